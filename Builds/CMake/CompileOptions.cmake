@@ -55,6 +55,16 @@ set(DEFAULT_COMPILE_DEFINITIONS
     SYSTEM_${SYSTEM_NAME_UPPER}
 )
 
+# Pad Vector3/Matrix3x3 storage to SIMD-register alignment (see Macros.hpp).
+# Changes type sizes, so it must be consistent across every target linked
+# against the core library.
+option(CUBBYFLOW_ALIGNED_VECTOR_TYPES "Pad Vector3/Matrix3x3 to SIMD-register alignment" OFF)
+if(CUBBYFLOW_ALIGNED_VECTOR_TYPES)
+    set(DEFAULT_COMPILE_DEFINITIONS ${DEFAULT_COMPILE_DEFINITIONS}
+        CUBBYFLOW_ALIGNED_VECTOR_TYPES
+    )
+endif()
+
 # MSVC compiler options
 if(CMAKE_CXX_COMPILER_ID MATCHES "MSVC")
     set(DEFAULT_COMPILE_DEFINITIONS ${DEFAULT_COMPILE_DEFINITIONS}
@@ -150,6 +160,13 @@ if(CMAKE_CXX_COMPILER_ID MATCHES "GNU" OR CMAKE_SYSTEM_NAME MATCHES "Linux")
     )
 endif()
 
+# shm_open/shm_unlink live in librt on older glibc
+if(CMAKE_SYSTEM_NAME MATCHES "Linux")
+    set(DEFAULT_LINKER_OPTIONS ${DEFAULT_LINKER_OPTIONS}
+        -lrt
+    )
+endif()
+
 # Code coverage - Debug only
 # NOTE: Code coverage results with an optimized (non-Debug) build may be misleading
 if(CMAKE_BUILD_TYPE MATCHES Debug AND CMAKE_COMPILER_IS_GNUCXX)
@@ -11,8 +11,8 @@
 #include <../ClaraUtils.hpp>
 
 #include <Core/Geometry/MarchingCubes.hpp>
+#include <Core/Geometry/ObjToSDFPipeline.hpp>
 #include <Core/Geometry/TriangleMesh3.hpp>
-#include <Core/Geometry/TriangleMeshToSDF.hpp>
 #include <Core/Grid/VertexCenteredScalarGrid3.hpp>
 
 #include <Clara/include/clara.hpp>
@@ -76,49 +76,39 @@ int main(int argc, char* argv[])
         exit(EXIT_FAILURE);
     }
 
-    TriangleMesh3 triMesh;
-
     std::ifstream objFile(inputFileName.c_str());
-    if (objFile)
-    {
-        printf("Reading obj file %s\n", inputFileName.c_str());
-        [[maybe_unused]] bool isLoaded = triMesh.ReadObj(&objFile);
-        objFile.close();
-    }
-    else
+    if (!objFile)
     {
         fprintf(stderr, "Failed to open file %s\n", inputFileName.c_str());
         exit(EXIT_FAILURE);
     }
 
-    BoundingBox3D box = triMesh.BoundingBox();
-    const Vector3D scale(box.GetWidth(), box.GetHeight(), box.GetDepth());
-    box.lowerCorner -= marginScale * scale;
-    box.upperCorner += marginScale * scale;
+    printf("Streaming obj file %s\n", inputFileName.c_str());
+
+    // Stream-parse the OBJ and bake the SDF slab by slab through the
+    // Core-side pipeline.
+    VertexCenteredScalarGrid3 grid;
 
-    const size_t resolutionY =
-        static_cast<size_t>(std::ceil(resX * box.GetHeight() / box.GetWidth()));
-    const size_t resolutionZ =
-        static_cast<size_t>(std::ceil(resX * box.GetDepth() / box.GetWidth()));
+    ObjToSDFPipelineSettings settings;
+    settings.resolutionX = resX;
+    settings.marginScale = marginScale;
 
-    printf("Vertex-centered grid size: %zu x %zu x %zu\n", resX, resolutionY,
-           resolutionZ);
+    if (!ObjToSDF(&objFile, &grid, settings))
+    {
+        fprintf(stderr, "Failed to convert %s\n", inputFileName.c_str());
+        exit(EXIT_FAILURE);
+    }
 
-    const double dx = box.GetWidth() / resX;
+    objFile.close();
 
-    VertexCenteredScalarGrid3 grid(resX, resolutionY, resolutionZ, dx, dx, dx,
-                                   box.lowerCorner.x, box.lowerCorner.y,
-                                   box.lowerCorner.z);
+    const Size3 resolution = grid.Resolution();
+    printf("Vertex-centered grid size: %zu x %zu x %zu\n", resolution.x,
+           resolution.y, resolution.z);
 
     const BoundingBox3D domain = grid.BoundingBox();
     printf("Domain size: [%f, %f, %f] x [%f, %f, %f]\n", domain.lowerCorner.x,
            domain.lowerCorner.y, domain.lowerCorner.z, domain.upperCorner.x,
            domain.upperCorner.y, domain.upperCorner.z);
-    printf("Generating SDF...");
-
-    TriangleMeshToSDF(triMesh, &grid);
-
-    printf("done\n");
 
     std::ofstream sdfFile(outputFileName.c_str(), std::ofstream::binary);
     if (sdfFile)
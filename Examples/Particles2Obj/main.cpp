@@ -17,6 +17,7 @@
 #include <Core/Geometry/TriangleMesh3.hpp>
 #include <Core/Grid/ScalarGrid3.hpp>
 #include <Core/Grid/VertexCenteredScalarGrid3.hpp>
+#include <Core/Particle/ParticleCache3.hpp>
 #include <Core/PointsToImplicit/AnisotropicPointsToImplicit3.hpp>
 #include <Core/PointsToImplicit/SPHPointsToImplicit3.hpp>
 #include <Core/PointsToImplicit/SphericalPointsToImplicit3.hpp>
@@ -280,8 +281,20 @@ int main(int argc, char* argv[])
 
     // Read particle positions
     Array1<Vector3D> positions;
-    std::ifstream positionFile(inputFileName.c_str(), std::ifstream::binary);
-    if (positionFile)
+    if (ParticleCache3::Reader cacheReader; cacheReader.Open(inputFileName))
+    {
+        // Chunked particle cache: fetch just the position layer instead of
+        // loading the whole frame.
+        if (!cacheReader.ReadVectorLayer(cacheReader.GetPositionLayerIndex(),
+                                         &positions))
+        {
+            printf("Cannot read cache file %s.\n", inputFileName.c_str());
+            exit(EXIT_FAILURE);
+        }
+    }
+    else if (std::ifstream positionFile(inputFileName.c_str(),
+                                        std::ifstream::binary);
+             positionFile)
     {
         const std::vector<uint8_t> buffer(
             (std::istreambuf_iterator<char>(positionFile)),
@@ -0,0 +1,104 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_ASYNC_FRAME_OUTPUT_HPP
+#define CUBBYFLOW_ASYNC_FRAME_OUTPUT_HPP
+
+#include <Core/Animation/Frame.hpp>
+#include <Core/Utils/Serialization.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Background serialization stage for per-frame simulation output.
+//!
+//! This class owns a single worker thread that serializes snapshots of the
+//! simulation state and hands the encoded buffer to a user-provided output
+//! function (typically a disk write). Submitting a snapshot returns as soon
+//! as the snapshot is queued, so the caller can start computing the next
+//! frame while the previous one is being encoded and written.
+//!
+//! The queue is double-buffered: at most one snapshot can be pending while
+//! another is being serialized. Submitting a third snapshot blocks until the
+//! worker catches up, which bounds the memory held by in-flight copies of
+//! the simulation state.
+//!
+class AsyncFrameOutput
+{
+ public:
+    //! Function type that consumes the serialized frame data.
+    using OutputFunc =
+        std::function<void(const Frame& frame, const std::vector<uint8_t>&)>;
+
+    //! Constructs the output stage and starts the worker thread.
+    explicit AsyncFrameOutput(OutputFunc outputFunc);
+
+    //! Deleted copy constructor.
+    AsyncFrameOutput(const AsyncFrameOutput&) = delete;
+
+    //! Deleted move constructor.
+    AsyncFrameOutput(AsyncFrameOutput&&) = delete;
+
+    //! Destructor. Drains the queue and joins the worker thread.
+    ~AsyncFrameOutput();
+
+    //! Deleted copy assignment operator.
+    AsyncFrameOutput& operator=(const AsyncFrameOutput&) = delete;
+
+    //! Deleted move assignment operator.
+    AsyncFrameOutput& operator=(AsyncFrameOutput&&) = delete;
+
+    //!
+    //! \brief Queues \p snapshot to be serialized and written for \p frame.
+    //!
+    //! The snapshot must be an immutable copy of the simulation state -- the
+    //! worker thread reads it without synchronizing against the simulation.
+    //! If a previous snapshot is still pending, this call blocks until the
+    //! worker picks it up.
+    //!
+    //! \param[in] frame    The frame the snapshot belongs to.
+    //! \param[in] snapshot Serializable copy of the simulation state.
+    //!
+    void Submit(const Frame& frame,
+                std::shared_ptr<const Serializable> snapshot);
+
+    //! Blocks until every submitted frame has been serialized and written.
+    void Flush();
+
+ private:
+    struct Task
+    {
+        Frame frame;
+        std::shared_ptr<const Serializable> snapshot;
+    };
+
+    void Run();
+
+    OutputFunc m_outputFunc;
+    std::deque<Task> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_taskAdded;
+    std::condition_variable m_taskFinished;
+    bool m_isBusy = false;
+    bool m_shutdown = false;
+    std::thread m_worker;
+};
+
+using AsyncFrameOutputPtr = std::shared_ptr<AsyncFrameOutput>;
+}  // namespace CubbyFlow
+
+#endif
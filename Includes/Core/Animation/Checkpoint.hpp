@@ -0,0 +1,83 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_CHECKPOINT_HPP
+#define CUBBYFLOW_CHECKPOINT_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Restartable simulation checkpoint.
+//!
+//! A checkpoint is a set of named, serialized components — one per system
+//! the owning animation wants to survive a restart. On disk, a checkpoint
+//! is a directory holding one file per component plus a manifest listing
+//! each component's name, size, and content hash.
+//!
+//! Saving is two-phase: component files are written under content-addressed
+//! names first, then the manifest is written to a temporary and renamed
+//! over the previous one, which makes that rename the commit point — a
+//! save interrupted at any moment leaves the previous checkpoint intact.
+//! Components whose hash matches the previous manifest are not rewritten,
+//! so checkpointing every N frames only pays for the state that changed.
+//!
+class Checkpoint final
+{
+ public:
+    //! Stores \p buffer as the component named \p name, replacing any
+    //! previous content. Names must not be empty and must consist of
+    //! alphanumerics, '_', '-', and '.'.
+    void Set(const std::string& name, std::vector<uint8_t> buffer);
+
+    //! Returns the buffer of the component named \p name, or null if the
+    //! checkpoint has no such component.
+    [[nodiscard]] const std::vector<uint8_t>* Get(
+        const std::string& name) const;
+
+    //! Removes every component.
+    void Clear();
+
+    //!
+    //! \brief Saves the checkpoint into \p directoryPath.
+    //!
+    //! The directory must exist. Any previous checkpoint in the directory
+    //! stays valid until the final manifest rename; afterwards, component
+    //! files it no longer references are removed.
+    //!
+    //! \return True on success; false if any file could not be written.
+    //!
+    [[nodiscard]] bool SaveToDirectory(const std::string& directoryPath) const;
+
+    //!
+    //! \brief Loads the checkpoint committed in \p directoryPath.
+    //!
+    //! Every component file is verified against the size and hash recorded
+    //! in the manifest.
+    //!
+    //! \return True on success; false if there is no manifest or any
+    //!         component is missing or fails verification.
+    //!
+    [[nodiscard]] bool LoadFromDirectory(const std::string& directoryPath);
+
+    //! Returns the FNV-1a hash of \p size bytes at \p data, used for the
+    //! manifest content hashes.
+    [[nodiscard]] static uint64_t HashBuffer(const uint8_t* data, size_t size);
+
+ private:
+    std::map<std::string, std::vector<uint8_t>> m_components;
+};
+}  // namespace CubbyFlow
+
+#endif
@@ -12,6 +12,11 @@
 #define CUBBYFLOW_PHYSICS_ANIMATION_HPP
 
 #include <Core/Animation/Animation.hpp>
+#include <Core/Animation/AsyncFrameOutput.hpp>
+#include <Core/Animation/Checkpoint.hpp>
+#include <Core/Animation/SharedMemoryFrameChannel.hpp>
+
+#include <functional>
 
 namespace CubbyFlow
 {
@@ -24,6 +29,10 @@ namespace CubbyFlow
 class PhysicsAnimation : public Animation
 {
  public:
+    //! Function type that copies the simulation state into a serializable
+    //! snapshot. The returned object must not alias live simulation buffers.
+    using SnapshotFunc = std::function<std::shared_ptr<const Serializable>()>;
+
     //! Default constructor.
     PhysicsAnimation();
 
@@ -90,6 +99,26 @@ class PhysicsAnimation : public Animation
     //!
     void SetNumberOfFixedSubTimeSteps(unsigned int numberOfSteps);
 
+    //! Returns the number of worker threads this animation's update may use
+    //! (0 means the engine-wide setting).
+    [[nodiscard]] unsigned int GetThreadBudget() const;
+
+    //!
+    //! \brief Sets the number of worker threads this animation's update may
+    //!        use.
+    //!
+    //! When non-zero, every update runs inside a ScopedThreadBudget, so all
+    //! parallel loops issued by the subclass (including initialization on
+    //! the first frame) are at most this wide. This makes the core count a
+    //! per-simulation property: a process hosting several simulations can
+    //! give each one a slice of the machine instead of letting every solver
+    //! assume all cores (see SimulationBatchRunner). Zero, the default,
+    //! leaves the engine-wide setting in charge.
+    //!
+    //! \param[in] numThreads Maximum loop width for this animation, or 0.
+    //!
+    void SetThreadBudget(unsigned int numThreads);
+
     //! Advances a single frame.
     void AdvanceSingleFrame();
 
@@ -111,6 +140,74 @@ class PhysicsAnimation : public Animation
     //!
     [[nodiscard]] double GetCurrentTimeInSeconds() const;
 
+    //!
+    //! \brief Enables asynchronous per-frame output.
+    //!
+    //! After each frame is advanced, \p snapshotFunc is invoked on the
+    //! simulation thread to copy the state (e.g. by copy-constructing a
+    //! ParticleSystemData3 or GridSystemData3 instance), and the snapshot is
+    //! handed to a background thread that serializes it and passes the
+    //! encoded buffer to \p outputFunc. This overlaps flatbuffers encoding
+    //! and disk writes with the next frame's compute.
+    //!
+    //! Copies of this animation share the same output stage.
+    //!
+    //! \param[in] snapshotFunc Function that copies the simulation state.
+    //! \param[in] outputFunc   Function that consumes the serialized frames.
+    //!
+    void SetFrameOutput(SnapshotFunc snapshotFunc,
+                        AsyncFrameOutput::OutputFunc outputFunc);
+
+    //! Blocks until every queued frame has been serialized and written.
+    void FlushFrameOutput() const;
+
+    //!
+    //! \brief Publishes each finished frame into a shared-memory channel.
+    //!
+    //! This is the live-preview variant of SetFrameOutput: after each frame,
+    //! \p snapshotFunc copies the state, a background thread serializes it,
+    //! and the encoded buffer is published into \p channel instead of being
+    //! written to disk. An external viewer that opened the channel by name
+    //! maps new frames with zero file I/O; frames that exceed the channel's
+    //! slot capacity are skipped with a warning.
+    //!
+    //! \param[in] snapshotFunc Function that copies the simulation state.
+    //! \param[in] channel      Channel created by
+    //!                         SharedMemoryFrameChannel::Create.
+    //!
+    void SetFramePublisher(SnapshotFunc snapshotFunc,
+                           SharedMemoryFrameChannelPtr channel);
+
+    //!
+    //! \brief Saves a restartable checkpoint into \p directoryPath.
+    //!
+    //! The checkpoint captures the frame cursor and every component the
+    //! solver contributes through OnSaveCheckpoint, so a preempted run can
+    //! resume from the last checkpoint instead of frame zero. The save is
+    //! atomic: an interrupted save leaves the previous checkpoint in the
+    //! directory intact. Components whose content did not change since the
+    //! previous save are not rewritten.
+    //!
+    //! \param[in] directoryPath The checkpoint directory; must exist.
+    //!
+    //! \return True on success; false if any file could not be written.
+    //!
+    [[nodiscard]] bool SaveCheckpoint(const std::string& directoryPath) const;
+
+    //!
+    //! \brief Restores the checkpoint committed in \p directoryPath.
+    //!
+    //! On success, the next call to AdvanceSingleFrame continues from the
+    //! checkpointed frame; initialization is skipped. On failure, the
+    //! animation state is left unchanged.
+    //!
+    //! \param[in] directoryPath The checkpoint directory.
+    //!
+    //! \return True on success; false if the checkpoint is missing,
+    //!         corrupt, or rejected by the solver.
+    //!
+    [[nodiscard]] bool LoadCheckpoint(const std::string& directoryPath);
+
  protected:
     //!
     //! \brief Called when a single time-step should be advanced.
@@ -149,6 +246,29 @@ class PhysicsAnimation : public Animation
     //!
     virtual void OnInitialize();
 
+    //!
+    //! \brief Stores solver state into \p checkpoint.
+    //!
+    //! Overrides must call the base implementation, then add one component
+    //! per system that must survive a restart. The base stores the frame
+    //! cursor and time-stepping settings.
+    //!
+    //! \param[in,out] checkpoint The checkpoint being assembled.
+    //!
+    virtual void OnSaveCheckpoint(Checkpoint* checkpoint) const;
+
+    //!
+    //! \brief Restores solver state from \p checkpoint.
+    //!
+    //! Overrides must call the base implementation first and propagate its
+    //! failure.
+    //!
+    //! \param[in] checkpoint The loaded checkpoint.
+    //!
+    //! \return True on success; false if a required component is missing.
+    //!
+    [[nodiscard]] virtual bool OnLoadCheckpoint(const Checkpoint& checkpoint);
+
  private:
     void OnUpdate(const Frame& frame) final;
 
@@ -159,7 +279,10 @@ class PhysicsAnimation : public Animation
     Frame m_currentFrame;
     bool m_isUsingFixedSubTimeSteps = true;
     unsigned int m_numberOfFixedSubTimeSteps = 1;
+    unsigned int m_threadBudget = 0;
     double m_currentTime = 0.0;
+    SnapshotFunc m_snapshotFunc;
+    AsyncFrameOutputPtr m_frameOutput;
 };
 
 using PhysicsAnimationPtr = std::shared_ptr<PhysicsAnimation>;
@@ -0,0 +1,130 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_SHARED_MEMORY_FRAME_CHANNEL_HPP
+#define CUBBYFLOW_SHARED_MEMORY_FRAME_CHANNEL_HPP
+
+#include <Core/Utils/Macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CubbyFlow
+{
+class SharedMemoryFrameChannel;
+
+//! Shared pointer type for the SharedMemoryFrameChannel.
+using SharedMemoryFrameChannelPtr = std::shared_ptr<SharedMemoryFrameChannel>;
+
+//!
+//! \brief Named shared-memory ring buffer for publishing per-frame data.
+//!
+//! The channel maps a named shared-memory region laid out as a fixed number
+//! of fixed-capacity slots. The writer publishes each frame into the slot
+//! indexed by the frame number modulo the slot count, guarded by a per-slot
+//! seqlock, and advertises the most recent frame in the region header. A
+//! reader in another process opens the channel by name and copies the latest
+//! frame out without any file I/O; a torn read (the writer overwrote the
+//! slot mid-copy) is detected through the seqlock and retried.
+//!
+//! The payload format is up to the caller; the intended use is the encoded
+//! buffer produced by Serialize, published from an AsyncFrameOutput stage
+//! (see PhysicsAnimation::SetFramePublisher).
+//!
+class SharedMemoryFrameChannel final
+{
+ public:
+    //!
+    //! \brief Creates the named channel as the writer.
+    //!
+    //! An existing region with the same name is replaced.
+    //!
+    //! \param[in] name         Channel name, shared with the readers.
+    //! \param[in] numSlots     Number of ring slots (at least 2 recommended
+    //!                         so readers rarely race the writer).
+    //! \param[in] slotCapacity Maximum payload size per frame in bytes.
+    //!
+    //! \return The channel, or nullptr if the region could not be created.
+    //!
+    [[nodiscard]] static SharedMemoryFrameChannelPtr Create(
+        const std::string& name, size_t numSlots, size_t slotCapacity);
+
+    //!
+    //! \brief Opens an existing named channel as a reader.
+    //!
+    //! \param[in] name Channel name used by the writer.
+    //!
+    //! \return The channel, or nullptr if the region does not exist or does
+    //!         not look like a frame channel.
+    //!
+    [[nodiscard]] static SharedMemoryFrameChannelPtr Open(
+        const std::string& name);
+
+    //! Destructor. Unmaps the region; the writer also unlinks the name.
+    ~SharedMemoryFrameChannel();
+
+    //! Deleted copy constructor.
+    SharedMemoryFrameChannel(const SharedMemoryFrameChannel&) = delete;
+
+    //! Deleted move constructor.
+    SharedMemoryFrameChannel(SharedMemoryFrameChannel&&) = delete;
+
+    //! Deleted copy assignment operator.
+    SharedMemoryFrameChannel& operator=(const SharedMemoryFrameChannel&) =
+        delete;
+
+    //! Deleted move assignment operator.
+    SharedMemoryFrameChannel& operator=(SharedMemoryFrameChannel&&) = delete;
+
+    //! Returns the number of ring slots.
+    [[nodiscard]] size_t GetNumberOfSlots() const;
+
+    //! Returns the maximum payload size per frame in bytes.
+    [[nodiscard]] size_t GetSlotCapacity() const;
+
+    //!
+    //! \brief Publishes one frame into the ring (writer only).
+    //!
+    //! \param[in] frameIndex Frame number; selects the slot.
+    //! \param[in] data       Payload bytes.
+    //! \param[in] size       Payload size; must fit the slot capacity.
+    //!
+    //! \return True on success; false if \p size exceeds the slot capacity.
+    //!
+    bool Publish(uint64_t frameIndex, const uint8_t* data, size_t size);
+
+    //!
+    //! \brief Copies the most recently published frame out of the ring.
+    //!
+    //! \param[out] frameIndex Frame number of the returned payload.
+    //! \param[out] data       Receives the payload bytes.
+    //!
+    //! \return True on success; false if nothing has been published yet or
+    //!         the writer kept overwriting the slot faster than it could be
+    //!         copied.
+    //!
+    bool ReadLatest(uint64_t* frameIndex, std::vector<uint8_t>* data) const;
+
+ private:
+    SharedMemoryFrameChannel() = default;
+
+    std::string m_name;
+    void* m_mapping = nullptr;
+    size_t m_mappingSize = 0;
+    bool m_isWriter = false;
+#ifdef CUBBYFLOW_WINDOWS
+    void* m_fileMapping = nullptr;
+#endif
+};
+}  // namespace CubbyFlow
+
+#endif
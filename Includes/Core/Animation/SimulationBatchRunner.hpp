@@ -0,0 +1,118 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_SIMULATION_BATCH_RUNNER_HPP
+#define CUBBYFLOW_SIMULATION_BATCH_RUNNER_HPP
+
+#include <Core/Animation/PhysicsAnimation.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Hosts multiple physics animations in one process.
+//!
+//! Parameter-sweep workflows run many small simulations that differ only in a
+//! few coefficients. Running them as separate processes duplicates every
+//! expensive read-only bake (collider SDFs from triangle meshes, the meshes
+//! themselves). This runner hosts the animations in one process so those
+//! resources can be built once, registered in the shared-resource cache, and
+//! referenced by every simulation, and it schedules the per-frame Update
+//! calls across the shared thread pool.
+//!
+//! Each simulation declares a core budget - an estimate of how many worker
+//! threads its update saturates. Simulations are advanced in waves whose
+//! combined budgets fit the pool size, so a batch of small sims runs
+//! concurrently while a single large sim still gets the whole pool.
+//!
+class SimulationBatchRunner
+{
+ public:
+    //!
+    //! \brief Adds a simulation to the batch.
+    //!
+    //! \param[in] simulation The animation to host.
+    //! \param[in] coreBudget Number of worker threads the simulation's update
+    //!                       is expected to saturate. Clamped to the pool
+    //!                       size; zero is treated as one.
+    //!
+    //! \return Index of the added simulation.
+    //!
+    size_t AddSimulation(const PhysicsAnimationPtr& simulation,
+                         size_t coreBudget = 1);
+
+    //! Returns the number of hosted simulations.
+    [[nodiscard]] size_t GetNumberOfSimulations() const;
+
+    //! Returns the simulation at index \p i.
+    [[nodiscard]] const PhysicsAnimationPtr& GetSimulationAt(size_t i) const;
+
+    //!
+    //! \brief Registers a shared read-only resource under \p key.
+    //!
+    //! The cache keeps the resource alive for the lifetime of the runner.
+    //! Registering an existing key replaces the stored resource.
+    //!
+    void SetSharedResource(const std::string& key,
+                           std::shared_ptr<void> resource);
+
+    //!
+    //! \brief Returns the shared resource registered under \p key.
+    //!
+    //! The caller states the resource type; the cache does not check it.
+    //! Returns null if no resource is registered under the key.
+    //!
+    template <typename T>
+    [[nodiscard]] std::shared_ptr<T> GetSharedResource(
+        const std::string& key) const
+    {
+        const auto iter = m_sharedResources.find(key);
+        if (iter == m_sharedResources.end())
+        {
+            return nullptr;
+        }
+
+        return std::static_pointer_cast<T>(iter->second);
+    }
+
+    //!
+    //! \brief Advances every hosted simulation by a single frame.
+    //!
+    //! Simulations are grouped into waves in registration order; a wave is
+    //! closed once the next simulation's core budget no longer fits. Each
+    //! wave updates concurrently on the tasking system, and each
+    //! simulation's own parallel loops run under a ScopedThreadBudget of its
+    //! core budget, so wave mates cannot oversubscribe each other's share of
+    //! the pool.
+    //!
+    void AdvanceSingleFrame();
+
+    //! Advances every hosted simulation by \p numberOfFrames frames.
+    void AdvanceFrames(size_t numberOfFrames);
+
+ private:
+    struct Entry
+    {
+        PhysicsAnimationPtr simulation;
+        size_t coreBudget;
+    };
+
+    std::vector<Entry> m_entries;
+    std::map<std::string, std::shared_ptr<void>> m_sharedResources;
+};
+
+using SimulationBatchRunnerPtr = std::shared_ptr<SimulationBatchRunner>;
+}  // namespace CubbyFlow
+
+#endif
@@ -12,6 +12,7 @@
 #define CUBBYFLOW_ARRAY_HPP
 
 #include <cstddef>
+#include <memory>
 
 namespace CubbyFlow
 {
@@ -23,10 +24,16 @@ namespace CubbyFlow
 //! interface for 1, 2 or 3 dimensional arrays using template specialization
 //! only, but it cannot create any instance by itself.
 //!
+//! The allocator parameter controls where the underlying storage comes from
+//! (e.g. a huge-page arena for very large grids) and defaults to the
+//! standard allocator, so the usual Array1/Array2/Array3 aliases are
+//! unaffected. Accessors view raw memory and stay allocator-agnostic.
+//!
 //! \tparam T - Real number type.
 //! \tparam N - Dimension.
+//! \tparam Allocator - Allocator for the underlying storage.
 //!
-template <typename T, size_t N>
+template <typename T, size_t N, typename Allocator = std::allocator<T>>
 class Array final
 {
  public:
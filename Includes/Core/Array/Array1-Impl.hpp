@@ -15,32 +15,32 @@
 
 namespace CubbyFlow
 {
-template <typename T>
-Array<T, 1>::Array(size_t size, const T& initVal)
+template <typename T, typename Allocator>
+Array<T, 1, Allocator>::Array(size_t size, const T& initVal)
 {
     Resize(size, initVal);
 }
 
-template <typename T>
-Array<T, 1>::Array(const std::initializer_list<T>& list)
+template <typename T, typename Allocator>
+Array<T, 1, Allocator>::Array(const std::initializer_list<T>& list)
 {
     Set(list);
 }
 
-template <typename T>
-Array<T, 1>::Array(const Array& other)
+template <typename T, typename Allocator>
+Array<T, 1, Allocator>::Array(const Array& other)
 {
     Set(other);
 }
 
-template <typename T>
-Array<T, 1>::Array(Array&& other) noexcept
+template <typename T, typename Allocator>
+Array<T, 1, Allocator>::Array(Array&& other) noexcept
 {
     *this = std::move(other);
 }
 
-template <typename T>
-void Array<T, 1>::Set(const T& value)
+template <typename T, typename Allocator>
+void Array<T, 1, Allocator>::Set(const T& value)
 {
     for (auto& v : m_data)
     {
@@ -48,15 +48,15 @@ void Array<T, 1>::Set(const T& value)
     }
 }
 
-template <typename T>
-void Array<T, 1>::Set(const Array& other)
+template <typename T, typename Allocator>
+void Array<T, 1, Allocator>::Set(const Array& other)
 {
     m_data.resize(other.m_data.size());
     std::copy(other.m_data.begin(), other.m_data.end(), m_data.begin());
 }
 
-template <typename T>
-void Array<T, 1>::Set(const std::initializer_list<T>& list)
+template <typename T, typename Allocator>
+void Array<T, 1, Allocator>::Set(const std::initializer_list<T>& list)
 {
     const size_t size = list.size();
     Resize(size);
@@ -69,180 +69,180 @@ void Array<T, 1>::Set(const std::initializer_list<T>& list)
     }
 }
 
-template <typename T>
-void Array<T, 1>::Clear()
+template <typename T, typename Allocator>
+void Array<T, 1, Allocator>::Clear()
 {
     m_data.clear();
 }
 
-template <typename T>
-void Array<T, 1>::Resize(size_t size, const T& initVal)
+template <typename T, typename Allocator>
+void Array<T, 1, Allocator>::Resize(size_t size, const T& initVal)
 {
     m_data.resize(size, initVal);
 }
 
-template <typename T>
-T& Array<T, 1>::At(size_t i)
+template <typename T, typename Allocator>
+T& Array<T, 1, Allocator>::At(size_t i)
 {
     assert(i < size());
     return m_data[i];
 }
 
-template <typename T>
-const T& Array<T, 1>::At(size_t i) const
+template <typename T, typename Allocator>
+const T& Array<T, 1, Allocator>::At(size_t i) const
 {
     assert(i < size());
     return m_data[i];
 }
 
-template <typename T>
-size_t Array<T, 1>::size() const
+template <typename T, typename Allocator>
+size_t Array<T, 1, Allocator>::size() const
 {
     return m_data.size();
 }
 
-template <typename T>
-T* Array<T, 1>::data()
+template <typename T, typename Allocator>
+T* Array<T, 1, Allocator>::data()
 {
     return m_data.data();
 }
 
-template <typename T>
-const T* Array<T, 1>::data() const
+template <typename T, typename Allocator>
+const T* Array<T, 1, Allocator>::data() const
 {
     return m_data.data();
 }
 
-template <typename T>
-typename Array<T, 1>::ContainerType::iterator Array<T, 1>::begin()
+template <typename T, typename Allocator>
+typename Array<T, 1, Allocator>::ContainerType::iterator Array<T, 1, Allocator>::begin()
 {
     return m_data.begin();
 }
 
-template <typename T>
-typename Array<T, 1>::ContainerType::const_iterator Array<T, 1>::begin() const
+template <typename T, typename Allocator>
+typename Array<T, 1, Allocator>::ContainerType::const_iterator Array<T, 1, Allocator>::begin() const
 {
     return m_data.cbegin();
 }
 
-template <typename T>
-typename Array<T, 1>::ContainerType::iterator Array<T, 1>::end()
+template <typename T, typename Allocator>
+typename Array<T, 1, Allocator>::ContainerType::iterator Array<T, 1, Allocator>::end()
 {
     return m_data.end();
 }
 
-template <typename T>
-typename Array<T, 1>::ContainerType::const_iterator Array<T, 1>::end() const
+template <typename T, typename Allocator>
+typename Array<T, 1, Allocator>::ContainerType::const_iterator Array<T, 1, Allocator>::end() const
 {
     return m_data.cend();
 }
 
-template <typename T>
-ArrayAccessor1<T> Array<T, 1>::Accessor()
+template <typename T, typename Allocator>
+ArrayAccessor1<T> Array<T, 1, Allocator>::Accessor()
 {
     return ArrayAccessor1<T>(size(), data());
 }
 
-template <typename T>
-ConstArrayAccessor1<T> Array<T, 1>::ConstAccessor() const
+template <typename T, typename Allocator>
+ConstArrayAccessor1<T> Array<T, 1, Allocator>::ConstAccessor() const
 {
     return ConstArrayAccessor1<T>(size(), data());
 }
 
-template <typename T>
-void Array<T, 1>::Swap(Array& other)
+template <typename T, typename Allocator>
+void Array<T, 1, Allocator>::Swap(Array& other)
 {
     std::swap(other.m_data, m_data);
 }
 
-template <typename T>
-void Array<T, 1>::Append(const T& newVal)
+template <typename T, typename Allocator>
+void Array<T, 1, Allocator>::Append(const T& newVal)
 {
     m_data.push_back(newVal);
 }
 
-template <typename T>
-void Array<T, 1>::Append(const Array& other)
+template <typename T, typename Allocator>
+void Array<T, 1, Allocator>::Append(const Array& other)
 {
     m_data.insert(m_data.end(), other.m_data.begin(), other.m_data.end());
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 1>::ForEach(Callback func) const
+void Array<T, 1, Allocator>::ForEach(Callback func) const
 {
     ConstAccessor().ForEach(func);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 1>::ForEachIndex(Callback func) const
+void Array<T, 1, Allocator>::ForEachIndex(Callback func) const
 {
     ConstAccessor().ForEachIndex(func);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 1>::ParallelForEach(Callback func)
+void Array<T, 1, Allocator>::ParallelForEach(Callback func)
 {
     Accessor().ParallelForEach(func);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 1>::ParallelForEachIndex(Callback func) const
+void Array<T, 1, Allocator>::ParallelForEachIndex(Callback func) const
 {
     ConstAccessor().ParallelForEachIndex(func);
 }
 
-template <typename T>
-T& Array<T, 1>::operator[](size_t i)
+template <typename T, typename Allocator>
+T& Array<T, 1, Allocator>::operator[](size_t i)
 {
     return m_data[i];
 }
 
-template <typename T>
-const T& Array<T, 1>::operator[](size_t i) const
+template <typename T, typename Allocator>
+const T& Array<T, 1, Allocator>::operator[](size_t i) const
 {
     return m_data[i];
 }
 
-template <typename T>
-Array<T, 1>& Array<T, 1>::operator=(const T& other)
+template <typename T, typename Allocator>
+Array<T, 1, Allocator>& Array<T, 1, Allocator>::operator=(const T& other)
 {
     Set(other);
     return *this;
 }
 
-template <typename T>
-Array<T, 1>& Array<T, 1>::operator=(const Array& other)
+template <typename T, typename Allocator>
+Array<T, 1, Allocator>& Array<T, 1, Allocator>::operator=(const Array& other)
 {
     Set(other);
     return *this;
 }
 
-template <typename T>
-Array<T, 1>& Array<T, 1>::operator=(Array&& other) noexcept
+template <typename T, typename Allocator>
+Array<T, 1, Allocator>& Array<T, 1, Allocator>::operator=(Array&& other) noexcept
 {
     m_data = std::move(other.m_data);
     return *this;
 }
 
-template <typename T>
-Array<T, 1>& Array<T, 1>::operator=(const std::initializer_list<T>& list)
+template <typename T, typename Allocator>
+Array<T, 1, Allocator>& Array<T, 1, Allocator>::operator=(const std::initializer_list<T>& list)
 {
     Set(list);
     return *this;
 }
 
-template <typename T>
-Array<T, 1>::operator ArrayAccessor1<T>()
+template <typename T, typename Allocator>
+Array<T, 1, Allocator>::operator ArrayAccessor1<T>()
 {
     return Accessor();
 }
 
-template <typename T>
-Array<T, 1>::operator ConstArrayAccessor1<T>() const
+template <typename T, typename Allocator>
+Array<T, 1, Allocator>::operator ConstArrayAccessor1<T>() const
 {
     return ConstAccessor();
 }
@@ -27,11 +27,11 @@ namespace CubbyFlow
 //!
 //! \tparam T - Type to store in the array.
 //!
-template <typename T>
-class Array<T, 1> final
+template <typename T, typename Allocator>
+class Array<T, 1, Allocator> final
 {
  public:
-    using ContainerType = std::vector<T>;
+    using ContainerType = std::vector<T, Allocator>;
     using Iterator = typename ContainerType::iterator;
     using ConstIterator = typename ContainerType::const_iterator;
 
@@ -235,8 +235,8 @@ class Array<T, 1> final
 };
 
 //! Type alias for 1-D array.
-template <typename T>
-using Array1 = Array<T, 1>;
+template <typename T, typename Allocator = std::allocator<T>>
+using Array1 = Array<T, 1, Allocator>;
 }  // namespace CubbyFlow
 
 #include <Core/Array/Array1-Impl.hpp>
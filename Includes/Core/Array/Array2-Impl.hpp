@@ -16,38 +16,38 @@
 
 namespace CubbyFlow
 {
-template <typename T>
-Array<T, 2>::Array(const Size2& size, const T& initVal)
+template <typename T, typename Allocator>
+Array<T, 2, Allocator>::Array(const Size2& size, const T& initVal)
 {
     Resize(size, initVal);
 }
 
-template <typename T>
-Array<T, 2>::Array(size_t width, size_t height, const T& initVal)
+template <typename T, typename Allocator>
+Array<T, 2, Allocator>::Array(size_t width, size_t height, const T& initVal)
 {
     Resize(width, height, initVal);
 }
 
-template <typename T>
-Array<T, 2>::Array(const std::initializer_list<std::initializer_list<T>>& list)
+template <typename T, typename Allocator>
+Array<T, 2, Allocator>::Array(const std::initializer_list<std::initializer_list<T>>& list)
 {
     Set(list);
 }
 
-template <typename T>
-Array<T, 2>::Array(const Array& other)
+template <typename T, typename Allocator>
+Array<T, 2, Allocator>::Array(const Array& other)
 {
     Set(other);
 }
 
-template <typename T>
-Array<T, 2>::Array(Array&& other) noexcept
+template <typename T, typename Allocator>
+Array<T, 2, Allocator>::Array(Array&& other) noexcept
 {
     *this = std::move(other);
 }
 
-template <typename T>
-void Array<T, 2>::Set(const T& value)
+template <typename T, typename Allocator>
+void Array<T, 2, Allocator>::Set(const T& value)
 {
     for (auto& v : m_data)
     {
@@ -55,16 +55,16 @@ void Array<T, 2>::Set(const T& value)
     }
 }
 
-template <typename T>
-void Array<T, 2>::Set(const Array& other)
+template <typename T, typename Allocator>
+void Array<T, 2, Allocator>::Set(const Array& other)
 {
     m_data.resize(other.m_data.size());
     std::copy(other.m_data.begin(), other.m_data.end(), m_data.begin());
     m_size = other.m_size;
 }
 
-template <typename T>
-void Array<T, 2>::Set(
+template <typename T, typename Allocator>
+void Array<T, 2, Allocator>::Set(
     const std::initializer_list<std::initializer_list<T>>& list)
 {
     const size_t height = list.size();
@@ -88,15 +88,15 @@ void Array<T, 2>::Set(
     }
 }
 
-template <typename T>
-void Array<T, 2>::Clear()
+template <typename T, typename Allocator>
+void Array<T, 2, Allocator>::Clear()
 {
     m_data.clear();
     m_size = Size2(0, 0);
 }
 
-template <typename T>
-void Array<T, 2>::Resize(const Size2& size, const T& initVal)
+template <typename T, typename Allocator>
+void Array<T, 2, Allocator>::Resize(const Size2& size, const T& initVal)
 {
     Array grid;
     grid.m_data.resize(size.x * size.y, initVal);
@@ -115,209 +115,209 @@ void Array<T, 2>::Resize(const Size2& size, const T& initVal)
     Swap(grid);
 }
 
-template <typename T>
-void Array<T, 2>::Resize(size_t width, size_t height, const T& initVal)
+template <typename T, typename Allocator>
+void Array<T, 2, Allocator>::Resize(size_t width, size_t height, const T& initVal)
 {
     Resize(Size2(width, height), initVal);
 }
 
-template <typename T>
-T& Array<T, 2>::At(size_t i)
+template <typename T, typename Allocator>
+T& Array<T, 2, Allocator>::At(size_t i)
 {
     assert(i < Width() * Height());
     return m_data[i];
 }
 
-template <typename T>
-const T& Array<T, 2>::At(size_t i) const
+template <typename T, typename Allocator>
+const T& Array<T, 2, Allocator>::At(size_t i) const
 {
     assert(i < Width() * Height());
     return m_data[i];
 }
 
-template <typename T>
-T& Array<T, 2>::At(const Point2UI& pt)
+template <typename T, typename Allocator>
+T& Array<T, 2, Allocator>::At(const Point2UI& pt)
 {
     return At(pt.x, pt.y);
 }
 
-template <typename T>
-const T& Array<T, 2>::At(const Point2UI& pt) const
+template <typename T, typename Allocator>
+const T& Array<T, 2, Allocator>::At(const Point2UI& pt) const
 {
     return At(pt.x, pt.y);
 }
 
-template <typename T>
-T& Array<T, 2>::At(size_t i, size_t j)
+template <typename T, typename Allocator>
+T& Array<T, 2, Allocator>::At(size_t i, size_t j)
 {
     assert(i < Width() && j < Height());
     return m_data[i + Width() * j];
 }
 
-template <typename T>
-const T& Array<T, 2>::At(size_t i, size_t j) const
+template <typename T, typename Allocator>
+const T& Array<T, 2, Allocator>::At(size_t i, size_t j) const
 {
     assert(i < Width() && j < Height());
     return m_data[i + Width() * j];
 }
 
-template <typename T>
-Size2 Array<T, 2>::size() const
+template <typename T, typename Allocator>
+Size2 Array<T, 2, Allocator>::size() const
 {
     return m_size;
 }
 
-template <typename T>
-size_t Array<T, 2>::Width() const
+template <typename T, typename Allocator>
+size_t Array<T, 2, Allocator>::Width() const
 {
     return m_size.x;
 }
 
-template <typename T>
-size_t Array<T, 2>::Height() const
+template <typename T, typename Allocator>
+size_t Array<T, 2, Allocator>::Height() const
 {
     return m_size.y;
 }
 
-template <typename T>
-T* Array<T, 2>::data()
+template <typename T, typename Allocator>
+T* Array<T, 2, Allocator>::data()
 {
     return m_data.data();
 }
 
-template <typename T>
-const T* Array<T, 2>::data() const
+template <typename T, typename Allocator>
+const T* Array<T, 2, Allocator>::data() const
 {
     return m_data.data();
 }
 
-template <typename T>
-typename Array<T, 2>::ContainerType::iterator Array<T, 2>::begin()
+template <typename T, typename Allocator>
+typename Array<T, 2, Allocator>::ContainerType::iterator Array<T, 2, Allocator>::begin()
 {
     return m_data.begin();
 }
 
-template <typename T>
-typename Array<T, 2>::ContainerType::const_iterator Array<T, 2>::begin() const
+template <typename T, typename Allocator>
+typename Array<T, 2, Allocator>::ContainerType::const_iterator Array<T, 2, Allocator>::begin() const
 {
     return m_data.cbegin();
 }
 
-template <typename T>
-typename Array<T, 2>::ContainerType::iterator Array<T, 2>::end()
+template <typename T, typename Allocator>
+typename Array<T, 2, Allocator>::ContainerType::iterator Array<T, 2, Allocator>::end()
 {
     return m_data.end();
 }
 
-template <typename T>
-typename Array<T, 2>::ContainerType::const_iterator Array<T, 2>::end() const
+template <typename T, typename Allocator>
+typename Array<T, 2, Allocator>::ContainerType::const_iterator Array<T, 2, Allocator>::end() const
 {
     return m_data.cend();
 }
 
-template <typename T>
-ArrayAccessor2<T> Array<T, 2>::Accessor()
+template <typename T, typename Allocator>
+ArrayAccessor2<T> Array<T, 2, Allocator>::Accessor()
 {
     return ArrayAccessor2<T>(size(), data());
 }
 
-template <typename T>
-ConstArrayAccessor2<T> Array<T, 2>::ConstAccessor() const
+template <typename T, typename Allocator>
+ConstArrayAccessor2<T> Array<T, 2, Allocator>::ConstAccessor() const
 {
     return ConstArrayAccessor2<T>(size(), data());
 }
 
-template <typename T>
-void Array<T, 2>::Swap(Array& other)
+template <typename T, typename Allocator>
+void Array<T, 2, Allocator>::Swap(Array& other)
 {
     std::swap(other.m_data, m_data);
     std::swap(other.m_size, m_size);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 2>::ForEach(Callback func) const
+void Array<T, 2, Allocator>::ForEach(Callback func) const
 {
     ConstAccessor().ForEach(func);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 2>::ForEachIndex(Callback func) const
+void Array<T, 2, Allocator>::ForEachIndex(Callback func) const
 {
     ConstAccessor().ForEachIndex(func);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 2>::ParallelForEach(Callback func)
+void Array<T, 2, Allocator>::ParallelForEach(Callback func)
 {
     Accessor().ParallelForEach(func);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 2>::ParallelForEachIndex(Callback func) const
+void Array<T, 2, Allocator>::ParallelForEachIndex(Callback func) const
 {
     ConstAccessor().ParallelForEachIndex(func);
 }
 
-template <typename T>
-T& Array<T, 2>::operator[](size_t i)
+template <typename T, typename Allocator>
+T& Array<T, 2, Allocator>::operator[](size_t i)
 {
     return m_data[i];
 }
 
-template <typename T>
-const T& Array<T, 2>::operator[](size_t i) const
+template <typename T, typename Allocator>
+const T& Array<T, 2, Allocator>::operator[](size_t i) const
 {
     return m_data[i];
 }
 
-template <typename T>
-T& Array<T, 2>::operator()(size_t i, size_t j)
+template <typename T, typename Allocator>
+T& Array<T, 2, Allocator>::operator()(size_t i, size_t j)
 {
     assert(i < Width() && j < Height());
     return m_data[i + Width() * j];
 }
 
-template <typename T>
-const T& Array<T, 2>::operator()(size_t i, size_t j) const
+template <typename T, typename Allocator>
+const T& Array<T, 2, Allocator>::operator()(size_t i, size_t j) const
 {
     assert(i < Width() && j < Height());
     return m_data[i + Width() * j];
 }
 
-template <typename T>
-T& Array<T, 2>::operator()(const Point2UI& pt)
+template <typename T, typename Allocator>
+T& Array<T, 2, Allocator>::operator()(const Point2UI& pt)
 {
     assert(pt.x < Width() && pt.y < Height());
     return m_data[pt.x + Width() * pt.y];
 }
 
-template <typename T>
-const T& Array<T, 2>::operator()(const Point2UI& pt) const
+template <typename T, typename Allocator>
+const T& Array<T, 2, Allocator>::operator()(const Point2UI& pt) const
 {
     assert(pt.x < Width() && pt.y < Height());
     return m_data[pt.x + Width() * pt.y];
 }
 
-template <typename T>
-Array<T, 2>& Array<T, 2>::operator=(const T& other)
+template <typename T, typename Allocator>
+Array<T, 2, Allocator>& Array<T, 2, Allocator>::operator=(const T& other)
 {
     Set(other);
     return *this;
 }
 
-template <typename T>
-Array<T, 2>& Array<T, 2>::operator=(const Array& other)
+template <typename T, typename Allocator>
+Array<T, 2, Allocator>& Array<T, 2, Allocator>::operator=(const Array& other)
 {
     Set(other);
     return *this;
 }
 
-template <typename T>
-Array<T, 2>& Array<T, 2>::operator=(Array&& other) noexcept
+template <typename T, typename Allocator>
+Array<T, 2, Allocator>& Array<T, 2, Allocator>::operator=(Array&& other) noexcept
 {
     m_data = std::move(other.m_data);
     m_size = other.m_size;
@@ -325,22 +325,22 @@ Array<T, 2>& Array<T, 2>::operator=(Array&& other) noexcept
     return *this;
 }
 
-template <typename T>
-Array<T, 2>& Array<T, 2>::operator=(
+template <typename T, typename Allocator>
+Array<T, 2, Allocator>& Array<T, 2, Allocator>::operator=(
     const std::initializer_list<std::initializer_list<T>>& list)
 {
     Set(list);
     return *this;
 }
 
-template <typename T>
-Array<T, 2>::operator ArrayAccessor2<T>()
+template <typename T, typename Allocator>
+Array<T, 2, Allocator>::operator ArrayAccessor2<T>()
 {
     return Accessor();
 }
 
-template <typename T>
-Array<T, 2>::operator ConstArrayAccessor2<T>() const
+template <typename T, typename Allocator>
+Array<T, 2, Allocator>::operator ConstArrayAccessor2<T>() const
 {
     return ConstAccessor();
 }
@@ -40,11 +40,11 @@ namespace CubbyFlow
 //!
 //! \tparam T - Type to store in the array.
 //!
-template <typename T>
-class Array<T, 2> final
+template <typename T, typename Allocator>
+class Array<T, 2, Allocator> final
 {
  public:
-    using ContainerType = std::vector<T>;
+    using ContainerType = std::vector<T, Allocator>;
     using Iterator = typename ContainerType::iterator;
     using ConstIterator = typename ContainerType::const_iterator;
 
@@ -311,7 +311,7 @@ class Array<T, 2> final
     //! where i is the index of linearly mapped elements such that
     //! i = x + (width * y) (x and y are the 2-D coordinates of the element).
     //!
-    //! \see Array<T, 2>::at
+    //! \see Array<T, 2, Allocator>::at
     //!
     T& operator[](size_t i);
 
@@ -322,7 +322,7 @@ class Array<T, 2> final
     //! array where i is the index of linearly mapped elements such that
     //! i = x + (width * y) (x and y are the 2-D coordinates of the element).
     //!
-    //! \see Array<T, 2>::at
+    //! \see Array<T, 2, Allocator>::at
     //!
     const T& operator[](size_t i) const;
 
@@ -377,12 +377,12 @@ class Array<T, 2> final
 
  private:
     Size2 m_size;
-    std::vector<T> m_data;
+    ContainerType m_data;
 };
 
 //! Type alias for 2-D array.
-template <typename T>
-using Array2 = Array<T, 2>;
+template <typename T, typename Allocator = std::allocator<T>>
+using Array2 = Array<T, 2, Allocator>;
 }  // namespace CubbyFlow
 
 #include <Core/Array/Array2-Impl.hpp>
@@ -16,56 +16,59 @@
 
 namespace CubbyFlow
 {
-template <typename T>
-Array<T, 3>::Array(const Size3& size, const T& initVal)
+template <typename T, typename Allocator>
+Array<T, 3, Allocator>::Array(const Size3& size, const T& initVal)
 {
     Resize(size, initVal);
 }
 
-template <typename T>
-Array<T, 3>::Array(size_t width, size_t height, size_t depth, const T& initVal)
+template <typename T, typename Allocator>
+Array<T, 3, Allocator>::Array(size_t width, size_t height, size_t depth, const T& initVal)
 {
     Resize(width, height, depth, initVal);
 }
 
-template <typename T>
-Array<T, 3>::Array(const std::initializer_list<
+template <typename T, typename Allocator>
+Array<T, 3, Allocator>::Array(const std::initializer_list<
                    std::initializer_list<std::initializer_list<T>>>& list)
 {
     Set(list);
 }
 
-template <typename T>
-Array<T, 3>::Array(const Array& other)
+template <typename T, typename Allocator>
+Array<T, 3, Allocator>::Array(const Array& other)
 {
     Set(other);
 }
 
-template <typename T>
-Array<T, 3>::Array(Array&& other) noexcept
+template <typename T, typename Allocator>
+Array<T, 3, Allocator>::Array(Array&& other) noexcept
 {
     *this = std::move(other);
 }
 
-template <typename T>
-void Array<T, 3>::Set(const T& value)
+template <typename T, typename Allocator>
+void Array<T, 3, Allocator>::Set(const T& value)
 {
-    for (auto& v : m_data)
+    Detach();
+
+    for (auto& v : *m_data)
     {
         v = value;
     }
 }
 
-template <typename T>
-void Array<T, 3>::Set(const Array& other)
+template <typename T, typename Allocator>
+void Array<T, 3, Allocator>::Set(const Array& other)
 {
-    m_data.resize(other.m_data.size());
-    std::copy(other.m_data.begin(), other.m_data.end(), m_data.begin());
+    // Share the buffer; the element copy is deferred until either array is
+    // accessed for writing.
+    m_data = other.m_data;
     m_size = other.m_size;
 }
 
-template <typename T>
-void Array<T, 3>::Set(const std::initializer_list<
+template <typename T, typename Allocator>
+void Array<T, 3, Allocator>::Set(const std::initializer_list<
                       std::initializer_list<std::initializer_list<T>>>& list)
 {
     const size_t depth = list.size();
@@ -96,31 +99,40 @@ void Array<T, 3>::Set(const std::initializer_list<
     }
 }
 
-template <typename T>
-void Array<T, 3>::Clear()
+template <typename T, typename Allocator>
+void Array<T, 3, Allocator>::Clear()
 {
     m_size = Size3(0, 0, 0);
-    m_data.clear();
+    m_data = std::make_shared<ContainerType>();
 }
 
-template <typename T>
-void Array<T, 3>::Resize(const Size3& size, const T& initVal)
+template <typename T, typename Allocator>
+void Array<T, 3, Allocator>::Resize(const Size3& size, const T& initVal)
 {
+    // Same-shape resizes keep the existing storage; the copy below would
+    // reproduce the current content anyway.
+    if (size == m_size)
+    {
+        return;
+    }
+
     Array grid;
-    grid.m_data.resize(size.x * size.y * size.z, initVal);
+    grid.m_data->resize(size.x * size.y * size.z, initVal);
     grid.m_size = size;
 
     const size_t iMin = std::min(size.x, m_size.x);
     const size_t jMin = std::min(size.y, m_size.y);
     const size_t kMin = std::min(size.z, m_size.z);
 
+    const ConstArrayAccessor3<T> src = ConstAccessor();
+
     for (size_t k = 0; k < kMin; ++k)
     {
         for (size_t j = 0; j < jMin; ++j)
         {
             for (size_t i = 0; i < iMin; ++i)
             {
-                grid(i, j, k) = At(i, j, k);
+                grid(i, j, k) = src(i, j, k);
             }
         }
     }
@@ -128,225 +140,257 @@ void Array<T, 3>::Resize(const Size3& size, const T& initVal)
     Swap(grid);
 }
 
-template <typename T>
-void Array<T, 3>::Resize(size_t width, size_t height, size_t depth,
+template <typename T, typename Allocator>
+void Array<T, 3, Allocator>::Resize(size_t width, size_t height, size_t depth,
                          const T& initVal)
 {
     Resize(Size3(width, height, depth), initVal);
 }
 
-template <typename T>
-T& Array<T, 3>::At(size_t i)
+template <typename T, typename Allocator>
+T& Array<T, 3, Allocator>::At(size_t i)
 {
     assert(i < Width() * Height() * Depth());
-    return m_data[i];
+    Detach();
+    return (*m_data)[i];
 }
 
-template <typename T>
-const T& Array<T, 3>::At(size_t i) const
+template <typename T, typename Allocator>
+const T& Array<T, 3, Allocator>::At(size_t i) const
 {
     assert(i < Width() * Height() * Depth());
-    return m_data[i];
+    return (*m_data)[i];
 }
 
-template <typename T>
-T& Array<T, 3>::At(const Point3UI& pt)
+template <typename T, typename Allocator>
+T& Array<T, 3, Allocator>::At(const Point3UI& pt)
 {
     return At(pt.x, pt.y, pt.z);
 }
 
-template <typename T>
-const T& Array<T, 3>::At(const Point3UI& pt) const
+template <typename T, typename Allocator>
+const T& Array<T, 3, Allocator>::At(const Point3UI& pt) const
 {
     return At(pt.x, pt.y, pt.z);
 }
 
-template <typename T>
-T& Array<T, 3>::At(size_t i, size_t j, size_t k)
+template <typename T, typename Allocator>
+T& Array<T, 3, Allocator>::At(size_t i, size_t j, size_t k)
 {
     assert(i < Width() && j < Height() && k < Depth());
-    return m_data[i + Width() * j + Width() * Height() * k];
+    Detach();
+    return (*m_data)[i + Width() * j + Width() * Height() * k];
 }
 
-template <typename T>
-const T& Array<T, 3>::At(size_t i, size_t j, size_t k) const
+template <typename T, typename Allocator>
+const T& Array<T, 3, Allocator>::At(size_t i, size_t j, size_t k) const
 {
     assert(i < Width() && j < Height() && k < Depth());
-    return m_data[i + Width() * j + Width() * Height() * k];
+    return (*m_data)[i + Width() * j + Width() * Height() * k];
 }
 
-template <typename T>
-Size3 Array<T, 3>::size() const
+template <typename T, typename Allocator>
+Size3 Array<T, 3, Allocator>::size() const
 {
     return m_size;
 }
 
-template <typename T>
-size_t Array<T, 3>::Width() const
+template <typename T, typename Allocator>
+size_t Array<T, 3, Allocator>::Width() const
 {
     return m_size.x;
 }
 
-template <typename T>
-size_t Array<T, 3>::Height() const
+template <typename T, typename Allocator>
+size_t Array<T, 3, Allocator>::Height() const
 {
     return m_size.y;
 }
 
-template <typename T>
-size_t Array<T, 3>::Depth() const
+template <typename T, typename Allocator>
+size_t Array<T, 3, Allocator>::Depth() const
 {
     return m_size.z;
 }
 
-template <typename T>
-T* Array<T, 3>::data()
+template <typename T, typename Allocator>
+T* Array<T, 3, Allocator>::data()
 {
-    return m_data.data();
+    Detach();
+    return m_data->data();
 }
 
-template <typename T>
-const T* Array<T, 3>::data() const
+template <typename T, typename Allocator>
+const T* Array<T, 3, Allocator>::data() const
 {
-    return m_data.data();
+    return m_data->data();
 }
 
-template <typename T>
-typename Array<T, 3>::ContainerType::iterator Array<T, 3>::begin()
+template <typename T, typename Allocator>
+typename Array<T, 3, Allocator>::ContainerType::iterator Array<T, 3, Allocator>::begin()
 {
-    return m_data.begin();
+    Detach();
+    return m_data->begin();
 }
 
-template <typename T>
-typename Array<T, 3>::ContainerType::const_iterator Array<T, 3>::begin() const
+template <typename T, typename Allocator>
+typename Array<T, 3, Allocator>::ContainerType::const_iterator Array<T, 3, Allocator>::begin() const
 {
-    return m_data.cbegin();
+    return m_data->cbegin();
 }
 
-template <typename T>
-typename Array<T, 3>::ContainerType::iterator Array<T, 3>::end()
+template <typename T, typename Allocator>
+typename Array<T, 3, Allocator>::ContainerType::iterator Array<T, 3, Allocator>::end()
 {
-    return m_data.end();
+    Detach();
+    return m_data->end();
 }
 
-template <typename T>
-typename Array<T, 3>::ContainerType::const_iterator Array<T, 3>::end() const
+template <typename T, typename Allocator>
+typename Array<T, 3, Allocator>::ContainerType::const_iterator Array<T, 3, Allocator>::end() const
 {
-    return m_data.cend();
+    return m_data->cend();
 }
 
-template <typename T>
-ArrayAccessor3<T> Array<T, 3>::Accessor()
+template <typename T, typename Allocator>
+ArrayAccessor3<T> Array<T, 3, Allocator>::Accessor()
 {
     return ArrayAccessor3<T>(size(), data());
 }
 
-template <typename T>
-ConstArrayAccessor3<T> Array<T, 3>::ConstAccessor() const
+template <typename T, typename Allocator>
+ConstArrayAccessor3<T> Array<T, 3, Allocator>::ConstAccessor() const
 {
     return ConstArrayAccessor3<T>(size(), data());
 }
 
-template <typename T>
-void Array<T, 3>::Swap(Array& other)
+template <typename T, typename Allocator>
+void Array<T, 3, Allocator>::Swap(Array& other)
 {
     std::swap(other.m_data, m_data);
     std::swap(other.m_size, m_size);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 3>::ForEach(Callback func) const
+void Array<T, 3, Allocator>::ForEach(Callback func) const
 {
     ConstAccessor().ForEach(func);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 3>::ForEachIndex(Callback func) const
+void Array<T, 3, Allocator>::ForEachIndex(Callback func) const
 {
     ConstAccessor().ForEachIndex(func);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 3>::ParallelForEach(Callback func)
+void Array<T, 3, Allocator>::ParallelForEach(Callback func)
 {
     Accessor().ParallelForEach(func);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename Callback>
-void Array<T, 3>::ParallelForEachIndex(Callback func) const
+void Array<T, 3, Allocator>::ParallelForEachIndex(Callback func) const
 {
     ConstAccessor().ParallelForEachIndex(func);
 }
 
-template <typename T>
-T& Array<T, 3>::operator[](size_t i)
+template <typename T, typename Allocator>
+template <typename Callback>
+void Array<T, 3, Allocator>::TiledForEachIndex(Callback func,
+                                               size_t tileSize) const
+{
+    ConstAccessor().TiledForEachIndex(func, tileSize);
+}
+
+template <typename T, typename Allocator>
+template <typename Callback>
+void Array<T, 3, Allocator>::ParallelTiledForEachIndex(Callback func,
+                                                       size_t tileSize) const
+{
+    ConstAccessor().ParallelTiledForEachIndex(func, tileSize);
+}
+
+template <typename T, typename Allocator>
+template <typename Callback>
+void Array<T, 3, Allocator>::MortonForEachIndex(Callback func) const
+{
+    ConstAccessor().MortonForEachIndex(func);
+}
+
+template <typename T, typename Allocator>
+T& Array<T, 3, Allocator>::operator[](size_t i)
 {
-    return m_data[i];
+    Detach();
+    return (*m_data)[i];
 }
 
-template <typename T>
-const T& Array<T, 3>::operator[](size_t i) const
+template <typename T, typename Allocator>
+const T& Array<T, 3, Allocator>::operator[](size_t i) const
 {
-    return m_data[i];
+    return (*m_data)[i];
 }
 
-template <typename T>
-T& Array<T, 3>::operator()(size_t i, size_t j, size_t k)
+template <typename T, typename Allocator>
+T& Array<T, 3, Allocator>::operator()(size_t i, size_t j, size_t k)
 {
     assert(i < Width() && j < Height() && k < Depth());
-    return m_data[i + Width() * j + Width() * Height() * k];
+    Detach();
+    return (*m_data)[i + Width() * j + Width() * Height() * k];
 }
 
-template <typename T>
-const T& Array<T, 3>::operator()(size_t i, size_t j, size_t k) const
+template <typename T, typename Allocator>
+const T& Array<T, 3, Allocator>::operator()(size_t i, size_t j, size_t k) const
 {
     assert(i < Width() && j < Height() && k < Depth());
-    return m_data[i + Width() * j + Width() * Height() * k];
+    return (*m_data)[i + Width() * j + Width() * Height() * k];
 }
 
-template <typename T>
-T& Array<T, 3>::operator()(const Point3UI& pt)
+template <typename T, typename Allocator>
+T& Array<T, 3, Allocator>::operator()(const Point3UI& pt)
 {
     assert(pt.x < Width() && pt.y < Height() && pt.z < Depth());
-    return m_data[pt.x + Width() * pt.y + Width() * Height() * pt.z];
+    Detach();
+    return (*m_data)[pt.x + Width() * pt.y + Width() * Height() * pt.z];
 }
 
-template <typename T>
-const T& Array<T, 3>::operator()(const Point3UI& pt) const
+template <typename T, typename Allocator>
+const T& Array<T, 3, Allocator>::operator()(const Point3UI& pt) const
 {
     assert(pt.x < Width() && pt.y < Height() && pt.z < Depth());
-    return m_data[pt.x + Width() * pt.y + Width() * Height() * pt.z];
+    return (*m_data)[pt.x + Width() * pt.y + Width() * Height() * pt.z];
 }
 
-template <typename T>
-Array<T, 3>& Array<T, 3>::operator=(const T& value)
+template <typename T, typename Allocator>
+Array<T, 3, Allocator>& Array<T, 3, Allocator>::operator=(const T& value)
 {
     Set(value);
     return *this;
 }
 
-template <typename T>
-Array<T, 3>& Array<T, 3>::operator=(const Array& other)
+template <typename T, typename Allocator>
+Array<T, 3, Allocator>& Array<T, 3, Allocator>::operator=(const Array& other)
 {
     Set(other);
     return *this;
 }
 
-template <typename T>
-Array<T, 3>& Array<T, 3>::operator=(Array&& other) noexcept
+template <typename T, typename Allocator>
+Array<T, 3, Allocator>& Array<T, 3, Allocator>::operator=(Array&& other) noexcept
 {
     m_data = std::move(other.m_data);
     m_size = other.m_size;
+    other.m_data = std::make_shared<ContainerType>();
     other.m_size = Size3();
     return *this;
 }
 
-template <typename T>
-Array<T, 3>& Array<T, 3>::operator=(
+template <typename T, typename Allocator>
+Array<T, 3, Allocator>& Array<T, 3, Allocator>::operator=(
     const std::initializer_list<
         std::initializer_list<std::initializer_list<T>>>& list)
 {
@@ -354,17 +398,26 @@ Array<T, 3>& Array<T, 3>::operator=(
     return *this;
 }
 
-template <typename T>
-Array<T, 3>::operator ArrayAccessor3<T>()
+template <typename T, typename Allocator>
+Array<T, 3, Allocator>::operator ArrayAccessor3<T>()
 {
     return Accessor();
 }
 
-template <typename T>
-Array<T, 3>::operator ConstArrayAccessor3<T>() const
+template <typename T, typename Allocator>
+Array<T, 3, Allocator>::operator ConstArrayAccessor3<T>() const
 {
     return ConstAccessor();
 }
+
+template <typename T, typename Allocator>
+void Array<T, 3, Allocator>::Detach()
+{
+    if (m_data.use_count() > 1)
+    {
+        m_data = std::make_shared<ContainerType>(*m_data);
+    }
+}
 }  // namespace CubbyFlow
 
 #endif
\ No newline at end of file
@@ -13,8 +13,10 @@
 
 #include <Core/Array/Array.hpp>
 #include <Core/Array/ArrayAccessor3.hpp>
+#include <Core/Array/CacheAlignedAllocator.hpp>
 #include <Core/Geometry/Size3.hpp>
 
+#include <memory>
 #include <vector>
 
 namespace CubbyFlow
@@ -41,13 +43,21 @@ namespace CubbyFlow
 //! }
 //! \endcode
 //!
+//! The element storage is shared copy-on-write: copying an array (or a grid
+//! built on top of one) only shares the buffer, and the actual element copy is
+//! deferred until one of the sharing arrays is accessed for writing. Any
+//! mutating member, including Accessor() and the non-const data(), detaches
+//! the buffer first. Note that raw pointers, iterators, and accessors acquired
+//! \b before a copy was taken keep pointing at the previously shared buffer
+//! and bypass the write fault; acquire them again after copying.
+//!
 //! \tparam T - Type to store in the array.
 //!
-template <typename T>
-class Array<T, 3> final
+template <typename T, typename Allocator>
+class Array<T, 3, Allocator> final
 {
  public:
-    using ContainerType = std::vector<T>;
+    using ContainerType = std::vector<T, Allocator>;
     using Iterator = typename ContainerType::iterator;
     using ConstIterator = typename ContainerType::const_iterator;
 
@@ -110,7 +120,8 @@ class Array<T, 3> final
     //! Sets entire array with given \p value.
     void Set(const T& value);
 
-    //! Copies given array \p other to this array.
+    //! Copies given array \p other to this array. The element buffer is
+    //! shared copy-on-write, so this is O(1) until one side is written to.
     void Set(const Array& other);
 
     //!
@@ -339,6 +350,49 @@ class Array<T, 3> final
     template <typename Callback>
     void ParallelForEachIndex(Callback func) const;
 
+    //!
+    //! \brief Iterates the array tile by tile and invoke given \p func for
+    //!     each index.
+    //!
+    //! This function visits the same indices as ForEachIndex, but traverses
+    //! the array in cubic tiles (see ParallelTiledFor) instead of flat ijk
+    //! order. Stencil kernels that touch neighboring elements can opt into
+    //! this traversal for better cache locality:
+    //!
+    //! \code{.cpp}
+    //! Array<int, 3> array(100, 200, 150, 4);
+    //! array.TiledForEachIndex([&](size_t i, size_t j, size_t k)
+    //! {
+    //!     array(i, j, k) *= 2;
+    //! });
+    //! \endcode
+    //!
+    template <typename Callback>
+    void TiledForEachIndex(Callback func, size_t tileSize = 8) const;
+
+    //!
+    //! \brief Iterates the array tile by tile and invoke given \p func for
+    //!     each index in parallel using multi-threading.
+    //!
+    //! This function behaves like ParallelForEachIndex, but traverses the
+    //! array in cubic tiles (see ParallelTiledFor) so each thread keeps its
+    //! stencil working set in cache. The order of execution will be
+    //! non-deterministic since it runs in parallel.
+    //!
+    template <typename Callback>
+    void ParallelTiledForEachIndex(Callback func, size_t tileSize = 8) const;
+
+    //!
+    //! \brief Iterates the array in Morton (Z-curve) order and invoke given
+    //!     \p func for each index.
+    //!
+    //! This function visits the same indices as ForEachIndex, but follows the
+    //! Morton space-filling curve (see ParallelMortonFor) so successively
+    //! visited indices stay close together in all three dimensions.
+    //!
+    template <typename Callback>
+    void MortonForEachIndex(Callback func) const;
+
     //!
     //! \brief Returns the reference to the i-th element.
     //!
@@ -420,14 +474,26 @@ class Array<T, 3> final
     //! Casts to const array accessor.
     operator ConstArrayAccessor3<T>() const;
 
+    //!
+    //! \brief Makes the shared buffer unique to this array.
+    //!
+    //! Copies the elements if another array still references them. Every
+    //! mutating member calls this implicitly; call it explicitly to force
+    //! the deep copy up front, e.g. when the copied-from array is about to
+    //! be written to from multiple threads.
+    //!
+    void Detach();
+
  private:
     Size3 m_size;
-    std::vector<T> m_data;
+    std::shared_ptr<ContainerType> m_data = std::make_shared<ContainerType>();
 };
 
-//! Type alias for 3-D array.
-template <typename T>
-using Array3 = Array<T, 3>;
+//! Type alias for 3-D array. Storage is cache-line aligned by default so
+//! that vectorized stencil sweeps never split loads across line boundaries
+//! at the buffer base; see CacheAlignedAllocator.
+template <typename T, typename Allocator = CacheAlignedAllocator<T>>
+using Array3 = Array<T, 3, Allocator>;
 }  // namespace CubbyFlow
 
 #include <Core/Array/Array3-Impl.hpp>
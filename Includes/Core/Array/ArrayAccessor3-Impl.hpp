@@ -219,6 +219,32 @@ void ArrayAccessor<T, 3>::ParallelForEachIndex(Callback func) const
                 func);
 }
 
+template <typename T>
+template <typename Callback>
+void ArrayAccessor<T, 3>::TiledForEachIndex(Callback func,
+                                            size_t tileSize) const
+{
+    ParallelTiledFor(ZERO_SIZE, Width(), ZERO_SIZE, Height(), ZERO_SIZE,
+                     Depth(), func, tileSize, ExecutionPolicy::Serial);
+}
+
+template <typename T>
+template <typename Callback>
+void ArrayAccessor<T, 3>::ParallelTiledForEachIndex(Callback func,
+                                                    size_t tileSize) const
+{
+    ParallelTiledFor(ZERO_SIZE, Width(), ZERO_SIZE, Height(), ZERO_SIZE,
+                     Depth(), func, tileSize);
+}
+
+template <typename T>
+template <typename Callback>
+void ArrayAccessor<T, 3>::MortonForEachIndex(Callback func) const
+{
+    ParallelMortonFor(ZERO_SIZE, Width(), ZERO_SIZE, Height(), ZERO_SIZE,
+                      Depth(), func, ExecutionPolicy::Serial);
+}
+
 template <typename T>
 size_t ArrayAccessor<T, 3>::Index(const Point3UI& pt) const
 {
@@ -437,6 +463,32 @@ void ConstArrayAccessor<T, 3>::ParallelForEachIndex(Callback func) const
                 func);
 }
 
+template <typename T>
+template <typename Callback>
+void ConstArrayAccessor<T, 3>::TiledForEachIndex(Callback func,
+                                                 size_t tileSize) const
+{
+    ParallelTiledFor(ZERO_SIZE, Width(), ZERO_SIZE, Height(), ZERO_SIZE,
+                     Depth(), func, tileSize, ExecutionPolicy::Serial);
+}
+
+template <typename T>
+template <typename Callback>
+void ConstArrayAccessor<T, 3>::ParallelTiledForEachIndex(Callback func,
+                                                         size_t tileSize) const
+{
+    ParallelTiledFor(ZERO_SIZE, Width(), ZERO_SIZE, Height(), ZERO_SIZE,
+                     Depth(), func, tileSize);
+}
+
+template <typename T>
+template <typename Callback>
+void ConstArrayAccessor<T, 3>::MortonForEachIndex(Callback func) const
+{
+    ParallelMortonFor(ZERO_SIZE, Width(), ZERO_SIZE, Height(), ZERO_SIZE,
+                      Depth(), func, ExecutionPolicy::Serial);
+}
+
 template <typename T>
 size_t ConstArrayAccessor<T, 3>::Index(const Point3UI& pt) const
 {
@@ -224,6 +224,47 @@ class ArrayAccessor<T, 3> final
     template <typename Callback>
     void ParallelForEachIndex(Callback func) const;
 
+    //!
+    //! \brief Iterates the array tile by tile and invoke given \p func for
+    //!     each index.
+    //!
+    //! This function visits the same indices as ForEachIndex, but traverses
+    //! the array in cubic tiles (see ParallelTiledFor) instead of flat ijk
+    //! order. Stencil kernels that touch neighboring elements can opt into
+    //! this traversal for better cache locality:
+    //!
+    //! \code{.cpp}
+    //! acc.TiledForEachIndex([&](size_t i, size_t j, size_t k) {
+    //!     acc(i, j, k) *= 2;
+    //! });
+    //! \endcode
+    //!
+    template <typename Callback>
+    void TiledForEachIndex(Callback func, size_t tileSize = 8) const;
+
+    //!
+    //! \brief Iterates the array tile by tile and invoke given \p func for
+    //!     each index in parallel using multi-threading.
+    //!
+    //! This function behaves like ParallelForEachIndex, but traverses the
+    //! array in cubic tiles (see ParallelTiledFor) so each thread keeps its
+    //! stencil working set in cache. The order of execution will be
+    //! non-deterministic since it runs in parallel.
+    //!
+    template <typename Callback>
+    void ParallelTiledForEachIndex(Callback func, size_t tileSize = 8) const;
+
+    //!
+    //! \brief Iterates the array in Morton (Z-curve) order and invoke given
+    //!     \p func for each index.
+    //!
+    //! This function visits the same indices as ForEachIndex, but follows the
+    //! Morton space-filling curve (see ParallelMortonFor) so successively
+    //! visited indices stay close together in all three dimensions.
+    //!
+    template <typename Callback>
+    void MortonForEachIndex(Callback func) const;
+
     //! Returns the linear index of the given 3-D coordinate (pt.x, pt.y, pt.z).
     [[nodiscard]] size_t Index(const Point3UI& pt) const;
 
@@ -426,6 +467,40 @@ class ConstArrayAccessor<T, 3>
     template <typename Callback>
     void ParallelForEachIndex(Callback func) const;
 
+    //!
+    //! \brief Iterates the array tile by tile and invoke given \p func for
+    //!     each index.
+    //!
+    //! This function visits the same indices as ForEachIndex, but traverses
+    //! the array in cubic tiles (see ParallelTiledFor) instead of flat ijk
+    //! order, which keeps stencil working sets in cache.
+    //!
+    template <typename Callback>
+    void TiledForEachIndex(Callback func, size_t tileSize = 8) const;
+
+    //!
+    //! \brief Iterates the array tile by tile and invoke given \p func for
+    //!     each index in parallel using multi-threading.
+    //!
+    //! This function behaves like ParallelForEachIndex, but traverses the
+    //! array in cubic tiles (see ParallelTiledFor) so each thread keeps its
+    //! stencil working set in cache. The order of execution will be
+    //! non-deterministic since it runs in parallel.
+    //!
+    template <typename Callback>
+    void ParallelTiledForEachIndex(Callback func, size_t tileSize = 8) const;
+
+    //!
+    //! \brief Iterates the array in Morton (Z-curve) order and invoke given
+    //!     \p func for each index.
+    //!
+    //! This function visits the same indices as ForEachIndex, but follows the
+    //! Morton space-filling curve (see ParallelMortonFor) so successively
+    //! visited indices stay close together in all three dimensions.
+    //!
+    template <typename Callback>
+    void MortonForEachIndex(Callback func) const;
+
     //! Returns the linear index of the given 3-D coordinate (pt.x, pt.y, pt.z).
     [[nodiscard]] size_t Index(const Point3UI& pt) const;
 
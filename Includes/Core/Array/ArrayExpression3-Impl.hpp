@@ -0,0 +1,214 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_ARRAY_EXPRESSION3_IMPL_HPP
+#define CUBBYFLOW_ARRAY_EXPRESSION3_IMPL_HPP
+
+#include <cassert>
+
+namespace CubbyFlow
+{
+template <typename T, typename E>
+Size3 ArrayExpression3<T, E>::size() const
+{
+    return static_cast<const E&>(*this).size();
+}
+
+template <typename T, typename E>
+const E& ArrayExpression3<T, E>::operator()() const
+{
+    return static_cast<const E&>(*this);
+}
+
+template <typename T>
+ArrayConstant3<T>::ArrayConstant3(const Size3& size, const T& c)
+    : m_size(size), m_c{ c }
+{
+    // Do nothing
+}
+
+template <typename T>
+Size3 ArrayConstant3<T>::size() const
+{
+    return m_size;
+}
+
+template <typename T>
+T ArrayConstant3<T>::operator()(size_t, size_t, size_t) const
+{
+    return m_c;
+}
+
+template <typename T>
+ArrayInput3<T>::ArrayInput3(const ConstArrayAccessor3<T>& accessor)
+    : m_accessor{ accessor }
+{
+    // Do nothing
+}
+
+template <typename T>
+Size3 ArrayInput3<T>::size() const
+{
+    return m_accessor.size();
+}
+
+template <typename T>
+T ArrayInput3<T>::operator()(size_t i, size_t j, size_t k) const
+{
+    return m_accessor(i, j, k);
+}
+
+template <typename T, typename E, typename Op>
+ArrayUnaryOp3<T, E, Op>::ArrayUnaryOp3(const E& u) : m_u{ u }
+{
+    // Do nothing
+}
+
+template <typename T, typename E, typename Op>
+Size3 ArrayUnaryOp3<T, E, Op>::size() const
+{
+    return m_u.size();
+}
+
+template <typename T, typename E, typename Op>
+T ArrayUnaryOp3<T, E, Op>::operator()(size_t i, size_t j, size_t k) const
+{
+    return m_op(m_u(i, j, k));
+}
+
+template <typename T, typename E1, typename E2, typename Op>
+ArrayBinaryOp3<T, E1, E2, Op>::ArrayBinaryOp3(const E1& u, const E2& v)
+    : m_u{ u }, m_v{ v }
+{
+    assert(u.size() == v.size());
+}
+
+template <typename T, typename E1, typename E2, typename Op>
+Size3 ArrayBinaryOp3<T, E1, E2, Op>::size() const
+{
+    return m_v.size();
+}
+
+template <typename T, typename E1, typename E2, typename Op>
+T ArrayBinaryOp3<T, E1, E2, Op>::operator()(size_t i, size_t j, size_t k) const
+{
+    return m_op(m_u(i, j, k), m_v(i, j, k));
+}
+
+template <typename T, typename E, typename Op>
+ArrayScalarBinaryOp3<T, E, Op>::ArrayScalarBinaryOp3(const E& u, const T& v)
+    : m_u{ u }, m_v{ v }
+{
+    // Do nothing
+}
+
+template <typename T, typename E, typename Op>
+Size3 ArrayScalarBinaryOp3<T, E, Op>::size() const
+{
+    return m_u.size();
+}
+
+template <typename T, typename E, typename Op>
+T ArrayScalarBinaryOp3<T, E, Op>::operator()(size_t i, size_t j,
+                                             size_t k) const
+{
+    return m_op(m_u(i, j, k), m_v);
+}
+
+template <typename T, typename E>
+ArrayScalarAdd3<T, E> operator+(const T& a, const ArrayExpression3<T, E>& b)
+{
+    return ArrayScalarAdd3<T, E>{ b(), a };
+}
+
+template <typename T, typename E>
+ArrayScalarAdd3<T, E> operator+(const ArrayExpression3<T, E>& a, const T& b)
+{
+    return ArrayScalarAdd3<T, E>{ a(), b };
+}
+
+template <typename T, typename E1, typename E2>
+ArrayAdd3<T, E1, E2> operator+(const ArrayExpression3<T, E1>& a,
+                               const ArrayExpression3<T, E2>& b)
+{
+    return ArrayAdd3<T, E1, E2>{ a(), b() };
+}
+
+template <typename T, typename E>
+ArrayScalarRSub3<T, E> operator-(const T& a, const ArrayExpression3<T, E>& b)
+{
+    return ArrayScalarRSub3<T, E>{ b(), a };
+}
+
+template <typename T, typename E>
+ArrayScalarSub3<T, E> operator-(const ArrayExpression3<T, E>& a, const T& b)
+{
+    return ArrayScalarSub3<T, E>{ a(), b };
+}
+
+template <typename T, typename E1, typename E2>
+ArraySub3<T, E1, E2> operator-(const ArrayExpression3<T, E1>& a,
+                               const ArrayExpression3<T, E2>& b)
+{
+    return ArraySub3<T, E1, E2>{ a(), b() };
+}
+
+template <typename T, typename E>
+ArrayScalarMul3<T, E> operator*(const T& a, const ArrayExpression3<T, E>& b)
+{
+    return ArrayScalarMul3<T, E>{ b(), a };
+}
+
+template <typename T, typename E>
+ArrayScalarMul3<T, E> operator*(const ArrayExpression3<T, E>& a, const T& b)
+{
+    return ArrayScalarMul3<T, E>{ a(), b };
+}
+
+template <typename T, typename E1, typename E2>
+ArrayMul3<T, E1, E2> operator*(const ArrayExpression3<T, E1>& a,
+                               const ArrayExpression3<T, E2>& b)
+{
+    return ArrayMul3<T, E1, E2>{ a(), b() };
+}
+
+template <typename T, typename E>
+ArrayScalarRDiv3<T, E> operator/(const T& a, const ArrayExpression3<T, E>& b)
+{
+    return ArrayScalarRDiv3<T, E>{ b(), a };
+}
+
+template <typename T, typename E>
+ArrayScalarDiv3<T, E> operator/(const ArrayExpression3<T, E>& a, const T& b)
+{
+    return ArrayScalarDiv3<T, E>{ a(), b };
+}
+
+template <typename T, typename E1, typename E2>
+ArrayDiv3<T, E1, E2> operator/(const ArrayExpression3<T, E1>& a,
+                               const ArrayExpression3<T, E2>& b)
+{
+    return ArrayDiv3<T, E1, E2>{ a(), b() };
+}
+
+template <typename T, typename E>
+void ParallelEvaluate(const ArrayExpression3<T, E>& expression,
+                      ArrayAccessor3<T> output)
+{
+    const E& expr = expression();
+
+    assert(expr.size() == output.size());
+
+    output.ParallelForEachIndex(
+        [&](size_t i, size_t j, size_t k) { output(i, j, k) = expr(i, j, k); });
+}
+}  // namespace CubbyFlow
+
+#endif
@@ -0,0 +1,293 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_ARRAY_EXPRESSION3_HPP
+#define CUBBYFLOW_ARRAY_EXPRESSION3_HPP
+
+#include <Core/Array/ArrayAccessor3.hpp>
+#include <Core/Geometry/Size3.hpp>
+#include <Core/Utils/Functors.hpp>
+
+#include <functional>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Base class for 3-D array expression.
+//!
+//! Array expression is a meta type that enables template expression pattern
+//! for elementwise operations on 3-D grid data, so that a chain like
+//! v = v + dt * f evaluates in a single pass over the array instead of one
+//! pass per operation.
+//!
+//! \tparam T  Real number type.
+//! \tparam E  Subclass type.
+//!
+template <typename T, typename E>
+class ArrayExpression3
+{
+ public:
+    //! Size of the array.
+    [[nodiscard]] Size3 size() const;
+
+    //! Returns actual implementation (the subclass).
+    const E& operator()() const;
+};
+
+//!
+//! \brief Constant 3-D array expression.
+//!
+//! This array expression represents an array filled with a constant.
+//!
+//! \tparam T  Real number type.
+//!
+template <typename T>
+class ArrayConstant3 : public ArrayExpression3<T, ArrayConstant3<T>>
+{
+ public:
+    //! Constructs constant array expression with given size and value.
+    ArrayConstant3(const Size3& size, const T& c);
+
+    //! Size of the array.
+    [[nodiscard]] Size3 size() const;
+
+    //! Returns array element at (i, j, k).
+    T operator()(size_t i, size_t j, size_t k) const;
+
+ private:
+    Size3 m_size;
+    T m_c;
+};
+
+//!
+//! \brief 3-D array expression reading from an array accessor.
+//!
+//! This is the leaf of an expression tree. The accessor is stored by value,
+//! so the expression stays valid as long as the underlying array does.
+//!
+//! \tparam T  Real number type.
+//!
+template <typename T>
+class ArrayInput3 : public ArrayExpression3<T, ArrayInput3<T>>
+{
+ public:
+    //! Constructs input expression for given array accessor.
+    ArrayInput3(const ConstArrayAccessor3<T>& accessor);
+
+    //! Size of the array.
+    [[nodiscard]] Size3 size() const;
+
+    //! Returns array element at (i, j, k).
+    T operator()(size_t i, size_t j, size_t k) const;
+
+ private:
+    ConstArrayAccessor3<T> m_accessor;
+};
+
+//!
+//! \brief 3-D array expression for unary operation.
+//!
+//! This array expression represents an unary operation that takes single
+//! input array expression.
+//!
+//! \tparam T   Real number type.
+//! \tparam E   Input expression type.
+//! \tparam Op  Unary operation.
+//!
+template <typename T, typename E, typename Op>
+class ArrayUnaryOp3 : public ArrayExpression3<T, ArrayUnaryOp3<T, E, Op>>
+{
+ public:
+    //! Constructs unary operation expression for given input expression.
+    ArrayUnaryOp3(const E& u);
+
+    //! Size of the array.
+    [[nodiscard]] Size3 size() const;
+
+    //! Returns array element at (i, j, k).
+    T operator()(size_t i, size_t j, size_t k) const;
+
+ private:
+    const E& m_u;
+    Op m_op;
+};
+
+//! Matrix expression for type casting.
+template <typename T, typename E, typename U>
+using ArrayTypeCast3 = ArrayUnaryOp3<T, E, TypeCast<U, T>>;
+
+//!
+//! \brief 3-D array expression for binary operation.
+//!
+//! This array expression represents a binary operation that takes two input
+//! array expressions.
+//!
+//! \tparam T   Real number type.
+//! \tparam E1  First input expression type.
+//! \tparam E2  Second input expression type.
+//! \tparam Op  Binary operation.
+//!
+template <typename T, typename E1, typename E2, typename Op>
+class ArrayBinaryOp3 : public ArrayExpression3<T, ArrayBinaryOp3<T, E1, E2, Op>>
+{
+ public:
+    //! Constructs binary operation expression for given input expressions.
+    ArrayBinaryOp3(const E1& u, const E2& v);
+
+    //! Size of the array.
+    [[nodiscard]] Size3 size() const;
+
+    //! Returns array element at (i, j, k).
+    T operator()(size_t i, size_t j, size_t k) const;
+
+ private:
+    const E1& m_u;
+    const E2& m_v;
+    Op m_op;
+};
+
+//!
+//! \brief 3-D array expression for binary operation with a scalar.
+//!
+//! This array expression represents a binary operation that takes one input
+//! array expression and one scalar.
+//!
+//! \tparam T   Real number type.
+//! \tparam E   Input expression type.
+//! \tparam Op  Binary operation.
+//!
+template <typename T, typename E, typename Op>
+class ArrayScalarBinaryOp3
+    : public ArrayExpression3<T, ArrayScalarBinaryOp3<T, E, Op>>
+{
+ public:
+    //! Constructs a binary expression for given array and scalar.
+    ArrayScalarBinaryOp3(const E& u, const T& v);
+
+    //! Size of the array.
+    [[nodiscard]] Size3 size() const;
+
+    //! Returns array element at (i, j, k).
+    T operator()(size_t i, size_t j, size_t k) const;
+
+ private:
+    const E& m_u;
+    T m_v;
+    Op m_op;
+};
+
+//! Array-array addition expression.
+template <typename T, typename E1, typename E2>
+using ArrayAdd3 = ArrayBinaryOp3<T, E1, E2, std::plus<T>>;
+
+//! Array-scalar addition expression.
+template <typename T, typename E>
+using ArrayScalarAdd3 = ArrayScalarBinaryOp3<T, E, std::plus<T>>;
+
+//! Array-array subtraction expression.
+template <typename T, typename E1, typename E2>
+using ArraySub3 = ArrayBinaryOp3<T, E1, E2, std::minus<T>>;
+
+//! Array-scalar subtraction expression.
+template <typename T, typename E>
+using ArrayScalarSub3 = ArrayScalarBinaryOp3<T, E, std::minus<T>>;
+
+//! Scalar-array subtraction expression.
+template <typename T, typename E>
+using ArrayScalarRSub3 = ArrayScalarBinaryOp3<T, E, RMinus<T>>;
+
+//! Elementwise array-array multiplication expression.
+template <typename T, typename E1, typename E2>
+using ArrayMul3 = ArrayBinaryOp3<T, E1, E2, std::multiplies<T>>;
+
+//! Array-scalar multiplication expression.
+template <typename T, typename E>
+using ArrayScalarMul3 = ArrayScalarBinaryOp3<T, E, std::multiplies<T>>;
+
+//! Elementwise array-array division expression.
+template <typename T, typename E1, typename E2>
+using ArrayDiv3 = ArrayBinaryOp3<T, E1, E2, std::divides<T>>;
+
+//! Array-scalar division expression.
+template <typename T, typename E>
+using ArrayScalarDiv3 = ArrayScalarBinaryOp3<T, E, std::divides<T>>;
+
+//! Scalar-array division expression.
+template <typename T, typename E>
+using ArrayScalarRDiv3 = ArrayScalarBinaryOp3<T, E, RDivides<T>>;
+
+//! Scalar-array addition operation.
+template <typename T, typename E>
+ArrayScalarAdd3<T, E> operator+(const T& a, const ArrayExpression3<T, E>& b);
+
+//! Array-scalar addition operation.
+template <typename T, typename E>
+ArrayScalarAdd3<T, E> operator+(const ArrayExpression3<T, E>& a, const T& b);
+
+//! Array-array addition operation.
+template <typename T, typename E1, typename E2>
+ArrayAdd3<T, E1, E2> operator+(const ArrayExpression3<T, E1>& a,
+                               const ArrayExpression3<T, E2>& b);
+
+//! Scalar-array subtraction operation.
+template <typename T, typename E>
+ArrayScalarRSub3<T, E> operator-(const T& a, const ArrayExpression3<T, E>& b);
+
+//! Array-scalar subtraction operation.
+template <typename T, typename E>
+ArrayScalarSub3<T, E> operator-(const ArrayExpression3<T, E>& a, const T& b);
+
+//! Array-array subtraction operation.
+template <typename T, typename E1, typename E2>
+ArraySub3<T, E1, E2> operator-(const ArrayExpression3<T, E1>& a,
+                               const ArrayExpression3<T, E2>& b);
+
+//! Scalar-array multiplication operation.
+template <typename T, typename E>
+ArrayScalarMul3<T, E> operator*(const T& a, const ArrayExpression3<T, E>& b);
+
+//! Array-scalar multiplication operation.
+template <typename T, typename E>
+ArrayScalarMul3<T, E> operator*(const ArrayExpression3<T, E>& a, const T& b);
+
+//! Elementwise array-array multiplication operation.
+template <typename T, typename E1, typename E2>
+ArrayMul3<T, E1, E2> operator*(const ArrayExpression3<T, E1>& a,
+                               const ArrayExpression3<T, E2>& b);
+
+//! Scalar-array division operation.
+template <typename T, typename E>
+ArrayScalarRDiv3<T, E> operator/(const T& a, const ArrayExpression3<T, E>& b);
+
+//! Array-scalar division operation.
+template <typename T, typename E>
+ArrayScalarDiv3<T, E> operator/(const ArrayExpression3<T, E>& a, const T& b);
+
+//! Elementwise array-array division operation.
+template <typename T, typename E1, typename E2>
+ArrayDiv3<T, E1, E2> operator/(const ArrayExpression3<T, E1>& a,
+                               const ArrayExpression3<T, E2>& b);
+
+//!
+//! \brief Evaluates the expression into \p output in a single parallel pass.
+//!
+//! The whole expression tree collapses into one loop body, so chained
+//! elementwise operations touch the output array exactly once. Reading the
+//! output array itself inside the expression is allowed as long as only the
+//! same (i, j, k) element is read.
+//!
+template <typename T, typename E>
+void ParallelEvaluate(const ArrayExpression3<T, E>& expression,
+                      ArrayAccessor3<T> output);
+}  // namespace CubbyFlow
+
+#include <Core/Array/ArrayExpression3-Impl.hpp>
+
+#endif
@@ -57,6 +57,21 @@ class CubicArraySampler final
     static_assert(N < 1 || N > 3,
                   "Not implemented - N should be either 1, 2 or 3.");
 };
+
+//!
+//! \brief Generic N-D fast cubic array sampler class.
+//!
+//! \tparam T - The value type to sample.
+//! \tparam R - The real number type.
+//! \tparam N - Dimension.
+//!
+template <typename T, typename R, size_t N>
+class FastCubicArraySampler final
+{
+ public:
+    static_assert(N < 1 || N > 3,
+                  "Not implemented - N should be either 1, 2 or 3.");
+};
 }  // namespace CubbyFlow
 
 #endif
\ No newline at end of file
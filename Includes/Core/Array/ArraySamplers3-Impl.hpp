@@ -219,6 +219,58 @@ T LinearArraySampler<T, R, 3>::operator()(const Vector3<R>& pt) const
         m_accessor(i, jp1, kp1), m_accessor(ip1, jp1, kp1), fx, fy, fz);
 }
 
+template <typename T, typename R>
+void LinearArraySampler<T, R, 3>::Sample(
+    const ConstArrayAccessor1<Vector3<R>>& points,
+    ArrayAccessor1<T> results) const
+{
+    assert(points.size() == results.size());
+
+    assert(m_gridSpacing.x > std::numeric_limits<R>::epsilon());
+    assert(m_gridSpacing.y > std::numeric_limits<R>::epsilon());
+    assert(m_gridSpacing.z > std::numeric_limits<R>::epsilon());
+
+    const ssize_t iSize = static_cast<ssize_t>(m_accessor.size().x);
+    const ssize_t jSize = static_cast<ssize_t>(m_accessor.size().y);
+    const ssize_t kSize = static_cast<ssize_t>(m_accessor.size().z);
+
+    // Resolve the storage layout once for the whole batch.
+    const T* data = m_accessor.data();
+    const ssize_t strideY = iSize;
+    const ssize_t strideZ = iSize * jSize;
+
+    const Vector3<R> invGridSpacing = m_invGridSpacing;
+    const Vector3<R> origin = m_origin;
+
+    const size_t n = points.size();
+    for (size_t idx = 0; idx < n; ++idx)
+    {
+        const Vector3<R> normalizedX =
+            (points[idx] - origin) * invGridSpacing;
+
+        ssize_t i, j, k;
+        R fx, fy, fz;
+
+        GetBarycentric(normalizedX.x, 0, iSize - 1, &i, &fx);
+        GetBarycentric(normalizedX.y, 0, jSize - 1, &j, &fy);
+        GetBarycentric(normalizedX.z, 0, kSize - 1, &k, &fz);
+
+        const ssize_t ip1 = std::min(i + 1, iSize - 1);
+        const ssize_t jp1 = std::min(j + 1, jSize - 1);
+        const ssize_t kp1 = std::min(k + 1, kSize - 1);
+
+        const ssize_t base00 = j * strideY + k * strideZ;
+        const ssize_t base10 = jp1 * strideY + k * strideZ;
+        const ssize_t base01 = j * strideY + kp1 * strideZ;
+        const ssize_t base11 = jp1 * strideY + kp1 * strideZ;
+
+        results[idx] = TriLerp(
+            data[i + base00], data[ip1 + base00], data[i + base10],
+            data[ip1 + base10], data[i + base01], data[ip1 + base01],
+            data[i + base11], data[ip1 + base11], fx, fy, fz);
+    }
+}
+
 template <typename T, typename R>
 void LinearArraySampler<T, R, 3>::GetCoordinatesAndWeights(
     const Vector3<R>& pt, std::array<Point3UI, 8>* indices,
@@ -338,6 +390,9 @@ CubicArraySampler<T, R, 3>::CubicArraySampler(ConstArrayAccessor3<T> accessor,
                                               const Vector3<R>& gridSpacing,
                                               const Vector3<R>& gridOrigin)
     : m_gridSpacing(gridSpacing),
+      m_invGridSpacing(static_cast<R>(1) / gridSpacing.x,
+                       static_cast<R>(1) / gridSpacing.y,
+                       static_cast<R>(1) / gridSpacing.z),
       m_origin(gridOrigin),
       m_accessor(std::move(accessor))
 {
@@ -347,6 +402,7 @@ CubicArraySampler<T, R, 3>::CubicArraySampler(ConstArrayAccessor3<T> accessor,
 template <typename T, typename R>
 CubicArraySampler<T, R, 3>::CubicArraySampler(const CubicArraySampler& other)
     : m_gridSpacing(other.m_gridSpacing),
+      m_invGridSpacing(other.m_invGridSpacing),
       m_origin(other.m_origin),
       m_accessor(other.m_accessor)
 {
@@ -357,6 +413,7 @@ template <typename T, typename R>
 CubicArraySampler<T, R, 3>::CubicArraySampler(
     CubicArraySampler&& other) noexcept
     : m_gridSpacing(other.m_gridSpacing),
+      m_invGridSpacing(other.m_invGridSpacing),
       m_origin(other.m_origin),
       m_accessor(other.m_accessor)
 {
@@ -368,6 +425,7 @@ CubicArraySampler<T, R, 3>& CubicArraySampler<T, R, 3>::operator=(
     const CubicArraySampler& other)
 {
     m_gridSpacing = other.m_gridSpacing;
+    m_invGridSpacing = other.m_invGridSpacing;
     m_origin = other.m_origin;
     m_accessor = other.m_accessor;
 
@@ -379,6 +437,7 @@ CubicArraySampler<T, R, 3>& CubicArraySampler<T, R, 3>::operator=(
     CubicArraySampler&& other) noexcept
 {
     m_gridSpacing = other.m_gridSpacing;
+    m_invGridSpacing = other.m_invGridSpacing;
     m_origin = other.m_origin;
     m_accessor = other.m_accessor;
 
@@ -395,7 +454,7 @@ T CubicArraySampler<T, R, 3>::operator()(const Vector3<R>& pt) const
     assert(m_gridSpacing.y > std::numeric_limits<R>::epsilon());
     assert(m_gridSpacing.z > std::numeric_limits<R>::epsilon());
 
-    const Vector3<R> normalizedX = (pt - m_origin) / m_gridSpacing;
+    const Vector3<R> normalizedX = (pt - m_origin) * m_invGridSpacing;
 
     const ssize_t iSize = static_cast<ssize_t>(m_accessor.size().x);
     const ssize_t jSize = static_cast<ssize_t>(m_accessor.size().y);
@@ -445,6 +504,174 @@ std::function<T(const Vector3<R>&)> CubicArraySampler<T, R, 3>::Functor() const
     return std::bind(&CubicArraySampler::operator(), sampler,
                      std::placeholders::_1);
 }
+
+template <typename T, typename R>
+FastCubicArraySampler<T, R, 3>::FastCubicArraySampler(
+    ConstArrayAccessor3<T> accessor, const Vector3<R>& gridSpacing,
+    const Vector3<R>& gridOrigin)
+    : m_gridSpacing(gridSpacing),
+      m_invGridSpacing(static_cast<R>(1) / gridSpacing.x,
+                       static_cast<R>(1) / gridSpacing.y,
+                       static_cast<R>(1) / gridSpacing.z),
+      m_origin(gridOrigin),
+      m_accessor(std::move(accessor))
+{
+    // Do nothing
+}
+
+template <typename T, typename R>
+FastCubicArraySampler<T, R, 3>::FastCubicArraySampler(
+    const FastCubicArraySampler& other)
+    : m_gridSpacing(other.m_gridSpacing),
+      m_invGridSpacing(other.m_invGridSpacing),
+      m_origin(other.m_origin),
+      m_accessor(other.m_accessor)
+{
+    // Do nothing
+}
+
+template <typename T, typename R>
+FastCubicArraySampler<T, R, 3>::FastCubicArraySampler(
+    FastCubicArraySampler&& other) noexcept
+    : m_gridSpacing(other.m_gridSpacing),
+      m_invGridSpacing(other.m_invGridSpacing),
+      m_origin(other.m_origin),
+      m_accessor(other.m_accessor)
+{
+    // Do nothing
+}
+
+template <typename T, typename R>
+FastCubicArraySampler<T, R, 3>& FastCubicArraySampler<T, R, 3>::operator=(
+    const FastCubicArraySampler& other)
+{
+    m_gridSpacing = other.m_gridSpacing;
+    m_invGridSpacing = other.m_invGridSpacing;
+    m_origin = other.m_origin;
+    m_accessor = other.m_accessor;
+
+    return *this;
+}
+
+template <typename T, typename R>
+FastCubicArraySampler<T, R, 3>& FastCubicArraySampler<T, R, 3>::operator=(
+    FastCubicArraySampler&& other) noexcept
+{
+    m_gridSpacing = other.m_gridSpacing;
+    m_invGridSpacing = other.m_invGridSpacing;
+    m_origin = other.m_origin;
+    m_accessor = other.m_accessor;
+
+    return *this;
+}
+
+template <typename T, typename R>
+T FastCubicArraySampler<T, R, 3>::operator()(const Vector3<R>& pt) const
+{
+    ssize_t i, j, k;
+    R fx, fy, fz;
+
+    assert(m_gridSpacing.x > std::numeric_limits<R>::epsilon());
+    assert(m_gridSpacing.y > std::numeric_limits<R>::epsilon());
+    assert(m_gridSpacing.z > std::numeric_limits<R>::epsilon());
+
+    const Vector3<R> normalizedX = (pt - m_origin) * m_invGridSpacing;
+
+    const ssize_t iSize = static_cast<ssize_t>(m_accessor.size().x);
+    const ssize_t jSize = static_cast<ssize_t>(m_accessor.size().y);
+    const ssize_t kSize = static_cast<ssize_t>(m_accessor.size().z);
+
+    GetBarycentric(normalizedX.x, 0, iSize, &i, &fx);
+    GetBarycentric(normalizedX.y, 0, jSize, &j, &fy);
+    GetBarycentric(normalizedX.z, 0, kSize, &k, &fz);
+
+    // Division-free Horner forms of the four Catmull-Rom basis weights,
+    // w(t) = [-t + 2t^2 - t^3, 2 - 5t^2 + 3t^3, t + 4t^2 - 3t^3,
+    //         -t^2 + t^3] / 2.
+    const auto basis = [](R t, R w[4]) {
+        constexpr R half = static_cast<R>(0.5);
+        constexpr R one = static_cast<R>(1);
+        constexpr R two = static_cast<R>(2);
+        constexpr R twoAndHalf = static_cast<R>(2.5);
+        constexpr R oneAndHalf = static_cast<R>(1.5);
+
+        w[0] = t * (-half + t * (one - half * t));
+        w[1] = one + t * t * (-twoAndHalf + oneAndHalf * t);
+        w[2] = t * (half + t * (two - oneAndHalf * t));
+        w[3] = t * t * (-half + half * t);
+    };
+
+    R wx[4], wy[4], wz[4];
+    basis(fx, wx);
+    basis(fy, wy);
+    basis(fz, wz);
+
+    T acc{};
+
+    if (i >= 1 && i + 2 < iSize && j >= 1 && j + 2 < jSize && k >= 1 &&
+        k + 2 < kSize)
+    {
+        // Interior fast path: the 4x4x4 stencil is fully inside the array,
+        // so each x-run of four values is contiguous in memory and can be
+        // reduced with a plain dot product.
+        const T* data = m_accessor.data();
+        const size_t rowStride = m_accessor.size().x;
+        const size_t sliceStride = rowStride * m_accessor.size().y;
+
+        for (int kk = 0; kk < 4; ++kk)
+        {
+            const T* slice = data + (k - 1 + kk) * sliceStride;
+
+            for (int jj = 0; jj < 4; ++jj)
+            {
+                const T* row = slice + (j - 1 + jj) * rowStride + (i - 1);
+                const R w = wy[jj] * wz[kk];
+
+                acc += (row[0] * wx[0] + row[1] * wx[1] + row[2] * wx[2] +
+                        row[3] * wx[3]) *
+                       w;
+            }
+        }
+
+        return acc;
+    }
+
+    // Boundary path with clamped indices; same weights.
+    const ssize_t is[4] = { std::max(i - 1, ZERO_SSIZE), i,
+                            std::min(i + 1, iSize - 1),
+                            std::min(i + 2, iSize - 1) };
+    const ssize_t js[4] = { std::max(j - 1, ZERO_SSIZE), j,
+                            std::min(j + 1, jSize - 1),
+                            std::min(j + 2, jSize - 1) };
+    const ssize_t ks[4] = { std::max(k - 1, ZERO_SSIZE), k,
+                            std::min(k + 1, kSize - 1),
+                            std::min(k + 2, kSize - 1) };
+
+    for (int kk = 0; kk < 4; ++kk)
+    {
+        for (int jj = 0; jj < 4; ++jj)
+        {
+            const R w = wy[jj] * wz[kk];
+
+            acc += (m_accessor(is[0], js[jj], ks[kk]) * wx[0] +
+                    m_accessor(is[1], js[jj], ks[kk]) * wx[1] +
+                    m_accessor(is[2], js[jj], ks[kk]) * wx[2] +
+                    m_accessor(is[3], js[jj], ks[kk]) * wx[3]) *
+                   w;
+        }
+    }
+
+    return acc;
+}
+
+template <typename T, typename R>
+std::function<T(const Vector3<R>&)> FastCubicArraySampler<T, R, 3>::Functor()
+    const
+{
+    FastCubicArraySampler sampler(*this);
+    return std::bind(&FastCubicArraySampler::operator(), sampler,
+                     std::placeholders::_1);
+}
 }  // namespace CubbyFlow
 
 #endif
\ No newline at end of file
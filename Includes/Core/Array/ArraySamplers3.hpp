@@ -11,6 +11,7 @@
 #ifndef CUBBYFLOW_ARRAY_SAMPLERS3_HPP
 #define CUBBYFLOW_ARRAY_SAMPLERS3_HPP
 
+#include <Core/Array/ArrayAccessor1.hpp>
 #include <Core/Array/ArrayAccessor3.hpp>
 #include <Core/Array/ArraySamplers.hpp>
 #include <Core/Vector/Vector3.hpp>
@@ -127,6 +128,23 @@ class LinearArraySampler<T, R, 3> final
     //! Returns sampled value at point \p pt.
     T operator()(const Vector3<R>& pt) const;
 
+    //!
+    //! \brief Samples multiple points at once.
+    //!
+    //! This function fills \p results with the trilinearly interpolated value
+    //! for every element of \p points. The batch loop resolves the data
+    //! pointer and row/slice strides once and keeps the eight fetches and the
+    //! fused lerps of each sample in one tight non-virtual loop, so stencil
+    //! consumers such as semi-Lagrangian advection avoid the per-sample
+    //! std::function dispatch of Functor().
+    //!
+    //! \param[in]  points  Sample positions.
+    //! \param[out] results Sampled values; must have the same size as
+    //!                     \p points.
+    //!
+    void Sample(const ConstArrayAccessor1<Vector3<R>>& points,
+                ArrayAccessor1<T> results) const;
+
     //! Returns the indices of points and their sampling weight for given point.
     void GetCoordinatesAndWeights(const Vector3<R>& pt,
                                   std::array<Point3UI, 8>* indices,
@@ -203,6 +221,7 @@ class CubicArraySampler<T, R, 3> final
 
  private:
     Vector3<R> m_gridSpacing;
+    Vector3<R> m_invGridSpacing;
     Vector3<R> m_origin;
     ConstArrayAccessor3<T> m_accessor;
 };
@@ -210,6 +229,73 @@ class CubicArraySampler<T, R, 3> final
 //! Type alias for 3-D cubic array sampler.
 template <typename T, typename R>
 using CubicArraySampler3 = CubicArraySampler<T, R, 3>;
+
+//!
+//! \brief 3-D fast cubic array sampler class.
+//!
+//! This class provides cubic sampling like CubicArraySampler, but evaluates
+//! the standard Catmull-Rom spline as a tensor product: the four basis
+//! weights per axis are computed once per sample with division-free Horner
+//! forms, and the 64-point stencil is reduced as weighted row sums that the
+//! compiler can vectorize. Away from the array boundary the stencil is read
+//! with raw row pointers. Note that, unlike CubicArraySampler, no
+//! monotonicity limiter is applied, so the result can overshoot the local
+//! data range near sharp gradients.
+//!
+//! \tparam T - The value type to sample.
+//! \tparam R - The real number type.
+//!
+template <typename T, typename R>
+class FastCubicArraySampler<T, R, 3> final
+{
+ public:
+    static_assert(
+        std::is_floating_point<R>::value,
+        "Samplers only can be instantiated with floating point types");
+
+    //!
+    //! \brief      Constructs a sampler using array accessor, spacing between
+    //!     the elements, and the position of the first array element.
+    //!
+    //! \param[in]  accessor    The array accessor.
+    //! \param[in]  gridSpacing The grid spacing.
+    //! \param[in]  gridOrigin  The grid origin.
+    //!
+    explicit FastCubicArraySampler(ConstArrayAccessor3<T> accessor,
+                                   const Vector3<R>& gridSpacing,
+                                   const Vector3<R>& gridOrigin);
+
+    //! Copy constructor.
+    FastCubicArraySampler(const FastCubicArraySampler& other);
+
+    //! Move constructor.
+    FastCubicArraySampler(FastCubicArraySampler&& other) noexcept;
+
+    //! Default destructor.
+    ~FastCubicArraySampler() = default;
+
+    //! Copy assignment operator.
+    FastCubicArraySampler& operator=(const FastCubicArraySampler& other);
+
+    //! Move assignment operator.
+    FastCubicArraySampler& operator=(FastCubicArraySampler&& other) noexcept;
+
+    //! Returns sampled value at point \p pt.
+    T operator()(const Vector3<R>& pt) const;
+
+    //! Returns a function object that wraps this instance.
+    [[nodiscard]] std::function<T(const Vector3<R>&)> Functor() const;
+
+ private:
+    Vector3<R> m_gridSpacing;
+    Vector3<R> m_invGridSpacing;
+    Vector3<R> m_origin;
+    ConstArrayAccessor3<T> m_accessor;
+};
+
+//! Type alias for 3-D fast cubic array sampler.
+template <typename T, typename R>
+using FastCubicArraySampler3 = FastCubicArraySampler<T, R, 3>;
 }  // namespace CubbyFlow
 
 #include <Core/Array/ArraySamplers3-Impl.hpp>
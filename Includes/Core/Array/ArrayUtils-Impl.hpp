@@ -16,10 +16,158 @@
 #include <Core/Utils/Parallel.hpp>
 #include <Core/Utils/TypeHelpers.hpp>
 
+#include <cstring>
 #include <iostream>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CUBBYFLOW_HAS_STREAMING_STORES
+#endif
 
 namespace CubbyFlow
 {
+namespace Internal
+{
+//! Bytes above which fills and copies switch to the streaming kernels.
+//! Smaller ranges fit in cache anyway, where plain stores are cheaper than
+//! the fences the non-temporal path needs.
+constexpr size_t BULK_STREAM_THRESHOLD = size_t{ 1 } << 20;
+
+#ifdef CUBBYFLOW_HAS_STREAMING_STORES
+//! Copies \p numBytes from \p input to \p output with non-temporal stores so
+//! a write-only destination does not evict the working set from cache. The
+//! caller issues the store fence once all ranges are written.
+inline void StreamCopy(const unsigned char* input, unsigned char* output,
+                       size_t numBytes)
+{
+    // Plain head copy until the destination is 16-byte aligned
+    const size_t head = std::min(
+        numBytes,
+        (16 - (reinterpret_cast<uintptr_t>(output) & 15)) & 15);
+    std::memcpy(output, input, head);
+    input += head;
+    output += head;
+    numBytes -= head;
+
+    const size_t numChunks = numBytes / 16;
+    auto* dst = reinterpret_cast<__m128i*>(output);
+    const auto* src = reinterpret_cast<const __m128i*>(input);
+    for (size_t i = 0; i < numChunks; ++i)
+    {
+        _mm_stream_si128(dst + i, _mm_loadu_si128(src + i));
+    }
+
+    std::memcpy(output + 16 * numChunks, input + 16 * numChunks,
+                numBytes - 16 * numChunks);
+}
+
+//! Fills \p count elements at \p output with \p value using non-temporal
+//! stores. Requires sizeof(T) to divide the 16-byte store width.
+template <typename T>
+void StreamFill(T* output, size_t count, const T& value)
+{
+    constexpr size_t perChunk = 16 / sizeof(T);
+
+    // Plain head stores until the destination is 16-byte aligned
+    while (count > 0 && (reinterpret_cast<uintptr_t>(output) & 15) != 0)
+    {
+        *output++ = value;
+        --count;
+    }
+
+    unsigned char pattern[16];
+    for (size_t i = 0; i < perChunk; ++i)
+    {
+        std::memcpy(pattern + i * sizeof(T), &value, sizeof(T));
+    }
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+
+    const size_t numChunks = count / perChunk;
+    auto* dst = reinterpret_cast<__m128i*>(output);
+    for (size_t i = 0; i < numChunks; ++i)
+    {
+        _mm_stream_si128(dst + i, chunk);
+    }
+
+    for (size_t i = numChunks * perChunk; i < count; ++i)
+    {
+        output[i] = value;
+    }
+}
+#endif
+
+//! Copies \p count elements from \p input to \p output. Large ranges are
+//! chunked across threads and written with non-temporal stores; small ones
+//! lower to a single memcpy.
+template <typename T>
+void BulkCopy(const T* input, T* output, size_t count)
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "BulkCopy requires a trivially copyable element type");
+
+    const size_t numBytes = count * sizeof(T);
+
+#ifdef CUBBYFLOW_HAS_STREAMING_STORES
+    if (numBytes >= BULK_STREAM_THRESHOLD)
+    {
+        ParallelRangeFor(ZERO_SIZE, count, [&](size_t begin, size_t end) {
+            StreamCopy(reinterpret_cast<const unsigned char*>(input + begin),
+                       reinterpret_cast<unsigned char*>(output + begin),
+                       (end - begin) * sizeof(T));
+        });
+        _mm_sfence();
+        return;
+    }
+#endif
+
+    std::memcpy(output, input, numBytes);
+}
+
+//! Assigns \p value to \p count elements at \p output. Large ranges of
+//! 16-byte-divisible elements are written with non-temporal stores.
+template <typename T>
+void BulkFill(T* output, size_t count, const T& value)
+{
+#ifdef CUBBYFLOW_HAS_STREAMING_STORES
+    if constexpr (sizeof(T) <= 16 && 16 % sizeof(T) == 0)
+    {
+        if (count * sizeof(T) >= BULK_STREAM_THRESHOLD)
+        {
+            ParallelRangeFor(ZERO_SIZE, count, [&](size_t begin, size_t end) {
+                StreamFill(output + begin, end - begin, value);
+            });
+            _mm_sfence();
+            return;
+        }
+    }
+#endif
+
+    ParallelFor(ZERO_SIZE, count, [&](size_t i) { output[i] = value; });
+}
+
+//! Evaluates to true when ArrayType exposes its contiguous storage through a
+//! data() member, which every array, accessor, and std::vector in the code
+//! base does.
+template <typename ArrayType, typename = void>
+struct HasContiguousData : std::false_type
+{
+    // Do nothing
+};
+
+template <typename ArrayType>
+struct HasContiguousData<
+    ArrayType, std::void_t<decltype(std::declval<ArrayType&>().data())>>
+    : std::true_type
+{
+    // Do nothing
+};
+}  // namespace Internal
+
 template <typename ArrayType, typename T>
 void SetRange1(size_t size, const T& value, ArrayType* output)
 {
@@ -29,6 +177,17 @@ void SetRange1(size_t size, const T& value, ArrayType* output)
 template <typename ArrayType, typename T>
 void SetRange1(size_t begin, size_t end, const T& value, ArrayType* output)
 {
+    if constexpr (Internal::HasContiguousData<ArrayType>::value)
+    {
+        using ElementType = std::remove_reference_t<decltype((*output)[0])>;
+        if constexpr (std::is_same_v<ElementType, T> &&
+                      std::is_trivially_copyable_v<T>)
+        {
+            Internal::BulkFill(output->data() + begin, end - begin, value);
+            return;
+        }
+    }
+
     ParallelFor(begin, end, [&](size_t i) { (*output)[i] = value; });
 }
 
@@ -42,6 +201,21 @@ template <typename ArrayType1, typename ArrayType2>
 void CopyRange1(const ArrayType1& input, size_t begin, size_t end,
                 ArrayType2* output)
 {
+    if constexpr (Internal::HasContiguousData<const ArrayType1>::value &&
+                  Internal::HasContiguousData<ArrayType2>::value)
+    {
+        using InputElement =
+            std::remove_const_t<std::remove_reference_t<decltype(input[0])>>;
+        using OutputElement = std::remove_reference_t<decltype((*output)[0])>;
+        if constexpr (std::is_same_v<InputElement, OutputElement> &&
+                      std::is_trivially_copyable_v<InputElement>)
+        {
+            Internal::BulkCopy(input.data() + begin, output->data() + begin,
+                               end - begin);
+            return;
+        }
+    }
+
     ParallelFor(begin, end,
                 [&input, &output](size_t i) { (*output)[i] = input[i]; });
 }
@@ -76,6 +250,33 @@ void CopyRange3(const ArrayType1& input, size_t beginX, size_t endX,
                 size_t beginY, size_t endY, size_t beginZ, size_t endZ,
                 ArrayType2* output)
 {
+    if constexpr (Internal::HasContiguousData<const ArrayType1>::value &&
+                  Internal::HasContiguousData<ArrayType2>::value)
+    {
+        using InputElement = std::remove_const_t<
+            std::remove_reference_t<decltype(input(0, 0, 0))>>;
+        using OutputElement =
+            std::remove_reference_t<decltype((*output)(0, 0, 0))>;
+        if constexpr (std::is_same_v<InputElement, OutputElement> &&
+                      std::is_trivially_copyable_v<InputElement> &&
+                      std::is_same_v<std::decay_t<decltype(input.size())>,
+                                     Size3> &&
+                      std::is_same_v<std::decay_t<decltype(output->size())>,
+                                     Size3>)
+        {
+            // Whole-volume copies collapse to one linear bulk copy when both
+            // arrays span exactly the copied region.
+            if (beginX == 0 && beginY == 0 && beginZ == 0 &&
+                input.size() == Size3(endX, endY, endZ) &&
+                output->size() == Size3(endX, endY, endZ))
+            {
+                Internal::BulkCopy(input.data(), output->data(),
+                                   endX * endY * endZ);
+                return;
+            }
+        }
+    }
+
     ParallelFor(beginX, endX, beginY, endY, beginZ, endZ,
                 [&input, &output](size_t i, size_t j, size_t k) {
                     (*output)(i, j, k) = input(i, j, k);
@@ -96,10 +297,19 @@ void ExtrapolateToRegion(const ConstArrayAccessor2<T>& input,
     Array2<char> valid0(size);
     Array2<char> valid1(size);
 
-    valid0.ParallelForEachIndex([&](size_t i, size_t j) {
-        valid0(i, j) = valid(i, j);
-        output(i, j) = input(i, j);
-    });
+    // Initial guess: the valid mask and the data copy straight through
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        Internal::BulkCopy(valid.data(), valid0.data(), size.x * size.y);
+        Internal::BulkCopy(input.data(), output.data(), size.x * size.y);
+    }
+    else
+    {
+        valid0.ParallelForEachIndex([&](size_t i, size_t j) {
+            valid0(i, j) = valid(i, j);
+            output(i, j) = input(i, j);
+        });
+    }
 
     for (unsigned int iter = 0; iter < numberOfIterations; ++iter)
     {
@@ -164,10 +374,21 @@ void ExtrapolateToRegion(const ConstArrayAccessor3<T>& input,
     Array3<char> valid0(size);
     Array3<char> valid1(size);
 
-    valid0.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        valid0(i, j, k) = valid(i, j, k);
-        output(i, j, k) = input(i, j, k);
-    });
+    // Initial guess: the valid mask and the data copy straight through
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        Internal::BulkCopy(valid.data(), valid0.data(),
+                           size.x * size.y * size.z);
+        Internal::BulkCopy(input.data(), output.data(),
+                           size.x * size.y * size.z);
+    }
+    else
+    {
+        valid0.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            valid0(i, j, k) = valid(i, j, k);
+            output(i, j, k) = input(i, j, k);
+        });
+    }
 
     for (unsigned int iter = 0; iter < numberOfIterations; ++iter)
     {
@@ -230,6 +451,197 @@ void ExtrapolateToRegion(const ConstArrayAccessor3<T>& input,
     }
 }
 
+template <typename T>
+void ExtrapolateToRegionFrontier(const ConstArrayAccessor3<T>& input,
+                                 const ConstArrayAccessor3<char>& valid,
+                                 unsigned int maxDistance,
+                                 ArrayAccessor3<T> output)
+{
+    const Size3 size = input.size();
+
+    assert(size == valid.size());
+    assert(size == output.size());
+
+    // 0: invalid, 1: valid, 2: queued in the current frontier
+    Array3<char> state(size);
+
+    state.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        state(i, j, k) = (valid(i, j, k) != 0) ? 1 : 0;
+        output(i, j, k) = input(i, j, k);
+    });
+
+    if (maxDistance == 0)
+    {
+        return;
+    }
+
+    // Compact the invalid cells bordering the valid region into the first
+    // frontier band.
+    std::mutex mergeMutex;
+    std::vector<Point3UI> frontier;
+
+    ParallelRangeFor(ZERO_SIZE, size.z, [&](size_t beginK, size_t endK) {
+        std::vector<Point3UI> local;
+
+        for (size_t k = beginK; k < endK; ++k)
+        {
+            for (size_t j = 0; j < size.y; ++j)
+            {
+                for (size_t i = 0; i < size.x; ++i)
+                {
+                    if (state(i, j, k) != 0)
+                    {
+                        continue;
+                    }
+
+                    if ((i + 1 < size.x && state(i + 1, j, k) == 1) ||
+                        (i > 0 && state(i - 1, j, k) == 1) ||
+                        (j + 1 < size.y && state(i, j + 1, k) == 1) ||
+                        (j > 0 && state(i, j - 1, k) == 1) ||
+                        (k + 1 < size.z && state(i, j, k + 1) == 1) ||
+                        (k > 0 && state(i, j, k - 1) == 1))
+                    {
+                        state(i, j, k) = 2;
+                        local.emplace_back(i, j, k);
+                    }
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock{ mergeMutex };
+        frontier.insert(frontier.end(), local.begin(), local.end());
+    });
+
+    std::vector<Point3UI> candidates, nextFrontier;
+
+    for (unsigned int band = 0; band < maxDistance && !frontier.empty();
+         ++band)
+    {
+        // Every frontier cell borders at least one valid cell by
+        // construction, and only cells valid before this band contribute,
+        // so the band can be filled in any order.
+        ParallelFor(ZERO_SIZE, frontier.size(), [&](size_t idx) {
+            const size_t i = frontier[idx].x;
+            const size_t j = frontier[idx].y;
+            const size_t k = frontier[idx].z;
+
+            T sum = Zero<T>();
+            unsigned int count = 0;
+
+            if (i + 1 < size.x && state(i + 1, j, k) == 1)
+            {
+                sum += output(i + 1, j, k);
+                ++count;
+            }
+
+            if (i > 0 && state(i - 1, j, k) == 1)
+            {
+                sum += output(i - 1, j, k);
+                ++count;
+            }
+
+            if (j + 1 < size.y && state(i, j + 1, k) == 1)
+            {
+                sum += output(i, j + 1, k);
+                ++count;
+            }
+
+            if (j > 0 && state(i, j - 1, k) == 1)
+            {
+                sum += output(i, j - 1, k);
+                ++count;
+            }
+
+            if (k + 1 < size.z && state(i, j, k + 1) == 1)
+            {
+                sum += output(i, j, k + 1);
+                ++count;
+            }
+
+            if (k > 0 && state(i, j, k - 1) == 1)
+            {
+                sum += output(i, j, k - 1);
+                ++count;
+            }
+
+            output(i, j, k) =
+                sum / static_cast<typename ScalarType<T>::value>(count);
+        });
+
+        ParallelFor(ZERO_SIZE, frontier.size(), [&](size_t idx) {
+            state(frontier[idx].x, frontier[idx].y, frontier[idx].z) = 1;
+        });
+
+        if (band + 1 == maxDistance)
+        {
+            break;
+        }
+
+        // March the frontier: gather the still-invalid neighbors of the
+        // band just filled. Neighbors shared by several frontier cells show
+        // up more than once, so the candidates are deduplicated below while
+        // being queued.
+        candidates.clear();
+        ParallelRangeFor(
+            ZERO_SIZE, frontier.size(), [&](size_t begin, size_t end) {
+                std::vector<Point3UI> local;
+
+                for (size_t idx = begin; idx < end; ++idx)
+                {
+                    const size_t i = frontier[idx].x;
+                    const size_t j = frontier[idx].y;
+                    const size_t k = frontier[idx].z;
+
+                    if (i + 1 < size.x && state(i + 1, j, k) == 0)
+                    {
+                        local.emplace_back(i + 1, j, k);
+                    }
+
+                    if (i > 0 && state(i - 1, j, k) == 0)
+                    {
+                        local.emplace_back(i - 1, j, k);
+                    }
+
+                    if (j + 1 < size.y && state(i, j + 1, k) == 0)
+                    {
+                        local.emplace_back(i, j + 1, k);
+                    }
+
+                    if (j > 0 && state(i, j - 1, k) == 0)
+                    {
+                        local.emplace_back(i, j - 1, k);
+                    }
+
+                    if (k + 1 < size.z && state(i, j, k + 1) == 0)
+                    {
+                        local.emplace_back(i, j, k + 1);
+                    }
+
+                    if (k > 0 && state(i, j, k - 1) == 0)
+                    {
+                        local.emplace_back(i, j, k - 1);
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock{ mergeMutex };
+                candidates.insert(candidates.end(), local.begin(),
+                                  local.end());
+            });
+
+        nextFrontier.clear();
+        for (const Point3UI& candidate : candidates)
+        {
+            if (state(candidate.x, candidate.y, candidate.z) == 0)
+            {
+                state(candidate.x, candidate.y, candidate.z) = 2;
+                nextFrontier.push_back(candidate);
+            }
+        }
+
+        frontier.swap(nextFrontier);
+    }
+}
+
 template <typename ArrayType>
 void ConvertToCSV(const ArrayType& data, std::ostream* stream)
 {
@@ -142,6 +142,29 @@ void ExtrapolateToRegion(const ConstArrayAccessor3<T>& input,
                          unsigned int numberOfIterations,
                          ArrayAccessor3<T> output);
 
+//!
+//! \brief Frontier-based variant of 3-D ExtrapolateToRegion.
+//!
+//! This function produces the same output as ExtrapolateToRegion, but
+//! processes cells in distance order: it compacts the 'invalid' cells
+//! bordering the 'valid' region into a frontier list, fills that band in
+//! parallel, then marches the frontier one cell further, up to
+//! \p maxDistance bands. Each cell is visited once, so the cost scales
+//! with the extrapolated shell rather than with maxDistance times the
+//! full grid. The input parameters 'valid' and 'data' should be
+//! collocated.
+//!
+//! \param input - data to extrapolate
+//! \param valid - set 1 if valid, else 0.
+//! \param maxDistance - maximum propagation distance, in cells
+//! \param output - extrapolated output
+//!
+template <typename T>
+void ExtrapolateToRegionFrontier(const ConstArrayAccessor3<T>& input,
+                                 const ConstArrayAccessor3<char>& valid,
+                                 unsigned int maxDistance,
+                                 ArrayAccessor3<T> output);
+
 //!
 //! \brief Converts 2-D array to Comma Separated Value (CSV) stream.
 //!
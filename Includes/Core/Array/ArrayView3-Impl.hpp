@@ -0,0 +1,301 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_ARRAY_VIEW3_IMPL_HPP
+#define CUBBYFLOW_ARRAY_VIEW3_IMPL_HPP
+
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <cassert>
+
+namespace CubbyFlow
+{
+template <typename T>
+ArrayView3<T>::ArrayView3()
+    : m_data(nullptr), m_strideX(0), m_strideY(0), m_strideZ(0)
+{
+    // Do nothing
+}
+
+template <typename T>
+ArrayView3<T>::ArrayView3(const ArrayAccessor3<T>& parent,
+                          const Point3UI& origin, const Size3& size,
+                          const Size3& stride)
+    : m_size(size)
+{
+    assert(stride.x > 0 && stride.y > 0 && stride.z > 0);
+    assert(size.x == 0 ||
+           origin.x + (size.x - 1) * stride.x < parent.Width());
+    assert(size.y == 0 ||
+           origin.y + (size.y - 1) * stride.y < parent.Height());
+    assert(size.z == 0 ||
+           origin.z + (size.z - 1) * stride.z < parent.Depth());
+
+    m_data = parent.data() + origin.x + parent.Width() * origin.y +
+             parent.Width() * parent.Height() * origin.z;
+    m_strideX = stride.x;
+    m_strideY = parent.Width() * stride.y;
+    m_strideZ = parent.Width() * parent.Height() * stride.z;
+}
+
+template <typename T>
+T& ArrayView3<T>::At(const Point3UI& pt)
+{
+    return At(pt.x, pt.y, pt.z);
+}
+
+template <typename T>
+const T& ArrayView3<T>::At(const Point3UI& pt) const
+{
+    return At(pt.x, pt.y, pt.z);
+}
+
+template <typename T>
+T& ArrayView3<T>::At(size_t i, size_t j, size_t k)
+{
+    assert(i < m_size.x && j < m_size.y && k < m_size.z);
+    return m_data[i * m_strideX + j * m_strideY + k * m_strideZ];
+}
+
+template <typename T>
+const T& ArrayView3<T>::At(size_t i, size_t j, size_t k) const
+{
+    assert(i < m_size.x && j < m_size.y && k < m_size.z);
+    return m_data[i * m_strideX + j * m_strideY + k * m_strideZ];
+}
+
+template <typename T>
+Size3 ArrayView3<T>::size() const
+{
+    return m_size;
+}
+
+template <typename T>
+size_t ArrayView3<T>::Width() const
+{
+    return m_size.x;
+}
+
+template <typename T>
+size_t ArrayView3<T>::Height() const
+{
+    return m_size.y;
+}
+
+template <typename T>
+size_t ArrayView3<T>::Depth() const
+{
+    return m_size.z;
+}
+
+template <typename T>
+ArrayView3<T> ArrayView3<T>::View(const Point3UI& origin, const Size3& size,
+                                  const Size3& stride) const
+{
+    assert(stride.x > 0 && stride.y > 0 && stride.z > 0);
+    assert(size.x == 0 || origin.x + (size.x - 1) * stride.x < m_size.x);
+    assert(size.y == 0 || origin.y + (size.y - 1) * stride.y < m_size.y);
+    assert(size.z == 0 || origin.z + (size.z - 1) * stride.z < m_size.z);
+
+    ArrayView3 view;
+    view.m_data = m_data + origin.x * m_strideX + origin.y * m_strideY +
+                  origin.z * m_strideZ;
+    view.m_size = size;
+    view.m_strideX = m_strideX * stride.x;
+    view.m_strideY = m_strideY * stride.y;
+    view.m_strideZ = m_strideZ * stride.z;
+
+    return view;
+}
+
+template <typename T>
+template <typename Callback>
+void ArrayView3<T>::ForEachIndex(Callback func) const
+{
+    for (size_t k = 0; k < m_size.z; ++k)
+    {
+        for (size_t j = 0; j < m_size.y; ++j)
+        {
+            for (size_t i = 0; i < m_size.x; ++i)
+            {
+                func(i, j, k);
+            }
+        }
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void ArrayView3<T>::ParallelForEachIndex(Callback func) const
+{
+    ParallelFor(ZERO_SIZE, m_size.x, ZERO_SIZE, m_size.y, ZERO_SIZE, m_size.z,
+                func);
+}
+
+template <typename T>
+T& ArrayView3<T>::operator()(const Point3UI& pt)
+{
+    return At(pt.x, pt.y, pt.z);
+}
+
+template <typename T>
+const T& ArrayView3<T>::operator()(const Point3UI& pt) const
+{
+    return At(pt.x, pt.y, pt.z);
+}
+
+template <typename T>
+T& ArrayView3<T>::operator()(size_t i, size_t j, size_t k)
+{
+    return At(i, j, k);
+}
+
+template <typename T>
+const T& ArrayView3<T>::operator()(size_t i, size_t j, size_t k) const
+{
+    return At(i, j, k);
+}
+
+template <typename T>
+ConstArrayView3<T>::ConstArrayView3()
+    : m_data(nullptr), m_strideX(0), m_strideY(0), m_strideZ(0)
+{
+    // Do nothing
+}
+
+template <typename T>
+ConstArrayView3<T>::ConstArrayView3(const ConstArrayAccessor3<T>& parent,
+                                    const Point3UI& origin, const Size3& size,
+                                    const Size3& stride)
+    : m_size(size)
+{
+    assert(stride.x > 0 && stride.y > 0 && stride.z > 0);
+    assert(size.x == 0 ||
+           origin.x + (size.x - 1) * stride.x < parent.Width());
+    assert(size.y == 0 ||
+           origin.y + (size.y - 1) * stride.y < parent.Height());
+    assert(size.z == 0 ||
+           origin.z + (size.z - 1) * stride.z < parent.Depth());
+
+    m_data = parent.data() + origin.x + parent.Width() * origin.y +
+             parent.Width() * parent.Height() * origin.z;
+    m_strideX = stride.x;
+    m_strideY = parent.Width() * stride.y;
+    m_strideZ = parent.Width() * parent.Height() * stride.z;
+}
+
+template <typename T>
+ConstArrayView3<T>::ConstArrayView3(const ArrayView3<T>& other)
+    : m_data(other.m_data),
+      m_size(other.m_size),
+      m_strideX(other.m_strideX),
+      m_strideY(other.m_strideY),
+      m_strideZ(other.m_strideZ)
+{
+    // Do nothing
+}
+
+template <typename T>
+const T& ConstArrayView3<T>::At(const Point3UI& pt) const
+{
+    return At(pt.x, pt.y, pt.z);
+}
+
+template <typename T>
+const T& ConstArrayView3<T>::At(size_t i, size_t j, size_t k) const
+{
+    assert(i < m_size.x && j < m_size.y && k < m_size.z);
+    return m_data[i * m_strideX + j * m_strideY + k * m_strideZ];
+}
+
+template <typename T>
+Size3 ConstArrayView3<T>::size() const
+{
+    return m_size;
+}
+
+template <typename T>
+size_t ConstArrayView3<T>::Width() const
+{
+    return m_size.x;
+}
+
+template <typename T>
+size_t ConstArrayView3<T>::Height() const
+{
+    return m_size.y;
+}
+
+template <typename T>
+size_t ConstArrayView3<T>::Depth() const
+{
+    return m_size.z;
+}
+
+template <typename T>
+ConstArrayView3<T> ConstArrayView3<T>::View(const Point3UI& origin,
+                                            const Size3& size,
+                                            const Size3& stride) const
+{
+    assert(stride.x > 0 && stride.y > 0 && stride.z > 0);
+    assert(size.x == 0 || origin.x + (size.x - 1) * stride.x < m_size.x);
+    assert(size.y == 0 || origin.y + (size.y - 1) * stride.y < m_size.y);
+    assert(size.z == 0 || origin.z + (size.z - 1) * stride.z < m_size.z);
+
+    ConstArrayView3 view;
+    view.m_data = m_data + origin.x * m_strideX + origin.y * m_strideY +
+                  origin.z * m_strideZ;
+    view.m_size = size;
+    view.m_strideX = m_strideX * stride.x;
+    view.m_strideY = m_strideY * stride.y;
+    view.m_strideZ = m_strideZ * stride.z;
+
+    return view;
+}
+
+template <typename T>
+template <typename Callback>
+void ConstArrayView3<T>::ForEachIndex(Callback func) const
+{
+    for (size_t k = 0; k < m_size.z; ++k)
+    {
+        for (size_t j = 0; j < m_size.y; ++j)
+        {
+            for (size_t i = 0; i < m_size.x; ++i)
+            {
+                func(i, j, k);
+            }
+        }
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void ConstArrayView3<T>::ParallelForEachIndex(Callback func) const
+{
+    ParallelFor(ZERO_SIZE, m_size.x, ZERO_SIZE, m_size.y, ZERO_SIZE, m_size.z,
+                func);
+}
+
+template <typename T>
+const T& ConstArrayView3<T>::operator()(const Point3UI& pt) const
+{
+    return At(pt.x, pt.y, pt.z);
+}
+
+template <typename T>
+const T& ConstArrayView3<T>::operator()(size_t i, size_t j, size_t k) const
+{
+    return At(i, j, k);
+}
+}  // namespace CubbyFlow
+
+#endif
@@ -0,0 +1,248 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_ARRAY_VIEW3_HPP
+#define CUBBYFLOW_ARRAY_VIEW3_HPP
+
+#include <Core/Array/ArrayAccessor3.hpp>
+#include <Core/Geometry/Size3.hpp>
+
+namespace CubbyFlow
+{
+template <typename T>
+class ConstArrayView3;
+
+//!
+//! \brief Non-owning view onto a box region of a 3-D array.
+//!
+//! While ArrayAccessor3 can only wrap a whole array, this class views a
+//! sub-box of one: it is described by an origin, a per-axis extent, and a
+//! per-axis stride in parent cells (1 = dense, 2 = every other cell, ...).
+//! Element (i, j, k) of the view maps to parent cell
+//! origin + (i, j, k) * stride, so tile-based algorithms - halo exchange,
+//! per-slab streaming, sparse tiles - can index a region with local
+//! coordinates instead of repeating the offset arithmetic at every access or
+//! copying the tile out. Like an accessor it does not handle memory
+//! management, and it is invalidated when the parent array reallocates.
+//!
+//! \see ArrayAccessor<T, 3>
+//!
+//! \tparam T - Array value type.
+//!
+template <typename T>
+class ArrayView3 final
+{
+ public:
+    //! Constructs empty 3-D array view.
+    ArrayView3();
+
+    //! Constructs a view onto the box of \p parent starting at \p origin
+    //! with \p size elements per axis, \p stride parent cells apart.
+    //! The whole box must lie inside \p parent.
+    //! \param parent Accessor of the array to view into.
+    //! \param origin Parent cell of view element (0, 0, 0).
+    //! \param size Number of view elements per axis.
+    //! \param stride Parent cell step between view elements per axis.
+    ArrayView3(const ArrayAccessor3<T>& parent, const Point3UI& origin,
+               const Size3& size, const Size3& stride = Size3{ 1, 1, 1 });
+
+    //! Copy constructor.
+    ArrayView3(const ArrayView3& other) = default;
+
+    //! Move constructor.
+    ArrayView3(ArrayView3&& other) noexcept = default;
+
+    //! Default destructor.
+    ~ArrayView3() = default;
+
+    //! Copy assignment operator.
+    ArrayView3& operator=(const ArrayView3& other) = default;
+
+    //! Move assignment operator.
+    ArrayView3& operator=(ArrayView3&& other) noexcept = default;
+
+    //! Returns the reference to the view element at (pt.x, pt.y, pt.z).
+    T& At(const Point3UI& pt);
+
+    //! Returns the const reference to the view element at (pt.x, pt.y, pt.z).
+    const T& At(const Point3UI& pt) const;
+
+    //! Returns the reference to the view element at (i, j, k).
+    T& At(size_t i, size_t j, size_t k);
+
+    //! Returns the const reference to the view element at (i, j, k).
+    const T& At(size_t i, size_t j, size_t k) const;
+
+    //! Returns the size of the view.
+    [[nodiscard]] Size3 size() const;
+
+    //! Returns the width of the view.
+    [[nodiscard]] size_t Width() const;
+
+    //! Returns the height of the view.
+    [[nodiscard]] size_t Height() const;
+
+    //! Returns the depth of the view.
+    [[nodiscard]] size_t Depth() const;
+
+    //! Returns a view onto the box of this view starting at \p origin with
+    //! \p size elements per axis. Strides compose with this view's strides.
+    [[nodiscard]] ArrayView3 View(const Point3UI& origin, const Size3& size,
+                                  const Size3& stride = Size3{ 1, 1,
+                                                               1 }) const;
+
+    //!
+    //! \brief Iterates the view and invoke given \p func for each index.
+    //!
+    //! This function iterates the view elements and invoke the callback
+    //! function \p func in serial manner. The callback function takes three
+    //! parameters which are the (i, j, k) indices of the view element.
+    //!
+    template <typename Callback>
+    void ForEachIndex(Callback func) const;
+
+    //!
+    //! \brief Iterates the view and invoke given \p func for each index in
+    //! parallel.
+    //!
+    //! This function iterates the view elements and invoke the callback
+    //! function \p func in parallel using multi-threading. The callback
+    //! function takes three parameters which are the (i, j, k) indices of
+    //! the view element.
+    //!
+    template <typename Callback>
+    void ParallelForEachIndex(Callback func) const;
+
+    //! Returns the reference to the view element at (pt.x, pt.y, pt.z).
+    T& operator()(const Point3UI& pt);
+
+    //! Returns the const reference to the view element at (pt.x, pt.y, pt.z).
+    const T& operator()(const Point3UI& pt) const;
+
+    //! Returns the reference to the view element at (i, j, k).
+    T& operator()(size_t i, size_t j, size_t k);
+
+    //! Returns the const reference to the view element at (i, j, k).
+    const T& operator()(size_t i, size_t j, size_t k) const;
+
+ private:
+    template <typename U>
+    friend class ConstArrayView3;
+
+    T* m_data;
+    Size3 m_size;
+    size_t m_strideX;
+    size_t m_strideY;
+    size_t m_strideZ;
+};
+
+//!
+//! \brief Read-only non-owning view onto a box region of a 3-D array.
+//!
+//! \see ArrayView3<T>
+//!
+//! \tparam T - Array value type.
+//!
+template <typename T>
+class ConstArrayView3 final
+{
+ public:
+    //! Constructs empty 3-D read-only array view.
+    ConstArrayView3();
+
+    //! Constructs a read-only view onto the box of \p parent starting at
+    //! \p origin with \p size elements per axis, \p stride parent cells
+    //! apart. The whole box must lie inside \p parent.
+    ConstArrayView3(const ConstArrayAccessor3<T>& parent,
+                    const Point3UI& origin, const Size3& size,
+                    const Size3& stride = Size3{ 1, 1, 1 });
+
+    //! Constructs a read-only view from read/write view.
+    explicit ConstArrayView3(const ArrayView3<T>& other);
+
+    //! Copy constructor.
+    ConstArrayView3(const ConstArrayView3& other) = default;
+
+    //! Move constructor.
+    ConstArrayView3(ConstArrayView3&& other) noexcept = default;
+
+    //! Default destructor.
+    ~ConstArrayView3() = default;
+
+    //! Copy assignment operator.
+    ConstArrayView3& operator=(const ConstArrayView3& other) = default;
+
+    //! Move assignment operator.
+    ConstArrayView3& operator=(ConstArrayView3&& other) noexcept = default;
+
+    //! Returns the const reference to the view element at (pt.x, pt.y, pt.z).
+    const T& At(const Point3UI& pt) const;
+
+    //! Returns the const reference to the view element at (i, j, k).
+    const T& At(size_t i, size_t j, size_t k) const;
+
+    //! Returns the size of the view.
+    [[nodiscard]] Size3 size() const;
+
+    //! Returns the width of the view.
+    [[nodiscard]] size_t Width() const;
+
+    //! Returns the height of the view.
+    [[nodiscard]] size_t Height() const;
+
+    //! Returns the depth of the view.
+    [[nodiscard]] size_t Depth() const;
+
+    //! Returns a view onto the box of this view starting at \p origin with
+    //! \p size elements per axis. Strides compose with this view's strides.
+    [[nodiscard]] ConstArrayView3 View(
+        const Point3UI& origin, const Size3& size,
+        const Size3& stride = Size3{ 1, 1, 1 }) const;
+
+    //!
+    //! \brief Iterates the view and invoke given \p func for each index.
+    //!
+    //! This function iterates the view elements and invoke the callback
+    //! function \p func in serial manner. The callback function takes three
+    //! parameters which are the (i, j, k) indices of the view element.
+    //!
+    template <typename Callback>
+    void ForEachIndex(Callback func) const;
+
+    //!
+    //! \brief Iterates the view and invoke given \p func for each index in
+    //! parallel.
+    //!
+    //! This function iterates the view elements and invoke the callback
+    //! function \p func in parallel using multi-threading. The callback
+    //! function takes three parameters which are the (i, j, k) indices of
+    //! the view element.
+    //!
+    template <typename Callback>
+    void ParallelForEachIndex(Callback func) const;
+
+    //! Returns the const reference to the view element at (pt.x, pt.y, pt.z).
+    const T& operator()(const Point3UI& pt) const;
+
+    //! Returns the const reference to the view element at (i, j, k).
+    const T& operator()(size_t i, size_t j, size_t k) const;
+
+ private:
+    const T* m_data;
+    Size3 m_size;
+    size_t m_strideX;
+    size_t m_strideY;
+    size_t m_strideZ;
+};
+}  // namespace CubbyFlow
+
+#include <Core/Array/ArrayView3-Impl.hpp>
+
+#endif
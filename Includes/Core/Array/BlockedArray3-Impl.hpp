@@ -0,0 +1,304 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_BLOCKED_ARRAY3_IMPL_HPP
+#define CUBBYFLOW_BLOCKED_ARRAY3_IMPL_HPP
+
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace CubbyFlow
+{
+template <typename T, size_t BlockLog2>
+BlockedArray3<T, BlockLog2>::BlockedArray3(const Size3& size, const T& initVal)
+{
+    Resize(size, initVal);
+}
+
+template <typename T, size_t BlockLog2>
+BlockedArray3<T, BlockLog2>::BlockedArray3(size_t width, size_t height,
+                                           size_t depth, const T& initVal)
+{
+    Resize(width, height, depth, initVal);
+}
+
+template <typename T, size_t BlockLog2>
+BlockedArray3<T, BlockLog2>::BlockedArray3(const ConstArrayAccessor3<T>& other)
+{
+    Set(other);
+}
+
+template <typename T, size_t BlockLog2>
+void BlockedArray3<T, BlockLog2>::Set(const T& value)
+{
+    for (auto& v : m_data)
+    {
+        v = value;
+    }
+}
+
+template <typename T, size_t BlockLog2>
+void BlockedArray3<T, BlockLog2>::Set(const ConstArrayAccessor3<T>& other)
+{
+    Resize(other.size());
+
+    for (size_t k = 0; k < m_size.z; ++k)
+    {
+        for (size_t j = 0; j < m_size.y; ++j)
+        {
+            for (size_t i = 0; i < m_size.x; ++i)
+            {
+                (*this)(i, j, k) = other(i, j, k);
+            }
+        }
+    }
+}
+
+template <typename T, size_t BlockLog2>
+void BlockedArray3<T, BlockLog2>::Clear()
+{
+    m_size = Size3(0, 0, 0);
+    m_blockCount = Size3(0, 0, 0);
+    m_data.clear();
+}
+
+template <typename T, size_t BlockLog2>
+void BlockedArray3<T, BlockLog2>::Resize(const Size3& size, const T& initVal)
+{
+    BlockedArray3 grid;
+    grid.m_size = size;
+    grid.m_blockCount = Size3((size.x + BLOCK_SIZE - 1) >> BlockLog2,
+                              (size.y + BLOCK_SIZE - 1) >> BlockLog2,
+                              (size.z + BLOCK_SIZE - 1) >> BlockLog2);
+    grid.m_data.resize(grid.m_blockCount.x * grid.m_blockCount.y *
+                           grid.m_blockCount.z * BLOCK_VOLUME,
+                       initVal);
+
+    const size_t iMin = std::min(size.x, m_size.x);
+    const size_t jMin = std::min(size.y, m_size.y);
+    const size_t kMin = std::min(size.z, m_size.z);
+
+    for (size_t k = 0; k < kMin; ++k)
+    {
+        for (size_t j = 0; j < jMin; ++j)
+        {
+            for (size_t i = 0; i < iMin; ++i)
+            {
+                grid(i, j, k) = At(i, j, k);
+            }
+        }
+    }
+
+    Swap(grid);
+}
+
+template <typename T, size_t BlockLog2>
+void BlockedArray3<T, BlockLog2>::Resize(size_t width, size_t height,
+                                         size_t depth, const T& initVal)
+{
+    Resize(Size3(width, height, depth), initVal);
+}
+
+template <typename T, size_t BlockLog2>
+T& BlockedArray3<T, BlockLog2>::At(size_t i, size_t j, size_t k)
+{
+    assert(i < m_size.x && j < m_size.y && k < m_size.z);
+    return m_data[Index(i, j, k)];
+}
+
+template <typename T, size_t BlockLog2>
+const T& BlockedArray3<T, BlockLog2>::At(size_t i, size_t j, size_t k) const
+{
+    assert(i < m_size.x && j < m_size.y && k < m_size.z);
+    return m_data[Index(i, j, k)];
+}
+
+template <typename T, size_t BlockLog2>
+Size3 BlockedArray3<T, BlockLog2>::size() const
+{
+    return m_size;
+}
+
+template <typename T, size_t BlockLog2>
+size_t BlockedArray3<T, BlockLog2>::Width() const
+{
+    return m_size.x;
+}
+
+template <typename T, size_t BlockLog2>
+size_t BlockedArray3<T, BlockLog2>::Height() const
+{
+    return m_size.y;
+}
+
+template <typename T, size_t BlockLog2>
+size_t BlockedArray3<T, BlockLog2>::Depth() const
+{
+    return m_size.z;
+}
+
+template <typename T, size_t BlockLog2>
+Size3 BlockedArray3<T, BlockLog2>::BlockCount() const
+{
+    return m_blockCount;
+}
+
+template <typename T, size_t BlockLog2>
+T* BlockedArray3<T, BlockLog2>::BlockData(size_t bi, size_t bj, size_t bk)
+{
+    assert(bi < m_blockCount.x && bj < m_blockCount.y && bk < m_blockCount.z);
+    return m_data.data() +
+           (bi + m_blockCount.x * (bj + m_blockCount.y * bk)) * BLOCK_VOLUME;
+}
+
+template <typename T, size_t BlockLog2>
+const T* BlockedArray3<T, BlockLog2>::BlockData(size_t bi, size_t bj,
+                                                size_t bk) const
+{
+    assert(bi < m_blockCount.x && bj < m_blockCount.y && bk < m_blockCount.z);
+    return m_data.data() +
+           (bi + m_blockCount.x * (bj + m_blockCount.y * bk)) * BLOCK_VOLUME;
+}
+
+template <typename T, size_t BlockLog2>
+void BlockedArray3<T, BlockLog2>::CopyTo(ArrayAccessor3<T> output) const
+{
+    assert(output.size() == m_size);
+
+    for (size_t k = 0; k < m_size.z; ++k)
+    {
+        for (size_t j = 0; j < m_size.y; ++j)
+        {
+            for (size_t i = 0; i < m_size.x; ++i)
+            {
+                output(i, j, k) = At(i, j, k);
+            }
+        }
+    }
+}
+
+template <typename T, size_t BlockLog2>
+Array3<T> BlockedArray3<T, BlockLog2>::Flatten() const
+{
+    Array3<T> result(m_size);
+    CopyTo(result.Accessor());
+    return result;
+}
+
+template <typename T, size_t BlockLog2>
+void BlockedArray3<T, BlockLog2>::Swap(BlockedArray3& other)
+{
+    std::swap(other.m_size, m_size);
+    std::swap(other.m_blockCount, m_blockCount);
+    std::swap(other.m_data, m_data);
+}
+
+template <typename T, size_t BlockLog2>
+template <typename Callback>
+void BlockedArray3<T, BlockLog2>::ForEachIndex(Callback func) const
+{
+    for (size_t bk = 0; bk < m_blockCount.z; ++bk)
+    {
+        for (size_t bj = 0; bj < m_blockCount.y; ++bj)
+        {
+            for (size_t bi = 0; bi < m_blockCount.x; ++bi)
+            {
+                const size_t iEnd =
+                    std::min((bi + 1) << BlockLog2, m_size.x);
+                const size_t jEnd =
+                    std::min((bj + 1) << BlockLog2, m_size.y);
+                const size_t kEnd =
+                    std::min((bk + 1) << BlockLog2, m_size.z);
+
+                for (size_t k = bk << BlockLog2; k < kEnd; ++k)
+                {
+                    for (size_t j = bj << BlockLog2; j < jEnd; ++j)
+                    {
+                        for (size_t i = bi << BlockLog2; i < iEnd; ++i)
+                        {
+                            func(i, j, k);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T, size_t BlockLog2>
+template <typename Callback>
+void BlockedArray3<T, BlockLog2>::ParallelForEachIndex(Callback func) const
+{
+    ParallelFor(
+        ZERO_SIZE, m_blockCount.x, ZERO_SIZE, m_blockCount.y, ZERO_SIZE,
+        m_blockCount.z, [&](size_t bi, size_t bj, size_t bk) {
+            const size_t iEnd = std::min((bi + 1) << BlockLog2, m_size.x);
+            const size_t jEnd = std::min((bj + 1) << BlockLog2, m_size.y);
+            const size_t kEnd = std::min((bk + 1) << BlockLog2, m_size.z);
+
+            for (size_t k = bk << BlockLog2; k < kEnd; ++k)
+            {
+                for (size_t j = bj << BlockLog2; j < jEnd; ++j)
+                {
+                    for (size_t i = bi << BlockLog2; i < iEnd; ++i)
+                    {
+                        func(i, j, k);
+                    }
+                }
+            }
+        });
+}
+
+template <typename T, size_t BlockLog2>
+T& BlockedArray3<T, BlockLog2>::operator()(size_t i, size_t j, size_t k)
+{
+    return At(i, j, k);
+}
+
+template <typename T, size_t BlockLog2>
+const T& BlockedArray3<T, BlockLog2>::operator()(size_t i, size_t j,
+                                                 size_t k) const
+{
+    return At(i, j, k);
+}
+
+template <typename T, size_t BlockLog2>
+size_t BlockedArray3<T, BlockLog2>::Index(size_t i, size_t j, size_t k) const
+{
+    const size_t bi = i >> BlockLog2;
+    const size_t bj = j >> BlockLog2;
+    const size_t bk = k >> BlockLog2;
+    const size_t blockIndex = bi + m_blockCount.x * (bj + m_blockCount.y * bk);
+
+    constexpr size_t mask = BLOCK_SIZE - 1;
+    return blockIndex * BLOCK_VOLUME +
+           MortonEncode(i & mask, j & mask, k & mask);
+}
+
+template <typename T, size_t BlockLog2>
+size_t BlockedArray3<T, BlockLog2>::MortonEncode(size_t x, size_t y, size_t z)
+{
+    size_t code = 0;
+
+    for (size_t bit = 0; bit < BlockLog2; ++bit)
+    {
+        code |= ((x >> bit) & 1) << (3 * bit);
+        code |= ((y >> bit) & 1) << (3 * bit + 1);
+        code |= ((z >> bit) & 1) << (3 * bit + 2);
+    }
+
+    return code;
+}
+}  // namespace CubbyFlow
+
+#endif
@@ -0,0 +1,186 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_BLOCKED_ARRAY3_HPP
+#define CUBBYFLOW_BLOCKED_ARRAY3_HPP
+
+#include <Core/Array/Array3.hpp>
+#include <Core/Array/ArrayAccessor3.hpp>
+#include <Core/Geometry/Size3.hpp>
+
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief 3-D array class with blocked (tiled) memory layout.
+//!
+//! This class stores 3-D data in fixed-size cubic blocks (2^BlockLog2 cells
+//! per axis, 8x8x8 by default) where the cells inside each block are laid out
+//! in Morton (Z-curve) order. Compared to the flat i-major layout of
+//! Array<T, 3>, a stencil access such as the 7-point Laplacian touches cache
+//! lines that are close together in all three axes, not only along x.
+//!
+//! The blocks themselves are stored in i-major order, so converting to and
+//! from Array<T, 3> only permutes elements within blocks.
+//!
+//! \tparam T - Type to store in the array.
+//! \tparam BlockLog2 - Log2 of the block edge length (3 -> 8x8x8 blocks).
+//!
+template <typename T, size_t BlockLog2 = 3>
+class BlockedArray3 final
+{
+ public:
+    //! Edge length of a single block.
+    static constexpr size_t BLOCK_SIZE = size_t(1) << BlockLog2;
+
+    //! Number of elements in a single block.
+    static constexpr size_t BLOCK_VOLUME = BLOCK_SIZE * BLOCK_SIZE * BLOCK_SIZE;
+
+    //! Default constructor.
+    BlockedArray3() = default;
+
+    //! Constructs 3-D blocked array with given \p size and fill it with
+    //! \p initVal.
+    //! \param size Initial size of the array.
+    //! \param initVal Initial value of each array element.
+    explicit BlockedArray3(const Size3& size, const T& initVal = T());
+
+    //! Constructs 3-D blocked array with size \p width x \p height x \p depth
+    //! and fill it with \p initVal.
+    //! \param width Initial width of the array.
+    //! \param height Initial height of the array.
+    //! \param depth Initial depth of the array.
+    //! \param initVal Initial value of each array element.
+    explicit BlockedArray3(size_t width, size_t height, size_t depth,
+                           const T& initVal = T());
+
+    //! Constructs 3-D blocked array from the contents of flat array view
+    //! \p other.
+    explicit BlockedArray3(const ConstArrayAccessor3<T>& other);
+
+    //! Copy constructor.
+    BlockedArray3(const BlockedArray3& other) = default;
+
+    //! Move constructor.
+    BlockedArray3(BlockedArray3&& other) noexcept = default;
+
+    //! Default destructor.
+    ~BlockedArray3() = default;
+
+    //! Copy assignment operator.
+    BlockedArray3& operator=(const BlockedArray3& other) = default;
+
+    //! Move assignment operator.
+    BlockedArray3& operator=(BlockedArray3&& other) noexcept = default;
+
+    //! Sets entire array with given \p value.
+    void Set(const T& value);
+
+    //! Copies the contents of flat array view \p other to this array,
+    //! resizing if needed.
+    void Set(const ConstArrayAccessor3<T>& other);
+
+    //! Clears the array and resizes to zero.
+    void Clear();
+
+    //! Resizes the array with \p size and fill the new element with
+    //! \p initVal.
+    void Resize(const Size3& size, const T& initVal = T());
+
+    //! Resizes the array with size \p width x \p height x \p depth and fill
+    //! the new element with \p initVal.
+    void Resize(size_t width, size_t height, size_t depth,
+                const T& initVal = T());
+
+    //! Returns the reference to the element at (i, j, k).
+    T& At(size_t i, size_t j, size_t k);
+
+    //! Returns the const reference to the element at (i, j, k).
+    [[nodiscard]] const T& At(size_t i, size_t j, size_t k) const;
+
+    //! Returns the size of the array.
+    [[nodiscard]] Size3 size() const;
+
+    //! Returns the width of the array.
+    [[nodiscard]] size_t Width() const;
+
+    //! Returns the height of the array.
+    [[nodiscard]] size_t Height() const;
+
+    //! Returns the depth of the array.
+    [[nodiscard]] size_t Depth() const;
+
+    //! Returns the number of blocks per axis.
+    [[nodiscard]] Size3 BlockCount() const;
+
+    //! Returns the raw pointer to the block at block index (bi, bj, bk).
+    //! The block holds BLOCK_VOLUME elements in Morton order.
+    T* BlockData(size_t bi, size_t bj, size_t bk);
+
+    //! Returns the const raw pointer to the block at block index
+    //! (bi, bj, bk).
+    const T* BlockData(size_t bi, size_t bj, size_t bk) const;
+
+    //! Copies the contents of this array to flat array view \p output.
+    //! The view must have the same size as this array.
+    void CopyTo(ArrayAccessor3<T> output) const;
+
+    //! Returns a flat Array<T, 3> copy of this array.
+    [[nodiscard]] Array3<T> Flatten() const;
+
+    //! Swaps the content of the array with \p other array.
+    void Swap(BlockedArray3& other);
+
+    //!
+    //! \brief Iterates the array and invoke given \p func for each index.
+    //!
+    //! This function iterates the array elements and invoke the callback
+    //! function \p func. The callback function takes three parameters which
+    //! are the (i, j, k) indices of the array. The iteration visits whole
+    //! blocks one at a time, so the traversal order differs from the nested
+    //! i/j/k loop of Array<T, 3>::ForEachIndex.
+    //!
+    template <typename Callback>
+    void ForEachIndex(Callback func) const;
+
+    //!
+    //! \brief Iterates the array and invoke given \p func for each index in
+    //!     parallel, one block per task.
+    //!
+    //! The callback function takes three parameters which are the (i, j, k)
+    //! indices of the array. The order of execution will be non-deterministic
+    //! since it runs in parallel.
+    //!
+    template <typename Callback>
+    void ParallelForEachIndex(Callback func) const;
+
+    //! Returns the reference to the element at (i, j, k).
+    T& operator()(size_t i, size_t j, size_t k);
+
+    //! Returns the const reference to the element at (i, j, k).
+    const T& operator()(size_t i, size_t j, size_t k) const;
+
+    //! Returns the linear element offset of (i, j, k) in the block storage.
+    [[nodiscard]] size_t Index(size_t i, size_t j, size_t k) const;
+
+ private:
+    //! Interleaves the lowest BlockLog2 bits of (x, y, z) into a Morton code.
+    static size_t MortonEncode(size_t x, size_t y, size_t z);
+
+    Size3 m_size;
+    Size3 m_blockCount;
+    std::vector<T> m_data;
+};
+}  // namespace CubbyFlow
+
+#include <Core/Array/BlockedArray3-Impl.hpp>
+
+#endif
@@ -0,0 +1,85 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_CACHE_ALIGNED_ALLOCATOR_HPP
+#define CUBBYFLOW_CACHE_ALIGNED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Allocator aligning array storage to cache-line boundaries.
+//!
+//! The standard heap only guarantees fundamental alignment (16 bytes), so a
+//! grid buffer can start in the middle of a cache line. Vectorized stencil
+//! and BLAS sweeps over such a buffer then split loads across line
+//! boundaries, and the first and last rows of adjacent thread partitions are
+//! more likely to share a line. Aligning the buffer base to 64 bytes removes
+//! the split at no layout cost: rows whose size is a multiple of the line
+//! (every power-of-two-wide double grid) start on a line boundary for the
+//! whole array. Element layout is unchanged, so flat pointer paths and
+//! serialization are unaffected.
+//!
+//! \tparam T - Element type.
+//!
+template <typename T>
+class CacheAlignedAllocator
+{
+ public:
+    using value_type = T;
+
+    //! Default constructor.
+    CacheAlignedAllocator() = default;
+
+    //! Converting constructor required of allocators.
+    template <typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U>&) noexcept
+    {
+        // Do nothing
+    }
+
+    //! Allocates cache-line-aligned storage for \p n elements.
+    [[nodiscard]] T* allocate(size_t n)
+    {
+        return static_cast<T*>(::operator new(
+            n * sizeof(T), std::align_val_t{ CACHE_LINE_SIZE }));
+    }
+
+    //! Releases the storage of \p n elements at \p ptr.
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        ::operator delete(ptr, n * sizeof(T),
+                          std::align_val_t{ CACHE_LINE_SIZE });
+    }
+
+ private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+};
+
+//! All CacheAlignedAllocator instances are interchangeable.
+template <typename T, typename U>
+bool operator==(const CacheAlignedAllocator<T>&,
+                const CacheAlignedAllocator<U>&)
+{
+    return true;
+}
+
+//! All CacheAlignedAllocator instances are interchangeable.
+template <typename T, typename U>
+bool operator!=(const CacheAlignedAllocator<T>&,
+                const CacheAlignedAllocator<U>&)
+{
+    return false;
+}
+}  // namespace CubbyFlow
+
+#endif
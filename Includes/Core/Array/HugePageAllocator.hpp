@@ -0,0 +1,117 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_HUGE_PAGE_ALLOCATOR_HPP
+#define CUBBYFLOW_HUGE_PAGE_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace CubbyFlow
+{
+//!
+//! \brief Allocator backing large arrays with huge pages.
+//!
+//! Intended as the allocator parameter of Array1/Array2/Array3 for very
+//! large grids, where 4 KiB pages cause TLB thrashing during sweeps. On
+//! Linux, allocations of at least 2 MiB are served by an anonymous mapping
+//! advised to use transparent huge pages; smaller allocations and other
+//! platforms fall back to the standard heap. Transparent huge pages are
+//! used instead of reserved hugetlbfs pages so no system configuration is
+//! required. NUMA placement is left to the OS first-touch policy, which the
+//! parallel fill loops in this codebase already exercise per thread.
+//!
+//! \tparam T - Element type.
+//!
+template <typename T>
+class HugePageAllocator
+{
+ public:
+    using value_type = T;
+
+    //! Default constructor.
+    HugePageAllocator() = default;
+
+    //! Converting constructor required of allocators.
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) noexcept
+    {
+        // Do nothing
+    }
+
+    //! Allocates storage for \p n elements.
+    [[nodiscard]] T* allocate(size_t n)
+    {
+        const size_t numBytes = n * sizeof(T);
+
+#if defined(__linux__)
+        if (numBytes >= HUGE_PAGE_SIZE)
+        {
+            void* ptr = mmap(nullptr, RoundUpToHugePage(numBytes),
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED)
+            {
+                throw std::bad_alloc{};
+            }
+
+            madvise(ptr, RoundUpToHugePage(numBytes), MADV_HUGEPAGE);
+            return static_cast<T*>(ptr);
+        }
+#endif
+
+        return static_cast<T*>(::operator new(numBytes));
+    }
+
+    //! Releases the storage of \p n elements at \p ptr.
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        const size_t numBytes = n * sizeof(T);
+
+#if defined(__linux__)
+        if (numBytes >= HUGE_PAGE_SIZE)
+        {
+            munmap(ptr, RoundUpToHugePage(numBytes));
+            return;
+        }
+#endif
+
+        ::operator delete(ptr);
+    }
+
+ private:
+    static constexpr size_t HUGE_PAGE_SIZE = size_t{ 2 } * 1024 * 1024;
+
+    [[nodiscard]] static size_t RoundUpToHugePage(size_t numBytes)
+    {
+        return (numBytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    }
+};
+
+//! All HugePageAllocator instances are interchangeable.
+template <typename T, typename U>
+bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&)
+{
+    return true;
+}
+
+//! All HugePageAllocator instances are interchangeable.
+template <typename T, typename U>
+bool operator!=(const HugePageAllocator<T>&, const HugePageAllocator<U>&)
+{
+    return false;
+}
+}  // namespace CubbyFlow
+
+#endif
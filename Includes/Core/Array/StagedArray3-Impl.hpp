@@ -0,0 +1,136 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_STAGED_ARRAY3_IMPL_HPP
+#define CUBBYFLOW_STAGED_ARRAY3_IMPL_HPP
+
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace CubbyFlow
+{
+template <typename T>
+StagedArray3<T>::~StagedArray3()
+{
+    if (m_future.valid())
+    {
+        m_future.wait();
+    }
+}
+
+template <typename T>
+void StagedArray3<T>::MarkDirty(size_t kBegin, size_t kEnd)
+{
+    if (kEnd > m_dirtySlabs.size())
+    {
+        m_allDirty = true;
+        return;
+    }
+
+    for (size_t k = kBegin; k < kEnd; ++k)
+    {
+        m_dirtySlabs[k] = true;
+    }
+}
+
+template <typename T>
+void StagedArray3<T>::MarkAllDirty()
+{
+    m_allDirty = true;
+}
+
+template <typename T>
+bool StagedArray3<T>::IsDirty() const
+{
+    return m_allDirty ||
+           std::find(m_dirtySlabs.begin(), m_dirtySlabs.end(), true) !=
+               m_dirtySlabs.end();
+}
+
+template <typename T>
+void StagedArray3<T>::StageAsync(const ConstArrayAccessor3<T>& source)
+{
+    Synchronize();
+
+    const Size3 size = source.size();
+    if (m_buffer.size() != size)
+    {
+        m_buffer.Resize(size);
+        m_allDirty = true;
+    }
+
+    if (m_dirtySlabs.size() != size.z)
+    {
+        m_dirtySlabs.assign(size.z, false);
+    }
+
+    std::vector<size_t> slabs;
+    for (size_t k = 0; k < size.z; ++k)
+    {
+        if (m_allDirty || m_dirtySlabs[k])
+        {
+            slabs.push_back(k);
+        }
+
+        m_dirtySlabs[k] = false;
+    }
+    m_allDirty = false;
+
+    if (slabs.empty())
+    {
+        return;
+    }
+
+    m_future = std::async(
+        std::launch::async, [this, source, slabs = std::move(slabs)]() {
+            const Size3 s = source.size();
+
+            ParallelFor(ZERO_SIZE, slabs.size(), [&](size_t idx) {
+                const size_t k = slabs[idx];
+
+                for (size_t j = 0; j < s.y; ++j)
+                {
+                    for (size_t i = 0; i < s.x; ++i)
+                    {
+                        m_buffer(i, j, k) = source(i, j, k);
+                    }
+                }
+            });
+        });
+}
+
+template <typename T>
+void StagedArray3<T>::Synchronize()
+{
+    if (m_future.valid())
+    {
+        m_future.get();
+    }
+}
+
+template <typename T>
+bool StagedArray3<T>::IsStaging() const
+{
+    return m_future.valid() &&
+           m_future.wait_for(std::chrono::seconds(0)) !=
+               std::future_status::ready;
+}
+
+template <typename T>
+const Array3<T>& StagedArray3<T>::Buffer() const
+{
+    return m_buffer;
+}
+}  // namespace CubbyFlow
+
+#endif
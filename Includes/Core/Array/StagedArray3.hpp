@@ -0,0 +1,95 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_STAGED_ARRAY3_HPP
+#define CUBBYFLOW_STAGED_ARRAY3_HPP
+
+#include <Core/Array/Array3.hpp>
+
+#include <future>
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Asynchronous staging buffer for 3-D array data.
+//!
+//! This class keeps a host-side copy of an Array3 and refreshes it on a
+//! background thread, so a consumer that needs a stable snapshot (a device
+//! upload, file writer, or remote solver) can overlap the copy with other
+//! CPU work instead of paying a synchronous full-array copy. Dirtiness is
+//! tracked per z-slab: the producer marks the slabs it mutated and only
+//! those are copied on the next StageAsync call. Grids with multiple
+//! component arrays (e.g. FaceCenteredGrid3) use one stager per component.
+//!
+//! The source array must stay alive and unmodified in the dirty slabs
+//! between StageAsync and Synchronize.
+//!
+template <typename T>
+class StagedArray3
+{
+ public:
+    //! Constructs an empty stager.
+    StagedArray3() = default;
+
+    //! Deleted copy constructor.
+    StagedArray3(const StagedArray3&) = delete;
+
+    //! Deleted move constructor.
+    StagedArray3(StagedArray3&&) noexcept = delete;
+
+    //! Destructor. Waits for an in-flight staging copy.
+    ~StagedArray3();
+
+    //! Deleted copy assignment operator.
+    StagedArray3& operator=(const StagedArray3&) = delete;
+
+    //! Deleted move assignment operator.
+    StagedArray3& operator=(StagedArray3&&) noexcept = delete;
+
+    //! Marks the z-slabs in [\p kBegin, \p kEnd) as dirty.
+    void MarkDirty(size_t kBegin, size_t kEnd);
+
+    //! Marks the whole array as dirty.
+    void MarkAllDirty();
+
+    //! Returns true if any slab is marked dirty.
+    [[nodiscard]] bool IsDirty() const;
+
+    //!
+    //! \brief Starts copying the dirty slabs of \p source into the staging
+    //! buffer on a background thread and returns immediately.
+    //!
+    //! A pending copy is synchronized first. When the source size differs
+    //! from the buffer, the whole array is copied. Clears the dirty flags.
+    //!
+    void StageAsync(const ConstArrayAccessor3<T>& source);
+
+    //! Blocks until the in-flight staging copy (if any) finishes.
+    void Synchronize();
+
+    //! Returns true while a staging copy is in flight.
+    [[nodiscard]] bool IsStaging() const;
+
+    //! Returns the staging buffer. Call Synchronize first; reading while a
+    //! copy is in flight races with the background thread.
+    [[nodiscard]] const Array3<T>& Buffer() const;
+
+ private:
+    Array3<T> m_buffer;
+    std::vector<bool> m_dirtySlabs;
+    bool m_allDirty = true;
+    mutable std::future<void> m_future;
+};
+}  // namespace CubbyFlow
+
+#include <Core/Array/StagedArray3-Impl.hpp>
+
+#endif
@@ -0,0 +1,33 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_EMITTER_STATE_HPP
+#define CUBBYFLOW_EMITTER_STATE_HPP
+
+namespace CubbyFlow
+{
+//!
+//! \brief Lifecycle state shared by grid-based and particle emitters.
+//!
+//! Active emitters run every update. Sleeping emitters are skipped but can
+//! be woken again, either manually or by an emitter set whose active-region
+//! culling sees them overlap the region once more. Expired emitters are done
+//! for good (e.g. a one-shot source that has emitted) and are never updated
+//! again, so scenes full of finished emitters pay nothing for them.
+//!
+enum class EmitterState
+{
+    Active,
+    Sleeping,
+    Expired
+};
+}  // namespace CubbyFlow
+
+#endif
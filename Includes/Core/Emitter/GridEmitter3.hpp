@@ -11,6 +11,9 @@
 #ifndef CUBBYFLOW_GRID_EMITTER3_HPP
 #define CUBBYFLOW_GRID_EMITTER3_HPP
 
+#include <Core/Emitter/EmitterState.hpp>
+#include <Core/Geometry/BoundingBox3.hpp>
+
 #include <functional>
 #include <memory>
 
@@ -59,6 +62,32 @@ class GridEmitter3
     //! Sets true/false to enable/disable the emitter.
     void SetIsEnabled(bool enabled);
 
+    //! Returns the lifecycle state of the emitter.
+    [[nodiscard]] EmitterState GetState() const;
+
+    //!
+    //! \brief      Sets the lifecycle state of the emitter.
+    //!
+    //! Only active emitters run on update. The state transitions
+    //! automatically: emitters expire themselves when they can no longer
+    //! emit (e.g. a one-shot source that has fired), and emitter sets put
+    //! members to sleep or wake them as they leave and re-enter the active
+    //! region. Set the state manually to pause an emitter or to re-arm an
+    //! expired one.
+    //!
+    //! \param[in]  state The new lifecycle state.
+    //!
+    void SetState(EmitterState state);
+
+    //!
+    //! \brief      Returns the bounds the emitter can write to.
+    //!
+    //! Emitter sets cull members whose influence bounds do not overlap the
+    //! active region. The default implementation returns an unbounded box,
+    //! which exempts the emitter from culling.
+    //!
+    [[nodiscard]] virtual BoundingBox3D GetInfluenceBounds() const;
+
     //!
     //! \brief      Sets the callback function to be called when
     //!             GridEmitter3::Update function is invoked.
@@ -80,6 +109,7 @@ class GridEmitter3
 
  private:
     OnBeginUpdateCallback m_onBeginUpdateCallback;
+    EmitterState m_state = EmitterState::Active;
     bool m_isEnabled = true;
 };
 
@@ -49,6 +49,22 @@ class GridEmitterSet3 final : public GridEmitter3
     //! Adds sub-emitter.
     void AddEmitter(const GridEmitter3Ptr& emitter);
 
+    //!
+    //! \brief Sets the active region used to cull sub-emitters.
+    //!
+    //! While a region is set, sub-emitters whose influence bounds do not
+    //! overlap it are put to sleep and skipped, and woken again once their
+    //! bounds overlap the region, so the per-frame cost scales with the
+    //! emitters that can actually touch the region. Expired sub-emitters
+    //! are always skipped.
+    //!
+    //! \param[in] region The region the simulation is interested in.
+    //!
+    void SetActiveRegion(const BoundingBox3D& region);
+
+    //! Clears the active region, disabling the culling.
+    void ClearActiveRegion();
+
     //! Returns builder fox GridEmitterSet3.
     [[nodiscard]] static Builder GetBuilder();
 
@@ -57,6 +73,8 @@ class GridEmitterSet3 final : public GridEmitter3
                   double timeIntervalInSeconds) override;
 
     std::vector<GridEmitter3Ptr> m_emitters;
+    BoundingBox3D m_activeRegion;
+    bool m_hasActiveRegion = false;
 };
 
 //! Shared pointer type for the GridEmitterSet3.
@@ -11,6 +11,8 @@
 #ifndef CUBBYFLOW_PARTICLE_EMITTER3_HPP
 #define CUBBYFLOW_PARTICLE_EMITTER3_HPP
 
+#include <Core/Emitter/EmitterState.hpp>
+#include <Core/Geometry/BoundingBox3.hpp>
 #include <Core/Particle/ParticleSystemData3.hpp>
 
 namespace CubbyFlow
@@ -64,6 +66,32 @@ class ParticleEmitter3
     //! Sets true/false to enable/disable the emitter.
     void SetIsEnabled(bool enabled);
 
+    //! Returns the lifecycle state of the emitter.
+    [[nodiscard]] EmitterState GetState() const;
+
+    //!
+    //! \brief      Sets the lifecycle state of the emitter.
+    //!
+    //! Only active emitters run on update. The state transitions
+    //! automatically: emitters expire themselves when they can no longer
+    //! emit (e.g. a one-shot source that has fired or a source that hit its
+    //! particle budget), and emitter sets put members to sleep or wake them
+    //! as they leave and re-enter the active region. Set the state manually
+    //! to pause an emitter or to re-arm an expired one.
+    //!
+    //! \param[in]  state The new lifecycle state.
+    //!
+    void SetState(EmitterState state);
+
+    //!
+    //! \brief      Returns the bounds the emitter can place particles in.
+    //!
+    //! Emitter sets cull members whose influence bounds do not overlap the
+    //! active region. The default implementation returns an unbounded box,
+    //! which exempts the emitter from culling.
+    //!
+    [[nodiscard]] virtual BoundingBox3D GetInfluenceBounds() const;
+
     //!
     //! \brief      Sets the callback function to be called when
     //!             ParticleEmitter3::Update function is invoked.
@@ -87,6 +115,7 @@ class ParticleEmitter3
  private:
     ParticleSystemData3Ptr m_particles;
     OnBeginUpdateCallback m_onBeginUpdateCallback;
+    EmitterState m_state = EmitterState::Active;
     bool m_isEnabled = true;
 };
 
@@ -47,11 +47,51 @@ class ParticleEmitterSet3 final : public ParticleEmitter3
     //! Adds sub-emitter.
     void AddEmitter(const ParticleEmitter3Ptr& emitter);
 
+    //! Returns true if sub-emitters are updated in parallel.
+    [[nodiscard]] bool GetIsParallelUpdateEnabled() const;
+
+    //!
+    //! \brief      Enables or disables parallel sub-emitter updates.
+    //!
+    //! When enabled, the set updates its sub-emitters concurrently and
+    //! brackets the update with the target's concurrent append phase, so
+    //! each emitter's AddParticles call stages a private batch instead of
+    //! resizing shared data layers. Enable this only when every sub-emitter
+    //! touches the target exclusively through AddParticle(s). Default value
+    //! is false.
+    //!
+    //! \param[in]  enabled True to update sub-emitters in parallel.
+    //!
+    void SetIsParallelUpdateEnabled(bool enabled);
+
+    //!
+    //! \brief Sets the active region used to cull sub-emitters.
+    //!
+    //! While a region is set, sub-emitters whose influence bounds do not
+    //! overlap it are put to sleep and skipped, and woken again once their
+    //! bounds overlap the region, so the per-frame cost scales with the
+    //! emitters that can actually touch the region. Expired sub-emitters
+    //! are always skipped.
+    //!
+    //! \param[in] region The region the simulation is interested in.
+    //!
+    void SetActiveRegion(const BoundingBox3D& region);
+
+    //! Clears the active region, disabling the culling.
+    void ClearActiveRegion();
+
     //! Returns builder fox ParticleEmitterSet3.
     [[nodiscard]] static Builder GetBuilder();
 
  private:
+    //! Applies expiry skipping and active-region culling, returning the
+    //! indices of the sub-emitters that should update this frame.
+    [[nodiscard]] std::vector<size_t> CollectLiveEmitters();
+
     std::vector<ParticleEmitter3Ptr> m_emitters;
+    BoundingBox3D m_activeRegion;
+    bool m_hasActiveRegion = false;
+    bool m_isParallelUpdateEnabled = false;
 
     void OnSetTarget(const ParticleSystemData3Ptr& particles) override;
 
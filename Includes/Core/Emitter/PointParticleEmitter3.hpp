@@ -13,7 +13,7 @@
 
 #include <Core/Emitter/ParticleEmitter3.hpp>
 
-#include <random>
+#include <cstdint>
 
 namespace CubbyFlow
 {
@@ -61,6 +61,10 @@ class PointParticleEmitter3 final : public ParticleEmitter3
     //! Sets max number of particles to be emitted.
     void SetMaxNumberOfParticles(size_t maxNumberOfParticles);
 
+    //! Returns the emission point, used by emitter sets for active-region
+    //! culling.
+    [[nodiscard]] BoundingBox3D GetInfluenceBounds() const override;
+
     //! Returns builder fox PointParticleEmitter3.
     [[nodiscard]] static Builder GetBuilder();
 
@@ -77,9 +81,7 @@ class PointParticleEmitter3 final : public ParticleEmitter3
     void Emit(Array1<Vector3D>* newPositions, Array1<Vector3D>* newVelocities,
               size_t maxNewNumberOfParticles);
 
-    [[nodiscard]] double Random();
-
-    std::mt19937 m_rng;
+    uint32_t m_seed = 0;
 
     double m_firstFrameTimeInSeconds = 0.0;
     size_t m_numberOfEmittedParticles = 0;
@@ -11,12 +11,14 @@
 #ifndef CUBBYFLOW_VOLUME_GRID_EMITTER3_HPP
 #define CUBBYFLOW_VOLUME_GRID_EMITTER3_HPP
 
+#include <Core/Array/Array3.hpp>
 #include <Core/Emitter/GridEmitter3.hpp>
 #include <Core/Geometry/ImplicitSurface3.hpp>
 #include <Core/Grid/ScalarGrid3.hpp>
 #include <Core/Grid/VectorGrid3.hpp>
 #include <Core/Vector/Vector3.hpp>
 
+#include <array>
 #include <memory>
 
 namespace CubbyFlow
@@ -114,6 +116,62 @@ class VolumeGridEmitter3 final : public GridEmitter3
     //! Returns true if this emits only once.
     [[nodiscard]] bool GetIsOneShot() const;
 
+    //! Returns the bounding box of the source region, used by emitter sets
+    //! for active-region culling. Unbounded sources are never culled.
+    [[nodiscard]] BoundingBox3D GetInfluenceBounds() const override;
+
+    //! Returns true if the emission is restricted to the source bounds.
+    [[nodiscard]] bool GetUseBoundedEmission() const;
+
+    //!
+    //! \brief Enables or disables bounding-box-restricted emission.
+    //!
+    //! When enabled, only the grid points inside the dilated bounding box of
+    //! the source region are evaluated and written, so a small source placed
+    //! in a large domain costs proportional to its own size rather than the
+    //! domain's. The target mappers must leave values outside the source
+    //! region untouched for the result to stay unchanged; this holds for
+    //! step-function and typical inflow targets, but not for
+    //! signed-distance targets that rasterize the full distance field.
+    //!
+    void SetUseBoundedEmission(bool useBoundedEmission);
+
+    //! Returns true if the source SDF cache is enabled.
+    [[nodiscard]] bool GetUseSourceSDFCache() const;
+
+    //!
+    //! \brief Enables or disables the source SDF cache.
+    //!
+    //! When enabled, the signed distances of the source region sampled at the
+    //! target grid points are rasterized once and reused on subsequent
+    //! emissions until the source surface transform or a target grid layout
+    //! changes. Sources that animate without changing their transform should
+    //! keep the cache disabled.
+    //!
+    void SetUseSourceSDFCache(bool useSourceSDFCache);
+
+    //! Returns true if SDF pyramid culling is enabled.
+    [[nodiscard]] bool GetUseSDFPyramid() const;
+
+    //!
+    //! \brief Enables or disables coarse-to-fine SDF pyramid culling.
+    //!
+    //! When enabled, each emission first evaluates the source SDF at the
+    //! centers of coarse blocks and 8^3 tiles of the target grid. A signed
+    //! distance changes by at most the distance traveled, so a tile whose
+    //! center distance exceeds its half-diagonal plus the smearing margin is
+    //! provably clear of the interface: tiles outside the source are skipped
+    //! entirely and tiles deep inside receive a conservative distance bound
+    //! instead of a full query. Full-resolution evaluation is then confined
+    //! to a shell around the interface, which makes emission cost scale with
+    //! the source surface area instead of the target volume. The pruning
+    //! assumes the source returns a metric signed distance and, like bounded
+    //! emission, is exact for step-function and inflow targets but
+    //! approximates signed-distance rasterization targets away from the
+    //! interface.
+    //!
+    void SetUseSDFPyramid(bool useSDFPyramid);
+
     //! Returns builder fox VolumeGridEmitter3.
     [[nodiscard]] static Builder GetBuilder();
 
@@ -126,11 +184,22 @@ class VolumeGridEmitter3 final : public GridEmitter3
 
     void Emit();
 
+    //! Returns true if the cached source SDF can be reused for this emission.
+    [[nodiscard]] bool RefreshSourceSDFCache();
+
     ImplicitSurface3Ptr m_sourceRegion;
     std::vector<ScalarTarget> m_customScalarTargets;
     std::vector<VectorTarget> m_customVectorTargets;
+    std::vector<Array3<double>> m_scalarTargetSDF;
+    std::vector<std::array<Array3<double>, 3>> m_vectorTargetSDF;
+    Transform3 m_cachedSourceTransform;
     bool m_isOneShot = true;
     bool m_hasEmitted = false;
+    bool m_useBoundedEmission = false;
+    bool m_useSourceSDFCache = false;
+    bool m_useSDFPyramid = false;
+    bool m_sourceSDFCacheValid = false;
+    bool m_cachedBoundedEmission = false;
 };
 
 //! Shared pointer type for the VolumeGridEmitter3.
@@ -79,6 +79,10 @@ class VolumeParticleEmitter3 final : public ParticleEmitter3
     //! Sets the max particle gen region.
     void SetMaxRegion(const BoundingBox3D& newMaxRegion);
 
+    //! Returns the intersection of the max region and the source surface
+    //! bounds, used by emitter sets for active-region culling.
+    [[nodiscard]] BoundingBox3D GetInfluenceBounds() const override;
+
     //! Returns jitter amount.
     [[nodiscard]] double GetJitter() const;
 
@@ -159,6 +163,19 @@ class VolumeParticleEmitter3 final : public ParticleEmitter3
     void Emit(const ParticleSystemData3Ptr& particles,
               Array1<Vector3D>* newPositions, Array1<Vector3D>* newVelocities);
 
+    //!
+    //! \brief      Generates and classifies candidate points in parallel.
+    //!
+    //! Batch-generates the candidate lattice through the point generator,
+    //! then jitters each candidate with a counter-based hash of its index
+    //! and evaluates the signed-distance inclusion test in a single parallel
+    //! pass. Only used when overlapping is allowed or the emitter is
+    //! one-shot, since the non-overlapping path needs a serially updated
+    //! neighbor searcher.
+    //!
+    void EmitParallel(const BoundingBox3D& region, double maxJitterDist,
+                      Array1<Vector3D>* newPositions, size_t* numNewParticles);
+
     [[nodiscard]] double Random();
 
     [[nodiscard]] Vector3D VelocityAt(const Vector3D& point) const;
@@ -107,6 +107,24 @@ struct FDMBLAS2
     static void Residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
 
+    //! Performs fused \p result = a*x + y and returns the dot product of
+    //! \p result with itself, saving one sweep over the data.
+    static ScalarType AXPlusYAndSelfDot(double a, const VectorType& x,
+                                        const VectorType& y,
+                                        VectorType* result);
+
+    //! Performs fused matrix-vector multiplication that also returns the dot
+    //! product of \p v with \p result.
+    static ScalarType MVMAndDot(const MatrixType& m, const VectorType& v,
+                                VectorType* result);
+
+    //! Computes fused residual vector (b - ax) and returns the dot product of
+    //! \p result with itself.
+    static ScalarType ResidualAndSelfDot(const MatrixType& a,
+                                         const VectorType& x,
+                                         const VectorType& b,
+                                         VectorType* result);
+
     //! Returns L2-norm of the given vector \p v.
     [[nodiscard]] static ScalarType L2Norm(const VectorType& v);
 
@@ -149,6 +167,21 @@ struct FDMCompressedBLAS2
     static void Residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
 
+    //! Fused ax + y kernel that also returns the self-dot of \p result.
+    static ScalarType AXPlusYAndSelfDot(double a, const VectorType& x,
+                                        const VectorType& y,
+                                        VectorType* result);
+
+    //! Fused SpMV kernel that also returns the dot of \p v with \p result.
+    static ScalarType MVMAndDot(const MatrixType& m, const VectorType& v,
+                                VectorType* result);
+
+    //! Fused residual kernel that also returns the self-dot of \p result.
+    static ScalarType ResidualAndSelfDot(const MatrixType& a,
+                                         const VectorType& x,
+                                         const VectorType& b,
+                                         VectorType* result);
+
     //! Returns L2-norm of the given vector \p v.
     [[nodiscard]] static ScalarType L2Norm(const VectorType& v);
 
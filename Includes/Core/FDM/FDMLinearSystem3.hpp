@@ -14,8 +14,11 @@
 #include <Core/Array/Array3.hpp>
 #include <Core/Geometry/Size3.hpp>
 #include <Core/Matrix/MatrixCSR.hpp>
+#include <Core/Utils/MemoryStats.hpp>
 #include <Core/Vector/VectorN.hpp>
 
+#include <functional>
+
 namespace CubbyFlow
 {
 //! The row of FDMMatrix3 where row corresponds to (i, j, k) grid point.
@@ -40,8 +43,65 @@ using FDMVector3 = Array3<double>;
 //! Matrix type for 3-D finite differencing.
 using FDMMatrix3 = Array3<FDMMatrixRow3>;
 
+//! Single-precision row of FDMMatrix3F.
+struct FDMMatrixRow3F
+{
+    //! Diagonal component of the matrix (row, row).
+    float center = 0.0f;
+
+    //! Off-diagonal element where column refers to (i+1, j, k) grid point.
+    float right = 0.0f;
+
+    //! Off-diagonal element where column refers to (i, j+1, k) grid point.
+    float up = 0.0f;
+
+    //! Off-diagonal element where column refers to (i, j, k+1) grid point.
+    float front = 0.0f;
+};
+
+//! Single-precision vector type for 3-D finite differencing.
+using FDMVector3F = Array3<float>;
+
+//! Single-precision matrix type for 3-D finite differencing.
+using FDMMatrix3F = Array3<FDMMatrixRow3F>;
+
+//!
+//! \brief Struct-of-arrays layout of FDMMatrix3.
+//!
+//! Stores each of the four stencil diagonals in its own contiguous array
+//! instead of interleaving them in 32-byte rows. The bandwidth-bound SpMV
+//! sweeps then read only the coefficients they touch and each diagonal
+//! streams through unit-stride loads the compiler can vectorize.
+//!
+struct FDMMatrixSoA3
+{
+    //! Clears all the diagonals.
+    void Clear();
+
+    //! Resizes the diagonals with given grid size.
+    void Resize(const Size3& size);
+
+    //! Copies the diagonals out of the row-interleaved matrix \p m.
+    void Set(const FDMMatrix3& m);
+
+    //! Returns the size of the matrix.
+    [[nodiscard]] Size3 size() const;
+
+    //! Diagonal components of the matrix (row, row).
+    Array3<double> center;
+
+    //! Off-diagonal elements where column refers to (i+1, j, k) grid point.
+    Array3<double> right;
+
+    //! Off-diagonal elements where column refers to (i, j+1, k) grid point.
+    Array3<double> up;
+
+    //! Off-diagonal elements where column refers to (i, j, k+1) grid point.
+    Array3<double> front;
+};
+
 //! Linear system (Ax=b) for 3-D finite differencing.
-struct FDMLinearSystem3
+struct FDMLinearSystem3 : public MemoryStats
 {
     //! Clears all the data.
     void Clear();
@@ -49,6 +109,13 @@ struct FDMLinearSystem3
     //! Resizes the arrays with given grid size.
     void Resize(const Size3& size);
 
+    //! Returns the type name for memory accounting.
+    [[nodiscard]] const char* GetMemoryStatsName() const override;
+
+    //! Reports the bytes held by the matrix and vectors.
+    void ReportMemoryUsage(
+        std::vector<MemoryUsageRecord>* records) const override;
+
     //! System matrix.
     FDMMatrix3 A;
 
@@ -60,11 +127,18 @@ struct FDMLinearSystem3
 };
 
 //! Compressed linear system (Ax=b) for 3-D finite differencing.
-struct FDMCompressedLinearSystem3
+struct FDMCompressedLinearSystem3 : public MemoryStats
 {
     //! Clears all the data.
     void Clear();
 
+    //! Returns the type name for memory accounting.
+    [[nodiscard]] const char* GetMemoryStatsName() const override;
+
+    //! Reports the bytes held by the matrix and vectors.
+    void ReportMemoryUsage(
+        std::vector<MemoryUsageRecord>* records) const override;
+
     //! System matrix.
     MatrixCSRD A;
 
@@ -110,6 +184,154 @@ struct FDMBLAS3
     static void Residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
 
+    //! Performs fused \p result = a*x + y and returns the dot product of
+    //! \p result with itself, saving one sweep over the data.
+    static ScalarType AXPlusYAndSelfDot(double a, const VectorType& x,
+                                        const VectorType& y,
+                                        VectorType* result);
+
+    //! Performs fused matrix-vector multiplication that also returns the dot
+    //! product of \p v with \p result.
+    static ScalarType MVMAndDot(const MatrixType& m, const VectorType& v,
+                                VectorType* result);
+
+    //! Computes fused residual vector (b - ax) and returns the dot product of
+    //! \p result with itself.
+    static ScalarType ResidualAndSelfDot(const MatrixType& a,
+                                         const VectorType& x,
+                                         const VectorType& b,
+                                         VectorType* result);
+
+    //! Returns L2-norm of the given vector \p v.
+    [[nodiscard]] static ScalarType L2Norm(const VectorType& v);
+
+    //! Returns Linf-norm of the given vector \p v.
+    [[nodiscard]] static ScalarType LInfNorm(const VectorType& v);
+};
+
+//!
+//! \brief Mixed-precision BLAS operator wrapper for 3-D finite differencing.
+//!
+//! Matrix and vectors are stored in single precision, which halves the
+//! memory traffic of the bandwidth-bound sweeps, while every reduction
+//! (dot products and norms) still accumulates in double precision to keep
+//! the conjugate gradient recurrences stable.
+//!
+struct FDMBLAS3F
+{
+    using ScalarType = double;
+    using VectorType = FDMVector3F;
+    using MatrixType = FDMMatrix3F;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void Set(ScalarType s, VectorType* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void Set(const VectorType& v, VectorType* result);
+
+    //! Sets entire element of given matrix \p result with scalar \p s.
+    static void Set(ScalarType s, MatrixType* result);
+
+    //! Copies entire element of given matrix \p result with other matrix \p v.
+    static void Set(const MatrixType& m, MatrixType* result);
+
+    //! Performs dot product with vector \p a and \p b, accumulating in
+    //! double precision.
+    static double Dot(const VectorType& a, const VectorType& b);
+
+    //! Performs ax + y operation where \p a is a scalar and \p x and \p y are
+    //! vectors.
+    static void AXPlusY(double a, const VectorType& x, const VectorType& y,
+                        VectorType* result);
+
+    //! Performs matrix-vector multiplication.
+    static void MVM(const MatrixType& m, const VectorType& v,
+                    VectorType* result);
+
+    //! Computes residual vector (b - ax).
+    static void Residual(const MatrixType& a, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+
+    //! Fused ax + y kernel that also returns the self-dot of \p result.
+    static ScalarType AXPlusYAndSelfDot(double a, const VectorType& x,
+                                        const VectorType& y,
+                                        VectorType* result);
+
+    //! Fused matrix-vector kernel that also returns the dot of \p v with
+    //! \p result.
+    static ScalarType MVMAndDot(const MatrixType& m, const VectorType& v,
+                                VectorType* result);
+
+    //! Fused residual kernel that also returns the self-dot of \p result.
+    static ScalarType ResidualAndSelfDot(const MatrixType& a,
+                                         const VectorType& x,
+                                         const VectorType& b,
+                                         VectorType* result);
+
+    //! Returns L2-norm of the given vector \p v.
+    [[nodiscard]] static ScalarType L2Norm(const VectorType& v);
+
+    //! Returns Linf-norm of the given vector \p v.
+    [[nodiscard]] static ScalarType LInfNorm(const VectorType& v);
+};
+
+//!
+//! \brief BLAS operator wrapper for the struct-of-arrays matrix layout.
+//!
+//! Vector operations are shared with FDMBLAS3; the matrix kernels sweep the
+//! four diagonal arrays row by row so every term is a unit-stride product of
+//! two contiguous streams. Boundary handling is hoisted out of the inner
+//! loops, which lets them vectorize without masking.
+//!
+struct FDMSoABLAS3
+{
+    using ScalarType = double;
+    using VectorType = FDMVector3;
+    using MatrixType = FDMMatrixSoA3;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void Set(ScalarType s, VectorType* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void Set(const VectorType& v, VectorType* result);
+
+    //! Sets entire element of given matrix \p result with scalar \p s.
+    static void Set(ScalarType s, MatrixType* result);
+
+    //! Copies entire element of given matrix \p result with other matrix \p m.
+    static void Set(const MatrixType& m, MatrixType* result);
+
+    //! Performs dot product with vector \p a and \p b.
+    static double Dot(const VectorType& a, const VectorType& b);
+
+    //! Performs ax + y operation where \p a is a scalar and \p x and \p y are
+    //! vectors.
+    static void AXPlusY(double a, const VectorType& x, const VectorType& y,
+                        VectorType* result);
+
+    //! Performs matrix-vector multiplication.
+    static void MVM(const MatrixType& m, const VectorType& v,
+                    VectorType* result);
+
+    //! Computes residual vector (b - ax).
+    static void Residual(const MatrixType& a, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+
+    //! Fused ax + y kernel that also returns the self-dot of \p result.
+    static ScalarType AXPlusYAndSelfDot(double a, const VectorType& x,
+                                        const VectorType& y,
+                                        VectorType* result);
+
+    //! Fused SpMV kernel that also returns the dot of \p v with \p result.
+    static ScalarType MVMAndDot(const MatrixType& m, const VectorType& v,
+                                VectorType* result);
+
+    //! Fused residual kernel that also returns the self-dot of \p result.
+    static ScalarType ResidualAndSelfDot(const MatrixType& a,
+                                         const VectorType& x,
+                                         const VectorType& b,
+                                         VectorType* result);
+
     //! Returns L2-norm of the given vector \p v.
     [[nodiscard]] static ScalarType L2Norm(const VectorType& v);
 
@@ -152,6 +374,84 @@ struct FDMCompressedBLAS3
     static void Residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
 
+    //! Fused ax + y kernel that also returns the self-dot of \p result.
+    static ScalarType AXPlusYAndSelfDot(double a, const VectorType& x,
+                                        const VectorType& y,
+                                        VectorType* result);
+
+    //! Fused SpMV kernel that also returns the dot of \p v with \p result.
+    static ScalarType MVMAndDot(const MatrixType& m, const VectorType& v,
+                                VectorType* result);
+
+    //! Fused residual kernel that also returns the self-dot of \p result.
+    static ScalarType ResidualAndSelfDot(const MatrixType& a,
+                                         const VectorType& x,
+                                         const VectorType& b,
+                                         VectorType* result);
+
+    //! Returns L2-norm of the given vector \p v.
+    [[nodiscard]] static ScalarType L2Norm(const VectorType& v);
+
+    //! Returns Linf-norm of the given vector \p v.
+    [[nodiscard]] static ScalarType LInfNorm(const VectorType& v);
+};
+
+//!
+//! \brief Matrix-free system operator for 3-D finite differencing.
+//!
+//! Evaluates the product of the (implicit) system matrix and the input vector,
+//! writing the result to the output vector. Stencil weights are computed on
+//! the fly, so no matrix storage or assembly pass is required.
+//!
+using FDMMatrixFreeOperator3 =
+    std::function<void(const FDMVector3&, FDMVector3*)>;
+
+//! BLAS operator wrapper for matrix-free 3-D finite differencing.
+struct FDMMatrixFreeBLAS3
+{
+    using ScalarType = double;
+    using VectorType = FDMVector3;
+    using MatrixType = FDMMatrixFreeOperator3;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void Set(ScalarType s, VectorType* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void Set(const VectorType& v, VectorType* result);
+
+    //! Performs dot product with vector \p a and \p b.
+    static double Dot(const VectorType& a, const VectorType& b);
+
+    //! Performs ax + y operation where \p a is a scalar and \p x and \p y are
+    //! vectors.
+    static void AXPlusY(double a, const VectorType& x, const VectorType& y,
+                        VectorType* result);
+
+    //! Performs matrix-vector multiplication by invoking the operator \p op.
+    static void MVM(const MatrixType& op, const VectorType& v,
+                    VectorType* result);
+
+    //! Computes residual vector (b - op(x)).
+    static void Residual(const MatrixType& op, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+
+    //! Fused ax + y kernel that also returns the self-dot of \p result.
+    static ScalarType AXPlusYAndSelfDot(double a, const VectorType& x,
+                                        const VectorType& y,
+                                        VectorType* result);
+
+    //! Applies \p op and returns the dot of \p v with \p result. The dot
+    //! runs as a separate parallel pass since the operator is opaque.
+    static ScalarType MVMAndDot(const MatrixType& op, const VectorType& v,
+                                VectorType* result);
+
+    //! Computes residual (b - op(x)) and returns the self-dot of \p result
+    //! in the same sweep.
+    static ScalarType ResidualAndSelfDot(const MatrixType& op,
+                                         const VectorType& x,
+                                         const VectorType& b,
+                                         VectorType* result);
+
     //! Returns L2-norm of the given vector \p v.
     [[nodiscard]] static ScalarType L2Norm(const VectorType& v);
 
@@ -23,11 +23,18 @@ using FDMMGMatrix3 = MGMatrix<FDMBLAS3>;
 using FDMMGVector3 = MGVector<FDMBLAS3>;
 
 //! Multigrid-syle 3-D linear system.
-struct FDMMGLinearSystem3
+struct FDMMGLinearSystem3 : public MemoryStats
 {
     //! Clears the linear system.
     void Clear();
 
+    //! Returns the type name for memory accounting.
+    [[nodiscard]] const char* GetMemoryStatsName() const override;
+
+    //! Reports the bytes held by every level of the hierarchy.
+    void ReportMemoryUsage(
+        std::vector<MemoryUsageRecord>* records) const override;
+
     //! Returns the number of multigrid levels.
     [[nodiscard]] size_t GetNumberOfLevels() const;
 
@@ -68,6 +75,19 @@ class FDMMGUtils3
     //! Corrects given coarser grid to the finer grid.
     static void Correct(const FDMVector3& coarser, FDMVector3* finer);
 
+    //!
+    //! \brief Restricts the residual (b - ax) of the finer level to the
+    //! coarser grid in a single fused pass.
+    //!
+    //! The residual is evaluated on the fly inside the restriction stencil,
+    //! so the full-resolution residual vector is never written out. Fine
+    //! cells shared by neighboring coarse stencils have their residual
+    //! recomputed, but those reads stay in cache, keeping the pass
+    //! bandwidth-bound on a single sweep of the fine level.
+    //!
+    static void RestrictResidual(const FDMMatrix3& a, const FDMVector3& x,
+                                 const FDMVector3& b, FDMVector3* coarserB);
+
     //! Resizes the array with the coarsest resolution and number of levels.
     template <typename T>
     static void ResizeArrayWithCoarsest(const Size3& coarsestResolution,
@@ -93,5 +113,6 @@ class FDMMGUtils3
 }  // namespace CubbyFlow
 
 #include <Core/FDM/FDMMGLinearSystem3-Impl.hpp>
+#include <Core/Utils/MemoryStats.hpp>
 
 #endif
\ No newline at end of file
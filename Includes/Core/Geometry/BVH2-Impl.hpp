@@ -11,6 +11,7 @@
 #ifndef CUBBYFLOW_BVH2_IMPL_HPP
 #define CUBBYFLOW_BVH2_IMPL_HPP
 
+#include <algorithm>
 #include <numeric>
 
 namespace CubbyFlow
@@ -70,6 +71,33 @@ void BVH2<T>::Build(const std::vector<T>& items,
         Build(0, itemIndices.data(), m_items.size(), 0);
 }
 
+template <typename T>
+void BVH2<T>::BuildSAH(const std::vector<T>& items,
+                       const std::vector<BoundingBox2D>& itemsBounds)
+{
+    m_items = items;
+    m_itemBounds = itemsBounds;
+
+    if (m_items.empty())
+    {
+        return;
+    }
+
+    m_nodes.clear();
+    m_bound = BoundingBox2D{};
+
+    for (size_t i = 0; i < m_items.size(); ++i)
+    {
+        m_bound.Merge(m_itemBounds[i]);
+    }
+
+    std::vector<size_t> itemIndices(m_items.size());
+    std::iota(std::begin(itemIndices), std::end(itemIndices), 0);
+
+    [[maybe_unused]] const size_t d =
+        BuildSAH(0, itemIndices.data(), m_items.size(), 0);
+}
+
 template <typename T>
 void BVH2<T>::Clear()
 {
@@ -730,6 +758,138 @@ size_t BVH2<T>::QSplit(size_t* itemIndices, size_t numItems, double pivot,
 
     return ret;
 }
+
+template <typename T>
+size_t BVH2<T>::BuildSAH(size_t nodeIndex, size_t* itemIndices, size_t nItems,
+                         size_t currentDepth)
+{
+    // add a node
+    m_nodes.push_back(Node{});
+
+    // initialize leaf node if termination criteria met
+    if (nItems == 1)
+    {
+        m_nodes[nodeIndex].InitLeaf(itemIndices[0],
+                                    m_itemBounds[itemIndices[0]]);
+        return currentDepth + 1;
+    }
+
+    BoundingBox2D nodeBound;
+    for (size_t i = 0; i < nItems; ++i)
+    {
+        nodeBound.Merge(m_itemBounds[itemIndices[i]]);
+    }
+
+    // partition primitives at the cheapest binned-SAH split plane
+    uint8_t axis = 0;
+    const size_t midPoint = SAHSplit(itemIndices, nItems, &axis);
+
+    // recursively initialize children m_nodes
+    const size_t d0 =
+        BuildSAH(nodeIndex + 1, itemIndices, midPoint, currentDepth + 1);
+    m_nodes[nodeIndex].InitInternal(axis, m_nodes.size(), nodeBound);
+    const size_t d1 = BuildSAH(m_nodes[nodeIndex].child,
+                               itemIndices + midPoint, nItems - midPoint,
+                               currentDepth + 1);
+
+    return std::max(d0, d1);
+}
+
+template <typename T>
+size_t BVH2<T>::SAHSplit(size_t* itemIndices, size_t nItems, uint8_t* axis)
+{
+    // Bin over the centroid bound rather than the node bound; overlapping
+    // items can make the node bound much wider than the centroid spread.
+    BoundingBox2D centroidBound;
+    for (size_t i = 0; i < nItems; ++i)
+    {
+        centroidBound.Merge(m_itemBounds[itemIndices[i]].MidPoint());
+    }
+
+    const Vector2D d = centroidBound.upperCorner - centroidBound.lowerCorner;
+    *axis = (d.x > d.y) ? 0 : 1;
+
+    const double extent = d[*axis];
+    if (!(extent > 0.0))
+    {
+        // Every centroid coincides; no plane separates the items.
+        return nItems >> 1;
+    }
+
+    const double lower = centroidBound.lowerCorner[*axis];
+    const auto binOf = [&](size_t itemIndex) {
+        const double c = m_itemBounds[itemIndex].MidPoint()[*axis];
+        const auto bin = static_cast<size_t>(
+            static_cast<double>(SAH_NUM_BINS) * (c - lower) / extent);
+        return std::min(bin, SAH_NUM_BINS - 1);
+    };
+
+    BoundingBox2D binBounds[SAH_NUM_BINS];
+    size_t binCounts[SAH_NUM_BINS] = {};
+
+    for (size_t i = 0; i < nItems; ++i)
+    {
+        const size_t bin = binOf(itemIndices[i]);
+        binBounds[bin].Merge(m_itemBounds[itemIndices[i]]);
+        ++binCounts[bin];
+    }
+
+    // In 2-D, the box perimeter plays the role of the surface area.
+    const auto surfaceArea = [](const BoundingBox2D& b) {
+        const Vector2D e = b.upperCorner - b.lowerCorner;
+        return 2.0 * (e.x + e.y);
+    };
+
+    // Sweep the SAH cost of every boundary between adjacent bins: suffix
+    // bounds from the right first, then prefix bounds while evaluating.
+    double rightArea[SAH_NUM_BINS];
+    size_t rightCount[SAH_NUM_BINS];
+    BoundingBox2D suffix;
+    size_t suffixCount = 0;
+    for (size_t i = SAH_NUM_BINS; i-- > 1;)
+    {
+        suffix.Merge(binBounds[i]);
+        suffixCount += binCounts[i];
+        rightArea[i] = surfaceArea(suffix);
+        rightCount[i] = suffixCount;
+    }
+
+    size_t bestBoundary = 1;
+    double bestCost = std::numeric_limits<double>::max();
+    BoundingBox2D prefix;
+    size_t prefixCount = 0;
+    for (size_t i = 1; i < SAH_NUM_BINS; ++i)
+    {
+        prefix.Merge(binBounds[i - 1]);
+        prefixCount += binCounts[i - 1];
+
+        if (prefixCount == 0 || rightCount[i] == 0)
+        {
+            continue;
+        }
+
+        const double cost =
+            surfaceArea(prefix) * static_cast<double>(prefixCount) +
+            rightArea[i] * static_cast<double>(rightCount[i]);
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestBoundary = i;
+        }
+    }
+
+    size_t* const mid = std::partition(
+        itemIndices, itemIndices + nItems,
+        [&](size_t itemIndex) { return binOf(itemIndex) < bestBoundary; });
+
+    const auto ret = static_cast<size_t>(mid - itemIndices);
+    if (ret == 0 || ret == nItems)
+    {
+        return nItems >> 1;
+    }
+
+    return ret;
+}
 }  // namespace CubbyFlow
 
 #endif
\ No newline at end of file
@@ -55,6 +55,21 @@ class BVH2 final : public IntersectionQueryEngine2<T>,
     void Build(const std::vector<T>& items,
                const std::vector<BoundingBox2D>& itemsBounds);
 
+    //!
+    //! \brief Builds bounding volume hierarchy with a binned surface-area
+    //! heuristic (SAH).
+    //!
+    //! Instead of splitting every node at the spatial midpoint like Build,
+    //! this function bins the item centroids along the widest centroid axis
+    //! and picks the split plane minimizing the SAH cost
+    //! area(left) * n(left) + area(right) * n(right). The build is somewhat
+    //! slower, but the resulting tree is shallower and tighter on irregular
+    //! item distributions, which pays off when the tree is queried many
+    //! times.
+    //!
+    void BuildSAH(const std::vector<T>& items,
+                  const std::vector<BoundingBox2D>& itemsBounds);
+
     //! Clears all the contents of this instance.
     void Clear();
 
@@ -151,6 +166,19 @@ class BVH2 final : public IntersectionQueryEngine2<T>,
     [[nodiscard]] size_t QSplit(size_t* itemIndices, size_t numItems,
                                 double pivot, uint8_t axis);
 
+    [[nodiscard]] size_t BuildSAH(size_t nodeIndex, size_t* itemIndices,
+                                  size_t nItems, size_t currentDepth);
+
+    //! Partitions \p itemIndices at the binned-SAH split plane and returns
+    //! the number of items in the left child, storing the split axis in
+    //! \p axis. Falls back to a median split when no plane separates the
+    //! item centroids.
+    [[nodiscard]] size_t SAHSplit(size_t* itemIndices, size_t nItems,
+                                  uint8_t* axis);
+
+    //! Number of centroid bins tested per SAH split.
+    static constexpr size_t SAH_NUM_BINS = 32;
+
     BoundingBox2D m_bound;
     ContainerType m_items;
     std::vector<BoundingBox2D> m_itemBounds;
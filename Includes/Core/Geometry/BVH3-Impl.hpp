@@ -11,6 +11,11 @@
 #ifndef CUBBYFLOW_BVH3_IMPL_HPP
 #define CUBBYFLOW_BVH3_IMPL_HPP
 
+#include <Core/Utils/Parallel.hpp>
+#include <Core/Utils/SmallVector.hpp>
+
+#include <algorithm>
+#include <cassert>
 #include <numeric>
 
 namespace CubbyFlow
@@ -68,6 +73,242 @@ void BVH3<T>::Build(const std::vector<T>& items,
 
     [[maybe_unused]] const size_t d =
         Build(0, itemIndices.data(), m_items.size(), 0);
+
+    m_buildCost = ComputeTreeCost();
+}
+
+template <typename T>
+void BVH3<T>::BuildParallel(const std::vector<T>& items,
+                            const std::vector<BoundingBox3D>& itemsBounds)
+{
+    m_items = items;
+    m_itemBounds = itemsBounds;
+
+    if (m_items.empty())
+    {
+        return;
+    }
+
+    m_nodes.clear();
+    m_bound = BoundingBox3D{};
+
+    const size_t n = m_items.size();
+
+    // Quantize the bound centroids into Morton codes over the scene bound.
+    const BoundingBox3D sceneBound = ParallelReduce(
+        ZERO_SIZE, n, BoundingBox3D{},
+        [&](size_t begin, size_t end, BoundingBox3D init) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                init.Merge(m_itemBounds[i]);
+            }
+
+            return init;
+        },
+        [](BoundingBox3D a, const BoundingBox3D& b) {
+            a.Merge(b);
+            return a;
+        });
+
+    constexpr size_t bitsPerAxis = 21;
+    constexpr auto resolution = static_cast<double>(size_t{ 1 } << bitsPerAxis);
+    const Vector3D lowerCorner = sceneBound.lowerCorner;
+    const Vector3D invExtent{
+        resolution /
+            std::max(sceneBound.GetWidth(),
+                     std::numeric_limits<double>::epsilon()),
+        resolution /
+            std::max(sceneBound.GetHeight(),
+                     std::numeric_limits<double>::epsilon()),
+        resolution / std::max(sceneBound.GetDepth(),
+                              std::numeric_limits<double>::epsilon())
+    };
+
+    std::vector<size_t> codes(n);
+    ParallelFor(ZERO_SIZE, n, [&](size_t i) {
+        const auto quantize = [](double x) {
+            return std::min(static_cast<size_t>(std::max(x, 0.0)),
+                            (size_t{ 1 } << bitsPerAxis) - 1);
+        };
+
+        const Vector3D c = m_itemBounds[i].MidPoint();
+        const size_t x = quantize((c.x - lowerCorner.x) * invExtent.x);
+        const size_t y = quantize((c.y - lowerCorner.y) * invExtent.y);
+        const size_t z = quantize((c.z - lowerCorner.z) * invExtent.z);
+
+        codes[i] = MortonCode(x, y, z, bitsPerAxis);
+    });
+
+    std::vector<size_t> itemIndices(n);
+    std::iota(std::begin(itemIndices), std::end(itemIndices), ZERO_SIZE);
+    ParallelSort(std::begin(itemIndices), std::end(itemIndices),
+                 [&codes](size_t a, size_t b) { return codes[a] < codes[b]; });
+
+    std::vector<size_t> sortedCodes(n);
+    ParallelFor(ZERO_SIZE, n,
+                [&](size_t i) { sortedCodes[i] = codes[itemIndices[i]]; });
+
+    // A binary tree with one item per leaf has exactly 2n - 1 nodes, and a
+    // subtree over k sorted items occupies the 2k - 1 slots after its root,
+    // so every node index is known up front and subtrees can be emitted
+    // independently.
+    m_nodes.resize(2 * n - 1);
+
+    struct Range
+    {
+        size_t nodeIndex;
+        size_t start;
+        size_t count;
+    };
+
+    // Split the top of the tree serially until each remaining range is small
+    // enough to hand to a worker.
+    const size_t grainSize =
+        std::max(n / (8 * GetMaxNumberOfThreads()), size_t{ 1024 });
+
+    std::vector<Range> pending{ Range{ 0, 0, n } };
+    std::vector<Range> tasks;
+
+    while (!pending.empty())
+    {
+        const Range range = pending.back();
+        pending.pop_back();
+
+        if (range.count <= grainSize)
+        {
+            tasks.push_back(range);
+            continue;
+        }
+
+        uint8_t axis = 0;
+        const size_t split =
+            FindSplit(sortedCodes.data() + range.start, range.count, &axis);
+
+        m_nodes[range.nodeIndex].InitInternal(
+            axis, range.nodeIndex + 2 * split, BoundingBox3D{});
+        pending.push_back(Range{ range.nodeIndex + 1, range.start, split });
+        pending.push_back(Range{ range.nodeIndex + 2 * split,
+                                 range.start + split, range.count - split });
+    }
+
+    ParallelFor(ZERO_SIZE, tasks.size(), [&](size_t i) {
+        const Range range = tasks[i];
+        BuildRange(range.nodeIndex, itemIndices.data() + range.start,
+                   sortedCodes.data() + range.start, range.count);
+    });
+
+    RefitNodes();
+
+    m_buildCost = ComputeTreeCost();
+}
+
+template <typename T>
+void BVH3<T>::BuildSAH(const std::vector<T>& items,
+                       const std::vector<BoundingBox3D>& itemsBounds)
+{
+    m_items = items;
+    m_itemBounds = itemsBounds;
+
+    if (m_items.empty())
+    {
+        return;
+    }
+
+    m_nodes.clear();
+    m_bound = BoundingBox3D{};
+
+    const size_t n = m_items.size();
+    for (size_t i = 0; i < n; ++i)
+    {
+        m_bound.Merge(m_itemBounds[i]);
+    }
+
+    std::vector<size_t> itemIndices(n);
+    std::iota(std::begin(itemIndices), std::end(itemIndices), ZERO_SIZE);
+
+    // Same fixed layout as BuildParallel: a subtree over k items occupies
+    // the 2k - 1 slots after its root, so node indices are known as soon as
+    // a range is split and subtrees can be emitted independently.
+    m_nodes.resize(2 * n - 1);
+
+    struct Range
+    {
+        size_t nodeIndex;
+        size_t start;
+        size_t count;
+    };
+
+    // Split the top of the tree serially until each remaining range is small
+    // enough to hand to a worker.
+    const size_t grainSize =
+        std::max(n / (8 * GetMaxNumberOfThreads()), size_t{ 1024 });
+
+    std::vector<Range> pending{ Range{ 0, 0, n } };
+    std::vector<Range> tasks;
+
+    while (!pending.empty())
+    {
+        const Range range = pending.back();
+        pending.pop_back();
+
+        if (range.count <= grainSize)
+        {
+            tasks.push_back(range);
+            continue;
+        }
+
+        BoundingBox3D rangeBound;
+        for (size_t i = 0; i < range.count; ++i)
+        {
+            rangeBound.Merge(m_itemBounds[itemIndices[range.start + i]]);
+        }
+
+        uint8_t axis = 0;
+        const size_t split =
+            SAHSplit(itemIndices.data() + range.start, range.count, &axis);
+
+        m_nodes[range.nodeIndex].InitInternal(axis, range.nodeIndex + 2 * split,
+                                              rangeBound);
+        pending.push_back(Range{ range.nodeIndex + 1, range.start, split });
+        pending.push_back(Range{ range.nodeIndex + 2 * split,
+                                 range.start + split, range.count - split });
+    }
+
+    ParallelFor(ZERO_SIZE, tasks.size(), [&](size_t i) {
+        const Range range = tasks[i];
+        BuildSAHRange(range.nodeIndex, itemIndices.data() + range.start,
+                      range.count);
+    });
+
+    m_buildCost = ComputeTreeCost();
+}
+
+template <typename T>
+void BVH3<T>::Refit(const std::vector<BoundingBox3D>& itemsBounds)
+{
+    assert(itemsBounds.size() == m_items.size());
+
+    m_itemBounds = itemsBounds;
+
+    if (m_nodes.empty())
+    {
+        return;
+    }
+
+    RefitNodes();
+
+    // Refitting keeps the topology chosen for the old item layout, so bounds
+    // can only grow looser as the items drift apart. Once the refitted tree
+    // is substantially more expensive to traverse than the one built for
+    // this layout would be, a rebuild pays for itself.
+    if (m_buildCost > 0.0 &&
+        ComputeTreeCost() > REFIT_DEGRADATION_RATIO * m_buildCost)
+    {
+        const ContainerType items = std::move(m_items);
+        const std::vector<BoundingBox3D> bounds = std::move(m_itemBounds);
+
+        BuildParallel(items, bounds);
+    }
 }
 
 template <typename T>
@@ -88,10 +329,97 @@ inline NearestNeighborQueryResult3<T> BVH3<T>::GetNearestNeighbor(
     best.distance = std::numeric_limits<double>::max();
     best.item = nullptr;
 
+    NearestNeighborSearch(pt, distanceFunc, &best);
+
+    return best;
+}
+
+template <typename T>
+void BVH3<T>::GetNearestNeighbors(
+    const ConstArrayAccessor1<Vector3D>& points,
+    const NearestNeighborDistanceFunc3<T>& distanceFunc,
+    ArrayAccessor1<NearestNeighborQueryResult3<T>> results) const
+{
+    assert(points.size() == results.size());
+
+    const size_t n = points.size();
+    if (n == 0)
+    {
+        return;
+    }
+
+    // Sort query indices along a Z-curve so that consecutive queries land on
+    // nearby parts of the tree.
+    BoundingBox3D queryBound;
+    for (size_t i = 0; i < n; ++i)
+    {
+        queryBound.Merge(points[i]);
+    }
+
+    constexpr size_t bitsPerAxis = 10;
+    constexpr auto resolution = static_cast<double>(size_t{ 1 } << bitsPerAxis);
+    const Vector3D lowerCorner = queryBound.lowerCorner;
+    const Vector3D invExtent{
+        resolution / std::max(queryBound.GetWidth(), std::numeric_limits<double>::epsilon()),
+        resolution / std::max(queryBound.GetHeight(), std::numeric_limits<double>::epsilon()),
+        resolution / std::max(queryBound.GetDepth(), std::numeric_limits<double>::epsilon())
+    };
+
+    const auto mortonCode = [&](const Vector3D& pt) {
+        const auto quantize = [](double x) {
+            return std::min(static_cast<size_t>(std::max(x, 0.0)),
+                            (size_t{ 1 } << bitsPerAxis) - 1);
+        };
+
+        const size_t x = quantize((pt.x - lowerCorner.x) * invExtent.x);
+        const size_t y = quantize((pt.y - lowerCorner.y) * invExtent.y);
+        const size_t z = quantize((pt.z - lowerCorner.z) * invExtent.z);
+
+        return MortonCode(x, y, z, bitsPerAxis);
+    };
+
+    std::vector<size_t> codes(n);
+    ParallelFor(ZERO_SIZE, n,
+                [&](size_t i) { codes[i] = mortonCode(points[i]); });
+
+    std::vector<size_t> order(n);
+    std::iota(std::begin(order), std::end(order), ZERO_SIZE);
+    std::sort(std::begin(order), std::end(order),
+              [&codes](size_t a, size_t b) { return codes[a] < codes[b]; });
+
+    // Each worker walks a contiguous range of the sorted queries and seeds
+    // every query with the previous result, so the traversal starts with a
+    // tight pruning bound instead of an infinite one.
+    ParallelRangeFor(ZERO_SIZE, n, [&](size_t begin, size_t end) {
+        NearestNeighborQueryResult3<T> best;
+        best.distance = std::numeric_limits<double>::max();
+        best.item = nullptr;
+
+        for (size_t idx = begin; idx < end; ++idx)
+        {
+            const size_t i = order[idx];
+            const Vector3D& pt = points[i];
+
+            if (best.item != nullptr)
+            {
+                best.distance = distanceFunc(*best.item, pt);
+            }
+
+            NearestNeighborSearch(pt, distanceFunc, &best);
+
+            results[i] = best;
+        }
+    });
+}
+
+template <typename T>
+inline void BVH3<T>::NearestNeighborSearch(
+    const Vector3D& pt, const NearestNeighborDistanceFunc3<T>& distanceFunc,
+    NearestNeighborQueryResult3<T>* best) const
+{
     // Prepare to traverse BVH
     static const int maxTreeDepth = 8 * sizeof(size_t);
-    const Node* todo[maxTreeDepth];
-    size_t todoPos = 0;
+    SmallVector<const Node*, maxTreeDepth> todo;
 
     // Traverse BVH nodes
     const Node* node = m_nodes.data();
@@ -100,18 +428,18 @@ inline NearestNeighborQueryResult3<T> BVH3<T>::GetNearestNeighbor(
         if (node->IsLeaf())
         {
             double dist = distanceFunc(m_items[node->item], pt);
-            if (dist < best.distance)
+            if (dist < best->distance)
             {
-                best.distance = dist;
-                best.item = &m_items[node->item];
+                best->distance = dist;
+                best->item = &m_items[node->item];
             }
 
             // Grab next node to process from todo stack
-            if (todoPos > 0)
+            if (!todo.IsEmpty())
             {
                 // Dequeue
-                --todoPos;
-                node = todo[todoPos];
+                node = todo.Back();
+                todo.PopBack();
             }
             else
             {
@@ -120,7 +448,7 @@ inline NearestNeighborQueryResult3<T> BVH3<T>::GetNearestNeighbor(
         }
         else
         {
-            const double bestDistSqr = best.distance * best.distance;
+            const double bestDistSqr = best->distance * best->distance;
 
             const Node* left = node + 1;
             const Node* right = &m_nodes[node->child];
@@ -155,8 +483,7 @@ inline NearestNeighborQueryResult3<T> BVH3<T>::GetNearestNeighbor(
                 }
 
                 // Enqueue secondChild in todo stack
-                todo[todoPos] = secondChild;
-                ++todoPos;
+                todo.Append(secondChild);
                 node = firstChild;
             }
             else if (shouldVisitLeft)
@@ -169,11 +496,11 @@ inline NearestNeighborQueryResult3<T> BVH3<T>::GetNearestNeighbor(
             }
             else
             {
-                if (todoPos > 0)
+                if (!todo.IsEmpty())
                 {
                     // Dequeue
-                    --todoPos;
-                    node = todo[todoPos];
+                    node = todo.Back();
+                    todo.PopBack();
                 }
                 else
                 {
@@ -182,8 +509,6 @@ inline NearestNeighborQueryResult3<T> BVH3<T>::GetNearestNeighbor(
             }
         }
     }
-
-    return best;
 }
 
 template <typename T>
@@ -197,8 +522,7 @@ inline bool BVH3<T>::IsIntersects(
 
     // prepare to traverse BVH for box
     static const int maxTreeDepth = 8 * sizeof(size_t);
-    const Node* todo[maxTreeDepth];
-    size_t todoPos = 0;
+    SmallVector<const Node*, maxTreeDepth> todo;
 
     // traverse BVH nodes for box
     const Node* node = m_nodes.data();
@@ -213,11 +537,11 @@ inline bool BVH3<T>::IsIntersects(
             }
 
             // grab next node to process from todo stack
-            if (todoPos > 0)
+            if (!todo.IsEmpty())
             {
                 // Dequeue
-                --todoPos;
-                node = todo[todoPos];
+                node = todo.Back();
+                todo.PopBack();
             }
             else
             {
@@ -242,8 +566,7 @@ inline bool BVH3<T>::IsIntersects(
             else
             {
                 // enqueue secondChild in todo stack
-                todo[todoPos] = secondChild;
-                ++todoPos;
+                todo.Append(secondChild);
                 node = firstChild;
             }
         }
@@ -263,8 +586,7 @@ inline bool BVH3<T>::IsIntersects(
 
     // prepare to traverse BVH for ray
     static const int maxTreeDepth = 8 * sizeof(size_t);
-    const Node* todo[maxTreeDepth];
-    size_t todoPos = 0;
+    SmallVector<const Node*, maxTreeDepth> todo;
 
     // traverse BVH nodes for ray
     const Node* node = m_nodes.data();
@@ -279,11 +601,11 @@ inline bool BVH3<T>::IsIntersects(
             }
 
             // grab next node to process from todo stack
-            if (todoPos > 0)
+            if (!todo.IsEmpty())
             {
                 // Dequeue
-                --todoPos;
-                node = todo[todoPos];
+                node = todo.Back();
+                todo.PopBack();
             }
             else
             {
@@ -319,8 +641,7 @@ inline bool BVH3<T>::IsIntersects(
             else
             {
                 // enqueue secondChild in todo stack
-                todo[todoPos] = secondChild;
-                ++todoPos;
+                todo.Append(secondChild);
                 node = firstChild;
             }
         }
@@ -341,8 +662,7 @@ inline void BVH3<T>::ForEachIntersectingItem(
 
     // prepare to traverse BVH for box
     static const int maxTreeDepth = 8 * sizeof(size_t);
-    const Node* todo[maxTreeDepth];
-    size_t todoPos = 0;
+    SmallVector<const Node*, maxTreeDepth> todo;
 
     // traverse BVH nodes for box
     const Node* node = m_nodes.data();
@@ -357,11 +677,11 @@ inline void BVH3<T>::ForEachIntersectingItem(
             }
 
             // grab next node to process from todo stack
-            if (todoPos > 0)
+            if (!todo.IsEmpty())
             {
                 // Dequeue
-                --todoPos;
-                node = todo[todoPos];
+                node = todo.Back();
+                todo.PopBack();
             }
             else
             {
@@ -386,8 +706,7 @@ inline void BVH3<T>::ForEachIntersectingItem(
             else
             {
                 // enqueue secondChild in todo stack
-                todo[todoPos] = secondChild;
-                ++todoPos;
+                todo.Append(secondChild);
                 node = firstChild;
             }
         }
@@ -406,8 +725,7 @@ inline void BVH3<T>::ForEachIntersectingItem(
 
     // prepare to traverse BVH for ray
     static const int maxTreeDepth = 8 * sizeof(size_t);
-    const Node* todo[maxTreeDepth];
-    size_t todoPos = 0;
+    SmallVector<const Node*, maxTreeDepth> todo;
 
     // traverse BVH nodes for ray
     const Node* node = m_nodes.data();
@@ -422,11 +740,11 @@ inline void BVH3<T>::ForEachIntersectingItem(
             }
 
             // grab next node to process from todo stack
-            if (todoPos > 0)
+            if (!todo.IsEmpty())
             {
                 // Dequeue
-                --todoPos;
-                node = todo[todoPos];
+                node = todo.Back();
+                todo.PopBack();
             }
             else
             {
@@ -462,8 +780,7 @@ inline void BVH3<T>::ForEachIntersectingItem(
             else
             {
                 // enqueue secondChild in todo stack
-                todo[todoPos] = secondChild;
-                ++todoPos;
+                todo.Append(secondChild);
                 node = firstChild;
             }
         }
@@ -485,8 +802,7 @@ inline ClosestIntersectionQueryResult3<T> BVH3<T>::GetClosestIntersection(
 
     // prepare to traverse BVH for ray
     static const int maxTreeDepth = 8 * sizeof(size_t);
-    const Node* todo[maxTreeDepth];
-    size_t todoPos = 0;
+    SmallVector<const Node*, maxTreeDepth> todo;
 
     // traverse BVH nodes for ray
     const Node* node = m_nodes.data();
@@ -503,11 +819,11 @@ inline ClosestIntersectionQueryResult3<T> BVH3<T>::GetClosestIntersection(
             }
 
             // grab next node to process from todo stack
-            if (todoPos > 0)
+            if (!todo.IsEmpty())
             {
                 // Dequeue
-                --todoPos;
-                node = todo[todoPos];
+                node = todo.Back();
+                todo.PopBack();
             }
             else
             {
@@ -543,8 +859,7 @@ inline ClosestIntersectionQueryResult3<T> BVH3<T>::GetClosestIntersection(
             else
             {
                 // enqueue secondChild in todo stack
-                todo[todoPos] = secondChild;
-                ++todoPos;
+                todo.Append(secondChild);
                 node = firstChild;
             }
         }
@@ -553,6 +868,138 @@ inline ClosestIntersectionQueryResult3<T> BVH3<T>::GetClosestIntersection(
     return best;
 }
 
+template <typename T>
+inline void BVH3<T>::GetClosestIntersections(
+    const ConstArrayAccessor1<Ray3D>& rays,
+    const GetRayIntersectionFunc3<T>& testFunc,
+    ArrayAccessor1<ClosestIntersectionQueryResult3<T>> results) const
+{
+    constexpr size_t PACKET_SIZE = 8;
+
+    const size_t n = rays.size();
+    const size_t numPackets = (n + PACKET_SIZE - 1) / PACKET_SIZE;
+
+    ParallelFor(ZERO_SIZE, numPackets, [&](size_t packet) {
+        const size_t packetBegin = packet * PACKET_SIZE;
+        const size_t packetEnd = std::min(n, packetBegin + PACKET_SIZE);
+
+        ClosestIntersectionPacket(rays, packetBegin, packetEnd, testFunc,
+                                  results);
+    });
+}
+
+template <typename T>
+inline void BVH3<T>::ClosestIntersectionPacket(
+    const ConstArrayAccessor1<Ray3D>& rays, size_t packetBegin,
+    size_t packetEnd, const GetRayIntersectionFunc3<T>& testFunc,
+    ArrayAccessor1<ClosestIntersectionQueryResult3<T>> results) const
+{
+    bool anyHitsRoot = false;
+    for (size_t i = packetBegin; i < packetEnd; ++i)
+    {
+        results[i].distance = std::numeric_limits<double>::max();
+        results[i].item = nullptr;
+
+        anyHitsRoot |= m_bound.Intersects(rays[i]);
+    }
+
+    if (!anyHitsRoot)
+    {
+        return;
+    }
+
+    // A node is descended into if any ray of the packet hits its bound, so
+    // the packet visits the union of the per-ray node sets and every ray
+    // still sees each of its own leaves exactly once.
+    const auto anyIntersects = [&](const Node* candidate) {
+        for (size_t i = packetBegin; i < packetEnd; ++i)
+        {
+            if (candidate->bound.Intersects(rays[i]))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    // prepare to traverse BVH for the packet
+    static const int maxTreeDepth = 8 * sizeof(size_t);
+    SmallVector<const Node*, maxTreeDepth> todo;
+
+    // traverse BVH nodes for the packet
+    const Node* node = m_nodes.data();
+
+    while (node != nullptr)
+    {
+        if (node->IsLeaf())
+        {
+            for (size_t i = packetBegin; i < packetEnd; ++i)
+            {
+                // Skip rays that reached this leaf only through another
+                // packet member.
+                if (!node->bound.Intersects(rays[i]))
+                {
+                    continue;
+                }
+
+                const double dist = testFunc(m_items[node->item], rays[i]);
+                if (dist < results[i].distance)
+                {
+                    results[i].distance = dist;
+                    results[i].item = m_items.data() + node->item;
+                }
+            }
+
+            // grab next node to process from todo stack
+            if (!todo.IsEmpty())
+            {
+                // Dequeue
+                node = todo.Back();
+                todo.PopBack();
+            }
+            else
+            {
+                break;
+            }
+        }
+        else
+        {
+            // Order children along the dominant direction of the packet's
+            // first ray; coherent packets share the sign.
+            const Node* firstChild;
+            const Node* secondChild;
+
+            if (rays[packetBegin].direction[node->flags] > 0.0)
+            {
+                firstChild = node + 1;
+                secondChild = &m_nodes[node->child];
+            }
+            else
+            {
+                firstChild = &m_nodes[node->child];
+                secondChild = node + 1;
+            }
+
+            // advance to next child node, possibly enqueue other child
+            if (!anyIntersects(firstChild))
+            {
+                node = secondChild;
+            }
+            else if (!anyIntersects(secondChild))
+            {
+                node = firstChild;
+            }
+            else
+            {
+                // enqueue secondChild in todo stack
+                todo.Append(secondChild);
+                node = firstChild;
+            }
+        }
+    }
+}
+
 template <typename T>
 const BoundingBox3D& BVH3<T>::GetBoundingBox() const
 {
@@ -730,6 +1177,269 @@ size_t BVH3<T>::QSplit(size_t* itemIndices, size_t numItems, double pivot,
 
     return ret;
 }
+
+template <typename T>
+void BVH3<T>::BuildSAHRange(size_t nodeIndex, size_t* itemIndices,
+                            size_t nItems)
+{
+    if (nItems == 1)
+    {
+        m_nodes[nodeIndex].InitLeaf(itemIndices[0],
+                                    m_itemBounds[itemIndices[0]]);
+        return;
+    }
+
+    BoundingBox3D nodeBound;
+    for (size_t i = 0; i < nItems; ++i)
+    {
+        nodeBound.Merge(m_itemBounds[itemIndices[i]]);
+    }
+
+    uint8_t axis = 0;
+    const size_t midPoint = SAHSplit(itemIndices, nItems, &axis);
+
+    m_nodes[nodeIndex].InitInternal(axis, nodeIndex + 2 * midPoint, nodeBound);
+    BuildSAHRange(nodeIndex + 1, itemIndices, midPoint);
+    BuildSAHRange(nodeIndex + 2 * midPoint, itemIndices + midPoint,
+                  nItems - midPoint);
+}
+
+template <typename T>
+size_t BVH3<T>::SAHSplit(size_t* itemIndices, size_t nItems, uint8_t* axis)
+{
+    // Bin over the centroid bound rather than the node bound; overlapping
+    // items can make the node bound much wider than the centroid spread.
+    BoundingBox3D centroidBound;
+    for (size_t i = 0; i < nItems; ++i)
+    {
+        centroidBound.Merge(m_itemBounds[itemIndices[i]].MidPoint());
+    }
+
+    const Vector3D d = centroidBound.upperCorner - centroidBound.lowerCorner;
+    if (d.x > d.y && d.x > d.z)
+    {
+        *axis = 0;
+    }
+    else
+    {
+        *axis = (d.y > d.z) ? 1 : 2;
+    }
+
+    const double extent = d[*axis];
+    if (!(extent > 0.0))
+    {
+        // Every centroid coincides; no plane separates the items.
+        return nItems >> 1;
+    }
+
+    const double lower = centroidBound.lowerCorner[*axis];
+    const auto binOf = [&](size_t itemIndex) {
+        const double c = m_itemBounds[itemIndex].MidPoint()[*axis];
+        const auto bin = static_cast<size_t>(
+            static_cast<double>(SAH_NUM_BINS) * (c - lower) / extent);
+        return std::min(bin, SAH_NUM_BINS - 1);
+    };
+
+    BoundingBox3D binBounds[SAH_NUM_BINS];
+    size_t binCounts[SAH_NUM_BINS] = {};
+
+    for (size_t i = 0; i < nItems; ++i)
+    {
+        const size_t bin = binOf(itemIndices[i]);
+        binBounds[bin].Merge(m_itemBounds[itemIndices[i]]);
+        ++binCounts[bin];
+    }
+
+    const auto surfaceArea = [](const BoundingBox3D& b) {
+        const Vector3D e = b.upperCorner - b.lowerCorner;
+        return 2.0 * (e.x * e.y + e.y * e.z + e.z * e.x);
+    };
+
+    // Sweep the SAH cost of every boundary between adjacent bins: suffix
+    // bounds from the right first, then prefix bounds while evaluating.
+    double rightArea[SAH_NUM_BINS];
+    size_t rightCount[SAH_NUM_BINS];
+    BoundingBox3D suffix;
+    size_t suffixCount = 0;
+    for (size_t i = SAH_NUM_BINS; i-- > 1;)
+    {
+        suffix.Merge(binBounds[i]);
+        suffixCount += binCounts[i];
+        rightArea[i] = surfaceArea(suffix);
+        rightCount[i] = suffixCount;
+    }
+
+    size_t bestBoundary = 1;
+    double bestCost = std::numeric_limits<double>::max();
+    BoundingBox3D prefix;
+    size_t prefixCount = 0;
+    for (size_t i = 1; i < SAH_NUM_BINS; ++i)
+    {
+        prefix.Merge(binBounds[i - 1]);
+        prefixCount += binCounts[i - 1];
+
+        if (prefixCount == 0 || rightCount[i] == 0)
+        {
+            continue;
+        }
+
+        const double cost =
+            surfaceArea(prefix) * static_cast<double>(prefixCount) +
+            rightArea[i] * static_cast<double>(rightCount[i]);
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestBoundary = i;
+        }
+    }
+
+    size_t* const mid = std::partition(
+        itemIndices, itemIndices + nItems,
+        [&](size_t itemIndex) { return binOf(itemIndex) < bestBoundary; });
+
+    const auto ret = static_cast<size_t>(mid - itemIndices);
+    if (ret == 0 || ret == nItems)
+    {
+        return nItems >> 1;
+    }
+
+    return ret;
+}
+
+template <typename T>
+size_t BVH3<T>::MortonCode(size_t x, size_t y, size_t z, size_t bitsPerAxis)
+{
+    size_t code = 0;
+
+    for (size_t bit = 0; bit < bitsPerAxis; ++bit)
+    {
+        code |= ((x >> bit) & 1) << (3 * bit);
+        code |= ((y >> bit) & 1) << (3 * bit + 1);
+        code |= ((z >> bit) & 1) << (3 * bit + 2);
+    }
+
+    return code;
+}
+
+template <typename T>
+void BVH3<T>::BuildRange(size_t nodeIndex, const size_t* itemIndices,
+                         const size_t* codes, size_t nItems)
+{
+    if (nItems == 1)
+    {
+        m_nodes[nodeIndex].InitLeaf(itemIndices[0],
+                                    m_itemBounds[itemIndices[0]]);
+        return;
+    }
+
+    uint8_t axis = 0;
+    const size_t split = FindSplit(codes, nItems, &axis);
+
+    m_nodes[nodeIndex].InitInternal(axis, nodeIndex + 2 * split,
+                                    BoundingBox3D{});
+    BuildRange(nodeIndex + 1, itemIndices, codes, split);
+    BuildRange(nodeIndex + 2 * split, itemIndices + split, codes + split,
+               nItems - split);
+}
+
+template <typename T>
+size_t BVH3<T>::FindSplit(const size_t* codes, size_t nItems, uint8_t* axis)
+{
+    const size_t first = codes[0];
+    const size_t last = codes[nItems - 1];
+
+    if (first == last)
+    {
+        *axis = 0;
+        return nItems >> 1;
+    }
+
+    // The highest bit where the sorted range differs decides both the split
+    // position and the axis the split is perpendicular to.
+    size_t splitBit = 0;
+    for (size_t bit = 8 * sizeof(size_t); bit-- > 0;)
+    {
+        if (((first ^ last) >> bit) & 1)
+        {
+            splitBit = bit;
+            break;
+        }
+    }
+
+    *axis = static_cast<uint8_t>(splitBit % 3);
+
+    // Binary search for the first code with the split bit set. Both children
+    // are non-empty since the first code has the bit unset and the last has
+    // it set.
+    size_t low = 1;
+    size_t high = nItems - 1;
+
+    while (low < high)
+    {
+        const size_t mid = (low + high) / 2;
+
+        if ((codes[mid] >> splitBit) & 1)
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+
+    return low;
+}
+
+template <typename T>
+void BVH3<T>::RefitNodes()
+{
+    // Leaf bounds are independent pulls from the item bounds and dominate
+    // the node count, so they are refreshed in parallel. The internal merge
+    // pass must see children before parents, which reverse index order
+    // guarantees since both children of a node follow it in m_nodes.
+    ParallelFor(ZERO_SIZE, m_nodes.size(), [&](size_t i) {
+        Node& node = m_nodes[i];
+
+        if (node.IsLeaf())
+        {
+            node.bound = m_itemBounds[node.item];
+        }
+    });
+
+    for (size_t i = m_nodes.size(); i-- > 0;)
+    {
+        Node& node = m_nodes[i];
+
+        if (!node.IsLeaf())
+        {
+            node.bound = m_nodes[i + 1].bound;
+            node.bound.Merge(m_nodes[node.child].bound);
+        }
+    }
+
+    m_bound = m_nodes[0].bound;
+}
+
+template <typename T>
+double BVH3<T>::ComputeTreeCost() const
+{
+    double cost = 0.0;
+
+    for (const Node& node : m_nodes)
+    {
+        if (!node.IsLeaf())
+        {
+            const Vector3D extent =
+                node.bound.upperCorner - node.bound.lowerCorner;
+
+            cost += 2.0 * (extent.x * extent.y + extent.y * extent.z +
+                           extent.z * extent.x);
+        }
+    }
+
+    return cost;
+}
 }  // namespace CubbyFlow
 
 #endif
\ No newline at end of file
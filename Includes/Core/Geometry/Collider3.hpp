@@ -85,7 +85,8 @@ class Collider3
     [[nodiscard]] const Surface3Ptr& GetSurface() const;
 
     //! Updates the collider state.
-    void Update(double currentTimeInSeconds, double timeIntervalInSeconds);
+    virtual void Update(double currentTimeInSeconds,
+                        double timeIntervalInSeconds);
 
     //!
     //! \brief      Sets the callback function to be called when
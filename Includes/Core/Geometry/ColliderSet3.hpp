@@ -12,6 +12,7 @@
 #define CUBBYFLOW_COLLIDER_SET3_HPP
 
 #include <Core/Geometry/Collider3.hpp>
+#include <Core/Utils/Macros.hpp>
 
 #include <vector>
 
@@ -32,6 +33,10 @@ class ColliderSet3 final : public Collider3
     //! Returns the velocity of the collider at given \p point.
     [[nodiscard]] Vector3D VelocityAt(const Vector3D& point) const override;
 
+    //! Updates the collider state and rebuilds the broadphase hash grid.
+    void Update(double currentTimeInSeconds,
+                double timeIntervalInSeconds) override;
+
     //! Adds a collider to the set.
     void AddCollider(const Collider3Ptr& collider);
 
@@ -45,7 +50,21 @@ class ColliderSet3 final : public Collider3
     [[nodiscard]] static Builder GetBuilder();
 
  private:
+    //! Rebuilds the spatial hash over member collider bounding boxes.
+    void RebuildBroadphase();
+
+    //! Returns the hash key for the given broadphase cell index.
+    [[nodiscard]] size_t GetBroadphaseKey(ssize_t x, ssize_t y,
+                                          ssize_t z) const;
+
     std::vector<Collider3Ptr> m_colliders;
+
+    //! Uniform spatial hash over collider bounding boxes. Rebuilt by
+    //! ColliderSet3::Update so that per-point queries only test colliders
+    //! overlapping nearby cells instead of the whole set.
+    double m_broadphaseCellSize = 0.0;
+    std::vector<std::vector<size_t>> m_broadphaseBuckets;
+    std::vector<size_t> m_unboundedColliders;
 };
 
 //! Shared pointer for the ColliderSet3 type.
@@ -0,0 +1,99 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_COMPACT_POINT_KDTREE3_HPP
+#define CUBBYFLOW_COMPACT_POINT_KDTREE3_HPP
+
+#include <Core/Array/ArrayAccessor1.hpp>
+#include <Core/Vector/Vector3.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Compact 3-D k-d tree specialized for fixed-radius point queries.
+//!
+//! Unlike the generic KdTree, which stores one full point per node, this tree
+//! keeps its nodes in a flat preorder array (the left child always follows its
+//! parent, only the right child index is stored) and terminates in leaves of
+//! up to eight points. The leaf points live contiguously in structure-of-
+//! arrays layout, so the distance test against a query sphere is a short
+//! branch-free loop over packed coordinates that compilers can vectorize.
+//! This is the access pattern the SPH neighbor queries issue almost
+//! exclusively, which is what this class is tuned for.
+//!
+class CompactPointKdTree3 final
+{
+ public:
+    //! Builds internal acceleration structure for given points list.
+    void Build(const ConstArrayAccessor1<Vector3D>& points);
+
+    //!
+    //! Invokes the callback function for each nearby point around the origin
+    //! within given radius. The callback receives the index the point had in
+    //! the list passed to Build.
+    //!
+    //! \param[in]  origin   The origin position.
+    //! \param[in]  radius   The search radius.
+    //! \param[in]  callback The callback function.
+    //!
+    void ForEachNearbyPoint(
+        const Vector3D& origin, double radius,
+        const std::function<void(size_t, const Vector3D&)>& callback) const;
+
+    //!
+    //! Returns true if there are any nearby points for given origin within
+    //! radius.
+    //!
+    //! \param[in]  origin The origin.
+    //! \param[in]  radius The radius.
+    //!
+    //! \return     True if has nearby point, false otherwise.
+    //!
+    [[nodiscard]] bool HasNearbyPoint(const Vector3D& origin,
+                                      double radius) const;
+
+    //! Returns the number of stored points.
+    [[nodiscard]] size_t GetNumberOfPoints() const;
+
+    //! Copies the stored points into \p points in the original item order.
+    void GetPoints(std::vector<Vector3D>* points) const;
+
+    //! Returns the bytes held by the tree nodes and packed coordinates.
+    [[nodiscard]] size_t GetMemoryUsage() const;
+
+ private:
+    //! Maximum number of points per leaf.
+    static constexpr size_t MAX_LEAF_SIZE = 8;
+
+    //! Split axis if flags < 3, leaf indicator if flags == 3.
+    struct Node
+    {
+        size_t flags = 3;
+        size_t child = std::numeric_limits<size_t>::max();
+        size_t begin = 0;
+        size_t end = 0;
+        double split = 0.0;
+    };
+
+    size_t Build(size_t* itemIndices, size_t nItems,
+                 const ConstArrayAccessor1<Vector3D>& points);
+
+    std::vector<Node> m_nodes;
+    std::vector<double> m_pointsX;
+    std::vector<double> m_pointsY;
+    std::vector<double> m_pointsZ;
+    std::vector<size_t> m_itemIndices;
+};
+}  // namespace CubbyFlow
+
+#endif
@@ -12,8 +12,12 @@
 #define CUBBYFLOW_CUSTOM_IMPLICIT_SURFACE3_HPP
 
 #include <Core/Geometry/ImplicitSurface3.hpp>
+#include <Core/Geometry/Size3.hpp>
 
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <vector>
 
 namespace CubbyFlow
 {
@@ -43,6 +47,26 @@ class CustomImplicitSurface3 final : public ImplicitSurface3
                                     const Transform3& _transform = Transform3{},
                                     bool _isNormalFlipped = false);
 
+    //!
+    //! \brief Enables (or disables) the memoizing evaluation cache.
+    //!
+    //! When enabled, signed-distance queries first consult a coarse grid of
+    //! cached function samples spanning the domain. Grid tiles are filled
+    //! lazily on first access with a double-checked atomic claim, so
+    //! concurrent queries never block: a thread that finds a tile under
+    //! construction simply evaluates the function exactly. Queries whose
+    //! interpolated value lies within \p refinementBandWidth of the surface
+    //! also fall back to exact evaluation, keeping full accuracy where it
+    //! matters. Requires a bounded domain, and assumes the function does not
+    //! change over time. Pass zero \p cacheGridSpacing to disable.
+    //!
+    //! \param[in] cacheGridSpacing    Sample spacing of the cache grid.
+    //! \param[in] refinementBandWidth Distance from the surface within which
+    //!                                queries stay exact.
+    //!
+    void SetEvaluationCache(double cacheGridSpacing,
+                            double refinementBandWidth);
+
     //! Returns builder for CustomImplicitSurface3.
     [[nodiscard]] static Builder GetBuilder();
 
@@ -65,11 +89,32 @@ class CustomImplicitSurface3 final : public ImplicitSurface3
 
     [[nodiscard]] Vector3D GradientLocal(const Vector3D& x) const;
 
+    //! Fills the given cache tile if this thread wins the claim. Returns
+    //! true when the tile is ready to read.
+    [[nodiscard]] bool EnsureCacheTile(size_t tileX, size_t tileY,
+                                       size_t tileZ) const;
+
+    //! Attempts to answer a signed-distance query from the cache. Returns
+    //! false when the query must be evaluated exactly.
+    [[nodiscard]] bool TryCachedSignedDistance(const Vector3D& otherPoint,
+                                               double* result) const;
+
+    //! Nodes per cache tile along each axis.
+    static constexpr size_t CACHE_TILE_SIZE = 8;
+
     std::function<double(const Vector3D&)> m_func;
     BoundingBox3D m_domain;
     double m_resolution = 1e-3;
     double m_rayMarchingResolution = 1e-6;
     unsigned int m_maxNumberOfIterations = 5;
+
+    double m_cacheGridSpacing = 0.0;
+    double m_cacheRefinementBandWidth = 0.0;
+    Size3 m_cacheNodeCount;
+    Size3 m_cacheTileCount;
+    Vector3D m_cacheActualSpacing;
+    mutable std::vector<double> m_cacheValues;
+    mutable std::unique_ptr<std::atomic<int>[]> m_cacheTileStates;
 };
 
 //! Shared pointer type for the CustomImplicitSurface3.
@@ -101,6 +146,11 @@ class CustomImplicitSurface3::Builder final
     //! searches.
     [[nodiscard]] Builder& WithMaxNumberOfIterations(unsigned int numIter);
 
+    //! Returns builder with the memoizing evaluation cache enabled.
+    //! \see CustomImplicitSurface3::SetEvaluationCache
+    [[nodiscard]] Builder& WithEvaluationCache(double cacheGridSpacing,
+                                               double refinementBandWidth);
+
     //! Builds CustomImplicitSurface3.
     [[nodiscard]] CustomImplicitSurface3 Build() const;
 
@@ -113,6 +163,8 @@ class CustomImplicitSurface3::Builder final
     double m_resolution = 1e-3;
     double m_rayMarchingResolution = 1e-6;
     unsigned int m_maxNumberOfIterations = 5;
+    double m_cacheGridSpacing = 0.0;
+    double m_cacheRefinementBandWidth = 0.0;
 };
 }  // namespace CubbyFlow
 
@@ -11,6 +11,7 @@
 #ifndef CUBBYFLOW_IMPLICIT_SURFACE3_HPP
 #define CUBBYFLOW_IMPLICIT_SURFACE3_HPP
 
+#include <Core/Array/ArrayAccessor1.hpp>
 #include <Core/Geometry/Surface3.hpp>
 
 namespace CubbyFlow
@@ -41,6 +42,42 @@ class ImplicitSurface3 : public Surface3
     //! Returns signed distance from the given point \p otherPoint.
     [[nodiscard]] double SignedDistance(const Vector3D& otherPoint) const;
 
+    //!
+    //! \brief Returns signed distances for a batch of points.
+    //!
+    //! Evaluates the signed distance at every position of \p points and
+    //! stores the results in \p results. The default implementation loops
+    //! over the scalar query; surfaces with a cheap closed-form distance
+    //! override this so one virtual dispatch covers the whole batch and the
+    //! inner loop can vectorize. Grid rasterization passes that query
+    //! millions of points per frame should prefer this overload.
+    //!
+    virtual void SignedDistance(const ConstArrayAccessor1<Vector3D>& points,
+                                ArrayAccessor1<double> results) const;
+
+    //!
+    //! \brief Returns the gradient of the signed distance field at
+    //!        \p otherPoint.
+    //!
+    //! The default implementation approximates the gradient with central
+    //! finite differences over SignedDistance, which costs six extra
+    //! distance evaluations per query. Surfaces with a closed-form distance
+    //! override this with the exact gradient; collision response and
+    //! closest-normal queries should prefer it over hand-rolled stencils.
+    //!
+    [[nodiscard]] virtual Vector3D Gradient(const Vector3D& otherPoint) const;
+
+    //!
+    //! \brief Returns signed-distance gradients for a batch of points.
+    //!
+    //! Evaluates the gradient at every position of \p points and stores the
+    //! results in \p results. The default implementation loops over the
+    //! scalar query; primitive-backed surfaces override it so the primitive
+    //! type is resolved once per batch instead of once per point.
+    //!
+    virtual void Gradient(const ConstArrayAccessor1<Vector3D>& points,
+                          ArrayAccessor1<Vector3D> results) const;
+
  protected:
     //! Returns signed distance from the given point \p otherPoint in local
     //! space.
@@ -0,0 +1,53 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_IMPLICIT_SURFACE_SET_TO_SDF_HPP
+#define CUBBYFLOW_IMPLICIT_SURFACE_SET_TO_SDF_HPP
+
+#include <Core/Geometry/ImplicitSurfaceSet3.hpp>
+#include <Core/Grid/ScalarGrid3.hpp>
+
+namespace CubbyFlow
+{
+//! \brief Rasterizes an implicit surface set into a signed-distance field.
+//! This function generates a signed-distance field from an implicit surface
+//! set by adaptively descending an octree over the grid instead of querying
+//! the full set for every cell. Each octant is classified by the set distance
+//! at its center: octants that provably contain no zero crossing are filled
+//! with a conservative distance bound, and only octants near the interface
+//! are refined down to individual cells, which are then evaluated against the
+//! member surfaces culled by bounding-box distance. Cells within three grid
+//! spacings of the interface receive the exact set distance; farther cells
+//! receive a lower bound on the distance magnitude with the correct sign,
+//! which is sufficient for the level-set solvers and colliders that only
+//! resolve a narrow band. The classification assumes the member surfaces
+//! return true (Lipschitz) distances.
+//!
+//! \param[in]      surfaceSet  The implicit surface set.
+//! \param[in,out]  sdf         The output signed-distance field.
+//!
+void ImplicitSurfaceSetToSDF(const ImplicitSurfaceSet3& surfaceSet,
+                             ScalarGrid3* sdf);
+
+//! \brief Rasterizes an implicit surface set with a custom exact band.
+//! Same as above, but the width of the band around the interface that is
+//! evaluated exactly is given in world units. Larger values of \p bandwidth
+//! refine more cells and skip fewer; the bound magnitude of every skipped
+//! cell is guaranteed to exceed \p bandwidth.
+//!
+//! \param[in]      surfaceSet  The implicit surface set.
+//! \param[in,out]  sdf         The output signed-distance field.
+//! \param[in]      bandwidth   Width of the exactly evaluated band.
+//!
+void ImplicitSurfaceSetToSDF(const ImplicitSurfaceSet3& surfaceSet,
+                             ScalarGrid3* sdf, double bandwidth);
+}  // namespace CubbyFlow
+
+#endif
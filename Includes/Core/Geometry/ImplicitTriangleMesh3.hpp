@@ -32,11 +32,21 @@ class ImplicitTriangleMesh3 final : public ImplicitSurface3
  public:
     class Builder;
 
-    //! Constructs an ImplicitSurface3 with mesh and other grid parameters.
-    explicit ImplicitTriangleMesh3(TriangleMesh3Ptr mesh,
-                                   size_t resolutionX = 32, double margin = 0.2,
-                                   const Transform3& _transform = Transform3{},
-                                   bool _isNormalFlipped = false);
+    //!
+    //! \brief Constructs an ImplicitSurface3 with mesh and other grid
+    //! parameters.
+    //!
+    //! When \p bakeCacheDirectory is non-empty, the baked SDF grid is cached
+    //! on disk in that directory, keyed by a hash of the mesh geometry,
+    //! \p resolutionX, and \p margin. A later construction with the same
+    //! inputs loads the cached grid instead of re-running the bake. Stale or
+    //! unreadable cache entries fall back to a fresh bake.
+    //!
+    explicit ImplicitTriangleMesh3(
+        TriangleMesh3Ptr mesh, size_t resolutionX = 32, double margin = 0.2,
+        const Transform3& _transform = Transform3{},
+        bool _isNormalFlipped = false,
+        const std::string& bakeCacheDirectory = std::string{});
 
     //! Default copy constructor.
     ImplicitTriangleMesh3(const ImplicitTriangleMesh3&) = default;
@@ -60,6 +70,14 @@ class ImplicitTriangleMesh3 final : public ImplicitSurface3
     //! Returns grid data.
     [[nodiscard]] const VertexCenteredScalarGrid3Ptr& GetGrid() const;
 
+    //!
+    //! \brief Returns the signed-distance gradient at \p otherPoint.
+    //!
+    //! Trilinearly interpolated gradient of the baked SDF grid, replacing
+    //! the six-sample finite-difference fallback of the base class.
+    //!
+    [[nodiscard]] Vector3D Gradient(const Vector3D& otherPoint) const override;
+
  private:
     [[nodiscard]] Vector3D ClosestPointLocal(
         const Vector3D& otherPoint) const override;
@@ -103,6 +121,11 @@ class ImplicitTriangleMesh3::Builder final : public SurfaceBuilderBase3<Builder>
     //! Returns builder with margin around the mesh.
     [[nodiscard]] Builder& WithMargin(double margin);
 
+    //! Returns builder with on-disk bake cache directory. An empty string
+    //! (the default) disables the cache.
+    [[nodiscard]] Builder& WithBakeCacheDirectory(
+        const std::string& bakeCacheDirectory);
+
     //! Builds ImplicitTriangleMesh3.
     [[nodiscard]] ImplicitTriangleMesh3 Build() const;
 
@@ -113,6 +136,7 @@ class ImplicitTriangleMesh3::Builder final : public SurfaceBuilderBase3<Builder>
     TriangleMesh3Ptr m_mesh;
     size_t m_resolutionX = 32;
     double m_margin = 0.2;
+    std::string m_bakeCacheDirectory;
 };
 }  // namespace CubbyFlow
 
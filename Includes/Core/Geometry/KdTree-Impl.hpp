@@ -11,6 +11,8 @@
 #ifndef CUBBYFLOW_KDTREE_IMPL_HPP
 #define CUBBYFLOW_KDTREE_IMPL_HPP
 
+#include <Core/Utils/SmallVector.hpp>
+
 #include <numeric>
 
 namespace CubbyFlow
@@ -69,8 +71,7 @@ void KdTree<T, K>::ForEachNearbyPoint(
 
     // prepare to traverse the tree for sphere
     static const int maxTreeDepth = 8 * sizeof(size_t);
-    const Node* todo[maxTreeDepth];
-    size_t todoPos = 0;
+    SmallVector<const Node*, maxTreeDepth> todo;
 
     // traverse the tree nodes for sphere
     const Node* node = m_nodes.data();
@@ -86,11 +87,11 @@ void KdTree<T, K>::ForEachNearbyPoint(
         if (node->IsLeaf())
         {
             // grab next node to process from todo stack
-            if (todoPos > 0)
+            if (!todo.IsEmpty())
             {
                 // dequeue
-                --todoPos;
-                node = todo[todoPos];
+                node = todo.Back();
+                todo.PopBack();
             }
             else
             {
@@ -118,8 +119,7 @@ void KdTree<T, K>::ForEachNearbyPoint(
             else
             {
                 // enqueue secondChild in todo stack
-                todo[todoPos] = secondChild;
-                ++todoPos;
+                todo.Append(secondChild);
                 node = firstChild;
             }
         }
@@ -133,8 +133,7 @@ bool KdTree<T, K>::HasNearbyPoint(const Point& origin, T radius) const
 
     // prepare to traverse the tree for sphere
     static const int maxTreeDepth = 8 * sizeof(size_t);
-    const Node* todo[maxTreeDepth];
-    size_t todoPos = 0;
+    SmallVector<const Node*, maxTreeDepth> todo;
 
     // traverse the tree nodes for sphere
     const Node* node = m_nodes.data();
@@ -150,11 +149,11 @@ bool KdTree<T, K>::HasNearbyPoint(const Point& origin, T radius) const
         if (node->IsLeaf())
         {
             // grab next node to process from todo stack
-            if (todoPos > 0)
+            if (!todo.IsEmpty())
             {
                 // dequeue
-                --todoPos;
-                node = todo[todoPos];
+                node = todo.Back();
+                todo.PopBack();
             }
             else
             {
@@ -182,8 +181,7 @@ bool KdTree<T, K>::HasNearbyPoint(const Point& origin, T radius) const
             else
             {
                 // enqueue secondChild in todo stack
-                todo[todoPos] = secondChild;
-                ++todoPos;
+                todo.Append(secondChild);
                 node = firstChild;
             }
         }
@@ -197,8 +195,7 @@ size_t KdTree<T, K>::GetNearestPoint(const Point& origin) const
 {
     // prepare to traverse the tree for sphere
     static const int maxTreeDepth = 8 * sizeof(size_t);
-    const Node* todo[maxTreeDepth];
-    size_t todoPos = 0;
+    SmallVector<const Node*, maxTreeDepth> todo;
 
     // traverse the tree nodes for sphere
     const Node* node = m_nodes.data();
@@ -217,11 +214,11 @@ size_t KdTree<T, K>::GetNearestPoint(const Point& origin) const
         if (node->IsLeaf())
         {
             // grab next node to process from todo stack
-            if (todoPos > 0)
+            if (!todo.IsEmpty())
             {
                 // Dequeue
-                --todoPos;
-                node = todo[todoPos];
+                node = todo.Back();
+                todo.PopBack();
             }
             else
             {
@@ -250,8 +247,7 @@ size_t KdTree<T, K>::GetNearestPoint(const Point& origin) const
             else
             {
                 // enqueue secondChild in todo stack
-                todo[todoPos] = secondChild;
-                ++todoPos;
+                todo.Append(secondChild);
                 node = firstChild;
             }
         }
@@ -0,0 +1,107 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_OBJ_TO_SDF_PIPELINE_HPP
+#define CUBBYFLOW_OBJ_TO_SDF_PIPELINE_HPP
+
+#include <Core/Geometry/TriangleMesh3.hpp>
+#include <Core/Grid/VertexCenteredScalarGrid3.hpp>
+
+#include <functional>
+#include <istream>
+
+namespace CubbyFlow
+{
+//! \brief Tuning knobs for the streaming OBJ-to-SDF pipeline.
+struct ObjToSDFPipelineSettings
+{
+    //! Grid resolution along the x-axis; y/z follow the mesh aspect ratio.
+    size_t resolutionX = 100;
+
+    //! Margin around the mesh bounds, as a fraction of the bounds extent.
+    double marginScale = 0.2;
+
+    //! Bytes pulled from the OBJ stream per chunk. Each chunk is tokenized
+    //! in parallel while the next one is fetched from the stream.
+    size_t readChunkSize = 1 << 20;
+
+    //! Far-field accuracy ratio for the winding-number sign test. Zero or
+    //! negative falls back to TriangleMesh3::IsInside.
+    double windingNumberAccuracy = 0.0;
+};
+
+//! Callback invoked with the half-open z-slab [kBegin, kEnd) of the SDF grid
+//! once its values are final. Runs on a worker thread, overlapped with the
+//! computation of the following slab, so it must only touch the given range.
+using SDFSlabWriter = std::function<void(size_t kBegin, size_t kEnd)>;
+
+//!
+//! \brief Streams an OBJ from \p stream into \p mesh chunk by chunk.
+//!
+//! Unlike TriangleMesh3::ReadObj, which materializes the whole file before
+//! building the mesh, this reader pulls \p readChunkSize bytes at a time,
+//! tokenizes the chunk's lines in parallel, and appends the records to the
+//! mesh in file order while the next chunk is fetched on a worker thread.
+//! Polygonal faces are fan-triangulated. Since records are resolved as they
+//! stream by, faces must reference vertices that appear earlier in the file
+//! (which is how exporters write OBJ); a forward reference fails the parse.
+//!
+//! \param[in]      stream          The OBJ input stream.
+//! \param[in,out]  mesh            The mesh to append to.
+//! \param[in]      readChunkSize   Bytes read from the stream per chunk.
+//!
+//! \return true on success.
+//!
+bool ReadObjStreaming(std::istream* stream, TriangleMesh3* mesh,
+                      size_t readChunkSize = 1 << 20);
+
+//!
+//! \brief Generates the signed-distance field slab by slab.
+//!
+//! Produces the same field as TriangleMeshToSDF, but evaluates one z-slab of
+//! grid points at a time and hands each finished slab to \p slabWriter on a
+//! worker thread, overlapped with the computation of the next slab. This lets
+//! callers stream high-resolution bakes to disk without holding the writer on
+//! the critical path. Passing a positive \p windingNumberAccuracy switches
+//! the sign test to the fast winding number, as in the TriangleMeshToSDF
+//! overload.
+//!
+//! \param[in]      mesh                    The mesh.
+//! \param[in,out]  sdf                     The output signed-distance field.
+//! \param[in]      windingNumberAccuracy   Far-field approximation ratio;
+//!                                         zero or negative uses IsInside.
+//! \param[in]      slabWriter              Optional per-slab completion
+//!                                         callback.
+//!
+void TriangleMeshToSDFSlabs(const TriangleMesh3& mesh, ScalarGrid3* sdf,
+                            double windingNumberAccuracy,
+                            const SDFSlabWriter& slabWriter);
+
+//!
+//! \brief End-to-end OBJ-to-SDF pipeline.
+//!
+//! Stream-parses the OBJ, sizes \p sdf from the mesh bounds plus margin
+//! (resolution along y/z follows the mesh aspect ratio), overlaps the BVH
+//! build with the grid allocation, and bakes the field slab by slab through
+//! TriangleMeshToSDFSlabs.
+//!
+//! \param[in]      objStream   The OBJ input stream.
+//! \param[in,out]  sdf         The output vertex-centered grid.
+//! \param[in]      settings    Pipeline settings.
+//! \param[in]      slabWriter  Optional per-slab completion callback.
+//!
+//! \return true on success.
+//!
+bool ObjToSDF(std::istream* objStream, VertexCenteredScalarGrid3* sdf,
+              const ObjToSDFPipelineSettings& settings = {},
+              const SDFSlabWriter& slabWriter = nullptr);
+}  // namespace CubbyFlow
+
+#endif
@@ -11,15 +11,16 @@
 #ifndef CUBBYFLOW_OCTREE_IMPL_HPP
 #define CUBBYFLOW_OCTREE_IMPL_HPP
 
+#include <Core/Utils/SmallVector.hpp>
+
 #include <numeric>
-#include <stack>
 
 namespace CubbyFlow
 {
 template <typename T>
 bool Octree<T>::Node::IsLeaf() const
 {
-    return firstChild == std::numeric_limits<size_t>::max();
+    return firstChild == INVALID_CHILD;
 }
 
 template <typename T>
@@ -31,6 +32,7 @@ void Octree<T>::Build(const std::vector<T>& items, const BoundingBox3D& bound,
     m_maxDepth = maxDepth;
     m_items = items;
     m_nodes.clear();
+    m_itemIndexPool.clear();
 
     // Normalize bounding box
     m_bbox = bound;
@@ -39,12 +41,30 @@ void Octree<T>::Build(const std::vector<T>& items, const BoundingBox3D& bound,
     m_bbox.upperCorner =
         m_bbox.lowerCorner + Vector3D{ maxEdgeLen, maxEdgeLen, maxEdgeLen };
 
-    // Build
+    // Build with per-node scratch item lists
     m_nodes.resize(1);
-    m_nodes[0].items.resize(m_items.size());
-    std::iota(m_nodes[0].items.begin(), m_nodes[0].items.end(), ZERO_SIZE);
+    std::vector<std::vector<uint32_t>> itemsPerNode(1);
+    itemsPerNode[0].resize(m_items.size());
+    std::iota(itemsPerNode[0].begin(), itemsPerNode[0].end(), 0);
+
+    Build(0, 1, m_bbox, testFunc, &itemsPerNode);
+
+    // Flatten the scratch lists into the shared item-index pool so every
+    // node's items are an inline [itemBegin, itemBegin + itemCount) range.
+    size_t totalItems = 0;
+    for (const auto& nodeItems : itemsPerNode)
+    {
+        totalItems += nodeItems.size();
+    }
+    m_itemIndexPool.reserve(totalItems);
 
-    Build(0, 1, m_bbox, testFunc);
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        m_nodes[i].itemBegin = static_cast<uint32_t>(m_itemIndexPool.size());
+        m_nodes[i].itemCount = static_cast<uint32_t>(itemsPerNode[i].size());
+        m_itemIndexPool.insert(m_itemIndexPool.end(), itemsPerNode[i].begin(),
+                               itemsPerNode[i].end());
+    }
 }
 
 template <typename T>
@@ -53,6 +73,7 @@ void Octree<T>::Clear()
     m_maxDepth = 1;
     m_items.clear();
     m_nodes.clear();
+    m_itemIndexPool.clear();
     m_bbox = BoundingBox3D();
 }
 
@@ -65,8 +86,9 @@ NearestNeighborQueryResult3<T> Octree<T>::GetNearestNeighbor(
     best.distance = std::numeric_limits<double>::max();
     best.item = nullptr;
 
-    // Prepare to traverse octree
-    std::stack<std::pair<const Node*, BoundingBox3D>> todo;
+    // Prepare to traverse octree. The inline capacity covers the pruned
+    // frontier of typical trees, so short queries never allocate.
+    SmallVector<std::pair<const Node*, BoundingBox3D>, 64> todo;
 
     // Traverse octree nodes
     const Node* node = m_nodes.data();
@@ -76,8 +98,9 @@ NearestNeighborQueryResult3<T> Octree<T>::GetNearestNeighbor(
     {
         if (node->IsLeaf())
         {
-            for (size_t itemIdx : node->items)
+            for (uint32_t i = 0; i < node->itemCount; ++i)
             {
+                const size_t itemIdx = m_itemIndexPool[node->itemBegin + i];
                 double d = distanceFunc(m_items[itemIdx], pt);
                 if (d < best.distance)
                 {
@@ -87,14 +110,14 @@ NearestNeighborQueryResult3<T> Octree<T>::GetNearestNeighbor(
             }
 
             // Grab next node to process from todo stack
-            if (todo.empty())
+            if (todo.IsEmpty())
             {
                 break;
             }
 
-            node = todo.top().first;
-            bound = todo.top().second;
-            todo.pop();
+            node = todo.Back().first;
+            bound = todo.Back().second;
+            todo.PopBack();
         }
         else
         {
@@ -127,19 +150,19 @@ NearestNeighborQueryResult3<T> Octree<T>::GetNearestNeighbor(
 
                 if (std::get<1>(childPair) < bestDistSqr)
                 {
-                    todo.emplace(std::get<0>(childPair),
-                                 std::get<2>(childPair));
+                    todo.Append({ std::get<0>(childPair),
+                                  std::get<2>(childPair) });
                 }
             }
 
-            if (todo.empty())
+            if (todo.IsEmpty())
             {
                 break;
             }
 
-            node = todo.top().first;
-            bound = todo.top().second;
-            todo.pop();
+            node = todo.Back().first;
+            bound = todo.Back().second;
+            todo.PopBack();
         }
     }
 
@@ -150,14 +173,86 @@ template <typename T>
 bool Octree<T>::IsIntersects(const BoundingBox3D& box,
                              const BoxIntersectionTestFunc3<T>& testFunc) const
 {
-    return IsIntersects(box, testFunc, 0, m_bbox);
+    // Iterative depth-first traversal; the inline capacity covers the
+    // frontier of typical trees, so short queries never allocate.
+    SmallVector<std::pair<size_t, BoundingBox3D>, 64> todo;
+    todo.Append({ 0, m_bbox });
+
+    while (!todo.IsEmpty())
+    {
+        const size_t nodeIdx = todo.Back().first;
+        const BoundingBox3D bound = todo.Back().second;
+        todo.PopBack();
+
+        if (!box.Overlaps(bound))
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[nodeIdx];
+
+        for (uint32_t i = 0; i < node.itemCount; ++i)
+        {
+            if (testFunc(m_items[m_itemIndexPool[node.itemBegin + i]], box))
+            {
+                return true;
+            }
+        }
+
+        if (!node.IsLeaf())
+        {
+            for (int i = 7; i >= 0; --i)
+            {
+                todo.Append({ static_cast<size_t>(node.firstChild) + i,
+                              BoundingBox3D{ bound.Corner(i),
+                                             bound.MidPoint() } });
+            }
+        }
+    }
+
+    return false;
 }
 
 template <typename T>
 bool Octree<T>::IsIntersects(const Ray3D& ray,
                              const RayIntersectionTestFunc3<T>& testFunc) const
 {
-    return IsIntersects(ray, testFunc, 0, m_bbox);
+    SmallVector<std::pair<size_t, BoundingBox3D>, 64> todo;
+    todo.Append({ 0, m_bbox });
+
+    while (!todo.IsEmpty())
+    {
+        const size_t nodeIdx = todo.Back().first;
+        const BoundingBox3D bound = todo.Back().second;
+        todo.PopBack();
+
+        if (!bound.Intersects(ray))
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[nodeIdx];
+
+        for (uint32_t i = 0; i < node.itemCount; ++i)
+        {
+            if (testFunc(m_items[m_itemIndexPool[node.itemBegin + i]], ray))
+            {
+                return true;
+            }
+        }
+
+        if (!node.IsLeaf())
+        {
+            for (int i = 7; i >= 0; --i)
+            {
+                todo.Append({ static_cast<size_t>(node.firstChild) + i,
+                              BoundingBox3D{ bound.Corner(i),
+                                             bound.MidPoint() } });
+            }
+        }
+    }
+
+    return false;
 }
 
 template <typename T>
@@ -165,7 +260,43 @@ void Octree<T>::ForEachIntersectingItem(
     const BoundingBox3D& box, const BoxIntersectionTestFunc3<T>& testFunc,
     const IntersectionVisitorFunc3<T>& visitorFunc) const
 {
-    ForEachIntersectingItem(box, testFunc, visitorFunc, 0, m_bbox);
+    // Children are pushed in reverse so items are visited in the same order
+    // as the old recursive traversal.
+    SmallVector<std::pair<size_t, BoundingBox3D>, 64> todo;
+    todo.Append({ 0, m_bbox });
+
+    while (!todo.IsEmpty())
+    {
+        const size_t nodeIdx = todo.Back().first;
+        const BoundingBox3D bound = todo.Back().second;
+        todo.PopBack();
+
+        if (!box.Overlaps(bound))
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[nodeIdx];
+
+        for (uint32_t i = 0; i < node.itemCount; ++i)
+        {
+            const size_t itemIdx = m_itemIndexPool[node.itemBegin + i];
+            if (testFunc(m_items[itemIdx], box))
+            {
+                visitorFunc(m_items[itemIdx]);
+            }
+        }
+
+        if (!node.IsLeaf())
+        {
+            for (int i = 7; i >= 0; --i)
+            {
+                todo.Append({ static_cast<size_t>(node.firstChild) + i,
+                              BoundingBox3D{ bound.Corner(i),
+                                             bound.MidPoint() } });
+            }
+        }
+    }
 }
 
 template <typename T>
@@ -173,7 +304,41 @@ void Octree<T>::ForEachIntersectingItem(
     const Ray3D& ray, const RayIntersectionTestFunc3<T>& testFunc,
     const IntersectionVisitorFunc3<T>& visitorFunc) const
 {
-    ForEachIntersectingItem(ray, testFunc, visitorFunc, 0, m_bbox);
+    SmallVector<std::pair<size_t, BoundingBox3D>, 64> todo;
+    todo.Append({ 0, m_bbox });
+
+    while (!todo.IsEmpty())
+    {
+        const size_t nodeIdx = todo.Back().first;
+        const BoundingBox3D bound = todo.Back().second;
+        todo.PopBack();
+
+        if (!bound.Intersects(ray))
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[nodeIdx];
+
+        for (uint32_t i = 0; i < node.itemCount; ++i)
+        {
+            const size_t itemIdx = m_itemIndexPool[node.itemBegin + i];
+            if (testFunc(m_items[itemIdx], ray))
+            {
+                visitorFunc(m_items[itemIdx]);
+            }
+        }
+
+        if (!node.IsLeaf())
+        {
+            for (int i = 7; i >= 0; --i)
+            {
+                todo.Append({ static_cast<size_t>(node.firstChild) + i,
+                              BoundingBox3D{ bound.Corner(i),
+                                             bound.MidPoint() } });
+            }
+        }
+    }
 }
 
 template <typename T>
@@ -184,7 +349,45 @@ ClosestIntersectionQueryResult3<T> Octree<T>::GetClosestIntersection(
     best.distance = std::numeric_limits<double>::max();
     best.item = nullptr;
 
-    return GetClosestIntersection(ray, testFunc, 0, m_bbox, best);
+    SmallVector<std::pair<size_t, BoundingBox3D>, 64> todo;
+    todo.Append({ 0, m_bbox });
+
+    while (!todo.IsEmpty())
+    {
+        const size_t nodeIdx = todo.Back().first;
+        const BoundingBox3D bound = todo.Back().second;
+        todo.PopBack();
+
+        if (!bound.Intersects(ray))
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[nodeIdx];
+
+        for (uint32_t i = 0; i < node.itemCount; ++i)
+        {
+            const size_t itemIdx = m_itemIndexPool[node.itemBegin + i];
+            double dist = testFunc(m_items[itemIdx], ray);
+            if (dist < best.distance)
+            {
+                best.distance = dist;
+                best.item = &m_items[itemIdx];
+            }
+        }
+
+        if (!node.IsLeaf())
+        {
+            for (int i = 7; i >= 0; --i)
+            {
+                todo.Append({ static_cast<size_t>(node.firstChild) + i,
+                              BoundingBox3D{ bound.Corner(i),
+                                             bound.MidPoint() } });
+            }
+        }
+    }
+
+    return best;
 }
 
 template <typename T>
@@ -230,9 +433,12 @@ size_t Octree<T>::GetNumberOfNodes() const
 }
 
 template <typename T>
-const std::vector<size_t>& Octree<T>::GetItemsAtNode(size_t nodeIdx) const
+std::vector<size_t> Octree<T>::GetItemsAtNode(size_t nodeIdx) const
 {
-    return m_nodes[nodeIdx].items;
+    const Node& node = m_nodes[nodeIdx];
+    return std::vector<size_t>(
+        m_itemIndexPool.begin() + node.itemBegin,
+        m_itemIndexPool.begin() + node.itemBegin + node.itemCount);
 }
 
 template <typename T>
@@ -255,12 +461,15 @@ size_t Octree<T>::GetMaxDepth() const
 
 template <typename T>
 void Octree<T>::Build(size_t nodeIdx, size_t depth, const BoundingBox3D& bound,
-                      const BoxIntersectionTestFunc3<T>& testFunc)
+                      const BoxIntersectionTestFunc3<T>& testFunc,
+                      std::vector<std::vector<uint32_t>>* itemsPerNode)
 {
-    if (depth < m_maxDepth && !m_nodes[nodeIdx].items.empty())
+    if (depth < m_maxDepth && !(*itemsPerNode)[nodeIdx].empty())
     {
-        const size_t firstChild = m_nodes[nodeIdx].firstChild = m_nodes.size();
-        m_nodes.resize(m_nodes[nodeIdx].firstChild + 8);
+        const size_t firstChild = m_nodes.size();
+        m_nodes[nodeIdx].firstChild = static_cast<uint32_t>(firstChild);
+        m_nodes.resize(firstChild + 8);
+        itemsPerNode->resize(firstChild + 8);
 
         BoundingBox3D bboxPerNode[8];
 
@@ -269,15 +478,15 @@ void Octree<T>::Build(size_t nodeIdx, size_t depth, const BoundingBox3D& bound,
             bboxPerNode[i] = BoundingBox3D{ bound.Corner(i), bound.MidPoint() };
         }
 
-        auto& currentItems = m_nodes[nodeIdx].items;
+        auto& currentItems = (*itemsPerNode)[nodeIdx];
         for (size_t i = 0; i < currentItems.size(); ++i)
         {
-            size_t currentItem = currentItems[i];
+            uint32_t currentItem = currentItems[i];
             for (int j = 0; j < 8; ++j)
             {
                 if (testFunc(m_items[currentItem], bboxPerNode[j]))
                 {
-                    m_nodes[firstChild + j].items.push_back(currentItem);
+                    (*itemsPerNode)[firstChild + j].push_back(currentItem);
                 }
             }
         }
@@ -288,197 +497,12 @@ void Octree<T>::Build(size_t nodeIdx, size_t depth, const BoundingBox3D& bound,
         // Refine
         for (int i = 0; i < 8; ++i)
         {
-            Build(firstChild + i, depth + 1, bboxPerNode[i], testFunc);
+            Build(firstChild + i, depth + 1, bboxPerNode[i], testFunc,
+                  itemsPerNode);
         }
     }
 }
 
-template <typename T>
-bool Octree<T>::IsIntersects(const BoundingBox3D& box,
-                             const BoxIntersectionTestFunc3<T>& testFunc,
-                             size_t nodeIdx, const BoundingBox3D& bound) const
-{
-    if (!box.Overlaps(bound))
-    {
-        return false;
-    }
-
-    const Node& node = m_nodes[nodeIdx];
-
-    if (!node.items.empty())
-    {
-        for (size_t itemIdx : node.items)
-        {
-            if (testFunc(m_items[itemIdx], box))
-            {
-                return true;
-            }
-        }
-    }
-
-    if (node.firstChild != std::numeric_limits<size_t>::max())
-    {
-        for (int i = 0; i < 8; ++i)
-        {
-            if (IsIntersects(
-                    box, testFunc, node.firstChild + i,
-                    BoundingBox3D{ bound.Corner(i), bound.MidPoint() }))
-            {
-                return true;
-            }
-        }
-    }
-
-    return false;
-}
-
-template <typename T>
-bool Octree<T>::IsIntersects(const Ray3D& ray,
-                             const RayIntersectionTestFunc3<T>& testFunc,
-                             size_t nodeIdx, const BoundingBox3D& bound) const
-{
-    if (!bound.Intersects(ray))
-    {
-        return false;
-    }
-
-    const Node& node = m_nodes[nodeIdx];
-
-    if (!node.items.empty())
-    {
-        for (size_t itemIdx : node.items)
-        {
-            if (testFunc(m_items[itemIdx], ray))
-            {
-                return true;
-            }
-        }
-    }
-
-    if (node.firstChild != std::numeric_limits<size_t>::max())
-    {
-        for (int i = 0; i < 8; ++i)
-        {
-            if (IsIntersects(
-                    ray, testFunc, node.firstChild + i,
-                    BoundingBox3D{ bound.Corner(i), bound.MidPoint() }))
-            {
-                return true;
-            }
-        }
-    }
-
-    return false;
-}
-
-template <typename T>
-void Octree<T>::ForEachIntersectingItem(
-    const BoundingBox3D& box, const BoxIntersectionTestFunc3<T>& testFunc,
-    const IntersectionVisitorFunc3<T>& visitorFunc, size_t nodeIdx,
-    const BoundingBox3D& bound) const
-{
-    if (!box.Overlaps(bound))
-    {
-        return;
-    }
-
-    const Node& node = m_nodes[nodeIdx];
-
-    if (!node.items.empty())
-    {
-        for (size_t itemIdx : node.items)
-        {
-            if (testFunc(m_items[itemIdx], box))
-            {
-                visitorFunc(m_items[itemIdx]);
-            }
-        }
-    }
-
-    if (node.firstChild != std::numeric_limits<size_t>::max())
-    {
-        for (int i = 0; i < 8; ++i)
-        {
-            ForEachIntersectingItem(
-                box, testFunc, visitorFunc, node.firstChild + i,
-                BoundingBox3D{ bound.Corner(i), bound.MidPoint() });
-        }
-    }
-}
-
-template <typename T>
-void Octree<T>::ForEachIntersectingItem(
-    const Ray3D& ray, const RayIntersectionTestFunc3<T>& testFunc,
-    const IntersectionVisitorFunc3<T>& visitorFunc, size_t nodeIdx,
-    const BoundingBox3D& bound) const
-{
-    if (!bound.Intersects(ray))
-    {
-        return;
-    }
-
-    const Node& node = m_nodes[nodeIdx];
-
-    if (!node.items.empty())
-    {
-        for (size_t itemIdx : node.items)
-        {
-            if (testFunc(m_items[itemIdx], ray))
-            {
-                visitorFunc(m_items[itemIdx]);
-            }
-        }
-    }
-
-    if (node.firstChild != std::numeric_limits<size_t>::max())
-    {
-        for (int i = 0; i < 8; ++i)
-        {
-            ForEachIntersectingItem(
-                ray, testFunc, visitorFunc, node.firstChild + i,
-                BoundingBox3D{ bound.Corner(i), bound.MidPoint() });
-        }
-    }
-}
-
-template <typename T>
-ClosestIntersectionQueryResult3<T> Octree<T>::GetClosestIntersection(
-    const Ray3D& ray, const GetRayIntersectionFunc3<T>& testFunc,
-    size_t nodeIdx, const BoundingBox3D& bound,
-    ClosestIntersectionQueryResult3<T> best) const
-{
-    if (!bound.Intersects(ray))
-    {
-        return best;
-    }
-
-    const Node& node = m_nodes[nodeIdx];
-
-    if (!node.items.empty())
-    {
-        for (size_t itemIdx : node.items)
-        {
-            double dist = testFunc(m_items[itemIdx], ray);
-            if (dist < best.distance)
-            {
-                best.distance = dist;
-                best.item = &m_items[itemIdx];
-            }
-        }
-    }
-
-    if (node.firstChild != std::numeric_limits<size_t>::max())
-    {
-        for (int i = 0; i < 8; ++i)
-        {
-            best = GetClosestIntersection(
-                ray, testFunc, node.firstChild + i,
-                BoundingBox3D{ bound.Corner(i), bound.MidPoint() }, best);
-        }
-    }
-
-    return best;
-}
 }  // namespace CubbyFlow
 
 #endif
\ No newline at end of file
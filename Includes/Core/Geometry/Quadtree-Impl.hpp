@@ -11,15 +11,16 @@
 #ifndef CUBBYFLOW_QUADTREE_IMPL_HPP
 #define CUBBYFLOW_QUADTREE_IMPL_HPP
 
+#include <Core/Utils/SmallVector.hpp>
+
 #include <numeric>
-#include <stack>
 
 namespace CubbyFlow
 {
 template <typename T>
 bool Quadtree<T>::Node::IsLeaf() const
 {
-    return firstChild == std::numeric_limits<size_t>::max();
+    return firstChild == INVALID_CHILD;
 }
 
 template <typename T>
@@ -31,6 +32,7 @@ void Quadtree<T>::Build(const std::vector<T>& items, const BoundingBox2D& bound,
     m_maxDepth = maxDepth;
     m_items = items;
     m_nodes.clear();
+    m_itemIndexPool.clear();
 
     // Normalize bounding box
     m_bbox = bound;
@@ -38,12 +40,30 @@ void Quadtree<T>::Build(const std::vector<T>& items, const BoundingBox2D& bound,
     m_bbox.upperCorner =
         m_bbox.lowerCorner + Vector2D{ maxEdgeLen, maxEdgeLen };
 
-    // Build
+    // Build with per-node scratch item lists
     m_nodes.resize(1);
-    m_nodes[0].items.resize(m_items.size());
-    std::iota(m_nodes[0].items.begin(), m_nodes[0].items.end(), ZERO_SIZE);
+    std::vector<std::vector<uint32_t>> itemsPerNode(1);
+    itemsPerNode[0].resize(m_items.size());
+    std::iota(itemsPerNode[0].begin(), itemsPerNode[0].end(), 0);
+
+    Build(0, 1, m_bbox, testFunc, &itemsPerNode);
+
+    // Flatten the scratch lists into the shared item-index pool so every
+    // node's items are an inline [itemBegin, itemBegin + itemCount) range.
+    size_t totalItems = 0;
+    for (const auto& nodeItems : itemsPerNode)
+    {
+        totalItems += nodeItems.size();
+    }
+    m_itemIndexPool.reserve(totalItems);
 
-    Build(0, 1, m_bbox, testFunc);
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        m_nodes[i].itemBegin = static_cast<uint32_t>(m_itemIndexPool.size());
+        m_nodes[i].itemCount = static_cast<uint32_t>(itemsPerNode[i].size());
+        m_itemIndexPool.insert(m_itemIndexPool.end(), itemsPerNode[i].begin(),
+                               itemsPerNode[i].end());
+    }
 }
 
 template <typename T>
@@ -51,7 +71,8 @@ void Quadtree<T>::Clear()
 {
     m_maxDepth = 1;
     m_items.clear();
-    m_nodes.cloear();
+    m_nodes.clear();
+    m_itemIndexPool.clear();
     m_bbox = BoundingBox2D();
 }
 
@@ -64,8 +85,9 @@ NearestNeighborQueryResult2<T> Quadtree<T>::GetNearestNeighbor(
     best.distance = std::numeric_limits<double>::max();
     best.item = nullptr;
 
-    // Prepare to traverse quadtree
-    std::stack<std::pair<const Node*, BoundingBox2D>> todo;
+    // Prepare to traverse quadtree. The inline capacity covers the pruned
+    // frontier of typical trees, so short queries never allocate.
+    SmallVector<std::pair<const Node*, BoundingBox2D>, 64> todo;
 
     // Traverse quadtree nodes
     const Node* node = m_nodes.data();
@@ -74,8 +96,9 @@ NearestNeighborQueryResult2<T> Quadtree<T>::GetNearestNeighbor(
     {
         if (node->IsLeaf())
         {
-            for (size_t itemIdx : node->items)
+            for (uint32_t i = 0; i < node->itemCount; ++i)
             {
+                const size_t itemIdx = m_itemIndexPool[node->itemBegin + i];
                 double d = distanceFunc(m_items[itemIdx], pt);
                 if (d < best.distance)
                 {
@@ -85,14 +108,14 @@ NearestNeighborQueryResult2<T> Quadtree<T>::GetNearestNeighbor(
             }
 
             // Grab next node to process from todo stack
-            if (todo.empty())
+            if (todo.IsEmpty())
             {
                 break;
             }
 
-            node = todo.top().first;
-            bound = todo.top().second;
-            todo.pop();
+            node = todo.Back().first;
+            bound = todo.Back().second;
+            todo.PopBack();
         }
         else
         {
@@ -122,19 +145,19 @@ NearestNeighborQueryResult2<T> Quadtree<T>::GetNearestNeighbor(
                 const auto& childPair = childDistSqrPairs[i];
                 if (std::get<1>(childPair) < bestDistSqr)
                 {
-                    todo.emplace(std::get<0>(childPair),
-                                 std::get<2>(childPair));
+                    todo.Append({ std::get<0>(childPair),
+                                  std::get<2>(childPair) });
                 }
             }
 
-            if (todo.empty())
+            if (todo.IsEmpty())
             {
                 break;
             }
 
-            node = todo.top().first;
-            bound = todo.top().second;
-            todo.pop();
+            node = todo.Back().first;
+            bound = todo.Back().second;
+            todo.PopBack();
         }
     }
 
@@ -145,14 +168,86 @@ template <typename T>
 bool Quadtree<T>::IsIntersects(
     const BoundingBox2D& box, const BoxIntersectionTestFunc2<T>& testFunc) const
 {
-    return IsIntersects(box, testFunc, 0, m_bbox);
+    // Iterative depth-first traversal; the inline capacity covers the
+    // frontier of typical trees, so short queries never allocate.
+    SmallVector<std::pair<size_t, BoundingBox2D>, 64> todo;
+    todo.Append({ 0, m_bbox });
+
+    while (!todo.IsEmpty())
+    {
+        const size_t nodeIdx = todo.Back().first;
+        const BoundingBox2D bound = todo.Back().second;
+        todo.PopBack();
+
+        if (!box.Overlaps(bound))
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[nodeIdx];
+
+        for (uint32_t i = 0; i < node.itemCount; ++i)
+        {
+            if (testFunc(m_items[m_itemIndexPool[node.itemBegin + i]], box))
+            {
+                return true;
+            }
+        }
+
+        if (!node.IsLeaf())
+        {
+            for (int i = 3; i >= 0; --i)
+            {
+                todo.Append({ static_cast<size_t>(node.firstChild) + i,
+                              BoundingBox2D{ bound.Corner(i),
+                                             bound.MidPoint() } });
+            }
+        }
+    }
+
+    return false;
 }
 
 template <typename T>
 bool Quadtree<T>::IsIntersects(
     const Ray2D& ray, const RayIntersectionTestFunc2<T>& testFunc) const
 {
-    return IsIntersects(ray, testFunc, 0, m_bbox);
+    SmallVector<std::pair<size_t, BoundingBox2D>, 64> todo;
+    todo.Append({ 0, m_bbox });
+
+    while (!todo.IsEmpty())
+    {
+        const size_t nodeIdx = todo.Back().first;
+        const BoundingBox2D bound = todo.Back().second;
+        todo.PopBack();
+
+        if (!bound.Intersects(ray))
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[nodeIdx];
+
+        for (uint32_t i = 0; i < node.itemCount; ++i)
+        {
+            if (testFunc(m_items[m_itemIndexPool[node.itemBegin + i]], ray))
+            {
+                return true;
+            }
+        }
+
+        if (!node.IsLeaf())
+        {
+            for (int i = 3; i >= 0; --i)
+            {
+                todo.Append({ static_cast<size_t>(node.firstChild) + i,
+                              BoundingBox2D{ bound.Corner(i),
+                                             bound.MidPoint() } });
+            }
+        }
+    }
+
+    return false;
 }
 
 template <typename T>
@@ -160,7 +255,43 @@ void Quadtree<T>::ForEachIntersectingItem(
     const BoundingBox2D& box, const BoxIntersectionTestFunc2<T>& testFunc,
     const IntersectionVisitorFunc2<T>& visitorFunc) const
 {
-    ForEachIntersectingItem(box, testFunc, visitorFunc, 0, m_bbox);
+    // Children are pushed in reverse so items are visited in the same order
+    // as the old recursive traversal.
+    SmallVector<std::pair<size_t, BoundingBox2D>, 64> todo;
+    todo.Append({ 0, m_bbox });
+
+    while (!todo.IsEmpty())
+    {
+        const size_t nodeIdx = todo.Back().first;
+        const BoundingBox2D bound = todo.Back().second;
+        todo.PopBack();
+
+        if (!box.Overlaps(bound))
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[nodeIdx];
+
+        for (uint32_t i = 0; i < node.itemCount; ++i)
+        {
+            const size_t itemIdx = m_itemIndexPool[node.itemBegin + i];
+            if (testFunc(m_items[itemIdx], box))
+            {
+                visitorFunc(m_items[itemIdx]);
+            }
+        }
+
+        if (!node.IsLeaf())
+        {
+            for (int i = 3; i >= 0; --i)
+            {
+                todo.Append({ static_cast<size_t>(node.firstChild) + i,
+                              BoundingBox2D{ bound.Corner(i),
+                                             bound.MidPoint() } });
+            }
+        }
+    }
 }
 
 template <typename T>
@@ -168,7 +299,41 @@ void Quadtree<T>::ForEachIntersectingItem(
     const Ray2D& ray, const RayIntersectionTestFunc2<T>& testFunc,
     const IntersectionVisitorFunc2<T>& visitorFunc) const
 {
-    ForEachIntersectingItem(ray, testFunc, visitorFunc, 0, m_bbox);
+    SmallVector<std::pair<size_t, BoundingBox2D>, 64> todo;
+    todo.Append({ 0, m_bbox });
+
+    while (!todo.IsEmpty())
+    {
+        const size_t nodeIdx = todo.Back().first;
+        const BoundingBox2D bound = todo.Back().second;
+        todo.PopBack();
+
+        if (!bound.Intersects(ray))
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[nodeIdx];
+
+        for (uint32_t i = 0; i < node.itemCount; ++i)
+        {
+            const size_t itemIdx = m_itemIndexPool[node.itemBegin + i];
+            if (testFunc(m_items[itemIdx], ray))
+            {
+                visitorFunc(m_items[itemIdx]);
+            }
+        }
+
+        if (!node.IsLeaf())
+        {
+            for (int i = 3; i >= 0; --i)
+            {
+                todo.Append({ static_cast<size_t>(node.firstChild) + i,
+                              BoundingBox2D{ bound.Corner(i),
+                                             bound.MidPoint() } });
+            }
+        }
+    }
 }
 
 template <typename T>
@@ -179,7 +344,45 @@ ClosestIntersectionQueryResult2<T> Quadtree<T>::GetClosestIntersection(
     best.distance = std::numeric_limits<double>::max();
     best.item = nullptr;
 
-    return GetClosestIntersection(ray, testFunc, 0, m_bbox, best);
+    SmallVector<std::pair<size_t, BoundingBox2D>, 64> todo;
+    todo.Append({ 0, m_bbox });
+
+    while (!todo.IsEmpty())
+    {
+        const size_t nodeIdx = todo.Back().first;
+        const BoundingBox2D bound = todo.Back().second;
+        todo.PopBack();
+
+        if (!bound.Intersects(ray))
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[nodeIdx];
+
+        for (uint32_t i = 0; i < node.itemCount; ++i)
+        {
+            const size_t itemIdx = m_itemIndexPool[node.itemBegin + i];
+            double dist = testFunc(m_items[itemIdx], ray);
+            if (dist < best.distance)
+            {
+                best.distance = dist;
+                best.item = &m_items[itemIdx];
+            }
+        }
+
+        if (!node.IsLeaf())
+        {
+            for (int i = 3; i >= 0; --i)
+            {
+                todo.Append({ static_cast<size_t>(node.firstChild) + i,
+                              BoundingBox2D{ bound.Corner(i),
+                                             bound.MidPoint() } });
+            }
+        }
+    }
+
+    return best;
 }
 
 template <typename T>
@@ -225,9 +428,12 @@ size_t Quadtree<T>::GetNumberOfNodes() const
 }
 
 template <typename T>
-const std::vector<size_t>& Quadtree<T>::GetItemsAtNode(size_t nodeIdx) const
+std::vector<size_t> Quadtree<T>::GetItemsAtNode(size_t nodeIdx) const
 {
-    return m_nodes[nodeIdx].items;
+    const Node& node = m_nodes[nodeIdx];
+    return std::vector<size_t>(
+        m_itemIndexPool.begin() + node.itemBegin,
+        m_itemIndexPool.begin() + node.itemBegin + node.itemCount);
 }
 
 template <typename T>
@@ -251,12 +457,15 @@ size_t Quadtree<T>::GetMaxDepth() const
 template <typename T>
 void Quadtree<T>::Build(size_t nodeIdx, size_t depth,
                         const BoundingBox2D& bound,
-                        const BoxIntersectionTestFunc2<T>& testFunc)
+                        const BoxIntersectionTestFunc2<T>& testFunc,
+                        std::vector<std::vector<uint32_t>>* itemsPerNode)
 {
-    if (depth < m_maxDepth && !m_nodes[nodeIdx].items.empty())
+    if (depth < m_maxDepth && !(*itemsPerNode)[nodeIdx].empty())
     {
-        const size_t firstChild = m_nodes[nodeIdx].firstChild = m_nodes.size();
-        m_nodes.resize(m_nodes[nodeIdx].firstChild + 4);
+        const size_t firstChild = m_nodes.size();
+        m_nodes[nodeIdx].firstChild = static_cast<uint32_t>(firstChild);
+        m_nodes.resize(firstChild + 4);
+        itemsPerNode->resize(firstChild + 4);
 
         BoundingBox2D bboxPerNode[4];
 
@@ -265,15 +474,15 @@ void Quadtree<T>::Build(size_t nodeIdx, size_t depth,
             bboxPerNode[i] = BoundingBox2D{ bound.Corner(i), bound.MidPoint() };
         }
 
-        auto& currentItems = m_nodes[nodeIdx].items;
+        auto& currentItems = (*itemsPerNode)[nodeIdx];
         for (size_t i = 0; i < currentItems.size(); ++i)
         {
-            size_t currentItem = currentItems[i];
+            uint32_t currentItem = currentItems[i];
             for (int j = 0; j < 4; ++j)
             {
                 if (testFunc(m_items[currentItem], bboxPerNode[j]))
                 {
-                    m_nodes[firstChild + j].items.push_back(currentItem);
+                    (*itemsPerNode)[firstChild + j].push_back(currentItem);
                 }
             }
         }
@@ -284,197 +493,11 @@ void Quadtree<T>::Build(size_t nodeIdx, size_t depth,
         // Refine
         for (int i = 0; i < 4; ++i)
         {
-            Build(firstChild + i, depth + 1, bboxPerNode[i], testFunc);
+            Build(firstChild + i, depth + 1, bboxPerNode[i], testFunc,
+                  itemsPerNode);
         }
     }
 }
-
-template <typename T>
-bool Quadtree<T>::IsIntersects(const BoundingBox2D& box,
-                               const BoxIntersectionTestFunc2<T>& testFunc,
-                               size_t nodeIdx, const BoundingBox2D& bound) const
-{
-    if (!box.Overlaps(bound))
-    {
-        return false;
-    }
-
-    const Node& node = m_nodes[nodeIdx];
-
-    if (node.items.size() > 0)
-    {
-        for (size_t itemIdx : node.items)
-        {
-            if (testFunc(m_items[itemIdx], box))
-            {
-                return true;
-            }
-        }
-    }
-
-    if (node.firstChild != std::numeric_limits<size_t>::max())
-    {
-        for (int i = 0; i < 4; ++i)
-        {
-            if (IsIntersects(
-                    box, testFunc, node.firstChild + i,
-                    BoundingBox2D{ bound.Corner(i), bound.MidPoint() }))
-            {
-                return true;
-            }
-        }
-    }
-
-    return false;
-}
-
-template <typename T>
-bool Quadtree<T>::IsIntersects(const Ray2D& ray,
-                               const RayIntersectionTestFunc2<T>& testFunc,
-                               size_t nodeIdx, const BoundingBox2D& bound) const
-{
-    if (!bound.Intersects(ray))
-    {
-        return false;
-    }
-
-    const Node& node = m_nodes[nodeIdx];
-
-    if (node.items.size() > 0)
-    {
-        for (size_t itemIdx : node.items)
-        {
-            if (testFunc(m_items[itemIdx], ray))
-            {
-                return true;
-            }
-        }
-    }
-
-    if (node.firstChild != std::numeric_limits<size_t>::max())
-    {
-        for (int i = 0; i < 4; ++i)
-        {
-            if (IsIntersects(
-                    ray, testFunc, node.firstChild + i,
-                    BoundingBox2D{ bound.Corner(i), bound.MidPoint() }))
-            {
-                return true;
-            }
-        }
-    }
-
-    return false;
-}
-
-template <typename T>
-void Quadtree<T>::ForEachIntersectingItem(
-    const BoundingBox2D& box, const BoxIntersectionTestFunc2<T>& testFunc,
-    const IntersectionVisitorFunc2<T>& visitorFunc, size_t nodeIdx,
-    const BoundingBox2D& bound) const
-{
-    if (!box.Overlaps(bound))
-    {
-        return;
-    }
-
-    const Node& node = m_nodes[nodeIdx];
-
-    if (node.items.size() > 0)
-    {
-        for (size_t itemIdx : node.items)
-        {
-            if (testFunc(m_items[itemIdx], box))
-            {
-                visitorFunc(m_items[itemIdx]);
-            }
-        }
-    }
-
-    if (node.firstChild != std::numeric_limits<size_t>::max())
-    {
-        for (int i = 0; i < 4; ++i)
-        {
-            ForEachIntersectingItem(
-                box, testFunc, visitorFunc, node.firstChild + i,
-                BoundingBox2D{ bound.Corner(i), bound.MidPoint() });
-        }
-    }
-}
-
-template <typename T>
-void Quadtree<T>::ForEachIntersectingItem(
-    const Ray2D& ray, const RayIntersectionTestFunc2<T>& testFunc,
-    const IntersectionVisitorFunc2<T>& visitorFunc, size_t nodeIdx,
-    const BoundingBox2D& bound) const
-{
-    if (!bound.Intersects(ray))
-    {
-        return;
-    }
-
-    const Node& node = m_nodes[nodeIdx];
-
-    if (node.items.size() > 0)
-    {
-        for (size_t itemIdx : node.items)
-        {
-            if (testFunc(m_items[itemIdx], ray))
-            {
-                visitorFunc(m_items[itemIdx]);
-            }
-        }
-    }
-
-    if (node.firstChild != std::numeric_limits<size_t>::max())
-    {
-        for (int i = 0; i < 4; ++i)
-        {
-            ForEachIntersectingItem(
-                ray, testFunc, visitorFunc, node.firstChild + i,
-                BoundingBox2D{ bound.Corner(i), bound.MidPoint() });
-        }
-    }
-}
-
-template <typename T>
-ClosestIntersectionQueryResult2<T> Quadtree<T>::GetClosestIntersection(
-    const Ray2D& ray, const GetRayIntersectionFunc2<T>& testFunc,
-    size_t nodeIdx, const BoundingBox2D& bound,
-    ClosestIntersectionQueryResult2<T> best) const
-{
-    if (!bound.Intersects(ray))
-    {
-        return best;
-    }
-
-    const Node& node = m_nodes[nodeIdx];
-
-    if (node.items.size() > 0)
-    {
-        for (size_t itemIdx : node.items)
-        {
-            double dist = testFunc(m_items[itemIdx], ray);
-            if (dist < best.distance)
-            {
-                best.distance = dist;
-                best.item = &m_items[itemIdx];
-            }
-        }
-    }
-
-    if (node.firstChild != std::numeric_limits<size_t>::max())
-    {
-        for (int i = 0; i < 4; ++i)
-        {
-            best = GetClosestIntersection(
-                ray, testFunc, node.firstChild + i,
-                BoundingBox2D{ bound.Corner(i), bound.MidPoint() }, best);
-        }
-    }
-
-    return best;
-}
 }  // namespace CubbyFlow
 
-#endif
\ No newline at end of file
+#endif
@@ -14,6 +14,8 @@
 #include <Core/QueryEngine/IntersectionQueryEngine2.hpp>
 #include <Core/QueryEngine/NearestNeighborQueryEngine2.hpp>
 
+#include <cstdint>
+
 namespace CubbyFlow
 {
 //!
@@ -112,9 +114,9 @@ class Quadtree final : public IntersectionQueryEngine2<T>,
     //! Returns the number of quadtree nodes.
     [[nodiscard]] size_t GetNumberOfNodes() const;
 
-    //! Returns the list of the items for given node index.
-    [[nodiscard]] const std::vector<size_t>& GetItemsAtNode(
-        size_t nodeIdx) const;
+    //! Returns the list of the items for given node index. The indices are
+    //! copied out of the shared item-index pool.
+    [[nodiscard]] std::vector<size_t> GetItemsAtNode(size_t nodeIdx) const;
 
     //!
     //! \brief      Returns a child's index for given node.
@@ -137,48 +139,37 @@ class Quadtree final : public IntersectionQueryEngine2<T>,
     [[nodiscard]] size_t GetMaxDepth() const;
 
  private:
+    //! Sentinel child index marking a leaf node.
+    static constexpr uint32_t INVALID_CHILD =
+        std::numeric_limits<uint32_t>::max();
+
+    //!
+    //! \brief Flat quadtree node.
+    //!
+    //! A node references its items as the half-open range [itemBegin,
+    //! itemBegin + itemCount) of the shared item-index pool instead of
+    //! owning a vector, and links its children with a 32-bit index, so the
+    //! whole tree lives in two contiguous allocations and queries touch no
+    //! per-node heap blocks.
+    //!
     struct Node
     {
         [[nodiscard]] bool IsLeaf() const;
 
-        size_t firstChild = std::numeric_limits<size_t>::max();
-        std::vector<size_t> items;
+        uint32_t firstChild = INVALID_CHILD;
+        uint32_t itemBegin = 0;
+        uint32_t itemCount = 0;
     };
 
-    void Build(size_t nodeIdx, size_t Depth, const BoundingBox2D& Bound,
-               const BoxIntersectionTestFunc2<T>& testFunc);
-
-    [[nodiscard]] bool IsIntersects(const BoundingBox2D& box,
-                                    const BoxIntersectionTestFunc2<T>& testFunc,
-                                    size_t nodeIdx,
-                                    const BoundingBox2D& Bound) const;
-
-    [[nodiscard]] bool IsIntersects(const Ray2D& ray,
-                                    const RayIntersectionTestFunc2<T>& testFunc,
-                                    size_t nodeIdx,
-                                    const BoundingBox2D& Bound) const;
-
-    void ForEachIntersectingItem(const BoundingBox2D& box,
-                                 const BoxIntersectionTestFunc2<T>& testFunc,
-                                 const IntersectionVisitorFunc2<T>& visitorFunc,
-                                 size_t nodeIdx,
-                                 const BoundingBox2D& Bound) const;
-
-    void ForEachIntersectingItem(const Ray2D& ray,
-                                 const RayIntersectionTestFunc2<T>& testFunc,
-                                 const IntersectionVisitorFunc2<T>& visitorFunc,
-                                 size_t nodeIdx,
-                                 const BoundingBox2D& Bound) const;
-
-    [[nodiscard]] ClosestIntersectionQueryResult2<T> GetClosestIntersection(
-        const Ray2D& ray, const GetRayIntersectionFunc2<T>& testFunc,
-        size_t nodeIdx, const BoundingBox2D& Bound,
-        ClosestIntersectionQueryResult2<T> best) const;
+    void Build(size_t nodeIdx, size_t depth, const BoundingBox2D& bound,
+               const BoxIntersectionTestFunc2<T>& testFunc,
+               std::vector<std::vector<uint32_t>>* itemsPerNode);
 
     size_t m_maxDepth = 1;
     BoundingBox2D m_bbox;
     std::vector<T> m_items;
     std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_itemIndexPool;
 };
 }  // namespace CubbyFlow
 
@@ -37,6 +37,32 @@ class RigidBodyCollider3 final : public Collider3
     //! Returns the velocity of the collider at given \p point.
     [[nodiscard]] Vector3D VelocityAt(const Vector3D& point) const override;
 
+    //!
+    //! \brief Updates the collider state and caches the swept transform.
+    //!
+    //! In addition to the base class update, this function records the
+    //! surface transform before and after the motion callback. When
+    //! RigidBodyCollider3::isVelocityDerivedFromMotion is set, the linear
+    //! and angular velocities are derived from that transform delta so that
+    //! scripted motion (e.g. fast-spinning blades) reports accurate surface
+    //! velocities without manual bookkeeping.
+    //!
+    void Update(double currentTimeInSeconds,
+                double timeIntervalInSeconds) override;
+
+    //!
+    //! \brief Returns the surface transform interpolated within the last
+    //!        substep.
+    //!
+    //! The returned transform blends the cached transforms from the previous
+    //! and current Update calls: translation is interpolated linearly and
+    //! orientation via slerp. \p fraction is clamped to [0, 1], where 0 maps
+    //! to the previous substep and 1 to the current one. Callers can query
+    //! intermediate collider placements for sub-step accurate collision
+    //! tests instead of shrinking the solver substep.
+    //!
+    [[nodiscard]] Transform3 GetTransformAt(double fraction) const;
+
     //! Returns builder fox RigidBodyCollider3.
     [[nodiscard]] static Builder GetBuilder();
 
@@ -45,6 +71,15 @@ class RigidBodyCollider3 final : public Collider3
 
     //! Angular velocity of the rigid body.
     Vector3D angularVelocity;
+
+    //! If true, Update derives the linear and angular velocities from the
+    //! surface motion between substeps instead of the assigned values.
+    bool isVelocityDerivedFromMotion = false;
+
+ private:
+    Transform3 m_previousTransform;
+    Transform3 m_currentTransform;
+    bool m_hasPreviousTransform = false;
 };
 
 //! Shared pointer for the RigidBodyCollider3 type.
@@ -60,6 +60,40 @@ class SurfaceToImplicit3 final : public ImplicitSurface3
     //! Returns true if the surface is a valid geometry.
     [[nodiscard]] bool IsValidGeometry() const override;
 
+    //! Brings the scalar overload into scope next to the batch override.
+    using ImplicitSurface3::SignedDistance;
+
+    //!
+    //! \brief Returns signed distances for a batch of points.
+    //!
+    //! When the wrapped surface is one of the analytic primitives (Sphere3,
+    //! Box3, or Plane3), the whole batch is evaluated with the closed-form
+    //! distance of that primitive in a tight non-virtual loop, which is what
+    //! grid rasterization should hit for the common emitter and collider
+    //! shapes. Any other surface falls back to the per-point closest-point
+    //! query of the base implementation.
+    //!
+    void SignedDistance(const ConstArrayAccessor1<Vector3D>& points,
+                        ArrayAccessor1<double> results) const override;
+
+    //!
+    //! \brief Returns the signed-distance gradient at \p otherPoint.
+    //!
+    //! Analytic for wrapped Sphere3, Box3, Plane3, and Cylinder3 primitives;
+    //! other surfaces fall back to the finite-difference base
+    //! implementation.
+    //!
+    [[nodiscard]] Vector3D Gradient(const Vector3D& otherPoint) const override;
+
+    //!
+    //! \brief Returns signed-distance gradients for a batch of points.
+    //!
+    //! Like the batch SignedDistance, the primitive type is resolved once
+    //! per batch so the per-point loops stay non-virtual.
+    //!
+    void Gradient(const ConstArrayAccessor1<Vector3D>& points,
+                  ArrayAccessor1<Vector3D> results) const override;
+
     //! Returns the raw surface instance.
     [[nodiscard]] Surface3Ptr GetSurface() const;
 
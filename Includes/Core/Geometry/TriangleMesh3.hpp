@@ -17,6 +17,9 @@
 #include <Core/Geometry/Surface3.hpp>
 #include <Core/Geometry/Triangle3.hpp>
 
+#include <cstdint>
+#include <vector>
+
 namespace CubbyFlow
 {
 //!
@@ -179,7 +182,8 @@ class TriangleMesh3 final : public Surface3
     //! Rotates the mesh.
     void Rotate(const QuaternionD& q);
 
-    //! Writes the mesh in obj format to the output stream.
+    //! Writes the mesh in obj format to the output stream. The text is
+    //! formatted into per-chunk buffers in parallel and flushed in order.
     void WriteObj(std::ostream* stream) const;
 
     //! Writes the mesh in obj format to the file.
@@ -191,6 +195,59 @@ class TriangleMesh3 final : public Surface3
     //! Reads the mesh in obj format from the file.
     [[nodiscard]] bool ReadObj(const std::string& fileName);
 
+    //!
+    //! \brief Writes the mesh in binary little-endian PLY format to the
+    //! output stream.
+    //!
+    //! Positions are always written as floats; per-vertex normals and UVs
+    //! are included when their counts match the point count. Faces store
+    //! the point indices. The payload is packed in parallel and written in
+    //! two bulk calls, so this is the preferred format for large meshes.
+    //! The writer assumes a little-endian host.
+    //!
+    void WritePly(std::ostream* stream) const;
+
+    //! Writes the mesh in binary PLY format to the file.
+    [[nodiscard]] bool WritePly(const std::string& fileName) const;
+
+    //! Reads a mesh written by WritePly from the input stream.
+    [[nodiscard]] bool ReadPly(std::istream* stream);
+
+    //! Reads the mesh in binary PLY format from the file.
+    [[nodiscard]] bool ReadPly(const std::string& fileName);
+
+    //!
+    //! \brief Enables (or disables) the compact query data.
+    //!
+    //! When enabled, the spatial query engine also snapshots the triangle
+    //! geometry as float32 positions addressed by 32-bit index triples.
+    //! Closest-point, closest-normal, and closest-distance queries then walk
+    //! this copy instead of gathering the full double-precision points,
+    //! normals, and UVs per candidate triangle, roughly halving the memory
+    //! touched during BVH traversal so that large collider meshes stay
+    //! cache-resident. The winning triangle is re-evaluated in double
+    //! precision, so results match the default path unless two candidates
+    //! are within float round-off of each other. Requires fewer than 2^32
+    //! points.
+    //!
+    void SetUseCompactQueryData(bool useCompactQueryData);
+
+    //! Returns true if the compact query data is enabled.
+    [[nodiscard]] bool GetUseCompactQueryData() const;
+
+    //!
+    //! \brief Returns the fast approximate winding number at \p point.
+    //!
+    //! Evaluates the dipole approximation of Barill et al. accumulated over
+    //! the internal BVH (Fast Winding Numbers for Soups and Clouds, ACM
+    //! SIGGRAPH 2018). \p point is given in world coordinates. \p accuracy
+    //! is the far-field approximation ratio (beta); larger values are faster
+    //! but less accurate. Values above 0.5 indicate the point is inside,
+    //! which degrades gracefully for non-watertight meshes.
+    //!
+    [[nodiscard]] double FastWindingNumber(const Vector3D& point,
+                                           double accuracy = 2.0) const;
+
     //! Returns builder fox TriangleMesh3.
     [[nodiscard]] static Builder GetBuilder();
 
@@ -220,6 +277,11 @@ class TriangleMesh3 final : public Surface3
 
     void BuildBVH() const;
 
+    void BuildCompactQueryData() const;
+
+    [[nodiscard]] double CompactTriangleDistance(size_t triIdx,
+                                                 const Vector3D& pt) const;
+
     void BuildWindingNumbers() const;
 
     [[nodiscard]] double GetWindingNumber(const Vector3D& queryPoint,
@@ -241,6 +303,16 @@ class TriangleMesh3 final : public Surface3
 
     mutable BVH3<size_t> m_bvh;
     mutable bool m_bvhInvalidated = true;
+    mutable size_t m_bvhBuiltTriangleCount = 0;
+
+    bool m_useCompactQueryData = false;
+    mutable std::vector<float> m_compactPositions;
+    mutable std::vector<uint32_t> m_compactIndices;
+    //! Per-triangle vertex coordinates, 9 floats per triangle, so the
+    //! distance kernel reads contiguously instead of gathering through the
+    //! index array.
+    mutable std::vector<float> m_compactTriangles;
+    mutable bool m_compactInvalidated = true;
 
     mutable Array1<Vector3D> m_wnAreaWeightedNormalSums;
     mutable Array1<Vector3D> m_wnAreaWeightedAvgPositions;
@@ -0,0 +1,46 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_TRIANGLE_MESH_DECIMATION_HPP
+#define CUBBYFLOW_TRIANGLE_MESH_DECIMATION_HPP
+
+#include <Core/Geometry/TriangleMesh3.hpp>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Decimates \p mesh toward the given triangle budget.
+//!
+//! Runs quadric-error-metric edge collapses in rounds. Each round scores
+//! every edge by the combined endpoint quadric (evaluated at the endpoints
+//! and the midpoint), picks a lock-free independent set — an edge is taken
+//! only when it is the cheapest edge of both of its endpoints, so the
+//! selected edges form a matching — and collapses the whole set in parallel.
+//! Collapses that would flip an adjacent triangle are rejected, and vertices
+//! on open boundaries are kept in place so the mesh silhouette survives.
+//!
+//! Normals and UVs of the input are discarded; the decimated mesh gets
+//! area-weighted smooth vertex normals instead, which is what the
+//! marching-cubes extraction produces anyway. Intended as a post-extract
+//! stage for per-frame surface export, where flat regions are heavily
+//! over-tessellated.
+//!
+//! \param[in,out]  mesh                        The mesh to decimate.
+//! \param[in]      targetNumberOfTriangles     Stop once the triangle count
+//!                                             drops to this budget.
+//! \param[in]      maxIterations               Upper bound on collapse
+//!                                             rounds.
+//!
+void DecimateTriangleMesh3(TriangleMesh3* mesh,
+                           size_t targetNumberOfTriangles,
+                           size_t maxIterations = 50);
+}  // namespace CubbyFlow
+
+#endif
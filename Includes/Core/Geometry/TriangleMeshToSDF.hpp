@@ -24,6 +24,23 @@ namespace CubbyFlow
 //! \param[in,out]  sdf     The output signed-distance field.
 //!
 void TriangleMeshToSDF(const TriangleMesh3& mesh, ScalarGrid3* sdf);
+
+//! \brief Generates signed-distance field with a custom winding-number
+//! accuracy.
+//! Same as above, but the sign is evaluated directly from the fast
+//! winding number with the given far-field approximation ratio. Larger
+//! values of \p windingNumberAccuracy trade accuracy for speed, which is
+//! useful when baking high-resolution fields from dirty scan meshes; the
+//! winding-number sign stays robust for non-watertight input. The BVH and
+//! the dipole hierarchy are built once up front, and the grid points are
+//! evaluated in parallel.
+//!
+//! \param[in]      mesh                    The mesh.
+//! \param[in,out]  sdf                     The output signed-distance field.
+//! \param[in]      windingNumberAccuracy   Far-field approximation ratio.
+//!
+void TriangleMeshToSDF(const TriangleMesh3& mesh, ScalarGrid3* sdf,
+                       double windingNumberAccuracy);
 }  // namespace CubbyFlow
 
 #endif
\ No newline at end of file
@@ -0,0 +1,363 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_ADAPTIVE_GRID3_IMPL_HPP
+#define CUBBYFLOW_ADAPTIVE_GRID3_IMPL_HPP
+
+#include <Core/Math/MathUtils.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+namespace CubbyFlow
+{
+template <typename T>
+void AdaptiveGrid3<T>::Build(const BoundingBox3D& domain, size_t maxDepth,
+                             const SamplerFunc& sampler,
+                             const DistanceFunc& distance,
+                             double refineThreshold, size_t minDepth)
+{
+    m_domain = domain;
+    m_maxDepth = maxDepth;
+
+    m_nodes.clear();
+    m_nodes.emplace_back();
+    m_nodes[0].value = sampler(domain.MidPoint());
+
+    BuildRecursive(0, domain, 0, sampler, distance, refineThreshold,
+                   std::min(minDepth, maxDepth));
+    Balance(sampler);
+}
+
+template <typename T>
+T AdaptiveGrid3<T>::Sample(const Vector3D& x) const
+{
+    assert(!m_nodes.empty());
+
+    const Vector3D lower = m_domain.lowerCorner;
+    const Vector3D p{ Clamp(x.x, lower.x, m_domain.upperCorner.x),
+                      Clamp(x.y, lower.y, m_domain.upperCorner.y),
+                      Clamp(x.z, lower.z, m_domain.upperCorner.z) };
+
+    BoundingBox3D leafBound;
+    size_t leafDepth;
+    [[maybe_unused]] const size_t leafIdx = FindLeaf(p, &leafBound, &leafDepth);
+
+    // Virtual uniform grid at the leaf's level; values at the eight cell
+    // centers surrounding p come from leaf lookups, which may land in a
+    // (one-level-coarser, thanks to the 2:1 balance) neighbor.
+    const double cells = static_cast<double>(size_t{ 1 } << leafDepth);
+    const Vector3D h = (m_domain.upperCorner - lower) / cells;
+    const Vector3D r{ (p.x - lower.x) / h.x - 0.5,
+                      (p.y - lower.y) / h.y - 0.5,
+                      (p.z - lower.z) / h.z - 0.5 };
+    const Vector3D base{ std::floor(r.x), std::floor(r.y), std::floor(r.z) };
+    const double tx = r.x - base.x;
+    const double ty = r.y - base.y;
+    const double tz = r.z - base.z;
+
+    std::array<T, 8> f;
+    for (size_t c = 0; c < 8; ++c)
+    {
+        const double dx = static_cast<double>(c & 1);
+        const double dy = static_cast<double>((c >> 1) & 1);
+        const double dz = static_cast<double>((c >> 2) & 1);
+        const Vector3D center{ lower.x + (base.x + dx + 0.5) * h.x,
+                               lower.y + (base.y + dy + 0.5) * h.y,
+                               lower.z + (base.z + dz + 0.5) * h.z };
+        f[c] = LeafValue(center);
+    }
+
+    return TriLerp(f[0], f[1], f[2], f[3], f[4], f[5], f[6], f[7], tx, ty,
+                   tz);
+}
+
+template <typename T>
+const BoundingBox3D& AdaptiveGrid3<T>::GetBoundingBox() const
+{
+    return m_domain;
+}
+
+template <typename T>
+size_t AdaptiveGrid3<T>::GetMaxDepth() const
+{
+    return m_maxDepth;
+}
+
+template <typename T>
+size_t AdaptiveGrid3<T>::GetNumberOfNodes() const
+{
+    return m_nodes.size();
+}
+
+template <typename T>
+size_t AdaptiveGrid3<T>::GetNumberOfLeaves() const
+{
+    size_t count = 0;
+    for (const Node& node : m_nodes)
+    {
+        if (node.IsLeaf())
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+template <typename T>
+void AdaptiveGrid3<T>::ForEachLeaf(
+    const std::function<void(const BoundingBox3D&, size_t, const T&)>& func)
+    const
+{
+    if (m_nodes.empty())
+    {
+        return;
+    }
+
+    struct Entry
+    {
+        size_t idx;
+        BoundingBox3D bound;
+        size_t depth;
+    };
+
+    std::vector<Entry> stack{ { 0, m_domain, 0 } };
+    while (!stack.empty())
+    {
+        const Entry entry = stack.back();
+        stack.pop_back();
+
+        const Node& node = m_nodes[entry.idx];
+        if (node.IsLeaf())
+        {
+            func(entry.bound, entry.depth, node.value);
+            continue;
+        }
+
+        for (size_t c = 0; c < 8; ++c)
+        {
+            stack.push_back({ node.firstChild + c,
+                              ChildBound(entry.bound, c), entry.depth + 1 });
+        }
+    }
+}
+
+template <typename T>
+void AdaptiveGrid3<T>::BuildRecursive(size_t nodeIdx,
+                                      const BoundingBox3D& bound, size_t depth,
+                                      const SamplerFunc& sampler,
+                                      const DistanceFunc& distance,
+                                      double refineThreshold, size_t minDepth)
+{
+    if (depth >= m_maxDepth)
+    {
+        return;
+    }
+
+    if (depth >= minDepth)
+    {
+        // Probe the eight corners and the center; refine while the source
+        // still varies noticeably across the cell.
+        std::array<T, 9> probes;
+        for (size_t c = 0; c < 8; ++c)
+        {
+            const Vector3D corner{
+                (c & 1) ? bound.upperCorner.x : bound.lowerCorner.x,
+                ((c >> 1) & 1) ? bound.upperCorner.y : bound.lowerCorner.y,
+                ((c >> 2) & 1) ? bound.upperCorner.z : bound.lowerCorner.z
+            };
+            probes[c] = sampler(corner);
+        }
+        probes[8] = sampler(bound.MidPoint());
+
+        double variation = 0.0;
+        for (size_t a = 0; a < 9; ++a)
+        {
+            for (size_t b = a + 1; b < 9; ++b)
+            {
+                variation =
+                    std::max(variation, distance(probes[a], probes[b]));
+            }
+        }
+
+        if (variation <= refineThreshold)
+        {
+            return;
+        }
+    }
+
+    Subdivide(nodeIdx, bound, sampler);
+
+    const size_t firstChild = m_nodes[nodeIdx].firstChild;
+    for (size_t c = 0; c < 8; ++c)
+    {
+        BuildRecursive(firstChild + c, ChildBound(bound, c), depth + 1,
+                       sampler, distance, refineThreshold, minDepth);
+    }
+}
+
+template <typename T>
+void AdaptiveGrid3<T>::Balance(const SamplerFunc& sampler)
+{
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+
+        struct Leaf
+        {
+            size_t idx;
+            BoundingBox3D bound;
+            size_t depth;
+        };
+
+        std::vector<Leaf> leaves;
+        std::vector<Leaf> stack{ { 0, m_domain, 0 } };
+        while (!stack.empty())
+        {
+            const Leaf entry = stack.back();
+            stack.pop_back();
+
+            if (m_nodes[entry.idx].IsLeaf())
+            {
+                leaves.push_back(entry);
+                continue;
+            }
+
+            for (size_t c = 0; c < 8; ++c)
+            {
+                stack.push_back({ m_nodes[entry.idx].firstChild + c,
+                                  ChildBound(entry.bound, c),
+                                  entry.depth + 1 });
+            }
+        }
+
+        for (const Leaf& leaf : leaves)
+        {
+            // Subdividing a neighbor may have split this leaf's ancestors'
+            // siblings, but never the leaf itself; only skip entries that a
+            // previous pass already split.
+            if (!m_nodes[leaf.idx].IsLeaf() || leaf.depth < 2)
+            {
+                continue;
+            }
+
+            const Vector3D center = leaf.bound.MidPoint();
+            const Vector3D size =
+                leaf.bound.upperCorner - leaf.bound.lowerCorner;
+
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                for (int dir = -1; dir <= 1; dir += 2)
+                {
+                    Vector3D probe = center;
+                    probe[axis] += dir * size[axis];
+                    if (!m_domain.Contains(probe))
+                    {
+                        continue;
+                    }
+
+                    BoundingBox3D neighborBound;
+                    size_t neighborDepth;
+                    const size_t neighborIdx =
+                        FindLeaf(probe, &neighborBound, &neighborDepth);
+
+                    if (neighborDepth + 1 < leaf.depth)
+                    {
+                        Subdivide(neighborIdx, neighborBound, sampler);
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void AdaptiveGrid3<T>::Subdivide(size_t nodeIdx, const BoundingBox3D& bound,
+                                 const SamplerFunc& sampler)
+{
+    assert(m_nodes[nodeIdx].IsLeaf());
+
+    const size_t firstChild = m_nodes.size();
+    for (size_t c = 0; c < 8; ++c)
+    {
+        Node child;
+        child.value = sampler(ChildBound(bound, c).MidPoint());
+        m_nodes.push_back(child);
+    }
+    m_nodes[nodeIdx].firstChild = firstChild;
+}
+
+template <typename T>
+BoundingBox3D AdaptiveGrid3<T>::ChildBound(const BoundingBox3D& bound,
+                                           size_t octant)
+{
+    const Vector3D center = bound.MidPoint();
+    BoundingBox3D child;
+
+    child.lowerCorner.x =
+        (octant & 1) ? center.x : bound.lowerCorner.x;
+    child.upperCorner.x =
+        (octant & 1) ? bound.upperCorner.x : center.x;
+    child.lowerCorner.y =
+        ((octant >> 1) & 1) ? center.y : bound.lowerCorner.y;
+    child.upperCorner.y =
+        ((octant >> 1) & 1) ? bound.upperCorner.y : center.y;
+    child.lowerCorner.z =
+        ((octant >> 2) & 1) ? center.z : bound.lowerCorner.z;
+    child.upperCorner.z =
+        ((octant >> 2) & 1) ? bound.upperCorner.z : center.z;
+
+    return child;
+}
+
+template <typename T>
+size_t AdaptiveGrid3<T>::FindLeaf(const Vector3D& x, BoundingBox3D* bound,
+                                  size_t* depth) const
+{
+    size_t idx = 0;
+    BoundingBox3D current = m_domain;
+    size_t d = 0;
+
+    while (!m_nodes[idx].IsLeaf())
+    {
+        const Vector3D center = current.MidPoint();
+        const size_t octant = (x.x > center.x ? 1 : 0) |
+                              (x.y > center.y ? 2 : 0) |
+                              (x.z > center.z ? 4 : 0);
+        idx = m_nodes[idx].firstChild + octant;
+        current = ChildBound(current, octant);
+        ++d;
+    }
+
+    *bound = current;
+    *depth = d;
+    return idx;
+}
+
+template <typename T>
+T AdaptiveGrid3<T>::LeafValue(const Vector3D& x) const
+{
+    const Vector3D p{
+        Clamp(x.x, m_domain.lowerCorner.x, m_domain.upperCorner.x),
+        Clamp(x.y, m_domain.lowerCorner.y, m_domain.upperCorner.y),
+        Clamp(x.z, m_domain.lowerCorner.z, m_domain.upperCorner.z)
+    };
+
+    BoundingBox3D bound;
+    size_t depth;
+    return m_nodes[FindLeaf(p, &bound, &depth)].value;
+}
+}  // namespace CubbyFlow
+
+#endif
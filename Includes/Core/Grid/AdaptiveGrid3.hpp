@@ -0,0 +1,152 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_ADAPTIVE_GRID3_HPP
+#define CUBBYFLOW_ADAPTIVE_GRID3_HPP
+
+#include <Core/Geometry/BoundingBox3.hpp>
+
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief 2:1-balanced octree grid storing one value per leaf cell.
+//!
+//! This class is the storage and sampling core shared by the adaptive field
+//! classes (AdaptiveScalarGrid3, AdaptiveVectorGrid3). The tree is built by
+//! recursively subdividing the domain wherever a user-provided source field
+//! varies more than a threshold across a cell, down to \p maxDepth levels, so
+//! a level-\p d leaf covers the same volume as a cell of a uniform
+//! 2^d x 2^d x 2^d grid. After refinement, the tree is rebalanced so
+//! face-adjacent leaves differ by at most one level; this bounds the
+//! resolution jump a sampler has to bridge at coarse-fine interfaces.
+//!
+//! Sampling is piecewise trilinear at the resolution of the leaf containing
+//! the query point: the eight surrounding virtual cell centers at that
+//! level are evaluated through leaf lookups (which may land in coarser
+//! neighbors) and blended. Thanks to the 2:1 balance, the mismatch at a
+//! coarse-fine interface is at most one level.
+//!
+//! \tparam T Type of the per-cell value.
+//!
+template <typename T>
+class AdaptiveGrid3
+{
+ public:
+    //! Sentinel index marking a node without children.
+    static constexpr size_t INVALID_NODE = std::numeric_limits<size_t>::max();
+
+    //! Single octree node. Children, when present, are eight consecutive
+    //! entries in the node array starting at firstChild.
+    struct Node
+    {
+        //! Index of the first of eight consecutive children, or INVALID_NODE.
+        size_t firstChild = INVALID_NODE;
+
+        //! Cell value; authoritative only for leaf nodes.
+        T value{};
+
+        //! Returns true if this node has no children.
+        [[nodiscard]] bool IsLeaf() const
+        {
+            return firstChild == INVALID_NODE;
+        }
+    };
+
+    //! Function returning the source value at a position.
+    using SamplerFunc = std::function<T(const Vector3D&)>;
+
+    //! Function returning the scalar distance between two values, used as
+    //! the refinement criterion.
+    using DistanceFunc = std::function<double(const T&, const T&)>;
+
+    //! Constructs an empty grid.
+    AdaptiveGrid3() = default;
+
+    //!
+    //! \brief Builds the tree from the given source function.
+    //!
+    //! A cell is subdivided while its depth is less than \p maxDepth and the
+    //! maximum pairwise \p distance between the source values at its corners
+    //! and center exceeds \p refineThreshold. Leaf values are the source
+    //! values at the leaf centers. The result is 2:1 balanced.
+    //!
+    //! Cells above \p minDepth are subdivided unconditionally; without that
+    //! floor, a feature smaller than a coarse cell can slip between the
+    //! probe points and never trigger refinement.
+    //!
+    //! \param[in] domain          Axis-aligned bounds covered by the root.
+    //! \param[in] maxDepth        Maximum subdivision depth.
+    //! \param[in] sampler         Source value function.
+    //! \param[in] distance        Distance between two source values.
+    //! \param[in] refineThreshold Variation that triggers subdivision.
+    //! \param[in] minDepth        Depth every cell is refined to, clamped to
+    //!                            \p maxDepth.
+    //!
+    void Build(const BoundingBox3D& domain, size_t maxDepth,
+               const SamplerFunc& sampler, const DistanceFunc& distance,
+               double refineThreshold, size_t minDepth = 2);
+
+    //! Returns the value sampled at given position \p x.
+    [[nodiscard]] T Sample(const Vector3D& x) const;
+
+    //! Returns the domain covered by the root cell.
+    [[nodiscard]] const BoundingBox3D& GetBoundingBox() const;
+
+    //! Returns the maximum subdivision depth the tree was built with.
+    [[nodiscard]] size_t GetMaxDepth() const;
+
+    //! Returns the total number of tree nodes.
+    [[nodiscard]] size_t GetNumberOfNodes() const;
+
+    //! Returns the number of leaf cells.
+    [[nodiscard]] size_t GetNumberOfLeaves() const;
+
+    //! Invokes \p func with the bounds, depth, and value of every leaf cell.
+    void ForEachLeaf(
+        const std::function<void(const BoundingBox3D&, size_t, const T&)>&
+            func) const;
+
+ private:
+    void BuildRecursive(size_t nodeIdx, const BoundingBox3D& bound,
+                        size_t depth, const SamplerFunc& sampler,
+                        const DistanceFunc& distance, double refineThreshold,
+                        size_t minDepth);
+
+    void Balance(const SamplerFunc& sampler);
+
+    void Subdivide(size_t nodeIdx, const BoundingBox3D& bound,
+                   const SamplerFunc& sampler);
+
+    //! Returns the bounds of child \p octant of a cell with bounds \p bound.
+    [[nodiscard]] static BoundingBox3D ChildBound(const BoundingBox3D& bound,
+                                                  size_t octant);
+
+    //! Descends to the leaf containing \p x (which must lie inside the
+    //! domain) and reports its index, bounds, and depth.
+    [[nodiscard]] size_t FindLeaf(const Vector3D& x, BoundingBox3D* bound,
+                                  size_t* depth) const;
+
+    //! Returns the stored value of the leaf containing \p x, clamping \p x
+    //! into the domain first.
+    [[nodiscard]] T LeafValue(const Vector3D& x) const;
+
+    std::vector<Node> m_nodes;
+    BoundingBox3D m_domain;
+    size_t m_maxDepth = 0;
+};
+}  // namespace CubbyFlow
+
+#include <Core/Grid/AdaptiveGrid3-Impl.hpp>
+
+#endif
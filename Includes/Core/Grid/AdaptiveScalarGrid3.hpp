@@ -0,0 +1,110 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_ADAPTIVE_SCALAR_GRID3_HPP
+#define CUBBYFLOW_ADAPTIVE_SCALAR_GRID3_HPP
+
+#include <Core/Field/ScalarField3.hpp>
+#include <Core/Grid/AdaptiveGrid3.hpp>
+
+namespace CubbyFlow
+{
+//!
+//! \brief 2:1-balanced octree scalar field for detail-concentrated data.
+//!
+//! This field stores a scalar on an adaptive octree (see AdaptiveGrid3): the
+//! tree is refined toward regions where the source varies, so an effective
+//! resolution of 2^maxDepth per axis only pays for fine cells near the
+//! detail. Typical use is upres sampling of smoke density, where only the
+//! plume needs fine cells. The class implements the ScalarField3 interface,
+//! so anything that reads through a field or its Sampler() can consume it
+//! without changes.
+//!
+class AdaptiveScalarGrid3 final : public ScalarField3
+{
+ public:
+    class Builder;
+
+    //! Constructs an empty field that samples to zero.
+    AdaptiveScalarGrid3() = default;
+
+    //!
+    //! \brief Constructs the field by adaptively sampling \p source.
+    //!
+    //! \param[in] source          Field to sample.
+    //! \param[in] domain          Bounds covered by the octree root.
+    //! \param[in] maxDepth        Maximum subdivision depth; the finest cells
+    //!                            match a uniform grid with 2^maxDepth cells
+    //!                            per axis.
+    //! \param[in] refineThreshold Subdivide cells across which the source
+    //!                            varies by more than this value.
+    //!
+    AdaptiveScalarGrid3(const ScalarField3& source,
+                        const BoundingBox3D& domain, size_t maxDepth,
+                        double refineThreshold);
+
+    //! Rebuilds the field by adaptively sampling \p source.
+    void Build(const ScalarField3& source, const BoundingBox3D& domain,
+               size_t maxDepth, double refineThreshold);
+
+    //! Returns the sampled value at given position \p x.
+    [[nodiscard]] double Sample(const Vector3D& x) const override;
+
+    //! Returns the gradient vector at given position \p x, computed by
+    //! central differencing at the finest cell size.
+    [[nodiscard]] Vector3D Gradient(const Vector3D& x) const override;
+
+    //! Returns the octree storage.
+    [[nodiscard]] const AdaptiveGrid3<double>& GetTree() const;
+
+    //! Returns builder fox AdaptiveScalarGrid3.
+    [[nodiscard]] static Builder GetBuilder();
+
+ private:
+    AdaptiveGrid3<double> m_tree;
+    bool m_hasData = false;
+};
+
+//! Shared pointer type for the AdaptiveScalarGrid3.
+using AdaptiveScalarGrid3Ptr = std::shared_ptr<AdaptiveScalarGrid3>;
+
+//!
+//! \brief Front-end to create AdaptiveScalarGrid3 objects step by step.
+//!
+class AdaptiveScalarGrid3::Builder final
+{
+ public:
+    //! Returns builder with the source field.
+    [[nodiscard]] Builder& WithSourceField(const ScalarField3Ptr& source);
+
+    //! Returns builder with the domain covered by the octree root.
+    [[nodiscard]] Builder& WithBoundingBox(const BoundingBox3D& domain);
+
+    //! Returns builder with the maximum subdivision depth.
+    [[nodiscard]] Builder& WithMaxDepth(size_t maxDepth);
+
+    //! Returns builder with the refinement threshold.
+    [[nodiscard]] Builder& WithRefinementThreshold(double threshold);
+
+    //! Builds AdaptiveScalarGrid3.
+    [[nodiscard]] AdaptiveScalarGrid3 Build() const;
+
+    //! Builds shared pointer of AdaptiveScalarGrid3 instance.
+    [[nodiscard]] AdaptiveScalarGrid3Ptr MakeShared() const;
+
+ private:
+    ScalarField3Ptr m_source;
+    BoundingBox3D m_domain{ Vector3D{ 0, 0, 0 }, Vector3D{ 1, 1, 1 } };
+    size_t m_maxDepth = 4;
+    double m_refineThreshold = 1e-3;
+};
+}  // namespace CubbyFlow
+
+#endif
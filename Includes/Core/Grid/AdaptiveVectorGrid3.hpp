@@ -0,0 +1,105 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_ADAPTIVE_VECTOR_GRID3_HPP
+#define CUBBYFLOW_ADAPTIVE_VECTOR_GRID3_HPP
+
+#include <Core/Field/VectorField3.hpp>
+#include <Core/Grid/AdaptiveGrid3.hpp>
+
+namespace CubbyFlow
+{
+//!
+//! \brief 2:1-balanced octree vector field for detail-concentrated data.
+//!
+//! Vector counterpart of AdaptiveScalarGrid3: all three components share one
+//! octree (refined where any component varies), stored collocated at the
+//! cell centers. The class implements the VectorField3 interface, so
+//! samplers, semi-Lagrangian backtracing, and anything else that reads
+//! through a field can consume it without changes.
+//!
+class AdaptiveVectorGrid3 final : public VectorField3
+{
+ public:
+    class Builder;
+
+    //! Constructs an empty field that samples to zero.
+    AdaptiveVectorGrid3() = default;
+
+    //!
+    //! \brief Constructs the field by adaptively sampling \p source.
+    //!
+    //! \param[in] source          Field to sample.
+    //! \param[in] domain          Bounds covered by the octree root.
+    //! \param[in] maxDepth        Maximum subdivision depth; the finest cells
+    //!                            match a uniform grid with 2^maxDepth cells
+    //!                            per axis.
+    //! \param[in] refineThreshold Subdivide cells across which any component
+    //!                            of the source varies by more than this
+    //!                            value.
+    //!
+    AdaptiveVectorGrid3(const VectorField3& source,
+                        const BoundingBox3D& domain, size_t maxDepth,
+                        double refineThreshold);
+
+    //! Rebuilds the field by adaptively sampling \p source.
+    void Build(const VectorField3& source, const BoundingBox3D& domain,
+               size_t maxDepth, double refineThreshold);
+
+    //! Returns the sampled value at given position \p x.
+    [[nodiscard]] Vector3D Sample(const Vector3D& x) const override;
+
+    //! Returns the octree storage.
+    [[nodiscard]] const AdaptiveGrid3<Vector3D>& GetTree() const;
+
+    //! Returns builder fox AdaptiveVectorGrid3.
+    [[nodiscard]] static Builder GetBuilder();
+
+ private:
+    AdaptiveGrid3<Vector3D> m_tree;
+    bool m_hasData = false;
+};
+
+//! Shared pointer type for the AdaptiveVectorGrid3.
+using AdaptiveVectorGrid3Ptr = std::shared_ptr<AdaptiveVectorGrid3>;
+
+//!
+//! \brief Front-end to create AdaptiveVectorGrid3 objects step by step.
+//!
+class AdaptiveVectorGrid3::Builder final
+{
+ public:
+    //! Returns builder with the source field.
+    [[nodiscard]] Builder& WithSourceField(const VectorField3Ptr& source);
+
+    //! Returns builder with the domain covered by the octree root.
+    [[nodiscard]] Builder& WithBoundingBox(const BoundingBox3D& domain);
+
+    //! Returns builder with the maximum subdivision depth.
+    [[nodiscard]] Builder& WithMaxDepth(size_t maxDepth);
+
+    //! Returns builder with the refinement threshold.
+    [[nodiscard]] Builder& WithRefinementThreshold(double threshold);
+
+    //! Builds AdaptiveVectorGrid3.
+    [[nodiscard]] AdaptiveVectorGrid3 Build() const;
+
+    //! Builds shared pointer of AdaptiveVectorGrid3 instance.
+    [[nodiscard]] AdaptiveVectorGrid3Ptr MakeShared() const;
+
+ private:
+    VectorField3Ptr m_source;
+    BoundingBox3D m_domain{ Vector3D{ 0, 0, 0 }, Vector3D{ 1, 1, 1 } };
+    size_t m_maxDepth = 4;
+    double m_refineThreshold = 1e-3;
+};
+}  // namespace CubbyFlow
+
+#endif
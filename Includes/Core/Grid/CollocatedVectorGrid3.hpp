@@ -131,6 +131,10 @@ class CollocatedVectorGrid3 : public VectorGrid3
     void OnResize(const Size3& resolution, const Vector3D& gridSpacing,
                   const Vector3D& origin, const Vector3D& initialValue) final;
 
+    //! Detaches the copy-on-write data buffer ahead of a write and rebinds
+    //! the cached sampler if the buffer was actually copied.
+    void DetachData();
+
     void ResetSampler();
 
     Array3<Vector3D> m_data;
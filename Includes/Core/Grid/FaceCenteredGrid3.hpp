@@ -109,6 +109,26 @@ class FaceCenteredGrid3 final : public VectorGrid3
     //! Returns curl at cell-center location.
     [[nodiscard]] Vector3D CurlAtCellCenter(size_t i, size_t j, size_t k) const;
 
+    //!
+    //! \brief Computes divergence at every cell center in one fused pass.
+    //!
+    //! Fills \p output, which must match the grid resolution, with the same
+    //! values DivergenceAtCellCenter returns. The inner loops run straight
+    //! over the face arrays, so the whole-grid form vectorizes where the
+    //! cell-by-cell getter cannot.
+    //!
+    void DivergenceGrid(ArrayAccessor3<double> output) const;
+
+    //!
+    //! \brief Computes curl at every cell center in one fused pass.
+    //!
+    //! Fills \p output, which must match the grid resolution, with the same
+    //! values CurlAtCellCenter returns. Cell-center values are shared by the
+    //! six neighboring curl stencils and are computed only once here, where
+    //! the cell-by-cell getter re-averages the faces for every neighbor.
+    //!
+    void CurlGrid(ArrayAccessor3<Vector3D> output) const;
+
     //! Returns u data accessor.
     [[nodiscard]] ScalarDataAccessor GetUAccessor();
 
@@ -180,6 +200,16 @@ class FaceCenteredGrid3 final : public VectorGrid3
     //! Returns the copy of the grid instance.
     [[nodiscard]] std::shared_ptr<VectorGrid3> Clone() const override;
 
+    //!
+    //! \brief Returns the version counter of the face data.
+    //!
+    //! The counter increases monotonically whenever mutable access to the
+    //! data is granted (accessors, fills, resizes, assignments), so callers
+    //! can cache quantities derived from the data and detect staleness by
+    //! comparing versions instead of re-reading the grid.
+    //!
+    [[nodiscard]] size_t GetDataVersion() const;
+
     //!
     //! \brief Invokes the given function \p func for each u-data point.
     //!
@@ -281,6 +311,10 @@ class FaceCenteredGrid3 final : public VectorGrid3
     void SetData(const std::vector<double>& data) override;
 
  private:
+    //! Detaches the copy-on-write face buffers ahead of a write and rebinds
+    //! the cached samplers if any buffer was actually copied.
+    void DetachData();
+
     void ResetSampler();
 
     Array3<double> m_dataU;
@@ -293,6 +327,7 @@ class FaceCenteredGrid3 final : public VectorGrid3
     LinearArraySampler3<double, double> m_vLinearSampler;
     LinearArraySampler3<double, double> m_wLinearSampler;
     std::function<Vector3D(const Vector3D&)> m_sampler;
+    size_t m_dataVersion = 1;
 };
 
 //! Shared pointer type for the FaceCenteredGrid3.
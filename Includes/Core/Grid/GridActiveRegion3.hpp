@@ -0,0 +1,167 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_GRID_ACTIVE_REGION3_HPP
+#define CUBBYFLOW_GRID_ACTIVE_REGION3_HPP
+
+#include <Core/Array/Array3.hpp>
+#include <Core/Geometry/Size3.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Tile mask that tracks the occupied part of a 3-D grid.
+//!
+//! This class groups the cells of a grid into cubic tiles and keeps a flag
+//! per tile telling whether the tile contains any cell of interest (e.g.
+//! non-zero smoke density). Solvers can consult the mask to skip whole tiles
+//! of work in sparsely occupied domains.
+//!
+class GridActiveRegion3
+{
+ public:
+    //! Edge length of a tile in cells.
+    static constexpr size_t TILE_SIZE = 8;
+
+    //!
+    //! \brief Rebuilds the tile mask over \p resolution cells.
+    //!
+    //! This function marks every tile that contains at least one cell for
+    //! which \p isCellActive returns true. The tiles are scanned in
+    //! parallel.
+    //!
+    //! \param[in] resolution   The cell resolution of the grid.
+    //! \param[in] isCellActive Predicate taking a cell index (i, j, k).
+    //!
+    template <typename Predicate>
+    void Build(const Size3& resolution, Predicate isCellActive)
+    {
+        m_resolution = resolution;
+        m_tileCount = Size3{ (resolution.x + TILE_SIZE - 1) / TILE_SIZE,
+                             (resolution.y + TILE_SIZE - 1) / TILE_SIZE,
+                             (resolution.z + TILE_SIZE - 1) / TILE_SIZE };
+        m_tiles.Resize(m_tileCount);
+
+        ParallelFor(
+            ZERO_SIZE, m_tileCount.x, ZERO_SIZE, m_tileCount.y, ZERO_SIZE,
+            m_tileCount.z, [&](size_t ti, size_t tj, size_t tk) {
+                const size_t iEnd =
+                    std::min((ti + 1) * TILE_SIZE, resolution.x);
+                const size_t jEnd =
+                    std::min((tj + 1) * TILE_SIZE, resolution.y);
+                const size_t kEnd =
+                    std::min((tk + 1) * TILE_SIZE, resolution.z);
+
+                char active = 0;
+
+                for (size_t k = tk * TILE_SIZE; k < kEnd && active == 0; ++k)
+                {
+                    for (size_t j = tj * TILE_SIZE; j < jEnd && active == 0;
+                         ++j)
+                    {
+                        for (size_t i = ti * TILE_SIZE; i < iEnd; ++i)
+                        {
+                            if (isCellActive(i, j, k))
+                            {
+                                active = 1;
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                m_tiles(ti, tj, tk) = active;
+            });
+    }
+
+    //!
+    //! \brief Rebuilds the mask as a narrow band around a level set.
+    //!
+    //! This function marks every tile containing a cell whose signed
+    //! distance magnitude is at most \p bandWidth. The input is expected to
+    //! be (approximately) a signed-distance field so that the magnitude
+    //! measures distance to the interface.
+    //!
+    //! \param[in] sdf       Cell values of the signed-distance field.
+    //! \param[in] bandWidth Half-width of the band in world units.
+    //!
+    void BuildNarrowBand(const ConstArrayAccessor3<double>& sdf,
+                         double bandWidth);
+
+    //! Expands the active set by one tile in every direction.
+    void AddHalo();
+
+    //!
+    //! \brief Invokes \p func with the index of every cell in an active tile.
+    //!
+    //! Tiles are processed in parallel and the cells of a tile are visited
+    //! serially, so \p func may only touch state owned by its own cell (or
+    //! state that is never written from an inactive tile).
+    //!
+    template <typename Callback>
+    void ParallelForEachCellInActiveTiles(Callback func) const
+    {
+        std::vector<Size3> activeTiles;
+        m_tiles.ForEachIndex([&](size_t ti, size_t tj, size_t tk) {
+            if (m_tiles(ti, tj, tk) != 0)
+            {
+                activeTiles.push_back(Size3{ ti, tj, tk });
+            }
+        });
+
+        ParallelFor(ZERO_SIZE, activeTiles.size(), [&](size_t t) {
+            const Size3& tile = activeTiles[t];
+            const size_t iEnd =
+                std::min((tile.x + 1) * TILE_SIZE, m_resolution.x);
+            const size_t jEnd =
+                std::min((tile.y + 1) * TILE_SIZE, m_resolution.y);
+            const size_t kEnd =
+                std::min((tile.z + 1) * TILE_SIZE, m_resolution.z);
+
+            for (size_t k = tile.z * TILE_SIZE; k < kEnd; ++k)
+            {
+                for (size_t j = tile.y * TILE_SIZE; j < jEnd; ++j)
+                {
+                    for (size_t i = tile.x * TILE_SIZE; i < iEnd; ++i)
+                    {
+                        func(i, j, k);
+                    }
+                }
+            }
+        });
+    }
+
+    //! Returns true if the cell at (\p i, \p j, \p k) lies in an active tile.
+    [[nodiscard]] bool IsCellActive(size_t i, size_t j, size_t k) const;
+
+    //! Returns true if the tile at (\p ti, \p tj, \p tk) is active.
+    [[nodiscard]] bool IsTileActive(size_t ti, size_t tj, size_t tk) const;
+
+    //! Returns the number of active tiles.
+    [[nodiscard]] size_t GetNumberOfActiveTiles() const;
+
+    //! Returns the number of tiles along each axis.
+    [[nodiscard]] const Size3& GetTileCount() const;
+
+    //! Returns the cell resolution the mask was built over.
+    [[nodiscard]] const Size3& GetResolution() const;
+
+ private:
+    Size3 m_resolution;
+    Size3 m_tileCount;
+    Array3<char> m_tiles;
+};
+}  // namespace CubbyFlow
+
+#endif
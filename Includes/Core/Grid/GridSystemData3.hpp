@@ -11,10 +11,16 @@
 #ifndef CUBBYFLOW_GRID_SYSTM_DATA3_HPP
 #define CUBBYFLOW_GRID_SYSTM_DATA3_HPP
 
+#include <Core/Grid/CellCenteredScalarGrid3.hpp>
+#include <Core/Grid/CellCenteredVectorGrid3.hpp>
 #include <Core/Grid/FaceCenteredGrid3.hpp>
 #include <Core/Grid/ScalarGrid3.hpp>
+#include <Core/Utils/MemoryStats.hpp>
 #include <Core/Utils/Serialization.hpp>
 
+#include <functional>
+#include <string>
+
 namespace CubbyFlow
 {
 //!
@@ -25,9 +31,24 @@ namespace CubbyFlow
 //! face-centered (MAC) grid by default. It can also have additional scalar or
 //! vector attributes by adding extra data layer.
 //!
-class GridSystemData3 : public Serializable
+class GridSystemData3 : public Serializable, public MemoryStats
 {
  public:
+    //! Cell-space edge length of the tiles used by the dirty-tile tracking.
+    static constexpr size_t DIRTY_TILE_SIZE = 16;
+
+    //!
+    //! \brief      Listener invoked after each tracked substep.
+    //!
+    //! Receives the cell-space tile indices (tiles are DIRTY_TILE_SIZE^3
+    //! cells) whose velocity faces or advectable scalar samples changed
+    //! beyond the tracking epsilon since the matching snapshot. The lists
+    //! are sorted in (z, y, x) scan order and may be empty.
+    //!
+    using TileChangeListener =
+        std::function<void(const std::vector<Point3UI>& velocityTiles,
+                           const std::vector<Point3UI>& scalarTiles)>;
+
     //! Constructs empty grid system.
     GridSystemData3();
 
@@ -209,6 +230,30 @@ class GridSystemData3 : public Serializable
     [[nodiscard]] const VectorGrid3Ptr& GetAdvectableVectorDataAt(
         size_t idx) const;
 
+    //!
+    //! \brief      Returns the shadow buffer paired with the advectable
+    //!             scalar data at given index.
+    //!
+    //! Shadow buffers form a double-buffering scheme for solver stages that
+    //! rewrite a grid from a snapshot of itself (advection, diffusion): the
+    //! stage swaps the live grid with its shadow and writes the result back
+    //! into the live grid, so no deep copy of the source is needed. The
+    //! buffer is created lazily as a clone of its grid and its contents are
+    //! unspecified between calls - a stage using it must overwrite every
+    //! sample of its output.
+    //!
+    [[nodiscard]] const ScalarGrid3Ptr& GetAdvectableScalarShadowAt(
+        size_t idx) const;
+
+    //!
+    //! \brief      Returns the shadow buffer paired with the advectable
+    //!             vector data at given index.
+    //!
+    //! \see GetAdvectableScalarShadowAt for the double-buffering contract.
+    //!
+    [[nodiscard]] const VectorGrid3Ptr& GetAdvectableVectorShadowAt(
+        size_t idx) const;
+
     //! Returns the number of non-advectable scalar data.
     [[nodiscard]] size_t GetNumberOfScalarData() const;
 
@@ -227,7 +272,143 @@ class GridSystemData3 : public Serializable
     //! Serialize the data from the given buffer.
     void Deserialize(const std::vector<uint8_t>& buffer) override;
 
+    //! Returns the type name for memory accounting.
+    [[nodiscard]] const char* GetMemoryStatsName() const override;
+
+    //! Reports the bytes held by each attribute list.
+    void ReportMemoryUsage(
+        std::vector<MemoryUsageRecord>* records) const override;
+
+    //!
+    //! \brief      Sets the dirty-tile listener (null disables tracking).
+    //!
+    //! While a listener is set, solvers snapshot the velocity and the
+    //! advectable scalar layers at the top of every substep (see
+    //! CaptureTileSnapshot) and report the changed tiles at the end of it,
+    //! so downstream consumers can process only the regions where the
+    //! fluid is actually active.
+    //!
+    void SetTileChangeListener(const TileChangeListener& listener);
+
+    //! Returns true if a dirty-tile listener is set.
+    [[nodiscard]] bool HasTileChangeListener() const;
+
+    //! Returns the per-sample threshold below which changes are ignored.
+    [[nodiscard]] double GetTileTrackingEpsilon() const;
+
+    //! Sets the per-sample threshold below which changes are ignored.
+    void SetTileTrackingEpsilon(double epsilon);
+
+    //!
+    //! \brief      Snapshots the tracked fields for the next tile diff.
+    //!
+    //! Copies the velocity components and every advectable scalar layer
+    //! into internal buffers (reused across substeps). No-op when no
+    //! listener is set.
+    //!
+    void CaptureTileSnapshot();
+
+    //!
+    //! \brief      Diffs the tracked fields against the last snapshot and
+    //!             fires the listener.
+    //!
+    //! Tiles are compared in parallel; a tile is dirty when any of its
+    //! samples moved by more than the tracking epsilon. The listener is
+    //! invoked exactly once per captured snapshot, with empty lists when
+    //! nothing changed. If the grid was resized since the capture, every
+    //! tile is reported dirty.
+    //!
+    void EmitTileChangeEvents();
+
+    //! Function computing a named derived scalar field into the given grid.
+    using DerivedScalarFieldFunc = std::function<void(
+        const GridSystemData3&, const CellCenteredScalarGrid3Ptr&)>;
+
+    //! Function computing a named derived vector field into the given grid.
+    using DerivedVectorFieldFunc = std::function<void(
+        const GridSystemData3&, const CellCenteredVectorGrid3Ptr&)>;
+
+    //!
+    //! \brief      Registers a named derived scalar field.
+    //!
+    //! Derived fields are not stored with the system; they are computed on
+    //! demand by ComputeDerivedScalarField or SerializeDerivedFields while
+    //! the source grids are still resident, instead of being reconstructed
+    //! from a cache in a second read pass.
+    //!
+    //! \param[in]  name  Name of the field.
+    //! \param[in]  func  Function filling a cell-centered grid of the
+    //!                   system's resolution with the field values.
+    //!
+    void AddDerivedScalarField(const std::string& name,
+                               const DerivedScalarFieldFunc& func);
+
+    //!
+    //! \brief      Registers a named derived vector field.
+    //!
+    //! \see AddDerivedScalarField for the computation contract.
+    //!
+    void AddDerivedVectorField(const std::string& name,
+                               const DerivedVectorFieldFunc& func);
+
+    //!
+    //! \brief      Registers the stock derived fields used by cache
+    //!             exporters.
+    //!
+    //! Registers "speed" (cell-center velocity magnitude), "vorticity"
+    //! (cell-center curl of the velocity field via the fused whole-grid
+    //! kernel), and "qCriterion" (second invariant of the cell-center
+    //! velocity gradient, positive inside vortex cores).
+    //!
+    void AddStandardDerivedFields();
+
+    //! Returns the registered derived field names in registration order.
+    [[nodiscard]] std::vector<std::string> GetDerivedFieldNames() const;
+
+    //!
+    //! \brief      Computes the named derived scalar field.
+    //!
+    //! \param[in]  name  Name of a registered derived scalar field.
+    //!
+    //! \return     Freshly computed cell-centered grid, or null if no scalar
+    //!             field with that name is registered.
+    //!
+    [[nodiscard]] CellCenteredScalarGrid3Ptr ComputeDerivedScalarField(
+        const std::string& name) const;
+
+    //!
+    //! \brief      Computes the named derived vector field.
+    //!
+    //! \param[in]  name  Name of a registered derived vector field.
+    //!
+    //! \return     Freshly computed cell-centered grid, or null if no vector
+    //!             field with that name is registered.
+    //!
+    [[nodiscard]] CellCenteredVectorGrid3Ptr ComputeDerivedVectorField(
+        const std::string& name) const;
+
+    //!
+    //! \brief      Computes every registered derived field and serializes
+    //!             them to the given buffer.
+    //!
+    //! Each field is computed once into a scratch grid and serialized
+    //! immediately, so the whole pass runs while the source grids are hot
+    //! instead of re-reading a velocity cache later. The buffer holds a
+    //! regular serialized GridSystemData3 whose scalar and vector layers
+    //! are the derived fields in registration order (field names are not
+    //! stored; readers match them by order against GetDerivedFieldNames).
+    //!
+    void SerializeDerivedFields(std::vector<uint8_t>* buffer) const;
+
  private:
+    //! A registered derived field; exactly one of the functions is set.
+    struct DerivedField
+    {
+        std::string name;
+        DerivedScalarFieldFunc scalarFunc;
+        DerivedVectorFieldFunc vectorFunc;
+    };
+
     Size3 m_resolution;
     Vector3D m_gridSpacing;
     Vector3D m_origin;
@@ -238,6 +419,24 @@ class GridSystemData3 : public Serializable
     std::vector<VectorGrid3Ptr> m_vectorDataList;
     std::vector<ScalarGrid3Ptr> m_advectableScalarDataList;
     std::vector<VectorGrid3Ptr> m_advectableVectorDataList;
+
+    // Lazily built double buffers for the advectable layers (see
+    // GetAdvectableScalarShadowAt). Mutable so the const getters can grow
+    // them on demand.
+    mutable std::vector<ScalarGrid3Ptr> m_advectableScalarShadowList;
+    mutable std::vector<VectorGrid3Ptr> m_advectableVectorShadowList;
+
+    // Dirty-tile tracking state. The snapshot arrays are transient scratch
+    // reused between substeps and are not copied or serialized.
+    TileChangeListener m_tileChangeListener;
+    double m_tileTrackingEpsilon = 1e-10;
+    bool m_tileSnapshotValid = false;
+    Array3<double> m_uSnapshot;
+    Array3<double> m_vSnapshot;
+    Array3<double> m_wSnapshot;
+    std::vector<Array3<double>> m_scalarSnapshotList;
+
+    std::vector<DerivedField> m_derivedFields;
 };
 
 //! Shared pointer type of GridSystemData3.
@@ -0,0 +1,155 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_HALF_SCALAR_GRID3_HPP
+#define CUBBYFLOW_HALF_SCALAR_GRID3_HPP
+
+#include <Core/Array/Array3.hpp>
+#include <Core/Field/ScalarField3.hpp>
+#include <Core/Grid/ScalarGrid3.hpp>
+
+namespace CubbyFlow
+{
+//!
+//! \brief 3-D scalar grid with half-precision storage.
+//!
+//! Render-only channels such as smoke density or temperature do not need
+//! the 8-byte doubles a ScalarGrid3 stores. This grid keeps one IEEE 754
+//! half-precision value per data point, quartering the memory and memory
+//! bandwidth of large render channels, and widens samples on load so the
+//! trilinear blend itself runs in full precision; only the storage is
+//! lossy. It implements the ScalarField3 interface and is meant as a sink
+//! for finished solver fields (see the converting constructor and Fill),
+//! not as a solver field: every write quantizes immediately, so
+//! accumulating into it loses precision.
+//!
+class HalfScalarGrid3 final : public ScalarField3
+{
+ public:
+    class Builder;
+
+    //! Constructs zero-sized grid.
+    HalfScalarGrid3() = default;
+
+    //! Constructs a grid with given resolution, grid spacing, origin and
+    //! initial value.
+    explicit HalfScalarGrid3(const Size3& resolution,
+                             const Vector3D& gridSpacing = Vector3D{ 1.0, 1.0,
+                                                                     1.0 },
+                             const Vector3D& origin = Vector3D{},
+                             double initialValue = 0.0);
+
+    //! Constructs a grid holding the quantized data points of \p other.
+    explicit HalfScalarGrid3(const ScalarGrid3& other);
+
+    //! Default copy constructor.
+    HalfScalarGrid3(const HalfScalarGrid3&) = default;
+
+    //! Default move constructor.
+    HalfScalarGrid3(HalfScalarGrid3&&) noexcept = default;
+
+    //! Default virtual destructor.
+    ~HalfScalarGrid3() override = default;
+
+    //! Default copy assignment operator.
+    HalfScalarGrid3& operator=(const HalfScalarGrid3&) = default;
+
+    //! Default move assignment operator.
+    HalfScalarGrid3& operator=(HalfScalarGrid3&&) noexcept = default;
+
+    //! Resizes the grid using given parameters.
+    void Resize(const Size3& resolution,
+                const Vector3D& gridSpacing = Vector3D{ 1.0, 1.0, 1.0 },
+                const Vector3D& origin = Vector3D{},
+                double initialValue = 0.0);
+
+    //! Returns the grid resolution.
+    [[nodiscard]] const Size3& Resolution() const;
+
+    //! Returns the grid spacing.
+    [[nodiscard]] const Vector3D& GridSpacing() const;
+
+    //! Returns the grid origin.
+    [[nodiscard]] const Vector3D& Origin() const;
+
+    //! Returns the position of the data point at (0, 0, 0), which sits half
+    //! a grid spacing inside the origin (cell-centered layout).
+    [[nodiscard]] Vector3D GetDataOrigin() const;
+
+    //! Returns the widened grid data at given data point.
+    double operator()(size_t i, size_t j, size_t k) const;
+
+    //! Quantizes \p value into the data point at (i, j, k).
+    void SetValue(size_t i, size_t j, size_t k, double value);
+
+    //!
+    //! \brief Re-quantizes every data point of \p other into this grid.
+    //!
+    //! The grid is resized so its data points coincide with the data points
+    //! of \p other, whatever the source layout (cell- or vertex-centered),
+    //! so sampling this grid matches sampling the source up to the
+    //! half-precision rounding. The copy runs in parallel.
+    //!
+    void Fill(const ScalarGrid3& other);
+
+    //! Returns the raw half-precision bits, e.g. for handing the channel to
+    //! a renderer without another conversion pass.
+    [[nodiscard]] ConstArrayAccessor3<uint16_t> GetRawDataAccessor() const;
+
+    //! Returns sampled value at given position \p x by trilinear
+    //! interpolation of the widened data points.
+    [[nodiscard]] double Sample(const Vector3D& x) const override;
+
+    //! Returns builder fox HalfScalarGrid3.
+    [[nodiscard]] static Builder GetBuilder();
+
+ private:
+    Size3 m_resolution;
+    Vector3D m_gridSpacing = Vector3D{ 1.0, 1.0, 1.0 };
+    Vector3D m_origin;
+    Array3<uint16_t> m_data;
+};
+
+//! Shared pointer for the HalfScalarGrid3 type.
+using HalfScalarGrid3Ptr = std::shared_ptr<HalfScalarGrid3>;
+
+//!
+//! \brief Front-end to create HalfScalarGrid3 objects step by step.
+//!
+class HalfScalarGrid3::Builder final
+{
+ public:
+    //! Returns builder with resolution.
+    Builder& WithResolution(const Size3& resolution);
+
+    //! Returns builder with grid spacing.
+    Builder& WithGridSpacing(const Vector3D& gridSpacing);
+
+    //! Returns builder with grid origin.
+    Builder& WithOrigin(const Vector3D& gridOrigin);
+
+    //! Returns builder with initial value.
+    Builder& WithInitialValue(double initialValue);
+
+    //! Builds HalfScalarGrid3 instance.
+    [[nodiscard]] HalfScalarGrid3 Build() const;
+
+    //! Builds shared pointer of HalfScalarGrid3 instance.
+    [[nodiscard]] HalfScalarGrid3Ptr MakeShared() const;
+
+ private:
+    Size3 m_resolution{ 1, 1, 1 };
+    Vector3D m_gridSpacing{ 1.0, 1.0, 1.0 };
+    Vector3D m_gridOrigin;
+    double m_initialValue = 0.0;
+};
+}  // namespace CubbyFlow
+
+#endif
@@ -0,0 +1,66 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_MARKER_BITSET3_HPP
+#define CUBBYFLOW_MARKER_BITSET3_HPP
+
+#include <Core/Array/ArrayAccessor3.hpp>
+#include <Core/Geometry/Size3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Compact two-bit-per-cell view of a 3-D marker grid.
+//!
+//! Stores the cell classification used by the grid solvers (0 = fluid,
+//! 1 = air, 2 = boundary) at two bits per cell, 32 cells per 64-bit word,
+//! in flat index order with the i-axis fastest. Compared to a byte-per-cell
+//! marker array this shrinks the memory footprint four-fold and lets callers
+//! answer whole-word queries -- counting fluid cells with popcount or
+//! skipping runs of all-air cells -- without touching every cell.
+//!
+class MarkerBitset3
+{
+ public:
+    //! Number of cells packed into one 64-bit word.
+    static constexpr size_t CELLS_PER_WORD = 32;
+
+    //! Packs the given marker array into the bitset.
+    void Build(const ConstArrayAccessor3<char>& markers);
+
+    //! Returns the size of the packed marker grid.
+    [[nodiscard]] const Size3& size() const;
+
+    //! Returns the number of packed 64-bit words.
+    [[nodiscard]] size_t GetNumberOfWords() const;
+
+    //! Returns the marker value at given coordinate.
+    [[nodiscard]] char operator()(size_t i, size_t j, size_t k) const;
+
+    //! Returns the marker value at given flat cell index.
+    [[nodiscard]] char At(size_t cellIdx) const;
+
+    //! Returns true if every cell in the given word is marked as air.
+    [[nodiscard]] bool IsAllAirWord(size_t wordIdx) const;
+
+    //! Returns the number of fluid cells, counted word-by-word.
+    [[nodiscard]] size_t CountFluidCells() const;
+
+ private:
+    Size3 m_size;
+    size_t m_numberOfCells = 0;
+    std::vector<uint64_t> m_words;
+};
+}  // namespace CubbyFlow
+
+#endif
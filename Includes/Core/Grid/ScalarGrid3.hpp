@@ -16,6 +16,7 @@
 #include <Core/Array/ArraySamplers3.hpp>
 #include <Core/Field/ScalarField3.hpp>
 #include <Core/Grid/Grid3.hpp>
+#include <Core/Utils/GridDataCodec.hpp>
 
 namespace CubbyFlow
 {
@@ -103,6 +104,16 @@ class ScalarGrid3 : public ScalarField3, public Grid3
     [[nodiscard]] double LaplacianAtDataPoint(size_t i, size_t j,
                                               size_t k) const;
 
+    //! Computes the gradient vector at every data point into \p result,
+    //! resizing it to the data size. Runs in parallel with a branch-free
+    //! interior kernel and agrees bitwise with GradientAtDataPoint.
+    void GradientGrid(Array3<Vector3D>* result) const;
+
+    //! Computes the Laplacian at every data point into \p result, resizing
+    //! it to the data size. Runs in parallel with a branch-free interior
+    //! kernel and agrees bitwise with LaplacianAtDataPoint.
+    void LaplacianGrid(Array3<double>* result) const;
+
     //! Returns the read-write data array accessor.
     [[nodiscard]] ScalarDataAccessor GetDataAccessor();
 
@@ -172,6 +183,23 @@ class ScalarGrid3 : public ScalarField3, public Grid3
     //! Deserializes the input buffer to the grid instance.
     void Deserialize(const std::vector<uint8_t>& buffer) override;
 
+    //!
+    //! \brief Serializes the grid instance to a compressed buffer.
+    //!
+    //! Unlike Serialize, the grid data is chunked and run-length encoded in
+    //! parallel, which shrinks simulation caches dominated by zero or
+    //! constant regions by an order of magnitude or more. The optional
+    //! \p quantization switches to lossy half-precision storage for
+    //! render-only channels. The buffer uses its own self-contained layout
+    //! and is only readable by DeserializeCompressed.
+    //!
+    void SerializeCompressed(std::vector<uint8_t>* buffer,
+                             GridDataQuantization quantization =
+                                 GridDataQuantization::Lossless) const;
+
+    //! Deserializes a buffer produced by SerializeCompressed.
+    void DeserializeCompressed(const std::vector<uint8_t>& buffer);
+
  protected:
     //! Swaps the data storage and predefined samplers with given grid.
     void SwapScalarGrid(ScalarGrid3* other);
@@ -186,6 +214,10 @@ class ScalarGrid3 : public ScalarField3, public Grid3
     void SetData(const std::vector<double>& data) override;
 
  private:
+    //! Detaches the copy-on-write data buffer ahead of a write and rebinds
+    //! the cached sampler if the buffer was actually copied.
+    void DetachData();
+
     void ResetSampler();
 
     Array3<double> m_data;
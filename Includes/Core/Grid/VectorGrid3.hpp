@@ -14,6 +14,7 @@
 #include <Core/Array/ArrayAccessor3.hpp>
 #include <Core/Field/VectorField3.hpp>
 #include <Core/Grid/Grid3.hpp>
+#include <Core/Utils/GridDataCodec.hpp>
 
 namespace CubbyFlow
 {
@@ -86,6 +87,20 @@ class VectorGrid3 : public VectorField3, public Grid3
     //! Deserializes the input buffer to the grid instance.
     void Deserialize(const std::vector<uint8_t>& buffer) override;
 
+    //!
+    //! \brief Serializes the grid instance to a compressed buffer.
+    //!
+    //! The grid data is chunked and run-length encoded in parallel; see
+    //! ScalarGrid3::SerializeCompressed for the trade-offs. The buffer is
+    //! only readable by DeserializeCompressed.
+    //!
+    void SerializeCompressed(std::vector<uint8_t>* buffer,
+                             GridDataQuantization quantization =
+                                 GridDataQuantization::Lossless) const;
+
+    //! Deserializes a buffer produced by SerializeCompressed.
+    void DeserializeCompressed(const std::vector<uint8_t>& buffer);
+
  protected:
     //!
     //! \brief Invoked when the resizing happens.
@@ -12,9 +12,71 @@
 #define CUBBYFLOW_CG_IMPL_HPP
 
 #include <Core/Math/MathUtils.hpp>
+#include <Core/Utils/Macros.hpp>
+#include <Core/Utils/Timer.hpp>
+
+#include <type_traits>
 
 namespace CubbyFlow
 {
+namespace Internal
+{
+//! Detects whether a BLAS type provides the fused CG kernels
+//! (AXPlusYAndSelfDot, MVMAndDot, and ResidualAndSelfDot).
+template <typename BLASType, typename = void>
+struct HasFusedCGKernels : std::false_type
+{
+    // Do nothing
+};
+
+template <typename BLASType>
+struct HasFusedCGKernels<
+    BLASType,
+    std::void_t<
+        decltype(BLASType::AXPlusYAndSelfDot(
+            std::declval<typename BLASType::ScalarType>(),
+            std::declval<const typename BLASType::VectorType&>(),
+            std::declval<const typename BLASType::VectorType&>(),
+            std::declval<typename BLASType::VectorType*>())),
+        decltype(BLASType::MVMAndDot(
+            std::declval<const typename BLASType::MatrixType&>(),
+            std::declval<const typename BLASType::VectorType&>(),
+            std::declval<typename BLASType::VectorType*>())),
+        decltype(BLASType::ResidualAndSelfDot(
+            std::declval<const typename BLASType::MatrixType&>(),
+            std::declval<const typename BLASType::VectorType&>(),
+            std::declval<const typename BLASType::VectorType&>(),
+            std::declval<typename BLASType::VectorType*>()))>> : std::true_type
+{
+    // Do nothing
+};
+
+//! Runs \p func, reporting its wall time to \p observer under \p phase.
+//! Without an observer the call is forwarded untimed.
+template <typename Callback>
+auto Timed(CGMetricsObserver* observer, CGPhase phase, Callback&& func)
+{
+    if (observer == nullptr)
+    {
+        return func();
+    }
+
+    if constexpr (std::is_void_v<decltype(func())>)
+    {
+        const Timer timer;
+        func();
+        observer->OnPhaseTime(phase, timer.DurationInSeconds());
+    }
+    else
+    {
+        const Timer timer;
+        auto result = func();
+        observer->OnPhaseTime(phase, timer.DurationInSeconds());
+        return result;
+    }
+}
+}  // namespace Internal
+
 template <typename BLASType>
 void CG(const typename BLASType::MatrixType& A,
         const typename BLASType::VectorType& b,
@@ -22,14 +84,95 @@ void CG(const typename BLASType::MatrixType& A,
         typename BLASType::VectorType* x, typename BLASType::VectorType* r,
         typename BLASType::VectorType* d, typename BLASType::VectorType* q,
         typename BLASType::VectorType* s, unsigned int* lastNumberOfIterations,
-        double* lastResidualNorm)
+        double* lastResidualNorm, CGMetricsObserver* observer)
 {
-    using PrecondType = NullCGPreconditioner<BLASType>;
-    PrecondType precond;
+    if constexpr (Internal::HasFusedCGKernels<BLASType>::value)
+    {
+        // Without a preconditioner the search direction is the residual
+        // itself, so the fused kernels fold each dot product into the pass
+        // that produces its operand instead of sweeping the vectors again.
+
+        // s is only needed by the preconditioned variant.
+        UNUSED_VARIABLE(s);
+
+        // r = b - Ax, sigmaNew = r.r
+        double sigmaNew = Internal::Timed(observer, CGPhase::SpMV, [&] {
+            return BLASType::ResidualAndSelfDot(A, *x, b, r);
+        });
+
+        // d = r
+        Internal::Timed(observer, CGPhase::Blas1,
+                        [&] { BLASType::Set(*r, d); });
 
-    PCG<BLASType, PrecondType>(A, b, maxNumberOfIterations, tolerance, &precond,
-                               x, r, d, q, s, lastNumberOfIterations,
-                               lastResidualNorm);
+        unsigned int iter = 0;
+        bool trigger = false;
+
+        while (sigmaNew > Square(tolerance) && iter < maxNumberOfIterations)
+        {
+            // q = Ad, alpha = sigmaNew / d.q
+            const double dDotQ = Internal::Timed(
+                observer, CGPhase::SpMV,
+                [&] { return BLASType::MVMAndDot(A, *d, q); });
+            const double alpha = sigmaNew / dDotQ;
+
+            // x = x + alpha * d
+            Internal::Timed(observer, CGPhase::Blas1,
+                            [&] { BLASType::AXPlusY(alpha, *d, *x, x); });
+
+            const double sigmaOld = sigmaNew;
+
+            // if i is divisible by 50...
+            if (trigger || (iter % 50 == 0 && iter > 0))
+            {
+                // r = b - Ax, sigmaNew = r.r
+                sigmaNew = Internal::Timed(observer, CGPhase::SpMV, [&] {
+                    return BLASType::ResidualAndSelfDot(A, *x, b, r);
+                });
+                trigger = false;
+            }
+            else
+            {
+                // r = r - alpha * q, sigmaNew = r.r
+                sigmaNew = Internal::Timed(observer, CGPhase::Blas1, [&] {
+                    return BLASType::AXPlusYAndSelfDot(-alpha, *q, *r, r);
+                });
+            }
+
+            if (sigmaNew > sigmaOld)
+            {
+                trigger = true;
+            }
+
+            // beta = sigmaNew / sigmaOld
+            const double beta = sigmaNew / sigmaOld;
+
+            // d = r + beta*d
+            Internal::Timed(observer, CGPhase::Blas1,
+                            [&] { BLASType::AXPlusY(beta, *d, *r, d); });
+
+            ++iter;
+
+            if (observer != nullptr)
+            {
+                observer->OnIteration(iter, std::sqrt(std::fabs(sigmaNew)));
+            }
+        }
+
+        *lastNumberOfIterations = iter;
+
+        // std::fabs(sigmaNew) - Workaround for negative zero
+        *lastResidualNorm = std::sqrt(std::fabs(sigmaNew));
+    }
+    else
+    {
+        using PrecondType = NullCGPreconditioner<BLASType>;
+        PrecondType precond;
+
+        PCG<BLASType, PrecondType>(A, b, maxNumberOfIterations, tolerance,
+                                   &precond, x, r, d, q, s,
+                                   lastNumberOfIterations, lastResidualNorm,
+                                   observer);
+    }
 }
 
 template <typename BLASType, typename PrecondType>
@@ -39,7 +182,7 @@ void PCG(const typename BLASType::MatrixType& A,
          typename BLASType::VectorType* x, typename BLASType::VectorType* r,
          typename BLASType::VectorType* d, typename BLASType::VectorType* q,
          typename BLASType::VectorType* s, unsigned int* lastNumberOfIterations,
-         double* lastResidualNorm)
+         double* lastResidualNorm, CGMetricsObserver* observer)
 {
     // Clear
     BLASType::Set(0, r);
@@ -48,13 +191,17 @@ void PCG(const typename BLASType::MatrixType& A,
     BLASType::Set(0, s);
 
     // r = b - Ax
-    BLASType::Residual(A, *x, b, r);
+    Internal::Timed(observer, CGPhase::SpMV,
+                    [&] { BLASType::Residual(A, *x, b, r); });
 
     // d = M^-1r
-    M->Solve(*r, d);
+    Internal::Timed(observer, CGPhase::Preconditioner,
+                    [&] { M->Solve(*r, d); });
 
     // sigmaNew = r.d
-    double sigmaNew = BLASType::Dot(*r, *d);
+    double sigmaNew = Internal::Timed(observer, CGPhase::Blas1, [&] {
+        return BLASType::Dot(*r, *d);
+    });
 
     unsigned int iter = 0;
     bool trigger = false;
@@ -62,35 +209,46 @@ void PCG(const typename BLASType::MatrixType& A,
     while (sigmaNew > Square(tolerance) && iter < maxNumberOfIterations)
     {
         // q = Ad
-        BLASType::MVM(A, *d, q);
+        Internal::Timed(observer, CGPhase::SpMV,
+                        [&] { BLASType::MVM(A, *d, q); });
 
         // alpha = sigmaNew / d.q
-        double alpha = sigmaNew / BLASType::Dot(*d, *q);
+        double alpha = sigmaNew / Internal::Timed(observer, CGPhase::Blas1,
+                                                  [&] {
+                                                      return BLASType::Dot(
+                                                          *d, *q);
+                                                  });
 
         // x = x + alpha * d
-        BLASType::AXPlusY(alpha, *d, *x, x);
+        Internal::Timed(observer, CGPhase::Blas1,
+                        [&] { BLASType::AXPlusY(alpha, *d, *x, x); });
 
         // if i is divisible by 50...
         if (trigger || (iter % 50 == 0 && iter > 0))
         {
             // r = b - Ax
-            BLASType::Residual(A, *x, b, r);
+            Internal::Timed(observer, CGPhase::SpMV,
+                            [&] { BLASType::Residual(A, *x, b, r); });
             trigger = false;
         }
         else
         {
             // r = r - alpha * q
-            BLASType::AXPlusY(-alpha, *q, *r, r);
+            Internal::Timed(observer, CGPhase::Blas1,
+                            [&] { BLASType::AXPlusY(-alpha, *q, *r, r); });
         }
 
         // s = M^-1r
-        M->Solve(*r, s);
+        Internal::Timed(observer, CGPhase::Preconditioner,
+                        [&] { M->Solve(*r, s); });
 
         // sigmaOld = sigmaNew
         const double sigmaOld = sigmaNew;
 
         // sigmaNew = r.s
-        sigmaNew = BLASType::Dot(*r, *s);
+        sigmaNew = Internal::Timed(observer, CGPhase::Blas1, [&] {
+            return BLASType::Dot(*r, *s);
+        });
 
         if (sigmaNew > sigmaOld)
         {
@@ -101,9 +259,15 @@ void PCG(const typename BLASType::MatrixType& A,
         double beta = sigmaNew / sigmaOld;
 
         // d = s + beta*d
-        BLASType::AXPlusY(beta, *d, *s, d);
+        Internal::Timed(observer, CGPhase::Blas1,
+                        [&] { BLASType::AXPlusY(beta, *d, *s, d); });
 
         ++iter;
+
+        if (observer != nullptr)
+        {
+            observer->OnIteration(iter, std::sqrt(std::fabs(sigmaNew)));
+        }
     }
 
     *lastNumberOfIterations = iter;
@@ -36,6 +36,55 @@ struct NullCGPreconditioner final
     }
 };
 
+//! Phases of a conjugate gradient iteration reported to CGMetricsObserver.
+enum class CGPhase
+{
+    //! Matrix-vector products (including the fused residual kernels).
+    SpMV,
+
+    //! Preconditioner solves.
+    Preconditioner,
+
+    //! Vector-vector sweeps (AXPlusY, Dot, Set).
+    Blas1
+};
+
+//!
+//! \brief Observer for conjugate gradient iteration metrics.
+//!
+//! When an observer is passed to CG or PCG, the solver reports the residual
+//! norm after every iteration and the wall time spent in each phase. Without
+//! an observer the iterations run untimed, so the hooks cost nothing in the
+//! default path.
+//!
+class CGMetricsObserver
+{
+ public:
+    //! Default constructor.
+    CGMetricsObserver() = default;
+
+    //! Default copy constructor.
+    CGMetricsObserver(const CGMetricsObserver&) = default;
+
+    //! Default move constructor.
+    CGMetricsObserver(CGMetricsObserver&&) noexcept = default;
+
+    //! Default virtual destructor.
+    virtual ~CGMetricsObserver() = default;
+
+    //! Default copy assignment operator.
+    CGMetricsObserver& operator=(const CGMetricsObserver&) = default;
+
+    //! Default move assignment operator.
+    CGMetricsObserver& operator=(CGMetricsObserver&&) noexcept = default;
+
+    //! Called after each iteration with the monitored residual norm.
+    virtual void OnIteration(unsigned int iteration, double residualNorm) = 0;
+
+    //! Called with the wall time of each instrumented phase.
+    virtual void OnPhaseTime(CGPhase phase, double seconds) = 0;
+};
+
 //!
 //! \brief Solves conjugate gradient.
 //!
@@ -46,7 +95,7 @@ void CG(const typename BLASType::MatrixType& A,
         typename BLASType::VectorType* x, typename BLASType::VectorType* r,
         typename BLASType::VectorType* d, typename BLASType::VectorType* q,
         typename BLASType::VectorType* s, unsigned int* lastNumberOfIterations,
-        double* lastResidualNorm);
+        double* lastResidualNorm, CGMetricsObserver* observer = nullptr);
 
 //!
 //! \brief Solves pre-conditioned conjugate gradient.
@@ -58,7 +107,7 @@ void PCG(const typename BLASType::MatrixType& A,
          typename BLASType::VectorType* x, typename BLASType::VectorType* r,
          typename BLASType::VectorType* d, typename BLASType::VectorType* q,
          typename BLASType::VectorType* s, unsigned int* lastNumberOfIterations,
-         double* lastResidualNorm);
+         double* lastResidualNorm, CGMetricsObserver* observer = nullptr);
 }  // namespace CubbyFlow
 
 #include <Core/Math/CG-Impl.hpp>
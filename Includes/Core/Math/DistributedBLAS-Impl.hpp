@@ -0,0 +1,122 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_DISTRIBUTED_BLAS_IMPL_HPP
+#define CUBBYFLOW_DISTRIBUTED_BLAS_IMPL_HPP
+
+#include <cmath>
+
+namespace CubbyFlow
+{
+template <typename BLASType, typename ReducePolicy>
+void DistributedBLAS<BLASType, ReducePolicy>::Set(ScalarType s,
+                                                  VectorType* result)
+{
+    BLASType::Set(s, result);
+}
+
+template <typename BLASType, typename ReducePolicy>
+void DistributedBLAS<BLASType, ReducePolicy>::Set(const VectorType& v,
+                                                  VectorType* result)
+{
+    BLASType::Set(v, result);
+}
+
+template <typename BLASType, typename ReducePolicy>
+void DistributedBLAS<BLASType, ReducePolicy>::Set(ScalarType s,
+                                                  MatrixType* result)
+{
+    BLASType::Set(s, result);
+}
+
+template <typename BLASType, typename ReducePolicy>
+void DistributedBLAS<BLASType, ReducePolicy>::Set(const MatrixType& m,
+                                                  MatrixType* result)
+{
+    BLASType::Set(m, result);
+}
+
+template <typename BLASType, typename ReducePolicy>
+typename BLASType::ScalarType DistributedBLAS<BLASType, ReducePolicy>::Dot(
+    const VectorType& a, const VectorType& b)
+{
+    return ReducePolicy::Sum(BLASType::Dot(a, b));
+}
+
+template <typename BLASType, typename ReducePolicy>
+void DistributedBLAS<BLASType, ReducePolicy>::AXPlusY(ScalarType a,
+                                                      const VectorType& x,
+                                                      const VectorType& y,
+                                                      VectorType* result)
+{
+    BLASType::AXPlusY(a, x, y, result);
+}
+
+template <typename BLASType, typename ReducePolicy>
+void DistributedBLAS<BLASType, ReducePolicy>::MVM(const MatrixType& m,
+                                                  const VectorType& v,
+                                                  VectorType* result)
+{
+    BLASType::MVM(m, v, result);
+}
+
+template <typename BLASType, typename ReducePolicy>
+void DistributedBLAS<BLASType, ReducePolicy>::Residual(const MatrixType& a,
+                                                       const VectorType& x,
+                                                       const VectorType& b,
+                                                       VectorType* result)
+{
+    BLASType::Residual(a, x, b, result);
+}
+
+template <typename BLASType, typename ReducePolicy>
+typename BLASType::ScalarType
+DistributedBLAS<BLASType, ReducePolicy>::AXPlusYAndSelfDot(ScalarType a,
+                                                           const VectorType& x,
+                                                           const VectorType& y,
+                                                           VectorType* result)
+{
+    return ReducePolicy::Sum(BLASType::AXPlusYAndSelfDot(a, x, y, result));
+}
+
+template <typename BLASType, typename ReducePolicy>
+typename BLASType::ScalarType
+DistributedBLAS<BLASType, ReducePolicy>::MVMAndDot(const MatrixType& m,
+                                                   const VectorType& v,
+                                                   VectorType* result)
+{
+    return ReducePolicy::Sum(BLASType::MVMAndDot(m, v, result));
+}
+
+template <typename BLASType, typename ReducePolicy>
+typename BLASType::ScalarType
+DistributedBLAS<BLASType, ReducePolicy>::ResidualAndSelfDot(
+    const MatrixType& a, const VectorType& x, const VectorType& b,
+    VectorType* result)
+{
+    return ReducePolicy::Sum(BLASType::ResidualAndSelfDot(a, x, b, result));
+}
+
+template <typename BLASType, typename ReducePolicy>
+typename BLASType::ScalarType DistributedBLAS<BLASType, ReducePolicy>::L2Norm(
+    const VectorType& v)
+{
+    return std::sqrt(ReducePolicy::Sum(BLASType::Dot(v, v)));
+}
+
+template <typename BLASType, typename ReducePolicy>
+typename BLASType::ScalarType
+DistributedBLAS<BLASType, ReducePolicy>::LInfNorm(const VectorType& v)
+{
+    return ReducePolicy::Max(BLASType::LInfNorm(v));
+}
+}  // namespace CubbyFlow
+
+#endif
@@ -0,0 +1,105 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_DISTRIBUTED_BLAS_HPP
+#define CUBBYFLOW_DISTRIBUTED_BLAS_HPP
+
+namespace CubbyFlow
+{
+//!
+//! \brief BLAS adapter globalizing reductions for domain-decomposed solves.
+//!
+//! CG and PCG are templated on a BLAS type, so running them across ranks
+//! only requires that every reduction returns the global value and that the
+//! matrix-vector products see up-to-date halo regions. This adapter wraps a
+//! local BLAS (e.g. FDMBLAS3 operating on the rank-local sub-domain) and
+//! routes every scalar reduction through \p ReducePolicy, which provides:
+//!
+//! \code
+//! struct Policy
+//! {
+//!     static double Sum(double localValue);  // e.g. MPI_Allreduce(SUM)
+//!     static double Max(double localValue);  // e.g. MPI_Allreduce(MAX)
+//! };
+//! \endcode
+//!
+//! All element-wise operations are forwarded unchanged. Halo exchange for
+//! MVM and Residual stays the caller's responsibility: either the wrapped
+//! matrix type exchanges ghost slabs inside its multiply, or the distributed
+//! layer wraps the solve in a matrix-free operator that exchanges before
+//! multiplying. The fused kernels are forwarded and their returned partial
+//! dot products are globalized, so the fused CG path stays usable.
+//!
+template <typename BLASType, typename ReducePolicy>
+struct DistributedBLAS
+{
+    using ScalarType = typename BLASType::ScalarType;
+    using VectorType = typename BLASType::VectorType;
+    using MatrixType = typename BLASType::MatrixType;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void Set(ScalarType s, VectorType* result);
+
+    //! Copies entire element of given vector \p result with other vector
+    //! \p v.
+    static void Set(const VectorType& v, VectorType* result);
+
+    //! Sets entire element of given matrix \p result with scalar \p s.
+    static void Set(ScalarType s, MatrixType* result);
+
+    //! Copies entire element of given matrix \p result with other matrix
+    //! \p m.
+    static void Set(const MatrixType& m, MatrixType* result);
+
+    //! Returns the global dot product with vector \p a and \p b.
+    static ScalarType Dot(const VectorType& a, const VectorType& b);
+
+    //! Performs ax + y operation where \p a is a matrix and \p x and \p y
+    //! are vectors.
+    static void AXPlusY(ScalarType a, const VectorType& x,
+                        const VectorType& y, VectorType* result);
+
+    //! Performs matrix-vector multiplication on the local sub-domain.
+    static void MVM(const MatrixType& m, const VectorType& v,
+                    VectorType* result);
+
+    //! Computes residual vector (b - ax) on the local sub-domain.
+    static void Residual(const MatrixType& a, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+
+    //! Performs fused \p result = a*x + y and returns the global dot product
+    //! of \p result with itself.
+    static ScalarType AXPlusYAndSelfDot(ScalarType a, const VectorType& x,
+                                        const VectorType& y,
+                                        VectorType* result);
+
+    //! Performs fused matrix-vector multiplication that also returns the
+    //! global dot product of \p v with \p result.
+    static ScalarType MVMAndDot(const MatrixType& m, const VectorType& v,
+                                VectorType* result);
+
+    //! Computes fused residual vector (b - ax) and returns the global dot
+    //! product of \p result with itself.
+    static ScalarType ResidualAndSelfDot(const MatrixType& a,
+                                         const VectorType& x,
+                                         const VectorType& b,
+                                         VectorType* result);
+
+    //! Returns the global L2-norm of the given vector \p v.
+    [[nodiscard]] static ScalarType L2Norm(const VectorType& v);
+
+    //! Returns the global Linf-norm of the given vector \p v.
+    [[nodiscard]] static ScalarType LInfNorm(const VectorType& v);
+};
+}  // namespace CubbyFlow
+
+#include <Core/Math/DistributedBLAS-Impl.hpp>
+
+#endif
@@ -266,7 +266,7 @@ Quaternion<T> Quaternion<T>::Mul(const Quaternion& other) const
 }
 
 template <typename T>
-T Quaternion<T>::Dot(const Quaternion<T>& other)
+T Quaternion<T>::Dot(const Quaternion<T>& other) const
 {
     return w * other.w + x * other.x + y * other.y + z * other.z;
 }
@@ -505,7 +505,7 @@ Quaternion<T> Slerp(const Quaternion<T>& a, const Quaternion<T>& b, T t)
     static const double threshold = 0.01;
     static const T eps = std::numeric_limits<T>::epsilon();
 
-    T cosHalfAngle = dot(a, b);
+    T cosHalfAngle = a.Dot(b);
     T weightA, weightB;
 
     // For better accuracy, return lerp result when a and b are close enough.
@@ -533,10 +533,13 @@ Quaternion<T> Slerp(const Quaternion<T>& a, const Quaternion<T>& b, T t)
         }
     }
 
+    // The near-parallel lerp branch leaves the result slightly off the unit
+    // sphere, so normalize before returning.
     return Quaternion<T>{ weightA * a.w + weightB * b.w,
                           weightA * a.x + weightB * b.x,
                           weightA * a.y + weightB * b.y,
-                          weightA * a.z + weightB * b.z };
+                          weightA * a.z + weightB * b.z }
+        .Normalized();
 }
 
 template <typename T>
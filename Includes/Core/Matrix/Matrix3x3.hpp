@@ -12,6 +12,7 @@
 #define CUBBYFLOW_MATRIX3X3_HPP
 
 #include <Core/Matrix/Matrix.hpp>
+#include <Core/Utils/Macros.hpp>
 #include <Core/Vector/Vector3.hpp>
 
 #include <array>
@@ -29,7 +30,7 @@ namespace CubbyFlow
 //! \tparam T - Type of the element.
 //!
 template <typename T>
-class Matrix<T, 3, 3>
+class CUBBYFLOW_SMALL_TYPE_ALIGNAS(T) Matrix<T, 3, 3>
 {
  public:
     static_assert(std::is_floating_point<T>::value,
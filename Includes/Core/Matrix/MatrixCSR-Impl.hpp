@@ -13,7 +13,9 @@
 
 #include <Core/Utils/CppUtils.hpp>
 #include <Core/Utils/Parallel.hpp>
+#include <Core/Vector/VectorN.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 namespace CubbyFlow
@@ -639,6 +641,54 @@ MatrixCSRVectorMul<T, VE> MatrixCSR<T>::Mul(
     return MatrixCSRVectorMul<T, VE>{ *this, v() };
 };
 
+template <typename T>
+void MatrixCSR<T>::ParallelMul(const VectorN<T>& x, VectorN<T>* result) const
+{
+    assert(x.size() == m_size.y);
+
+    const size_t numRows = m_size.x;
+    result->Resize(numRows);
+
+    const size_t* rp = m_rowPointers.data();
+    const size_t* ci = m_columnIndices.data();
+    const T* nnz = m_nonZeros.data();
+
+    const unsigned int numThreadsHint = GetMaxNumberOfThreads();
+    const size_t numBlocks =
+        (numThreadsHint == 0u) ? 8u : static_cast<size_t>(numThreadsHint);
+
+    // Partition the rows into blocks with roughly equal numbers of non-zeros.
+    // The row pointers are a prefix sum over them already, so the block
+    // boundaries come from binary searches for the per-block targets.
+    const size_t totalNonZeros = m_nonZeros.size();
+    std::vector<size_t> blockRowBegin(numBlocks + 1);
+    blockRowBegin[0] = 0;
+    blockRowBegin[numBlocks] = numRows;
+
+    for (size_t b = 1; b < numBlocks; ++b)
+    {
+        const size_t targetNonZeros = b * totalNonZeros / numBlocks;
+        blockRowBegin[b] = static_cast<size_t>(
+            std::upper_bound(rp, rp + numRows + 1, targetNonZeros) - rp - 1);
+    }
+
+    ParallelFor(ZERO_SIZE, numBlocks, [&](size_t b) {
+        const size_t rowEnd = blockRowBegin[b + 1];
+
+        for (size_t i = blockRowBegin[b]; i < rowEnd; ++i)
+        {
+            T sum = 0;
+
+            for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj)
+            {
+                sum += nnz[jj] * x[ci[jj]];
+            }
+
+            (*result)[i] = sum;
+        }
+    });
+}
+
 template <typename T>
 template <typename ME>
 MatrixCSRMatrixMul<T, ME> MatrixCSR<T>::Mul(
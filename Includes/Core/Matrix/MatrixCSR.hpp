@@ -16,10 +16,13 @@
 
 namespace CubbyFlow
 {
-// Forward declaration
+// Forward declarations
 template <typename T>
 class MatrixCSR;
 
+template <typename T>
+class VectorN;
+
 //!
 //! \brief Vector expression for CSR matrix-vector multiplication.
 //!
@@ -371,6 +374,18 @@ class MatrixCSR final : public MatrixExpression<T, MatrixCSR<T>>
     [[nodiscard]] MatrixCSRMatrixMul<T, ME> Mul(
         const MatrixExpression<T, ME>& m) const;
 
+    //!
+    //! \brief Computes this matrix * input vector \p x into \p result in
+    //! parallel.
+    //!
+    //! Unlike the lazy Mul expression, this function evaluates the product
+    //! eagerly across the tasking system. Rows are partitioned by accumulated
+    //! non-zero count rather than by row count, so each task streams roughly
+    //! the same amount of matrix data even when the non-zeros are distributed
+    //! unevenly across the rows.
+    //!
+    void ParallelMul(const VectorN<T>& x, VectorN<T>* result) const;
+
     //! Returns this matrix / input scalar.
     [[nodiscard]] MatrixCSR Div(const T& s) const;
 
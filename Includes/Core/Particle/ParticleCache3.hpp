@@ -0,0 +1,114 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_PARTICLE_CACHE3_HPP
+#define CUBBYFLOW_PARTICLE_CACHE3_HPP
+
+#include <Core/Particle/ParticleSystemData3.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Chunked on-disk cache format for 3-D particle system data.
+//!
+//! Unlike ParticleSystemData3::Serialize, which encodes every attribute into
+//! one monolithic flatbuffer in RAM before anything reaches the disk, this
+//! format streams each attribute layer to the file in fixed-size chunks, so
+//! peak memory stays bounded by a single chunk regardless of particle count.
+//!
+//! Every chunk starts on a 4096-byte boundary and a footer lists the byte
+//! offset of each chunk, so playback tools can locate and map individual
+//! attribute layers (e.g. positions only) without touching the rest of the
+//! file. The reader below fetches single layers through seeks for the same
+//! reason.
+//!
+//! File layout (little-endian):
+//!   header | chunk 0 | chunk 1 | ... | footer (chunk offsets) | trailer
+//!
+//! Chunks are ordered layer-major: all chunks of scalar layer 0, then scalar
+//! layer 1, ..., then vector layer 0, and so on. Vector layers store three
+//! doubles per particle.
+//!
+class ParticleCache3
+{
+ public:
+    //! Default number of particles per chunk.
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
+    //!
+    //! \brief Writes every attribute layer of \p data to \p fileName.
+    //!
+    //! \param[in] fileName  Path of the cache file to create.
+    //! \param[in] data      Particle system data to write.
+    //! \param[in] chunkSize Number of particles per chunk.
+    //!
+    //! \return True if the file was written successfully.
+    //!
+    [[nodiscard]] static bool Write(const std::string& fileName,
+                                    const ParticleSystemData3& data,
+                                    size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    //!
+    //! \brief Random-access reader for a particle cache file.
+    //!
+    //! Opening a file reads only the header and the footer; attribute data
+    //! is fetched on demand, one layer at a time, so a tool that needs just
+    //! the positions never pays for velocities, forces, or custom layers.
+    //!
+    class Reader
+    {
+     public:
+        //! Opens \p fileName and reads its header and footer.
+        //! \return True if the file is a valid particle cache.
+        [[nodiscard]] bool Open(const std::string& fileName);
+
+        //! Returns the number of particles in the cache.
+        [[nodiscard]] size_t GetNumberOfParticles() const;
+
+        //! Returns the number of scalar attribute layers.
+        [[nodiscard]] size_t GetNumberOfScalarLayers() const;
+
+        //! Returns the number of vector attribute layers.
+        [[nodiscard]] size_t GetNumberOfVectorLayers() const;
+
+        //! Returns the vector layer index holding particle positions.
+        [[nodiscard]] size_t GetPositionLayerIndex() const;
+
+        //! Reads scalar layer \p idx into \p data.
+        //! \return True on success.
+        [[nodiscard]] bool ReadScalarLayer(size_t idx,
+                                           Array1<double>* data) const;
+
+        //! Reads vector layer \p idx into \p data.
+        //! \return True on success.
+        [[nodiscard]] bool ReadVectorLayer(size_t idx,
+                                           Array1<Vector3D>* data) const;
+
+     private:
+        [[nodiscard]] bool ReadLayer(size_t chunkBegin, char* dst,
+                                     size_t bytesPerParticle) const;
+
+        mutable std::ifstream m_file;
+        std::vector<uint64_t> m_chunkOffsets;
+        size_t m_numberOfParticles = 0;
+        size_t m_numberOfScalarLayers = 0;
+        size_t m_numberOfVectorLayers = 0;
+        size_t m_positionLayerIdx = 0;
+        size_t m_chunkSize = 0;
+        size_t m_chunksPerLayer = 0;
+    };
+};
+}  // namespace CubbyFlow
+
+#endif
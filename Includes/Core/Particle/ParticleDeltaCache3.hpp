@@ -0,0 +1,103 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_PARTICLE_DELTA_CACHE3_HPP
+#define CUBBYFLOW_PARTICLE_DELTA_CACHE3_HPP
+
+#include <Core/Particle/ParticleSystemData3.hpp>
+
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Frame-delta codec for sequences of 3-D particle system data.
+//!
+//! Sequential cache frames are highly temporally coherent: particles move
+//! less than a grid spacing per frame. The encoder exploits this by writing
+//! a full keyframe (a regular ParticleSystemData3 flatbuffer) every N frames
+//! and, in between, only the bitwise residual of each attribute against a
+//! prediction from the previous frame. Positions are predicted as
+//! position + velocity * dt; every other attribute is predicted by its
+//! previous value. Residuals are XOR-ed bit patterns, so nearby predictions
+//! produce words that are mostly zero bytes, which a byte-plane transpose
+//! followed by run-length coding collapses — and since nothing is rounded,
+//! decoding restores every frame bit-exactly.
+//!
+//! Frames must be decoded in the order they were encoded; a decoder can
+//! start at any keyframe. The encoder falls back to a keyframe whenever the
+//! particle count or attribute layout changes.
+//!
+class ParticleDeltaCache3
+{
+ public:
+    //! Default number of frames between keyframes.
+    static constexpr size_t DEFAULT_KEYFRAME_INTERVAL = 8;
+
+    //! Stateful frame encoder.
+    class Encoder
+    {
+     public:
+        //! Constructs an encoder emitting a keyframe every
+        //! \p keyframeInterval frames.
+        explicit Encoder(size_t keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+
+        //!
+        //! \brief Encodes the next frame of \p data into \p buffer.
+        //!
+        //! \param[in]  data                  The particle data of this frame.
+        //! \param[in]  timeIntervalInSeconds The time step since the
+        //!                                   previous frame, used for the
+        //!                                   position prediction.
+        //! \param[out] buffer                The encoded frame.
+        //!
+        void EncodeFrame(const ParticleSystemData3& data,
+                         double timeIntervalInSeconds,
+                         std::vector<uint8_t>* buffer);
+
+        //! Resets the encoder; the next frame becomes a keyframe.
+        void Reset();
+
+     private:
+        ParticleSystemData3 m_state;
+        size_t m_keyframeInterval;
+        size_t m_framesSinceKeyframe = 0;
+        bool m_hasState = false;
+    };
+
+    //! Stateful frame decoder.
+    class Decoder
+    {
+     public:
+        //!
+        //! \brief Decodes the next frame from \p buffer into \p data.
+        //!
+        //! Frames must be passed in encode order, starting at a keyframe.
+        //!
+        //! \param[in]  buffer The encoded frame.
+        //! \param[out] data   The restored particle data.
+        //!
+        //! \return True on success; false if a delta frame arrives without
+        //!         a preceding keyframe or the buffer is malformed.
+        //!
+        [[nodiscard]] bool DecodeFrame(const std::vector<uint8_t>& buffer,
+                                       ParticleSystemData3* data);
+
+        //! Resets the decoder; the next frame must be a keyframe.
+        void Reset();
+
+     private:
+        ParticleSystemData3 m_state;
+        bool m_hasState = false;
+    };
+};
+}  // namespace CubbyFlow
+
+#endif
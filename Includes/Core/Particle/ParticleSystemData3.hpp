@@ -12,11 +12,18 @@
 #define CUBBYFLOW_PARTICLE_SYSTEM_DATA3_HPP
 
 #include <Core/Array/Array1.hpp>
+#include <Core/Array/Array3.hpp>
 #include <Core/Searcher/PointNeighborSearcher3.hpp>
+#include <Core/Utils/MemoryStats.hpp>
 #include <Core/Utils/Serialization.hpp>
 #include <Core/Vector/Vector3.hpp>
 
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 #ifndef CUBBYFLOW_DOXYGEN
@@ -47,7 +54,7 @@ namespace CubbyFlow
 //! single particle has position, velocity, and force attributes by default. But
 //! it can also have additional custom scalar or vector attributes.
 //!
-class ParticleSystemData3 : public Serializable
+class ParticleSystemData3 : public Serializable, public MemoryStats
 {
  public:
     //! Scalar data chunk.
@@ -56,6 +63,105 @@ class ParticleSystemData3 : public Serializable
     //! Vector data chunk.
     using VectorData = Array1<Vector3D>;
 
+    //!
+    //! \brief Mutable view of a vector attribute stored as three scalar
+    //!        channels (structure-of-arrays).
+    //!
+    //! Each channel is a contiguous array of doubles, so SIMD loops can use
+    //! unit-stride loads on x, y, and z independently.
+    //!
+    struct SoAVectorDataView
+    {
+        ArrayAccessor1<double> x;
+        ArrayAccessor1<double> y;
+        ArrayAccessor1<double> z;
+
+        //! Returns the vector value at index \p i.
+        [[nodiscard]] Vector3D At(size_t i) const
+        {
+            return Vector3D{ x[i], y[i], z[i] };
+        }
+
+        //! Sets the vector value at index \p i.
+        void Set(size_t i, const Vector3D& value)
+        {
+            x[i] = value.x;
+            y[i] = value.y;
+            z[i] = value.z;
+        }
+    };
+
+    //!
+    //! \brief Element type of a typed attribute channel.
+    //!
+    //! Render attributes such as age, foam factor, or color rarely need 64
+    //! bits per component; narrow channels halve (or better) the memory and
+    //! cache bandwidth of attribute-heavy systems.
+    //!
+    enum class TypedDataType : uint8_t
+    {
+        //! 32-bit floating point scalar, element type float.
+        Float32 = 0,
+
+        //! 16-bit unsigned integer scalar, element type uint16_t.
+        UInt16 = 1,
+
+        //! Unit vector packed octahedrally into 32 bits (see
+        //! ParticleSystemData3::PackNormal), element type uint32_t.
+        PackedNormal = 2
+    };
+
+    //! Immutable view of a vector attribute stored as three scalar channels.
+    struct ConstSoAVectorDataView
+    {
+        ConstArrayAccessor1<double> x;
+        ConstArrayAccessor1<double> y;
+        ConstArrayAccessor1<double> z;
+
+        //! Returns the vector value at index \p i.
+        [[nodiscard]] Vector3D At(size_t i) const
+        {
+            return Vector3D{ x[i], y[i], z[i] };
+        }
+    };
+
+    //!
+    //! \brief Flattened, CSR-style neighbor list storage.
+    //!
+    //! All neighbor indices are packed into a single 32-bit index array, and
+    //! \p offsets bounds the slice belonging to each particle. Iterating the
+    //! neighbors of every particle then walks two contiguous allocations
+    //! instead of chasing one heap block per particle.
+    //!
+    struct CompactNeighborLists
+    {
+        //! Offsets into \p indices; entries \p i and \p i + 1 bound the
+        //! neighbors of particle \p i. Has (number of particles + 1) entries.
+        std::vector<size_t> offsets;
+
+        //! Packed neighbor indices for all particles.
+        std::vector<uint32_t> indices;
+
+        //! Returns the number of neighbors of particle \p i.
+        [[nodiscard]] size_t NumberOfNeighbors(size_t i) const
+        {
+            return offsets[i + 1] - offsets[i];
+        }
+
+        //! Invokes \p callback with the index of each neighbor of particle
+        //! \p i.
+        template <typename Callback>
+        void ForEachNeighbor(size_t i, Callback callback) const
+        {
+            const size_t end = offsets[i + 1];
+
+            for (size_t jj = offsets[i]; jj < end; ++jj)
+            {
+                callback(static_cast<size_t>(indices[jj]));
+            }
+        }
+    };
+
     //! Default constructor.
     ParticleSystemData3();
 
@@ -93,6 +199,15 @@ class ParticleSystemData3 : public Serializable
     //! Returns the number of particles.
     size_t GetNumberOfParticles() const;
 
+    //! Returns the number of scalar data layers.
+    [[nodiscard]] size_t GetNumberOfScalarDataLayers() const;
+
+    //! Returns the number of vector data layers.
+    [[nodiscard]] size_t GetNumberOfVectorDataLayers() const;
+
+    //! Returns the vector data layer index holding particle positions.
+    [[nodiscard]] size_t GetPositionIndex() const;
+
     //!
     //! \brief      Adds a scalar data layer and returns its index.
     //!
@@ -113,6 +228,101 @@ class ParticleSystemData3 : public Serializable
     //!
     size_t AddVectorData(const Vector3D& initialVal = Vector3D());
 
+    //!
+    //! \brief      Adds a SoA vector data layer and returns its index.
+    //!
+    //! This function adds a new vector data layer stored as three separate
+    //! contiguous double channels (true SoA) instead of an interleaved
+    //! Array1<Vector3D>. Use this for attributes consumed by vectorized
+    //! kernels that need unit-stride access per component. The channels are
+    //! backed by regular scalar data layers, so Resize and AddParticle(s)
+    //! keep them in sync with the rest of the system.
+    //!
+    //! \param[in] initialVal  Initial value of the new vector data.
+    //!
+    size_t AddSoAVectorData(const Vector3D& initialVal = Vector3D());
+
+    //!
+    //! \brief      Adds a typed data channel and returns its index.
+    //!
+    //! Typed channels store one narrow element per particle (float,
+    //! uint16_t, or a packed normal) instead of a full double, and are kept
+    //! in sync with the rest of the system by Resize and AddParticle(s).
+    //! New particles get zero-initialized elements. Retrieve the channel
+    //! with ParticleSystemData3::TypedDataAt using the element type listed
+    //! on TypedDataType.
+    //!
+    //! \param[in] type  Element type of the new channel.
+    //!
+    size_t AddTypedData(TypedDataType type);
+
+    //! Returns the number of typed data channels.
+    [[nodiscard]] size_t GetNumberOfTypedDataLayers() const;
+
+    //! Returns the element type of the typed data channel at given index.
+    [[nodiscard]] TypedDataType GetTypedDataTypeAt(size_t idx) const;
+
+    //! Returns the element size in bytes of the given typed data type.
+    [[nodiscard]] static size_t GetTypedDataElementSize(TypedDataType type);
+
+    //! Returns true if \p T is the element type matching \p type.
+    template <typename T>
+    [[nodiscard]] static constexpr bool IsTypedDataElementType(
+        TypedDataType type)
+    {
+        return (std::is_same_v<T, float> && type == TypedDataType::Float32) ||
+               (std::is_same_v<T, uint16_t> &&
+                type == TypedDataType::UInt16) ||
+               (std::is_same_v<T, uint32_t> &&
+                type == TypedDataType::PackedNormal);
+    }
+
+    //!
+    //! \brief      Returns the typed data channel at given index (immutable).
+    //!
+    //! \tparam T  Element type of the channel; must match the type the
+    //!            channel was registered with.
+    //!
+    template <typename T>
+    [[nodiscard]] ConstArrayAccessor1<T> TypedDataAt(size_t idx) const
+    {
+        const TypedData& data = m_typedDataList[idx];
+        assert(IsTypedDataElementType<T>(data.type));
+
+        return ConstArrayAccessor1<T>{
+            m_numberOfParticles,
+            reinterpret_cast<const T*>(data.bytes.data())
+        };
+    }
+
+    //!
+    //! \brief      Returns the typed data channel at given index (mutable).
+    //!
+    //! \tparam T  Element type of the channel; must match the type the
+    //!            channel was registered with.
+    //!
+    template <typename T>
+    [[nodiscard]] ArrayAccessor1<T> TypedDataAt(size_t idx)
+    {
+        TypedData& data = m_typedDataList[idx];
+        assert(IsTypedDataElementType<T>(data.type));
+
+        return ArrayAccessor1<T>{ m_numberOfParticles,
+                                  reinterpret_cast<T*>(data.bytes.data()) };
+    }
+
+    //!
+    //! \brief      Packs a unit vector into 32 bits.
+    //!
+    //! Octahedral encoding with 16 bits per component; the reconstruction
+    //! error stays well below what shading normals need. The input does not
+    //! have to be normalized (a zero vector packs as +z).
+    //!
+    [[nodiscard]] static uint32_t PackNormal(const Vector3D& normal);
+
+    //! Unpacks a normal packed by ParticleSystemData3::PackNormal.
+    [[nodiscard]] static Vector3D UnpackNormal(uint32_t packed);
+
     //! Returns the radius of the particles.
     double GetRadius() const;
 
@@ -120,7 +330,7 @@ class ParticleSystemData3 : public Serializable
     virtual void SetRadius(double newRadius);
 
     //! Returns the mass of the particles.
-    double GetMass() const;
+    virtual double GetMass() const;
 
     //! Sets the mass of the particles.
     virtual void SetMass(double newMass);
@@ -155,6 +365,20 @@ class ParticleSystemData3 : public Serializable
     //! Returns custom vector data layer at given index (mutable).
     ArrayAccessor1<Vector3D> VectorDataAt(size_t idx);
 
+    //! Returns custom SoA vector data layer at given index (immutable).
+    ConstSoAVectorDataView SoAVectorDataAt(size_t idx) const;
+
+    //! Returns custom SoA vector data layer at given index (mutable).
+    SoAVectorDataView SoAVectorDataAt(size_t idx);
+
+    //! Copies interleaved vector data layer \p vectorIdx into SoA vector data
+    //! layer \p soaIdx.
+    void CopyVectorDataToSoA(size_t vectorIdx, size_t soaIdx);
+
+    //! Copies SoA vector data layer \p soaIdx into interleaved vector data
+    //! layer \p vectorIdx.
+    void CopyVectorDataFromSoA(size_t vectorIdx, size_t soaIdx);
+
     //!
     //! \brief      Adds a particle to the data structure.
     //!
@@ -192,6 +416,33 @@ class ParticleSystemData3 : public Serializable
                       const ConstArrayAccessor1<Vector3D>& newForces =
                           ConstArrayAccessor1<Vector3D>());
 
+    //!
+    //! \brief      Begins a lock-free concurrent append phase.
+    //!
+    //! While the phase is active, ParticleSystemData3::AddParticle and
+    //! ParticleSystemData3::AddParticles copy their input into private
+    //! staging batches that are pushed onto a lock-free list instead of
+    //! resizing the data layers, so they may be called from multiple threads
+    //! at once. Existing layers are not mutated during the phase, so
+    //! concurrent readers of the current particles stay valid. Call
+    //! ParticleSystemData3::EndConcurrentAppend from a single thread to merge
+    //! the staged batches into the system.
+    //!
+    void BeginConcurrentAppend();
+
+    //!
+    //! \brief      Ends the concurrent append phase and merges staged batches.
+    //!
+    //! Performs a single resize followed by one parallel copy of all staged
+    //! batches. The relative order of batches staged by different threads is
+    //! unspecified. Must not be called while other threads are still
+    //! appending.
+    //!
+    void EndConcurrentAppend();
+
+    //! Returns true if a concurrent append phase is active.
+    [[nodiscard]] bool IsConcurrentAppendActive() const;
+
     //!
     //! \brief      Returns neighbor searcher.
     //!
@@ -213,22 +464,157 @@ class ParticleSystemData3 : public Serializable
     //! PointParallelHashGridSearcher3::BuildNeighborLists. Each list stores
     //! indices of the neighbors.
     //!
+    //! The per-particle vectors are expanded from the compact storage on
+    //! first call after a rebuild, so performance-sensitive loops should use
+    //! GetCompactNeighborLists instead.
+    //!
     //! \return     Neighbor lists.
     //!
     const std::vector<std::vector<size_t>>& GetNeighborLists() const;
 
+    //!
+    //! \brief      Returns compact neighbor lists.
+    //!
+    //! This function returns the flattened neighbor lists which are available
+    //! after calling ParticleSystemData3::BuildNeighborLists. Unlike
+    //! ParticleSystemData3::GetNeighborLists, no per-particle heap blocks are
+    //! involved, so this is the preferred form for hot kernel loops.
+    //!
+    //! \return     Compact neighbor lists.
+    //!
+    const CompactNeighborLists& GetCompactNeighborLists() const;
+
     //! Builds neighbor searcher with given search radius.
     void BuildNeighborSearcher(double maxSearchRadius);
 
+    //!
+    //! \brief      Updates neighbor searcher with given search radius.
+    //!
+    //! When the current searcher is a PointParallelHashGridSearcher3 built
+    //! for the same search radius, this function incrementally re-bins only
+    //! the particles that moved to another hash grid cell, which is much
+    //! cheaper than a full rebuild for CFL-limited displacements. Otherwise
+    //! it falls back to ParticleSystemData3::BuildNeighborSearcher.
+    //!
+    void UpdateNeighborSearcher(double maxSearchRadius);
+
     //! Builds neighbor lists with given search radius.
     void BuildNeighborLists(double maxSearchRadius);
 
+    //!
+    //! \brief      Computes the number of particles per cell of the given
+    //!             grid layout.
+    //!
+    //! This function bins every particle into the cell containing it,
+    //! clamping positions outside the domain into the border cells the same
+    //! way the grid transfer kernels do. The histogram is the cost model for
+    //! load-balanced grid loops: slabs or tiles holding many particles get
+    //! proportionally smaller index ranges (see ParallelRangeForWeighted),
+    //! which evens out per-thread work of particle-grid transfers over
+    //! strongly clustered distributions.
+    //!
+    //! \param[in]  resolution  The grid resolution.
+    //! \param[in]  origin      The grid origin.
+    //! \param[in]  gridSpacing The grid spacing.
+    //! \param[out] histogram   The per-cell particle counts.
+    //!
+    void ComputeParticleCountHistogram(const Size3& resolution,
+                                       const Vector3D& origin,
+                                       const Vector3D& gridSpacing,
+                                       Array3<size_t>* histogram) const;
+
+    //!
+    //! \brief      Updates the per-particle sleep states.
+    //!
+    //! A particle falls asleep once its speed stays at or below
+    //! \p sleepSpeedThreshold for \p sleepFrameCount consecutive calls, and
+    //! a sleeping particle wakes up again when any cell in the 3x3x3
+    //! neighborhood of its own cell holds an active particle, so motion
+    //! entering a settled region propagates one cell ring per update. Cells
+    //! follow the given grid layout with the same clamped binning as
+    //! ParticleSystemData3::ComputeParticleCountHistogram. Newly added
+    //! particles start active, and reordering the particles invalidates the
+    //! states until the next update. The result is available through
+    //! ParticleSystemData3::GetActivityStates; solvers can skip transfer and
+    //! advection work for sleeping particles.
+    //!
+    //! \param[in]  sleepSpeedThreshold Speed at or below which a particle
+    //!                                 counts as resting.
+    //! \param[in]  sleepFrameCount     Number of consecutive resting updates
+    //!                                 before a particle falls asleep.
+    //! \param[in]  resolution  The grid resolution.
+    //! \param[in]  origin      The grid origin.
+    //! \param[in]  gridSpacing The grid spacing.
+    //!
+    void UpdateActivityStates(double sleepSpeedThreshold,
+                              size_t sleepFrameCount, const Size3& resolution,
+                              const Vector3D& origin,
+                              const Vector3D& gridSpacing);
+
+    //!
+    //! \brief      Returns the per-particle activity states.
+    //!
+    //! One entry per particle, 1 for sleeping and 0 for active. Empty until
+    //! ParticleSystemData3::UpdateActivityStates has been called.
+    //!
+    [[nodiscard]] ConstArrayAccessor1<char> GetActivityStates() const;
+
+    //!
+    //! \brief      Reorders particles into the neighbor searcher's sorted
+    //!             order.
+    //!
+    //! This function permutes every attribute channel so that particles that
+    //! share a hash grid cell become contiguous in memory, which makes
+    //! neighbor gathers read near-contiguous cache lines. It requires the
+    //! current searcher to be a PointParallelHashGridSearcher3 that was built
+    //! for the current set of particles, and does nothing otherwise. The
+    //! reordering invalidates neighbor searcher and neighbor lists; callers
+    //! must rebuild them afterwards. The applied mapping is available through
+    //! ParticleSystemData3::GetParticleReorderMap for code that keeps
+    //! particle indices across the reorder.
+    //!
+    void ReorderParticles();
+
+    //!
+    //! \brief      Returns the old-to-new index map of the last reorder.
+    //!
+    //! The returned list maps a particle's index before the most recent
+    //! ReorderParticles call to its index afterwards. It is empty if the
+    //! particles have never been reordered.
+    //!
+    //! \return     The particle reorder map.
+    //!
+    const std::vector<size_t>& GetParticleReorderMap() const;
+
+    //!
+    //! \brief      Removes the flagged particles from the system.
+    //!
+    //! This function compacts every attribute channel over the particles
+    //! whose \p shouldRemove flag is zero, preserving their relative order.
+    //! Like adding particles, removal invalidates neighbor searcher and
+    //! neighbor lists; it is users responsibility to call
+    //! ParticleSystemData3::BuildNeighborSearcher and
+    //! ParticleSystemData3::BuildNeighborLists to refresh those data. The
+    //! activity states and the particle reorder map are cleared as well.
+    //!
+    //! \param[in]  shouldRemove  One flag per particle; non-zero entries are
+    //!                           removed.
+    //!
+    void RemoveParticles(const ConstArrayAccessor1<char>& shouldRemove);
+
     //! Serializes this particle system data to the buffer.
     void Serialize(std::vector<uint8_t>* buffer) const override;
 
     //! Deserializes this particle system data from the buffer.
     void Deserialize(const std::vector<uint8_t>& buffer) override;
 
+    //! Returns the type name for memory accounting.
+    [[nodiscard]] const char* GetMemoryStatsName() const override;
+
+    //! Reports the bytes held by each attribute list.
+    void ReportMemoryUsage(
+        std::vector<MemoryUsageRecord>* records) const override;
+
     //! Copies from other particle system data.
     void Set(const ParticleSystemData3& other);
 
@@ -242,6 +628,45 @@ class ParticleSystemData3 : public Serializable
         const fbs::ParticleSystemData3* fbsParticleSystemData);
 
  private:
+    //! One typed attribute channel: element type plus raw byte storage of
+    //! (element size) * (number of particles) bytes.
+    struct TypedData
+    {
+        TypedDataType type;
+        Array1<uint8_t> bytes;
+    };
+
+    //! One batch staged by a concurrent AddParticles call.
+    struct StagedParticleBatch
+    {
+        Array1<Vector3D> positions;
+        Array1<Vector3D> velocities;
+        Array1<Vector3D> forces;
+        StagedParticleBatch* next = nullptr;
+    };
+
+    //! Head of the lock-free staged batch list; allocated only while a
+    //! concurrent append phase is active.
+    struct ConcurrentAppendState
+    {
+        ~ConcurrentAppendState()
+        {
+            StagedParticleBatch* batch = head.load();
+            while (batch != nullptr)
+            {
+                StagedParticleBatch* next = batch->next;
+                delete batch;
+                batch = next;
+            }
+        }
+
+        std::atomic<StagedParticleBatch*> head{ nullptr };
+    };
+
+    void StageParticles(const ConstArrayAccessor1<Vector3D>& newPositions,
+                        const ConstArrayAccessor1<Vector3D>& newVelocities,
+                        const ConstArrayAccessor1<Vector3D>& newForces);
+
     double m_radius = 1e-3;
     double m_mass = 1e-3;
     size_t m_numberOfParticles = 0;
@@ -252,8 +677,36 @@ class ParticleSystemData3 : public Serializable
     std::vector<ScalarData> m_scalarDataList;
     std::vector<VectorData> m_vectorDataList;
 
+    //! Per-SoA-layer indices of the backing x/y/z scalar data layers.
+    //! Rebuilt by the owner after deserialization; the channels themselves
+    //! persist as ordinary scalar data layers.
+    std::vector<std::array<size_t, 3>> m_soaVectorDataList;
+
+    //! Typed attribute channels. The cache schema stores doubles only, so
+    //! serialization widens each channel into a trailing f64 scalar layer;
+    //! the typed layout is rebuilt by the owner after deserialization.
+    std::vector<TypedData> m_typedDataList;
+
     PointNeighborSearcher3Ptr m_neighborSearcher;
-    std::vector<std::vector<size_t>> m_neighborLists;
+    CompactNeighborLists m_neighborLists;
+
+    //! Old-to-new index map of the most recent ReorderParticles call.
+    std::vector<size_t> m_reorderOldToNew;
+
+    //! Per-particle activity states (1 = sleeping) and the consecutive
+    //! resting-update counts backing the sleep hysteresis. Sized lazily by
+    //! UpdateActivityStates; not serialized.
+    Array1<char> m_activityStates;
+    Array1<uint32_t> m_quietFrameCounts;
+
+    //! Non-null only between BeginConcurrentAppend and EndConcurrentAppend;
+    //! not copied by Set.
+    std::unique_ptr<ConcurrentAppendState> m_concurrentAppendState;
+
+    //! Per-particle vectors expanded from m_neighborLists on demand for the
+    //! legacy GetNeighborLists accessor.
+    mutable std::vector<std::vector<size_t>> m_expandedNeighborLists;
+    mutable bool m_expandedNeighborListsDirty = true;
 };
 
 //! Shared pointer type of ParticleSystemData3.
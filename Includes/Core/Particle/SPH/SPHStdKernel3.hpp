@@ -30,6 +30,9 @@ namespace CubbyFlow
 //!
 struct SPHStdKernel3
 {
+    //! Number of distances consumed by one batched evaluation call.
+    static constexpr size_t BATCH_SIZE = 8;
+
     //! Constructs a kernel object with zero radius.
     SPHStdKernel3();
 
@@ -39,9 +42,22 @@ struct SPHStdKernel3
     //! Returns kernel function value at given distance.
     double operator()(double distance) const;
 
+    //!
+    //! \brief Evaluates the kernel for \p count packed distances at once.
+    //!
+    //! The loop body is branch-free so that the compiler can vectorize it.
+    //! \p count must not exceed BATCH_SIZE.
+    //!
+    void Evaluate(const double* distances, size_t count,
+                  double* weights) const;
+
     //! Returns the first derivative at given distance.
     [[nodiscard]] double FirstDerivative(double distance) const;
 
+    //! Evaluates the first derivative for \p count packed distances at once.
+    void FirstDerivative(const double* distances, size_t count,
+                         double* derivatives) const;
+
     //! Returns the gradient at a point.
     [[nodiscard]] Vector3D Gradient(const Vector3D& point) const;
 
@@ -52,6 +68,10 @@ struct SPHStdKernel3
     //! Returns the second derivative at given distance.
     [[nodiscard]] double SecondDerivative(double distance) const;
 
+    //! Evaluates the second derivative for \p count packed distances at once.
+    void SecondDerivative(const double* distances, size_t count,
+                          double* derivatives) const;
+
     //! Kernel radius.
     double h;
 
@@ -63,6 +83,21 @@ struct SPHStdKernel3
 
     //! Fifth-power of the kernel radius.
     double h5;
+
+    //! Cached reciprocal 1 / h^2, fixed at construction so the per-distance
+    //! support test needs no division in the evaluation loops.
+    double invH2;
+
+    //! Cached normalization constant 315 / (64 * pi * h^3) of the kernel.
+    double kernelNorm;
+
+    //! Cached normalization constant -945 / (32 * pi * h^5) of the first
+    //! derivative.
+    double firstDerivativeNorm;
+
+    //! Cached normalization constant 945 / (32 * pi * h^5) of the second
+    //! derivative.
+    double secondDerivativeNorm;
 };
 
 //!
@@ -75,6 +110,9 @@ struct SPHStdKernel3
 //!
 struct SPHSpikyKernel3
 {
+    //! Number of distances consumed by one batched evaluation call.
+    static constexpr size_t BATCH_SIZE = 8;
+
     //! Constructs a kernel object with zero radius.
     SPHSpikyKernel3();
 
@@ -84,9 +122,22 @@ struct SPHSpikyKernel3
     //! Returns kernel function value at given distance.
     double operator()(double distance) const;
 
+    //!
+    //! \brief Evaluates the kernel for \p count packed distances at once.
+    //!
+    //! The loop body is branch-free so that the compiler can vectorize it.
+    //! \p count must not exceed BATCH_SIZE.
+    //!
+    void Evaluate(const double* distances, size_t count,
+                  double* weights) const;
+
     //! Returns the first derivative at given distance.
     [[nodiscard]] double FirstDerivative(double distance) const;
 
+    //! Evaluates the first derivative for \p count packed distances at once.
+    void FirstDerivative(const double* distances, size_t count,
+                         double* derivatives) const;
+
     //! Returns the gradient at a point.
     [[nodiscard]] Vector3D Gradient(const Vector3D& point) const;
 
@@ -97,6 +148,10 @@ struct SPHSpikyKernel3
     //! Returns the second derivative at given distance.
     [[nodiscard]] double SecondDerivative(double distance) const;
 
+    //! Evaluates the second derivative for \p count packed distances at once.
+    void SecondDerivative(const double* distances, size_t count,
+                          double* derivatives) const;
+
     //! Kernel radius.
     double h;
 
@@ -111,6 +166,21 @@ struct SPHSpikyKernel3
 
     //! Fifth-power of the kernel radius.
     double h5;
+
+    //! Cached reciprocal 1 / h, fixed at construction so the per-distance
+    //! support test needs no division in the evaluation loops.
+    double invH;
+
+    //! Cached normalization constant 15 / (pi * h^3) of the kernel.
+    double kernelNorm;
+
+    //! Cached normalization constant -45 / (pi * h^4) of the first
+    //! derivative.
+    double firstDerivativeNorm;
+
+    //! Cached normalization constant 90 / (pi * h^5) of the second
+    //! derivative.
+    double secondDerivativeNorm;
 };
 }  // namespace CubbyFlow
 
@@ -63,6 +63,16 @@ class SPHSystemData3 : public ParticleSystemData3
     //!
     void SetMass(double newMass) override;
 
+    //!
+    //! \brief      Returns the mass of a particle.
+    //!
+    //! Setting target density, spacing, or kernel radius only marks the mass
+    //! as stale; the BCC-lattice calibration in ComputeMass() runs here, once,
+    //! on first use. This keeps scene setup scripts that assign those
+    //! properties in arbitrary order from recomputing the mass per assignment.
+    //!
+    double GetMass() const override;
+
     //! Returns the density array accessor (immutable).
     [[nodiscard]] ConstArrayAccessor1<double> GetDensities() const;
 
@@ -165,9 +175,93 @@ class SPHSystemData3 : public ParticleSystemData3
     [[nodiscard]] Vector3D LaplacianAt(
         size_t i, const ConstArrayAccessor1<Vector3D>& values) const;
 
+    //!
+    //! \brief Enables per-particle spacing and mass channels.
+    //!
+    //! Adds two scalar data layers holding each particle's own spacing and
+    //! mass, initialized from the current target spacing and calibrated
+    //! mass. They are the data model for adaptive resolution: split
+    //! particles near the free surface to keep surface detail and merge
+    //! them in the deep interior where a coarser sampling carries the same
+    //! pressure field (see SPHSystemData3::SplitParticles and
+    //! SPHSystemData3::MergeParticles). While enabled, neighbor queries are
+    //! built with the largest per-particle kernel radius so coarse
+    //! particles still find all of their neighbors. The interpolation and
+    //! density utilities keep using the global kernel radius, so spacing
+    //! variation should stay within a small factor of the target spacing.
+    //! Like the SoA and typed channel layout, the channel assignment is not
+    //! serialized and must be re-enabled by the owner after
+    //! deserialization.
+    //!
+    void EnableAdaptiveSpacing();
+
+    //! Returns true if per-particle spacing and mass channels are enabled.
+    [[nodiscard]] bool HasAdaptiveSpacing() const;
+
+    //! Returns the per-particle spacing array accessor (immutable).
+    [[nodiscard]] ConstArrayAccessor1<double> GetParticleSpacings() const;
+
+    //! Returns the per-particle spacing array accessor (mutable).
+    [[nodiscard]] ArrayAccessor1<double> GetParticleSpacings();
+
+    //! Returns the per-particle mass array accessor (immutable).
+    [[nodiscard]] ConstArrayAccessor1<double> GetParticleMasses() const;
+
+    //! Returns the per-particle mass array accessor (mutable).
+    [[nodiscard]] ArrayAccessor1<double> GetParticleMasses();
+
+    //!
+    //! \brief Splits the flagged particles in two.
+    //!
+    //! Each flagged particle is replaced by two children that share its
+    //! volume: half the mass each and the spacing scaled by 2^(-1/3). The
+    //! children are offset symmetrically along the parent's velocity (or
+    //! the x-axis when the parent is at rest) and inherit its velocity,
+    //! force, density, and pressure, so total mass and momentum are
+    //! conserved exactly. Particles whose children would fall below
+    //! \p minSpacing are left untouched. Requires
+    //! SPHSystemData3::EnableAdaptiveSpacing, and invalidates neighbor
+    //! searcher and neighbor lists like adding particles does.
+    //!
+    //! \param[in]  shouldSplit One flag per particle; non-zero entries are
+    //!                         split.
+    //! \param[in]  minSpacing  Smallest allowed child spacing.
+    //!
+    //! \return     The number of particles that were split.
+    //!
+    size_t SplitParticles(const ConstArrayAccessor1<char>& shouldSplit,
+                          double minSpacing);
+
+    //!
+    //! \brief Merges flagged particles pairwise.
+    //!
+    //! Greedily pairs each flagged particle with its nearest flagged
+    //! neighbor and replaces the pair by one particle at their center of
+    //! mass, with summed mass and force, mass-weighted velocity and
+    //! density, and the volume-combining spacing (s1^3 + s2^3)^(1/3), so
+    //! total mass and momentum are conserved exactly. Pairs whose combined
+    //! spacing would exceed \p maxSpacing are skipped, and each particle
+    //! merges at most once per call. Requires
+    //! SPHSystemData3::EnableAdaptiveSpacing and up-to-date neighbor lists,
+    //! and invalidates neighbor searcher and neighbor lists when any pair
+    //! merges.
+    //!
+    //! \param[in]  canMerge    One flag per particle; only non-zero entries
+    //!                         may merge.
+    //! \param[in]  maxSpacing  Largest allowed merged spacing.
+    //!
+    //! \return     The number of merged pairs.
+    //!
+    size_t MergeParticles(const ConstArrayAccessor1<char>& canMerge,
+                          double maxSpacing);
+
     //! Builds neighbor searcher with kernel radius.
     void BuildNeighborSearcher();
 
+    //! Updates neighbor searcher with kernel radius, re-binning only the
+    //! particles that moved to another hash grid cell when possible.
+    void UpdateNeighborSearcher();
+
     //! Builds neighbor lists with kernel radius.
     void BuildNeighborLists();
 
@@ -198,8 +292,27 @@ class SPHSystemData3 : public ParticleSystemData3
 
     size_t m_densityIdx = 0;
 
-    //! Computes the mass based on the target density and spacing.
+    //! True when the per-particle spacing and mass channels exist. The flag
+    //! and the channel indices are not serialized (see
+    //! SPHSystemData3::EnableAdaptiveSpacing).
+    bool m_hasAdaptiveSpacing = false;
+
+    size_t m_spacingIdx = 0;
+
+    size_t m_particleMassIdx = 0;
+
+    //! True when the mass no longer matches the target density/spacing and
+    //! must be recalibrated on the next GetMass() call.
+    bool m_massDirty = true;
+
+    //! Computes the mass based on the target density and spacing, and clears
+    //! the pending recompute flag.
     void ComputeMass();
+
+    //! Returns the radius neighbor queries must cover: the global kernel
+    //! radius, widened to the largest per-particle kernel radius when
+    //! adaptive spacing is enabled.
+    [[nodiscard]] double GetMaxSearchRadius() const;
 };
 
 //! Shared pointer for the SPHSystemData3 type.
@@ -34,6 +34,18 @@ class BccLatticePointGenerator final : public PointGenerator3
     void ForEachPoint(
         const BoundingBox3D& boundingBox, double spacing,
         const std::function<bool(const Vector3D&)>& callback) const override;
+
+    //!
+    //! \brief Generates BCC-lattice points inside \p boundingBox in parallel.
+    //!
+    //! The lattice is regular, so the exact number of points per z-slab is
+    //! known up front; the output array is appended to in one resize and the
+    //! slabs are filled in parallel. The points and their order match
+    //! ForEachPoint exactly, without the per-point callback and append
+    //! overhead that dominates large-volume seeding.
+    //!
+    void Generate(const BoundingBox3D& boundingBox, double spacing,
+                  Array1<Vector3D>* points) const override;
 };
 
 //! Shared pointer type for the BccLatticePointGenerator.
@@ -31,6 +31,16 @@ class GridPointGenerator3 final : public PointGenerator3
     void ForEachPoint(
         const BoundingBox3D& boundingBox, double spacing,
         const std::function<bool(const Vector3D&)>& callback) const override;
+
+    //!
+    //! \brief Generates regular grid points inside \p boundingBox in parallel.
+    //!
+    //! Every z-slab of the grid holds the same number of points, so the
+    //! output array is sized once up front and the slabs are filled in
+    //! parallel. The points and their order match ForEachPoint exactly.
+    //!
+    void Generate(const BoundingBox3D& boundingBox, double spacing,
+                  Array1<Vector3D>* points) const override;
 };
 
 //! Shared pointer type for the GridPointGenerator3.
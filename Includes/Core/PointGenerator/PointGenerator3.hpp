@@ -47,9 +47,11 @@ class PointGenerator3
     PointGenerator3& operator=(PointGenerator3&&) noexcept = default;
 
     //! Generates points to output array \p points inside given \p boundingBox
-    //! with target point \p spacing.
-    void Generate(const BoundingBox3D& boundingBox, double spacing,
-                  Array1<Vector3D>* points) const;
+    //! with target point \p spacing. The base implementation appends through
+    //! ForEachPoint; subclasses may override it with a pre-sized parallel
+    //! fill when the point count can be computed up front.
+    virtual void Generate(const BoundingBox3D& boundingBox, double spacing,
+                          Array1<Vector3D>* points) const;
 
     //!
     //! \brief Iterates every point within the bounding box with specified
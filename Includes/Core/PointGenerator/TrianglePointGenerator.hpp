@@ -31,6 +31,18 @@ class TrianglePointGenerator final : public PointGenerator2
     void ForEachPoint(
         const BoundingBox2D& boundingBox, double spacing,
         const std::function<bool(const Vector2D&)>& callback) const override;
+
+    //!
+    //! \brief Generates triangle lattice points inside \p boundingBox in
+    //! parallel.
+    //!
+    //! The row point counts only depend on whether the row carries the
+    //! half-spacing offset, so the output array is sized once up front and
+    //! the rows are filled in parallel. The points and their order match
+    //! ForEachPoint exactly.
+    //!
+    void Generate(const BoundingBox2D& boundingBox, double spacing,
+                  Array1<Vector2D>* points) const override;
 };
 
 using TrianglePointGeneratorPtr = std::shared_ptr<TrianglePointGenerator>;
@@ -11,8 +11,12 @@
 #ifndef CUBBYFLOW_ANISOTROPIC_POINTS_TO_IMPLICIT3_HPP
 #define CUBBYFLOW_ANISOTROPIC_POINTS_TO_IMPLICIT3_HPP
 
+#include <Core/Matrix/Matrix3x3.hpp>
 #include <Core/PointsToImplicit/PointsToImplicit3.hpp>
 
+#include <functional>
+#include <vector>
+
 namespace CubbyFlow
 {
 //!
@@ -46,10 +50,65 @@ class AnisotropicPointsToImplicit3 final : public PointsToImplicit3
                                  size_t minNumNeighbors = 25,
                                  bool isOutputSDF = true);
 
+    //!
+    //! \brief Callback that appends the points inside \p region to \p points.
+    //!
+    //! Used by the streaming conversion path to fetch particles on demand,
+    //! e.g. from an out-of-core particle cache. Returning extra points
+    //! outside the region is allowed; dropping points inside it is not.
+    //!
+    using PointsInRegionFunc =
+        std::function<void(const BoundingBox3D& region,
+                           std::vector<Vector3D>* points)>;
+
     //! Converts the given points to implicit surface scalar field.
     void Convert(const ConstArrayAccessor1<Vector3D>& points,
                  ScalarGrid3* output) const override;
 
+    //!
+    //! \brief Per-particle state carried between incremental conversions.
+    //!
+    //! Holds the particle positions, neighbor counts, and anisotropy
+    //! matrices from the previous frame. Owned by the caller so one
+    //! converter can serve multiple particle sets.
+    //!
+    struct AnisotropyCache final
+    {
+        std::vector<Vector3D> positions;
+        std::vector<size_t> numNeighbors;
+        std::vector<Matrix3x3D> gs;
+    };
+
+    //!
+    //! \brief Temporally coherent variant of Convert.
+    //!
+    //! Reuses the previous frame's anisotropy matrix for particles whose
+    //! neighborhood barely changed - displacement below
+    //! \p positionTolerance (expressed as a fraction of the kernel radius)
+    //! and neighbor-count delta at most \p neighborCountTolerance - and
+    //! recomputes the covariance SVD only for the rest. \p cache must keep
+    //! addressing the same particle set across calls; a size mismatch
+    //! triggers a full recompute. Smoothed kernel centers and densities are
+    //! always refreshed.
+    //!
+    void ConvertIncremental(const ConstArrayAccessor1<Vector3D>& points,
+                            AnisotropyCache* cache, ScalarGrid3* output,
+                            double positionTolerance = 0.05,
+                            size_t neighborCountTolerance = 2) const;
+
+    //!
+    //! \brief Streaming variant of Convert that bounds peak particle memory.
+    //!
+    //! Processes the output grid in z-slabs of \p slabThickness data layers.
+    //! For each slab, only the particles within kernel reach of that slab
+    //! (including the neighbors their anisotropy estimates depend on) are
+    //! fetched through \p pointsInRegion, so frames far larger than RAM can
+    //! be converted as long as a single slab's working set fits. Results
+    //! match Convert up to floating-point summation order.
+    //!
+    void ConvertStreaming(const PointsInRegionFunc& pointsInRegion,
+                          ScalarGrid3* output, size_t slabThickness = 32) const;
+
  private:
     double m_kernelRadius = 1.0;
     double m_cutOffDensity = 0.5;
@@ -0,0 +1,349 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_DYNAMIC_QUERY_ENGINE3_IMPL_HPP
+#define CUBBYFLOW_DYNAMIC_QUERY_ENGINE3_IMPL_HPP
+
+#include <Core/Utils/Constants.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace CubbyFlow
+{
+template <typename T>
+DynamicQueryEngine3<T>::DynamicQueryEngine3(BoundingBoxFunc boundsFunc)
+    : m_boundsFunc{ std::move(boundsFunc) }
+{
+    // Do nothing
+}
+
+template <typename T>
+void DynamicQueryEngine3<T>::Add(const T& item)
+{
+    m_pool.emplace_back(item);
+    m_bounds.emplace_back(m_boundsFunc(item));
+    m_removed.emplace_back(0);
+}
+
+template <typename T>
+void DynamicQueryEngine3<T>::Add(const std::vector<T>& items)
+{
+    for (const auto& item : items)
+    {
+        Add(item);
+    }
+}
+
+template <typename T>
+bool DynamicQueryEngine3<T>::Remove(const T& item)
+{
+    for (size_t i = 0; i < m_pool.size(); ++i)
+    {
+        if (!m_removed[i] && m_pool[i] == item)
+        {
+            m_removed[i] = 1;
+            ++m_numRemoved;
+
+            if (i < m_numInTree)
+            {
+                m_refitPending = true;
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+void DynamicQueryEngine3<T>::Clear()
+{
+    m_pool.clear();
+    m_bounds.clear();
+    m_removed.clear();
+    m_numRemoved = 0;
+    m_numInTree = 0;
+    m_refitPending = false;
+    m_bvh.Clear();
+}
+
+template <typename T>
+size_t DynamicQueryEngine3<T>::GetNumberOfItems() const
+{
+    return m_pool.size() - m_numRemoved;
+}
+
+template <typename T>
+bool DynamicQueryEngine3<T>::IsIntersects(
+    const BoundingBox3D& box, const BoxIntersectionTestFunc3<T>& testFunc) const
+{
+    Sync();
+
+    if (m_numInTree > 0 &&
+        m_bvh.IsIntersects(box,
+                           [&](const size_t& idx, const BoundingBox3D& b) {
+                               return !m_removed[idx] &&
+                                      testFunc(m_pool[idx], b);
+                           }))
+    {
+        return true;
+    }
+
+    for (size_t i = m_numInTree; i < m_pool.size(); ++i)
+    {
+        if (!m_removed[i] && testFunc(m_pool[i], box))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+bool DynamicQueryEngine3<T>::IsIntersects(
+    const Ray3D& ray, const RayIntersectionTestFunc3<T>& testFunc) const
+{
+    Sync();
+
+    if (m_numInTree > 0 &&
+        m_bvh.IsIntersects(ray, [&](const size_t& idx, const Ray3D& r) {
+            return !m_removed[idx] && testFunc(m_pool[idx], r);
+        }))
+    {
+        return true;
+    }
+
+    for (size_t i = m_numInTree; i < m_pool.size(); ++i)
+    {
+        if (!m_removed[i] && testFunc(m_pool[i], ray))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+void DynamicQueryEngine3<T>::ForEachIntersectingItem(
+    const BoundingBox3D& box, const BoxIntersectionTestFunc3<T>& testFunc,
+    const IntersectionVisitorFunc3<T>& visitorFunc) const
+{
+    Sync();
+
+    if (m_numInTree > 0)
+    {
+        m_bvh.ForEachIntersectingItem(
+            box,
+            [&](const size_t& idx, const BoundingBox3D& b) {
+                return !m_removed[idx] && testFunc(m_pool[idx], b);
+            },
+            [&](const size_t& idx) { visitorFunc(m_pool[idx]); });
+    }
+
+    for (size_t i = m_numInTree; i < m_pool.size(); ++i)
+    {
+        if (!m_removed[i] && testFunc(m_pool[i], box))
+        {
+            visitorFunc(m_pool[i]);
+        }
+    }
+}
+
+template <typename T>
+void DynamicQueryEngine3<T>::ForEachIntersectingItem(
+    const Ray3D& ray, const RayIntersectionTestFunc3<T>& testFunc,
+    const IntersectionVisitorFunc3<T>& visitorFunc) const
+{
+    Sync();
+
+    if (m_numInTree > 0)
+    {
+        m_bvh.ForEachIntersectingItem(
+            ray,
+            [&](const size_t& idx, const Ray3D& r) {
+                return !m_removed[idx] && testFunc(m_pool[idx], r);
+            },
+            [&](const size_t& idx) { visitorFunc(m_pool[idx]); });
+    }
+
+    for (size_t i = m_numInTree; i < m_pool.size(); ++i)
+    {
+        if (!m_removed[i] && testFunc(m_pool[i], ray))
+        {
+            visitorFunc(m_pool[i]);
+        }
+    }
+}
+
+template <typename T>
+ClosestIntersectionQueryResult3<T>
+DynamicQueryEngine3<T>::GetClosestIntersection(
+    const Ray3D& ray, const GetRayIntersectionFunc3<T>& testFunc) const
+{
+    Sync();
+
+    ClosestIntersectionQueryResult3<T> best;
+
+    if (m_numInTree > 0)
+    {
+        const auto treeResult = m_bvh.GetClosestIntersection(
+            ray, [&](const size_t& idx, const Ray3D& r) {
+                return m_removed[idx] ? std::numeric_limits<double>::max()
+                                      : testFunc(m_pool[idx], r);
+            });
+        if (treeResult.item != nullptr)
+        {
+            best.distance = treeResult.distance;
+            best.item = &m_pool[*treeResult.item];
+        }
+    }
+
+    for (size_t i = m_numInTree; i < m_pool.size(); ++i)
+    {
+        if (m_removed[i])
+        {
+            continue;
+        }
+
+        const double dist = testFunc(m_pool[i], ray);
+        if (dist < best.distance)
+        {
+            best.distance = dist;
+            best.item = &m_pool[i];
+        }
+    }
+
+    return best;
+}
+
+template <typename T>
+NearestNeighborQueryResult3<T> DynamicQueryEngine3<T>::GetNearestNeighbor(
+    const Vector3D& pt,
+    const NearestNeighborDistanceFunc3<T>& distanceFunc) const
+{
+    Sync();
+
+    NearestNeighborQueryResult3<T> best;
+
+    if (m_numInTree > 0)
+    {
+        const auto treeResult = m_bvh.GetNearestNeighbor(
+            pt, [&](const size_t& idx, const Vector3D& p) {
+                return m_removed[idx] ? std::numeric_limits<double>::max()
+                                      : distanceFunc(m_pool[idx], p);
+            });
+        if (treeResult.item != nullptr && !m_removed[*treeResult.item])
+        {
+            best.distance = treeResult.distance;
+            best.item = &m_pool[*treeResult.item];
+        }
+    }
+
+    for (size_t i = m_numInTree; i < m_pool.size(); ++i)
+    {
+        if (m_removed[i])
+        {
+            continue;
+        }
+
+        const double dist = distanceFunc(m_pool[i], pt);
+        if (dist < best.distance)
+        {
+            best.distance = dist;
+            best.item = &m_pool[i];
+        }
+    }
+
+    return best;
+}
+
+template <typename T>
+void DynamicQueryEngine3<T>::Sync() const
+{
+    const size_t numOverflow = m_pool.size() - m_numInTree;
+    const size_t numChanges = numOverflow + m_numRemoved;
+    const size_t numLive = m_pool.size() - m_numRemoved;
+    const auto threshold =
+        std::max(MIN_CHANGES_PER_REBUILD,
+                 static_cast<size_t>(REBUILD_FRACTION *
+                                     static_cast<double>(numLive)));
+
+    if (numChanges > threshold || m_numInTree == 0)
+    {
+        Rebuild();
+        return;
+    }
+
+    if (m_refitPending)
+    {
+        // Shrink the bounds of removed items to empty boxes so that the
+        // refitted tree never descends into them; the items stay in the
+        // pool until the next compaction.
+        std::vector<BoundingBox3D> treeBounds(m_numInTree);
+        for (size_t i = 0; i < m_numInTree; ++i)
+        {
+            treeBounds[i] = m_removed[i] ? BoundingBox3D{} : m_bounds[i];
+        }
+
+        m_bvh.Refit(treeBounds);
+        m_refitPending = false;
+    }
+}
+
+template <typename T>
+void DynamicQueryEngine3<T>::Rebuild() const
+{
+    if (m_numRemoved > 0)
+    {
+        size_t dst = 0;
+        for (size_t src = 0; src < m_pool.size(); ++src)
+        {
+            if (!m_removed[src])
+            {
+                if (dst != src)
+                {
+                    m_pool[dst] = std::move(m_pool[src]);
+                    m_bounds[dst] = m_bounds[src];
+                }
+                ++dst;
+            }
+        }
+
+        m_pool.resize(dst);
+        m_bounds.resize(dst);
+        m_removed.assign(dst, 0);
+        m_numRemoved = 0;
+    }
+
+    m_numInTree = m_pool.size();
+    m_refitPending = false;
+
+    if (m_numInTree == 0)
+    {
+        m_bvh.Clear();
+        return;
+    }
+
+    std::vector<size_t> indices(m_numInTree);
+    std::iota(indices.begin(), indices.end(), ZERO_SIZE);
+
+    // The LBVH build trades some query quality for build speed, which is
+    // the right trade for a tree that is rebuilt periodically.
+    m_bvh.BuildParallel(indices, m_bounds);
+}
+}  // namespace CubbyFlow
+
+#endif
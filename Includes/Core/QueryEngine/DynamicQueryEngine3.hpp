@@ -0,0 +1,118 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_DYNAMIC_QUERY_ENGINE3_HPP
+#define CUBBYFLOW_DYNAMIC_QUERY_ENGINE3_HPP
+
+#include <Core/Geometry/BVH3.hpp>
+#include <Core/QueryEngine/IntersectionQueryEngine3.hpp>
+#include <Core/QueryEngine/NearestNeighborQueryEngine3.hpp>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Incremental 3-D intersection/nearest-neighbor query engine.
+//!
+//! This engine targets item sets that change every frame, where rebuilding
+//! a BVH3 per frame is too expensive and ListQueryEngine3 makes every query
+//! a linear scan. Items live in a persistent pool; a BVH indexes a prefix of
+//! the pool while recently added items are kept in a small linear overflow
+//! section and removed items are masked out via a bottom-up refit of the
+//! tree. Once the accumulated changes exceed a fraction of the live item
+//! count, the pool is compacted and the tree rebuilt, so the rebuild cost is
+//! amortized over the mutations while queries stay sublinear in between.
+//!
+template <typename T>
+class DynamicQueryEngine3 final : public IntersectionQueryEngine3<T>,
+                                  public NearestNeighborQueryEngine3<T>
+{
+ public:
+    //! Returns the bounding box of an item.
+    using BoundingBoxFunc = std::function<BoundingBox3D(const T&)>;
+
+    //! Constructs an empty engine with given item-to-bounds mapping function.
+    explicit DynamicQueryEngine3(BoundingBoxFunc boundsFunc);
+
+    //! Adds an item to the container.
+    void Add(const T& item);
+
+    //! Adds items to the container.
+    void Add(const std::vector<T>& items);
+
+    //! Removes the first item comparing equal to \p item. Returns false if
+    //! no such item is stored.
+    bool Remove(const T& item);
+
+    //! Clears all the stored items.
+    void Clear();
+
+    //! Returns the number of stored items.
+    [[nodiscard]] size_t GetNumberOfItems() const;
+
+    //! Returns true if given \p box intersects with any of the stored items.
+    [[nodiscard]] bool IsIntersects(
+        const BoundingBox3D& box,
+        const BoxIntersectionTestFunc3<T>& testFunc) const override;
+
+    //! Returns true if given \p ray intersects with any of the stored items.
+    [[nodiscard]] bool IsIntersects(
+        const Ray3D& ray,
+        const RayIntersectionTestFunc3<T>& testFunc) const override;
+
+    //! Invokes \p visitorFunc for every intersecting items.
+    void ForEachIntersectingItem(
+        const BoundingBox3D& box, const BoxIntersectionTestFunc3<T>& testFunc,
+        const IntersectionVisitorFunc3<T>& visitorFunc) const override;
+
+    //! Invokes \p visitorFunc for every intersecting items.
+    void ForEachIntersectingItem(
+        const Ray3D& ray, const RayIntersectionTestFunc3<T>& testFunc,
+        const IntersectionVisitorFunc3<T>& visitorFunc) const override;
+
+    //! Returns the closest intersection for given \p ray.
+    [[nodiscard]] ClosestIntersectionQueryResult3<T> GetClosestIntersection(
+        const Ray3D& ray,
+        const GetRayIntersectionFunc3<T>& testFunc) const override;
+
+    //! Returns the nearest neighbor for given point and distance measure
+    //! function.
+    [[nodiscard]] NearestNeighborQueryResult3<T> GetNearestNeighbor(
+        const Vector3D& pt,
+        const NearestNeighborDistanceFunc3<T>& distanceFunc) const override;
+
+ private:
+    //! Applies pending removals to the tree and rebuilds it when the
+    //! accumulated changes crossed the amortization threshold.
+    void Sync() const;
+
+    //! Compacts the pool, dropping removed items, and rebuilds the tree
+    //! over the whole pool.
+    void Rebuild() const;
+
+    //! Minimum number of pending changes before a rebuild is considered.
+    static constexpr size_t MIN_CHANGES_PER_REBUILD = 8;
+
+    //! Pending-change-to-live-item ratio that triggers a rebuild.
+    static constexpr double REBUILD_FRACTION = 0.25;
+
+    BoundingBoxFunc m_boundsFunc;
+    mutable std::vector<T> m_pool;
+    mutable std::vector<BoundingBox3D> m_bounds;
+    mutable std::vector<char> m_removed;
+    mutable size_t m_numRemoved = 0;
+    mutable size_t m_numInTree = 0;
+    mutable bool m_refitPending = false;
+    mutable BVH3<size_t> m_bvh;
+};
+}  // namespace CubbyFlow
+
+#include <Core/QueryEngine/DynamicQueryEngine3-Impl.hpp>
+
+#endif
@@ -11,6 +11,7 @@
 #ifndef CUBBYFLOW_INTERSECTION_QUERY_ENGINE3_HPP
 #define CUBBYFLOW_INTERSECTION_QUERY_ENGINE3_HPP
 
+#include <Core/Array/ArrayAccessor1.hpp>
 #include <Core/Geometry/BoundingBox3.hpp>
 #include <Core/Vector/Vector3.hpp>
 
@@ -95,6 +96,24 @@ class IntersectionQueryEngine3
     [[nodiscard]] virtual ClosestIntersectionQueryResult3<T>
     GetClosestIntersection(
         const Ray3D& ray, const GetRayIntersectionFunc3<T>& testFunc) const = 0;
+
+    //!
+    //! \brief Computes the closest intersection for every ray in \p rays.
+    //!
+    //! Writes the result for \p rays[i] to \p results[i]. The default
+    //! implementation answers each ray independently; engines that can
+    //! amortize traversal over coherent ray batches override this.
+    //!
+    virtual void GetClosestIntersections(
+        const ConstArrayAccessor1<Ray3D>& rays,
+        const GetRayIntersectionFunc3<T>& testFunc,
+        ArrayAccessor1<ClosestIntersectionQueryResult3<T>> results) const
+    {
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            results[i] = GetClosestIntersection(rays[i], testFunc);
+        }
+    }
 };
 }  // namespace CubbyFlow
 
@@ -13,6 +13,8 @@
 
 #include <Core/Geometry/Size3.hpp>
 #include <Core/Searcher/PointNeighborSearcher3.hpp>
+#include <Core/Utils/Macros.hpp>
+#include <Core/Utils/SmallVector.hpp>
 
 #include <vector>
 
@@ -77,6 +79,20 @@ class PointHashGridSearcher3 final : public PointNeighborSearcher3
     //! Builds internal acceleration structure for given points list.
     void Build(const ConstArrayAccessor1<Vector3D>& points) override;
 
+    //!
+    //! \brief Rebuilds the acceleration structure with a new grid spacing.
+    //!
+    //! Equivalent to retargeting the grid spacing and calling Build, but on
+    //! the live instance: the bucket table and the per-bucket index lists
+    //! keep their allocations, so pooling the searcher across frames avoids
+    //! reallocating them every substep.
+    //!
+    //! \param[in]  points      The points to be added.
+    //! \param[in]  gridSpacing The grid spacing.
+    //!
+    void Rebuild(const ConstArrayAccessor1<Vector3D>& points,
+                 double gridSpacing);
+
     //!
     //! Invokes the callback function for each nearby point around the origin
     //! within given radius.
@@ -89,6 +105,40 @@ class PointHashGridSearcher3 final : public PointNeighborSearcher3
         const Vector3D& origin, double radius,
         const ForEachNearbyPointFunc& callback) const override;
 
+    //!
+    //! \brief Template overload of ForEachNearbyPoint without type erasure.
+    //!
+    //! The callback is invoked directly instead of through a std::function,
+    //! so the compiler can inline it into the bucket scan. Prefer this
+    //! overload in inner loops that issue one query per particle.
+    //!
+    //! \param[in]  origin   The origin position.
+    //! \param[in]  radius   The search radius.
+    //! \param[in]  callback The callback function.
+    //!
+    template <typename Callback>
+    void ForEachNearbyPoint(const Vector3D& origin, double radius,
+                            const Callback& callback) const;
+
+    //!
+    //! \brief Accumulates a value over the nearby points.
+    //!
+    //! Fused query-and-reduce variant: \p function is invoked as
+    //! function(accumulated, pointIndex, pointPosition) for every point
+    //! within \p radius, and its return value becomes the new accumulated
+    //! value. Returns the final accumulation, starting from \p initialValue.
+    //!
+    //! \param[in]  origin       The origin position.
+    //! \param[in]  radius       The search radius.
+    //! \param[in]  initialValue The initial accumulator value.
+    //! \param[in]  function     The reduction function.
+    //!
+    template <typename Value, typename Function>
+    [[nodiscard]] Value AccumulateNearbyPoints(const Vector3D& origin,
+                                               double radius,
+                                               const Value& initialValue,
+                                               Function function) const;
+
     //!
     //! Returns true if there are any nearby points for given origin within
     //! radius.
@@ -158,18 +208,49 @@ class PointHashGridSearcher3 final : public PointNeighborSearcher3
     //! Deserializes the neighbor searcher from the buffer.
     void Deserialize(const std::vector<uint8_t>& buffer) override;
 
+    //! Returns the type name for memory accounting.
+    [[nodiscard]] const char* GetMemoryStatsName() const override;
+
+    //! Reports the bytes held by the search structure.
+    void ReportMemoryUsage(
+        std::vector<MemoryUsageRecord>* records) const override;
+
     //! Returns builder fox PointHashGridSearcher3.
     [[nodiscard]] static Builder GetBuilder();
 
  private:
+    //! How many candidates ahead of the distance test to prefetch. Roughly
+    //! the load latency divided by the per-candidate work.
+    static constexpr size_t PREFETCH_DISTANCE = 8;
+
     [[nodiscard]] size_t GetHashKeyFromPosition(const Vector3D& position) const;
 
     void GetNearbyKeys(const Vector3D& position, size_t* nearbyKeys) const;
 
+    //! Refreshes the cached reciprocal spacing and, when every resolution is
+    //! a power of two, the masks and shifts of the branchless key path. Must
+    //! be called whenever the resolution or grid spacing changes.
+    void UpdateHashConstants();
+
     double m_gridSpacing = 1.0;
     Point3I m_resolution = Point3I(1, 1, 1);
     std::vector<Vector3D> m_points;
     std::vector<std::vector<size_t>> m_buckets;
+
+    //! Cached 1 / gridSpacing so bucket quantization needs no division.
+    double m_invGridSpacing = 1.0;
+
+    //! True when every resolution component is a power of two; bucket
+    //! wrapping then reduces to a bit-and and the row math to shifts.
+    bool m_isResolutionPowerOfTwo = true;
+
+    //! Per-axis wrap masks (resolution - 1), valid in power-of-two mode.
+    Point3I m_resolutionMask = Point3I(0, 0, 0);
+
+    //! log2(resolution.x) and log2(resolution.x * resolution.y), valid in
+    //! power-of-two mode.
+    size_t m_resolutionShiftX = 0;
+    size_t m_resolutionShiftXY = 0;
 };
 
 //! Shared pointer for the PointHashGridSearcher3 type.
@@ -202,6 +283,78 @@ class PointHashGridSearcher3::Builder final
     Size3 m_resolution{ 64, 64, 64 };
     double m_gridSpacing = 1.0;
 };
+
+template <typename Callback>
+void PointHashGridSearcher3::ForEachNearbyPoint(const Vector3D& origin,
+                                                double radius,
+                                                const Callback& callback) const
+{
+    if (m_buckets.empty())
+    {
+        return;
+    }
+
+    size_t nearbyKeys[8];
+    GetNearbyKeys(origin, nearbyKeys);
+
+    const double queryRadiusSquared = radius * radius;
+
+    // Walking the bucket index lists is sequential and cheap; the expensive
+    // part is the dependent gather of m_points at random addresses. Collect
+    // the candidate indices first, then run the distance tests with software
+    // prefetches issued a fixed distance ahead so the point loads overlap
+    // with the tests instead of serializing on cache misses.
+    SmallVector<size_t, 256> candidates;
+
+    for (const auto& key : nearbyKeys)
+    {
+        for (const size_t pointIndex : m_buckets[key])
+        {
+            candidates.Append(pointIndex);
+        }
+    }
+
+    const size_t numberOfCandidates = candidates.Size();
+
+    for (size_t i = 0; i < PREFETCH_DISTANCE && i < numberOfCandidates; ++i)
+    {
+        CUBBYFLOW_PREFETCH_READ(&m_points[candidates[i]]);
+    }
+
+    for (size_t i = 0; i < numberOfCandidates; ++i)
+    {
+        if (i + PREFETCH_DISTANCE < numberOfCandidates)
+        {
+            CUBBYFLOW_PREFETCH_READ(
+                &m_points[candidates[i + PREFETCH_DISTANCE]]);
+        }
+
+        const size_t pointIndex = candidates[i];
+        const double rSquared = (m_points[pointIndex] - origin).LengthSquared();
+
+        if (rSquared <= queryRadiusSquared)
+        {
+            callback(pointIndex, m_points[pointIndex]);
+        }
+    }
+}
+
+template <typename Value, typename Function>
+Value PointHashGridSearcher3::AccumulateNearbyPoints(const Vector3D& origin,
+                                                     double radius,
+                                                     const Value& initialValue,
+                                                     Function function) const
+{
+    Value accumulated = initialValue;
+
+    ForEachNearbyPoint(origin, radius,
+                       [&](size_t pointIndex, const Vector3D& point) {
+                           accumulated =
+                               function(accumulated, pointIndex, point);
+                       });
+
+    return accumulated;
+}
 }  // namespace CubbyFlow
 
 #endif
\ No newline at end of file
@@ -11,7 +11,7 @@
 #ifndef CUBBYFLOW_POINT_KDTREE_SEARCHER3_HPP
 #define CUBBYFLOW_POINT_KDTREE_SEARCHER3_HPP
 
-#include <Core/Geometry/KdTree.hpp>
+#include <Core/Geometry/CompactPointKdTree3.hpp>
 #include <Core/Searcher/PointNeighborSearcher3.hpp>
 
 namespace CubbyFlow
@@ -19,8 +19,10 @@ namespace CubbyFlow
 //!
 //! \brief KdTree-based 3-D point searcher.
 //!
-//! This class implements 3-D point searcher by using KdTree for its internal
-//! acceleration data structure.
+//! This class implements 3-D point searcher by using a compact k-d tree for
+//! its internal acceleration data structure. The tree keeps leaf points
+//! packed contiguously, which speeds up the fixed-radius queries issued by
+//! the SPH kernels.
 //!
 class PointKdTreeSearcher3 final : public PointNeighborSearcher3
 {
@@ -91,11 +93,18 @@ class PointKdTreeSearcher3 final : public PointNeighborSearcher3
     //! Deserializes the neighbor searcher from the buffer.
     void Deserialize(const std::vector<uint8_t>& buffer) override;
 
+    //! Returns the type name for memory accounting.
+    [[nodiscard]] const char* GetMemoryStatsName() const override;
+
+    //! Reports the bytes held by the search structure.
+    void ReportMemoryUsage(
+        std::vector<MemoryUsageRecord>* records) const override;
+
     //! Returns builder fox PointKdTreeSearcher3.
     [[nodiscard]] static Builder GetBuilder();
 
  private:
-    KdTree<double, 3> m_tree;
+    CompactPointKdTree3 m_tree;
 };
 
 //! Shared pointer for the PointKdTreeSearcher3 type.
@@ -11,6 +11,7 @@
 #ifndef CUBBYFLOW_POINT_NEIGHBOR_SEARCHER3_HPP
 #define CUBBYFLOW_POINT_NEIGHBOR_SEARCHER3_HPP
 
+#include <Core/Utils/MemoryStats.hpp>
 #include <Core/Utils/Serialization.hpp>
 #include <Core/Vector/Vector3.hpp>
 
@@ -28,7 +29,7 @@ namespace CubbyFlow
 //! Once built, the data structure is used to search nearby points for given
 //! origin point.
 //!
-class PointNeighborSearcher3 : public Serializable
+class PointNeighborSearcher3 : public Serializable, public MemoryStats
 {
  public:
     //! Callback function for nearby search query. The first parameter is the
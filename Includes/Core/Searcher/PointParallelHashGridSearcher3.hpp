@@ -84,6 +84,36 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3
     //!
     void Build(const ConstArrayAccessor1<Vector3D>& points) override;
 
+    //!
+    //! \brief Incrementally updates the acceleration structure.
+    //!
+    //! This function refreshes the stored point positions and re-bins only
+    //! the points whose hash grid bucket changed since the last Build or
+    //! Update call, keeping the sorted arrays and index tables valid. When
+    //! displacements are small relative to the grid spacing, most points stay
+    //! in their bucket and this is much cheaper than a full rebuild. The
+    //! function falls back to Build when the number of points changed or too
+    //! many points moved to another bucket.
+    //!
+    //! \param[in]  points The points to be updated.
+    //!
+    void Update(const ConstArrayAccessor1<Vector3D>& points);
+
+    //!
+    //! \brief Rebuilds the acceleration structure with a new grid spacing.
+    //!
+    //! Equivalent to retargeting the grid spacing and calling Build, but on
+    //! the live instance, so the bucket tables, key arrays, and sorted
+    //! indices keep their allocations when the point count is stable.
+    //! Intended for per-substep rebuilds where the searcher is pooled
+    //! across frames instead of reconstructed.
+    //!
+    //! \param[in]  points      The points to be added.
+    //! \param[in]  gridSpacing The grid spacing.
+    //!
+    void Rebuild(const ConstArrayAccessor1<Vector3D>& points,
+                 double gridSpacing);
+
     //!
     //! Invokes the callback function for each nearby point around the origin
     //! within given radius.
@@ -96,6 +126,40 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3
         const Vector3D& origin, double radius,
         const ForEachNearbyPointFunc& callback) const override;
 
+    //!
+    //! \brief Template overload of ForEachNearbyPoint without type erasure.
+    //!
+    //! The callback is invoked directly instead of through a std::function,
+    //! so the compiler can inline it into the bucket scan. Prefer this
+    //! overload in inner loops that issue one query per particle.
+    //!
+    //! \param[in]  origin   The origin position.
+    //! \param[in]  radius   The search radius.
+    //! \param[in]  callback The callback function.
+    //!
+    template <typename Callback>
+    void ForEachNearbyPoint(const Vector3D& origin, double radius,
+                            const Callback& callback) const;
+
+    //!
+    //! \brief Accumulates a value over the nearby points.
+    //!
+    //! Fused query-and-reduce variant: \p function is invoked as
+    //! function(accumulated, pointIndex, pointPosition) for every point
+    //! within \p radius, and its return value becomes the new accumulated
+    //! value. Returns the final accumulation, starting from \p initialValue.
+    //!
+    //! \param[in]  origin       The origin position.
+    //! \param[in]  radius       The search radius.
+    //! \param[in]  initialValue The initial accumulator value.
+    //! \param[in]  function     The reduction function.
+    //!
+    template <typename Value, typename Function>
+    [[nodiscard]] Value AccumulateNearbyPoints(const Vector3D& origin,
+                                               double radius,
+                                               const Value& initialValue,
+                                               Function function) const;
+
     //!
     //! Returns true if there are any nearby points for given origin within
     //! radius.
@@ -199,6 +263,13 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3
     //!
     [[nodiscard]] Point3I GetBucketIndex(const Vector3D& position) const;
 
+    //!
+    //! Returns the grid spacing of the hash grid.
+    //!
+    //! \return     The grid spacing.
+    //!
+    [[nodiscard]] double GridSpacing() const;
+
     //!
     //! \brief      Creates a new instance of the object with same properties
     //!             than original.
@@ -216,6 +287,13 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3
     //! Deserializes the neighbor searcher from the buffer.
     void Deserialize(const std::vector<uint8_t>& buffer) override;
 
+    //! Returns the type name for memory accounting.
+    [[nodiscard]] const char* GetMemoryStatsName() const override;
+
+    //! Reports the bytes held by the search structure.
+    void ReportMemoryUsage(
+        std::vector<MemoryUsageRecord>* records) const override;
+
     //! Returns builder fox PointParallelHashGridSearcher3.
     [[nodiscard]] static Builder GetBuilder();
 
@@ -224,6 +302,8 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3
 
     void GetNearbyKeys(const Vector3D& position, size_t* nearbyKeys) const;
 
+    void RebuildStartEndTables();
+
     double m_gridSpacing = 1.0;
     Point3I m_resolution = Point3I{ 1, 1, 1 };
     std::vector<Vector3D> m_points;
@@ -231,6 +311,10 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3
     std::vector<size_t> m_startIndexTable;
     std::vector<size_t> m_endIndexTable;
     std::vector<size_t> m_sortedIndices;
+
+    //! Scratch buffer for Build, kept across calls so per-substep rebuilds
+    //! do not hand the unsorted key storage back to the allocator.
+    std::vector<size_t> m_tempKeys;
 };
 
 //! Shared pointer for the PointParallelHashGridSearcher3 type.
@@ -265,6 +349,54 @@ class PointParallelHashGridSearcher3::Builder final
     Size3 m_resolution{ 64, 64, 64 };
     double m_gridSpacing = 1.0;
 };
+
+template <typename Callback>
+void PointParallelHashGridSearcher3::ForEachNearbyPoint(
+    const Vector3D& origin, double radius, const Callback& callback) const
+{
+    size_t nearbyKeys[8];
+    GetNearbyKeys(origin, nearbyKeys);
+
+    const double queryRadiusSquared = radius * radius;
+
+    for (const auto& key : nearbyKeys)
+    {
+        const size_t start = m_startIndexTable[key];
+        const size_t end = m_endIndexTable[key];
+
+        // Empty bucket -- continue to next bucket
+        if (start == std::numeric_limits<size_t>::max())
+        {
+            continue;
+        }
+
+        for (size_t j = start; j < end; ++j)
+        {
+            const Vector3D direction = m_points[j] - origin;
+            const double distanceSquared = direction.LengthSquared();
+            if (distanceSquared <= queryRadiusSquared)
+            {
+                callback(m_sortedIndices[j], m_points[j]);
+            }
+        }
+    }
+}
+
+template <typename Value, typename Function>
+Value PointParallelHashGridSearcher3::AccumulateNearbyPoints(
+    const Vector3D& origin, double radius, const Value& initialValue,
+    Function function) const
+{
+    Value accumulated = initialValue;
+
+    ForEachNearbyPoint(origin, radius,
+                       [&](size_t pointIndex, const Vector3D& point) {
+                           accumulated =
+                               function(accumulated, pointIndex, point);
+                       });
+
+    return accumulated;
+}
 }  // namespace CubbyFlow
 
 #endif
\ No newline at end of file
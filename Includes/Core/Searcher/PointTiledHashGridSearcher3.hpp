@@ -0,0 +1,215 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_POINT_TILED_HASH_GRID_SEARCHER3_HPP
+#define CUBBYFLOW_POINT_TILED_HASH_GRID_SEARCHER3_HPP
+
+#include <Core/Geometry/Point3.hpp>
+#include <Core/Searcher/PointNeighborSearcher3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Two-level tiled hash grid-based 3-D point searcher.
+//!
+//! This class implements a 3-D point searcher whose domain is unbounded.
+//! Cells are grouped into 4x4x4 tiles; only tiles that actually contain
+//! points are stored, keyed by a packed 32-bit tile coordinate in an
+//! open-addressing hash table, and each stored tile keeps its cell buckets
+//! densely in CSR form. Unlike PointHashGridSearcher3 there is no
+//! resolution-sized bucket table, so memory scales with the number of
+//! occupied tiles rather than the domain extent, which keeps large sparse
+//! scenes with localized particles cache-resident. The grid spacing must be
+//! 2x or greater than the search radius. Distant tiles whose packed keys
+//! alias share a bucket; the query-time radius test filters their points, so
+//! aliasing only costs extra distance checks.
+//!
+class PointTiledHashGridSearcher3 final : public PointNeighborSearcher3
+{
+ public:
+    CUBBYFLOW_NEIGHBOR_SEARCHER3_TYPE_NAME(PointTiledHashGridSearcher3)
+
+    class Builder;
+
+    //!
+    //! \brief      Constructs tiled hash grid with given grid spacing.
+    //!
+    //! The grid spacing must be 2x or greater than the search radius.
+    //!
+    //! \param[in]  gridSpacing The grid spacing.
+    //!
+    explicit PointTiledHashGridSearcher3(double gridSpacing);
+
+    //! Copy constructor.
+    PointTiledHashGridSearcher3(const PointTiledHashGridSearcher3& other);
+
+    //! Default move constructor.
+    PointTiledHashGridSearcher3(PointTiledHashGridSearcher3&&) noexcept =
+        default;
+
+    //! Default virtual destructor.
+    ~PointTiledHashGridSearcher3() override = default;
+
+    //! Copy assignment operator.
+    PointTiledHashGridSearcher3& operator=(
+        const PointTiledHashGridSearcher3& other);
+
+    //! Default move assignment operator.
+    PointTiledHashGridSearcher3& operator=(PointTiledHashGridSearcher3&&) =
+        default;
+
+    //! Builds internal acceleration structure for given points list.
+    void Build(const ConstArrayAccessor1<Vector3D>& points) override;
+
+    //!
+    //! Invokes the callback function for each nearby point around the origin
+    //! within given radius.
+    //!
+    //! \param[in]  origin   The origin position.
+    //! \param[in]  radius   The search radius.
+    //! \param[in]  callback The callback function.
+    //!
+    void ForEachNearbyPoint(
+        const Vector3D& origin, double radius,
+        const ForEachNearbyPointFunc& callback) const override;
+
+    //!
+    //! Returns true if there are any nearby points for given origin within
+    //! radius.
+    //!
+    //! \param[in]  origin The origin.
+    //! \param[in]  radius The radius.
+    //!
+    //! \return     True if has nearby point, false otherwise.
+    //!
+    [[nodiscard]] bool HasNearbyPoint(const Vector3D& origin,
+                                      double radius) const override;
+
+    //! Returns the number of occupied tiles.
+    [[nodiscard]] size_t GetNumberOfTiles() const;
+
+    //!
+    //! Returns the packed 32-bit tile key for given cell index.
+    //!
+    //! \param[in]  cellIndex The cell index.
+    //!
+    //! \return     The packed tile key.
+    //!
+    [[nodiscard]] static uint32_t GetTileKeyFromCellIndex(
+        const Point3I& cellIndex);
+
+    //!
+    //! Gets the cell index from a point.
+    //!
+    //! \param[in]  position The position of the point.
+    //!
+    //! \return     The cell index.
+    //!
+    [[nodiscard]] Point3I GetCellIndex(const Vector3D& position) const;
+
+    //!
+    //! \brief      Creates a new instance of the object with same properties
+    //!             than original.
+    //!
+    //! \return     Copy of this object.
+    //!
+    [[nodiscard]] PointNeighborSearcher3Ptr Clone() const override;
+
+    //! Copy from the other instance.
+    void Set(const PointTiledHashGridSearcher3& other);
+
+    //! Serializes the neighbor searcher into the buffer.
+    void Serialize(std::vector<uint8_t>* buffer) const override;
+
+    //! Deserializes the neighbor searcher from the buffer.
+    void Deserialize(const std::vector<uint8_t>& buffer) override;
+
+    //! Returns the type name for memory accounting.
+    [[nodiscard]] const char* GetMemoryStatsName() const override;
+
+    //! Reports the bytes held by the search structure.
+    void ReportMemoryUsage(
+        std::vector<MemoryUsageRecord>* records) const override;
+
+    //! Returns builder fox PointTiledHashGridSearcher3.
+    [[nodiscard]] static Builder GetBuilder();
+
+ private:
+    //! Cells per tile side; a tile holds TILE_SIZE^3 cell buckets.
+    static constexpr ssize_t TILE_SIZE = 4;
+
+    //! Number of cell buckets per tile.
+    static constexpr size_t CELLS_PER_TILE = 64;
+
+    //! Sentinel key marking an empty hash table slot. Packed keys use only
+    //! the lower 30 bits, so this value can never collide with one.
+    static constexpr uint32_t EMPTY_KEY = 0xFFFFFFFF;
+
+    //! Returns the index of the tile with given key, or the number of tiles
+    //! if no such tile is stored.
+    [[nodiscard]] size_t FindTile(uint32_t key) const;
+
+    //! Returns the intra-tile cell bucket index (0..63) for given cell index.
+    [[nodiscard]] static size_t GetIntraTileIndex(const Point3I& cellIndex);
+
+    template <typename Visitor>
+    void ForEachCandidate(const Vector3D& origin, double radius,
+                          const Visitor& visitor) const;
+
+    double m_gridSpacing = 1.0;
+    std::vector<Vector3D> m_points;
+
+    //! Open-addressing hash table over occupied tiles; power-of-two sized.
+    std::vector<uint32_t> m_tableKeys;
+    std::vector<uint32_t> m_tableTileIndices;
+
+    //! CSR cell buckets: entries [tile * 64 + cell] and [tile * 64 + cell
+    //! + 1] of m_cellOffsets bound the point indices of that cell in
+    //! m_sortedIndices.
+    std::vector<size_t> m_cellOffsets;
+    std::vector<size_t> m_sortedIndices;
+
+    size_t m_numberOfTiles = 0;
+};
+
+//! Shared pointer for the PointTiledHashGridSearcher3 type.
+using PointTiledHashGridSearcher3Ptr =
+    std::shared_ptr<PointTiledHashGridSearcher3>;
+
+//!
+//! \brief Front-end to create PointTiledHashGridSearcher3 objects step by
+//!        step.
+//!
+class PointTiledHashGridSearcher3::Builder final
+    : public PointNeighborSearcherBuilder3
+{
+ public:
+    //! Returns builder with grid spacing.
+    [[nodiscard]] Builder& WithGridSpacing(double gridSpacing);
+
+    //! Builds PointTiledHashGridSearcher3 instance.
+    [[nodiscard]] PointTiledHashGridSearcher3 Build() const;
+
+    //! Builds shared pointer of PointTiledHashGridSearcher3 instance.
+    [[nodiscard]] PointTiledHashGridSearcher3Ptr MakeShared() const;
+
+    //! Returns shared pointer of PointNeighborSearcher3 type.
+    [[nodiscard]] PointNeighborSearcher3Ptr BuildPointNeighborSearcher()
+        const override;
+
+ private:
+    double m_gridSpacing = 1.0;
+};
+}  // namespace CubbyFlow
+
+#endif
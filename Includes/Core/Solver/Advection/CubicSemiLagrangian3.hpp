@@ -32,6 +32,17 @@ class CubicSemiLagrangian3 final : public SemiLagrangian3
     [[nodiscard]] std::function<double(const Vector3D&)> GetScalarSamplerFunc(
         const ScalarGrid3& source) const override;
 
+    //!
+    //! \brief Returns batched spatial interpolation function object for given
+    //! scalar grid.
+    //!
+    //! This function overrides the linear batch sampler with a per-point loop
+    //! over the cubic sampler.
+    //!
+    [[nodiscard]] std::function<void(const ConstArrayAccessor1<Vector3D>&,
+                                     ArrayAccessor1<double>)>
+    GetScalarBatchSamplerFunc(const ScalarGrid3& source) const override;
+
     //!
     //! \brief Returns spatial interpolation function object for given
     //! collocated vector grid.
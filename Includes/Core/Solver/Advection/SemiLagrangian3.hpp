@@ -69,7 +69,7 @@ class SemiLagrangian3 : public AdvectionSolver3
     void Advect(const ScalarGrid3& input, const VectorField3& flow, double dt,
                 ScalarGrid3* output,
                 const ScalarField3& boundarySDF = ConstantScalarField3(
-                    std::numeric_limits<double>::max())) final;
+                    std::numeric_limits<double>::max())) override;
 
     //!
     //! \brief Computes semi-Lagrangian for given collocated vector grid.
@@ -93,7 +93,7 @@ class SemiLagrangian3 : public AdvectionSolver3
     void Advect(const CollocatedVectorGrid3& input, const VectorField3& flow,
                 double dt, CollocatedVectorGrid3* output,
                 const ScalarField3& boundarySDF = ConstantScalarField3(
-                    std::numeric_limits<double>::max())) final;
+                    std::numeric_limits<double>::max())) override;
 
     //!
     //! \brief Computes semi-Lagrangian for given face-centered vector grid.
@@ -117,7 +117,7 @@ class SemiLagrangian3 : public AdvectionSolver3
     void Advect(const FaceCenteredGrid3& input, const VectorField3& flow,
                 double dt, FaceCenteredGrid3* output,
                 const ScalarField3& boundarySDF = ConstantScalarField3(
-                    std::numeric_limits<double>::max())) final;
+                    std::numeric_limits<double>::max())) override;
 
  protected:
     //!
@@ -132,6 +132,21 @@ class SemiLagrangian3 : public AdvectionSolver3
     [[nodiscard]] virtual std::function<double(const Vector3D&)>
     GetScalarSamplerFunc(const ScalarGrid3& input) const;
 
+    //!
+    //! \brief Returns batched spatial interpolation function object for given
+    //! scalar grid.
+    //!
+    //! The returned function samples \p input at every position of the given
+    //! point array and stores the results in the output array. By default, it
+    //! forwards to LinearArraySampler3::Sample, which interpolates the whole
+    //! batch in one tight loop instead of dispatching through a per-sample
+    //! std::function. Override this function together with
+    //! GetScalarSamplerFunc when changing the interpolation order.
+    //!
+    [[nodiscard]] virtual std::function<void(
+        const ConstArrayAccessor1<Vector3D>&, ArrayAccessor1<double>)>
+    GetScalarBatchSamplerFunc(const ScalarGrid3& input) const;
+
     //!
     //! \brief Returns spatial interpolation function object for given
     //! collocated vector grid.
@@ -156,7 +171,15 @@ class SemiLagrangian3 : public AdvectionSolver3
     [[nodiscard]] virtual std::function<Vector3D(const Vector3D&)>
     GetVectorSamplerFunc(const FaceCenteredGrid3& input) const;
 
- private:
+    //!
+    //! \brief Back-traces \p startPt through \p flow for time-step \p dt.
+    //!
+    //! Uses the 2nd-order mid-point rule with adaptive sub-stepping so each
+    //! sub-step stays within one grid cell of size \p h, and projects the
+    //! trace onto the boundary interface when it crosses \p boundarySDF.
+    //! Exposed to inheriting classes so multi-pass schemes (e.g. MacCormack)
+    //! can reuse the exact trace of the base advection passes.
+    //!
     [[nodiscard]] Vector3D BackTrace(const VectorField3& flow, double dt,
                                      double h, const Vector3D& startPt,
                                      const ScalarField3& boundarySDF) const;
@@ -29,6 +29,16 @@ class FDMCGSolver3 final : public FDMLinearSystemSolver3
     //! Solves the given compressed linear system.
     bool SolveCompressed(FDMCompressedLinearSystem3* system) override;
 
+    //!
+    //! \brief Solves the linear system given as matrix-free operator \p op.
+    //!
+    //! Instead of an assembled matrix, \p op evaluates the product of the
+    //! system matrix and a vector on the fly, which skips both the assembly
+    //! pass and the matrix storage.
+    //!
+    bool SolveMatrixFree(const FDMMatrixFreeOperator3& op, const FDMVector3& b,
+                         FDMVector3* x);
+
     //! Returns the max number of Jacobi iterations.
     [[nodiscard]] unsigned int GetMaxNumberOfIterations() const;
 
@@ -38,12 +48,65 @@ class FDMCGSolver3 final : public FDMLinearSystemSolver3
     //! Returns the max residual tolerance for the Jacobi method.
     [[nodiscard]] double GetTolerance() const;
 
+    //! Sets the max residual tolerance; adaptive callers (e.g. the pressure
+    //! solver's divergence controller) retune this between solves.
+    void SetTolerance(double tolerance);
+
     //! Returns the last residual after the Jacobi iterations.
     [[nodiscard]] double GetLastResidual() const;
 
+    //! Returns the relative residual tolerance, or zero if disabled.
+    [[nodiscard]] double GetRelativeTolerance() const;
+
+    //!
+    //! \brief Sets the relative residual tolerance.
+    //!
+    //! When set to a positive value, the iterations also stop once the
+    //! residual norm drops below the given fraction of the right-hand side
+    //! norm, whichever of the absolute and relative criteria is looser.
+    //! Zero (the default) keeps the absolute tolerance only.
+    //!
+    void SetRelativeTolerance(double relativeTolerance);
+
+    //! Returns true if the solver starts from the content of the solution
+    //! vector instead of zero.
+    [[nodiscard]] bool GetUseInitialGuess() const;
+
+    //!
+    //! \brief Enables (or disables) warm starting from an initial guess.
+    //!
+    //! When enabled, the solver keeps the incoming solution vector as the
+    //! starting point of the iterations instead of clearing it. The caller
+    //! is responsible for seeding the vector with a sensible guess such as
+    //! the solution of the previous time step.
+    //!
+    void SetUseInitialGuess(bool useInitialGuess);
+
+    //! Returns true if the solver iterates in single precision.
+    [[nodiscard]] bool GetUseSinglePrecision() const;
+
+    //!
+    //! \brief Enables (or disables) the mixed-precision solve.
+    //!
+    //! When enabled, Solve copies the system into single-precision storage
+    //! and runs the conjugate gradient iterations on it, halving the memory
+    //! traffic of the bandwidth-bound sweeps. Dot products and norms still
+    //! accumulate in double precision, and the solution is written back to
+    //! the double-precision system. Tolerances tighter than what single
+    //! precision can represent (around 1e-7 relative) will not converge, so
+    //! pair this mode with a relative tolerance. The compressed and
+    //! matrix-free paths are unaffected.
+    //!
+    void SetUseSinglePrecision(bool useSinglePrecision);
+
  private:
+    bool SolveSinglePrecision(FDMLinearSystem3* system);
+
     void ClearUncompressedVectors();
     void ClearCompressedVectors();
+    void ClearSinglePrecisionVectors();
+
+    [[nodiscard]] double EffectiveTolerance(double bNorm) const;
 
     // Uncompressed vectors
     FDMVector3 m_r;
@@ -57,10 +120,22 @@ class FDMCGSolver3 final : public FDMLinearSystemSolver3
     VectorND m_qComp;
     VectorND m_sComp;
 
+    // Single-precision copies of the system and scratch vectors
+    FDMMatrix3F m_matF;
+    FDMVector3F m_xF;
+    FDMVector3F m_bF;
+    FDMVector3F m_rF;
+    FDMVector3F m_dF;
+    FDMVector3F m_qF;
+    FDMVector3F m_sF;
+
     unsigned int m_maxNumberOfIterations;
     unsigned int m_lastNumberOfIterations;
     double m_tolerance;
+    double m_relativeTolerance = 0.0;
     double m_lastResidual;
+    bool m_useInitialGuess = false;
+    bool m_useSinglePrecision = false;
 };
 
 //! Shared pointer type for the FDMCGSolver3.
@@ -0,0 +1,67 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_FDM_CALLBACK_SOLVER3_HPP
+#define CUBBYFLOW_FDM_CALLBACK_SOLVER3_HPP
+
+#include <Core/Solver/FDM/FDMLinearSystemSolver3.hpp>
+
+namespace CubbyFlow
+{
+//! Function solving an assembled 3-D finite difference-type linear system.
+//! Returns true on success.
+using FDMSystemSolverFunction3 = std::function<bool(FDMLinearSystem3*)>;
+
+//! Function solving a compressed 3-D finite difference-type linear system.
+//! Returns true on success.
+using FDMCompressedSystemSolverFunction3 =
+    std::function<bool(FDMCompressedLinearSystem3*)>;
+
+//!
+//! \brief 3-D finite difference-type linear system solver backed by a
+//! user-provided function.
+//!
+//! This adapter lets an external solver sit behind the
+//! FDMLinearSystemSolver3 interface without linking it into the core
+//! library. A typical use is offloading the pressure solve to an
+//! accelerator: the registered function uploads the assembled 7-point
+//! system (or its compressed form), runs the device solver, and writes
+//! only the solution vector back into the system before returning. The
+//! rest of the engine stays unchanged — the adapter is handed to, e.g.,
+//! GridFractionalSinglePhasePressureSolver3::SetLinearSystemSolver like
+//! any built-in solver.
+//!
+class FDMCallbackSolver3 final : public FDMLinearSystemSolver3
+{
+ public:
+    //! Constructs a solver delegating to the given functions. The
+    //! compressed-system function may be null, in which case
+    //! SolveCompressed reports failure like the base class.
+    explicit FDMCallbackSolver3(
+        FDMSystemSolverFunction3 solveFunction,
+        FDMCompressedSystemSolverFunction3 solveCompressedFunction = nullptr);
+
+    //! Solves the given linear system with the registered function.
+    bool Solve(FDMLinearSystem3* system) override;
+
+    //! Solves the given compressed linear system with the registered
+    //! function, if any.
+    bool SolveCompressed(FDMCompressedLinearSystem3* system) override;
+
+ private:
+    FDMSystemSolverFunction3 m_solveFunction;
+    FDMCompressedSystemSolverFunction3 m_solveCompressedFunction;
+};
+
+//! Shared pointer type for the FDMCallbackSolver3.
+using FDMCallbackSolver3Ptr = std::shared_ptr<FDMCallbackSolver3>;
+}  // namespace CubbyFlow
+
+#endif
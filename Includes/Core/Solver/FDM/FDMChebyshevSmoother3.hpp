@@ -0,0 +1,46 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_FDM_CHEBYSHEV_SMOOTHER3_HPP
+#define CUBBYFLOW_FDM_CHEBYSHEV_SMOOTHER3_HPP
+
+#include <Core/FDM/FDMLinearSystem3.hpp>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Jacobi-preconditioned Chebyshev polynomial smoother for 3-D FDM
+//! systems.
+//!
+//! Unlike Gauss-Seidel, the Chebyshev recurrence has no inter-iteration data
+//! dependencies within a sweep: every pass is an element-wise update driven
+//! by a Jacobi-preconditioned residual, so it parallelizes and vectorizes
+//! freely. It is intended as a Multigrid relaxer, where only the rough upper
+//! part of the spectrum needs damping.
+//!
+class FDMChebyshevSmoother3
+{
+ public:
+    //!
+    //! \brief Performs \p numberOfIterations Chebyshev relaxation steps on
+    //! Ax = b.
+    //!
+    //! The polynomial is built for the Jacobi-preconditioned spectrum, which
+    //! lies in [0, 2] for the weakly diagonally dominant matrices the FDM
+    //! assembly produces, so no eigenvalue estimation pass is needed.
+    //! \p z and \p d are scratch vectors of the same size as \p x.
+    //!
+    static void Relax(const FDMMatrix3& A, const FDMVector3& b,
+                      unsigned int numberOfIterations, FDMVector3* x,
+                      FDMVector3* z, FDMVector3* d);
+};
+}  // namespace CubbyFlow
+
+#endif
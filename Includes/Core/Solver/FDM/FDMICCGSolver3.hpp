@@ -40,9 +40,55 @@ class FDMICCGSolver3 final : public FDMLinearSystemSolver3
     //! Returns the max residual tolerance for the Jacobi method.
     [[nodiscard]] double GetTolerance() const;
 
+    //! Sets the max residual tolerance; adaptive callers (e.g. the pressure
+    //! solver's divergence controller) retune this between solves.
+    void SetTolerance(double tolerance);
+
     //! Returns the last residual after the Jacobi iterations.
     [[nodiscard]] double GetLastResidual() const;
 
+    //! Returns the relative residual tolerance, or zero if disabled.
+    [[nodiscard]] double GetRelativeTolerance() const;
+
+    //!
+    //! \brief Sets the relative residual tolerance.
+    //!
+    //! When set to a positive value, the iterations also stop once the
+    //! residual norm drops below the given fraction of the right-hand side
+    //! norm, whichever of the absolute and relative criteria is looser.
+    //! Zero (the default) keeps the absolute tolerance only.
+    //!
+    void SetRelativeTolerance(double relativeTolerance);
+
+    //! Returns true if the solver starts from the content of the solution
+    //! vector instead of zero.
+    [[nodiscard]] bool GetUseInitialGuess() const;
+
+    //!
+    //! \brief Enables (or disables) warm starting from an initial guess.
+    //!
+    //! When enabled, the solver keeps the incoming solution vector as the
+    //! starting point of the iterations instead of clearing it. The caller
+    //! is responsible for seeding the vector with a sensible guess such as
+    //! the solution of the previous time step.
+    //!
+    void SetUseInitialGuess(bool useInitialGuess);
+
+    //! Returns true if the solver reuses the last incomplete Cholesky
+    //! factorization instead of rebuilding it every solve.
+    [[nodiscard]] bool GetReusePreconditioner() const;
+
+    //!
+    //! \brief Enables (or disables) reusing the IC factorization.
+    //!
+    //! When enabled, a solve keeps the factorization built by the previous
+    //! solve as long as the system size is unchanged. The caller is
+    //! responsible for only enabling this while the matrix coefficients are
+    //! actually identical, e.g. across substeps with a constant time step
+    //! and unchanged boundaries.
+    //!
+    void SetReusePreconditioner(bool reusePreconditioner);
+
  private:
     struct Preconditioner final
     {
@@ -83,10 +129,15 @@ class FDMICCGSolver3 final : public FDMLinearSystemSolver3
     VectorND m_sComp;
     PreconditionerCompressed m_precondComp;
 
+    [[nodiscard]] double EffectiveTolerance(double bNorm) const;
+
     unsigned int m_maxNumberOfIterations;
     unsigned int m_lastNumberOfIterations;
     double m_tolerance;
+    double m_relativeTolerance = 0.0;
     double m_lastResidualNorm;
+    bool m_useInitialGuess = false;
+    bool m_reusePreconditioner = false;
 };
 
 //! Shared pointer type for the FDMICCGSolver3.
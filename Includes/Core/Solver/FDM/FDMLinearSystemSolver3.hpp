@@ -11,10 +11,44 @@
 #ifndef CUBBYFLOW_FDM_LINEAR_SYSTEM_SOLVER3_HPP
 #define CUBBYFLOW_FDM_LINEAR_SYSTEM_SOLVER3_HPP
 
+#include <Core/Array/Array1.hpp>
 #include <Core/FDM/FDMLinearSystem3.hpp>
+#include <Core/Math/CG.hpp>
+#include <Core/Utils/Timer.hpp>
+
+#include <functional>
 
 namespace CubbyFlow
 {
+//!
+//! \brief Per-solve metrics of a 3-D finite difference-type linear system
+//! solver.
+//!
+//! The metrics are collected only while a callback is registered on the
+//! solver, so the default solve path stays untimed.
+//!
+struct FDMSolverMetrics3
+{
+    //! Monitored residual norm after each iteration.
+    Array1<double> residualHistory;
+
+    //! Wall time spent in matrix-vector products.
+    double spmvTimeInSeconds = 0.0;
+
+    //! Wall time spent in preconditioner builds and solves.
+    double preconditionerTimeInSeconds = 0.0;
+
+    //! Wall time spent in vector-vector sweeps.
+    double blas1TimeInSeconds = 0.0;
+
+    //! Wall time of the whole solve call.
+    double totalTimeInSeconds = 0.0;
+};
+
+//! Callback invoked with the metrics of a finished solve.
+using FDMSolverMetricsCallback3 =
+    std::function<void(const FDMSolverMetrics3&)>;
+
 //! Abstract base class for 3-D finite difference-type linear system solver.
 class FDMLinearSystemSolver3
 {
@@ -46,6 +80,54 @@ class FDMLinearSystemSolver3
     {
         return false;
     }
+
+    //!
+    //! \brief Registers a callback invoked with the metrics of each solve.
+    //!
+    //! While a callback is registered, instrumented solvers record the
+    //! per-iteration residual history and the wall time per phase and hand
+    //! the result to the callback when the solve returns. Passing a null
+    //! callback unregisters it and disables the collection.
+    //!
+    void SetMetricsCallback(const FDMSolverMetricsCallback3& callback);
+
+    //! Returns the metrics of the last instrumented solve.
+    [[nodiscard]] const FDMSolverMetrics3& GetLastMetrics() const;
+
+ protected:
+    //!
+    //! \brief Starts a metrics collection pass.
+    //!
+    //! Returns the observer to pass to CG or PCG, or null when no callback
+    //! is registered. Instrumented solvers call this at the top of Solve and
+    //! EndMetricsCollection before returning.
+    //!
+    [[nodiscard]] CGMetricsObserver* BeginMetricsCollection();
+
+    //! Stamps the total solve time and invokes the registered callback.
+    void EndMetricsCollection();
+
+ private:
+    //! CG observer accumulating into the solver metrics.
+    class MetricsCollector final : public CGMetricsObserver
+    {
+     public:
+        explicit MetricsCollector(FDMSolverMetrics3* metrics);
+
+        void OnIteration(unsigned int iteration,
+                         double residualNorm) override;
+
+        void OnPhaseTime(CGPhase phase, double seconds) override;
+
+     private:
+        FDMSolverMetrics3* m_metrics;
+    };
+
+    FDMSolverMetrics3 m_metrics;
+    MetricsCollector m_metricsCollector{ &m_metrics };
+    FDMSolverMetricsCallback3 m_metricsCallback;
+    Timer m_solveTimer;
+    bool m_isCollectingMetrics = false;
 };
 
 //! Shared pointer type for the FDMLinearSystemSolver3.
@@ -47,6 +47,16 @@ class FDMMGPCGSolver3 final : public FDMMGSolver3
                     double maxTolerance = 1e-9, double sorFactor = 1.5,
                     bool useRedBlackOrdering = false);
 
+    //! Constructs the solver with an explicit smoother choice for the
+    //! Multigrid preconditioner.
+    FDMMGPCGSolver3(unsigned int numberOfCGIter, size_t maxNumberOfLevels,
+                    MGSmootherType smootherType,
+                    unsigned int numberOfRestrictionIter = 5,
+                    unsigned int numberOfCorrectionIter = 5,
+                    unsigned int numberOfCoarsestIter = 20,
+                    unsigned int numberOfFinalIter = 20,
+                    double maxTolerance = 1e-9, double sorFactor = 1.5);
+
     //! Solves the given linear system.
     bool Solve(FDMMGLinearSystem3* system) override;
 
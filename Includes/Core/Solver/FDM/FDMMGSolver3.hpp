@@ -17,6 +17,21 @@
 
 namespace CubbyFlow
 {
+//! Smoother types for the Multigrid relaxation steps.
+enum class MGSmootherType
+{
+    //! Lexicographic Gauss-Seidel/SOR. The sweeps are serial.
+    GaussSeidel,
+
+    //! Red-black ordered Gauss-Seidel/SOR. Each half-sweep is parallel.
+    RedBlackGaussSeidel,
+
+    //! Jacobi-preconditioned Chebyshev polynomial smoother. Every pass is
+    //! element-wise, so it parallelizes and vectorizes where Gauss-Seidel
+    //! cannot. The SOR factor is ignored by this smoother.
+    Chebyshev
+};
+
 //! \brief 3-D finite difference-type linear system solver using Multigrid.
 class FDMMGSolver3 : public FDMLinearSystemSolver3
 {
@@ -30,6 +45,14 @@ class FDMMGSolver3 : public FDMLinearSystemSolver3
                  double maxTolerance = 1e-9, double sorFactor = 1.5,
                  bool useRedBlackOrdering = false);
 
+    //! Constructs the solver with an explicit smoother choice.
+    FDMMGSolver3(size_t maxNumberOfLevels, MGSmootherType smootherType,
+                 unsigned int numberOfRestrictionIter = 5,
+                 unsigned int numberOfCorrectionIter = 5,
+                 unsigned int numberOfCoarsestIter = 20,
+                 unsigned int numberOfFinalIter = 20,
+                 double maxTolerance = 1e-9, double sorFactor = 1.5);
+
     //! Returns the Multigrid parameters.
     [[nodiscard]] const MGParameters<FDMBLAS3>& GetParams() const;
 
@@ -39,6 +62,9 @@ class FDMMGSolver3 : public FDMLinearSystemSolver3
     //! Returns true if red-black ordering is enabled.
     [[nodiscard]] bool GetUseRedBlackOrdering() const;
 
+    //! Returns the smoother type used for the relaxation steps.
+    [[nodiscard]] MGSmootherType GetSmootherType() const;
+
     //! No-op. Multigrid-type solvers do not solve FDMLinearSystem3.
     bool Solve(FDMLinearSystem3* system) final;
 
@@ -49,6 +75,7 @@ class FDMMGSolver3 : public FDMLinearSystemSolver3
     MGParameters<FDMBLAS3> m_mgParams;
     double m_sorFactor;
     bool m_useRedBlackOrdering;
+    MGSmootherType m_smootherType;
 };
 
 //! Shared pointer type for the FDMMGSolver3.
@@ -126,10 +126,24 @@ class GridBackwardEulerDiffusionSolver3 final : public GridDiffusionSolver3
     void BuildVectors(const ConstArrayAccessor3<Vector3D>& f, const Vector3D& c,
                       size_t component);
 
+    //! Returns true if the assembled matrix can be reused for the current
+    //! (size, scaled coefficient, markers) combination, updating the cache
+    //! key otherwise. Must be called after BuildMarkers.
+    [[nodiscard]] bool TryReuseSystem(const Size3& size, const Vector3D& c);
+
+    //! Runs the linear system solver, reusing its preconditioner
+    //! factorization when \p matrixUnchanged says the matrix is identical to
+    //! the previously solved one.
+    void SolveSystem(bool matrixUnchanged);
+
     BoundaryType m_boundaryType;
     FDMLinearSystem3 m_system;
     FDMLinearSystemSolver3Ptr m_systemSolver;
     Array3<char> m_markers;
+    Size3 m_cachedSize;
+    Vector3D m_cachedC;
+    size_t m_cachedMarkerHash = 0;
+    bool m_systemCached = false;
 };
 
 //! Shared pointer type for the GridBackwardEulerDiffusionSolver3.
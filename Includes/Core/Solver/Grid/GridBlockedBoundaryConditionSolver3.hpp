@@ -70,6 +70,7 @@ class GridBlockedBoundaryConditionSolver3 final
 
  private:
     Array3<char> m_marker;
+    size_t m_markerSDFVersion = 0;
 };
 
 //! Shared pointer type for the GridBlockedBoundaryConditionSolver3.
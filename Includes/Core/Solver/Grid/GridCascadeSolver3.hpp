@@ -0,0 +1,110 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_GRID_CASCADE_SOLVER3_HPP
+#define CUBBYFLOW_GRID_CASCADE_SOLVER3_HPP
+
+#include <Core/Animation/Animation.hpp>
+#include <Core/Solver/Grid/GridFluidSolver3.hpp>
+
+namespace CubbyFlow
+{
+//!
+//! \brief 3-D two-grid cascade solver for nested simulation domains.
+//!
+//! This class couples a coarse background solver with a fine solver whose
+//! domain is nested inside the coarse one, e.g. a hero region simulated at
+//! high resolution inside a vast low-resolution ocean. Every frame, the
+//! coarse solver advances first, its velocity field is handed to the fine
+//! solver as the background velocity field, and the fine solver advances
+//! with its boundary band blended toward the coarse flow
+//! (\see GridFluidSolver3::SetBackgroundVelocityField). With two-way
+//! coupling enabled, the fine velocity is also sampled back onto the coarse
+//! faces covered by the fine domain so the background reacts to the nested
+//! flow. Both members can be any GridFluidSolver3 subclass, including
+//! FLIPSolver3; the fine domain must lie inside the coarse domain.
+//!
+class GridCascadeSolver3 final : public Animation
+{
+ public:
+    class Builder;
+
+    //! Constructs a cascade from the given coarse and fine solvers.
+    GridCascadeSolver3(GridFluidSolver3Ptr coarseSolver,
+                       GridFluidSolver3Ptr fineSolver);
+
+    //! Returns the coarse background solver.
+    [[nodiscard]] const GridFluidSolver3Ptr& GetCoarseSolver() const;
+
+    //! Returns the fine nested solver.
+    [[nodiscard]] const GridFluidSolver3Ptr& GetFineSolver() const;
+
+    //! Returns true if the fine velocity feeds back into the coarse grid.
+    [[nodiscard]] bool GetIsTwoWayCouplingEnabled() const;
+
+    //!
+    //! \brief Enables (or disables) two-way coupling.
+    //!
+    //! When enabled, the coarse faces inside the fine domain (shrunk by the
+    //! fine solver's blend band) are overwritten with the fine velocity after
+    //! each frame. One-way coupling is the default.
+    //!
+    void SetIsTwoWayCouplingEnabled(bool isEnabled);
+
+    //! Returns builder fox GridCascadeSolver3.
+    [[nodiscard]] static Builder GetBuilder();
+
+ protected:
+    //! Advances the coarse solver, couples the boundary flow into the fine
+    //! solver, advances the fine solver, and optionally feeds back.
+    void OnUpdate(const Frame& frame) override;
+
+ private:
+    //! Hands the coarse velocity field to the fine solver as background flow.
+    void ApplyCoarseToFine() const;
+
+    //! Samples the fine velocity back onto the covered coarse faces.
+    void ApplyFineToCoarse() const;
+
+    GridFluidSolver3Ptr m_coarseSolver;
+    GridFluidSolver3Ptr m_fineSolver;
+    bool m_isTwoWayCouplingEnabled = false;
+};
+
+//! Shared pointer type for the GridCascadeSolver3.
+using GridCascadeSolver3Ptr = std::shared_ptr<GridCascadeSolver3>;
+
+//!
+//! \brief Front-end to create GridCascadeSolver3 objects step by step.
+//!
+class GridCascadeSolver3::Builder final
+{
+ public:
+    //! Returns builder with coarse background solver.
+    [[nodiscard]] Builder& WithCoarseSolver(
+        const GridFluidSolver3Ptr& coarseSolver);
+
+    //! Returns builder with fine nested solver.
+    [[nodiscard]] Builder& WithFineSolver(const GridFluidSolver3Ptr& fineSolver);
+
+    //! Returns builder with two-way coupling flag.
+    [[nodiscard]] Builder& WithTwoWayCoupling(bool isEnabled);
+
+    //! Builds shared pointer of GridCascadeSolver3 instance.
+    [[nodiscard]] GridCascadeSolver3Ptr MakeShared() const;
+
+ private:
+    GridFluidSolver3Ptr m_coarseSolver;
+    GridFluidSolver3Ptr m_fineSolver;
+    bool m_isTwoWayCouplingEnabled = false;
+};
+}  // namespace CubbyFlow
+
+#endif
@@ -15,9 +15,13 @@
 #include <Core/Emitter/GridEmitter3.hpp>
 #include <Core/Geometry/Collider3.hpp>
 #include <Core/Grid/GridSystemData3.hpp>
+#include <Core/Particle/ParticleSystemData3.hpp>
 #include <Core/Solver/Advection/AdvectionSolver3.hpp>
 #include <Core/Solver/Grid/GridDiffusionSolver3.hpp>
 #include <Core/Solver/Grid/GridPressureSolver3.hpp>
+#include <Core/Utils/ScratchPool.hpp>
+
+#include <future>
 
 namespace CubbyFlow
 {
@@ -82,6 +86,12 @@ class GridFluidSolver3 : public PhysicsAnimation
     //! \brief Returns the CFL number from the current velocity field for given
     //! time interval.
     //!
+    //! The underlying maximum velocity is cached against the data version
+    //! of the velocity grid and only re-read after the field has actually
+    //! been written to, so repeated calls within a substep (time-step
+    //! sizing, logging, reinitialization heuristics) cost a single
+    //! full-grid pass at most.
+    //!
     //! \param[in] timeIntervalInSeconds The time interval in seconds.
     //!
     [[nodiscard]] double GetCFL(double timeIntervalInSeconds) const;
@@ -98,6 +108,38 @@ class GridFluidSolver3 : public PhysicsAnimation
     //! Sets whether the solver should use compressed linear system.
     void SetUseCompressedLinearSystem(bool isOn);
 
+    //! Returns true if the solver is caching the collider SDF.
+    [[nodiscard]] bool GetUseColliderSDFCache() const;
+
+    //!
+    //! \brief Sets whether the solver should cache the collider SDF.
+    //!
+    //! When enabled, the boundary condition solver skips re-rasterizing the
+    //! collider's signed distance field for colliders whose transform did not
+    //! change, re-rasterizes moving colliders only within their dilated
+    //! bounding boxes, and the fractional pressure solver reuses the boundary
+    //! weights derived from the SDF. Colliders whose surface animates without
+    //! changing its transform should keep this cache disabled.
+    //!
+    void SetUseColliderSDFCache(bool isOn);
+
+    //! Returns true if the solver updates the grid emitter asynchronously.
+    [[nodiscard]] bool GetUseAsyncEmitterUpdate() const;
+
+    //!
+    //! \brief Sets whether the grid emitter should update asynchronously.
+    //!
+    //! When enabled, the emitter update is kicked on a worker thread at the
+    //! beginning of each sub-time-step and joined right before the
+    //! solver-specific begin-step stage (particle-to-grid transfer for the
+    //! hybrid solvers, source diffusion for the smoke solver), overlapping
+    //! the emitter's source SDF evaluation with the collider update and the
+    //! boundary condition pass. The emitter must not target the velocity
+    //! field, which the boundary condition pass writes concurrently; keep
+    //! this disabled for such emitters.
+    //!
+    void SetUseAsyncEmitterUpdate(bool isOn);
+
     //! Returns the advection solver instance.
     [[nodiscard]] const AdvectionSolver3Ptr& GetAdvectionSolver() const;
 
@@ -122,6 +164,30 @@ class GridFluidSolver3 : public PhysicsAnimation
     //! Sets the closed domain boundary flag.
     void SetClosedDomainBoundaryFlag(int flag);
 
+    //! Returns the background velocity field, or null if none is set.
+    [[nodiscard]] const VectorField3Ptr& GetBackgroundVelocityField() const;
+
+    //!
+    //! \brief Sets the background velocity field for nested-domain coupling.
+    //!
+    //! When set, every boundary condition pass blends the velocity faces
+    //! within GetBackgroundBlendWidth() cells of the domain boundary toward
+    //! this field. The blend weight ramps from full replacement at the
+    //! outermost faces down to zero at the inner edge of the band, so the
+    //! band carries the surrounding flow into the domain without a hard
+    //! seam. This is the fine-domain half of a two-grid cascade
+    //! (\see GridCascadeSolver3). Pass null to disable.
+    //!
+    //! \param[in] field The new background velocity field.
+    //!
+    void SetBackgroundVelocityField(const VectorField3Ptr& field);
+
+    //! Returns the width of the background blend band in grid cells.
+    [[nodiscard]] unsigned int GetBackgroundBlendWidth() const;
+
+    //! Sets the width of the background blend band in grid cells.
+    void SetBackgroundBlendWidth(unsigned int numCells);
+
     //!
     //! \brief Returns the grid system data.
     //!
@@ -195,6 +261,38 @@ class GridFluidSolver3 : public PhysicsAnimation
     //! Sets the emitter.
     void SetEmitter(const GridEmitter3Ptr& newEmitter);
 
+    //! Returns true if the secondary (whitewater) particle subsystem is
+    //! enabled.
+    [[nodiscard]] bool GetIsSecondaryParticlesEnabled() const;
+
+    //!
+    //! \brief Enables (or disables) the secondary (whitewater) particle
+    //!        subsystem.
+    //!
+    //! When \p isEnabled is true, spray/foam particles are emitted from
+    //! interface cells whose local CFL number or velocity divergence exceeds
+    //! fixed thresholds, and integrated with a ballistic-plus-drag scheme:
+    //! particles inside the liquid are dragged toward the sampled fluid
+    //! velocity, particles in the air fall under gravity with weak air drag.
+    //! The subsystem never feeds back into the pressure solve and performs
+    //! no neighbor search, so millions of secondary particles cost a small
+    //! fraction of a primary sub-step. Solvers without a real fluid SDF
+    //! (GridFluidSolver3::GetFluidSDF) emit nothing.
+    //!
+    void SetIsSecondaryParticlesEnabled(bool isEnabled);
+
+    //! Returns the secondary particles, or null if the subsystem has not run
+    //! yet. Each particle carries a remaining-lifetime scalar channel at
+    //! index 0.
+    [[nodiscard]] ParticleSystemData3Ptr GetSecondaryParticles() const;
+
+    //! Returns the maximum number of secondary particles.
+    [[nodiscard]] size_t GetMaxNumberOfSecondaryParticles() const;
+
+    //! Sets the maximum number of secondary particles. Emission stops while
+    //! the system is at capacity; existing particles keep integrating.
+    void SetMaxNumberOfSecondaryParticles(size_t maxNumber);
+
     //! Returns builder fox GridFluidSolver3.
     [[nodiscard]] static Builder GetBuilder();
 
@@ -205,6 +303,12 @@ class GridFluidSolver3 : public PhysicsAnimation
     //! Called when advancing a single time-step.
     void OnAdvanceTimeStep(double timeIntervalInSeconds) override;
 
+    //! Stores the grid system data into \p checkpoint.
+    void OnSaveCheckpoint(Checkpoint* checkpoint) const override;
+
+    //! Restores the grid system data from \p checkpoint.
+    [[nodiscard]] bool OnLoadCheckpoint(const Checkpoint& checkpoint) override;
+
     //!
     //! \brief Returns the required sub-time-steps for given time interval.
     //!
@@ -213,6 +317,12 @@ class GridFluidSolver3 : public PhysicsAnimation
     //! too large so that it makes the CFL number greater than the max value,
     //! This function will return a number that is greater than 1.
     //!
+    //! When an explicit (forward Euler) diffusion solver is set, the
+    //! diffusion stability limit is also honored. The resulting sub-time-step
+    //! may grow by at most 50% relative to the previous one, so the step size
+    //! contracts immediately on fast transients but expands with hysteresis
+    //! instead of oscillating around the CFL target.
+    //!
     //! \see GridFluidSolver3::GetMaxCFL
     //!
     [[nodiscard]] unsigned int GetNumberOfSubTimeSteps(
@@ -254,6 +364,16 @@ class GridFluidSolver3 : public PhysicsAnimation
     //!
     [[nodiscard]] virtual ScalarField3Ptr GetFluidSDF() const;
 
+    //!
+    //! \brief Returns the boundary SDF used when advecting scalar fields.
+    //!
+    //! This function returns the boundary SDF that limits where the
+    //! advectable scalar data is advected. By default, this is the collider
+    //! SDF; subclasses can narrow it further, e.g. to an active region of
+    //! the domain.
+    //!
+    [[nodiscard]] virtual ScalarField3Ptr GetScalarAdvectionBoundary() const;
+
     //! Computes the gravity term.
     void ComputeGravity(double timeIntervalInSeconds);
 
@@ -289,6 +409,21 @@ class GridFluidSolver3 : public PhysicsAnimation
 
     void UpdateEmitter(double timeIntervalInSeconds) const;
 
+    void UpdateSecondaryParticles(double timeIntervalInSeconds);
+
+    //! Blends the boundary band of the velocity field toward the background
+    //! velocity field.
+    void BlendWithBackgroundVelocity() const;
+
+    //! Recomputes the cached component-wise maxima of the cell-center
+    //! velocity with a tiled parallel reduction.
+    void RefreshMaxVelocityComponents() const;
+
+    //! Returns a scratch copy of \p grid drawn from the given pool.
+    template <typename GridType, typename PoolType>
+    static std::shared_ptr<GridType> AcquireScratchCopy(PoolType& pool,
+                                                        const GridType& grid);
+
     GridSystemData3Ptr m_grids;
     Collider3Ptr m_collider;
     GridEmitter3Ptr m_emitter;
@@ -298,11 +433,46 @@ class GridFluidSolver3 : public PhysicsAnimation
     GridPressureSolver3Ptr m_pressureSolver;
     GridBoundaryConditionSolver3Ptr m_boundaryConditionSolver;
 
+    VectorField3Ptr m_backgroundVelocityField;
+    unsigned int m_backgroundBlendWidth = 4;
+
     Vector3D m_gravity = Vector3D{ 0.0, -9.8, 0.0 };
     double m_viscosityCoefficient = 0.0;
     double m_maxCFL = 5.0;
+    mutable double m_lastSubTimeStepSize = 0.0;
+
+    //! Component-wise maxima of the cell-center velocity, used by GetCFL.
+    //! Tagged with the data version of the velocity grid and refreshed
+    //! lazily when the versions diverge, so the repeated CFL queries of a
+    //! substep share one full-grid read.
+    mutable Vector3D m_maxVelocityComponents;
+    mutable size_t m_maxVelocityVersion = 0;
     int m_closedDomainBoundaryFlag = DIRECTION_ALL;
     bool m_useCompressedLinearSys = false;
+    bool m_useColliderSDFCache = false;
+    bool m_useAsyncEmitterUpdate = false;
+    size_t m_lastColliderSDFVersion = 0;
+
+    //! Pending asynchronous emitter update, joined before the begin-step
+    //! stage callback.
+    std::future<void> m_emitterUpdateFuture;
+
+    bool m_isSecondaryParticlesEnabled = false;
+    ParticleSystemData3Ptr m_secondaryParticles;
+    size_t m_maxNumberOfSecondaryParticles = 1000000;
+    unsigned int m_secondaryEmissionSeed = 0;
+
+    //! Collider bounds of the previous substep, used to derive the dirty
+    //! region for partial boundary weight updates.
+    BoundingBox3D m_lastColliderBounds;
+    bool m_hasLastColliderBounds = false;
+
+    //! Frame-scoped scratch grids reused across substeps so that the
+    //! steady-state simulation loop performs no per-substep heap allocation.
+    //! Reset at the beginning of every substep and cleared on grid resize.
+    //! Only the pressure stage still needs a true velocity copy; advection
+    //! and diffusion use the shadow buffers owned by GridSystemData3.
+    mutable ScratchPool<FaceCenteredGrid3> m_velocityScratch;
 };
 
 //! Shared pointer type for the GridFluidSolver3.
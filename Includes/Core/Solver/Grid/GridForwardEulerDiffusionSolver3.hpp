@@ -109,6 +109,10 @@ class GridForwardEulerDiffusionSolver3 final : public GridDiffusionSolver3
         const ScalarField3& boundarySDF, const ScalarField3& fluidSDF);
 
     Array3<char> m_markers;
+
+    //! Scratch buffer for the whole-field Laplacian used by the
+    //! face-centered path, reused across components and calls.
+    Array3<double> m_laplacianScratch;
 };
 
 //! Shared pointer type for the GridForwardEulerDiffusionSolver3.
@@ -15,6 +15,8 @@
 #include <Core/Grid/CellCenteredScalarGrid3.hpp>
 #include <Core/Solver/Grid/GridBoundaryConditionSolver3.hpp>
 
+#include <vector>
+
 namespace CubbyFlow
 {
 //!
@@ -67,14 +69,88 @@ class GridFractionalBoundaryConditionSolver3
     //! Returns the velocity field of the collider.
     [[nodiscard]] VectorField3Ptr GetColliderVelocityField() const override;
 
+    //! Returns true if the collider SDF cache is enabled.
+    [[nodiscard]] bool GetUseColliderSDFCache() const;
+
+    //!
+    //! \brief Enables or disables the collider SDF cache.
+    //!
+    //! When enabled, the rasterized signed distance field is kept across
+    //! collider updates as long as the collider surface and its transform stay
+    //! unchanged, skipping the (potentially expensive) re-rasterization for
+    //! static colliders. A collider that only moved keeps the far field and
+    //! gets re-rasterized within the dilated union of its previous and current
+    //! bounding boxes; the stale far-field distances remain sign-correct,
+    //! which is all the boundary handling relies on. Surfaces that animate
+    //! without changing their transform should keep the cache disabled.
+    //!
+    void SetUseColliderSDFCache(bool useColliderSDFCache);
+
+    //! Returns the version of the rasterized collider SDF. The version is
+    //! incremented whenever the SDF content is (re-)rasterized, so callers can
+    //! cache data derived from the SDF and detect staleness.
+    [[nodiscard]] size_t GetColliderSDFVersion() const;
+
  protected:
     //! Invoked when a new collider is set.
     void OnColliderUpdated(const Size3& gridSize, const Vector3D& gridSpacing,
                            const Vector3D& gridOrigin) override;
 
  private:
+    //! A collider-interior face retained by the classification pass: the face
+    //! index plus the collider-surface normal cached there (zero when the SDF
+    //! gradient vanishes at the face center).
+    struct FractionalFace
+    {
+        Size3 index;
+        Vector3D normal;
+    };
+
+    //!
+    //! \brief Rebuilds the per-face classification tables.
+    //!
+    //! Classifies every velocity face against the collider SDF once: faces
+    //! with zero open fraction go to the solid lists, faces whose center lies
+    //! inside the collider go to the fractional lists together with their
+    //! cached surface normal, and fully-fluid faces appear in neither. The
+    //! face markers consumed by the extrapolation pass are filled here as
+    //! well. The tables stay valid while the collider SDF version and the
+    //! velocity grid layout are unchanged, so for static colliders with the
+    //! SDF cache enabled the constrain pass degenerates to table-driven
+    //! sweeps without any SDF sampling.
+    //!
+    void BuildFaceClassification(const FaceCenteredGrid3& velocity);
+
     CellCenteredScalarGrid3Ptr m_colliderSDF;
     CustomVectorField3Ptr m_colliderVel;
+    Surface3Ptr m_cachedSurface;
+    Transform3 m_cachedTransform;
+    BoundingBox3D m_cachedBound;
+    size_t m_colliderSDFVersion = 0;
+    bool m_useColliderSDFCache = false;
+    bool m_hasCachedColliderSDF = false;
+
+    // Workspace for ConstrainVelocity, kept across calls to avoid per-substep
+    // allocations. Resized only when the resolution changes.
+    Array3<double> m_uTemp;
+    Array3<double> m_vTemp;
+    Array3<double> m_wTemp;
+    Array3<char> m_uMarker;
+    Array3<char> m_vMarker;
+    Array3<char> m_wMarker;
+
+    // Per-face classification tables keyed on the collider SDF version and
+    // the velocity grid layout; see BuildFaceClassification(). The marker
+    // arrays above double as the cached fluid masks for extrapolation.
+    std::vector<Size3> m_uSolidFaces;
+    std::vector<Size3> m_vSolidFaces;
+    std::vector<Size3> m_wSolidFaces;
+    std::vector<FractionalFace> m_uFractionalFaces;
+    std::vector<FractionalFace> m_vFractionalFaces;
+    std::vector<FractionalFace> m_wFractionalFaces;
+    Size3 m_classifiedSize;
+    size_t m_classifiedSDFVersion = 0;
+    bool m_hasFaceClassification = false;
 };
 
 //! Shared pointer type for the GridFractionalBoundaryConditionSolver3.
@@ -12,6 +12,7 @@
 #define CUBBYFLOW_FRACTIONAL_SINGLE_PHASE_PRESSURE_SOLVER3_HPP
 
 #include <Core/FDM/FDMMGLinearSystem3.hpp>
+#include <Core/Geometry/BoundingBox3.hpp>
 #include <Core/Solver/FDM/FDMLinearSystemSolver3.hpp>
 #include <Core/Solver/FDM/FDMMGSolver3.hpp>
 #include <Core/Solver/Grid/GridPressureSolver3.hpp>
@@ -123,6 +124,36 @@ class GridFractionalSinglePhasePressureSolver3 : public GridPressureSolver3
     //! Returns the pressure field.
     [[nodiscard]] const FDMVector3& GetPressure() const;
 
+    //! Returns true if the boundary weight cache is enabled.
+    [[nodiscard]] bool GetUseWeightCache() const;
+
+    //!
+    //! \brief Enables or disables the boundary weight cache.
+    //!
+    //! When enabled, the fractional boundary weights are reused across solves
+    //! as long as the same boundary SDF field and grid layout are given. The
+    //! fluid SDF is still re-sampled every solve. Call InvalidateWeightCache
+    //! whenever the content of the boundary SDF field has changed.
+    //!
+    void SetUseWeightCache(bool useWeightCache);
+
+    //! Invalidates the cached boundary weights so that the next solve
+    //! rebuilds them from the boundary SDF.
+    void InvalidateWeightCache();
+
+    //!
+    //! \brief Invalidates the cached boundary weights inside \p region only.
+    //!
+    //! The next solve recomputes just the face weights whose sampling
+    //! stencil can overlap \p region (world space) and keeps the rest of
+    //! the cache, turning three full passes into a pass over the dirty
+    //! cells. Typically called with the union of a moving collider's
+    //! previous and current bounding boxes; weights farther away cannot
+    //! change because the boundary SDF stays positive across their whole
+    //! stencil there. Repeated calls between solves merge their regions.
+    //!
+    void InvalidateWeightCacheInRegion(const BoundingBox3D& region);
+
  private:
     void BuildWeights(const FaceCenteredGrid3& input,
                       const ScalarField3& boundarySDF,
@@ -150,6 +181,15 @@ class GridFractionalSinglePhasePressureSolver3 : public GridPressureSolver3
     std::vector<Array3<double>> m_fluidSDF;
 
     std::function<Vector3D(const Vector3D&)> m_boundaryVel;
+
+    const ScalarField3* m_cachedBoundarySDF = nullptr;
+    Size3 m_cachedWeightsSize;
+    size_t m_cachedWeightsLevels = 0;
+    bool m_useWeightCache = false;
+    bool m_weightCacheValid = false;
+
+    BoundingBox3D m_dirtyRegion;
+    bool m_hasDirtyRegion = false;
 };
 
 //! Shared pointer type for the GridFractionalSinglePhasePressureSolver3.
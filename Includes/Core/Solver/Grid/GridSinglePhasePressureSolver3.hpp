@@ -12,6 +12,7 @@
 #define CUBBYFLOW_SINGLE_PHASE_PRESSURE_SOLVER3_HPP
 
 #include <Core/FDM/FDMMGLinearSystem3.hpp>
+#include <Core/Grid/MarkerBitset3.hpp>
 #include <Core/Solver/FDM/FDMLinearSystemSolver3.hpp>
 #include <Core/Solver/FDM/FDMMGSolver3.hpp>
 #include <Core/Solver/Grid/GridPressureSolver3.hpp>
@@ -113,6 +114,77 @@ class GridSinglePhasePressureSolver3 : public GridPressureSolver3
     //! Returns the pressure field.
     [[nodiscard]] const FDMVector3& GetPressure() const;
 
+    //! Returns true if the system matrix is evaluated matrix-free.
+    [[nodiscard]] bool GetUseMatrixFree() const;
+
+    //!
+    //! \brief Enables or disables the matrix-free solve.
+    //!
+    //! When enabled, the solver skips the matrix assembly pass and evaluates
+    //! the Laplacian stencil (with boundary weights) on the fly during the
+    //! conjugate gradient iterations, which avoids storing the system matrix.
+    //! The matrix-free path requires the linear system solver to be an
+    //! FDMCGSolver3 and falls back to the assembled system otherwise.
+    //!
+    void SetUseMatrixFree(bool useMatrixFree);
+
+    //! Returns true if the previous solution is reused as the initial guess.
+    [[nodiscard]] bool GetUseWarmStart() const;
+
+    //!
+    //! \brief Enables or disables warm starting from the previous solution.
+    //!
+    //! When enabled, the pressure field from the previous call to Solve is
+    //! kept and used as the initial guess of the linear system solve. Since
+    //! pressure varies smoothly between consecutive time steps, the guess is
+    //! usually close to the new solution and the iterations converge in far
+    //! fewer steps. Cells that were not fluid in the previous call (or the
+    //! whole field, if the resolution changed) fall back to zero. Warm
+    //! starting requires the linear system solver to be an FDMCGSolver3 or
+    //! FDMICCGSolver3 and has no effect on the multigrid path.
+    //!
+    void SetUseWarmStart(bool useWarmStart);
+
+    //! Returns true if post-projection divergence metrics are measured.
+    [[nodiscard]] bool GetDivergenceTrackingEnabled() const;
+
+    //!
+    //! \brief Enables or disables post-projection divergence metrics.
+    //!
+    //! When enabled, each call to Solve additionally measures the maximum and
+    //! mean |div u| over the fluid cells of the projected velocity field,
+    //! available through GetLastMaxDivergence and GetLastMeanDivergence. The
+    //! sweep runs right after the pressure gradient application while the
+    //! velocity data is still cache-hot. Setting a positive target divergence
+    //! enables the metrics implicitly.
+    //!
+    void SetDivergenceTrackingEnabled(bool enabled);
+
+    //! Returns max |div u| over fluid cells after the last solve.
+    [[nodiscard]] double GetLastMaxDivergence() const;
+
+    //! Returns mean |div u| over fluid cells after the last solve.
+    [[nodiscard]] double GetLastMeanDivergence() const;
+
+    //! Returns the target max divergence of the adaptive-tolerance
+    //! controller, or zero if the controller is disabled.
+    [[nodiscard]] double GetTargetDivergence() const;
+
+    //!
+    //! \brief Sets the target max divergence for adaptive solver tolerance.
+    //!
+    //! When positive, a feedback controller retunes the tolerance of the
+    //! underlying FDMCGSolver3 or FDMICCGSolver3 before every solve: the
+    //! tolerance is doubled while the measured post-projection divergence
+    //! stays below a quarter of the target and quartered once it exceeds the
+    //! target, never dropping below the tolerance the solver was configured
+    //! with. Simulations that only need the divergence below some visible
+    //! threshold then stop over-solving the pressure system and converge in
+    //! fewer iterations. Zero (the default) disables the controller. Has no
+    //! effect on the multigrid path.
+    //!
+    void SetTargetDivergence(double targetDivergence);
+
  private:
     void BuildMarkers(
         const Size3& size,
@@ -121,12 +193,22 @@ class GridSinglePhasePressureSolver3 : public GridPressureSolver3
 
     void DecompressSolution();
 
+    void SeedInitialGuess(FDMVector3* x) const;
+
+    void SeedCompressedInitialGuess();
+
+    void StorePreviousSolution();
+
     virtual void BuildSystem(const FaceCenteredGrid3& input,
                              bool useCompressed);
 
     virtual void ApplyPressureGradient(const FaceCenteredGrid3& input,
                                        FaceCenteredGrid3* output);
 
+    void MeasureDivergence(const FaceCenteredGrid3& output);
+
+    void AdaptSolverTolerance();
+
     FDMLinearSystem3 m_system;
     FDMCompressedLinearSystem3 m_compSystem;
     FDMLinearSystemSolver3Ptr m_systemSolver;
@@ -135,6 +217,21 @@ class GridSinglePhasePressureSolver3 : public GridPressureSolver3
     FDMMGSolver3Ptr m_mgSystemSolver;
 
     std::vector<Array3<char>> m_markers;
+    MarkerBitset3 m_markerBitset;
+
+    FDMVector3 m_prevPressure;
+    Array3<char> m_prevMarkers;
+
+    bool m_useMatrixFree = false;
+    bool m_useWarmStart = false;
+
+    bool m_divergenceTrackingEnabled = false;
+    double m_targetDivergence = 0.0;
+    double m_lastMaxDivergence = 0.0;
+    double m_lastMeanDivergence = 0.0;
+    bool m_hasDivergenceSample = false;
+    double m_baseTolerance = 0.0;
+    double m_adaptiveTolerance = 0.0;
 };
 
 //! Shared pointer type for the GridSinglePhasePressureSolver3.
@@ -0,0 +1,144 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_SHALLOW_WATER_SOLVER2_HPP
+#define CUBBYFLOW_SHALLOW_WATER_SOLVER2_HPP
+
+#include <Core/Animation/PhysicsAnimation.hpp>
+#include <Core/Geometry/BoundingBox3.hpp>
+#include <Core/Grid/CellCenteredScalarGrid2.hpp>
+#include <Core/Solver/Hybrid/FLIP/FLIPSolver3.hpp>
+
+namespace CubbyFlow
+{
+//!
+//! \brief      Height-field (shallow water) liquid solver.
+//!
+//! This solver animates a liquid surface as a 2D height field instead of a
+//! full 3D volume. The state lives on cell-centered scalar grids: the water
+//! depth above the terrain, the terrain elevation, and the depth-averaged
+//! horizontal velocity. Each time step advects the state semi-Lagrangianly,
+//! accelerates the velocity down the surface-elevation gradient, and updates
+//! the depth from the velocity divergence. Large calm regions (harbors, open
+//! sea around a ship) are orders of magnitude cheaper to solve this way than
+//! with a 3D grid of the same footprint.
+//!
+//! The 2D domain maps to the 3D world by taking the grid x/y axes as world
+//! x/z and the height as world y. CoupleToFLIP pushes the height-field state
+//! one-way into a FLIPSolver3: particles inside a designated coupling region
+//! get their horizontal velocity overwritten by the depth-averaged velocity,
+//! so waves entering the 3D domain carry the far-field motion.
+//!
+class ShallowWaterSolver2 : public PhysicsAnimation
+{
+ public:
+    //! Constructs a solver with a single cell covering the unit domain.
+    ShallowWaterSolver2();
+
+    //! Constructs a solver with given resolution, grid spacing, and origin.
+    ShallowWaterSolver2(const Size2& resolution, const Vector2D& gridSpacing,
+                        const Vector2D& origin);
+
+    //! Deleted copy constructor.
+    ShallowWaterSolver2(const ShallowWaterSolver2&) = delete;
+
+    //! Deleted move constructor.
+    ShallowWaterSolver2(ShallowWaterSolver2&&) noexcept = delete;
+
+    //! Default virtual destructor.
+    ~ShallowWaterSolver2() override = default;
+
+    //! Deleted copy assignment operator.
+    ShallowWaterSolver2& operator=(const ShallowWaterSolver2&) = delete;
+
+    //! Deleted move assignment operator.
+    ShallowWaterSolver2& operator=(ShallowWaterSolver2&&) noexcept = delete;
+
+    //! Returns the gravity magnitude.
+    [[nodiscard]] double GetGravity() const;
+
+    //! Sets the gravity magnitude.
+    void SetGravity(double gravity);
+
+    //! Returns the max allowed CFL number of a sub-time step.
+    [[nodiscard]] double GetMaxCFL() const;
+
+    //! Sets the max allowed CFL number of a sub-time step.
+    void SetMaxCFL(double cfl);
+
+    //! Returns the water depth above the terrain.
+    [[nodiscard]] CellCenteredScalarGrid2& GetHeight();
+
+    //! Returns the water depth above the terrain.
+    [[nodiscard]] const CellCenteredScalarGrid2& GetHeight() const;
+
+    //! Returns the terrain elevation.
+    [[nodiscard]] CellCenteredScalarGrid2& GetTerrain();
+
+    //! Returns the terrain elevation.
+    [[nodiscard]] const CellCenteredScalarGrid2& GetTerrain() const;
+
+    //! Returns the x-component of the depth-averaged velocity.
+    [[nodiscard]] CellCenteredScalarGrid2& GetVelocityU();
+
+    //! Returns the x-component of the depth-averaged velocity.
+    [[nodiscard]] const CellCenteredScalarGrid2& GetVelocityU() const;
+
+    //! Returns the y-component of the depth-averaged velocity.
+    [[nodiscard]] CellCenteredScalarGrid2& GetVelocityV();
+
+    //! Returns the y-component of the depth-averaged velocity.
+    [[nodiscard]] const CellCenteredScalarGrid2& GetVelocityV() const;
+
+    //! Returns the surface elevation (terrain + depth) at \p x.
+    [[nodiscard]] double GetSurfaceHeightAt(const Vector2D& x) const;
+
+    //! Returns the depth-averaged velocity at \p x.
+    [[nodiscard]] Vector2D GetVelocityAt(const Vector2D& x) const;
+
+    //!
+    //! \brief Pushes the height-field state one-way into a FLIP solver.
+    //!
+    //! Every particle of \p solver inside \p region gets its world x/z
+    //! velocity overwritten by the depth-averaged velocity sampled at the
+    //! particle's x/z position; the vertical component is left to the 3D
+    //! solve. Call this after advancing this solver and before advancing the
+    //! FLIP solver. The coupling is one-way: the 3D solve does not feed back
+    //! into the height field.
+    //!
+    //! \param[in]  solver  The FLIP solver receiving the far-field motion.
+    //! \param[in]  region  The coupling region in world coordinates.
+    //!
+    void CoupleToFLIP(const FLIPSolver3Ptr& solver,
+                      const BoundingBox3D& region) const;
+
+ protected:
+    //! Advances the height field by \p timeIntervalInSeconds.
+    void OnAdvanceTimeStep(double timeIntervalInSeconds) override;
+
+    //! Returns the number of sub-time steps limited by the gravity wave CFL.
+    [[nodiscard]] unsigned int GetNumberOfSubTimeSteps(
+        double timeIntervalInSeconds) const override;
+
+ private:
+    double m_gravity = 9.8;
+    double m_maxCFL = 0.5;
+
+    CellCenteredScalarGrid2 m_height;
+    CellCenteredScalarGrid2 m_terrain;
+    CellCenteredScalarGrid2 m_velocityU;
+    CellCenteredScalarGrid2 m_velocityV;
+};
+
+//! Shared pointer type for the ShallowWaterSolver2.
+using ShallowWaterSolver2Ptr = std::shared_ptr<ShallowWaterSolver2>;
+}  // namespace CubbyFlow
+
+#endif
@@ -55,6 +55,9 @@ class APICSolver3 : public PICSolver3
     [[nodiscard]] static Builder GetBuilder();
 
  protected:
+    //! Computes the advection term of the fluid solver.
+    void ComputeAdvection(double timeIntervalInSeconds) override;
+
     //! Transfers velocity field from particles to grids.
     void TransferFromParticlesToGrids() override;
 
@@ -62,9 +65,19 @@ class APICSolver3 : public PICSolver3
     void TransferFromGridsToParticles() override;
 
  private:
-    Array1<Vector3D> m_cX;
-    Array1<Vector3D> m_cY;
-    Array1<Vector3D> m_cZ;
+    //!
+    //! \brief Fused grid-to-particle transfer and particle advection.
+    //!
+    //! Reconstructs the particle velocity and affine matrix from the grid and
+    //! advances the particle position in a single pass, so each particle is
+    //! touched once per substep. With a zero time interval, this reduces to
+    //! the plain grid-to-particle transfer.
+    //!
+    void TransferFromGridsToParticlesAndMove(double timeIntervalInSeconds);
+
+    //! Per-particle affine matrix, packed as nine consecutive doubles
+    //! (rows c_x, c_y, c_z) so the fused pass streams one buffer.
+    Array1<double> m_c;
 };
 
 //! Shared pointer type for the APICSolver3.
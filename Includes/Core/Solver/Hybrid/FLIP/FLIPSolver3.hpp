@@ -68,6 +68,24 @@ class FLIPSolver3 : public PICSolver3
     //!
     void SetPICBlendingFactor(double factor);
 
+    //! Returns true if the vorticity-adaptive PIC blending is enabled.
+    [[nodiscard]] bool GetUseVorticityAdaptiveBlending() const;
+
+    //!
+    //! \brief  Enables or disables the vorticity-adaptive PIC blending.
+    //!
+    //! When enabled, the PIC blending factor varies per region instead of
+    //! being a single global value: the local vorticity is measured on a
+    //! coarse grid, quiescent regions get the full factor configured with
+    //! SetPICBlendingFactor (damping particle noise), and strongly rotating
+    //! regions fall back toward pure FLIP so their swirls are not smeared
+    //! out. The configured factor acts as the upper bound. Default is
+    //! disabled.
+    //!
+    //! \param[in]  useAdaptiveBlending True to enable the adaptive blending.
+    //!
+    void SetUseVorticityAdaptiveBlending(bool useAdaptiveBlending);
+
     //! Returns builder fox FLIPSolver3.
     [[nodiscard]] static Builder GetBuilder();
 
@@ -79,10 +97,23 @@ class FLIPSolver3 : public PICSolver3
     void TransferFromGridsToParticles() override;
 
  private:
+    //! Refreshes the coarse per-region PIC weights from the grid vorticity.
+    void UpdateBlendWeights(const FaceCenteredGrid3Ptr& flow);
+
     double m_picBlendingFactor = 0.0;
-    Array3<double> m_uDelta;
-    Array3<double> m_vDelta;
-    Array3<double> m_wDelta;
+    bool m_useVorticityAdaptiveBlending = false;
+
+    //! Single-precision snapshot of the grid right after the
+    //! particle-to-grid transfer; the FLIP delta is formed against it on the
+    //! fly while sampling, so no full-resolution delta grid is ever written.
+    Array3<float> m_uSnapshot;
+    Array3<float> m_vSnapshot;
+    Array3<float> m_wSnapshot;
+
+    //! Coarse per-region PIC blending weights and their sampling transform.
+    Array3<double> m_blendWeights;
+    Vector3D m_blendWeightsSpacing;
+    Vector3D m_blendWeightsOrigin;
 };
 
 //! Shared pointer type for the FLIPSolver3.
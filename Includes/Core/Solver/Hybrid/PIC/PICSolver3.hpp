@@ -32,6 +32,20 @@ class PICSolver3 : public GridFluidSolver3
  public:
     class Builder;
 
+    //! Integrator types for particle advection.
+    enum class ParticleIntegrator
+    {
+        //! Mid-point rule (second-order Runge-Kutta).
+        RungeKutta2,
+
+        //! Ralston's third-order Runge-Kutta.
+        RungeKutta3,
+
+        //! Mid-point rule with per-particle substep count chosen from the
+        //! particle's own CFL number instead of the global maximum.
+        Adaptive
+    };
+
     //! Default constructor.
     PICSolver3();
 
@@ -66,6 +80,65 @@ class PICSolver3 : public GridFluidSolver3
     //! Sets the particle emitter.
     void SetParticleEmitter(const ParticleEmitter3Ptr& newEmitter);
 
+    //! Returns true if the particle-to-grid transfer runs in gather mode.
+    [[nodiscard]] bool GetUseGatherModeTransfer() const;
+
+    //!
+    //! \brief Sets whether the particle-to-grid transfer runs in gather mode.
+    //!
+    //! The default transfer scatters each particle's contribution to its
+    //! eight surrounding faces, which serializes on the shared face arrays.
+    //! In gather mode, particles are first binned per grid cell and then
+    //! every face gathers from the particles in its neighboring bins, so
+    //! faces can be processed fully in parallel with no write contention.
+    //! Both modes compute the same weighted average up to floating-point
+    //! summation order. APIC solvers use their own transfer and ignore this
+    //! flag.
+    //!
+    void SetUseGatherModeTransfer(bool isOn);
+
+    //! Returns true if particle sleeping is enabled.
+    [[nodiscard]] bool GetUseParticleSleeping() const;
+
+    //!
+    //! \brief Sets whether settled particles are put to sleep.
+    //!
+    //! When enabled, the solver tracks per-particle activity states through
+    //! ParticleSystemData3::UpdateActivityStates and skips the transfer
+    //! contribution and advection of sleeping particles. Their faces stay
+    //! marked as fluid, so pressure and extrapolation see the settled region
+    //! as before, and motion entering the region wakes its particles cell by
+    //! cell. On late-stage shots where most particles have settled, this
+    //! removes most per-particle work at the cost of freezing residual
+    //! motion below the sleep threshold. Disabled by default.
+    //!
+    void SetUseParticleSleeping(bool isOn);
+
+    //! Returns the sleep threshold as a fraction of a cell per time-step.
+    [[nodiscard]] double GetSleepThresholdFactor() const;
+
+    //!
+    //! \brief Sets the sleep threshold as a fraction of a cell per time-step.
+    //!
+    //! A particle counts as resting while it moves less than this fraction
+    //! of the smallest grid spacing per time-step, and falls asleep after
+    //! resting for a fixed number of consecutive time-steps. Defaults to
+    //! 0.01.
+    //!
+    void SetSleepThresholdFactor(double factor);
+
+    //! Returns the particle advection integrator type.
+    [[nodiscard]] ParticleIntegrator GetParticleIntegrator() const;
+
+    //!
+    //! \brief Sets the particle advection integrator type.
+    //!
+    //! Higher-order integrators tolerate larger substeps at equal advection
+    //! quality; the adaptive integrator spends substeps only on fast
+    //! particles. Defaults to the mid-point rule.
+    //!
+    void SetParticleIntegrator(ParticleIntegrator integrator);
+
     //! Returns builder fox PICSolver3.
     [[nodiscard]] static Builder GetBuilder();
 
@@ -91,20 +164,29 @@ class PICSolver3 : public GridFluidSolver3
     //! Moves particles.
     virtual void MoveParticles(double timeIntervalInSeconds);
 
+    //! Extrapolates marked face velocities into the air region.
+    void ExtrapolateVelocityToAir() const;
+
     Array3<char> m_uMarkers;
     Array3<char> m_vMarkers;
     Array3<char> m_wMarkers;
 
  private:
-    void ExtrapolateVelocityToAir() const;
+    void TransferFromParticlesToGridsGather();
 
     void BuildSignedDistanceField();
 
     void UpdateParticleEmitter(double timeIntervalInSeconds) const;
 
+    void UpdateParticleActivityStates(double timeIntervalInSeconds) const;
+
     size_t m_signedDistanceFieldID;
     ParticleSystemData3Ptr m_particles;
     ParticleEmitter3Ptr m_particleEmitter;
+    bool m_useGatherModeTransfer = false;
+    bool m_useParticleSleeping = false;
+    double m_sleepThresholdFactor = 0.01;
+    ParticleIntegrator m_particleIntegrator = ParticleIntegrator::RungeKutta2;
 };
 
 //! Shared pointer type for the PICSolver3.
@@ -13,6 +13,8 @@
 
 #include <Core/Solver/LevelSet/LevelSetSolver3.hpp>
 
+#include <vector>
+
 namespace CubbyFlow
 {
 //!
@@ -54,6 +56,24 @@ class FMMLevelSetSolver3 final : public LevelSetSolver3
     void Extrapolate(const ScalarGrid3& input, const ScalarField3& sdf,
                      double maxDistance, ScalarGrid3* output) override;
 
+    //!
+    //! \brief Extrapolates multiple scalar fields in a single marching pass.
+    //!
+    //! The marching order and the upwind weights depend only on \p sdf, so
+    //! fields that share the same reference SDF and grid layout (velocity
+    //! components, temperature, ...) can reuse one ordering instead of
+    //! recomputing it per quantity. The result of each field is identical to
+    //! extrapolating it on its own.
+    //!
+    //! \param inputs Input scalar fields to be extrapolated.
+    //! \param sdf Reference signed-distance field.
+    //! \param maxDistance Max range of extrapolation.
+    //! \param outputs Output scalar fields, one per input.
+    //!
+    void Extrapolate(const std::vector<ScalarGrid3Ptr>& inputs,
+                     const ScalarField3& sdf, double maxDistance,
+                     const std::vector<ScalarGrid3Ptr>& outputs);
+
     //!
     //! Extrapolates given collocated vector field from negative to positive SDF
     //! region.
@@ -84,6 +104,11 @@ class FMMLevelSetSolver3 final : public LevelSetSolver3
                      const ConstArrayAccessor3<double>& sdf,
                      const Vector3D& gridSpacing, double maxDistance,
                      ArrayAccessor3<double> output);
+
+    void Extrapolate(const std::vector<ConstArrayAccessor3<double>>& inputs,
+                     const ConstArrayAccessor3<double>& sdf,
+                     const Vector3D& gridSpacing, double maxDistance,
+                     std::vector<ArrayAccessor3<double>>& outputs);
 };
 
 //! Shared pointer type for the FMMLevelSetSolver3.
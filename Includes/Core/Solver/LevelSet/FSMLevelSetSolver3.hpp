@@ -0,0 +1,97 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_FSM_LEVEL_SET_SOLVER3_HPP
+#define CUBBYFLOW_FSM_LEVEL_SET_SOLVER3_HPP
+
+#include <Core/Solver/LevelSet/LevelSetSolver3.hpp>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Three-dimensional fast sweeping method (FSM) implementation.
+//!
+//! This class implements 3-D FSM, a parallel alternative to the fast marching
+//! method. Instead of propagating a serial priority queue outward from the
+//! interface, the eikonal equation is solved by eight directional Gauss-Seidel
+//! sweeps. Within each sweep, cells on a diagonal plane i + j + k = constant
+//! have no data dependency on each other, so every plane is processed in
+//! parallel.
+//!
+//! \see Zhao, Hongkai. "A fast sweeping method for eikonal equations."
+//!     Mathematics of Computation 74.250 (2005): 603-627.
+//! \see Detrixhe, Miles, Frederic Gibou, and Chohong Min. "A parallel fast
+//!     sweeping method for the eikonal equation." Journal of Computational
+//!     Physics 237 (2013): 46-55.
+//!
+class FSMLevelSetSolver3 final : public LevelSetSolver3
+{
+ public:
+    //! Default constructor.
+    FSMLevelSetSolver3() = default;
+
+    //!
+    //! Reinitializes given scalar field to signed-distance field.
+    //!
+    //! \param inputSDF Input signed-distance field which can be distorted.
+    //! \param maxDistance Max range of reinitialization.
+    //! \param outputSDF Output signed-distance field.
+    //!
+    void Reinitialize(const ScalarGrid3& inputSDF, double maxDistance,
+                      ScalarGrid3* outputSDF) override;
+
+    //!
+    //! Extrapolates given scalar field from negative to positive SDF region.
+    //!
+    //! \param input Input scalar field to be extrapolated.
+    //! \param sdf Reference signed-distance field.
+    //! \param maxDistance Max range of extrapolation.
+    //! \param output Output scalar field.
+    //!
+    void Extrapolate(const ScalarGrid3& input, const ScalarField3& sdf,
+                     double maxDistance, ScalarGrid3* output) override;
+
+    //!
+    //! Extrapolates given collocated vector field from negative to positive SDF
+    //! region.
+    //!
+    //! \param input Input collocated vector field to be extrapolated.
+    //! \param sdf Reference signed-distance field.
+    //! \param maxDistance Max range of extrapolation.
+    //! \param output Output collocated vector field.
+    //!
+    void Extrapolate(const CollocatedVectorGrid3& input,
+                     const ScalarField3& sdf, double maxDistance,
+                     CollocatedVectorGrid3* output) override;
+
+    //!
+    //! Extrapolates given face-centered vector field from negative to positive
+    //! SDF region.
+    //!
+    //! \param input Input face-centered field to be extrapolated.
+    //! \param sdf Reference signed-distance field.
+    //! \param maxDistance Max range of extrapolation.
+    //! \param output Output face-centered vector field.
+    //!
+    void Extrapolate(const FaceCenteredGrid3& input, const ScalarField3& sdf,
+                     double maxDistance, FaceCenteredGrid3* output) override;
+
+ private:
+    void Extrapolate(const ConstArrayAccessor3<double>& input,
+                     const ConstArrayAccessor3<double>& sdf,
+                     const Vector3D& gridSpacing, double maxDistance,
+                     ArrayAccessor3<double> output);
+};
+
+//! Shared pointer type for the FSMLevelSetSolver3.
+using FSMLevelSetSolver3Ptr = std::shared_ptr<FSMLevelSetSolver3>;
+}  // namespace CubbyFlow
+
+#endif
@@ -106,6 +106,40 @@ class IterativeLevelSetSolver3 : public LevelSetSolver3
     //!
     void SetMaxCFL(double newMaxCFL);
 
+    //! Returns the narrow band half-width, or zero if disabled.
+    [[nodiscard]] double GetNarrowBandWidth() const;
+
+    //!
+    //! \brief Sets the narrow band half-width in world units.
+    //!
+    //! When set to a positive value, Reinitialize only iterates the cells
+    //! whose input signed distance magnitude is within the given width of
+    //! the interface (plus a one-tile halo); cells outside the band keep
+    //! their input values. Since only a few cells around the interface are
+    //! ever consumed by the simulation, a width slightly larger than the
+    //! reinitialization distance preserves the result while skipping most
+    //! of the domain. Zero (the default) processes the whole grid. The
+    //! negative input will be clamped to 0.
+    //!
+    void SetNarrowBandWidth(double newWidth);
+
+    //! Returns the convergence tolerance, or zero if disabled.
+    [[nodiscard]] double GetConvergenceTolerance() const;
+
+    //!
+    //! \brief Sets the convergence tolerance for early exit.
+    //!
+    //! When set to a positive value, Reinitialize stops iterating as soon
+    //! as the largest cell update of a pseudo-time step drops below
+    //! tolerance * dtau — that is, once the remaining gradient error
+    //! ||grad(phi)| - 1| is below the tolerance everywhere in the iterated
+    //! region. Inputs that are already near-distance fields then exit after
+    //! a couple of sweeps instead of running the full maxDistance-derived
+    //! iteration count. Zero (the default) always runs every iteration.
+    //! The negative input will be clamped to 0.
+    //!
+    void SetConvergenceTolerance(double newTolerance);
+
  protected:
     //! Computes the derivatives for given grid point.
     virtual void GetDerivatives(ConstArrayAccessor3<double> grid,
@@ -131,6 +165,8 @@ class IterativeLevelSetSolver3 : public LevelSetSolver3
                                         const Vector3D& gridSpacing) const;
 
     double m_maxCFL = 0.5;
+    double m_narrowBandWidth = 0.0;
+    double m_convergenceTolerance = 0.0;
 };
 
 using IterativeLevelSetSolver3Ptr = std::shared_ptr<IterativeLevelSetSolver3>;
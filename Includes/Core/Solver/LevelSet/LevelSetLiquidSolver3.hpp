@@ -11,9 +11,15 @@
 #ifndef CUBBYFLOW_LEVEL_SET_LIQUID_SOLVER3_HPP
 #define CUBBYFLOW_LEVEL_SET_LIQUID_SOLVER3_HPP
 
+#include <Core/Geometry/TriangleMesh3.hpp>
+#include <Core/Particle/ParticleSystemData3.hpp>
 #include <Core/Solver/Grid/GridFluidSolver3.hpp>
 #include <Core/Solver/LevelSet/LevelSetSolver3.hpp>
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace CubbyFlow
 {
 //!
@@ -45,8 +51,8 @@ class LevelSetLiquidSolver3 : public GridFluidSolver3
     //! Deleted move constructor.
     LevelSetLiquidSolver3(LevelSetLiquidSolver3&&) noexcept = delete;
 
-    //! Default virtual destructor.
-    ~LevelSetLiquidSolver3() override = default;
+    //! Destructor. Joins the surface preview extraction thread.
+    ~LevelSetLiquidSolver3() override;
 
     //! Deleted copy assignment operator.
     LevelSetLiquidSolver3& operator=(const LevelSetLiquidSolver3&) = delete;
@@ -80,6 +86,58 @@ class LevelSetLiquidSolver3 : public GridFluidSolver3
     //!
     void SetIsGlobalCompensationEnabled(bool isEnabled);
 
+    //!
+    //! \brief Enables (or disables) narrow-band reinitialization.
+    //!
+    //! When \p isEnabled is true, the reinitialization step only processes a
+    //! band of cells around the liquid surface instead of the whole grid. The
+    //! band is sized slightly larger than the reinitialization distance, so
+    //! every cell the simulation actually consumes gets the same value as in
+    //! the full-grid pass while the far field keeps its advected values. This
+    //! requires the level set solver to be an IterativeLevelSetSolver3 (the
+    //! default); other solvers keep processing the whole grid.
+    //!
+    void SetIsNarrowBandEnabled(bool isEnabled);
+
+    //!
+    //! \brief Enables (or disables) the particle level set correction.
+    //!
+    //! When \p isEnabled is true, marker particles are seeded in a band
+    //! around the liquid surface, advected through the same velocity field as
+    //! the grid, and used to rebuild the signed-distance field wherever grid
+    //! advection smeared it away. Escaped particles — those that end up on
+    //! the wrong side of the interface by more than their radius — carry
+    //! enough information to restore thin sheets and droplets smaller than a
+    //! few grid cells, so comparable surface detail survives at a lower grid
+    //! resolution.
+    //!
+    //! \see Enright, Douglas, Stephen Marschner, and Ronald Fedkiw.
+    //!     "Animation and rendering of complex water surfaces." ACM
+    //!     Transactions on Graphics (TOG). Vol. 21. No. 3. ACM, 2002.
+    //!
+    void SetIsParticleLevelSetEnabled(bool isEnabled);
+
+    //! Returns the marker particles used by the particle level set
+    //! correction, or null if the feature has not run yet.
+    [[nodiscard]] ParticleSystemData3Ptr GetLevelSetParticles() const;
+
+    //!
+    //! \brief Enables (or disables) asynchronous surface preview extraction.
+    //!
+    //! When \p isEnabled is true, the solver snapshots the signed-distance
+    //! field at the end of every time-step, restricts it to quarter
+    //! resolution on a background thread, and extracts a preview triangle
+    //! mesh with marching cubes. The solver never waits for the worker: if a
+    //! step finishes while the previous extraction is still running, that
+    //! step simply skips publishing, so the preview trails the simulation by
+    //! at most a frame while the solve throughput stays unchanged.
+    //!
+    void SetIsSurfacePreviewEnabled(bool isEnabled);
+
+    //! Returns the most recently published preview mesh, or null if no
+    //! extraction has completed yet.
+    [[nodiscard]] TriangleMesh3Ptr GetSurfacePreview() const;
+
     //!
     //! \brief Returns liquid volume measured by smeared Heaviside function.
     //!
@@ -118,11 +176,32 @@ class LevelSetLiquidSolver3 : public GridFluidSolver3
 
     void AddVolume(double volDiff);
 
+    void ReseedLevelSetParticles();
+
+    void AdvectLevelSetParticles(double timeIntervalInSeconds);
+
+    void CorrectSDFWithParticles();
+
+    void AdjustLevelSetParticleRadii();
+
+    void ExtractSurfacePreview();
+
     size_t m_signedDistanceFieldId;
     LevelSetSolver3Ptr m_levelSetSolver;
     double m_minReinitializeDistance = 10.0;
     bool m_isGlobalCompensationEnabled = false;
+    bool m_isNarrowBandEnabled = false;
+    bool m_isParticleLevelSetEnabled = false;
+    ParticleSystemData3Ptr m_levelSetParticles;
+    size_t m_particleSignDataId = 0;
+    size_t m_particleRadiusDataId = 0;
+    unsigned int m_stepsSinceReseed = 0;
     double m_lastKnownVolume = 0.0;
+    bool m_isSurfacePreviewEnabled = false;
+    std::thread m_previewThread;
+    std::atomic<bool> m_previewInFlight{ false };
+    mutable std::mutex m_previewMutex;
+    TriangleMesh3Ptr m_previewMesh;
 };
 
 //! Shared pointer type for the LevelSetLiquidSolver3.
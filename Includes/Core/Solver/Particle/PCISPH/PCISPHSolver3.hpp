@@ -73,6 +73,19 @@ class PCISPHSolver3 : public SPHSolver3
     //!
     void SetMaxNumberOfIterations(unsigned int n);
 
+    //! Returns the number of PCISPH iterations the last pressure solve took.
+    [[nodiscard]] unsigned int GetLastNumberOfIterations() const;
+
+    //!
+    //! \brief Returns the max density error ratio of the last pressure solve.
+    //!
+    //! The ratio is the largest per-particle density error after the final
+    //! iteration divided by the target density. Together with
+    //! PCISPHSolver3::GetLastNumberOfIterations this shows whether the solve
+    //! converged early or hit the iteration cap.
+    //!
+    [[nodiscard]] double GetLastMaxDensityErrorRatio() const;
+
     //! Returns builder fox PCISPHSolver3.
     [[nodiscard]] static Builder GetBuilder();
 
@@ -91,10 +104,14 @@ class PCISPHSolver3 : public SPHSolver3
     double m_maxDensityErrorRatio = 0.01;
     unsigned int m_maxNumberOfIterations = 5;
 
+    unsigned int m_lastNumberOfIterations = 0;
+    double m_lastMaxDensityErrorRatio = 0.0;
+
     ParticleSystemData3::VectorData m_tempPositions;
     ParticleSystemData3::VectorData m_tempVelocities;
     ParticleSystemData3::VectorData m_pressureForces;
     ParticleSystemData3::ScalarData m_densityErrors;
+    ParticleSystemData3::ScalarData m_predictedDensities;
 };
 
 //! Shared pointer type for the PCISPHSolver3.
@@ -20,20 +20,44 @@
 
 namespace CubbyFlow
 {
+//!
+//! \brief Builds serializable types from their type-name strings.
+//!
+//! The known grid and searcher types are dispatched through a switch over
+//! compile-time hashed type names, so a lookup costs one hash of the queried
+//! name and one string comparison, with no map probing and no std::string
+//! temporaries. The const char* overloads are the primary entry points; the
+//! deserialization loops of GridSystemData2/3 and ParticleSystemData2/3 hand
+//! in the flatbuffer-owned C strings directly.
+//!
 class Factory
 {
  public:
+    static ScalarGrid2Ptr BuildScalarGrid2(const char* name);
+
     static ScalarGrid2Ptr BuildScalarGrid2(const std::string& name);
 
+    static ScalarGrid3Ptr BuildScalarGrid3(const char* name);
+
     static ScalarGrid3Ptr BuildScalarGrid3(const std::string& name);
 
+    static VectorGrid2Ptr BuildVectorGrid2(const char* name);
+
     static VectorGrid2Ptr BuildVectorGrid2(const std::string& name);
 
+    static VectorGrid3Ptr BuildVectorGrid3(const char* name);
+
     static VectorGrid3Ptr BuildVectorGrid3(const std::string& name);
 
+    static PointNeighborSearcher2Ptr BuildPointNeighborSearcher2(
+        const char* name);
+
     static PointNeighborSearcher2Ptr BuildPointNeighborSearcher2(
         const std::string& name);
 
+    static PointNeighborSearcher3Ptr BuildPointNeighborSearcher3(
+        const char* name);
+
     static PointNeighborSearcher3Ptr BuildPointNeighborSearcher3(
         const std::string& name);
 };
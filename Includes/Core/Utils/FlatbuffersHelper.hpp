@@ -13,6 +13,7 @@
 
 #include <Core/Geometry/Size2.hpp>
 #include <Core/Geometry/Size3.hpp>
+#include <Core/Utils/Parallel.hpp>
 #include <Core/Vector/Vector2.hpp>
 #include <Core/Vector/Vector3.hpp>
 
@@ -65,16 +66,21 @@ void SerializeGrid(flatbuffers::FlatBufferBuilder* builder,
                    const std::vector<GridType>& gridList, FbsFactoryFunc func,
                    std::vector<flatbuffers::Offset<FbsGridType>>* fbsGridList)
 {
-    for (const auto& grid : gridList)
+    // Encode every grid into its own segment in parallel; the shared builder
+    // only sees the finished bytes, which are stitched below in the original
+    // deterministic order.
+    std::vector<std::vector<uint8_t>> gridsSerialized(gridList.size());
+    ParallelFor(static_cast<size_t>(0), gridList.size(), [&](size_t i) {
+        gridList[i]->Serialize(&gridsSerialized[i]);
+    });
+
+    for (size_t i = 0; i < gridList.size(); ++i)
     {
-        auto type = builder->CreateString(grid->TypeName());
-
-        std::vector<uint8_t> gridSerialized;
-        grid->Serialize(&gridSerialized);
+        auto type = builder->CreateString(gridList[i]->TypeName());
 
         auto fbsGrid = func(*builder, type,
-                            builder->CreateVector(gridSerialized.data(),
-                                                  gridSerialized.size()));
+                            builder->CreateVector(gridsSerialized[i].data(),
+                                                  gridsSerialized[i].size()));
         fbsGridList->push_back(fbsGrid);
     }
 }
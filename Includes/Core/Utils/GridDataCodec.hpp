@@ -0,0 +1,65 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_GRID_DATA_CODEC_HPP
+#define CUBBYFLOW_GRID_DATA_CODEC_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace CubbyFlow
+{
+//! Quantization applied to grid values before compression.
+enum class GridDataQuantization : uint8_t
+{
+    //! Values are stored as the original 64-bit doubles; the round trip is
+    //! bit-exact.
+    Lossless = 0,
+
+    //! Values are quantized to IEEE half precision before encoding. Suited
+    //! for render-only channels where ~3 decimal digits suffice; out-of-range
+    //! values saturate to the half-precision limits.
+    Float16 = 1
+};
+
+//!
+//! \brief Compresses a flat grid value array into \p buffer.
+//!
+//! The values are split into chunks of 64^3 values which are run-length
+//! encoded in parallel. Simulation caches are dominated by zero and
+//! near-constant regions, which the codec collapses to a few bytes per run;
+//! data without such runs grows by well under one percent. The buffer is
+//! self-contained: it records the value count, the quantization mode, and
+//! the per-chunk payload sizes, so DecompressGridData needs no extra
+//! context.
+//!
+//! \param[in]  values       The values to compress.
+//! \param[in]  quantization The quantization mode.
+//! \param[out] buffer       The output buffer.
+//!
+void CompressGridData(const std::vector<double>& values,
+                      GridDataQuantization quantization,
+                      std::vector<uint8_t>* buffer);
+
+//!
+//! \brief Decompresses a buffer produced by CompressGridData.
+//!
+//! Chunks are decoded in parallel. \p values is resized to the stored value
+//! count.
+//!
+//! \param[in]  data   The buffer contents.
+//! \param[in]  size   The buffer size in bytes.
+//! \param[out] values The decompressed values.
+//!
+void DecompressGridData(const uint8_t* data, size_t size,
+                        std::vector<double>* values);
+}  // namespace CubbyFlow
+
+#endif
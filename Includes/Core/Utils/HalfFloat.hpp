@@ -0,0 +1,110 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_HALF_FLOAT_HPP
+#define CUBBYFLOW_HALF_FLOAT_HPP
+
+#include <cstdint>
+#include <cstring>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Converts \p value to IEEE 754 half-precision bits.
+//!
+//! Rounds to nearest; overflows saturate to the half-precision limits and
+//! NaN payloads stay non-zero. Shared by the grid data codec and the
+//! half-precision storage grids, so both quantize identically.
+//!
+inline uint16_t DoubleToHalf(double value)
+{
+    const auto f = static_cast<float>(value);
+
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000U);
+    const int32_t exponent =
+        static_cast<int32_t>((bits >> 23) & 0xFFU) - 127 + 15;
+    uint32_t mantissa = bits & 0x007FFFFFU;
+
+    if (exponent >= 31)
+    {
+        // Saturate overflows; keep NaN payloads non-zero.
+        const bool isNaN = (((bits >> 23) & 0xFFU) == 0xFFU) && mantissa != 0;
+        return static_cast<uint16_t>(sign | 0x7BFFU | (isNaN ? 0x0400U : 0));
+    }
+
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+        {
+            return sign;
+        }
+
+        // Subnormal half: shift the implicit bit into the mantissa.
+        mantissa |= 0x00800000U;
+        const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        const uint32_t rounded = (mantissa + (1U << (shift - 1))) >> shift;
+        return static_cast<uint16_t>(sign | rounded);
+    }
+
+    // Round to nearest; the carry may bump the exponent, which the
+    // addition handles for free.
+    const uint32_t rounded =
+        ((static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13)) +
+        ((mantissa >> 12) & 1U);
+    return static_cast<uint16_t>(sign | rounded);
+}
+
+//! Converts IEEE 754 half-precision bits back to a double.
+inline double HalfToDouble(uint16_t value)
+{
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000U) << 16;
+    uint32_t exponent = (value >> 10) & 0x1FU;
+    uint32_t mantissa = value & 0x03FFU;
+
+    uint32_t bits;
+    if (exponent == 0)
+    {
+        if (mantissa == 0)
+        {
+            bits = sign;
+        }
+        else
+        {
+            // Normalize the subnormal half.
+            int32_t e = -1;
+            do
+            {
+                ++e;
+                mantissa <<= 1;
+            } while ((mantissa & 0x0400U) == 0);
+
+            bits = sign | (static_cast<uint32_t>(127 - 15 - e) << 23) |
+                   ((mantissa & 0x03FFU) << 13);
+        }
+    }
+    else if (exponent == 31)
+    {
+        bits = sign | 0x7F800000U | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return static_cast<double>(f);
+}
+}  // namespace CubbyFlow
+
+#endif
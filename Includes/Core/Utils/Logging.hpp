@@ -54,16 +54,22 @@ class Logger final
     //! Deleted move assignment operator.
     Logger& operator=(Logger&&) noexcept = delete;
 
-    //! Writes a value to the buffer stream.
+    //! Writes a value to the buffer stream. Filtered-out severities skip the
+    //! formatting entirely.
     template <typename T>
     const Logger& operator<<(const T& x) const
     {
-        m_buffer << x;
+        if (m_isEnabled)
+        {
+            m_buffer << x;
+        }
+
         return *this;
     }
 
  private:
     LogLevel m_level;
+    bool m_isEnabled;
     mutable std::stringstream m_buffer{};
 };
 
@@ -92,6 +98,27 @@ class Logging
     //! Sets the log level.
     static void SetLevel(LogLevel level);
 
+    //! Returns the log level.
+    [[nodiscard]] static LogLevel GetLevel();
+
+    //!
+    //! \brief Enables or disables asynchronous logging.
+    //!
+    //! When enabled, log calls push their preformatted records into a
+    //! lock-free ring buffer that a background thread drains to the output
+    //! streams, so hot-path logging no longer serializes the calling
+    //! threads on the output mutex. Records keep their per-thread order;
+    //! interleaving between threads is unspecified. Disabling flushes all
+    //! pending records before returning. Default is synchronous.
+    //!
+    static void SetAsyncMode(bool enabled);
+
+    //! Returns true if asynchronous logging is enabled.
+    [[nodiscard]] static bool GetAsyncMode();
+
+    //! Blocks until all pending asynchronous records are written.
+    static void Flush();
+
     //! Mutes the logger.
     static void Mute();
 
@@ -28,10 +28,21 @@ MGResult MGVCycle(const MGMatrix<BlasType>& A, MGParameters<BlasType>& params,
     // 2) if currentLevel is the coarsest grid, goto 5)
     if (currentLevel < A.levels.size() - 1)
     {
-        auto r = buffer;
-        BlasType::Residual(A[currentLevel], (*x)[currentLevel],
-                           (*b)[currentLevel], &(*r)[currentLevel]);
-        params.restrictFunc((*r)[currentLevel], &(*b)[currentLevel + 1]);
+        if (params.restrictResidualFunc)
+        {
+            // Fused kernel: the residual is computed and restricted in one
+            // pass, skipping the full-resolution residual write-out.
+            params.restrictResidualFunc(A[currentLevel], (*x)[currentLevel],
+                                        (*b)[currentLevel],
+                                        &(*b)[currentLevel + 1]);
+        }
+        else
+        {
+            auto r = buffer;
+            BlasType::Residual(A[currentLevel], (*x)[currentLevel],
+                               (*b)[currentLevel], &(*r)[currentLevel]);
+            params.restrictFunc((*r)[currentLevel], &(*b)[currentLevel + 1]);
+        }
 
         BlasType::Set(0.0, &(*x)[currentLevel + 1]);
 
@@ -63,16 +74,19 @@ MGResult MGVCycle(const MGMatrix<BlasType>& A, MGParameters<BlasType>& params,
         params.relaxFunc(A[currentLevel], (*b)[currentLevel],
                          params.numberOfCoarsestIter, params.maxTolerance,
                          &((*x)[currentLevel]), &((*buffer)[currentLevel]));
+    }
+
+    MGResult result;
 
+    // The result of the deeper recursion levels is discarded by the caller,
+    // so only the top level pays for the residual norm.
+    if (currentLevel == 0)
+    {
         BlasType::Residual(A[currentLevel], (*x)[currentLevel],
                            (*b)[currentLevel], &(*buffer)[currentLevel]);
+        result.lastResidualNorm = BlasType::L2Norm((*buffer)[currentLevel]);
     }
 
-    BlasType::Residual(A[currentLevel], (*x)[currentLevel], (*b)[currentLevel],
-                       &(*buffer)[currentLevel]);
-
-    MGResult result;
-    result.lastResidualNorm = BlasType::L2Norm((*buffer)[currentLevel]);
     return result;
 }
 }  // namespace Internal
@@ -57,6 +57,14 @@ using MGCorrectFunc =
     std::function<void(const typename BlasType::VectorType& coarser,
                        typename BlasType::VectorType* finer)>;
 
+//! Multi-grid fused residual-restriction function type.
+template <typename BlasType>
+using MGRestrictResidualFunc =
+    std::function<void(const typename BlasType::MatrixType& A,
+                       const typename BlasType::VectorType& x,
+                       const typename BlasType::VectorType& b,
+                       typename BlasType::VectorType* coarserB)>;
+
 //! Multi-grid input parameter set.
 template <typename BlasType>
 struct MGParameters
@@ -85,6 +93,15 @@ struct MGParameters
     //! Correction function that maps coarser to finer grid.
     MGCorrectFunc<BlasType> correctFunc;
 
+    //!
+    //! \brief Optional fused kernel that computes the residual (b - Ax) and
+    //! restricts it to the coarser grid in a single pass.
+    //!
+    //! When empty, the V-cycle falls back to a separate residual pass
+    //! followed by restrictFunc.
+    //!
+    MGRestrictResidualFunc<BlasType> restrictResidualFunc;
+
     //! Max error tolerance.
     double maxTolerance = 1e-9;
 };
@@ -92,8 +109,9 @@ struct MGParameters
 //! Multi-grid result type.
 struct MGResult
 {
-    //! Lastly measured norm of residual.
-    double lastResidualNorm;
+    //! Lastly measured norm of residual. Only the top level of the V-cycle
+    //! computes this; deeper recursion levels leave it at zero.
+    double lastResidualNorm = 0.0;
 };
 
 //!
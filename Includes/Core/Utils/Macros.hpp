@@ -33,4 +33,62 @@ typedef SSIZE_T ssize_t;
 #define UNUSED_VARIABLE(x) ((void)x)
 #endif
 
+// Opt-in padded alignment for small fixed-size vector/matrix types. When
+// CUBBYFLOW_ALIGNED_VECTOR_TYPES is defined (see CompileOptions.cmake),
+// Vector3 and Matrix3x3 are padded to a multiple of four elements so they
+// load and store as whole SIMD registers and arrays of them stay aligned,
+// letting the compiler emit 4-wide arithmetic. Costs one padding element
+// per vector, and the flag must be applied to every translation unit since
+// it changes type sizes.
+#ifdef CUBBYFLOW_ALIGNED_VECTOR_TYPES
+#define CUBBYFLOW_SMALL_TYPE_ALIGNAS(T) alignas(4 * sizeof(T))
+#else
+#define CUBBYFLOW_SMALL_TYPE_ALIGNAS(T)
+#endif
+
+// Software prefetch hint for a read that will happen a few iterations from
+// now. Compiles to a plain prefetch instruction where available and to a
+// no-op elsewhere; the address does not have to be valid to dereference.
+#if defined(__GNUC__) || defined(__clang__)
+#define CUBBYFLOW_PREFETCH_READ(addr) __builtin_prefetch((addr), 0, 3)
+#elif defined(CUBBYFLOW_WINDOWS) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define CUBBYFLOW_PREFETCH_READ(addr) \
+    _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#else
+#define CUBBYFLOW_PREFETCH_READ(addr) ((void)0)
+#endif
+
+// Per-ISA function multi-versioning for hot, auto-vectorizable loops. The
+// compiler emits one clone of the function per listed instruction set plus
+// a baseline, and the dynamic loader resolves the call to the widest clone
+// the running CPU supports (GNU ifunc), so one shipped binary uses 256- or
+// 512-bit vectors on machines that have them without recompiling. Apply it
+// to free functions holding plain counted loops over raw pointers; it has
+// no effect on templates or lambdas. Only ELF x86-64 targets with a recent
+// GCC or Clang support the attribute; elsewhere the macro compiles to
+// nothing and the configure-time baseline ISA is used.
+#if defined(CUBBYFLOW_LINUX) && defined(__x86_64__) &&         \
+    ((defined(__GNUC__) && !defined(__clang__) &&              \
+      __GNUC__ >= 6) ||                                        \
+     (defined(__clang__) && __clang_major__ >= 14))
+#define CUBBYFLOW_TARGET_CLONES \
+    __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define CUBBYFLOW_TARGET_CLONES
+#endif
+
+// Forces inlining of the small hot accessors (stencil readers, array
+// samplers) that sit between a kernel loop and the raw storage. Compilers
+// usually inline these at -O2 anyway, but when the layered calls trip the
+// inlining heuristic the loop also stops vectorizing; the attribute removes
+// the call boundary deterministically.
+#if defined(__GNUC__) || defined(__clang__)
+#define CUBBYFLOW_FORCE_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define CUBBYFLOW_FORCE_INLINE __forceinline
+#else
+#define CUBBYFLOW_FORCE_INLINE inline
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,93 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_MEMORY_STATS_HPP
+#define CUBBYFLOW_MEMORY_STATS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace CubbyFlow
+{
+//! Memory usage of one named component of a system.
+struct MemoryUsageRecord
+{
+    //! Component name, e.g. "GridSystemData3.velocity".
+    std::string component;
+
+    //! Bytes held by the component.
+    size_t bytes = 0;
+};
+
+//!
+//! \brief Interface for in-engine memory accounting.
+//!
+//! Systems that own significant allocations (grid system data, particle
+//! system data, linear systems, neighbor searchers) implement this
+//! interface and report the exact bytes held per component. Every live
+//! instance is tracked in a global registry, so the memory footprint of a
+//! solver configuration can be inspected — and rejected — before it
+//! exhausts a machine, without external RSS sampling.
+//!
+//! Enumerating the registry calls virtual functions on every registered
+//! instance; do not run it concurrently with the construction or
+//! destruction of reporting systems. Calling it between frames, the way
+//! the profiler is dumped, is safe.
+//!
+class MemoryStats
+{
+ public:
+    //! Registers this instance.
+    MemoryStats();
+
+    //! Registers the new instance; the source stays registered.
+    MemoryStats(const MemoryStats&);
+
+    //! Registers the new instance; the source stays registered until it is
+    //! destroyed.
+    MemoryStats(MemoryStats&&) noexcept;
+
+    //! Unregisters this instance.
+    virtual ~MemoryStats();
+
+    //! Default copy assignment operator; both instances stay registered.
+    MemoryStats& operator=(const MemoryStats&) = default;
+
+    //! Default move assignment operator; both instances stay registered.
+    MemoryStats& operator=(MemoryStats&&) noexcept = default;
+
+    //! Returns a short name identifying the reporting type, used as the
+    //! component prefix when the registry is enumerated.
+    [[nodiscard]] virtual const char* GetMemoryStatsName() const = 0;
+
+    //!
+    //! \brief Appends one record per component owned by this instance.
+    //!
+    //! Component names are reported without the type prefix; bytes count
+    //! the actual allocations, not the reserved capacities, unless noted
+    //! otherwise by the implementation.
+    //!
+    virtual void ReportMemoryUsage(
+        std::vector<MemoryUsageRecord>* records) const = 0;
+
+    //! Returns the total bytes held by this instance.
+    [[nodiscard]] size_t GetMemoryUsage() const;
+
+    //! Appends the records of every live instance, with component names
+    //! prefixed by the owning type name.
+    static void EnumerateMemoryUsage(std::vector<MemoryUsageRecord>* records);
+
+    //! Returns the total bytes held by every live instance.
+    [[nodiscard]] static size_t GetTotalMemoryUsage();
+};
+}  // namespace CubbyFlow
+
+#endif
@@ -28,13 +28,25 @@
 #include <tbb/parallel_reduce.h>
 #include <tbb/parallel_sort.h>
 #include <tbb/task.h>
+#include <tbb/task_arena.h>
 #elif defined(CUBBYFLOW_TASKING_CPP11THREAD)
+#include <chrono>
+#include <functional>
+#include <memory>
 #include <thread>
 #endif
 
+#if defined(CUBBYFLOW_TASKING_OPENMP)
+#include <omp.h>
+#endif
+
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <future>
+#include <memory>
 #include <vector>
 
 #undef max
@@ -44,7 +56,60 @@ namespace CubbyFlow
 {
 namespace Internal
 {
-#if defined(CUBBYFLOW_TASKING_HPX)
+#if defined(CUBBYFLOW_TASKING_CPP11THREAD)
+//! Enqueues \p task on the shared persistent worker pool (see Parallel.cpp).
+//! Workers are spawned lazily on the first call and sleep on a condition
+//! variable between calls, so scheduling costs no thread creation.
+void ScheduleTask(std::function<void()> task);
+
+//! Enqueues \p task on one specific pool worker (workerIndex modulo the pool
+//! size). Pinned tasks are never stolen by other threads, which is what makes
+//! the chunk-to-thread mapping of ExecutionPolicy::ParallelStatic
+//! deterministic across calls.
+void ScheduleTaskOnWorker(size_t workerIndex, std::function<void()> task);
+
+//! Runs queued pool tasks on the calling thread until \p isDone returns true,
+//! sleeping on the pool's condition variable when the queue is empty.
+void HelpWhileWaiting(const std::function<bool()>& isDone);
+
+//!
+//! \brief Future that executes queued pool tasks while waiting.
+//!
+//! Blocking on the pool from inside a pool task (e.g. the recursion in
+//! ParallelMergeSort) could exhaust the fixed-size pool, so waiting lends the
+//! calling thread to the pool instead of parking it.
+//!
+template <typename T>
+class PooledFuture
+{
+ public:
+    PooledFuture() = default;
+
+    explicit PooledFuture(std::future<T>&& f) : m_future(std::move(f))
+    {
+        // Do nothing
+    }
+
+    [[nodiscard]] bool valid() const
+    {
+        return m_future.valid();
+    }
+
+    void wait() const
+    {
+        HelpWhileWaiting([this]() {
+            return m_future.wait_for(std::chrono::seconds::zero()) ==
+                   std::future_status::ready;
+        });
+    }
+
+ private:
+    std::future<T> m_future;
+};
+
+template <typename Task>
+using future = PooledFuture<Task>;
+#elif defined(CUBBYFLOW_TASKING_HPX)
 template <typename Task>
 using future = hpx::future<Task>;
 #else
@@ -90,12 +155,36 @@ inline auto Async(TASK&& fn) -> future<operator_return_t<TASK>>
     return task.get_future();
 
 #elif defined(CUBBYFLOW_TASKING_CPP11THREAD)
-    return std::async(std::launch::async, fn);
+    using package_t = std::packaged_task<operator_return_t<TASK>()>;
+
+    auto task = std::make_shared<package_t>(std::forward<TASK>(fn));
+    auto f = task->get_future();
+
+    ScheduleTask([task]() { (*task)(); });
+
+    return PooledFuture<operator_return_t<TASK>>{ std::move(f) };
 #else
     return std::async(std::launch::deferred, fn);
 #endif
 }
 
+#if defined(CUBBYFLOW_TASKING_CPP11THREAD)
+//! Async variant that pins the task to one specific pool worker.
+template <typename TASK>
+inline auto AsyncOnWorker(size_t workerIndex, TASK&& fn)
+    -> future<operator_return_t<TASK>>
+{
+    using package_t = std::packaged_task<operator_return_t<TASK>()>;
+
+    auto task = std::make_shared<package_t>(std::forward<TASK>(fn));
+    auto f = task->get_future();
+
+    ScheduleTaskOnWorker(workerIndex, [task]() { (*task)(); });
+
+    return PooledFuture<operator_return_t<TASK>>{ std::move(f) };
+}
+#endif
+
 // Adopted from:
 // Radenski, A.
 // Shared Memory, Message Passing, and Hybrid Merge Sorts for Standalone and
@@ -185,6 +274,137 @@ void ParallelMergeSort(RandomIterator a, size_t size, RandomIterator2 temp,
         Merge(a, size, temp, compareFunction);
     }
 }
+
+//! Stable counterpart of Merge: ties take the left run, so the merged order
+//! of equal elements never depends on where the range was split.
+template <typename RandomIterator, typename RandomIterator2,
+          typename CompareFunction>
+void StableMerge(RandomIterator a, size_t size, RandomIterator2 temp,
+                 CompareFunction compareFunction)
+{
+    size_t i1 = 0;
+    size_t i2 = size / 2;
+    size_t tempi = 0;
+
+    while (i1 < size / 2 && i2 < size)
+    {
+        if (compareFunction(a[i2], a[i1]))
+        {
+            temp[tempi] = a[i2];
+            i2++;
+        }
+        else
+        {
+            temp[tempi] = a[i1];
+            i1++;
+        }
+
+        tempi++;
+    }
+
+    while (i1 < size / 2)
+    {
+        temp[tempi] = a[i1];
+        i1++;
+        tempi++;
+    }
+
+    while (i2 < size)
+    {
+        temp[tempi] = a[i2];
+        i2++;
+        tempi++;
+    }
+
+    // Copy sorted temp array into main array, a
+    ParallelFor(ZERO_SIZE, size, [&](size_t i) { a[i] = temp[i]; });
+}
+
+//! Stable parallel merge sort: std::stable_sort at the leaves combined with
+//! StableMerge. The output of a stable sort is uniquely determined by the
+//! input and the comparator, so the result is independent of the split
+//! points and therefore of the thread count and tasking backend.
+template <typename RandomIterator, typename RandomIterator2,
+          typename CompareFunction>
+void ParallelStableMergeSort(RandomIterator a, size_t size,
+                             RandomIterator2 temp, unsigned int numThreads,
+                             CompareFunction compareFunction)
+{
+    if (numThreads == 1)
+    {
+        std::stable_sort(a, a + size, compareFunction);
+    }
+    else if (numThreads > 1)
+    {
+        std::vector<future<void>> pool;
+        pool.reserve(2);
+
+        auto launchRange = [compareFunction](RandomIterator begin, size_t k2,
+                                             RandomIterator2 temp,
+                                             unsigned int numThreads) {
+            ParallelStableMergeSort(begin, k2, temp, numThreads,
+                                    compareFunction);
+        };
+
+        pool.emplace_back(Internal::Async(
+            [=]() { launchRange(a, size / 2, temp, numThreads / 2); }));
+
+        pool.emplace_back(Internal::Async([=]() {
+            launchRange(a + size / 2, size - size / 2, temp + size / 2,
+                        numThreads - numThreads / 2);
+        }));
+
+        // Wait for jobs to finish
+        for (auto& f : pool)
+        {
+            if (f.valid())
+            {
+                f.wait();
+            }
+        }
+
+        StableMerge(a, size, temp, compareFunction);
+    }
+}
+
+//! Returns the number of bits needed to represent indices in [0, n).
+inline size_t BitWidth(size_t n)
+{
+    size_t width = 0;
+    while ((size_t{ 1 } << width) < n)
+    {
+        ++width;
+    }
+    return width;
+}
+
+//! Deinterleaves a Morton code into per-axis indices. Axes are interleaved
+//! cyclically (x, y, z) starting at the LSB; an axis stops contributing once
+//! its \p bits are exhausted, so an elongated domain only pays for the
+//! power-of-two roundup per axis rather than for a full enclosing cube.
+inline void MortonDecode(uint64_t code, const size_t bits[3], size_t index[3])
+{
+    size_t remaining[3] = { bits[0], bits[1], bits[2] };
+    size_t shift[3] = { 0, 0, 0 };
+    index[0] = index[1] = index[2] = 0;
+
+    size_t pos = 0;
+    while (remaining[0] + remaining[1] + remaining[2] > 0)
+    {
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            if (remaining[axis] == 0)
+            {
+                continue;
+            }
+
+            index[axis] |= ((code >> pos) & 1) << shift[axis];
+            ++shift[axis];
+            --remaining[axis];
+            ++pos;
+        }
+    }
+}
 }  // namespace Internal
 
 template <typename RandomIterator, typename T>
@@ -217,11 +437,30 @@ void ParallelFor(IndexType beginIndex, IndexType endIndex,
         return;
     }
 
-    if (policy == ExecutionPolicy::Parallel)
+    if (policy != ExecutionPolicy::Serial)
     {
 #if defined(CUBBYFLOW_TASKING_TBB)
         (void)policy;
-        tbb::parallel_for(beginIndex, endIndex, function);
+        const size_t grainSize = GetParallelForGrainSize();
+        if (grainSize > 0)
+        {
+            // Forward the grain size so that the work-stealing scheduler
+            // splits the range into fixed-size chunks.
+            tbb::parallel_for(
+                tbb::blocked_range<IndexType>(
+                    beginIndex, endIndex, grainSize),
+                [&function](const tbb::blocked_range<IndexType>& range) {
+                    for (IndexType i = range.begin(); i != range.end(); ++i)
+                    {
+                        function(i);
+                    }
+                },
+                tbb::simple_partitioner{});
+        }
+        else
+        {
+            tbb::parallel_for(beginIndex, endIndex, function);
+        }
 #elif defined(CUBBYFLOW_TASKING_HPX)
         (void)policy;
         hpx::parallel::for_loop(hpx::parallel::execution::par, beginIndex,
@@ -232,12 +471,6 @@ void ParallelFor(IndexType beginIndex, IndexType endIndex,
         const unsigned int numThreads =
             (numThreadsHint == 0u) ? 8u : numThreadsHint;
 
-        // Size of a slice for the range functions
-        IndexType n = endIndex - beginIndex + 1;
-        IndexType slice = static_cast<IndexType>(
-            std::round(n / static_cast<double>(numThreads)));
-        slice = std::max(slice, IndexType(1));
-
         // [Helper] Inner loop
         auto launchRange = [&function](IndexType k1, IndexType k2) {
             for (IndexType k = k1; k < k2; ++k)
@@ -246,30 +479,92 @@ void ParallelFor(IndexType beginIndex, IndexType endIndex,
             }
         };
 
-        // Create pool and launch jobs
-        std::vector<std::thread> pool;
+        // Launch jobs on the shared worker pool
+        std::vector<CubbyFlow::Internal::future<void>> pool;
         pool.reserve(numThreads);
-        IndexType i1 = beginIndex;
-        IndexType i2 = std::min(beginIndex + slice, endIndex);
 
-        for (unsigned int i = 0; i + 1 < numThreads && i1 < endIndex; ++i)
+        const size_t grainSize = GetParallelForGrainSize();
+        if (policy == ExecutionPolicy::ParallelStatic)
         {
-            pool.emplace_back(launchRange, i1, i2);
-            i1 = i2;
-            i2 = std::min(i2 + slice, endIndex);
+            // Static chunk scheduling: one contiguous slice per worker, with
+            // slice c pinned to worker c. Every ParallelStatic loop over the
+            // same range lands each slice on the same thread, so pages
+            // first-touched during a fill stay local to the thread (and NUMA
+            // node) that sweeps them in later kernels.
+            IndexType n = endIndex - beginIndex + 1;
+            IndexType slice = static_cast<IndexType>(
+                std::round(n / static_cast<double>(numThreads)));
+            slice = std::max(slice, IndexType(1));
+
+            IndexType i1 = beginIndex;
+            for (unsigned int c = 0; c < numThreads && i1 < endIndex; ++c)
+            {
+                const IndexType i2 = (c + 1 == numThreads)
+                                         ? endIndex
+                                         : std::min(i1 + slice, endIndex);
+                pool.emplace_back(Internal::AsyncOnWorker(
+                    c, [=]() { launchRange(i1, i2); }));
+                i1 = i2;
+            }
         }
+        else if (grainSize > 0)
+        {
+            // Dynamic chunk scheduling: workers claim fixed-size chunks from
+            // a shared counter, balancing irregular per-iteration costs.
+            const size_t numChunks =
+                (static_cast<size_t>(endIndex - beginIndex) + grainSize - 1) /
+                grainSize;
+            const IndexType chunk = static_cast<IndexType>(grainSize);
+            std::atomic<size_t> nextChunk{ 0 };
+
+            auto claimChunks = [&]() {
+                size_t c;
+                while ((c = nextChunk.fetch_add(1)) < numChunks)
+                {
+                    const IndexType k1 =
+                        beginIndex + static_cast<IndexType>(c) * chunk;
+                    const IndexType k2 = std::min(k1 + chunk, endIndex);
+                    launchRange(k1, k2);
+                }
+            };
 
-        if (i1 < endIndex)
+            for (unsigned int i = 0; i < numThreads && i < numChunks; ++i)
+            {
+                pool.emplace_back(Internal::Async(claimChunks));
+            }
+        }
+        else
         {
-            pool.emplace_back(launchRange, i1, endIndex);
+            // Size of a slice for the range functions
+            IndexType n = endIndex - beginIndex + 1;
+            IndexType slice = static_cast<IndexType>(
+                std::round(n / static_cast<double>(numThreads)));
+            slice = std::max(slice, IndexType(1));
+
+            IndexType i1 = beginIndex;
+            IndexType i2 = std::min(beginIndex + slice, endIndex);
+
+            for (unsigned int i = 0; i + 1 < numThreads && i1 < endIndex; ++i)
+            {
+                pool.emplace_back(
+                    Internal::Async([=]() { launchRange(i1, i2); }));
+                i1 = i2;
+                i2 = std::min(i2 + slice, endIndex);
+            }
+
+            if (i1 < endIndex)
+            {
+                pool.emplace_back(
+                    Internal::Async([=]() { launchRange(i1, endIndex); }));
+            }
         }
 
         // Wait for jobs to finish
-        for (std::thread& t : pool)
+        for (auto& f : pool)
         {
-            if (t.joinable())
+            if (f.valid())
             {
-                t.join();
+                f.wait();
             }
         }
 #else
@@ -303,6 +598,194 @@ void ParallelFor(IndexType beginIndex, IndexType endIndex,
     }
 }
 
+
+template <typename IndexType, typename Function>
+void ParallelForWithWorkerIndex(IndexType beginIndex, IndexType endIndex,
+                                const Function& function,
+                                ExecutionPolicy policy)
+{
+    if (beginIndex > endIndex)
+    {
+        return;
+    }
+
+    if (policy == ExecutionPolicy::Serial)
+    {
+        for (auto i = beginIndex; i < endIndex; ++i)
+        {
+            function(ZERO_SIZE, i);
+        }
+
+        return;
+    }
+
+#if defined(CUBBYFLOW_TASKING_TBB)
+    // A chunk never migrates threads mid-execution, so the arena thread index
+    // is stable for the whole loop body invocation.
+    tbb::parallel_for(beginIndex, endIndex, [&function](IndexType i) {
+        const int slot = tbb::this_task_arena::current_thread_index();
+        function(static_cast<size_t>(std::max(slot, 0)), i);
+    });
+#elif defined(CUBBYFLOW_TASKING_CPP11THREAD)
+    // Estimate number of threads in the pool
+    const unsigned int numThreadsHint = GetMaxNumberOfThreads();
+    const unsigned int numThreads =
+        (numThreadsHint == 0u) ? 8u : numThreadsHint;
+
+    // [Helper] Inner loop
+    auto launchRange = [&function](size_t workerIndex, IndexType k1,
+                                   IndexType k2) {
+        for (IndexType k = k1; k < k2; ++k)
+        {
+            function(workerIndex, k);
+        }
+    };
+
+    // Launch jobs on the shared worker pool; the slot is the task ordinal,
+    // which is unique per task, and every task runs on one thread from start
+    // to finish.
+    std::vector<CubbyFlow::Internal::future<void>> pool;
+    pool.reserve(numThreads);
+
+    const size_t grainSize = GetParallelForGrainSize();
+    if (policy == ExecutionPolicy::ParallelStatic)
+    {
+        // Same pinned slicing as the 1-D ParallelFor; slice c runs on pool
+        // worker c, so the reported slot coincides with the worker index.
+        IndexType n = endIndex - beginIndex + 1;
+        IndexType slice = static_cast<IndexType>(
+            std::round(n / static_cast<double>(numThreads)));
+        slice = std::max(slice, IndexType(1));
+
+        IndexType i1 = beginIndex;
+        for (unsigned int c = 0; c < numThreads && i1 < endIndex; ++c)
+        {
+            const IndexType i2 = (c + 1 == numThreads)
+                                     ? endIndex
+                                     : std::min(i1 + slice, endIndex);
+            const size_t workerIndex = c;
+            pool.emplace_back(Internal::AsyncOnWorker(
+                c, [=]() { launchRange(workerIndex, i1, i2); }));
+            i1 = i2;
+        }
+    }
+    else if (grainSize > 0)
+    {
+        // Dynamic chunk scheduling; a task keeps its slot across every chunk
+        // it claims.
+        const size_t numChunks =
+            (static_cast<size_t>(endIndex - beginIndex) + grainSize - 1) /
+            grainSize;
+        const IndexType chunk = static_cast<IndexType>(grainSize);
+
+        // The chunk cursor is shared by value; the tasks can outlive this
+        // block since the futures are only awaited at the end of the
+        // function.
+        const auto nextChunk = std::make_shared<std::atomic<size_t>>(0);
+
+        auto claimChunks = [&launchRange, nextChunk, numChunks, chunk,
+                            beginIndex, endIndex](size_t workerIndex) {
+            size_t c;
+            while ((c = nextChunk->fetch_add(1)) < numChunks)
+            {
+                const IndexType k1 =
+                    beginIndex + static_cast<IndexType>(c) * chunk;
+                const IndexType k2 = std::min(k1 + chunk, endIndex);
+                launchRange(workerIndex, k1, k2);
+            }
+        };
+
+        for (unsigned int i = 0; i < numThreads && i < numChunks; ++i)
+        {
+            pool.emplace_back(
+                Internal::Async([claimChunks, workerIndex = size_t(i)]() {
+                    claimChunks(workerIndex);
+                }));
+        }
+    }
+    else
+    {
+        // Size of a slice for the range functions
+        IndexType n = endIndex - beginIndex + 1;
+        IndexType slice = static_cast<IndexType>(
+            std::round(n / static_cast<double>(numThreads)));
+        slice = std::max(slice, IndexType(1));
+
+        unsigned int c = 0;
+        IndexType i1 = beginIndex;
+        IndexType i2 = std::min(beginIndex + slice, endIndex);
+
+        for (; c + 1 < numThreads && i1 < endIndex; ++c)
+        {
+            const size_t workerIndex = c;
+            pool.emplace_back(Internal::Async(
+                [=]() { launchRange(workerIndex, i1, i2); }));
+            i1 = i2;
+            i2 = std::min(i2 + slice, endIndex);
+        }
+
+        if (i1 < endIndex)
+        {
+            const size_t workerIndex = c;
+            pool.emplace_back(Internal::Async(
+                [=]() { launchRange(workerIndex, i1, endIndex); }));
+        }
+    }
+
+    // Wait for jobs to finish
+    for (auto& f : pool)
+    {
+        if (f.valid())
+        {
+            f.wait();
+        }
+    }
+#elif defined(CUBBYFLOW_TASKING_OPENMP)
+#pragma omp parallel for
+#if defined(_MSC_VER) && !defined(__INTEL_COMPILER)
+    for (ssize_t i = beginIndex; i < static_cast<ssize_t>(endIndex); ++i)
+    {
+#else   // !MSVC || Intel
+    for (auto i = beginIndex; i < endIndex; ++i)
+    {
+#endif  // MSVC && !Intel
+        function(static_cast<size_t>(omp_get_thread_num()), i);
+    }
+#else
+    // Remaining backends (HPX, serial fallback): hand out slots through a
+    // shared free-list. Each range chunk runs on one thread from start to
+    // finish, and at most GetMaxNumberOfWorkerSlots() chunks are in flight.
+    const size_t numSlots = GetMaxNumberOfWorkerSlots();
+    const std::unique_ptr<std::atomic<bool>[]> inUse{
+        new std::atomic<bool>[numSlots]
+    };
+    for (size_t s = 0; s < numSlots; ++s)
+    {
+        inUse[s].store(false);
+    }
+
+    ParallelRangeFor(
+        beginIndex, endIndex,
+        [&](IndexType i1, IndexType i2) {
+            size_t slot = 0;
+            bool expected = false;
+            while (!inUse[slot].compare_exchange_strong(expected, true))
+            {
+                expected = false;
+                slot = (slot + 1) % numSlots;
+            }
+
+            for (IndexType i = i1; i < i2; ++i)
+            {
+                function(slot, i);
+            }
+
+            inUse[slot].store(false);
+        },
+        policy);
+#endif
+}
+
 template <typename IndexType, typename Function>
 void ParallelRangeFor(IndexType beginIndex, IndexType endIndex,
                       const Function& function, ExecutionPolicy policy)
@@ -312,7 +795,7 @@ void ParallelRangeFor(IndexType beginIndex, IndexType endIndex,
         return;
     }
 
-    if (policy == ExecutionPolicy::Parallel)
+    if (policy != ExecutionPolicy::Serial)
     {
 #if defined(CUBBYFLOW_TASKING_TBB)
         tbb::parallel_for(
@@ -338,17 +821,36 @@ void ParallelRangeFor(IndexType beginIndex, IndexType endIndex,
         IndexType i1 = beginIndex;
         IndexType i2 = std::min(beginIndex + slice, endIndex);
 
-        for (unsigned int i = 0; i + 1 < numThreads && i1 < endIndex; ++i)
+#if defined(CUBBYFLOW_TASKING_CPP11THREAD)
+        if (policy == ExecutionPolicy::ParallelStatic)
         {
-            pool.emplace_back(Internal::Async([=]() { function(i1, i2); }));
-            i1 = i2;
-            i2 = std::min(i2 + slice, endIndex);
+            // Pin slice c to worker c for a deterministic chunk-to-thread
+            // mapping (see the 1-D ParallelFor).
+            for (unsigned int c = 0; c < numThreads && i1 < endIndex; ++c)
+            {
+                i2 = (c + 1 == numThreads) ? endIndex
+                                           : std::min(i1 + slice, endIndex);
+                pool.emplace_back(
+                    Internal::AsyncOnWorker(c, [=]() { function(i1, i2); }));
+                i1 = i2;
+            }
         }
-
-        if (i1 < endIndex)
+        else
+#endif
         {
-            pool.emplace_back(
-                Internal::Async([=]() { function(i1, endIndex); }));
+            for (unsigned int i = 0; i + 1 < numThreads && i1 < endIndex; ++i)
+            {
+                pool.emplace_back(
+                    Internal::Async([=]() { function(i1, i2); }));
+                i1 = i2;
+                i2 = std::min(i2 + slice, endIndex);
+            }
+
+            if (i1 < endIndex)
+            {
+                pool.emplace_back(
+                    Internal::Async([=]() { function(i1, endIndex); }));
+            }
         }
 
         // Wait for jobs to finish
@@ -367,6 +869,63 @@ void ParallelRangeFor(IndexType beginIndex, IndexType endIndex,
     }
 }
 
+template <typename IndexType, typename CostFunction, typename Function>
+void ParallelRangeForWeighted(IndexType beginIndex, IndexType endIndex,
+                              const CostFunction& cost,
+                              const Function& function, ExecutionPolicy policy)
+{
+    if (beginIndex >= endIndex)
+    {
+        return;
+    }
+
+    if (policy == ExecutionPolicy::Serial)
+    {
+        function(beginIndex, endIndex);
+        return;
+    }
+
+    const unsigned int numThreadsHint = GetMaxNumberOfThreads();
+    const unsigned int numThreads = numThreadsHint == 0u ? 8u : numThreadsHint;
+
+    double totalCost = 0.0;
+    for (IndexType i = beginIndex; i < endIndex; ++i)
+    {
+        totalCost += static_cast<double>(cost(i));
+    }
+
+    if (totalCost <= 0.0)
+    {
+        ParallelRangeFor(beginIndex, endIndex, function, policy);
+        return;
+    }
+
+    // Cut the range where the running cost crosses equal shares of the
+    // total. Every cut advances by at least one index, so the chunk bounds
+    // stay strictly monotonic and cover the whole range.
+    const double share = totalCost / static_cast<double>(numThreads);
+
+    std::vector<IndexType> bounds;
+    bounds.push_back(beginIndex);
+
+    double running = 0.0;
+    for (IndexType i = beginIndex; i < endIndex; ++i)
+    {
+        running += static_cast<double>(cost(i));
+
+        if (running >= static_cast<double>(bounds.size()) * share &&
+            i + 1 < endIndex && bounds.size() < numThreads)
+        {
+            bounds.push_back(i + 1);
+        }
+    }
+    bounds.push_back(endIndex);
+
+    ParallelFor(
+        ZERO_SIZE, bounds.size() - 1,
+        [&](size_t c) { function(bounds[c], bounds[c + 1]); }, policy);
+}
+
 template <typename IndexType, typename Function>
 void ParallelFor(IndexType beginIndexX, IndexType endIndexX,
                  IndexType beginIndexY, IndexType endIndexY,
@@ -402,14 +961,18 @@ void ParallelFor(IndexType beginIndexX, IndexType endIndexX,
                  IndexType beginIndexZ, IndexType endIndexZ,
                  const Function& function, ExecutionPolicy policy)
 {
-    ParallelFor(
-        beginIndexZ, endIndexZ,
-        [&](IndexType k) {
-            for (IndexType j = beginIndexY; j < endIndexY; ++j)
+    ParallelRangeFor(
+        beginIndexX, endIndexX, beginIndexY, endIndexY, beginIndexZ, endIndexZ,
+        [&](IndexType iBegin, IndexType iEnd, IndexType jBegin, IndexType jEnd,
+            IndexType kBegin, IndexType kEnd) {
+            for (IndexType k = kBegin; k < kEnd; ++k)
             {
-                for (IndexType i = beginIndexX; i < endIndexX; ++i)
+                for (IndexType j = jBegin; j < jEnd; ++j)
                 {
-                    function(i, j, k);
+                    for (IndexType i = iBegin; i < iEnd; ++i)
+                    {
+                        function(i, j, k);
+                    }
                 }
             }
         },
@@ -422,11 +985,147 @@ void ParallelRangeFor(IndexType beginIndexX, IndexType endIndexX,
                       IndexType beginIndexZ, IndexType endIndexZ,
                       const Function& function, ExecutionPolicy policy)
 {
+    if (beginIndexX >= endIndexX || beginIndexY >= endIndexY ||
+        beginIndexZ >= endIndexZ)
+    {
+        return;
+    }
+
+    const size_t numY = static_cast<size_t>(endIndexY - beginIndexY);
+    const size_t numZ = static_cast<size_t>(endIndexZ - beginIndexZ);
+
+    // Split the outer Z axis first and, when it alone cannot keep every
+    // worker busy (thin-slab domains such as 1024x1024x64 on wide machines),
+    // split Y as well. A few blocks per worker keep the tail balanced. The
+    // unit-stride X axis is never split.
+    const size_t targetBlocks = 4 * GetMaxNumberOfWorkerSlots();
+    const size_t splitsZ = std::min(numZ, targetBlocks);
+    size_t splitsY = 1;
+    if (policy != ExecutionPolicy::Serial && splitsZ < targetBlocks)
+    {
+        splitsY = std::min(numY, targetBlocks / splitsZ);
+    }
+
+    if (splitsY <= 1)
+    {
+        ParallelRangeFor(
+            beginIndexZ, endIndexZ,
+            [&](IndexType kBegin, IndexType kEnd) {
+                function(beginIndexX, endIndexX, beginIndexY, endIndexY,
+                         kBegin, kEnd);
+            },
+            policy);
+        return;
+    }
+
+    ParallelFor(
+        ZERO_SIZE, splitsY * splitsZ,
+        [&](size_t blockIdx) {
+            const size_t blockY = blockIdx % splitsY;
+            const size_t blockZ = blockIdx / splitsY;
+
+            const size_t jBegin = (numY * blockY) / splitsY;
+            const size_t jEnd = (numY * (blockY + 1)) / splitsY;
+            const size_t kBegin = (numZ * blockZ) / splitsZ;
+            const size_t kEnd = (numZ * (blockZ + 1)) / splitsZ;
+
+            function(beginIndexX, endIndexX,
+                     beginIndexY + static_cast<IndexType>(jBegin),
+                     beginIndexY + static_cast<IndexType>(jEnd),
+                     beginIndexZ + static_cast<IndexType>(kBegin),
+                     beginIndexZ + static_cast<IndexType>(kEnd));
+        },
+        policy);
+}
+
+template <typename IndexType, typename Function>
+void ParallelTiledFor(IndexType beginIndexX, IndexType endIndexX,
+                      IndexType beginIndexY, IndexType endIndexY,
+                      IndexType beginIndexZ, IndexType endIndexZ,
+                      const Function& function, IndexType tileSize,
+                      ExecutionPolicy policy)
+{
+    if (beginIndexX >= endIndexX || beginIndexY >= endIndexY ||
+        beginIndexZ >= endIndexZ || tileSize <= 0)
+    {
+        return;
+    }
+
+    const IndexType numTilesX =
+        (endIndexX - beginIndexX + tileSize - 1) / tileSize;
+    const IndexType numTilesY =
+        (endIndexY - beginIndexY + tileSize - 1) / tileSize;
+    const IndexType numTilesZ =
+        (endIndexZ - beginIndexZ + tileSize - 1) / tileSize;
+
+    // Parallelize over whole tiles so every tile is traversed by a single
+    // thread and keeps its working set in cache.
+    ParallelFor(
+        static_cast<IndexType>(0), numTilesX * numTilesY * numTilesZ,
+        [&](IndexType tileIdx) {
+            const IndexType tileX = tileIdx % numTilesX;
+            const IndexType tileY = (tileIdx / numTilesX) % numTilesY;
+            const IndexType tileZ = tileIdx / (numTilesX * numTilesY);
+
+            const IndexType iBegin = beginIndexX + tileX * tileSize;
+            const IndexType jBegin = beginIndexY + tileY * tileSize;
+            const IndexType kBegin = beginIndexZ + tileZ * tileSize;
+            const IndexType iEnd = std::min(iBegin + tileSize, endIndexX);
+            const IndexType jEnd = std::min(jBegin + tileSize, endIndexY);
+            const IndexType kEnd = std::min(kBegin + tileSize, endIndexZ);
+
+            for (IndexType k = kBegin; k < kEnd; ++k)
+            {
+                for (IndexType j = jBegin; j < jEnd; ++j)
+                {
+                    for (IndexType i = iBegin; i < iEnd; ++i)
+                    {
+                        function(i, j, k);
+                    }
+                }
+            }
+        },
+        policy);
+}
+
+template <typename IndexType, typename Function>
+void ParallelMortonFor(IndexType beginIndexX, IndexType endIndexX,
+                       IndexType beginIndexY, IndexType endIndexY,
+                       IndexType beginIndexZ, IndexType endIndexZ,
+                       const Function& function, ExecutionPolicy policy)
+{
+    if (beginIndexX >= endIndexX || beginIndexY >= endIndexY ||
+        beginIndexZ >= endIndexZ)
+    {
+        return;
+    }
+
+    const size_t sizes[3] = { static_cast<size_t>(endIndexX - beginIndexX),
+                              static_cast<size_t>(endIndexY - beginIndexY),
+                              static_cast<size_t>(endIndexZ - beginIndexZ) };
+    const size_t bits[3] = { Internal::BitWidth(sizes[0]),
+                             Internal::BitWidth(sizes[1]),
+                             Internal::BitWidth(sizes[2]) };
+    const uint64_t numCodes = uint64_t{ 1 } << (bits[0] + bits[1] + bits[2]);
+
+    // Contiguous code ranges map to compact spatial blocks, so chunking the
+    // curve across threads preserves its locality.
     ParallelRangeFor(
-        beginIndexZ, endIndexZ,
-        [&](IndexType kBegin, IndexType kEnd) {
-            function(beginIndexX, endIndexX, beginIndexY, endIndexY, kBegin,
-                     kEnd);
+        uint64_t{ 0 }, numCodes,
+        [&](uint64_t codeBegin, uint64_t codeEnd) {
+            size_t index[3];
+            for (uint64_t code = codeBegin; code < codeEnd; ++code)
+            {
+                Internal::MortonDecode(code, bits, index);
+                if (index[0] < sizes[0] && index[1] < sizes[1] &&
+                    index[2] < sizes[2])
+                {
+                    function(
+                        beginIndexX + static_cast<IndexType>(index[0]),
+                        beginIndexY + static_cast<IndexType>(index[1]),
+                        beginIndexZ + static_cast<IndexType>(index[2]));
+                }
+            }
         },
         policy);
 }
@@ -442,7 +1141,53 @@ Value ParallelReduce(IndexType beginIndex, IndexType endIndex,
         return identity;
     }
 
-    if (policy == ExecutionPolicy::Parallel)
+    if (policy != ExecutionPolicy::Serial && GetDeterministicExecution())
+    {
+        // The engine-wide determinism switch upgrades every parallel
+        // reduction to the order-stable path.
+        policy = ExecutionPolicy::ParallelDeterministic;
+    }
+
+    if (policy == ExecutionPolicy::ParallelDeterministic)
+    {
+        // Fixed-size chunks combined through a fixed binary tree: the result
+        // depends on neither the thread count nor the completion order, so
+        // floating-point reductions are bit-stable across reruns.
+        constexpr size_t CHUNK_SIZE = 4096;
+        const auto n = static_cast<size_t>(endIndex - beginIndex);
+        const size_t numChunks = (n + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+        if (numChunks <= 1)
+        {
+            return function(beginIndex, endIndex, identity);
+        }
+
+        std::vector<Value> partials(numChunks, identity);
+        ParallelFor(
+            ZERO_SIZE, numChunks,
+            [&](size_t c) {
+                const IndexType k1 =
+                    beginIndex + static_cast<IndexType>(c * CHUNK_SIZE);
+                const IndexType k2 = std::min(
+                    k1 + static_cast<IndexType>(CHUNK_SIZE), endIndex);
+                partials[c] = function(k1, k2, identity);
+            },
+            ExecutionPolicy::Parallel);
+
+        for (size_t stride = 1; stride < numChunks; stride *= 2)
+        {
+            for (size_t i = 0; i + stride < numChunks; i += 2 * stride)
+            {
+                partials[i] = reduce(partials[i], partials[i + stride]);
+            }
+        }
+
+        return partials[0];
+    }
+
+    // ParallelStatic falls back to the dynamic reduction; partial results
+    // are gathered on the caller either way.
+    if (policy != ExecutionPolicy::Serial)
     {
 #if defined(CUBBYFLOW_TASKING_TBB)
         return tbb::parallel_reduce(
@@ -538,7 +1283,28 @@ void ParallelSort(RandomIterator begin, RandomIterator end,
         return;
     }
 
-    if (policy == ExecutionPolicy::Parallel)
+    if (policy != ExecutionPolicy::Serial && GetDeterministicExecution())
+    {
+        // Backend-independent path: a stable sort's output is uniquely
+        // determined by the input and the comparator, so the result matches
+        // across thread counts and tasking backends.
+        const size_t size = static_cast<size_t>(end - begin);
+
+        using value_type =
+            typename std::iterator_traits<RandomIterator>::value_type;
+        std::vector<value_type> temp(size);
+
+        const unsigned int numThreadsHint = GetMaxNumberOfThreads();
+        const unsigned int numThreads =
+            (numThreadsHint == 0u) ? 8u : numThreadsHint;
+
+        Internal::ParallelStableMergeSort(begin, size, temp.begin(),
+                                          numThreads, compareFunction);
+
+        return;
+    }
+
+    if (policy != ExecutionPolicy::Serial)
     {
 #if defined(CUBBYFLOW_TASKING_HPX)
         hpx::parallel::sort(hpx::parallel::execution::par, begin, end,
@@ -567,6 +1333,235 @@ void ParallelSort(RandomIterator begin, RandomIterator end,
         std::sort(begin, end, compareFunction);
     }
 }
+
+template <typename KeyIterator, typename ValueIterator>
+void ParallelRadixSort(KeyIterator beginKey, KeyIterator endKey,
+                       ValueIterator beginValue, ExecutionPolicy policy)
+{
+    using KeyType = typename std::iterator_traits<KeyIterator>::value_type;
+    using ValueType = typename std::iterator_traits<ValueIterator>::value_type;
+
+    static_assert(std::is_integral<KeyType>::value &&
+                      std::is_unsigned<KeyType>::value,
+                  "ParallelRadixSort requires unsigned integer keys");
+
+    constexpr size_t RADIX_BITS = 8;
+    constexpr size_t NUM_BUCKETS = size_t(1) << RADIX_BITS;
+
+    const size_t size = static_cast<size_t>(endKey - beginKey);
+    if (size < 2)
+    {
+        return;
+    }
+
+    // Find the bit positions that actually differ so that passes over
+    // constant bytes (typically the high bytes of small hash keys) are
+    // skipped entirely.
+    const KeyType firstKey = *beginKey;
+    const KeyType diffBits = ParallelReduce(
+        ZERO_SIZE, size, KeyType(0),
+        [&](size_t start, size_t end, KeyType init) {
+            KeyType bits = init;
+            for (size_t i = start; i < end; ++i)
+            {
+                bits |= static_cast<KeyType>(beginKey[i] ^ firstKey);
+            }
+            return bits;
+        },
+        [](KeyType a, KeyType b) { return static_cast<KeyType>(a | b); },
+        policy);
+
+    if (diffBits == 0)
+    {
+        return;
+    }
+
+    const unsigned int numThreadsHint =
+        (policy == ExecutionPolicy::Serial) ? 1u : GetMaxNumberOfThreads();
+    const unsigned int numThreads = (numThreadsHint == 0u) ? 8u : numThreadsHint;
+    const size_t numChunks =
+        std::max(std::min(static_cast<size_t>(numThreads), size / NUM_BUCKETS),
+                 size_t(1));
+
+    std::vector<KeyType> tempKeys(size);
+    std::vector<ValueType> tempValues(size);
+    bool inTemp = false;
+
+    for (size_t shift = 0; shift < sizeof(KeyType) * 8; shift += RADIX_BITS)
+    {
+        if (((diffBits >> shift) & KeyType(NUM_BUCKETS - 1)) == 0)
+        {
+            continue;
+        }
+
+        KeyType* srcKeys = inTemp ? tempKeys.data() : &beginKey[0];
+        ValueType* srcValues = inTemp ? tempValues.data() : &beginValue[0];
+        KeyType* dstKeys = inTemp ? &beginKey[0] : tempKeys.data();
+        ValueType* dstValues = inTemp ? &beginValue[0] : tempValues.data();
+
+        // Per-chunk digit histograms
+        std::vector<std::array<size_t, NUM_BUCKETS>> histograms(numChunks);
+        ParallelFor(
+            ZERO_SIZE, numChunks,
+            [&](size_t c) {
+                std::array<size_t, NUM_BUCKETS>& histogram = histograms[c];
+                histogram.fill(0);
+
+                const size_t chunkBegin = size * c / numChunks;
+                const size_t chunkEnd = size * (c + 1) / numChunks;
+                for (size_t i = chunkBegin; i < chunkEnd; ++i)
+                {
+                    ++histogram[(srcKeys[i] >> shift) & (NUM_BUCKETS - 1)];
+                }
+            },
+            policy);
+
+        // Exclusive scan over (digit, chunk) yields the stable scatter
+        // offset of every chunk's first element per digit
+        size_t runningOffset = 0;
+        for (size_t d = 0; d < NUM_BUCKETS; ++d)
+        {
+            for (size_t c = 0; c < numChunks; ++c)
+            {
+                const size_t count = histograms[c][d];
+                histograms[c][d] = runningOffset;
+                runningOffset += count;
+            }
+        }
+
+        // Stable scatter; each chunk owns disjoint destination ranges
+        ParallelFor(
+            ZERO_SIZE, numChunks,
+            [&](size_t c) {
+                std::array<size_t, NUM_BUCKETS>& offsets = histograms[c];
+
+                const size_t chunkBegin = size * c / numChunks;
+                const size_t chunkEnd = size * (c + 1) / numChunks;
+                for (size_t i = chunkBegin; i < chunkEnd; ++i)
+                {
+                    const size_t bucket =
+                        (srcKeys[i] >> shift) & (NUM_BUCKETS - 1);
+                    const size_t dst = offsets[bucket]++;
+
+                    dstKeys[dst] = srcKeys[i];
+                    dstValues[dst] = srcValues[i];
+                }
+            },
+            policy);
+
+        inTemp = !inTemp;
+    }
+
+    if (inTemp)
+    {
+        ParallelFor(
+            ZERO_SIZE, size,
+            [&](size_t i) {
+                beginKey[i] = tempKeys[i];
+                beginValue[i] = tempValues[i];
+            },
+            policy);
+    }
+}
+template <typename RandomIterator, typename KeyExtractor>
+void ParallelSortByKey(RandomIterator begin, RandomIterator end,
+                       KeyExtractor keyExtractor, ExecutionPolicy policy)
+{
+    using ValueType =
+        typename std::iterator_traits<RandomIterator>::value_type;
+    using KeyType = typename std::remove_cv<typename std::remove_reference<
+        decltype(keyExtractor(*begin))>::type>::type;
+
+    static_assert(
+        std::is_integral<KeyType>::value && std::is_unsigned<KeyType>::value,
+        "ParallelSortByKey requires a key extractor returning unsigned "
+        "integers");
+
+    const size_t size = static_cast<size_t>(end - begin);
+    if (size < 2)
+    {
+        return;
+    }
+
+    // Sort (key, index) pairs instead of the elements themselves; the
+    // payload stays in place until the final gather.
+    std::vector<KeyType> keys(size);
+    std::vector<size_t> permutation(size);
+
+    ParallelFor(
+        ZERO_SIZE, size,
+        [&](size_t i) {
+            keys[i] = keyExtractor(begin[i]);
+            permutation[i] = i;
+        },
+        policy);
+
+    ParallelRadixSort(keys.begin(), keys.end(), permutation.begin(), policy);
+
+    // Apply the permutation in one parallel gather. Each source index occurs
+    // exactly once in the permutation, so moving from it is safe.
+    std::vector<ValueType> sorted(size);
+
+    ParallelFor(
+        ZERO_SIZE, size,
+        [&](size_t i) { sorted[i] = std::move(begin[permutation[i]]); },
+        policy);
+
+    ParallelFor(
+        ZERO_SIZE, size, [&](size_t i) { begin[i] = std::move(sorted[i]); },
+        policy);
+}
+
+template <typename T>
+PerWorkerScratch<T>::PerWorkerScratch()
+    : m_entries(GetMaxNumberOfWorkerSlots())
+{
+    // Do nothing
+}
+
+template <typename T>
+PerWorkerScratch<T>::PerWorkerScratch(const T& initialValue)
+    : m_entries(GetMaxNumberOfWorkerSlots(), Entry{ initialValue })
+{
+    // Do nothing
+}
+
+template <typename T>
+size_t PerWorkerScratch<T>::size() const
+{
+    return m_entries.size();
+}
+
+template <typename T>
+T& PerWorkerScratch<T>::At(size_t workerIndex)
+{
+    return m_entries[workerIndex].value;
+}
+
+template <typename T>
+const T& PerWorkerScratch<T>::At(size_t workerIndex) const
+{
+    return m_entries[workerIndex].value;
+}
+
+template <typename T>
+void PerWorkerScratch<T>::Reset(const T& value)
+{
+    for (Entry& entry : m_entries)
+    {
+        entry.value = value;
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void PerWorkerScratch<T>::ForEach(Callback callback)
+{
+    for (Entry& entry : m_entries)
+    {
+        callback(entry.value);
+    }
+}
 }  // namespace CubbyFlow
 
 #endif
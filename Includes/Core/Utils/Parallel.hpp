@@ -11,13 +11,36 @@
 #ifndef CUBBYFLOW_PARALLEL_HPP
 #define CUBBYFLOW_PARALLEL_HPP
 
+#include <cstddef>
+#include <vector>
+
 namespace CubbyFlow
 {
-//! Execution policy tag.
+//!
+//! \brief Execution policy tag.
+//!
+//! ParallelStatic runs in parallel like Parallel, but splits the index range
+//! into one contiguous chunk per worker thread and always assigns chunk c to
+//! worker c. Repeated loops over the same range therefore land each chunk on
+//! the same thread. On NUMA machines, using ParallelStatic both for the fill
+//! that initializes a grid and for the kernels that later sweep it keeps each
+//! chunk on the node that first touched its pages, avoiding remote-socket
+//! traffic. Backends with their own work-stealing scheduler (TBB, HPX,
+//! OpenMP) treat ParallelStatic as Parallel.
+//!
+//! ParallelDeterministic runs like Parallel, but ParallelReduce splits the
+//! range into fixed-size chunks and combines the partial results through a
+//! fixed binary tree, so floating-point reductions return bit-identical
+//! values across reruns regardless of thread count or completion order.
+//! Functions other than ParallelReduce treat ParallelDeterministic as
+//! Parallel.
+//!
 enum class ExecutionPolicy
 {
     Serial,
-    Parallel
+    Parallel,
+    ParallelStatic,
+    ParallelDeterministic
 };
 
 //!
@@ -60,6 +83,32 @@ void ParallelFor(IndexType beginIndex, IndexType endIndex,
                  const Function& function,
                  ExecutionPolicy policy = ExecutionPolicy::Parallel);
 
+//!
+//! \brief      Makes a for-loop from \p beginIndex to \p endIndex in
+//!             parallel, passing a stable worker slot index to the function.
+//!
+//! This function behaves like the 1-D ParallelFor, but the function object is
+//! called as function(workerIndex, i) with a worker slot index in
+//! [0, GetMaxNumberOfWorkerSlots()). No two concurrently running calls share
+//! a slot, and a worker keeps its slot for every index it visits, so the slot
+//! can address per-worker accumulators or scratch buffers (see
+//! PerWorkerScratch) without locks. Unlike thread_local storage, the slots
+//! stay valid under backends that migrate tasks between threads. The order of
+//! the visit is not guaranteed due to the nature of parallel execution.
+//!
+//! \param[in]  beginIndex The begin index.
+//! \param[in]  endIndex   The end index.
+//! \param[in]  function   The function to call as function(workerIndex, i).
+//! \param[in]  policy     The execution policy (parallel or serial).
+//!
+//! \tparam     IndexType  Index type.
+//! \tparam     Function   Function type.
+//!
+template <typename IndexType, typename Function>
+void ParallelForWithWorkerIndex(
+    IndexType beginIndex, IndexType endIndex, const Function& function,
+    ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
 //!
 //! \brief      Makes a range-loop from \p beginIndex \p to endIndex in
 //!             parallel.
@@ -82,6 +131,35 @@ void ParallelRangeFor(IndexType beginIndex, IndexType endIndex,
                       const Function& function,
                       ExecutionPolicy policy = ExecutionPolicy::Parallel);
 
+//!
+//! \brief      Makes a range-loop from \p beginIndex to \p endIndex in
+//!             parallel, splitting the range by the given per-index cost.
+//!
+//! This function behaves like the 1-D ParallelRangeFor, but instead of
+//! cutting the range into equal index counts it cuts it where the running
+//! cost crosses equal shares of the total, so each chunk carries roughly the
+//! same amount of work. Use it when the per-index work is known to be uneven,
+//! e.g. grid slabs whose cost follows a particle-count histogram. The cost
+//! function is called once per index on the calling thread before the loop
+//! starts and must return a non-negative value; if every cost is zero, the
+//! loop falls back to the even split.
+//!
+//! \param[in]  beginIndex The begin index.
+//! \param[in]  endIndex   The end index.
+//! \param[in]  cost       The per-index cost function.
+//! \param[in]  function   The function to call for each index range.
+//! \param[in]  policy     The execution policy (parallel or serial).
+//!
+//! \tparam     IndexType    Index type.
+//! \tparam     CostFunction Cost function type.
+//! \tparam     Function     Function type.
+//!
+template <typename IndexType, typename CostFunction, typename Function>
+void ParallelRangeForWeighted(
+    IndexType beginIndex, IndexType endIndex, const CostFunction& cost,
+    const Function& function,
+    ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
 //!
 //! \brief      Makes a 2D nested for-loop in parallel.
 //!
@@ -136,8 +214,11 @@ void ParallelRangeFor(IndexType beginIndexX, IndexType endIndexX,
 //!
 //! This function makes a 3D nested for-loop specified by begin and end indices
 //! for each dimension. X will be the inner-most loop while Z is the outer-most.
-//! The order of the visit is not guaranteed due to the nature of parallel
-//! execution.
+//! The domain is split across threads along the Z axis first and, when the Z
+//! extent alone cannot feed every worker (thin-slab domains), along Y as
+//! well; the unit-stride X axis is never split so the inner loops stay
+//! vectorizable. The order of the visit is not guaranteed due to the nature
+//! of parallel execution.
 //!
 //! \param[in]  beginIndexX The begin index in X dimension.
 //! \param[in]  endIndexX   The end index in X dimension.
@@ -164,8 +245,11 @@ void ParallelFor(IndexType beginIndexX, IndexType endIndexX,
 //! This function makes a 3D nested for-loop specified by begin and end indices
 //! for each dimension. X will be the inner-most loop while Z is the outer-most.
 //! Unlike parallelFor function, the input function object takes range instead
-//! of single index. The order of the visit is not guaranteed due to the nature
-//! of parallel execution.
+//! of single index. The ranges handed to the function are rectangular blocks:
+//! always the full X extent, and Y/Z sub-ranges chosen so that the number of
+//! blocks covers the worker threads even when the Z extent is shallow. The
+//! order of the visit is not guaranteed due to the nature of parallel
+//! execution.
 //!
 //! \param[in]  beginIndexX The begin index in X dimension.
 //! \param[in]  endIndexX   The end index in X dimension.
@@ -186,6 +270,65 @@ void ParallelRangeFor(IndexType beginIndexX, IndexType endIndexX,
                       const Function& function,
                       ExecutionPolicy policy = ExecutionPolicy::Parallel);
 
+//!
+//! \brief      Makes a 3D nested for-loop in parallel, tile by tile.
+//!
+//! This function visits the same index set as the 3D ParallelFor, but in
+//! cache-blocked order: the domain is split into cubic tiles (8x8x8 by
+//! default) and each tile is traversed with the usual nested loop before the
+//! next tile is started. Stencil kernels that touch neighboring elements keep
+//! their working set in cache this way, where the flat traversal would evict
+//! a plane of the grid between reuses. The order of the visit is not
+//! guaranteed due to the nature of parallel execution.
+//!
+//! \param[in]  beginIndexX The begin index in X dimension.
+//! \param[in]  endIndexX   The end index in X dimension.
+//! \param[in]  beginIndexY The begin index in Y dimension.
+//! \param[in]  endIndexY   The end index in Y dimension.
+//! \param[in]  beginIndexZ The begin index in Z dimension.
+//! \param[in]  endIndexZ   The end index in Z dimension.
+//! \param[in]  function    The function to call for each index (i, j, k).
+//! \param[in]  tileSize    Edge length of the cubic traversal tiles.
+//! \param[in]  policy      The execution policy (parallel or serial).
+//!
+//! \tparam     IndexType   Index type.
+//! \tparam     Function    Function type.
+//!
+template <typename IndexType, typename Function>
+void ParallelTiledFor(IndexType beginIndexX, IndexType endIndexX,
+                      IndexType beginIndexY, IndexType endIndexY,
+                      IndexType beginIndexZ, IndexType endIndexZ,
+                      const Function& function, IndexType tileSize = 8,
+                      ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
+//!
+//! \brief      Makes a 3D nested for-loop in parallel, in Morton order.
+//!
+//! This function visits the same index set as the 3D ParallelFor, but follows
+//! the Morton (Z-order) space-filling curve, so successively visited indices
+//! stay close together in all three dimensions. Indices of the enclosing
+//! power-of-two box that fall outside the domain are skipped. The order of
+//! the visit is not guaranteed due to the nature of parallel execution.
+//!
+//! \param[in]  beginIndexX The begin index in X dimension.
+//! \param[in]  endIndexX   The end index in X dimension.
+//! \param[in]  beginIndexY The begin index in Y dimension.
+//! \param[in]  endIndexY   The end index in Y dimension.
+//! \param[in]  beginIndexZ The begin index in Z dimension.
+//! \param[in]  endIndexZ   The end index in Z dimension.
+//! \param[in]  function    The function to call for each index (i, j, k).
+//! \param[in]  policy      The execution policy (parallel or serial).
+//!
+//! \tparam     IndexType   Index type.
+//! \tparam     Function    Function type.
+//!
+template <typename IndexType, typename Function>
+void ParallelMortonFor(IndexType beginIndexX, IndexType endIndexX,
+                       IndexType beginIndexY, IndexType endIndexY,
+                       IndexType beginIndexZ, IndexType endIndexZ,
+                       const Function& function,
+                       ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
 //!
 //! \brief      Performs reduce operation in parallel.
 //!
@@ -245,11 +388,193 @@ void ParallelSort(RandomIterator begin, RandomIterator end,
                   CompareFunction compare,
                   ExecutionPolicy policy = ExecutionPolicy::Parallel);
 
+//!
+//! \brief      Sorts key-value pairs by key with a parallel LSD radix sort.
+//!
+//! This function sorts the keys in [\p beginKey, \p endKey) into ascending
+//! order and applies the same permutation to the value range starting at
+//! \p beginValue. Keys must be unsigned integers (32- or 64-bit in practice).
+//! The sort processes one byte per pass, skipping byte positions that are
+//! identical across all keys, and is stable, so it outperforms the
+//! comparison-based ParallelSort by a wide margin on the large hash-key
+//! arrays built by the point searchers.
+//!
+//! \param[in]  beginKey   The begin iterator of the key range.
+//! \param[in]  endKey     The end iterator of the key range.
+//! \param[in]  beginValue The begin iterator of the value range.
+//! \param[in]  policy     The execution policy (parallel or serial).
+//!
+//! \tparam     KeyIterator   Random access iterator over unsigned integers.
+//! \tparam     ValueIterator Random access iterator over the payload.
+//!
+template <typename KeyIterator, typename ValueIterator>
+void ParallelRadixSort(KeyIterator beginKey, KeyIterator endKey,
+                       ValueIterator beginValue,
+                       ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
+//!
+//! \brief      Sorts heavy elements by an extracted unsigned key with O(n)
+//!             payload movement.
+//!
+//! This function extracts one unsigned integer key per element, sorts an
+//! index permutation with ParallelRadixSort, and then applies the permutation
+//! to the elements in a single parallel gather pass. Each element is moved
+//! exactly twice no matter how far it travels, unlike the merge-based
+//! ParallelSort which moves payload bytes at every merge level; prefer it
+//! when the element type is much larger than its sort key. The sort is
+//! stable, and the element type must be move-assignable and
+//! default-constructible (for the gather buffer).
+//!
+//! \param[in]  begin        The begin random access iterator.
+//! \param[in]  end          The end random access iterator.
+//! \param[in]  keyExtractor Functor mapping an element to its unsigned key.
+//! \param[in]  policy       The execution policy (parallel or serial).
+//!
+//! \tparam     RandomIterator Iterator type.
+//! \tparam     KeyExtractor   Key extraction functor type.
+//!
+template <typename RandomIterator, typename KeyExtractor>
+void ParallelSortByKey(RandomIterator begin, RandomIterator end,
+                       KeyExtractor keyExtractor,
+                       ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
 //! Sets maximum number of threads to use.
 void SetMaxNumberOfThreads(unsigned int numThreads);
 
-//! Returns maximum number of threads to use.
+//! Returns maximum number of threads to use for work launched from the
+//! calling thread: the engine-wide cap, reduced by the tightest
+//! ScopedThreadBudget alive on this thread.
 unsigned int GetMaxNumberOfThreads();
+
+//!
+//! \brief      Scoped per-thread cap on parallel loop width.
+//!
+//! While an instance is alive, every Parallel* call issued from the thread
+//! it lives on behaves as if the engine-wide thread cap were the given
+//! value; the engine-wide cap still bounds it from above, and zero means no
+//! additional cap. Scopes nest, and the tightest enclosing budget wins.
+//! This makes the core count a per-caller property: a process hosting
+//! several simulations can hand each one a slice of the machine instead of
+//! letting every solver assume all cores (see
+//! PhysicsAnimation::SetThreadBudget). Backends whose launchers take their
+//! width from the thread-count hint honor the budget; schedulers that own a
+//! global worker pool outright (TBB, OpenMP, HPX) keep using the
+//! engine-wide setting.
+//!
+class ScopedThreadBudget
+{
+ public:
+    //! Caps the calling thread's parallel loop width at \p numThreads.
+    explicit ScopedThreadBudget(unsigned int numThreads);
+
+    //! Restores the budget that was active when this scope was entered.
+    ~ScopedThreadBudget();
+
+    //! Deleted copy constructor.
+    ScopedThreadBudget(const ScopedThreadBudget&) = delete;
+
+    //! Deleted move constructor.
+    ScopedThreadBudget(ScopedThreadBudget&&) noexcept = delete;
+
+    //! Deleted copy assignment operator.
+    ScopedThreadBudget& operator=(const ScopedThreadBudget&) = delete;
+
+    //! Deleted move assignment operator.
+    ScopedThreadBudget& operator=(ScopedThreadBudget&&) noexcept = delete;
+
+ private:
+    unsigned int m_previousBudget;
+};
+
+//! Returns the thread budget active on the calling thread (0 if none).
+unsigned int GetCurrentThreadBudget();
+
+//! Returns the number of worker slots handed out by
+//! ParallelForWithWorkerIndex; every reported worker index is smaller than
+//! this value.
+size_t GetMaxNumberOfWorkerSlots();
+
+//!
+//! \brief      Sets the grain size (iterations per task) for ParallelFor.
+//!
+//! When the grain size is non-zero, 1-D ParallelFor splits its range into
+//! chunks of the given size and the worker threads claim chunks dynamically,
+//! which balances irregular per-iteration costs. With the TBB backend the
+//! value is forwarded as the blocked-range grain size. Setting zero (the
+//! default) restores the static one-slice-per-thread chunking.
+//!
+//! \param[in]  grainSize  Minimum number of iterations per task, or 0 for
+//!                        automatic static chunking.
+//!
+void SetParallelForGrainSize(size_t grainSize);
+
+//! Returns the grain size for ParallelFor (0 means automatic chunking).
+size_t GetParallelForGrainSize();
+
+//!
+//! \brief      Enables or disables engine-wide deterministic execution.
+//!
+//! When enabled, ParallelReduce treats every parallel policy as
+//! ParallelDeterministic (fixed chunks combined through a fixed binary tree)
+//! and ParallelSort runs a stable parallel merge sort whose output is
+//! uniquely determined by the input and the comparator. Results then match
+//! bit-for-bit across reruns, thread counts, and tasking backends, so a
+//! render farm can mix node types within one shot. The mode costs some
+//! scheduling flexibility and is off by default.
+//!
+//! \param[in]  enabled  True to force deterministic reductions and sorts.
+//!
+void SetDeterministicExecution(bool enabled);
+
+//! Returns whether engine-wide deterministic execution is enabled.
+bool GetDeterministicExecution();
+
+//!
+//! \brief Cache-line padded array of per-worker scratch values.
+//!
+//! Holds one entry per worker slot of ParallelForWithWorkerIndex (i.e.
+//! GetMaxNumberOfWorkerSlots() entries), each padded to its own cache line so
+//! workers that accumulate into their entry do not invalidate each other's
+//! lines. Typical use is a histogram or partial-sum buffer per worker that
+//! gets combined serially with ForEach once the loop has finished.
+//!
+//! \tparam T Scratch value type.
+//!
+template <typename T>
+class PerWorkerScratch
+{
+ public:
+    //! Constructs one value-initialized entry per worker slot.
+    PerWorkerScratch();
+
+    //! Constructs one entry per worker slot, initialized to \p initialValue.
+    explicit PerWorkerScratch(const T& initialValue);
+
+    //! Returns the number of worker slots.
+    [[nodiscard]] size_t size() const;
+
+    //! Returns the scratch value of the given worker slot.
+    [[nodiscard]] T& At(size_t workerIndex);
+
+    //! Returns the scratch value of the given worker slot (immutable).
+    [[nodiscard]] const T& At(size_t workerIndex) const;
+
+    //! Reassigns every entry to \p value.
+    void Reset(const T& value);
+
+    //! Invokes \p callback with a reference to every entry, serially.
+    template <typename Callback>
+    void ForEach(Callback callback);
+
+ private:
+    //! Pads each value to a (typical) cache line of its own.
+    struct alignas(64) Entry
+    {
+        T value;
+    };
+
+    std::vector<Entry> m_entries;
+};
 }  // namespace CubbyFlow
 
 #include <Core/Utils/Parallel-Impl.hpp>
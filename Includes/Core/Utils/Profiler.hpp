@@ -0,0 +1,147 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_PROFILER_HPP
+#define CUBBYFLOW_PROFILER_HPP
+
+#include <ostream>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Hierarchical scoped profiler.
+//!
+//! The profiler records named zones as begin/end timestamp pairs into
+//! per-thread buffers; nesting zones on one thread yields the timing tree.
+//! It is disabled by default, in which case entering a zone is a single
+//! atomic flag check. Recorded events can be dumped in the chrome://tracing
+//! JSON format (load the file via chrome://tracing or Perfetto), typically
+//! once per frame followed by Profiler::Clear.
+//!
+//! Zone names must be string literals (or otherwise outlive the dump); the
+//! profiler stores the pointers, not copies.
+//!
+//! Zones can additionally carry bandwidth and FLOP counters reported via
+//! ReportZoneCounters; the dump then includes the achieved GB/s and GFLOPS
+//! per zone so stages can be compared against machine peak.
+//!
+class Profiler
+{
+ public:
+    //! Enables or disables zone recording. Default is disabled.
+    static void SetEnabled(bool enabled);
+
+    //! Returns true if zone recording is enabled.
+    [[nodiscard]] static bool GetEnabled();
+
+    //!
+    //! \brief Begins a zone with given name on the calling thread.
+    //!
+    //! Prefer the CUBBYFLOW_PROFILE_ZONE macro, which pairs the begin/end
+    //! calls through RAII.
+    //!
+    //! \param[in]  name The zone name; must be a string literal.
+    //!
+    static void BeginZone(const char* name);
+
+    //! Ends the innermost open zone on the calling thread.
+    static void EndZone();
+
+    //!
+    //! \brief Adds memory traffic and FLOP estimates to the innermost open
+    //!        zone on the calling thread.
+    //!
+    //! The estimates count unique bytes touched (roofline convention), not
+    //! every access, so stencil kernels should charge each array once.
+    //! Repeated calls within one zone accumulate. The dump derives achieved
+    //! GB/s and GFLOPS from the counters and the zone duration. Does
+    //! nothing when recording is disabled or no zone is open; prefer the
+    //! CUBBYFLOW_PROFILE_COUNTERS macro, which also skips evaluating the
+    //! estimates while disabled.
+    //!
+    //! \param[in]  bytesRead    Estimated unique bytes read.
+    //! \param[in]  bytesWritten Estimated unique bytes written.
+    //! \param[in]  flops        Estimated floating-point operations.
+    //!
+    static void ReportZoneCounters(double bytesRead, double bytesWritten,
+                                   double flops);
+
+    //!
+    //! \brief Writes all recorded events to \p stream as chrome-trace JSON.
+    //!
+    //! Call this between frames; dumping while other threads are inside
+    //! zones omits their open zones.
+    //!
+    //! \param[in]  stream The output stream.
+    //!
+    static void DumpChromeTrace(std::ostream* stream);
+
+    //! Discards all recorded events.
+    static void Clear();
+};
+
+//!
+//! \brief RAII zone for the profiler.
+//!
+//! Begins a zone on construction and ends it on destruction. When the
+//! profiler is disabled at construction time, both are no-ops.
+//!
+class ProfileZone final
+{
+ public:
+    //! Begins a zone with given name; \p name must be a string literal.
+    explicit ProfileZone(const char* name);
+
+    //! Ends the zone.
+    ~ProfileZone();
+
+    //! Deleted copy constructor.
+    ProfileZone(const ProfileZone&) = delete;
+
+    //! Deleted move constructor.
+    ProfileZone(ProfileZone&&) noexcept = delete;
+
+    //! Deleted copy assignment operator.
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+    //! Deleted move assignment operator.
+    ProfileZone& operator=(ProfileZone&&) noexcept = delete;
+
+ private:
+    bool m_isActive;
+};
+
+#define CUBBYFLOW_PROFILE_CONCAT_IMPL(x, y) x##y
+#define CUBBYFLOW_PROFILE_CONCAT(x, y) CUBBYFLOW_PROFILE_CONCAT_IMPL(x, y)
+
+//! Records a zone covering the rest of the enclosing scope.
+#define CUBBYFLOW_PROFILE_ZONE(name)                                   \
+    ::CubbyFlow::ProfileZone CUBBYFLOW_PROFILE_CONCAT(profileZone,     \
+                                                      __LINE__)        \
+    {                                                                  \
+        name                                                           \
+    }
+
+//! Reports bandwidth/FLOP counters for the enclosing zone; the counter
+//! expressions are not evaluated while recording is disabled.
+#define CUBBYFLOW_PROFILE_COUNTERS(bytesRead, bytesWritten, flops)     \
+    do                                                                 \
+    {                                                                  \
+        if (::CubbyFlow::Profiler::GetEnabled())                       \
+        {                                                              \
+            ::CubbyFlow::Profiler::ReportZoneCounters(                 \
+                static_cast<double>(bytesRead),                        \
+                static_cast<double>(bytesWritten),                     \
+                static_cast<double>(flops));                           \
+        }                                                              \
+    } while (false)
+}  // namespace CubbyFlow
+
+#endif
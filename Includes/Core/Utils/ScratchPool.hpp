@@ -0,0 +1,102 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_SCRATCH_POOL_HPP
+#define CUBBYFLOW_SCRATCH_POOL_HPP
+
+#include <memory>
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Frame-scoped pool of reusable scratch objects.
+//!
+//! This class keeps previously created temporary objects alive so that
+//! steady-state simulation loops can avoid per-substep heap allocation.
+//! Call Reset once per substep (or frame) to mark every pooled object as
+//! free again; subsequent Acquire calls then hand out the cached objects
+//! in the same order instead of invoking the factory.
+//!
+//! Acquired objects keep whatever contents they had when last used, so the
+//! caller is responsible for refreshing them before use.
+//!
+//! \tparam T - Type of the pooled objects.
+//!
+template <typename T>
+class ScratchPool
+{
+ public:
+    //! Default constructor.
+    ScratchPool() = default;
+
+    //!
+    //! \brief Returns a pooled object, creating one with \p factory on miss.
+    //!
+    //! If a free pooled object is available, it is returned as-is; otherwise
+    //! \p factory is invoked and its result is added to the pool. Objects are
+    //! handed out in creation order, so acquire patterns that are stable
+    //! across substeps will receive matching objects every time.
+    //!
+    //! \param[in] factory  Callable returning std::shared_ptr<T>.
+    //!
+    template <typename Factory>
+    std::shared_ptr<T> Acquire(Factory&& factory);
+
+    //! Marks all pooled objects as free again. Call once per substep.
+    void Reset();
+
+    //! Drops all pooled objects. Call when the pooled objects became stale
+    //! (e.g. after a grid resize).
+    void Clear();
+
+    //! Returns the number of objects held by the pool.
+    [[nodiscard]] size_t GetSize() const;
+
+ private:
+    std::vector<std::shared_ptr<T>> m_objects;
+    size_t m_numberOfUsedObjects = 0;
+};
+
+template <typename T>
+template <typename Factory>
+std::shared_ptr<T> ScratchPool<T>::Acquire(Factory&& factory)
+{
+    if (m_numberOfUsedObjects < m_objects.size())
+    {
+        return m_objects[m_numberOfUsedObjects++];
+    }
+
+    m_objects.push_back(factory());
+    ++m_numberOfUsedObjects;
+    return m_objects.back();
+}
+
+template <typename T>
+void ScratchPool<T>::Reset()
+{
+    m_numberOfUsedObjects = 0;
+}
+
+template <typename T>
+void ScratchPool<T>::Clear()
+{
+    m_objects.clear();
+    m_numberOfUsedObjects = 0;
+}
+
+template <typename T>
+size_t ScratchPool<T>::GetSize() const
+{
+    return m_objects.size();
+}
+}  // namespace CubbyFlow
+
+#endif
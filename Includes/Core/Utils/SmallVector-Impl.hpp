@@ -0,0 +1,270 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_SMALL_VECTOR_IMPL_HPP
+#define CUBBYFLOW_SMALL_VECTOR_IMPL_HPP
+
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace CubbyFlow
+{
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector() : m_data(InlineData())
+{
+    // Do nothing
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::~SmallVector()
+{
+    Clear();
+
+    if (m_data != InlineData())
+    {
+        ::operator delete(m_data);
+    }
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector& other) : m_data(InlineData())
+{
+    if (other.m_size > m_capacity)
+    {
+        Grow(other.m_size);
+    }
+
+    for (size_t i = 0; i < other.m_size; ++i)
+    {
+        ::new (static_cast<void*>(m_data + i)) T(other.m_data[i]);
+    }
+
+    m_size = other.m_size;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(SmallVector&& other) noexcept
+    : m_data(InlineData())
+{
+    if (other.m_data != other.InlineData())
+    {
+        // Steal the heap buffer.
+        m_data = other.m_data;
+        m_capacity = other.m_capacity;
+        m_size = other.m_size;
+
+        other.m_data = other.InlineData();
+        other.m_capacity = N;
+        other.m_size = 0;
+        return;
+    }
+
+    for (size_t i = 0; i < other.m_size; ++i)
+    {
+        ::new (static_cast<void*>(m_data + i)) T(std::move(other.m_data[i]));
+    }
+
+    m_size = other.m_size;
+    other.Clear();
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(const SmallVector& other)
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    Clear();
+
+    if (other.m_size > m_capacity)
+    {
+        Grow(other.m_size);
+    }
+
+    for (size_t i = 0; i < other.m_size; ++i)
+    {
+        ::new (static_cast<void*>(m_data + i)) T(other.m_data[i]);
+    }
+
+    m_size = other.m_size;
+    return *this;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(SmallVector&& other) noexcept
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    Clear();
+
+    if (other.m_data != other.InlineData())
+    {
+        if (m_data != InlineData())
+        {
+            ::operator delete(m_data);
+        }
+
+        m_data = other.m_data;
+        m_capacity = other.m_capacity;
+        m_size = other.m_size;
+
+        other.m_data = other.InlineData();
+        other.m_capacity = N;
+        other.m_size = 0;
+        return *this;
+    }
+
+    for (size_t i = 0; i < other.m_size; ++i)
+    {
+        ::new (static_cast<void*>(m_data + i)) T(std::move(other.m_data[i]));
+    }
+
+    m_size = other.m_size;
+    other.Clear();
+    return *this;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::Append(const T& value)
+{
+    if (m_size == m_capacity)
+    {
+        Grow(m_capacity * 2);
+    }
+
+    ::new (static_cast<void*>(m_data + m_size)) T(value);
+    ++m_size;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::PopBack()
+{
+    assert(m_size > 0);
+
+    --m_size;
+    m_data[m_size].~T();
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::Clear()
+{
+    for (size_t i = 0; i < m_size; ++i)
+    {
+        m_data[i].~T();
+    }
+
+    m_size = 0;
+}
+
+template <typename T, size_t N>
+T& SmallVector<T, N>::Back()
+{
+    assert(m_size > 0);
+
+    return m_data[m_size - 1];
+}
+
+template <typename T, size_t N>
+const T& SmallVector<T, N>::Back() const
+{
+    assert(m_size > 0);
+
+    return m_data[m_size - 1];
+}
+
+template <typename T, size_t N>
+size_t SmallVector<T, N>::Size() const
+{
+    return m_size;
+}
+
+template <typename T, size_t N>
+size_t SmallVector<T, N>::Capacity() const
+{
+    return m_capacity;
+}
+
+template <typename T, size_t N>
+bool SmallVector<T, N>::IsEmpty() const
+{
+    return m_size == 0;
+}
+
+template <typename T, size_t N>
+T& SmallVector<T, N>::operator[](size_t i)
+{
+    assert(i < m_size);
+
+    return m_data[i];
+}
+
+template <typename T, size_t N>
+const T& SmallVector<T, N>::operator[](size_t i) const
+{
+    assert(i < m_size);
+
+    return m_data[i];
+}
+
+template <typename T, size_t N>
+T* SmallVector<T, N>::data()
+{
+    return m_data;
+}
+
+template <typename T, size_t N>
+const T* SmallVector<T, N>::data() const
+{
+    return m_data;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::Grow(size_t minCapacity)
+{
+    const size_t newCapacity =
+        (minCapacity > m_capacity * 2) ? minCapacity : m_capacity * 2;
+    T* newData =
+        static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+
+    for (size_t i = 0; i < m_size; ++i)
+    {
+        ::new (static_cast<void*>(newData + i)) T(std::move(m_data[i]));
+        m_data[i].~T();
+    }
+
+    if (m_data != InlineData())
+    {
+        ::operator delete(m_data);
+    }
+
+    m_data = newData;
+    m_capacity = newCapacity;
+}
+
+template <typename T, size_t N>
+T* SmallVector<T, N>::InlineData()
+{
+    return reinterpret_cast<T*>(m_inlineStorage);
+}
+
+template <typename T, size_t N>
+const T* SmallVector<T, N>::InlineData() const
+{
+    return reinterpret_cast<const T*>(m_inlineStorage);
+}
+}  // namespace CubbyFlow
+
+#endif
@@ -0,0 +1,101 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_SMALL_VECTOR_HPP
+#define CUBBYFLOW_SMALL_VECTOR_HPP
+
+#include <cstddef>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Fixed-capacity-first vector with inline storage for N elements.
+//!
+//! The first N elements live inside the object itself, so short-lived
+//! containers - traversal stacks and candidate lists in spatial query
+//! engines - never touch the heap for typical queries. Growing past N
+//! falls back to a heap buffer transparently, so deep traversals stay
+//! correct rather than overflowing a fixed array.
+//!
+template <typename T, size_t N>
+class SmallVector
+{
+ public:
+    //! Constructs an empty vector.
+    SmallVector();
+
+    //! Destructor; destroys elements and releases any heap buffer.
+    ~SmallVector();
+
+    //! Copy constructor.
+    SmallVector(const SmallVector& other);
+
+    //! Move constructor. Inline elements are moved element-wise.
+    SmallVector(SmallVector&& other) noexcept;
+
+    //! Copy assignment operator.
+    SmallVector& operator=(const SmallVector& other);
+
+    //! Move assignment operator.
+    SmallVector& operator=(SmallVector&& other) noexcept;
+
+    //! Appends \p value at the end, growing to the heap if needed.
+    void Append(const T& value);
+
+    //! Removes the last element.
+    void PopBack();
+
+    //! Removes all elements. Keeps the current capacity.
+    void Clear();
+
+    //! Returns the last element.
+    [[nodiscard]] T& Back();
+
+    //! Returns the last element.
+    [[nodiscard]] const T& Back() const;
+
+    //! Returns the number of elements.
+    [[nodiscard]] size_t Size() const;
+
+    //! Returns the current capacity.
+    [[nodiscard]] size_t Capacity() const;
+
+    //! Returns true if the vector is empty.
+    [[nodiscard]] bool IsEmpty() const;
+
+    //! Returns the reference to the i-th element.
+    T& operator[](size_t i);
+
+    //! Returns the const reference to the i-th element.
+    const T& operator[](size_t i) const;
+
+    //! Returns the raw pointer to the elements.
+    [[nodiscard]] T* data();
+
+    //! Returns the const raw pointer to the elements.
+    [[nodiscard]] const T* data() const;
+
+ private:
+    void Grow(size_t minCapacity);
+
+    [[nodiscard]] T* InlineData();
+
+    [[nodiscard]] const T* InlineData() const;
+
+    alignas(T) unsigned char m_inlineStorage[N * sizeof(T)];
+    T* m_data;
+    size_t m_size = 0;
+    size_t m_capacity = N;
+};
+}  // namespace CubbyFlow
+
+#include <Core/Utils/SmallVector-Impl.hpp>
+
+#endif
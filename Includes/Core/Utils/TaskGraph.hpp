@@ -0,0 +1,78 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef CUBBYFLOW_TASK_GRAPH_HPP
+#define CUBBYFLOW_TASK_GRAPH_HPP
+
+#include <Core/Utils/Parallel.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace CubbyFlow
+{
+//!
+//! \brief Small dependency-aware task runner for solver stages.
+//!
+//! Each task declares which resources it reads and which it writes; resources
+//! are identified by opaque pointers (typically the grid objects a stage
+//! touches). A task depends on every earlier task whose writes overlap its
+//! reads or writes, or whose reads overlap its writes. Run executes the tasks
+//! level by level: tasks with no unsatisfied dependencies run concurrently on
+//! the tasking system, so independent stages -- like the per-quantity
+//! advections of a grid solver -- no longer serialize.
+//!
+class TaskGraph
+{
+ public:
+    using TaskID = size_t;
+
+    //!
+    //! \brief Adds a task with its declared resource accesses.
+    //!
+    //! \param[in] work   The function to execute.
+    //! \param[in] reads  Resources the task reads (shared between tasks).
+    //! \param[in] writes Resources the task writes (exclusive to the task).
+    //!
+    //! \return ID of the added task.
+    //!
+    TaskID AddTask(std::function<void()> work,
+                   std::vector<const void*> reads = {},
+                   std::vector<const void*> writes = {});
+
+    //! Returns the number of added tasks.
+    [[nodiscard]] size_t GetNumberOfTasks() const;
+
+    //!
+    //! \brief Executes all tasks, honoring the declared dependencies.
+    //!
+    //! Tasks are grouped into levels by declaration order and dependency
+    //! depth; each level runs as one parallel batch. The grouping only
+    //! depends on the declared accesses, so the execution schedule is
+    //! deterministic.
+    //!
+    void Run(ExecutionPolicy policy = ExecutionPolicy::Parallel) const;
+
+    //! Removes all tasks.
+    void Clear();
+
+ private:
+    struct Task
+    {
+        std::function<void()> work;
+        std::vector<const void*> reads;
+        std::vector<const void*> writes;
+    };
+
+    std::vector<Task> m_tasks;
+};
+}  // namespace CubbyFlow
+
+#endif
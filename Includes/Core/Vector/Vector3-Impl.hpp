@@ -19,9 +19,12 @@ namespace CubbyFlow
 {
 template <typename T>
 template <typename U>
-Vector<T, 3>::Vector(const std::initializer_list<U>& list)
+constexpr Vector<T, 3>::Vector(const std::initializer_list<U>& list)
+    : x{ static_cast<T>(*list.begin()) },
+      y{ static_cast<T>(*(list.begin() + 1)) },
+      z{ static_cast<T>(*(list.begin() + 2)) }
 {
-    Set(list);
+    assert(list.size() >= 3);
 }
 
 template <typename T>
@@ -64,7 +67,7 @@ void Vector<T, 3>::Set(const Vector2<T>& pt, T newZ)
 
 template <typename T>
 template <typename U>
-void Vector<T, 3>::Set(const std::initializer_list<U>& list)
+constexpr void Vector<T, 3>::Set(const std::initializer_list<U>& list)
 {
     assert(list.size() >= 3);
 
@@ -100,95 +103,95 @@ void Vector<T, 3>::Normalize()
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::Add(T v) const
+constexpr Vector<T, 3> Vector<T, 3>::Add(T v) const
 {
-    return Vector<T, 3>{ x + v, y + v, z + v };
+    return Vector<T, 3>( x + v, y + v, z + v );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::Add(const Vector& v) const
+constexpr Vector<T, 3> Vector<T, 3>::Add(const Vector& v) const
 {
-    return Vector<T, 3>{ x + v.x, y + v.y, z + v.z };
+    return Vector<T, 3>( x + v.x, y + v.y, z + v.z );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::Sub(T v) const
+constexpr Vector<T, 3> Vector<T, 3>::Sub(T v) const
 {
-    return Vector<T, 3>{ x - v, y - v, z - v };
+    return Vector<T, 3>( x - v, y - v, z - v );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::Sub(const Vector& v) const
+constexpr Vector<T, 3> Vector<T, 3>::Sub(const Vector& v) const
 {
-    return Vector<T, 3>{ x - v.x, y - v.y, z - v.z };
+    return Vector<T, 3>( x - v.x, y - v.y, z - v.z );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::Mul(T v) const
+constexpr Vector<T, 3> Vector<T, 3>::Mul(T v) const
 {
-    return Vector<T, 3>{ x * v, y * v, z * v };
+    return Vector<T, 3>( x * v, y * v, z * v );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::Mul(const Vector& v) const
+constexpr Vector<T, 3> Vector<T, 3>::Mul(const Vector& v) const
 {
-    return Vector<T, 3>{ x * v.x, y * v.y, z * v.z };
+    return Vector<T, 3>( x * v.x, y * v.y, z * v.z );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::Div(T v) const
+constexpr Vector<T, 3> Vector<T, 3>::Div(T v) const
 {
-    return Vector<T, 3>{ x / v, y / v, z / v };
+    return Vector<T, 3>( x / v, y / v, z / v );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::Div(const Vector& v) const
+constexpr Vector<T, 3> Vector<T, 3>::Div(const Vector& v) const
 {
-    return Vector<T, 3>{ x / v.x, y / v.y, z / v.z };
+    return Vector<T, 3>( x / v.x, y / v.y, z / v.z );
 }
 
 template <typename T>
-T Vector<T, 3>::Dot(const Vector& v) const
+constexpr T Vector<T, 3>::Dot(const Vector& v) const
 {
     return x * v.x + y * v.y + z * v.z;
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::Cross(const Vector& v) const
+constexpr Vector<T, 3> Vector<T, 3>::Cross(const Vector& v) const
 {
-    return Vector<T, 3>{ y * v.z - z * v.y, z * v.x - x * v.z,
-                         x * v.y - y * v.x };
+    return Vector<T, 3>( y * v.z - z * v.y, z * v.x - x * v.z,
+                         x * v.y - y * v.x );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::RSub(T v) const
+constexpr Vector<T, 3> Vector<T, 3>::RSub(T v) const
 {
-    return Vector<T, 3>{ v - x, v - y, v - z };
+    return Vector<T, 3>( v - x, v - y, v - z );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::RSub(const Vector& v) const
+constexpr Vector<T, 3> Vector<T, 3>::RSub(const Vector& v) const
 {
-    return Vector<T, 3>{ v.x - x, v.y - y, v.z - z };
+    return Vector<T, 3>( v.x - x, v.y - y, v.z - z );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::RDiv(T v) const
+constexpr Vector<T, 3> Vector<T, 3>::RDiv(T v) const
 {
-    return Vector<T, 3>{ v / x, v / y, v / z };
+    return Vector<T, 3>( v / x, v / y, v / z );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::RDiv(const Vector& v) const
+constexpr Vector<T, 3> Vector<T, 3>::RDiv(const Vector& v) const
 {
-    return Vector<T, 3>{ v.x / x, v.y / y, v.z / z };
+    return Vector<T, 3>( v.x / x, v.y / y, v.z / z );
 }
 
 template <typename T>
-Vector<T, 3> Vector<T, 3>::RCross(const Vector& v) const
+constexpr Vector<T, 3> Vector<T, 3>::RCross(const Vector& v) const
 {
-    return Vector<T, 3>{ v.y * z - v.z * y, v.z * x - v.x * z,
-                         v.x * y - v.y * x };
+    return Vector<T, 3>( v.y * z - v.z * y, v.z * x - v.x * z,
+                         v.x * y - v.y * x );
 }
 
 template <typename T>
@@ -346,7 +349,7 @@ size_t Vector<T, 3>::SubdominantAxis() const
 template <typename T>
 Vector<T, 3> Vector<T, 3>::Normalized() const
 {
-    return Vector<T, 3>{ x / Length(), y / Length(), z / Length() };
+    return Vector<T, 3>( x / Length(), y / Length(), z / Length() );
 }
 
 template <typename T>
@@ -391,8 +394,8 @@ template <typename T>
 std::tuple<Vector<T, 3>, Vector<T, 3>> Vector<T, 3>::Tangential() const
 {
     Vector<T, 3> a =
-        ((std::fabs(y) > 0 || std::fabs(z) > 0) ? Vector<T, 3>{ 1, 0, 0 }
-                                                : Vector<T, 3>{ 0, 1, 0 })
+        ((std::fabs(y) > 0 || std::fabs(z) > 0) ? Vector<T, 3>( 1, 0, 0 )
+                                                : Vector<T, 3>( 0, 1, 0 ))
             .Cross(*this)
             .Normalized();
     Vector<T, 3> b = Cross(a);
@@ -535,85 +538,85 @@ bool Vector<T, 3>::operator!=(const Vector& v) const
 }
 
 template <typename T>
-Vector<T, 3> operator+(const Vector<T, 3>& a)
+constexpr Vector<T, 3> operator+(const Vector<T, 3>& a)
 {
     return a;
 }
 
 template <typename T>
-Vector<T, 3> operator-(const Vector<T, 3>& a)
+constexpr Vector<T, 3> operator-(const Vector<T, 3>& a)
 {
-    return Vector<T, 3>{ -a.x, -a.y, -a.z };
+    return Vector<T, 3>( -a.x, -a.y, -a.z );
 }
 
 template <typename T>
-Vector<T, 3> operator+(const Vector<T, 3>& a, T b)
+constexpr Vector<T, 3> operator+(const Vector<T, 3>& a, T b)
 {
     return a.Add(b);
 }
 
 template <typename T>
-Vector<T, 3> operator+(T a, const Vector<T, 3>& b)
+constexpr Vector<T, 3> operator+(T a, const Vector<T, 3>& b)
 {
     return b.Add(a);
 }
 
 template <typename T>
-Vector<T, 3> operator+(const Vector<T, 3>& a, const Vector<T, 3>& b)
+constexpr Vector<T, 3> operator+(const Vector<T, 3>& a, const Vector<T, 3>& b)
 {
     return a.Add(b);
 }
 
 template <typename T>
-Vector<T, 3> operator-(const Vector<T, 3>& a, T b)
+constexpr Vector<T, 3> operator-(const Vector<T, 3>& a, T b)
 {
     return a.Sub(b);
 }
 
 template <typename T>
-Vector<T, 3> operator-(T a, const Vector<T, 3>& b)
+constexpr Vector<T, 3> operator-(T a, const Vector<T, 3>& b)
 {
     return b.RSub(a);
 }
 
 template <typename T>
-Vector<T, 3> operator-(const Vector<T, 3>& a, const Vector<T, 3>& b)
+constexpr Vector<T, 3> operator-(const Vector<T, 3>& a, const Vector<T, 3>& b)
 {
     return a.Sub(b);
 }
 
 template <typename T>
-Vector<T, 3> operator*(const Vector<T, 3>& a, T b)
+constexpr Vector<T, 3> operator*(const Vector<T, 3>& a, T b)
 {
     return a.Mul(b);
 }
 
 template <typename T>
-Vector<T, 3> operator*(T a, const Vector<T, 3>& b)
+constexpr Vector<T, 3> operator*(T a, const Vector<T, 3>& b)
 {
     return b.Mul(a);
 }
 
 template <typename T>
-Vector<T, 3> operator*(const Vector<T, 3>& a, const Vector<T, 3>& b)
+constexpr Vector<T, 3> operator*(const Vector<T, 3>& a, const Vector<T, 3>& b)
 {
     return a.Mul(b);
 }
 
 template <typename T>
-Vector<T, 3> operator/(const Vector<T, 3>& a, T b)
+constexpr Vector<T, 3> operator/(const Vector<T, 3>& a, T b)
 {
     return a.Div(b);
 }
 
 template <typename T>
-Vector<T, 3> operator/(T a, const Vector<T, 3>& b)
+constexpr Vector<T, 3> operator/(T a, const Vector<T, 3>& b)
 {
     return b.RDiv(a);
 }
 
 template <typename T>
-Vector<T, 3> operator/(const Vector<T, 3>& a, const Vector<T, 3>& b)
+constexpr Vector<T, 3> operator/(const Vector<T, 3>& a, const Vector<T, 3>& b)
 {
     return a.Div(b);
 }
@@ -621,35 +624,35 @@ Vector<T, 3> operator/(const Vector<T, 3>& a, const Vector<T, 3>& b)
 template <typename T>
 Vector<T, 3> Min(const Vector<T, 3>& a, const Vector<T, 3>& b)
 {
-    return Vector<T, 3>{ std::min(a.x, b.x), std::min(a.y, b.y),
-                         std::min(a.z, b.z) };
+    return Vector<T, 3>( std::min(a.x, b.x), std::min(a.y, b.y),
+                         std::min(a.z, b.z) );
 }
 
 template <typename T>
 Vector<T, 3> Max(const Vector<T, 3>& a, const Vector<T, 3>& b)
 {
-    return Vector<T, 3>{ std::max(a.x, b.x), std::max(a.y, b.y),
-                         std::max(a.z, b.z) };
+    return Vector<T, 3>( std::max(a.x, b.x), std::max(a.y, b.y),
+                         std::max(a.z, b.z) );
 }
 
 template <typename T>
 Vector<T, 3> Clamp(const Vector<T, 3>& v, const Vector<T, 3>& low,
                    const Vector<T, 3>& high)
 {
-    return Vector<T, 3>{ Clamp(v.x, low.x, high.x), Clamp(v.y, low.y, high.y),
-                         Clamp(v.z, low.z, high.z) };
+    return Vector<T, 3>( Clamp(v.x, low.x, high.x), Clamp(v.y, low.y, high.y),
+                         Clamp(v.z, low.z, high.z) );
 }
 
 template <typename T>
 Vector<T, 3> Ceil(const Vector<T, 3>& a)
 {
-    return Vector<T, 3>{ std::ceil(a.x), std::ceil(a.y), std::ceil(a.z) };
+    return Vector<T, 3>( std::ceil(a.x), std::ceil(a.y), std::ceil(a.z) );
 }
 
 template <typename T>
 Vector<T, 3> Floor(const Vector<T, 3>& a)
 {
-    return Vector<T, 3>{ std::floor(a.x), std::floor(a.y), std::floor(a.z) };
+    return Vector<T, 3>( std::floor(a.x), std::floor(a.y), std::floor(a.z) );
 }
 
 template <typename T>
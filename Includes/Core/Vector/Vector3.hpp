@@ -11,6 +11,7 @@
 #ifndef CUBBYFLOW_VECTOR3_HPP
 #define CUBBYFLOW_VECTOR3_HPP
 
+#include <Core/Utils/Macros.hpp>
 #include <Core/Vector/Vector2.hpp>
 
 #include <limits>
@@ -25,7 +26,7 @@ namespace CubbyFlow
 //! \tparam T - Type of the element
 //!
 template <typename T>
-class Vector<T, 3> final
+class CUBBYFLOW_SMALL_TYPE_ALIGNAS(T) Vector<T, 3> final
 {
  public:
     static_assert(std::is_floating_point<T>::value,
@@ -51,7 +52,7 @@ class Vector<T, 3> final
 
     //! Constructs vector with initializer list.
     template <typename U>
-    Vector(const std::initializer_list<U>& list);
+    constexpr Vector(const std::initializer_list<U>& list);
 
     //! Copy constructor.
     constexpr Vector(const Vector& v) : x{ v.x }, y{ v.y }, z{ v.z }
@@ -85,7 +86,7 @@ class Vector<T, 3> final
 
     //! Set x, y, and z components with given initializer list.
     template <typename U>
-    void Set(const std::initializer_list<U>& list);
+    constexpr void Set(const std::initializer_list<U>& list);
 
     //! Set x, y, and z with other vector \p v.
     void Set(const Vector& v);
@@ -97,49 +98,49 @@ class Vector<T, 3> final
     void Normalize();
 
     //! Computes this + (v, v, v).
-    [[nodiscard]] Vector Add(T v) const;
+    [[nodiscard]] constexpr Vector Add(T v) const;
 
     //! Computes this + (v.x, v.y, v.z).
-    [[nodiscard]] Vector Add(const Vector& v) const;
+    [[nodiscard]] constexpr Vector Add(const Vector& v) const;
 
     //! Computes this - (v, v, v).
-    [[nodiscard]] Vector Sub(T v) const;
+    [[nodiscard]] constexpr Vector Sub(T v) const;
 
     //! Computes this - (v.x, v.y, v.z).
-    [[nodiscard]] Vector Sub(const Vector& v) const;
+    [[nodiscard]] constexpr Vector Sub(const Vector& v) const;
 
     //! Computes this * (v, v, v).
-    [[nodiscard]] Vector Mul(T v) const;
+    [[nodiscard]] constexpr Vector Mul(T v) const;
 
     //! Computes this * (v.x, v.y, v.z).
-    [[nodiscard]] Vector Mul(const Vector& v) const;
+    [[nodiscard]] constexpr Vector Mul(const Vector& v) const;
 
     //! Computes this / (v, v, v).
-    [[nodiscard]] Vector Div(T v) const;
+    [[nodiscard]] constexpr Vector Div(T v) const;
 
     //! Computes this / (v.x, v.y, v.z).
-    [[nodiscard]] Vector Div(const Vector& v) const;
+    [[nodiscard]] constexpr Vector Div(const Vector& v) const;
 
     //! Computes dot product.
-    [[nodiscard]] T Dot(const Vector& v) const;
+    [[nodiscard]] constexpr T Dot(const Vector& v) const;
 
     //! Computes cross product.
-    [[nodiscard]] Vector Cross(const Vector& v) const;
+    [[nodiscard]] constexpr Vector Cross(const Vector& v) const;
 
     //! Computes (v, v, v) - this.
-    [[nodiscard]] Vector RSub(T v) const;
+    [[nodiscard]] constexpr Vector RSub(T v) const;
 
     //! Computes (v.x, v.y, v.z) - this.
-    [[nodiscard]] Vector RSub(const Vector& v) const;
+    [[nodiscard]] constexpr Vector RSub(const Vector& v) const;
 
     //! Computes (v, v, v) / this.
-    [[nodiscard]] Vector RDiv(T v) const;
+    [[nodiscard]] constexpr Vector RDiv(T v) const;
 
     //! Computes (v.x, v.y, v.z) / this.
-    [[nodiscard]] Vector RDiv(const Vector& v) const;
+    [[nodiscard]] constexpr Vector RDiv(const Vector& v) const;
 
     //! Computes \p v cross this.
-    [[nodiscard]] Vector RCross(const Vector& v) const;
+    [[nodiscard]] constexpr Vector RCross(const Vector& v) const;
 
     //! Computes this += (v, v, v).
     void IAdd(T v);
@@ -287,55 +288,55 @@ using Vector3 = Vector<T, 3>;
 
 //! Positive sign operator.
 template <typename T>
-Vector<T, 3> operator+(const Vector<T, 3>& a);
+constexpr Vector<T, 3> operator+(const Vector<T, 3>& a);
 
 //! Negative sign operator.
 template <typename T>
-Vector<T, 3> operator-(const Vector<T, 3>& a);
+constexpr Vector<T, 3> operator-(const Vector<T, 3>& a);
 
 //! Computes (a, a, a) + (b.x, b.y, b.z).
 template <typename T>
-Vector<T, 3> operator+(T a, const Vector<T, 3>& b);
+constexpr Vector<T, 3> operator+(T a, const Vector<T, 3>& b);
 
 //! Computes (a.x, a.y, a.z) + (b.x, b.y, b.z).
 template <typename T>
-Vector<T, 3> operator+(const Vector<T, 3>& a, const Vector<T, 3>& b);
+constexpr Vector<T, 3> operator+(const Vector<T, 3>& a, const Vector<T, 3>& b);
 
 //! Computes (a.x, a.y, a.z) - (b, b, b).
 template <typename T>
-Vector<T, 3> operator-(const Vector<T, 3>& a, T b);
+constexpr Vector<T, 3> operator-(const Vector<T, 3>& a, T b);
 
 //! Computes (a, a, a) - (b.x, b.y, b.z).
 template <typename T>
-Vector<T, 3> operator-(T a, const Vector<T, 3>& b);
+constexpr Vector<T, 3> operator-(T a, const Vector<T, 3>& b);
 
 //! Computes (a.x, a.y, a.z) - (b.x, b.y, b.z).
 template <typename T>
-Vector<T, 3> operator-(const Vector<T, 3>& a, const Vector<T, 3>& b);
+constexpr Vector<T, 3> operator-(const Vector<T, 3>& a, const Vector<T, 3>& b);
 
 //! Computes (a.x, a.y, a.z) * (b, b, b).
 template <typename T>
-Vector<T, 3> operator*(const Vector<T, 3>& a, T b);
+constexpr Vector<T, 3> operator*(const Vector<T, 3>& a, T b);
 
 //! Computes (a, a, a) * (b.x, b.y, b.z).
 template <typename T>
-Vector<T, 3> operator*(T a, const Vector<T, 3>& b);
+constexpr Vector<T, 3> operator*(T a, const Vector<T, 3>& b);
 
 //! Computes (a.x, a.y, a.z) * (b.x, b.y, b.z).
 template <typename T>
-Vector<T, 3> operator*(const Vector<T, 3>& a, const Vector<T, 3>& b);
+constexpr Vector<T, 3> operator*(const Vector<T, 3>& a, const Vector<T, 3>& b);
 
 //! Computes (a.x, a.y, a.z) / (b, b, b).
 template <typename T>
-Vector<T, 3> operator/(const Vector<T, 3>& a, T b);
+constexpr Vector<T, 3> operator/(const Vector<T, 3>& a, T b);
 
 //! Computes (a, a, a) / (b.x, b.y, b.z).
 template <typename T>
-Vector<T, 3> operator/(T a, const Vector<T, 3>& b);
+constexpr Vector<T, 3> operator/(T a, const Vector<T, 3>& b);
 
 //! Computes (a.x, a.y, a.z) / (b.x, b.y, b.z).
 template <typename T>
-Vector<T, 3> operator/(const Vector<T, 3>& a, const Vector<T, 3>& b);
+constexpr Vector<T, 3> operator/(const Vector<T, 3>& a, const Vector<T, 3>& b);
 
 //! Returns element-wise min vector.
 template <typename T>
@@ -39,9 +39,14 @@ void AddAnimation(pybind11::module& m)
 		)pbdoc")
         .def(pybind11::init<>())
         .def("Update", &Animation::Update,
+             pybind11::call_guard<pybind11::gil_scoped_release>(),
              R"pbdoc(
 			Updates animation state for given `frame`.
 
+			The GIL is released for the duration of the call, so Python
+			threads (e.g. progress monitoring) keep running while the native
+			update computes. Python-side overrides of OnUpdate re-acquire it.
+
 			Parameters
 			----------
 			- frame : Number of frames to advance.
@@ -52,7 +52,13 @@ void AddPhysicsAnimation(pybind11::module& m)
         .def_property("numberOfFixedSubTimeSteps",
                       &PhysicsAnimation::GetNumberOfFixedSubTimeSteps,
                       &PhysicsAnimation::SetNumberOfFixedSubTimeSteps)
-        .def("AdvanceSingleFrame", &PhysicsAnimation::AdvanceSingleFrame)
+        .def("AdvanceSingleFrame", &PhysicsAnimation::AdvanceSingleFrame,
+             pybind11::call_guard<pybind11::gil_scoped_release>(),
+             R"pbdoc(
+			Advances a single frame. The GIL is released while the frame
+			computes; Python-side overrides of OnAdvanceTimeStep re-acquire
+			it.
+		)pbdoc")
         .def_property("currentFrame", &PhysicsAnimation::GetCurrentFrame,
                       &PhysicsAnimation::SetCurrentFrame)
         .def_property_readonly("currentTimeInSeconds",
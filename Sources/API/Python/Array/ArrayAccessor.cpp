@@ -45,6 +45,21 @@ void AddArrayAccessor1Vector(pybind11::module m, const char* name)
             });
 };
 
+template <typename T, size_t N>
+void AddArrayAccessor2Vector(pybind11::module m, const char* name)
+{
+    pybind11::class_<ArrayAccessor2<Vector<T, N>>>(m, name,
+                                                   pybind11::buffer_protocol())
+        .def_buffer(
+            [](ArrayAccessor2<Vector<T, N>>& m) -> pybind11::buffer_info {
+                return pybind11::buffer_info(
+                    m.data(), sizeof(T),
+                    pybind11::format_descriptor<T>::format(), 3,
+                    { m.Height(), m.Width(), N },
+                    { sizeof(T) * N * m.Width(), sizeof(T) * N, sizeof(T) });
+            });
+};
+
 template <typename T>
 void AddArrayAccessor2Scalar(pybind11::module m, const char* name)
 {
@@ -57,6 +72,22 @@ void AddArrayAccessor2Scalar(pybind11::module m, const char* name)
         });
 };
 
+template <typename T, size_t N>
+void AddArrayAccessor3Vector(pybind11::module m, const char* name)
+{
+    pybind11::class_<ArrayAccessor3<Vector<T, N>>>(m, name,
+                                                   pybind11::buffer_protocol())
+        .def_buffer(
+            [](ArrayAccessor3<Vector<T, N>>& m) -> pybind11::buffer_info {
+                return pybind11::buffer_info(
+                    m.data(), sizeof(T),
+                    pybind11::format_descriptor<T>::format(), 4,
+                    { m.Depth(), m.Height(), m.Width(), N },
+                    { sizeof(T) * N * m.Width() * m.Height(),
+                      sizeof(T) * N * m.Width(), sizeof(T) * N, sizeof(T) });
+            });
+};
+
 template <typename T>
 void AddArrayAccessor3Scalar(pybind11::module m, const char* name)
 {
@@ -85,11 +116,15 @@ void AddArrayAccessor1(pybind11::module& m)
 void AddArrayAccessor2(pybind11::module& m)
 {
     AddArrayAccessor2Scalar<double>(m, "ArrayAccessor2D");
+    AddArrayAccessor2Vector<double, 2>(m, "ArrayAccessor2Vector2D");
     AddArrayAccessor2Scalar<float>(m, "ArrayAccessor2F");
+    AddArrayAccessor2Vector<float, 2>(m, "ArrayAccessor2Vector2F");
 }
 
 void AddArrayAccessor3(pybind11::module& m)
 {
     AddArrayAccessor3Scalar<double>(m, "ArrayAccessor3D");
+    AddArrayAccessor3Vector<double, 3>(m, "ArrayAccessor3Vector3D");
     AddArrayAccessor3Scalar<float>(m, "ArrayAccessor3F");
+    AddArrayAccessor3Vector<float, 3>(m, "ArrayAccessor3Vector3F");
 }
\ No newline at end of file
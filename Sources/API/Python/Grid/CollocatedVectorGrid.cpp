@@ -144,8 +144,10 @@ void AddCollocatedVectorGrid2(pybind11::module& m)
 		)pbdoc",
              pybind11::arg("i"), pybind11::arg("j"))
         .def("GetDataAccessor", &CollocatedVectorGrid2::GetDataAccessor,
+             pybind11::keep_alive<0, 1>(),
              R"pbdoc(
-			Returns the data array accessor.
+			Returns the data array accessor. The returned view aliases the
+			grid storage and keeps it alive.
 		)pbdoc")
         .def("GetDataPosition", &CollocatedVectorGrid2::GetDataPosition,
              R"pbdoc(
@@ -335,8 +337,10 @@ void AddCollocatedVectorGrid3(pybind11::module& m)
 		)pbdoc",
              pybind11::arg("i"), pybind11::arg("j"), pybind11::arg("k"))
         .def("GetDataAccessor", &CollocatedVectorGrid3::GetDataAccessor,
+             pybind11::keep_alive<0, 1>(),
              R"pbdoc(
-			Returns the data array accessor.
+			Returns the data array accessor. The returned view aliases the
+			grid storage and keeps it alive.
 		)pbdoc")
         .def("GetDataPosition", &CollocatedVectorGrid3::GetDataPosition,
              R"pbdoc(
@@ -152,12 +152,16 @@ void AddFaceCenteredGrid2(pybind11::module& m)
 		)pbdoc",
              pybind11::arg("i"), pybind11::arg("j"))
         .def("GetUAccessor", &FaceCenteredGrid2::GetUAccessor,
+             pybind11::keep_alive<0, 1>(),
              R"pbdoc(
-			U data accessor.
+			U data accessor. The returned view aliases the grid storage and
+			keeps it alive.
 		)pbdoc")
         .def("GetVAccessor", &FaceCenteredGrid2::GetVAccessor,
+             pybind11::keep_alive<0, 1>(),
              R"pbdoc(
-			V data accessor.
+			V data accessor. The returned view aliases the grid storage and
+			keeps it alive.
 		)pbdoc")
         .def("GetUPosition", &FaceCenteredGrid2::GetUPosition,
              R"pbdoc(
@@ -453,16 +457,22 @@ void AddFaceCenteredGrid3(pybind11::module& m)
 		)pbdoc",
              pybind11::arg("i"), pybind11::arg("j"), pybind11::arg("k"))
         .def("GetUAccessor", &FaceCenteredGrid3::GetUAccessor,
+             pybind11::keep_alive<0, 1>(),
              R"pbdoc(
-			U data accessor.
+			U data accessor. The returned view aliases the grid storage and
+			keeps it alive.
 		)pbdoc")
         .def("GetVAccessor", &FaceCenteredGrid3::GetVAccessor,
+             pybind11::keep_alive<0, 1>(),
              R"pbdoc(
-			V data accessor.
+			V data accessor. The returned view aliases the grid storage and
+			keeps it alive.
 		)pbdoc")
         .def("GetWAccessor", &FaceCenteredGrid3::GetWAccessor,
+             pybind11::keep_alive<0, 1>(),
              R"pbdoc(
-			W data accessor.
+			W data accessor. The returned view aliases the grid storage and
+			keeps it alive.
 		)pbdoc")
         .def("GetUPosition", &FaceCenteredGrid3::GetUPosition,
              R"pbdoc(
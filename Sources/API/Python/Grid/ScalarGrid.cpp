@@ -182,7 +182,9 @@ void AddScalarGrid2(pybind11::module& m)
 		)pbdoc",
              pybind11::arg("i"), pybind11::arg("j"))
         .def("GetDataAccessor", &ScalarGrid2::GetDataAccessor,
-             R"pbdoc(The data array accessor.)pbdoc")
+             pybind11::keep_alive<0, 1>(),
+             R"pbdoc(The data array accessor. The returned view aliases the
+             grid storage and keeps it alive.)pbdoc")
         .def("GetDataPosition", &ScalarGrid2::GetDataPosition,
              R"pbdoc(The function that maps data point to its position.)pbdoc")
         .def(
@@ -423,7 +425,9 @@ void AddScalarGrid3(pybind11::module& m)
 		)pbdoc",
              pybind11::arg("i"), pybind11::arg("j"), pybind11::arg("k"))
         .def("GetDataAccessor", &ScalarGrid3::GetDataAccessor,
-             R"pbdoc(The data array accessor.)pbdoc")
+             pybind11::keep_alive<0, 1>(),
+             R"pbdoc(The data array accessor. The returned view aliases the
+             grid storage and keeps it alive.)pbdoc")
         .def("GetDataPosition", &ScalarGrid3::GetDataPosition,
              R"pbdoc(The function that maps data point to its position.)pbdoc")
         .def(
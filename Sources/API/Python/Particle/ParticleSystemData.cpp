@@ -95,38 +95,48 @@ void AddParticleSystemData2(pybind11::module& m)
                 return instance.GetPositions();
             },
             R"pbdoc(
-			Returns the position array (mutable).
-		)pbdoc")
+			Returns the position array (mutable). The returned view aliases this
+			object's storage and keeps it alive.
+		)pbdoc",
+            pybind11::keep_alive<0, 1>())
         .def_property_readonly(
             "velocities",
             [](ParticleSystemData2& instance) {
                 return instance.GetVelocities();
             },
             R"pbdoc(
-			Returns the velocity array (mutable).
-		)pbdoc")
+			Returns the velocity array (mutable). The returned view aliases this
+			object's storage and keeps it alive.
+		)pbdoc",
+            pybind11::keep_alive<0, 1>())
         .def_property_readonly(
             "forces",
             [](ParticleSystemData2& instance) { return instance.GetForces(); },
             R"pbdoc(
-			Returns the force array (mutable).
-		)pbdoc")
+			Returns the force array (mutable). The returned view aliases this
+			object's storage and keeps it alive.
+		)pbdoc",
+            pybind11::keep_alive<0, 1>())
         .def(
             "ScalarDataAt",
             [](ParticleSystemData2& instance, size_t idx) {
                 return instance.ScalarDataAt(idx);
             },
             R"pbdoc(
-			Returns custom scalar data layer at given index (mutable).
-		)pbdoc")
+			Returns custom scalar data layer at given index (mutable). The
+			returned view aliases this object's storage and keeps it alive.
+		)pbdoc",
+            pybind11::keep_alive<0, 1>())
         .def(
             "VectorDataAt",
             [](ParticleSystemData2& instance, size_t idx) {
                 return instance.VectorDataAt(idx);
             },
             R"pbdoc(
-			Returns custom vector data layer at given index (mutable).
-		)pbdoc")
+			Returns custom vector data layer at given index (mutable). The
+			returned view aliases this object's storage and keeps it alive.
+		)pbdoc",
+            pybind11::keep_alive<0, 1>())
         .def(
             "AddParticle",
             [](ParticleSystemData2& instance, pybind11::object p,
@@ -310,38 +320,48 @@ void AddParticleSystemData3(pybind11::module& m)
                 return instance.GetPositions();
             },
             R"pbdoc(
-			Returns the position array (mutable).
-		)pbdoc")
+			Returns the position array (mutable). The returned view aliases this
+			object's storage and keeps it alive.
+		)pbdoc",
+            pybind11::keep_alive<0, 1>())
         .def_property_readonly(
             "velocities",
             [](ParticleSystemData3& instance) {
                 return instance.GetVelocities();
             },
             R"pbdoc(
-			Returns the velocity array (mutable).
-		)pbdoc")
+			Returns the velocity array (mutable). The returned view aliases this
+			object's storage and keeps it alive.
+		)pbdoc",
+            pybind11::keep_alive<0, 1>())
         .def_property_readonly(
             "forces",
             [](ParticleSystemData3& instance) { return instance.GetForces(); },
             R"pbdoc(
-			Returns the force array (mutable).
-		)pbdoc")
+			Returns the force array (mutable). The returned view aliases this
+			object's storage and keeps it alive.
+		)pbdoc",
+            pybind11::keep_alive<0, 1>())
         .def(
             "ScalarDataAt",
             [](ParticleSystemData3& instance, size_t idx) {
                 return instance.ScalarDataAt(idx);
             },
             R"pbdoc(
-			Returns custom scalar data layer at given index (mutable).
-		)pbdoc")
+			Returns custom scalar data layer at given index (mutable). The
+			returned view aliases this object's storage and keeps it alive.
+		)pbdoc",
+            pybind11::keep_alive<0, 1>())
         .def(
             "VectorDataAt",
             [](ParticleSystemData3& instance, size_t idx) {
                 return instance.VectorDataAt(idx);
             },
             R"pbdoc(
-			Returns custom vector data layer at given index (mutable).
-		)pbdoc")
+			Returns custom vector data layer at given index (mutable). The
+			returned view aliases this object's storage and keeps it alive.
+		)pbdoc",
+            pybind11::keep_alive<0, 1>())
         .def(
             "AddParticle",
             [](ParticleSystemData3& instance, pybind11::object p,
@@ -36,6 +36,9 @@ void AddPointsToImplicit2(pybind11::module& m)
 
                 ConstArrayAccessor1<Vector2D> pointsAcc(points_.size(),
                                                         points_.data());
+
+                // No Python objects are touched past this point.
+                pybind11::gil_scoped_release release;
                 instance.Convert(pointsAcc, output.get());
             },
             R"pbdoc(
@@ -68,6 +71,9 @@ void AddPointsToImplicit3(pybind11::module& m)
 
                 ConstArrayAccessor1<Vector3D> pointsAcc(points_.size(),
                                                         points_.data());
+
+                // No Python objects are touched past this point.
+                pybind11::gil_scoped_release release;
                 instance.Convert(pointsAcc, output.get());
             },
             R"pbdoc(
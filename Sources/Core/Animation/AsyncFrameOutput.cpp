@@ -0,0 +1,102 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Animation/AsyncFrameOutput.hpp>
+
+#include <cassert>
+#include <utility>
+
+namespace CubbyFlow
+{
+AsyncFrameOutput::AsyncFrameOutput(OutputFunc outputFunc)
+    : m_outputFunc(std::move(outputFunc))
+{
+    assert(m_outputFunc);
+
+    m_worker = std::thread(&AsyncFrameOutput::Run, this);
+}
+
+AsyncFrameOutput::~AsyncFrameOutput()
+{
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        m_shutdown = true;
+    }
+
+    m_taskAdded.notify_one();
+    m_worker.join();
+}
+
+void AsyncFrameOutput::Submit(const Frame& frame,
+                              std::shared_ptr<const Serializable> snapshot)
+{
+    assert(snapshot != nullptr);
+
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+
+        // Keep at most one snapshot pending (double buffering) so that no
+        // more than two copies of the simulation state are alive at once.
+        m_taskFinished.wait(lock, [this] { return m_tasks.empty(); });
+
+        m_tasks.push_back(Task{ frame, std::move(snapshot) });
+    }
+
+    m_taskAdded.notify_one();
+}
+
+void AsyncFrameOutput::Flush()
+{
+    std::unique_lock<std::mutex> lock{ m_mutex };
+
+    m_taskFinished.wait(lock, [this] { return m_tasks.empty() && !m_isBusy; });
+}
+
+void AsyncFrameOutput::Run()
+{
+    std::vector<uint8_t> buffer;
+
+    while (true)
+    {
+        Task task;
+
+        {
+            std::unique_lock<std::mutex> lock{ m_mutex };
+
+            m_taskAdded.wait(lock,
+                             [this] { return m_shutdown || !m_tasks.empty(); });
+
+            if (m_tasks.empty())
+            {
+                break;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            m_isBusy = true;
+        }
+
+        // The submitting thread may queue the next frame as soon as the slot
+        // frees up.
+        m_taskFinished.notify_all();
+
+        buffer.clear();
+        task.snapshot->Serialize(&buffer);
+        m_outputFunc(task.frame, buffer);
+
+        {
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_isBusy = false;
+        }
+
+        m_taskFinished.notify_all();
+    }
+}
+}  // namespace CubbyFlow
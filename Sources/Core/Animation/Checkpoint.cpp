@@ -0,0 +1,266 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Animation/Checkpoint.hpp>
+#include <Core/Utils/Logging.hpp>
+
+#include <cassert>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace CubbyFlow
+{
+namespace
+{
+const char MANIFEST_NAME[] = "checkpoint.manifest";
+const char MANIFEST_MAGIC[] = "CUBBYFLOW_CHECKPOINT";
+const int MANIFEST_VERSION = 1;
+
+struct ManifestEntry
+{
+    uint64_t hash = 0;
+    size_t size = 0;
+};
+
+//! Referenced from an assert only, so Release builds see no use.
+[[maybe_unused]] bool IsValidComponentName(const std::string& name)
+{
+    if (name.empty())
+    {
+        return false;
+    }
+
+    for (const char c : name)
+    {
+        if (std::isalnum(static_cast<unsigned char>(c)) == 0 && c != '_' &&
+            c != '-' && c != '.')
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string HashToHex(uint64_t hash)
+{
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx",
+                  static_cast<unsigned long long>(hash));
+    return std::string{ buffer };
+}
+
+//! Component files are content-addressed so that a save never overwrites
+//! data the committed manifest still references.
+std::string ComponentFileName(const std::string& name, uint64_t hash)
+{
+    return name + "." + HashToHex(hash) + ".bin";
+}
+
+bool ReadManifest(const std::string& directoryPath,
+                  std::map<std::string, ManifestEntry>* entries)
+{
+    std::ifstream file{ directoryPath + "/" + MANIFEST_NAME };
+    if (!file)
+    {
+        return false;
+    }
+
+    std::string magic;
+    int version = 0;
+    file >> magic >> version;
+    if (magic != MANIFEST_MAGIC || version != MANIFEST_VERSION)
+    {
+        return false;
+    }
+
+    std::string hashHex, name;
+    size_t size = 0;
+    while (file >> hashHex >> size >> name)
+    {
+        ManifestEntry entry;
+        entry.hash = std::stoull(hashHex, nullptr, 16);
+        entry.size = size;
+        (*entries)[name] = entry;
+    }
+
+    return true;
+}
+
+bool WriteFileAtomic(const std::string& path, const uint8_t* data, size_t size)
+{
+    const std::string tempPath = path + ".tmp";
+
+    {
+        std::ofstream file{ tempPath, std::ios::binary };
+        if (!file)
+        {
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(data),
+                   static_cast<std::streamsize>(size));
+        if (!file)
+        {
+            return false;
+        }
+    }
+
+    return std::rename(tempPath.c_str(), path.c_str()) == 0;
+}
+}  // namespace
+
+void Checkpoint::Set(const std::string& name, std::vector<uint8_t> buffer)
+{
+    assert(IsValidComponentName(name));
+
+    m_components[name] = std::move(buffer);
+}
+
+const std::vector<uint8_t>* Checkpoint::Get(const std::string& name) const
+{
+    const auto iter = m_components.find(name);
+    return iter != m_components.end() ? &iter->second : nullptr;
+}
+
+void Checkpoint::Clear()
+{
+    m_components.clear();
+}
+
+bool Checkpoint::SaveToDirectory(const std::string& directoryPath) const
+{
+    std::map<std::string, ManifestEntry> previous;
+    ReadManifest(directoryPath, &previous);
+
+    // Phase 1: put every component file in place. Unchanged components are
+    // already on disk under their content-addressed name.
+    std::map<std::string, ManifestEntry> current;
+    for (const auto& component : m_components)
+    {
+        ManifestEntry entry;
+        entry.hash =
+            HashBuffer(component.second.data(), component.second.size());
+        entry.size = component.second.size();
+        current[component.first] = entry;
+
+        const auto prevIter = previous.find(component.first);
+        if (prevIter != previous.end() &&
+            prevIter->second.hash == entry.hash &&
+            prevIter->second.size == entry.size)
+        {
+            continue;
+        }
+
+        const std::string path =
+            directoryPath + "/" +
+            ComponentFileName(component.first, entry.hash);
+        if (!WriteFileAtomic(path, component.second.data(),
+                             component.second.size()))
+        {
+            CUBBYFLOW_ERROR << "Failed to write checkpoint component: "
+                            << path;
+            return false;
+        }
+    }
+
+    // Phase 2: commit by renaming the manifest over the previous one.
+    std::ostringstream manifest;
+    manifest << MANIFEST_MAGIC << " " << MANIFEST_VERSION << "\n";
+    for (const auto& entry : current)
+    {
+        manifest << HashToHex(entry.second.hash) << " " << entry.second.size
+                 << " " << entry.first << "\n";
+    }
+
+    const std::string manifestStr = manifest.str();
+    if (!WriteFileAtomic(
+            directoryPath + "/" + MANIFEST_NAME,
+            reinterpret_cast<const uint8_t*>(manifestStr.data()),
+            manifestStr.size()))
+    {
+        CUBBYFLOW_ERROR << "Failed to write checkpoint manifest in: "
+                        << directoryPath;
+        return false;
+    }
+
+    // The previous checkpoint is no longer referenced; drop the component
+    // files it alone used.
+    for (const auto& entry : previous)
+    {
+        const auto currIter = current.find(entry.first);
+        if (currIter == current.end() ||
+            currIter->second.hash != entry.second.hash)
+        {
+            std::remove((directoryPath + "/" +
+                         ComponentFileName(entry.first, entry.second.hash))
+                            .c_str());
+        }
+    }
+
+    return true;
+}
+
+bool Checkpoint::LoadFromDirectory(const std::string& directoryPath)
+{
+    std::map<std::string, ManifestEntry> entries;
+    if (!ReadManifest(directoryPath, &entries))
+    {
+        CUBBYFLOW_ERROR << "Failed to read checkpoint manifest in: "
+                        << directoryPath;
+        return false;
+    }
+
+    std::map<std::string, std::vector<uint8_t>> components;
+    for (const auto& entry : entries)
+    {
+        const std::string path =
+            directoryPath + "/" +
+            ComponentFileName(entry.first, entry.second.hash);
+
+        std::ifstream file{ path, std::ios::binary };
+        if (!file)
+        {
+            CUBBYFLOW_ERROR << "Missing checkpoint component: " << path;
+            return false;
+        }
+
+        std::vector<uint8_t> buffer(entry.second.size);
+        file.read(reinterpret_cast<char*>(buffer.data()),
+                  static_cast<std::streamsize>(buffer.size()));
+        if (static_cast<size_t>(file.gcount()) != entry.second.size ||
+            HashBuffer(buffer.data(), buffer.size()) != entry.second.hash)
+        {
+            CUBBYFLOW_ERROR << "Corrupt checkpoint component: " << path;
+            return false;
+        }
+
+        components[entry.first] = std::move(buffer);
+    }
+
+    m_components = std::move(components);
+    return true;
+}
+
+uint64_t Checkpoint::HashBuffer(const uint8_t* data, size_t size)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+}  // namespace CubbyFlow
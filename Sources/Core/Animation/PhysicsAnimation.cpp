@@ -11,8 +11,12 @@
 #include <Core/Animation/PhysicsAnimation.hpp>
 #include <Core/Utils/Logging.hpp>
 #include <Core/Utils/Macros.hpp>
+#include <Core/Utils/Parallel.hpp>
+#include <Core/Utils/Profiler.hpp>
 #include <Core/Utils/Timer.hpp>
 
+#include <cstring>
+
 namespace CubbyFlow
 {
 PhysicsAnimation::PhysicsAnimation()
@@ -40,6 +44,16 @@ void PhysicsAnimation::SetNumberOfFixedSubTimeSteps(unsigned int numberOfSteps)
     m_numberOfFixedSubTimeSteps = numberOfSteps;
 }
 
+unsigned int PhysicsAnimation::GetThreadBudget() const
+{
+    return m_threadBudget;
+}
+
+void PhysicsAnimation::SetThreadBudget(unsigned int numThreads)
+{
+    m_threadBudget = numThreads;
+}
+
 void PhysicsAnimation::AdvanceSingleFrame()
 {
     Frame f = m_currentFrame;
@@ -61,6 +75,67 @@ double PhysicsAnimation::GetCurrentTimeInSeconds() const
     return m_currentTime;
 }
 
+void PhysicsAnimation::SetFrameOutput(SnapshotFunc snapshotFunc,
+                                      AsyncFrameOutput::OutputFunc outputFunc)
+{
+    m_snapshotFunc = std::move(snapshotFunc);
+
+    if (m_snapshotFunc && outputFunc)
+    {
+        m_frameOutput =
+            std::make_shared<AsyncFrameOutput>(std::move(outputFunc));
+    }
+    else
+    {
+        m_frameOutput.reset();
+    }
+}
+
+void PhysicsAnimation::SetFramePublisher(SnapshotFunc snapshotFunc,
+                                         SharedMemoryFrameChannelPtr channel)
+{
+    if (channel == nullptr)
+    {
+        SetFrameOutput(std::move(snapshotFunc), nullptr);
+        return;
+    }
+
+    SetFrameOutput(
+        std::move(snapshotFunc),
+        [channel = std::move(channel)](const Frame& frame,
+                                       const std::vector<uint8_t>& buffer) {
+            channel->Publish(static_cast<uint64_t>(frame.index),
+                             buffer.data(), buffer.size());
+        });
+}
+
+void PhysicsAnimation::FlushFrameOutput() const
+{
+    if (m_frameOutput != nullptr)
+    {
+        m_frameOutput->Flush();
+    }
+}
+
+bool PhysicsAnimation::SaveCheckpoint(const std::string& directoryPath) const
+{
+    Checkpoint checkpoint;
+    OnSaveCheckpoint(&checkpoint);
+
+    return checkpoint.SaveToDirectory(directoryPath);
+}
+
+bool PhysicsAnimation::LoadCheckpoint(const std::string& directoryPath)
+{
+    Checkpoint checkpoint;
+    if (!checkpoint.LoadFromDirectory(directoryPath))
+    {
+        return false;
+    }
+
+    return OnLoadCheckpoint(checkpoint);
+}
+
 unsigned int PhysicsAnimation::GetNumberOfSubTimeSteps(
     double timeIntervalInSeconds) const
 {
@@ -72,6 +147,10 @@ unsigned int PhysicsAnimation::GetNumberOfSubTimeSteps(
 
 void PhysicsAnimation::OnUpdate(const Frame& frame)
 {
+    // Scopes every parallel loop of this update, including first-frame
+    // initialization, to this animation's thread budget (no-op when zero).
+    const ScopedThreadBudget threadBudget{ m_threadBudget };
+
     if (frame.index > m_currentFrame.index)
     {
         if (m_currentFrame.index < 0)
@@ -84,6 +163,16 @@ void PhysicsAnimation::OnUpdate(const Frame& frame)
         for (int32_t i = 0; i < numberOfFrames; ++i)
         {
             AdvanceTimeStep(frame.timeIntervalInSeconds);
+
+            if (m_frameOutput != nullptr)
+            {
+                // Copy the state on this thread, then let the background
+                // stage serialize and write it while the next frame runs.
+                Frame outputFrame = frame;
+                outputFrame.index = m_currentFrame.index + i + 1;
+
+                m_frameOutput->Submit(outputFrame, m_snapshotFunc());
+            }
         }
 
         m_currentFrame = frame;
@@ -92,6 +181,8 @@ void PhysicsAnimation::OnUpdate(const Frame& frame)
 
 void PhysicsAnimation::AdvanceTimeStep(double timeIntervalInSeconds)
 {
+    CUBBYFLOW_PROFILE_ZONE("PhysicsAnimation::AdvanceTimeStep");
+
     m_currentTime = m_currentFrame.TimeInSeconds();
 
     if (m_isUsingFixedSubTimeSteps)
@@ -110,7 +201,10 @@ void PhysicsAnimation::AdvanceTimeStep(double timeIntervalInSeconds)
                            << " (1/" << 1.0 / actualTimeInterval << ") seconds";
 
             Timer timer;
-            OnAdvanceTimeStep(actualTimeInterval);
+            {
+                CUBBYFLOW_PROFILE_ZONE("PhysicsAnimation::OnAdvanceTimeStep");
+                OnAdvanceTimeStep(actualTimeInterval);
+            }
 
             CUBBYFLOW_INFO << "End onAdvanceTimeStep (took "
                            << timer.DurationInSeconds() << " seconds)";
@@ -136,7 +230,10 @@ void PhysicsAnimation::AdvanceTimeStep(double timeIntervalInSeconds)
                            << " (1/" << 1.0 / actualTimeInterval << ") seconds";
 
             Timer timer;
-            OnAdvanceTimeStep(actualTimeInterval);
+            {
+                CUBBYFLOW_PROFILE_ZONE("PhysicsAnimation::OnAdvanceTimeStep");
+                OnAdvanceTimeStep(actualTimeInterval);
+            }
 
             CUBBYFLOW_INFO << "End onAdvanceTimeStep (took "
                            << timer.DurationInSeconds() << " seconds)";
@@ -156,4 +253,63 @@ void PhysicsAnimation::OnInitialize()
 {
     // Do nothing
 }
+
+void PhysicsAnimation::OnSaveCheckpoint(Checkpoint* checkpoint) const
+{
+    std::vector<uint8_t> buffer(sizeof(int32_t) + 2 * sizeof(double) +
+                                sizeof(uint8_t) + sizeof(uint32_t));
+    uint8_t* cursor = buffer.data();
+
+    const auto append = [&cursor](const void* src, size_t size) {
+        std::memcpy(cursor, src, size);
+        cursor += size;
+    };
+
+    const int32_t frameIndex = m_currentFrame.index;
+    const double frameInterval = m_currentFrame.timeIntervalInSeconds;
+    const uint8_t isFixed = m_isUsingFixedSubTimeSteps ? 1 : 0;
+    const uint32_t numSubSteps = m_numberOfFixedSubTimeSteps;
+
+    append(&frameIndex, sizeof(frameIndex));
+    append(&frameInterval, sizeof(frameInterval));
+    append(&m_currentTime, sizeof(m_currentTime));
+    append(&isFixed, sizeof(isFixed));
+    append(&numSubSteps, sizeof(numSubSteps));
+
+    checkpoint->Set("physicsAnimation", std::move(buffer));
+}
+
+bool PhysicsAnimation::OnLoadCheckpoint(const Checkpoint& checkpoint)
+{
+    const std::vector<uint8_t>* buffer = checkpoint.Get("physicsAnimation");
+    if (buffer == nullptr ||
+        buffer->size() != sizeof(int32_t) + 2 * sizeof(double) +
+                              sizeof(uint8_t) + sizeof(uint32_t))
+    {
+        return false;
+    }
+
+    const uint8_t* cursor = buffer->data();
+    const auto read = [&cursor](void* dst, size_t size) {
+        std::memcpy(dst, cursor, size);
+        cursor += size;
+    };
+
+    int32_t frameIndex = 0;
+    double frameInterval = 0.0;
+    uint8_t isFixed = 0;
+    uint32_t numSubSteps = 0;
+
+    read(&frameIndex, sizeof(frameIndex));
+    read(&frameInterval, sizeof(frameInterval));
+    read(&m_currentTime, sizeof(m_currentTime));
+    read(&isFixed, sizeof(isFixed));
+    read(&numSubSteps, sizeof(numSubSteps));
+
+    m_currentFrame = Frame{ frameIndex, frameInterval };
+    m_isUsingFixedSubTimeSteps = isFixed != 0;
+    m_numberOfFixedSubTimeSteps = numSubSteps;
+
+    return true;
+}
 }  // namespace CubbyFlow
\ No newline at end of file
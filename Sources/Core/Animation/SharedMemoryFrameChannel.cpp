@@ -0,0 +1,367 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Animation/SharedMemoryFrameChannel.hpp>
+#include <Core/Utils/Logging.hpp>
+
+#include <atomic>
+#include <cstring>
+
+#ifdef CUBBYFLOW_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CubbyFlow
+{
+namespace
+{
+// "CBFLWFR1" -- identifies a mapped region as a frame channel.
+constexpr uint64_t CHANNEL_MAGIC = 0x3152465746C42343ULL;
+
+constexpr size_t SLOT_ALIGNMENT = 64;
+
+//! Region header. latestSequence is even and increments by two per publish;
+//! zero means nothing has been published yet.
+struct ChannelHeader
+{
+    uint64_t magic;
+    uint64_t numSlots;
+    uint64_t slotCapacity;
+    std::atomic<uint64_t> latestFrame;
+    std::atomic<uint64_t> publishCount;
+};
+
+//! Per-slot seqlock header, immediately followed by the payload bytes.
+struct SlotHeader
+{
+    std::atomic<uint64_t> sequence;
+    uint64_t frameIndex;
+    uint64_t size;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Seqlock requires lock-free 64-bit atomics");
+
+size_t SlotStride(size_t slotCapacity)
+{
+    const size_t raw = sizeof(SlotHeader) + slotCapacity;
+    return (raw + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT * SLOT_ALIGNMENT;
+}
+
+size_t RegionSize(size_t numSlots, size_t slotCapacity)
+{
+    return SlotStride(sizeof(ChannelHeader)) +
+           numSlots * SlotStride(slotCapacity);
+}
+
+ChannelHeader* GetHeader(void* mapping)
+{
+    return static_cast<ChannelHeader*>(mapping);
+}
+
+SlotHeader* GetSlot(void* mapping, size_t slotIdx, size_t slotCapacity)
+{
+    uint8_t* base =
+        static_cast<uint8_t*>(mapping) + SlotStride(sizeof(ChannelHeader));
+    return reinterpret_cast<SlotHeader*>(base +
+                                         slotIdx * SlotStride(slotCapacity));
+}
+
+#ifndef CUBBYFLOW_WINDOWS
+std::string PosixName(const std::string& name)
+{
+    if (!name.empty() && name[0] == '/')
+    {
+        return name;
+    }
+
+    return '/' + name;
+}
+#endif
+}  // namespace
+
+SharedMemoryFrameChannelPtr SharedMemoryFrameChannel::Create(
+    const std::string& name, size_t numSlots, size_t slotCapacity)
+{
+    if (numSlots == 0 || slotCapacity == 0)
+    {
+        CUBBYFLOW_ERROR << "Invalid frame channel geometry: " << numSlots
+                        << " slots x " << slotCapacity << " bytes";
+        return nullptr;
+    }
+
+    const size_t regionSize = RegionSize(numSlots, slotCapacity);
+    void* mapping = nullptr;
+
+#ifdef CUBBYFLOW_WINDOWS
+    HANDLE fileMapping = CreateFileMappingA(
+        INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(regionSize >> 32),
+        static_cast<DWORD>(regionSize & 0xFFFFFFFFULL), name.c_str());
+    if (fileMapping == nullptr)
+    {
+        CUBBYFLOW_ERROR << "Failed to create shared memory: " << name;
+        return nullptr;
+    }
+
+    mapping = MapViewOfFile(fileMapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (mapping == nullptr)
+    {
+        CloseHandle(fileMapping);
+        CUBBYFLOW_ERROR << "Failed to map shared memory: " << name;
+        return nullptr;
+    }
+#else
+    const std::string posixName = PosixName(name);
+    shm_unlink(posixName.c_str());
+
+    const int fd =
+        shm_open(posixName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        CUBBYFLOW_ERROR << "Failed to create shared memory: " << posixName;
+        return nullptr;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(regionSize)) != 0)
+    {
+        close(fd);
+        shm_unlink(posixName.c_str());
+        CUBBYFLOW_ERROR << "Failed to size shared memory: " << posixName;
+        return nullptr;
+    }
+
+    mapping = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        shm_unlink(posixName.c_str());
+        CUBBYFLOW_ERROR << "Failed to map shared memory: " << posixName;
+        return nullptr;
+    }
+#endif
+
+    std::memset(mapping, 0, regionSize);
+
+    ChannelHeader* header = GetHeader(mapping);
+    header->numSlots = numSlots;
+    header->slotCapacity = slotCapacity;
+    header->latestFrame.store(0, std::memory_order_relaxed);
+    header->publishCount.store(0, std::memory_order_relaxed);
+    // The magic goes in last so a concurrently attaching reader never sees
+    // a half-initialized header behind it.
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = CHANNEL_MAGIC;
+
+    auto channel =
+        SharedMemoryFrameChannelPtr(new SharedMemoryFrameChannel());
+    channel->m_name = name;
+    channel->m_mapping = mapping;
+    channel->m_mappingSize = regionSize;
+    channel->m_isWriter = true;
+#ifdef CUBBYFLOW_WINDOWS
+    channel->m_fileMapping = fileMapping;
+#endif
+
+    return channel;
+}
+
+SharedMemoryFrameChannelPtr SharedMemoryFrameChannel::Open(
+    const std::string& name)
+{
+    void* mapping = nullptr;
+    size_t regionSize = 0;
+
+#ifdef CUBBYFLOW_WINDOWS
+    HANDLE fileMapping =
+        OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+    if (fileMapping == nullptr)
+    {
+        return nullptr;
+    }
+
+    mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+    if (mapping == nullptr)
+    {
+        CloseHandle(fileMapping);
+        return nullptr;
+    }
+
+    MEMORY_BASIC_INFORMATION info;
+    VirtualQuery(mapping, &info, sizeof(info));
+    regionSize = info.RegionSize;
+#else
+    const std::string posixName = PosixName(name);
+
+    const int fd = shm_open(posixName.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(ChannelHeader))
+    {
+        close(fd);
+        return nullptr;
+    }
+    regionSize = static_cast<size_t>(st.st_size);
+
+    mapping = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        return nullptr;
+    }
+#endif
+
+    const ChannelHeader* header = GetHeader(mapping);
+    if (header->magic != CHANNEL_MAGIC ||
+        RegionSize(header->numSlots, header->slotCapacity) > regionSize)
+    {
+        CUBBYFLOW_ERROR << "Shared memory region is not a frame channel: "
+                        << name;
+#ifdef CUBBYFLOW_WINDOWS
+        UnmapViewOfFile(mapping);
+        CloseHandle(fileMapping);
+#else
+        munmap(mapping, regionSize);
+#endif
+        return nullptr;
+    }
+
+    auto channel =
+        SharedMemoryFrameChannelPtr(new SharedMemoryFrameChannel());
+    channel->m_name = name;
+    channel->m_mapping = mapping;
+    channel->m_mappingSize = regionSize;
+    channel->m_isWriter = false;
+#ifdef CUBBYFLOW_WINDOWS
+    channel->m_fileMapping = fileMapping;
+#endif
+
+    return channel;
+}
+
+SharedMemoryFrameChannel::~SharedMemoryFrameChannel()
+{
+    if (m_mapping == nullptr)
+    {
+        return;
+    }
+
+#ifdef CUBBYFLOW_WINDOWS
+    UnmapViewOfFile(m_mapping);
+    CloseHandle(m_fileMapping);
+#else
+    munmap(m_mapping, m_mappingSize);
+    if (m_isWriter)
+    {
+        shm_unlink(PosixName(m_name).c_str());
+    }
+#endif
+}
+
+size_t SharedMemoryFrameChannel::GetNumberOfSlots() const
+{
+    return GetHeader(m_mapping)->numSlots;
+}
+
+size_t SharedMemoryFrameChannel::GetSlotCapacity() const
+{
+    return GetHeader(m_mapping)->slotCapacity;
+}
+
+bool SharedMemoryFrameChannel::Publish(uint64_t frameIndex,
+                                       const uint8_t* data, size_t size)
+{
+    ChannelHeader* header = GetHeader(m_mapping);
+
+    if (size > header->slotCapacity)
+    {
+        CUBBYFLOW_WARN << "Frame " << frameIndex << " (" << size
+                       << " bytes) exceeds channel slot capacity ("
+                       << header->slotCapacity << " bytes); skipped";
+        return false;
+    }
+
+    SlotHeader* slot = GetSlot(m_mapping, frameIndex % header->numSlots,
+                               header->slotCapacity);
+
+    // Seqlock write: odd sequence marks the slot as being rewritten.
+    const uint64_t seq = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->frameIndex = frameIndex;
+    slot->size = size;
+    std::memcpy(slot + 1, data, size);
+
+    slot->sequence.store(seq + 2, std::memory_order_release);
+
+    header->latestFrame.store(frameIndex, std::memory_order_relaxed);
+    header->publishCount.fetch_add(1, std::memory_order_release);
+
+    return true;
+}
+
+bool SharedMemoryFrameChannel::ReadLatest(uint64_t* frameIndex,
+                                          std::vector<uint8_t>* data) const
+{
+    const ChannelHeader* header = GetHeader(m_mapping);
+
+    if (header->publishCount.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    constexpr int MAX_ATTEMPTS = 64;
+    for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt)
+    {
+        const uint64_t latest =
+            header->latestFrame.load(std::memory_order_relaxed);
+        SlotHeader* slot = GetSlot(m_mapping, latest % header->numSlots,
+                                   header->slotCapacity);
+
+        const uint64_t seqBefore =
+            slot->sequence.load(std::memory_order_acquire);
+        if (seqBefore == 0 || (seqBefore & 1) != 0)
+        {
+            continue;
+        }
+
+        const uint64_t size = slot->size;
+        if (size > header->slotCapacity)
+        {
+            continue;
+        }
+
+        *frameIndex = slot->frameIndex;
+        data->resize(size);
+        std::memcpy(data->data(), slot + 1, size);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) == seqBefore)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+}  // namespace CubbyFlow
@@ -0,0 +1,90 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Animation/SimulationBatchRunner.hpp>
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <algorithm>
+
+namespace CubbyFlow
+{
+size_t SimulationBatchRunner::AddSimulation(
+    const PhysicsAnimationPtr& simulation, size_t coreBudget)
+{
+    m_entries.push_back(Entry{ simulation, std::max(coreBudget, ONE_SIZE) });
+    return m_entries.size() - 1;
+}
+
+size_t SimulationBatchRunner::GetNumberOfSimulations() const
+{
+    return m_entries.size();
+}
+
+const PhysicsAnimationPtr& SimulationBatchRunner::GetSimulationAt(
+    size_t i) const
+{
+    return m_entries[i].simulation;
+}
+
+void SimulationBatchRunner::SetSharedResource(const std::string& key,
+                                              std::shared_ptr<void> resource)
+{
+    m_sharedResources[key] = std::move(resource);
+}
+
+void SimulationBatchRunner::AdvanceSingleFrame()
+{
+    const size_t poolSize =
+        std::max<size_t>(GetMaxNumberOfThreads(), ONE_SIZE);
+
+    size_t waveBegin = 0;
+    while (waveBegin < m_entries.size())
+    {
+        // Close the wave once the next simulation's budget no longer fits.
+        // The first simulation always joins, so budgets larger than the pool
+        // degenerate to running that simulation alone with the whole pool.
+        size_t waveEnd = waveBegin;
+        size_t budget = 0;
+
+        while (waveEnd < m_entries.size())
+        {
+            const size_t coreBudget =
+                std::min(m_entries[waveEnd].coreBudget, poolSize);
+            if (waveEnd > waveBegin && budget + coreBudget > poolSize)
+            {
+                break;
+            }
+
+            budget += coreBudget;
+            ++waveEnd;
+        }
+
+        ParallelFor(waveBegin, waveEnd, [this, poolSize](size_t i) {
+            // The wave packing assumed this width; enforce it so one hungry
+            // simulation cannot oversubscribe its wave mates.
+            const ScopedThreadBudget budget{ static_cast<unsigned int>(
+                std::min(m_entries[i].coreBudget, poolSize)) };
+
+            m_entries[i].simulation->AdvanceSingleFrame();
+        });
+
+        waveBegin = waveEnd;
+    }
+}
+
+void SimulationBatchRunner::AdvanceFrames(size_t numberOfFrames)
+{
+    for (size_t frame = 0; frame < numberOfFrames; ++frame)
+    {
+        AdvanceSingleFrame();
+    }
+}
+}  // namespace CubbyFlow
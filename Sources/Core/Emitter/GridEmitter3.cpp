@@ -10,11 +10,18 @@
 
 #include <Core/Emitter/GridEmitter3.hpp>
 
+#include <limits>
+
 namespace CubbyFlow
 {
 void GridEmitter3::Update(double currentTimeInSeconds,
                           double timeIntervalInSeconds)
 {
+    if (m_state != EmitterState::Active)
+    {
+        return;
+    }
+
     if (m_onBeginUpdateCallback)
     {
         m_onBeginUpdateCallback(this, currentTimeInSeconds,
@@ -34,6 +41,23 @@ void GridEmitter3::SetIsEnabled(bool enabled)
     m_isEnabled = enabled;
 }
 
+EmitterState GridEmitter3::GetState() const
+{
+    return m_state;
+}
+
+void GridEmitter3::SetState(EmitterState state)
+{
+    m_state = state;
+}
+
+BoundingBox3D GridEmitter3::GetInfluenceBounds() const
+{
+    constexpr double extent = std::numeric_limits<double>::max();
+    return BoundingBox3D{ Vector3D{ -extent, -extent, -extent },
+                          Vector3D{ extent, extent, extent } };
+}
+
 void GridEmitter3::SetOnBeginUpdateCallback(
     const OnBeginUpdateCallback& callback)
 {
@@ -25,6 +25,17 @@ void GridEmitterSet3::AddEmitter(const GridEmitter3Ptr& emitter)
     m_emitters.push_back(emitter);
 }
 
+void GridEmitterSet3::SetActiveRegion(const BoundingBox3D& region)
+{
+    m_activeRegion = region;
+    m_hasActiveRegion = true;
+}
+
+void GridEmitterSet3::ClearActiveRegion()
+{
+    m_hasActiveRegion = false;
+}
+
 void GridEmitterSet3::OnUpdate(double currentTimeInSeconds,
                                double timeIntervalInSeconds)
 {
@@ -35,6 +46,25 @@ void GridEmitterSet3::OnUpdate(double currentTimeInSeconds,
 
     for (auto& emitter : m_emitters)
     {
+        if (emitter->GetState() == EmitterState::Expired)
+        {
+            continue;
+        }
+
+        if (m_hasActiveRegion)
+        {
+            if (!emitter->GetInfluenceBounds().Overlaps(m_activeRegion))
+            {
+                emitter->SetState(EmitterState::Sleeping);
+                continue;
+            }
+
+            if (emitter->GetState() == EmitterState::Sleeping)
+            {
+                emitter->SetState(EmitterState::Active);
+            }
+        }
+
         emitter->Update(currentTimeInSeconds, timeIntervalInSeconds);
     }
 }
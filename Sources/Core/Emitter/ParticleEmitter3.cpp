@@ -11,11 +11,18 @@
 #include <Core/Emitter/ParticleEmitter3.hpp>
 #include <Core/Utils/Macros.hpp>
 
+#include <limits>
+
 namespace CubbyFlow
 {
 void ParticleEmitter3::Update(double currentTimeInSeconds,
                               double timeIntervalInSeconds)
 {
+    if (m_state != EmitterState::Active)
+    {
+        return;
+    }
+
     if (m_onBeginUpdateCallback)
     {
         m_onBeginUpdateCallback(this, currentTimeInSeconds,
@@ -47,6 +54,23 @@ void ParticleEmitter3::SetIsEnabled(bool enabled)
     m_isEnabled = enabled;
 }
 
+EmitterState ParticleEmitter3::GetState() const
+{
+    return m_state;
+}
+
+void ParticleEmitter3::SetState(EmitterState state)
+{
+    m_state = state;
+}
+
+BoundingBox3D ParticleEmitter3::GetInfluenceBounds() const
+{
+    constexpr double extent = std::numeric_limits<double>::max();
+    return BoundingBox3D{ Vector3D{ -extent, -extent, -extent },
+                          Vector3D{ extent, extent, extent } };
+}
+
 void ParticleEmitter3::SetOnBeginUpdateCallback(
     const OnBeginUpdateCallback& callback)
 {
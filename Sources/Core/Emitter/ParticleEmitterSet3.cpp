@@ -9,6 +9,8 @@
 // property of any third parties.
 
 #include <Core/Emitter/ParticleEmitterSet3.hpp>
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/Parallel.hpp>
 
 #include <utility>
 
@@ -34,6 +36,61 @@ void ParticleEmitterSet3::OnSetTarget(const ParticleSystemData3Ptr& particles)
     }
 }
 
+bool ParticleEmitterSet3::GetIsParallelUpdateEnabled() const
+{
+    return m_isParallelUpdateEnabled;
+}
+
+void ParticleEmitterSet3::SetIsParallelUpdateEnabled(bool enabled)
+{
+    m_isParallelUpdateEnabled = enabled;
+}
+
+void ParticleEmitterSet3::SetActiveRegion(const BoundingBox3D& region)
+{
+    m_activeRegion = region;
+    m_hasActiveRegion = true;
+}
+
+void ParticleEmitterSet3::ClearActiveRegion()
+{
+    m_hasActiveRegion = false;
+}
+
+std::vector<size_t> ParticleEmitterSet3::CollectLiveEmitters()
+{
+    std::vector<size_t> live;
+    live.reserve(m_emitters.size());
+
+    for (size_t i = 0; i < m_emitters.size(); ++i)
+    {
+        const ParticleEmitter3Ptr& emitter = m_emitters[i];
+
+        if (emitter->GetState() == EmitterState::Expired)
+        {
+            continue;
+        }
+
+        if (m_hasActiveRegion)
+        {
+            if (!emitter->GetInfluenceBounds().Overlaps(m_activeRegion))
+            {
+                emitter->SetState(EmitterState::Sleeping);
+                continue;
+            }
+
+            if (emitter->GetState() == EmitterState::Sleeping)
+            {
+                emitter->SetState(EmitterState::Active);
+            }
+        }
+
+        live.push_back(i);
+    }
+
+    return live;
+}
+
 void ParticleEmitterSet3::OnUpdate(double currentTimeInSeconds,
                                    double timeIntervalInSeconds)
 {
@@ -42,9 +99,27 @@ void ParticleEmitterSet3::OnUpdate(double currentTimeInSeconds,
         return;
     }
 
-    for (auto& emitter : m_emitters)
+    const std::vector<size_t> live = CollectLiveEmitters();
+    const ParticleSystemData3Ptr& particles = GetTarget();
+
+    if (m_isParallelUpdateEnabled && particles != nullptr)
+    {
+        // Stage appends lock-free so the sub-emitters can run concurrently;
+        // the merge happens once after they all finish.
+        particles->BeginConcurrentAppend();
+
+        ParallelFor(ZERO_SIZE, live.size(), [&](size_t i) {
+            m_emitters[live[i]]->Update(currentTimeInSeconds,
+                                        timeIntervalInSeconds);
+        });
+
+        particles->EndConcurrentAppend();
+        return;
+    }
+
+    for (const size_t i : live)
     {
-        emitter->Update(currentTimeInSeconds, timeIntervalInSeconds);
+        m_emitters[i]->Update(currentTimeInSeconds, timeIntervalInSeconds);
     }
 }
 
@@ -10,15 +10,38 @@
 
 #include <Core/Emitter/PointParticleEmitter3.hpp>
 #include <Core/Matrix/Matrix3x3.hpp>
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/Parallel.hpp>
 #include <Core/Utils/Samplers.hpp>
 
 namespace CubbyFlow
 {
+namespace
+{
+// Counter-based RNG: a splitmix64-style finalizer hashes the seed and the
+// global particle index, so every particle draws its own samples without any
+// shared generator state. Emission order then no longer matters, which keeps
+// parallel emission bitwise-identical across thread counts and re-runs.
+uint64_t HashCounter(uint64_t state)
+{
+    state += 0x9E3779B97F4A7C15ULL;
+    state = (state ^ (state >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    state = (state ^ (state >> 27)) * 0x94D049BB133111EBULL;
+    return state ^ (state >> 31);
+}
+
+double ToUniformDouble(uint64_t hash)
+{
+    // Upper 53 bits mapped to [0, 1)
+    return static_cast<double>(hash >> 11) * (1.0 / 9007199254740992.0);
+}
+}  // namespace
+
 PointParticleEmitter3::PointParticleEmitter3(
     const Vector3D& origin, const Vector3D& direction, double speed,
     double spreadAngleInDegrees, size_t maxNumOfNewParticlesPerSec,
     size_t maxNumOfParticles, uint32_t seed)
-    : m_rng(seed),
+    : m_seed(seed),
       m_maxNumberOfNewParticlesPerSecond(maxNumOfNewParticlesPerSec),
       m_maxNumberOfParticles(maxNumOfParticles),
       m_origin(origin),
@@ -47,6 +70,18 @@ size_t PointParticleEmitter3::GetMaxNumberOfParticles() const
 void PointParticleEmitter3::SetMaxNumberOfParticles(size_t maxNumberOfParticles)
 {
     m_maxNumberOfParticles = maxNumberOfParticles;
+
+    // Raising the budget re-arms an emitter that expired on exhausting it.
+    if (GetState() == EmitterState::Expired &&
+        m_numberOfEmittedParticles < m_maxNumberOfParticles)
+    {
+        SetState(EmitterState::Active);
+    }
+}
+
+BoundingBox3D PointParticleEmitter3::GetInfluenceBounds() const
+{
+    return BoundingBox3D{ m_origin, m_origin };
 }
 
 void PointParticleEmitter3::OnUpdate(double currentTimeInSeconds,
@@ -92,26 +127,39 @@ void PointParticleEmitter3::OnUpdate(double currentTimeInSeconds,
 
         m_numberOfEmittedParticles += newPositions.size();
     }
+
+    // Once the budget is spent no further frame can emit; expire so that
+    // emitter sets skip this emitter from now on.
+    if (m_numberOfEmittedParticles >= m_maxNumberOfParticles)
+    {
+        SetState(EmitterState::Expired);
+    }
 }
 
 void PointParticleEmitter3::Emit(Array1<Vector3D>* newPositions,
                                  Array1<Vector3D>* newVelocities,
                                  size_t maxNewNumberOfParticles)
 {
-    for (size_t i = 0; i < maxNewNumberOfParticles; ++i)
-    {
-        Vector3D newDirection = UniformSampleCone(
-            Random(), Random(), m_direction, m_spreadAngleInRadians);
+    newPositions->Resize(maxNewNumberOfParticles);
+    newVelocities->Resize(maxNewNumberOfParticles);
 
-        newPositions->Append(m_origin);
-        newVelocities->Append(m_speed * newDirection);
-    }
-}
+    ParallelFor(ZERO_SIZE, maxNewNumberOfParticles, [&](size_t i) {
+        // Keyed on the global particle index so that every frame draws a
+        // fresh, reproducible pair of uniforms regardless of batch size.
+        const uint64_t key =
+            (static_cast<uint64_t>(m_seed) << 32) ^
+            static_cast<uint64_t>(m_numberOfEmittedParticles + i);
 
-double PointParticleEmitter3::Random()
-{
-    std::uniform_real_distribution<> d{ 0.0, 1.0 };
-    return d(m_rng);
+        const double u1 = ToUniformDouble(HashCounter(key));
+        const double u2 =
+            ToUniformDouble(HashCounter(key ^ 0x5851F42D4C957F2DULL));
+
+        const Vector3D newDirection =
+            UniformSampleCone(u1, u2, m_direction, m_spreadAngleInRadians);
+
+        (*newPositions)[i] = m_origin;
+        (*newVelocities)[i] = m_speed * newDirection;
+    });
 }
 
 PointParticleEmitter3::Builder PointParticleEmitter3::GetBuilder()
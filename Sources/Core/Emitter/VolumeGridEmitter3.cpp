@@ -14,11 +14,166 @@
 #include <Core/Grid/FaceCenteredGrid3.hpp>
 #include <Core/Utils/LevelSetUtils.hpp>
 #include <Core/Utils/Macros.hpp>
+#include <Core/Utils/Parallel.hpp>
 
 #include <utility>
 
 namespace CubbyFlow
 {
+namespace
+{
+//! Edge length of a fine classification tile, in grid points.
+constexpr size_t PYRAMID_TILE_SIZE = 8;
+//! Edge length of a coarse pyramid block, in tiles.
+constexpr size_t PYRAMID_BLOCK_TILES = 4;
+
+constexpr char PYRAMID_NEAR = 0;
+constexpr char PYRAMID_INSIDE = 1;
+constexpr char PYRAMID_OUTSIDE = 2;
+
+//!
+//! \brief Per-tile classification of a target grid against the source SDF.
+//!
+//! Decided tiles carry the reference point and distance that proved them
+//! inside or outside, so per-point distance bounds can be derived from them
+//! without querying the source again.
+//!
+struct SDFPyramid
+{
+    Array3<char> tileClass;
+    Array3<double> tileSDF;
+    Array3<Vector3D> tileCenter;
+    Size3 numTiles;
+};
+
+//! Classifies a cell range against \p source using the center distance and
+//! the half-diagonal of the range. Returns PYRAMID_NEAR when undecided.
+template <typename PosFunc>
+char ClassifyRange(const ImplicitSurface3& source, const PosFunc& pos,
+                   const Size3& begin, const Size3& end, double margin,
+                   Vector3D* center, double* sdf)
+{
+    const Vector3D lo = pos(begin.x, begin.y, begin.z);
+    const Vector3D hi = pos(end.x - 1, end.y - 1, end.z - 1);
+
+    *center = 0.5 * (lo + hi);
+    *sdf = source.SignedDistance(*center);
+
+    const double radius = 0.5 * lo.DistanceTo(hi);
+
+    if (*sdf > radius + margin)
+    {
+        return PYRAMID_OUTSIDE;
+    }
+    if (*sdf < -(radius + margin))
+    {
+        return PYRAMID_INSIDE;
+    }
+
+    return PYRAMID_NEAR;
+}
+
+//! Builds the two-level tile classification for a target of the given
+//! \p size: coarse blocks are tested first and only the undecided ones are
+//! refined per tile, so the number of source queries scales with the source
+//! surface area rather than the target volume.
+template <typename PosFunc>
+SDFPyramid BuildSDFPyramid(const ImplicitSurface3& source, const Size3& size,
+                           const PosFunc& pos, double margin)
+{
+    SDFPyramid pyramid;
+    pyramid.numTiles =
+        Size3{ (size.x + PYRAMID_TILE_SIZE - 1) / PYRAMID_TILE_SIZE,
+               (size.y + PYRAMID_TILE_SIZE - 1) / PYRAMID_TILE_SIZE,
+               (size.z + PYRAMID_TILE_SIZE - 1) / PYRAMID_TILE_SIZE };
+    pyramid.tileClass.Resize(pyramid.numTiles, PYRAMID_NEAR);
+    pyramid.tileSDF.Resize(pyramid.numTiles);
+    pyramid.tileCenter.Resize(pyramid.numTiles);
+
+    const Size3 numBlocks{
+        (pyramid.numTiles.x + PYRAMID_BLOCK_TILES - 1) / PYRAMID_BLOCK_TILES,
+        (pyramid.numTiles.y + PYRAMID_BLOCK_TILES - 1) / PYRAMID_BLOCK_TILES,
+        (pyramid.numTiles.z + PYRAMID_BLOCK_TILES - 1) / PYRAMID_BLOCK_TILES
+    };
+
+    auto tileClassAcc = pyramid.tileClass.Accessor();
+    auto tileSDFAcc = pyramid.tileSDF.Accessor();
+    auto tileCenterAcc = pyramid.tileCenter.Accessor();
+
+    ParallelFor(
+        ZERO_SIZE, numBlocks.x, ZERO_SIZE, numBlocks.y, ZERO_SIZE, numBlocks.z,
+        [&](size_t bx, size_t by, size_t bz) {
+            const Size3 tileBegin{ bx * PYRAMID_BLOCK_TILES,
+                                   by * PYRAMID_BLOCK_TILES,
+                                   bz * PYRAMID_BLOCK_TILES };
+            const Size3 tileEnd{
+                std::min(tileBegin.x + PYRAMID_BLOCK_TILES, pyramid.numTiles.x),
+                std::min(tileBegin.y + PYRAMID_BLOCK_TILES, pyramid.numTiles.y),
+                std::min(tileBegin.z + PYRAMID_BLOCK_TILES, pyramid.numTiles.z)
+            };
+
+            const Size3 cellBegin{ tileBegin.x * PYRAMID_TILE_SIZE,
+                                   tileBegin.y * PYRAMID_TILE_SIZE,
+                                   tileBegin.z * PYRAMID_TILE_SIZE };
+            const Size3 cellEnd{
+                std::min(tileEnd.x * PYRAMID_TILE_SIZE, size.x),
+                std::min(tileEnd.y * PYRAMID_TILE_SIZE, size.y),
+                std::min(tileEnd.z * PYRAMID_TILE_SIZE, size.z)
+            };
+
+            Vector3D center;
+            double sdf;
+            const char blockClass = ClassifyRange(source, pos, cellBegin,
+                                                  cellEnd, margin, &center,
+                                                  &sdf);
+
+            if (blockClass != PYRAMID_NEAR)
+            {
+                for (size_t tk = tileBegin.z; tk < tileEnd.z; ++tk)
+                {
+                    for (size_t tj = tileBegin.y; tj < tileEnd.y; ++tj)
+                    {
+                        for (size_t ti = tileBegin.x; ti < tileEnd.x; ++ti)
+                        {
+                            tileClassAcc(ti, tj, tk) = blockClass;
+                            tileSDFAcc(ti, tj, tk) = sdf;
+                            tileCenterAcc(ti, tj, tk) = center;
+                        }
+                    }
+                }
+                return;
+            }
+
+            // Undecided block: refine per tile.
+            for (size_t tk = tileBegin.z; tk < tileEnd.z; ++tk)
+            {
+                for (size_t tj = tileBegin.y; tj < tileEnd.y; ++tj)
+                {
+                    for (size_t ti = tileBegin.x; ti < tileEnd.x; ++ti)
+                    {
+                        const Size3 begin{ ti * PYRAMID_TILE_SIZE,
+                                           tj * PYRAMID_TILE_SIZE,
+                                           tk * PYRAMID_TILE_SIZE };
+                        const Size3 end{
+                            std::min(begin.x + PYRAMID_TILE_SIZE, size.x),
+                            std::min(begin.y + PYRAMID_TILE_SIZE, size.y),
+                            std::min(begin.z + PYRAMID_TILE_SIZE, size.z)
+                        };
+
+                        tileClassAcc(ti, tj, tk) =
+                            ClassifyRange(source, pos, begin, end, margin,
+                                          &center, &sdf);
+                        tileSDFAcc(ti, tj, tk) = sdf;
+                        tileCenterAcc(ti, tj, tk) = center;
+                    }
+                }
+            }
+        });
+
+    return pyramid;
+}
+}  // namespace
+
 VolumeGridEmitter3::VolumeGridEmitter3(ImplicitSurface3Ptr sourceRegion,
                                        bool isOneShot)
     : m_sourceRegion(std::move(sourceRegion)), m_isOneShot(isOneShot)
@@ -53,12 +208,14 @@ void VolumeGridEmitter3::AddTarget(const ScalarGrid3Ptr& scalarGridTarget,
                                    const ScalarMapper& customMapper)
 {
     m_customScalarTargets.emplace_back(scalarGridTarget, customMapper);
+    m_scalarTargetSDF.emplace_back();
 }
 
 void VolumeGridEmitter3::AddTarget(const VectorGrid3Ptr& vectorGridTarget,
                                    const VectorMapper& customMapper)
 {
     m_customVectorTargets.emplace_back(vectorGridTarget, customMapper);
+    m_vectorTargetSDF.emplace_back();
 }
 
 const ImplicitSurface3Ptr& VolumeGridEmitter3::GetSourceRegion() const
@@ -71,6 +228,63 @@ bool VolumeGridEmitter3::GetIsOneShot() const
     return m_isOneShot;
 }
 
+BoundingBox3D VolumeGridEmitter3::GetInfluenceBounds() const
+{
+    if (m_sourceRegion != nullptr && m_sourceRegion->IsBounded())
+    {
+        return m_sourceRegion->BoundingBox();
+    }
+
+    return GridEmitter3::GetInfluenceBounds();
+}
+
+bool VolumeGridEmitter3::GetUseBoundedEmission() const
+{
+    return m_useBoundedEmission;
+}
+
+void VolumeGridEmitter3::SetUseBoundedEmission(bool useBoundedEmission)
+{
+    m_useBoundedEmission = useBoundedEmission;
+}
+
+bool VolumeGridEmitter3::GetUseSourceSDFCache() const
+{
+    return m_useSourceSDFCache;
+}
+
+void VolumeGridEmitter3::SetUseSourceSDFCache(bool useSourceSDFCache)
+{
+    m_useSourceSDFCache = useSourceSDFCache;
+
+    if (!m_useSourceSDFCache)
+    {
+        m_sourceSDFCacheValid = false;
+
+        for (auto& sdf : m_scalarTargetSDF)
+        {
+            sdf.Clear();
+        }
+        for (auto& sdfs : m_vectorTargetSDF)
+        {
+            for (auto& sdf : sdfs)
+            {
+                sdf.Clear();
+            }
+        }
+    }
+}
+
+bool VolumeGridEmitter3::GetUseSDFPyramid() const
+{
+    return m_useSDFPyramid;
+}
+
+void VolumeGridEmitter3::SetUseSDFPyramid(bool useSDFPyramid)
+{
+    m_useSDFPyramid = useSDFPyramid;
+}
+
 void VolumeGridEmitter3::OnUpdate(double currentTimeInSeconds,
                                   double timeIntervalInSeconds)
 {
@@ -86,7 +300,10 @@ void VolumeGridEmitter3::OnUpdate(double currentTimeInSeconds,
 
     if (m_isOneShot)
     {
+        // A one-shot source is done after its first emission; expiring it
+        // lets emitter sets skip it without re-checking every frame.
         SetIsEnabled(false);
+        SetState(EmitterState::Expired);
     }
 
     m_hasEmitted = true;
@@ -101,39 +318,187 @@ void VolumeGridEmitter3::Emit()
 
     m_sourceRegion->UpdateQueryEngine();
 
-    for (const auto& target : m_customScalarTargets)
+    const bool reuseCachedSDF = RefreshSourceSDFCache();
+
+    BoundingBox3D sourceBound;
+    if (m_useBoundedEmission)
+    {
+        sourceBound = m_sourceRegion->BoundingBox();
+    }
+
+    for (size_t n = 0; n < m_customScalarTargets.size(); ++n)
     {
-        const auto& grid = std::get<0>(target);
-        const auto& mapper = std::get<1>(target);
+        const auto& grid = std::get<0>(m_customScalarTargets[n]);
+        const auto& mapper = std::get<1>(m_customScalarTargets[n]);
 
         auto pos = grid->GetDataPosition();
+        Array3<double>& sdfCache = m_scalarTargetSDF[n];
+
+        const bool readCache =
+            reuseCachedSDF && sdfCache.size() == grid->GetDataSize();
+        const bool writeCache = m_useSourceSDFCache && !readCache;
+        if (writeCache)
+        {
+            sdfCache.Resize(grid->GetDataSize());
+        }
+
+        BoundingBox3D bound = sourceBound;
+        bound.Expand(3.0 * grid->GridSpacing().Max());
+
+        auto acc = grid->GetDataAccessor();
+        auto sdfAcc = sdfCache.Accessor();
+
+        SDFPyramid pyramid;
+        if (m_useSDFPyramid)
+        {
+            pyramid = BuildSDFPyramid(*m_sourceRegion, grid->GetDataSize(),
+                                      pos, 3.0 * grid->GridSpacing().Max());
+        }
+
+        auto pyrClassAcc = pyramid.tileClass.ConstAccessor();
+        auto pyrSDFAcc = pyramid.tileSDF.ConstAccessor();
+        auto pyrCenterAcc = pyramid.tileCenter.ConstAccessor();
+
         grid->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
             const Vector3D gx = pos(i, j, k);
-            const double sdf = GetSourceRegion()->SignedDistance(gx);
 
-            (*grid)(i, j, k) = mapper(sdf, gx, (*grid)(i, j, k));
+            if (m_useBoundedEmission && !bound.Contains(gx))
+            {
+                return;
+            }
+
+            char tileClass = PYRAMID_NEAR;
+            size_t ti = 0, tj = 0, tk = 0;
+            if (m_useSDFPyramid)
+            {
+                ti = i / PYRAMID_TILE_SIZE;
+                tj = j / PYRAMID_TILE_SIZE;
+                tk = k / PYRAMID_TILE_SIZE;
+                tileClass = pyrClassAcc(ti, tj, tk);
+
+                if (tileClass == PYRAMID_OUTSIDE)
+                {
+                    return;
+                }
+            }
+
+            double sdf;
+            if (readCache)
+            {
+                sdf = sdfAcc(i, j, k);
+            }
+            else
+            {
+                if (tileClass == PYRAMID_INSIDE)
+                {
+                    // Upper bound on the signed distance; still clear of the
+                    // smearing margin by the tile classification.
+                    sdf = pyrSDFAcc(ti, tj, tk) +
+                          gx.DistanceTo(pyrCenterAcc(ti, tj, tk));
+                }
+                else
+                {
+                    sdf = GetSourceRegion()->SignedDistance(gx);
+                }
+
+                if (writeCache)
+                {
+                    sdfAcc(i, j, k) = sdf;
+                }
+            }
+
+            acc(i, j, k) = mapper(sdf, gx, acc(i, j, k));
         });
     }
 
-    for (const auto& target : m_customVectorTargets)
+    for (size_t n = 0; n < m_customVectorTargets.size(); ++n)
     {
-        const auto& grid = std::get<0>(target);
-        const auto& mapper = std::get<1>(target);
+        const auto& grid = std::get<0>(m_customVectorTargets[n]);
+        const auto& mapper = std::get<1>(m_customVectorTargets[n]);
 
         CollocatedVectorGrid3Ptr collocated =
             std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid);
         if (collocated != nullptr)
         {
             auto pos = collocated->GetDataPosition();
+            Array3<double>& sdfCache = m_vectorTargetSDF[n][0];
+
+            const bool readCache =
+                reuseCachedSDF && sdfCache.size() == collocated->GetDataSize();
+            const bool writeCache = m_useSourceSDFCache && !readCache;
+            if (writeCache)
+            {
+                sdfCache.Resize(collocated->GetDataSize());
+            }
+
+            BoundingBox3D bound = sourceBound;
+            bound.Expand(3.0 * collocated->GridSpacing().Max());
+
+            auto acc = collocated->GetDataAccessor();
+            auto sdfAcc = sdfCache.Accessor();
+
+            SDFPyramid pyramid;
+            if (m_useSDFPyramid)
+            {
+                pyramid = BuildSDFPyramid(
+                    *m_sourceRegion, collocated->GetDataSize(), pos,
+                    3.0 * collocated->GridSpacing().Max());
+            }
+
+            auto pyrClassAcc = pyramid.tileClass.ConstAccessor();
+            auto pyrSDFAcc = pyramid.tileSDF.ConstAccessor();
+            auto pyrCenterAcc = pyramid.tileCenter.ConstAccessor();
+
             collocated->ParallelForEachDataPointIndex(
                 [&](size_t i, size_t j, size_t k) {
                     const Vector3D gx = pos(i, j, k);
-                    const double sdf = GetSourceRegion()->SignedDistance(gx);
+
+                    if (m_useBoundedEmission && !bound.Contains(gx))
+                    {
+                        return;
+                    }
+
+                    char tileClass = PYRAMID_NEAR;
+                    size_t ti = 0, tj = 0, tk = 0;
+                    if (m_useSDFPyramid)
+                    {
+                        ti = i / PYRAMID_TILE_SIZE;
+                        tj = j / PYRAMID_TILE_SIZE;
+                        tk = k / PYRAMID_TILE_SIZE;
+                        tileClass = pyrClassAcc(ti, tj, tk);
+
+                        if (tileClass == PYRAMID_OUTSIDE)
+                        {
+                            return;
+                        }
+                    }
+
+                    double sdf;
+                    if (readCache)
+                    {
+                        sdf = sdfAcc(i, j, k);
+                    }
+                    else
+                    {
+                        if (tileClass == PYRAMID_INSIDE)
+                        {
+                            sdf = pyrSDFAcc(ti, tj, tk) +
+                                  gx.DistanceTo(pyrCenterAcc(ti, tj, tk));
+                        }
+                        else
+                        {
+                            sdf = GetSourceRegion()->SignedDistance(gx);
+                        }
+
+                        if (writeCache)
+                        {
+                            sdfAcc(i, j, k) = sdf;
+                        }
+                    }
 
                     if (IsInsideSDF(sdf))
                     {
-                        (*collocated)(i, j, k) =
-                            mapper(sdf, gx, (*collocated)(i, j, k));
+                        acc(i, j, k) = mapper(sdf, gx, acc(i, j, k));
                     }
                 });
 
@@ -148,39 +513,204 @@ void VolumeGridEmitter3::Emit()
             auto vPos = faceCentered->GetVPosition();
             auto wPos = faceCentered->GetWPosition();
 
+            std::array<Array3<double>, 3>& sdfCaches = m_vectorTargetSDF[n];
+
+            const bool readCache =
+                reuseCachedSDF &&
+                sdfCaches[0].size() == faceCentered->GetUSize() &&
+                sdfCaches[1].size() == faceCentered->GetVSize() &&
+                sdfCaches[2].size() == faceCentered->GetWSize();
+            const bool writeCache = m_useSourceSDFCache && !readCache;
+            if (writeCache)
+            {
+                sdfCaches[0].Resize(faceCentered->GetUSize());
+                sdfCaches[1].Resize(faceCentered->GetVSize());
+                sdfCaches[2].Resize(faceCentered->GetWSize());
+            }
+
+            BoundingBox3D bound = sourceBound;
+            bound.Expand(3.0 * faceCentered->GridSpacing().Max());
+
+            std::array<ArrayAccessor3<double>, 3> sdfCacheAccs{
+                sdfCaches[0].Accessor(), sdfCaches[1].Accessor(),
+                sdfCaches[2].Accessor()
+            };
+
+            auto uAcc = faceCentered->GetUAccessor();
+            auto vAcc = faceCentered->GetVAccessor();
+            auto wAcc = faceCentered->GetWAccessor();
+
+            std::array<SDFPyramid, 3> pyramids;
+            if (m_useSDFPyramid)
+            {
+                const double margin = 3.0 * faceCentered->GridSpacing().Max();
+                pyramids[0] = BuildSDFPyramid(
+                    *m_sourceRegion, faceCentered->GetUSize(), uPos, margin);
+                pyramids[1] = BuildSDFPyramid(
+                    *m_sourceRegion, faceCentered->GetVSize(), vPos, margin);
+                pyramids[2] = BuildSDFPyramid(
+                    *m_sourceRegion, faceCentered->GetWSize(), wPos, margin);
+            }
+
+            std::array<ConstArrayAccessor3<char>, 3> pyrClassAccs{
+                pyramids[0].tileClass.ConstAccessor(),
+                pyramids[1].tileClass.ConstAccessor(),
+                pyramids[2].tileClass.ConstAccessor()
+            };
+            std::array<ConstArrayAccessor3<double>, 3> pyrSDFAccs{
+                pyramids[0].tileSDF.ConstAccessor(),
+                pyramids[1].tileSDF.ConstAccessor(),
+                pyramids[2].tileSDF.ConstAccessor()
+            };
+            std::array<ConstArrayAccessor3<Vector3D>, 3> pyrCenterAccs{
+                pyramids[0].tileCenter.ConstAccessor(),
+                pyramids[1].tileCenter.ConstAccessor(),
+                pyramids[2].tileCenter.ConstAccessor()
+            };
+
+            // Looks up the tile class for the face at (i, j, k) and resolves
+            // the signed distance through the cache, the inside-tile bound,
+            // or a full query; returns false for provably outside tiles.
+            auto resolveSDF = [&](size_t axis, size_t i, size_t j, size_t k,
+                                  const Vector3D& gx, double* sdf) {
+                char tileClass = PYRAMID_NEAR;
+                size_t ti = 0, tj = 0, tk = 0;
+                if (m_useSDFPyramid)
+                {
+                    ti = i / PYRAMID_TILE_SIZE;
+                    tj = j / PYRAMID_TILE_SIZE;
+                    tk = k / PYRAMID_TILE_SIZE;
+                    tileClass = pyrClassAccs[axis](ti, tj, tk);
+
+                    if (tileClass == PYRAMID_OUTSIDE)
+                    {
+                        return false;
+                    }
+                }
+
+                if (readCache)
+                {
+                    *sdf = sdfCacheAccs[axis](i, j, k);
+                }
+                else
+                {
+                    if (tileClass == PYRAMID_INSIDE)
+                    {
+                        *sdf = pyrSDFAccs[axis](ti, tj, tk) +
+                               gx.DistanceTo(pyrCenterAccs[axis](ti, tj, tk));
+                    }
+                    else
+                    {
+                        *sdf = GetSourceRegion()->SignedDistance(gx);
+                    }
+
+                    if (writeCache)
+                    {
+                        sdfCacheAccs[axis](i, j, k) = *sdf;
+                    }
+                }
+
+                return true;
+            };
+
             faceCentered->ParallelForEachUIndex(
                 [&](size_t i, size_t j, size_t k) {
                     const Vector3D gx = uPos(i, j, k);
-                    const double sdf = GetSourceRegion()->SignedDistance(gx);
+
+                    if (m_useBoundedEmission && !bound.Contains(gx))
+                    {
+                        return;
+                    }
+
+                    double sdf;
+                    if (!resolveSDF(0, i, j, k, gx, &sdf))
+                    {
+                        return;
+                    }
+
                     const Vector3D oldVal = faceCentered->Sample(gx);
                     const Vector3D newVal = mapper(sdf, gx, oldVal);
 
-                    faceCentered->GetU(i, j, k) = newVal.x;
+                    uAcc(i, j, k) = newVal.x;
                 });
 
             faceCentered->ParallelForEachVIndex(
                 [&](size_t i, size_t j, size_t k) {
                     const Vector3D gx = vPos(i, j, k);
-                    const double sdf = GetSourceRegion()->SignedDistance(gx);
+
+                    if (m_useBoundedEmission && !bound.Contains(gx))
+                    {
+                        return;
+                    }
+
+                    double sdf;
+                    if (!resolveSDF(1, i, j, k, gx, &sdf))
+                    {
+                        return;
+                    }
+
                     const Vector3D oldVal = faceCentered->Sample(gx);
                     const Vector3D newVal = mapper(sdf, gx, oldVal);
 
-                    faceCentered->GetV(i, j, k) = newVal.y;
+                    vAcc(i, j, k) = newVal.y;
                 });
 
             faceCentered->ParallelForEachWIndex(
                 [&](size_t i, size_t j, size_t k) {
                     const Vector3D gx = wPos(i, j, k);
-                    const double sdf = GetSourceRegion()->SignedDistance(gx);
+
+                    if (m_useBoundedEmission && !bound.Contains(gx))
+                    {
+                        return;
+                    }
+
+                    double sdf;
+                    if (!resolveSDF(2, i, j, k, gx, &sdf))
+                    {
+                        return;
+                    }
+
                     const Vector3D oldVal = faceCentered->Sample(gx);
                     const Vector3D newVal = mapper(sdf, gx, oldVal);
 
-                    faceCentered->GetW(i, j, k) = newVal.z;
+                    wAcc(i, j, k) = newVal.z;
                 });
         }
     }
 }
 
+bool VolumeGridEmitter3::RefreshSourceSDFCache()
+{
+    if (!m_useSourceSDFCache)
+    {
+        m_sourceSDFCacheValid = false;
+        return false;
+    }
+
+    // For wrapped explicit surfaces, motion shows up on the inner surface's
+    // transform while the SurfaceToImplicit3 wrapper stays at identity, so
+    // track the innermost transform.
+    Transform3 transform = m_sourceRegion->transform;
+    if (const auto wrapper =
+            std::dynamic_pointer_cast<SurfaceToImplicit3>(m_sourceRegion))
+    {
+        transform = wrapper->GetSurface()->transform;
+    }
+
+    const bool reusable =
+        m_sourceSDFCacheValid &&
+        m_cachedBoundedEmission == m_useBoundedEmission &&
+        m_cachedSourceTransform.GetTranslation() ==
+            transform.GetTranslation() &&
+        m_cachedSourceTransform.GetOrientation() == transform.GetOrientation();
+
+    m_cachedSourceTransform = transform;
+    m_cachedBoundedEmission = m_useBoundedEmission;
+    m_sourceSDFCacheValid = true;
+
+    return reusable;
+}
+
 VolumeGridEmitter3::Builder VolumeGridEmitter3::GetBuilder()
 {
     return Builder();
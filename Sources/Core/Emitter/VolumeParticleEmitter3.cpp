@@ -12,7 +12,9 @@
 #include <Core/Geometry/SurfaceToImplicit3.hpp>
 #include <Core/PointGenerator/BccLatticePointGenerator.hpp>
 #include <Core/Searcher/PointHashGridSearcher3.hpp>
+#include <Core/Utils/Constants.hpp>
 #include <Core/Utils/Logging.hpp>
+#include <Core/Utils/Parallel.hpp>
 #include <Core/Utils/Samplers.hpp>
 
 #include <utility>
@@ -66,9 +68,17 @@ void VolumeParticleEmitter3::OnUpdate(double currentTimeInSeconds,
 
     particles->AddParticles(newPositions, newVelocities);
 
+    // One-shot sources and sources that hit their particle budget cannot
+    // emit anything anymore; expiring them lets emitter sets skip them
+    // without re-checking every frame.
     if (m_isOneShot)
     {
         SetIsEnabled(false);
+        SetState(EmitterState::Expired);
+    }
+    else if (m_numberOfEmittedParticles >= m_maxNumberOfParticles)
+    {
+        SetState(EmitterState::Expired);
     }
 }
 
@@ -98,29 +108,7 @@ void VolumeParticleEmitter3::Emit(const ParticleSystemData3Ptr& particles,
 
     if (m_allowOverlapping || m_isOneShot)
     {
-        m_pointsGen->ForEachPoint(
-            region, m_spacing, [&](const Vector3D& point) {
-                const Vector3D randomDir =
-                    UniformSampleSphere(Random(), Random());
-                const Vector3D offset = maxJitterDist * randomDir;
-                const Vector3D candidate = point + offset;
-
-                if (m_implicitSurface->SignedDistance(candidate) <= 0.0)
-                {
-                    if (m_numberOfEmittedParticles < m_maxNumberOfParticles)
-                    {
-                        newPositions->Append(candidate);
-                        ++m_numberOfEmittedParticles;
-                        ++numNewParticles;
-                    }
-                    else
-                    {
-                        return false;
-                    }
-                }
-
-                return true;
-            });
+        EmitParallel(region, maxJitterDist, newPositions, &numNewParticles);
     }
     else
     {
@@ -174,6 +162,78 @@ void VolumeParticleEmitter3::Emit(const ParticleSystemData3Ptr& particles,
     });
 }
 
+void VolumeParticleEmitter3::EmitParallel(const BoundingBox3D& region,
+                                          double maxJitterDist,
+                                          Array1<Vector3D>* newPositions,
+                                          size_t* numNewParticles)
+{
+    // Batch-generate the candidate lattice, then jitter and classify the
+    // candidates in one parallel pass.
+    Array1<Vector3D> candidates;
+    m_pointsGen->Generate(region, m_spacing, &candidates);
+
+    const size_t numCandidates = candidates.size();
+    Array1<char> isInside(numCandidates, 0);
+
+    // Jitter comes from a counter-based hash of the candidate index (the
+    // SplitMix64 finalizer), so the samples are independent of how the
+    // parallel loop is chunked; the base seed still advances the emitter's
+    // stream.
+    const uint64_t baseSeed = static_cast<uint64_t>(m_rng());
+
+    const auto hashCounter = [](uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    };
+
+    ArrayAccessor1<Vector3D> candidateAcc = candidates.Accessor();
+    ArrayAccessor1<char> isInsideAcc = isInside.Accessor();
+
+    ParallelFor(ZERO_SIZE, numCandidates, [&](size_t idx) {
+        const uint64_t hash =
+            hashCounter(baseSeed + static_cast<uint64_t>(idx));
+        const double u1 =
+            static_cast<double>(hash & 0xFFFFFFFFULL) / 4294967296.0;
+        const double u2 = static_cast<double>(hash >> 32) / 4294967296.0;
+
+        const Vector3D randomDir = UniformSampleSphere(u1, u2);
+        const Vector3D candidate =
+            candidateAcc[idx] + maxJitterDist * randomDir;
+
+        candidateAcc[idx] = candidate;
+        isInsideAcc[idx] =
+            (m_implicitSurface->SignedDistance(candidate) <= 0.0) ? 1 : 0;
+    });
+
+    size_t numValid = 0;
+    for (size_t idx = 0; idx < numCandidates; ++idx)
+    {
+        numValid += static_cast<size_t>(isInside[idx]);
+    }
+
+    const size_t budget = m_maxNumberOfParticles - m_numberOfEmittedParticles;
+    const size_t numToEmit = std::min(numValid, budget);
+
+    const size_t oldSize = newPositions->size();
+    newPositions->Resize(oldSize + numToEmit);
+
+    size_t writeIdx = oldSize;
+    for (size_t idx = 0;
+         idx < numCandidates && writeIdx < oldSize + numToEmit; ++idx)
+    {
+        if (isInside[idx] != 0)
+        {
+            (*newPositions)[writeIdx] = candidates[idx];
+            ++writeIdx;
+        }
+    }
+
+    m_numberOfEmittedParticles += numToEmit;
+    *numNewParticles += numToEmit;
+}
+
 void VolumeParticleEmitter3::SetPointGenerator(
     const PointGenerator3Ptr& newPointsGen)
 {
@@ -195,6 +255,20 @@ const BoundingBox3D& VolumeParticleEmitter3::GetMaxRegion() const
     return m_maxRegion;
 }
 
+BoundingBox3D VolumeParticleEmitter3::GetInfluenceBounds() const
+{
+    BoundingBox3D region = m_maxRegion;
+
+    if (m_implicitSurface != nullptr && m_implicitSurface->IsBounded())
+    {
+        const BoundingBox3D surfaceBBox = m_implicitSurface->BoundingBox();
+        region.lowerCorner = Max(region.lowerCorner, surfaceBBox.lowerCorner);
+        region.upperCorner = Min(region.upperCorner, surfaceBBox.upperCorner);
+    }
+
+    return region;
+}
+
 void VolumeParticleEmitter3::SetMaxRegion(const BoundingBox3D& newMaxRegion)
 {
     m_maxRegion = newMaxRegion;
@@ -239,6 +313,13 @@ void VolumeParticleEmitter3::SetMaxNumberOfParticles(
     size_t newMaxNumberOfParticles)
 {
     m_maxNumberOfParticles = newMaxNumberOfParticles;
+
+    // Raising the budget re-arms an emitter that expired on exhausting it.
+    if (GetState() == EmitterState::Expired && !m_isOneShot &&
+        m_numberOfEmittedParticles < m_maxNumberOfParticles)
+    {
+        SetState(EmitterState::Active);
+    }
 }
 
 double VolumeParticleEmitter3::GetSpacing() const
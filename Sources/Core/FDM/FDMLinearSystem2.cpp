@@ -9,12 +9,40 @@
 // property of any third parties.
 
 #include <Core/FDM/FDMLinearSystem2.hpp>
+#include <Core/FDM/FDMUtils.hpp>
 #include <Core/Math/MathUtils.hpp>
+#include <Core/Utils/Parallel.hpp>
 
 #include <cassert>
+#include <functional>
 
 namespace CubbyFlow
 {
+namespace
+{
+//! Checked 5-point row of A·v at (i, j); used for the boundary shell.
+double MVMAt(const FDMMatrix2& m, const FDMVector2& v, const Size2& size,
+             size_t i, size_t j)
+{
+    return m(i, j).center * v(i, j) +
+           ((i > 0) ? m(i - 1, j).right * v(i - 1, j) : 0.0) +
+           ((i + 1 < size.x) ? m(i, j).right * v(i + 1, j) : 0.0) +
+           ((j > 0) ? m(i, j - 1).up * v(i, j - 1) : 0.0) +
+           ((j + 1 < size.y) ? m(i, j).up * v(i, j + 1) : 0.0);
+}
+
+//! Checked 5-point row of b - A·x at (i, j); used for the boundary shell.
+double ResidualAt(const FDMMatrix2& a, const FDMVector2& x, const FDMVector2& b,
+                  const Size2& size, size_t i, size_t j)
+{
+    return b(i, j) - a(i, j).center * x(i, j) -
+           ((i > 0) ? a(i - 1, j).right * x(i - 1, j) : 0.0) -
+           ((i + 1 < size.x) ? a(i, j).right * x(i + 1, j) : 0.0) -
+           ((j > 0) ? a(i, j - 1).up * x(i, j - 1) : 0.0) -
+           ((j + 1 < size.y) ? a(i, j).up * x(i, j + 1) : 0.0);
+}
+}  // namespace
+
 void FDMLinearSystem2::Clear()
 {
     A.Clear();
@@ -94,13 +122,37 @@ void FDMBLAS2::MVM(const FDMMatrix2& m, const FDMVector2& v, FDMVector2* result)
     assert(size == v.size());
     assert(size == result->size());
 
-    m.ParallelForEachIndex([&](size_t i, size_t j) {
-        (*result)(i, j) =
-            m(i, j).center * v(i, j) +
-            ((i > 0) ? m(i - 1, j).right * v(i - 1, j) : 0.0) +
-            ((i + 1 < size.x) ? m(i, j).right * v(i + 1, j) : 0.0) +
-            ((j > 0) ? m(i, j - 1).up * v(i, j - 1) : 0.0) +
-            ((j + 1 < size.y) ? m(i, j).up * v(i, j + 1) : 0.0);
+    const StencilAccessor2<FDMMatrixRow2> mAcc{ m.ConstAccessor() };
+    const StencilAccessor2<double> vAcc{ v.ConstAccessor() };
+    double* resultData = result->data();
+
+    ParallelFor(ZERO_SIZE, size.y, [&](size_t j) {
+        // Rows touching the domain boundary (and degenerate rows) keep the
+        // checked per-point path; interior rows run the unchecked stencil
+        // with the same term order, so results match bitwise.
+        if (size.x < 3 || j == 0 || j + 1 == size.y)
+        {
+            for (size_t i = 0; i < size.x; ++i)
+            {
+                (*result)(i, j) = MVMAt(m, v, size, i, j);
+            }
+
+            return;
+        }
+
+        (*result)(0, j) = MVMAt(m, v, size, 0, j);
+
+        size_t idx = mAcc.Index(1, j);
+        for (size_t i = 1; i + 1 < size.x; ++i, ++idx)
+        {
+            resultData[idx] = mAcc.Center(idx).center * vAcc.Center(idx) +
+                              mAcc.Left(idx).right * vAcc.Left(idx) +
+                              mAcc.Center(idx).right * vAcc.Right(idx) +
+                              mAcc.Down(idx).up * vAcc.Down(idx) +
+                              mAcc.Center(idx).up * vAcc.Up(idx);
+        }
+
+        (*result)(size.x - 1, j) = MVMAt(m, v, size, size.x - 1, j);
     });
 }
 
@@ -113,16 +165,198 @@ void FDMBLAS2::Residual(const FDMMatrix2& a, const FDMVector2& x,
     assert(size == b.size());
     assert(size == result->size());
 
-    a.ParallelForEachIndex([&](size_t i, size_t j) {
-        (*result)(i, j) =
-            b(i, j) - a(i, j).center * x(i, j) -
-            ((i > 0) ? a(i - 1, j).right * x(i - 1, j) : 0.0) -
-            ((i + 1 < size.x) ? a(i, j).right * x(i + 1, j) : 0.0) -
-            ((j > 0) ? a(i, j - 1).up * x(i, j - 1) : 0.0) -
-            ((j + 1 < size.y) ? a(i, j).up * x(i, j + 1) : 0.0);
+    const StencilAccessor2<FDMMatrixRow2> aAcc{ a.ConstAccessor() };
+    const StencilAccessor2<double> xAcc{ x.ConstAccessor() };
+    const StencilAccessor2<double> bAcc{ b.ConstAccessor() };
+    double* resultData = result->data();
+
+    ParallelFor(ZERO_SIZE, size.y, [&](size_t j) {
+        if (size.x < 3 || j == 0 || j + 1 == size.y)
+        {
+            for (size_t i = 0; i < size.x; ++i)
+            {
+                (*result)(i, j) = ResidualAt(a, x, b, size, i, j);
+            }
+
+            return;
+        }
+
+        (*result)(0, j) = ResidualAt(a, x, b, size, 0, j);
+
+        size_t idx = aAcc.Index(1, j);
+        for (size_t i = 1; i + 1 < size.x; ++i, ++idx)
+        {
+            resultData[idx] = bAcc.Center(idx) -
+                              aAcc.Center(idx).center * xAcc.Center(idx) -
+                              aAcc.Left(idx).right * xAcc.Left(idx) -
+                              aAcc.Center(idx).right * xAcc.Right(idx) -
+                              aAcc.Down(idx).up * xAcc.Down(idx) -
+                              aAcc.Center(idx).up * xAcc.Up(idx);
+        }
+
+        (*result)(size.x - 1, j) = ResidualAt(a, x, b, size, size.x - 1, j);
     });
 }
 
+double FDMBLAS2::AXPlusYAndSelfDot(double a, const FDMVector2& x,
+                                   const FDMVector2& y, FDMVector2* result)
+{
+    assert(x.size() == y.size());
+    assert(x.size() == result->size());
+
+    const Size2 size = x.size();
+    const size_t n = size.x * size.y;
+    const double* xData = x.data();
+    const double* yData = y.data();
+    double* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double sum = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                const double val = a * xData[i] + yData[i];
+                resultData[i] = val;
+                sum += val * val;
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMBLAS2::MVMAndDot(const FDMMatrix2& m, const FDMVector2& v,
+                           FDMVector2* result)
+{
+    Size2 size = m.size();
+
+    assert(size == v.size());
+    assert(size == result->size());
+
+    const StencilAccessor2<FDMMatrixRow2> mAcc{ m.ConstAccessor() };
+    const StencilAccessor2<double> vAcc{ v.ConstAccessor() };
+    double* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, size.y, 0.0,
+        [&](size_t jBegin, size_t jEnd, double init) {
+            double sum = init;
+
+            for (size_t j = jBegin; j < jEnd; ++j)
+            {
+                if (size.x < 3 || j == 0 || j + 1 == size.y)
+                {
+                    for (size_t i = 0; i < size.x; ++i)
+                    {
+                        const double val = MVMAt(m, v, size, i, j);
+                        (*result)(i, j) = val;
+                        sum += v(i, j) * val;
+                    }
+
+                    continue;
+                }
+
+                {
+                    const double val = MVMAt(m, v, size, 0, j);
+                    (*result)(0, j) = val;
+                    sum += v(0, j) * val;
+                }
+
+                size_t idx = mAcc.Index(1, j);
+                for (size_t i = 1; i + 1 < size.x; ++i, ++idx)
+                {
+                    const double val =
+                        mAcc.Center(idx).center * vAcc.Center(idx) +
+                        mAcc.Left(idx).right * vAcc.Left(idx) +
+                        mAcc.Center(idx).right * vAcc.Right(idx) +
+                        mAcc.Down(idx).up * vAcc.Down(idx) +
+                        mAcc.Center(idx).up * vAcc.Up(idx);
+
+                    resultData[idx] = val;
+                    sum += vAcc.Center(idx) * val;
+                }
+
+                {
+                    const double val = MVMAt(m, v, size, size.x - 1, j);
+                    (*result)(size.x - 1, j) = val;
+                    sum += v(size.x - 1, j) * val;
+                }
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMBLAS2::ResidualAndSelfDot(const FDMMatrix2& a, const FDMVector2& x,
+                                    const FDMVector2& b, FDMVector2* result)
+{
+    Size2 size = a.size();
+
+    assert(size == x.size());
+    assert(size == b.size());
+    assert(size == result->size());
+
+    const StencilAccessor2<FDMMatrixRow2> aAcc{ a.ConstAccessor() };
+    const StencilAccessor2<double> xAcc{ x.ConstAccessor() };
+    const StencilAccessor2<double> bAcc{ b.ConstAccessor() };
+    double* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, size.y, 0.0,
+        [&](size_t jBegin, size_t jEnd, double init) {
+            double sum = init;
+
+            for (size_t j = jBegin; j < jEnd; ++j)
+            {
+                if (size.x < 3 || j == 0 || j + 1 == size.y)
+                {
+                    for (size_t i = 0; i < size.x; ++i)
+                    {
+                        const double val = ResidualAt(a, x, b, size, i, j);
+                        (*result)(i, j) = val;
+                        sum += val * val;
+                    }
+
+                    continue;
+                }
+
+                {
+                    const double val = ResidualAt(a, x, b, size, 0, j);
+                    (*result)(0, j) = val;
+                    sum += val * val;
+                }
+
+                size_t idx = aAcc.Index(1, j);
+                for (size_t i = 1; i + 1 < size.x; ++i, ++idx)
+                {
+                    const double val =
+                        bAcc.Center(idx) -
+                        aAcc.Center(idx).center * xAcc.Center(idx) -
+                        aAcc.Left(idx).right * xAcc.Left(idx) -
+                        aAcc.Center(idx).right * xAcc.Right(idx) -
+                        aAcc.Down(idx).up * xAcc.Down(idx) -
+                        aAcc.Center(idx).up * xAcc.Up(idx);
+
+                    resultData[idx] = val;
+                    sum += val * val;
+                }
+
+                {
+                    const double val =
+                        ResidualAt(a, x, b, size, size.x - 1, j);
+                    (*result)(size.x - 1, j) = val;
+                    sum += val * val;
+                }
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
 double FDMBLAS2::L2Norm(const FDMVector2& v)
 {
     return std::sqrt(Dot(v, v));
@@ -178,24 +412,7 @@ void FDMCompressedBLAS2::AXPlusY(double a, const VectorND& x, const VectorND& y,
 void FDMCompressedBLAS2::MVM(const MatrixCSRD& m, const VectorND& v,
                              VectorND* result)
 {
-    const auto rp = m.RowPointersBegin();
-    const auto ci = m.ColumnIndicesBegin();
-    const auto nnz = m.NonZeroBegin();
-
-    v.ParallelForEachIndex([&](size_t i) {
-        const size_t rowBegin = rp[i];
-        const size_t rowEnd = rp[i + 1];
-
-        double sum = 0.0;
-
-        for (size_t jj = rowBegin; jj < rowEnd; ++jj)
-        {
-            const size_t j = ci[jj];
-            sum += nnz[jj] * v[j];
-        }
-
-        (*result)[i] = sum;
-    });
+    m.ParallelMul(v, result);
 }
 
 void FDMCompressedBLAS2::Residual(const MatrixCSRD& a, const VectorND& x,
@@ -221,6 +438,97 @@ void FDMCompressedBLAS2::Residual(const MatrixCSRD& a, const VectorND& x,
     });
 }
 
+double FDMCompressedBLAS2::AXPlusYAndSelfDot(double a, const VectorND& x,
+                                             const VectorND& y,
+                                             VectorND* result)
+{
+    assert(x.size() == y.size());
+    assert(x.size() == result->size());
+
+    const double* xData = x.data();
+    const double* yData = y.data();
+    double* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, x.size(), 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double sum = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                const double val = a * xData[i] + yData[i];
+                resultData[i] = val;
+                sum += val * val;
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMCompressedBLAS2::MVMAndDot(const MatrixCSRD& m, const VectorND& v,
+                                     VectorND* result)
+{
+    const auto rp = m.RowPointersBegin();
+    const auto ci = m.ColumnIndicesBegin();
+    const auto nnz = m.NonZeroBegin();
+
+    return ParallelReduce(
+        ZERO_SIZE, v.size(), 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double sum = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                double rowSum = 0.0;
+
+                for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj)
+                {
+                    rowSum += nnz[jj] * v[ci[jj]];
+                }
+
+                (*result)[i] = rowSum;
+                sum += v[i] * rowSum;
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMCompressedBLAS2::ResidualAndSelfDot(const MatrixCSRD& a,
+                                              const VectorND& x,
+                                              const VectorND& b,
+                                              VectorND* result)
+{
+    const auto rp = a.RowPointersBegin();
+    const auto ci = a.ColumnIndicesBegin();
+    const auto nnz = a.NonZeroBegin();
+
+    return ParallelReduce(
+        ZERO_SIZE, x.size(), 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double sum = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                double rowSum = 0.0;
+
+                for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj)
+                {
+                    rowSum += nnz[jj] * x[ci[jj]];
+                }
+
+                const double val = b[i] - rowSum;
+                (*result)[i] = val;
+                sum += val * val;
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
 double FDMCompressedBLAS2::L2Norm(const VectorND& v)
 {
     return std::sqrt(v.Dot(v));
@@ -9,12 +9,105 @@
 // property of any third parties.
 
 #include <Core/FDM/FDMLinearSystem3.hpp>
+#include <Core/FDM/FDMUtils.hpp>
 #include <Core/Math/MathUtils.hpp>
+#include <Core/Utils/Macros.hpp>
+#include <Core/Utils/Parallel.hpp>
+#include <Core/Utils/Profiler.hpp>
 
 #include <cassert>
+#include <functional>
 
 namespace CubbyFlow
 {
+namespace
+{
+//! Checked 7-point row of A·v at (i, j, k); used for the boundary shell.
+double MVMAt(const FDMMatrix3& m, const FDMVector3& v, const Size3& size,
+             size_t i, size_t j, size_t k)
+{
+    return m(i, j, k).center * v(i, j, k) +
+           ((i > 0) ? m(i - 1, j, k).right * v(i - 1, j, k) : 0.0) +
+           ((i + 1 < size.x) ? m(i, j, k).right * v(i + 1, j, k) : 0.0) +
+           ((j > 0) ? m(i, j - 1, k).up * v(i, j - 1, k) : 0.0) +
+           ((j + 1 < size.y) ? m(i, j, k).up * v(i, j + 1, k) : 0.0) +
+           ((k > 0) ? m(i, j, k - 1).front * v(i, j, k - 1) : 0.0) +
+           ((k + 1 < size.z) ? m(i, j, k).front * v(i, j, k + 1) : 0.0);
+}
+
+//! Checked 7-point row of b - A·x at (i, j, k); used for the boundary shell.
+double ResidualAt(const FDMMatrix3& a, const FDMVector3& x, const FDMVector3& b,
+                  const Size3& size, size_t i, size_t j, size_t k)
+{
+    return b(i, j, k) - a(i, j, k).center * x(i, j, k) -
+           ((i > 0) ? a(i - 1, j, k).right * x(i - 1, j, k) : 0.0) -
+           ((i + 1 < size.x) ? a(i, j, k).right * x(i + 1, j, k) : 0.0) -
+           ((j > 0) ? a(i, j - 1, k).up * x(i, j - 1, k) : 0.0) -
+           ((j + 1 < size.y) ? a(i, j, k).up * x(i, j + 1, k) : 0.0) -
+           ((k > 0) ? a(i, j, k - 1).front * x(i, j, k - 1) : 0.0) -
+           ((k + 1 < size.z) ? a(i, j, k).front * x(i, j, k + 1) : 0.0);
+}
+
+// The element-wise kernels below carry the hot loops of the BLAS-style
+// reductions and updates. They live outside the ParallelFor/ParallelReduce
+// lambdas so that CUBBYFLOW_TARGET_CLONES can version them per instruction
+// set; the caller picks the range, the loader picks the ISA.
+
+CUBBYFLOW_TARGET_CLONES
+double DotRange(const double* a, const double* b, size_t begin, size_t end,
+                double init)
+{
+    double sum = init;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
+CUBBYFLOW_TARGET_CLONES
+void AXPlusYRange(double a, const double* x, const double* y, double* result,
+                  size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        result[i] = a * x[i] + y[i];
+    }
+}
+
+CUBBYFLOW_TARGET_CLONES
+double AXPlusYSelfDotRange(double a, const double* x, const double* y,
+                           double* result, size_t begin, size_t end,
+                           double init)
+{
+    double sum = init;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        const double val = a * x[i] + y[i];
+        result[i] = val;
+        sum += val * val;
+    }
+
+    return sum;
+}
+
+CUBBYFLOW_TARGET_CLONES
+double MaxAbsRange(const double* v, size_t begin, size_t end, double init)
+{
+    double localMax = init;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        localMax = AbsMax(localMax, v[i]);
+    }
+
+    return localMax;
+}
+}  // namespace
+
 void FDMLinearSystem3::Clear()
 {
     A.Clear();
@@ -36,6 +129,43 @@ void FDMCompressedLinearSystem3::Clear()
     b.Clear();
 }
 
+const char* FDMLinearSystem3::GetMemoryStatsName() const
+{
+    return "FDMLinearSystem3";
+}
+
+void FDMLinearSystem3::ReportMemoryUsage(
+    std::vector<MemoryUsageRecord>* records) const
+{
+    const Size3 size = A.size();
+    const size_t n = size.x * size.y * size.z;
+
+    records->push_back(
+        MemoryUsageRecord{ "A", n * sizeof(FDMMatrixRow3) });
+    records->push_back(MemoryUsageRecord{
+        "x", x.size().x * x.size().y * x.size().z * sizeof(double) });
+    records->push_back(MemoryUsageRecord{
+        "b", b.size().x * b.size().y * b.size().z * sizeof(double) });
+}
+
+const char* FDMCompressedLinearSystem3::GetMemoryStatsName() const
+{
+    return "FDMCompressedLinearSystem3";
+}
+
+void FDMCompressedLinearSystem3::ReportMemoryUsage(
+    std::vector<MemoryUsageRecord>* records) const
+{
+    // Values plus column indices per non-zero, plus the row pointers.
+    records->push_back(MemoryUsageRecord{
+        "A", A.NumberOfNonZeros() * (sizeof(double) + sizeof(size_t)) +
+                 (A.Rows() + 1) * sizeof(size_t) });
+    records->push_back(
+        MemoryUsageRecord{ "x", x.size() * sizeof(double) });
+    records->push_back(
+        MemoryUsageRecord{ "b", b.size() * sizeof(double) });
+}
+
 void FDMBLAS3::Set(double s, FDMVector3* result)
 {
     result->Set(s);
@@ -64,34 +194,718 @@ double FDMBLAS3::Dot(const FDMVector3& a, const FDMVector3& b)
 
     assert(size == b.size());
 
-    double result = 0.0;
+    const size_t n = size.x * size.y * size.z;
+    const double* aData = a.data();
+    const double* bData = b.data();
+
+    CUBBYFLOW_PROFILE_ZONE("FDMBLAS3::Dot");
+    CUBBYFLOW_PROFILE_COUNTERS(16.0 * n, 0.0, 2.0 * n);
+
+    return ParallelReduce(
+        ZERO_SIZE, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            return DotRange(aData, bData, begin, end, init);
+        },
+        std::plus<double>());
+}
+
+void FDMBLAS3::AXPlusY(double a, const FDMVector3& x, const FDMVector3& y,
+                       FDMVector3* result)
+{
+    assert(x.size() == y.size());
+    assert(x.size() == result->size());
+
+    const Size3 size = x.size();
+    const size_t n = size.x * size.y * size.z;
+    const double* xData = x.data();
+    const double* yData = y.data();
+    double* resultData = result->data();
+
+    CUBBYFLOW_PROFILE_ZONE("FDMBLAS3::AXPlusY");
+    CUBBYFLOW_PROFILE_COUNTERS(16.0 * n, 8.0 * n, 2.0 * n);
+
+    ParallelRangeFor(ZERO_SIZE, n, [&](size_t begin, size_t end) {
+        AXPlusYRange(a, xData, yData, resultData, begin, end);
+    });
+}
+
+void FDMBLAS3::MVM(const FDMMatrix3& m, const FDMVector3& v, FDMVector3* result)
+{
+    Size3 size = m.size();
+
+    assert(size == v.size());
+    assert(size == result->size());
+
+    const auto n = static_cast<double>(size.x * size.y * size.z);
+
+    CUBBYFLOW_PROFILE_ZONE("FDMBLAS3::MVM");
+    CUBBYFLOW_PROFILE_COUNTERS(40.0 * n, 8.0 * n, 13.0 * n);
+
+    const StencilAccessor3<FDMMatrixRow3> mAcc{ m.ConstAccessor() };
+    const StencilAccessor3<double> vAcc{ v.ConstAccessor() };
+    double* resultData = result->data();
+
+    ParallelFor(ZERO_SIZE, size.z, [&](size_t k) {
+        for (size_t j = 0; j < size.y; ++j)
+        {
+            // Rows touching the domain boundary (and degenerate rows) keep
+            // the checked per-point path; interior rows run the unchecked
+            // stencil with the same term order, so results match bitwise.
+            if (size.x < 3 || j == 0 || j + 1 == size.y || k == 0 ||
+                k + 1 == size.z)
+            {
+                for (size_t i = 0; i < size.x; ++i)
+                {
+                    (*result)(i, j, k) = MVMAt(m, v, size, i, j, k);
+                }
+
+                continue;
+            }
+
+            (*result)(0, j, k) = MVMAt(m, v, size, 0, j, k);
+
+            size_t idx = mAcc.Index(1, j, k);
+            for (size_t i = 1; i + 1 < size.x; ++i, ++idx)
+            {
+                resultData[idx] = mAcc.Center(idx).center * vAcc.Center(idx) +
+                                  mAcc.Left(idx).right * vAcc.Left(idx) +
+                                  mAcc.Center(idx).right * vAcc.Right(idx) +
+                                  mAcc.Down(idx).up * vAcc.Down(idx) +
+                                  mAcc.Center(idx).up * vAcc.Up(idx) +
+                                  mAcc.Back(idx).front * vAcc.Back(idx) +
+                                  mAcc.Center(idx).front * vAcc.Front(idx);
+            }
+
+            (*result)(size.x - 1, j, k) =
+                MVMAt(m, v, size, size.x - 1, j, k);
+        }
+    });
+}
+
+void FDMBLAS3::Residual(const FDMMatrix3& a, const FDMVector3& x,
+                        const FDMVector3& b, FDMVector3* result)
+{
+    Size3 size = a.size();
+
+    assert(size == x.size());
+    assert(size == b.size());
+    assert(size == result->size());
+
+    const auto n = static_cast<double>(size.x * size.y * size.z);
+
+    CUBBYFLOW_PROFILE_ZONE("FDMBLAS3::Residual");
+    CUBBYFLOW_PROFILE_COUNTERS(48.0 * n, 8.0 * n, 14.0 * n);
+
+    const StencilAccessor3<FDMMatrixRow3> aAcc{ a.ConstAccessor() };
+    const StencilAccessor3<double> xAcc{ x.ConstAccessor() };
+    const double* bData = b.data();
+    double* resultData = result->data();
+
+    ParallelFor(ZERO_SIZE, size.z, [&](size_t k) {
+        for (size_t j = 0; j < size.y; ++j)
+        {
+            if (size.x < 3 || j == 0 || j + 1 == size.y || k == 0 ||
+                k + 1 == size.z)
+            {
+                for (size_t i = 0; i < size.x; ++i)
+                {
+                    (*result)(i, j, k) = ResidualAt(a, x, b, size, i, j, k);
+                }
+
+                continue;
+            }
+
+            (*result)(0, j, k) = ResidualAt(a, x, b, size, 0, j, k);
+
+            size_t idx = aAcc.Index(1, j, k);
+            for (size_t i = 1; i + 1 < size.x; ++i, ++idx)
+            {
+                resultData[idx] = bData[idx] -
+                                  aAcc.Center(idx).center * xAcc.Center(idx) -
+                                  aAcc.Left(idx).right * xAcc.Left(idx) -
+                                  aAcc.Center(idx).right * xAcc.Right(idx) -
+                                  aAcc.Down(idx).up * xAcc.Down(idx) -
+                                  aAcc.Center(idx).up * xAcc.Up(idx) -
+                                  aAcc.Back(idx).front * xAcc.Back(idx) -
+                                  aAcc.Center(idx).front * xAcc.Front(idx);
+            }
 
-    for (size_t k = 0; k < size.z; ++k)
+            (*result)(size.x - 1, j, k) =
+                ResidualAt(a, x, b, size, size.x - 1, j, k);
+        }
+    });
+}
+
+double FDMBLAS3::AXPlusYAndSelfDot(double a, const FDMVector3& x,
+                                   const FDMVector3& y, FDMVector3* result)
+{
+    assert(x.size() == y.size());
+    assert(x.size() == result->size());
+
+    const Size3 size = x.size();
+    const size_t n = size.x * size.y * size.z;
+    const double* xData = x.data();
+    const double* yData = y.data();
+    double* resultData = result->data();
+
+    CUBBYFLOW_PROFILE_ZONE("FDMBLAS3::AXPlusYAndSelfDot");
+    CUBBYFLOW_PROFILE_COUNTERS(16.0 * n, 8.0 * n, 4.0 * n);
+
+    return ParallelReduce(
+        ZERO_SIZE, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            return AXPlusYSelfDotRange(a, xData, yData, resultData, begin,
+                                       end, init);
+        },
+        std::plus<double>());
+}
+
+double FDMBLAS3::MVMAndDot(const FDMMatrix3& m, const FDMVector3& v,
+                           FDMVector3* result)
+{
+    Size3 size = m.size();
+
+    assert(size == v.size());
+    assert(size == result->size());
+
+    const auto n = static_cast<double>(size.x * size.y * size.z);
+
+    CUBBYFLOW_PROFILE_ZONE("FDMBLAS3::MVMAndDot");
+    CUBBYFLOW_PROFILE_COUNTERS(40.0 * n, 8.0 * n, 15.0 * n);
+
+    const StencilAccessor3<FDMMatrixRow3> mAcc{ m.ConstAccessor() };
+    const StencilAccessor3<double> vAcc{ v.ConstAccessor() };
+    double* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, size.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double init) {
+            double sum = init;
+
+            for (size_t k = kBegin; k < kEnd; ++k)
+            {
+                for (size_t j = 0; j < size.y; ++j)
+                {
+                    if (size.x < 3 || j == 0 || j + 1 == size.y || k == 0 ||
+                        k + 1 == size.z)
+                    {
+                        for (size_t i = 0; i < size.x; ++i)
+                        {
+                            const double val = MVMAt(m, v, size, i, j, k);
+
+                            (*result)(i, j, k) = val;
+                            sum += v(i, j, k) * val;
+                        }
+
+                        continue;
+                    }
+
+                    double val = MVMAt(m, v, size, 0, j, k);
+                    (*result)(0, j, k) = val;
+                    sum += v(0, j, k) * val;
+
+                    size_t idx = mAcc.Index(1, j, k);
+                    for (size_t i = 1; i + 1 < size.x; ++i, ++idx)
+                    {
+                        val = mAcc.Center(idx).center * vAcc.Center(idx) +
+                              mAcc.Left(idx).right * vAcc.Left(idx) +
+                              mAcc.Center(idx).right * vAcc.Right(idx) +
+                              mAcc.Down(idx).up * vAcc.Down(idx) +
+                              mAcc.Center(idx).up * vAcc.Up(idx) +
+                              mAcc.Back(idx).front * vAcc.Back(idx) +
+                              mAcc.Center(idx).front * vAcc.Front(idx);
+
+                        resultData[idx] = val;
+                        sum += vAcc.Center(idx) * val;
+                    }
+
+                    val = MVMAt(m, v, size, size.x - 1, j, k);
+                    (*result)(size.x - 1, j, k) = val;
+                    sum += v(size.x - 1, j, k) * val;
+                }
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMBLAS3::ResidualAndSelfDot(const FDMMatrix3& a, const FDMVector3& x,
+                                    const FDMVector3& b, FDMVector3* result)
+{
+    Size3 size = a.size();
+
+    assert(size == x.size());
+    assert(size == b.size());
+    assert(size == result->size());
+
+    const auto n = static_cast<double>(size.x * size.y * size.z);
+
+    CUBBYFLOW_PROFILE_ZONE("FDMBLAS3::ResidualAndSelfDot");
+    CUBBYFLOW_PROFILE_COUNTERS(48.0 * n, 8.0 * n, 16.0 * n);
+
+    const StencilAccessor3<FDMMatrixRow3> aAcc{ a.ConstAccessor() };
+    const StencilAccessor3<double> xAcc{ x.ConstAccessor() };
+    const double* bData = b.data();
+    double* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, size.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double init) {
+            double sum = init;
+
+            for (size_t k = kBegin; k < kEnd; ++k)
+            {
+                for (size_t j = 0; j < size.y; ++j)
+                {
+                    if (size.x < 3 || j == 0 || j + 1 == size.y || k == 0 ||
+                        k + 1 == size.z)
+                    {
+                        for (size_t i = 0; i < size.x; ++i)
+                        {
+                            const double val =
+                                ResidualAt(a, x, b, size, i, j, k);
+
+                            (*result)(i, j, k) = val;
+                            sum += val * val;
+                        }
+
+                        continue;
+                    }
+
+                    double val = ResidualAt(a, x, b, size, 0, j, k);
+                    (*result)(0, j, k) = val;
+                    sum += val * val;
+
+                    size_t idx = aAcc.Index(1, j, k);
+                    for (size_t i = 1; i + 1 < size.x; ++i, ++idx)
+                    {
+                        val = bData[idx] -
+                              aAcc.Center(idx).center * xAcc.Center(idx) -
+                              aAcc.Left(idx).right * xAcc.Left(idx) -
+                              aAcc.Center(idx).right * xAcc.Right(idx) -
+                              aAcc.Down(idx).up * xAcc.Down(idx) -
+                              aAcc.Center(idx).up * xAcc.Up(idx) -
+                              aAcc.Back(idx).front * xAcc.Back(idx) -
+                              aAcc.Center(idx).front * xAcc.Front(idx);
+
+                        resultData[idx] = val;
+                        sum += val * val;
+                    }
+
+                    val = ResidualAt(a, x, b, size, size.x - 1, j, k);
+                    (*result)(size.x - 1, j, k) = val;
+                    sum += val * val;
+                }
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMBLAS3::L2Norm(const FDMVector3& v)
+{
+    return std::sqrt(Dot(v, v));
+}
+
+double FDMBLAS3::LInfNorm(const FDMVector3& v)
+{
+    const Size3 size = v.size();
+    const size_t n = size.x * size.y * size.z;
+    const double* vData = v.data();
+
+    const double result = ParallelReduce(
+        ZERO_SIZE, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            return MaxAbsRange(vData, begin, end, init);
+        },
+        [](double a, double b) { return AbsMax(a, b); });
+
+    return std::fabs(result);
+}
+
+void FDMMatrixSoA3::Clear()
+{
+    center.Clear();
+    right.Clear();
+    up.Clear();
+    front.Clear();
+}
+
+void FDMMatrixSoA3::Resize(const Size3& size)
+{
+    center.Resize(size);
+    right.Resize(size);
+    up.Resize(size);
+    front.Resize(size);
+}
+
+void FDMMatrixSoA3::Set(const FDMMatrix3& m)
+{
+    Resize(m.size());
+
+    const FDMMatrixRow3* rows = m.data();
+    double* centerData = center.data();
+    double* rightData = right.data();
+    double* upData = up.data();
+    double* frontData = front.data();
+
+    const Size3 size = m.size();
+    const size_t n = size.x * size.y * size.z;
+
+    ParallelFor(ZERO_SIZE, n, [&](size_t i) {
+        centerData[i] = rows[i].center;
+        rightData[i] = rows[i].right;
+        upData[i] = rows[i].up;
+        frontData[i] = rows[i].front;
+    });
+}
+
+Size3 FDMMatrixSoA3::size() const
+{
+    return center.size();
+}
+
+namespace
+{
+//!
+//! Computes one (j, k) row of the SoA stencil product into \p out. Every
+//! term is a product of two unit-stride streams; the j/k boundary tests are
+//! uniform over the row, so they hoist out of the inner loops.
+//!
+CUBBYFLOW_TARGET_CLONES
+void SoAProductRow(const FDMMatrixSoA3& m, const double* vData,
+                   const Size3& size, size_t j, size_t k, double* out)
+{
+    const size_t nx = size.x;
+    const size_t rowIdx = nx * (j + size.y * k);
+
+    const double* cRow = m.center.data() + rowIdx;
+    const double* rRow = m.right.data() + rowIdx;
+    const double* vRow = vData + rowIdx;
+
+    // Center and the i-direction couplings.
+    out[0] = cRow[0] * vRow[0];
+    for (size_t i = 1; i < nx; ++i)
+    {
+        out[i] = cRow[i] * vRow[i] + rRow[i - 1] * vRow[i - 1];
+    }
+    for (size_t i = 0; i + 1 < nx; ++i)
+    {
+        out[i] += rRow[i] * vRow[i + 1];
+    }
+
+    // j-direction couplings.
+    if (j > 0)
     {
+        const double* uRowM = m.up.data() + rowIdx - nx;
+        const double* vRowM = vRow - nx;
+        for (size_t i = 0; i < nx; ++i)
+        {
+            out[i] += uRowM[i] * vRowM[i];
+        }
+    }
+    if (j + 1 < size.y)
+    {
+        const double* uRow = m.up.data() + rowIdx;
+        const double* vRowP = vRow + nx;
+        for (size_t i = 0; i < nx; ++i)
+        {
+            out[i] += uRow[i] * vRowP[i];
+        }
+    }
+
+    // k-direction couplings.
+    const size_t slice = nx * size.y;
+    if (k > 0)
+    {
+        const double* fRowM = m.front.data() + rowIdx - slice;
+        const double* vRowM = vData + rowIdx - slice;
+        for (size_t i = 0; i < nx; ++i)
+        {
+            out[i] += fRowM[i] * vRowM[i];
+        }
+    }
+    if (k + 1 < size.z)
+    {
+        const double* fRow = m.front.data() + rowIdx;
+        const double* vRowP = vData + rowIdx + slice;
+        for (size_t i = 0; i < nx; ++i)
+        {
+            out[i] += fRow[i] * vRowP[i];
+        }
+    }
+}
+}  // namespace
+
+void FDMSoABLAS3::Set(double s, FDMVector3* result)
+{
+    result->Set(s);
+}
+
+void FDMSoABLAS3::Set(const FDMVector3& v, FDMVector3* result)
+{
+    result->Set(v);
+}
+
+void FDMSoABLAS3::Set(double s, FDMMatrixSoA3* result)
+{
+    result->center.Set(s);
+    result->right.Set(s);
+    result->up.Set(s);
+    result->front.Set(s);
+}
+
+void FDMSoABLAS3::Set(const FDMMatrixSoA3& m, FDMMatrixSoA3* result)
+{
+    result->center.Set(m.center);
+    result->right.Set(m.right);
+    result->up.Set(m.up);
+    result->front.Set(m.front);
+}
+
+double FDMSoABLAS3::Dot(const FDMVector3& a, const FDMVector3& b)
+{
+    return FDMBLAS3::Dot(a, b);
+}
+
+void FDMSoABLAS3::AXPlusY(double a, const FDMVector3& x, const FDMVector3& y,
+                          FDMVector3* result)
+{
+    FDMBLAS3::AXPlusY(a, x, y, result);
+}
+
+void FDMSoABLAS3::MVM(const FDMMatrixSoA3& m, const FDMVector3& v,
+                      FDMVector3* result)
+{
+    const Size3 size = m.size();
+
+    assert(size == v.size());
+    assert(size == result->size());
+
+    const auto n = static_cast<double>(size.x * size.y * size.z);
+
+    CUBBYFLOW_PROFILE_ZONE("FDMSoABLAS3::MVM");
+    CUBBYFLOW_PROFILE_COUNTERS(40.0 * n, 8.0 * n, 13.0 * n);
+
+    const double* vData = v.data();
+    double* resultData = result->data();
+
+    ParallelFor(ZERO_SIZE, size.z, [&](size_t k) {
+        for (size_t j = 0; j < size.y; ++j)
+        {
+            SoAProductRow(m, vData, size, j, k,
+                          resultData + size.x * (j + size.y * k));
+        }
+    });
+}
+
+void FDMSoABLAS3::Residual(const FDMMatrixSoA3& a, const FDMVector3& x,
+                           const FDMVector3& b, FDMVector3* result)
+{
+    const Size3 size = a.size();
+
+    assert(size == x.size());
+    assert(size == b.size());
+    assert(size == result->size());
+
+    const auto n = static_cast<double>(size.x * size.y * size.z);
+
+    CUBBYFLOW_PROFILE_ZONE("FDMSoABLAS3::Residual");
+    CUBBYFLOW_PROFILE_COUNTERS(48.0 * n, 8.0 * n, 14.0 * n);
+
+    const double* xData = x.data();
+    const double* bData = b.data();
+    double* resultData = result->data();
+
+    ParallelFor(ZERO_SIZE, size.z, [&](size_t k) {
         for (size_t j = 0; j < size.y; ++j)
         {
+            const size_t rowIdx = size.x * (j + size.y * k);
+            double* out = resultData + rowIdx;
+
+            SoAProductRow(a, xData, size, j, k, out);
+
+            // The product row is still in L1; flipping it into the residual
+            // is a cheap second sweep.
+            const double* bRow = bData + rowIdx;
             for (size_t i = 0; i < size.x; ++i)
             {
-                result += a(i, j, k) * b(i, j, k);
+                out[i] = bRow[i] - out[i];
             }
         }
-    }
+    });
+}
 
-    return result;
+double FDMSoABLAS3::AXPlusYAndSelfDot(double a, const FDMVector3& x,
+                                      const FDMVector3& y, FDMVector3* result)
+{
+    return FDMBLAS3::AXPlusYAndSelfDot(a, x, y, result);
 }
 
-void FDMBLAS3::AXPlusY(double a, const FDMVector3& x, const FDMVector3& y,
-                       FDMVector3* result)
+double FDMSoABLAS3::MVMAndDot(const FDMMatrixSoA3& m, const FDMVector3& v,
+                              FDMVector3* result)
+{
+    const Size3 size = m.size();
+
+    assert(size == v.size());
+    assert(size == result->size());
+
+    const auto n = static_cast<double>(size.x * size.y * size.z);
+
+    CUBBYFLOW_PROFILE_ZONE("FDMSoABLAS3::MVMAndDot");
+    CUBBYFLOW_PROFILE_COUNTERS(40.0 * n, 8.0 * n, 15.0 * n);
+
+    const double* vData = v.data();
+    double* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, size.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double init) {
+            double sum = init;
+
+            for (size_t k = kBegin; k < kEnd; ++k)
+            {
+                for (size_t j = 0; j < size.y; ++j)
+                {
+                    const size_t rowIdx = size.x * (j + size.y * k);
+                    double* out = resultData + rowIdx;
+                    const double* vRow = vData + rowIdx;
+
+                    SoAProductRow(m, vData, size, j, k, out);
+
+                    for (size_t i = 0; i < size.x; ++i)
+                    {
+                        sum += vRow[i] * out[i];
+                    }
+                }
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMSoABLAS3::ResidualAndSelfDot(const FDMMatrixSoA3& a,
+                                       const FDMVector3& x,
+                                       const FDMVector3& b,
+                                       FDMVector3* result)
+{
+    const Size3 size = a.size();
+
+    assert(size == x.size());
+    assert(size == b.size());
+    assert(size == result->size());
+
+    const auto n = static_cast<double>(size.x * size.y * size.z);
+
+    CUBBYFLOW_PROFILE_ZONE("FDMSoABLAS3::ResidualAndSelfDot");
+    CUBBYFLOW_PROFILE_COUNTERS(48.0 * n, 8.0 * n, 16.0 * n);
+
+    const double* xData = x.data();
+    const double* bData = b.data();
+    double* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, size.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double init) {
+            double sum = init;
+
+            for (size_t k = kBegin; k < kEnd; ++k)
+            {
+                for (size_t j = 0; j < size.y; ++j)
+                {
+                    const size_t rowIdx = size.x * (j + size.y * k);
+                    double* out = resultData + rowIdx;
+                    const double* bRow = bData + rowIdx;
+
+                    SoAProductRow(a, xData, size, j, k, out);
+
+                    for (size_t i = 0; i < size.x; ++i)
+                    {
+                        const double val = bRow[i] - out[i];
+                        out[i] = val;
+                        sum += val * val;
+                    }
+                }
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMSoABLAS3::L2Norm(const FDMVector3& v)
+{
+    return FDMBLAS3::L2Norm(v);
+}
+
+double FDMSoABLAS3::LInfNorm(const FDMVector3& v)
+{
+    return FDMBLAS3::LInfNorm(v);
+}
+
+void FDMBLAS3F::Set(double s, FDMVector3F* result)
+{
+    result->Set(static_cast<float>(s));
+}
+
+void FDMBLAS3F::Set(const FDMVector3F& v, FDMVector3F* result)
+{
+    result->Set(v);
+}
+
+void FDMBLAS3F::Set(double s, FDMMatrix3F* result)
+{
+    FDMMatrixRow3F row;
+    row.center = row.right = row.up = row.front = static_cast<float>(s);
+    result->Set(row);
+}
+
+void FDMBLAS3F::Set(const FDMMatrix3F& m, FDMMatrix3F* result)
+{
+    result->Set(m);
+}
+
+double FDMBLAS3F::Dot(const FDMVector3F& a, const FDMVector3F& b)
+{
+    const Size3 size = a.size();
+
+    assert(size == b.size());
+
+    const size_t n = size.x * size.y * size.z;
+    const float* aData = a.data();
+    const float* bData = b.data();
+
+    return ParallelReduce(
+        ZERO_SIZE, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double sum = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                sum += static_cast<double>(aData[i]) * bData[i];
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+void FDMBLAS3F::AXPlusY(double a, const FDMVector3F& x, const FDMVector3F& y,
+                        FDMVector3F* result)
 {
     assert(x.size() == y.size());
     assert(x.size() == result->size());
 
     x.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        (*result)(i, j, k) = a * x(i, j, k) + y(i, j, k);
+        (*result)(i, j, k) = static_cast<float>(a * x(i, j, k) + y(i, j, k));
     });
 }
 
-void FDMBLAS3::MVM(const FDMMatrix3& m, const FDMVector3& v, FDMVector3* result)
+void FDMBLAS3F::MVM(const FDMMatrix3F& m, const FDMVector3F& v,
+                    FDMVector3F* result)
 {
     Size3 size = m.size();
 
@@ -101,17 +915,17 @@ void FDMBLAS3::MVM(const FDMMatrix3& m, const FDMVector3& v, FDMVector3* result)
     m.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
         (*result)(i, j, k) =
             m(i, j, k).center * v(i, j, k) +
-            ((i > 0) ? m(i - 1, j, k).right * v(i - 1, j, k) : 0.0) +
-            ((i + 1 < size.x) ? m(i, j, k).right * v(i + 1, j, k) : 0.0) +
-            ((j > 0) ? m(i, j - 1, k).up * v(i, j - 1, k) : 0.0) +
-            ((j + 1 < size.y) ? m(i, j, k).up * v(i, j + 1, k) : 0.0) +
-            ((k > 0) ? m(i, j, k - 1).front * v(i, j, k - 1) : 0.0) +
-            ((k + 1 < size.z) ? m(i, j, k).front * v(i, j, k + 1) : 0.0);
+            ((i > 0) ? m(i - 1, j, k).right * v(i - 1, j, k) : 0.0f) +
+            ((i + 1 < size.x) ? m(i, j, k).right * v(i + 1, j, k) : 0.0f) +
+            ((j > 0) ? m(i, j - 1, k).up * v(i, j - 1, k) : 0.0f) +
+            ((j + 1 < size.y) ? m(i, j, k).up * v(i, j + 1, k) : 0.0f) +
+            ((k > 0) ? m(i, j, k - 1).front * v(i, j, k - 1) : 0.0f) +
+            ((k + 1 < size.z) ? m(i, j, k).front * v(i, j, k + 1) : 0.0f);
     });
 }
 
-void FDMBLAS3::Residual(const FDMMatrix3& a, const FDMVector3& x,
-                        const FDMVector3& b, FDMVector3* result)
+void FDMBLAS3F::Residual(const FDMMatrix3F& a, const FDMVector3F& x,
+                         const FDMVector3F& b, FDMVector3F* result)
 {
     Size3 size = a.size();
 
@@ -122,35 +936,163 @@ void FDMBLAS3::Residual(const FDMMatrix3& a, const FDMVector3& x,
     a.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
         (*result)(i, j, k) =
             b(i, j, k) - a(i, j, k).center * x(i, j, k) -
-            ((i > 0) ? a(i - 1, j, k).right * x(i - 1, j, k) : 0.0) -
-            ((i + 1 < size.x) ? a(i, j, k).right * x(i + 1, j, k) : 0.0) -
-            ((j > 0) ? a(i, j - 1, k).up * x(i, j - 1, k) : 0.0) -
-            ((j + 1 < size.y) ? a(i, j, k).up * x(i, j + 1, k) : 0.0) -
-            ((k > 0) ? a(i, j, k - 1).front * x(i, j, k - 1) : 0.0) -
-            ((k + 1 < size.z) ? a(i, j, k).front * x(i, j, k + 1) : 0.0);
+            ((i > 0) ? a(i - 1, j, k).right * x(i - 1, j, k) : 0.0f) -
+            ((i + 1 < size.x) ? a(i, j, k).right * x(i + 1, j, k) : 0.0f) -
+            ((j > 0) ? a(i, j - 1, k).up * x(i, j - 1, k) : 0.0f) -
+            ((j + 1 < size.y) ? a(i, j, k).up * x(i, j + 1, k) : 0.0f) -
+            ((k > 0) ? a(i, j, k - 1).front * x(i, j, k - 1) : 0.0f) -
+            ((k + 1 < size.z) ? a(i, j, k).front * x(i, j, k + 1) : 0.0f);
     });
 }
 
-double FDMBLAS3::L2Norm(const FDMVector3& v)
+double FDMBLAS3F::AXPlusYAndSelfDot(double a, const FDMVector3F& x,
+                                    const FDMVector3F& y, FDMVector3F* result)
+{
+    assert(x.size() == y.size());
+    assert(x.size() == result->size());
+
+    const Size3 size = x.size();
+    const size_t n = size.x * size.y * size.z;
+    const float* xData = x.data();
+    const float* yData = y.data();
+    float* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double sum = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                const double val = a * xData[i] + yData[i];
+                resultData[i] = static_cast<float>(val);
+                sum += val * val;
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMBLAS3F::MVMAndDot(const FDMMatrix3F& m, const FDMVector3F& v,
+                            FDMVector3F* result)
+{
+    Size3 size = m.size();
+
+    assert(size == v.size());
+    assert(size == result->size());
+
+    return ParallelReduce(
+        ZERO_SIZE, size.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double init) {
+            double sum = init;
+
+            for (size_t k = kBegin; k < kEnd; ++k)
+            {
+                for (size_t j = 0; j < size.y; ++j)
+                {
+                    for (size_t i = 0; i < size.x; ++i)
+                    {
+                        const float val =
+                            m(i, j, k).center * v(i, j, k) +
+                            ((i > 0) ? m(i - 1, j, k).right * v(i - 1, j, k)
+                                     : 0.0f) +
+                            ((i + 1 < size.x)
+                                 ? m(i, j, k).right * v(i + 1, j, k)
+                                 : 0.0f) +
+                            ((j > 0) ? m(i, j - 1, k).up * v(i, j - 1, k)
+                                     : 0.0f) +
+                            ((j + 1 < size.y) ? m(i, j, k).up * v(i, j + 1, k)
+                                              : 0.0f) +
+                            ((k > 0) ? m(i, j, k - 1).front * v(i, j, k - 1)
+                                     : 0.0f) +
+                            ((k + 1 < size.z)
+                                 ? m(i, j, k).front * v(i, j, k + 1)
+                                 : 0.0f);
+
+                        (*result)(i, j, k) = val;
+                        sum += static_cast<double>(v(i, j, k)) * val;
+                    }
+                }
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMBLAS3F::ResidualAndSelfDot(const FDMMatrix3F& a, const FDMVector3F& x,
+                                     const FDMVector3F& b, FDMVector3F* result)
+{
+    Size3 size = a.size();
+
+    assert(size == x.size());
+    assert(size == b.size());
+    assert(size == result->size());
+
+    return ParallelReduce(
+        ZERO_SIZE, size.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double init) {
+            double sum = init;
+
+            for (size_t k = kBegin; k < kEnd; ++k)
+            {
+                for (size_t j = 0; j < size.y; ++j)
+                {
+                    for (size_t i = 0; i < size.x; ++i)
+                    {
+                        const float val =
+                            b(i, j, k) - a(i, j, k).center * x(i, j, k) -
+                            ((i > 0) ? a(i - 1, j, k).right * x(i - 1, j, k)
+                                     : 0.0f) -
+                            ((i + 1 < size.x)
+                                 ? a(i, j, k).right * x(i + 1, j, k)
+                                 : 0.0f) -
+                            ((j > 0) ? a(i, j - 1, k).up * x(i, j - 1, k)
+                                     : 0.0f) -
+                            ((j + 1 < size.y) ? a(i, j, k).up * x(i, j + 1, k)
+                                              : 0.0f) -
+                            ((k > 0) ? a(i, j, k - 1).front * x(i, j, k - 1)
+                                     : 0.0f) -
+                            ((k + 1 < size.z)
+                                 ? a(i, j, k).front * x(i, j, k + 1)
+                                 : 0.0f);
+
+                        (*result)(i, j, k) = val;
+                        sum += static_cast<double>(val) * val;
+                    }
+                }
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMBLAS3F::L2Norm(const FDMVector3F& v)
 {
     return std::sqrt(Dot(v, v));
 }
 
-double FDMBLAS3::LInfNorm(const FDMVector3& v)
+double FDMBLAS3F::LInfNorm(const FDMVector3F& v)
 {
     const Size3 size = v.size();
-    double result = 0.0;
+    const size_t n = size.x * size.y * size.z;
+    const float* vData = v.data();
 
-    for (size_t k = 0; k < size.z; ++k)
-    {
-        for (size_t j = 0; j < size.y; ++j)
-        {
-            for (size_t i = 0; i < size.x; ++i)
+    const double result = ParallelReduce(
+        ZERO_SIZE, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double localMax = init;
+
+            for (size_t i = begin; i < end; ++i)
             {
-                result = AbsMax(result, v(i, j, k));
+                localMax = AbsMax(localMax, static_cast<double>(vData[i]));
             }
-        }
-    }
+
+            return localMax;
+        },
+        [](double a, double b) { return AbsMax(a, b); });
 
     return std::fabs(result);
 }
@@ -189,24 +1131,7 @@ void FDMCompressedBLAS3::AXPlusY(double a, const VectorND& x, const VectorND& y,
 void FDMCompressedBLAS3::MVM(const MatrixCSRD& m, const VectorND& v,
                              VectorND* result)
 {
-    const auto rp = m.RowPointersBegin();
-    const auto ci = m.ColumnIndicesBegin();
-    const auto nnz = m.NonZeroBegin();
-
-    v.ParallelForEachIndex([&](size_t i) {
-        const size_t rowBegin = rp[i];
-        const size_t rowEnd = rp[i + 1];
-
-        double sum = 0.0;
-
-        for (size_t jj = rowBegin; jj < rowEnd; ++jj)
-        {
-            const size_t j = ci[jj];
-            sum += nnz[jj] * v[j];
-        }
-
-        (*result)[i] = sum;
-    });
+    m.ParallelMul(v, result);
 }
 
 void FDMCompressedBLAS3::Residual(const MatrixCSRD& a, const VectorND& x,
@@ -232,6 +1157,97 @@ void FDMCompressedBLAS3::Residual(const MatrixCSRD& a, const VectorND& x,
     });
 }
 
+double FDMCompressedBLAS3::AXPlusYAndSelfDot(double a, const VectorND& x,
+                                             const VectorND& y,
+                                             VectorND* result)
+{
+    assert(x.size() == y.size());
+    assert(x.size() == result->size());
+
+    const double* xData = x.data();
+    const double* yData = y.data();
+    double* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, x.size(), 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double sum = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                const double val = a * xData[i] + yData[i];
+                resultData[i] = val;
+                sum += val * val;
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMCompressedBLAS3::MVMAndDot(const MatrixCSRD& m, const VectorND& v,
+                                     VectorND* result)
+{
+    const auto rp = m.RowPointersBegin();
+    const auto ci = m.ColumnIndicesBegin();
+    const auto nnz = m.NonZeroBegin();
+
+    return ParallelReduce(
+        ZERO_SIZE, v.size(), 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double sum = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                double rowSum = 0.0;
+
+                for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj)
+                {
+                    rowSum += nnz[jj] * v[ci[jj]];
+                }
+
+                (*result)[i] = rowSum;
+                sum += v[i] * rowSum;
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMCompressedBLAS3::ResidualAndSelfDot(const MatrixCSRD& a,
+                                              const VectorND& x,
+                                              const VectorND& b,
+                                              VectorND* result)
+{
+    const auto rp = a.RowPointersBegin();
+    const auto ci = a.ColumnIndicesBegin();
+    const auto nnz = a.NonZeroBegin();
+
+    return ParallelReduce(
+        ZERO_SIZE, x.size(), 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double sum = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                double rowSum = 0.0;
+
+                for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj)
+                {
+                    rowSum += nnz[jj] * x[ci[jj]];
+                }
+
+                const double val = b[i] - rowSum;
+                (*result)[i] = val;
+                sum += val * val;
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
 double FDMCompressedBLAS3::L2Norm(const VectorND& v)
 {
     return std::sqrt(v.Dot(v));
@@ -241,4 +1257,123 @@ double FDMCompressedBLAS3::LInfNorm(const VectorND& v)
 {
     return std::fabs(v.AbsMax());
 }
+
+void FDMMatrixFreeBLAS3::Set(double s, FDMVector3* result)
+{
+    FDMBLAS3::Set(s, result);
+}
+
+void FDMMatrixFreeBLAS3::Set(const FDMVector3& v, FDMVector3* result)
+{
+    FDMBLAS3::Set(v, result);
+}
+
+double FDMMatrixFreeBLAS3::Dot(const FDMVector3& a, const FDMVector3& b)
+{
+    return FDMBLAS3::Dot(a, b);
+}
+
+void FDMMatrixFreeBLAS3::AXPlusY(double a, const FDMVector3& x,
+                                 const FDMVector3& y, FDMVector3* result)
+{
+    FDMBLAS3::AXPlusY(a, x, y, result);
+}
+
+void FDMMatrixFreeBLAS3::MVM(const FDMMatrixFreeOperator3& op,
+                             const FDMVector3& v, FDMVector3* result)
+{
+    assert(v.size() == result->size());
+
+    op(v, result);
+}
+
+void FDMMatrixFreeBLAS3::Residual(const FDMMatrixFreeOperator3& op,
+                                  const FDMVector3& x, const FDMVector3& b,
+                                  FDMVector3* result)
+{
+    assert(x.size() == b.size());
+    assert(x.size() == result->size());
+
+    op(x, result);
+
+    b.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        (*result)(i, j, k) = b(i, j, k) - (*result)(i, j, k);
+    });
+}
+
+double FDMMatrixFreeBLAS3::AXPlusYAndSelfDot(double a, const FDMVector3& x,
+                                             const FDMVector3& y,
+                                             FDMVector3* result)
+{
+    return FDMBLAS3::AXPlusYAndSelfDot(a, x, y, result);
+}
+
+double FDMMatrixFreeBLAS3::MVMAndDot(const FDMMatrixFreeOperator3& op,
+                                     const FDMVector3& v, FDMVector3* result)
+{
+    assert(v.size() == result->size());
+
+    op(v, result);
+
+    const Size3 size = v.size();
+    const size_t n = size.x * size.y * size.z;
+    const double* vData = v.data();
+    const double* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double sum = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                sum += vData[i] * resultData[i];
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMMatrixFreeBLAS3::ResidualAndSelfDot(const FDMMatrixFreeOperator3& op,
+                                              const FDMVector3& x,
+                                              const FDMVector3& b,
+                                              FDMVector3* result)
+{
+    assert(x.size() == b.size());
+    assert(x.size() == result->size());
+
+    op(x, result);
+
+    const Size3 size = x.size();
+    const size_t n = size.x * size.y * size.z;
+    const double* bData = b.data();
+    double* resultData = result->data();
+
+    return ParallelReduce(
+        ZERO_SIZE, n, 0.0,
+        [&](size_t begin, size_t end, double init) {
+            double sum = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                const double val = bData[i] - resultData[i];
+                resultData[i] = val;
+                sum += val * val;
+            }
+
+            return sum;
+        },
+        std::plus<double>());
+}
+
+double FDMMatrixFreeBLAS3::L2Norm(const FDMVector3& v)
+{
+    return FDMBLAS3::L2Norm(v);
+}
+
+double FDMMatrixFreeBLAS3::LInfNorm(const FDMVector3& v)
+{
+    return FDMBLAS3::LInfNorm(v);
+}
 }  // namespace CubbyFlow
\ No newline at end of file
@@ -60,6 +60,7 @@ void FDMMGUtils3::Restrict(const FDMVector3 &finer, FDMVector3 *coarser)
                                                     0.125 } };
 
     const Size3 n = coarser->size();
+    ArrayAccessor3<double> coarserAcc = coarser->Accessor();
     ParallelRangeFor(
         ZERO_SIZE, n.x, ZERO_SIZE, n.y, ZERO_SIZE, n.z,
         [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
@@ -105,7 +106,85 @@ void FDMMGUtils3::Restrict(const FDMVector3 &finer, FDMVector3 *coarser)
                             }
                         }
 
-                        (*coarser)(i, j, k) = sum;
+                        coarserAcc(i, j, k) = sum;
+                    }
+                }
+            }
+        });
+}
+
+void FDMMGUtils3::RestrictResidual(const FDMMatrix3 &a, const FDMVector3 &x,
+                                   const FDMVector3 &b, FDMVector3 *coarserB)
+{
+    assert(a.size() == x.size());
+    assert(a.size() == b.size());
+    assert(a.size().x == 2 * coarserB->size().x);
+    assert(a.size().y == 2 * coarserB->size().y);
+    assert(a.size().z == 2 * coarserB->size().z);
+
+    static const std::array<double, 4> kernel = { { 0.125, 0.375, 0.375,
+                                                    0.125 } };
+
+    const Size3 m = a.size();
+    const auto residual = [&](size_t i, size_t j, size_t k) {
+        return b(i, j, k) - a(i, j, k).center * x(i, j, k) -
+               ((i > 0) ? a(i - 1, j, k).right * x(i - 1, j, k) : 0.0) -
+               ((i + 1 < m.x) ? a(i, j, k).right * x(i + 1, j, k) : 0.0) -
+               ((j > 0) ? a(i, j - 1, k).up * x(i, j - 1, k) : 0.0) -
+               ((j + 1 < m.y) ? a(i, j, k).up * x(i, j + 1, k) : 0.0) -
+               ((k > 0) ? a(i, j, k - 1).front * x(i, j, k - 1) : 0.0) -
+               ((k + 1 < m.z) ? a(i, j, k).front * x(i, j, k + 1) : 0.0);
+    };
+
+    const Size3 n = coarserB->size();
+    ArrayAccessor3<double> coarserBAcc = coarserB->Accessor();
+    ParallelRangeFor(
+        ZERO_SIZE, n.x, ZERO_SIZE, n.y, ZERO_SIZE, n.z,
+        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
+            size_t kBegin, size_t kEnd) {
+            std::array<size_t, 4> kIndices;
+
+            for (size_t k = kBegin; k < kEnd; ++k)
+            {
+                kIndices[0] = (k > 0) ? 2 * k - 1 : 2 * k;
+                kIndices[1] = 2 * k;
+                kIndices[2] = 2 * k + 1;
+                kIndices[3] = (k + 1 < n.z) ? 2 * k + 2 : 2 * k + 1;
+
+                std::array<size_t, 4> jIndices;
+
+                for (size_t j = jBegin; j < jEnd; ++j)
+                {
+                    jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
+                    jIndices[1] = 2 * j;
+                    jIndices[2] = 2 * j + 1;
+                    jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : 2 * j + 1;
+
+                    std::array<size_t, 4> iIndices;
+                    for (size_t i = iBegin; i < iEnd; ++i)
+                    {
+                        iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
+                        iIndices[1] = 2 * i;
+                        iIndices[2] = 2 * i + 1;
+                        iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : 2 * i + 1;
+
+                        double sum = 0.0;
+                        for (size_t z = 0; z < 4; ++z)
+                        {
+                            for (size_t y = 0; y < 4; ++y)
+                            {
+                                for (size_t x2 = 0; x2 < 4; ++x2)
+                                {
+                                    double w = kernel[x2] * kernel[y] *
+                                               kernel[z];
+                                    sum += w * residual(iIndices[x2],
+                                                        jIndices[y],
+                                                        kIndices[z]);
+                                }
+                            }
+                        }
+
+                        coarserBAcc(i, j, k) = sum;
                     }
                 }
             }
@@ -123,6 +202,7 @@ void FDMMGUtils3::Correct(const FDMVector3 &coarser, FDMVector3 *finer)
     //  1/4   3/4   3/4   1/4
     // --*--|--*--|--*--|--*--
     const Size3 n = finer->size();
+    ArrayAccessor3<double> finerAcc = finer->Accessor();
     ParallelRangeFor(
         ZERO_SIZE, n.x, ZERO_SIZE, n.y, ZERO_SIZE, n.z,
         [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
@@ -199,7 +279,7 @@ void FDMMGUtils3::Correct(const FDMVector3 &coarser, FDMVector3 *finer)
                                                kWeights[z] *
                                                coarser(iIndices[x], jIndices[y],
                                                        kIndices[z]);
-                                    (*finer)(i, j, k) += w;
+                                    finerAcc(i, j, k) += w;
                                 }
                             }
                         }
@@ -208,4 +288,36 @@ void FDMMGUtils3::Correct(const FDMVector3 &coarser, FDMVector3 *finer)
             }
         });
 }
-}  // namespace CubbyFlow
\ No newline at end of file
+
+const char* FDMMGLinearSystem3::GetMemoryStatsName() const
+{
+    return "FDMMGLinearSystem3";
+}
+
+void FDMMGLinearSystem3::ReportMemoryUsage(
+    std::vector<MemoryUsageRecord>* records) const
+{
+    const auto matrixBytes = [](const FDMMGMatrix3& matrix) {
+        size_t bytes = 0;
+        for (const FDMMatrix3& level : matrix.levels)
+        {
+            const Size3 size = level.size();
+            bytes += size.x * size.y * size.z * sizeof(FDMMatrixRow3);
+        }
+        return bytes;
+    };
+    const auto vectorBytes = [](const FDMMGVector3& vector) {
+        size_t bytes = 0;
+        for (const FDMVector3& level : vector.levels)
+        {
+            const Size3 size = level.size();
+            bytes += size.x * size.y * size.z * sizeof(double);
+        }
+        return bytes;
+    };
+
+    records->push_back(MemoryUsageRecord{ "A", matrixBytes(A) });
+    records->push_back(MemoryUsageRecord{ "x", vectorBytes(x) });
+    records->push_back(MemoryUsageRecord{ "b", vectorBytes(b) });
+}
+}  // namespace CubbyFlow
@@ -9,6 +9,7 @@
 // property of any third parties.
 
 #include <Core/FDM/FDMUtils.hpp>
+#include <Core/Utils/Parallel.hpp>
 
 namespace CubbyFlow
 {
@@ -24,7 +25,9 @@ Vector2D Gradient2(const ConstArrayAccessor2<double>& data,
     const double down = data(i, (j > 0) ? j - 1 : j);
     const double up = data(i, (j + 1 < ds.y) ? j + 1 : j);
 
-    return 0.5 * Vector2D{ right - left, up - down } / gridSpacing;
+    const Vector2D halfInvGridSpacing = 0.5 / gridSpacing;
+
+    return Vector2D{ right - left, up - down } * halfInvGridSpacing;
 }
 
 std::array<Vector2D, 2> Gradient2(const ConstArrayAccessor2<Vector2D>& data,
@@ -40,9 +43,13 @@ std::array<Vector2D, 2> Gradient2(const ConstArrayAccessor2<Vector2D>& data,
     const Vector2D down = data(i, (j > 0) ? j - 1 : j);
     const Vector2D up = data(i, (j + 1 < ds.y) ? j + 1 : j);
 
+    const Vector2D halfInvGridSpacing = 0.5 / gridSpacing;
+
     std::array<Vector2D, 2> result;
-    result[0] = 0.5 * Vector2D{ right.x - left.x, up.x - down.x } / gridSpacing;
-    result[1] = 0.5 * Vector2D{ right.y - left.y, up.y - down.y } / gridSpacing;
+    result[0] =
+        Vector2D{ right.x - left.x, up.x - down.x } * halfInvGridSpacing;
+    result[1] =
+        Vector2D{ right.y - left.y, up.y - down.y } * halfInvGridSpacing;
 
     return result;
 }
@@ -61,8 +68,10 @@ Vector3D Gradient3(const ConstArrayAccessor3<double>& data,
     const double back = data(i, j, (k > 0) ? k - 1 : k);
     const double front = data(i, j, (k + 1 < ds.z) ? k + 1 : k);
 
-    return 0.5 * Vector3D{ right - left, up - down, front - back } /
-           gridSpacing;
+    const Vector3D halfInvGridSpacing = 0.5 / gridSpacing;
+
+    return Vector3D{ right - left, up - down, front - back } *
+           halfInvGridSpacing;
 }
 
 std::array<Vector3D, 3> Gradient3(const ConstArrayAccessor3<Vector3D>& data,
@@ -80,16 +89,15 @@ std::array<Vector3D, 3> Gradient3(const ConstArrayAccessor3<Vector3D>& data,
     const Vector3D back = data(i, j, (k > 0) ? k - 1 : k);
     const Vector3D front = data(i, j, (k + 1 < ds.z) ? k + 1 : k);
 
+    const Vector3D halfInvGridSpacing = 0.5 / gridSpacing;
+
     std::array<Vector3D, 3> result;
-    result[0] = 0.5 *
-                Vector3D{ right.x - left.x, up.x - down.x, front.x - back.x } /
-                gridSpacing;
-    result[1] = 0.5 *
-                Vector3D{ right.y - left.y, up.y - down.y, front.y - back.y } /
-                gridSpacing;
-    result[2] = 0.5 *
-                Vector3D{ right.z - left.z, up.z - down.z, front.z - back.z } /
-                gridSpacing;
+    result[0] = Vector3D{ right.x - left.x, up.x - down.x, front.x - back.x } *
+                halfInvGridSpacing;
+    result[1] = Vector3D{ right.y - left.y, up.y - down.y, front.y - back.y } *
+                halfInvGridSpacing;
+    result[2] = Vector3D{ right.z - left.z, up.z - down.z, front.z - back.z } *
+                halfInvGridSpacing;
 
     return result;
 }
@@ -122,8 +130,10 @@ double Laplacian2(const ConstArrayAccessor2<double>& data,
         dUp = data(i, j + 1) - center;
     }
 
-    return (dRight - dLeft) / Square(gridSpacing.x) +
-           (dUp - dDown) / Square(gridSpacing.y);
+    const Vector2D invSqGridSpacing = 1.0 / (gridSpacing * gridSpacing);
+
+    return (dRight - dLeft) * invSqGridSpacing.x +
+           (dUp - dDown) * invSqGridSpacing.y;
 }
 
 Vector2D Laplacian2(const ConstArrayAccessor2<Vector2D>& data,
@@ -154,8 +164,10 @@ Vector2D Laplacian2(const ConstArrayAccessor2<Vector2D>& data,
         dUp = data(i, j + 1) - center;
     }
 
-    return (dRight - dLeft) / Square(gridSpacing.x) +
-           (dUp - dDown) / Square(gridSpacing.y);
+    const Vector2D invSqGridSpacing = 1.0 / (gridSpacing * gridSpacing);
+
+    return (dRight - dLeft) * invSqGridSpacing.x +
+           (dUp - dDown) * invSqGridSpacing.y;
 }
 
 double Laplacian3(const ConstArrayAccessor3<double>& data,
@@ -196,9 +208,11 @@ double Laplacian3(const ConstArrayAccessor3<double>& data,
         dFront = data(i, j, k + 1) - center;
     }
 
-    return (dRight - dLeft) / Square(gridSpacing.x) +
-           (dUp - dDown) / Square(gridSpacing.y) +
-           (dFront - dback) / Square(gridSpacing.z);
+    const Vector3D invSqGridSpacing = 1.0 / (gridSpacing * gridSpacing);
+
+    return (dRight - dLeft) * invSqGridSpacing.x +
+           (dUp - dDown) * invSqGridSpacing.y +
+           (dFront - dback) * invSqGridSpacing.z;
 }
 
 Vector3D Laplacian3(const ConstArrayAccessor3<Vector3D>& data,
@@ -238,8 +252,108 @@ Vector3D Laplacian3(const ConstArrayAccessor3<Vector3D>& data,
         dFront = data(i, j, k + 1) - center;
     }
 
-    return (dRight - dLeft) / Square(gridSpacing.x) +
-           (dUp - dDown) / Square(gridSpacing.y) +
-           (dFront - dBack) / Square(gridSpacing.z);
+    const Vector3D invSqGridSpacing = 1.0 / (gridSpacing * gridSpacing);
+
+    return (dRight - dLeft) * invSqGridSpacing.x +
+           (dUp - dDown) * invSqGridSpacing.y +
+           (dFront - dBack) * invSqGridSpacing.z;
+}
+
+void GradientGrid3(const ConstArrayAccessor3<double>& data,
+                   const Vector3D& gridSpacing, ArrayAccessor3<Vector3D> result)
+{
+    const Size3 ds = data.size();
+
+    assert(result.size() == ds);
+
+    // Hoisted once per kernel; the per-point fallback derives the identical
+    // constant, so interior and boundary cells stay bitwise-consistent.
+    const Vector3D halfInvGridSpacing = 0.5 / gridSpacing;
+
+    ParallelFor(ZERO_SIZE, ds.z, [&](size_t k) {
+        for (size_t j = 0; j < ds.y; ++j)
+        {
+            if (j == 0 || j + 1 == ds.y || k == 0 || k + 1 == ds.z)
+            {
+                for (size_t i = 0; i < ds.x; ++i)
+                {
+                    result(i, j, k) = Gradient3(data, gridSpacing, i, j, k);
+                }
+                continue;
+            }
+
+            result(0, j, k) = Gradient3(data, gridSpacing, 0, j, k);
+
+            for (size_t i = 1; i + 1 < ds.x; ++i)
+            {
+                const double left = data(i - 1, j, k);
+                const double right = data(i + 1, j, k);
+                const double down = data(i, j - 1, k);
+                const double up = data(i, j + 1, k);
+                const double back = data(i, j, k - 1);
+                const double front = data(i, j, k + 1);
+
+                result(i, j, k) =
+                    Vector3D{ right - left, up - down, front - back } *
+                    halfInvGridSpacing;
+            }
+
+            if (ds.x > 1)
+            {
+                result(ds.x - 1, j, k) =
+                    Gradient3(data, gridSpacing, ds.x - 1, j, k);
+            }
+        }
+    });
+}
+
+void LaplacianGrid3(const ConstArrayAccessor3<double>& data,
+                    const Vector3D& gridSpacing, ArrayAccessor3<double> result)
+{
+    const Size3 ds = data.size();
+
+    assert(result.size() == ds);
+
+    // Hoisted once per kernel; the per-point fallback derives the identical
+    // constant, so interior and boundary cells stay bitwise-consistent.
+    const Vector3D invSqGridSpacing = 1.0 / (gridSpacing * gridSpacing);
+
+    ParallelFor(ZERO_SIZE, ds.z, [&](size_t k) {
+        for (size_t j = 0; j < ds.y; ++j)
+        {
+            if (j == 0 || j + 1 == ds.y || k == 0 || k + 1 == ds.z)
+            {
+                for (size_t i = 0; i < ds.x; ++i)
+                {
+                    result(i, j, k) = Laplacian3(data, gridSpacing, i, j, k);
+                }
+                continue;
+            }
+
+            result(0, j, k) = Laplacian3(data, gridSpacing, 0, j, k);
+
+            for (size_t i = 1; i + 1 < ds.x; ++i)
+            {
+                const double center = data(i, j, k);
+
+                const double dLeft = center - data(i - 1, j, k);
+                const double dRight = data(i + 1, j, k) - center;
+                const double dDown = center - data(i, j - 1, k);
+                const double dUp = data(i, j + 1, k) - center;
+                const double dBack = center - data(i, j, k - 1);
+                const double dFront = data(i, j, k + 1) - center;
+
+                result(i, j, k) = (dRight - dLeft) * invSqGridSpacing.x +
+                                  (dUp - dDown) * invSqGridSpacing.y +
+                                  (dFront - dBack) * invSqGridSpacing.z;
+            }
+
+            if (ds.x > 1)
+            {
+                result(ds.x - 1, j, k) =
+                    Laplacian3(data, gridSpacing, ds.x - 1, j, k);
+            }
+        }
+    });
 }
 }  // namespace CubbyFlow
\ No newline at end of file
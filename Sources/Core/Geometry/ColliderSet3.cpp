@@ -11,8 +11,18 @@
 #include <Core/Geometry/ColliderSet3.hpp>
 #include <Core/Geometry/SurfaceSet3.hpp>
 
+#include <cmath>
+
 namespace CubbyFlow
 {
+namespace
+{
+// Number of broadphase hash cells per axis. Cell indices wrap around this
+// resolution, so distant cells may share a bucket; that only adds extra
+// candidates and never drops one.
+constexpr ssize_t BROADPHASE_RESOLUTION = 32;
+}  // namespace
+
 ColliderSet3::ColliderSet3() : ColliderSet3(std::vector<Collider3Ptr>())
 {
     // Do nothing
@@ -32,6 +42,62 @@ Vector3D ColliderSet3::VelocityAt(const Vector3D& point) const
     size_t closestCollider = std::numeric_limits<size_t>::max();
     double closestDist = std::numeric_limits<double>::max();
 
+    if (!m_broadphaseBuckets.empty())
+    {
+        // Any collider whose bounding box does not overlap the 3x3x3 cell
+        // block around the point is farther than one cell size away, so
+        // testing only the hashed candidates is exact whenever the best
+        // candidate is within a cell size.
+        const auto x =
+            static_cast<ssize_t>(std::floor(point.x / m_broadphaseCellSize));
+        const auto y =
+            static_cast<ssize_t>(std::floor(point.y / m_broadphaseCellSize));
+        const auto z =
+            static_cast<ssize_t>(std::floor(point.z / m_broadphaseCellSize));
+
+        for (ssize_t k = z - 1; k <= z + 1; ++k)
+        {
+            for (ssize_t j = y - 1; j <= y + 1; ++j)
+            {
+                for (ssize_t i = x - 1; i <= x + 1; ++i)
+                {
+                    for (const size_t colliderIndex :
+                         m_broadphaseBuckets[GetBroadphaseKey(i, j, k)])
+                    {
+                        const double dist =
+                            m_colliders[colliderIndex]
+                                ->GetSurface()
+                                ->ClosestDistance(point);
+
+                        if (dist < closestDist)
+                        {
+                            closestDist = dist;
+                            closestCollider = colliderIndex;
+                        }
+                    }
+                }
+            }
+        }
+
+        for (const size_t colliderIndex : m_unboundedColliders)
+        {
+            const double dist =
+                m_colliders[colliderIndex]->GetSurface()->ClosestDistance(
+                    point);
+
+            if (dist < closestDist)
+            {
+                closestDist = dist;
+                closestCollider = colliderIndex;
+            }
+        }
+
+        if (closestDist <= m_broadphaseCellSize)
+        {
+            return m_colliders[closestCollider]->VelocityAt(point);
+        }
+    }
+
     for (size_t i = 0; i < m_colliders.size(); ++i)
     {
         const double dist = m_colliders[i]->GetSurface()->ClosestDistance(point);
@@ -51,11 +117,21 @@ Vector3D ColliderSet3::VelocityAt(const Vector3D& point) const
     return Vector3D();
 }
 
+void ColliderSet3::Update(double currentTimeInSeconds,
+                          double timeIntervalInSeconds)
+{
+    Collider3::Update(currentTimeInSeconds, timeIntervalInSeconds);
+
+    RebuildBroadphase();
+}
+
 void ColliderSet3::AddCollider(const Collider3Ptr& collider)
 {
     auto surfaceSet = std::dynamic_pointer_cast<SurfaceSet3>(GetSurface());
     m_colliders.push_back(collider);
     surfaceSet->AddSurface(collider->GetSurface());
+
+    RebuildBroadphase();
 }
 
 size_t ColliderSet3::NumberOfColliders() const
@@ -68,6 +144,105 @@ Collider3Ptr ColliderSet3::Collider(size_t i) const
     return m_colliders[i];
 }
 
+void ColliderSet3::RebuildBroadphase()
+{
+    for (auto& bucket : m_broadphaseBuckets)
+    {
+        bucket.clear();
+    }
+    m_unboundedColliders.clear();
+
+    // Size the cells to the largest bounded collider so that every bounding
+    // box overlaps at most two cells per axis.
+    double maxEdge = 0.0;
+    size_t numBounded = 0;
+
+    for (const auto& collider : m_colliders)
+    {
+        const Surface3Ptr& surface = collider->GetSurface();
+        if (!surface->IsValidGeometry() || !surface->IsBounded())
+        {
+            continue;
+        }
+
+        const BoundingBox3D box = surface->BoundingBox();
+        maxEdge = std::max({ maxEdge, box.GetWidth(), box.GetHeight(),
+                             box.GetDepth() });
+        ++numBounded;
+    }
+
+    if (numBounded < 2 || maxEdge <= 0.0)
+    {
+        m_broadphaseBuckets.clear();
+        return;
+    }
+
+    m_broadphaseCellSize = maxEdge;
+    m_broadphaseBuckets.resize(BROADPHASE_RESOLUTION * BROADPHASE_RESOLUTION *
+                               BROADPHASE_RESOLUTION);
+
+    for (size_t i = 0; i < m_colliders.size(); ++i)
+    {
+        const Surface3Ptr& surface = m_colliders[i]->GetSurface();
+        if (!surface->IsValidGeometry() || !surface->IsBounded())
+        {
+            m_unboundedColliders.push_back(i);
+            continue;
+        }
+
+        const BoundingBox3D box = surface->BoundingBox();
+        const auto lowerX = static_cast<ssize_t>(
+            std::floor(box.lowerCorner.x / m_broadphaseCellSize));
+        const auto lowerY = static_cast<ssize_t>(
+            std::floor(box.lowerCorner.y / m_broadphaseCellSize));
+        const auto lowerZ = static_cast<ssize_t>(
+            std::floor(box.lowerCorner.z / m_broadphaseCellSize));
+        const auto upperX = static_cast<ssize_t>(
+            std::floor(box.upperCorner.x / m_broadphaseCellSize));
+        const auto upperY = static_cast<ssize_t>(
+            std::floor(box.upperCorner.y / m_broadphaseCellSize));
+        const auto upperZ = static_cast<ssize_t>(
+            std::floor(box.upperCorner.z / m_broadphaseCellSize));
+
+        for (ssize_t z = lowerZ; z <= upperZ; ++z)
+        {
+            for (ssize_t y = lowerY; y <= upperY; ++y)
+            {
+                for (ssize_t x = lowerX; x <= upperX; ++x)
+                {
+                    m_broadphaseBuckets[GetBroadphaseKey(x, y, z)].push_back(i);
+                }
+            }
+        }
+    }
+}
+
+size_t ColliderSet3::GetBroadphaseKey(ssize_t x, ssize_t y, ssize_t z) const
+{
+    ssize_t wrappedX = x % BROADPHASE_RESOLUTION;
+    ssize_t wrappedY = y % BROADPHASE_RESOLUTION;
+    ssize_t wrappedZ = z % BROADPHASE_RESOLUTION;
+
+    if (wrappedX < 0)
+    {
+        wrappedX += BROADPHASE_RESOLUTION;
+    }
+
+    if (wrappedY < 0)
+    {
+        wrappedY += BROADPHASE_RESOLUTION;
+    }
+
+    if (wrappedZ < 0)
+    {
+        wrappedZ += BROADPHASE_RESOLUTION;
+    }
+
+    return static_cast<size_t>(
+        (wrappedZ * BROADPHASE_RESOLUTION + wrappedY) * BROADPHASE_RESOLUTION +
+        wrappedX);
+}
+
 ColliderSet3::Builder ColliderSet3::GetBuilder()
 {
     return Builder();
@@ -0,0 +1,265 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Geometry/CompactPointKdTree3.hpp>
+#include <Core/Utils/Constants.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace CubbyFlow
+{
+void CompactPointKdTree3::Build(const ConstArrayAccessor1<Vector3D>& points)
+{
+    m_nodes.clear();
+    m_pointsX.clear();
+    m_pointsY.clear();
+    m_pointsZ.clear();
+    m_itemIndices.clear();
+
+    const size_t n = points.size();
+    if (n == 0)
+    {
+        return;
+    }
+
+    m_nodes.reserve(2 * n / MAX_LEAF_SIZE + 1);
+    m_pointsX.reserve(n);
+    m_pointsY.reserve(n);
+    m_pointsZ.reserve(n);
+    m_itemIndices.reserve(n);
+
+    std::vector<size_t> itemIndices(n);
+    std::iota(itemIndices.begin(), itemIndices.end(), ZERO_SIZE);
+
+    Build(itemIndices.data(), n, points);
+}
+
+size_t CompactPointKdTree3::Build(size_t* itemIndices, size_t nItems,
+                                  const ConstArrayAccessor1<Vector3D>& points)
+{
+    const size_t nodeIndex = m_nodes.size();
+    m_nodes.emplace_back();
+
+    if (nItems <= MAX_LEAF_SIZE)
+    {
+        const size_t begin = m_itemIndices.size();
+
+        for (size_t i = 0; i < nItems; ++i)
+        {
+            const Vector3D& pt = points[itemIndices[i]];
+
+            m_pointsX.push_back(pt.x);
+            m_pointsY.push_back(pt.y);
+            m_pointsZ.push_back(pt.z);
+            m_itemIndices.push_back(itemIndices[i]);
+        }
+
+        m_nodes[nodeIndex].begin = begin;
+        m_nodes[nodeIndex].end = m_itemIndices.size();
+
+        return nodeIndex;
+    }
+
+    // Split along the axis of largest extent at the median
+    Vector3D lower = points[itemIndices[0]];
+    Vector3D upper = lower;
+
+    for (size_t i = 1; i < nItems; ++i)
+    {
+        const Vector3D& pt = points[itemIndices[i]];
+
+        lower = Min(lower, pt);
+        upper = Max(upper, pt);
+    }
+
+    const Vector3D extent = upper - lower;
+    size_t axis = 0;
+    if (extent.y > extent.x)
+    {
+        axis = 1;
+    }
+    if (extent.z > extent[axis])
+    {
+        axis = 2;
+    }
+
+    const size_t mid = nItems / 2;
+    std::nth_element(itemIndices, itemIndices + mid, itemIndices + nItems,
+                     [&points, axis](size_t a, size_t b) {
+                         return points[a][axis] < points[b][axis];
+                     });
+
+    const double split = points[itemIndices[mid]][axis];
+
+    // Preorder layout: the left child is built right after this node, so
+    // only the right child index needs to be stored.
+    Build(itemIndices, mid, points);
+    const size_t rightChild = Build(itemIndices + mid, nItems - mid, points);
+
+    m_nodes[nodeIndex].flags = axis;
+    m_nodes[nodeIndex].child = rightChild;
+    m_nodes[nodeIndex].split = split;
+
+    return nodeIndex;
+}
+
+void CompactPointKdTree3::ForEachNearbyPoint(
+    const Vector3D& origin, double radius,
+    const std::function<void(size_t, const Vector3D&)>& callback) const
+{
+    if (m_nodes.empty())
+    {
+        return;
+    }
+
+    const double radiusSquared = radius * radius;
+
+    size_t todo[128];
+    size_t todoPos = 0;
+    size_t nodeIndex = 0;
+
+    while (true)
+    {
+        const Node& node = m_nodes[nodeIndex];
+
+        if (node.flags == 3)
+        {
+            // Contiguous structure-of-arrays scan over the leaf points
+            for (size_t i = node.begin; i < node.end; ++i)
+            {
+                const double dx = m_pointsX[i] - origin.x;
+                const double dy = m_pointsY[i] - origin.y;
+                const double dz = m_pointsZ[i] - origin.z;
+                const double distanceSquared = dx * dx + dy * dy + dz * dz;
+
+                if (distanceSquared <= radiusSquared)
+                {
+                    callback(m_itemIndices[i],
+                             Vector3D{ m_pointsX[i], m_pointsY[i],
+                                       m_pointsZ[i] });
+                }
+            }
+
+            if (todoPos > 0)
+            {
+                --todoPos;
+                nodeIndex = todo[todoPos];
+            }
+            else
+            {
+                break;
+            }
+        }
+        else
+        {
+            const double signedDistance = origin[node.flags] - node.split;
+            const size_t nearChild =
+                (signedDistance <= 0.0) ? nodeIndex + 1 : node.child;
+            const size_t farChild =
+                (signedDistance <= 0.0) ? node.child : nodeIndex + 1;
+
+            if (signedDistance * signedDistance <= radiusSquared)
+            {
+                todo[todoPos] = farChild;
+                ++todoPos;
+            }
+
+            nodeIndex = nearChild;
+        }
+    }
+}
+
+bool CompactPointKdTree3::HasNearbyPoint(const Vector3D& origin,
+                                         double radius) const
+{
+    if (m_nodes.empty())
+    {
+        return false;
+    }
+
+    const double radiusSquared = radius * radius;
+
+    size_t todo[128];
+    size_t todoPos = 0;
+    size_t nodeIndex = 0;
+
+    while (true)
+    {
+        const Node& node = m_nodes[nodeIndex];
+
+        if (node.flags == 3)
+        {
+            for (size_t i = node.begin; i < node.end; ++i)
+            {
+                const double dx = m_pointsX[i] - origin.x;
+                const double dy = m_pointsY[i] - origin.y;
+                const double dz = m_pointsZ[i] - origin.z;
+
+                if (dx * dx + dy * dy + dz * dz <= radiusSquared)
+                {
+                    return true;
+                }
+            }
+
+            if (todoPos > 0)
+            {
+                --todoPos;
+                nodeIndex = todo[todoPos];
+            }
+            else
+            {
+                break;
+            }
+        }
+        else
+        {
+            const double signedDistance = origin[node.flags] - node.split;
+            const size_t nearChild =
+                (signedDistance <= 0.0) ? nodeIndex + 1 : node.child;
+            const size_t farChild =
+                (signedDistance <= 0.0) ? node.child : nodeIndex + 1;
+
+            if (signedDistance * signedDistance <= radiusSquared)
+            {
+                todo[todoPos] = farChild;
+                ++todoPos;
+            }
+
+            nodeIndex = nearChild;
+        }
+    }
+
+    return false;
+}
+
+size_t CompactPointKdTree3::GetNumberOfPoints() const
+{
+    return m_itemIndices.size();
+}
+
+void CompactPointKdTree3::GetPoints(std::vector<Vector3D>* points) const
+{
+    points->resize(m_itemIndices.size());
+
+    for (size_t i = 0; i < m_itemIndices.size(); ++i)
+    {
+        (*points)[m_itemIndices[i]] =
+            Vector3D{ m_pointsX[i], m_pointsY[i], m_pointsZ[i] };
+    }
+}
+size_t CompactPointKdTree3::GetMemoryUsage() const
+{
+    return m_nodes.size() * sizeof(Node) +
+           (m_pointsX.size() + m_pointsY.size() + m_pointsZ.size()) *
+               sizeof(double) +
+           m_itemIndices.size() * sizeof(size_t);
+}
+}  // namespace CubbyFlow
@@ -9,8 +9,11 @@
 // property of any third parties.
 
 #include <Core/Geometry/CustomImplicitSurface3.hpp>
+#include <Core/Math/MathUtils.hpp>
 #include <Core/Utils/LevelSetUtils.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 namespace CubbyFlow
@@ -104,12 +107,184 @@ double CustomImplicitSurface3::SignedDistanceLocal(
 {
     if (m_func)
     {
+        if (m_cacheGridSpacing > 0.0)
+        {
+            double cached;
+            if (TryCachedSignedDistance(otherPoint, &cached))
+            {
+                return cached;
+            }
+        }
+
         return m_func(otherPoint);
     }
 
     return std::numeric_limits<double>::max();
 }
 
+void CustomImplicitSurface3::SetEvaluationCache(double cacheGridSpacing,
+                                                double refinementBandWidth)
+{
+    m_cacheGridSpacing = std::max(cacheGridSpacing, 0.0);
+    m_cacheRefinementBandWidth = std::max(refinementBandWidth, 0.0);
+    m_cacheValues.clear();
+    m_cacheTileStates.reset();
+
+    const double width = m_domain.GetWidth();
+    const double height = m_domain.GetHeight();
+    const double depth = m_domain.GetDepth();
+
+    if (m_cacheGridSpacing <= 0.0 || !m_func || width <= 0.0 ||
+        height <= 0.0 || depth <= 0.0)
+    {
+        m_cacheGridSpacing = 0.0;
+        return;
+    }
+
+    const auto cellCount = [this](double length) {
+        return std::max<size_t>(
+            static_cast<size_t>(std::ceil(length / m_cacheGridSpacing)), 1);
+    };
+
+    m_cacheNodeCount = Size3{ cellCount(width) + 1, cellCount(height) + 1,
+                              cellCount(depth) + 1 };
+    m_cacheActualSpacing =
+        Vector3D{ width / static_cast<double>(m_cacheNodeCount.x - 1),
+                  height / static_cast<double>(m_cacheNodeCount.y - 1),
+                  depth / static_cast<double>(m_cacheNodeCount.z - 1) };
+    m_cacheTileCount =
+        Size3{ (m_cacheNodeCount.x + CACHE_TILE_SIZE - 1) / CACHE_TILE_SIZE,
+               (m_cacheNodeCount.y + CACHE_TILE_SIZE - 1) / CACHE_TILE_SIZE,
+               (m_cacheNodeCount.z + CACHE_TILE_SIZE - 1) / CACHE_TILE_SIZE };
+
+    m_cacheValues.resize(m_cacheNodeCount.x * m_cacheNodeCount.y *
+                         m_cacheNodeCount.z);
+    m_cacheTileStates = std::make_unique<std::atomic<int>[]>(
+        m_cacheTileCount.x * m_cacheTileCount.y * m_cacheTileCount.z);
+}
+
+bool CustomImplicitSurface3::EnsureCacheTile(size_t tileX, size_t tileY,
+                                             size_t tileZ) const
+{
+    std::atomic<int>& state =
+        m_cacheTileStates[(tileZ * m_cacheTileCount.y + tileY) *
+                              m_cacheTileCount.x +
+                          tileX];
+
+    // Double-checked claim: 0 = empty, 1 = being filled, 2 = ready. A
+    // thread that loses the claim does not wait for the winner; the caller
+    // falls back to exact evaluation until the tile is published.
+    if (state.load(std::memory_order_acquire) == 2)
+    {
+        return true;
+    }
+
+    int expected = 0;
+    if (state.compare_exchange_strong(expected, 1, std::memory_order_acq_rel))
+    {
+        const size_t beginI = tileX * CACHE_TILE_SIZE;
+        const size_t beginJ = tileY * CACHE_TILE_SIZE;
+        const size_t beginK = tileZ * CACHE_TILE_SIZE;
+        const size_t endI =
+            std::min(beginI + CACHE_TILE_SIZE, m_cacheNodeCount.x);
+        const size_t endJ =
+            std::min(beginJ + CACHE_TILE_SIZE, m_cacheNodeCount.y);
+        const size_t endK =
+            std::min(beginK + CACHE_TILE_SIZE, m_cacheNodeCount.z);
+
+        for (size_t k = beginK; k < endK; ++k)
+        {
+            for (size_t j = beginJ; j < endJ; ++j)
+            {
+                for (size_t i = beginI; i < endI; ++i)
+                {
+                    const Vector3D pt =
+                        m_domain.lowerCorner +
+                        Vector3D{ static_cast<double>(i) *
+                                      m_cacheActualSpacing.x,
+                                  static_cast<double>(j) *
+                                      m_cacheActualSpacing.y,
+                                  static_cast<double>(k) *
+                                      m_cacheActualSpacing.z };
+                    m_cacheValues[(k * m_cacheNodeCount.y + j) *
+                                      m_cacheNodeCount.x +
+                                  i] = m_func(pt);
+                }
+            }
+        }
+
+        state.store(2, std::memory_order_release);
+        return true;
+    }
+
+    return state.load(std::memory_order_acquire) == 2;
+}
+
+bool CustomImplicitSurface3::TryCachedSignedDistance(const Vector3D& otherPoint,
+                                                     double* result) const
+{
+    if (!m_domain.Contains(otherPoint))
+    {
+        return false;
+    }
+
+    const Vector3D offset = otherPoint - m_domain.lowerCorner;
+    const size_t i = std::min(
+        static_cast<size_t>(std::max(offset.x / m_cacheActualSpacing.x, 0.0)),
+        m_cacheNodeCount.x - 2);
+    const size_t j = std::min(
+        static_cast<size_t>(std::max(offset.y / m_cacheActualSpacing.y, 0.0)),
+        m_cacheNodeCount.y - 2);
+    const size_t k = std::min(
+        static_cast<size_t>(std::max(offset.z / m_cacheActualSpacing.z, 0.0)),
+        m_cacheNodeCount.z - 2);
+
+    // The eight corner nodes can live in up to eight different tiles.
+    for (size_t dk = 0; dk < 2; ++dk)
+    {
+        for (size_t dj = 0; dj < 2; ++dj)
+        {
+            for (size_t di = 0; di < 2; ++di)
+            {
+                if (!EnsureCacheTile((i + di) / CACHE_TILE_SIZE,
+                                     (j + dj) / CACHE_TILE_SIZE,
+                                     (k + dk) / CACHE_TILE_SIZE))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    const auto value = [&](size_t ii, size_t jj, size_t kk) {
+        return m_cacheValues[(kk * m_cacheNodeCount.y + jj) *
+                                 m_cacheNodeCount.x +
+                             ii];
+    };
+
+    const double fx =
+        offset.x / m_cacheActualSpacing.x - static_cast<double>(i);
+    const double fy =
+        offset.y / m_cacheActualSpacing.y - static_cast<double>(j);
+    const double fz =
+        offset.z / m_cacheActualSpacing.z - static_cast<double>(k);
+
+    const double interpolated = TriLerp(
+        value(i, j, k), value(i + 1, j, k), value(i, j + 1, k),
+        value(i + 1, j + 1, k), value(i, j, k + 1), value(i + 1, j, k + 1),
+        value(i, j + 1, k + 1), value(i + 1, j + 1, k + 1), fx, fy, fz);
+
+    // Near the surface the coarse samples are not accurate enough; stay
+    // exact within the refinement band.
+    if (std::fabs(interpolated) <= m_cacheRefinementBandWidth)
+    {
+        return false;
+    }
+
+    *result = interpolated;
+    return true;
+}
+
 Vector3D CustomImplicitSurface3::ClosestNormalLocal(
     const Vector3D& otherPoint) const
 {
@@ -239,23 +414,48 @@ CustomImplicitSurface3::Builder::WithMaxNumberOfIterations(unsigned int numIter)
     return *this;
 }
 
+CustomImplicitSurface3::Builder&
+CustomImplicitSurface3::Builder::WithEvaluationCache(double cacheGridSpacing,
+                                                     double refinementBandWidth)
+{
+    m_cacheGridSpacing = cacheGridSpacing;
+    m_cacheRefinementBandWidth = refinementBandWidth;
+    return *this;
+}
+
 CustomImplicitSurface3 CustomImplicitSurface3::Builder::Build() const
 {
-    return CustomImplicitSurface3{ m_func,
-                                   m_domain,
-                                   m_resolution,
-                                   m_rayMarchingResolution,
-                                   m_maxNumberOfIterations,
-                                   m_transform,
-                                   m_isNormalFlipped };
+    CustomImplicitSurface3 surface{ m_func,
+                                    m_domain,
+                                    m_resolution,
+                                    m_rayMarchingResolution,
+                                    m_maxNumberOfIterations,
+                                    m_transform,
+                                    m_isNormalFlipped };
+
+    if (m_cacheGridSpacing > 0.0)
+    {
+        surface.SetEvaluationCache(m_cacheGridSpacing,
+                                   m_cacheRefinementBandWidth);
+    }
+
+    return surface;
 }
 
 CustomImplicitSurface3Ptr CustomImplicitSurface3::Builder::MakeShared() const
 {
-    return std::shared_ptr<CustomImplicitSurface3>(
+    auto surface = std::shared_ptr<CustomImplicitSurface3>(
         new CustomImplicitSurface3{
             m_func, m_domain, m_resolution, m_rayMarchingResolution,
             m_maxNumberOfIterations, m_transform, m_isNormalFlipped },
         [](CustomImplicitSurface3* obj) { delete obj; });
+
+    if (m_cacheGridSpacing > 0.0)
+    {
+        surface->SetEvaluationCache(m_cacheGridSpacing,
+                                    m_cacheRefinementBandWidth);
+    }
+
+    return surface;
 }
 }  // namespace CubbyFlow
\ No newline at end of file
@@ -26,6 +26,48 @@ double ImplicitSurface3::SignedDistance(const Vector3D& otherPoint) const
     return (isNormalFlipped) ? -sd : sd;
 }
 
+void ImplicitSurface3::SignedDistance(
+    const ConstArrayAccessor1<Vector3D>& points,
+    ArrayAccessor1<double> results) const
+{
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        results[i] = SignedDistance(points[i]);
+    }
+}
+
+Vector3D ImplicitSurface3::Gradient(const Vector3D& otherPoint) const
+{
+    // Step size for the finite-difference fallback; small enough for
+    // collision normals, large enough to stay clear of cancellation.
+    constexpr double STEP = 1.0e-4;
+
+    const double left =
+        SignedDistance(otherPoint - Vector3D{ 0.5 * STEP, 0.0, 0.0 });
+    const double right =
+        SignedDistance(otherPoint + Vector3D{ 0.5 * STEP, 0.0, 0.0 });
+    const double bottom =
+        SignedDistance(otherPoint - Vector3D{ 0.0, 0.5 * STEP, 0.0 });
+    const double top =
+        SignedDistance(otherPoint + Vector3D{ 0.0, 0.5 * STEP, 0.0 });
+    const double back =
+        SignedDistance(otherPoint - Vector3D{ 0.0, 0.0, 0.5 * STEP });
+    const double front =
+        SignedDistance(otherPoint + Vector3D{ 0.0, 0.0, 0.5 * STEP });
+
+    return Vector3D{ (right - left) / STEP, (top - bottom) / STEP,
+                     (front - back) / STEP };
+}
+
+void ImplicitSurface3::Gradient(const ConstArrayAccessor1<Vector3D>& points,
+                                ArrayAccessor1<Vector3D> results) const
+{
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        results[i] = Gradient(points[i]);
+    }
+}
+
 double ImplicitSurface3::ClosestDistanceLocal(const Vector3D& otherPoint) const
 {
     return std::fabs(SignedDistanceLocal(otherPoint));
@@ -340,7 +340,9 @@ void ImplicitSurfaceSet2::BuildBVH() const
             }
         }
 
-        m_bvh.Build(surfs, bounds);
+        // The set is rebuilt rarely and queried often, so spend the
+        // extra build time on a SAH-optimized tree.
+        m_bvh.BuildSAH(surfs, bounds);
         m_bvhInvalidated = false;
     }
 }
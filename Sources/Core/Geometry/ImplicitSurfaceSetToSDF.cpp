@@ -0,0 +1,288 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Geometry/ImplicitSurfaceSetToSDF.hpp>
+#include <Core/Geometry/Octree.hpp>
+#include <Core/Geometry/Point3.hpp>
+#include <Core/Geometry/Size3.hpp>
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/Parallel.hpp>
+#include <Core/Vector/Vector3.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace CubbyFlow
+{
+namespace
+{
+// Descent stops refining an octant when no extent exceeds this many cells;
+// cells of such leaves near the interface are evaluated individually.
+constexpr size_t LEAF_EXTENT = 4;
+
+//! Grid region classified as provably free of zero crossings. Every cell is
+//! filled with a distance bound derived from the region-center distance.
+struct FarRegion
+{
+    Point3UI begin;
+    Point3UI end;
+    Vector3D center;
+    double centerSD;
+};
+
+//! Grid region near the interface. Every cell is evaluated against the
+//! culled candidate surfaces (indices into the bounded surface list).
+struct NearRegion
+{
+    Point3UI begin;
+    Point3UI end;
+    std::vector<size_t> candidates;
+};
+
+struct DescentContext
+{
+    const ImplicitSurfaceSet3& surfaceSet;
+    ScalarGrid3::DataPositionFunc pos;
+    double bandwidth = 0.0;
+
+    std::vector<ImplicitSurface3Ptr> bounded;
+    std::vector<BoundingBox3D> boundedBounds;
+    std::vector<ImplicitSurface3Ptr> unbounded;
+    Octree<size_t> octree;
+
+    std::vector<char> marks;
+    std::vector<FarRegion> farRegions;
+    std::vector<NearRegion> nearRegions;
+};
+
+void Descend(DescentContext& ctx, const Point3UI& begin, const Point3UI& end)
+{
+    const Vector3D lower = ctx.pos(begin.x, begin.y, begin.z);
+    const Vector3D upper = ctx.pos(end.x - 1, end.y - 1, end.z - 1);
+    const Vector3D center = 0.5 * (lower + upper);
+    const double radius = 0.5 * (upper - lower).Length();
+
+    const double centerSD = ctx.surfaceSet.SignedDistance(center);
+
+    // A 1-Lipschitz distance cannot change by more than the half diagonal
+    // across the octant, so no cell here can be within the band.
+    if (std::fabs(centerSD) > radius + ctx.bandwidth)
+    {
+        ctx.farRegions.push_back({ begin, end, center, centerSD });
+        return;
+    }
+
+    const size_t extentX = end.x - begin.x;
+    const size_t extentY = end.y - begin.y;
+    const size_t extentZ = end.z - begin.z;
+
+    if (std::max({ extentX, extentY, extentZ }) <= LEAF_EXTENT)
+    {
+        NearRegion region{ begin, end, {} };
+
+        if (!ctx.bounded.empty())
+        {
+            // Local-frame box covering every sample position in the region,
+            // expanded so that any surface that can be the closest one for
+            // some cell must overlap it. The sign flip of the set itself is
+            // undone since the member distances are queried in local frame.
+            const Transform3& transform = ctx.surfaceSet.transform;
+            const BoundingBox3D worldBox{ lower, upper };
+            BoundingBox3D localBox;
+
+            for (size_t c = 0; c < 8; ++c)
+            {
+                localBox.Merge(transform.ToLocal(worldBox.Corner(c)));
+            }
+
+            const double localSD =
+                ctx.surfaceSet.isNormalFlipped ? -centerSD : centerSD;
+            localBox.Expand(std::max(localSD + radius, 0.0));
+
+            const auto testFunc = [&](const size_t& idx,
+                                      const BoundingBox3D& box) {
+                return ctx.boundedBounds[idx].Overlaps(box);
+            };
+
+            ctx.octree.ForEachIntersectingItem(
+                localBox, testFunc, [&](const size_t& idx) {
+                    if (ctx.marks[idx] == 0)
+                    {
+                        ctx.marks[idx] = 1;
+                        region.candidates.push_back(idx);
+                    }
+                });
+
+            for (const size_t idx : region.candidates)
+            {
+                ctx.marks[idx] = 0;
+            }
+        }
+
+        ctx.nearRegions.push_back(std::move(region));
+        return;
+    }
+
+    // Split every dimension that still has more than one cell and recurse
+    // into the resulting octants.
+    const size_t xSplit[3] = { begin.x,
+                               (extentX >= 2) ? begin.x + extentX / 2 : end.x,
+                               end.x };
+    const size_t ySplit[3] = { begin.y,
+                               (extentY >= 2) ? begin.y + extentY / 2 : end.y,
+                               end.y };
+    const size_t zSplit[3] = { begin.z,
+                               (extentZ >= 2) ? begin.z + extentZ / 2 : end.z,
+                               end.z };
+
+    for (size_t a = 0; a < 2; ++a)
+    {
+        for (size_t b = 0; b < 2; ++b)
+        {
+            for (size_t c = 0; c < 2; ++c)
+            {
+                const Point3UI childBegin{ xSplit[a], ySplit[b], zSplit[c] };
+                const Point3UI childEnd{ xSplit[a + 1], ySplit[b + 1],
+                                         zSplit[c + 1] };
+
+                if (childBegin.x < childEnd.x && childBegin.y < childEnd.y &&
+                    childBegin.z < childEnd.z)
+                {
+                    Descend(ctx, childBegin, childEnd);
+                }
+            }
+        }
+    }
+}
+}  // namespace
+
+void ImplicitSurfaceSetToSDF(const ImplicitSurfaceSet3& surfaceSet,
+                             ScalarGrid3* sdf)
+{
+    const Vector3D gridSpacing = sdf->GridSpacing();
+    ImplicitSurfaceSetToSDF(
+        surfaceSet, sdf,
+        3.0 * std::max({ gridSpacing.x, gridSpacing.y, gridSpacing.z }));
+}
+
+void ImplicitSurfaceSetToSDF(const ImplicitSurfaceSet3& surfaceSet,
+                             ScalarGrid3* sdf, double bandwidth)
+{
+    const Size3 size = sdf->GetDataSize();
+    if (size.x * size.y * size.z == 0)
+    {
+        return;
+    }
+
+    const auto pos = sdf->GetDataPosition();
+
+    if (surfaceSet.NumberOfSurfaces() == 0)
+    {
+        sdf->Fill(surfaceSet.SignedDistance(pos(0, 0, 0)));
+        return;
+    }
+
+    DescentContext ctx{ surfaceSet, pos };
+    ctx.bandwidth = std::max(bandwidth, 0.0);
+
+    BoundingBox3D itemBound;
+    for (size_t i = 0; i < surfaceSet.NumberOfSurfaces(); ++i)
+    {
+        const ImplicitSurface3Ptr& surface = surfaceSet.SurfaceAt(i);
+
+        if (surface->IsBounded())
+        {
+            ctx.boundedBounds.push_back(surface->BoundingBox());
+            itemBound.Merge(ctx.boundedBounds.back());
+            ctx.bounded.push_back(surface);
+        }
+        else
+        {
+            ctx.unbounded.push_back(surface);
+        }
+    }
+
+    if (!ctx.bounded.empty())
+    {
+        std::vector<size_t> indices(ctx.bounded.size());
+        std::iota(indices.begin(), indices.end(), ZERO_SIZE);
+
+        const auto testFunc = [&](const size_t& idx,
+                                  const BoundingBox3D& box) {
+            return ctx.boundedBounds[idx].Overlaps(box);
+        };
+
+        const size_t maxDepth =
+            1 + static_cast<size_t>(
+                    std::ceil(std::log2(static_cast<double>(indices.size())) /
+                              3.0));
+
+        ctx.octree.Build(indices, itemBound, testFunc, maxDepth);
+    }
+
+    ctx.marks.resize(ctx.bounded.size(), 0);
+
+    Descend(ctx, Point3UI{ 0, 0, 0 }, Point3UI{ size.x, size.y, size.z });
+
+    ParallelFor(ZERO_SIZE, ctx.farRegions.size(), [&](size_t r) {
+        const FarRegion& region = ctx.farRegions[r];
+        const double sign = (region.centerSD < 0.0) ? -1.0 : 1.0;
+        const double magnitude = std::fabs(region.centerSD);
+
+        for (size_t k = region.begin.z; k < region.end.z; ++k)
+        {
+            for (size_t j = region.begin.y; j < region.end.y; ++j)
+            {
+                for (size_t i = region.begin.x; i < region.end.x; ++i)
+                {
+                    // Lower bound on the distance magnitude with the correct
+                    // sign; exceeds the bandwidth for every cell here.
+                    (*sdf)(i, j, k) =
+                        sign * (magnitude -
+                                pos(i, j, k).DistanceTo(region.center));
+                }
+            }
+        }
+    });
+
+    ParallelFor(ZERO_SIZE, ctx.nearRegions.size(), [&](size_t r) {
+        const NearRegion& region = ctx.nearRegions[r];
+
+        for (size_t k = region.begin.z; k < region.end.z; ++k)
+        {
+            for (size_t j = region.begin.y; j < region.end.y; ++j)
+            {
+                for (size_t i = region.begin.x; i < region.end.x; ++i)
+                {
+                    const Vector3D localP =
+                        surfaceSet.transform.ToLocal(pos(i, j, k));
+                    double best = std::numeric_limits<double>::max();
+
+                    for (const size_t idx : region.candidates)
+                    {
+                        best = std::min(
+                            best, ctx.bounded[idx]->SignedDistance(localP));
+                    }
+
+                    for (const ImplicitSurface3Ptr& surface : ctx.unbounded)
+                    {
+                        best = std::min(best, surface->SignedDistance(localP));
+                    }
+
+                    (*sdf)(i, j, k) =
+                        surfaceSet.isNormalFlipped ? -best : best;
+                }
+            }
+        }
+    });
+}
+}  // namespace CubbyFlow
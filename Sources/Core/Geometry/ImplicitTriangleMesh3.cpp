@@ -11,14 +11,51 @@
 #include <Core/Geometry/ImplicitTriangleMesh3.hpp>
 #include <Core/Geometry/TriangleMeshToSDF.hpp>
 
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
 #include <utility>
 
 namespace CubbyFlow
 {
-ImplicitTriangleMesh3::ImplicitTriangleMesh3(TriangleMesh3Ptr mesh,
-                                             size_t resolutionX, double margin,
-                                             const Transform3& _transform,
-                                             bool _isNormalFlipped)
+static uint64_t HashBakeBytes(const void* data, size_t numBytes, uint64_t hash)
+{
+    // FNV-1a
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < numBytes; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+static uint64_t HashBakeInputs(const TriangleMesh3& mesh, size_t resolutionX,
+                               double margin)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < mesh.NumberOfPoints(); ++i)
+    {
+        hash = HashBakeBytes(&mesh.Point(i), sizeof(Vector3D), hash);
+    }
+    for (size_t i = 0; i < mesh.NumberOfTriangles(); ++i)
+    {
+        hash = HashBakeBytes(&mesh.PointIndex(i), sizeof(Point3UI), hash);
+    }
+
+    hash = HashBakeBytes(&resolutionX, sizeof(resolutionX), hash);
+    hash = HashBakeBytes(&margin, sizeof(margin), hash);
+
+    return hash;
+}
+
+ImplicitTriangleMesh3::ImplicitTriangleMesh3(
+    TriangleMesh3Ptr mesh, size_t resolutionX, double margin,
+    const Transform3& _transform, bool _isNormalFlipped,
+    const std::string& bakeCacheDirectory)
     : ImplicitSurface3{ _transform, _isNormalFlipped }, m_mesh(std::move(mesh))
 {
     BoundingBox3D box = m_mesh->BoundingBox();
@@ -37,7 +74,53 @@ ImplicitTriangleMesh3::ImplicitTriangleMesh3(TriangleMesh3Ptr mesh,
     m_grid->Resize(resolutionX, resolutionY, resolutionZ, dx, dx, dx,
                    box.lowerCorner.x, box.lowerCorner.y, box.lowerCorner.z);
 
-    TriangleMeshToSDF(*m_mesh, m_grid.get());
+    std::string cacheFilePath;
+    bool loadedFromCache = false;
+
+    if (!bakeCacheDirectory.empty())
+    {
+        std::ostringstream fileName;
+        fileName << std::hex << std::setfill('0') << std::setw(16)
+                 << HashBakeInputs(*m_mesh, resolutionX, margin) << ".sdf";
+        cacheFilePath = bakeCacheDirectory + "/" + fileName.str();
+
+        if (std::ifstream file{ cacheFilePath, std::ios::binary })
+        {
+            const std::vector<uint8_t> buffer{
+                std::istreambuf_iterator<char>{ file },
+                std::istreambuf_iterator<char>{}
+            };
+            m_grid->Deserialize(buffer);
+
+            loadedFromCache =
+                m_grid->Resolution() ==
+                Size3{ resolutionX, resolutionY, resolutionZ };
+            if (!loadedFromCache)
+            {
+                // Stale or corrupt cache entry; fall back to a fresh bake.
+                m_grid->Resize(resolutionX, resolutionY, resolutionZ, dx, dx,
+                               dx, box.lowerCorner.x, box.lowerCorner.y,
+                               box.lowerCorner.z);
+            }
+        }
+    }
+
+    if (!loadedFromCache)
+    {
+        TriangleMeshToSDF(*m_mesh, m_grid.get());
+
+        if (!cacheFilePath.empty())
+        {
+            std::vector<uint8_t> buffer;
+            m_grid->Serialize(&buffer);
+
+            if (std::ofstream file{ cacheFilePath, std::ios::binary })
+            {
+                file.write(reinterpret_cast<const char*>(buffer.data()),
+                           static_cast<std::streamsize>(buffer.size()));
+            }
+        }
+    }
 
     m_customImplicitSurface =
         CustomImplicitSurface3::Builder{}
@@ -99,6 +182,14 @@ const VertexCenteredScalarGrid3Ptr& ImplicitTriangleMesh3::GetGrid() const
     return m_grid;
 }
 
+Vector3D ImplicitTriangleMesh3::Gradient(const Vector3D& otherPoint) const
+{
+    const Vector3D gradient = transform.ToWorldDirection(
+        m_grid->Gradient(transform.ToLocal(otherPoint)));
+
+    return isNormalFlipped ? -gradient : gradient;
+}
+
 ImplicitTriangleMesh3::Builder&
 ImplicitTriangleMesh3::Builder::WithTriangleMesh(const TriangleMesh3Ptr& mesh)
 {
@@ -120,17 +211,26 @@ ImplicitTriangleMesh3::Builder& ImplicitTriangleMesh3::Builder::WithMargin(
     return *this;
 }
 
+ImplicitTriangleMesh3::Builder&
+ImplicitTriangleMesh3::Builder::WithBakeCacheDirectory(
+    const std::string& bakeCacheDirectory)
+{
+    m_bakeCacheDirectory = bakeCacheDirectory;
+    return *this;
+}
+
 ImplicitTriangleMesh3 ImplicitTriangleMesh3::Builder::Build() const
 {
-    return ImplicitTriangleMesh3{ m_mesh, m_resolutionX, m_margin, m_transform,
-                                  m_isNormalFlipped };
+    return ImplicitTriangleMesh3{ m_mesh,           m_resolutionX,
+                                  m_margin,         m_transform,
+                                  m_isNormalFlipped, m_bakeCacheDirectory };
 }
 
 ImplicitTriangleMesh3Ptr ImplicitTriangleMesh3::Builder::MakeShared() const
 {
     return std::shared_ptr<ImplicitTriangleMesh3>(
         new ImplicitTriangleMesh3{ m_mesh, m_resolutionX, m_margin, m_transform,
-                                   m_isNormalFlipped },
+                                   m_isNormalFlipped, m_bakeCacheDirectory },
         [](ImplicitTriangleMesh3* obj) { delete obj; });
 }
 }  // namespace CubbyFlow
\ No newline at end of file
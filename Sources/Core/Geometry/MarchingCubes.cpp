@@ -24,10 +24,13 @@
 #include <Core/Geometry/MarchingCubes.hpp>
 #include <Core/Geometry/MarchingCubesTable.hpp>
 #include <Core/Geometry/MarchingSquaresTable.hpp>
+#include <Core/Utils/Constants.hpp>
 #include <Core/Utils/LevelSetUtils.hpp>
+#include <Core/Utils/Parallel.hpp>
 
 #include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 namespace CubbyFlow
 {
@@ -381,67 +384,212 @@ static void SingleCube(const std::array<double, 8>& data,
     }
 }
 
-void MarchingCubes(const ConstArrayAccessor3<double>& grid,
-                   const Vector3D& gridSize, const Vector3D& origin,
-                   TriangleMesh3* mesh, double isoValue, int bndClose,
-                   int bndConnectivity)
+static void MarchCube(const ConstArrayAccessor3<double>& grid, ssize_t i,
+                      ssize_t j, ssize_t k, const Vector3D& gridSize,
+                      const Vector3D& invGridSize, const Vector3D& origin,
+                      MarchingCubeVertexMap* vertexMap, TriangleMesh3* mesh,
+                      double isoValue)
 {
-    MarchingCubeVertexMap vertexMap;
-
     const Size3 dim = grid.size();
-    const Vector3D invGridSize = 1.0 / gridSize;
 
-    auto pos = [origin, gridSize](ssize_t i, ssize_t j, ssize_t k) {
-        return origin + gridSize * Vector3D{ { i, j, k } };
+    auto pos = [origin, gridSize](ssize_t x, ssize_t y, ssize_t z) {
+        return origin + gridSize * Vector3D{ { x, y, z } };
     };
 
+    std::array<double, 8> data{};
+    std::array<size_t, 12> edgeIDs{};
+    std::array<Vector3D, 8> normals;
+    BoundingBox3D bound;
+
+    data[0] = grid(i, j, k);
+    data[1] = grid(i + 1, j, k);
+    data[4] = grid(i, j + 1, k);
+    data[5] = grid(i + 1, j + 1, k);
+    data[3] = grid(i, j, k + 1);
+    data[2] = grid(i + 1, j, k + 1);
+    data[7] = grid(i, j + 1, k + 1);
+    data[6] = grid(i + 1, j + 1, k + 1);
+
+    normals[0] = Grad(grid, i, j, k, invGridSize);
+    normals[1] = Grad(grid, i + 1, j, k, invGridSize);
+    normals[4] = Grad(grid, i, j + 1, k, invGridSize);
+    normals[5] = Grad(grid, i + 1, j + 1, k, invGridSize);
+    normals[3] = Grad(grid, i, j, k + 1, invGridSize);
+    normals[2] = Grad(grid, i + 1, j, k + 1, invGridSize);
+    normals[7] = Grad(grid, i, j + 1, k + 1, invGridSize);
+    normals[6] = Grad(grid, i + 1, j + 1, k + 1, invGridSize);
+
+    for (int e = 0; e < 12; ++e)
+    {
+        edgeIDs[e] = GlobalEdgeID(i, j, k, dim, e);
+    }
+
+    bound.lowerCorner = pos(i, j, k);
+    bound.upperCorner = pos(i + 1, j + 1, k + 1);
+
+    SingleCube(data, edgeIDs, normals, bound, vertexMap, mesh, isoValue);
+}
+
+//
+// The interior cells are marched in parallel: the z-range is split into
+// slabs, each slab appends into its own mesh fragment and vertex map, and
+// the fragments are merged afterwards. Welding happens during the merge by
+// looking every fragment vertex up in the global vertex map keyed by its
+// grid edge ID, so vertices on the planes shared by adjacent slabs collapse
+// to one index exactly as in the serial march. The merged triangles are
+// copied with fragment-local indices first and rewritten in parallel using
+// the per-fragment remap tables and prefix-summed triangle offsets.
+//
+static void MarchInterior(const ConstArrayAccessor3<double>& grid,
+                          const Vector3D& gridSize,
+                          const Vector3D& invGridSize, const Vector3D& origin,
+                          MarchingCubeVertexMap* vertexMap,
+                          TriangleMesh3* mesh, double isoValue)
+{
+    const Size3 dim = grid.size();
     const ssize_t dimX = static_cast<ssize_t>(dim.x);
     const ssize_t dimY = static_cast<ssize_t>(dim.y);
     const ssize_t dimZ = static_cast<ssize_t>(dim.z);
 
-    for (ssize_t k = 0; k < dimZ - 1; ++k)
+    const size_t numCellsZ =
+        (dimZ > 1) ? static_cast<size_t>(dimZ - 1) : ZERO_SIZE;
+    const size_t numSlabs =
+        std::min(static_cast<size_t>(GetMaxNumberOfThreads()), numCellsZ);
+
+    if (numSlabs <= 1)
     {
-        for (ssize_t j = 0; j < dimY - 1; ++j)
+        for (ssize_t k = 0; k < dimZ - 1; ++k)
         {
-            for (ssize_t i = 0; i < dimX - 1; ++i)
+            for (ssize_t j = 0; j < dimY - 1; ++j)
             {
-                std::array<double, 8> data{};
-                std::array<size_t, 12> edgeIDs{};
-                std::array<Vector3D, 8> normals;
-                BoundingBox3D bound;
+                for (ssize_t i = 0; i < dimX - 1; ++i)
+                {
+                    MarchCube(grid, i, j, k, gridSize, invGridSize, origin,
+                              vertexMap, mesh, isoValue);
+                }
+            }
+        }
 
-                data[0] = grid(i, j, k);
-                data[1] = grid(i + 1, j, k);
-                data[4] = grid(i, j + 1, k);
-                data[5] = grid(i + 1, j + 1, k);
-                data[3] = grid(i, j, k + 1);
-                data[2] = grid(i + 1, j, k + 1);
-                data[7] = grid(i, j + 1, k + 1);
-                data[6] = grid(i + 1, j + 1, k + 1);
-
-                normals[0] = Grad(grid, i, j, k, invGridSize);
-                normals[1] = Grad(grid, i + 1, j, k, invGridSize);
-                normals[4] = Grad(grid, i, j + 1, k, invGridSize);
-                normals[5] = Grad(grid, i + 1, j + 1, k, invGridSize);
-                normals[3] = Grad(grid, i, j, k + 1, invGridSize);
-                normals[2] = Grad(grid, i + 1, j, k + 1, invGridSize);
-                normals[7] = Grad(grid, i, j + 1, k + 1, invGridSize);
-                normals[6] = Grad(grid, i + 1, j + 1, k + 1, invGridSize);
-
-                for (int e = 0; e < 12; ++e)
+        return;
+    }
+
+    // March each slab into its own fragment
+    std::vector<TriangleMesh3> fragments(numSlabs);
+    std::vector<MarchingCubeVertexMap> fragmentMaps(numSlabs);
+
+    ParallelFor(ZERO_SIZE, numSlabs, [&](size_t s) {
+        const auto kBegin = static_cast<ssize_t>(numCellsZ * s / numSlabs);
+        const auto kEnd =
+            static_cast<ssize_t>(numCellsZ * (s + 1) / numSlabs);
+
+        for (ssize_t k = kBegin; k < kEnd; ++k)
+        {
+            for (ssize_t j = 0; j < dimY - 1; ++j)
+            {
+                for (ssize_t i = 0; i < dimX - 1; ++i)
                 {
-                    edgeIDs[e] = GlobalEdgeID(i, j, k, dim, e);
+                    MarchCube(grid, i, j, k, gridSize, invGridSize, origin,
+                              &fragmentMaps[s], &fragments[s], isoValue);
                 }
+            }
+        }
+    });
 
-                bound.lowerCorner = pos(i, j, k);
-                bound.upperCorner = pos(i + 1, j + 1, k + 1);
+    // Invert the fragment maps into per-vertex edge keys
+    std::vector<std::vector<MarchingCubeVertexHashKey>> fragmentKeys(numSlabs);
 
-                SingleCube(data, edgeIDs, normals, bound, &vertexMap, mesh,
-                           isoValue);
+    ParallelFor(ZERO_SIZE, numSlabs, [&](size_t s) {
+        fragmentKeys[s].resize(fragments[s].NumberOfPoints());
+
+        for (const auto& keyAndID : fragmentMaps[s])
+        {
+            fragmentKeys[s][keyAndID.second] = keyAndID.first;
+        }
+    });
+
+    // Merge vertices, welding duplicates through the global vertex map
+    std::vector<std::vector<size_t>> vertexRemaps(numSlabs);
+    std::vector<size_t> triangleOffsets(numSlabs + 1);
+    const size_t firstMergedTriangle = mesh->NumberOfTriangles();
+
+    for (size_t s = 0; s < numSlabs; ++s)
+    {
+        const TriangleMesh3& fragment = fragments[s];
+        std::vector<size_t>& remap = vertexRemaps[s];
+        remap.resize(fragment.NumberOfPoints());
+
+        for (size_t localID = 0; localID < fragment.NumberOfPoints();
+             ++localID)
+        {
+            const MarchingCubeVertexHashKey vKey = fragmentKeys[s][localID];
+            MarchingCubeVertexID vID;
+
+            if (QueryVertexID(*vertexMap, vKey, &vID))
+            {
+                remap[localID] = vID;
+            }
+            else
+            {
+                remap[localID] = mesh->NumberOfPoints();
+                mesh->AddPoint(fragment.Point(localID));
+                mesh->AddNormal(fragment.Normal(localID));
+                mesh->AddUV(Vector2D{});
+                vertexMap->insert(std::make_pair(vKey, remap[localID]));
             }
         }
+
+        triangleOffsets[s] = mesh->NumberOfTriangles() - firstMergedTriangle;
+
+        for (size_t t = 0; t < fragment.NumberOfTriangles(); ++t)
+        {
+            mesh->AddPointTriangle(fragment.PointIndex(t));
+            mesh->AddNormalTriangle(fragment.NormalIndex(t));
+            mesh->AddUVTriangle(fragment.UVIndex(t));
+        }
     }
 
+    triangleOffsets[numSlabs] =
+        mesh->NumberOfTriangles() - firstMergedTriangle;
+
+    // Rewrite fragment-local triangle indices to the merged vertex indices
+    ParallelFor(ZERO_SIZE, triangleOffsets[numSlabs], [&](size_t t) {
+        const auto upper = std::upper_bound(triangleOffsets.begin(),
+                                            triangleOffsets.end(), t);
+        const auto s = static_cast<size_t>(
+            std::distance(triangleOffsets.begin(), upper) - 1);
+        const std::vector<size_t>& remap = vertexRemaps[s];
+
+        Point3UI& face = mesh->PointIndex(firstMergedTriangle + t);
+        face.x = remap[face.x];
+        face.y = remap[face.y];
+        face.z = remap[face.z];
+
+        mesh->NormalIndex(firstMergedTriangle + t) = face;
+        mesh->UVIndex(firstMergedTriangle + t) = face;
+    });
+}
+
+void MarchingCubes(const ConstArrayAccessor3<double>& grid,
+                   const Vector3D& gridSize, const Vector3D& origin,
+                   TriangleMesh3* mesh, double isoValue, int bndClose,
+                   int bndConnectivity)
+{
+    MarchingCubeVertexMap vertexMap;
+
+    const Size3 dim = grid.size();
+    const Vector3D invGridSize = 1.0 / gridSize;
+
+    auto pos = [origin, gridSize](ssize_t i, ssize_t j, ssize_t k) {
+        return origin + gridSize * Vector3D{ { i, j, k } };
+    };
+
+    const ssize_t dimX = static_cast<ssize_t>(dim.x);
+    const ssize_t dimY = static_cast<ssize_t>(dim.y);
+    const ssize_t dimZ = static_cast<ssize_t>(dim.z);
+
+    MarchInterior(grid, gridSize, invGridSize, origin, &vertexMap, mesh,
+                  isoValue);
+
     // Construct boundaries parallel to x-y plane
     if (bndClose & (DIRECTION_BACK | DIRECTION_FRONT))
     {
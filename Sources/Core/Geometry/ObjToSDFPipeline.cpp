@@ -0,0 +1,399 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Geometry/ObjToSDFPipeline.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <vector>
+
+namespace CubbyFlow
+{
+namespace
+{
+enum class ObjRecordKind : char
+{
+    None,
+    Point,
+    Normal,
+    UV,
+    Face
+};
+
+//! One tokenized OBJ line. Face corners keep the raw (v, vt, vn) indices;
+//! zero marks an absent attribute, negative indices are relative.
+struct ObjRecord
+{
+    ObjRecordKind kind = ObjRecordKind::None;
+    Vector3D v;
+    Vector2D uv;
+    std::vector<std::array<long long, 3>> corners;
+};
+
+bool IsObjSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* SkipObjSpace(const char* p, const char* end)
+{
+    while (p < end && IsObjSpace(*p))
+    {
+        ++p;
+    }
+
+    return p;
+}
+
+//! Tokenizes a single OBJ line. Lines other than v/vn/vt/f are ignored.
+void ParseObjLine(const char* p, const char* end, ObjRecord* record)
+{
+    p = SkipObjSpace(p, end);
+    if (p >= end)
+    {
+        return;
+    }
+
+    char* q = nullptr;
+
+    if (*p == 'v')
+    {
+        if (p + 1 < end && IsObjSpace(p[1]))
+        {
+            record->kind = ObjRecordKind::Point;
+            record->v.x = std::strtod(p + 1, &q);
+            record->v.y = std::strtod(q, &q);
+            record->v.z = std::strtod(q, &q);
+        }
+        else if (p + 2 < end && p[1] == 'n' && IsObjSpace(p[2]))
+        {
+            record->kind = ObjRecordKind::Normal;
+            record->v.x = std::strtod(p + 2, &q);
+            record->v.y = std::strtod(q, &q);
+            record->v.z = std::strtod(q, &q);
+        }
+        else if (p + 2 < end && p[1] == 't' && IsObjSpace(p[2]))
+        {
+            record->kind = ObjRecordKind::UV;
+            record->uv.x = std::strtod(p + 2, &q);
+            record->uv.y = std::strtod(q, &q);
+        }
+    }
+    else if (*p == 'f' && p + 1 < end && IsObjSpace(p[1]))
+    {
+        record->kind = ObjRecordKind::Face;
+        p = SkipObjSpace(p + 1, end);
+
+        while (p < end && *p != '\n')
+        {
+            std::array<long long, 3> corner{ { 0, 0, 0 } };
+
+            corner[0] = std::strtoll(p, &q, 10);
+            p = q;
+
+            if (p < end && *p == '/')
+            {
+                ++p;
+
+                if (p < end && *p != '/')
+                {
+                    corner[1] = std::strtoll(p, &q, 10);
+                    p = q;
+                }
+
+                if (p < end && *p == '/')
+                {
+                    corner[2] = std::strtoll(p + 1, &q, 10);
+                    p = q;
+                }
+            }
+
+            record->corners.push_back(corner);
+            p = SkipObjSpace(p, end);
+        }
+    }
+}
+
+//! Resolves a raw 1-based (or negative relative) OBJ index against the
+//! current attribute count. Returns false for zero or out-of-range indices.
+bool ResolveObjIndex(long long raw, size_t count, size_t* resolved)
+{
+    if (raw > 0 && static_cast<size_t>(raw) <= count)
+    {
+        *resolved = static_cast<size_t>(raw) - 1;
+        return true;
+    }
+
+    if (raw < 0 && static_cast<size_t>(-raw) <= count)
+    {
+        *resolved = count - static_cast<size_t>(-raw);
+        return true;
+    }
+
+    return false;
+}
+
+//! Appends the tokenized records of one chunk to the mesh, in file order.
+bool AppendObjRecords(const std::vector<ObjRecord>& records,
+                      TriangleMesh3* mesh)
+{
+    for (const ObjRecord& record : records)
+    {
+        switch (record.kind)
+        {
+            case ObjRecordKind::Point:
+                mesh->AddPoint(record.v);
+                break;
+            case ObjRecordKind::Normal:
+                mesh->AddNormal(record.v);
+                break;
+            case ObjRecordKind::UV:
+                mesh->AddUV(record.uv);
+                break;
+            case ObjRecordKind::Face:
+            {
+                const size_t numCorners = record.corners.size();
+                if (numCorners < 3)
+                {
+                    return false;
+                }
+
+                // Fan-triangulate the polygon.
+                for (size_t c = 2; c < numCorners; ++c)
+                {
+                    const std::array<long long, 3>& c0 = record.corners[0];
+                    const std::array<long long, 3>& c1 = record.corners[c - 1];
+                    const std::array<long long, 3>& c2 = record.corners[c];
+
+                    Point3UI points;
+                    if (!ResolveObjIndex(c0[0], mesh->NumberOfPoints(),
+                                         &points.x) ||
+                        !ResolveObjIndex(c1[0], mesh->NumberOfPoints(),
+                                         &points.y) ||
+                        !ResolveObjIndex(c2[0], mesh->NumberOfPoints(),
+                                         &points.z))
+                    {
+                        return false;
+                    }
+                    mesh->AddPointTriangle(points);
+
+                    Point3UI uvs;
+                    if (c0[1] != 0 && c1[1] != 0 && c2[1] != 0 &&
+                        ResolveObjIndex(c0[1], mesh->NumberOfUVs(), &uvs.x) &&
+                        ResolveObjIndex(c1[1], mesh->NumberOfUVs(), &uvs.y) &&
+                        ResolveObjIndex(c2[1], mesh->NumberOfUVs(), &uvs.z))
+                    {
+                        mesh->AddUVTriangle(uvs);
+                    }
+
+                    Point3UI normals;
+                    if (c0[2] != 0 && c1[2] != 0 && c2[2] != 0 &&
+                        ResolveObjIndex(c0[2], mesh->NumberOfNormals(),
+                                        &normals.x) &&
+                        ResolveObjIndex(c1[2], mesh->NumberOfNormals(),
+                                        &normals.y) &&
+                        ResolveObjIndex(c2[2], mesh->NumberOfNormals(),
+                                        &normals.z))
+                    {
+                        mesh->AddNormalTriangle(normals);
+                    }
+                }
+                break;
+            }
+            case ObjRecordKind::None:
+                break;
+        }
+    }
+
+    return true;
+}
+}  // namespace
+
+bool ReadObjStreaming(std::istream* stream, TriangleMesh3* mesh,
+                      size_t readChunkSize)
+{
+    const size_t chunkSize = std::max<size_t>(readChunkSize, 1);
+
+    // Pulls the next chunk and extends it to the end of the current line so
+    // that no record straddles a chunk boundary.
+    const auto fetchChunk = [stream, chunkSize]() {
+        std::string chunk(chunkSize, '\0');
+        stream->read(&chunk[0], static_cast<std::streamsize>(chunkSize));
+        chunk.resize(static_cast<size_t>(stream->gcount()));
+
+        if (!chunk.empty() && chunk.back() != '\n')
+        {
+            std::string rest;
+            if (std::getline(*stream, rest))
+            {
+                chunk += rest;
+            }
+            chunk += '\n';
+        }
+
+        return chunk;
+    };
+
+    bool success = true;
+    std::future<std::string> nextChunk =
+        std::async(std::launch::async, fetchChunk);
+
+    while (success)
+    {
+        const std::string chunk = nextChunk.get();
+        if (chunk.empty())
+        {
+            break;
+        }
+
+        // Fetch the next chunk on a worker while this one is parsed.
+        nextChunk = std::async(std::launch::async, fetchChunk);
+
+        // Split into lines serially, then tokenize them in parallel.
+        std::vector<std::pair<size_t, size_t>> lines;
+        size_t lineBegin = 0;
+        while (lineBegin < chunk.size())
+        {
+            const char* newline = static_cast<const char*>(std::memchr(
+                chunk.data() + lineBegin, '\n', chunk.size() - lineBegin));
+            const size_t lineEnd =
+                (newline != nullptr)
+                    ? static_cast<size_t>(newline - chunk.data())
+                    : chunk.size();
+
+            lines.emplace_back(lineBegin, lineEnd);
+            lineBegin = lineEnd + 1;
+        }
+
+        std::vector<ObjRecord> records(lines.size());
+        ParallelFor(ZERO_SIZE, lines.size(), [&](size_t lineIdx) {
+            ParseObjLine(chunk.data() + lines[lineIdx].first,
+                         chunk.data() + lines[lineIdx].second,
+                         &records[lineIdx]);
+        });
+
+        success = AppendObjRecords(records, mesh);
+    }
+
+    if (nextChunk.valid())
+    {
+        nextChunk.get();
+    }
+
+    return success;
+}
+
+void TriangleMeshToSDFSlabs(const TriangleMesh3& mesh, ScalarGrid3* sdf,
+                            double windingNumberAccuracy,
+                            const SDFSlabWriter& slabWriter)
+{
+    const Size3 size = sdf->GetDataSize();
+    if (size.x * size.y * size.z == 0)
+    {
+        return;
+    }
+
+    const auto pos = sdf->GetDataPosition();
+    mesh.UpdateQueryEngine();
+
+    std::future<void> pendingWrite;
+
+    for (size_t k = 0; k < size.z; ++k)
+    {
+        ParallelFor(ZERO_SIZE, size.x, ZERO_SIZE, size.y,
+                    [&](size_t i, size_t j) {
+                        const Vector3D p = pos(i, j, k);
+                        const double d = mesh.ClosestDistance(p);
+                        const bool isInside =
+                            (windingNumberAccuracy > 0.0)
+                                ? mesh.isNormalFlipped ==
+                                      !(mesh.FastWindingNumber(
+                                            p, windingNumberAccuracy) > 0.5)
+                                : mesh.IsInside(p);
+
+                        (*sdf)(i, j, k) = isInside ? -d : d;
+                    });
+
+        if (slabWriter)
+        {
+            // Hand the finished slab to the writer while the next slab is
+            // computed; at most one write is in flight.
+            if (pendingWrite.valid())
+            {
+                pendingWrite.get();
+            }
+
+            pendingWrite = std::async(std::launch::async, [&slabWriter, k]() {
+                slabWriter(k, k + 1);
+            });
+        }
+    }
+
+    if (pendingWrite.valid())
+    {
+        pendingWrite.get();
+    }
+}
+
+bool ObjToSDF(std::istream* objStream, VertexCenteredScalarGrid3* sdf,
+              const ObjToSDFPipelineSettings& settings,
+              const SDFSlabWriter& slabWriter)
+{
+    TriangleMesh3 mesh;
+    if (!ReadObjStreaming(objStream, &mesh, settings.readChunkSize))
+    {
+        return false;
+    }
+
+    if (mesh.NumberOfTriangles() == 0)
+    {
+        return false;
+    }
+
+    // Bounds from the raw points; going through BoundingBox() would force
+    // the BVH build onto the critical path.
+    BoundingBox3D box{ mesh.Point(0), mesh.Point(0) };
+    for (size_t i = 1; i < mesh.NumberOfPoints(); ++i)
+    {
+        box.Merge(mesh.Point(i));
+    }
+
+    const Vector3D scale{ box.GetWidth(), box.GetHeight(), box.GetDepth() };
+    box.lowerCorner -= settings.marginScale * scale;
+    box.upperCorner += settings.marginScale * scale;
+
+    const size_t resX = std::max<size_t>(settings.resolutionX, 1);
+    const auto resY = static_cast<size_t>(
+        std::ceil(resX * box.GetHeight() / box.GetWidth()));
+    const auto resZ = static_cast<size_t>(
+        std::ceil(resX * box.GetDepth() / box.GetWidth()));
+    const double dx = box.GetWidth() / static_cast<double>(resX);
+
+    // Build the BVH (and dipole hierarchy) while the grid storage is
+    // allocated.
+    std::future<void> queryEngineBuild = std::async(
+        std::launch::async, [&mesh]() { mesh.UpdateQueryEngine(); });
+
+    sdf->Resize(resX, resY, resZ, dx, dx, dx, box.lowerCorner.x,
+                box.lowerCorner.y, box.lowerCorner.z);
+
+    queryEngineBuild.get();
+
+    TriangleMeshToSDFSlabs(mesh, sdf, settings.windingNumberAccuracy,
+                           slabWriter);
+
+    return true;
+}
+}  // namespace CubbyFlow
@@ -10,6 +10,9 @@
 
 #include <Core/Geometry/RigidBodyCollider3.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace CubbyFlow
 {
 RigidBodyCollider3::RigidBodyCollider3(const Surface3Ptr& surface)
@@ -31,6 +34,56 @@ Vector3D RigidBodyCollider3::VelocityAt(const Vector3D& point) const
     return linearVelocity + angularVelocity.Cross(r);
 }
 
+void RigidBodyCollider3::Update(double currentTimeInSeconds,
+                                double timeIntervalInSeconds)
+{
+    m_previousTransform =
+        m_hasPreviousTransform ? m_currentTransform : GetSurface()->transform;
+
+    Collider3::Update(currentTimeInSeconds, timeIntervalInSeconds);
+
+    m_currentTransform = GetSurface()->transform;
+    m_hasPreviousTransform = true;
+
+    if (isVelocityDerivedFromMotion && timeIntervalInSeconds > 0.0)
+    {
+        linearVelocity = (m_currentTransform.GetTranslation() -
+                          m_previousTransform.GetTranslation()) /
+                         timeIntervalInSeconds;
+
+        const QuaternionD delta =
+            m_currentTransform.GetOrientation() *
+            m_previousTransform.GetOrientation().Inverse();
+        const double angle = delta.Angle();
+
+        if (std::fabs(angle) > std::numeric_limits<double>::epsilon())
+        {
+            angularVelocity = delta.Axis() * (angle / timeIntervalInSeconds);
+        }
+        else
+        {
+            angularVelocity = Vector3D{};
+        }
+    }
+}
+
+Transform3 RigidBodyCollider3::GetTransformAt(double fraction) const
+{
+    if (!m_hasPreviousTransform)
+    {
+        return GetSurface()->transform;
+    }
+
+    const double t = std::clamp(fraction, 0.0, 1.0);
+
+    Transform3 result;
+    result.SetTranslation((1.0 - t) * m_previousTransform.GetTranslation() +
+                          t * m_currentTransform.GetTranslation());
+    result.SetOrientation(Slerp(m_previousTransform.GetOrientation(),
+                                m_currentTransform.GetOrientation(), t));
+    return result;
+}
+
 RigidBodyCollider3::Builder RigidBodyCollider3::GetBuilder()
 {
     return Builder();
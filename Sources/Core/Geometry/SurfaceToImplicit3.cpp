@@ -8,12 +8,94 @@
 // personal capacity and are not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <Core/Geometry/Box3.hpp>
+#include <Core/Geometry/Cylinder3.hpp>
+#include <Core/Geometry/Plane3.hpp>
+#include <Core/Geometry/Sphere3.hpp>
 #include <Core/Geometry/TriangleMesh3.hpp>
 #include <Core/Geometry/SurfaceToImplicit3.hpp>
 #include <Core/Utils/Logging.hpp>
 
 namespace CubbyFlow
 {
+namespace
+{
+// Local-frame signed-distance gradients of the analytic primitives, exact
+// derivatives of the respective closed-form distances. The callers map the
+// direction back to world space and apply the normal-flip sign.
+Vector3D SphereGradientLocal(const Sphere3& sphere, const Vector3D& pt)
+{
+    const Vector3D d = pt - sphere.center;
+    const double len = d.Length();
+
+    return (len > 0.0) ? d / len : Vector3D{ 1.0, 0.0, 0.0 };
+}
+
+Vector3D BoxGradientLocal(const Box3& box, const Vector3D& pt)
+{
+    const Vector3D lower = box.bound.lowerCorner;
+    const Vector3D upper = box.bound.upperCorner;
+
+    const Vector3D d{ std::max(lower.x - pt.x, pt.x - upper.x),
+                      std::max(lower.y - pt.y, pt.y - upper.y),
+                      std::max(lower.z - pt.z, pt.z - upper.z) };
+
+    const Vector3D outside{ std::max(d.x, 0.0), std::max(d.y, 0.0),
+                            std::max(d.z, 0.0) };
+    const double outsideLen = outside.Length();
+
+    if (outsideLen > 0.0)
+    {
+        // Outside: direction from the clamped surface point, with per-axis
+        // signs recovering which side of each slab the point left.
+        return Vector3D{ (pt.x > upper.x) ? outside.x : -outside.x,
+                         (pt.y > upper.y) ? outside.y : -outside.y,
+                         (pt.z > upper.z) ? outside.z : -outside.z } /
+               outsideLen;
+    }
+
+    // Inside: the distance follows the nearest face, so the gradient points
+    // along that face's axis.
+    const Vector3D center = 0.5 * (lower + upper);
+    if (d.x >= d.y && d.x >= d.z)
+    {
+        return Vector3D{ (pt.x >= center.x) ? 1.0 : -1.0, 0.0, 0.0 };
+    }
+    if (d.y >= d.z)
+    {
+        return Vector3D{ 0.0, (pt.y >= center.y) ? 1.0 : -1.0, 0.0 };
+    }
+    return Vector3D{ 0.0, 0.0, (pt.z >= center.z) ? 1.0 : -1.0 };
+}
+
+Vector3D CylinderGradientLocal(const Cylinder3& cylinder, const Vector3D& pt)
+{
+    const Vector3D p = pt - cylinder.center;
+    const double radialLen = std::sqrt(p.x * p.x + p.z * p.z);
+    const Vector3D radialDir =
+        (radialLen > 0.0)
+            ? Vector3D{ p.x / radialLen, 0.0, p.z / radialLen }
+            : Vector3D{ 1.0, 0.0, 0.0 };
+    const Vector3D capDir{ 0.0, (p.y >= 0.0) ? 1.0 : -1.0, 0.0 };
+
+    const double radialDist = radialLen - cylinder.radius;
+    const double capDist = std::abs(p.y) - 0.5 * cylinder.height;
+
+    const double radialOutside = std::max(radialDist, 0.0);
+    const double capOutside = std::max(capDist, 0.0);
+    const double outsideLen =
+        std::sqrt(radialOutside * radialOutside + capOutside * capOutside);
+
+    if (outsideLen > 0.0)
+    {
+        return (radialOutside * radialDir + capOutside * capDir) / outsideLen;
+    }
+
+    // Inside: the distance follows whichever of the shell and the caps is
+    // nearer.
+    return (radialDist >= capDist) ? radialDir : capDir;
+}
+}  // namespace
 SurfaceToImplicit3::SurfaceToImplicit3(const Surface3Ptr& surface,
                                        const Transform3& _transform,
                                        bool _isNormalFlipped)
@@ -43,6 +125,205 @@ bool SurfaceToImplicit3::IsValidGeometry() const
     return m_surface->IsValidGeometry();
 }
 
+void SurfaceToImplicit3::SignedDistance(
+    const ConstArrayAccessor1<Vector3D>& points,
+    ArrayAccessor1<double> results) const
+{
+    // The primitive type is resolved once per batch, so the loops below pay
+    // no per-point dispatch. Rigid transforms preserve distances, which is
+    // why the local-frame values can be written out directly. The sign flips
+    // of this wrapper and of the wrapped surface cancel when both are set,
+    // matching the scalar path through Surface3::IsInside.
+    if (const auto sphere = std::dynamic_pointer_cast<Sphere3>(m_surface))
+    {
+        const double sign =
+            (isNormalFlipped != sphere->isNormalFlipped) ? -1.0 : 1.0;
+        const Vector3D center = sphere->center;
+        const double radius = sphere->radius;
+
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            const Vector3D pt =
+                sphere->transform.ToLocal(transform.ToLocal(points[i]));
+            results[i] = sign * ((pt - center).Length() - radius);
+        }
+
+        return;
+    }
+
+    if (const auto box = std::dynamic_pointer_cast<Box3>(m_surface))
+    {
+        const double sign =
+            (isNormalFlipped != box->isNormalFlipped) ? -1.0 : 1.0;
+        const Vector3D lower = box->bound.lowerCorner;
+        const Vector3D upper = box->bound.upperCorner;
+
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            const Vector3D pt =
+                box->transform.ToLocal(transform.ToLocal(points[i]));
+
+            // Per-axis signed distance to the slab; negative on all axes
+            // means the point is inside the box
+            const Vector3D d{ std::max(lower.x - pt.x, pt.x - upper.x),
+                              std::max(lower.y - pt.y, pt.y - upper.y),
+                              std::max(lower.z - pt.z, pt.z - upper.z) };
+
+            const Vector3D outside{ std::max(d.x, 0.0), std::max(d.y, 0.0),
+                                    std::max(d.z, 0.0) };
+            const double inside = std::min(std::max({ d.x, d.y, d.z }), 0.0);
+
+            results[i] = sign * (outside.Length() + inside);
+        }
+
+        return;
+    }
+
+    if (const auto plane = std::dynamic_pointer_cast<Plane3>(m_surface))
+    {
+        const double sign =
+            (isNormalFlipped != plane->isNormalFlipped) ? -1.0 : 1.0;
+        const Vector3D normal = plane->normal;
+        const Vector3D point = plane->point;
+
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            const Vector3D pt =
+                plane->transform.ToLocal(transform.ToLocal(points[i]));
+            results[i] = sign * normal.Dot(pt - point);
+        }
+
+        return;
+    }
+
+    ImplicitSurface3::SignedDistance(points, results);
+}
+
+Vector3D SurfaceToImplicit3::Gradient(const Vector3D& otherPoint) const
+{
+    if (const auto sphere = std::dynamic_pointer_cast<Sphere3>(m_surface))
+    {
+        const double sign =
+            (isNormalFlipped != sphere->isNormalFlipped) ? -1.0 : 1.0;
+        const Vector3D pt =
+            sphere->transform.ToLocal(transform.ToLocal(otherPoint));
+
+        return sign * transform.ToWorldDirection(
+                          sphere->transform.ToWorldDirection(
+                              SphereGradientLocal(*sphere, pt)));
+    }
+
+    if (const auto box = std::dynamic_pointer_cast<Box3>(m_surface))
+    {
+        const double sign =
+            (isNormalFlipped != box->isNormalFlipped) ? -1.0 : 1.0;
+        const Vector3D pt =
+            box->transform.ToLocal(transform.ToLocal(otherPoint));
+
+        return sign * transform.ToWorldDirection(
+                          box->transform.ToWorldDirection(
+                              BoxGradientLocal(*box, pt)));
+    }
+
+    if (const auto plane = std::dynamic_pointer_cast<Plane3>(m_surface))
+    {
+        const double sign =
+            (isNormalFlipped != plane->isNormalFlipped) ? -1.0 : 1.0;
+
+        return sign * transform.ToWorldDirection(
+                          plane->transform.ToWorldDirection(plane->normal));
+    }
+
+    if (const auto cylinder = std::dynamic_pointer_cast<Cylinder3>(m_surface))
+    {
+        const double sign =
+            (isNormalFlipped != cylinder->isNormalFlipped) ? -1.0 : 1.0;
+        const Vector3D pt =
+            cylinder->transform.ToLocal(transform.ToLocal(otherPoint));
+
+        return sign * transform.ToWorldDirection(
+                          cylinder->transform.ToWorldDirection(
+                              CylinderGradientLocal(*cylinder, pt)));
+    }
+
+    return ImplicitSurface3::Gradient(otherPoint);
+}
+
+void SurfaceToImplicit3::Gradient(const ConstArrayAccessor1<Vector3D>& points,
+                                  ArrayAccessor1<Vector3D> results) const
+{
+    // As in the batch SignedDistance, the primitive type is resolved once
+    // per batch so the loops below pay no per-point dispatch.
+    if (const auto sphere = std::dynamic_pointer_cast<Sphere3>(m_surface))
+    {
+        const double sign =
+            (isNormalFlipped != sphere->isNormalFlipped) ? -1.0 : 1.0;
+
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            const Vector3D pt =
+                sphere->transform.ToLocal(transform.ToLocal(points[i]));
+            results[i] = sign * transform.ToWorldDirection(
+                                    sphere->transform.ToWorldDirection(
+                                        SphereGradientLocal(*sphere, pt)));
+        }
+
+        return;
+    }
+
+    if (const auto box = std::dynamic_pointer_cast<Box3>(m_surface))
+    {
+        const double sign =
+            (isNormalFlipped != box->isNormalFlipped) ? -1.0 : 1.0;
+
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            const Vector3D pt =
+                box->transform.ToLocal(transform.ToLocal(points[i]));
+            results[i] = sign * transform.ToWorldDirection(
+                                    box->transform.ToWorldDirection(
+                                        BoxGradientLocal(*box, pt)));
+        }
+
+        return;
+    }
+
+    if (const auto plane = std::dynamic_pointer_cast<Plane3>(m_surface))
+    {
+        const double sign =
+            (isNormalFlipped != plane->isNormalFlipped) ? -1.0 : 1.0;
+        const Vector3D gradient =
+            sign * transform.ToWorldDirection(
+                       plane->transform.ToWorldDirection(plane->normal));
+
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            results[i] = gradient;
+        }
+
+        return;
+    }
+
+    if (const auto cylinder = std::dynamic_pointer_cast<Cylinder3>(m_surface))
+    {
+        const double sign =
+            (isNormalFlipped != cylinder->isNormalFlipped) ? -1.0 : 1.0;
+
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            const Vector3D pt =
+                cylinder->transform.ToLocal(transform.ToLocal(points[i]));
+            results[i] = sign * transform.ToWorldDirection(
+                                    cylinder->transform.ToWorldDirection(
+                                        CylinderGradientLocal(*cylinder, pt)));
+        }
+
+        return;
+    }
+
+    ImplicitSurface3::Gradient(points, results);
+}
+
 Surface3Ptr SurfaceToImplicit3::GetSurface() const
 {
     return m_surface;
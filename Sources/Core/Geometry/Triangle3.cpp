@@ -87,21 +87,33 @@ Vector3D Triangle3::ClosestPointLocal(const Vector3D& otherPoint) const
     const Vector3D q = t * n + otherPoint;
 
     const Vector3D q01 = (points[1] - points[0]).Cross(q - points[0]);
-    if (n.Dot(q01) < 0)
-    {
-        return ClosestPointOnLine(points[0], points[1], q);
-    }
-
     const Vector3D q12 = (points[2] - points[1]).Cross(q - points[1]);
-    if (n.Dot(q12) < 0)
-    {
-        return ClosestPointOnLine(points[1], points[2], q);
-    }
-
     const Vector3D q02 = (points[0] - points[2]).Cross(q - points[2]);
-    if (n.Dot(q02) < 0)
+
+    if (n.Dot(q01) < 0 || n.Dot(q12) < 0 || n.Dot(q02) < 0)
     {
-        return ClosestPointOnLine(points[0], points[2], q);
+        // The projection falls outside the triangle, so the closest point
+        // lies on the boundary. A vertex region is outside two edges at
+        // once, so take the nearest candidate among all three edges rather
+        // than the first one whose test fails.
+        Vector3D result = ClosestPointOnLine(points[0], points[1], q);
+        double bestDistSq = (result - q).LengthSquared();
+
+        const Vector3D cand12 = ClosestPointOnLine(points[1], points[2], q);
+        const double distSq12 = (cand12 - q).LengthSquared();
+        if (distSq12 < bestDistSq)
+        {
+            result = cand12;
+            bestDistSq = distSq12;
+        }
+
+        const Vector3D cand02 = ClosestPointOnLine(points[0], points[2], q);
+        if ((cand02 - q).LengthSquared() < bestDistSq)
+        {
+            result = cand02;
+        }
+
+        return result;
     }
 
     const double a = Area();
@@ -122,24 +134,35 @@ Vector3D Triangle3::ClosestNormalLocal(const Vector3D& otherPoint) const
     const Vector3D q = t * n + otherPoint;
 
     const Vector3D q01 = (points[1] - points[0]).Cross(q - points[0]);
-    if (n.Dot(q01) < 0)
-    {
-        return ClosestNormalOnLine(points[0], points[1], normals[0], normals[1],
-                                   q);
-    }
-
     const Vector3D q12 = (points[2] - points[1]).Cross(q - points[1]);
-    if (n.Dot(q12) < 0)
-    {
-        return ClosestNormalOnLine(points[1], points[2], normals[1], normals[2],
-                                   q);
-    }
-
     const Vector3D q02 = (points[0] - points[2]).Cross(q - points[2]);
-    if (n.Dot(q02) < 0)
+
+    if (n.Dot(q01) < 0 || n.Dot(q12) < 0 || n.Dot(q02) < 0)
     {
-        return ClosestNormalOnLine(points[0], points[2], normals[0], normals[2],
-                                   q);
+        // Pick the edge whose segment actually carries the closest point,
+        // matching the edge selection in ClosestPointLocal.
+        const Vector3D cand01 = ClosestPointOnLine(points[0], points[1], q);
+        const Vector3D cand12 = ClosestPointOnLine(points[1], points[2], q);
+        const Vector3D cand02 = ClosestPointOnLine(points[0], points[2], q);
+
+        const double distSq01 = (cand01 - q).LengthSquared();
+        const double distSq12 = (cand12 - q).LengthSquared();
+        const double distSq02 = (cand02 - q).LengthSquared();
+
+        if (distSq01 <= distSq12 && distSq01 <= distSq02)
+        {
+            return ClosestNormalOnLine(points[0], points[1], normals[0],
+                                       normals[1], q);
+        }
+
+        if (distSq12 <= distSq02)
+        {
+            return ClosestNormalOnLine(points[1], points[2], normals[1],
+                                       normals[2], q);
+        }
+
+        return ClosestNormalOnLine(points[0], points[2], normals[0],
+                                   normals[2], q);
     }
 
     const double a = Area();
@@ -16,9 +16,15 @@
 #define TINYOBJLOADER_USE_DOUBLE
 #include <tiny_obj_loader.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <numeric>
+#include <sstream>
 #include <utility>
+#include <vector>
 
 namespace CubbyFlow
 {
@@ -83,6 +89,69 @@ std::ostream& operator<<(std::ostream& stream, const Vector3D& v)
     stream << v.x << ' ' << v.y << ' ' << v.z;
     return stream;
 }
+
+//!
+//! \brief Branch-free squared distance from a point to one triangle.
+//!
+//! \p tri points at 9 contiguous floats (three vertices). Instead of the
+//! region-based early-out logic in Triangle3, this evaluates the clamped
+//! projections onto all three edges plus the face interior and takes the
+//! minimum — every candidate is a clamp/select, so the loop over BVH leaf
+//! visits has no data-dependent branches and vectorizes cleanly.
+//!
+inline float TriangleDistanceSquared(const float* tri, float px, float py,
+                                     float pz)
+{
+    const float ax = tri[0], ay = tri[1], az = tri[2];
+    const float bx = tri[3], by = tri[4], bz = tri[5];
+    const float cx = tri[6], cy = tri[7], cz = tri[8];
+
+    const float abx = bx - ax, aby = by - ay, abz = bz - az;
+    const float acx = cx - ax, acy = cy - ay, acz = cz - az;
+    const float apx = px - ax, apy = py - ay, apz = pz - az;
+
+    const auto clamp01 = [](float t) {
+        return std::min(std::max(t, 0.0f), 1.0f);
+    };
+    const auto edgeDistSq = [&](float ex, float ey, float ez, float ox,
+                                float oy, float oz) {
+        // Distance to the segment from (ox,oy,oz) along (ex,ey,ez)
+        const float qx = px - ox, qy = py - oy, qz = pz - oz;
+        const float lenSq = ex * ex + ey * ey + ez * ez;
+        const float t = clamp01(
+            (qx * ex + qy * ey + qz * ez) /
+            std::max(lenSq, std::numeric_limits<float>::min()));
+        const float dx = qx - t * ex, dy = qy - t * ey, dz = qz - t * ez;
+        return dx * dx + dy * dy + dz * dz;
+    };
+
+    float distSq = edgeDistSq(abx, aby, abz, ax, ay, az);
+    distSq = std::min(distSq, edgeDistSq(acx, acy, acz, ax, ay, az));
+    distSq =
+        std::min(distSq, edgeDistSq(cx - bx, cy - by, cz - bz, bx, by, bz));
+
+    // Face interior: valid only when the projected barycentrics are inside;
+    // otherwise one of the edge candidates is already the answer.
+    const float nx = aby * acz - abz * acy;
+    const float ny = abz * acx - abx * acz;
+    const float nz = abx * acy - aby * acx;
+    const float nLenSq = nx * nx + ny * ny + nz * nz;
+
+    const float d00 = abx * abx + aby * aby + abz * abz;
+    const float d01 = abx * acx + aby * acy + abz * acz;
+    const float d11 = acx * acx + acy * acy + acz * acz;
+    const float d20 = apx * abx + apy * aby + apz * abz;
+    const float d21 = apx * acx + apy * acy + apz * acz;
+    const float denom = d00 * d11 - d01 * d01;
+
+    const float v = d11 * d20 - d01 * d21;
+    const float w = d00 * d21 - d01 * d20;
+    const bool inside = (v >= 0.0f) && (w >= 0.0f) && (v + w <= denom) &&
+                        (denom > 0.0f) && (nLenSq > 0.0f);
+
+    const float pn = apx * nx + apy * ny + apz * nz;
+    return inside ? std::min(distSq, pn * pn / nLenSq) : distSq;
+}
 }  // namespace
 
 TriangleMesh3::TriangleMesh3(const Transform3& _transform,
@@ -494,54 +563,80 @@ void TriangleMesh3::Rotate(const QuaternionD& q)
 
 void TriangleMesh3::WriteObj(std::ostream* stream) const
 {
+    // Formats count lines into per-chunk string buffers in parallel, then
+    // flushes the buffers to the stream in order. Formatting dominates the
+    // element-at-a-time writer, so only the final copies stay serial.
+    const auto writeChunked = [stream](size_t count, const auto& formatLine) {
+        const size_t numChunks = std::min(
+            static_cast<size_t>(GetMaxNumberOfThreads()), count / 1024 + 1);
+
+        std::vector<std::string> buffers(numChunks);
+
+        ParallelFor(ZERO_SIZE, numChunks, [&](size_t c) {
+            const size_t begin = count * c / numChunks;
+            const size_t end = count * (c + 1) / numChunks;
+
+            std::ostringstream buffer;
+            for (size_t i = begin; i < end; ++i)
+            {
+                formatLine(buffer, i);
+            }
+
+            buffers[c] = buffer.str();
+        });
+
+        for (const std::string& buffer : buffers)
+        {
+            *stream << buffer;
+        }
+    };
+
     // vertex
-    for (const auto& pt : m_points)
-    {
-        *stream << "v " << pt << std::endl;
-    }
+    writeChunked(m_points.size(), [this](std::ostream& s, size_t i) {
+        s << "v " << m_points[i] << '\n';
+    });
 
     // UV coordinates
-    for (const auto& uv : m_uvs)
-    {
-        *stream << "vt " << uv << std::endl;
-    }
+    writeChunked(m_uvs.size(), [this](std::ostream& s, size_t i) {
+        s << "vt " << m_uvs[i] << '\n';
+    });
 
     // normals
-    for (const auto& n : m_normals)
-    {
-        *stream << "vn " << n << std::endl;
-    }
+    writeChunked(m_normals.size(), [this](std::ostream& s, size_t i) {
+        s << "vn " << m_normals[i] << '\n';
+    });
 
     // faces
     const bool hasUVs = HasUVs();
     const bool hasNormals = HasNormals();
-    for (size_t i = 0; i < NumberOfTriangles(); ++i)
-    {
-        *stream << "f ";
+    writeChunked(NumberOfTriangles(), [&](std::ostream& s, size_t i) {
+        s << "f ";
 
         for (int j = 0; j < 3; ++j)
         {
-            *stream << m_pointIndices[i][j] + 1;
+            s << m_pointIndices[i][j] + 1;
 
             if (hasNormals || hasUVs)
             {
-                *stream << '/';
+                s << '/';
             }
 
             if (hasUVs)
             {
-                *stream << m_uvIndices[i][j] + 1;
+                s << m_uvIndices[i][j] + 1;
             }
 
             if (hasNormals)
             {
-                *stream << '/' << m_normalIndices[i][j] + 1;
+                s << '/' << m_normalIndices[i][j] + 1;
             }
-            *stream << ' ';
+            s << ' ';
         }
 
-        *stream << std::endl;
-    }
+        s << '\n';
+    });
+
+    stream->flush();
 }
 
 bool TriangleMesh3::WriteObj(const std::string& fileName) const
@@ -673,6 +768,313 @@ bool TriangleMesh3::ReadObj(const std::string& fileName)
     return false;
 }
 
+void TriangleMesh3::WritePly(std::ostream* stream) const
+{
+    const bool hasNormals =
+        HasNormals() && NumberOfNormals() == NumberOfPoints();
+    const bool hasUVs = HasUVs() && NumberOfUVs() == NumberOfPoints();
+
+    *stream << "ply\n"
+            << "format binary_little_endian 1.0\n"
+            << "element vertex " << NumberOfPoints() << '\n'
+            << "property float x\n"
+            << "property float y\n"
+            << "property float z\n";
+
+    if (hasNormals)
+    {
+        *stream << "property float nx\n"
+                << "property float ny\n"
+                << "property float nz\n";
+    }
+
+    if (hasUVs)
+    {
+        *stream << "property float u\n"
+                << "property float v\n";
+    }
+
+    *stream << "element face " << NumberOfTriangles() << '\n'
+            << "property list uchar uint vertex_indices\n"
+            << "end_header\n";
+
+    // Pack the vertex payload in parallel and write it in one call
+    const size_t stride = 3 + (hasNormals ? 3 : 0) + (hasUVs ? 2 : 0);
+    std::vector<float> vertexData(NumberOfPoints() * stride);
+
+    ParallelFor(ZERO_SIZE, NumberOfPoints(), [&](size_t i) {
+        float* v = &vertexData[i * stride];
+
+        v[0] = static_cast<float>(m_points[i].x);
+        v[1] = static_cast<float>(m_points[i].y);
+        v[2] = static_cast<float>(m_points[i].z);
+        v += 3;
+
+        if (hasNormals)
+        {
+            v[0] = static_cast<float>(m_normals[i].x);
+            v[1] = static_cast<float>(m_normals[i].y);
+            v[2] = static_cast<float>(m_normals[i].z);
+            v += 3;
+        }
+
+        if (hasUVs)
+        {
+            v[0] = static_cast<float>(m_uvs[i].x);
+            v[1] = static_cast<float>(m_uvs[i].y);
+        }
+    });
+
+    stream->write(reinterpret_cast<const char*>(vertexData.data()),
+                  static_cast<std::streamsize>(vertexData.size() *
+                                               sizeof(float)));
+
+    // Faces: uchar vertex count followed by three uint32 point indices
+    const size_t faceStride = 1 + 3 * sizeof(uint32_t);
+    std::vector<char> faceData(NumberOfTriangles() * faceStride);
+
+    ParallelFor(ZERO_SIZE, NumberOfTriangles(), [&](size_t i) {
+        char* f = &faceData[i * faceStride];
+        f[0] = 3;
+
+        uint32_t indices[3];
+        indices[0] = static_cast<uint32_t>(m_pointIndices[i].x);
+        indices[1] = static_cast<uint32_t>(m_pointIndices[i].y);
+        indices[2] = static_cast<uint32_t>(m_pointIndices[i].z);
+
+        std::memcpy(f + 1, indices, sizeof(indices));
+    });
+
+    stream->write(faceData.data(),
+                  static_cast<std::streamsize>(faceData.size()));
+    stream->flush();
+}
+
+bool TriangleMesh3::WritePly(const std::string& fileName) const
+{
+    std::ofstream file{ fileName.c_str(), std::ios::binary };
+
+    if (file)
+    {
+        WritePly(&file);
+        file.close();
+
+        return true;
+    }
+
+    return false;
+}
+
+bool TriangleMesh3::ReadPly(std::istream* stream)
+{
+    std::string line;
+
+    if (!std::getline(*stream, line) || line != "ply")
+    {
+        return false;
+    }
+
+    if (!std::getline(*stream, line) ||
+        line != "format binary_little_endian 1.0")
+    {
+        return false;
+    }
+
+    size_t numVertices = 0;
+    size_t numFaces = 0;
+    std::vector<std::string> vertexProperties;
+    bool inVertexElement = false;
+    bool hasFaceList = false;
+
+    while (std::getline(*stream, line))
+    {
+        std::istringstream tokens{ line };
+        std::string keyword;
+        tokens >> keyword;
+
+        if (keyword == "comment")
+        {
+            continue;
+        }
+
+        if (keyword == "element")
+        {
+            std::string name;
+            tokens >> name;
+
+            if (name == "vertex")
+            {
+                tokens >> numVertices;
+                inVertexElement = true;
+            }
+            else if (name == "face")
+            {
+                tokens >> numFaces;
+                inVertexElement = false;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else if (keyword == "property")
+        {
+            std::string type;
+            tokens >> type;
+
+            if (type == "list")
+            {
+                hasFaceList = true;
+            }
+            else if (inVertexElement)
+            {
+                if (type != "float")
+                {
+                    return false;
+                }
+
+                std::string name;
+                tokens >> name;
+                vertexProperties.push_back(name);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else if (keyword == "end_header")
+        {
+            break;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // Positions are required; normals and UVs are picked up when present
+    const auto propertyOffset =
+        [&vertexProperties](const std::string& name) -> ssize_t {
+        const auto iter = std::find(vertexProperties.begin(),
+                                    vertexProperties.end(), name);
+        if (iter == vertexProperties.end())
+        {
+            return -1;
+        }
+
+        return std::distance(vertexProperties.begin(), iter);
+    };
+
+    const ssize_t xOffset = propertyOffset("x");
+    const ssize_t nxOffset = propertyOffset("nx");
+    const ssize_t uOffset = propertyOffset("u");
+
+    if (xOffset < 0 || (numFaces > 0 && !hasFaceList))
+    {
+        return false;
+    }
+
+    const size_t stride = vertexProperties.size();
+    std::vector<float> vertexData(numVertices * stride);
+
+    stream->read(reinterpret_cast<char*>(vertexData.data()),
+                 static_cast<std::streamsize>(vertexData.size() *
+                                              sizeof(float)));
+    if (!(*stream))
+    {
+        return false;
+    }
+
+    InvalidateCache();
+
+    for (size_t i = 0; i < numVertices; ++i)
+    {
+        const float* v = &vertexData[i * stride];
+
+        AddPoint({ v[xOffset], v[xOffset + 1], v[xOffset + 2] });
+
+        if (nxOffset >= 0)
+        {
+            AddNormal({ v[nxOffset], v[nxOffset + 1], v[nxOffset + 2] });
+        }
+
+        if (uOffset >= 0)
+        {
+            AddUV({ v[uOffset], v[uOffset + 1] });
+        }
+    }
+
+    for (size_t i = 0; i < numFaces; ++i)
+    {
+        char count = 0;
+        stream->read(&count, 1);
+
+        uint32_t indices[3];
+        if (count != 3 ||
+            !stream->read(reinterpret_cast<char*>(indices), sizeof(indices)))
+        {
+            return false;
+        }
+
+        const Point3UI face{ indices[0], indices[1], indices[2] };
+        AddPointTriangle(face);
+
+        if (nxOffset >= 0)
+        {
+            AddNormalTriangle(face);
+        }
+
+        if (uOffset >= 0)
+        {
+            AddUVTriangle(face);
+        }
+    }
+
+    return true;
+}
+
+bool TriangleMesh3::ReadPly(const std::string& fileName)
+{
+    std::ifstream file{ fileName.c_str(), std::ios::binary };
+
+    if (file)
+    {
+        const bool result = ReadPly(&file);
+        file.close();
+
+        return result;
+    }
+
+    return false;
+}
+
+void TriangleMesh3::SetUseCompactQueryData(bool useCompactQueryData)
+{
+    m_useCompactQueryData = useCompactQueryData;
+
+    if (m_useCompactQueryData)
+    {
+        m_compactInvalidated = true;
+    }
+    else
+    {
+        std::vector<float>{}.swap(m_compactPositions);
+        std::vector<uint32_t>{}.swap(m_compactIndices);
+        std::vector<float>{}.swap(m_compactTriangles);
+    }
+}
+
+bool TriangleMesh3::GetUseCompactQueryData() const
+{
+    return m_useCompactQueryData;
+}
+
+double TriangleMesh3::FastWindingNumber(const Vector3D& point,
+                                        double accuracy) const
+{
+    return GetFastWindingNumber(transform.ToLocal(point), accuracy);
+}
+
 TriangleMesh3::Builder TriangleMesh3::GetBuilder()
 {
     return Builder{};
@@ -681,8 +1083,14 @@ TriangleMesh3::Builder TriangleMesh3::GetBuilder()
 Vector3D TriangleMesh3::ClosestPointLocal(const Vector3D& otherPoint) const
 {
     BuildBVH();
+    BuildCompactQueryData();
 
     const auto distanceFunc = [this](const size_t& triIdx, const Vector3D& pt) {
+        if (m_useCompactQueryData)
+        {
+            return CompactTriangleDistance(triIdx, pt);
+        }
+
         const Triangle3 tri = Triangle(triIdx);
         return tri.ClosestDistance(pt);
     };
@@ -694,13 +1102,26 @@ Vector3D TriangleMesh3::ClosestPointLocal(const Vector3D& otherPoint) const
 double TriangleMesh3::ClosestDistanceLocal(const Vector3D& otherPoint) const
 {
     BuildBVH();
+    BuildCompactQueryData();
 
     const auto distanceFunc = [this](const size_t& triIdx, const Vector3D& pt) {
+        if (m_useCompactQueryData)
+        {
+            return CompactTriangleDistance(triIdx, pt);
+        }
+
         const Triangle3 tri = Triangle(triIdx);
         return tri.ClosestDistance(pt);
     };
 
     const auto queryResult = m_bvh.GetNearestNeighbor(otherPoint, distanceFunc);
+
+    if (m_useCompactQueryData && queryResult.item != nullptr)
+    {
+        // Re-evaluate the winning triangle in double precision.
+        return Triangle(*queryResult.item).ClosestDistance(otherPoint);
+    }
+
     return queryResult.distance;
 }
 
@@ -726,8 +1147,14 @@ BoundingBox3D TriangleMesh3::BoundingBoxLocal() const
 Vector3D TriangleMesh3::ClosestNormalLocal(const Vector3D& otherPoint) const
 {
     BuildBVH();
+    BuildCompactQueryData();
 
     const auto distanceFunc = [this](const size_t& triIdx, const Vector3D& pt) {
+        if (m_useCompactQueryData)
+        {
+            return CompactTriangleDistance(triIdx, pt);
+        }
+
         const Triangle3 tri = Triangle(triIdx);
         return tri.ClosestDistance(pt);
     };
@@ -773,6 +1200,7 @@ void TriangleMesh3::InvalidateCache() const
 {
     m_bvhInvalidated = true;
     m_wnInvalidated = true;
+    m_compactInvalidated = true;
 }
 
 void TriangleMesh3::InvalidateBVH() const
@@ -786,19 +1214,86 @@ void TriangleMesh3::BuildBVH() const
     {
         const size_t nTris = NumberOfTriangles();
 
-        std::vector<size_t> ids(nTris);
         std::vector<BoundingBox3D> bounds(nTris);
-        for (size_t i = 0; i < nTris; ++i)
+        ParallelFor(ZERO_SIZE, nTris,
+                    [&](size_t i) { bounds[i] = Triangle(i).BoundingBox(); });
+
+        // The BVH stores triangle indices, so as long as the triangle count
+        // is unchanged (e.g. only the vertices deformed), refitting the
+        // existing tree over the new bounds stays exact and is far cheaper
+        // than a rebuild. Refit falls back to a rebuild by itself if the
+        // deformation has degraded the tree too much.
+        if (nTris > 0 && nTris == m_bvhBuiltTriangleCount)
+        {
+            m_bvh.Refit(bounds);
+        }
+        else
         {
-            ids[i] = i;
-            bounds[i] = Triangle(i).BoundingBox();
+            std::vector<size_t> ids(nTris);
+            std::iota(ids.begin(), ids.end(), ZERO_SIZE);
+
+            m_bvh.BuildParallel(ids, bounds);
+            m_bvhBuiltTriangleCount = nTris;
         }
 
-        m_bvh.Build(ids, bounds);
         m_bvhInvalidated = false;
     }
 }
 
+void TriangleMesh3::BuildCompactQueryData() const
+{
+    if (!m_useCompactQueryData || !m_compactInvalidated)
+    {
+        return;
+    }
+
+    const size_t nPoints = NumberOfPoints();
+    const size_t nTris = NumberOfTriangles();
+
+    m_compactPositions.resize(3 * nPoints);
+    ParallelFor(ZERO_SIZE, nPoints, [&](size_t i) {
+        const Vector3D& pt = m_points[i];
+        m_compactPositions[3 * i] = static_cast<float>(pt.x);
+        m_compactPositions[3 * i + 1] = static_cast<float>(pt.y);
+        m_compactPositions[3 * i + 2] = static_cast<float>(pt.z);
+    });
+
+    m_compactIndices.resize(3 * nTris);
+    ParallelFor(ZERO_SIZE, nTris, [&](size_t i) {
+        const Point3UI& face = m_pointIndices[i];
+        m_compactIndices[3 * i] = static_cast<uint32_t>(face.x);
+        m_compactIndices[3 * i + 1] = static_cast<uint32_t>(face.y);
+        m_compactIndices[3 * i + 2] = static_cast<uint32_t>(face.z);
+    });
+
+    m_compactTriangles.resize(9 * nTris);
+    ParallelFor(ZERO_SIZE, nTris, [&](size_t i) {
+        const Point3UI& face = m_pointIndices[i];
+        float* dst = &m_compactTriangles[9 * i];
+
+        const size_t corners[3] = { face.x, face.y, face.z };
+        for (int j = 0; j < 3; ++j)
+        {
+            const Vector3D& pt = m_points[corners[j]];
+            dst[3 * j] = static_cast<float>(pt.x);
+            dst[3 * j + 1] = static_cast<float>(pt.y);
+            dst[3 * j + 2] = static_cast<float>(pt.z);
+        }
+    });
+
+    m_compactInvalidated = false;
+}
+
+double TriangleMesh3::CompactTriangleDistance(size_t triIdx,
+                                              const Vector3D& pt) const
+{
+    const float distSq = TriangleDistanceSquared(
+        &m_compactTriangles[9 * triIdx], static_cast<float>(pt.x),
+        static_cast<float>(pt.y), static_cast<float>(pt.z));
+
+    return std::sqrt(static_cast<double>(distSq));
+}
+
 void TriangleMesh3::BuildWindingNumbers() const
 {
     // Barill et al., Fast Winding Numbers for Soups and Clouds,
@@ -902,7 +1397,7 @@ double TriangleMesh3::GetFastWindingNumber(const Vector3D& q,
     {
         if (m_bvh.IsLeaf(rootNodeIndex))
         {
-            // Case: q is nearby; use direct sum for tree��s elements
+            // Case: q is nearby; use direct sum for tree��s elements
             const auto iter = m_bvh.GetItemOfNode(rootNodeIndex);
             return GetWindingNumber(q, *iter) * INV_FOUR_PI_DOUBLE;
         }
@@ -0,0 +1,579 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Geometry/TriangleMeshDecimation.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <unordered_set>
+#include <vector>
+
+namespace CubbyFlow
+{
+namespace
+{
+constexpr size_t INVALID_EDGE = std::numeric_limits<size_t>::max();
+
+//! Symmetric 4x4 error quadric: E(v) = v^T A v + 2 b.v + c.
+struct Quadric
+{
+    double a00 = 0.0, a01 = 0.0, a02 = 0.0;
+    double a11 = 0.0, a12 = 0.0, a22 = 0.0;
+    Vector3D b;
+    double c = 0.0;
+
+    void Add(const Quadric& other)
+    {
+        a00 += other.a00;
+        a01 += other.a01;
+        a02 += other.a02;
+        a11 += other.a11;
+        a12 += other.a12;
+        a22 += other.a22;
+        b += other.b;
+        c += other.c;
+    }
+
+    //! Adds the area-weighted plane quadric of the plane (n, d).
+    void AddPlane(const Vector3D& n, double d, double weight)
+    {
+        a00 += weight * n.x * n.x;
+        a01 += weight * n.x * n.y;
+        a02 += weight * n.x * n.z;
+        a11 += weight * n.y * n.y;
+        a12 += weight * n.y * n.z;
+        a22 += weight * n.z * n.z;
+        b += (weight * d) * n;
+        c += weight * d * d;
+    }
+
+    [[nodiscard]] double Evaluate(const Vector3D& v) const
+    {
+        return v.x * (a00 * v.x + a01 * v.y + a02 * v.z) +
+               v.y * (a01 * v.x + a11 * v.y + a12 * v.z) +
+               v.z * (a02 * v.x + a12 * v.y + a22 * v.z) + 2.0 * b.Dot(v) + c;
+    }
+};
+
+uint64_t MakeEdgeKey(size_t v0, size_t v1)
+{
+    const auto lo = static_cast<uint64_t>(std::min(v0, v1));
+    const auto hi = static_cast<uint64_t>(std::max(v0, v1));
+
+    return (lo << 32) | hi;
+}
+
+//! Triangle normal scaled by twice the area.
+Vector3D TriangleAreaNormal(const Vector3D& p0, const Vector3D& p1,
+                            const Vector3D& p2)
+{
+    return (p1 - p0).Cross(p2 - p0);
+}
+
+//! SplitMix64 finalizer; used as a deterministic tie-break so that equal
+//! collapse costs (flat regions!) still yield a dense matching instead of
+//! cascading toward the lowest edge indices.
+uint64_t MixEdgeKey(uint64_t key)
+{
+    key += 0x9e3779b97f4a7c15ULL;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+
+    return key ^ (key >> 31);
+}
+}  // namespace
+
+void DecimateTriangleMesh3(TriangleMesh3* mesh,
+                           size_t targetNumberOfTriangles,
+                           size_t maxIterations)
+{
+    const size_t numPoints = mesh->NumberOfPoints();
+    if (mesh->NumberOfTriangles() <= targetNumberOfTriangles || numPoints == 0)
+    {
+        return;
+    }
+
+    std::vector<Vector3D> positions(numPoints);
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+        positions[i] = mesh->Point(i);
+    }
+
+    std::vector<Point3UI> tris(mesh->NumberOfTriangles());
+    for (size_t i = 0; i < tris.size(); ++i)
+    {
+        tris[i] = mesh->PointIndex(i);
+    }
+
+    // Per-vertex quadrics from the area-weighted face planes. They are
+    // accumulated across collapses (Qa += Qb) rather than rebuilt.
+    std::vector<Quadric> quadrics(numPoints);
+    for (const Point3UI& tri : tris)
+    {
+        const Vector3D areaNormal = TriangleAreaNormal(
+            positions[tri.x], positions[tri.y], positions[tri.z]);
+        const double doubleArea = areaNormal.Length();
+        if (doubleArea <= std::numeric_limits<double>::epsilon())
+        {
+            continue;
+        }
+
+        const Vector3D n = areaNormal / doubleArea;
+        const double d = -n.Dot(positions[tri.x]);
+        const double w = 0.5 * doubleArea;
+
+        quadrics[tri.x].AddPlane(n, d, w);
+        quadrics[tri.y].AddPlane(n, d, w);
+        quadrics[tri.z].AddPlane(n, d, w);
+    }
+
+    std::vector<size_t> remap(numPoints);
+    std::iota(remap.begin(), remap.end(), ZERO_SIZE);
+
+    // Edges whose collapse failed the link or flip test. They would fail
+    // identically every round while blocking their endpoints, so they are
+    // taken out of the running for good.
+    std::unordered_set<uint64_t> banned;
+
+    for (size_t iter = 0;
+         iter < maxIterations && tris.size() > targetNumberOfTriangles; ++iter)
+    {
+        // Unique edge list; edges seen by exactly one triangle are open
+        // boundary edges and pin their endpoints.
+        std::vector<uint64_t> rawKeys;
+        rawKeys.reserve(3 * tris.size());
+        for (const Point3UI& tri : tris)
+        {
+            rawKeys.push_back(MakeEdgeKey(tri.x, tri.y));
+            rawKeys.push_back(MakeEdgeKey(tri.y, tri.z));
+            rawKeys.push_back(MakeEdgeKey(tri.z, tri.x));
+        }
+        std::sort(rawKeys.begin(), rawKeys.end());
+
+        std::vector<uint64_t> edgeKeys;
+        std::vector<char> pinned(numPoints, 0);
+        edgeKeys.reserve(rawKeys.size());
+        for (size_t i = 0; i < rawKeys.size();)
+        {
+            size_t run = i + 1;
+            while (run < rawKeys.size() && rawKeys[run] == rawKeys[i])
+            {
+                ++run;
+            }
+
+            edgeKeys.push_back(rawKeys[i]);
+            if (run - i == 1)
+            {
+                pinned[rawKeys[i] >> 32] = 1;
+                pinned[rawKeys[i] & 0xffffffffULL] = 1;
+            }
+
+            i = run;
+        }
+
+        const size_t numEdges = edgeKeys.size();
+
+        // Score each edge by the combined endpoint quadric, evaluated at
+        // both endpoints and the midpoint.
+        std::vector<double> costs(numEdges);
+        std::vector<Vector3D> targets(numEdges);
+        ParallelFor(ZERO_SIZE, numEdges, [&](size_t e) {
+            const auto a = static_cast<size_t>(edgeKeys[e] >> 32);
+            const auto b = static_cast<size_t>(edgeKeys[e] & 0xffffffffULL);
+
+            if (pinned[a] != 0 || pinned[b] != 0 ||
+                banned.find(edgeKeys[e]) != banned.end())
+            {
+                costs[e] = std::numeric_limits<double>::max();
+                return;
+            }
+
+            Quadric q = quadrics[a];
+            q.Add(quadrics[b]);
+
+            const Vector3D mid = 0.5 * (positions[a] + positions[b]);
+            const double errA = q.Evaluate(positions[a]);
+            const double errB = q.Evaluate(positions[b]);
+            const double errMid = q.Evaluate(mid);
+
+            if (errMid <= errA && errMid <= errB)
+            {
+                costs[e] = errMid;
+                targets[e] = mid;
+            }
+            else if (errA <= errB)
+            {
+                costs[e] = errA;
+                targets[e] = positions[a];
+            }
+            else
+            {
+                costs[e] = errB;
+                targets[e] = positions[b];
+            }
+        });
+
+        // Lock-free independent set: relax each vertex toward its cheapest
+        // incident edge with a CAS min, then keep the edges that won both
+        // endpoints. Those edges form a matching, so the collapses below
+        // touch disjoint vertices.
+        std::unique_ptr<std::atomic<size_t>[]> bestEdge(
+            new std::atomic<size_t>[numPoints]);
+        ParallelFor(ZERO_SIZE, numPoints, [&](size_t i) {
+            bestEdge[i].store(INVALID_EDGE, std::memory_order_relaxed);
+        });
+
+        const auto isBetter = [&costs, &edgeKeys](size_t e1, size_t e2) {
+            if (costs[e1] != costs[e2])
+            {
+                return costs[e1] < costs[e2];
+            }
+
+            const uint64_t h1 = MixEdgeKey(edgeKeys[e1]);
+            const uint64_t h2 = MixEdgeKey(edgeKeys[e2]);
+
+            return h1 < h2 || (h1 == h2 && e1 < e2);
+        };
+
+        ParallelFor(ZERO_SIZE, numEdges, [&](size_t e) {
+            if (costs[e] == std::numeric_limits<double>::max())
+            {
+                return;
+            }
+
+            const size_t endPoints[2] = {
+                static_cast<size_t>(edgeKeys[e] >> 32),
+                static_cast<size_t>(edgeKeys[e] & 0xffffffffULL)
+            };
+
+            for (const size_t v : endPoints)
+            {
+                size_t cur = bestEdge[v].load(std::memory_order_relaxed);
+                while ((cur == INVALID_EDGE || isBetter(e, cur)) &&
+                       !bestEdge[v].compare_exchange_weak(
+                           cur, e, std::memory_order_relaxed))
+                {
+                }
+            }
+        });
+
+        // An edge is matched when it won both of its endpoints.
+        std::vector<char> matched(numEdges, 0);
+        ParallelFor(ZERO_SIZE, numEdges, [&](size_t e) {
+            const auto a = static_cast<size_t>(edgeKeys[e] >> 32);
+            const auto b = static_cast<size_t>(edgeKeys[e] & 0xffffffffULL);
+
+            matched[e] =
+                (costs[e] != std::numeric_limits<double>::max() &&
+                 bestEdge[a].load(std::memory_order_relaxed) == e &&
+                 bestEdge[b].load(std::memory_order_relaxed) == e)
+                    ? 1
+                    : 0;
+        });
+
+        // Vertex-to-triangle adjacency for the flip test.
+        std::vector<size_t> adjOffsets(numPoints + 1, 0);
+        for (const Point3UI& tri : tris)
+        {
+            ++adjOffsets[tri.x + 1];
+            ++adjOffsets[tri.y + 1];
+            ++adjOffsets[tri.z + 1];
+        }
+        for (size_t i = 0; i < numPoints; ++i)
+        {
+            adjOffsets[i + 1] += adjOffsets[i];
+        }
+        std::vector<size_t> adjTris(adjOffsets[numPoints]);
+        {
+            std::vector<size_t> cursor(adjOffsets.begin(),
+                                       adjOffsets.end() - 1);
+            for (size_t t = 0; t < tris.size(); ++t)
+            {
+                adjTris[cursor[tris[t].x]++] = t;
+                adjTris[cursor[tris[t].y]++] = t;
+                adjTris[cursor[tris[t].z]++] = t;
+            }
+        }
+
+        // Validation pass (read-only): enforce the link condition so the
+        // collapse cannot create fins or duplicate triangles, then accept
+        // the cheapest of the three candidate targets that does not flip
+        // any surviving triangle around either endpoint. Neighbors are
+        // evaluated at their pre-round positions.
+        std::vector<char> valid(numEdges, 0);
+        std::vector<char> failed(numEdges, 0);
+        ParallelFor(ZERO_SIZE, numEdges, [&](size_t e) {
+            if (matched[e] == 0)
+            {
+                return;
+            }
+
+            const auto a = static_cast<size_t>(edgeKeys[e] >> 32);
+            const auto b = static_cast<size_t>(edgeKeys[e] & 0xffffffffULL);
+
+            // Link condition: the common neighbors of a and b must all come
+            // from triangles that contain the edge itself.
+            std::vector<size_t> aNeighbors;
+            size_t numDyingTris = 0;
+            for (size_t s = adjOffsets[a]; s < adjOffsets[a + 1]; ++s)
+            {
+                const Point3UI& tri = tris[adjTris[s]];
+                const size_t idx[3] = { tri.x, tri.y, tri.z };
+
+                bool hasB = false;
+                for (const size_t i : idx)
+                {
+                    hasB |= (i == b);
+                }
+                numDyingTris += hasB ? 1 : 0;
+
+                for (const size_t i : idx)
+                {
+                    if (i != a && i != b)
+                    {
+                        aNeighbors.push_back(i);
+                    }
+                }
+            }
+            std::sort(aNeighbors.begin(), aNeighbors.end());
+            aNeighbors.erase(
+                std::unique(aNeighbors.begin(), aNeighbors.end()),
+                aNeighbors.end());
+
+            std::vector<size_t> bNeighbors;
+            for (size_t s = adjOffsets[b]; s < adjOffsets[b + 1]; ++s)
+            {
+                const Point3UI& tri = tris[adjTris[s]];
+                for (const size_t i : { tri.x, tri.y, tri.z })
+                {
+                    if (i != a && i != b)
+                    {
+                        bNeighbors.push_back(i);
+                    }
+                }
+            }
+            std::sort(bNeighbors.begin(), bNeighbors.end());
+            bNeighbors.erase(
+                std::unique(bNeighbors.begin(), bNeighbors.end()),
+                bNeighbors.end());
+
+            // Defer to any higher-priority matched edge whose endpoint sits
+            // in this edge's one-ring: such collapses touch overlapping
+            // triangle fans, and applying both in one round could pinch the
+            // surface even though each passes its own checks.
+            for (const std::vector<size_t>* ring : { &aNeighbors, &bNeighbors })
+            {
+                for (const size_t v : *ring)
+                {
+                    const size_t other =
+                        bestEdge[v].load(std::memory_order_relaxed);
+                    if (other != INVALID_EDGE && other != e &&
+                        matched[other] != 0 && isBetter(other, e))
+                    {
+                        return;
+                    }
+                }
+            }
+
+            size_t numCommon = 0;
+            for (const size_t i : bNeighbors)
+            {
+                if (std::binary_search(aNeighbors.begin(), aNeighbors.end(),
+                                       i))
+                {
+                    ++numCommon;
+                }
+            }
+            // Every common neighbor must be the third vertex of a triangle
+            // that dies with the edge; anything else pinches the surface.
+            if (numCommon != numDyingTris)
+            {
+                failed[e] = 1;
+                return;
+            }
+
+            const auto flips = [&](const Vector3D& target) {
+                for (const size_t v : { a, b })
+                {
+                    for (size_t s = adjOffsets[v]; s < adjOffsets[v + 1]; ++s)
+                    {
+                        const Point3UI& tri = tris[adjTris[s]];
+                        const size_t idx[3] = { tri.x, tri.y, tri.z };
+
+                        bool hasA = false, hasB = false;
+                        for (const size_t i : idx)
+                        {
+                            hasA |= (i == a);
+                            hasB |= (i == b);
+                        }
+                        if (hasA && hasB)
+                        {
+                            // The triangle dies with the collapse.
+                            continue;
+                        }
+
+                        Vector3D oldPos[3], newPos[3];
+                        for (int i = 0; i < 3; ++i)
+                        {
+                            oldPos[i] = positions[idx[i]];
+                            newPos[i] = (idx[i] == a || idx[i] == b)
+                                            ? target
+                                            : positions[idx[i]];
+                        }
+
+                        const Vector3D nOld = TriangleAreaNormal(
+                            oldPos[0], oldPos[1], oldPos[2]);
+                        const Vector3D nNew = TriangleAreaNormal(
+                            newPos[0], newPos[1], newPos[2]);
+                        if (nOld.Dot(nNew) <= 0.0)
+                        {
+                            return true;
+                        }
+                    }
+                }
+
+                return false;
+            };
+
+            Quadric q = quadrics[a];
+            q.Add(quadrics[b]);
+
+            Vector3D candidates[3] = { 0.5 * (positions[a] + positions[b]),
+                                       positions[a], positions[b] };
+            double errors[3] = { q.Evaluate(candidates[0]),
+                                 q.Evaluate(candidates[1]),
+                                 q.Evaluate(candidates[2]) };
+            size_t order[3] = { 0, 1, 2 };
+            std::sort(order, order + 3, [&errors](size_t l, size_t r) {
+                return errors[l] < errors[r];
+            });
+
+            for (const size_t c : order)
+            {
+                if (!flips(candidates[c]))
+                {
+                    targets[e] = candidates[c];
+                    valid[e] = 1;
+                    return;
+                }
+            }
+
+            failed[e] = 1;
+        });
+
+        size_t numNewBans = 0;
+        for (size_t e = 0; e < numEdges; ++e)
+        {
+            if (failed[e] != 0)
+            {
+                banned.insert(edgeKeys[e]);
+                ++numNewBans;
+            }
+        }
+
+        // Application pass: the matching guarantees disjoint writes.
+        std::atomic<size_t> numCollapsed{ 0 };
+        ParallelFor(ZERO_SIZE, numEdges, [&](size_t e) {
+            if (valid[e] == 0)
+            {
+                return;
+            }
+
+            const auto a = static_cast<size_t>(edgeKeys[e] >> 32);
+            const auto b = static_cast<size_t>(edgeKeys[e] & 0xffffffffULL);
+
+            positions[a] = targets[e];
+            quadrics[a].Add(quadrics[b]);
+            remap[b] = a;
+            numCollapsed.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        if (numCollapsed.load() == 0 && numNewBans == 0)
+        {
+            break;
+        }
+
+        // Remap surviving triangles and drop the degenerate ones.
+        size_t writeIdx = 0;
+        for (Point3UI& tri : tris)
+        {
+            tri.x = remap[tri.x];
+            tri.y = remap[tri.y];
+            tri.z = remap[tri.z];
+
+            if (tri.x != tri.y && tri.y != tri.z && tri.z != tri.x)
+            {
+                tris[writeIdx++] = tri;
+            }
+        }
+        tris.resize(writeIdx);
+
+        // Matching collapses are one level deep; reset for the next round.
+        std::iota(remap.begin(), remap.end(), ZERO_SIZE);
+    }
+
+    // Compact the surviving vertices and rebuild the mesh with smooth
+    // area-weighted normals, matching the marching-cubes output layout.
+    std::vector<size_t> newIndex(numPoints, INVALID_EDGE);
+    size_t numNewPoints = 0;
+    for (const Point3UI& tri : tris)
+    {
+        for (const size_t v : { tri.x, tri.y, tri.z })
+        {
+            if (newIndex[v] == INVALID_EDGE)
+            {
+                newIndex[v] = numNewPoints++;
+            }
+        }
+    }
+
+    std::vector<Vector3D> newPositions(numNewPoints);
+    for (size_t v = 0; v < numPoints; ++v)
+    {
+        if (newIndex[v] != INVALID_EDGE)
+        {
+            newPositions[newIndex[v]] = positions[v];
+        }
+    }
+
+    std::vector<Vector3D> newNormals(numNewPoints);
+    for (Point3UI& tri : tris)
+    {
+        tri.x = newIndex[tri.x];
+        tri.y = newIndex[tri.y];
+        tri.z = newIndex[tri.z];
+
+        const Vector3D areaNormal = TriangleAreaNormal(
+            newPositions[tri.x], newPositions[tri.y], newPositions[tri.z]);
+        newNormals[tri.x] += areaNormal;
+        newNormals[tri.y] += areaNormal;
+        newNormals[tri.z] += areaNormal;
+    }
+
+    mesh->Clear();
+    for (size_t v = 0; v < numNewPoints; ++v)
+    {
+        mesh->AddPoint(newPositions[v]);
+
+        const double len = newNormals[v].Length();
+        mesh->AddNormal(len > 0.0 ? newNormals[v] / len
+                                  : Vector3D{ 0.0, 1.0, 0.0 });
+    }
+    for (const Point3UI& tri : tris)
+    {
+        mesh->AddPointTriangle(tri);
+        mesh->AddNormalTriangle(tri);
+    }
+}
+}  // namespace CubbyFlow
@@ -35,4 +35,26 @@ void TriangleMeshToSDF(const TriangleMesh3& mesh, ScalarGrid3* sdf)
         (*sdf)(i, j, k) = sd;
     });
 }
+
+void TriangleMeshToSDF(const TriangleMesh3& mesh, ScalarGrid3* sdf,
+                       double windingNumberAccuracy)
+{
+    const Size3 size = sdf->GetDataSize();
+    if (size.x * size.y * size.z == 0)
+    {
+        return;
+    }
+
+    const auto pos = sdf->GetDataPosition();
+    mesh.UpdateQueryEngine();
+    sdf->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D p = pos(i, j, k);
+        const double d = mesh.ClosestDistance(p);
+        const bool isInside =
+            mesh.isNormalFlipped ==
+            !(mesh.FastWindingNumber(p, windingNumberAccuracy) > 0.5);
+
+        (*sdf)(i, j, k) = isInside ? -d : d;
+    });
+}
 }  // namespace CubbyFlow
@@ -0,0 +1,123 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Grid/AdaptiveScalarGrid3.hpp>
+
+#include <cmath>
+
+namespace CubbyFlow
+{
+AdaptiveScalarGrid3::AdaptiveScalarGrid3(const ScalarField3& source,
+                                         const BoundingBox3D& domain,
+                                         size_t maxDepth,
+                                         double refineThreshold)
+{
+    Build(source, domain, maxDepth, refineThreshold);
+}
+
+void AdaptiveScalarGrid3::Build(const ScalarField3& source,
+                                const BoundingBox3D& domain, size_t maxDepth,
+                                double refineThreshold)
+{
+    m_tree.Build(
+        domain, maxDepth,
+        [&source](const Vector3D& x) { return source.Sample(x); },
+        [](const double& a, const double& b) { return std::fabs(a - b); },
+        refineThreshold);
+    m_hasData = true;
+}
+
+double AdaptiveScalarGrid3::Sample(const Vector3D& x) const
+{
+    if (!m_hasData)
+    {
+        return 0.0;
+    }
+
+    return m_tree.Sample(x);
+}
+
+Vector3D AdaptiveScalarGrid3::Gradient(const Vector3D& x) const
+{
+    if (!m_hasData)
+    {
+        return Vector3D{ 0, 0, 0 };
+    }
+
+    const BoundingBox3D& domain = m_tree.GetBoundingBox();
+    const double cells =
+        static_cast<double>(size_t{ 1 } << m_tree.GetMaxDepth());
+    const Vector3D h = (domain.upperCorner - domain.lowerCorner) / cells;
+
+    const double left = m_tree.Sample(x - Vector3D{ 0.5 * h.x, 0, 0 });
+    const double right = m_tree.Sample(x + Vector3D{ 0.5 * h.x, 0, 0 });
+    const double down = m_tree.Sample(x - Vector3D{ 0, 0.5 * h.y, 0 });
+    const double up = m_tree.Sample(x + Vector3D{ 0, 0.5 * h.y, 0 });
+    const double back = m_tree.Sample(x - Vector3D{ 0, 0, 0.5 * h.z });
+    const double front = m_tree.Sample(x + Vector3D{ 0, 0, 0.5 * h.z });
+
+    return Vector3D{ (right - left) / h.x, (up - down) / h.y,
+                     (front - back) / h.z };
+}
+
+const AdaptiveGrid3<double>& AdaptiveScalarGrid3::GetTree() const
+{
+    return m_tree;
+}
+
+AdaptiveScalarGrid3::Builder AdaptiveScalarGrid3::GetBuilder()
+{
+    return Builder{};
+}
+
+AdaptiveScalarGrid3::Builder& AdaptiveScalarGrid3::Builder::WithSourceField(
+    const ScalarField3Ptr& source)
+{
+    m_source = source;
+    return *this;
+}
+
+AdaptiveScalarGrid3::Builder& AdaptiveScalarGrid3::Builder::WithBoundingBox(
+    const BoundingBox3D& domain)
+{
+    m_domain = domain;
+    return *this;
+}
+
+AdaptiveScalarGrid3::Builder& AdaptiveScalarGrid3::Builder::WithMaxDepth(
+    size_t maxDepth)
+{
+    m_maxDepth = maxDepth;
+    return *this;
+}
+
+AdaptiveScalarGrid3::Builder&
+AdaptiveScalarGrid3::Builder::WithRefinementThreshold(double threshold)
+{
+    m_refineThreshold = threshold;
+    return *this;
+}
+
+AdaptiveScalarGrid3 AdaptiveScalarGrid3::Builder::Build() const
+{
+    if (m_source == nullptr)
+    {
+        return AdaptiveScalarGrid3{};
+    }
+
+    return AdaptiveScalarGrid3{ *m_source, m_domain, m_maxDepth,
+                                m_refineThreshold };
+}
+
+AdaptiveScalarGrid3Ptr AdaptiveScalarGrid3::Builder::MakeShared() const
+{
+    return std::make_shared<AdaptiveScalarGrid3>(Build());
+}
+}  // namespace CubbyFlow
@@ -0,0 +1,106 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Grid/AdaptiveVectorGrid3.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace CubbyFlow
+{
+AdaptiveVectorGrid3::AdaptiveVectorGrid3(const VectorField3& source,
+                                         const BoundingBox3D& domain,
+                                         size_t maxDepth,
+                                         double refineThreshold)
+{
+    Build(source, domain, maxDepth, refineThreshold);
+}
+
+void AdaptiveVectorGrid3::Build(const VectorField3& source,
+                                const BoundingBox3D& domain, size_t maxDepth,
+                                double refineThreshold)
+{
+    m_tree.Build(
+        domain, maxDepth,
+        [&source](const Vector3D& x) { return source.Sample(x); },
+        [](const Vector3D& a, const Vector3D& b) {
+            // Refine on the largest component difference so a single
+            // fast-varying component is enough to trigger subdivision.
+            return std::max({ std::fabs(a.x - b.x), std::fabs(a.y - b.y),
+                              std::fabs(a.z - b.z) });
+        },
+        refineThreshold);
+    m_hasData = true;
+}
+
+Vector3D AdaptiveVectorGrid3::Sample(const Vector3D& x) const
+{
+    if (!m_hasData)
+    {
+        return Vector3D{ 0, 0, 0 };
+    }
+
+    return m_tree.Sample(x);
+}
+
+const AdaptiveGrid3<Vector3D>& AdaptiveVectorGrid3::GetTree() const
+{
+    return m_tree;
+}
+
+AdaptiveVectorGrid3::Builder AdaptiveVectorGrid3::GetBuilder()
+{
+    return Builder{};
+}
+
+AdaptiveVectorGrid3::Builder& AdaptiveVectorGrid3::Builder::WithSourceField(
+    const VectorField3Ptr& source)
+{
+    m_source = source;
+    return *this;
+}
+
+AdaptiveVectorGrid3::Builder& AdaptiveVectorGrid3::Builder::WithBoundingBox(
+    const BoundingBox3D& domain)
+{
+    m_domain = domain;
+    return *this;
+}
+
+AdaptiveVectorGrid3::Builder& AdaptiveVectorGrid3::Builder::WithMaxDepth(
+    size_t maxDepth)
+{
+    m_maxDepth = maxDepth;
+    return *this;
+}
+
+AdaptiveVectorGrid3::Builder&
+AdaptiveVectorGrid3::Builder::WithRefinementThreshold(double threshold)
+{
+    m_refineThreshold = threshold;
+    return *this;
+}
+
+AdaptiveVectorGrid3 AdaptiveVectorGrid3::Builder::Build() const
+{
+    if (m_source == nullptr)
+    {
+        return AdaptiveVectorGrid3{};
+    }
+
+    return AdaptiveVectorGrid3{ *m_source, m_domain, m_maxDepth,
+                                m_refineThreshold };
+}
+
+AdaptiveVectorGrid3Ptr AdaptiveVectorGrid3::Builder::MakeShared() const
+{
+    return std::make_shared<AdaptiveVectorGrid3>(Build());
+}
+}  // namespace CubbyFlow
@@ -26,6 +26,7 @@ const Vector3D& CollocatedVectorGrid3::operator()(size_t i, size_t j,
 
 Vector3D& CollocatedVectorGrid3::operator()(size_t i, size_t j, size_t k)
 {
+    DetachData();
     return m_data(i, j, k);
 }
 
@@ -129,6 +130,7 @@ std::function<Vector3D(const Vector3D&)> CollocatedVectorGrid3::Sampler() const
 
 VectorGrid3::VectorDataAccessor CollocatedVectorGrid3::GetDataAccessor()
 {
+    DetachData();
     return m_data.Accessor();
 }
 
@@ -191,6 +193,19 @@ void CollocatedVectorGrid3::OnResize(const Size3& resolution,
     ResetSampler();
 }
 
+void CollocatedVectorGrid3::DetachData()
+{
+    const Vector3D* shared = m_data.ConstAccessor().data();
+
+    // The non-const data() detaches the copy-on-write buffer; the cached
+    // sampler still points at the previously shared storage if the buffer
+    // actually moved.
+    if (m_data.data() != shared)
+    {
+        ResetSampler();
+    }
+}
+
 void CollocatedVectorGrid3::ResetSampler()
 {
     m_linearSampler =
@@ -217,6 +232,8 @@ void CollocatedVectorGrid3::SetData(const std::vector<double>& data)
     assert(3 * GetDataSize().x * GetDataSize().y * GetDataSize().z ==
            data.size());
 
+    DetachData();
+
     size_t cnt = 0;
 
     m_data.ForEachIndex([&](const size_t i, const size_t j, const size_t k) {
@@ -0,0 +1,100 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Grid/GridActiveRegion3.hpp>
+
+#include <cmath>
+
+namespace CubbyFlow
+{
+void GridActiveRegion3::BuildNarrowBand(const ConstArrayAccessor3<double>& sdf,
+                                        double bandWidth)
+{
+    Build(sdf.size(), [&](size_t i, size_t j, size_t k) {
+        return std::abs(sdf(i, j, k)) <= bandWidth;
+    });
+}
+
+void GridActiveRegion3::AddHalo()
+{
+    if (m_tiles.size() == Size3{ 0, 0, 0 })
+    {
+        return;
+    }
+
+    Array3<char> dilated{ m_tileCount, 0 };
+
+    ParallelFor(
+        ZERO_SIZE, m_tileCount.x, ZERO_SIZE, m_tileCount.y, ZERO_SIZE,
+        m_tileCount.z, [&](size_t ti, size_t tj, size_t tk) {
+            const size_t iBegin = (ti > 0) ? ti - 1 : 0;
+            const size_t jBegin = (tj > 0) ? tj - 1 : 0;
+            const size_t kBegin = (tk > 0) ? tk - 1 : 0;
+            const size_t iEnd = std::min(ti + 2, m_tileCount.x);
+            const size_t jEnd = std::min(tj + 2, m_tileCount.y);
+            const size_t kEnd = std::min(tk + 2, m_tileCount.z);
+
+            char active = 0;
+
+            for (size_t k = kBegin; k < kEnd && active == 0; ++k)
+            {
+                for (size_t j = jBegin; j < jEnd && active == 0; ++j)
+                {
+                    for (size_t i = iBegin; i < iEnd; ++i)
+                    {
+                        if (m_tiles(i, j, k) != 0)
+                        {
+                            active = 1;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            dilated(ti, tj, tk) = active;
+        });
+
+    m_tiles.Swap(dilated);
+}
+
+bool GridActiveRegion3::IsCellActive(size_t i, size_t j, size_t k) const
+{
+    return m_tiles(i / TILE_SIZE, j / TILE_SIZE, k / TILE_SIZE) != 0;
+}
+
+bool GridActiveRegion3::IsTileActive(size_t ti, size_t tj, size_t tk) const
+{
+    return m_tiles(ti, tj, tk) != 0;
+}
+
+size_t GridActiveRegion3::GetNumberOfActiveTiles() const
+{
+    size_t count = 0;
+
+    m_tiles.ForEach([&count](char tile) {
+        if (tile != 0)
+        {
+            ++count;
+        }
+    });
+
+    return count;
+}
+
+const Size3& GridActiveRegion3::GetTileCount() const
+{
+    return m_tileCount;
+}
+
+const Size3& GridActiveRegion3::GetResolution() const
+{
+    return m_resolution;
+}
+}  // namespace CubbyFlow
@@ -284,13 +284,18 @@ void GridSystemData2::Deserialize(const std::vector<uint8_t>& buffer)
     m_advectableScalarDataList.clear();
     m_advectableVectorDataList.clear();
 
-    DeserializeGrid(gsd->scalarData(), Factory::BuildScalarGrid2,
-                    &m_scalarDataList);
-    DeserializeGrid(gsd->vectorData(), Factory::BuildVectorGrid2,
-                    &m_vectorDataList);
-    DeserializeGrid(gsd->advectableScalarData(), Factory::BuildScalarGrid2,
+    const auto buildScalar = [](const char* name) {
+        return Factory::BuildScalarGrid2(name);
+    };
+    const auto buildVector = [](const char* name) {
+        return Factory::BuildVectorGrid2(name);
+    };
+
+    DeserializeGrid(gsd->scalarData(), buildScalar, &m_scalarDataList);
+    DeserializeGrid(gsd->vectorData(), buildVector, &m_vectorDataList);
+    DeserializeGrid(gsd->advectableScalarData(), buildScalar,
                     &m_advectableScalarDataList);
-    DeserializeGrid(gsd->advectableVectorData(), Factory::BuildVectorGrid2,
+    DeserializeGrid(gsd->advectableVectorData(), buildVector,
                     &m_advectableVectorDataList);
 
     m_velocityIdx = static_cast<size_t>(gsd->velocityIdx());
@@ -8,9 +8,11 @@
 // personal capacity and are not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <Core/Grid/CollocatedVectorGrid3.hpp>
 #include <Core/Grid/GridSystemData3.hpp>
 #include <Core/Utils/Factory.hpp>
 #include <Core/Utils/FlatbuffersHelper.hpp>
+#include <Core/Utils/Parallel.hpp>
 
 #include <Flatbuffers/generated/GridSystemData3_generated.h>
 
@@ -62,6 +64,8 @@ GridSystemData3::GridSystemData3(const GridSystemData3& other)
     assert(m_velocity != nullptr);
 
     m_velocityIdx = 0;
+
+    m_derivedFields = other.m_derivedFields;
 }
 
 GridSystemData3& GridSystemData3::operator=(const GridSystemData3& other)
@@ -94,6 +98,8 @@ GridSystemData3& GridSystemData3::operator=(const GridSystemData3& other)
 
     m_velocityIdx = 0;
 
+    m_derivedFields = other.m_derivedFields;
+
     return *this;
 }
 
@@ -121,6 +127,11 @@ void GridSystemData3::Resize(const Size3& resolution,
     {
         data->Resize(resolution, gridSpacing, origin);
     }
+
+    // Stale double buffers would otherwise be swapped into the live grids;
+    // they are rebuilt on demand.
+    m_advectableScalarShadowList.clear();
+    m_advectableVectorShadowList.clear();
 }
 
 Size3 GridSystemData3::GetResolution() const
@@ -211,6 +222,46 @@ const VectorGrid3Ptr& GridSystemData3::GetAdvectableVectorDataAt(
     return m_advectableVectorDataList[idx];
 }
 
+const ScalarGrid3Ptr& GridSystemData3::GetAdvectableScalarShadowAt(
+    size_t idx) const
+{
+    if (m_advectableScalarShadowList.size() <
+        m_advectableScalarDataList.size())
+    {
+        m_advectableScalarShadowList.resize(m_advectableScalarDataList.size());
+    }
+
+    ScalarGrid3Ptr& shadow = m_advectableScalarShadowList[idx];
+    const ScalarGrid3Ptr& data = m_advectableScalarDataList[idx];
+
+    if (shadow == nullptr || shadow->Resolution() != data->Resolution())
+    {
+        shadow = data->Clone();
+    }
+
+    return shadow;
+}
+
+const VectorGrid3Ptr& GridSystemData3::GetAdvectableVectorShadowAt(
+    size_t idx) const
+{
+    if (m_advectableVectorShadowList.size() <
+        m_advectableVectorDataList.size())
+    {
+        m_advectableVectorShadowList.resize(m_advectableVectorDataList.size());
+    }
+
+    VectorGrid3Ptr& shadow = m_advectableVectorShadowList[idx];
+    const VectorGrid3Ptr& data = m_advectableVectorDataList[idx];
+
+    if (shadow == nullptr || shadow->Resolution() != data->Resolution())
+    {
+        shadow = data->Clone();
+    }
+
+    return shadow;
+}
+
 size_t GridSystemData3::GetNumberOfScalarData() const
 {
     return m_scalarDataList.size();
@@ -284,17 +335,435 @@ void GridSystemData3::Deserialize(const std::vector<uint8_t>& buffer)
     m_advectableScalarDataList.clear();
     m_advectableVectorDataList.clear();
 
-    DeserializeGrid(gsd->scalarData(), Factory::BuildScalarGrid3,
-                    &m_scalarDataList);
-    DeserializeGrid(gsd->vectorData(), Factory::BuildVectorGrid3,
-                    &m_vectorDataList);
-    DeserializeGrid(gsd->advectableScalarData(), Factory::BuildScalarGrid3,
+    const auto buildScalar = [](const char* name) {
+        return Factory::BuildScalarGrid3(name);
+    };
+    const auto buildVector = [](const char* name) {
+        return Factory::BuildVectorGrid3(name);
+    };
+
+    DeserializeGrid(gsd->scalarData(), buildScalar, &m_scalarDataList);
+    DeserializeGrid(gsd->vectorData(), buildVector, &m_vectorDataList);
+    DeserializeGrid(gsd->advectableScalarData(), buildScalar,
                     &m_advectableScalarDataList);
-    DeserializeGrid(gsd->advectableVectorData(), Factory::BuildVectorGrid3,
+    DeserializeGrid(gsd->advectableVectorData(), buildVector,
                     &m_advectableVectorDataList);
 
     m_velocityIdx = static_cast<size_t>(gsd->velocityIdx());
     m_velocity = std::dynamic_pointer_cast<FaceCenteredGrid3>(
         m_advectableVectorDataList[m_velocityIdx]);
 }
-}  // namespace CubbyFlow
\ No newline at end of file
+
+const char* GridSystemData3::GetMemoryStatsName() const
+{
+    return "GridSystemData3";
+}
+
+void GridSystemData3::ReportMemoryUsage(
+    std::vector<MemoryUsageRecord>* records) const
+{
+    const auto scalarBytes = [](const std::vector<ScalarGrid3Ptr>& grids) {
+        size_t bytes = 0;
+        for (const ScalarGrid3Ptr& grid : grids)
+        {
+            const Size3 size = grid->GetDataSize();
+            bytes += size.x * size.y * size.z * sizeof(double);
+        }
+        return bytes;
+    };
+    const auto vectorBytes = [](const std::vector<VectorGrid3Ptr>& grids) {
+        size_t bytes = 0;
+        for (const VectorGrid3Ptr& grid : grids)
+        {
+            if (const auto faceCentered =
+                    std::dynamic_pointer_cast<FaceCenteredGrid3>(grid))
+            {
+                const Size3 u = faceCentered->GetUSize();
+                const Size3 v = faceCentered->GetVSize();
+                const Size3 w = faceCentered->GetWSize();
+                bytes += (u.x * u.y * u.z + v.x * v.y * v.z +
+                          w.x * w.y * w.z) *
+                         sizeof(double);
+            }
+            else if (const auto collocated =
+                         std::dynamic_pointer_cast<CollocatedVectorGrid3>(
+                             grid))
+            {
+                const Size3 size = collocated->GetDataSize();
+                bytes += size.x * size.y * size.z * sizeof(Vector3D);
+            }
+        }
+        return bytes;
+    };
+
+    // The velocity grid lives in the advectable vector data list, so it is
+    // covered by that record.
+    records->push_back(MemoryUsageRecord{ "scalarData",
+                                          scalarBytes(m_scalarDataList) });
+    records->push_back(MemoryUsageRecord{ "vectorData",
+                                          vectorBytes(m_vectorDataList) });
+    records->push_back(
+        MemoryUsageRecord{ "advectableScalarData",
+                           scalarBytes(m_advectableScalarDataList) });
+    records->push_back(
+        MemoryUsageRecord{ "advectableVectorData",
+                           vectorBytes(m_advectableVectorDataList) });
+}
+void GridSystemData3::SetTileChangeListener(const TileChangeListener& listener)
+{
+    m_tileChangeListener = listener;
+    m_tileSnapshotValid = false;
+}
+
+bool GridSystemData3::HasTileChangeListener() const
+{
+    return static_cast<bool>(m_tileChangeListener);
+}
+
+double GridSystemData3::GetTileTrackingEpsilon() const
+{
+    return m_tileTrackingEpsilon;
+}
+
+void GridSystemData3::SetTileTrackingEpsilon(double epsilon)
+{
+    m_tileTrackingEpsilon = std::max(epsilon, 0.0);
+}
+
+namespace
+{
+//! Copies the given accessor into the (reused) snapshot array.
+void CopyFieldSnapshot(const ConstArrayAccessor3<double>& data,
+                       Array3<double>* snapshot)
+{
+    snapshot->Resize(data.size());
+    std::copy(data.data(), data.data() + data.size().x * data.size().y *
+              data.size().z, snapshot->begin());
+}
+
+//! Marks every tile that owns a sample which moved beyond the epsilon.
+//! Tiles own the cell range [t * DIRTY_TILE_SIZE, (t + 1) * DIRTY_TILE_SIZE)
+//! plus one overlap sample, so staggered and vertex-centered layouts report
+//! border changes to every touching tile.
+void MarkDirtyTiles(const ConstArrayAccessor3<double>& data,
+                    const Array3<double>& snapshot, double epsilon,
+                    const Size3& numTiles, std::vector<char>* dirty)
+{
+    constexpr size_t T = GridSystemData3::DIRTY_TILE_SIZE;
+    const Size3 ds = data.size();
+
+    ParallelFor(ZERO_SIZE, numTiles.z, [&](size_t tz) {
+        const size_t kBegin = std::min(tz * T, ds.z);
+        const size_t kEnd = std::min((tz + 1) * T + 1, ds.z);
+
+        for (size_t ty = 0; ty < numTiles.y; ++ty)
+        {
+            const size_t jBegin = std::min(ty * T, ds.y);
+            const size_t jEnd = std::min((ty + 1) * T + 1, ds.y);
+
+            for (size_t tx = 0; tx < numTiles.x; ++tx)
+            {
+                const size_t flatTile =
+                    tx + numTiles.x * (ty + numTiles.y * tz);
+                if ((*dirty)[flatTile] != 0)
+                {
+                    continue;
+                }
+
+                const size_t iBegin = std::min(tx * T, ds.x);
+                const size_t iEnd = std::min((tx + 1) * T + 1, ds.x);
+
+                for (size_t k = kBegin; k < kEnd && (*dirty)[flatTile] == 0;
+                     ++k)
+                {
+                    for (size_t j = jBegin;
+                         j < jEnd && (*dirty)[flatTile] == 0; ++j)
+                    {
+                        for (size_t i = iBegin; i < iEnd; ++i)
+                        {
+                            if (std::fabs(data(i, j, k) -
+                                          snapshot(i, j, k)) > epsilon)
+                            {
+                                (*dirty)[flatTile] = 1;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+//! Gathers the dirty tiles into a (z, y, x) scan-ordered list.
+std::vector<Point3UI> CollectDirtyTiles(const std::vector<char>& dirty,
+                                        const Size3& numTiles)
+{
+    std::vector<Point3UI> tiles;
+
+    for (size_t tz = 0; tz < numTiles.z; ++tz)
+    {
+        for (size_t ty = 0; ty < numTiles.y; ++ty)
+        {
+            for (size_t tx = 0; tx < numTiles.x; ++tx)
+            {
+                if (dirty[tx + numTiles.x * (ty + numTiles.y * tz)] != 0)
+                {
+                    tiles.push_back(Point3UI{ tx, ty, tz });
+                }
+            }
+        }
+    }
+
+    return tiles;
+}
+}  // namespace
+
+void GridSystemData3::CaptureTileSnapshot()
+{
+    if (!HasTileChangeListener())
+    {
+        return;
+    }
+
+    CopyFieldSnapshot(m_velocity->GetUConstAccessor(), &m_uSnapshot);
+    CopyFieldSnapshot(m_velocity->GetVConstAccessor(), &m_vSnapshot);
+    CopyFieldSnapshot(m_velocity->GetWConstAccessor(), &m_wSnapshot);
+
+    m_scalarSnapshotList.resize(m_advectableScalarDataList.size());
+    for (size_t i = 0; i < m_advectableScalarDataList.size(); ++i)
+    {
+        CopyFieldSnapshot(
+            m_advectableScalarDataList[i]->GetConstDataAccessor(),
+            &m_scalarSnapshotList[i]);
+    }
+
+    m_tileSnapshotValid = true;
+}
+
+void GridSystemData3::EmitTileChangeEvents()
+{
+    if (!HasTileChangeListener() || !m_tileSnapshotValid)
+    {
+        return;
+    }
+
+    m_tileSnapshotValid = false;
+
+    const Size3 numTiles{
+        (m_resolution.x + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE,
+        (m_resolution.y + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE,
+        (m_resolution.z + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE
+    };
+    const size_t totalTiles = numTiles.x * numTiles.y * numTiles.z;
+
+    const bool shapesMatch =
+        m_uSnapshot.size() == m_velocity->GetUSize() &&
+        m_vSnapshot.size() == m_velocity->GetVSize() &&
+        m_wSnapshot.size() == m_velocity->GetWSize();
+
+    std::vector<char> velocityDirty(totalTiles, 0);
+    std::vector<char> scalarDirty(totalTiles, 0);
+
+    if (shapesMatch)
+    {
+        MarkDirtyTiles(m_velocity->GetUConstAccessor(), m_uSnapshot,
+                       m_tileTrackingEpsilon, numTiles, &velocityDirty);
+        MarkDirtyTiles(m_velocity->GetVConstAccessor(), m_vSnapshot,
+                       m_tileTrackingEpsilon, numTiles, &velocityDirty);
+        MarkDirtyTiles(m_velocity->GetWConstAccessor(), m_wSnapshot,
+                       m_tileTrackingEpsilon, numTiles, &velocityDirty);
+
+        for (size_t i = 0; i < m_advectableScalarDataList.size(); ++i)
+        {
+            if (i >= m_scalarSnapshotList.size() ||
+                m_scalarSnapshotList[i].size() !=
+                    m_advectableScalarDataList[i]->GetDataSize())
+            {
+                std::fill(scalarDirty.begin(), scalarDirty.end(), 1);
+                break;
+            }
+
+            MarkDirtyTiles(
+                m_advectableScalarDataList[i]->GetConstDataAccessor(),
+                m_scalarSnapshotList[i], m_tileTrackingEpsilon, numTiles,
+                &scalarDirty);
+        }
+    }
+    else
+    {
+        // The system was resized since the capture; report everything.
+        std::fill(velocityDirty.begin(), velocityDirty.end(), 1);
+        std::fill(scalarDirty.begin(), scalarDirty.end(), 1);
+    }
+
+    m_tileChangeListener(CollectDirtyTiles(velocityDirty, numTiles),
+                         CollectDirtyTiles(scalarDirty, numTiles));
+}
+
+void GridSystemData3::AddDerivedScalarField(const std::string& name,
+                                            const DerivedScalarFieldFunc& func)
+{
+    m_derivedFields.push_back({ name, func, nullptr });
+}
+
+void GridSystemData3::AddDerivedVectorField(const std::string& name,
+                                            const DerivedVectorFieldFunc& func)
+{
+    m_derivedFields.push_back({ name, nullptr, func });
+}
+
+void GridSystemData3::AddStandardDerivedFields()
+{
+    AddDerivedScalarField(
+        "speed", [](const GridSystemData3& data,
+                    const CellCenteredScalarGrid3Ptr& output) {
+            const FaceCenteredGrid3& vel = *data.GetVelocity();
+
+            auto acc = output->GetDataAccessor();
+            output->ParallelForEachDataPointIndex(
+                [&](size_t i, size_t j, size_t k) {
+                    acc(i, j, k) = vel.ValueAtCellCenter(i, j, k).Length();
+                });
+        });
+
+    AddDerivedVectorField(
+        "vorticity", [](const GridSystemData3& data,
+                        const CellCenteredVectorGrid3Ptr& output) {
+            data.GetVelocity()->CurlGrid(output->GetDataAccessor());
+        });
+
+    AddDerivedScalarField(
+        "qCriterion", [](const GridSystemData3& data,
+                         const CellCenteredScalarGrid3Ptr& output) {
+            const FaceCenteredGrid3& vel = *data.GetVelocity();
+            const Size3 res = data.GetResolution();
+            const Vector3D h = data.GetGridSpacing();
+
+            Array3<Vector3D> v{ res };
+            v.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+                v(i, j, k) = vel.ValueAtCellCenter(i, j, k);
+            });
+
+            auto acc = output->GetDataAccessor();
+            output->ParallelForEachDataPointIndex([&](size_t i, size_t j,
+                                                      size_t k) {
+                const size_t im = (i > 0) ? i - 1 : i;
+                const size_t ip = (i + 1 < res.x) ? i + 1 : i;
+                const size_t jm = (j > 0) ? j - 1 : j;
+                const size_t jp = (j + 1 < res.y) ? j + 1 : j;
+                const size_t km = (k > 0) ? k - 1 : k;
+                const size_t kp = (k + 1 < res.z) ? k + 1 : k;
+
+                // Velocity gradient columns by central differences
+                // (one-sided at the boundary, zero on degenerate axes).
+                const Vector3D dvdx =
+                    (ip > im) ? (v(ip, j, k) - v(im, j, k)) /
+                                    (static_cast<double>(ip - im) * h.x)
+                              : Vector3D{};
+                const Vector3D dvdy =
+                    (jp > jm) ? (v(i, jp, k) - v(i, jm, k)) /
+                                    (static_cast<double>(jp - jm) * h.y)
+                              : Vector3D{};
+                const Vector3D dvdz =
+                    (kp > km) ? (v(i, j, kp) - v(i, j, km)) /
+                                    (static_cast<double>(kp - km) * h.z)
+                              : Vector3D{};
+
+                const double grad[3][3] = { { dvdx.x, dvdy.x, dvdz.x },
+                                            { dvdx.y, dvdy.y, dvdz.y },
+                                            { dvdx.z, dvdy.z, dvdz.z } };
+
+                // Q = 0.5 * (|Omega|^2 - |S|^2) with S and Omega the
+                // symmetric and antisymmetric parts of the gradient.
+                double sNorm = 0.0;
+                double oNorm = 0.0;
+                for (int r = 0; r < 3; ++r)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        const double s = 0.5 * (grad[r][c] + grad[c][r]);
+                        const double o = 0.5 * (grad[r][c] - grad[c][r]);
+
+                        sNorm += s * s;
+                        oNorm += o * o;
+                    }
+                }
+
+                acc(i, j, k) = 0.5 * (oNorm - sNorm);
+            });
+        });
+}
+
+std::vector<std::string> GridSystemData3::GetDerivedFieldNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(m_derivedFields.size());
+
+    for (const auto& field : m_derivedFields)
+    {
+        names.push_back(field.name);
+    }
+
+    return names;
+}
+
+CellCenteredScalarGrid3Ptr GridSystemData3::ComputeDerivedScalarField(
+    const std::string& name) const
+{
+    for (const auto& field : m_derivedFields)
+    {
+        if (field.name == name && field.scalarFunc)
+        {
+            auto grid = std::make_shared<CellCenteredScalarGrid3>(
+                m_resolution, m_gridSpacing, m_origin);
+            field.scalarFunc(*this, grid);
+            return grid;
+        }
+    }
+
+    return nullptr;
+}
+
+CellCenteredVectorGrid3Ptr GridSystemData3::ComputeDerivedVectorField(
+    const std::string& name) const
+{
+    for (const auto& field : m_derivedFields)
+    {
+        if (field.name == name && field.vectorFunc)
+        {
+            auto grid = std::make_shared<CellCenteredVectorGrid3>(
+                m_resolution, m_gridSpacing, m_origin);
+            field.vectorFunc(*this, grid);
+            return grid;
+        }
+    }
+
+    return nullptr;
+}
+
+void GridSystemData3::SerializeDerivedFields(std::vector<uint8_t>* buffer) const
+{
+    GridSystemData3 snapshot{ m_resolution, m_gridSpacing, m_origin };
+
+    for (const auto& field : m_derivedFields)
+    {
+        if (field.scalarFunc)
+        {
+            auto grid = std::make_shared<CellCenteredScalarGrid3>(
+                m_resolution, m_gridSpacing, m_origin);
+            field.scalarFunc(*this, grid);
+            snapshot.m_scalarDataList.push_back(grid);
+        }
+        else
+        {
+            auto grid = std::make_shared<CellCenteredVectorGrid3>(
+                m_resolution, m_gridSpacing, m_origin);
+            field.vectorFunc(*this, grid);
+            snapshot.m_vectorDataList.push_back(grid);
+        }
+    }
+
+    snapshot.Serialize(buffer);
+}
+}  // namespace CubbyFlow
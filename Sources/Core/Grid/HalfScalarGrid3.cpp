@@ -0,0 +1,184 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Grid/HalfScalarGrid3.hpp>
+#include <Core/Math/MathUtils.hpp>
+#include <Core/Utils/HalfFloat.hpp>
+
+#include <algorithm>
+
+namespace CubbyFlow
+{
+HalfScalarGrid3::HalfScalarGrid3(const Size3& resolution,
+                                 const Vector3D& gridSpacing,
+                                 const Vector3D& origin, double initialValue)
+{
+    Resize(resolution, gridSpacing, origin, initialValue);
+}
+
+HalfScalarGrid3::HalfScalarGrid3(const ScalarGrid3& other)
+{
+    Fill(other);
+}
+
+void HalfScalarGrid3::Resize(const Size3& resolution,
+                             const Vector3D& gridSpacing,
+                             const Vector3D& origin, double initialValue)
+{
+    m_resolution = resolution;
+    m_gridSpacing = gridSpacing;
+    m_origin = origin;
+    m_data.Resize(resolution, DoubleToHalf(initialValue));
+}
+
+const Size3& HalfScalarGrid3::Resolution() const
+{
+    return m_resolution;
+}
+
+const Vector3D& HalfScalarGrid3::GridSpacing() const
+{
+    return m_gridSpacing;
+}
+
+const Vector3D& HalfScalarGrid3::Origin() const
+{
+    return m_origin;
+}
+
+Vector3D HalfScalarGrid3::GetDataOrigin() const
+{
+    return m_origin + 0.5 * m_gridSpacing;
+}
+
+double HalfScalarGrid3::operator()(size_t i, size_t j, size_t k) const
+{
+    return HalfToDouble(m_data(i, j, k));
+}
+
+void HalfScalarGrid3::SetValue(size_t i, size_t j, size_t k, double value)
+{
+    m_data(i, j, k) = DoubleToHalf(value);
+}
+
+void HalfScalarGrid3::Fill(const ScalarGrid3& other)
+{
+    // Adopt the source's data point layout so both grids sample the same
+    // positions: the data points sit at GetDataOrigin() regardless of
+    // whether the source is cell- or vertex-centered.
+    m_resolution = other.GetDataSize();
+    m_gridSpacing = other.GridSpacing();
+    m_origin = other.GetDataOrigin() - 0.5 * m_gridSpacing;
+    m_data.Resize(m_resolution);
+
+    ConstArrayAccessor3<double> src = other.GetConstDataAccessor();
+    m_data.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        m_data(i, j, k) = DoubleToHalf(src(i, j, k));
+    });
+}
+
+ConstArrayAccessor3<uint16_t> HalfScalarGrid3::GetRawDataAccessor() const
+{
+    return m_data.ConstAccessor();
+}
+
+double HalfScalarGrid3::Sample(const Vector3D& x) const
+{
+    const ssize_t iSize = static_cast<ssize_t>(m_resolution.x);
+    const ssize_t jSize = static_cast<ssize_t>(m_resolution.y);
+    const ssize_t kSize = static_cast<ssize_t>(m_resolution.z);
+
+    if (iSize == 0 || jSize == 0 || kSize == 0)
+    {
+        return 0.0;
+    }
+
+    // Mirrors LinearArraySampler3, but decodes the eight half-precision
+    // taps on load so the trilinear blend itself runs in full precision.
+    const Vector3D dataOrigin = GetDataOrigin();
+    const Vector3D normalizedX{ (x.x - dataOrigin.x) / m_gridSpacing.x,
+                                (x.y - dataOrigin.y) / m_gridSpacing.y,
+                                (x.z - dataOrigin.z) / m_gridSpacing.z };
+
+    ssize_t i, j, k;
+    double fx, fy, fz;
+
+    GetBarycentric(normalizedX.x, 0, iSize - 1, &i, &fx);
+    GetBarycentric(normalizedX.y, 0, jSize - 1, &j, &fy);
+    GetBarycentric(normalizedX.z, 0, kSize - 1, &k, &fz);
+
+    const size_t ip1 = std::min(static_cast<size_t>(i + 1),
+                                static_cast<size_t>(iSize - 1));
+    const size_t jp1 = std::min(static_cast<size_t>(j + 1),
+                                static_cast<size_t>(jSize - 1));
+    const size_t kp1 = std::min(static_cast<size_t>(k + 1),
+                                static_cast<size_t>(kSize - 1));
+
+    const size_t si = static_cast<size_t>(i);
+    const size_t sj = static_cast<size_t>(j);
+    const size_t sk = static_cast<size_t>(k);
+
+    return TriLerp(HalfToDouble(m_data(si, sj, sk)),
+                   HalfToDouble(m_data(ip1, sj, sk)),
+                   HalfToDouble(m_data(si, jp1, sk)),
+                   HalfToDouble(m_data(ip1, jp1, sk)),
+                   HalfToDouble(m_data(si, sj, kp1)),
+                   HalfToDouble(m_data(ip1, sj, kp1)),
+                   HalfToDouble(m_data(si, jp1, kp1)),
+                   HalfToDouble(m_data(ip1, jp1, kp1)), fx, fy, fz);
+}
+
+HalfScalarGrid3::Builder HalfScalarGrid3::GetBuilder()
+{
+    return Builder{};
+}
+
+HalfScalarGrid3::Builder& HalfScalarGrid3::Builder::WithResolution(
+    const Size3& resolution)
+{
+    m_resolution = resolution;
+    return *this;
+}
+
+HalfScalarGrid3::Builder& HalfScalarGrid3::Builder::WithGridSpacing(
+    const Vector3D& gridSpacing)
+{
+    m_gridSpacing = gridSpacing;
+    return *this;
+}
+
+HalfScalarGrid3::Builder& HalfScalarGrid3::Builder::WithOrigin(
+    const Vector3D& gridOrigin)
+{
+    m_gridOrigin = gridOrigin;
+    return *this;
+}
+
+HalfScalarGrid3::Builder& HalfScalarGrid3::Builder::WithInitialValue(
+    double initialValue)
+{
+    m_initialValue = initialValue;
+    return *this;
+}
+
+HalfScalarGrid3 HalfScalarGrid3::Builder::Build() const
+{
+    return HalfScalarGrid3{ m_resolution, m_gridSpacing, m_gridOrigin,
+                            m_initialValue };
+}
+
+HalfScalarGrid3Ptr HalfScalarGrid3::Builder::MakeShared() const
+{
+    return std::shared_ptr<HalfScalarGrid3>(
+        new HalfScalarGrid3{ m_resolution, m_gridSpacing, m_gridOrigin,
+                             m_initialValue },
+        [](HalfScalarGrid3* obj) { delete obj; });
+}
+}  // namespace CubbyFlow
@@ -0,0 +1,92 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Grid/MarkerBitset3.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <bitset>
+
+namespace CubbyFlow
+{
+namespace
+{
+// Every cell slot set to air (01) -- also the fill value for the unused
+// tail slots of the last word, so whole-word queries need no masking.
+constexpr uint64_t ALL_AIR_WORD = 0x5555555555555555ULL;
+
+// The low bit of every two-bit cell slot.
+constexpr uint64_t LOW_BITS = 0x5555555555555555ULL;
+}  // namespace
+
+void MarkerBitset3::Build(const ConstArrayAccessor3<char>& markers)
+{
+    m_size = markers.size();
+    m_numberOfCells = m_size.x * m_size.y * m_size.z;
+
+    const size_t numberOfWords =
+        (m_numberOfCells + CELLS_PER_WORD - 1) / CELLS_PER_WORD;
+    m_words.resize(numberOfWords);
+
+    ParallelFor(ZERO_SIZE, numberOfWords, [&](size_t wordIdx) {
+        uint64_t word = ALL_AIR_WORD;
+        const size_t begin = wordIdx * CELLS_PER_WORD;
+        const size_t end =
+            std::min(begin + CELLS_PER_WORD, m_numberOfCells);
+
+        for (size_t cellIdx = begin; cellIdx < end; ++cellIdx)
+        {
+            const size_t shift = 2 * (cellIdx - begin);
+            word &= ~(uint64_t{ 3 } << shift);
+            word |= static_cast<uint64_t>(markers[cellIdx]) << shift;
+        }
+
+        m_words[wordIdx] = word;
+    });
+}
+
+const Size3& MarkerBitset3::size() const
+{
+    return m_size;
+}
+
+size_t MarkerBitset3::GetNumberOfWords() const
+{
+    return m_words.size();
+}
+
+char MarkerBitset3::operator()(size_t i, size_t j, size_t k) const
+{
+    return At((k * m_size.y + j) * m_size.x + i);
+}
+
+char MarkerBitset3::At(size_t cellIdx) const
+{
+    const uint64_t word = m_words[cellIdx / CELLS_PER_WORD];
+    const size_t shift = 2 * (cellIdx % CELLS_PER_WORD);
+    return static_cast<char>((word >> shift) & 3);
+}
+
+bool MarkerBitset3::IsAllAirWord(size_t wordIdx) const
+{
+    return m_words[wordIdx] == ALL_AIR_WORD;
+}
+
+size_t MarkerBitset3::CountFluidCells() const
+{
+    // A cell is fluid (00) iff both of its bits are clear.
+    size_t count = 0;
+    for (const uint64_t word : m_words)
+    {
+        count += std::bitset<64>{ ~(word | (word >> 1)) & LOW_BITS }.count();
+    }
+
+    return count;
+}
+}  // namespace CubbyFlow
@@ -8,6 +8,7 @@
 // personal capacity and are not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <Core/Array/ArrayUtils.hpp>
 #include <Core/FDM/FDMUtils.hpp>
 #include <Core/Grid/ScalarGrid3.hpp>
 #include <Core/Utils/FlatbuffersHelper.hpp>
@@ -68,6 +69,7 @@ const double& ScalarGrid3::operator()(size_t i, size_t j, size_t k) const
 
 double& ScalarGrid3::operator()(size_t i, size_t j, size_t k)
 {
+    DetachData();
     return m_data(i, j, k);
 }
 
@@ -81,6 +83,18 @@ double ScalarGrid3::LaplacianAtDataPoint(size_t i, size_t j, size_t k) const
     return Laplacian3(m_data.ConstAccessor(), GridSpacing(), i, j, k);
 }
 
+void ScalarGrid3::GradientGrid(Array3<Vector3D>* result) const
+{
+    result->Resize(GetDataSize());
+    GradientGrid3(m_data.ConstAccessor(), GridSpacing(), result->Accessor());
+}
+
+void ScalarGrid3::LaplacianGrid(Array3<double>* result) const
+{
+    result->Resize(GetDataSize());
+    LaplacianGrid3(m_data.ConstAccessor(), GridSpacing(), result->Accessor());
+}
+
 double ScalarGrid3::Sample(const Vector3D& x) const
 {
     return m_sampler(x);
@@ -127,6 +141,7 @@ double ScalarGrid3::Laplacian(const Vector3D& x) const
 
 ScalarGrid3::ScalarDataAccessor ScalarGrid3::GetDataAccessor()
 {
+    DetachData();
     return m_data.Accessor();
 }
 
@@ -147,6 +162,17 @@ ScalarGrid3::DataPositionFunc ScalarGrid3::GetDataPosition() const
 
 void ScalarGrid3::Fill(double value, ExecutionPolicy policy)
 {
+    DetachData();
+
+    if (policy == ExecutionPolicy::Parallel)
+    {
+        // The data layout is contiguous, so let the bulk kernel stream the
+        // constant straight through memory instead of walking indices.
+        SetRange1(m_data.Width() * m_data.Height() * m_data.Depth(), value,
+                  &m_data);
+        return;
+    }
+
     ParallelFor(
         ZERO_SIZE, m_data.Width(), ZERO_SIZE, m_data.Height(), ZERO_SIZE,
         m_data.Depth(),
@@ -159,6 +185,8 @@ void ScalarGrid3::Fill(double value, ExecutionPolicy policy)
 void ScalarGrid3::Fill(const std::function<double(const Vector3D&)>& func,
                        ExecutionPolicy policy)
 {
+    DetachData();
+
     DataPositionFunc pos = GetDataPosition();
 
     ParallelFor(
@@ -215,9 +243,54 @@ void ScalarGrid3::Deserialize(const std::vector<uint8_t>& buffer)
            FlatbuffersToCubbyFlow(*fbsGrid->gridSpacing()),
            FlatbuffersToCubbyFlow(*fbsGrid->origin()));
 
+    // Copy straight into the (reused) data array; no staging buffer.
+    DetachData();
+
     const flatbuffers::Vector<double>* data = fbsGrid->data();
-    std::vector<double> gridData(data->size());
-    std::copy(data->begin(), data->end(), gridData.begin());
+    assert(data->size() == m_data.size().x * m_data.size().y *
+                               m_data.size().z);
+    std::copy(data->begin(), data->end(), m_data.begin());
+}
+
+void ScalarGrid3::SerializeCompressed(std::vector<uint8_t>* buffer,
+                                      GridDataQuantization quantization) const
+{
+    const Size3 res = Resolution();
+    const Vector3D gs = GridSpacing();
+    const Vector3D org = Origin();
+
+    const uint64_t resolution[3] = { res.x, res.y, res.z };
+    const double geometry[6] = { gs.x, gs.y, gs.z, org.x, org.y, org.z };
+
+    std::vector<double> gridData;
+    GetData(&gridData);
+
+    std::vector<uint8_t> payload;
+    CompressGridData(gridData, quantization, &payload);
+
+    buffer->resize(sizeof(resolution) + sizeof(geometry) + payload.size());
+    memcpy(buffer->data(), resolution, sizeof(resolution));
+    memcpy(buffer->data() + sizeof(resolution), geometry, sizeof(geometry));
+    memcpy(buffer->data() + sizeof(resolution) + sizeof(geometry),
+           payload.data(), payload.size());
+}
+
+void ScalarGrid3::DeserializeCompressed(const std::vector<uint8_t>& buffer)
+{
+    uint64_t resolution[3];
+    double geometry[6];
+
+    memcpy(resolution, buffer.data(), sizeof(resolution));
+    memcpy(geometry, buffer.data() + sizeof(resolution), sizeof(geometry));
+
+    Resize(Size3{ resolution[0], resolution[1], resolution[2] },
+           Vector3D{ geometry[0], geometry[1], geometry[2] },
+           Vector3D{ geometry[3], geometry[4], geometry[5] });
+
+    std::vector<double> gridData;
+    DecompressGridData(
+        buffer.data() + sizeof(resolution) + sizeof(geometry),
+        buffer.size() - sizeof(resolution) - sizeof(geometry), &gridData);
 
     SetData(gridData);
 }
@@ -239,6 +312,19 @@ void ScalarGrid3::SetScalarGrid(const ScalarGrid3& other)
     ResetSampler();
 }
 
+void ScalarGrid3::DetachData()
+{
+    const double* shared = m_data.ConstAccessor().data();
+
+    // The non-const data() detaches the copy-on-write buffer; the cached
+    // sampler still points at the previously shared storage if the buffer
+    // actually moved.
+    if (m_data.data() != shared)
+    {
+        ResetSampler();
+    }
+}
+
 void ScalarGrid3::ResetSampler()
 {
     m_linearSampler =
@@ -258,6 +344,7 @@ void ScalarGrid3::SetData(const std::vector<double>& data)
 {
     assert(GetDataSize().x * GetDataSize().y * GetDataSize().z == data.size());
 
+    DetachData();
     std::copy(data.begin(), data.end(), m_data.begin());
 }
 }  // namespace CubbyFlow
\ No newline at end of file
@@ -93,4 +93,47 @@ void VectorGrid3::Deserialize(const std::vector<uint8_t>& buffer)
 
     SetData(gridData);
 }
+
+void VectorGrid3::SerializeCompressed(std::vector<uint8_t>* buffer,
+                                      GridDataQuantization quantization) const
+{
+    const Size3 res = Resolution();
+    const Vector3D gs = GridSpacing();
+    const Vector3D org = Origin();
+
+    const uint64_t resolution[3] = { res.x, res.y, res.z };
+    const double geometry[6] = { gs.x, gs.y, gs.z, org.x, org.y, org.z };
+
+    std::vector<double> gridData;
+    GetData(&gridData);
+
+    std::vector<uint8_t> payload;
+    CompressGridData(gridData, quantization, &payload);
+
+    buffer->resize(sizeof(resolution) + sizeof(geometry) + payload.size());
+    memcpy(buffer->data(), resolution, sizeof(resolution));
+    memcpy(buffer->data() + sizeof(resolution), geometry, sizeof(geometry));
+    memcpy(buffer->data() + sizeof(resolution) + sizeof(geometry),
+           payload.data(), payload.size());
+}
+
+void VectorGrid3::DeserializeCompressed(const std::vector<uint8_t>& buffer)
+{
+    uint64_t resolution[3];
+    double geometry[6];
+
+    memcpy(resolution, buffer.data(), sizeof(resolution));
+    memcpy(geometry, buffer.data() + sizeof(resolution), sizeof(geometry));
+
+    Resize(Size3{ resolution[0], resolution[1], resolution[2] },
+           Vector3D{ geometry[0], geometry[1], geometry[2] },
+           Vector3D{ geometry[3], geometry[4], geometry[5] });
+
+    std::vector<double> gridData;
+    DecompressGridData(
+        buffer.data() + sizeof(resolution) + sizeof(geometry),
+        buffer.size() - sizeof(resolution) - sizeof(geometry), &gridData);
+
+    SetData(gridData);
+}
 }  // namespace CubbyFlow
\ No newline at end of file
@@ -0,0 +1,248 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Particle/ParticleCache3.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace CubbyFlow
+{
+namespace
+{
+constexpr uint32_t CACHE_MAGIC = 0x43465043;  // "CFPC"
+constexpr uint32_t CACHE_VERSION = 1;
+constexpr size_t CHUNK_ALIGNMENT = 4096;
+
+struct CacheHeader
+{
+    uint32_t magic = CACHE_MAGIC;
+    uint32_t version = CACHE_VERSION;
+    uint64_t numberOfParticles = 0;
+    uint64_t chunkSize = 0;
+    uint32_t numberOfScalarLayers = 0;
+    uint32_t numberOfVectorLayers = 0;
+    uint64_t positionLayerIdx = 0;
+};
+
+struct CacheTrailer
+{
+    uint64_t footerOffset = 0;
+    uint32_t magic = CACHE_MAGIC;
+};
+
+size_t GetChunksPerLayer(size_t numberOfParticles, size_t chunkSize)
+{
+    return (numberOfParticles + chunkSize - 1) / chunkSize;
+}
+
+void PadToAlignment(std::ofstream& file)
+{
+    static const char zeros[CHUNK_ALIGNMENT] = { 0 };
+
+    const auto pos = static_cast<size_t>(file.tellp());
+    const size_t remainder = pos % CHUNK_ALIGNMENT;
+
+    if (remainder != 0)
+    {
+        file.write(zeros,
+                   static_cast<std::streamsize>(CHUNK_ALIGNMENT - remainder));
+    }
+}
+
+void WriteLayer(std::ofstream& file, const char* src, size_t numberOfParticles,
+                size_t chunkSize, size_t bytesPerParticle,
+                std::vector<uint64_t>& chunkOffsets)
+{
+    const size_t numChunks = GetChunksPerLayer(numberOfParticles, chunkSize);
+
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+        PadToAlignment(file);
+        chunkOffsets.push_back(static_cast<uint64_t>(file.tellp()));
+
+        const size_t begin = c * chunkSize;
+        const size_t count = std::min(chunkSize, numberOfParticles - begin);
+
+        file.write(src + begin * bytesPerParticle,
+                   static_cast<std::streamsize>(count * bytesPerParticle));
+    }
+}
+}  // namespace
+
+bool ParticleCache3::Write(const std::string& fileName,
+                           const ParticleSystemData3& data, size_t chunkSize)
+{
+    if (chunkSize == 0)
+    {
+        return false;
+    }
+
+    std::ofstream file{ fileName.c_str(), std::ofstream::binary };
+    if (!file)
+    {
+        return false;
+    }
+
+    const size_t n = data.GetNumberOfParticles();
+
+    CacheHeader header;
+    header.numberOfParticles = n;
+    header.chunkSize = chunkSize;
+    header.numberOfScalarLayers =
+        static_cast<uint32_t>(data.GetNumberOfScalarDataLayers());
+    header.numberOfVectorLayers =
+        static_cast<uint32_t>(data.GetNumberOfVectorDataLayers());
+    header.positionLayerIdx = data.GetPositionIndex();
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Stream each layer chunk by chunk; nothing larger than one chunk is
+    // ever staged in memory.
+    std::vector<uint64_t> chunkOffsets;
+
+    for (size_t s = 0; s < data.GetNumberOfScalarDataLayers(); ++s)
+    {
+        const ConstArrayAccessor1<double> acc = data.ScalarDataAt(s);
+        WriteLayer(file, reinterpret_cast<const char*>(acc.data()), n,
+                   chunkSize, sizeof(double), chunkOffsets);
+    }
+
+    for (size_t v = 0; v < data.GetNumberOfVectorDataLayers(); ++v)
+    {
+        const ConstArrayAccessor1<Vector3D> acc = data.VectorDataAt(v);
+        WriteLayer(file, reinterpret_cast<const char*>(acc.data()), n,
+                   chunkSize, sizeof(Vector3D), chunkOffsets);
+    }
+
+    CacheTrailer trailer;
+    trailer.footerOffset = static_cast<uint64_t>(file.tellp());
+
+    file.write(reinterpret_cast<const char*>(chunkOffsets.data()),
+               static_cast<std::streamsize>(chunkOffsets.size() *
+                                            sizeof(uint64_t)));
+    file.write(reinterpret_cast<const char*>(&trailer), sizeof(trailer));
+
+    return file.good();
+}
+
+bool ParticleCache3::Reader::Open(const std::string& fileName)
+{
+    m_file.open(fileName.c_str(), std::ifstream::binary);
+    if (!m_file)
+    {
+        return false;
+    }
+
+    CacheHeader header;
+    m_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!m_file || header.magic != CACHE_MAGIC ||
+        header.version != CACHE_VERSION || header.chunkSize == 0)
+    {
+        return false;
+    }
+
+    CacheTrailer trailer;
+    m_file.seekg(-static_cast<std::streamoff>(sizeof(trailer)),
+                 std::ifstream::end);
+    m_file.read(reinterpret_cast<char*>(&trailer), sizeof(trailer));
+
+    if (!m_file || trailer.magic != CACHE_MAGIC)
+    {
+        return false;
+    }
+
+    m_numberOfParticles = static_cast<size_t>(header.numberOfParticles);
+    m_numberOfScalarLayers = header.numberOfScalarLayers;
+    m_numberOfVectorLayers = header.numberOfVectorLayers;
+    m_positionLayerIdx = static_cast<size_t>(header.positionLayerIdx);
+    m_chunkSize = static_cast<size_t>(header.chunkSize);
+    m_chunksPerLayer = GetChunksPerLayer(m_numberOfParticles, m_chunkSize);
+
+    const size_t totalChunks =
+        (m_numberOfScalarLayers + m_numberOfVectorLayers) * m_chunksPerLayer;
+
+    m_chunkOffsets.resize(totalChunks);
+    m_file.seekg(static_cast<std::streamoff>(trailer.footerOffset),
+                 std::ifstream::beg);
+    m_file.read(reinterpret_cast<char*>(m_chunkOffsets.data()),
+                static_cast<std::streamsize>(totalChunks * sizeof(uint64_t)));
+
+    return m_file.good();
+}
+
+size_t ParticleCache3::Reader::GetNumberOfParticles() const
+{
+    return m_numberOfParticles;
+}
+
+size_t ParticleCache3::Reader::GetNumberOfScalarLayers() const
+{
+    return m_numberOfScalarLayers;
+}
+
+size_t ParticleCache3::Reader::GetNumberOfVectorLayers() const
+{
+    return m_numberOfVectorLayers;
+}
+
+size_t ParticleCache3::Reader::GetPositionLayerIndex() const
+{
+    return m_positionLayerIdx;
+}
+
+bool ParticleCache3::Reader::ReadScalarLayer(size_t idx,
+                                             Array1<double>* data) const
+{
+    if (idx >= m_numberOfScalarLayers)
+    {
+        return false;
+    }
+
+    data->Resize(m_numberOfParticles);
+
+    return ReadLayer(idx * m_chunksPerLayer,
+                     reinterpret_cast<char*>(data->data()), sizeof(double));
+}
+
+bool ParticleCache3::Reader::ReadVectorLayer(size_t idx,
+                                             Array1<Vector3D>* data) const
+{
+    if (idx >= m_numberOfVectorLayers)
+    {
+        return false;
+    }
+
+    data->Resize(m_numberOfParticles);
+
+    return ReadLayer((m_numberOfScalarLayers + idx) * m_chunksPerLayer,
+                     reinterpret_cast<char*>(data->data()), sizeof(Vector3D));
+}
+
+bool ParticleCache3::Reader::ReadLayer(size_t chunkBegin, char* dst,
+                                       size_t bytesPerParticle) const
+{
+    for (size_t c = 0; c < m_chunksPerLayer; ++c)
+    {
+        const size_t begin = c * m_chunkSize;
+        const size_t count =
+            std::min(m_chunkSize, m_numberOfParticles - begin);
+
+        m_file.seekg(
+            static_cast<std::streamoff>(m_chunkOffsets[chunkBegin + c]),
+            std::ifstream::beg);
+        m_file.read(dst + begin * bytesPerParticle,
+                    static_cast<std::streamsize>(count * bytesPerParticle));
+    }
+
+    return m_file.good();
+}
+}  // namespace CubbyFlow
@@ -0,0 +1,456 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Particle/ParticleDeltaCache3.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace CubbyFlow
+{
+namespace
+{
+// Frame layout (little-endian):
+//   [uint8 frameType]
+//   keyframe:  [ParticleSystemData3 flatbuffer]
+//   delta:     [double dt][uint64 particleCount]
+//              [uint32 scalarLayers][uint32 vectorLayers]
+//              per layer: [uint64 payloadBytes][payload]
+// Scalar layers come first, then vector layers (three words per particle).
+//
+// A delta payload holds the XOR of each attribute word against its
+// prediction, byte-plane transposed so that the mostly-zero high bytes of
+// nearby values form long runs, then run-length coded: a uint32 token with
+// the high bit set is followed by one byte repeated (token & 0x7FFFFFFF)
+// times; without the high bit, by that many raw bytes.
+constexpr uint8_t FRAME_TYPE_KEY = 0;
+constexpr uint8_t FRAME_TYPE_DELTA = 1;
+
+constexpr uint32_t RUN_TOKEN_BIT = 0x80000000U;
+constexpr size_t MIN_RUN_LENGTH = 8;
+
+template <typename T>
+void AppendPOD(std::vector<uint8_t>* buffer, const T& value)
+{
+    const size_t offset = buffer->size();
+    buffer->resize(offset + sizeof(T));
+    std::memcpy(buffer->data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T ReadPOD(const uint8_t* data, size_t* offset)
+{
+    T value;
+    std::memcpy(&value, data + *offset, sizeof(T));
+    *offset += sizeof(T);
+    return value;
+}
+
+void EncodeBytes(const std::vector<uint8_t>& bytes,
+                 std::vector<uint8_t>* payload)
+{
+    const size_t count = bytes.size();
+    size_t literalBegin = 0;
+    size_t i = 0;
+
+    const auto flushLiterals = [&](size_t literalEnd) {
+        size_t remaining = literalEnd - literalBegin;
+        size_t offset = literalBegin;
+
+        while (remaining > 0)
+        {
+            const size_t blockSize =
+                std::min(remaining, static_cast<size_t>(0x7FFFFFFF));
+            AppendPOD(payload, static_cast<uint32_t>(blockSize));
+
+            const size_t payloadOffset = payload->size();
+            payload->resize(payloadOffset + blockSize);
+            std::memcpy(payload->data() + payloadOffset,
+                        bytes.data() + offset, blockSize);
+
+            offset += blockSize;
+            remaining -= blockSize;
+        }
+    };
+
+    while (i < count)
+    {
+        size_t runEnd = i + 1;
+        while (runEnd < count && bytes[runEnd] == bytes[i])
+        {
+            ++runEnd;
+        }
+
+        const size_t runLength = runEnd - i;
+        if (runLength >= MIN_RUN_LENGTH)
+        {
+            flushLiterals(i);
+
+            size_t remaining = runLength;
+            while (remaining > 0)
+            {
+                const size_t blockSize =
+                    std::min(remaining, static_cast<size_t>(0x7FFFFFFF));
+                AppendPOD(payload,
+                          static_cast<uint32_t>(blockSize) | RUN_TOKEN_BIT);
+                AppendPOD(payload, bytes[i]);
+                remaining -= blockSize;
+            }
+
+            literalBegin = runEnd;
+        }
+
+        i = runEnd;
+    }
+
+    flushLiterals(count);
+}
+
+bool DecodeBytes(const uint8_t* payload, size_t payloadSize,
+                 std::vector<uint8_t>* bytes)
+{
+    size_t offset = 0;
+    size_t produced = 0;
+    const size_t count = bytes->size();
+
+    while (offset < payloadSize && produced < count)
+    {
+        const auto token = ReadPOD<uint32_t>(payload, &offset);
+        const size_t blockSize = token & ~RUN_TOKEN_BIT;
+
+        if (produced + blockSize > count)
+        {
+            return false;
+        }
+
+        if ((token & RUN_TOKEN_BIT) != 0)
+        {
+            const auto value = ReadPOD<uint8_t>(payload, &offset);
+            std::fill(bytes->begin() + produced,
+                      bytes->begin() + produced + blockSize, value);
+        }
+        else
+        {
+            if (offset + blockSize > payloadSize)
+            {
+                return false;
+            }
+
+            std::memcpy(bytes->data() + produced, payload + offset,
+                        blockSize);
+            offset += blockSize;
+        }
+
+        produced += blockSize;
+    }
+
+    return produced == count;
+}
+
+void EncodeResidualWords(const std::vector<uint64_t>& words,
+                         std::vector<uint8_t>* payload)
+{
+    const size_t count = words.size();
+
+    // Byte-plane transpose: plane 7 (the exponent/sign bytes) first, since
+    // it is the most uniform.
+    std::vector<uint8_t> planes(count * sizeof(uint64_t));
+    for (size_t plane = 0; plane < sizeof(uint64_t); ++plane)
+    {
+        const size_t shift = 8 * (7 - plane);
+        for (size_t i = 0; i < count; ++i)
+        {
+            planes[plane * count + i] =
+                static_cast<uint8_t>(words[i] >> shift);
+        }
+    }
+
+    EncodeBytes(planes, payload);
+}
+
+bool DecodeResidualWords(const uint8_t* payload, size_t payloadSize,
+                         std::vector<uint64_t>* words)
+{
+    const size_t count = words->size();
+
+    std::vector<uint8_t> planes(count * sizeof(uint64_t));
+    if (!DecodeBytes(payload, payloadSize, &planes))
+    {
+        return false;
+    }
+
+    std::fill(words->begin(), words->end(), static_cast<uint64_t>(0));
+    for (size_t plane = 0; plane < sizeof(uint64_t); ++plane)
+    {
+        const size_t shift = 8 * (7 - plane);
+        for (size_t i = 0; i < count; ++i)
+        {
+            (*words)[i] |= static_cast<uint64_t>(planes[plane * count + i])
+                           << shift;
+        }
+    }
+
+    return true;
+}
+
+uint64_t DoubleBits(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double BitsToDouble(uint64_t bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+bool SameLayout(const ParticleSystemData3& a, const ParticleSystemData3& b)
+{
+    return a.GetNumberOfParticles() == b.GetNumberOfParticles() &&
+           a.GetNumberOfScalarDataLayers() == b.GetNumberOfScalarDataLayers() &&
+           a.GetNumberOfVectorDataLayers() == b.GetNumberOfVectorDataLayers() &&
+           a.GetPositionIndex() == b.GetPositionIndex();
+}
+}  // namespace
+
+ParticleDeltaCache3::Encoder::Encoder(size_t keyframeInterval)
+    : m_keyframeInterval{ std::max(keyframeInterval, static_cast<size_t>(1)) }
+{
+    // Do nothing
+}
+
+void ParticleDeltaCache3::Encoder::EncodeFrame(const ParticleSystemData3& data,
+                                               double timeIntervalInSeconds,
+                                               std::vector<uint8_t>* buffer)
+{
+    buffer->clear();
+
+    const bool needKeyframe = !m_hasState ||
+                              m_framesSinceKeyframe >= m_keyframeInterval ||
+                              !SameLayout(data, m_state);
+
+    if (needKeyframe)
+    {
+        AppendPOD(buffer, FRAME_TYPE_KEY);
+
+        std::vector<uint8_t> serialized;
+        data.Serialize(&serialized);
+        buffer->insert(buffer->end(), serialized.begin(), serialized.end());
+
+        m_framesSinceKeyframe = 1;
+    }
+    else
+    {
+        AppendPOD(buffer, FRAME_TYPE_DELTA);
+        AppendPOD(buffer, timeIntervalInSeconds);
+
+        const size_t n = data.GetNumberOfParticles();
+        const size_t scalarLayers = data.GetNumberOfScalarDataLayers();
+        const size_t vectorLayers = data.GetNumberOfVectorDataLayers();
+
+        AppendPOD(buffer, static_cast<uint64_t>(n));
+        AppendPOD(buffer, static_cast<uint32_t>(scalarLayers));
+        AppendPOD(buffer, static_cast<uint32_t>(vectorLayers));
+
+        std::vector<uint64_t> residuals;
+        std::vector<uint8_t> payload;
+
+        const auto appendLayer = [&]() {
+            payload.clear();
+            EncodeResidualWords(residuals, &payload);
+            AppendPOD(buffer, static_cast<uint64_t>(payload.size()));
+            buffer->insert(buffer->end(), payload.begin(), payload.end());
+        };
+
+        for (size_t layer = 0; layer < scalarLayers; ++layer)
+        {
+            const auto curr = data.ScalarDataAt(layer);
+            const auto prev = m_state.ScalarDataAt(layer);
+
+            residuals.resize(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                residuals[i] = DoubleBits(curr[i]) ^ DoubleBits(prev[i]);
+            }
+
+            appendLayer();
+        }
+
+        const size_t positionLayer = data.GetPositionIndex();
+        const auto prevVel = m_state.GetVelocities();
+
+        for (size_t layer = 0; layer < vectorLayers; ++layer)
+        {
+            const auto curr = data.VectorDataAt(layer);
+            const auto prev = m_state.VectorDataAt(layer);
+
+            residuals.resize(3 * n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                Vector3D predicted = prev[i];
+                if (layer == positionLayer)
+                {
+                    predicted += prevVel[i] * timeIntervalInSeconds;
+                }
+
+                residuals[3 * i] =
+                    DoubleBits(curr[i].x) ^ DoubleBits(predicted.x);
+                residuals[3 * i + 1] =
+                    DoubleBits(curr[i].y) ^ DoubleBits(predicted.y);
+                residuals[3 * i + 2] =
+                    DoubleBits(curr[i].z) ^ DoubleBits(predicted.z);
+            }
+
+            appendLayer();
+        }
+
+        ++m_framesSinceKeyframe;
+    }
+
+    // Set (and thus operator=) appends the attribute lists of a non-empty
+    // target, so replace the state with a freshly copied object instead.
+    m_state = ParticleSystemData3{ data };
+    m_hasState = true;
+}
+
+void ParticleDeltaCache3::Encoder::Reset()
+{
+    m_hasState = false;
+    m_framesSinceKeyframe = 0;
+}
+
+bool ParticleDeltaCache3::Decoder::DecodeFrame(
+    const std::vector<uint8_t>& buffer, ParticleSystemData3* data)
+{
+    if (buffer.empty())
+    {
+        return false;
+    }
+
+    size_t offset = 0;
+    const auto frameType = ReadPOD<uint8_t>(buffer.data(), &offset);
+
+    if (frameType == FRAME_TYPE_KEY)
+    {
+        const std::vector<uint8_t> serialized(buffer.begin() + 1,
+                                              buffer.end());
+        ParticleSystemData3 decoded;
+        decoded.Deserialize(serialized);
+        m_state = std::move(decoded);
+        m_hasState = true;
+
+        *data = ParticleSystemData3{ m_state };
+        return true;
+    }
+
+    if (frameType != FRAME_TYPE_DELTA || !m_hasState)
+    {
+        return false;
+    }
+
+    const auto dt = ReadPOD<double>(buffer.data(), &offset);
+    const auto n = static_cast<size_t>(
+        ReadPOD<uint64_t>(buffer.data(), &offset));
+    const auto scalarLayers = static_cast<size_t>(
+        ReadPOD<uint32_t>(buffer.data(), &offset));
+    const auto vectorLayers = static_cast<size_t>(
+        ReadPOD<uint32_t>(buffer.data(), &offset));
+
+    if (n != m_state.GetNumberOfParticles() ||
+        scalarLayers != m_state.GetNumberOfScalarDataLayers() ||
+        vectorLayers != m_state.GetNumberOfVectorDataLayers())
+    {
+        return false;
+    }
+
+    std::vector<uint64_t> residuals;
+
+    const auto readLayer = [&](size_t wordCount) -> bool {
+        if (offset + sizeof(uint64_t) > buffer.size())
+        {
+            return false;
+        }
+
+        const auto payloadSize = static_cast<size_t>(
+            ReadPOD<uint64_t>(buffer.data(), &offset));
+        if (offset + payloadSize > buffer.size())
+        {
+            return false;
+        }
+
+        residuals.resize(wordCount);
+        const bool ok = DecodeResidualWords(buffer.data() + offset,
+                                            payloadSize, &residuals);
+        offset += payloadSize;
+        return ok;
+    };
+
+    for (size_t layer = 0; layer < scalarLayers; ++layer)
+    {
+        if (!readLayer(n))
+        {
+            return false;
+        }
+
+        auto values = m_state.ScalarDataAt(layer);
+        for (size_t i = 0; i < n; ++i)
+        {
+            values[i] = BitsToDouble(DoubleBits(values[i]) ^ residuals[i]);
+        }
+    }
+
+    const size_t positionLayer = m_state.GetPositionIndex();
+
+    // The position prediction must read the previous frame's velocities,
+    // which the loop below overwrites, so keep a copy.
+    const auto velAccessor = m_state.GetVelocities();
+    std::vector<Vector3D> prevVel(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        prevVel[i] = velAccessor[i];
+    }
+
+    for (size_t layer = 0; layer < vectorLayers; ++layer)
+    {
+        if (!readLayer(3 * n))
+        {
+            return false;
+        }
+
+        auto values = m_state.VectorDataAt(layer);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            Vector3D predicted = values[i];
+            if (layer == positionLayer)
+            {
+                predicted += prevVel[i] * dt;
+            }
+
+            values[i] = Vector3D{
+                BitsToDouble(DoubleBits(predicted.x) ^ residuals[3 * i]),
+                BitsToDouble(DoubleBits(predicted.y) ^ residuals[3 * i + 1]),
+                BitsToDouble(DoubleBits(predicted.z) ^ residuals[3 * i + 2])
+            };
+        }
+    }
+
+    *data = ParticleSystemData3{ m_state };
+    return true;
+}
+
+void ParticleDeltaCache3::Decoder::Reset()
+{
+    m_hasState = false;
+}
+}  // namespace CubbyFlow
@@ -20,6 +20,10 @@
 
 #include <Flatbuffers/generated/ParticleSystemData3_generated.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 namespace CubbyFlow
 {
 static const size_t DEFAULT_HASH_GRID_RESOLUTION = 64;
@@ -68,6 +72,12 @@ void ParticleSystemData3::Resize(size_t newNumberOfParticles)
     {
         attr.Resize(newNumberOfParticles, Vector3D{});
     }
+
+    for (auto& attr : m_typedDataList)
+    {
+        attr.bytes.Resize(
+            newNumberOfParticles * GetTypedDataElementSize(attr.type), 0);
+    }
 }
 
 size_t ParticleSystemData3::GetNumberOfParticles() const
@@ -75,6 +85,21 @@ size_t ParticleSystemData3::GetNumberOfParticles() const
     return m_numberOfParticles;
 }
 
+size_t ParticleSystemData3::GetNumberOfScalarDataLayers() const
+{
+    return m_scalarDataList.size();
+}
+
+size_t ParticleSystemData3::GetNumberOfVectorDataLayers() const
+{
+    return m_vectorDataList.size();
+}
+
+size_t ParticleSystemData3::GetPositionIndex() const
+{
+    return m_positionIdx;
+}
+
 size_t ParticleSystemData3::AddScalarData(double initialVal)
 {
     const size_t attrIdx = m_scalarDataList.size();
@@ -89,6 +114,105 @@ size_t ParticleSystemData3::AddVectorData(const Vector3D& initialVal)
     return attrIdx;
 }
 
+size_t ParticleSystemData3::AddSoAVectorData(const Vector3D& initialVal)
+{
+    const size_t attrIdx = m_soaVectorDataList.size();
+    m_soaVectorDataList.push_back({ AddScalarData(initialVal.x),
+                                    AddScalarData(initialVal.y),
+                                    AddScalarData(initialVal.z) });
+    return attrIdx;
+}
+
+size_t ParticleSystemData3::AddTypedData(TypedDataType type)
+{
+    const size_t attrIdx = m_typedDataList.size();
+    Array1<uint8_t> bytes(
+        GetNumberOfParticles() * GetTypedDataElementSize(type), 0);
+    m_typedDataList.push_back(TypedData{ type, std::move(bytes) });
+    return attrIdx;
+}
+
+size_t ParticleSystemData3::GetNumberOfTypedDataLayers() const
+{
+    return m_typedDataList.size();
+}
+
+ParticleSystemData3::TypedDataType ParticleSystemData3::GetTypedDataTypeAt(
+    size_t idx) const
+{
+    return m_typedDataList[idx].type;
+}
+
+size_t ParticleSystemData3::GetTypedDataElementSize(TypedDataType type)
+{
+    switch (type)
+    {
+        case TypedDataType::Float32:
+            return sizeof(float);
+        case TypedDataType::UInt16:
+            return sizeof(uint16_t);
+        case TypedDataType::PackedNormal:
+            return sizeof(uint32_t);
+    }
+
+    return 0;
+}
+
+uint32_t ParticleSystemData3::PackNormal(const Vector3D& normal)
+{
+    const double len =
+        std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+
+    // Project onto the octahedron; a degenerate input packs as +z.
+    double u = 0.0;
+    double v = 0.0;
+    double z = 1.0;
+
+    if (len > 0.0)
+    {
+        u = normal.x / len;
+        v = normal.y / len;
+        z = normal.z / len;
+    }
+
+    if (z < 0.0)
+    {
+        // Fold the lower hemisphere over the diagonals.
+        const double foldedU = (1.0 - std::abs(v)) * (u >= 0.0 ? 1.0 : -1.0);
+        const double foldedV = (1.0 - std::abs(u)) * (v >= 0.0 ? 1.0 : -1.0);
+        u = foldedU;
+        v = foldedV;
+    }
+
+    const auto quantizedU =
+        static_cast<uint32_t>(std::lround((u * 0.5 + 0.5) * 65535.0));
+    const auto quantizedV =
+        static_cast<uint32_t>(std::lround((v * 0.5 + 0.5) * 65535.0));
+
+    return quantizedU | (quantizedV << 16);
+}
+
+Vector3D ParticleSystemData3::UnpackNormal(uint32_t packed)
+{
+    const double u =
+        static_cast<double>(packed & 0xFFFF) / 65535.0 * 2.0 - 1.0;
+    const double v = static_cast<double>(packed >> 16) / 65535.0 * 2.0 - 1.0;
+
+    Vector3D normal{ u, v, 1.0 - std::abs(u) - std::abs(v) };
+
+    if (normal.z < 0.0)
+    {
+        const double foldedX =
+            (1.0 - std::abs(normal.y)) * (normal.x >= 0.0 ? 1.0 : -1.0);
+        const double foldedY =
+            (1.0 - std::abs(normal.x)) * (normal.y >= 0.0 ? 1.0 : -1.0);
+        normal.x = foldedX;
+        normal.y = foldedY;
+    }
+
+    return normal.Normalized();
+}
+
 double ParticleSystemData3::GetRadius() const
 {
     return m_radius;
@@ -160,6 +284,42 @@ ArrayAccessor1<Vector3D> ParticleSystemData3::VectorDataAt(size_t idx)
     return m_vectorDataList[idx].Accessor();
 }
 
+ParticleSystemData3::ConstSoAVectorDataView ParticleSystemData3::SoAVectorDataAt(
+    size_t idx) const
+{
+    const auto& channels = m_soaVectorDataList[idx];
+    return ConstSoAVectorDataView{ ScalarDataAt(channels[0]),
+                                   ScalarDataAt(channels[1]),
+                                   ScalarDataAt(channels[2]) };
+}
+
+ParticleSystemData3::SoAVectorDataView ParticleSystemData3::SoAVectorDataAt(
+    size_t idx)
+{
+    const auto& channels = m_soaVectorDataList[idx];
+    return SoAVectorDataView{ ScalarDataAt(channels[0]),
+                              ScalarDataAt(channels[1]),
+                              ScalarDataAt(channels[2]) };
+}
+
+void ParticleSystemData3::CopyVectorDataToSoA(size_t vectorIdx, size_t soaIdx)
+{
+    auto src = VectorDataAt(vectorIdx);
+    auto dst = SoAVectorDataAt(soaIdx);
+
+    ParallelFor(ZERO_SIZE, GetNumberOfParticles(),
+                [&](size_t i) { dst.Set(i, src[i]); });
+}
+
+void ParticleSystemData3::CopyVectorDataFromSoA(size_t vectorIdx, size_t soaIdx)
+{
+    auto dst = VectorDataAt(vectorIdx);
+    auto src = SoAVectorDataAt(soaIdx);
+
+    ParallelFor(ZERO_SIZE, GetNumberOfParticles(),
+                [&](size_t i) { dst[i] = src.At(i); });
+}
+
 void ParticleSystemData3::AddParticle(const Vector3D& newPosition,
                                       const Vector3D& newVelocity,
                                       const Vector3D& newForce)
@@ -192,6 +352,12 @@ void ParticleSystemData3::AddParticles(
         };
     }
 
+    if (m_concurrentAppendState != nullptr)
+    {
+        StageParticles(newPositions, newVelocities, newForces);
+        return;
+    }
+
     size_t oldNumberOfParticles = GetNumberOfParticles();
     const size_t newNumberOfParticles =
         oldNumberOfParticles + newPositions.size();
@@ -221,6 +387,120 @@ void ParticleSystemData3::AddParticles(
     }
 }
 
+void ParticleSystemData3::BeginConcurrentAppend()
+{
+    if (m_concurrentAppendState == nullptr)
+    {
+        m_concurrentAppendState = std::make_unique<ConcurrentAppendState>();
+    }
+}
+
+void ParticleSystemData3::EndConcurrentAppend()
+{
+    if (m_concurrentAppendState == nullptr)
+    {
+        return;
+    }
+
+    // Detach the staged list and leave the normal append path active before
+    // merging.
+    StagedParticleBatch* head = m_concurrentAppendState->head.exchange(nullptr);
+    m_concurrentAppendState.reset();
+
+    std::vector<std::unique_ptr<StagedParticleBatch>> batches;
+    while (head != nullptr)
+    {
+        StagedParticleBatch* next = head->next;
+        batches.emplace_back(head);
+        head = next;
+    }
+
+    if (batches.empty())
+    {
+        return;
+    }
+
+    // The lock-free push reverses insertion order; undo it so a
+    // single-threaded staging sequence merges in call order.
+    std::reverse(batches.begin(), batches.end());
+
+    const size_t oldNumberOfParticles = GetNumberOfParticles();
+
+    std::vector<size_t> batchOffsets(batches.size() + 1);
+    batchOffsets[0] = oldNumberOfParticles;
+    for (size_t b = 0; b < batches.size(); ++b)
+    {
+        batchOffsets[b + 1] = batchOffsets[b] + batches[b]->positions.size();
+    }
+
+    Resize(batchOffsets.back());
+
+    auto pos = GetPositions();
+    auto vel = GetVelocities();
+    auto frc = GetForces();
+
+    ParallelFor(ZERO_SIZE, batches.size(), [&](size_t b) {
+        const StagedParticleBatch& batch = *batches[b];
+        const size_t offset = batchOffsets[b];
+
+        for (size_t i = 0; i < batch.positions.size(); ++i)
+        {
+            pos[offset + i] = batch.positions[i];
+        }
+
+        for (size_t i = 0; i < batch.velocities.size(); ++i)
+        {
+            vel[offset + i] = batch.velocities[i];
+        }
+
+        for (size_t i = 0; i < batch.forces.size(); ++i)
+        {
+            frc[offset + i] = batch.forces[i];
+        }
+    });
+}
+
+bool ParticleSystemData3::IsConcurrentAppendActive() const
+{
+    return m_concurrentAppendState != nullptr;
+}
+
+void ParticleSystemData3::StageParticles(
+    const ConstArrayAccessor1<Vector3D>& newPositions,
+    const ConstArrayAccessor1<Vector3D>& newVelocities,
+    const ConstArrayAccessor1<Vector3D>& newForces)
+{
+    auto* batch = new StagedParticleBatch;
+
+    batch->positions.Resize(newPositions.size());
+    for (size_t i = 0; i < newPositions.size(); ++i)
+    {
+        batch->positions[i] = newPositions[i];
+    }
+
+    batch->velocities.Resize(newVelocities.size());
+    for (size_t i = 0; i < newVelocities.size(); ++i)
+    {
+        batch->velocities[i] = newVelocities[i];
+    }
+
+    batch->forces.Resize(newForces.size());
+    for (size_t i = 0; i < newForces.size(); ++i)
+    {
+        batch->forces[i] = newForces[i];
+    }
+
+    // Lock-free push; concurrent callers only contend on the head pointer.
+    ConcurrentAppendState& state = *m_concurrentAppendState;
+    batch->next = state.head.load(std::memory_order_relaxed);
+    while (!state.head.compare_exchange_weak(batch->next, batch,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed))
+    {
+        // Retry with the updated head.
+    }
+}
+
 const PointNeighborSearcher3Ptr& ParticleSystemData3::GetNeighborSearcher()
     const
 {
@@ -235,6 +515,35 @@ void ParticleSystemData3::SetNeighborSearcher(
 
 const std::vector<std::vector<size_t>>& ParticleSystemData3::GetNeighborLists()
     const
+{
+    if (m_expandedNeighborListsDirty)
+    {
+        const size_t numberOfParticles =
+            (m_neighborLists.offsets.empty())
+                ? 0
+                : m_neighborLists.offsets.size() - 1;
+
+        m_expandedNeighborLists.resize(numberOfParticles);
+
+        for (size_t i = 0; i < numberOfParticles; ++i)
+        {
+            std::vector<size_t>& neighbors = m_expandedNeighborLists[i];
+
+            neighbors.clear();
+            neighbors.reserve(m_neighborLists.NumberOfNeighbors(i));
+
+            m_neighborLists.ForEachNeighbor(
+                i, [&](size_t j) { neighbors.push_back(j); });
+        }
+
+        m_expandedNeighborListsDirty = false;
+    }
+
+    return m_expandedNeighborLists;
+}
+
+const ParticleSystemData3::CompactNeighborLists&
+ParticleSystemData3::GetCompactNeighborLists() const
 {
     return m_neighborLists;
 }
@@ -243,43 +552,397 @@ void ParticleSystemData3::BuildNeighborSearcher(double maxSearchRadius)
 {
     const Timer timer;
 
-    // Use PointParallelHashGridSearcher3 by default
-    m_neighborSearcher = std::make_shared<PointParallelHashGridSearcher3>(
-        DEFAULT_HASH_GRID_RESOLUTION, DEFAULT_HASH_GRID_RESOLUTION,
-        DEFAULT_HASH_GRID_RESOLUTION, 2.0 * maxSearchRadius);
+    const auto parallelSearcher =
+        std::dynamic_pointer_cast<PointParallelHashGridSearcher3>(
+            m_neighborSearcher);
+
+    if (parallelSearcher != nullptr)
+    {
+        // Pool the searcher across frames: Rebuild retargets the grid
+        // spacing and refills the existing bucket tables, key arrays, and
+        // sorted indices instead of paying the allocator for fresh ones
+        // every substep.
+        parallelSearcher->Rebuild(GetPositions(), 2.0 * maxSearchRadius);
+    }
+    else
+    {
+        // Use PointParallelHashGridSearcher3 by default
+        m_neighborSearcher = std::make_shared<PointParallelHashGridSearcher3>(
+            DEFAULT_HASH_GRID_RESOLUTION, DEFAULT_HASH_GRID_RESOLUTION,
+            DEFAULT_HASH_GRID_RESOLUTION, 2.0 * maxSearchRadius);
 
-    m_neighborSearcher->Build(GetPositions());
+        m_neighborSearcher->Build(GetPositions());
+    }
 
     CUBBYFLOW_INFO << "Building neighbor searcher took: "
                    << timer.DurationInSeconds() << " seconds";
 }
 
+void ParticleSystemData3::UpdateNeighborSearcher(double maxSearchRadius)
+{
+    const auto parallelSearcher =
+        std::dynamic_pointer_cast<PointParallelHashGridSearcher3>(
+            m_neighborSearcher);
+
+    if (parallelSearcher != nullptr &&
+        parallelSearcher->GridSpacing() == 2.0 * maxSearchRadius)
+    {
+        const Timer timer;
+
+        parallelSearcher->Update(GetPositions());
+
+        CUBBYFLOW_INFO << "Updating neighbor searcher took: "
+                       << timer.DurationInSeconds() << " seconds";
+        return;
+    }
+
+    BuildNeighborSearcher(maxSearchRadius);
+}
+
 void ParticleSystemData3::BuildNeighborLists(double maxSearchRadius)
 {
     const Timer timer;
 
-    m_neighborLists.resize(GetNumberOfParticles());
-
+    const size_t numberOfParticles = GetNumberOfParticles();
     auto points = GetPositions();
 
-    for (size_t i = 0; i < GetNumberOfParticles(); ++i)
-    {
-        Vector3D origin = points[i];
-        m_neighborLists[i].clear();
+    // Count pass: store per-particle neighbor counts shifted by one so the
+    // prefix sum below turns them into offsets in place.
+    m_neighborLists.offsets.assign(numberOfParticles + 1, 0);
+
+    ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+        const Vector3D origin = points[i];
+        size_t count = 0;
 
         m_neighborSearcher->ForEachNearbyPoint(
             origin, maxSearchRadius, [&](size_t j, const Vector3D&) {
                 if (i != j)
                 {
-                    m_neighborLists[i].push_back(j);
+                    ++count;
                 }
             });
+
+        m_neighborLists.offsets[i + 1] = count;
+    });
+
+    for (size_t i = 0; i < numberOfParticles; ++i)
+    {
+        m_neighborLists.offsets[i + 1] += m_neighborLists.offsets[i];
     }
 
+    // Fill pass: each particle writes its own slice of the packed array.
+    m_neighborLists.indices.resize(m_neighborLists.offsets[numberOfParticles]);
+
+    ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+        const Vector3D origin = points[i];
+        size_t cursor = m_neighborLists.offsets[i];
+
+        m_neighborSearcher->ForEachNearbyPoint(
+            origin, maxSearchRadius, [&](size_t j, const Vector3D&) {
+                if (i != j)
+                {
+                    m_neighborLists.indices[cursor++] =
+                        static_cast<uint32_t>(j);
+                }
+            });
+    });
+
+    m_expandedNeighborListsDirty = true;
+
     CUBBYFLOW_INFO << "Building neighbor list took: "
                    << timer.DurationInSeconds() << " seconds";
 }
 
+void ParticleSystemData3::ComputeParticleCountHistogram(
+    const Size3& resolution, const Vector3D& origin,
+    const Vector3D& gridSpacing, Array3<size_t>* histogram) const
+{
+    histogram->Resize(resolution);
+    histogram->Set(0);
+
+    const size_t numberOfParticles = GetNumberOfParticles();
+    ConstArrayAccessor1<Vector3D> positions = GetPositions();
+    ArrayAccessor3<size_t> counts = histogram->Accessor();
+
+    const Vector3D invGridSpacing = 1.0 / gridSpacing;
+
+    for (size_t p = 0; p < numberOfParticles; ++p)
+    {
+        const Vector3D& pt = positions[p];
+
+        const auto i = static_cast<size_t>(
+            std::clamp(std::floor((pt.x - origin.x) * invGridSpacing.x), 0.0,
+                       static_cast<double>(resolution.x - 1)));
+        const auto j = static_cast<size_t>(
+            std::clamp(std::floor((pt.y - origin.y) * invGridSpacing.y), 0.0,
+                       static_cast<double>(resolution.y - 1)));
+        const auto k = static_cast<size_t>(
+            std::clamp(std::floor((pt.z - origin.z) * invGridSpacing.z), 0.0,
+                       static_cast<double>(resolution.z - 1)));
+
+        ++counts(i, j, k);
+    }
+}
+
+void ParticleSystemData3::UpdateActivityStates(double sleepSpeedThreshold,
+                                               size_t sleepFrameCount,
+                                               const Size3& resolution,
+                                               const Vector3D& origin,
+                                               const Vector3D& gridSpacing)
+{
+    const size_t numberOfParticles = GetNumberOfParticles();
+
+    // Newly added particles get zero-filled entries, which means active.
+    m_activityStates.Resize(numberOfParticles, 0);
+    m_quietFrameCounts.Resize(numberOfParticles, 0);
+
+    ConstArrayAccessor1<Vector3D> positions = GetPositions();
+    ConstArrayAccessor1<Vector3D> velocities = GetVelocities();
+    ArrayAccessor1<char> states = m_activityStates.Accessor();
+    ArrayAccessor1<uint32_t> quietFrames = m_quietFrameCounts.Accessor();
+
+    const Vector3D invGridSpacing = 1.0 / gridSpacing;
+    const double threshold2 = sleepSpeedThreshold * sleepSpeedThreshold;
+
+    const auto cellOf = [&](const Vector3D& pt) {
+        const auto i = static_cast<size_t>(
+            std::clamp(std::floor((pt.x - origin.x) * invGridSpacing.x), 0.0,
+                       static_cast<double>(resolution.x - 1)));
+        const auto j = static_cast<size_t>(
+            std::clamp(std::floor((pt.y - origin.y) * invGridSpacing.y), 0.0,
+                       static_cast<double>(resolution.y - 1)));
+        const auto k = static_cast<size_t>(
+            std::clamp(std::floor((pt.z - origin.z) * invGridSpacing.z), 0.0,
+                       static_cast<double>(resolution.z - 1)));
+        return Size3{ i, j, k };
+    };
+
+    // Count consecutive resting updates; the hysteresis keeps briefly calm
+    // particles from flickering in and out of sleep.
+    ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t p) {
+        if (velocities[p].LengthSquared() <= threshold2)
+        {
+            ++quietFrames[p];
+        }
+        else
+        {
+            quietFrames[p] = 0;
+        }
+
+        states[p] = (quietFrames[p] >= sleepFrameCount) ? 1 : 0;
+    });
+
+    // Mark the cells holding an active particle, then wake every sleeping
+    // particle whose cell neighborhood touches one of them.
+    Array3<char> activeCells{ resolution };
+    activeCells.Set(0);
+    ArrayAccessor3<char> activeAcc = activeCells.Accessor();
+
+    for (size_t p = 0; p < numberOfParticles; ++p)
+    {
+        if (states[p] == 0)
+        {
+            const Size3 cell = cellOf(positions[p]);
+            activeAcc(cell.x, cell.y, cell.z) = 1;
+        }
+    }
+
+    ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t p) {
+        if (states[p] == 0)
+        {
+            return;
+        }
+
+        const Size3 cell = cellOf(positions[p]);
+        const size_t iBegin = (cell.x > 0) ? cell.x - 1 : 0;
+        const size_t jBegin = (cell.y > 0) ? cell.y - 1 : 0;
+        const size_t kBegin = (cell.z > 0) ? cell.z - 1 : 0;
+        const size_t iEnd = std::min(cell.x + 2, resolution.x);
+        const size_t jEnd = std::min(cell.y + 2, resolution.y);
+        const size_t kEnd = std::min(cell.z + 2, resolution.z);
+
+        for (size_t k = kBegin; k < kEnd; ++k)
+        {
+            for (size_t j = jBegin; j < jEnd; ++j)
+            {
+                for (size_t i = iBegin; i < iEnd; ++i)
+                {
+                    if (activeAcc(i, j, k) != 0)
+                    {
+                        states[p] = 0;
+                        quietFrames[p] = 0;
+                        return;
+                    }
+                }
+            }
+        }
+    });
+}
+
+ConstArrayAccessor1<char> ParticleSystemData3::GetActivityStates() const
+{
+    return m_activityStates.ConstAccessor();
+}
+
+void ParticleSystemData3::ReorderParticles()
+{
+    const auto parallelSearcher =
+        std::dynamic_pointer_cast<PointParallelHashGridSearcher3>(
+            m_neighborSearcher);
+
+    if (parallelSearcher == nullptr)
+    {
+        return;
+    }
+
+    // Maps new index i to old index sortedIndices[i].
+    const std::vector<size_t>& sortedIndices =
+        parallelSearcher->SortedIndices();
+    const size_t numberOfParticles = GetNumberOfParticles();
+
+    if (sortedIndices.size() != numberOfParticles)
+    {
+        return;
+    }
+
+    const Timer timer;
+
+    // SoA channels are backed by scalar data layers, so permuting the scalar
+    // and vector lists covers every attribute of the system.
+    for (ScalarData& scalarData : m_scalarDataList)
+    {
+        ScalarData permuted(numberOfParticles);
+
+        ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+            permuted[i] = scalarData[sortedIndices[i]];
+        });
+
+        scalarData.Swap(permuted);
+    }
+
+    for (VectorData& vectorData : m_vectorDataList)
+    {
+        VectorData permuted(numberOfParticles);
+
+        ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+            permuted[i] = vectorData[sortedIndices[i]];
+        });
+
+        vectorData.Swap(permuted);
+    }
+
+    for (TypedData& typedData : m_typedDataList)
+    {
+        const size_t elementSize = GetTypedDataElementSize(typedData.type);
+        Array1<uint8_t> permuted(numberOfParticles * elementSize);
+
+        ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+            std::memcpy(&permuted[i * elementSize],
+                        &typedData.bytes[sortedIndices[i] * elementSize],
+                        elementSize);
+        });
+
+        typedData.bytes.Swap(permuted);
+    }
+
+    m_reorderOldToNew.resize(numberOfParticles);
+
+    ParallelFor(ZERO_SIZE, numberOfParticles,
+                [&](size_t i) { m_reorderOldToNew[sortedIndices[i]] = i; });
+
+    // Neighbor searcher and lists refer to pre-reorder indices now.
+    m_neighborLists.offsets.clear();
+    m_neighborLists.indices.clear();
+    m_expandedNeighborListsDirty = true;
+
+    CUBBYFLOW_INFO << "Reordering particles took: "
+                   << timer.DurationInSeconds() << " seconds";
+}
+
+const std::vector<size_t>& ParticleSystemData3::GetParticleReorderMap() const
+{
+    return m_reorderOldToNew;
+}
+
+void ParticleSystemData3::RemoveParticles(
+    const ConstArrayAccessor1<char>& shouldRemove)
+{
+    const size_t numberOfParticles = m_numberOfParticles;
+    assert(shouldRemove.size() == numberOfParticles);
+
+    std::vector<size_t> keptIndices;
+    keptIndices.reserve(numberOfParticles);
+
+    for (size_t i = 0; i < numberOfParticles; ++i)
+    {
+        if (shouldRemove[i] == 0)
+        {
+            keptIndices.push_back(i);
+        }
+    }
+
+    const size_t newNumberOfParticles = keptIndices.size();
+
+    if (newNumberOfParticles == numberOfParticles)
+    {
+        return;
+    }
+
+    const Timer timer;
+
+    // SoA channels are backed by scalar data layers, so compacting the scalar
+    // and vector lists covers every attribute of the system.
+    for (ScalarData& scalarData : m_scalarDataList)
+    {
+        ScalarData compacted(newNumberOfParticles);
+
+        ParallelFor(ZERO_SIZE, newNumberOfParticles, [&](size_t i) {
+            compacted[i] = scalarData[keptIndices[i]];
+        });
+
+        scalarData.Swap(compacted);
+    }
+
+    for (VectorData& vectorData : m_vectorDataList)
+    {
+        VectorData compacted(newNumberOfParticles);
+
+        ParallelFor(ZERO_SIZE, newNumberOfParticles, [&](size_t i) {
+            compacted[i] = vectorData[keptIndices[i]];
+        });
+
+        vectorData.Swap(compacted);
+    }
+
+    for (TypedData& typedData : m_typedDataList)
+    {
+        const size_t elementSize = GetTypedDataElementSize(typedData.type);
+        Array1<uint8_t> compacted(newNumberOfParticles * elementSize);
+
+        ParallelFor(ZERO_SIZE, newNumberOfParticles, [&](size_t i) {
+            std::memcpy(&compacted[i * elementSize],
+                        &typedData.bytes[keptIndices[i] * elementSize],
+                        elementSize);
+        });
+
+        typedData.bytes.Swap(compacted);
+    }
+
+    m_numberOfParticles = newNumberOfParticles;
+
+    // Every index-based side structure refers to pre-removal indices now.
+    m_reorderOldToNew.clear();
+    m_activityStates.Clear();
+    m_quietFrameCounts.Clear();
+    m_neighborLists.offsets.clear();
+    m_neighborLists.indices.clear();
+    m_expandedNeighborListsDirty = true;
+
+    CUBBYFLOW_INFO << "Removing " << numberOfParticles - newNumberOfParticles
+                   << " particles took: " << timer.DurationInSeconds()
+                   << " seconds";
+}
+
 void ParticleSystemData3::Serialize(std::vector<uint8_t>* buffer) const
 {
     flatbuffers::FlatBufferBuilder builder{ 1024 };
@@ -322,8 +985,12 @@ void ParticleSystemData3::Set(const ParticleSystemData3& other)
         m_vectorDataList.emplace_back(attr);
     }
 
+    m_soaVectorDataList = other.m_soaVectorDataList;
+    m_typedDataList = other.m_typedDataList;
+
     m_neighborSearcher = other.m_neighborSearcher->Clone();
     m_neighborLists = other.m_neighborLists;
+    m_expandedNeighborListsDirty = true;
 }
 
 void ParticleSystemData3::SerializeParticleSystemData(
@@ -340,6 +1007,50 @@ void ParticleSystemData3::SerializeParticleSystemData(
                 builder->CreateVector(scalarData.data(), scalarData.size()));
         scalarDataList.push_back(fbsScalarData);
     }
+
+    // The cache schema stores f64 layers only, so typed channels widen into
+    // scalar layers trailing the regular ones in registration order. The
+    // in-memory narrow layout is rebuilt by the owner after deserialization.
+    for (const TypedData& typedData : m_typedDataList)
+    {
+        std::vector<double> widened(m_numberOfParticles);
+
+        switch (typedData.type)
+        {
+            case TypedDataType::Float32:
+            {
+                const auto* values =
+                    reinterpret_cast<const float*>(typedData.bytes.data());
+                ParallelFor(ZERO_SIZE, m_numberOfParticles, [&](size_t i) {
+                    widened[i] = static_cast<double>(values[i]);
+                });
+                break;
+            }
+            case TypedDataType::UInt16:
+            {
+                const auto* values =
+                    reinterpret_cast<const uint16_t*>(typedData.bytes.data());
+                ParallelFor(ZERO_SIZE, m_numberOfParticles, [&](size_t i) {
+                    widened[i] = static_cast<double>(values[i]);
+                });
+                break;
+            }
+            case TypedDataType::PackedNormal:
+            {
+                const auto* values =
+                    reinterpret_cast<const uint32_t*>(typedData.bytes.data());
+                ParallelFor(ZERO_SIZE, m_numberOfParticles, [&](size_t i) {
+                    widened[i] = static_cast<double>(values[i]);
+                });
+                break;
+            }
+        }
+
+        scalarDataList.push_back(fbs::CreateScalarParticleData3(
+            *builder,
+            builder->CreateVector(widened.data(), widened.size())));
+    }
+
     const flatbuffers::Offset<
         flatbuffers::Vector<flatbuffers::Offset<fbs::ScalarParticleData3>>>
         fbsScalarDataList = builder->CreateVector(scalarDataList);
@@ -347,11 +1058,10 @@ void ParticleSystemData3::SerializeParticleSystemData(
     std::vector<flatbuffers::Offset<fbs::VectorParticleData3>> vectorDataList;
     for (const auto& vectorData : m_vectorDataList)
     {
-        std::vector<fbs::Vector3D> newVectorData;
-        for (const auto& v : vectorData)
-        {
-            newVectorData.push_back(CubbyFlowToFlatbuffers(v));
-        }
+        std::vector<fbs::Vector3D> newVectorData(vectorData.size());
+        ParallelFor(ZERO_SIZE, vectorData.size(), [&](size_t i) {
+            newVectorData[i] = CubbyFlowToFlatbuffers(vectorData[i]);
+        });
 
         flatbuffers::Offset<fbs::VectorParticleData3> fbsVectorData =
             CreateVectorParticleData3(
@@ -375,10 +1085,17 @@ void ParticleSystemData3::SerializeParticleSystemData(
                                   neighborSearcherSerialized.size()));
 
     // Copy neighbor lists
+    const size_t numberOfLists = (m_neighborLists.offsets.empty())
+                                     ? 0
+                                     : m_neighborLists.offsets.size() - 1;
     std::vector<flatbuffers::Offset<fbs::ParticleNeighborList3>> neighborLists;
-    for (const auto& neighbors : m_neighborLists)
+    for (size_t i = 0; i < numberOfLists; ++i)
     {
-        std::vector<uint64_t> neighbors64(neighbors.begin(), neighbors.end());
+        std::vector<uint64_t> neighbors64;
+        neighbors64.reserve(m_neighborLists.NumberOfNeighbors(i));
+        m_neighborLists.ForEachNeighbor(
+            i, [&](size_t j) { neighbors64.push_back(j); });
+
         flatbuffers::Offset<fbs::ParticleNeighborList3> fbsNeighborList =
             fbs::CreateParticleNeighborList3(
                 *builder,
@@ -400,9 +1117,6 @@ void ParticleSystemData3::SerializeParticleSystemData(
 void ParticleSystemData3::DeserializeParticleSystemData(
     const fbs::ParticleSystemData3* fbsParticleSystemData)
 {
-    m_scalarDataList.clear();
-    m_vectorDataList.clear();
-
     // Copy scalars
     m_radius = fbsParticleSystemData->radius();
     m_mass = fbsParticleSystemData->mass();
@@ -410,16 +1124,24 @@ void ParticleSystemData3::DeserializeParticleSystemData(
     m_velocityIdx = static_cast<size_t>(fbsParticleSystemData->velocityIdx());
     m_forceIdx = static_cast<size_t>(fbsParticleSystemData->forceIdx());
 
-    // Copy data
+    // Copy data, reusing the existing attribute storage when the layout
+    // matches so repeated deserialization (e.g. frame scrubbing) does not
+    // reallocate per frame. Array resizes preserve capacity.
     const flatbuffers::Vector<flatbuffers::Offset<fbs::ScalarParticleData3>>*
         fbsScalarDataList = fbsParticleSystemData->scalarDataList();
+    m_scalarDataList.resize(fbsScalarDataList->size());
+
+    // Typed channels were widened into trailing scalar layers; the owner
+    // re-registers its typed layout against those layers.
+    m_typedDataList.clear();
+
+    size_t attrIdx = 0;
     for (const auto fbsScalarData : (*fbsScalarDataList))
     {
         const flatbuffers::Vector<double>* data = fbsScalarData->data();
 
-        m_scalarDataList.emplace_back(data->size());
-
-        Array<double, 1>& newData = *(m_scalarDataList.rbegin());
+        Array<double, 1>& newData = m_scalarDataList[attrIdx++];
+        newData.Resize(data->size());
 
         for (uint32_t i = 0; i < data->size(); ++i)
         {
@@ -429,14 +1151,16 @@ void ParticleSystemData3::DeserializeParticleSystemData(
 
     const flatbuffers::Vector<flatbuffers::Offset<fbs::VectorParticleData3>>*
         fbsVectorDataList = fbsParticleSystemData->vectorDataList();
+    m_vectorDataList.resize(fbsVectorDataList->size());
+
+    attrIdx = 0;
     for (const auto fbsVectorData : (*fbsVectorDataList))
     {
         const flatbuffers::Vector<const fbs::Vector3D*>* data =
             fbsVectorData->data();
 
-        m_vectorDataList.emplace_back(data->size());
-
-        Array<Vector<double, 3>, 1>& newData = *(m_vectorDataList.rbegin());
+        Array<Vector<double, 3>, 1>& newData = m_vectorDataList[attrIdx++];
+        newData.Resize(data->size());
 
         for (uint32_t i = 0; i < data->size(); ++i)
         {
@@ -446,11 +1170,16 @@ void ParticleSystemData3::DeserializeParticleSystemData(
 
     m_numberOfParticles = m_vectorDataList[0].size();
 
-    // Copy neighbor searcher
+    // Copy neighbor searcher, reusing the existing instance when the type
+    // matches.
     const fbs::PointNeighborSearcherSerialized3* fbsNeighborSearcher =
         fbsParticleSystemData->neighborSearcher();
-    m_neighborSearcher = Factory::BuildPointNeighborSearcher3(
-        fbsNeighborSearcher->type()->c_str());
+    if (m_neighborSearcher == nullptr ||
+        m_neighborSearcher->TypeName() != fbsNeighborSearcher->type()->str())
+    {
+        m_neighborSearcher = Factory::BuildPointNeighborSearcher3(
+            fbsNeighborSearcher->type()->c_str());
+    }
     const std::vector<uint8_t> neighborSearcherSerialized{
         fbsNeighborSearcher->data()->begin(), fbsNeighborSearcher->data()->end()
     };
@@ -459,18 +1188,68 @@ void ParticleSystemData3::DeserializeParticleSystemData(
     // Copy neighbor list
     const flatbuffers::Vector<flatbuffers::Offset<fbs::ParticleNeighborList3>>*
         fbsNeighborLists = fbsParticleSystemData->neighborLists();
-    m_neighborLists.resize(fbsNeighborLists->size());
+    m_neighborLists.offsets.assign(fbsNeighborLists->size() + 1, 0);
+    m_neighborLists.indices.clear();
 
     for (uint32_t i = 0; i < fbsNeighborLists->size(); ++i)
     {
         const flatbuffers::Vector<
             flatbuffers::Offset<fbs::ParticleNeighborList3>>::return_type
             fbsNeighborList = fbsNeighborLists->Get(i);
-        m_neighborLists[i].resize(fbsNeighborList->data()->size());
-        std::transform(fbsNeighborList->data()->begin(),
-                       fbsNeighborList->data()->end(),
-                       m_neighborLists[i].begin(),
-                       [](uint64_t val) { return static_cast<size_t>(val); });
+
+        for (const uint64_t val : *fbsNeighborList->data())
+        {
+            m_neighborLists.indices.push_back(static_cast<uint32_t>(val));
+        }
+
+        m_neighborLists.offsets[i + 1] = m_neighborLists.indices.size();
+    }
+
+    m_expandedNeighborListsDirty = true;
+}
+
+const char* ParticleSystemData3::GetMemoryStatsName() const
+{
+    return "ParticleSystemData3";
+}
+
+void ParticleSystemData3::ReportMemoryUsage(
+    std::vector<MemoryUsageRecord>* records) const
+{
+    size_t scalarBytes = 0;
+    for (const ScalarData& data : m_scalarDataList)
+    {
+        scalarBytes += data.size() * sizeof(double);
     }
+
+    size_t vectorBytes = 0;
+    for (const VectorData& data : m_vectorDataList)
+    {
+        vectorBytes += data.size() * sizeof(Vector3D);
+    }
+
+    size_t typedBytes = 0;
+    for (const TypedData& data : m_typedDataList)
+    {
+        typedBytes += data.bytes.size();
+    }
+
+    size_t expandedBytes = 0;
+    for (const std::vector<size_t>& neighbors : m_expandedNeighborLists)
+    {
+        expandedBytes += neighbors.size() * sizeof(size_t);
+    }
+
+    // The neighbor searcher registers itself and reports its own records.
+    records->push_back(MemoryUsageRecord{ "scalarData", scalarBytes });
+    records->push_back(MemoryUsageRecord{ "vectorData", vectorBytes });
+    records->push_back(MemoryUsageRecord{ "typedData", typedBytes });
+    records->push_back(
+        MemoryUsageRecord{ "neighborLists",
+                           m_neighborLists.offsets.size() * sizeof(size_t) +
+                               m_neighborLists.indices.size() *
+                                   sizeof(uint32_t) });
+    records->push_back(
+        MemoryUsageRecord{ "expandedNeighborLists", expandedBytes });
 }
-}  // namespace CubbyFlow
\ No newline at end of file
+}  // namespace CubbyFlow
@@ -16,15 +16,32 @@
 #include <Core/Particle/SPH/SPHStdKernel3.hpp>
 #include <Core/Utils/Constants.hpp>
 
+#include <algorithm>
+
 namespace CubbyFlow
 {
-SPHStdKernel3::SPHStdKernel3() : h{ 0 }, h2{ 0 }, h3{ 0 }, h5{ 0 }
+SPHStdKernel3::SPHStdKernel3()
+    : h{ 0 },
+      h2{ 0 },
+      h3{ 0 },
+      h5{ 0 },
+      invH2{ 0 },
+      kernelNorm{ 0 },
+      firstDerivativeNorm{ 0 },
+      secondDerivativeNorm{ 0 }
 {
     // Do nothing
 }
 
 SPHStdKernel3::SPHStdKernel3(double kernelRadius)
-    : h{ kernelRadius }, h2{ h * h }, h3{ h2 * h }, h5{ h2 * h2 * h }
+    : h{ kernelRadius },
+      h2{ h * h },
+      h3{ h2 * h },
+      h5{ h2 * h2 * h },
+      invH2{ 1.0 / h2 },
+      kernelNorm{ 315.0 / (64.0 * PI_DOUBLE * h3) },
+      firstDerivativeNorm{ -945.0 / (32.0 * PI_DOUBLE * h5) },
+      secondDerivativeNorm{ 945.0 / (32.0 * PI_DOUBLE * h5) }
 {
     // Do nothing
 }
@@ -38,8 +55,21 @@ double SPHStdKernel3::operator()(double distance) const
         return 0.0;
     }
 
-    const double x = 1.0 - distanceSquared / h2;
-    return 315.0 / (64.0 * PI_DOUBLE * h3) * x * x * x;
+    const double x = 1.0 - distanceSquared * invH2;
+    return kernelNorm * x * x * x;
+}
+
+void SPHStdKernel3::Evaluate(const double* distances, size_t count,
+                             double* weights) const
+{
+    const double scale = kernelNorm;
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        const double x =
+            std::max(1.0 - distances[n] * distances[n] * invH2, 0.0);
+        weights[n] = scale * x * x * x;
+    }
 }
 
 double SPHStdKernel3::FirstDerivative(double distance) const
@@ -49,8 +79,21 @@ double SPHStdKernel3::FirstDerivative(double distance) const
         return 0.0;
     }
 
-    const double x = 1.0 - distance * distance / h2;
-    return -945.0 * distance / (32.0 * PI_DOUBLE * h5) * x * x;
+    const double x = 1.0 - distance * distance * invH2;
+    return firstDerivativeNorm * distance * x * x;
+}
+
+void SPHStdKernel3::FirstDerivative(const double* distances, size_t count,
+                                    double* derivatives) const
+{
+    const double scale = firstDerivativeNorm;
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        const double x =
+            std::max(1.0 - distances[n] * distances[n] * invH2, 0.0);
+        derivatives[n] = scale * distances[n] * x * x;
+    }
 }
 
 Vector3D SPHStdKernel3::Gradient(const Vector3D& point) const
@@ -80,17 +123,48 @@ double SPHStdKernel3::SecondDerivative(double distance) const
         return 0.0;
     }
 
-    const double x = distanceSquared / h2;
-    return 945.0 / (32.0 * PI_DOUBLE * h5) * (1 - x) * (5 * x - 1);
+    const double x = distanceSquared * invH2;
+    return secondDerivativeNorm * (1 - x) * (5 * x - 1);
+}
+
+void SPHStdKernel3::SecondDerivative(const double* distances, size_t count,
+                                     double* derivatives) const
+{
+    const double scale = secondDerivativeNorm;
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        // With t = max(1 - d^2/h^2, 0), t * (4 - 5t) equals
+        // (1 - x) * (5x - 1) inside the support and vanishes outside it.
+        const double t =
+            std::max(1.0 - distances[n] * distances[n] * invH2, 0.0);
+        derivatives[n] = scale * t * (4.0 - 5.0 * t);
+    }
 }
 
-SPHSpikyKernel3::SPHSpikyKernel3() : h{ 0 }, h2{ 0 }, h3{ 0 }, h4{ 0 }, h5{ 0 }
+SPHSpikyKernel3::SPHSpikyKernel3()
+    : h{ 0 },
+      h2{ 0 },
+      h3{ 0 },
+      h4{ 0 },
+      h5{ 0 },
+      kernelNorm{ 0 },
+      firstDerivativeNorm{ 0 },
+      secondDerivativeNorm{ 0 }
 {
     // Do nothing
 }
 
 SPHSpikyKernel3::SPHSpikyKernel3(double kernelRadius)
-    : h{ kernelRadius }, h2{ h * h }, h3{ h2 * h }, h4{ h2 * h2 }, h5{ h3 * h2 }
+    : h{ kernelRadius },
+      h2{ h * h },
+      h3{ h2 * h },
+      h4{ h2 * h2 },
+      h5{ h3 * h2 },
+      invH{ 1.0 / h },
+      kernelNorm{ 15.0 / (PI_DOUBLE * h3) },
+      firstDerivativeNorm{ -45.0 / (PI_DOUBLE * h4) },
+      secondDerivativeNorm{ 90.0 / (PI_DOUBLE * h5) }
 {
     // Do nothing
 }
@@ -102,8 +176,20 @@ double SPHSpikyKernel3::operator()(double distance) const
         return 0.0;
     }
 
-    const double x = 1.0 - distance / h;
-    return 15.0 / (PI_DOUBLE * h3) * x * x * x;
+    const double x = 1.0 - distance * invH;
+    return kernelNorm * x * x * x;
+}
+
+void SPHSpikyKernel3::Evaluate(const double* distances, size_t count,
+                               double* weights) const
+{
+    const double scale = kernelNorm;
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        const double x = std::max(1.0 - distances[n] * invH, 0.0);
+        weights[n] = scale * x * x * x;
+    }
 }
 
 double SPHSpikyKernel3::FirstDerivative(double distance) const
@@ -113,8 +199,20 @@ double SPHSpikyKernel3::FirstDerivative(double distance) const
         return 0.0;
     }
 
-    const double x = 1.0 - distance / h;
-    return -45.0 / (PI_DOUBLE * h4) * x * x;
+    const double x = 1.0 - distance * invH;
+    return firstDerivativeNorm * x * x;
+}
+
+void SPHSpikyKernel3::FirstDerivative(const double* distances, size_t count,
+                                      double* derivatives) const
+{
+    const double scale = firstDerivativeNorm;
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        const double x = std::max(1.0 - distances[n] * invH, 0.0);
+        derivatives[n] = scale * x * x;
+    }
 }
 
 Vector3D SPHSpikyKernel3::Gradient(const Vector3D& point) const
@@ -142,7 +240,19 @@ double SPHSpikyKernel3::SecondDerivative(double distance) const
         return 0.0;
     }
 
-    const double x = 1.0 - distance / h;
-    return 90.0 / (PI_DOUBLE * h5) * x;
+    const double x = 1.0 - distance * invH;
+    return secondDerivativeNorm * x;
+}
+
+void SPHSpikyKernel3::SecondDerivative(const double* distances, size_t count,
+                                       double* derivatives) const
+{
+    const double scale = secondDerivativeNorm;
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        const double x = std::max(1.0 - distances[n] * invH, 0.0);
+        derivatives[n] = scale * x;
+    }
 }
 }  // namespace CubbyFlow
\ No newline at end of file
@@ -12,9 +12,13 @@
 #include <Core/Particle/SPH/SPHStdKernel3.hpp>
 #include <Core/Particle/SPH/SPHSystemData3.hpp>
 #include <Core/PointGenerator/BccLatticePointGenerator.hpp>
+#include <Core/Searcher/PointParallelHashGridSearcher3.hpp>
 
 #include <Flatbuffers/generated/SPHSystemData3_generated.h>
 
+#include <cmath>
+#include <limits>
+
 namespace CubbyFlow
 {
 SPHSystemData3::SPHSystemData3() : SPHSystemData3{ 0 }
@@ -54,6 +58,17 @@ void SPHSystemData3::SetMass(double newMass)
     const double incRatio = newMass / GetMass();
     m_targetDensity *= incRatio;
     ParticleSystemData3::SetMass(newMass);
+    m_massDirty = false;
+}
+
+double SPHSystemData3::GetMass() const
+{
+    if (m_massDirty)
+    {
+        const_cast<SPHSystemData3*>(this)->ComputeMass();
+    }
+
+    return ParticleSystemData3::GetMass();
 }
 
 ConstArrayAccessor1<double> SPHSystemData3::GetDensities() const
@@ -81,18 +96,41 @@ void SPHSystemData3::UpdateDensities()
     ArrayAccessor<Vector3D, 1> p = GetPositions();
     ArrayAccessor<double, 1> d = GetDensities();
     const double m = GetMass();
+    const size_t numberOfParticles = GetNumberOfParticles();
 
-    ParallelFor(ZERO_SIZE, GetNumberOfParticles(), [&](size_t i) {
-        const double sum = SumOfKernelNearby(p[i]);
-        d[i] = m * sum;
-    });
+    const CompactNeighborLists& neighborLists = GetCompactNeighborLists();
+
+    if (neighborLists.offsets.size() == numberOfParticles + 1)
+    {
+        // Neighbor lists are up to date, so sum the kernel over the packed
+        // lists instead of probing the hash grid for every particle.
+        const SPHStdKernel3 kernel{ m_kernelRadius };
+
+        ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+            const Vector3D origin = p[i];
+            double sum = kernel(0.0);
+
+            neighborLists.ForEachNeighbor(i, [&](size_t j) {
+                sum += kernel(origin.DistanceTo(p[j]));
+            });
+
+            d[i] = m * sum;
+        });
+    }
+    else
+    {
+        ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+            const double sum = SumOfKernelNearby(p[i]);
+            d[i] = m * sum;
+        });
+    }
 }
 
 void SPHSystemData3::SetTargetDensity(double targetDensity)
 {
     m_targetDensity = targetDensity;
 
-    ComputeMass();
+    m_massDirty = true;
 }
 
 double SPHSystemData3::GetTargetDensity() const
@@ -107,7 +145,7 @@ void SPHSystemData3::SetTargetSpacing(double spacing)
     m_targetSpacing = spacing;
     m_kernelRadius = m_kernelRadiusOverTargetSpacing * m_targetSpacing;
 
-    ComputeMass();
+    m_massDirty = true;
 }
 
 double SPHSystemData3::GetTargetSpacing() const
@@ -120,7 +158,7 @@ void SPHSystemData3::SetRelativeKernelRadius(double relativeRadius)
     m_kernelRadiusOverTargetSpacing = relativeRadius;
     m_kernelRadius = m_kernelRadiusOverTargetSpacing * m_targetSpacing;
 
-    ComputeMass();
+    m_massDirty = true;
 }
 
 double SPHSystemData3::GetRelativeKernelRadius() const
@@ -133,7 +171,7 @@ void SPHSystemData3::SetKernelRadius(double kernelRadius)
     m_kernelRadius = kernelRadius;
     m_targetSpacing = kernelRadius / m_kernelRadiusOverTargetSpacing;
 
-    ComputeMass();
+    m_massDirty = true;
 }
 
 double SPHSystemData3::GetKernelRadius() const
@@ -143,10 +181,24 @@ double SPHSystemData3::GetKernelRadius() const
 
 double SPHSystemData3::SumOfKernelNearby(const Vector3D& origin) const
 {
+    const SPHStdKernel3 kernel{ m_kernelRadius };
+
+    // The default searcher is the parallel hash grid; its fused accumulate
+    // overload avoids a type-erased callback per neighbor.
+    const PointNeighborSearcher3Ptr& searcher = GetNeighborSearcher();
+    if (const auto gridSearcher =
+            std::dynamic_pointer_cast<PointParallelHashGridSearcher3>(searcher))
+    {
+        return gridSearcher->AccumulateNearbyPoints(
+            origin, m_kernelRadius, 0.0,
+            [&](double sum, size_t, const Vector3D& neighborPosition) {
+                return sum + kernel(origin.DistanceTo(neighborPosition));
+            });
+    }
+
     double sum = 0.0;
-    SPHStdKernel3 kernel{ m_kernelRadius };
 
-    GetNeighborSearcher()->ForEachNearbyPoint(
+    searcher->ForEachNearbyPoint(
         origin, m_kernelRadius, [&](size_t, const Vector3D& neighborPosition) {
             const double dist = origin.DistanceTo(neighborPosition);
             sum += kernel(dist);
@@ -201,13 +253,11 @@ Vector3D SPHSystemData3::GradientAt(
     Vector3D sum;
     const ConstArrayAccessor<Vector3D, 1> p = GetPositions();
     const ConstArrayAccessor<double, 1> d = GetDensities();
-    const std::vector<size_t>& neighbors = GetNeighborLists()[i];
     const Vector3D origin = p[i];
     const SPHSpikyKernel3 kernel{ m_kernelRadius };
     const double m = GetMass();
 
-    for (size_t j : neighbors)
-    {
+    GetCompactNeighborLists().ForEachNeighbor(i, [&](size_t j) {
         Vector3D neighborPosition = p[j];
         const double dist = origin.DistanceTo(neighborPosition);
 
@@ -218,7 +268,7 @@ Vector3D SPHSystemData3::GradientAt(
                    (values[i] / Square(d[i]) + values[j] / Square(d[j])) *
                    kernel.Gradient(dist, dir);
         }
-    }
+    });
 
     return sum;
 }
@@ -229,18 +279,16 @@ double SPHSystemData3::LaplacianAt(
     double sum = 0.0;
     const ConstArrayAccessor<Vector3D, 1> p = GetPositions();
     const ConstArrayAccessor<double, 1> d = GetDensities();
-    const std::vector<size_t>& neighbors = GetNeighborLists()[i];
     const Vector3D origin = p[i];
     const SPHSpikyKernel3 kernel{ m_kernelRadius };
     const double m = GetMass();
 
-    for (size_t j : neighbors)
-    {
+    GetCompactNeighborLists().ForEachNeighbor(i, [&](size_t j) {
         Vector3D neighborPosition = p[j];
         const double dist = origin.DistanceTo(neighborPosition);
         sum +=
             m * (values[j] - values[i]) / d[j] * kernel.SecondDerivative(dist);
-    }
+    });
 
     return sum;
 }
@@ -251,30 +299,257 @@ Vector3D SPHSystemData3::LaplacianAt(
     Vector3D sum;
     const ConstArrayAccessor<Vector3D, 1> p = GetPositions();
     const ConstArrayAccessor<double, 1> d = GetDensities();
-    const std::vector<size_t>& neighbors = GetNeighborLists()[i];
     const Vector3D origin = p[i];
     const SPHSpikyKernel3 kernel{ m_kernelRadius };
     const double m = GetMass();
 
-    for (size_t j : neighbors)
-    {
+    GetCompactNeighborLists().ForEachNeighbor(i, [&](size_t j) {
         Vector3D neighborPosition = p[j];
         const double dist = origin.DistanceTo(neighborPosition);
         sum +=
             m * (values[j] - values[i]) / d[j] * kernel.SecondDerivative(dist);
-    }
+    });
 
     return sum;
 }
 
+void SPHSystemData3::EnableAdaptiveSpacing()
+{
+    if (m_hasAdaptiveSpacing)
+    {
+        return;
+    }
+
+    // Flush any pending mass recalibration before the value is frozen into
+    // the per-particle channel.
+    const double mass = GetMass();
+
+    m_spacingIdx = AddScalarData(m_targetSpacing);
+    m_particleMassIdx = AddScalarData(mass);
+    m_hasAdaptiveSpacing = true;
+}
+
+bool SPHSystemData3::HasAdaptiveSpacing() const
+{
+    return m_hasAdaptiveSpacing;
+}
+
+ConstArrayAccessor1<double> SPHSystemData3::GetParticleSpacings() const
+{
+    assert(m_hasAdaptiveSpacing);
+
+    return ScalarDataAt(m_spacingIdx);
+}
+
+ArrayAccessor1<double> SPHSystemData3::GetParticleSpacings()
+{
+    assert(m_hasAdaptiveSpacing);
+
+    return ScalarDataAt(m_spacingIdx);
+}
+
+ConstArrayAccessor1<double> SPHSystemData3::GetParticleMasses() const
+{
+    assert(m_hasAdaptiveSpacing);
+
+    return ScalarDataAt(m_particleMassIdx);
+}
+
+ArrayAccessor1<double> SPHSystemData3::GetParticleMasses()
+{
+    assert(m_hasAdaptiveSpacing);
+
+    return ScalarDataAt(m_particleMassIdx);
+}
+
+size_t SPHSystemData3::SplitParticles(
+    const ConstArrayAccessor1<char>& shouldSplit, double minSpacing)
+{
+    assert(m_hasAdaptiveSpacing);
+
+    const size_t oldNumberOfParticles = GetNumberOfParticles();
+    assert(shouldSplit.size() == oldNumberOfParticles);
+
+    // Each child carries half the parent volume.
+    const double childSpacingScale = 1.0 / std::cbrt(2.0);
+
+    std::vector<size_t> parents;
+
+    {
+        // Scoped so the accessor cannot outlive the Resize below.
+        const ArrayAccessor1<double> spacings = GetParticleSpacings();
+
+        for (size_t i = 0; i < oldNumberOfParticles; ++i)
+        {
+            if (shouldSplit[i] != 0 &&
+                spacings[i] * childSpacingScale >= minSpacing)
+            {
+                parents.push_back(i);
+            }
+        }
+    }
+
+    if (parents.empty())
+    {
+        return 0;
+    }
+
+    Resize(oldNumberOfParticles + parents.size());
+
+    ArrayAccessor1<Vector3D> positions = GetPositions();
+    ArrayAccessor1<Vector3D> velocities = GetVelocities();
+    ArrayAccessor1<Vector3D> forces = GetForces();
+    ArrayAccessor1<double> spacings = GetParticleSpacings();
+    ArrayAccessor1<double> masses = GetParticleMasses();
+    ArrayAccessor1<double> densities = GetDensities();
+    ArrayAccessor1<double> pressures = GetPressures();
+
+    ParallelFor(ZERO_SIZE, parents.size(), [&](size_t n) {
+        const size_t i = parents[n];
+        const size_t j = oldNumberOfParticles + n;
+
+        const double childSpacing = spacings[i] * childSpacingScale;
+        const double childMass = 0.5 * masses[i];
+
+        // Offsetting the pair along the parent's velocity keeps the children
+        // in the flow plane; a resting parent splits along the x-axis.
+        Vector3D splitDir{ 1.0, 0.0, 0.0 };
+        const double speed = velocities[i].Length();
+        if (speed > std::numeric_limits<double>::epsilon())
+        {
+            splitDir = velocities[i] / speed;
+        }
+
+        const Vector3D offset = 0.25 * childSpacing * splitDir;
+
+        positions[j] = positions[i] + offset;
+        positions[i] -= offset;
+        velocities[j] = velocities[i];
+        forces[j] = forces[i];
+        spacings[i] = childSpacing;
+        spacings[j] = childSpacing;
+        masses[i] = childMass;
+        masses[j] = childMass;
+        densities[j] = densities[i];
+        pressures[j] = pressures[i];
+    });
+
+    return parents.size();
+}
+
+size_t SPHSystemData3::MergeParticles(const ConstArrayAccessor1<char>& canMerge,
+                                      double maxSpacing)
+{
+    assert(m_hasAdaptiveSpacing);
+
+    const size_t numberOfParticles = GetNumberOfParticles();
+    assert(canMerge.size() == numberOfParticles);
+
+    const CompactNeighborLists& neighborLists = GetCompactNeighborLists();
+
+    if (neighborLists.offsets.size() != numberOfParticles + 1)
+    {
+        return 0;
+    }
+
+    ArrayAccessor1<Vector3D> positions = GetPositions();
+    ArrayAccessor1<Vector3D> velocities = GetVelocities();
+    ArrayAccessor1<Vector3D> forces = GetForces();
+    ArrayAccessor1<double> spacings = GetParticleSpacings();
+    ArrayAccessor1<double> masses = GetParticleMasses();
+    ArrayAccessor1<double> densities = GetDensities();
+
+    // The pass is serial and greedy: it is deterministic, each particle
+    // merges at most once, and its cost is dwarfed by the kernel evaluations
+    // the removed particles would have kept costing.
+    Array1<char> consumed(numberOfParticles, 0);
+    Array1<char> shouldRemove(numberOfParticles, 0);
+    size_t numberOfMerges = 0;
+
+    for (size_t i = 0; i < numberOfParticles; ++i)
+    {
+        if (canMerge[i] == 0 || consumed[i] != 0)
+        {
+            continue;
+        }
+
+        size_t partner = i;
+        double partnerDistance = std::numeric_limits<double>::max();
+
+        neighborLists.ForEachNeighbor(i, [&](size_t j) {
+            if (canMerge[j] == 0 || consumed[j] != 0 || j == i)
+            {
+                return;
+            }
+
+            const double mergedSpacing = std::cbrt(
+                spacings[i] * spacings[i] * spacings[i] +
+                spacings[j] * spacings[j] * spacings[j]);
+
+            if (mergedSpacing > maxSpacing)
+            {
+                return;
+            }
+
+            const double distance = positions[i].DistanceTo(positions[j]);
+            if (distance < partnerDistance)
+            {
+                partnerDistance = distance;
+                partner = j;
+            }
+        });
+
+        if (partner == i)
+        {
+            continue;
+        }
+
+        const double m1 = masses[i];
+        const double m2 = masses[partner];
+        const double totalMass = m1 + m2;
+
+        positions[i] =
+            (m1 * positions[i] + m2 * positions[partner]) / totalMass;
+        velocities[i] =
+            (m1 * velocities[i] + m2 * velocities[partner]) / totalMass;
+        forces[i] += forces[partner];
+        densities[i] =
+            (m1 * densities[i] + m2 * densities[partner]) / totalMass;
+        spacings[i] =
+            std::cbrt(spacings[i] * spacings[i] * spacings[i] +
+                      spacings[partner] * spacings[partner] *
+                          spacings[partner]);
+        masses[i] = totalMass;
+
+        consumed[i] = 1;
+        consumed[partner] = 1;
+        shouldRemove[partner] = 1;
+        ++numberOfMerges;
+    }
+
+    if (numberOfMerges == 0)
+    {
+        return 0;
+    }
+
+    RemoveParticles(shouldRemove.ConstAccessor());
+
+    return numberOfMerges;
+}
+
 void SPHSystemData3::BuildNeighborSearcher()
 {
-    ParticleSystemData3::BuildNeighborSearcher(m_kernelRadius);
+    ParticleSystemData3::BuildNeighborSearcher(GetMaxSearchRadius());
+}
+
+void SPHSystemData3::UpdateNeighborSearcher()
+{
+    ParticleSystemData3::UpdateNeighborSearcher(GetMaxSearchRadius());
 }
 
 void SPHSystemData3::BuildNeighborLists()
 {
-    ParticleSystemData3::BuildNeighborLists(m_kernelRadius);
+    ParticleSystemData3::BuildNeighborLists(GetMaxSearchRadius());
 }
 
 void SPHSystemData3::ComputeMass()
@@ -311,10 +586,36 @@ void SPHSystemData3::ComputeMass()
     const double newMass = m_targetDensity / maxNumberDensity;
 
     ParticleSystemData3::SetMass(newMass);
+    m_massDirty = false;
+}
+
+double SPHSystemData3::GetMaxSearchRadius() const
+{
+    if (!m_hasAdaptiveSpacing)
+    {
+        return m_kernelRadius;
+    }
+
+    // The density and interpolation loops still probe with the global kernel
+    // radius, so never shrink below it; only widen for coarse particles.
+    double maxSpacing = 0.0;
+    const ConstArrayAccessor1<double> spacings = GetParticleSpacings();
+
+    for (size_t i = 0; i < spacings.size(); ++i)
+    {
+        maxSpacing = std::max(maxSpacing, spacings[i]);
+    }
+
+    return std::max(m_kernelRadius,
+                    m_kernelRadiusOverTargetSpacing * maxSpacing);
 }
 
 void SPHSystemData3::Serialize(std::vector<uint8_t>* buffer) const
 {
+    // The serialized base data carries the particle mass; flush any pending
+    // recalibration so the snapshot stays consistent.
+    GetMass();
+
     flatbuffers::FlatBufferBuilder builder{ 1024 };
     flatbuffers::Offset<fbs::ParticleSystemData3> fbsParticleSystemData;
 
@@ -350,6 +651,7 @@ void SPHSystemData3::Deserialize(const std::vector<uint8_t>& buffer)
     m_kernelRadius = fbsSPHSystemData->kernelRadius();
     m_pressureIdx = static_cast<size_t>(fbsSPHSystemData->pressureIdx());
     m_densityIdx = static_cast<size_t>(fbsSPHSystemData->densityIdx());
+    m_massDirty = false;
 }
 
 void SPHSystemData3::Set(const SPHSystemData3& other)
@@ -362,5 +664,9 @@ void SPHSystemData3::Set(const SPHSystemData3& other)
     m_kernelRadius = other.m_kernelRadius;
     m_densityIdx = other.m_densityIdx;
     m_pressureIdx = other.m_pressureIdx;
+    m_hasAdaptiveSpacing = other.m_hasAdaptiveSpacing;
+    m_spacingIdx = other.m_spacingIdx;
+    m_particleMassIdx = other.m_particleMassIdx;
+    m_massDirty = other.m_massDirty;
 }
 }  // namespace CubbyFlow
\ No newline at end of file
@@ -9,9 +9,42 @@
 // property of any third parties.
 
 #include <Core/PointGenerator/BccLatticePointGenerator.hpp>
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <cmath>
+#include <vector>
 
 namespace CubbyFlow
 {
+namespace
+{
+//! Number of lattice indices n such that n * step + offset <= extent, using
+//! the same floating-point comparison as the iteration loops so the count
+//! matches them exactly even at boundary ties.
+size_t CountAlong(double extent, double offset, double step)
+{
+    if (offset > extent)
+    {
+        return 0;
+    }
+
+    size_t count =
+        static_cast<size_t>(std::max(0.0, std::floor((extent - offset) / step))) +
+        1;
+    while (static_cast<double>(count) * step + offset <= extent)
+    {
+        ++count;
+    }
+    while (count > 0 &&
+           static_cast<double>(count - 1) * step + offset > extent)
+    {
+        --count;
+    }
+    return count;
+}
+}  // namespace
+
 void BccLatticePointGenerator::ForEachPoint(
     const BoundingBox3D& boundingBox, double spacing,
     const std::function<bool(const Vector3D&)>& callback) const
@@ -50,4 +83,54 @@ void BccLatticePointGenerator::ForEachPoint(
         hasOffset = !hasOffset;
     }
 }
+
+void BccLatticePointGenerator::Generate(const BoundingBox3D& boundingBox,
+                                        double spacing,
+                                        Array1<Vector3D>* points) const
+{
+    const double halfSpacing = spacing / 2.0;
+    const double boxWidth = boundingBox.GetWidth();
+    const double boxHeight = boundingBox.GetHeight();
+    const double boxDepth = boundingBox.GetDepth();
+
+    // Exact point count per z-slab; odd slabs carry the half-spacing offset.
+    const size_t numSlabs = CountAlong(boxDepth, 0.0, halfSpacing);
+    std::vector<size_t> slabOffsets(numSlabs + 1, 0);
+    for (size_t k = 0; k < numSlabs; ++k)
+    {
+        const double offset = (k & 1) ? halfSpacing : 0.0;
+        const size_t numX = CountAlong(boxWidth, offset, spacing);
+        const size_t numY = CountAlong(boxHeight, offset, spacing);
+        slabOffsets[k + 1] = slabOffsets[k] + numX * numY;
+    }
+
+    // Single append-style resize, then fill the slabs in parallel.
+    const size_t baseIndex = points->size();
+    points->Resize(baseIndex + slabOffsets[numSlabs]);
+    ArrayAccessor1<Vector3D> output = points->Accessor();
+
+    ParallelFor(ZERO_SIZE, numSlabs, [&](size_t k) {
+        const double offset = (k & 1) ? halfSpacing : 0.0;
+        const size_t numX = CountAlong(boxWidth, offset, spacing);
+        const size_t numY = CountAlong(boxHeight, offset, spacing);
+
+        Vector3D position;
+        position.z = static_cast<double>(k) * halfSpacing +
+                     boundingBox.lowerCorner.z;
+
+        size_t index = baseIndex + slabOffsets[k];
+        for (size_t j = 0; j < numY; ++j)
+        {
+            position.y = static_cast<double>(j) * spacing + offset +
+                         boundingBox.lowerCorner.y;
+
+            for (size_t i = 0; i < numX; ++i)
+            {
+                position.x = static_cast<double>(i) * spacing + offset +
+                             boundingBox.lowerCorner.x;
+                output[index++] = position;
+            }
+        }
+    });
+}
 }  // namespace CubbyFlow
\ No newline at end of file
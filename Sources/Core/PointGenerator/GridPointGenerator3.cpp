@@ -9,9 +9,39 @@
 // property of any third parties.
 
 #include <Core/PointGenerator/GridPointGenerator3.hpp>
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <cmath>
 
 namespace CubbyFlow
 {
+namespace
+{
+//! Number of grid indices n such that n * spacing <= extent, counted with the
+//! same floating-point comparison as the iteration loops so boundary ties
+//! resolve identically.
+size_t CountAlong(double extent, double spacing)
+{
+    if (extent < 0.0)
+    {
+        return 0;
+    }
+
+    size_t count =
+        static_cast<size_t>(std::max(0.0, std::floor(extent / spacing))) + 1;
+    while (static_cast<double>(count) * spacing <= extent)
+    {
+        ++count;
+    }
+    while (count > 0 && static_cast<double>(count - 1) * spacing > extent)
+    {
+        --count;
+    }
+    return count;
+}
+}  // namespace
+
 void GridPointGenerator3::ForEachPoint(
     const BoundingBox3D& boundingBox, double spacing,
     const std::function<bool(const Vector3D&)>& callback) const
@@ -43,4 +73,43 @@ void GridPointGenerator3::ForEachPoint(
         }
     }
 }
+
+void GridPointGenerator3::Generate(const BoundingBox3D& boundingBox,
+                                   double spacing,
+                                   Array1<Vector3D>* points) const
+{
+    const double boxWidth = boundingBox.GetWidth();
+    const double boxHeight = boundingBox.GetHeight();
+    const double boxDepth = boundingBox.GetDepth();
+
+    const size_t numX = CountAlong(boxWidth, spacing);
+    const size_t numY = CountAlong(boxHeight, spacing);
+    const size_t numZ = CountAlong(boxDepth, spacing);
+    const size_t numPointsPerSlab = numX * numY;
+
+    // Single append-style resize, then fill the slabs in parallel.
+    const size_t baseIndex = points->size();
+    points->Resize(baseIndex + numPointsPerSlab * numZ);
+    ArrayAccessor1<Vector3D> output = points->Accessor();
+
+    ParallelFor(ZERO_SIZE, numZ, [&](size_t k) {
+        Vector3D position;
+        position.z = static_cast<double>(k) * spacing +
+                     boundingBox.lowerCorner.z;
+
+        size_t index = baseIndex + numPointsPerSlab * k;
+        for (size_t j = 0; j < numY; ++j)
+        {
+            position.y = static_cast<double>(j) * spacing +
+                         boundingBox.lowerCorner.y;
+
+            for (size_t i = 0; i < numX; ++i)
+            {
+                position.x = static_cast<double>(i) * spacing +
+                             boundingBox.lowerCorner.x;
+                output[index++] = position;
+            }
+        }
+    });
+}
 }  // namespace CubbyFlow
\ No newline at end of file
@@ -9,9 +9,42 @@
 // property of any third parties.
 
 #include <Core/PointGenerator/TrianglePointGenerator.hpp>
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <cmath>
+#include <vector>
 
 namespace CubbyFlow
 {
+namespace
+{
+//! Number of lattice indices n such that n * step + offset <= extent, counted
+//! with the same floating-point comparison as the iteration loops so boundary
+//! ties resolve identically.
+size_t CountAlong(double extent, double offset, double step)
+{
+    if (offset > extent)
+    {
+        return 0;
+    }
+
+    size_t count =
+        static_cast<size_t>(std::max(0.0, std::floor((extent - offset) / step))) +
+        1;
+    while (static_cast<double>(count) * step + offset <= extent)
+    {
+        ++count;
+    }
+    while (count > 0 &&
+           static_cast<double>(count - 1) * step + offset > extent)
+    {
+        --count;
+    }
+    return count;
+}
+}  // namespace
+
 void TrianglePointGenerator::ForEachPoint(
     const BoundingBox2D& boundingBox, double spacing,
     const std::function<bool(const Vector2D&)>& callback) const
@@ -45,4 +78,46 @@ void TrianglePointGenerator::ForEachPoint(
     }
 }
 
+void TrianglePointGenerator::Generate(const BoundingBox2D& boundingBox,
+                                      double spacing,
+                                      Array1<Vector2D>* points) const
+{
+    const double halfSpacing = spacing / 2.0;
+    const double ySpacing = spacing * std::sqrt(3.0) / 2.0;
+    const double boxWidth = boundingBox.GetWidth();
+    const double boxHeight = boundingBox.GetHeight();
+
+    // Exact point count per row; odd rows carry the half-spacing offset.
+    const size_t numRows = CountAlong(boxHeight, 0.0, ySpacing);
+    std::vector<size_t> rowOffsets(numRows + 1, 0);
+    for (size_t j = 0; j < numRows; ++j)
+    {
+        const double offset = (j & 1) ? halfSpacing : 0.0;
+        rowOffsets[j + 1] =
+            rowOffsets[j] + CountAlong(boxWidth, offset, spacing);
+    }
+
+    // Single append-style resize, then fill the rows in parallel.
+    const size_t baseIndex = points->size();
+    points->Resize(baseIndex + rowOffsets[numRows]);
+    ArrayAccessor1<Vector2D> output = points->Accessor();
+
+    ParallelFor(ZERO_SIZE, numRows, [&](size_t j) {
+        const double offset = (j & 1) ? halfSpacing : 0.0;
+        const size_t numX = CountAlong(boxWidth, offset, spacing);
+
+        Vector2D position;
+        position.y = static_cast<double>(j) * ySpacing +
+                     boundingBox.lowerCorner.y;
+
+        size_t index = baseIndex + rowOffsets[j];
+        for (size_t i = 0; i < numX; ++i)
+        {
+            position.x = static_cast<double>(i) * spacing + offset +
+                         boundingBox.lowerCorner.x;
+            output[index++] = position;
+        }
+    });
+}
+
 }  // namespace CubbyFlow
\ No newline at end of file
@@ -16,6 +16,8 @@
 #include <Core/Solver/LevelSet/FMMLevelSetSolver3.hpp>
 #include <Core/Utils/Logging.hpp>
 
+#include <atomic>
+
 namespace CubbyFlow
 {
 inline double P(double distance)
@@ -53,6 +55,152 @@ inline double W(const Vector3D& r, const Matrix3x3D& g, double gDet)
     return sigma * gDet * P((g * r).Length());
 }
 
+namespace
+{
+//! Computes the anisotropy matrix for one particle from the covariance of
+//! its neighborhood around \p xMean, following Yu and Turk's estimator.
+Matrix3x3D ComputeG(const PointKdTreeSearcher3Ptr& neighborSearcher,
+                    const Vector3D& x, const Vector3D& xMean, double h,
+                    double r)
+{
+    const double invH = 1 / h;
+
+    // Compute covariance matrix
+    // We start with small scale matrix (h*h) in order to
+    // prevent zero covariance matrix when points are all
+    // perfectly lined up.
+    Matrix3x3D cov = Matrix3x3D::MakeScaleMatrix(h * h, h * h, h * h);
+    double wSum = 0.0;
+    const auto getCov = [&](size_t, const Vector3D& xj) {
+        const double wj = Wij((xMean - xj).Length(), r);
+        wSum += wj;
+        cov += wj * Vvt(xj - xMean);
+    };
+    neighborSearcher->ForEachNearbyPoint(x, r, getCov);
+
+    cov /= wSum;
+
+    // SVD
+    Matrix3x3D u;
+    Vector3D v;
+    Matrix3x3D w;
+    SVD(cov, u, v, w);
+
+    // Take off the sign
+    v.x = std::fabs(v.x);
+    v.y = std::fabs(v.y);
+    v.z = std::fabs(v.z);
+
+    // Constrain Sigma
+    const double maxSingularVal = v.Max();
+    const double kr = 4.0;
+    v.x = std::max(v.x, maxSingularVal / kr);
+    v.y = std::max(v.y, maxSingularVal / kr);
+    v.z = std::max(v.z, maxSingularVal / kr);
+
+    const Matrix3x3D invSigma = Matrix3x3D::MakeScaleMatrix(1.0 / v);
+
+    // Compute G
+    // Volume preservation
+    const double scale = std::pow(v.x * v.y * v.z, 1.0 / 3.0);
+    return invH * scale * (w * invSigma * u.Transposed());
+}
+
+//! Computes the anisotropy matrices and smoothed kernel centers for all
+//! \p points, following Yu and Turk's estimator.
+void ComputeGsAndXMeans(const ConstArrayAccessor1<Vector3D>& points,
+                        const PointKdTreeSearcher3Ptr& neighborSearcher,
+                        double h, double positionSmoothingFactor,
+                        size_t minNumNeighbors, std::vector<Matrix3x3D>* gs,
+                        Array1<Vector3D>* xMeans)
+{
+    const double invH = 1 / h;
+    const double r = 2.0 * h;
+
+    gs->resize(points.size());
+    xMeans->Resize(points.size());
+
+    ParallelFor(ZERO_SIZE, points.size(), [&](size_t i) {
+        const Vector3D& x = points[i];
+
+        // Compute xMean
+        Vector3D xMean;
+        double wSum = 0.0;
+        size_t numNeighbors = 0;
+        const auto getXMean = [&](size_t, const Vector3D& xj) {
+            const double wj = Wij((x - xj).Length(), r);
+            wSum += wj;
+            xMean += wj * xj;
+            ++numNeighbors;
+        };
+        neighborSearcher->ForEachNearbyPoint(x, r, getXMean);
+
+        assert(wSum > 0.0);
+        xMean /= wSum;
+
+        (*xMeans)[i] = Lerp(x, xMean, positionSmoothingFactor);
+
+        if (numNeighbors < minNumNeighbors)
+        {
+            (*gs)[i] = Matrix3x3D::MakeScaleMatrix(invH, invH, invH);
+        }
+        else
+        {
+            (*gs)[i] = ComputeG(neighborSearcher, x, xMean, h, r);
+        }
+    });
+}
+
+//! Splats the anisotropic kernels onto the output grid and redistances or
+//! swaps the result depending on \p isOutputSDF.
+void SplatAndFinalize(const ConstArrayAccessor1<Vector3D>& points,
+                      const PointKdTreeSearcher3Ptr& neighborSearcher,
+                      const std::vector<Matrix3x3D>& gs,
+                      const Array1<Vector3D>& xMeans, double h,
+                      double cutOffDensity, bool isOutputSDF,
+                      ScalarGrid3* output)
+{
+    const double r = 2.0 * h;
+
+    // SPH estimator
+    SPHSystemData3 meanParticles;
+    meanParticles.AddParticles(points);
+    meanParticles.SetNeighborSearcher(neighborSearcher);
+    meanParticles.SetKernelRadius(h);
+    meanParticles.UpdateDensities();
+    const ArrayAccessor<double, 1> d = meanParticles.GetDensities();
+    const double m = meanParticles.GetMass();
+
+    PointKdTreeSearcher3 xMeanSearcher;
+    xMeanSearcher.Build(xMeans.ConstAccessor());
+
+    // Compute SDF
+    const std::shared_ptr<ScalarGrid3> temp = output->Clone();
+    temp->Fill([&](const Vector3D& x) {
+        double sum = 0.0;
+        xMeanSearcher.ForEachNearbyPoint(
+            x, r, [&](size_t i, const Vector3D& neighborPosition) {
+                sum += m / d[i] *
+                       W(neighborPosition - x, gs[i], gs[i].Determinant());
+            });
+
+        return cutOffDensity - sum;
+    });
+
+    CUBBYFLOW_INFO << "Computed SDF.";
+
+    if (isOutputSDF)
+    {
+        FMMLevelSetSolver3 solver;
+        solver.Reinitialize(*temp, std::numeric_limits<double>::max(), output);
+    }
+    else
+    {
+        temp->Swap(output);
+    }
+}
+}  // namespace
+
 AnisotropicPointsToImplicit3::AnisotropicPointsToImplicit3(
     double kernelRadius, double cutOffDensity, double positionSmoothingFactor,
     size_t minNumNeighbors, bool isOutputSDF)
@@ -88,30 +236,88 @@ void AnisotropicPointsToImplicit3::Convert(
         return;
     }
 
+    const double h = m_kernelRadius;
+
+    // Mean estimator for cov. mat.
+    const PointKdTreeSearcher3Ptr meanNeighborSearcher =
+        PointKdTreeSearcher3::Builder{}.MakeShared();
+    meanNeighborSearcher->Build(points);
+
+    CUBBYFLOW_INFO << "Built neighbor searcher.";
+
+    // Compute G and xMean
+    std::vector<Matrix3x3D> gs;
+    Array1<Vector3D> xMeans;
+    ComputeGsAndXMeans(points, meanNeighborSearcher, h,
+                       m_positionSmoothingFactor, m_minNumNeighbors, &gs,
+                       &xMeans);
+
+    CUBBYFLOW_INFO << "Computed G and means.";
+
+    SplatAndFinalize(points, meanNeighborSearcher, gs, xMeans, h,
+                     m_cutOffDensity, m_isOutputSDF, output);
+
+    CUBBYFLOW_INFO << "Done converting points to implicit surface.";
+}
+
+void AnisotropicPointsToImplicit3::ConvertIncremental(
+    const ConstArrayAccessor1<Vector3D>& points, AnisotropyCache* cache,
+    ScalarGrid3* output, double positionTolerance,
+    size_t neighborCountTolerance) const
+{
+    if (output == nullptr)
+    {
+        CUBBYFLOW_WARN << "Null scalar grid output pointer provided.";
+        return;
+    }
+
+    if (cache == nullptr)
+    {
+        CUBBYFLOW_WARN << "Null anisotropy cache pointer provided.";
+        return;
+    }
+
+    const Size3& res = output->Resolution();
+    if (res.x * res.y * res.z == 0)
+    {
+        CUBBYFLOW_WARN << "Empty grid is provided.";
+        return;
+    }
+
+    const BoundingBox3D& bbox = output->BoundingBox();
+    if (bbox.IsEmpty())
+    {
+        CUBBYFLOW_WARN << "Empty domain is provided.";
+        return;
+    }
+
     const double h = m_kernelRadius;
     const double invH = 1 / h;
     const double r = 2.0 * h;
 
-    // Mean estimator for cov. mat.
     const PointKdTreeSearcher3Ptr meanNeighborSearcher =
         PointKdTreeSearcher3::Builder{}.MakeShared();
     meanNeighborSearcher->Build(points);
 
     CUBBYFLOW_INFO << "Built neighbor searcher.";
 
-    SPHSystemData3 meanParticles;
-    meanParticles.AddParticles(points);
-    meanParticles.SetNeighborSearcher(meanNeighborSearcher);
-    meanParticles.SetKernelRadius(r);
+    const size_t n = points.size();
+    const bool warmCache = cache->positions.size() == n &&
+                           cache->numNeighbors.size() == n &&
+                           cache->gs.size() == n;
+    const double toleranceSquared =
+        positionTolerance * h * positionTolerance * h;
 
-    // Compute G and xMean
-    std::vector<Matrix3x3D> gs(points.size());
-    Array1<Vector3D> xMeans{ points.size() };
+    std::vector<Matrix3x3D> gs(n);
+    Array1<Vector3D> xMeans{ n };
+    std::vector<size_t> numNeighborsList(n);
+    std::atomic<size_t> numReused{ 0 };
 
-    ParallelFor(ZERO_SIZE, points.size(), [&](size_t i) {
+    ParallelFor(ZERO_SIZE, n, [&](size_t i) {
         const Vector3D& x = points[i];
 
-        // Compute xMean
+        // The mean pass is always refreshed; it is cheap compared to the
+        // covariance pass plus SVD and also yields the reuse signals.
         Vector3D xMean;
         double wSum = 0.0;
         size_t numNeighbors = 0;
@@ -127,92 +333,173 @@ void AnisotropicPointsToImplicit3::Convert(
         xMean /= wSum;
 
         xMeans[i] = Lerp(x, xMean, m_positionSmoothingFactor);
+        numNeighborsList[i] = numNeighbors;
+
+        if (warmCache)
+        {
+            const size_t prevNumNeighbors = cache->numNeighbors[i];
+            const size_t neighborDelta = (numNeighbors > prevNumNeighbors)
+                                             ? numNeighbors - prevNumNeighbors
+                                             : prevNumNeighbors - numNeighbors;
+
+            if (neighborDelta <= neighborCountTolerance &&
+                (x - cache->positions[i]).LengthSquared() <= toleranceSquared)
+            {
+                gs[i] = cache->gs[i];
+                ++numReused;
+                return;
+            }
+        }
 
         if (numNeighbors < m_minNumNeighbors)
         {
-            const Matrix3x3D g = Matrix3x3D::MakeScaleMatrix(invH, invH, invH);
-            gs[i] = g;
+            gs[i] = Matrix3x3D::MakeScaleMatrix(invH, invH, invH);
         }
         else
         {
-            // Compute covariance matrix
-            // We start with small scale matrix (h*h) in order to
-            // prevent zero covariance matrix when points are all
-            // perfectly lined up.
-            Matrix3x3D cov = Matrix3x3D::MakeScaleMatrix(h * h, h * h, h * h);
-            wSum = 0.0;
-            const auto getCov = [&](size_t, const Vector3D& xj) {
-                const double wj = Wij((xMean - xj).Length(), r);
-                wSum += wj;
-                cov += wj * Vvt(xj - xMean);
-            };
-            meanNeighborSearcher->ForEachNearbyPoint(x, r, getCov);
-
-            cov /= wSum;
-
-            // SVD
-            Matrix3x3D u;
-            Vector3D v;
-            Matrix3x3D w;
-            SVD(cov, u, v, w);
-
-            // Take off the sign
-            v.x = std::fabs(v.x);
-            v.y = std::fabs(v.y);
-            v.z = std::fabs(v.z);
-
-            // Constrain Sigma
-            const double maxSingularVal = v.Max();
-            const double kr = 4.0;
-            v.x = std::max(v.x, maxSingularVal / kr);
-            v.y = std::max(v.y, maxSingularVal / kr);
-            v.z = std::max(v.z, maxSingularVal / kr);
-
-            const Matrix3x3D invSigma = Matrix3x3D::MakeScaleMatrix(1.0 / v);
-
-            // Compute G
-            // Volume preservation
-            const double scale = std::pow(v.x * v.y * v.z, 1.0 / 3.0);
-            const Matrix3x3D g = invH * scale * (w * invSigma * u.Transposed());
-            gs[i] = g;
+            gs[i] = ComputeG(meanNeighborSearcher, x, xMean, h, r);
         }
     });
 
-    CUBBYFLOW_INFO << "Computed G and means.";
+    CUBBYFLOW_INFO << "Computed G and means (reused " << numReused << "/" << n
+                   << " anisotropy matrices).";
 
-    // SPH estimator
-    meanParticles.SetKernelRadius(h);
-    meanParticles.UpdateDensities();
-    const ArrayAccessor<double, 1> d = meanParticles.GetDensities();
-    const double m = meanParticles.GetMass();
+    SplatAndFinalize(points, meanNeighborSearcher, gs, xMeans, h,
+                     m_cutOffDensity, m_isOutputSDF, output);
 
-    PointKdTreeSearcher3 meanNeighborSearcher3;
-    meanNeighborSearcher3.Build(xMeans);
+    cache->positions.resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        cache->positions[i] = points[i];
+    }
+    cache->numNeighbors = std::move(numNeighborsList);
+    cache->gs = std::move(gs);
 
-    // Compute SDF
-    std::shared_ptr<ScalarGrid3> temp = output->Clone();
-    temp->Fill([&](const Vector3D& x) {
-        double sum = 0.0;
-        meanNeighborSearcher3.ForEachNearbyPoint(
-            x, r, [&](size_t i, const Vector3D& neighborPosition) {
-                sum += m / d[i] *
-                       W(neighborPosition - x, gs[i], gs[i].Determinant());
-            });
+    CUBBYFLOW_INFO << "Done converting points to implicit surface.";
+}
 
-        return m_cutOffDensity - sum;
-    });
+void AnisotropicPointsToImplicit3::ConvertStreaming(
+    const PointsInRegionFunc& pointsInRegion, ScalarGrid3* output,
+    size_t slabThickness) const
+{
+    if (output == nullptr)
+    {
+        CUBBYFLOW_WARN << "Null scalar grid output pointer provided.";
+        return;
+    }
 
-    CUBBYFLOW_INFO << "Computed SDF.";
+    const Size3& res = output->Resolution();
+    if (res.x * res.y * res.z == 0)
+    {
+        CUBBYFLOW_WARN << "Empty grid is provided.";
+        return;
+    }
+
+    const BoundingBox3D& bbox = output->BoundingBox();
+    if (bbox.IsEmpty())
+    {
+        CUBBYFLOW_WARN << "Empty domain is provided.";
+        return;
+    }
+
+    const double h = m_kernelRadius;
+    const double r = 2.0 * h;
+
+    // Grid values in a slab depend on smoothed kernel centers within r.
+    // Those centers can drift up to r from their source particles, whose
+    // anisotropy and density estimates in turn depend on neighbors within
+    // another r, so a 3r band around the slab holds everything needed.
+    const double fetchMargin = 3.0 * r;
+
+    const Size3 dataSize = output->GetDataSize();
+    const Vector3D dataOrigin = output->GetDataOrigin();
+    const Vector3D gridSpacing = output->GridSpacing();
+
+    slabThickness = std::max(slabThickness, static_cast<size_t>(1));
+    const size_t numSlabs = (dataSize.z + slabThickness - 1) / slabThickness;
+
+    auto data = output->GetDataAccessor();
+    auto pos = output->GetDataPosition();
+
+    std::vector<Vector3D> slabPoints;
+    for (size_t slab = 0; slab < numSlabs; ++slab)
+    {
+        const size_t kBegin = slab * slabThickness;
+        const size_t kEnd = std::min(kBegin + slabThickness, dataSize.z);
+
+        BoundingBox3D region{
+            dataOrigin + gridSpacing * Vector3D{ 0.0, 0.0,
+                                                 static_cast<double>(kBegin) },
+            dataOrigin +
+                gridSpacing * Vector3D{ static_cast<double>(dataSize.x - 1),
+                                        static_cast<double>(dataSize.y - 1),
+                                        static_cast<double>(kEnd - 1) }
+        };
+        region.Expand(fetchMargin);
+
+        slabPoints.clear();
+        pointsInRegion(region, &slabPoints);
+
+        if (slabPoints.empty())
+        {
+            ParallelFor(ZERO_SIZE, dataSize.x, ZERO_SIZE, dataSize.y, kBegin,
+                        kEnd, [&](size_t i, size_t j, size_t k) {
+                            data(i, j, k) = m_cutOffDensity;
+                        });
+            continue;
+        }
+
+        const ConstArrayAccessor1<Vector3D> slabAccessor{ slabPoints.size(),
+                                                          slabPoints.data() };
+
+        const PointKdTreeSearcher3Ptr slabNeighborSearcher =
+            PointKdTreeSearcher3::Builder{}.MakeShared();
+        slabNeighborSearcher->Build(slabAccessor);
+
+        std::vector<Matrix3x3D> gs;
+        Array1<Vector3D> xMeans;
+        ComputeGsAndXMeans(slabAccessor, slabNeighborSearcher, h,
+                           m_positionSmoothingFactor, m_minNumNeighbors, &gs,
+                           &xMeans);
+
+        SPHSystemData3 slabParticles;
+        slabParticles.AddParticles(slabAccessor);
+        slabParticles.SetNeighborSearcher(slabNeighborSearcher);
+        slabParticles.SetKernelRadius(h);
+        slabParticles.UpdateDensities();
+        const ArrayAccessor<double, 1> d = slabParticles.GetDensities();
+        const double m = slabParticles.GetMass();
+
+        PointKdTreeSearcher3 xMeanSearcher;
+        xMeanSearcher.Build(xMeans.ConstAccessor());
+
+        ParallelFor(ZERO_SIZE, dataSize.x, ZERO_SIZE, dataSize.y, kBegin, kEnd,
+                    [&](size_t i, size_t j, size_t k) {
+                        const Vector3D x = pos(i, j, k);
+
+                        double sum = 0.0;
+                        xMeanSearcher.ForEachNearbyPoint(
+                            x, r,
+                            [&](size_t idx, const Vector3D& neighborPosition) {
+                                sum += m / d[idx] *
+                                       W(neighborPosition - x, gs[idx],
+                                         gs[idx].Determinant());
+                            });
+
+                        data(i, j, k) = m_cutOffDensity - sum;
+                    });
+
+        CUBBYFLOW_INFO << "Computed SDF slab " << slab + 1 << "/" << numSlabs
+                       << " with " << slabPoints.size() << " points.";
+    }
 
     if (m_isOutputSDF)
     {
+        const std::shared_ptr<ScalarGrid3> temp = output->Clone();
+
         FMMLevelSetSolver3 solver;
         solver.Reinitialize(*temp, std::numeric_limits<double>::max(), output);
     }
-    else
-    {
-        temp->Swap(output);
-    }
 
     CUBBYFLOW_INFO << "Done converting points to implicit surface.";
 }
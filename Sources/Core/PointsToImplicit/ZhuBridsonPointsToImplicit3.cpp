@@ -8,10 +8,14 @@
 // personal capacity and are not conveying any rights to any intellectual
 // property of any third parties.
 
-#include <Core/Particle/ParticleSystemData3.hpp>
+#include <Core/Array/Array3.hpp>
 #include <Core/PointsToImplicit/ZhuBridsonPointsToImplicit3.hpp>
 #include <Core/Solver/LevelSet/FMMLevelSetSolver3.hpp>
 #include <Core/Utils/Logging.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <algorithm>
+#include <cmath>
 
 namespace CubbyFlow
 {
@@ -53,33 +57,129 @@ void ZhuBridsonPointsToImplicit3::Convert(
         return;
     }
 
-    ParticleSystemData3 particles;
-    particles.AddParticles(points);
-    particles.BuildNeighborSearcher(m_kernelRadius);
-
-    const PointNeighborSearcher3Ptr neighborSearcher =
-        particles.GetNeighborSearcher();
     const double isoContValue = m_cutOffThreshold * m_kernelRadius;
 
     auto temp = output->Clone();
-    temp->Fill([&](const Vector3D& x) -> double {
-        Vector3D xAvg;
-        double wSum = 0.0;
-        const auto func = [&](size_t, const Vector3D& xi) {
-            const double wi = k((x - xi).Length() / m_kernelRadius);
-            wSum += wi;
-            xAvg += wi * xi;
-        };
-        neighborSearcher->ForEachNearbyPoint(x, m_kernelRadius, func);
-
-        if (wSum > 0.0)
+
+    const Size3 dataSize = temp->GetDataSize();
+    const Vector3D dataOrigin = temp->GetDataOrigin();
+    const Vector3D gridSpacing = temp->GridSpacing();
+
+    // Scatter pass: instead of running a neighbor search per data point,
+    // splat each particle onto the data points inside its kernel support.
+    // Particles are binned into z-slab tiles that own disjoint cell ranges,
+    // so the slabs can accumulate in parallel without write conflicts. A
+    // slab is at least one kernel support thick, meaning a particle can
+    // only reach cells of its own and the two adjacent slabs.
+    Array3<double> wSum{ dataSize, 0.0 };
+    Array3<Vector3D> xAvg{ dataSize };
+
+    const auto slabThickness = std::max(
+        static_cast<ssize_t>(std::ceil(m_kernelRadius / gridSpacing.z)),
+        static_cast<ssize_t>(1));
+    const size_t numSlabs =
+        (dataSize.z + slabThickness - 1) / slabThickness;
+
+    std::vector<std::vector<size_t>> slabBins(numSlabs);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        const auto zIndex = static_cast<ssize_t>(
+            std::floor((points[i].z - dataOrigin.z) / gridSpacing.z));
+        const size_t slab = static_cast<size_t>(std::clamp(
+            zIndex / slabThickness, static_cast<ssize_t>(0),
+            static_cast<ssize_t>(numSlabs - 1)));
+        slabBins[slab].push_back(i);
+    }
+
+    ParallelFor(ZERO_SIZE, numSlabs, [&](size_t slab) {
+        const ssize_t zBegin = static_cast<ssize_t>(slab) * slabThickness;
+        const ssize_t zEnd =
+            std::min(zBegin + slabThickness, static_cast<ssize_t>(dataSize.z));
+
+        for (ssize_t neighborSlab = static_cast<ssize_t>(slab) - 1;
+             neighborSlab <= static_cast<ssize_t>(slab) + 1; ++neighborSlab)
+        {
+            if (neighborSlab < 0 ||
+                neighborSlab >= static_cast<ssize_t>(numSlabs))
+            {
+                continue;
+            }
+
+            for (const size_t pointIndex : slabBins[neighborSlab])
+            {
+                const Vector3D& xi = points[pointIndex];
+
+                const auto iBegin = std::max(
+                    static_cast<ssize_t>(std::ceil(
+                        (xi.x - m_kernelRadius - dataOrigin.x) /
+                        gridSpacing.x)),
+                    static_cast<ssize_t>(0));
+                const auto iEnd = std::min(
+                    static_cast<ssize_t>(std::floor(
+                        (xi.x + m_kernelRadius - dataOrigin.x) /
+                        gridSpacing.x)),
+                    static_cast<ssize_t>(dataSize.x) - 1);
+                const auto jBegin = std::max(
+                    static_cast<ssize_t>(std::ceil(
+                        (xi.y - m_kernelRadius - dataOrigin.y) /
+                        gridSpacing.y)),
+                    static_cast<ssize_t>(0));
+                const auto jEnd = std::min(
+                    static_cast<ssize_t>(std::floor(
+                        (xi.y + m_kernelRadius - dataOrigin.y) /
+                        gridSpacing.y)),
+                    static_cast<ssize_t>(dataSize.y) - 1);
+                const auto kBegin = std::max(
+                    static_cast<ssize_t>(std::ceil(
+                        (xi.z - m_kernelRadius - dataOrigin.z) /
+                        gridSpacing.z)),
+                    zBegin);
+                const auto kEnd = std::min(
+                    static_cast<ssize_t>(std::floor(
+                        (xi.z + m_kernelRadius - dataOrigin.z) /
+                        gridSpacing.z)),
+                    zEnd - 1);
+
+                for (ssize_t kIdx = kBegin; kIdx <= kEnd; ++kIdx)
+                {
+                    for (ssize_t jIdx = jBegin; jIdx <= jEnd; ++jIdx)
+                    {
+                        for (ssize_t iIdx = iBegin; iIdx <= iEnd; ++iIdx)
+                        {
+                            const Vector3D x =
+                                dataOrigin +
+                                gridSpacing * Vector3D{
+                                    static_cast<double>(iIdx),
+                                    static_cast<double>(jIdx),
+                                    static_cast<double>(kIdx) };
+                            const double wi =
+                                k((x - xi).Length() / m_kernelRadius);
+
+                            if (wi > 0.0)
+                            {
+                                wSum(iIdx, jIdx, kIdx) += wi;
+                                xAvg(iIdx, jIdx, kIdx) += wi * xi;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    auto data = temp->GetDataAccessor();
+    auto pos = temp->GetDataPosition();
+    const double backgroundValue = output->BoundingBox().DiagonalLength();
+
+    temp->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t l) {
+        if (wSum(i, j, l) > 0.0)
         {
-            xAvg /= wSum;
-            return (x - xAvg).Length() - isoContValue;
+            const Vector3D avg = xAvg(i, j, l) / wSum(i, j, l);
+            data(i, j, l) = (pos(i, j, l) - avg).Length() - isoContValue;
         }
         else
         {
-            return output->BoundingBox().DiagonalLength();
+            data(i, j, l) = backgroundValue;
         }
     });
 
@@ -15,6 +15,16 @@
 
 namespace CubbyFlow
 {
+namespace
+{
+//! Wraps a bucket coordinate into [0, resolution) for arbitrary resolutions.
+ssize_t WrapBucketCoordinate(ssize_t coordinate, ssize_t resolution)
+{
+    const ssize_t wrapped = coordinate % resolution;
+    return (wrapped < 0) ? wrapped + resolution : wrapped;
+}
+}  // namespace
+
 PointHashGridSearcher3::PointHashGridSearcher3(const Size3& resolution,
                                                double gridSpacing)
     : PointHashGridSearcher3{ resolution.x, resolution.y, resolution.z,
@@ -35,6 +45,8 @@ PointHashGridSearcher3::PointHashGridSearcher3(size_t resolutionX,
         std::max(static_cast<ssize_t>(resolutionY), static_cast<ssize_t>(1));
     m_resolution.z =
         std::max(static_cast<ssize_t>(resolutionZ), static_cast<ssize_t>(1));
+
+    UpdateHashConstants();
 }
 
 PointHashGridSearcher3::PointHashGridSearcher3(
@@ -52,11 +64,26 @@ PointHashGridSearcher3& PointHashGridSearcher3::operator=(
 
 void PointHashGridSearcher3::Build(const ConstArrayAccessor1<Vector3D>& points)
 {
-    m_buckets.clear();
-    m_points.clear();
+    const size_t tableSize =
+        static_cast<size_t>(m_resolution.x * m_resolution.y * m_resolution.z);
+
+    if (m_buckets.size() == tableSize)
+    {
+        // Keep the per-bucket index lists alive; clearing them preserves
+        // their capacity, so a rebuild at a stable point distribution does
+        // not return the bucket storage to the allocator.
+        for (auto& bucket : m_buckets)
+        {
+            bucket.clear();
+        }
+    }
+    else
+    {
+        m_buckets.clear();
+        m_buckets.resize(tableSize);
+    }
 
-    // Allocate memory chunks
-    m_buckets.resize(m_resolution.x * m_resolution.y * m_resolution.z);
+    m_points.clear();
     m_points.resize(points.size());
 
     if (m_points.empty())
@@ -73,36 +100,22 @@ void PointHashGridSearcher3::Build(const ConstArrayAccessor1<Vector3D>& points)
     }
 }
 
+void PointHashGridSearcher3::Rebuild(
+    const ConstArrayAccessor1<Vector3D>& points, double gridSpacing)
+{
+    m_gridSpacing = gridSpacing;
+    UpdateHashConstants();
+
+    Build(points);
+}
+
 void PointHashGridSearcher3::ForEachNearbyPoint(
     const Vector3D& origin, double radius,
     const ForEachNearbyPointFunc& callback) const
 {
-    if (m_buckets.empty())
-    {
-        return;
-    }
-
-    size_t nearbyKeys[8];
-    GetNearbyKeys(origin, nearbyKeys);
-
-    const double queryRadiusSquared = radius * radius;
-
-    for (const auto& key : nearbyKeys)
-    {
-        const std::vector<size_t>& bucket = m_buckets[key];
-        const size_t numberOfPointsInBucket = bucket.size();
-
-        for (size_t j = 0; j < numberOfPointsInBucket; ++j)
-        {
-            const size_t pointIndex = bucket[j];
-            const double rSquared =
-                (m_points[pointIndex] - origin).LengthSquared();
-            if (rSquared <= queryRadiusSquared)
-            {
-                callback(pointIndex, m_points[pointIndex]);
-            }
-        }
-    }
+    // Shares the loop with the template overload; only this virtual entry
+    // pays the std::function indirection.
+    ForEachNearbyPoint<ForEachNearbyPointFunc>(origin, radius, callback);
 }
 
 bool PointHashGridSearcher3::HasNearbyPoint(const Vector3D& origin,
@@ -163,40 +176,34 @@ const std::vector<std::vector<size_t>>& PointHashGridSearcher3::GetBuckets()
 size_t PointHashGridSearcher3::GetHashKeyFromBucketIndex(
     const Point3I& bucketIndex) const
 {
-    Point3I wrappedIndex;
-    wrappedIndex.x = bucketIndex.x % m_resolution.x;
-    wrappedIndex.y = bucketIndex.y % m_resolution.y;
-    wrappedIndex.z = bucketIndex.z % m_resolution.z;
-
-    if (wrappedIndex.x < 0)
+    if (m_isResolutionPowerOfTwo)
     {
-        wrappedIndex.x += m_resolution.x;
+        // Masking a two's-complement coordinate wraps negatives correctly,
+        // so the whole key is branch-free: three ands, two shifts, two ors.
+        return (static_cast<size_t>(bucketIndex.z & m_resolutionMask.z)
+                << m_resolutionShiftXY) |
+               (static_cast<size_t>(bucketIndex.y & m_resolutionMask.y)
+                << m_resolutionShiftX) |
+               static_cast<size_t>(bucketIndex.x & m_resolutionMask.x);
     }
 
-    if (wrappedIndex.y < 0)
-    {
-        wrappedIndex.y += m_resolution.y;
-    }
-
-    if (wrappedIndex.z < 0)
-    {
-        wrappedIndex.z += m_resolution.z;
-    }
+    const ssize_t wrappedX = WrapBucketCoordinate(bucketIndex.x, m_resolution.x);
+    const ssize_t wrappedY = WrapBucketCoordinate(bucketIndex.y, m_resolution.y);
+    const ssize_t wrappedZ = WrapBucketCoordinate(bucketIndex.z, m_resolution.z);
 
     return static_cast<size_t>(
-        (wrappedIndex.z * m_resolution.y + wrappedIndex.y) * m_resolution.x +
-        wrappedIndex.x);
+        (wrappedZ * m_resolution.y + wrappedY) * m_resolution.x + wrappedX);
 }
 
 Point3I PointHashGridSearcher3::GetBucketIndex(const Vector3D& position) const
 {
     Point3I bucketIndex;
     bucketIndex.x =
-        static_cast<ssize_t>(std::floor(position.x / m_gridSpacing));
+        static_cast<ssize_t>(std::floor(position.x * m_invGridSpacing));
     bucketIndex.y =
-        static_cast<ssize_t>(std::floor(position.y / m_gridSpacing));
+        static_cast<ssize_t>(std::floor(position.y * m_invGridSpacing));
     bucketIndex.z =
-        static_cast<ssize_t>(std::floor(position.z / m_gridSpacing));
+        static_cast<ssize_t>(std::floor(position.z * m_invGridSpacing));
 
     return bucketIndex;
 }
@@ -214,6 +221,8 @@ void PointHashGridSearcher3::Set(const PointHashGridSearcher3& other)
     m_gridSpacing = other.m_gridSpacing;
     m_points = other.m_points;
     m_buckets = other.m_buckets;
+
+    UpdateHashConstants();
 }
 
 void PointHashGridSearcher3::Serialize(std::vector<uint8_t>* buffer) const
@@ -273,6 +282,7 @@ void PointHashGridSearcher3::Deserialize(const std::vector<uint8_t>& buffer)
     const Size3 res = FlatbuffersToCubbyFlow(*fbsSearcher->resolution());
     m_resolution.Set({ res.x, res.y, res.z });
     m_gridSpacing = fbsSearcher->gridSpacing();
+    UpdateHashConstants();
 
     // Copy points
     const flatbuffers::Vector<const fbs::Vector3D*>* fbsPoints =
@@ -300,11 +310,67 @@ void PointHashGridSearcher3::Deserialize(const std::vector<uint8_t>& buffer)
     }
 }
 
+const char* PointHashGridSearcher3::GetMemoryStatsName() const
+{
+    return "PointHashGridSearcher3";
+}
+
+void PointHashGridSearcher3::ReportMemoryUsage(
+    std::vector<MemoryUsageRecord>* records) const
+{
+    records->push_back(MemoryUsageRecord{
+        "points", m_points.size() * sizeof(Vector3D) });
+
+    size_t bucketBytes = m_buckets.size() * sizeof(std::vector<size_t>);
+    for (const std::vector<size_t>& bucket : m_buckets)
+    {
+        bucketBytes += bucket.capacity() * sizeof(size_t);
+    }
+    records->push_back(MemoryUsageRecord{ "buckets", bucketBytes });
+}
+
 PointHashGridSearcher3::Builder PointHashGridSearcher3::GetBuilder()
 {
     return Builder{};
 }
 
+void PointHashGridSearcher3::UpdateHashConstants()
+{
+    m_invGridSpacing = 1.0 / m_gridSpacing;
+
+    const auto isPowerOfTwo = [](ssize_t value) {
+        return value > 0 && (value & (value - 1)) == 0;
+    };
+
+    m_isResolutionPowerOfTwo = isPowerOfTwo(m_resolution.x) &&
+                               isPowerOfTwo(m_resolution.y) &&
+                               isPowerOfTwo(m_resolution.z);
+
+    if (!m_isResolutionPowerOfTwo)
+    {
+        m_resolutionMask = Point3I{ 0, 0, 0 };
+        m_resolutionShiftX = 0;
+        m_resolutionShiftXY = 0;
+        return;
+    }
+
+    const auto log2OfPowerOfTwo = [](ssize_t value) {
+        size_t log = 0;
+        while ((static_cast<ssize_t>(1) << log) < value)
+        {
+            ++log;
+        }
+        return log;
+    };
+
+    m_resolutionMask.x = m_resolution.x - 1;
+    m_resolutionMask.y = m_resolution.y - 1;
+    m_resolutionMask.z = m_resolution.z - 1;
+    m_resolutionShiftX = log2OfPowerOfTwo(m_resolution.x);
+    m_resolutionShiftXY =
+        m_resolutionShiftX + log2OfPowerOfTwo(m_resolution.y);
+}
+
 size_t PointHashGridSearcher3::GetHashKeyFromPosition(
     const Vector3D& position) const
 {
@@ -316,64 +382,76 @@ void PointHashGridSearcher3::GetNearbyKeys(const Vector3D& position,
                                            size_t* nearbyKeys) const
 {
     const Point3I originIndex = GetBucketIndex(position);
-    Point3I nearbyBucketIndices[8];
-
-    for (auto& bucketIndex : nearbyBucketIndices)
-    {
-        bucketIndex = originIndex;
-    }
-
-    if ((static_cast<double>(originIndex.x) + 0.5) * m_gridSpacing <=
-        position.x)
-    {
-        nearbyBucketIndices[4].x += 1;
-        nearbyBucketIndices[5].x += 1;
-        nearbyBucketIndices[6].x += 1;
-        nearbyBucketIndices[7].x += 1;
-    }
-    else
-    {
-        nearbyBucketIndices[4].x -= 1;
-        nearbyBucketIndices[5].x -= 1;
-        nearbyBucketIndices[6].x -= 1;
-        nearbyBucketIndices[7].x -= 1;
-    }
-
-    if ((static_cast<double>(originIndex.y) + 0.5) * m_gridSpacing <=
-        position.y)
-    {
-        nearbyBucketIndices[2].y += 1;
-        nearbyBucketIndices[3].y += 1;
-        nearbyBucketIndices[6].y += 1;
-        nearbyBucketIndices[7].y += 1;
-    }
-    else
-    {
-        nearbyBucketIndices[2].y -= 1;
-        nearbyBucketIndices[3].y -= 1;
-        nearbyBucketIndices[6].y -= 1;
-        nearbyBucketIndices[7].y -= 1;
-    }
 
-    if ((static_cast<double>(originIndex.z) + 0.5) * m_gridSpacing <=
-        position.z)
+    // The query point lies in one octant of its bucket; the 2x2x2 block of
+    // buckets covering the search sphere extends toward that octant.
+    const ssize_t dx = ((static_cast<double>(originIndex.x) + 0.5) *
+                            m_gridSpacing <=
+                        position.x)
+                           ? 1
+                           : -1;
+    const ssize_t dy = ((static_cast<double>(originIndex.y) + 0.5) *
+                            m_gridSpacing <=
+                        position.y)
+                           ? 1
+                           : -1;
+    const ssize_t dz = ((static_cast<double>(originIndex.z) + 0.5) *
+                            m_gridSpacing <=
+                        position.z)
+                           ? 1
+                           : -1;
+
+    // Wrap the two candidate coordinates per axis once and pre-scale the y
+    // and z terms, so the eight keys fall out of one branch-free combine
+    // loop instead of eight full wrap-and-multiply chains.
+    size_t termX[2];
+    size_t termY[2];
+    size_t termZ[2];
+
+    if (m_isResolutionPowerOfTwo)
     {
-        nearbyBucketIndices[1].z += 1;
-        nearbyBucketIndices[3].z += 1;
-        nearbyBucketIndices[5].z += 1;
-        nearbyBucketIndices[7].z += 1;
+        termX[0] = static_cast<size_t>(originIndex.x & m_resolutionMask.x);
+        termX[1] =
+            static_cast<size_t>((originIndex.x + dx) & m_resolutionMask.x);
+        termY[0] = static_cast<size_t>(originIndex.y & m_resolutionMask.y)
+                   << m_resolutionShiftX;
+        termY[1] =
+            static_cast<size_t>((originIndex.y + dy) & m_resolutionMask.y)
+            << m_resolutionShiftX;
+        termZ[0] = static_cast<size_t>(originIndex.z & m_resolutionMask.z)
+                   << m_resolutionShiftXY;
+        termZ[1] =
+            static_cast<size_t>((originIndex.z + dz) & m_resolutionMask.z)
+            << m_resolutionShiftXY;
     }
     else
     {
-        nearbyBucketIndices[1].z -= 1;
-        nearbyBucketIndices[3].z -= 1;
-        nearbyBucketIndices[5].z -= 1;
-        nearbyBucketIndices[7].z -= 1;
+        const size_t strideY = static_cast<size_t>(m_resolution.x);
+        const size_t strideZ =
+            static_cast<size_t>(m_resolution.x * m_resolution.y);
+
+        termX[0] = static_cast<size_t>(
+            WrapBucketCoordinate(originIndex.x, m_resolution.x));
+        termX[1] = static_cast<size_t>(
+            WrapBucketCoordinate(originIndex.x + dx, m_resolution.x));
+        termY[0] = static_cast<size_t>(WrapBucketCoordinate(
+                       originIndex.y, m_resolution.y)) *
+                   strideY;
+        termY[1] = static_cast<size_t>(WrapBucketCoordinate(
+                       originIndex.y + dy, m_resolution.y)) *
+                   strideY;
+        termZ[0] = static_cast<size_t>(WrapBucketCoordinate(
+                       originIndex.z, m_resolution.z)) *
+                   strideZ;
+        termZ[1] = static_cast<size_t>(WrapBucketCoordinate(
+                       originIndex.z + dz, m_resolution.z)) *
+                   strideZ;
     }
 
     for (int i = 0; i < 8; ++i)
     {
-        nearbyKeys[i] = GetHashKeyFromBucketIndex(nearbyBucketIndices[i]);
+        nearbyKeys[i] =
+            termZ[i & 1] + termY[(i >> 1) & 1] + termX[(i >> 2) & 1];
     }
 }
 
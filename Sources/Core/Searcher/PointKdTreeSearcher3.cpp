@@ -65,9 +65,13 @@ void PointKdTreeSearcher3::Serialize(std::vector<uint8_t>* buffer) const
 {
     flatbuffers::FlatBufferBuilder builder{ 1024 };
 
-    // Copy points
+    // Copy points in original item order; the tree itself is cheap to
+    // rebuild, so the nodes are not persisted.
+    std::vector<Vector3D> treePoints;
+    m_tree.GetPoints(&treePoints);
+
     std::vector<fbs::Vector3D> points;
-    for (const auto& iter : m_tree)
+    for (const auto& iter : treePoints)
     {
         points.push_back(CubbyFlowToFlatbuffers(iter));
     }
@@ -75,13 +79,7 @@ void PointKdTreeSearcher3::Serialize(std::vector<uint8_t>* buffer) const
     const flatbuffers::Offset<flatbuffers::Vector<const fbs::Vector3D*>>
         fbsPoints = builder.CreateVectorOfStructs(points.data(), points.size());
 
-    // Copy nodes
-    std::vector<fbs::PointKdTreeSearcherNode3> nodes;
-    for (auto iter = m_tree.BeginNode(); iter != m_tree.EndNode(); ++iter)
-    {
-        nodes.emplace_back(iter->flags, iter->child, iter->item);
-    }
-
+    const std::vector<fbs::PointKdTreeSearcherNode3> nodes;
     const flatbuffers::Offset<
         flatbuffers::Vector<const fbs::PointKdTreeSearcherNode3*>>
         fbsNodes = builder.CreateVectorOfStructs(nodes);
@@ -107,31 +105,28 @@ void PointKdTreeSearcher3::Deserialize(const std::vector<uint8_t>& buffer)
 
     const flatbuffers::Vector<const fbs::Vector3D*>* fbsPoints =
         fbsSearcher->points();
-    const flatbuffers::Vector<const fbs::PointKdTreeSearcherNode3*>* fbsNodes =
-        fbsSearcher->nodes();
 
-    m_tree.Reserve(fbsPoints->size(), fbsNodes->size());
-
-    // Copy points
-    const auto pointsIter = m_tree.begin();
+    // Copy points and rebuild the tree; persisted nodes (if any) are ignored
+    // since the compact layout is reconstructed deterministically.
+    std::vector<Vector3D> points(fbsPoints->size());
     for (uint32_t i = 0; i < fbsPoints->size(); ++i)
     {
-        pointsIter[i] = FlatbuffersToCubbyFlow(*fbsPoints->Get(i));
+        points[i] = FlatbuffersToCubbyFlow(*fbsPoints->Get(i));
     }
 
-    // Copy nodes
-    const auto nodesIter = m_tree.BeginNode();
-    for (uint32_t i = 0; i < fbsNodes->size(); ++i)
-    {
-        const flatbuffers::Vector<
-            const fbs::PointKdTreeSearcherNode3*>::return_type fbsNode =
-            fbsNodes->Get(i);
-
-        nodesIter[i].flags = fbsNode->flags();
-        nodesIter[i].child = fbsNode->child();
-        nodesIter[i].item = fbsNode->item();
-        nodesIter[i].point = pointsIter[fbsNode->item()];
-    }
+    m_tree.Build(ConstArrayAccessor1<Vector3D>{ points.size(), points.data() });
+}
+
+const char* PointKdTreeSearcher3::GetMemoryStatsName() const
+{
+    return "PointKdTreeSearcher3";
+}
+
+void PointKdTreeSearcher3::ReportMemoryUsage(
+    std::vector<MemoryUsageRecord>* records) const
+{
+    records->push_back(
+        MemoryUsageRecord{ "tree", m_tree.GetMemoryUsage() });
 }
 
 PointKdTreeSearcher3::Builder PointKdTreeSearcher3::GetBuilder()
@@ -17,6 +17,8 @@
 
 #include <flatbuffers/flatbuffers.h>
 
+#include <algorithm>
+
 namespace CubbyFlow
 {
 PointParallelHashGridSearcher3::PointParallelHashGridSearcher3(
@@ -64,21 +66,20 @@ void PointParallelHashGridSearcher3::Build(
     m_endIndexTable.clear();
     m_sortedIndices.clear();
 
-    // Allocate memory chunks
+    // Allocate memory chunks; all of these keep their capacity across
+    // calls, so rebuilding an existing searcher at a stable point count
+    // touches the allocator only when the simulation grows.
     const size_t numberOfPoints = points.size();
-    std::vector<size_t> tempKeys(numberOfPoints);
+    m_tempKeys.resize(numberOfPoints);
     m_startIndexTable.resize(m_resolution.x * m_resolution.y * m_resolution.z);
     m_endIndexTable.resize(m_resolution.x * m_resolution.y * m_resolution.z);
-    ParallelFill(m_startIndexTable.begin(), m_startIndexTable.end(),
-                 std::numeric_limits<size_t>::max());
-    ParallelFill(m_endIndexTable.begin(), m_endIndexTable.end(),
-                 std::numeric_limits<size_t>::max());
     m_keys.resize(numberOfPoints);
     m_sortedIndices.resize(numberOfPoints);
     m_points.resize(numberOfPoints);
 
     if (numberOfPoints == 0)
     {
+        RebuildStartEndTables();
         return;
     }
 
@@ -86,43 +87,23 @@ void PointParallelHashGridSearcher3::Build(
     ParallelFor(ZERO_SIZE, numberOfPoints, [&](size_t i) {
         m_sortedIndices[i] = i;
         m_points[i] = points[i];
-        tempKeys[i] = GetHashKeyFromPosition(points[i]);
+        m_tempKeys[i] = GetHashKeyFromPosition(points[i]);
     });
 
-    // Sort indices based on hash key
-    ParallelSort(m_sortedIndices.begin(), m_sortedIndices.end(),
-                 [&tempKeys](size_t indexA, size_t indexB) {
-                     return tempKeys[indexA] < tempKeys[indexB];
-                 });
+    // Sort the keys and carry the indices along; radix beats a comparison
+    // sort by a wide margin at particle counts in the millions
+    ParallelRadixSort(m_tempKeys.begin(), m_tempKeys.end(),
+                      m_sortedIndices.begin());
 
     // Re-order point and key arrays
     ParallelFor(ZERO_SIZE, numberOfPoints, [&](size_t i) {
         m_points[i] = points[m_sortedIndices[i]];
-        m_keys[i] = tempKeys[m_sortedIndices[i]];
+        m_keys[i] = m_tempKeys[i];
     });
 
     // Now m_points and m_keys are sorted by points' hash key values.
     // Let's fill in start/end index table with m_keys.
-
-    // Assume that m_keys array looks like:
-    // [5|8|8|10|10|10]
-    // Then m_startIndexTable and m_endIndexTable should be like:
-    // [.....|0|...|1|..|3|..]
-    // [.....|1|...|3|..|6|..]
-    //       ^5    ^8   ^10
-    // So that m_endIndexTable[i] - m_startIndexTable[i] is the number points
-    // in i-th table bucket.
-
-    m_startIndexTable[m_keys[0]] = 0;
-    m_endIndexTable[m_keys[numberOfPoints - 1]] = numberOfPoints;
-
-    ParallelFor(static_cast<size_t>(1), numberOfPoints, [&](size_t i) {
-        if (m_keys[i] > m_keys[i - 1])
-        {
-            m_startIndexTable[m_keys[i]] = i;
-            m_endIndexTable[m_keys[i - 1]] = i;
-        }
-    });
+    RebuildStartEndTables();
 
     size_t sumNumberOfPointsPerBucket = 0;
     size_t maxNumberOfPointsPerBucket = 0;
@@ -148,36 +129,134 @@ void PointParallelHashGridSearcher3::Build(
                    << maxNumberOfPointsPerBucket;
 }
 
-void PointParallelHashGridSearcher3::ForEachNearbyPoint(
-    const Vector3D& origin, double radius,
-    const ForEachNearbyPointFunc& callback) const
+void PointParallelHashGridSearcher3::Update(
+    const ConstArrayAccessor1<Vector3D>& points)
 {
-    size_t nearbyKeys[8];
-    GetNearbyKeys(origin, nearbyKeys);
+    const size_t numberOfPoints = points.size();
 
-    const double queryRadiusSquared = radius * radius;
+    if (numberOfPoints == 0 || numberOfPoints != m_points.size())
+    {
+        Build(points);
+        return;
+    }
 
-    for (const auto& key : nearbyKeys)
+    // Refresh stored positions and count the points whose bucket changed.
+    // A point needs re-binning only when its displacement moved it across a
+    // cell boundary, so for CFL-limited time steps most points keep both
+    // their bucket and their slot in the sorted arrays.
+    std::vector<size_t> newKeys(numberOfPoints);
+
+    const size_t numberOfMovedPoints = ParallelReduce(
+        ZERO_SIZE, numberOfPoints, ZERO_SIZE,
+        [&](size_t begin, size_t end, size_t init) {
+            size_t count = init;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                const Vector3D newPosition = points[m_sortedIndices[i]];
+
+                m_points[i] = newPosition;
+                newKeys[i] = GetHashKeyFromPosition(newPosition);
+
+                if (newKeys[i] != m_keys[i])
+                {
+                    ++count;
+                }
+            }
+
+            return count;
+        },
+        std::plus<size_t>());
+
+    if (numberOfMovedPoints == 0)
     {
-        const size_t start = m_startIndexTable[key];
-        const size_t end = m_endIndexTable[key];
+        // Every point stayed in its bucket; the tables are still valid.
+        return;
+    }
 
-        // Empty bucket -- continue to next bucket
-        if (start == std::numeric_limits<size_t>::max())
+    if (numberOfMovedPoints > numberOfPoints / 4)
+    {
+        // Too many points moved for the merge below to pay off.
+        Build(points);
+        return;
+    }
+
+    // Pull out the movers, sort just those, and merge them back with the
+    // still-sorted remainder.
+    std::vector<size_t> movedSlots;
+    movedSlots.reserve(numberOfMovedPoints);
+
+    for (size_t i = 0; i < numberOfPoints; ++i)
+    {
+        if (newKeys[i] != m_keys[i])
         {
-            continue;
+            movedSlots.push_back(i);
         }
+    }
 
-        for (size_t j = start; j < end; ++j)
+    std::sort(movedSlots.begin(), movedSlots.end(),
+              [&newKeys](size_t slotA, size_t slotB) {
+                  return newKeys[slotA] < newKeys[slotB];
+              });
+
+    std::vector<Vector3D> mergedPoints(numberOfPoints);
+    std::vector<size_t> mergedKeys(numberOfPoints);
+    std::vector<size_t> mergedIndices(numberOfPoints);
+
+    size_t keepCursor = 0;
+    size_t moveCursor = 0;
+
+    for (size_t out = 0; out < numberOfPoints; ++out)
+    {
+        while (keepCursor < numberOfPoints &&
+               newKeys[keepCursor] != m_keys[keepCursor])
         {
-            Vector3D direction = m_points[j] - origin;
-            const double distanceSquared = direction.LengthSquared();
-            if (distanceSquared <= queryRadiusSquared)
-            {
-                callback(m_sortedIndices[j], m_points[j]);
-            }
+            ++keepCursor;
         }
+
+        bool takeMover;
+        if (keepCursor >= numberOfPoints)
+        {
+            takeMover = true;
+        }
+        else if (moveCursor >= movedSlots.size())
+        {
+            takeMover = false;
+        }
+        else
+        {
+            takeMover = newKeys[movedSlots[moveCursor]] < m_keys[keepCursor];
+        }
+
+        const size_t slot = takeMover ? movedSlots[moveCursor++] : keepCursor++;
+
+        mergedPoints[out] = m_points[slot];
+        mergedKeys[out] = newKeys[slot];
+        mergedIndices[out] = m_sortedIndices[slot];
     }
+
+    m_points.swap(mergedPoints);
+    m_keys.swap(mergedKeys);
+    m_sortedIndices.swap(mergedIndices);
+
+    RebuildStartEndTables();
+}
+
+void PointParallelHashGridSearcher3::Rebuild(
+    const ConstArrayAccessor1<Vector3D>& points, double gridSpacing)
+{
+    m_gridSpacing = gridSpacing;
+
+    Build(points);
+}
+
+void PointParallelHashGridSearcher3::ForEachNearbyPoint(
+    const Vector3D& origin, double radius,
+    const ForEachNearbyPointFunc& callback) const
+{
+    // Shares the loop with the template overload; only this virtual entry
+    // pays the std::function indirection.
+    ForEachNearbyPoint<ForEachNearbyPointFunc>(origin, radius, callback);
 }
 
 bool PointParallelHashGridSearcher3::HasNearbyPoint(const Vector3D& origin,
@@ -249,6 +328,11 @@ Point3I PointParallelHashGridSearcher3::GetBucketIndex(
     return bucketIndex;
 }
 
+double PointParallelHashGridSearcher3::GridSpacing() const
+{
+    return m_gridSpacing;
+}
+
 size_t PointParallelHashGridSearcher3::GetHashKeyFromPosition(
     const Vector3D& position) const
 {
@@ -348,6 +432,41 @@ void PointParallelHashGridSearcher3::GetNearbyKeys(const Vector3D& position,
     }
 }
 
+void PointParallelHashGridSearcher3::RebuildStartEndTables()
+{
+    ParallelFill(m_startIndexTable.begin(), m_startIndexTable.end(),
+                 std::numeric_limits<size_t>::max());
+    ParallelFill(m_endIndexTable.begin(), m_endIndexTable.end(),
+                 std::numeric_limits<size_t>::max());
+
+    const size_t numberOfPoints = m_points.size();
+
+    if (numberOfPoints == 0)
+    {
+        return;
+    }
+
+    // Assume that m_keys array looks like:
+    // [5|8|8|10|10|10]
+    // Then m_startIndexTable and m_endIndexTable should be like:
+    // [.....|0|...|1|..|3|..]
+    // [.....|1|...|3|..|6|..]
+    //       ^5    ^8   ^10
+    // So that m_endIndexTable[i] - m_startIndexTable[i] is the number points
+    // in i-th table bucket.
+
+    m_startIndexTable[m_keys[0]] = 0;
+    m_endIndexTable[m_keys[numberOfPoints - 1]] = numberOfPoints;
+
+    ParallelFor(static_cast<size_t>(1), numberOfPoints, [&](size_t i) {
+        if (m_keys[i] > m_keys[i - 1])
+        {
+            m_startIndexTable[m_keys[i]] = i;
+            m_endIndexTable[m_keys[i - 1]] = i;
+        }
+    });
+}
+
 PointNeighborSearcher3Ptr PointParallelHashGridSearcher3::Clone() const
 {
     return std::shared_ptr<PointParallelHashGridSearcher3>(
@@ -512,4 +631,20 @@ PointParallelHashGridSearcher3::Builder::BuildPointNeighborSearcher() const
 {
     return MakeShared();
 }
-}  // namespace CubbyFlow
\ No newline at end of file
+const char* PointParallelHashGridSearcher3::GetMemoryStatsName() const
+{
+    return "PointParallelHashGridSearcher3";
+}
+
+void PointParallelHashGridSearcher3::ReportMemoryUsage(
+    std::vector<MemoryUsageRecord>* records) const
+{
+    records->push_back(MemoryUsageRecord{
+        "points", m_points.size() * sizeof(Vector3D) });
+    records->push_back(MemoryUsageRecord{
+        "hashTable",
+        (m_keys.size() + m_startIndexTable.size() + m_endIndexTable.size() +
+         m_sortedIndices.size()) *
+            sizeof(size_t) });
+}
+}  // namespace CubbyFlow
@@ -124,6 +124,18 @@ void PointSimpleListSearcher3::Deserialize(const std::vector<uint8_t>& buffer)
     }
 }
 
+const char* PointSimpleListSearcher3::GetMemoryStatsName() const
+{
+    return "PointSimpleListSearcher3";
+}
+
+void PointSimpleListSearcher3::ReportMemoryUsage(
+    std::vector<MemoryUsageRecord>* records) const
+{
+    records->push_back(MemoryUsageRecord{
+        "points", m_points.size() * sizeof(Vector3D) });
+}
+
 PointSimpleListSearcher3::Builder PointSimpleListSearcher3::GetBuilder()
 {
     return Builder{};
@@ -0,0 +1,433 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Searcher/PointTiledHashGridSearcher3.hpp>
+#include <Core/Utils/FlatbuffersHelper.hpp>
+
+#include <Flatbuffers/generated/PointHashGridSearcher3_generated.h>
+
+#include <algorithm>
+
+namespace CubbyFlow
+{
+PointTiledHashGridSearcher3::PointTiledHashGridSearcher3(double gridSpacing)
+    : m_gridSpacing(gridSpacing)
+{
+    // Do nothing
+}
+
+PointTiledHashGridSearcher3::PointTiledHashGridSearcher3(
+    const PointTiledHashGridSearcher3& other)
+{
+    Set(other);
+}
+
+PointTiledHashGridSearcher3& PointTiledHashGridSearcher3::operator=(
+    const PointTiledHashGridSearcher3& other)
+{
+    Set(other);
+    return *this;
+}
+
+void PointTiledHashGridSearcher3::Build(
+    const ConstArrayAccessor1<Vector3D>& points)
+{
+    m_points.clear();
+    m_tableKeys.clear();
+    m_tableTileIndices.clear();
+    m_cellOffsets.clear();
+    m_sortedIndices.clear();
+    m_numberOfTiles = 0;
+
+    if (points.size() == 0)
+    {
+        return;
+    }
+
+    const size_t numberOfPoints = points.size();
+
+    m_points.resize(numberOfPoints);
+    std::vector<uint32_t> tileKeys(numberOfPoints);
+    std::vector<size_t> intraIndices(numberOfPoints);
+
+    for (size_t i = 0; i < numberOfPoints; ++i)
+    {
+        m_points[i] = points[i];
+
+        const Point3I cellIndex = GetCellIndex(points[i]);
+        tileKeys[i] = GetTileKeyFromCellIndex(cellIndex);
+        intraIndices[i] = GetIntraTileIndex(cellIndex);
+    }
+
+    // Collect the occupied tile keys
+    std::vector<uint32_t> uniqueKeys{ tileKeys };
+    std::sort(uniqueKeys.begin(), uniqueKeys.end());
+    uniqueKeys.erase(std::unique(uniqueKeys.begin(), uniqueKeys.end()),
+                     uniqueKeys.end());
+    m_numberOfTiles = uniqueKeys.size();
+
+    // Build the open-addressing table at 50% max load factor
+    size_t tableSize = 1;
+    while (tableSize < 2 * m_numberOfTiles)
+    {
+        tableSize *= 2;
+    }
+
+    m_tableKeys.assign(tableSize, EMPTY_KEY);
+    m_tableTileIndices.assign(tableSize, 0);
+
+    const size_t tableMask = tableSize - 1;
+    for (size_t t = 0; t < m_numberOfTiles; ++t)
+    {
+        size_t slot = static_cast<size_t>(uniqueKeys[t]) & tableMask;
+
+        while (m_tableKeys[slot] != EMPTY_KEY)
+        {
+            slot = (slot + 1) & tableMask;
+        }
+
+        m_tableKeys[slot] = uniqueKeys[t];
+        m_tableTileIndices[slot] = static_cast<uint32_t>(t);
+    }
+
+    // Count points per cell bucket, then prefix-sum into CSR offsets
+    m_cellOffsets.assign(m_numberOfTiles * CELLS_PER_TILE + 1, 0);
+
+    for (size_t i = 0; i < numberOfPoints; ++i)
+    {
+        const size_t tile = FindTile(tileKeys[i]);
+        ++m_cellOffsets[tile * CELLS_PER_TILE + intraIndices[i] + 1];
+    }
+
+    for (size_t c = 1; c < m_cellOffsets.size(); ++c)
+    {
+        m_cellOffsets[c] += m_cellOffsets[c - 1];
+    }
+
+    m_sortedIndices.resize(numberOfPoints);
+    std::vector<size_t> fillCursors{ m_cellOffsets };
+
+    for (size_t i = 0; i < numberOfPoints; ++i)
+    {
+        const size_t tile = FindTile(tileKeys[i]);
+        const size_t cell = tile * CELLS_PER_TILE + intraIndices[i];
+        m_sortedIndices[fillCursors[cell]++] = i;
+    }
+}
+
+template <typename Visitor>
+void PointTiledHashGridSearcher3::ForEachCandidate(
+    const Vector3D& origin, double radius, const Visitor& visitor) const
+{
+    const Point3I originIndex = GetCellIndex(origin);
+    Point3I nearbyCellIndices[8];
+
+    for (auto& cellIndex : nearbyCellIndices)
+    {
+        cellIndex = originIndex;
+    }
+
+    if ((static_cast<double>(originIndex.x) + 0.5) * m_gridSpacing <=
+        origin.x)
+    {
+        nearbyCellIndices[4].x += 1;
+        nearbyCellIndices[5].x += 1;
+        nearbyCellIndices[6].x += 1;
+        nearbyCellIndices[7].x += 1;
+    }
+    else
+    {
+        nearbyCellIndices[4].x -= 1;
+        nearbyCellIndices[5].x -= 1;
+        nearbyCellIndices[6].x -= 1;
+        nearbyCellIndices[7].x -= 1;
+    }
+
+    if ((static_cast<double>(originIndex.y) + 0.5) * m_gridSpacing <=
+        origin.y)
+    {
+        nearbyCellIndices[2].y += 1;
+        nearbyCellIndices[3].y += 1;
+        nearbyCellIndices[6].y += 1;
+        nearbyCellIndices[7].y += 1;
+    }
+    else
+    {
+        nearbyCellIndices[2].y -= 1;
+        nearbyCellIndices[3].y -= 1;
+        nearbyCellIndices[6].y -= 1;
+        nearbyCellIndices[7].y -= 1;
+    }
+
+    if ((static_cast<double>(originIndex.z) + 0.5) * m_gridSpacing <=
+        origin.z)
+    {
+        nearbyCellIndices[1].z += 1;
+        nearbyCellIndices[3].z += 1;
+        nearbyCellIndices[5].z += 1;
+        nearbyCellIndices[7].z += 1;
+    }
+    else
+    {
+        nearbyCellIndices[1].z -= 1;
+        nearbyCellIndices[3].z -= 1;
+        nearbyCellIndices[5].z -= 1;
+        nearbyCellIndices[7].z -= 1;
+    }
+
+    const double queryRadiusSquared = radius * radius;
+
+    for (const auto& cellIndex : nearbyCellIndices)
+    {
+        const size_t tile = FindTile(GetTileKeyFromCellIndex(cellIndex));
+        if (tile == m_numberOfTiles)
+        {
+            continue;
+        }
+
+        const size_t cell = tile * CELLS_PER_TILE + GetIntraTileIndex(cellIndex);
+        const size_t end = m_cellOffsets[cell + 1];
+
+        for (size_t j = m_cellOffsets[cell]; j < end; ++j)
+        {
+            const size_t pointIndex = m_sortedIndices[j];
+            const double rSquared =
+                (m_points[pointIndex] - origin).LengthSquared();
+            if (rSquared <= queryRadiusSquared)
+            {
+                if (!visitor(pointIndex))
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+void PointTiledHashGridSearcher3::ForEachNearbyPoint(
+    const Vector3D& origin, double radius,
+    const ForEachNearbyPointFunc& callback) const
+{
+    if (m_numberOfTiles == 0)
+    {
+        return;
+    }
+
+    ForEachCandidate(origin, radius, [&](size_t pointIndex) {
+        callback(pointIndex, m_points[pointIndex]);
+        return true;
+    });
+}
+
+bool PointTiledHashGridSearcher3::HasNearbyPoint(const Vector3D& origin,
+                                                 double radius) const
+{
+    if (m_numberOfTiles == 0)
+    {
+        return false;
+    }
+
+    bool hasNearbyPoint = false;
+
+    ForEachCandidate(origin, radius, [&](size_t) {
+        hasNearbyPoint = true;
+        return false;
+    });
+
+    return hasNearbyPoint;
+}
+
+size_t PointTiledHashGridSearcher3::GetNumberOfTiles() const
+{
+    return m_numberOfTiles;
+}
+
+uint32_t PointTiledHashGridSearcher3::GetTileKeyFromCellIndex(
+    const Point3I& cellIndex)
+{
+    // Floor-divide the cell index down to the tile index; the bit operations
+    // match for negative two's-complement values.
+    const auto tx = static_cast<int64_t>(cellIndex.x) >> 2;
+    const auto ty = static_cast<int64_t>(cellIndex.y) >> 2;
+    const auto tz = static_cast<int64_t>(cellIndex.z) >> 2;
+
+    // Pack three 10-bit wrapped tile coordinates into 30 bits. Tiles that
+    // are 1024 tiles apart alias; queries filter their points by distance.
+    return (static_cast<uint32_t>(tx & 0x3FF) << 20) |
+           (static_cast<uint32_t>(ty & 0x3FF) << 10) |
+           static_cast<uint32_t>(tz & 0x3FF);
+}
+
+Point3I PointTiledHashGridSearcher3::GetCellIndex(
+    const Vector3D& position) const
+{
+    Point3I cellIndex;
+    cellIndex.x = static_cast<ssize_t>(std::floor(position.x / m_gridSpacing));
+    cellIndex.y = static_cast<ssize_t>(std::floor(position.y / m_gridSpacing));
+    cellIndex.z = static_cast<ssize_t>(std::floor(position.z / m_gridSpacing));
+
+    return cellIndex;
+}
+
+size_t PointTiledHashGridSearcher3::FindTile(uint32_t key) const
+{
+    if (m_tableKeys.empty())
+    {
+        return m_numberOfTiles;
+    }
+
+    const size_t tableMask = m_tableKeys.size() - 1;
+    size_t slot = static_cast<size_t>(key) & tableMask;
+
+    while (m_tableKeys[slot] != EMPTY_KEY)
+    {
+        if (m_tableKeys[slot] == key)
+        {
+            return m_tableTileIndices[slot];
+        }
+
+        slot = (slot + 1) & tableMask;
+    }
+
+    return m_numberOfTiles;
+}
+
+size_t PointTiledHashGridSearcher3::GetIntraTileIndex(const Point3I& cellIndex)
+{
+    const auto ix = static_cast<size_t>(cellIndex.x & 3);
+    const auto iy = static_cast<size_t>(cellIndex.y & 3);
+    const auto iz = static_cast<size_t>(cellIndex.z & 3);
+
+    return (iz * TILE_SIZE + iy) * TILE_SIZE + ix;
+}
+
+PointNeighborSearcher3Ptr PointTiledHashGridSearcher3::Clone() const
+{
+    return std::shared_ptr<PointNeighborSearcher3>(
+        new PointTiledHashGridSearcher3{ *this },
+        [](PointTiledHashGridSearcher3* obj) { delete obj; });
+}
+
+void PointTiledHashGridSearcher3::Set(const PointTiledHashGridSearcher3& other)
+{
+    m_gridSpacing = other.m_gridSpacing;
+    m_points = other.m_points;
+    m_tableKeys = other.m_tableKeys;
+    m_tableTileIndices = other.m_tableTileIndices;
+    m_cellOffsets = other.m_cellOffsets;
+    m_sortedIndices = other.m_sortedIndices;
+    m_numberOfTiles = other.m_numberOfTiles;
+}
+
+void PointTiledHashGridSearcher3::Serialize(std::vector<uint8_t>* buffer) const
+{
+    // The tile table and CSR buckets are cheap to rebuild, so only the grid
+    // spacing and the raw points go to disk, reusing the hash grid searcher
+    // schema with empty buckets.
+    flatbuffers::FlatBufferBuilder builder{ 1024 };
+
+    auto fbsResolution = fbs::Size3(TILE_SIZE, TILE_SIZE, TILE_SIZE);
+
+    std::vector<fbs::Vector3D> points;
+    for (const auto& pt : m_points)
+    {
+        points.push_back(CubbyFlowToFlatbuffers(pt));
+    }
+
+    const flatbuffers::Offset<flatbuffers::Vector<const fbs::Vector3D*>>
+        fbsPoints = builder.CreateVectorOfStructs(points.data(), points.size());
+
+    const flatbuffers::Offset<flatbuffers::Vector<
+        flatbuffers::Offset<fbs::PointHashGridSearcherBucket3>>>
+        fbsBuckets = builder.CreateVector(
+            std::vector<
+                flatbuffers::Offset<fbs::PointHashGridSearcherBucket3>>{});
+
+    const flatbuffers::Offset<fbs::PointHashGridSearcher3> fbsSearcher =
+        CreatePointHashGridSearcher3(builder, m_gridSpacing, &fbsResolution,
+                                     fbsPoints, fbsBuckets);
+
+    builder.Finish(fbsSearcher);
+
+    uint8_t* buf = builder.GetBufferPointer();
+    const size_t size = builder.GetSize();
+
+    buffer->resize(size);
+    memcpy(buffer->data(), buf, size);
+}
+
+void PointTiledHashGridSearcher3::Deserialize(
+    const std::vector<uint8_t>& buffer)
+{
+    const fbs::PointHashGridSearcher3* fbsSearcher =
+        fbs::GetPointHashGridSearcher3(buffer.data());
+
+    m_gridSpacing = fbsSearcher->gridSpacing();
+
+    // Copy points and rebuild the tile structure
+    const flatbuffers::Vector<const fbs::Vector3D*>* fbsPoints =
+        fbsSearcher->points();
+    Array1<Vector3D> points(fbsPoints->size());
+    for (uint32_t i = 0; i < fbsPoints->size(); ++i)
+    {
+        points[i] = FlatbuffersToCubbyFlow(*fbsPoints->Get(i));
+    }
+
+    Build(points.ConstAccessor());
+}
+
+const char* PointTiledHashGridSearcher3::GetMemoryStatsName() const
+{
+    return "PointTiledHashGridSearcher3";
+}
+
+void PointTiledHashGridSearcher3::ReportMemoryUsage(
+    std::vector<MemoryUsageRecord>* records) const
+{
+    records->push_back(MemoryUsageRecord{
+        "points", m_points.size() * sizeof(Vector3D) });
+    records->push_back(MemoryUsageRecord{
+        "hashTable",
+        (m_tableKeys.size() + m_tableTileIndices.size()) * sizeof(uint32_t) +
+            (m_cellOffsets.size() + m_sortedIndices.size()) *
+                sizeof(size_t) });
+}
+
+PointTiledHashGridSearcher3::Builder PointTiledHashGridSearcher3::GetBuilder()
+{
+    return Builder{};
+}
+
+PointTiledHashGridSearcher3::Builder&
+PointTiledHashGridSearcher3::Builder::WithGridSpacing(double gridSpacing)
+{
+    m_gridSpacing = gridSpacing;
+    return *this;
+}
+
+PointTiledHashGridSearcher3 PointTiledHashGridSearcher3::Builder::Build() const
+{
+    return PointTiledHashGridSearcher3{ m_gridSpacing };
+}
+
+PointTiledHashGridSearcher3Ptr
+PointTiledHashGridSearcher3::Builder::MakeShared() const
+{
+    return std::shared_ptr<PointTiledHashGridSearcher3>(
+        new PointTiledHashGridSearcher3{ m_gridSpacing },
+        [](PointTiledHashGridSearcher3* obj) { delete obj; });
+}
+
+PointNeighborSearcher3Ptr
+PointTiledHashGridSearcher3::Builder::BuildPointNeighborSearcher() const
+{
+    return MakeShared();
+}
+}  // namespace CubbyFlow
@@ -22,6 +22,24 @@ CubicSemiLagrangian3::GetScalarSamplerFunc(const ScalarGrid3& source) const
     return sourceSampler.Functor();
 }
 
+std::function<void(const ConstArrayAccessor1<Vector3D>&,
+                   ArrayAccessor1<double>)>
+CubicSemiLagrangian3::GetScalarBatchSamplerFunc(const ScalarGrid3& source) const
+{
+    const auto sourceSampler =
+        CubicArraySampler3<double, double>{ source.GetConstDataAccessor(),
+                                            source.GridSpacing(),
+                                            source.GetDataOrigin() };
+
+    return [sourceSampler](const ConstArrayAccessor1<Vector3D>& points,
+                           ArrayAccessor1<double> results) {
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            results[i] = sourceSampler(points[i]);
+        }
+    };
+}
+
 std::function<Vector3D(const Vector3D&)>
 CubicSemiLagrangian3::GetVectorSamplerFunc(
     const CollocatedVectorGrid3& source) const
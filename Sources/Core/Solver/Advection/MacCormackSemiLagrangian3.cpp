@@ -0,0 +1,290 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Array/Array3.hpp>
+#include <Core/Field/CustomVectorField3.hpp>
+#include <Core/Solver/Advection/MacCormackSemiLagrangian3.hpp>
+
+namespace CubbyFlow
+{
+namespace
+{
+//! Applies the clamped MacCormack correction to one sample. Reverts to the
+//! stable first-order result when the correction leaves the bounds of the
+//! stencil the forward pass interpolated between.
+double CorrectAndClamp(double forward, double source, double backward,
+                       double lowerBound, double upperBound)
+{
+    const double corrected = forward + 0.5 * (source - backward);
+
+    if (corrected < lowerBound || corrected > upperBound)
+    {
+        return forward;
+    }
+
+    return corrected;
+}
+}  // namespace
+
+void MacCormackSemiLagrangian3::Advect(const ScalarGrid3& input,
+                                       const VectorField3& flow, double dt,
+                                       ScalarGrid3* output,
+                                       const ScalarField3& boundarySDF)
+{
+    const double h = std::min(output->GridSpacing().x, output->GridSpacing().y);
+    const CustomVectorField3 reverseFlow{ [&flow](const Vector3D& x) {
+        return -flow.Sample(x);
+    } };
+
+    ConstArrayAccessor3<double> inputAcc = input.GetConstDataAccessor();
+    const LinearArraySampler3<double, double> sampler{
+        inputAcc, input.GridSpacing(), input.GetDataOrigin()
+    };
+
+    const std::shared_ptr<ScalarGrid3> forward = input.Clone();
+    const std::shared_ptr<ScalarGrid3> backward = input.Clone();
+
+    Array3<double> lowerBound{ inputAcc.size() };
+    Array3<double> upperBound{ inputAcc.size() };
+
+    // Forward pass, recording each trace's interpolation bounds
+    ForwardPass(flow, dt, h, inputAcc, sampler, input.GetDataPosition(),
+                output->GetDataPosition(), boundarySDF,
+                forward->GetDataAccessor(), lowerBound.Accessor(),
+                upperBound.Accessor());
+
+    // Trace the forward result back to where it came from; the round-trip
+    // error measures the truncation error of the linear scheme
+    SemiLagrangian3::Advect(*forward, reverseFlow, dt, backward.get(),
+                            boundarySDF);
+
+    CorrectionPass(inputAcc, forward->GetConstDataAccessor(),
+                   backward->GetConstDataAccessor(),
+                   lowerBound.ConstAccessor(), upperBound.ConstAccessor(),
+                   input.GetDataPosition(), boundarySDF,
+                   output->GetDataAccessor());
+}
+
+void MacCormackSemiLagrangian3::Advect(const CollocatedVectorGrid3& input,
+                                       const VectorField3& flow, double dt,
+                                       CollocatedVectorGrid3* output,
+                                       const ScalarField3& boundarySDF)
+{
+    const double h = std::min(output->GridSpacing().x, output->GridSpacing().y);
+    const CustomVectorField3 reverseFlow{ [&flow](const Vector3D& x) {
+        return -flow.Sample(x);
+    } };
+
+    ConstArrayAccessor3<Vector3D> inputAcc = input.GetConstDataAccessor();
+    const LinearArraySampler3<Vector3D, double> sampler{
+        inputAcc, input.GridSpacing(), input.GetDataOrigin()
+    };
+
+    const auto forward =
+        std::dynamic_pointer_cast<CollocatedVectorGrid3>(input.Clone());
+    const auto backward =
+        std::dynamic_pointer_cast<CollocatedVectorGrid3>(input.Clone());
+
+    Array3<Vector3D> lowerBound{ inputAcc.size() };
+    Array3<Vector3D> upperBound{ inputAcc.size() };
+
+    ArrayAccessor3<Vector3D> forwardAcc = forward->GetDataAccessor();
+    ArrayAccessor3<Vector3D> lowerAcc = lowerBound.Accessor();
+    ArrayAccessor3<Vector3D> upperAcc = upperBound.Accessor();
+    CollocatedVectorGrid3::DataPositionFunc inputDataPos =
+        input.GetDataPosition();
+    CollocatedVectorGrid3::DataPositionFunc outputDataPos =
+        output->GetDataPosition();
+
+    // Forward pass, recording each trace's interpolation bounds
+    output->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (boundarySDF.Sample(inputDataPos(i, j, k)) > 0.0)
+        {
+            const Vector3D pt = BackTrace(flow, dt, h, outputDataPos(i, j, k),
+                                          boundarySDF);
+
+            std::array<Point3UI, 8> indices;
+            std::array<double, 8> weights;
+            sampler.GetCoordinatesAndWeights(pt, &indices, &weights);
+
+            Vector3D value;
+            Vector3D lower{ std::numeric_limits<double>::max(),
+                            std::numeric_limits<double>::max(),
+                            std::numeric_limits<double>::max() };
+            Vector3D upper = -lower;
+
+            for (size_t m = 0; m < 8; ++m)
+            {
+                const Vector3D& nodeValue =
+                    inputAcc(indices[m].x, indices[m].y, indices[m].z);
+                value += weights[m] * nodeValue;
+                lower = Min(lower, nodeValue);
+                upper = Max(upper, nodeValue);
+            }
+
+            forwardAcc(i, j, k) = value;
+            lowerAcc(i, j, k) = lower;
+            upperAcc(i, j, k) = upper;
+        }
+    });
+
+    SemiLagrangian3::Advect(*forward, reverseFlow, dt, backward.get(),
+                            boundarySDF);
+
+    ConstArrayAccessor3<Vector3D> backwardAcc = backward->GetConstDataAccessor();
+    ArrayAccessor3<Vector3D> outputAcc = output->GetDataAccessor();
+
+    output->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (boundarySDF.Sample(inputDataPos(i, j, k)) > 0.0)
+        {
+            const Vector3D& forwardValue = forwardAcc(i, j, k);
+            const Vector3D& sourceValue = inputAcc(i, j, k);
+            const Vector3D& backwardValue = backwardAcc(i, j, k);
+            const Vector3D& lower = lowerAcc(i, j, k);
+            const Vector3D& upper = upperAcc(i, j, k);
+
+            outputAcc(i, j, k) = Vector3D{
+                CorrectAndClamp(forwardValue.x, sourceValue.x, backwardValue.x,
+                                lower.x, upper.x),
+                CorrectAndClamp(forwardValue.y, sourceValue.y, backwardValue.y,
+                                lower.y, upper.y),
+                CorrectAndClamp(forwardValue.z, sourceValue.z, backwardValue.z,
+                                lower.z, upper.z)
+            };
+        }
+    });
+}
+
+void MacCormackSemiLagrangian3::Advect(const FaceCenteredGrid3& input,
+                                       const VectorField3& flow, double dt,
+                                       FaceCenteredGrid3* output,
+                                       const ScalarField3& boundarySDF)
+{
+    const double h = std::min(output->GridSpacing().x, output->GridSpacing().y);
+    const CustomVectorField3 reverseFlow{ [&flow](const Vector3D& x) {
+        return -flow.Sample(x);
+    } };
+
+    const auto forward =
+        std::dynamic_pointer_cast<FaceCenteredGrid3>(input.Clone());
+    const auto backward =
+        std::dynamic_pointer_cast<FaceCenteredGrid3>(input.Clone());
+
+    // Each velocity component lives on its own staggered lattice, so the
+    // passes run per component with scalar accessors
+    ConstArrayAccessor3<double> uInput = input.GetUConstAccessor();
+    const LinearArraySampler3<double, double> uSampler{
+        uInput, input.GridSpacing(), input.GetUOrigin()
+    };
+    Array3<double> uLower{ uInput.size() };
+    Array3<double> uUpper{ uInput.size() };
+
+    ForwardPass(flow, dt, h, uInput, uSampler, input.GetUPosition(),
+                output->GetUPosition(), boundarySDF, forward->GetUAccessor(),
+                uLower.Accessor(), uUpper.Accessor());
+
+    ConstArrayAccessor3<double> vInput = input.GetVConstAccessor();
+    const LinearArraySampler3<double, double> vSampler{
+        vInput, input.GridSpacing(), input.GetVOrigin()
+    };
+    Array3<double> vLower{ vInput.size() };
+    Array3<double> vUpper{ vInput.size() };
+
+    ForwardPass(flow, dt, h, vInput, vSampler, input.GetVPosition(),
+                output->GetVPosition(), boundarySDF, forward->GetVAccessor(),
+                vLower.Accessor(), vUpper.Accessor());
+
+    ConstArrayAccessor3<double> wInput = input.GetWConstAccessor();
+    const LinearArraySampler3<double, double> wSampler{
+        wInput, input.GridSpacing(), input.GetWOrigin()
+    };
+    Array3<double> wLower{ wInput.size() };
+    Array3<double> wUpper{ wInput.size() };
+
+    ForwardPass(flow, dt, h, wInput, wSampler, input.GetWPosition(),
+                output->GetWPosition(), boundarySDF, forward->GetWAccessor(),
+                wLower.Accessor(), wUpper.Accessor());
+
+    SemiLagrangian3::Advect(*forward, reverseFlow, dt, backward.get(),
+                            boundarySDF);
+
+    CorrectionPass(uInput, forward->GetUConstAccessor(),
+                   backward->GetUConstAccessor(), uLower.ConstAccessor(),
+                   uUpper.ConstAccessor(), input.GetUPosition(), boundarySDF,
+                   output->GetUAccessor());
+    CorrectionPass(vInput, forward->GetVConstAccessor(),
+                   backward->GetVConstAccessor(), vLower.ConstAccessor(),
+                   vUpper.ConstAccessor(), input.GetVPosition(), boundarySDF,
+                   output->GetVAccessor());
+    CorrectionPass(wInput, forward->GetWConstAccessor(),
+                   backward->GetWConstAccessor(), wLower.ConstAccessor(),
+                   wUpper.ConstAccessor(), input.GetWPosition(), boundarySDF,
+                   output->GetWAccessor());
+}
+
+void MacCormackSemiLagrangian3::ForwardPass(
+    const VectorField3& flow, double dt, double h,
+    const ConstArrayAccessor3<double>& inputAcc,
+    const LinearArraySampler3<double, double>& sampler,
+    const std::function<Vector3D(size_t, size_t, size_t)>& inputDataPos,
+    const std::function<Vector3D(size_t, size_t, size_t)>& outputDataPos,
+    const ScalarField3& boundarySDF, ArrayAccessor3<double> forwardAcc,
+    ArrayAccessor3<double> lowerBound, ArrayAccessor3<double> upperBound) const
+{
+    forwardAcc.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (boundarySDF.Sample(inputDataPos(i, j, k)) > 0.0)
+        {
+            const Vector3D pt = BackTrace(flow, dt, h, outputDataPos(i, j, k),
+                                          boundarySDF);
+
+            std::array<Point3UI, 8> indices;
+            std::array<double, 8> weights;
+            sampler.GetCoordinatesAndWeights(pt, &indices, &weights);
+
+            double value = 0.0;
+            double lower = std::numeric_limits<double>::max();
+            double upper = std::numeric_limits<double>::lowest();
+
+            for (size_t m = 0; m < 8; ++m)
+            {
+                const double nodeValue =
+                    inputAcc(indices[m].x, indices[m].y, indices[m].z);
+                value += weights[m] * nodeValue;
+                lower = std::min(lower, nodeValue);
+                upper = std::max(upper, nodeValue);
+            }
+
+            forwardAcc(i, j, k) = value;
+            lowerBound(i, j, k) = lower;
+            upperBound(i, j, k) = upper;
+        }
+    });
+}
+
+void MacCormackSemiLagrangian3::CorrectionPass(
+    const ConstArrayAccessor3<double>& inputAcc,
+    const ConstArrayAccessor3<double>& forwardAcc,
+    const ConstArrayAccessor3<double>& backwardAcc,
+    const ConstArrayAccessor3<double>& lowerBound,
+    const ConstArrayAccessor3<double>& upperBound,
+    const std::function<Vector3D(size_t, size_t, size_t)>& inputDataPos,
+    const ScalarField3& boundarySDF, ArrayAccessor3<double> outputAcc) const
+{
+    outputAcc.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (boundarySDF.Sample(inputDataPos(i, j, k)) > 0.0)
+        {
+            outputAcc(i, j, k) =
+                CorrectAndClamp(forwardAcc(i, j, k), inputAcc(i, j, k),
+                                backwardAcc(i, j, k), lowerBound(i, j, k),
+                                upperBound(i, j, k));
+        }
+    });
+}
+}  // namespace CubbyFlow
@@ -8,7 +8,10 @@
 // personal capacity and are not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <Core/Array/Array1.hpp>
+#include <Core/Array/ArraySamplers3.hpp>
 #include <Core/Solver/Advection/SemiLagrangian3.hpp>
+#include <Core/Utils/Parallel.hpp>
 
 namespace CubbyFlow
 {
@@ -16,20 +19,55 @@ void SemiLagrangian3::Advect(const ScalarGrid3& input, const VectorField3& flow,
                              double dt, ScalarGrid3* output,
                              const ScalarField3& boundarySDF)
 {
-    std::function<double(const Vector3D&)> inputSamplerFunc =
-        GetScalarSamplerFunc(input);
+    std::function<void(const ConstArrayAccessor1<Vector3D>&,
+                       ArrayAccessor1<double>)>
+        inputBatchSamplerFunc = GetScalarBatchSamplerFunc(input);
     double h = std::min(output->GridSpacing().x, output->GridSpacing().y);
 
     ScalarGrid3::DataPositionFunc inputDataPos = input.GetDataPosition();
     ScalarGrid3::DataPositionFunc outputDataPos = output->GetDataPosition();
     ArrayAccessor<double, 3> outputDataAcc = output->GetDataAccessor();
 
+    const Size3 size = outputDataAcc.size();
+    const size_t n = size.x * size.y * size.z;
+
+    // Back-trace every sample point first, then hand the whole batch to the
+    // sampler so the interpolation runs as tight non-virtual loops.
+    Array1<Vector3D> backTracedPoints(n);
+    Array1<double> sampledValues(n);
+    Array1<char> needsUpdate(n);
+
     output->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const size_t idx = i + size.x * (j + size.y * k);
+
         if (boundarySDF.Sample(inputDataPos(i, j, k)) > 0.0)
         {
-            const Vector3D pt =
+            needsUpdate[idx] = 1;
+            backTracedPoints[idx] =
                 BackTrace(flow, dt, h, outputDataPos(i, j, k), boundarySDF);
-            outputDataAcc(i, j, k) = inputSamplerFunc(pt);
+        }
+        else
+        {
+            needsUpdate[idx] = 0;
+            backTracedPoints[idx] = outputDataPos(i, j, k);
+        }
+    });
+
+    ParallelRangeFor(ZERO_SIZE, n, [&](size_t begin, size_t end) {
+        const ConstArrayAccessor1<Vector3D> points{
+            end - begin, backTracedPoints.data() + begin
+        };
+        const ArrayAccessor1<double> values{ end - begin,
+                                             sampledValues.data() + begin };
+        inputBatchSamplerFunc(points, values);
+    });
+
+    output->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const size_t idx = i + size.x * (j + size.y * k);
+
+        if (needsUpdate[idx] != 0)
+        {
+            outputDataAcc(i, j, k) = sampledValues[idx];
         }
     });
 }
@@ -156,6 +194,21 @@ std::function<double(const Vector3D&)> SemiLagrangian3::GetScalarSamplerFunc(
     return input.Sampler();
 }
 
+std::function<void(const ConstArrayAccessor1<Vector3D>&,
+                   ArrayAccessor1<double>)>
+SemiLagrangian3::GetScalarBatchSamplerFunc(const ScalarGrid3& input) const
+{
+    const LinearArraySampler3<double, double> sourceSampler{
+        input.GetConstDataAccessor(), input.GridSpacing(),
+        input.GetDataOrigin()
+    };
+
+    return [sourceSampler](const ConstArrayAccessor1<Vector3D>& points,
+                           ArrayAccessor1<double> results) {
+        sourceSampler.Sample(points, results);
+    };
+}
+
 std::function<Vector3D(const Vector3D&)> SemiLagrangian3::GetVectorSamplerFunc(
     const CollocatedVectorGrid3& input) const
 {
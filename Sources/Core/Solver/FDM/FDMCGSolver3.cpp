@@ -10,6 +10,9 @@
 
 #include <Core/Math/CG.hpp>
 #include <Core/Solver/FDM/FDMCGSolver3.hpp>
+#include <Core/Utils/Profiler.hpp>
+
+#include <algorithm>
 
 namespace CubbyFlow
 {
@@ -24,6 +27,13 @@ FDMCGSolver3::FDMCGSolver3(unsigned int maxNumberOfIterations, double tolerance)
 
 bool FDMCGSolver3::Solve(FDMLinearSystem3* system)
 {
+    CUBBYFLOW_PROFILE_ZONE("FDMCGSolver3::Solve");
+
+    if (m_useSinglePrecision)
+    {
+        return SolveSinglePrecision(system);
+    }
+
     FDMMatrix3& matrix = system->A;
     FDMVector3& solution = system->x;
     FDMVector3& rhs = system->b;
@@ -32,6 +42,7 @@ bool FDMCGSolver3::Solve(FDMLinearSystem3* system)
     assert(matrix.size() == solution.size());
 
     ClearCompressedVectors();
+    ClearSinglePrecisionVectors();
 
     const Size3 size = matrix.size();
     m_r.Resize(size);
@@ -39,17 +50,26 @@ bool FDMCGSolver3::Solve(FDMLinearSystem3* system)
     m_q.Resize(size);
     m_s.Resize(size);
 
-    system->x.Set(0.0);
+    if (!m_useInitialGuess)
+    {
+        system->x.Set(0.0);
+    }
     m_r.Set(0.0);
     m_d.Set(0.0);
     m_q.Set(0.0);
     m_s.Set(0.0);
 
-    CG<FDMBLAS3>(matrix, rhs, m_maxNumberOfIterations, m_tolerance, &solution,
+    const double tolerance = EffectiveTolerance(FDMBLAS3::L2Norm(rhs));
+
+    CGMetricsObserver* observer = BeginMetricsCollection();
+
+    CG<FDMBLAS3>(matrix, rhs, m_maxNumberOfIterations, tolerance, &solution,
                  &m_r, &m_d, &m_q, &m_s, &m_lastNumberOfIterations,
-                 &m_lastResidual);
+                 &m_lastResidual, observer);
+
+    EndMetricsCollection();
 
-    return (m_lastResidual <= m_tolerance) ||
+    return (m_lastResidual <= tolerance) ||
            (m_lastNumberOfIterations < m_maxNumberOfIterations);
 }
 
@@ -67,17 +87,64 @@ bool FDMCGSolver3::SolveCompressed(FDMCompressedLinearSystem3* system)
     m_qComp.Resize(size);
     m_sComp.Resize(size);
 
-    system->x.Set(0.0);
+    if (!m_useInitialGuess)
+    {
+        system->x.Set(0.0);
+    }
     m_rComp.Set(0.0);
     m_dComp.Set(0.0);
     m_qComp.Set(0.0);
     m_sComp.Set(0.0);
 
-    CG<FDMCompressedBLAS3>(matrix, rhs, m_maxNumberOfIterations, m_tolerance,
+    const double tolerance =
+        EffectiveTolerance(FDMCompressedBLAS3::L2Norm(rhs));
+
+    CGMetricsObserver* observer = BeginMetricsCollection();
+
+    CG<FDMCompressedBLAS3>(matrix, rhs, m_maxNumberOfIterations, tolerance,
                            &solution, &m_rComp, &m_dComp, &m_qComp, &m_sComp,
-                           &m_lastNumberOfIterations, &m_lastResidual);
+                           &m_lastNumberOfIterations, &m_lastResidual,
+                           observer);
+
+    EndMetricsCollection();
 
-    return (m_lastResidual <= m_tolerance) ||
+    return (m_lastResidual <= tolerance) ||
+           (m_lastNumberOfIterations < m_maxNumberOfIterations);
+}
+
+bool FDMCGSolver3::SolveMatrixFree(const FDMMatrixFreeOperator3& op,
+                                   const FDMVector3& b, FDMVector3* x)
+{
+    assert(b.size() == x->size());
+
+    ClearCompressedVectors();
+
+    const Size3 size = b.size();
+    m_r.Resize(size);
+    m_d.Resize(size);
+    m_q.Resize(size);
+    m_s.Resize(size);
+
+    if (!m_useInitialGuess)
+    {
+        x->Set(0.0);
+    }
+    m_r.Set(0.0);
+    m_d.Set(0.0);
+    m_q.Set(0.0);
+    m_s.Set(0.0);
+
+    const double tolerance = EffectiveTolerance(FDMBLAS3::L2Norm(b));
+
+    CGMetricsObserver* observer = BeginMetricsCollection();
+
+    CG<FDMMatrixFreeBLAS3>(op, b, m_maxNumberOfIterations, tolerance, x,
+                           &m_r, &m_d, &m_q, &m_s, &m_lastNumberOfIterations,
+                           &m_lastResidual, observer);
+
+    EndMetricsCollection();
+
+    return (m_lastResidual <= tolerance) ||
            (m_lastNumberOfIterations < m_maxNumberOfIterations);
 }
 
@@ -96,11 +163,110 @@ double FDMCGSolver3::GetTolerance() const
     return m_tolerance;
 }
 
+void FDMCGSolver3::SetTolerance(double tolerance)
+{
+    m_tolerance = std::max(tolerance, 0.0);
+}
+
 double FDMCGSolver3::GetLastResidual() const
 {
     return m_lastResidual;
 }
 
+double FDMCGSolver3::GetRelativeTolerance() const
+{
+    return m_relativeTolerance;
+}
+
+void FDMCGSolver3::SetRelativeTolerance(double relativeTolerance)
+{
+    m_relativeTolerance = std::max(relativeTolerance, 0.0);
+}
+
+bool FDMCGSolver3::GetUseInitialGuess() const
+{
+    return m_useInitialGuess;
+}
+
+void FDMCGSolver3::SetUseInitialGuess(bool useInitialGuess)
+{
+    m_useInitialGuess = useInitialGuess;
+}
+
+bool FDMCGSolver3::GetUseSinglePrecision() const
+{
+    return m_useSinglePrecision;
+}
+
+void FDMCGSolver3::SetUseSinglePrecision(bool useSinglePrecision)
+{
+    m_useSinglePrecision = useSinglePrecision;
+}
+
+bool FDMCGSolver3::SolveSinglePrecision(FDMLinearSystem3* system)
+{
+    FDMMatrix3& matrix = system->A;
+    FDMVector3& solution = system->x;
+    FDMVector3& rhs = system->b;
+
+    assert(matrix.size() == rhs.size());
+    assert(matrix.size() == solution.size());
+
+    ClearUncompressedVectors();
+    ClearCompressedVectors();
+
+    const Size3 size = matrix.size();
+    m_matF.Resize(size);
+    m_xF.Resize(size);
+    m_bF.Resize(size);
+    m_rF.Resize(size);
+    m_dF.Resize(size);
+    m_qF.Resize(size);
+    m_sF.Resize(size);
+
+    if (!m_useInitialGuess)
+    {
+        solution.Set(0.0);
+    }
+
+    matrix.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        m_matF(i, j, k).center = static_cast<float>(matrix(i, j, k).center);
+        m_matF(i, j, k).right = static_cast<float>(matrix(i, j, k).right);
+        m_matF(i, j, k).up = static_cast<float>(matrix(i, j, k).up);
+        m_matF(i, j, k).front = static_cast<float>(matrix(i, j, k).front);
+
+        m_xF(i, j, k) = static_cast<float>(solution(i, j, k));
+        m_bF(i, j, k) = static_cast<float>(rhs(i, j, k));
+    });
+
+    m_rF.Set(0.0f);
+    m_dF.Set(0.0f);
+    m_qF.Set(0.0f);
+    m_sF.Set(0.0f);
+
+    const double tolerance = EffectiveTolerance(FDMBLAS3F::L2Norm(m_bF));
+
+    CGMetricsObserver* observer = BeginMetricsCollection();
+
+    CG<FDMBLAS3F>(m_matF, m_bF, m_maxNumberOfIterations, tolerance, &m_xF,
+                  &m_rF, &m_dF, &m_qF, &m_sF, &m_lastNumberOfIterations,
+                  &m_lastResidual, observer);
+
+    EndMetricsCollection();
+
+    solution.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        solution(i, j, k) = m_xF(i, j, k);
+    });
+
+    return (m_lastResidual <= tolerance) ||
+           (m_lastNumberOfIterations < m_maxNumberOfIterations);
+}
+
+double FDMCGSolver3::EffectiveTolerance(double bNorm) const
+{
+    return std::max(m_tolerance, m_relativeTolerance * bNorm);
+}
+
 void FDMCGSolver3::ClearUncompressedVectors()
 {
     m_r.Clear();
@@ -116,4 +282,15 @@ void FDMCGSolver3::ClearCompressedVectors()
     m_qComp.Clear();
     m_sComp.Clear();
 }
+
+void FDMCGSolver3::ClearSinglePrecisionVectors()
+{
+    m_matF.Clear();
+    m_xF.Clear();
+    m_bF.Clear();
+    m_rF.Clear();
+    m_dF.Clear();
+    m_qF.Clear();
+    m_sF.Clear();
+}
 }  // namespace CubbyFlow
\ No newline at end of file
@@ -0,0 +1,45 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Solver/FDM/FDMCallbackSolver3.hpp>
+
+#include <utility>
+
+namespace CubbyFlow
+{
+FDMCallbackSolver3::FDMCallbackSolver3(
+    FDMSystemSolverFunction3 solveFunction,
+    FDMCompressedSystemSolverFunction3 solveCompressedFunction)
+    : m_solveFunction(std::move(solveFunction)),
+      m_solveCompressedFunction(std::move(solveCompressedFunction))
+{
+    // Do nothing
+}
+
+bool FDMCallbackSolver3::Solve(FDMLinearSystem3* system)
+{
+    if (!m_solveFunction)
+    {
+        return false;
+    }
+
+    return m_solveFunction(system);
+}
+
+bool FDMCallbackSolver3::SolveCompressed(FDMCompressedLinearSystem3* system)
+{
+    if (!m_solveCompressedFunction)
+    {
+        return false;
+    }
+
+    return m_solveCompressedFunction(system);
+}
+}  // namespace CubbyFlow
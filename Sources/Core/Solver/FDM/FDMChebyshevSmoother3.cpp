@@ -0,0 +1,93 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Solver/FDM/FDMChebyshevSmoother3.hpp>
+
+#include <cassert>
+
+namespace CubbyFlow
+{
+void FDMChebyshevSmoother3::Relax(const FDMMatrix3& A, const FDMVector3& b,
+                                  unsigned int numberOfIterations,
+                                  FDMVector3* x, FDMVector3* z, FDMVector3* d)
+{
+    const Size3 size = A.size();
+
+    assert(size == b.size());
+    assert(size == x->size());
+    assert(size == z->size());
+    assert(size == d->size());
+
+    if (numberOfIterations == 0)
+    {
+        return;
+    }
+
+    // The Jacobi-preconditioned spectrum sits in [0, 2] by weak diagonal
+    // dominance. The polynomial targets the upper part of that interval;
+    // the lower bound only decides how much of the smooth spectrum is also
+    // damped, which Multigrid handles on the coarser levels anyway.
+    const double eigMax = 2.2;
+    const double eigMin = 0.1 * eigMax;
+
+    const double theta = 0.5 * (eigMax + eigMin);
+    const double delta = 0.5 * (eigMax - eigMin);
+    const double sigma = theta / delta;
+
+    ArrayAccessor3<double> xAcc = x->Accessor();
+    ArrayAccessor3<double> zAcc = z->Accessor();
+    ArrayAccessor3<double> dAcc = d->Accessor();
+
+    const auto jacobiResidual = [&](size_t i, size_t j, size_t k) {
+        const double r =
+            b(i, j, k) - A(i, j, k).center * xAcc(i, j, k) -
+            ((i > 0) ? A(i - 1, j, k).right * xAcc(i - 1, j, k) : 0.0) -
+            ((i + 1 < size.x) ? A(i, j, k).right * xAcc(i + 1, j, k) : 0.0) -
+            ((j > 0) ? A(i, j - 1, k).up * xAcc(i, j - 1, k) : 0.0) -
+            ((j + 1 < size.y) ? A(i, j, k).up * xAcc(i, j + 1, k) : 0.0) -
+            ((k > 0) ? A(i, j, k - 1).front * xAcc(i, j, k - 1) : 0.0) -
+            ((k + 1 < size.z) ? A(i, j, k).front * xAcc(i, j, k + 1) : 0.0);
+
+        return r / A(i, j, k).center;
+    };
+
+    // First step: d = z / theta, x += d
+    A.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        zAcc(i, j, k) = jacobiResidual(i, j, k);
+    });
+    A.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const double val = zAcc(i, j, k) / theta;
+        dAcc(i, j, k) = val;
+        xAcc(i, j, k) += val;
+    });
+
+    double rhoPrev = 1.0 / sigma;
+
+    for (unsigned int iter = 1; iter < numberOfIterations; ++iter)
+    {
+        const double rho = 1.0 / (2.0 * sigma - rhoPrev);
+        const double c1 = rho * rhoPrev;
+        const double c2 = 2.0 * rho / delta;
+
+        // The residual pass only reads x, the update pass is element-wise,
+        // so both run fully parallel.
+        A.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            zAcc(i, j, k) = jacobiResidual(i, j, k);
+        });
+        A.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            const double val = c1 * dAcc(i, j, k) + c2 * zAcc(i, j, k);
+            dAcc(i, j, k) = val;
+            xAcc(i, j, k) += val;
+        });
+
+        rhoPrev = rho;
+    }
+}
+}  // namespace CubbyFlow
@@ -190,8 +190,11 @@ void FDMGaussSeidelSolver2::RelaxRedBlack(const FDMMatrix2& A,
         [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd) {
             for (size_t j = jBegin; j < jEnd; ++j)
             {
-                // i.e. (0, 0)
-                size_t i = j % 2 + iBegin;
+                // First index with even parity, i.e. (0, 0). Derived from the
+                // absolute index so that the sweep stays correct even when
+                // the range splitter hands out sub-ranges that start at an
+                // odd i.
+                size_t i = iBegin + (iBegin + j) % 2;
 
                 for (; i < iEnd; i += 2)
                 {
@@ -214,7 +217,8 @@ void FDMGaussSeidelSolver2::RelaxRedBlack(const FDMMatrix2& A,
         [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd) {
             for (size_t j = jBegin; j < jEnd; ++j)
             {
-                size_t i = 1 - j % 2 + iBegin;  // i.e. (1, 0)
+                // First index with odd parity, i.e. (1, 0).
+                size_t i = iBegin + 1 - (iBegin + j) % 2;
 
                 for (; i < iEnd; i += 2)
                 {
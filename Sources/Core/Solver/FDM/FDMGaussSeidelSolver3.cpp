@@ -130,18 +130,18 @@ void FDMGaussSeidelSolver3::Relax(const FDMMatrix3& A, const FDMVector3& b,
                                   double sorFactor, FDMVector3* x)
 {
     Size3 size = A.size();
-    FDMVector3& xRef = *x;
+    ArrayAccessor3<double> xAcc = x->Accessor();
 
     A.ForEachIndex([&](size_t i, size_t j, size_t k) {
         const double r =
-            ((i > 0) ? A(i - 1, j, k).right * xRef(i - 1, j, k) : 0.0) +
-            ((i + 1 < size.x) ? A(i, j, k).right * xRef(i + 1, j, k) : 0.0) +
-            ((j > 0) ? A(i, j - 1, k).up * xRef(i, j - 1, k) : 0.0) +
-            ((j + 1 < size.y) ? A(i, j, k).up * xRef(i, j + 1, k) : 0.0) +
-            ((k > 0) ? A(i, j, k - 1).front * xRef(i, j, k - 1) : 0.0) +
-            ((k + 1 < size.z) ? A(i, j, k).front * xRef(i, j, k + 1) : 0.0);
-
-        xRef(i, j, k) = (1.0 - sorFactor) * xRef(i, j, k) +
+            ((i > 0) ? A(i - 1, j, k).right * xAcc(i - 1, j, k) : 0.0) +
+            ((i + 1 < size.x) ? A(i, j, k).right * xAcc(i + 1, j, k) : 0.0) +
+            ((j > 0) ? A(i, j - 1, k).up * xAcc(i, j - 1, k) : 0.0) +
+            ((j + 1 < size.y) ? A(i, j, k).up * xAcc(i, j + 1, k) : 0.0) +
+            ((k > 0) ? A(i, j, k - 1).front * xAcc(i, j, k - 1) : 0.0) +
+            ((k + 1 < size.z) ? A(i, j, k).front * xAcc(i, j, k + 1) : 0.0);
+
+        xAcc(i, j, k) = (1.0 - sorFactor) * xAcc(i, j, k) +
                         sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
     });
 }
@@ -184,7 +184,7 @@ void FDMGaussSeidelSolver3::RelaxRedBlack(const FDMMatrix3& A,
                                           FDMVector3* x)
 {
     Size3 size = A.size();
-    FDMVector3& xRef = *x;
+    ArrayAccessor3<double> xAcc = x->Accessor();
 
     // Red update
     ParallelRangeFor(
@@ -195,30 +195,33 @@ void FDMGaussSeidelSolver3::RelaxRedBlack(const FDMMatrix3& A,
             {
                 for (size_t j = jBegin; j < jEnd; ++j)
                 {
-                    // i.e. (0, 0, 0)
-                    size_t i = (j + k) % 2 + iBegin;
+                    // First index with even parity, i.e. (0, 0, 0). Derived
+                    // from the absolute index so that the sweep stays correct
+                    // even when the range splitter hands out sub-ranges that
+                    // start at an odd i.
+                    size_t i = iBegin + (iBegin + j + k) % 2;
 
                     for (; i < iEnd; i += 2)
                     {
                         const double r =
-                            ((i > 0) ? A(i - 1, j, k).right * xRef(i - 1, j, k)
+                            ((i > 0) ? A(i - 1, j, k).right * xAcc(i - 1, j, k)
                                      : 0.0) +
                             ((i + 1 < size.x)
-                                 ? A(i, j, k).right * xRef(i + 1, j, k)
+                                 ? A(i, j, k).right * xAcc(i + 1, j, k)
                                  : 0.0) +
-                            ((j > 0) ? A(i, j - 1, k).up * xRef(i, j - 1, k)
+                            ((j > 0) ? A(i, j - 1, k).up * xAcc(i, j - 1, k)
                                      : 0.0) +
                             ((j + 1 < size.y)
-                                 ? A(i, j, k).up * xRef(i, j + 1, k)
+                                 ? A(i, j, k).up * xAcc(i, j + 1, k)
                                  : 0.0) +
-                            ((k > 0) ? A(i, j, k - 1).front * xRef(i, j, k - 1)
+                            ((k > 0) ? A(i, j, k - 1).front * xAcc(i, j, k - 1)
                                      : 0.0) +
                             ((k + 1 < size.z)
-                                 ? A(i, j, k).front * xRef(i, j, k + 1)
+                                 ? A(i, j, k).front * xAcc(i, j, k + 1)
                                  : 0.0);
 
-                        xRef(i, j, k) =
-                            (1.0 - sorFactor) * xRef(i, j, k) +
+                        xAcc(i, j, k) =
+                            (1.0 - sorFactor) * xAcc(i, j, k) +
                             sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
                     }
                 }
@@ -234,30 +237,30 @@ void FDMGaussSeidelSolver3::RelaxRedBlack(const FDMMatrix3& A,
             {
                 for (size_t j = jBegin; j < jEnd; ++j)
                 {
-                    // i.e. (1, 1, 1)
-                    size_t i = 1 - (j + k) % 2 + iBegin;
+                    // First index with odd parity, i.e. (1, 1, 1).
+                    size_t i = iBegin + 1 - (iBegin + j + k) % 2;
 
                     for (; i < iEnd; i += 2)
                     {
                         const double r =
-                            ((i > 0) ? A(i - 1, j, k).right * xRef(i - 1, j, k)
+                            ((i > 0) ? A(i - 1, j, k).right * xAcc(i - 1, j, k)
                                      : 0.0) +
                             ((i + 1 < size.x)
-                                 ? A(i, j, k).right * xRef(i + 1, j, k)
+                                 ? A(i, j, k).right * xAcc(i + 1, j, k)
                                  : 0.0) +
-                            ((j > 0) ? A(i, j - 1, k).up * xRef(i, j - 1, k)
+                            ((j > 0) ? A(i, j - 1, k).up * xAcc(i, j - 1, k)
                                      : 0.0) +
                             ((j + 1 < size.y)
-                                 ? A(i, j, k).up * xRef(i, j + 1, k)
+                                 ? A(i, j, k).up * xAcc(i, j + 1, k)
                                  : 0.0) +
-                            ((k > 0) ? A(i, j, k - 1).front * xRef(i, j, k - 1)
+                            ((k > 0) ? A(i, j, k - 1).front * xAcc(i, j, k - 1)
                                      : 0.0) +
                             ((k + 1 < size.z)
-                                 ? A(i, j, k).front * xRef(i, j, k + 1)
+                                 ? A(i, j, k).front * xAcc(i, j, k + 1)
                                  : 0.0);
 
-                        xRef(i, j, k) =
-                            (1.0 - sorFactor) * xRef(i, j, k) +
+                        xAcc(i, j, k) =
+                            (1.0 - sorFactor) * xAcc(i, j, k) +
                             sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
                     }
                 }
@@ -11,6 +11,10 @@
 #include <Core/Math/CG.hpp>
 #include <Core/Solver/FDM/FDMICCGSolver3.hpp>
 #include <Core/Utils/Logging.hpp>
+#include <Core/Utils/Parallel.hpp>
+#include <Core/Utils/Profiler.hpp>
+
+#include <algorithm>
 
 namespace CubbyFlow
 {
@@ -49,20 +53,51 @@ void FDMICCGSolver3::Preconditioner::Solve(const FDMVector3& b, FDMVector3* x)
     const auto sy = static_cast<ssize_t>(size.y);
     const auto sz = static_cast<ssize_t>(size.z);
 
-    b.ForEachIndex([&](size_t i, size_t j, size_t k) {
-        y(i, j, k) = (b(i, j, k) -
-                      ((i > 0) ? A(i - 1, j, k).right * y(i - 1, j, k) : 0.0) -
-                      ((j > 0) ? A(i, j - 1, k).up * y(i, j - 1, k) : 0.0) -
-                      ((k > 0) ? A(i, j, k - 1).front * y(i, j, k - 1) : 0.0)) *
-                     d(i, j, k);
-    });
+    // Both triangular sweeps are level-scheduled over the hyperplanes
+    // i + j + k = s. With the 7-point stencil, every element on a plane
+    // depends only on elements of the previous plane, so the elements
+    // within one plane can be solved concurrently while each of them is
+    // still computed from exactly the same operands as in the serial
+    // sweep. The result is therefore bit-identical to the serial version.
+    const ssize_t numPlanes = sx + sy + sz - 2;
 
-    for (ssize_t k = sz - 1; k >= 0; --k)
+    for (ssize_t s = 0; s < numPlanes; ++s)
     {
-        for (ssize_t j = sy - 1; j >= 0; --j)
-        {
-            for (ssize_t i = sx - 1; i >= 0; --i)
+        const ssize_t kBegin = std::max(ssize_t{ 0 }, s - (sx - 1) - (sy - 1));
+        const ssize_t kEnd = std::min(sz - 1, s);
+
+        ParallelFor(kBegin, kEnd + 1, [&](ssize_t k) {
+            const ssize_t jBegin = std::max(ssize_t{ 0 }, s - k - (sx - 1));
+            const ssize_t jEnd = std::min(sy - 1, s - k);
+
+            for (ssize_t j = jBegin; j <= jEnd; ++j)
+            {
+                const ssize_t i = s - k - j;
+
+                y(i, j, k) =
+                    (b(i, j, k) -
+                     ((i > 0) ? A(i - 1, j, k).right * y(i - 1, j, k) : 0.0) -
+                     ((j > 0) ? A(i, j - 1, k).up * y(i, j - 1, k) : 0.0) -
+                     ((k > 0) ? A(i, j, k - 1).front * y(i, j, k - 1)
+                              : 0.0)) *
+                    d(i, j, k);
+            }
+        });
+    }
+
+    for (ssize_t s = numPlanes - 1; s >= 0; --s)
+    {
+        const ssize_t kBegin = std::max(ssize_t{ 0 }, s - (sx - 1) - (sy - 1));
+        const ssize_t kEnd = std::min(sz - 1, s);
+
+        ParallelFor(kBegin, kEnd + 1, [&](ssize_t k) {
+            const ssize_t jBegin = std::max(ssize_t{ 0 }, s - k - (sx - 1));
+            const ssize_t jEnd = std::min(sy - 1, s - k);
+
+            for (ssize_t j = jBegin; j <= jEnd; ++j)
             {
+                const ssize_t i = s - k - j;
+
                 (*x)(i, j, k) =
                     (y(i, j, k) -
                      ((i + 1 < sx) ? A(i, j, k).right * (*x)(i + 1, j, k)
@@ -72,7 +107,7 @@ void FDMICCGSolver3::Preconditioner::Solve(const FDMVector3& b, FDMVector3* x)
                                    : 0.0)) *
                     d(i, j, k);
             }
-        }
+        });
     }
 }
 
@@ -177,6 +212,8 @@ FDMICCGSolver3::FDMICCGSolver3(unsigned int maxNumberOfIterations,
 
 bool FDMICCGSolver3::Solve(FDMLinearSystem3* system)
 {
+    CUBBYFLOW_PROFILE_ZONE("FDMICCGSolver3::Solve");
+
     FDMMatrix3& matrix = system->A;
     FDMVector3& solution = system->x;
     FDMVector3& rhs = system->b;
@@ -192,24 +229,52 @@ bool FDMICCGSolver3::Solve(FDMLinearSystem3* system)
     m_q.Resize(size);
     m_s.Resize(size);
 
-    system->x.Set(0.0);
+    if (!m_useInitialGuess)
+    {
+        system->x.Set(0.0);
+    }
     m_r.Set(0.0);
     m_d.Set(0.0);
     m_q.Set(0.0);
     m_s.Set(0.0);
 
-    m_precond.Build(matrix);
+    CGMetricsObserver* observer = BeginMetricsCollection();
+
+    {
+        const Timer precondTimer;
+
+        if (m_reusePreconditioner && m_precond.d.size() == size)
+        {
+            // The factorization from the previous solve is still valid;
+            // only re-point the accessor at the (unchanged) coefficients.
+            m_precond.A = matrix.ConstAccessor();
+        }
+        else
+        {
+            m_precond.Build(matrix);
+        }
+
+        if (observer != nullptr)
+        {
+            observer->OnPhaseTime(CGPhase::Preconditioner,
+                                  precondTimer.DurationInSeconds());
+        }
+    }
+
+    const double tolerance = EffectiveTolerance(FDMBLAS3::L2Norm(rhs));
 
     PCG<FDMBLAS3, Preconditioner>(matrix, rhs, m_maxNumberOfIterations,
-                                  m_tolerance, &m_precond, &solution, &m_r,
+                                  tolerance, &m_precond, &solution, &m_r,
                                   &m_d, &m_q, &m_s, &m_lastNumberOfIterations,
-                                  &m_lastResidualNorm);
+                                  &m_lastResidualNorm, observer);
+
+    EndMetricsCollection();
 
     CUBBYFLOW_INFO << "Residual norm after solving ICCG: " << m_lastResidualNorm
                    << " Number of ICCG iterations: "
                    << m_lastNumberOfIterations;
 
-    return (m_lastResidualNorm <= m_tolerance) ||
+    return (m_lastResidualNorm <= tolerance) ||
            (m_lastNumberOfIterations < m_maxNumberOfIterations);
 }
 
@@ -227,24 +292,51 @@ bool FDMICCGSolver3::SolveCompressed(FDMCompressedLinearSystem3* system)
     m_qComp.Resize(size);
     m_sComp.Resize(size);
 
-    system->x.Set(0.0);
+    if (!m_useInitialGuess)
+    {
+        system->x.Set(0.0);
+    }
     m_rComp.Set(0.0);
     m_dComp.Set(0.0);
     m_qComp.Set(0.0);
     m_sComp.Set(0.0);
 
-    m_precondComp.Build(matrix);
+    CGMetricsObserver* observer = BeginMetricsCollection();
+
+    {
+        const Timer precondTimer;
+
+        if (m_reusePreconditioner && m_precondComp.d.size() == size)
+        {
+            m_precondComp.A = &matrix;
+        }
+        else
+        {
+            m_precondComp.Build(matrix);
+        }
+
+        if (observer != nullptr)
+        {
+            observer->OnPhaseTime(CGPhase::Preconditioner,
+                                  precondTimer.DurationInSeconds());
+        }
+    }
+
+    const double tolerance =
+        EffectiveTolerance(FDMCompressedBLAS3::L2Norm(rhs));
 
     PCG<FDMCompressedBLAS3, PreconditionerCompressed>(
-        matrix, rhs, m_maxNumberOfIterations, m_tolerance, &m_precondComp,
+        matrix, rhs, m_maxNumberOfIterations, tolerance, &m_precondComp,
         &solution, &m_rComp, &m_dComp, &m_qComp, &m_sComp,
-        &m_lastNumberOfIterations, &m_lastResidualNorm);
+        &m_lastNumberOfIterations, &m_lastResidualNorm, observer);
+
+    EndMetricsCollection();
 
     CUBBYFLOW_INFO << "Residual after solving ICCG: " << m_lastResidualNorm
                    << " Number of ICCG iterations: "
                    << m_lastNumberOfIterations;
 
-    return (m_lastResidualNorm <= m_tolerance) ||
+    return (m_lastResidualNorm <= tolerance) ||
            (m_lastNumberOfIterations < m_maxNumberOfIterations);
 }
 
@@ -263,11 +355,51 @@ double FDMICCGSolver3::GetTolerance() const
     return m_tolerance;
 }
 
+void FDMICCGSolver3::SetTolerance(double tolerance)
+{
+    m_tolerance = std::max(tolerance, 0.0);
+}
+
 double FDMICCGSolver3::GetLastResidual() const
 {
     return m_lastResidualNorm;
 }
 
+double FDMICCGSolver3::GetRelativeTolerance() const
+{
+    return m_relativeTolerance;
+}
+
+void FDMICCGSolver3::SetRelativeTolerance(double relativeTolerance)
+{
+    m_relativeTolerance = std::max(relativeTolerance, 0.0);
+}
+
+bool FDMICCGSolver3::GetUseInitialGuess() const
+{
+    return m_useInitialGuess;
+}
+
+void FDMICCGSolver3::SetUseInitialGuess(bool useInitialGuess)
+{
+    m_useInitialGuess = useInitialGuess;
+}
+
+bool FDMICCGSolver3::GetReusePreconditioner() const
+{
+    return m_reusePreconditioner;
+}
+
+void FDMICCGSolver3::SetReusePreconditioner(bool reusePreconditioner)
+{
+    m_reusePreconditioner = reusePreconditioner;
+}
+
+double FDMICCGSolver3::EffectiveTolerance(double bNorm) const
+{
+    return std::max(m_tolerance, m_relativeTolerance * bNorm);
+}
+
 void FDMICCGSolver3::ClearUncompressedVectors()
 {
     m_r.Clear();
@@ -115,19 +115,19 @@ void FDMJacobiSolver3::Relax(const FDMMatrix3& A, const FDMVector3& b,
                              FDMVector3* x, FDMVector3* xTemp)
 {
     Size3 size = A.size();
-    FDMVector3& xRef = *x;
-    FDMVector3& xTempRef = *xTemp;
+    const ConstArrayAccessor3<double> xAcc = x->ConstAccessor();
+    ArrayAccessor3<double> xTempAcc = xTemp->Accessor();
 
     A.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
         const double r =
-            ((i > 0) ? A(i - 1, j, k).right * xRef(i - 1, j, k) : 0.0) +
-            ((i + 1 < size.x) ? A(i, j, k).right * xRef(i + 1, j, k) : 0.0) +
-            ((j > 0) ? A(i, j - 1, k).up * xRef(i, j - 1, k) : 0.0) +
-            ((j + 1 < size.y) ? A(i, j, k).up * xRef(i, j + 1, k) : 0.0) +
-            ((k > 0) ? A(i, j, k - 1).front * xRef(i, j, k - 1) : 0.0) +
-            ((k + 1 < size.z) ? A(i, j, k).front * xRef(i, j, k + 1) : 0.0);
-
-        xTempRef(i, j, k) = (b(i, j, k) - r) / A(i, j, k).center;
+            ((i > 0) ? A(i - 1, j, k).right * xAcc(i - 1, j, k) : 0.0) +
+            ((i + 1 < size.x) ? A(i, j, k).right * xAcc(i + 1, j, k) : 0.0) +
+            ((j > 0) ? A(i, j - 1, k).up * xAcc(i, j - 1, k) : 0.0) +
+            ((j + 1 < size.y) ? A(i, j, k).up * xAcc(i, j + 1, k) : 0.0) +
+            ((k > 0) ? A(i, j, k - 1).front * xAcc(i, j, k - 1) : 0.0) +
+            ((k + 1 < size.z) ? A(i, j, k).front * xAcc(i, j, k + 1) : 0.0);
+
+        xTempAcc(i, j, k) = (b(i, j, k) - r) / A(i, j, k).center;
     });
 }
 
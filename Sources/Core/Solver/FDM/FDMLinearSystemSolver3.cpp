@@ -0,0 +1,90 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Solver/FDM/FDMLinearSystemSolver3.hpp>
+
+namespace CubbyFlow
+{
+void FDMLinearSystemSolver3::SetMetricsCallback(
+    const FDMSolverMetricsCallback3& callback)
+{
+    m_metricsCallback = callback;
+}
+
+const FDMSolverMetrics3& FDMLinearSystemSolver3::GetLastMetrics() const
+{
+    return m_metrics;
+}
+
+CGMetricsObserver* FDMLinearSystemSolver3::BeginMetricsCollection()
+{
+    if (!m_metricsCallback)
+    {
+        m_isCollectingMetrics = false;
+        return nullptr;
+    }
+
+    m_metrics.residualHistory.Clear();
+    m_metrics.spmvTimeInSeconds = 0.0;
+    m_metrics.preconditionerTimeInSeconds = 0.0;
+    m_metrics.blas1TimeInSeconds = 0.0;
+    m_metrics.totalTimeInSeconds = 0.0;
+
+    m_isCollectingMetrics = true;
+    m_solveTimer.Reset();
+
+    return &m_metricsCollector;
+}
+
+void FDMLinearSystemSolver3::EndMetricsCollection()
+{
+    if (!m_isCollectingMetrics)
+    {
+        return;
+    }
+
+    m_metrics.totalTimeInSeconds = m_solveTimer.DurationInSeconds();
+    m_isCollectingMetrics = false;
+
+    m_metricsCallback(m_metrics);
+}
+
+FDMLinearSystemSolver3::MetricsCollector::MetricsCollector(
+    FDMSolverMetrics3* metrics)
+    : m_metrics{ metrics }
+{
+    // Do nothing
+}
+
+void FDMLinearSystemSolver3::MetricsCollector::OnIteration(
+    unsigned int iteration, double residualNorm)
+{
+    UNUSED_VARIABLE(iteration);
+
+    m_metrics->residualHistory.Append(residualNorm);
+}
+
+void FDMLinearSystemSolver3::MetricsCollector::OnPhaseTime(CGPhase phase,
+                                                           double seconds)
+{
+    switch (phase)
+    {
+        case CGPhase::SpMV:
+            m_metrics->spmvTimeInSeconds += seconds;
+            break;
+        case CGPhase::Preconditioner:
+            m_metrics->preconditionerTimeInSeconds += seconds;
+            break;
+        case CGPhase::Blas1:
+            m_metrics->blas1TimeInSeconds += seconds;
+            break;
+    }
+}
+}  // namespace CubbyFlow
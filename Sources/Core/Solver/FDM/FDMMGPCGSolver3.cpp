@@ -62,6 +62,27 @@ FDMMGPCGSolver3::FDMMGPCGSolver3(
     // Do nothing
 }
 
+FDMMGPCGSolver3::FDMMGPCGSolver3(
+    unsigned int numberOfCGIter, size_t maxNumberOfLevels,
+    MGSmootherType smootherType, unsigned int numberOfRestrictionIter,
+    unsigned int numberOfCorrectionIter, unsigned int numberOfCoarsestIter,
+    unsigned int numberOfFinalIter, double maxTolerance, double sorFactor)
+    : FDMMGSolver3{ maxNumberOfLevels,
+                    smootherType,
+                    numberOfRestrictionIter,
+                    numberOfCorrectionIter,
+                    numberOfCoarsestIter,
+                    numberOfFinalIter,
+                    maxTolerance,
+                    sorFactor },
+      m_maxNumberOfIterations{ numberOfCGIter },
+      m_lastNumberOfIterations{ 0 },
+      m_tolerance{ maxTolerance },
+      m_lastResidualNorm{ std::numeric_limits<double>::max() }
+{
+    // Do nothing
+}
+
 bool FDMMGPCGSolver3::Solve(FDMMGLinearSystem3* system)
 {
     const Size3 size = system->A.levels.front().size();
@@ -8,9 +8,11 @@
 // personal capacity and are not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <Core/Solver/FDM/FDMChebyshevSmoother3.hpp>
 #include <Core/Solver/FDM/FDMGaussSeidelSolver3.hpp>
 #include <Core/Solver/FDM/FDMMGSolver3.hpp>
 #include <Core/Utils/MG.hpp>
+#include <Core/Utils/Profiler.hpp>
 
 namespace CubbyFlow
 {
@@ -20,6 +22,26 @@ FDMMGSolver3::FDMMGSolver3(size_t maxNumberOfLevels,
                            unsigned int numberOfCoarsestIter,
                            unsigned int numberOfFinalIter, double maxTolerance,
                            double sorFactor, bool useRedBlackOrdering)
+    : FDMMGSolver3{ maxNumberOfLevels,
+                    useRedBlackOrdering ? MGSmootherType::RedBlackGaussSeidel
+                                        : MGSmootherType::GaussSeidel,
+                    numberOfRestrictionIter,
+                    numberOfCorrectionIter,
+                    numberOfCoarsestIter,
+                    numberOfFinalIter,
+                    maxTolerance,
+                    sorFactor }
+{
+    // Do nothing
+}
+
+FDMMGSolver3::FDMMGSolver3(size_t maxNumberOfLevels,
+                           MGSmootherType smootherType,
+                           unsigned int numberOfRestrictionIter,
+                           unsigned int numberOfCorrectionIter,
+                           unsigned int numberOfCoarsestIter,
+                           unsigned int numberOfFinalIter, double maxTolerance,
+                           double sorFactor)
 {
     m_mgParams.maxNumberOfLevels = maxNumberOfLevels;
     m_mgParams.numberOfRestrictionIter = numberOfRestrictionIter;
@@ -28,12 +50,15 @@ FDMMGSolver3::FDMMGSolver3(size_t maxNumberOfLevels,
     m_mgParams.numberOfFinalIter = numberOfFinalIter;
     m_mgParams.maxTolerance = maxTolerance;
 
-    if (useRedBlackOrdering)
+    switch (smootherType)
     {
-        m_mgParams.relaxFunc =
-            [sorFactor](const FDMMatrix3& A, const FDMVector3& b,
-                        unsigned int numberOfIterations, double _maxTolerance,
-                        FDMVector3* x, FDMVector3* buffer) {
+        case MGSmootherType::RedBlackGaussSeidel:
+            m_mgParams.relaxFunc = [sorFactor](const FDMMatrix3& A,
+                                               const FDMVector3& b,
+                                               unsigned int numberOfIterations,
+                                               double _maxTolerance,
+                                               FDMVector3* x,
+                                               FDMVector3* buffer) {
                 UNUSED_VARIABLE(_maxTolerance);
                 UNUSED_VARIABLE(buffer);
 
@@ -42,13 +67,39 @@ FDMMGSolver3::FDMMGSolver3(size_t maxNumberOfLevels,
                     FDMGaussSeidelSolver3::RelaxRedBlack(A, b, sorFactor, x);
                 }
             };
-    }
-    else
-    {
-        m_mgParams.relaxFunc =
-            [sorFactor](const FDMMatrix3& A, const FDMVector3& b,
-                        unsigned int numberOfIterations, double _maxTolerance,
-                        FDMVector3* x, FDMVector3* buffer) {
+            break;
+
+        case MGSmootherType::Chebyshev:
+        {
+            // The relax function is copied around by value, so the scratch
+            // vectors are shared through pointers and resized per level.
+            const auto z = std::make_shared<FDMVector3>();
+            const auto d = std::make_shared<FDMVector3>();
+
+            m_mgParams.relaxFunc = [z, d](const FDMMatrix3& A,
+                                          const FDMVector3& b,
+                                          unsigned int numberOfIterations,
+                                          double _maxTolerance, FDMVector3* x,
+                                          FDMVector3* buffer) {
+                UNUSED_VARIABLE(_maxTolerance);
+                UNUSED_VARIABLE(buffer);
+
+                z->Resize(A.size());
+                d->Resize(A.size());
+
+                FDMChebyshevSmoother3::Relax(A, b, numberOfIterations, x,
+                                             z.get(), d.get());
+            };
+            break;
+        }
+
+        case MGSmootherType::GaussSeidel:
+            m_mgParams.relaxFunc = [sorFactor](const FDMMatrix3& A,
+                                               const FDMVector3& b,
+                                               unsigned int numberOfIterations,
+                                               double _maxTolerance,
+                                               FDMVector3* x,
+                                               FDMVector3* buffer) {
                 UNUSED_VARIABLE(_maxTolerance);
                 UNUSED_VARIABLE(buffer);
 
@@ -57,12 +108,16 @@ FDMMGSolver3::FDMMGSolver3(size_t maxNumberOfLevels,
                     FDMGaussSeidelSolver3::Relax(A, b, sorFactor, x);
                 }
             };
+            break;
     }
 
     m_mgParams.restrictFunc = FDMMGUtils3::Restrict;
     m_mgParams.correctFunc = FDMMGUtils3::Correct;
+    m_mgParams.restrictResidualFunc = FDMMGUtils3::RestrictResidual;
     m_sorFactor = sorFactor;
-    m_useRedBlackOrdering = useRedBlackOrdering;
+    m_useRedBlackOrdering =
+        (smootherType == MGSmootherType::RedBlackGaussSeidel);
+    m_smootherType = smootherType;
 }
 
 const MGParameters<FDMBLAS3>& FDMMGSolver3::GetParams() const
@@ -80,6 +135,11 @@ bool FDMMGSolver3::GetUseRedBlackOrdering() const
     return m_useRedBlackOrdering;
 }
 
+MGSmootherType FDMMGSolver3::GetSmootherType() const
+{
+    return m_smootherType;
+}
+
 bool FDMMGSolver3::Solve(FDMLinearSystem3* system)
 {
     UNUSED_VARIABLE(system);
@@ -89,6 +149,8 @@ bool FDMMGSolver3::Solve(FDMLinearSystem3* system)
 
 bool FDMMGSolver3::Solve(FDMMGLinearSystem3* system)
 {
+    CUBBYFLOW_PROFILE_ZONE("FDMMGSolver3::Solve");
+
     FDMMGVector3 buffer = system->x;
     const MGResult result =
         MGVCycle(system->A, m_mgParams, &system->x, &system->b, &buffer);
@@ -38,17 +38,24 @@ void GridBackwardEulerDiffusionSolver3::Solve(const ScalarGrid3& source,
     const Vector3D c = timeIntervalInSeconds * diffusionCoefficient / (h * h);
 
     BuildMarkers(source.GetDataSize(), pos, boundarySDF, fluidSDF);
-    BuildMatrix(source.GetDataSize(), c);
+
+    const bool reuseSystem = TryReuseSystem(source.GetDataSize(), c);
+    if (!reuseSystem)
+    {
+        BuildMatrix(source.GetDataSize(), c);
+    }
+
     BuildVectors(source.GetConstDataAccessor(), c);
 
     if (m_systemSolver != nullptr)
     {
         // Solve the system
-        m_systemSolver->Solve(&m_system);
+        SolveSystem(reuseSystem);
 
         // Assign the solution
+        auto destAcc = dest->GetDataAccessor();
         source.ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-            (*dest)(i, j, k) = m_system.x(i, j, k);
+            destAcc(i, j, k) = m_system.x(i, j, k);
         });
     }
 }
@@ -63,7 +70,12 @@ void GridBackwardEulerDiffusionSolver3::Solve(
     const Vector3D c = timeIntervalInSeconds * diffusionCoefficient / (h * h);
 
     BuildMarkers(source.GetDataSize(), pos, boundarySDF, fluidSDF);
-    BuildMatrix(source.GetDataSize(), c);
+
+    const bool reuseSystem = TryReuseSystem(source.GetDataSize(), c);
+    if (!reuseSystem)
+    {
+        BuildMatrix(source.GetDataSize(), c);
+    }
 
     // u
     BuildVectors(source.GetConstDataAccessor(), c, 0);
@@ -71,11 +83,12 @@ void GridBackwardEulerDiffusionSolver3::Solve(
     if (m_systemSolver != nullptr)
     {
         // Solve the system
-        m_systemSolver->Solve(&m_system);
+        SolveSystem(reuseSystem);
 
         // Assign the solution
+        auto destAcc = dest->GetDataAccessor();
         source.ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-            (*dest)(i, j, k).x = m_system.x(i, j, k);
+            destAcc(i, j, k).x = m_system.x(i, j, k);
         });
     }
 
@@ -84,12 +97,13 @@ void GridBackwardEulerDiffusionSolver3::Solve(
 
     if (m_systemSolver != nullptr)
     {
-        // Solve the system
-        m_systemSolver->Solve(&m_system);
+        // Solve the system (same matrix as the u component)
+        SolveSystem(true);
 
         // Assign the solution
+        auto destAcc = dest->GetDataAccessor();
         source.ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-            (*dest)(i, j, k).y = m_system.x(i, j, k);
+            destAcc(i, j, k).y = m_system.x(i, j, k);
         });
     }
 
@@ -98,12 +112,13 @@ void GridBackwardEulerDiffusionSolver3::Solve(
 
     if (m_systemSolver != nullptr)
     {
-        // Solve the system
-        m_systemSolver->Solve(&m_system);
+        // Solve the system (same matrix as the u component)
+        SolveSystem(true);
 
         // Assign the solution
+        auto destAcc = dest->GetDataAccessor();
         source.ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-            (*dest)(i, j, k).z = m_system.x(i, j, k);
+            destAcc(i, j, k).z = m_system.x(i, j, k);
         });
     }
 }
@@ -118,6 +133,10 @@ void GridBackwardEulerDiffusionSolver3::Solve(const FaceCenteredGrid3& source,
     const Vector3D& h = source.GridSpacing();
     const Vector3D c = timeIntervalInSeconds * diffusionCoefficient / (h * h);
 
+    // The three face components cycle different systems through m_system,
+    // so the assembled-system cache cannot be kept here.
+    m_systemCached = false;
+
     // u
     const auto uPos = source.GetUPosition();
     BuildMarkers(source.GetUSize(), uPos, boundarySDF, fluidSDF);
@@ -130,8 +149,9 @@ void GridBackwardEulerDiffusionSolver3::Solve(const FaceCenteredGrid3& source,
         m_systemSolver->Solve(&m_system);
 
         // Assign the solution
+        auto destAcc = dest->GetUAccessor();
         source.ParallelForEachUIndex([&](size_t i, size_t j, size_t k) {
-            dest->GetU(i, j, k) = m_system.x(i, j, k);
+            destAcc(i, j, k) = m_system.x(i, j, k);
         });
     }
 
@@ -147,8 +167,9 @@ void GridBackwardEulerDiffusionSolver3::Solve(const FaceCenteredGrid3& source,
         m_systemSolver->Solve(&m_system);
 
         // Assign the solution
+        auto destAcc = dest->GetVAccessor();
         source.ParallelForEachVIndex([&](size_t i, size_t j, size_t k) {
-            dest->GetV(i, j, k) = m_system.x(i, j, k);
+            destAcc(i, j, k) = m_system.x(i, j, k);
         });
     }
 
@@ -164,8 +185,9 @@ void GridBackwardEulerDiffusionSolver3::Solve(const FaceCenteredGrid3& source,
         m_systemSolver->Solve(&m_system);
 
         // Assign the solution
+        auto destAcc = dest->GetWAccessor();
         source.ParallelForEachWIndex([&](size_t i, size_t j, size_t k) {
-            dest->GetW(i, j, k) = m_system.x(i, j, k);
+            destAcc(i, j, k) = m_system.x(i, j, k);
         });
     }
 }
@@ -174,6 +196,49 @@ void GridBackwardEulerDiffusionSolver3::SetLinearSystemSolver(
     const FDMLinearSystemSolver3Ptr& Solver)
 {
     m_systemSolver = Solver;
+    m_systemCached = false;
+}
+
+bool GridBackwardEulerDiffusionSolver3::TryReuseSystem(const Size3& size,
+                                                       const Vector3D& c)
+{
+    // FNV-1a over the marker array; substeps with unchanged boundaries
+    // produce identical markers and therefore identical matrices.
+    size_t hash = static_cast<size_t>(14695981039346656037ULL);
+    for (const char marker : m_markers)
+    {
+        hash ^= static_cast<size_t>(static_cast<unsigned char>(marker));
+        hash *= static_cast<size_t>(1099511628211ULL);
+    }
+
+    const bool reusable = m_systemCached && size == m_cachedSize &&
+                          c == m_cachedC && hash == m_cachedMarkerHash;
+
+    m_cachedSize = size;
+    m_cachedC = c;
+    m_cachedMarkerHash = hash;
+    m_systemCached = true;
+
+    return reusable;
+}
+
+void GridBackwardEulerDiffusionSolver3::SolveSystem(bool matrixUnchanged)
+{
+    const auto iccg =
+        std::dynamic_pointer_cast<FDMICCGSolver3>(m_systemSolver);
+
+    if (iccg != nullptr)
+    {
+        const bool reuse = iccg->GetReusePreconditioner();
+
+        iccg->SetReusePreconditioner(matrixUnchanged);
+        iccg->Solve(&m_system);
+        iccg->SetReusePreconditioner(reuse);
+    }
+    else
+    {
+        m_systemSolver->Solve(&m_system);
+    }
 }
 
 void GridBackwardEulerDiffusionSolver3::BuildMarkers(
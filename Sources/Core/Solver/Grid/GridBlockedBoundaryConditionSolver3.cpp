@@ -86,6 +86,16 @@ void GridBlockedBoundaryConditionSolver3::OnColliderUpdated(
     GridFractionalBoundaryConditionSolver3::OnColliderUpdated(
         gridSize, gridSpacing, gridOrigin);
 
+    // The marker is derived from the rasterized collider SDF, so it only
+    // needs rebuilding when the SDF content changed (e.g. it stays put for
+    // static colliders with the SDF cache enabled).
+    if (m_marker.size() == gridSize &&
+        m_markerSDFVersion == GetColliderSDFVersion())
+    {
+        return;
+    }
+    m_markerSDFVersion = GetColliderSDFVersion();
+
     const auto sdf =
         std::dynamic_pointer_cast<CellCenteredScalarGrid3>(GetColliderSDF());
 
@@ -0,0 +1,164 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Field/CustomVectorField3.hpp>
+#include <Core/Solver/Grid/GridCascadeSolver3.hpp>
+
+#include <utility>
+
+namespace CubbyFlow
+{
+GridCascadeSolver3::GridCascadeSolver3(GridFluidSolver3Ptr coarseSolver,
+                                       GridFluidSolver3Ptr fineSolver)
+    : m_coarseSolver(std::move(coarseSolver)),
+      m_fineSolver(std::move(fineSolver))
+{
+    // Nothing to do
+}
+
+const GridFluidSolver3Ptr& GridCascadeSolver3::GetCoarseSolver() const
+{
+    return m_coarseSolver;
+}
+
+const GridFluidSolver3Ptr& GridCascadeSolver3::GetFineSolver() const
+{
+    return m_fineSolver;
+}
+
+bool GridCascadeSolver3::GetIsTwoWayCouplingEnabled() const
+{
+    return m_isTwoWayCouplingEnabled;
+}
+
+void GridCascadeSolver3::SetIsTwoWayCouplingEnabled(bool isEnabled)
+{
+    m_isTwoWayCouplingEnabled = isEnabled;
+}
+
+GridCascadeSolver3::Builder GridCascadeSolver3::GetBuilder()
+{
+    return Builder{};
+}
+
+void GridCascadeSolver3::OnUpdate(const Frame& frame)
+{
+    m_coarseSolver->Update(frame);
+
+    ApplyCoarseToFine();
+
+    m_fineSolver->Update(frame);
+
+    if (m_isTwoWayCouplingEnabled)
+    {
+        ApplyFineToCoarse();
+    }
+}
+
+void GridCascadeSolver3::ApplyCoarseToFine() const
+{
+    const FaceCenteredGrid3Ptr coarseVel = m_coarseSolver->GetVelocity();
+
+    // The sampler captures the coarse velocity data, which stays untouched
+    // while the fine solver advances; refresh the wrapper every frame so the
+    // fine boundary band always sees the latest coarse state.
+    m_fineSolver->SetBackgroundVelocityField(
+        std::make_shared<CustomVectorField3>(coarseVel->Sampler()));
+}
+
+void GridCascadeSolver3::ApplyFineToCoarse() const
+{
+    const FaceCenteredGrid3Ptr coarseVel = m_coarseSolver->GetVelocity();
+    const FaceCenteredGrid3Ptr fineVel = m_fineSolver->GetVelocity();
+
+    // Feed back only the interior of the fine domain. The blend band is
+    // excluded since it carries coarse data already.
+    const Vector3D fineSpacing = fineVel->GridSpacing();
+    const double bandWidth =
+        m_fineSolver->GetBackgroundBlendWidth() *
+        std::min(fineSpacing.x, std::min(fineSpacing.y, fineSpacing.z));
+
+    BoundingBox3D feedbackBox = fineVel->BoundingBox();
+    feedbackBox.lowerCorner += Vector3D{ bandWidth, bandWidth, bandWidth };
+    feedbackBox.upperCorner -= Vector3D{ bandWidth, bandWidth, bandWidth };
+
+    if (feedbackBox.lowerCorner.x >= feedbackBox.upperCorner.x ||
+        feedbackBox.lowerCorner.y >= feedbackBox.upperCorner.y ||
+        feedbackBox.lowerCorner.z >= feedbackBox.upperCorner.z)
+    {
+        return;
+    }
+
+    auto uPos = coarseVel->GetUPosition();
+    auto u = coarseVel->GetUAccessor();
+    coarseVel->ParallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D pt = uPos(i, j, k);
+
+        if (feedbackBox.Contains(pt))
+        {
+            u(i, j, k) = fineVel->Sample(pt).x;
+        }
+    });
+
+    auto vPos = coarseVel->GetVPosition();
+    auto v = coarseVel->GetVAccessor();
+    coarseVel->ParallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D pt = vPos(i, j, k);
+
+        if (feedbackBox.Contains(pt))
+        {
+            v(i, j, k) = fineVel->Sample(pt).y;
+        }
+    });
+
+    auto wPos = coarseVel->GetWPosition();
+    auto w = coarseVel->GetWAccessor();
+    coarseVel->ParallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D pt = wPos(i, j, k);
+
+        if (feedbackBox.Contains(pt))
+        {
+            w(i, j, k) = fineVel->Sample(pt).z;
+        }
+    });
+}
+
+GridCascadeSolver3::Builder& GridCascadeSolver3::Builder::WithCoarseSolver(
+    const GridFluidSolver3Ptr& coarseSolver)
+{
+    m_coarseSolver = coarseSolver;
+    return *this;
+}
+
+GridCascadeSolver3::Builder& GridCascadeSolver3::Builder::WithFineSolver(
+    const GridFluidSolver3Ptr& fineSolver)
+{
+    m_fineSolver = fineSolver;
+    return *this;
+}
+
+GridCascadeSolver3::Builder& GridCascadeSolver3::Builder::WithTwoWayCoupling(
+    bool isEnabled)
+{
+    m_isTwoWayCouplingEnabled = isEnabled;
+    return *this;
+}
+
+GridCascadeSolver3Ptr GridCascadeSolver3::Builder::MakeShared() const
+{
+    GridCascadeSolver3Ptr solver = std::shared_ptr<GridCascadeSolver3>(
+        new GridCascadeSolver3{ m_coarseSolver, m_fineSolver },
+        [](GridCascadeSolver3* obj) { delete obj; });
+
+    solver->SetIsTwoWayCouplingEnabled(m_isTwoWayCouplingEnabled);
+
+    return solver;
+}
+}  // namespace CubbyFlow
@@ -8,17 +8,153 @@
 // personal capacity and are not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <Core/Array/ArrayExpression3.hpp>
 #include <Core/Array/ArrayUtils.hpp>
+#include <Core/Grid/GridActiveRegion3.hpp>
+#include <Core/Math/MathUtils.hpp>
 #include <Core/Solver/Advection/CubicSemiLagrangian3.hpp>
 #include <Core/Solver/Grid/GridBackwardEulerDiffusionSolver3.hpp>
 #include <Core/Solver/Grid/GridFluidSolver3.hpp>
+#include <Core/Solver/Grid/GridForwardEulerDiffusionSolver3.hpp>
+#include <Core/Solver/Grid/GridFractionalBoundaryConditionSolver3.hpp>
 #include <Core/Solver/Grid/GridFractionalSinglePhasePressureSolver3.hpp>
+#include <Core/Utils/Constants.hpp>
 #include <Core/Utils/LevelSetUtils.hpp>
 #include <Core/Utils/Logging.hpp>
+#include <Core/Utils/Parallel.hpp>
+#include <Core/Utils/Profiler.hpp>
+#include <Core/Utils/TaskGraph.hpp>
 #include <Core/Utils/Timer.hpp>
 
+#include <random>
+
 namespace CubbyFlow
 {
+//! Secondary (whitewater) particle tuning constants. Emission thresholds are
+//! expressed in local CFL numbers and per-step divergence so they stay
+//! resolution- and time-step-independent; drags are rates in 1/seconds.
+constexpr size_t SECONDARY_MAX_EMISSION_PER_CELL = 8;
+constexpr double SECONDARY_MIN_CFL = 0.3;
+constexpr double SECONDARY_MIN_DIVERGENCE = 0.2;
+constexpr double SECONDARY_MIN_LIFETIME = 0.5;
+constexpr double SECONDARY_MAX_LIFETIME = 2.0;
+constexpr double SECONDARY_FLUID_DRAG = 8.0;
+constexpr double SECONDARY_AIR_DRAG = 1.0;
+
+//! Copies the data points of \p src into reused scratch grid \p dst.
+static void RefreshScratch(const FaceCenteredGrid3& src, FaceCenteredGrid3* dst)
+{
+    dst->Set(src);
+}
+
+//!
+//! \brief Narrow-band variant of ExtrapolateToRegion.
+//!
+//! This function gives the same result as ExtrapolateToRegion as long as
+//! \p band covers every invalid cell within \p numberOfIterations hops of a
+//! valid cell; cells outside the band cannot be reached by that many
+//! averaging passes and thus keep their input values either way. Only the
+//! cells in active tiles are visited per iteration, which skips most of the
+//! domain when the collider occupies a small fraction of it.
+//!
+template <typename T>
+static void ExtrapolateToRegionBanded(const ConstArrayAccessor3<T>& input,
+                                      const ConstArrayAccessor3<char>& valid,
+                                      unsigned int numberOfIterations,
+                                      ArrayAccessor3<T> output,
+                                      const GridActiveRegion3& band)
+{
+    const Size3 size = input.size();
+
+    assert(size == valid.size());
+    assert(size == output.size());
+
+    Array3<char> valid0(size);
+    Array3<char> valid1(size);
+
+    // Unlike the full-grid version, valid1 must also start from the input
+    // markers: valid cells outside the band are never visited, yet their
+    // flags have to survive the per-iteration swaps below.
+    valid0.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        valid0(i, j, k) = valid(i, j, k);
+        valid1(i, j, k) = valid(i, j, k);
+        output(i, j, k) = input(i, j, k);
+    });
+
+    for (unsigned int iter = 0; iter < numberOfIterations; ++iter)
+    {
+        band.ParallelForEachCellInActiveTiles(
+            [&](size_t i, size_t j, size_t k) {
+                T sum = Zero<T>();
+                unsigned int count = 0;
+
+                if (!valid0(i, j, k))
+                {
+                    if (i + 1 < size.x && valid0(i + 1, j, k))
+                    {
+                        sum += output(i + 1, j, k);
+                        ++count;
+                    }
+
+                    if (i > 0 && valid0(i - 1, j, k))
+                    {
+                        sum += output(i - 1, j, k);
+                        ++count;
+                    }
+
+                    if (j + 1 < size.y && valid0(i, j + 1, k))
+                    {
+                        sum += output(i, j + 1, k);
+                        ++count;
+                    }
+
+                    if (j > 0 && valid0(i, j - 1, k))
+                    {
+                        sum += output(i, j - 1, k);
+                        ++count;
+                    }
+
+                    if (k + 1 < size.z && valid0(i, j, k + 1))
+                    {
+                        sum += output(i, j, k + 1);
+                        ++count;
+                    }
+
+                    if (k > 0 && valid0(i, j, k - 1))
+                    {
+                        sum += output(i, j, k - 1);
+                        ++count;
+                    }
+
+                    if (count > 0)
+                    {
+                        output(i, j, k) =
+                            sum /
+                            static_cast<typename ScalarType<T>::value>(count);
+                        valid1(i, j, k) = 1;
+                    }
+                }
+                else
+                {
+                    valid1(i, j, k) = 1;
+                }
+            });
+
+        valid0.Swap(valid1);
+    }
+}
+
+template <typename GridType, typename PoolType>
+std::shared_ptr<GridType> GridFluidSolver3::AcquireScratchCopy(
+    PoolType& pool, const GridType& grid)
+{
+    std::shared_ptr<GridType> scratch = pool.Acquire(
+        [&grid]() { return std::dynamic_pointer_cast<GridType>(grid.Clone()); });
+
+    RefreshScratch(grid, scratch.get());
+    return scratch;
+}
+
 GridFluidSolver3::GridFluidSolver3()
     : GridFluidSolver3{ { 1, 1, 1 }, { 1, 1, 1 }, { 0, 0, 0 } }
 {
@@ -61,14 +197,17 @@ void GridFluidSolver3::SetViscosityCoefficient(double newValue)
 
 double GridFluidSolver3::GetCFL(double timeIntervalInSeconds) const
 {
-    FaceCenteredGrid3Ptr vel = m_grids->GetVelocity();
-    double maxVel = 0.0;
+    if (m_grids->GetVelocity()->GetDataVersion() != m_maxVelocityVersion)
+    {
+        RefreshMaxVelocityComponents();
+    }
 
-    vel->ForEachCellIndex([&](size_t i, size_t j, size_t k) {
-        const Vector3D v =
-            vel->ValueAtCellCenter(i, j, k) + timeIntervalInSeconds * m_gravity;
-        maxVel = std::max(maxVel, v.Max());
-    });
+    // Adding the constant gravity term per component commutes with taking
+    // the maximum over cells, so the cached component maxima reproduce the
+    // full-grid scan exactly for any time interval.
+    const Vector3D v =
+        m_maxVelocityComponents + timeIntervalInSeconds * m_gravity;
+    const double maxVel = std::max(v.Max(), 0.0);
 
     const Vector3D gridSpacing = m_grids->GetGridSpacing();
     const double minGridSize = gridSpacing.Min();
@@ -76,6 +215,37 @@ double GridFluidSolver3::GetCFL(double timeIntervalInSeconds) const
     return maxVel * timeIntervalInSeconds / minGridSize;
 }
 
+void GridFluidSolver3::RefreshMaxVelocityComponents() const
+{
+    FaceCenteredGrid3Ptr vel = m_grids->GetVelocity();
+    const Size3 res = m_grids->GetResolution();
+    constexpr double lowest = std::numeric_limits<double>::lowest();
+
+    // Slabs of z act as the tiles: each worker folds its slab serially and
+    // the per-slab maxima meet in a small final reduction.
+    m_maxVelocityComponents = ParallelReduce(
+        ZERO_SIZE, res.z, Vector3D{ lowest, lowest, lowest },
+        [&](size_t beginK, size_t endK, const Vector3D& init) {
+            Vector3D result = init;
+
+            for (size_t k = beginK; k < endK; ++k)
+            {
+                for (size_t j = 0; j < res.y; ++j)
+                {
+                    for (size_t i = 0; i < res.x; ++i)
+                    {
+                        result = Max(result, vel->ValueAtCellCenter(i, j, k));
+                    }
+                }
+            }
+
+            return result;
+        },
+        [](const Vector3D& a, const Vector3D& b) { return Max(a, b); });
+
+    m_maxVelocityVersion = vel->GetDataVersion();
+}
+
 double GridFluidSolver3::GetMaxCFL() const
 {
     return m_maxCFL;
@@ -96,6 +266,26 @@ void GridFluidSolver3::SetUseCompressedLinearSystem(bool isOn)
     m_useCompressedLinearSys = isOn;
 }
 
+bool GridFluidSolver3::GetUseColliderSDFCache() const
+{
+    return m_useColliderSDFCache;
+}
+
+void GridFluidSolver3::SetUseColliderSDFCache(bool isOn)
+{
+    m_useColliderSDFCache = isOn;
+}
+
+bool GridFluidSolver3::GetUseAsyncEmitterUpdate() const
+{
+    return m_useAsyncEmitterUpdate;
+}
+
+void GridFluidSolver3::SetUseAsyncEmitterUpdate(bool isOn)
+{
+    m_useAsyncEmitterUpdate = isOn;
+}
+
 const AdvectionSolver3Ptr& GridFluidSolver3::GetAdvectionSolver() const
 {
     return m_advectionSolver;
@@ -149,6 +339,26 @@ void GridFluidSolver3::SetClosedDomainBoundaryFlag(int flag)
         m_closedDomainBoundaryFlag);
 }
 
+const VectorField3Ptr& GridFluidSolver3::GetBackgroundVelocityField() const
+{
+    return m_backgroundVelocityField;
+}
+
+void GridFluidSolver3::SetBackgroundVelocityField(const VectorField3Ptr& field)
+{
+    m_backgroundVelocityField = field;
+}
+
+unsigned int GridFluidSolver3::GetBackgroundBlendWidth() const
+{
+    return m_backgroundBlendWidth;
+}
+
+void GridFluidSolver3::SetBackgroundBlendWidth(unsigned int numCells)
+{
+    m_backgroundBlendWidth = numCells;
+}
+
 const GridSystemData3Ptr& GridFluidSolver3::GetGridSystemData() const
 {
     return m_grids;
@@ -159,6 +369,11 @@ void GridFluidSolver3::ResizeGrid(const Size3& newSize,
                                   const Vector3D& newGridOrigin) const
 {
     m_grids->Resize(newSize, newGridSpacing, newGridOrigin);
+
+    // Pooled scratch grids no longer match the new resolution. The shadow
+    // buffers are invalidated by GridSystemData3::Resize itself.
+    m_velocityScratch.Clear();
+    m_maxVelocityVersion = 0;
 }
 
 Size3 GridFluidSolver3::GetResolution() const
@@ -201,6 +416,31 @@ void GridFluidSolver3::SetEmitter(const GridEmitter3Ptr& newEmitter)
     m_emitter = newEmitter;
 }
 
+bool GridFluidSolver3::GetIsSecondaryParticlesEnabled() const
+{
+    return m_isSecondaryParticlesEnabled;
+}
+
+void GridFluidSolver3::SetIsSecondaryParticlesEnabled(bool isEnabled)
+{
+    m_isSecondaryParticlesEnabled = isEnabled;
+}
+
+ParticleSystemData3Ptr GridFluidSolver3::GetSecondaryParticles() const
+{
+    return m_secondaryParticles;
+}
+
+size_t GridFluidSolver3::GetMaxNumberOfSecondaryParticles() const
+{
+    return m_maxNumberOfSecondaryParticles;
+}
+
+void GridFluidSolver3::SetMaxNumberOfSecondaryParticles(size_t maxNumber)
+{
+    m_maxNumberOfSecondaryParticles = maxNumber;
+}
+
 void GridFluidSolver3::OnInitialize()
 {
     // When initializing the solver, update the collider and emitter state as
@@ -216,8 +456,44 @@ void GridFluidSolver3::OnInitialize()
                    << " seconds";
 }
 
+void GridFluidSolver3::OnSaveCheckpoint(Checkpoint* checkpoint) const
+{
+    PhysicsAnimation::OnSaveCheckpoint(checkpoint);
+
+    std::vector<uint8_t> buffer;
+    m_grids->Serialize(&buffer);
+    checkpoint->Set("gridSystemData", std::move(buffer));
+}
+
+bool GridFluidSolver3::OnLoadCheckpoint(const Checkpoint& checkpoint)
+{
+    if (!PhysicsAnimation::OnLoadCheckpoint(checkpoint))
+    {
+        return false;
+    }
+
+    const std::vector<uint8_t>* buffer = checkpoint.Get("gridSystemData");
+    if (buffer == nullptr)
+    {
+        return false;
+    }
+
+    m_grids->Deserialize(*buffer);
+
+    // Cached boundary state belongs to the interrupted run.
+    m_lastSubTimeStepSize = 0.0;
+    m_lastColliderSDFVersion = 0;
+    m_hasLastColliderBounds = false;
+    m_velocityScratch.Clear();
+    m_maxVelocityVersion = 0;
+
+    return true;
+}
+
 void GridFluidSolver3::OnAdvanceTimeStep(double timeIntervalInSeconds)
 {
+    CUBBYFLOW_PROFILE_ZONE("GridFluidSolver3::OnAdvanceTimeStep");
+
     // The minimum grid resolution is 1x1.
     if (m_grids->GetResolution().x == 0 || m_grids->GetResolution().y == 0 ||
         m_grids->GetResolution().z == 0)
@@ -226,6 +502,15 @@ void GridFluidSolver3::OnAdvanceTimeStep(double timeIntervalInSeconds)
         return;
     }
 
+    // Make the scratch grids cached during the previous substep available
+    // again so the steady-state loop stays allocation-free.
+    m_velocityScratch.Reset();
+
+    if (m_grids->HasTileChangeListener())
+    {
+        m_grids->CaptureTileSnapshot();
+    }
+
     BeginAdvanceTimeStep(timeIntervalInSeconds);
 
     Timer timer;
@@ -248,15 +533,57 @@ void GridFluidSolver3::OnAdvanceTimeStep(double timeIntervalInSeconds)
     CUBBYFLOW_INFO << "Computing advection force took "
                    << timer.DurationInSeconds() << " seconds";
 
+    if (m_isSecondaryParticlesEnabled)
+    {
+        timer.Reset();
+        UpdateSecondaryParticles(timeIntervalInSeconds);
+        CUBBYFLOW_INFO << "Updating secondary particles took "
+                       << timer.DurationInSeconds() << " seconds";
+    }
+
     EndAdvanceTimeStep(timeIntervalInSeconds);
+
+    if (m_grids->HasTileChangeListener())
+    {
+        m_grids->EmitTileChangeEvents();
+    }
 }
 
 unsigned int GridFluidSolver3::GetNumberOfSubTimeSteps(
     double timeIntervalInSeconds) const
 {
     const double currentCFL = GetCFL(timeIntervalInSeconds);
-    return static_cast<unsigned int>(
-        std::max(std::ceil(currentCFL / m_maxCFL), 1.0));
+    double numSteps = std::max(std::ceil(currentCFL / m_maxCFL), 1.0);
+
+    // Explicit diffusion has its own stability limit dt <= h^2 / (6 * nu)
+    if (m_viscosityCoefficient > 0.0 &&
+        std::dynamic_pointer_cast<GridForwardEulerDiffusionSolver3>(
+            m_diffusionSolver) != nullptr)
+    {
+        const Vector3D gridSpacing = GetGridSpacing();
+        const double h =
+            std::min({ gridSpacing.x, gridSpacing.y, gridSpacing.z });
+        const double stableDiffusionDt =
+            h * h / (6.0 * m_viscosityCoefficient);
+
+        numSteps = std::max(
+            numSteps, std::ceil(timeIntervalInSeconds / stableDiffusionDt));
+    }
+
+    // Hysteresis: contract immediately, but let the sub-time-step grow by at
+    // most 50% per step so a brief velocity dip does not flip the step size
+    // back and forth
+    const double candidateDt = timeIntervalInSeconds / numSteps;
+    if (m_lastSubTimeStepSize > 0.0 &&
+        candidateDt > 1.5 * m_lastSubTimeStepSize)
+    {
+        numSteps = std::ceil(timeIntervalInSeconds /
+                             (1.5 * m_lastSubTimeStepSize));
+    }
+
+    m_lastSubTimeStepSize = timeIntervalInSeconds / numSteps;
+
+    return static_cast<unsigned int>(numSteps);
 }
 
 void GridFluidSolver3::OnBeginAdvanceTimeStep(double timeIntervalInSeconds)
@@ -271,17 +598,27 @@ void GridFluidSolver3::OnEndAdvanceTimeStep(double timeIntervalInSeconds)
 
 void GridFluidSolver3::ComputeExternalForces(double timeIntervalInSeconds)
 {
+    CUBBYFLOW_PROFILE_ZONE("GridFluidSolver3::ComputeExternalForces");
+
     ComputeGravity(timeIntervalInSeconds);
 }
 
 void GridFluidSolver3::ComputeViscosity(double timeIntervalInSeconds)
 {
+    CUBBYFLOW_PROFILE_ZONE("GridFluidSolver3::ComputeViscosity");
+
     if (m_diffusionSolver != nullptr &&
         m_viscosityCoefficient > std::numeric_limits<double>::epsilon())
     {
+        // Same double-buffer flip as ComputeAdvection: the diffusion solvers
+        // assign every face of the destination, so the stale shadow can serve
+        // as the source without a copy.
         const FaceCenteredGrid3Ptr vel = GetVelocity();
         const std::shared_ptr<FaceCenteredGrid3> vel0 =
-            std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->Clone());
+            std::dynamic_pointer_cast<FaceCenteredGrid3>(
+                m_grids->GetAdvectableVectorShadowAt(
+                    m_grids->GetVelocityIndex()));
+        vel->Swap(vel0.get());
 
         m_diffusionSolver->Solve(*vel0, m_viscosityCoefficient,
                                  timeIntervalInSeconds, vel.get(),
@@ -292,11 +629,67 @@ void GridFluidSolver3::ComputeViscosity(double timeIntervalInSeconds)
 
 void GridFluidSolver3::ComputePressure(double timeIntervalInSeconds)
 {
+    CUBBYFLOW_PROFILE_ZONE("GridFluidSolver3::ComputePressure");
+
     if (m_pressureSolver != nullptr)
     {
+        // Keep the fractional pressure solver's boundary weight cache in sync
+        // with the collider SDF rasterization.
+        if (const auto fractionalP = std::dynamic_pointer_cast<
+                GridFractionalSinglePhasePressureSolver3>(m_pressureSolver))
+        {
+            fractionalP->SetUseWeightCache(m_useColliderSDFCache);
+
+            if (const auto fractionalBC = std::dynamic_pointer_cast<
+                    GridFractionalBoundaryConditionSolver3>(
+                    m_boundaryConditionSolver))
+            {
+                if (fractionalBC->GetColliderSDFVersion() !=
+                    m_lastColliderSDFVersion)
+                {
+                    // When a bounded collider moved, only the weights near
+                    // its previous and current bounds can change; invalidate
+                    // just that region instead of the whole cache.
+                    bool partial = false;
+                    const Collider3Ptr& collider = GetCollider();
+
+                    if (collider != nullptr &&
+                        collider->GetSurface() != nullptr &&
+                        collider->GetSurface()->IsBounded())
+                    {
+                        const BoundingBox3D bounds =
+                            collider->GetSurface()->BoundingBox();
+
+                        if (m_hasLastColliderBounds)
+                        {
+                            BoundingBox3D dirty = bounds;
+                            dirty.Merge(m_lastColliderBounds);
+                            fractionalP->InvalidateWeightCacheInRegion(dirty);
+                            partial = true;
+                        }
+
+                        m_lastColliderBounds = bounds;
+                        m_hasLastColliderBounds = true;
+                    }
+                    else
+                    {
+                        m_hasLastColliderBounds = false;
+                    }
+
+                    if (!partial)
+                    {
+                        fractionalP->InvalidateWeightCache();
+                    }
+
+                    m_lastColliderSDFVersion =
+                        fractionalBC->GetColliderSDFVersion();
+                }
+            }
+        }
+
         const FaceCenteredGrid3Ptr vel = GetVelocity();
         const std::shared_ptr<FaceCenteredGrid3> vel0 =
-            std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->Clone());
+            AcquireScratchCopy(m_velocityScratch, *vel);
 
         m_pressureSolver->Solve(*vel0, timeIntervalInSeconds, vel.get(),
                                 *GetColliderSDF(), *GetColliderVelocityField(),
@@ -307,26 +700,56 @@ void GridFluidSolver3::ComputePressure(double timeIntervalInSeconds)
 
 void GridFluidSolver3::ComputeAdvection(double timeIntervalInSeconds)
 {
+    CUBBYFLOW_PROFILE_ZONE("GridFluidSolver3::ComputeAdvection");
+
     const FaceCenteredGrid3Ptr vel = GetVelocity();
 
     if (m_advectionSolver != nullptr)
     {
+        // Each quantity is double-buffered: swapping the live grid with its
+        // shadow buffer turns the stale shadow into the advection source, and
+        // the solver writes every output sample back into the live grid. This
+        // replaces the deep source copy the old clone-based scheme made per
+        // quantity per substep.
+        //
+        // Every buffer is swapped up front - including the velocity - so each
+        // advection only reads the velocity shadow (the pre-advection
+        // velocity) and its own shadow, and only writes its own grid. The
+        // stages are therefore independent and run concurrently through a
+        // task graph instead of back to back.
+        const size_t velIdx = m_grids->GetVelocityIndex();
+        const std::shared_ptr<FaceCenteredGrid3> velShadow =
+            std::dynamic_pointer_cast<FaceCenteredGrid3>(
+                m_grids->GetAdvectableVectorShadowAt(velIdx));
+        vel->Swap(velShadow.get());
+
+        TaskGraph graph;
+
         // Solve advections for custom scalar fields.
         size_t n = m_grids->GetNumberOfAdvectableScalarData();
+        const ScalarField3Ptr scalarBoundary = GetScalarAdvectionBoundary();
 
         for (size_t i = 0; i < n; ++i)
         {
             ScalarGrid3Ptr grid = m_grids->GetAdvectableScalarDataAt(i);
-            std::shared_ptr<ScalarGrid3> grid0 = grid->Clone();
-
-            m_advectionSolver->Advect(*grid0, *vel, timeIntervalInSeconds,
-                                      grid.get(), *GetColliderSDF());
-            ExtrapolateIntoCollider(grid.get());
+            const ScalarGrid3Ptr& shadow =
+                m_grids->GetAdvectableScalarShadowAt(i);
+            grid->Swap(shadow.get());
+
+            graph.AddTask(
+                [this, grid, shadow, velShadow, scalarBoundary,
+                 timeIntervalInSeconds]() {
+                    m_advectionSolver->Advect(*shadow, *velShadow,
+                                              timeIntervalInSeconds,
+                                              grid.get(), *scalarBoundary);
+                    ExtrapolateIntoCollider(grid.get());
+                },
+                { velShadow.get(), shadow.get() }, { grid.get() });
         }
 
         // Solve advections for custom vector fields.
         n = m_grids->GetNumberOfAdvectableVectorData();
-        const size_t velIdx = m_grids->GetVelocityIndex();
+        const ScalarField3Ptr colliderSDF = GetColliderSDF();
 
         for (size_t i = 0; i < n; ++i)
         {
@@ -337,42 +760,61 @@ void GridFluidSolver3::ComputeAdvection(double timeIntervalInSeconds)
             }
 
             VectorGrid3Ptr grid = m_grids->GetAdvectableVectorDataAt(i);
-            std::shared_ptr<VectorGrid3> grid0 = grid->Clone();
 
             std::shared_ptr<CollocatedVectorGrid3> collocated =
                 std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid);
-            std::shared_ptr<CollocatedVectorGrid3> collocated0 =
-                std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid0);
 
             if (collocated != nullptr)
             {
-                m_advectionSolver->Advect(*collocated0, *vel,
-                                          timeIntervalInSeconds,
-                                          collocated.get(), *GetColliderSDF());
-                ExtrapolateIntoCollider(collocated.get());
+                const std::shared_ptr<CollocatedVectorGrid3> shadow =
+                    std::dynamic_pointer_cast<CollocatedVectorGrid3>(
+                        m_grids->GetAdvectableVectorShadowAt(i));
+                collocated->Swap(shadow.get());
+
+                graph.AddTask(
+                    [this, collocated, shadow, velShadow, colliderSDF,
+                     timeIntervalInSeconds]() {
+                        m_advectionSolver->Advect(
+                            *shadow, *velShadow, timeIntervalInSeconds,
+                            collocated.get(), *colliderSDF);
+                        ExtrapolateIntoCollider(collocated.get());
+                    },
+                    { velShadow.get(), shadow.get() }, { collocated.get() });
                 continue;
             }
 
             std::shared_ptr<FaceCenteredGrid3> faceCentered =
                 std::dynamic_pointer_cast<FaceCenteredGrid3>(grid);
-            std::shared_ptr<FaceCenteredGrid3> faceCentered0 =
-                std::dynamic_pointer_cast<FaceCenteredGrid3>(grid0);
 
-            if (faceCentered != nullptr && faceCentered0 != nullptr)
+            if (faceCentered != nullptr)
             {
-                m_advectionSolver->Advect(
-                    *faceCentered0, *vel, timeIntervalInSeconds,
-                    faceCentered.get(), *GetColliderSDF());
-                ExtrapolateIntoCollider(faceCentered.get());
+                const std::shared_ptr<FaceCenteredGrid3> shadow =
+                    std::dynamic_pointer_cast<FaceCenteredGrid3>(
+                        m_grids->GetAdvectableVectorShadowAt(i));
+                faceCentered->Swap(shadow.get());
+
+                graph.AddTask(
+                    [this, faceCentered, shadow, velShadow, colliderSDF,
+                     timeIntervalInSeconds]() {
+                        m_advectionSolver->Advect(
+                            *shadow, *velShadow, timeIntervalInSeconds,
+                            faceCentered.get(), *colliderSDF);
+                        ExtrapolateIntoCollider(faceCentered.get());
+                    },
+                    { velShadow.get(), shadow.get() }, { faceCentered.get() });
             }
         }
 
         // Solve velocity advection
-        const std::shared_ptr<FaceCenteredGrid3> vel0 =
-            std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->Clone());
-
-        m_advectionSolver->Advect(*vel0, *vel0, timeIntervalInSeconds,
-                                  vel.get(), *GetColliderSDF());
+        graph.AddTask(
+            [this, vel, velShadow, colliderSDF, timeIntervalInSeconds]() {
+                m_advectionSolver->Advect(*velShadow, *velShadow,
+                                          timeIntervalInSeconds, vel.get(),
+                                          *colliderSDF);
+            },
+            { velShadow.get() }, { vel.get() });
+
+        graph.Run();
         ApplyBoundaryCondition();
     }
 }
@@ -383,34 +825,38 @@ ScalarField3Ptr GridFluidSolver3::GetFluidSDF() const
         -std::numeric_limits<double>::max());
 }
 
+ScalarField3Ptr GridFluidSolver3::GetScalarAdvectionBoundary() const
+{
+    return GetColliderSDF();
+}
+
 void GridFluidSolver3::ComputeGravity(double timeIntervalInSeconds)
 {
     if (m_gravity.LengthSquared() > std::numeric_limits<double>::epsilon())
     {
         FaceCenteredGrid3Ptr vel = m_grids->GetVelocity();
-        ArrayAccessor3<double> u = vel->GetUAccessor();
-        ArrayAccessor3<double> v = vel->GetVAccessor();
-        ArrayAccessor3<double> w = vel->GetWAccessor();
 
+        // u = u + dt * g; the expression fuses into a single parallel pass
+        // per velocity component.
         if (std::abs(m_gravity.x) > std::numeric_limits<double>::epsilon())
         {
-            vel->ForEachUIndex([&](size_t i, size_t j, size_t k) {
-                u(i, j, k) += timeIntervalInSeconds * m_gravity.x;
-            });
+            ParallelEvaluate(ArrayInput3<double>{ vel->GetUConstAccessor() } +
+                                 timeIntervalInSeconds * m_gravity.x,
+                             vel->GetUAccessor());
         }
 
         if (std::abs(m_gravity.y) > std::numeric_limits<double>::epsilon())
         {
-            vel->ForEachVIndex([&](size_t i, size_t j, size_t k) {
-                v(i, j, k) += timeIntervalInSeconds * m_gravity.y;
-            });
+            ParallelEvaluate(ArrayInput3<double>{ vel->GetVConstAccessor() } +
+                                 timeIntervalInSeconds * m_gravity.y,
+                             vel->GetVAccessor());
         }
 
         if (std::abs(m_gravity.z) > std::numeric_limits<double>::epsilon())
         {
-            vel->ForEachWIndex([&](size_t i, size_t j, size_t k) {
-                w(i, j, k) += timeIntervalInSeconds * m_gravity.z;
-            });
+            ParallelEvaluate(ArrayInput3<double>{ vel->GetWConstAccessor() } +
+                                 timeIntervalInSeconds * m_gravity.z,
+                             vel->GetWAccessor());
         }
 
         ApplyBoundaryCondition();
@@ -426,15 +872,90 @@ void GridFluidSolver3::ApplyBoundaryCondition() const
         const auto depth = static_cast<unsigned int>(std::ceil(m_maxCFL));
         m_boundaryConditionSolver->ConstrainVelocity(vel.get(), depth);
     }
+
+    if (vel != nullptr && m_backgroundVelocityField != nullptr)
+    {
+        BlendWithBackgroundVelocity();
+    }
+}
+
+void GridFluidSolver3::BlendWithBackgroundVelocity() const
+{
+    const FaceCenteredGrid3Ptr vel = m_grids->GetVelocity();
+    const BoundingBox3D domain = vel->BoundingBox();
+    const Vector3D gridSpacing = vel->GridSpacing();
+    const double bandWidth =
+        m_backgroundBlendWidth *
+        std::min(gridSpacing.x, std::min(gridSpacing.y, gridSpacing.z));
+
+    if (bandWidth <= 0.0)
+    {
+        return;
+    }
+
+    const VectorField3* background = m_backgroundVelocityField.get();
+
+    // Weight is one at the domain boundary and falls off linearly to zero
+    // at the inner edge of the blend band.
+    const auto weight = [&domain, bandWidth](const Vector3D& pt) {
+        const double distX =
+            std::min(pt.x - domain.lowerCorner.x, domain.upperCorner.x - pt.x);
+        const double distY =
+            std::min(pt.y - domain.lowerCorner.y, domain.upperCorner.y - pt.y);
+        const double distZ =
+            std::min(pt.z - domain.lowerCorner.z, domain.upperCorner.z - pt.z);
+        const double dist = std::min(distX, std::min(distY, distZ));
+
+        return 1.0 - Clamp(dist / bandWidth, 0.0, 1.0);
+    };
+
+    auto uPos = vel->GetUPosition();
+    auto u = vel->GetUAccessor();
+    vel->ParallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D pt = uPos(i, j, k);
+        const double blend = weight(pt);
+
+        if (blend > 0.0)
+        {
+            u(i, j, k) = Lerp(u(i, j, k), background->Sample(pt).x, blend);
+        }
+    });
+
+    auto vPos = vel->GetVPosition();
+    auto v = vel->GetVAccessor();
+    vel->ParallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D pt = vPos(i, j, k);
+        const double blend = weight(pt);
+
+        if (blend > 0.0)
+        {
+            v(i, j, k) = Lerp(v(i, j, k), background->Sample(pt).y, blend);
+        }
+    });
+
+    auto wPos = vel->GetWPosition();
+    auto w = vel->GetWAccessor();
+    vel->ParallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D pt = wPos(i, j, k);
+        const double blend = weight(pt);
+
+        if (blend > 0.0)
+        {
+            w(i, j, k) = Lerp(w(i, j, k), background->Sample(pt).z, blend);
+        }
+    });
 }
 
 void GridFluidSolver3::ExtrapolateIntoCollider(ScalarGrid3* grid)
 {
     Array3<char> marker(grid->GetDataSize());
+    Array3<double> colliderPhi(grid->GetDataSize());
     auto pos = grid->GetDataPosition();
 
     marker.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (IsInsideSDF(GetColliderSDF()->Sample(pos(i, j, k))))
+        colliderPhi(i, j, k) = GetColliderSDF()->Sample(pos(i, j, k));
+
+        if (IsInsideSDF(colliderPhi(i, j, k)))
         {
             marker(i, j, k) = 0;
         }
@@ -445,17 +966,27 @@ void GridFluidSolver3::ExtrapolateIntoCollider(ScalarGrid3* grid)
     });
 
     const auto depth = static_cast<unsigned int>(std::ceil(m_maxCFL));
-    ExtrapolateToRegion(grid->GetConstDataAccessor(), marker, depth,
-                        grid->GetDataAccessor());
+
+    // Only cells within `depth` hops of the collider surface can change.
+    GridActiveRegion3 band;
+    band.BuildNarrowBand(colliderPhi.ConstAccessor(),
+                         (depth + 1) * grid->GridSpacing().Max());
+    band.AddHalo();
+
+    ExtrapolateToRegionBanded(grid->GetConstDataAccessor(), marker, depth,
+                              grid->GetDataAccessor(), band);
 }
 
 void GridFluidSolver3::ExtrapolateIntoCollider(CollocatedVectorGrid3* grid)
 {
     Array3<char> marker(grid->GetDataSize());
+    Array3<double> colliderPhi(grid->GetDataSize());
     auto pos = grid->GetDataPosition();
 
     marker.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (IsInsideSDF(GetColliderSDF()->Sample(pos(i, j, k))))
+        colliderPhi(i, j, k) = GetColliderSDF()->Sample(pos(i, j, k));
+
+        if (IsInsideSDF(colliderPhi(i, j, k)))
         {
             marker(i, j, k) = 0;
         }
@@ -466,8 +997,14 @@ void GridFluidSolver3::ExtrapolateIntoCollider(CollocatedVectorGrid3* grid)
     });
 
     const auto depth = static_cast<unsigned int>(std::ceil(m_maxCFL));
-    ExtrapolateToRegion(grid->GetConstDataAccessor(), marker, depth,
-                        grid->GetDataAccessor());
+
+    GridActiveRegion3 band;
+    band.BuildNarrowBand(colliderPhi.ConstAccessor(),
+                         (depth + 1) * grid->GridSpacing().Max());
+    band.AddHalo();
+
+    ExtrapolateToRegionBanded(grid->GetConstDataAccessor(), marker, depth,
+                              grid->GetDataAccessor(), band);
 }
 
 void GridFluidSolver3::ExtrapolateIntoCollider(FaceCenteredGrid3* grid)
@@ -484,8 +1021,14 @@ void GridFluidSolver3::ExtrapolateIntoCollider(FaceCenteredGrid3* grid)
     Array3<char> vMarker{ v.size() };
     Array3<char> wMarker{ w.size() };
 
+    Array3<double> uPhi{ u.size() };
+    Array3<double> vPhi{ v.size() };
+    Array3<double> wPhi{ w.size() };
+
     uMarker.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (IsInsideSDF(GetColliderSDF()->Sample(uPos(i, j, k))))
+        uPhi(i, j, k) = GetColliderSDF()->Sample(uPos(i, j, k));
+
+        if (IsInsideSDF(uPhi(i, j, k)))
         {
             uMarker(i, j, k) = 0;
         }
@@ -496,7 +1039,9 @@ void GridFluidSolver3::ExtrapolateIntoCollider(FaceCenteredGrid3* grid)
     });
 
     vMarker.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (IsInsideSDF(GetColliderSDF()->Sample(vPos(i, j, k))))
+        vPhi(i, j, k) = GetColliderSDF()->Sample(vPos(i, j, k));
+
+        if (IsInsideSDF(vPhi(i, j, k)))
         {
             vMarker(i, j, k) = 0;
         }
@@ -507,7 +1052,9 @@ void GridFluidSolver3::ExtrapolateIntoCollider(FaceCenteredGrid3* grid)
     });
 
     wMarker.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (IsInsideSDF(GetColliderSDF()->Sample(wPos(i, j, k))))
+        wPhi(i, j, k) = GetColliderSDF()->Sample(wPos(i, j, k));
+
+        if (IsInsideSDF(wPhi(i, j, k)))
         {
             wMarker(i, j, k) = 0;
         }
@@ -518,9 +1065,22 @@ void GridFluidSolver3::ExtrapolateIntoCollider(FaceCenteredGrid3* grid)
     });
 
     const auto depth = static_cast<unsigned int>(std::ceil(m_maxCFL));
-    ExtrapolateToRegion(grid->GetUConstAccessor(), uMarker, depth, u);
-    ExtrapolateToRegion(grid->GetVConstAccessor(), vMarker, depth, v);
-    ExtrapolateToRegion(grid->GetWConstAccessor(), wMarker, depth, w);
+    const double bandWidth = (depth + 1) * grid->GridSpacing().Max();
+
+    GridActiveRegion3 uBand, vBand, wBand;
+    uBand.BuildNarrowBand(uPhi.ConstAccessor(), bandWidth);
+    uBand.AddHalo();
+    vBand.BuildNarrowBand(vPhi.ConstAccessor(), bandWidth);
+    vBand.AddHalo();
+    wBand.BuildNarrowBand(wPhi.ConstAccessor(), bandWidth);
+    wBand.AddHalo();
+
+    ExtrapolateToRegionBanded(grid->GetUConstAccessor(), uMarker, depth, u,
+                              uBand);
+    ExtrapolateToRegionBanded(grid->GetVConstAccessor(), vMarker, depth, v,
+                              vBand);
+    ExtrapolateToRegionBanded(grid->GetWConstAccessor(), wMarker, depth, w,
+                              wBand);
 }
 
 ScalarField3Ptr GridFluidSolver3::GetColliderSDF() const
@@ -535,20 +1095,41 @@ VectorField3Ptr GridFluidSolver3::GetColliderVelocityField() const
 
 void GridFluidSolver3::BeginAdvanceTimeStep(double timeIntervalInSeconds)
 {
-    // Update collider and emitter
+    // Update collider and emitter. When requested, the emitter update runs
+    // on a worker thread so its source SDF evaluation overlaps the collider
+    // update and the boundary condition pass below; it is joined before the
+    // begin-step stage callback which may read the emitted fields.
     Timer timer;
+    if (m_useAsyncEmitterUpdate && m_emitter != nullptr)
+    {
+        m_emitterUpdateFuture =
+            std::async(std::launch::async, [this, timeIntervalInSeconds]() {
+                UpdateEmitter(timeIntervalInSeconds);
+            });
+    }
+
     UpdateCollider(timeIntervalInSeconds);
     CUBBYFLOW_INFO << "Update collider took " << timer.DurationInSeconds()
                    << " seconds";
 
-    timer.Reset();
-    UpdateEmitter(timeIntervalInSeconds);
-    CUBBYFLOW_INFO << "Update emitter took " << timer.DurationInSeconds()
-                   << " seconds";
+    if (!m_emitterUpdateFuture.valid())
+    {
+        timer.Reset();
+        UpdateEmitter(timeIntervalInSeconds);
+        CUBBYFLOW_INFO << "Update emitter took " << timer.DurationInSeconds()
+                       << " seconds";
+    }
 
     // Update boundary condition solver
     if (m_boundaryConditionSolver != nullptr)
     {
+        if (const auto fractionalBC =
+                std::dynamic_pointer_cast<GridFractionalBoundaryConditionSolver3>(
+                    m_boundaryConditionSolver))
+        {
+            fractionalBC->SetUseColliderSDFCache(m_useColliderSDFCache);
+        }
+
         m_boundaryConditionSolver->UpdateCollider(
             m_collider, m_grids->GetResolution(), m_grids->GetGridSpacing(),
             m_grids->GetOrigin());
@@ -558,6 +1139,16 @@ void GridFluidSolver3::BeginAdvanceTimeStep(double timeIntervalInSeconds)
     // updated externally.
     ApplyBoundaryCondition();
 
+    // Join the asynchronous emitter update before any stage that may read
+    // the emitted fields.
+    if (m_emitterUpdateFuture.valid())
+    {
+        timer.Reset();
+        m_emitterUpdateFuture.get();
+        CUBBYFLOW_INFO << "Joining async emitter update took "
+                       << timer.DurationInSeconds() << " seconds";
+    }
+
     // Invoke callback
     OnBeginAdvanceTimeStep(timeIntervalInSeconds);
 }
@@ -584,6 +1175,155 @@ void GridFluidSolver3::UpdateEmitter(double timeIntervalInSeconds) const
     }
 }
 
+void GridFluidSolver3::UpdateSecondaryParticles(double timeIntervalInSeconds)
+{
+    CUBBYFLOW_PROFILE_ZONE("GridFluidSolver3::UpdateSecondaryParticles");
+
+    const FaceCenteredGrid3Ptr& vel = m_grids->GetVelocity();
+    const ScalarField3Ptr fluidSDF = GetFluidSDF();
+    const BoundingBox3D domain = m_grids->GetBoundingBox();
+    const Vector3D gridSpacing = m_grids->GetGridSpacing();
+    const double h = gridSpacing.Max();
+
+    std::vector<Vector3D> positions;
+    std::vector<Vector3D> velocities;
+    std::vector<double> lifetimes;
+
+    // Integrate and cull the surviving particles: ballistic plus drag only,
+    // with no pressure feedback and no neighbor search.
+    if (m_secondaryParticles != nullptr)
+    {
+        const size_t numberOfParticles =
+            m_secondaryParticles->GetNumberOfParticles();
+        const ConstArrayAccessor1<Vector3D> oldPositions =
+            std::as_const(*m_secondaryParticles).GetPositions();
+        const ConstArrayAccessor1<Vector3D> oldVelocities =
+            std::as_const(*m_secondaryParticles).GetVelocities();
+        const ConstArrayAccessor1<double> oldLifetimes =
+            std::as_const(*m_secondaryParticles).ScalarDataAt(0);
+
+        std::vector<Vector3D> newPositions(numberOfParticles);
+        std::vector<Vector3D> newVelocities(numberOfParticles);
+        std::vector<char> alive(numberOfParticles);
+
+        ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+            Vector3D x = oldPositions[i];
+            Vector3D v = oldVelocities[i];
+
+            if (IsInsideSDF(fluidSDF->Sample(x)))
+            {
+                // Foam: relax toward the carrying flow
+                const Vector3D fluidVel = vel->Sample(x);
+                v += std::min(SECONDARY_FLUID_DRAG * timeIntervalInSeconds,
+                              1.0) *
+                     (fluidVel - v);
+            }
+            else
+            {
+                // Spray: ballistic with weak air drag
+                v += timeIntervalInSeconds * m_gravity;
+                v *= 1.0 - std::min(
+                               SECONDARY_AIR_DRAG * timeIntervalInSeconds,
+                               1.0);
+            }
+
+            x += timeIntervalInSeconds * v;
+
+            newPositions[i] = x;
+            newVelocities[i] = v;
+            alive[i] = (oldLifetimes[i] > timeIntervalInSeconds &&
+                        domain.Contains(x))
+                           ? 1
+                           : 0;
+        });
+
+        positions.reserve(numberOfParticles);
+        velocities.reserve(numberOfParticles);
+        lifetimes.reserve(numberOfParticles);
+        for (size_t i = 0; i < numberOfParticles; ++i)
+        {
+            if (alive[i] != 0)
+            {
+                positions.push_back(newPositions[i]);
+                velocities.push_back(newVelocities[i]);
+                lifetimes.push_back(oldLifetimes[i] - timeIntervalInSeconds);
+            }
+        }
+    }
+
+    // Emit from interface cells whose flow is fast or strongly divergent.
+    std::mt19937 rng{ m_secondaryEmissionSeed++ };
+    std::uniform_real_distribution<double> jitter{ -0.5, 0.5 };
+    std::uniform_real_distribution<double> lifetimeDist{
+        SECONDARY_MIN_LIFETIME, SECONDARY_MAX_LIFETIME
+    };
+
+    const auto cellCenter = vel->CellCenterPosition();
+    const Size3 resolution = m_grids->GetResolution();
+
+    for (size_t k = 0; k < resolution.z; ++k)
+    {
+        for (size_t j = 0; j < resolution.y; ++j)
+        {
+            for (size_t i = 0; i < resolution.x; ++i)
+            {
+                if (positions.size() >= m_maxNumberOfSecondaryParticles)
+                {
+                    break;
+                }
+
+                const Vector3D x = cellCenter(i, j, k);
+                if (std::abs(fluidSDF->Sample(x)) > h)
+                {
+                    continue;
+                }
+
+                const Vector3D fluidVel = vel->ValueAtCellCenter(i, j, k);
+                const double localCFL =
+                    fluidVel.Length() * timeIntervalInSeconds / h;
+                const double stepDivergence =
+                    std::abs(vel->DivergenceAtCellCenter(i, j, k)) *
+                    timeIntervalInSeconds;
+
+                const double potential =
+                    std::max(localCFL - SECONDARY_MIN_CFL, 0.0) +
+                    std::max(stepDivergence - SECONDARY_MIN_DIVERGENCE, 0.0);
+                if (potential <= 0.0)
+                {
+                    continue;
+                }
+
+                const size_t numToEmit = std::min(
+                    SECONDARY_MAX_EMISSION_PER_CELL,
+                    1 + static_cast<size_t>(4.0 * potential));
+                for (size_t p = 0; p < numToEmit; ++p)
+                {
+                    positions.push_back(
+                        x + Vector3D{ jitter(rng) * gridSpacing.x,
+                                      jitter(rng) * gridSpacing.y,
+                                      jitter(rng) * gridSpacing.z });
+                    velocities.push_back(
+                        fluidVel *
+                        (1.0 + 0.1 * jitter(rng)));
+                    lifetimes.push_back(lifetimeDist(rng));
+                }
+            }
+        }
+    }
+
+    m_secondaryParticles = std::make_shared<ParticleSystemData3>();
+    m_secondaryParticles->AddScalarData();
+    m_secondaryParticles->AddParticles(
+        ConstArrayAccessor1<Vector3D>{ positions.size(), positions.data() },
+        ConstArrayAccessor1<Vector3D>{ velocities.size(),
+                                       velocities.data() });
+
+    ArrayAccessor1<double> lifetimeData =
+        m_secondaryParticles->ScalarDataAt(0);
+    ParallelFor(ZERO_SIZE, lifetimes.size(),
+                [&](size_t i) { lifetimeData[i] = lifetimes[i]; });
+}
+
 GridFluidSolver3::Builder GridFluidSolver3::GetBuilder()
 {
     return Builder{};
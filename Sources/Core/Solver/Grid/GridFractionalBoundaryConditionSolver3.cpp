@@ -13,8 +13,11 @@
 #include <Core/Geometry/SurfaceToImplicit3.hpp>
 #include <Core/Solver/Grid/GridFractionalBoundaryConditionSolver3.hpp>
 #include <Core/Utils/LevelSetUtils.hpp>
+#include <Core/Utils/Parallel.hpp>
 #include <Core/Utils/PhysicsHelpers.hpp>
 
+#include <algorithm>
+
 namespace CubbyFlow
 {
 void GridFractionalBoundaryConditionSolver3::ConstrainVelocity(
@@ -35,186 +38,127 @@ void GridFractionalBoundaryConditionSolver3::ConstrainVelocity(
     auto vPos = velocity->GetVPosition();
     auto wPos = velocity->GetWPosition();
 
-    Array3<double> uTemp{ u.size() };
-    Array3<double> vTemp{ v.size() };
-    Array3<double> wTemp{ w.size() };
-    Array3<char> uMarker{ u.size(), 1 };
-    Array3<char> vMarker{ v.size(), 1 };
-    Array3<char> wMarker{ w.size(), 1 };
-
-    Vector3D h = velocity->GridSpacing();
-
-    // Assign collider's velocity first and initialize markers
-    velocity->ParallelForEachUIndex([&](size_t i, size_t j, size_t k) {
-        const Vector3D pt = uPos(i, j, k);
-        const double phi0 =
-            m_colliderSDF->Sample(pt - Vector3D{ 0.5 * h.x, 0.0, 0.0 });
-        const double phi1 =
-            m_colliderSDF->Sample(pt + Vector3D{ 0.5 * h.x, 0.0, 0.0 });
-        double frac = FractionInsideSDF(phi0, phi1);
-        frac = 1.0 - std::clamp(frac, 0.0, 1.0);
+    // Persistent workspace; Resize is a no-op unless the resolution changed,
+    // and every element is overwritten below.
+    m_uTemp.Resize(u.size());
+    m_vTemp.Resize(v.size());
+    m_wTemp.Resize(w.size());
+    m_uMarker.Resize(u.size());
+    m_vMarker.Resize(v.size());
+    m_wMarker.Resize(w.size());
+
+    // Classify faces against the collider SDF once per SDF version; for
+    // static colliders the tables (and the markers) are reused across
+    // substeps and the sweeps below never touch the SDF.
+    if (!m_hasFaceClassification ||
+        m_classifiedSDFVersion != m_colliderSDFVersion ||
+        m_classifiedSize != size)
+    {
+        BuildFaceClassification(*velocity);
+    }
 
-        if (frac > 0.0)
-        {
-            uMarker(i, j, k) = 1;
-        }
-        else
-        {
-            const Vector3D colliderVel = GetCollider()->VelocityAt(pt);
-            u(i, j, k) = colliderVel.x;
-            uMarker(i, j, k) = 0;
-        }
+    // Assign collider's velocity to fully-solid faces. Fully-fluid and
+    // fractional faces keep their markers from the classification pass.
+    ParallelFor(ZERO_SIZE, m_uSolidFaces.size(), [&](size_t n) {
+        const Size3& f = m_uSolidFaces[n];
+        u(f.x, f.y, f.z) = GetCollider()->VelocityAt(uPos(f.x, f.y, f.z)).x;
     });
-
-    velocity->ParallelForEachVIndex([&](size_t i, size_t j, size_t k) {
-        const Vector3D pt = vPos(i, j, k);
-        const double phi0 =
-            m_colliderSDF->Sample(pt - Vector3D{ 0.0, 0.5 * h.y, 0.0 });
-        const double phi1 =
-            m_colliderSDF->Sample(pt + Vector3D{ 0.0, 0.5 * h.y, 0.0 });
-        double frac = FractionInsideSDF(phi0, phi1);
-        frac = 1.0 - std::clamp(frac, 0.0, 1.0);
-
-        if (frac > 0.0)
-        {
-            vMarker(i, j, k) = 1;
-        }
-        else
-        {
-            const Vector3D colliderVel = GetCollider()->VelocityAt(pt);
-            v(i, j, k) = colliderVel.y;
-            vMarker(i, j, k) = 0;
-        }
+    ParallelFor(ZERO_SIZE, m_vSolidFaces.size(), [&](size_t n) {
+        const Size3& f = m_vSolidFaces[n];
+        v(f.x, f.y, f.z) = GetCollider()->VelocityAt(vPos(f.x, f.y, f.z)).y;
     });
-
-    velocity->ParallelForEachWIndex([&](size_t i, size_t j, size_t k) {
-        const Vector3D pt = wPos(i, j, k);
-        const double phi0 =
-            m_colliderSDF->Sample(pt - Vector3D{ 0.0, 0.0, 0.5 * h.z });
-        const double phi1 =
-            m_colliderSDF->Sample(pt + Vector3D{ 0.0, 0.0, 0.5 * h.z });
-        double frac = FractionInsideSDF(phi0, phi1);
-        frac = 1.0 - std::clamp(frac, 0.0, 1.0);
-
-        if (frac > 0.0)
-        {
-            wMarker(i, j, k) = 1;
-        }
-        else
-        {
-            const Vector3D colliderVel = GetCollider()->VelocityAt(pt);
-            w(i, j, k) = colliderVel.z;
-            wMarker(i, j, k) = 0;
-        }
+    ParallelFor(ZERO_SIZE, m_wSolidFaces.size(), [&](size_t n) {
+        const Size3& f = m_wSolidFaces[n];
+        w(f.x, f.y, f.z) = GetCollider()->VelocityAt(wPos(f.x, f.y, f.z)).z;
     });
 
     // Free-slip: Extrapolate fluid velocity into the collider
-    ExtrapolateToRegion(velocity->GetUConstAccessor(), uMarker,
-                        extrapolationDepth, u);
-    ExtrapolateToRegion(velocity->GetVConstAccessor(), vMarker,
-                        extrapolationDepth, v);
-    ExtrapolateToRegion(velocity->GetWConstAccessor(), wMarker,
-                        extrapolationDepth, w);
+    ExtrapolateToRegionFrontier(velocity->GetUConstAccessor(), m_uMarker,
+                                extrapolationDepth, u);
+    ExtrapolateToRegionFrontier(velocity->GetVConstAccessor(), m_vMarker,
+                                extrapolationDepth, v);
+    ExtrapolateToRegionFrontier(velocity->GetWConstAccessor(), m_wMarker,
+                                extrapolationDepth, w);
 
     // No-flux: project the extrapolated velocity to the collider's surface
-    // normal
-    velocity->ParallelForEachUIndex([&](size_t i, size_t j, size_t k) {
-        const Vector3D pt = uPos(i, j, k);
+    // normal, visiting only the cached fractional faces.
+    u.ParallelForEachIndex(
+        [&](size_t i, size_t j, size_t k) { m_uTemp(i, j, k) = u(i, j, k); });
+    v.ParallelForEachIndex(
+        [&](size_t i, size_t j, size_t k) { m_vTemp(i, j, k) = v(i, j, k); });
+    w.ParallelForEachIndex(
+        [&](size_t i, size_t j, size_t k) { m_wTemp(i, j, k) = w(i, j, k); });
 
-        if (IsInsideSDF(m_colliderSDF->Sample(pt)))
+    ParallelFor(ZERO_SIZE, m_uFractionalFaces.size(), [&](size_t n) {
+        const FractionalFace& face = m_uFractionalFaces[n];
+        const Vector3D pt = uPos(face.index.x, face.index.y, face.index.z);
+        const Vector3D colliderVel = GetCollider()->VelocityAt(pt);
+
+        if (face.normal.LengthSquared() > 0.0)
         {
-            const Vector3D colliderVel = GetCollider()->VelocityAt(pt);
             const Vector3D vel = velocity->Sample(pt);
-            const Vector3D g = m_colliderSDF->Gradient(pt);
-
-            if (g.LengthSquared() > 0.0)
-            {
-                const Vector3D n = g.Normalized();
-                const Vector3D velr = vel - colliderVel;
-                const Vector3D velt = ProjectAndApplyFriction(
-                    velr, n, GetCollider()->GetFrictionCoefficient());
-                const Vector3D velp = velt + colliderVel;
+            const Vector3D velr = vel - colliderVel;
+            const Vector3D velt = ProjectAndApplyFriction(
+                velr, face.normal, GetCollider()->GetFrictionCoefficient());
+            const Vector3D velp = velt + colliderVel;
 
-                uTemp(i, j, k) = velp.x;
-            }
-            else
-            {
-                uTemp(i, j, k) = colliderVel.x;
-            }
+            m_uTemp(face.index.x, face.index.y, face.index.z) = velp.x;
         }
         else
         {
-            uTemp(i, j, k) = u(i, j, k);
+            m_uTemp(face.index.x, face.index.y, face.index.z) = colliderVel.x;
         }
     });
 
-    velocity->ParallelForEachVIndex([&](size_t i, size_t j, size_t k) {
-        const Vector3D pt = vPos(i, j, k);
+    ParallelFor(ZERO_SIZE, m_vFractionalFaces.size(), [&](size_t n) {
+        const FractionalFace& face = m_vFractionalFaces[n];
+        const Vector3D pt = vPos(face.index.x, face.index.y, face.index.z);
+        const Vector3D colliderVel = GetCollider()->VelocityAt(pt);
 
-        if (IsInsideSDF(m_colliderSDF->Sample(pt)))
+        if (face.normal.LengthSquared() > 0.0)
         {
-            const Vector3D colliderVel = GetCollider()->VelocityAt(pt);
             const Vector3D vel = velocity->Sample(pt);
-            const Vector3D g = m_colliderSDF->Gradient(pt);
-
-            if (g.LengthSquared() > 0.0)
-            {
-                const Vector3D n = g.Normalized();
-                const Vector3D velr = vel - colliderVel;
-                const Vector3D velt = ProjectAndApplyFriction(
-                    velr, n, GetCollider()->GetFrictionCoefficient());
-                const Vector3D velp = velt + colliderVel;
+            const Vector3D velr = vel - colliderVel;
+            const Vector3D velt = ProjectAndApplyFriction(
+                velr, face.normal, GetCollider()->GetFrictionCoefficient());
+            const Vector3D velp = velt + colliderVel;
 
-                vTemp(i, j, k) = velp.y;
-            }
-            else
-            {
-                vTemp(i, j, k) = colliderVel.y;
-            }
+            m_vTemp(face.index.x, face.index.y, face.index.z) = velp.y;
         }
         else
         {
-            vTemp(i, j, k) = v(i, j, k);
+            m_vTemp(face.index.x, face.index.y, face.index.z) = colliderVel.y;
         }
     });
 
-    velocity->ParallelForEachWIndex([&](size_t i, size_t j, size_t k) {
-        const Vector3D pt = wPos(i, j, k);
+    ParallelFor(ZERO_SIZE, m_wFractionalFaces.size(), [&](size_t n) {
+        const FractionalFace& face = m_wFractionalFaces[n];
+        const Vector3D pt = wPos(face.index.x, face.index.y, face.index.z);
+        const Vector3D colliderVel = GetCollider()->VelocityAt(pt);
 
-        if (IsInsideSDF(m_colliderSDF->Sample(pt)))
+        if (face.normal.LengthSquared() > 0.0)
         {
-            const Vector3D colliderVel = GetCollider()->VelocityAt(pt);
             const Vector3D vel = velocity->Sample(pt);
-            const Vector3D g = m_colliderSDF->Gradient(pt);
-
-            if (g.LengthSquared() > 0.0)
-            {
-                const Vector3D n = g.Normalized();
-                const Vector3D velr = vel - colliderVel;
-                const Vector3D velt = ProjectAndApplyFriction(
-                    velr, n, GetCollider()->GetFrictionCoefficient());
-                const Vector3D velp = velt + colliderVel;
+            const Vector3D velr = vel - colliderVel;
+            const Vector3D velt = ProjectAndApplyFriction(
+                velr, face.normal, GetCollider()->GetFrictionCoefficient());
+            const Vector3D velp = velt + colliderVel;
 
-                wTemp(i, j, k) = velp.z;
-            }
-            else
-            {
-                wTemp(i, j, k) = colliderVel.z;
-            }
+            m_wTemp(face.index.x, face.index.y, face.index.z) = velp.z;
         }
         else
         {
-            wTemp(i, j, k) = w(i, j, k);
+            m_wTemp(face.index.x, face.index.y, face.index.z) = colliderVel.z;
         }
     });
 
     // Transfer results
     u.ParallelForEachIndex(
-        [&](size_t i, size_t j, size_t k) { u(i, j, k) = uTemp(i, j, k); });
+        [&](size_t i, size_t j, size_t k) { u(i, j, k) = m_uTemp(i, j, k); });
     v.ParallelForEachIndex(
-        [&](size_t i, size_t j, size_t k) { v(i, j, k) = vTemp(i, j, k); });
+        [&](size_t i, size_t j, size_t k) { v(i, j, k) = m_vTemp(i, j, k); });
     w.ParallelForEachIndex(
-        [&](size_t i, size_t j, size_t k) { w(i, j, k) = wTemp(i, j, k); });
+        [&](size_t i, size_t j, size_t k) { w(i, j, k) = m_wTemp(i, j, k); });
 
     // No-flux: Project velocity on the domain boundary if closed
     if (GetClosedDomainBoundaryFlag() & DIRECTION_LEFT)
@@ -279,6 +223,113 @@ void GridFractionalBoundaryConditionSolver3::ConstrainVelocity(
     }
 }
 
+void GridFractionalBoundaryConditionSolver3::BuildFaceClassification(
+    const FaceCenteredGrid3& velocity)
+{
+    const Vector3D h = velocity.GridSpacing();
+    auto uPos = velocity.GetUPosition();
+    auto vPos = velocity.GetVPosition();
+    auto wPos = velocity.GetWPosition();
+
+    m_uMarker.Resize(velocity.GetUConstAccessor().size());
+    m_vMarker.Resize(velocity.GetVConstAccessor().size());
+    m_wMarker.Resize(velocity.GetWConstAccessor().size());
+
+    m_uSolidFaces.clear();
+    m_vSolidFaces.clear();
+    m_wSolidFaces.clear();
+    m_uFractionalFaces.clear();
+    m_vFractionalFaces.clear();
+    m_wFractionalFaces.clear();
+
+    // Classification byte per face: bit 0 marks a zero open fraction (fully
+    // solid), bit 1 marks a face center inside the collider (fractional).
+    // The bits are computed in parallel and compacted into the face lists
+    // serially; surface normals are only evaluated for the compact interior
+    // set.
+    const auto classify = [&](const Vector3D& pt, const Vector3D& faceOffset) {
+        const double phi0 = m_colliderSDF->Sample(pt - faceOffset);
+        const double phi1 = m_colliderSDF->Sample(pt + faceOffset);
+        double frac = FractionInsideSDF(phi0, phi1);
+        frac = 1.0 - std::clamp(frac, 0.0, 1.0);
+
+        uint8_t bits = 0;
+        if (frac <= 0.0)
+        {
+            bits |= 1;
+        }
+        if (IsInsideSDF(m_colliderSDF->Sample(pt)))
+        {
+            bits |= 2;
+        }
+
+        return bits;
+    };
+
+    const auto surfaceNormal = [&](const Vector3D& pt) {
+        const Vector3D g = m_colliderSDF->Gradient(pt);
+        return (g.LengthSquared() > 0.0) ? g.Normalized() : Vector3D{};
+    };
+
+    Array3<uint8_t> uBits(m_uMarker.size());
+    Array3<uint8_t> vBits(m_vMarker.size());
+    Array3<uint8_t> wBits(m_wMarker.size());
+
+    velocity.ParallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        uBits(i, j, k) =
+            classify(uPos(i, j, k), Vector3D{ 0.5 * h.x, 0.0, 0.0 });
+        m_uMarker(i, j, k) = (uBits(i, j, k) & 1) ? 0 : 1;
+    });
+    velocity.ParallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        vBits(i, j, k) =
+            classify(vPos(i, j, k), Vector3D{ 0.0, 0.5 * h.y, 0.0 });
+        m_vMarker(i, j, k) = (vBits(i, j, k) & 1) ? 0 : 1;
+    });
+    velocity.ParallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        wBits(i, j, k) =
+            classify(wPos(i, j, k), Vector3D{ 0.0, 0.0, 0.5 * h.z });
+        m_wMarker(i, j, k) = (wBits(i, j, k) & 1) ? 0 : 1;
+    });
+
+    uBits.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (uBits(i, j, k) & 1)
+        {
+            m_uSolidFaces.push_back(Size3{ i, j, k });
+        }
+        if (uBits(i, j, k) & 2)
+        {
+            m_uFractionalFaces.push_back(
+                FractionalFace{ Size3{ i, j, k }, surfaceNormal(uPos(i, j, k)) });
+        }
+    });
+    vBits.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (vBits(i, j, k) & 1)
+        {
+            m_vSolidFaces.push_back(Size3{ i, j, k });
+        }
+        if (vBits(i, j, k) & 2)
+        {
+            m_vFractionalFaces.push_back(
+                FractionalFace{ Size3{ i, j, k }, surfaceNormal(vPos(i, j, k)) });
+        }
+    });
+    wBits.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (wBits(i, j, k) & 1)
+        {
+            m_wSolidFaces.push_back(Size3{ i, j, k });
+        }
+        if (wBits(i, j, k) & 2)
+        {
+            m_wFractionalFaces.push_back(
+                FractionalFace{ Size3{ i, j, k }, surfaceNormal(wPos(i, j, k)) });
+        }
+    });
+
+    m_classifiedSize = velocity.Resolution();
+    m_classifiedSDFVersion = m_colliderSDFVersion;
+    m_hasFaceClassification = true;
+}
+
 ScalarField3Ptr GridFractionalBoundaryConditionSolver3::GetColliderSDF() const
 {
     return m_colliderSDF;
@@ -290,6 +341,22 @@ GridFractionalBoundaryConditionSolver3::GetColliderVelocityField() const
     return m_colliderVel;
 }
 
+bool GridFractionalBoundaryConditionSolver3::GetUseColliderSDFCache() const
+{
+    return m_useColliderSDFCache;
+}
+
+void GridFractionalBoundaryConditionSolver3::SetUseColliderSDFCache(
+    bool useColliderSDFCache)
+{
+    m_useColliderSDFCache = useColliderSDFCache;
+}
+
+size_t GridFractionalBoundaryConditionSolver3::GetColliderSDFVersion() const
+{
+    return m_colliderSDFVersion;
+}
+
 void GridFractionalBoundaryConditionSolver3::OnColliderUpdated(
     const Size3& gridSize, const Vector3D& gridSpacing,
     const Vector3D& gridOrigin)
@@ -299,7 +366,13 @@ void GridFractionalBoundaryConditionSolver3::OnColliderUpdated(
         m_colliderSDF = std::make_shared<CellCenteredScalarGrid3>();
     }
 
-    m_colliderSDF->Resize(gridSize, gridSpacing, gridOrigin);
+    if (m_colliderSDF->Resolution() != gridSize ||
+        m_colliderSDF->GridSpacing() != gridSpacing ||
+        m_colliderSDF->Origin() != gridOrigin)
+    {
+        m_colliderSDF->Resize(gridSize, gridSpacing, gridOrigin);
+        m_hasCachedColliderSDF = false;
+    }
 
     if (GetCollider() != nullptr)
     {
@@ -311,9 +384,53 @@ void GridFractionalBoundaryConditionSolver3::OnColliderUpdated(
             implicitSurface = std::make_shared<SurfaceToImplicit3>(surface);
         }
 
-        m_colliderSDF->Fill([&](const Vector3D& pt) {
-            return implicitSurface->SignedDistance(pt);
-        });
+        const bool sameSurface =
+            m_hasCachedColliderSDF && m_cachedSurface == surface;
+        const bool sameTransform =
+            sameSurface &&
+            m_cachedTransform.GetTranslation() ==
+                surface->transform.GetTranslation() &&
+            m_cachedTransform.GetOrientation() ==
+                surface->transform.GetOrientation();
+
+        if (!m_useColliderSDFCache || !sameTransform)
+        {
+            if (m_useColliderSDFCache && sameSurface)
+            {
+                // The collider only moved; re-rasterize within the dilated
+                // union of the previous and current bounds. The far field
+                // keeps the old distances which stay sign-correct.
+                BoundingBox3D bound = surface->BoundingBox();
+                bound.Merge(m_cachedBound);
+                bound.Expand(3.0 * std::max({ gridSpacing.x, gridSpacing.y,
+                                              gridSpacing.z }));
+
+                auto pos = m_colliderSDF->GetDataPosition();
+                ArrayAccessor3<double> sdf = m_colliderSDF->GetDataAccessor();
+
+                m_colliderSDF->ParallelForEachDataPointIndex(
+                    [&](size_t i, size_t j, size_t k) {
+                        const Vector3D pt = pos(i, j, k);
+
+                        if (bound.Contains(pt))
+                        {
+                            sdf(i, j, k) = implicitSurface->SignedDistance(pt);
+                        }
+                    });
+            }
+            else
+            {
+                m_colliderSDF->Fill([&](const Vector3D& pt) {
+                    return implicitSurface->SignedDistance(pt);
+                });
+            }
+
+            ++m_colliderSDFVersion;
+            m_cachedSurface = surface;
+            m_cachedTransform = surface->transform;
+            m_cachedBound = surface->BoundingBox();
+            m_hasCachedColliderSDF = true;
+        }
 
         m_colliderVel = CustomVectorField3::Builder{}
                             .WithFunction([&](const Vector3D& x) {
@@ -324,7 +441,17 @@ void GridFractionalBoundaryConditionSolver3::OnColliderUpdated(
     }
     else
     {
-        m_colliderSDF->Fill(std::numeric_limits<double>::max());
+        if (!m_useColliderSDFCache || !m_hasCachedColliderSDF ||
+            m_cachedSurface != nullptr)
+        {
+            m_colliderSDF->Fill(std::numeric_limits<double>::max());
+
+            ++m_colliderSDFVersion;
+            m_cachedSurface = nullptr;
+            m_cachedTransform = Transform3{};
+            m_cachedBound = BoundingBox3D{};
+            m_hasCachedColliderSDF = true;
+        }
 
         m_colliderVel =
             CustomVectorField3::Builder{}
@@ -572,6 +572,30 @@ void BuildSingleSystem(MatrixCSRD* A, VectorND* x, VectorND* b,
 
     x->Resize(b->size(), 0.0);
 }
+
+//! Converts a world-space dirty region to the index range of the weight
+//! array it can affect. An empty intersection yields begin >= end.
+void GetDirtyIndexRange(const BoundingBox3D& region, const Vector3D& origin,
+                        const Vector3D& gridSpacing, const Size3& size,
+                        Size3* begin, Size3* end)
+{
+    const Vector3D lower = (region.lowerCorner - origin) / gridSpacing;
+    const Vector3D upper = (region.upperCorner - origin) / gridSpacing;
+
+    begin->x = static_cast<size_t>(
+        std::clamp(std::floor(lower.x), 0.0, static_cast<double>(size.x)));
+    begin->y = static_cast<size_t>(
+        std::clamp(std::floor(lower.y), 0.0, static_cast<double>(size.y)));
+    begin->z = static_cast<size_t>(
+        std::clamp(std::floor(lower.z), 0.0, static_cast<double>(size.z)));
+
+    end->x = static_cast<size_t>(
+        std::clamp(std::ceil(upper.x) + 1.0, 0.0, static_cast<double>(size.x)));
+    end->y = static_cast<size_t>(
+        std::clamp(std::ceil(upper.y) + 1.0, 0.0, static_cast<double>(size.y)));
+    end->z = static_cast<size_t>(
+        std::clamp(std::ceil(upper.z) + 1.0, 0.0, static_cast<double>(size.z)));
+}
 }  // namespace
 
 GridFractionalSinglePhasePressureSolver3::
@@ -660,6 +684,42 @@ const FDMVector3& GridFractionalSinglePhasePressureSolver3::GetPressure() const
     return m_mgSystem.x.levels.front();
 }
 
+bool GridFractionalSinglePhasePressureSolver3::GetUseWeightCache() const
+{
+    return m_useWeightCache;
+}
+
+void GridFractionalSinglePhasePressureSolver3::SetUseWeightCache(
+    bool useWeightCache)
+{
+    m_useWeightCache = useWeightCache;
+
+    if (!m_useWeightCache)
+    {
+        m_weightCacheValid = false;
+    }
+}
+
+void GridFractionalSinglePhasePressureSolver3::InvalidateWeightCache()
+{
+    m_weightCacheValid = false;
+    m_hasDirtyRegion = false;
+}
+
+void GridFractionalSinglePhasePressureSolver3::InvalidateWeightCacheInRegion(
+    const BoundingBox3D& region)
+{
+    if (m_hasDirtyRegion)
+    {
+        m_dirtyRegion.Merge(region);
+    }
+    else
+    {
+        m_dirtyRegion = region;
+        m_hasDirtyRegion = true;
+    }
+}
+
 void GridFractionalSinglePhasePressureSolver3::BuildWeights(
     const FaceCenteredGrid3& input, const ScalarField3& boundarySDF,
     const VectorField3& boundaryVelocity, const ScalarField3& fluidSDF)
@@ -674,6 +734,13 @@ void GridFractionalSinglePhasePressureSolver3::BuildWeights(
     }
 
     FDMMGUtils3::ResizeArrayWithFinest(size, maxLevels, &m_fluidSDF);
+
+    const bool cacheCompatible =
+        m_useWeightCache && m_weightCacheValid &&
+        &boundarySDF == m_cachedBoundarySDF && size == m_cachedWeightsSize &&
+        m_fluidSDF.size() == m_cachedWeightsLevels;
+    const bool weightsCached = cacheCompatible && !m_hasDirtyRegion;
+    const bool partialUpdate = cacheCompatible && m_hasDirtyRegion;
     m_uWeights.resize(m_fluidSDF.size());
     m_vWeights.resize(m_fluidSDF.size());
     m_wWeights.resize(m_fluidSDF.size());
@@ -696,93 +763,132 @@ void GridFractionalSinglePhasePressureSolver3::BuildWeights(
         m_fluidSDF[0](i, j, k) = fluidSDF.Sample(cellPos(i, j, k));
     });
 
-    m_uWeights[0].ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        const Vector3D pt = uPos(i, j, k);
-        const double phi0 =
-            boundarySDF.Sample(pt + Vector3D{ 0.0, -0.5 * h.y, -0.5 * h.z });
-        const double phi1 =
-            boundarySDF.Sample(pt + Vector3D{ 0.0, 0.5 * h.y, -0.5 * h.z });
-        const double phi2 =
-            boundarySDF.Sample(pt + Vector3D{ 0.0, -0.5 * h.y, 0.5 * h.z });
-        const double phi3 =
-            boundarySDF.Sample(pt + Vector3D{ 0.0, 0.5 * h.y, 0.5 * h.z });
-        const double frac = FractionInside(phi0, phi1, phi2, phi3);
-        double weight = std::clamp(1.0 - frac, 0.0, 1.0);
-
-        // Clamp non-zero weight to kMinWeight. Having nearly-zero element
-        // in the matrix can be an issue.
-        if (weight < MIN_WEIGHT && weight > 0.0)
-        {
-            weight = MIN_WEIGHT;
-        }
+    // Index ranges to refresh. A dirty-region update touches only the faces
+    // whose sampling stencil can overlap the region; every other face keeps
+    // its cached weight.
+    Size3 uBegin{ 0, 0, 0 }, uEnd = m_uWeights[0].size();
+    Size3 vBegin{ 0, 0, 0 }, vEnd = m_vWeights[0].size();
+    Size3 wBegin{ 0, 0, 0 }, wEnd = m_wWeights[0].size();
 
-        m_uWeights[0](i, j, k) = weight;
-    });
+    if (partialUpdate)
+    {
+        // One cell of slack for the SDF sampling plus half a cell for the
+        // face-fraction stencil.
+        BoundingBox3D region = m_dirtyRegion;
+        region.Expand(1.5 * std::max({ h.x, h.y, h.z }));
+
+        GetDirtyIndexRange(region, input.GetUOrigin(), h,
+                           m_uWeights[0].size(), &uBegin, &uEnd);
+        GetDirtyIndexRange(region, input.GetVOrigin(), h,
+                           m_vWeights[0].size(), &vBegin, &vEnd);
+        GetDirtyIndexRange(region, input.GetWOrigin(), h,
+                           m_wWeights[0].size(), &wBegin, &wEnd);
+    }
 
-    m_vWeights[0].ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        const Vector3D pt = vPos(i, j, k);
-        const double phi0 =
-            boundarySDF.Sample(pt + Vector3D{ -0.5 * h.x, 0.0, -0.5 * h.z });
-        const double phi1 =
-            boundarySDF.Sample(pt + Vector3D{ -0.5 * h.x, 0.0, 0.5 * h.z });
-        const double phi2 =
-            boundarySDF.Sample(pt + Vector3D{ 0.5 * h.x, 0.0, -0.5 * h.z });
-        const double phi3 =
-            boundarySDF.Sample(pt + Vector3D{ 0.5 * h.x, 0.0, 0.5 * h.z });
-        const double frac = FractionInside(phi0, phi1, phi2, phi3);
-        double weight = std::clamp(1.0 - frac, 0.0, 1.0);
-
-        // Clamp non-zero weight to kMinWeight. Having nearly-zero element
-        // in the matrix can be an issue.
-        if (weight < MIN_WEIGHT && weight > 0.0)
-        {
-            weight = MIN_WEIGHT;
-        }
+    if (!weightsCached)
+    {
+        ParallelFor(uBegin.x, uEnd.x, uBegin.y, uEnd.y, uBegin.z, uEnd.z,
+                    [&](size_t i, size_t j, size_t k) {
+            const Vector3D pt = uPos(i, j, k);
+            const double phi0 = boundarySDF.Sample(
+                pt + Vector3D{ 0.0, -0.5 * h.y, -0.5 * h.z });
+            const double phi1 =
+                boundarySDF.Sample(pt + Vector3D{ 0.0, 0.5 * h.y, -0.5 * h.z });
+            const double phi2 =
+                boundarySDF.Sample(pt + Vector3D{ 0.0, -0.5 * h.y, 0.5 * h.z });
+            const double phi3 =
+                boundarySDF.Sample(pt + Vector3D{ 0.0, 0.5 * h.y, 0.5 * h.z });
+            const double frac = FractionInside(phi0, phi1, phi2, phi3);
+            double weight = std::clamp(1.0 - frac, 0.0, 1.0);
+
+            // Clamp non-zero weight to kMinWeight. Having nearly-zero element
+            // in the matrix can be an issue.
+            if (weight < MIN_WEIGHT && weight > 0.0)
+            {
+                weight = MIN_WEIGHT;
+            }
 
-        m_vWeights[0](i, j, k) = weight;
-    });
+            m_uWeights[0](i, j, k) = weight;
+        });
 
-    m_wWeights[0].ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        const Vector3D pt = wPos(i, j, k);
-        const double phi0 =
-            boundarySDF.Sample(pt + Vector3D{ -0.5 * h.x, -0.5 * h.y, 0.0 });
-        const double phi1 =
-            boundarySDF.Sample(pt + Vector3D{ -0.5 * h.x, 0.5 * h.y, 0.0 });
-        const double phi2 =
-            boundarySDF.Sample(pt + Vector3D{ 0.5 * h.x, -0.5 * h.y, 0.0 });
-        const double phi3 =
-            boundarySDF.Sample(pt + Vector3D{ 0.5 * h.x, 0.5 * h.y, 0.0 });
-        const double frac = FractionInside(phi0, phi1, phi2, phi3);
-        double weight = std::clamp(1.0 - frac, 0.0, 1.0);
-
-        // Clamp non-zero weight to kMinWeight. Having nearly-zero element
-        // in the matrix can be an issue.
-        if (weight < MIN_WEIGHT && weight > 0.0)
-        {
-            weight = MIN_WEIGHT;
-        }
+        ParallelFor(vBegin.x, vEnd.x, vBegin.y, vEnd.y, vBegin.z, vEnd.z,
+                    [&](size_t i, size_t j, size_t k) {
+            const Vector3D pt = vPos(i, j, k);
+            const double phi0 = boundarySDF.Sample(
+                pt + Vector3D{ -0.5 * h.x, 0.0, -0.5 * h.z });
+            const double phi1 =
+                boundarySDF.Sample(pt + Vector3D{ -0.5 * h.x, 0.0, 0.5 * h.z });
+            const double phi2 =
+                boundarySDF.Sample(pt + Vector3D{ 0.5 * h.x, 0.0, -0.5 * h.z });
+            const double phi3 =
+                boundarySDF.Sample(pt + Vector3D{ 0.5 * h.x, 0.0, 0.5 * h.z });
+            const double frac = FractionInside(phi0, phi1, phi2, phi3);
+            double weight = std::clamp(1.0 - frac, 0.0, 1.0);
+
+            // Clamp non-zero weight to kMinWeight. Having nearly-zero element
+            // in the matrix can be an issue.
+            if (weight < MIN_WEIGHT && weight > 0.0)
+            {
+                weight = MIN_WEIGHT;
+            }
 
-        m_wWeights[0](i, j, k) = weight;
-    });
+            m_vWeights[0](i, j, k) = weight;
+        });
+
+        ParallelFor(wBegin.x, wEnd.x, wBegin.y, wEnd.y, wBegin.z, wEnd.z,
+                    [&](size_t i, size_t j, size_t k) {
+            const Vector3D pt = wPos(i, j, k);
+            const double phi0 = boundarySDF.Sample(
+                pt + Vector3D{ -0.5 * h.x, -0.5 * h.y, 0.0 });
+            const double phi1 =
+                boundarySDF.Sample(pt + Vector3D{ -0.5 * h.x, 0.5 * h.y, 0.0 });
+            const double phi2 =
+                boundarySDF.Sample(pt + Vector3D{ 0.5 * h.x, -0.5 * h.y, 0.0 });
+            const double phi3 =
+                boundarySDF.Sample(pt + Vector3D{ 0.5 * h.x, 0.5 * h.y, 0.0 });
+            const double frac = FractionInside(phi0, phi1, phi2, phi3);
+            double weight = std::clamp(1.0 - frac, 0.0, 1.0);
+
+            // Clamp non-zero weight to kMinWeight. Having nearly-zero element
+            // in the matrix can be an issue.
+            if (weight < MIN_WEIGHT && weight > 0.0)
+            {
+                weight = MIN_WEIGHT;
+            }
+
+            m_wWeights[0](i, j, k) = weight;
+        });
+    }
 
     // Build sub-levels
     for (size_t l = 1; l < m_fluidSDF.size(); ++l)
     {
         const Array3<double>& finerFluidSdf = m_fluidSDF[l - 1];
         Array3<double>& coarserFluidSdf = m_fluidSDF[l];
-        const Array3<double>& finerUWeight = m_uWeights[l - 1];
-        Array3<double>& coarserUWeight = m_uWeights[l];
-        const Array3<double>& finerVWeight = m_vWeights[l - 1];
-        Array3<double>& coarserVWeight = m_vWeights[l];
-        const Array3<double>& finerWWeight = m_wWeights[l - 1];
-        Array3<double>& coarserWWeight = m_wWeights[l];
 
         // Fluid SDF
         Restrict(finerFluidSdf, &coarserFluidSdf);
-        Restrict(finerUWeight, &coarserUWeight);
-        Restrict(finerVWeight, &coarserVWeight);
-        Restrict(finerWWeight, &coarserWWeight);
+
+        if (!weightsCached)
+        {
+            const Array3<double>& finerUWeight = m_uWeights[l - 1];
+            Array3<double>& coarserUWeight = m_uWeights[l];
+            const Array3<double>& finerVWeight = m_vWeights[l - 1];
+            Array3<double>& coarserVWeight = m_vWeights[l];
+            const Array3<double>& finerWWeight = m_wWeights[l - 1];
+            Array3<double>& coarserWWeight = m_wWeights[l];
+
+            Restrict(finerUWeight, &coarserUWeight);
+            Restrict(finerVWeight, &coarserVWeight);
+            Restrict(finerWWeight, &coarserWWeight);
+        }
     }
+
+    m_cachedBoundarySDF = &boundarySDF;
+    m_cachedWeightsSize = size;
+    m_cachedWeightsLevels = m_fluidSDF.size();
+    m_weightCacheValid = m_useWeightCache;
+    m_hasDirtyRegion = false;
 }
 
 void GridFractionalSinglePhasePressureSolver3::DecompressSolution()
@@ -8,10 +8,15 @@
 // personal capacity and are not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <Core/Solver/FDM/FDMCGSolver3.hpp>
 #include <Core/Solver/FDM/FDMICCGSolver3.hpp>
 #include <Core/Solver/Grid/GridBlockedBoundaryConditionSolver3.hpp>
 #include <Core/Solver/Grid/GridSinglePhasePressureSolver3.hpp>
 #include <Core/Utils/LevelSetUtils.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <cassert>
+#include <cmath>
 
 namespace CubbyFlow
 {
@@ -31,18 +36,19 @@ void BuildSingleSystem(FDMMatrix3* A, FDMVector3* b,
     const Vector3D invH = 1.0 / input.GridSpacing();
     Vector3D invHSqr = invH * invH;
 
+    // Fill the RHS with the whole-grid fused divergence kernel; the marker
+    // pass below zeroes the rows that are not fluid.
+    input.DivergenceGrid(b->Accessor());
+
     // Build linear system
     A->ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
         FDMMatrixRow3& row = (*A)(i, j, k);
 
         // initialize
         row.center = row.right = row.up = row.front = 0.0;
-        (*b)(i, j, k) = 0.0;
 
         if (markers(i, j, k) == FLUID)
         {
-            (*b)(i, j, k) = input.DivergenceAtCellCenter(i, j, k);
-
             if (i + 1 < size.x && markers(i + 1, j, k) != BOUNDARY)
             {
                 row.center += invHSqr.x;
@@ -88,12 +94,14 @@ void BuildSingleSystem(FDMMatrix3* A, FDMVector3* b,
         else
         {
             row.center = 1.0;
+            (*b)(i, j, k) = 0.0;
         }
     });
 }
 
 void BuildSingleSystem(MatrixCSRD* A, VectorND* x, VectorND* b,
                        const Array3<char>& markers,
+                       const MarkerBitset3& markerBits,
                        const FaceCenteredGrid3& input)
 {
     Size3 size = input.Resolution();
@@ -101,26 +109,58 @@ void BuildSingleSystem(MatrixCSRD* A, VectorND* x, VectorND* b,
     Vector3D invHSqr = invH * invH;
 
     const ConstArrayAccessor3<char> markerAcc = markers.ConstAccessor();
+    const size_t numberOfCells = size.x * size.y * size.z;
+    const size_t numberOfWords = markerBits.GetNumberOfWords();
 
     A->Clear();
     b->Clear();
 
+    // Both passes below walk the packed markers word by word so that runs of
+    // 32 all-air cells are skipped with a single comparison.
     size_t numRows = 0;
     Array3<size_t> coordToIndex{ size };
-    markers.ForEachIndex([&](size_t i, size_t j, size_t k) {
-        const size_t cIdx = markerAcc.Index(i, j, k);
+    for (size_t wordIdx = 0; wordIdx < numberOfWords; ++wordIdx)
+    {
+        if (markerBits.IsAllAirWord(wordIdx))
+        {
+            continue;
+        }
 
-        if (markerAcc[cIdx] == FLUID)
+        const size_t begin = wordIdx * MarkerBitset3::CELLS_PER_WORD;
+        const size_t end =
+            std::min(begin + MarkerBitset3::CELLS_PER_WORD, numberOfCells);
+        for (size_t cIdx = begin; cIdx < end; ++cIdx)
         {
-            coordToIndex[cIdx] = numRows++;
+            if (markerAcc[cIdx] == FLUID)
+            {
+                coordToIndex[cIdx] = numRows++;
+            }
         }
-    });
+    }
 
-    markers.ForEachIndex([&](size_t i, size_t j, size_t k) {
-        const size_t cIdx = markerAcc.Index(i, j, k);
+    assert(numRows == markerBits.CountFluidCells());
+
+    for (size_t wordIdx = 0; wordIdx < numberOfWords; ++wordIdx)
+    {
+        if (markerBits.IsAllAirWord(wordIdx))
+        {
+            continue;
+        }
 
-        if (markerAcc[cIdx] == FLUID)
+        const size_t wordBegin = wordIdx * MarkerBitset3::CELLS_PER_WORD;
+        const size_t wordEnd =
+            std::min(wordBegin + MarkerBitset3::CELLS_PER_WORD, numberOfCells);
+        for (size_t cIdx = wordBegin; cIdx < wordEnd; ++cIdx)
         {
+            if (markerAcc[cIdx] != FLUID)
+            {
+                continue;
+            }
+
+            const size_t i = cIdx % size.x;
+            const size_t j = (cIdx / size.x) % size.y;
+            const size_t k = cIdx / (size.x * size.y);
+
             b->Append(input.DivergenceAtCellCenter(i, j, k));
 
             std::vector<double> row(1, 0.0);
@@ -200,10 +240,101 @@ void BuildSingleSystem(MatrixCSRD* A, VectorND* x, VectorND* b,
 
             A->AddRow(row, colIdx);
         }
-    });
+    }
 
     x->Resize(b->size(), 0.0);
 }
+
+void BuildSingleSystemRHS(FDMVector3* b, const Array3<char>& markers,
+                          const FaceCenteredGrid3& input)
+{
+    b->ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        (*b)(i, j, k) = (markers(i, j, k) == FLUID)
+                            ? input.DivergenceAtCellCenter(i, j, k)
+                            : 0.0;
+    });
+}
+
+FDMMatrixFreeOperator3 BuildSingleSystemOperator(const Array3<char>& markers,
+                                                 const FaceCenteredGrid3& input)
+{
+    const Size3 size = input.Resolution();
+    const Vector3D invH = 1.0 / input.GridSpacing();
+    const Vector3D invHSqr = invH * invH;
+
+    // The weights below mirror the assembled-matrix version of
+    // BuildSingleSystem row by row; off-diagonal terms from both sides of a
+    // cell are applied here since no neighbor row objects exist to hold them.
+    return [markerAcc = markers.ConstAccessor(), size,
+            invHSqr](const FDMVector3& v, FDMVector3* result) {
+        v.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            if (markerAcc(i, j, k) != FLUID)
+            {
+                (*result)(i, j, k) = v(i, j, k);
+                return;
+            }
+
+            double center = 0.0;
+            double offDiag = 0.0;
+
+            if (i + 1 < size.x && markerAcc(i + 1, j, k) != BOUNDARY)
+            {
+                center += invHSqr.x;
+                if (markerAcc(i + 1, j, k) == FLUID)
+                {
+                    offDiag -= invHSqr.x * v(i + 1, j, k);
+                }
+            }
+
+            if (i > 0 && markerAcc(i - 1, j, k) != BOUNDARY)
+            {
+                center += invHSqr.x;
+                if (markerAcc(i - 1, j, k) == FLUID)
+                {
+                    offDiag -= invHSqr.x * v(i - 1, j, k);
+                }
+            }
+
+            if (j + 1 < size.y && markerAcc(i, j + 1, k) != BOUNDARY)
+            {
+                center += invHSqr.y;
+                if (markerAcc(i, j + 1, k) == FLUID)
+                {
+                    offDiag -= invHSqr.y * v(i, j + 1, k);
+                }
+            }
+
+            if (j > 0 && markerAcc(i, j - 1, k) != BOUNDARY)
+            {
+                center += invHSqr.y;
+                if (markerAcc(i, j - 1, k) == FLUID)
+                {
+                    offDiag -= invHSqr.y * v(i, j - 1, k);
+                }
+            }
+
+            if (k + 1 < size.z && markerAcc(i, j, k + 1) != BOUNDARY)
+            {
+                center += invHSqr.z;
+                if (markerAcc(i, j, k + 1) == FLUID)
+                {
+                    offDiag -= invHSqr.z * v(i, j, k + 1);
+                }
+            }
+
+            if (k > 0 && markerAcc(i, j, k - 1) != BOUNDARY)
+            {
+                center += invHSqr.z;
+                if (markerAcc(i, j, k - 1) == FLUID)
+                {
+                    offDiag -= invHSqr.z * v(i, j, k - 1);
+                }
+            }
+
+            (*result)(i, j, k) = center * v(i, j, k) + offDiag;
+        });
+    };
+}
 }  // namespace
 
 GridSinglePhasePressureSolver3::GridSinglePhasePressureSolver3()
@@ -225,6 +356,62 @@ void GridSinglePhasePressureSolver3::Solve(const FaceCenteredGrid3& input,
     const auto pos = input.CellCenterPosition();
 
     BuildMarkers(input.Resolution(), pos, boundarySDF, fluidSDF);
+
+    if (m_targetDivergence > 0.0 && m_mgSystemSolver == nullptr)
+    {
+        AdaptSolverTolerance();
+    }
+
+    if (m_mgSystemSolver == nullptr)
+    {
+        if (const auto cg =
+                std::dynamic_pointer_cast<FDMCGSolver3>(m_systemSolver))
+        {
+            cg->SetUseInitialGuess(m_useWarmStart);
+        }
+        else if (const auto iccg =
+                     std::dynamic_pointer_cast<FDMICCGSolver3>(m_systemSolver))
+        {
+            iccg->SetUseInitialGuess(m_useWarmStart);
+        }
+    }
+
+    FDMCGSolver3Ptr cgSolver;
+    if (m_useMatrixFree && m_mgSystemSolver == nullptr && !useCompressed)
+    {
+        cgSolver = std::dynamic_pointer_cast<FDMCGSolver3>(m_systemSolver);
+    }
+
+    if (cgSolver != nullptr)
+    {
+        // Matrix-free solve: build the RHS only and let the CG iterations
+        // evaluate the stencil on the fly.
+        m_compSystem.Clear();
+        m_system.A.Clear();
+        m_system.x.Resize(input.Resolution());
+        m_system.b.Resize(input.Resolution());
+
+        BuildSingleSystemRHS(&m_system.b, m_markers[0], input);
+
+        if (m_useWarmStart)
+        {
+            SeedInitialGuess(&m_system.x);
+        }
+
+        cgSolver->SolveMatrixFree(BuildSingleSystemOperator(m_markers[0], input),
+                                  m_system.b, &m_system.x);
+
+        if (m_useWarmStart)
+        {
+            StorePreviousSolution();
+        }
+
+        // Apply pressure gradient
+        ApplyPressureGradient(input, output);
+
+        return;
+    }
+
     BuildSystem(input, useCompressed);
 
     if (m_systemSolver != nullptr)
@@ -235,14 +422,31 @@ void GridSinglePhasePressureSolver3::Solve(const FaceCenteredGrid3& input,
             if (useCompressed)
             {
                 m_system.Clear();
+
+                if (m_useWarmStart)
+                {
+                    SeedCompressedInitialGuess();
+                }
+
                 m_systemSolver->SolveCompressed(&m_compSystem);
                 DecompressSolution();
             }
             else
             {
                 m_compSystem.Clear();
+
+                if (m_useWarmStart)
+                {
+                    SeedInitialGuess(&m_system.x);
+                }
+
                 m_systemSolver->Solve(&m_system);
             }
+
+            if (m_useWarmStart)
+            {
+                StorePreviousSolution();
+            }
         }
         else
         {
@@ -295,6 +499,57 @@ const FDMVector3& GridSinglePhasePressureSolver3::GetPressure() const
     return m_mgSystem.x.levels.front();
 }
 
+bool GridSinglePhasePressureSolver3::GetUseMatrixFree() const
+{
+    return m_useMatrixFree;
+}
+
+void GridSinglePhasePressureSolver3::SetUseMatrixFree(bool useMatrixFree)
+{
+    m_useMatrixFree = useMatrixFree;
+}
+
+bool GridSinglePhasePressureSolver3::GetUseWarmStart() const
+{
+    return m_useWarmStart;
+}
+
+void GridSinglePhasePressureSolver3::SetUseWarmStart(bool useWarmStart)
+{
+    m_useWarmStart = useWarmStart;
+}
+
+bool GridSinglePhasePressureSolver3::GetDivergenceTrackingEnabled() const
+{
+    return m_divergenceTrackingEnabled;
+}
+
+void GridSinglePhasePressureSolver3::SetDivergenceTrackingEnabled(bool enabled)
+{
+    m_divergenceTrackingEnabled = enabled;
+}
+
+double GridSinglePhasePressureSolver3::GetLastMaxDivergence() const
+{
+    return m_lastMaxDivergence;
+}
+
+double GridSinglePhasePressureSolver3::GetLastMeanDivergence() const
+{
+    return m_lastMeanDivergence;
+}
+
+double GridSinglePhasePressureSolver3::GetTargetDivergence() const
+{
+    return m_targetDivergence;
+}
+
+void GridSinglePhasePressureSolver3::SetTargetDivergence(
+    double targetDivergence)
+{
+    m_targetDivergence = std::max(targetDivergence, 0.0);
+}
+
 void GridSinglePhasePressureSolver3::BuildMarkers(
     const Size3& size,
     const std::function<Vector3D(size_t, size_t, size_t)>& pos,
@@ -326,6 +581,9 @@ void GridSinglePhasePressureSolver3::BuildMarkers(
         }
     });
 
+    // Pack the top-level markers for word-parallel queries
+    m_markerBitset.Build(m_markers[0].ConstAccessor());
+
     // Build sub-level markers
     for (size_t l = 1; l < m_markers.size(); ++l)
     {
@@ -398,6 +656,65 @@ void GridSinglePhasePressureSolver3::BuildMarkers(
     }
 }
 
+void GridSinglePhasePressureSolver3::SeedInitialGuess(FDMVector3* x) const
+{
+    if (m_prevPressure.size() != x->size() ||
+        m_prevMarkers.size() != m_markers[0].size())
+    {
+        // No usable previous solution (first call or resized grid).
+        x->Set(0.0);
+        return;
+    }
+
+    x->ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (m_prevMarkers(i, j, k) == FLUID && m_markers[0](i, j, k) == FLUID)
+        {
+            (*x)(i, j, k) = m_prevPressure(i, j, k);
+        }
+        else
+        {
+            (*x)(i, j, k) = 0.0;
+        }
+    });
+}
+
+void GridSinglePhasePressureSolver3::SeedCompressedInitialGuess()
+{
+    if (m_prevPressure.size() != m_markers[0].size() ||
+        m_prevMarkers.size() != m_markers[0].size())
+    {
+        // BuildSystem has already zero-initialized the compressed solution.
+        return;
+    }
+
+    // Rows are assigned to fluid cells in ForEachIndex order, matching the
+    // coordinate-to-index map built in BuildSingleSystem.
+    size_t row = 0;
+    m_markers[0].ForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (m_markers[0](i, j, k) == FLUID)
+        {
+            if (m_prevMarkers(i, j, k) == FLUID)
+            {
+                m_compSystem.x[row] = m_prevPressure(i, j, k);
+            }
+
+            ++row;
+        }
+    });
+}
+
+void GridSinglePhasePressureSolver3::StorePreviousSolution()
+{
+    m_prevPressure = m_system.x;
+    m_prevMarkers = m_markers[0];
+
+    // Force the copy now: the live arrays are rewritten in parallel during
+    // the next BuildSystem pass, and lazily shared storage would make those
+    // writers race on the copy-on-write fault.
+    m_prevPressure.Detach();
+    m_prevMarkers.Detach();
+}
+
 void GridSinglePhasePressureSolver3::DecompressSolution()
 {
     const ConstArrayAccessor3<char> acc = m_markers[0].ConstAccessor();
@@ -448,7 +765,7 @@ void GridSinglePhasePressureSolver3::BuildSystem(const FaceCenteredGrid3& input,
         if (useCompressed)
         {
             BuildSingleSystem(&m_compSystem.A, &m_compSystem.x, &m_compSystem.b,
-                              m_markers[0], *finer);
+                              m_markers[0], m_markerBitset, *finer);
         }
         else
         {
@@ -519,5 +836,104 @@ void GridSinglePhasePressureSolver3::ApplyPressureGradient(
             }
         }
     });
+
+    if (m_divergenceTrackingEnabled || m_targetDivergence > 0.0)
+    {
+        MeasureDivergence(*output);
+    }
+}
+
+void GridSinglePhasePressureSolver3::MeasureDivergence(
+    const FaceCenteredGrid3& output)
+{
+    const Size3 size = m_markers[0].size();
+
+    struct DivergenceStats
+    {
+        double maxAbs;
+        double sumAbs;
+        double count;
+    };
+
+    // The divergence of a cell reads the faces written by its neighbor
+    // iterations, so this sweep has to run after the gradient application
+    // above rather than inside it; the velocity data is still cache-hot.
+    const DivergenceStats total = ParallelReduce(
+        ZERO_SIZE, size.z, DivergenceStats{ 0.0, 0.0, 0.0 },
+        [&](size_t kBegin, size_t kEnd, DivergenceStats init) {
+            DivergenceStats stats = init;
+
+            for (size_t k = kBegin; k < kEnd; ++k)
+            {
+                for (size_t j = 0; j < size.y; ++j)
+                {
+                    for (size_t i = 0; i < size.x; ++i)
+                    {
+                        if (m_markers[0](i, j, k) == FLUID)
+                        {
+                            const double div = std::fabs(
+                                output.DivergenceAtCellCenter(i, j, k));
+
+                            stats.maxAbs = std::max(stats.maxAbs, div);
+                            stats.sumAbs += div;
+                            stats.count += 1.0;
+                        }
+                    }
+                }
+            }
+
+            return stats;
+        },
+        [](const DivergenceStats& a, const DivergenceStats& b) {
+            return DivergenceStats{ std::max(a.maxAbs, b.maxAbs),
+                                    a.sumAbs + b.sumAbs, a.count + b.count };
+        });
+
+    m_lastMaxDivergence = total.maxAbs;
+    m_lastMeanDivergence =
+        (total.count > 0.0) ? total.sumAbs / total.count : 0.0;
+    m_hasDivergenceSample = true;
+}
+
+void GridSinglePhasePressureSolver3::AdaptSolverTolerance()
+{
+    const auto cgSolver =
+        std::dynamic_pointer_cast<FDMCGSolver3>(m_systemSolver);
+    const auto iccgSolver =
+        std::dynamic_pointer_cast<FDMICCGSolver3>(m_systemSolver);
+    if (cgSolver == nullptr && iccgSolver == nullptr)
+    {
+        return;
+    }
+
+    if (m_adaptiveTolerance == 0.0)
+    {
+        // First engagement: remember the configured tolerance as the floor.
+        m_baseTolerance = (cgSolver != nullptr) ? cgSolver->GetTolerance()
+                                                : iccgSolver->GetTolerance();
+        m_adaptiveTolerance = m_baseTolerance;
+    }
+
+    if (m_hasDivergenceSample)
+    {
+        if (m_lastMaxDivergence > m_targetDivergence)
+        {
+            m_adaptiveTolerance =
+                std::max(0.25 * m_adaptiveTolerance, m_baseTolerance);
+        }
+        else if (m_lastMaxDivergence < 0.25 * m_targetDivergence)
+        {
+            m_adaptiveTolerance *= 2.0;
+        }
+    }
+
+    if (cgSolver != nullptr)
+    {
+        cgSolver->SetTolerance(m_adaptiveTolerance);
+    }
+    else
+    {
+        iccgSolver->SetTolerance(m_adaptiveTolerance);
+    }
 }
 }  // namespace CubbyFlow
\ No newline at end of file
@@ -8,8 +8,10 @@
 // personal capacity and are not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <Core/Field/CustomScalarField3.hpp>
 #include <Core/Grid/CellCenteredScalarGrid3.hpp>
 #include <Core/Solver/Grid/GridSmokeSolver3.hpp>
+#include <Core/Utils/Logging.hpp>
 
 namespace CubbyFlow
 {
@@ -91,6 +93,41 @@ void GridSmokeSolver3::SetTemperatureDecayFactor(double newValue)
     m_temperatureDecayFactor = std::clamp(newValue, 0.0, 1.0);
 }
 
+double GridSmokeSolver3::GetVorticityConfinementStrength() const
+{
+    return m_vorticityConfinementStrength;
+}
+
+void GridSmokeSolver3::SetVorticityConfinementStrength(double newStrength)
+{
+    m_vorticityConfinementStrength = std::max(newStrength, 0.0);
+}
+
+bool GridSmokeSolver3::IsUsingActiveRegion() const
+{
+    return m_useActiveRegion;
+}
+
+void GridSmokeSolver3::SetUseActiveRegion(bool useActiveRegion)
+{
+    m_useActiveRegion = useActiveRegion;
+
+    if (!useActiveRegion)
+    {
+        m_activeRegionSDF.reset();
+    }
+}
+
+double GridSmokeSolver3::GetActiveRegionThreshold() const
+{
+    return m_activeRegionThreshold;
+}
+
+void GridSmokeSolver3::SetActiveRegionThreshold(double newThreshold)
+{
+    m_activeRegionThreshold = std::max(newThreshold, 0.0);
+}
+
 ScalarGrid3Ptr GridSmokeSolver3::GetSmokeDensity() const
 {
     return GetGridSystemData()->GetAdvectableScalarDataAt(m_smokeDensityDataID);
@@ -108,13 +145,94 @@ void GridSmokeSolver3::OnEndAdvanceTimeStep(double timeIntervalInSeconds)
 
 void GridSmokeSolver3::ComputeExternalForces(double timeIntervalInSeconds)
 {
+    if (m_useActiveRegion)
+    {
+        UpdateActiveRegion();
+    }
+
     ComputeBuoyancyForce(timeIntervalInSeconds);
+
+    if (m_vorticityConfinementStrength >
+        std::numeric_limits<double>::epsilon())
+    {
+        ComputeVorticityConfinement(timeIntervalInSeconds);
+    }
+}
+
+ScalarField3Ptr GridSmokeSolver3::GetScalarAdvectionBoundary() const
+{
+    if (m_useActiveRegion && m_activeRegionSDF != nullptr)
+    {
+        return m_activeRegionSDF;
+    }
+
+    return GridFluidSolver3::GetScalarAdvectionBoundary();
+}
+
+void GridSmokeSolver3::UpdateActiveRegion()
+{
+    const ScalarGrid3Ptr den = GetSmokeDensity();
+    const ScalarGrid3Ptr temp = GetTemperature();
+    ConstArrayAccessor3<double> denAcc = den->GetConstDataAccessor();
+    ConstArrayAccessor3<double> tempAcc = temp->GetConstDataAccessor();
+
+    m_activeRegion.Build(
+        den->Resolution(), [&](size_t i, size_t j, size_t k) {
+            return std::abs(denAcc(i, j, k)) > m_activeRegionThreshold ||
+                   std::abs(tempAcc(i, j, k)) > m_activeRegionThreshold;
+        });
+    m_activeRegion.AddHalo();
+
+    // Compose the collider SDF with the tile mask so that both the scalar
+    // advection and the diffusion solver treat inactive tiles as boundary
+    // and leave them untouched.
+    const ScalarField3Ptr colliderSDF = GetColliderSDF();
+    const Vector3D origin = den->Origin();
+    const Vector3D gridSpacing = den->GridSpacing();
+    const Size3 resolution = den->Resolution();
+
+    m_activeRegionSDF = std::make_shared<CustomScalarField3>(
+        [this, colliderSDF, origin, gridSpacing,
+         resolution](const Vector3D& pt) {
+            const auto toCell = [](double x, double o, double h, size_t res) {
+                const double s = std::floor((x - o) / h);
+                return std::min(static_cast<size_t>(std::max(s, 0.0)),
+                                res - 1);
+            };
+
+            const size_t i = toCell(pt.x, origin.x, gridSpacing.x,
+                                    resolution.x);
+            const size_t j = toCell(pt.y, origin.y, gridSpacing.y,
+                                    resolution.y);
+            const size_t k = toCell(pt.z, origin.z, gridSpacing.z,
+                                    resolution.z);
+
+            if (!m_activeRegion.IsCellActive(i, j, k))
+            {
+                return -1.0;
+            }
+
+            return colliderSDF->Sample(pt);
+        });
+
+    CUBBYFLOW_INFO << "Active region has "
+                   << m_activeRegion.GetNumberOfActiveTiles() << " of "
+                   << m_activeRegion.GetTileCount().x *
+                          m_activeRegion.GetTileCount().y *
+                          m_activeRegion.GetTileCount().z
+                   << " tiles";
 }
 
 void GridSmokeSolver3::ComputeDiffusion(double timeIntervalInSeconds)
 {
+    const bool restrictToActiveRegion =
+        m_useActiveRegion && m_activeRegionSDF != nullptr;
+
     if (GetDiffusionSolver() != nullptr)
     {
+        const ScalarField3Ptr boundarySDF =
+            restrictToActiveRegion ? m_activeRegionSDF : GetColliderSDF();
+
         if (m_smokeDiffusionCoefficient >
             std::numeric_limits<double>::epsilon())
         {
@@ -125,7 +243,7 @@ void GridSmokeSolver3::ComputeDiffusion(double timeIntervalInSeconds)
 
             GetDiffusionSolver()->Solve(*den0, m_smokeDiffusionCoefficient,
                                         timeIntervalInSeconds, den.get(),
-                                        *GetColliderSDF());
+                                        *boundarySDF);
             ExtrapolateIntoCollider(den.get());
         }
 
@@ -139,17 +257,27 @@ void GridSmokeSolver3::ComputeDiffusion(double timeIntervalInSeconds)
 
             GetDiffusionSolver()->Solve(
                 *temp0, m_temperatureDiffusionCoefficient,
-                timeIntervalInSeconds, temp.get(), *GetColliderSDF());
+                timeIntervalInSeconds, temp.get(), *boundarySDF);
             ExtrapolateIntoCollider(temp.get());
         }
     }
 
     ScalarGrid3Ptr den = GetSmokeDensity();
     den->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (restrictToActiveRegion && !m_activeRegion.IsCellActive(i, j, k))
+        {
+            return;
+        }
+
         (*den)(i, j, k) *= 1.0 - m_smokeDecayFactor;
     });
     ScalarGrid3Ptr temp = GetTemperature();
     temp->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (restrictToActiveRegion && !m_activeRegion.IsCellActive(i, j, k))
+        {
+            return;
+        }
+
         (*temp)(i, j, k) *= 1.0 - m_temperatureDecayFactor;
     });
 }
@@ -187,9 +315,20 @@ void GridSmokeSolver3::ComputeBuoyancyForce(double timeIntervalInSeconds)
         auto vPos = vel->GetVPosition();
         auto wPos = vel->GetWPosition();
 
+        const Size3 resolution = grids->GetResolution();
+        const bool restrictToActiveRegion =
+            m_useActiveRegion && m_activeRegionSDF != nullptr;
+
         if (std::abs(up.x) > std::numeric_limits<double>::epsilon())
         {
             vel->ParallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+                if (restrictToActiveRegion &&
+                    !m_activeRegion.IsCellActive(
+                        std::min(i, resolution.x - 1), j, k))
+                {
+                    return;
+                }
+
                 const Vector3D pt = uPos(i, j, k);
                 const double fBuoy =
                     m_buoyancySmokeDensityFactor * den->Sample(pt) +
@@ -201,6 +340,13 @@ void GridSmokeSolver3::ComputeBuoyancyForce(double timeIntervalInSeconds)
         if (std::abs(up.y) > std::numeric_limits<double>::epsilon())
         {
             vel->ParallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+                if (restrictToActiveRegion &&
+                    !m_activeRegion.IsCellActive(
+                        i, std::min(j, resolution.y - 1), k))
+                {
+                    return;
+                }
+
                 const Vector3D pt = vPos(i, j, k);
                 const double fBuoy =
                     m_buoyancySmokeDensityFactor * den->Sample(pt) +
@@ -212,6 +358,13 @@ void GridSmokeSolver3::ComputeBuoyancyForce(double timeIntervalInSeconds)
         if (std::abs(up.z) > std::numeric_limits<double>::epsilon())
         {
             vel->ParallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+                if (restrictToActiveRegion &&
+                    !m_activeRegion.IsCellActive(
+                        i, j, std::min(k, resolution.z - 1)))
+                {
+                    return;
+                }
+
                 const Vector3D pt = wPos(i, j, k);
                 const double fBuoy =
                     m_buoyancySmokeDensityFactor * den->Sample(pt) +
@@ -224,6 +377,112 @@ void GridSmokeSolver3::ComputeBuoyancyForce(double timeIntervalInSeconds)
     }
 }
 
+void GridSmokeSolver3::ComputeVorticityConfinement(double timeIntervalInSeconds)
+{
+    const GridSystemData3Ptr grids = GetGridSystemData();
+    const FaceCenteredGrid3Ptr vel = grids->GetVelocity();
+    const Size3 resolution = grids->GetResolution();
+
+    if (resolution.x < 3 || resolution.y < 3 || resolution.z < 3)
+    {
+        return;
+    }
+
+    const Vector3D gridSpacing = grids->GetGridSpacing();
+    const double hMin =
+        std::min({ gridSpacing.x, gridSpacing.y, gridSpacing.z });
+    const bool restrictToActiveRegion =
+        m_useActiveRegion && m_activeRegionSDF != nullptr;
+
+    // Pass 1: batch curl at cell centers.
+    m_vorticityScratch.Resize(resolution);
+    vel->CurlGrid(m_vorticityScratch.Accessor());
+
+    ConstArrayAccessor3<Vector3D> vorticity =
+        m_vorticityScratch.ConstAccessor();
+
+    // Pass 2: fused |omega| gradient, normalization and confinement force
+    // per cell: f = epsilon * h * (N x omega) with N = grad|omega| / |.|.
+    m_confinementForceScratch.Resize(resolution);
+    ArrayAccessor3<Vector3D> force = m_confinementForceScratch.Accessor();
+
+    const double strength = m_vorticityConfinementStrength;
+    ParallelFor(
+        ZERO_SIZE, resolution.x, ZERO_SIZE, resolution.y, ZERO_SIZE,
+        resolution.z, [&](size_t i, size_t j, size_t k) {
+            if (restrictToActiveRegion &&
+                !m_activeRegion.IsCellActive(i, j, k))
+            {
+                force(i, j, k) = Vector3D{};
+                return;
+            }
+
+            const size_t im = (i > 0) ? i - 1 : i;
+            const size_t ip = (i + 1 < resolution.x) ? i + 1 : i;
+            const size_t jm = (j > 0) ? j - 1 : j;
+            const size_t jp = (j + 1 < resolution.y) ? j + 1 : j;
+            const size_t km = (k > 0) ? k - 1 : k;
+            const size_t kp = (k + 1 < resolution.z) ? k + 1 : k;
+
+            const Vector3D eta{ (vorticity(ip, j, k).Length() -
+                                 vorticity(im, j, k).Length()) /
+                                    (2.0 * gridSpacing.x),
+                                (vorticity(i, jp, k).Length() -
+                                 vorticity(i, jm, k).Length()) /
+                                    (2.0 * gridSpacing.y),
+                                (vorticity(i, j, kp).Length() -
+                                 vorticity(i, j, km).Length()) /
+                                    (2.0 * gridSpacing.z) };
+
+            const double etaLength = eta.Length();
+            if (etaLength < std::numeric_limits<double>::epsilon())
+            {
+                force(i, j, k) = Vector3D{};
+                return;
+            }
+
+            const Vector3D n = eta / etaLength;
+            force(i, j, k) = strength * hMin * n.Cross(vorticity(i, j, k));
+        });
+
+    // Pass 3: accumulate the cell-centered force onto the interior faces.
+    ConstArrayAccessor3<Vector3D> forceAcc =
+        m_confinementForceScratch.ConstAccessor();
+    ArrayAccessor3<double> u = vel->GetUAccessor();
+    ArrayAccessor3<double> v = vel->GetVAccessor();
+    ArrayAccessor3<double> w = vel->GetWAccessor();
+
+    vel->ParallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        if (i == 0 || i == resolution.x)
+        {
+            return;
+        }
+
+        u(i, j, k) += timeIntervalInSeconds * 0.5 *
+                      (forceAcc(i - 1, j, k).x + forceAcc(i, j, k).x);
+    });
+    vel->ParallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        if (j == 0 || j == resolution.y)
+        {
+            return;
+        }
+
+        v(i, j, k) += timeIntervalInSeconds * 0.5 *
+                      (forceAcc(i, j - 1, k).y + forceAcc(i, j, k).y);
+    });
+    vel->ParallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        if (k == 0 || k == resolution.z)
+        {
+            return;
+        }
+
+        w(i, j, k) += timeIntervalInSeconds * 0.5 *
+                      (forceAcc(i, j, k - 1).z + forceAcc(i, j, k).z);
+    });
+
+    ApplyBoundaryCondition();
+}
+
 GridSmokeSolver3::Builder GridSmokeSolver3::GetBuilder()
 {
     return Builder{};
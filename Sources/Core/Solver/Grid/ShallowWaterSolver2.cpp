@@ -0,0 +1,227 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Solver/Grid/ShallowWaterSolver2.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace CubbyFlow
+{
+ShallowWaterSolver2::ShallowWaterSolver2()
+    : ShallowWaterSolver2{ Size2{ 1, 1 }, Vector2D{ 1.0, 1.0 }, Vector2D{} }
+{
+    // Do nothing
+}
+
+ShallowWaterSolver2::ShallowWaterSolver2(const Size2& resolution,
+                                         const Vector2D& gridSpacing,
+                                         const Vector2D& origin)
+    : m_height{ resolution, gridSpacing, origin },
+      m_terrain{ resolution, gridSpacing, origin },
+      m_velocityU{ resolution, gridSpacing, origin },
+      m_velocityV{ resolution, gridSpacing, origin }
+{
+    // Do nothing
+}
+
+double ShallowWaterSolver2::GetGravity() const
+{
+    return m_gravity;
+}
+
+void ShallowWaterSolver2::SetGravity(double gravity)
+{
+    m_gravity = std::max(gravity, 0.0);
+}
+
+double ShallowWaterSolver2::GetMaxCFL() const
+{
+    return m_maxCFL;
+}
+
+void ShallowWaterSolver2::SetMaxCFL(double cfl)
+{
+    m_maxCFL = std::max(cfl, std::numeric_limits<double>::epsilon());
+}
+
+CellCenteredScalarGrid2& ShallowWaterSolver2::GetHeight()
+{
+    return m_height;
+}
+
+const CellCenteredScalarGrid2& ShallowWaterSolver2::GetHeight() const
+{
+    return m_height;
+}
+
+CellCenteredScalarGrid2& ShallowWaterSolver2::GetTerrain()
+{
+    return m_terrain;
+}
+
+const CellCenteredScalarGrid2& ShallowWaterSolver2::GetTerrain() const
+{
+    return m_terrain;
+}
+
+CellCenteredScalarGrid2& ShallowWaterSolver2::GetVelocityU()
+{
+    return m_velocityU;
+}
+
+const CellCenteredScalarGrid2& ShallowWaterSolver2::GetVelocityU() const
+{
+    return m_velocityU;
+}
+
+CellCenteredScalarGrid2& ShallowWaterSolver2::GetVelocityV()
+{
+    return m_velocityV;
+}
+
+const CellCenteredScalarGrid2& ShallowWaterSolver2::GetVelocityV() const
+{
+    return m_velocityV;
+}
+
+double ShallowWaterSolver2::GetSurfaceHeightAt(const Vector2D& x) const
+{
+    return m_terrain.Sample(x) + m_height.Sample(x);
+}
+
+Vector2D ShallowWaterSolver2::GetVelocityAt(const Vector2D& x) const
+{
+    return Vector2D{ m_velocityU.Sample(x), m_velocityV.Sample(x) };
+}
+
+void ShallowWaterSolver2::CoupleToFLIP(const FLIPSolver3Ptr& solver,
+                                       const BoundingBox3D& region) const
+{
+    const ParticleSystemData3Ptr& particles = solver->GetParticleSystemData();
+    ConstArrayAccessor1<Vector3D> positions = particles->GetPositions();
+    ArrayAccessor1<Vector3D> velocities = particles->GetVelocities();
+
+    ParallelFor(ZERO_SIZE, particles->GetNumberOfParticles(), [&](size_t i) {
+        const Vector3D& pt = positions[i];
+        if (!region.Contains(pt))
+        {
+            return;
+        }
+
+        const Vector2D vel = GetVelocityAt(Vector2D{ pt.x, pt.z });
+        velocities[i].x = vel.x;
+        velocities[i].z = vel.y;
+    });
+}
+
+void ShallowWaterSolver2::OnAdvanceTimeStep(double timeIntervalInSeconds)
+{
+    const Size2 size = m_height.Resolution();
+    const Vector2D invH = 1.0 / m_height.GridSpacing();
+    const auto pos = m_height.GetDataPosition();
+
+    // Semi-Lagrangian advection of depth and velocity along the
+    // depth-averaged flow.
+    const CellCenteredScalarGrid2 h0{ m_height };
+    const CellCenteredScalarGrid2 u0{ m_velocityU };
+    const CellCenteredScalarGrid2 v0{ m_velocityV };
+
+    m_height.ParallelForEachDataPointIndex([&](size_t i, size_t j) {
+        const Vector2D pt = pos(i, j);
+        const Vector2D vel{ u0.Sample(pt), v0.Sample(pt) };
+        const Vector2D back = pt - timeIntervalInSeconds * vel;
+
+        m_height(i, j) = h0.Sample(back);
+        m_velocityU(i, j) = u0.Sample(back);
+        m_velocityV(i, j) = v0.Sample(back);
+    });
+
+    // Accelerate the velocity down the surface-elevation gradient. The
+    // elevation is snapshotted first since the update runs in place.
+    Array2<double> eta{ size };
+    m_height.ParallelForEachDataPointIndex([&](size_t i, size_t j) {
+        eta(i, j) = m_terrain(i, j) + m_height(i, j);
+    });
+
+    const double g = m_gravity;
+    m_height.ParallelForEachDataPointIndex([&](size_t i, size_t j) {
+        const size_t im = (i > 0) ? i - 1 : i;
+        const size_t ip = (i + 1 < size.x) ? i + 1 : i;
+        const size_t jm = (j > 0) ? j - 1 : j;
+        const size_t jp = (j + 1 < size.y) ? j + 1 : j;
+
+        const double gradX =
+            (eta(ip, j) - eta(im, j)) * invH.x / static_cast<double>(ip - im);
+        const double gradY =
+            (eta(i, jp) - eta(i, jm)) * invH.y / static_cast<double>(jp - jm);
+
+        m_velocityU(i, j) -= g * timeIntervalInSeconds * gradX;
+        m_velocityV(i, j) -= g * timeIntervalInSeconds * gradY;
+    });
+
+    // Reflective walls: no flow through the domain border.
+    for (size_t j = 0; j < size.y; ++j)
+    {
+        m_velocityU(0, j) = 0.0;
+        m_velocityU(size.x - 1, j) = 0.0;
+    }
+    for (size_t i = 0; i < size.x; ++i)
+    {
+        m_velocityV(i, 0) = 0.0;
+        m_velocityV(i, size.y - 1) = 0.0;
+    }
+
+    // Update the depth from the velocity divergence. The velocity is
+    // snapshotted so every cell sees the same field.
+    Array2<double> u1{ size };
+    Array2<double> v1{ size };
+    m_height.ParallelForEachDataPointIndex([&](size_t i, size_t j) {
+        u1(i, j) = m_velocityU(i, j);
+        v1(i, j) = m_velocityV(i, j);
+    });
+
+    m_height.ParallelForEachDataPointIndex([&](size_t i, size_t j) {
+        const size_t im = (i > 0) ? i - 1 : i;
+        const size_t ip = (i + 1 < size.x) ? i + 1 : i;
+        const size_t jm = (j > 0) ? j - 1 : j;
+        const size_t jp = (j + 1 < size.y) ? j + 1 : j;
+
+        const double div =
+            (u1(ip, j) - u1(im, j)) * invH.x / static_cast<double>(ip - im) +
+            (v1(i, jp) - v1(i, jm)) * invH.y / static_cast<double>(jp - jm);
+
+        const double h =
+            m_height(i, j) * (1.0 - timeIntervalInSeconds * div);
+        m_height(i, j) = std::max(h, 0.0);
+    });
+}
+
+unsigned int ShallowWaterSolver2::GetNumberOfSubTimeSteps(
+    double timeIntervalInSeconds) const
+{
+    double maxSpeed = 0.0;
+    m_height.ForEachDataPointIndex([&](size_t i, size_t j) {
+        const double speed =
+            std::fabs(m_velocityU(i, j)) + std::fabs(m_velocityV(i, j)) +
+            std::sqrt(m_gravity * std::max(m_height(i, j), 0.0));
+        maxSpeed = std::max(maxSpeed, speed);
+    });
+
+    const Vector2D gridSpacing = m_height.GridSpacing();
+    const double minSpacing = std::min(gridSpacing.x, gridSpacing.y);
+    const double cfl = maxSpeed * timeIntervalInSeconds / minSpacing;
+
+    return std::max(
+        static_cast<unsigned int>(std::ceil(cfl / m_maxCFL)), 1u);
+}
+}  // namespace CubbyFlow
@@ -9,6 +9,8 @@
 // property of any third parties.
 
 #include <Core/Solver/Hybrid/APIC/APICSolver3.hpp>
+#include <Core/Utils/Logging.hpp>
+#include <Core/Utils/Timer.hpp>
 
 namespace CubbyFlow
 {
@@ -36,9 +38,7 @@ void APICSolver3::TransferFromParticlesToGrids()
     const BoundingBox3D& bbox = flow->BoundingBox();
 
     // Allocate buffers
-    m_cX.Resize(numberOfParticles);
-    m_cY.Resize(numberOfParticles);
-    m_cZ.Resize(numberOfParticles);
+    m_c.Resize(9 * numberOfParticles, 0.0);
 
     // Clear velocity to zero
     flow->Fill(Vector3D{});
@@ -75,6 +75,11 @@ void APICSolver3::TransferFromParticlesToGrids()
         std::array<Point3UI, 8> indices{};
         std::array<double, 8> weights{};
 
+        const size_t base = 9 * i;
+        const Vector3D cX{ m_c[base], m_c[base + 1], m_c[base + 2] };
+        const Vector3D cY{ m_c[base + 3], m_c[base + 4], m_c[base + 5] };
+        const Vector3D cZ{ m_c[base + 6], m_c[base + 7], m_c[base + 8] };
+
         Vector3<double> uPosClamped = positions[i];
         uPosClamped.y = std::clamp(uPosClamped.y, bbox.lowerCorner.y + hh.y,
                                    bbox.upperCorner.y - hh.y);
@@ -85,7 +90,7 @@ void APICSolver3::TransferFromParticlesToGrids()
         for (int j = 0; j < 8; ++j)
         {
             Vector3D gridPos = uPos(indices[j].x, indices[j].y, indices[j].z);
-            double apicTerm = m_cX[i].Dot(gridPos - uPosClamped);
+            double apicTerm = cX.Dot(gridPos - uPosClamped);
 
             u(indices[j]) += weights[j] * (velocities[i].x + apicTerm);
             uWeight(indices[j]) += weights[j];
@@ -102,7 +107,7 @@ void APICSolver3::TransferFromParticlesToGrids()
         for (int j = 0; j < 8; ++j)
         {
             Vector3D gridPos = vPos(indices[j].x, indices[j].y, indices[j].z);
-            double apicTerm = m_cY[i].Dot(gridPos - vPosClamped);
+            double apicTerm = cY.Dot(gridPos - vPosClamped);
 
             v(indices[j]) += weights[j] * (velocities[i].y + apicTerm);
             vWeight(indices[j]) += weights[j];
@@ -119,7 +124,7 @@ void APICSolver3::TransferFromParticlesToGrids()
         for (int j = 0; j < 8; ++j)
         {
             Vector3D gridPos = wPos(indices[j].x, indices[j].y, indices[j].z);
-            double apicTerm = m_cZ[i].Dot(gridPos - wPosClamped);
+            double apicTerm = cZ.Dot(gridPos - wPosClamped);
 
             w(indices[j]) += weights[j] * (velocities[i].z + apicTerm);
             wWeight(indices[j]) += weights[j];
@@ -148,22 +153,39 @@ void APICSolver3::TransferFromParticlesToGrids()
 }
 
 void APICSolver3::TransferFromGridsToParticles()
+{
+    TransferFromGridsToParticlesAndMove(0.0);
+}
+
+void APICSolver3::ComputeAdvection(double timeIntervalInSeconds)
+{
+    Timer timer;
+    ExtrapolateVelocityToAir();
+    CUBBYFLOW_INFO << "ExtrapolateVelocityToAir took "
+                   << timer.DurationInSeconds() << " seconds";
+
+    ApplyBoundaryCondition();
+
+    timer.Reset();
+    TransferFromGridsToParticlesAndMove(timeIntervalInSeconds);
+    CUBBYFLOW_INFO << "TransferFromGridsToParticlesAndMove took "
+                   << timer.DurationInSeconds() << " seconds";
+}
+
+void APICSolver3::TransferFromGridsToParticlesAndMove(
+    double timeIntervalInSeconds)
 {
     FaceCenteredGrid3Ptr flow = GetGridSystemData()->GetVelocity();
     const ParticleSystemData3Ptr particles = GetParticleSystemData();
-    const ArrayAccessor1<Vector3<double>> positions = particles->GetPositions();
+    ArrayAccessor1<Vector3<double>> positions = particles->GetPositions();
     ArrayAccessor1<Vector3<double>> velocities = particles->GetVelocities();
     const size_t numberOfParticles = particles->GetNumberOfParticles();
     const Vector3<double> hh = flow->GridSpacing() / 2.0;
     const BoundingBox3D& bbox = flow->BoundingBox();
+    const int domainBoundaryFlag = GetClosedDomainBoundaryFlag();
 
     // Allocate buffers
-    m_cX.Resize(numberOfParticles);
-    m_cY.Resize(numberOfParticles);
-    m_cZ.Resize(numberOfParticles);
-    m_cX.Set(Vector3D{});
-    m_cY.Set(Vector3D{});
-    m_cZ.Set(Vector3D{});
+    m_c.Resize(9 * numberOfParticles, 0.0);
 
     ArrayAccessor3<double> u = flow->GetUAccessor();
     ArrayAccessor3<double> v = flow->GetVAccessor();
@@ -175,9 +197,19 @@ void APICSolver3::TransferFromGridsToParticles()
                                                   flow->GetVOrigin() };
     LinearArraySampler3<double, double> wSampler{ w, flow->GridSpacing(),
                                                   flow->GetWOrigin() };
+    const auto sample = [&](const Vector3D& pt) {
+        return Vector3D{ uSampler(pt), vSampler(pt), wSampler(pt) };
+    };
+
+    const ParticleIntegrator integrator = GetParticleIntegrator();
+    const unsigned int maxSubSteps =
+        static_cast<unsigned int>(std::max(GetMaxCFL(), 1.0));
+    const double minSpacing = flow->GridSpacing().Min();
 
     ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
-        velocities[i] = flow->Sample(positions[i]);
+        velocities[i] = sample(positions[i]);
+
+        Vector3D cX, cY, cZ;
 
         std::array<Point3UI, 8> indices{};
         std::array<Vector3D, 8> gradWeights{};
@@ -193,7 +225,7 @@ void APICSolver3::TransferFromGridsToParticles()
 
         for (int j = 0; j < 8; ++j)
         {
-            m_cX[i] += gradWeights[j] * u(indices[j]);
+            cX += gradWeights[j] * u(indices[j]);
         }
 
         // y
@@ -207,7 +239,7 @@ void APICSolver3::TransferFromGridsToParticles()
 
         for (int j = 0; j < 8; ++j)
         {
-            m_cY[i] += gradWeights[j] * v(indices[j]);
+            cY += gradWeights[j] * v(indices[j]);
         }
 
         // z
@@ -221,9 +253,116 @@ void APICSolver3::TransferFromGridsToParticles()
 
         for (int j = 0; j < 8; ++j)
         {
-            m_cZ[i] += gradWeights[j] * w(indices[j]);
+            cZ += gradWeights[j] * w(indices[j]);
+        }
+
+        const size_t base = 9 * i;
+        m_c[base] = cX.x;
+        m_c[base + 1] = cX.y;
+        m_c[base + 2] = cX.z;
+        m_c[base + 3] = cY.x;
+        m_c[base + 4] = cY.y;
+        m_c[base + 5] = cY.z;
+        m_c[base + 6] = cZ.x;
+        m_c[base + 7] = cZ.y;
+        m_c[base + 8] = cZ.z;
+
+        if (timeIntervalInSeconds <= 0.0)
+        {
+            return;
+        }
+
+        // Move the particle while its grid samples are still hot.
+        Vector3D pt0 = positions[i];
+        Vector3D pt1 = pt0;
+        Vector3D vel = velocities[i];
+
+        // Adaptive time-stepping
+        unsigned int numSubSteps = maxSubSteps;
+        if (integrator == ParticleIntegrator::Adaptive)
+        {
+            const double cfl =
+                vel.Length() * timeIntervalInSeconds / minSpacing;
+            numSubSteps = std::clamp(
+                static_cast<unsigned int>(std::ceil(cfl)), 1u, maxSubSteps);
+        }
+
+        const double dt = timeIntervalInSeconds / numSubSteps;
+        for (unsigned int t = 0; t < numSubSteps; ++t)
+        {
+            Vector3D vel0 = sample(pt0);
+
+            if (integrator == ParticleIntegrator::RungeKutta3)
+            {
+                // Ralston's third-order rule
+                Vector3D midVel = sample(pt0 + 0.5 * dt * vel0);
+                Vector3D lastVel = sample(pt0 + 0.75 * dt * midVel);
+                pt1 = pt0 +
+                      dt / 9.0 * (2.0 * vel0 + 3.0 * midVel + 4.0 * lastVel);
+            }
+            else
+            {
+                // Mid-point rule
+                Vector3D midPt = pt0 + 0.5 * dt * vel0;
+                Vector3D midVel = sample(midPt);
+                pt1 = pt0 + dt * midVel;
+            }
+
+            pt0 = pt1;
+        }
+
+        if ((domainBoundaryFlag & DIRECTION_LEFT) &&
+            pt1.x <= bbox.lowerCorner.x)
+        {
+            pt1.x = bbox.lowerCorner.x;
+            vel.x = 0.0;
+        }
+        if ((domainBoundaryFlag & DIRECTION_RIGHT) &&
+            pt1.x >= bbox.upperCorner.x)
+        {
+            pt1.x = bbox.upperCorner.x;
+            vel.x = 0.0;
         }
+        if ((domainBoundaryFlag & DIRECTION_DOWN) &&
+            pt1.y <= bbox.lowerCorner.y)
+        {
+            pt1.y = bbox.lowerCorner.y;
+            vel.y = 0.0;
+        }
+        if ((domainBoundaryFlag & DIRECTION_UP) && pt1.y >= bbox.upperCorner.y)
+        {
+            pt1.y = bbox.upperCorner.y;
+            vel.y = 0.0;
+        }
+        if ((domainBoundaryFlag & DIRECTION_BACK) &&
+            pt1.z <= bbox.lowerCorner.z)
+        {
+            pt1.z = bbox.lowerCorner.z;
+            vel.z = 0.0;
+        }
+        if ((domainBoundaryFlag & DIRECTION_FRONT) &&
+            pt1.z >= bbox.upperCorner.z)
+        {
+            pt1.z = bbox.upperCorner.z;
+            vel.z = 0.0;
+        }
+
+        positions[i] = pt1;
+        velocities[i] = vel;
     });
+
+    if (timeIntervalInSeconds <= 0.0)
+    {
+        return;
+    }
+
+    Collider3Ptr col = GetCollider();
+    if (col != nullptr)
+    {
+        ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+            col->ResolveCollision(0.0, 0.0, &positions[i], &velocities[i]);
+        });
+    }
 }
 
 APICSolver3::Builder APICSolver3::GetBuilder()
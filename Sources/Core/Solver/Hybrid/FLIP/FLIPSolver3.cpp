@@ -10,6 +10,9 @@
 
 #include <Core/Solver/Hybrid/FLIP/FLIPSolver3.hpp>
 
+#include <algorithm>
+#include <limits>
+
 namespace CubbyFlow
 {
 FLIPSolver3::FLIPSolver3()
@@ -35,28 +38,39 @@ void FLIPSolver3::SetPICBlendingFactor(double factor)
     m_picBlendingFactor = std::clamp(factor, 0.0, 1.0);
 }
 
+bool FLIPSolver3::GetUseVorticityAdaptiveBlending() const
+{
+    return m_useVorticityAdaptiveBlending;
+}
+
+void FLIPSolver3::SetUseVorticityAdaptiveBlending(bool useAdaptiveBlending)
+{
+    m_useVorticityAdaptiveBlending = useAdaptiveBlending;
+}
+
 void FLIPSolver3::TransferFromParticlesToGrids()
 {
     PICSolver3::TransferFromParticlesToGrids();
 
-    // Store snapshot
+    // Store snapshot. Single precision is plenty for the reference values the
+    // delta is formed against and halves the snapshot traffic.
     const FaceCenteredGrid3Ptr vel = GetGridSystemData()->GetVelocity();
-    ConstArrayAccessor3<double> u =
-        GetGridSystemData()->GetVelocity()->GetUConstAccessor();
-    ConstArrayAccessor3<double> v =
-        GetGridSystemData()->GetVelocity()->GetVConstAccessor();
-    ConstArrayAccessor3<double> w =
-        GetGridSystemData()->GetVelocity()->GetWConstAccessor();
-    m_uDelta.Resize(u.size());
-    m_vDelta.Resize(v.size());
-    m_wDelta.Resize(w.size());
-
-    vel->ParallelForEachUIndex(
-        [&](size_t i, size_t j, size_t k) { m_uDelta(i, j, k) = u(i, j, k); });
-    vel->ParallelForEachVIndex(
-        [&](size_t i, size_t j, size_t k) { m_vDelta(i, j, k) = v(i, j, k); });
-    vel->ParallelForEachWIndex(
-        [&](size_t i, size_t j, size_t k) { m_wDelta(i, j, k) = w(i, j, k); });
+    ConstArrayAccessor3<double> u = vel->GetUConstAccessor();
+    ConstArrayAccessor3<double> v = vel->GetVConstAccessor();
+    ConstArrayAccessor3<double> w = vel->GetWConstAccessor();
+    m_uSnapshot.Resize(u.size());
+    m_vSnapshot.Resize(v.size());
+    m_wSnapshot.Resize(w.size());
+
+    vel->ParallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        m_uSnapshot(i, j, k) = static_cast<float>(u(i, j, k));
+    });
+    vel->ParallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        m_vSnapshot(i, j, k) = static_cast<float>(v(i, j, k));
+    });
+    vel->ParallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        m_wSnapshot(i, j, k) = static_cast<float>(w(i, j, k));
+    });
 }
 
 void FLIPSolver3::TransferFromGridsToParticles()
@@ -69,51 +83,130 @@ void FLIPSolver3::TransferFromGridsToParticles()
     const size_t numberOfParticles =
         GetParticleSystemData()->GetNumberOfParticles();
 
-    // Compute delta
-    flow->ParallelForEachUIndex([&](size_t i, size_t j, size_t k) {
-        m_uDelta(i, j, k) = flow->GetU(i, j, k) - m_uDelta(i, j, k);
-    });
-
-    flow->ParallelForEachVIndex([&](size_t i, size_t j, size_t k) {
-        m_vDelta(i, j, k) = flow->GetV(i, j, k) - m_vDelta(i, j, k);
-    });
-
-    flow->ParallelForEachWIndex([&](size_t i, size_t j, size_t k) {
-        m_wDelta(i, j, k) = flow->GetW(i, j, k) - m_wDelta(i, j, k);
-    });
-
-    LinearArraySampler3<double, double> uSampler{
-        m_uDelta.ConstAccessor(), flow->GridSpacing().CastTo<double>(),
-        flow->GetUOrigin().CastTo<double>()
+    // Sleeping particles keep their resting velocity on the FLIP path too;
+    // in a settled region the delta is noise-level anyway.
+    const ConstArrayAccessor1<char> sleeping =
+        GetParticleSystemData()->GetActivityStates();
+    const bool useSleeping =
+        GetUseParticleSleeping() && sleeping.size() == numberOfParticles;
+
+    // The delta is formed per particle as (new grid sample) - (snapshot
+    // sample); since trilinear sampling is linear, this matches sampling a
+    // precomputed delta grid without ever writing one.
+    LinearArraySampler3<float, double> uSnapshotSampler{
+        m_uSnapshot.ConstAccessor(), flow->GridSpacing(), flow->GetUOrigin()
     };
-    LinearArraySampler3<double, double> vSampler{
-        m_vDelta.ConstAccessor(), flow->GridSpacing().CastTo<double>(),
-        flow->GetVOrigin().CastTo<double>()
+    LinearArraySampler3<float, double> vSnapshotSampler{
+        m_vSnapshot.ConstAccessor(), flow->GridSpacing(), flow->GetVOrigin()
     };
-    LinearArraySampler3<double, double> wSampler{
-        m_wDelta.ConstAccessor(), flow->GridSpacing().CastTo<double>(),
-        flow->GetWOrigin().CastTo<double>()
+    LinearArraySampler3<float, double> wSnapshotSampler{
+        m_wSnapshot.ConstAccessor(), flow->GridSpacing(), flow->GetWOrigin()
     };
 
-    auto sampler = [uSampler, vSampler, wSampler](const Vector3D& x) {
-        const Vector3<double> xf = x.CastTo<double>();
-        const double u = uSampler(xf);
-        const double v = vSampler(xf);
-        const double w = wSampler(xf);
-        return Vector3D{ u, v, w };
+    auto snapshotSampler = [uSnapshotSampler, vSnapshotSampler,
+                            wSnapshotSampler](const Vector3D& x) {
+        return Vector3D{ uSnapshotSampler(x), vSnapshotSampler(x),
+                         wSnapshotSampler(x) };
     };
 
-    // Transfer delta to the particles
-    ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
-        Vector3D flipVel = velocities[i] + sampler(positions[i]);
+    if (m_useVorticityAdaptiveBlending)
+    {
+        UpdateBlendWeights(flow);
+
+        LinearArraySampler3<double, double> weightSampler{
+            m_blendWeights.ConstAccessor(), m_blendWeightsSpacing,
+            m_blendWeightsOrigin
+        };
+
+        ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+            if (useSleeping && sleeping[i] != 0)
+            {
+                return;
+            }
+
+            const Vector3D picVel = flow->Sample(positions[i]);
+            const Vector3D flipVel =
+                velocities[i] + picVel - snapshotSampler(positions[i]);
+            velocities[i] =
+                Lerp(flipVel, picVel, weightSampler(positions[i]));
+        });
+    }
+    else
+    {
+        ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+            if (useSleeping && sleeping[i] != 0)
+            {
+                return;
+            }
 
-        if (m_picBlendingFactor > 0.0)
-        {
             const Vector3D picVel = flow->Sample(positions[i]);
-            flipVel = Lerp(flipVel, picVel, m_picBlendingFactor);
-        }
+            Vector3D flipVel =
+                velocities[i] + picVel - snapshotSampler(positions[i]);
+
+            if (m_picBlendingFactor > 0.0)
+            {
+                flipVel = Lerp(flipVel, picVel, m_picBlendingFactor);
+            }
+
+            velocities[i] = flipVel;
+        });
+    }
+}
+
+void FLIPSolver3::UpdateBlendWeights(const FaceCenteredGrid3Ptr& flow)
+{
+    // One weight cell per 4^3 velocity cells is plenty of resolution for a
+    // blend factor and keeps the vorticity probing cheap.
+    constexpr size_t BLEND_COARSENING = 4;
+
+    const Size3 resolution = flow->Resolution();
+
+    // The curl probe interpolates between neighboring cell centers, which
+    // needs at least two cells per axis; a degenerate grid has no resolvable
+    // vorticity anyway, so fall back to the configured uniform blend.
+    if (resolution.x < 2 || resolution.y < 2 || resolution.z < 2)
+    {
+        m_blendWeights.Resize(Size3{ 1, 1, 1 });
+        m_blendWeights.Set(m_picBlendingFactor);
+        m_blendWeightsSpacing =
+            flow->GridSpacing() * static_cast<double>(BLEND_COARSENING);
+        m_blendWeightsOrigin = flow->Origin() + 0.5 * m_blendWeightsSpacing;
+        return;
+    }
+    const Size3 coarseResolution{
+        (resolution.x + BLEND_COARSENING - 1) / BLEND_COARSENING,
+        (resolution.y + BLEND_COARSENING - 1) / BLEND_COARSENING,
+        (resolution.z + BLEND_COARSENING - 1) / BLEND_COARSENING
+    };
+
+    m_blendWeightsSpacing =
+        flow->GridSpacing() * static_cast<double>(BLEND_COARSENING);
+    m_blendWeightsOrigin = flow->Origin() + 0.5 * m_blendWeightsSpacing;
+
+    m_blendWeights.Resize(coarseResolution);
+    m_blendWeights.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D pos{
+            m_blendWeightsOrigin.x + i * m_blendWeightsSpacing.x,
+            m_blendWeightsOrigin.y + j * m_blendWeightsSpacing.y,
+            m_blendWeightsOrigin.z + k * m_blendWeightsSpacing.z
+        };
+        m_blendWeights(i, j, k) = flow->Curl(pos).Length();
+    });
+
+    double maxVorticity = 0.0;
+    m_blendWeights.ForEach(
+        [&](double value) { maxVorticity = std::max(maxVorticity, value); });
+
+    if (maxVorticity < std::numeric_limits<double>::epsilon())
+    {
+        m_blendWeights.Set(m_picBlendingFactor);
+        return;
+    }
 
-        velocities[i] = flipVel;
+    // Quiescent regions get the full configured PIC amount; the most
+    // vortical region gets pure FLIP.
+    m_blendWeights.ParallelForEach([&](double& value) {
+        value = m_picBlendingFactor * (1.0 - value / maxVorticity);
     });
 }
 
@@ -12,10 +12,17 @@
 #include <Core/Grid/CellCenteredScalarGrid3.hpp>
 #include <Core/Solver/Hybrid/PIC/PICSolver3.hpp>
 #include <Core/Utils/Logging.hpp>
+#include <Core/Utils/Parallel.hpp>
 #include <Core/Utils/Timer.hpp>
 
 namespace CubbyFlow
 {
+namespace
+{
+//! Number of consecutive resting time-steps before a particle falls asleep.
+constexpr size_t SLEEP_FRAME_COUNT = 10;
+}  // namespace
+
 PICSolver3::PICSolver3() : PICSolver3{ { 1, 1, 1 }, { 1, 1, 1 }, { 0, 0, 0 } }
 {
     // Do nothing
@@ -53,6 +60,46 @@ void PICSolver3::SetParticleEmitter(const ParticleEmitter3Ptr& newEmitter)
     newEmitter->SetTarget(m_particles);
 }
 
+bool PICSolver3::GetUseGatherModeTransfer() const
+{
+    return m_useGatherModeTransfer;
+}
+
+void PICSolver3::SetUseGatherModeTransfer(bool isOn)
+{
+    m_useGatherModeTransfer = isOn;
+}
+
+bool PICSolver3::GetUseParticleSleeping() const
+{
+    return m_useParticleSleeping;
+}
+
+void PICSolver3::SetUseParticleSleeping(bool isOn)
+{
+    m_useParticleSleeping = isOn;
+}
+
+double PICSolver3::GetSleepThresholdFactor() const
+{
+    return m_sleepThresholdFactor;
+}
+
+void PICSolver3::SetSleepThresholdFactor(double factor)
+{
+    m_sleepThresholdFactor = std::max(factor, 0.0);
+}
+
+PICSolver3::ParticleIntegrator PICSolver3::GetParticleIntegrator() const
+{
+    return m_particleIntegrator;
+}
+
+void PICSolver3::SetParticleIntegrator(ParticleIntegrator integrator)
+{
+    m_particleIntegrator = integrator;
+}
+
 void PICSolver3::OnInitialize()
 {
     GridFluidSolver3::OnInitialize();
@@ -76,6 +123,14 @@ void PICSolver3::OnBeginAdvanceTimeStep(double timeIntervalInSeconds)
     CUBBYFLOW_INFO << "Number of PIC-type particles: "
                    << m_particles->GetNumberOfParticles();
 
+    if (m_useParticleSleeping)
+    {
+        timer.Reset();
+        UpdateParticleActivityStates(timeIntervalInSeconds);
+        CUBBYFLOW_INFO << "UpdateParticleActivityStates took "
+                       << timer.DurationInSeconds() << " seconds";
+    }
+
     timer.Reset();
     TransferFromParticlesToGrids();
     CUBBYFLOW_INFO << "TransferFromParticlesToGrids took "
@@ -121,11 +176,21 @@ ScalarField3Ptr PICSolver3::GetFluidSDF() const
 
 void PICSolver3::TransferFromParticlesToGrids()
 {
+    if (m_useGatherModeTransfer)
+    {
+        TransferFromParticlesToGridsGather();
+        return;
+    }
+
     FaceCenteredGrid3Ptr flow = GetGridSystemData()->GetVelocity();
     ArrayAccessor1<Vector3<double>> positions = m_particles->GetPositions();
     ArrayAccessor1<Vector3<double>> velocities = m_particles->GetVelocities();
     size_t numberOfParticles = m_particles->GetNumberOfParticles();
 
+    const ConstArrayAccessor1<char> sleeping = m_particles->GetActivityStates();
+    const bool useSleeping =
+        m_useParticleSleeping && sleeping.size() == numberOfParticles;
+
     // Clear velocity to zero
     flow->Fill(Vector3D{});
 
@@ -158,27 +223,41 @@ void PICSolver3::TransferFromParticlesToGrids()
         std::array<Point3UI, 8> indices{};
         std::array<double, 8> weights{};
 
+        // Sleeping particles keep marking their faces as fluid but skip the
+        // velocity accumulation; their residual speed sits below the sleep
+        // threshold, so their settled cells effectively freeze at rest.
+        const bool asleep = useSleeping && sleeping[i] != 0;
+
         uSampler.GetCoordinatesAndWeights(positions[i], &indices, &weights);
         for (int j = 0; j < 8; ++j)
         {
-            u(indices[j]) += velocities[i].x * weights[j];
-            uWeight(indices[j]) += weights[j];
+            if (!asleep)
+            {
+                u(indices[j]) += velocities[i].x * weights[j];
+                uWeight(indices[j]) += weights[j];
+            }
             m_uMarkers(indices[j]) = 1;
         }
 
         vSampler.GetCoordinatesAndWeights(positions[i], &indices, &weights);
         for (int j = 0; j < 8; ++j)
         {
-            v(indices[j]) += velocities[i].y * weights[j];
-            vWeight(indices[j]) += weights[j];
+            if (!asleep)
+            {
+                v(indices[j]) += velocities[i].y * weights[j];
+                vWeight(indices[j]) += weights[j];
+            }
             m_vMarkers(indices[j]) = 1;
         }
 
         wSampler.GetCoordinatesAndWeights(positions[i], &indices, &weights);
         for (int j = 0; j < 8; ++j)
         {
-            w(indices[j]) += velocities[i].z * weights[j];
-            wWeight(indices[j]) += weights[j];
+            if (!asleep)
+            {
+                w(indices[j]) += velocities[i].z * weights[j];
+                wWeight(indices[j]) += weights[j];
+            }
             m_wMarkers(indices[j]) = 1;
         }
     }
@@ -203,15 +282,286 @@ void PICSolver3::TransferFromParticlesToGrids()
     });
 }
 
-void PICSolver3::TransferFromGridsToParticles()
+void PICSolver3::TransferFromParticlesToGridsGather()
 {
     FaceCenteredGrid3Ptr flow = GetGridSystemData()->GetVelocity();
     ArrayAccessor1<Vector3<double>> positions = m_particles->GetPositions();
     ArrayAccessor1<Vector3<double>> velocities = m_particles->GetVelocities();
     const size_t numberOfParticles = m_particles->GetNumberOfParticles();
 
+    const ConstArrayAccessor1<char> sleeping = m_particles->GetActivityStates();
+    const bool useSleeping =
+        m_useParticleSleeping && sleeping.size() == numberOfParticles;
+
+    const Size3 resolution = GetResolution();
+    const Vector3D gridSpacing = flow->GridSpacing();
+    const Vector3D invGridSpacing{ 1.0 / gridSpacing.x, 1.0 / gridSpacing.y,
+                                   1.0 / gridSpacing.z };
+    const Vector3D origin = flow->Origin();
+
+    ArrayAccessor3<double> u = flow->GetUAccessor();
+    ArrayAccessor3<double> v = flow->GetVAccessor();
+    ArrayAccessor3<double> w = flow->GetWAccessor();
+    m_uMarkers.Resize(u.size());
+    m_vMarkers.Resize(v.size());
+    m_wMarkers.Resize(w.size());
+
+    // Bin particle indices per grid cell (a flat counting sort), so every
+    // face can gather from a bounded neighborhood below. The per-cell counts
+    // come from the particle system's histogram, which doubles as the cost
+    // model for the load-balanced face loops further down.
+    const size_t numberOfBins = resolution.x * resolution.y * resolution.z;
+    Array3<size_t> histogram;
+    m_particles->ComputeParticleCountHistogram(resolution, origin, gridSpacing,
+                                               &histogram);
+    const size_t* cellCounts = histogram.ConstAccessor().data();
+
+    std::vector<size_t> binStart(numberOfBins + 1, 0);
+    std::vector<size_t> binnedIndices(numberOfParticles);
+    std::vector<size_t> binOf(numberOfParticles);
+
+    const auto cellOf = [&](const Vector3D& pt) {
+        const auto ci = static_cast<size_t>(std::clamp(
+            std::floor((pt.x - origin.x) * invGridSpacing.x), 0.0,
+            static_cast<double>(resolution.x - 1)));
+        const auto cj = static_cast<size_t>(std::clamp(
+            std::floor((pt.y - origin.y) * invGridSpacing.y), 0.0,
+            static_cast<double>(resolution.y - 1)));
+        const auto ck = static_cast<size_t>(std::clamp(
+            std::floor((pt.z - origin.z) * invGridSpacing.z), 0.0,
+            static_cast<double>(resolution.z - 1)));
+        return (ck * resolution.y + cj) * resolution.x + ci;
+    };
+
     ParallelFor(ZERO_SIZE, numberOfParticles,
-                [&](size_t i) { velocities[i] = flow->Sample(positions[i]); });
+                [&](size_t i) { binOf[i] = cellOf(positions[i]); });
+
+    for (size_t bin = 0; bin < numberOfBins; ++bin)
+    {
+        binStart[bin + 1] = binStart[bin] + cellCounts[bin];
+    }
+    {
+        std::vector<size_t> cursor{ binStart };
+        for (size_t i = 0; i < numberOfParticles; ++i)
+        {
+            binnedIndices[cursor[binOf[i]]++] = i;
+        }
+    }
+
+    // Particle count per z-slab of cells. A face at slab k gathers from the
+    // cell slabs k - 1 .. k + 1, so the per-slab gather cost is the windowed
+    // sum plus a constant per-face term that keeps empty slabs from
+    // collapsing to zero-width chunks.
+    std::vector<double> slabCount(resolution.z, 0.0);
+    for (size_t k = 0; k < resolution.z; ++k)
+    {
+        size_t count = 0;
+        const size_t slabBegin = (k * resolution.y) * resolution.x;
+        const size_t slabEnd = ((k + 1) * resolution.y) * resolution.x;
+        for (size_t bin = slabBegin; bin < slabEnd; ++bin)
+        {
+            count += cellCounts[bin];
+        }
+        slabCount[k] = static_cast<double>(count);
+    }
+
+    const auto slabCost = [&](size_t k) {
+        const size_t kc = std::min(k, resolution.z - 1);
+        double cost = 1.0 + slabCount[kc];
+        if (kc > 0)
+        {
+            cost += slabCount[kc - 1];
+        }
+        if (kc + 1 < resolution.z)
+        {
+            cost += slabCount[kc + 1];
+        }
+        return cost;
+    };
+
+    // Each face gathers from the 3x3x3 cells that can hold particles within
+    // its linear kernel support. The per-axis weight replicates the scatter
+    // path exactly: barycentric coordinates are clamped into the node range,
+    // and a face belongs to a particle's stencil — and thus gets marked —
+    // even when the clamped weight degenerates to zero.
+    const auto axisWeight = [](double normalized, size_t node, size_t size,
+                               double* weight) {
+        const double s = std::floor(normalized);
+        size_t base;
+        double f;
+
+        if (size == 1 || s < 0.0)
+        {
+            base = 0;
+            f = 0.0;
+        }
+        else if (s > static_cast<double>(size - 2))
+        {
+            base = size - 2;
+            f = 1.0;
+        }
+        else
+        {
+            base = static_cast<size_t>(s);
+            f = normalized - s;
+        }
+
+        const size_t next = std::min(base + 1, size - 1);
+
+        if (node != base && node != next)
+        {
+            return false;
+        }
+
+        *weight = 0.0;
+        if (node == base)
+        {
+            *weight += 1.0 - f;
+        }
+        if (node == next)
+        {
+            *weight += f;
+        }
+        return true;
+    };
+
+    const auto gather = [&](const Vector3D& faceOrigin, const Size3& faceSize,
+                            size_t fi, size_t fj, size_t fk, auto&& value,
+                            double* result) {
+        const Vector3D facePos =
+            faceOrigin + Vector3D{ fi * gridSpacing.x, fj * gridSpacing.y,
+                                   fk * gridSpacing.z };
+
+        const auto ci = static_cast<size_t>(std::clamp(
+            std::floor((facePos.x - origin.x) * invGridSpacing.x), 0.0,
+            static_cast<double>(resolution.x - 1)));
+        const auto cj = static_cast<size_t>(std::clamp(
+            std::floor((facePos.y - origin.y) * invGridSpacing.y), 0.0,
+            static_cast<double>(resolution.y - 1)));
+        const auto ck = static_cast<size_t>(std::clamp(
+            std::floor((facePos.z - origin.z) * invGridSpacing.z), 0.0,
+            static_cast<double>(resolution.z - 1)));
+
+        const size_t iBegin = (ci > 0) ? ci - 1 : 0;
+        const size_t jBegin = (cj > 0) ? cj - 1 : 0;
+        const size_t kBegin = (ck > 0) ? ck - 1 : 0;
+        const size_t iEnd = std::min(ci + 2, resolution.x);
+        const size_t jEnd = std::min(cj + 2, resolution.y);
+        const size_t kEnd = std::min(ck + 2, resolution.z);
+
+        double sum = 0.0;
+        double weightSum = 0.0;
+        bool marked = false;
+
+        for (size_t k = kBegin; k < kEnd; ++k)
+        {
+            for (size_t j = jBegin; j < jEnd; ++j)
+            {
+                for (size_t i = iBegin; i < iEnd; ++i)
+                {
+                    const size_t bin =
+                        (k * resolution.y + j) * resolution.x + i;
+
+                    for (size_t cursor = binStart[bin];
+                         cursor < binStart[bin + 1]; ++cursor)
+                    {
+                        const size_t p = binnedIndices[cursor];
+                        const Vector3D& pt = positions[p];
+
+                        double wx, wy, wz;
+                        if (!axisWeight(
+                                (pt.x - faceOrigin.x) * invGridSpacing.x,
+                                fi, faceSize.x, &wx) ||
+                            !axisWeight(
+                                (pt.y - faceOrigin.y) * invGridSpacing.y,
+                                fj, faceSize.y, &wy) ||
+                            !axisWeight(
+                                (pt.z - faceOrigin.z) * invGridSpacing.z,
+                                fk, faceSize.z, &wz))
+                        {
+                            continue;
+                        }
+
+                        marked = true;
+
+                        // Matches the scatter path: sleeping particles mark
+                        // their faces but contribute no velocity or weight.
+                        if (useSleeping && sleeping[p] != 0)
+                        {
+                            continue;
+                        }
+
+                        const double weight = wx * wy * wz;
+                        sum += value(p) * weight;
+                        weightSum += weight;
+                    }
+                }
+            }
+        }
+
+        *result = (weightSum > 0.0) ? sum / weightSum : 0.0;
+        return marked;
+    };
+
+    // Split each face loop by z-slab with chunks sized by the histogram
+    // cost model, so workers covering dense particle clusters get fewer
+    // slabs than workers covering empty space.
+    const auto gatherComponent = [&](const Vector3D& faceOrigin,
+                                     const Size3& faceSize,
+                                     ArrayAccessor3<double> component,
+                                     ArrayAccessor3<char> markers,
+                                     auto&& value) {
+        ParallelRangeForWeighted(
+            ZERO_SIZE, faceSize.z, slabCost,
+            [&](size_t kBegin, size_t kEnd) {
+                for (size_t k = kBegin; k < kEnd; ++k)
+                {
+                    for (size_t j = 0; j < faceSize.y; ++j)
+                    {
+                        for (size_t i = 0; i < faceSize.x; ++i)
+                        {
+                            double result;
+                            markers(i, j, k) =
+                                gather(faceOrigin, faceSize, i, j, k, value,
+                                       &result)
+                                    ? 1
+                                    : 0;
+                            component(i, j, k) = result;
+                        }
+                    }
+                }
+            });
+    };
+
+    gatherComponent(flow->GetUOrigin(), u.size(), u, m_uMarkers.Accessor(),
+                    [&](size_t p) { return velocities[p].x; });
+    gatherComponent(flow->GetVOrigin(), v.size(), v, m_vMarkers.Accessor(),
+                    [&](size_t p) { return velocities[p].y; });
+    gatherComponent(flow->GetWOrigin(), w.size(), w, m_wMarkers.Accessor(),
+                    [&](size_t p) { return velocities[p].z; });
+}
+
+void PICSolver3::TransferFromGridsToParticles()
+{
+    FaceCenteredGrid3Ptr flow = GetGridSystemData()->GetVelocity();
+    ArrayAccessor1<Vector3<double>> positions = m_particles->GetPositions();
+    ArrayAccessor1<Vector3<double>> velocities = m_particles->GetVelocities();
+    const size_t numberOfParticles = m_particles->GetNumberOfParticles();
+
+    const ConstArrayAccessor1<char> sleeping = m_particles->GetActivityStates();
+    const bool useSleeping =
+        m_useParticleSleeping && sleeping.size() == numberOfParticles;
+
+    ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+        // Sleeping particles keep their resting velocity; they wake up
+        // through the activity-state update once neighbors start moving.
+        if (useSleeping && sleeping[i] != 0)
+        {
+            return;
+        }
+
+        velocities[i] = flow->Sample(positions[i]);
+    });
 }
 
 void PICSolver3::MoveParticles(double timeIntervalInSeconds)
@@ -222,24 +572,71 @@ void PICSolver3::MoveParticles(double timeIntervalInSeconds)
     const size_t numberOfParticles = m_particles->GetNumberOfParticles();
     int domainBoundaryFlag = GetClosedDomainBoundaryFlag();
     BoundingBox3D boundingBox = flow->BoundingBox();
+    const ConstArrayAccessor1<char> sleeping = m_particles->GetActivityStates();
+    const bool useSleeping =
+        m_useParticleSleeping && sleeping.size() == numberOfParticles;
+    const ParticleIntegrator integrator = m_particleIntegrator;
+    const unsigned int maxSubSteps =
+        static_cast<unsigned int>(std::max(GetMaxCFL(), 1.0));
+    const double minSpacing = flow->GridSpacing().Min();
+
+    // Sample the face arrays directly; routing every sample through the
+    // grid's std::function sampler costs an indirect call per evaluation.
+    LinearArraySampler3<double, double> uSampler{ flow->GetUConstAccessor(),
+                                                  flow->GridSpacing(),
+                                                  flow->GetUOrigin() };
+    LinearArraySampler3<double, double> vSampler{ flow->GetVConstAccessor(),
+                                                  flow->GridSpacing(),
+                                                  flow->GetVOrigin() };
+    LinearArraySampler3<double, double> wSampler{ flow->GetWConstAccessor(),
+                                                  flow->GridSpacing(),
+                                                  flow->GetWOrigin() };
+    const auto sample = [&](const Vector3D& pt) {
+        return Vector3D{ uSampler(pt), vSampler(pt), wSampler(pt) };
+    };
 
     ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+        // Sleeping particles stay put; advecting them would only accumulate
+        // sampling noise in settled regions.
+        if (useSleeping && sleeping[i] != 0)
+        {
+            return;
+        }
+
         Vector3D pt0 = positions[i];
         Vector3D pt1 = pt0;
         Vector3D vel = velocities[i];
 
         // Adaptive time-stepping
-        const unsigned int numSubSteps =
-            static_cast<unsigned int>(std::max(GetMaxCFL(), 1.0));
+        unsigned int numSubSteps = maxSubSteps;
+        if (integrator == ParticleIntegrator::Adaptive)
+        {
+            const double cfl =
+                vel.Length() * timeIntervalInSeconds / minSpacing;
+            numSubSteps = std::clamp(
+                static_cast<unsigned int>(std::ceil(cfl)), 1u, maxSubSteps);
+        }
+
         const double dt = timeIntervalInSeconds / numSubSteps;
         for (unsigned int t = 0; t < numSubSteps; ++t)
         {
-            Vector3D vel0 = flow->Sample(pt0);
-
-            // Mid-point rule
-            Vector3D midPt = pt0 + 0.5 * dt * vel0;
-            Vector3D midVel = flow->Sample(midPt);
-            pt1 = pt0 + dt * midVel;
+            Vector3D vel0 = sample(pt0);
+
+            if (integrator == ParticleIntegrator::RungeKutta3)
+            {
+                // Ralston's third-order rule
+                Vector3D midVel = sample(pt0 + 0.5 * dt * vel0);
+                Vector3D lastVel = sample(pt0 + 0.75 * dt * midVel);
+                pt1 = pt0 +
+                      dt / 9.0 * (2.0 * vel0 + 3.0 * midVel + 4.0 * lastVel);
+            }
+            else
+            {
+                // Mid-point rule
+                Vector3D midPt = pt0 + 0.5 * dt * vel0;
+                Vector3D midVel = sample(midPt);
+                pt1 = pt0 + dt * midVel;
+            }
 
             pt0 = pt1;
         }
@@ -289,6 +686,11 @@ void PICSolver3::MoveParticles(double timeIntervalInSeconds)
     if (col != nullptr)
     {
         ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+            if (useSleeping && sleeping[i] != 0)
+            {
+                return;
+            }
+
             col->ResolveCollision(0.0, 0.0, &positions[i], &velocities[i]);
         });
     }
@@ -302,9 +704,12 @@ void PICSolver3::ExtrapolateVelocityToAir() const
     const ArrayAccessor3<double> w = vel->GetWAccessor();
 
     const auto depth = static_cast<unsigned int>(std::ceil(GetMaxCFL()));
-    ExtrapolateToRegion(vel->GetUConstAccessor(), m_uMarkers, depth, u);
-    ExtrapolateToRegion(vel->GetVConstAccessor(), m_vMarkers, depth, v);
-    ExtrapolateToRegion(vel->GetWConstAccessor(), m_wMarkers, depth, w);
+    ExtrapolateToRegionFrontier(vel->GetUConstAccessor(), m_uMarkers, depth,
+                                u);
+    ExtrapolateToRegionFrontier(vel->GetVConstAccessor(), m_vMarkers, depth,
+                                v);
+    ExtrapolateToRegionFrontier(vel->GetWConstAccessor(), m_wMarkers, depth,
+                                w);
 }
 
 void PICSolver3::BuildSignedDistanceField()
@@ -332,6 +737,22 @@ void PICSolver3::BuildSignedDistanceField()
     ExtrapolateIntoCollider(sdf.get());
 }
 
+void PICSolver3::UpdateParticleActivityStates(
+    double timeIntervalInSeconds) const
+{
+    const FaceCenteredGrid3Ptr flow = GetGridSystemData()->GetVelocity();
+
+    // The threshold factor is the distance a resting particle may travel per
+    // time-step, expressed in cells.
+    const double sleepSpeedThreshold =
+        m_sleepThresholdFactor * flow->GridSpacing().Min() /
+        std::max(timeIntervalInSeconds, std::numeric_limits<double>::epsilon());
+
+    m_particles->UpdateActivityStates(sleepSpeedThreshold, SLEEP_FRAME_COUNT,
+                                      GetResolution(), flow->Origin(),
+                                      flow->GridSpacing());
+}
+
 void PICSolver3::UpdateParticleEmitter(double timeIntervalInSeconds) const
 {
     if (m_particleEmitter != nullptr)
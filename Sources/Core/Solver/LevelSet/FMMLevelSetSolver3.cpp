@@ -12,7 +12,8 @@
 #include <Core/Solver/LevelSet/FMMLevelSetSolver3.hpp>
 #include <Core/Utils/LevelSetUtils.hpp>
 
-#include <queue>
+#include <algorithm>
+#include <vector>
 
 namespace CubbyFlow
 {
@@ -20,6 +21,89 @@ static const char UNKNOWN = 0;
 static const char KNOWN = 1;
 static const char TRIAL = 2;
 
+//!
+//! \brief Dial's-algorithm bucket queue for the marching front.
+//!
+//! Trial cells are binned by their tentative distance quantized to
+//! \p bucketWidth, and popped bucket by bucket in ascending order. Since the
+//! marching recomputes the distance of every popped cell from its KNOWN
+//! neighbors anyway, the ordering only has to be correct up to the bucket
+//! width, which turns the O(N log N) heap into O(N) push/pop with memory
+//! proportional to the cells currently in the narrow band.
+//!
+class BucketQueue
+{
+ public:
+    BucketQueue(double bucketWidth, double maxValue)
+        : m_invBucketWidth(1.0 / bucketWidth)
+    {
+        m_buckets.resize(static_cast<size_t>(maxValue * m_invBucketWidth) + 2);
+    }
+
+    [[nodiscard]] bool IsEmpty() const
+    {
+        return m_numEntries == 0;
+    }
+
+    void Push(const Point3UI& idx, double value)
+    {
+        size_t bucket = m_current;
+
+        if (value > 0.0)
+        {
+            // Values ahead of the cursor land in their quantized bucket;
+            // anything at or behind it is processed next so no cell is lost.
+            bucket = std::max(
+                std::min(static_cast<size_t>(value * m_invBucketWidth),
+                         m_buckets.size() - 1),
+                m_current);
+        }
+
+        m_buckets[bucket].push_back(idx);
+        ++m_numEntries;
+    }
+
+    Point3UI Pop()
+    {
+        while (m_buckets[m_current].empty())
+        {
+            ++m_current;
+        }
+
+        const Point3UI idx = m_buckets[m_current].back();
+        m_buckets[m_current].pop_back();
+        --m_numEntries;
+
+        return idx;
+    }
+
+ private:
+    std::vector<std::vector<Point3UI>> m_buckets;
+    double m_invBucketWidth;
+    size_t m_current = 0;
+    size_t m_numEntries = 0;
+};
+
+//! Returns the bucket width for the given grid spacing. One-twentieth of the
+//! smallest cell edge keeps the ordering error well below the marching
+//! stencil's own discretization error.
+inline double BucketWidth(const Vector3D& gridSpacing)
+{
+    return 0.05 * std::min({ gridSpacing.x, gridSpacing.y, gridSpacing.z });
+}
+
+//! Returns the largest distance the marching can reach, i.e. \p maxDistance
+//! capped by the domain diagonal, which bounds the number of buckets.
+inline double MaxMarchDistance(const Size3& size, const Vector3D& gridSpacing,
+                               double maxDistance)
+{
+    const Vector3D diagonal(gridSpacing.x * static_cast<double>(size.x),
+                            gridSpacing.y * static_cast<double>(size.y),
+                            gridSpacing.z * static_cast<double>(size.z));
+
+    return std::min(maxDistance, diagonal.Length());
+}
+
 // Find geometric solution near the boundary
 inline double SolveQuadNearBoundary(const Array3<char>& markers,
                                     ArrayAccessor3<double> output,
@@ -310,13 +394,9 @@ void FMMLevelSetSolver3::Reinitialize(const ScalarGrid3& inputSDF,
             }
         });
 
-        auto compare = [&](const Point3UI& a, const Point3UI& b) {
-            return output(a.x, a.y, a.z) > output(b.x, b.y, b.z);
-        };
-
         // Enqueue initial candidates
-        std::priority_queue<Point3UI, std::vector<Point3UI>, decltype(compare)>
-            trial(compare);
+        BucketQueue trial{ BucketWidth(gridSpacing),
+                           MaxMarchDistance(size, gridSpacing, maxDistance) };
         markers.ForEachIndex([&](size_t i, size_t j, size_t k) {
             if (markers(i, j, k) != KNOWN &&
                 ((i > 0 && markers(i - 1, j, k) == KNOWN) ||
@@ -326,16 +406,15 @@ void FMMLevelSetSolver3::Reinitialize(const ScalarGrid3& inputSDF,
                  (k > 0 && markers(i, j, k - 1) == KNOWN) ||
                  (k + 1 < size.z && markers(i, j, k + 1) == KNOWN)))
             {
-                trial.push(Point3UI{ i, j, k });
+                trial.Push(Point3UI{ i, j, k }, output(i, j, k));
                 markers(i, j, k) = TRIAL;
             }
         });
 
         // Propagate
-        while (!trial.empty())
+        while (!trial.IsEmpty())
         {
-            const Point3UI idx = trial.top();
-            trial.pop();
+            const Point3UI idx = trial.Pop();
 
             const size_t i = idx.x;
             const size_t j = idx.y;
@@ -358,7 +437,7 @@ void FMMLevelSetSolver3::Reinitialize(const ScalarGrid3& inputSDF,
                     output(i - 1, j, k) =
                         SolveQuad(markers, output, gridSpacing,
                                   invGridSpacingSqr, i - 1, j, k);
-                    trial.push(Point3UI{ i - 1, j, k });
+                    trial.Push(Point3UI{ i - 1, j, k }, output(i - 1, j, k));
                 }
             }
 
@@ -370,7 +449,7 @@ void FMMLevelSetSolver3::Reinitialize(const ScalarGrid3& inputSDF,
                     output(i + 1, j, k) =
                         SolveQuad(markers, output, gridSpacing,
                                   invGridSpacingSqr, i + 1, j, k);
-                    trial.push(Point3UI{ i + 1, j, k });
+                    trial.Push(Point3UI{ i + 1, j, k }, output(i + 1, j, k));
                 }
             }
 
@@ -382,7 +461,7 @@ void FMMLevelSetSolver3::Reinitialize(const ScalarGrid3& inputSDF,
                     output(i, j - 1, k) =
                         SolveQuad(markers, output, gridSpacing,
                                   invGridSpacingSqr, i, j - 1, k);
-                    trial.push(Point3UI{ i, j - 1, k });
+                    trial.Push(Point3UI{ i, j - 1, k }, output(i, j - 1, k));
                 }
             }
 
@@ -394,7 +473,7 @@ void FMMLevelSetSolver3::Reinitialize(const ScalarGrid3& inputSDF,
                     output(i, j + 1, k) =
                         SolveQuad(markers, output, gridSpacing,
                                   invGridSpacingSqr, i, j + 1, k);
-                    trial.push(Point3UI{ i, j + 1, k });
+                    trial.Push(Point3UI{ i, j + 1, k }, output(i, j + 1, k));
                 }
             }
 
@@ -406,7 +485,7 @@ void FMMLevelSetSolver3::Reinitialize(const ScalarGrid3& inputSDF,
                     output(i, j, k - 1) =
                         SolveQuad(markers, output, gridSpacing,
                                   invGridSpacingSqr, i, j, k - 1);
-                    trial.push(Point3UI{ i, j, k - 1 });
+                    trial.Push(Point3UI{ i, j, k - 1 }, output(i, j, k - 1));
                 }
             }
 
@@ -418,7 +497,7 @@ void FMMLevelSetSolver3::Reinitialize(const ScalarGrid3& inputSDF,
                     output(i, j, k + 1) =
                         SolveQuad(markers, output, gridSpacing,
                                   invGridSpacingSqr, i, j, k + 1);
-                    trial.push(Point3UI{ i, j, k + 1 });
+                    trial.Push(Point3UI{ i, j, k + 1 }, output(i, j, k + 1));
                 }
             }
         }
@@ -449,6 +528,52 @@ void FMMLevelSetSolver3::Extrapolate(const ScalarGrid3& input,
                 input.GridSpacing(), maxDistance, output->GetDataAccessor());
 }
 
+void FMMLevelSetSolver3::Extrapolate(const std::vector<ScalarGrid3Ptr>& inputs,
+                                     const ScalarField3& sdf,
+                                     double maxDistance,
+                                     const std::vector<ScalarGrid3Ptr>& outputs)
+{
+    if (inputs.size() != outputs.size())
+    {
+        throw std::invalid_argument{
+            "inputs and outputs have not same count."
+        };
+    }
+
+    if (inputs.empty())
+    {
+        return;
+    }
+
+    for (size_t n = 0; n < inputs.size(); ++n)
+    {
+        if (!inputs[n]->HasSameShape(*outputs[n]) ||
+            !inputs[n]->HasSameShape(*inputs[0]))
+        {
+            throw std::invalid_argument{
+                "input and output have not same shape."
+            };
+        }
+    }
+
+    Array3<double> sdfGrid{ inputs[0]->GetDataSize() };
+    auto pos = inputs[0]->GetDataPosition();
+    sdfGrid.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        sdfGrid(i, j, k) = sdf.Sample(pos(i, j, k));
+    });
+
+    std::vector<ConstArrayAccessor3<double>> inputAccs;
+    std::vector<ArrayAccessor3<double>> outputAccs;
+    for (size_t n = 0; n < inputs.size(); ++n)
+    {
+        inputAccs.push_back(inputs[n]->GetConstDataAccessor());
+        outputAccs.push_back(outputs[n]->GetDataAccessor());
+    }
+
+    Extrapolate(inputAccs, sdfGrid.ConstAccessor(), inputs[0]->GridSpacing(),
+                maxDistance, outputAccs);
+}
+
 void FMMLevelSetSolver3::Extrapolate(const CollocatedVectorGrid3& input,
                                      const ScalarField3& sdf,
                                      double maxDistance,
@@ -484,10 +609,11 @@ void FMMLevelSetSolver3::Extrapolate(const CollocatedVectorGrid3& input,
     Extrapolate(v, sdfGrid.ConstAccessor(), gridSpacing, maxDistance, v0);
     Extrapolate(w, sdfGrid.ConstAccessor(), gridSpacing, maxDistance, w0);
 
+    auto outputAcc = output->GetDataAccessor();
     output->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-        (*output)(i, j, k).x = u(i, j, k);
-        (*output)(i, j, k).y = v(i, j, k);
-        (*output)(i, j, k).z = w(i, j, k);
+        outputAcc(i, j, k).x = u(i, j, k);
+        outputAcc(i, j, k).y = v(i, j, k);
+        outputAcc(i, j, k).z = w(i, j, k);
     });
 }
 
@@ -539,7 +665,26 @@ void FMMLevelSetSolver3::Extrapolate(const ConstArrayAccessor3<double>& input,
                                      double maxDistance,
                                      ArrayAccessor3<double> output)
 {
-    Size3 size = input.size();
+    std::vector<ConstArrayAccessor3<double>> inputs{ input };
+    std::vector<ArrayAccessor3<double>> outputs{ output };
+
+    Extrapolate(inputs, sdf, gridSpacing, maxDistance, outputs);
+}
+
+void FMMLevelSetSolver3::Extrapolate(
+    const std::vector<ConstArrayAccessor3<double>>& inputs,
+    const ConstArrayAccessor3<double>& sdf, const Vector3D& gridSpacing,
+    double maxDistance, std::vector<ArrayAccessor3<double>>& outputs)
+{
+    assert(inputs.size() == outputs.size());
+
+    const size_t numFields = inputs.size();
+    if (numFields == 0)
+    {
+        return;
+    }
+
+    Size3 size = inputs[0].size();
     const Vector3D invGridSpacing = 1.0 / gridSpacing;
 
     // Build markers
@@ -549,16 +694,16 @@ void FMMLevelSetSolver3::Extrapolate(const ConstArrayAccessor3<double>& input,
         {
             markers(i, j, k) = KNOWN;
         }
-        output(i, j, k) = input(i, j, k);
-    });
 
-    auto compare = [&](const Point3UI& a, const Point3UI& b) {
-        return sdf(a.x, a.y, a.z) > sdf(b.x, b.y, b.z);
-    };
+        for (size_t n = 0; n < numFields; ++n)
+        {
+            outputs[n](i, j, k) = inputs[n](i, j, k);
+        }
+    });
 
     // Enqueue initial candidates
-    std::priority_queue<Point3UI, std::vector<Point3UI>, decltype(compare)>
-        trial(compare);
+    BucketQueue trial{ BucketWidth(gridSpacing),
+                       MaxMarchDistance(size, gridSpacing, maxDistance) };
     markers.ForEachIndex([&](size_t i, size_t j, size_t k) {
         if (markers(i, j, k) == KNOWN)
         {
@@ -567,52 +712,54 @@ void FMMLevelSetSolver3::Extrapolate(const ConstArrayAccessor3<double>& input,
 
         if (i > 0 && markers(i - 1, j, k) == KNOWN)
         {
-            trial.push(Point3UI{ i, j, k });
+            trial.Push(Point3UI{ i, j, k }, sdf(i, j, k));
             markers(i, j, k) = TRIAL;
             return;
         }
 
         if (i + 1 < size.x && markers(i + 1, j, k) == KNOWN)
         {
-            trial.push(Point3UI{ i, j, k });
+            trial.Push(Point3UI{ i, j, k }, sdf(i, j, k));
             markers(i, j, k) = TRIAL;
             return;
         }
 
         if (j > 0 && markers(i, j - 1, k) == KNOWN)
         {
-            trial.push(Point3UI{ i, j, k });
+            trial.Push(Point3UI{ i, j, k }, sdf(i, j, k));
             markers(i, j, k) = TRIAL;
             return;
         }
 
         if (j + 1 < size.y && markers(i, j + 1, k) == KNOWN)
         {
-            trial.push(Point3UI{ i, j, k });
+            trial.Push(Point3UI{ i, j, k }, sdf(i, j, k));
             markers(i, j, k) = TRIAL;
             return;
         }
 
         if (k > 0 && markers(i, j, k - 1) == KNOWN)
         {
-            trial.push(Point3UI{ i, j, k });
+            trial.Push(Point3UI{ i, j, k }, sdf(i, j, k));
             markers(i, j, k) = TRIAL;
             return;
         }
 
         if (k + 1 < size.z && markers(i, j, k + 1) == KNOWN)
         {
-            trial.push(Point3UI{ i, j, k });
+            trial.Push(Point3UI{ i, j, k }, sdf(i, j, k));
             markers(i, j, k) = TRIAL;
             return;
         }
     });
 
-    // Propagate
-    while (!trial.empty())
+    // Propagate. The weights depend only on the SDF gradient, so one set of
+    // weights extrapolates every field at once.
+    std::vector<double> sums(numFields);
+
+    while (!trial.IsEmpty())
     {
-        const Point3UI idx = trial.top();
-        trial.pop();
+        const Point3UI idx = trial.Pop();
 
         const size_t i = idx.x;
         const size_t j = idx.y;
@@ -625,7 +772,7 @@ void FMMLevelSetSolver3::Extrapolate(const ConstArrayAccessor3<double>& input,
 
         Vector3D grad = Gradient3(sdf, gridSpacing, i, j, k).Normalized();
 
-        double sum = 0.0;
+        std::fill(sums.begin(), sums.end(), 0.0);
         double count = 0.0;
 
         if (i > 0)
@@ -640,13 +787,16 @@ void FMMLevelSetSolver3::Extrapolate(const ConstArrayAccessor3<double>& input,
                     weight = 1.0;
                 }
 
-                sum += weight * output(i - 1, j, k);
+                for (size_t n = 0; n < numFields; ++n)
+                {
+                    sums[n] += weight * outputs[n](i - 1, j, k);
+                }
                 count += weight;
             }
             else if (markers(i - 1, j, k) == UNKNOWN)
             {
                 markers(i - 1, j, k) = TRIAL;
-                trial.push(Point3UI{ i - 1, j, k });
+                trial.Push(Point3UI{ i - 1, j, k }, sdf(i - 1, j, k));
             }
         }
 
@@ -662,13 +812,16 @@ void FMMLevelSetSolver3::Extrapolate(const ConstArrayAccessor3<double>& input,
                     weight = 1.0;
                 }
 
-                sum += weight * output(i + 1, j, k);
+                for (size_t n = 0; n < numFields; ++n)
+                {
+                    sums[n] += weight * outputs[n](i + 1, j, k);
+                }
                 count += weight;
             }
             else if (markers(i + 1, j, k) == UNKNOWN)
             {
                 markers(i + 1, j, k) = TRIAL;
-                trial.push(Point3UI{ i + 1, j, k });
+                trial.Push(Point3UI{ i + 1, j, k }, sdf(i + 1, j, k));
             }
         }
 
@@ -684,13 +837,16 @@ void FMMLevelSetSolver3::Extrapolate(const ConstArrayAccessor3<double>& input,
                     weight = 1.0;
                 }
 
-                sum += weight * output(i, j - 1, k);
+                for (size_t n = 0; n < numFields; ++n)
+                {
+                    sums[n] += weight * outputs[n](i, j - 1, k);
+                }
                 count += weight;
             }
             else if (markers(i, j - 1, k) == UNKNOWN)
             {
                 markers(i, j - 1, k) = TRIAL;
-                trial.push(Point3UI{ i, j - 1, k });
+                trial.Push(Point3UI{ i, j - 1, k }, sdf(i, j - 1, k));
             }
         }
 
@@ -706,13 +862,16 @@ void FMMLevelSetSolver3::Extrapolate(const ConstArrayAccessor3<double>& input,
                     weight = 1.0;
                 }
 
-                sum += weight * output(i, j + 1, k);
+                for (size_t n = 0; n < numFields; ++n)
+                {
+                    sums[n] += weight * outputs[n](i, j + 1, k);
+                }
                 count += weight;
             }
             else if (markers(i, j + 1, k) == UNKNOWN)
             {
                 markers(i, j + 1, k) = TRIAL;
-                trial.push(Point3UI{ i, j + 1, k });
+                trial.Push(Point3UI{ i, j + 1, k }, sdf(i, j + 1, k));
             }
         }
 
@@ -728,13 +887,16 @@ void FMMLevelSetSolver3::Extrapolate(const ConstArrayAccessor3<double>& input,
                     weight = 1.0;
                 }
 
-                sum += weight * output(i, j, k - 1);
+                for (size_t n = 0; n < numFields; ++n)
+                {
+                    sums[n] += weight * outputs[n](i, j, k - 1);
+                }
                 count += weight;
             }
             else if (markers(i, j, k - 1) == UNKNOWN)
             {
                 markers(i, j, k - 1) = TRIAL;
-                trial.push(Point3UI{ i, j, k - 1 });
+                trial.Push(Point3UI{ i, j, k - 1 }, sdf(i, j, k - 1));
             }
         }
 
@@ -750,19 +912,25 @@ void FMMLevelSetSolver3::Extrapolate(const ConstArrayAccessor3<double>& input,
                     weight = 1.0;
                 }
 
-                sum += weight * output(i, j, k + 1);
+                for (size_t n = 0; n < numFields; ++n)
+                {
+                    sums[n] += weight * outputs[n](i, j, k + 1);
+                }
                 count += weight;
             }
             else if (markers(i, j, k + 1) == UNKNOWN)
             {
                 markers(i, j, k + 1) = TRIAL;
-                trial.push(Point3UI{ i, j, k + 1 });
+                trial.Push(Point3UI{ i, j, k + 1 }, sdf(i, j, k + 1));
             }
         }
 
         assert(count > 0.0);
 
-        output(i, j, k) = sum / count;
+        for (size_t n = 0; n < numFields; ++n)
+        {
+            outputs[n](i, j, k) = sums[n] / count;
+        }
         markers(i, j, k) = KNOWN;
     }
 }
@@ -0,0 +1,495 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/FDM/FDMUtils.hpp>
+#include <Core/Solver/LevelSet/FSMLevelSetSolver3.hpp>
+#include <Core/Utils/LevelSetUtils.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace CubbyFlow
+{
+static const char UNKNOWN = 0;
+static const char KNOWN = 1;
+static const char VALID = 2;
+
+static const int SWEEP_DIRS[8][3] = { { 1, 1, 1 },   { -1, 1, 1 },
+                                      { 1, -1, 1 },  { 1, 1, -1 },
+                                      { -1, -1, 1 }, { -1, 1, -1 },
+                                      { 1, -1, -1 }, { -1, -1, -1 } };
+
+//!
+//! Visits every cell of \p size in the sweep order given by \p dir, invoking
+//! \p func in parallel over the cells of each diagonal plane. With a
+//! six-point stencil, no two cells on the same plane are neighbors, so the
+//! per-plane updates are data-race free while the plane-by-plane ordering
+//! preserves the Gauss-Seidel dependency of the sweep.
+//!
+template <typename Func>
+static void SweepPlanes(const Size3& size, const int dir[3], Func func)
+{
+    const size_t numLevels = size.x + size.y + size.z - 2;
+
+    for (size_t level = 0; level < numLevels; ++level)
+    {
+        ParallelFor(ZERO_SIZE, size.y, [&](size_t jj) {
+            if (jj > level)
+            {
+                return;
+            }
+
+            const size_t remaining = level - jj;
+            const size_t kkBegin =
+                (remaining >= size.x) ? remaining - size.x + 1 : 0;
+            const size_t kkEnd = std::min(remaining + 1, size.z);
+
+            for (size_t kk = kkBegin; kk < kkEnd; ++kk)
+            {
+                const size_t ii = remaining - kk;
+                if (ii >= size.x)
+                {
+                    continue;
+                }
+
+                const size_t i = (dir[0] > 0) ? ii : size.x - 1 - ii;
+                const size_t j = (dir[1] > 0) ? jj : size.y - 1 - jj;
+                const size_t k = (dir[2] > 0) ? kk : size.z - 1 - kk;
+
+                func(i, j, k);
+            }
+        });
+    }
+}
+
+//! Solves the eikonal quadratic at (i, j, k) from the smallest axis-wise
+//! neighbor distances and returns the candidate solution.
+static double SolveEikonal(const ConstArrayAccessor3<double>& dist,
+                           const Vector3D& gridSpacing, size_t i, size_t j,
+                           size_t k)
+{
+    const Size3 size = dist.size();
+    const double maxVal = std::numeric_limits<double>::max();
+
+    std::array<std::pair<double, double>, 3> phiH;
+    size_t numCandidates = 0;
+
+    double phiX = maxVal;
+    if (i > 0)
+    {
+        phiX = std::min(phiX, dist(i - 1, j, k));
+    }
+    if (i + 1 < size.x)
+    {
+        phiX = std::min(phiX, dist(i + 1, j, k));
+    }
+    if (phiX < maxVal)
+    {
+        phiH[numCandidates++] = { phiX, gridSpacing.x };
+    }
+
+    double phiY = maxVal;
+    if (j > 0)
+    {
+        phiY = std::min(phiY, dist(i, j - 1, k));
+    }
+    if (j + 1 < size.y)
+    {
+        phiY = std::min(phiY, dist(i, j + 1, k));
+    }
+    if (phiY < maxVal)
+    {
+        phiH[numCandidates++] = { phiY, gridSpacing.y };
+    }
+
+    double phiZ = maxVal;
+    if (k > 0)
+    {
+        phiZ = std::min(phiZ, dist(i, j, k - 1));
+    }
+    if (k + 1 < size.z)
+    {
+        phiZ = std::min(phiZ, dist(i, j, k + 1));
+    }
+    if (phiZ < maxVal)
+    {
+        phiH[numCandidates++] = { phiZ, gridSpacing.z };
+    }
+
+    if (numCandidates == 0)
+    {
+        return maxVal;
+    }
+
+    std::sort(phiH.begin(), phiH.begin() + numCandidates);
+
+    // Add one axis at a time while the candidate exceeds the next smallest
+    // neighbor value.
+    double solution = phiH[0].first + phiH[0].second;
+    double a = 0.0;
+    double b = 0.0;
+    double c = -1.0;
+
+    for (size_t m = 0; m < numCandidates; ++m)
+    {
+        if (m > 0 && solution <= phiH[m].first)
+        {
+            break;
+        }
+
+        const double invHSqr = 1.0 / Square(phiH[m].second);
+        a += invHSqr;
+        b -= phiH[m].first * invHSqr;
+        c += Square(phiH[m].first) * invHSqr;
+
+        const double det = b * b - a * c;
+        if (det > 0.0)
+        {
+            solution = (-b + std::sqrt(det)) / a;
+        }
+    }
+
+    return solution;
+}
+
+void FSMLevelSetSolver3::Reinitialize(const ScalarGrid3& inputSDF,
+                                      double maxDistance,
+                                      ScalarGrid3* outputSDF)
+{
+    UNUSED_VARIABLE(maxDistance);
+
+    if (!inputSDF.HasSameShape(*outputSDF))
+    {
+        throw std::invalid_argument{
+            "inputSDF and outputSDF have not same shape."
+        };
+    }
+
+    const Size3 size = inputSDF.GetDataSize();
+    const Vector3D gridSpacing = inputSDF.GridSpacing();
+    const double maxVal = std::numeric_limits<double>::max();
+
+    auto output = outputSDF->GetDataAccessor();
+
+    Array3<double> dist{ size, maxVal };
+    Array3<char> frozen{ size, UNKNOWN };
+
+    // Freeze cells next to the interface with geometric distances computed
+    // from the input values, like the near-boundary pass of the FMM solver.
+    // All other cells start at infinity.
+    dist.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const double phi = inputSDF(i, j, k);
+        const double sign = IsInsideSDF(phi) ? -1.0 : 1.0;
+
+        bool hasX = false;
+        double phiX = maxVal;
+        if (i > 0 && IsInsideSDF(sign * inputSDF(i - 1, j, k)))
+        {
+            hasX = true;
+            phiX = std::min(phiX, sign * inputSDF(i - 1, j, k));
+        }
+        if (i + 1 < size.x && IsInsideSDF(sign * inputSDF(i + 1, j, k)))
+        {
+            hasX = true;
+            phiX = std::min(phiX, sign * inputSDF(i + 1, j, k));
+        }
+
+        bool hasY = false;
+        double phiY = maxVal;
+        if (j > 0 && IsInsideSDF(sign * inputSDF(i, j - 1, k)))
+        {
+            hasY = true;
+            phiY = std::min(phiY, sign * inputSDF(i, j - 1, k));
+        }
+        if (j + 1 < size.y && IsInsideSDF(sign * inputSDF(i, j + 1, k)))
+        {
+            hasY = true;
+            phiY = std::min(phiY, sign * inputSDF(i, j + 1, k));
+        }
+
+        bool hasZ = false;
+        double phiZ = maxVal;
+        if (k > 0 && IsInsideSDF(sign * inputSDF(i, j, k - 1)))
+        {
+            hasZ = true;
+            phiZ = std::min(phiZ, sign * inputSDF(i, j, k - 1));
+        }
+        if (k + 1 < size.z && IsInsideSDF(sign * inputSDF(i, j, k + 1)))
+        {
+            hasZ = true;
+            phiZ = std::min(phiZ, sign * inputSDF(i, j, k + 1));
+        }
+
+        if (!(hasX || hasY || hasZ))
+        {
+            return;
+        }
+
+        double denomSqr = 0.0;
+
+        if (hasX)
+        {
+            const double distToBndX =
+                gridSpacing.x * std::abs(phi) / (std::abs(phi) + std::abs(phiX));
+            denomSqr += 1.0 / Square(distToBndX);
+        }
+        if (hasY)
+        {
+            const double distToBndY =
+                gridSpacing.y * std::abs(phi) / (std::abs(phi) + std::abs(phiY));
+            denomSqr += 1.0 / Square(distToBndY);
+        }
+        if (hasZ)
+        {
+            const double distToBndZ =
+                gridSpacing.z * std::abs(phi) / (std::abs(phi) + std::abs(phiZ));
+            denomSqr += 1.0 / Square(distToBndZ);
+        }
+
+        dist(i, j, k) = 1.0 / std::sqrt(denomSqr);
+        frozen(i, j, k) = KNOWN;
+    });
+
+    // Eight directional sweeps; each covers one octant of characteristic
+    // directions, so a single pass converges for the eikonal equation.
+    for (const auto& dir : SWEEP_DIRS)
+    {
+        SweepPlanes(size, dir, [&](size_t i, size_t j, size_t k) {
+            if (frozen(i, j, k) == KNOWN)
+            {
+                return;
+            }
+
+            const double solution =
+                SolveEikonal(dist.ConstAccessor(), gridSpacing, i, j, k);
+
+            if (solution < dist(i, j, k))
+            {
+                dist(i, j, k) = solution;
+            }
+        });
+    }
+
+    // Restore the sign from the input field.
+    output.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        output(i, j, k) =
+            IsInsideSDF(inputSDF(i, j, k)) ? -dist(i, j, k) : dist(i, j, k);
+    });
+}
+
+void FSMLevelSetSolver3::Extrapolate(const ScalarGrid3& input,
+                                     const ScalarField3& sdf,
+                                     double maxDistance, ScalarGrid3* output)
+{
+    if (!input.HasSameShape(*output))
+    {
+        throw std::invalid_argument{ "input and output have not same shape." };
+    }
+
+    Array3<double> sdfGrid{ input.GetDataSize() };
+    auto pos = input.GetDataPosition();
+    sdfGrid.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        sdfGrid(i, j, k) = sdf.Sample(pos(i, j, k));
+    });
+
+    Extrapolate(input.GetConstDataAccessor(), sdfGrid.ConstAccessor(),
+                input.GridSpacing(), maxDistance, output->GetDataAccessor());
+}
+
+void FSMLevelSetSolver3::Extrapolate(const CollocatedVectorGrid3& input,
+                                     const ScalarField3& sdf,
+                                     double maxDistance,
+                                     CollocatedVectorGrid3* output)
+{
+    if (!input.HasSameShape(*output))
+    {
+        throw std::invalid_argument{ "input and output have not same shape." };
+    }
+
+    Array3<double> sdfGrid{ input.GetDataSize() };
+    auto pos = input.GetDataPosition();
+    sdfGrid.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        sdfGrid(i, j, k) = sdf.Sample(pos(i, j, k));
+    });
+
+    const Vector3D gridSpacing = input.GridSpacing();
+
+    Array3<double> u{ input.GetDataSize() };
+    Array3<double> u0{ input.GetDataSize() };
+    Array3<double> v{ input.GetDataSize() };
+    Array3<double> v0{ input.GetDataSize() };
+    Array3<double> w{ input.GetDataSize() };
+    Array3<double> w0{ input.GetDataSize() };
+
+    input.ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        u(i, j, k) = input(i, j, k).x;
+        v(i, j, k) = input(i, j, k).y;
+        w(i, j, k) = input(i, j, k).z;
+    });
+
+    Extrapolate(u.ConstAccessor(), sdfGrid.ConstAccessor(), gridSpacing,
+                maxDistance, u0.Accessor());
+    Extrapolate(v.ConstAccessor(), sdfGrid.ConstAccessor(), gridSpacing,
+                maxDistance, v0.Accessor());
+    Extrapolate(w.ConstAccessor(), sdfGrid.ConstAccessor(), gridSpacing,
+                maxDistance, w0.Accessor());
+
+    auto outputAcc = output->GetDataAccessor();
+    output->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        outputAcc(i, j, k).x = u0(i, j, k);
+        outputAcc(i, j, k).y = v0(i, j, k);
+        outputAcc(i, j, k).z = w0(i, j, k);
+    });
+}
+
+void FSMLevelSetSolver3::Extrapolate(const FaceCenteredGrid3& input,
+                                     const ScalarField3& sdf,
+                                     double maxDistance,
+                                     FaceCenteredGrid3* output)
+{
+    if (!input.HasSameShape(*output))
+    {
+        throw std::invalid_argument{ "input and output have not same shape." };
+    }
+
+    const Vector3D& gridSpacing = input.GridSpacing();
+
+    const ConstArrayAccessor3<double> u = input.GetUConstAccessor();
+    auto uPos = input.GetUPosition();
+    Array3<double> sdfAtU{ u.size() };
+    input.ParallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtU(i, j, k) = sdf.Sample(uPos(i, j, k));
+    });
+
+    Extrapolate(u, sdfAtU.ConstAccessor(), gridSpacing, maxDistance,
+                output->GetUAccessor());
+
+    const ConstArrayAccessor3<double> v = input.GetVConstAccessor();
+    auto vPos = input.GetVPosition();
+    Array3<double> sdfAtV{ v.size() };
+    input.ParallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtV(i, j, k) = sdf.Sample(vPos(i, j, k));
+    });
+
+    Extrapolate(v, sdfAtV.ConstAccessor(), gridSpacing, maxDistance,
+                output->GetVAccessor());
+
+    const ConstArrayAccessor3<double> w = input.GetWConstAccessor();
+    auto wPos = input.GetWPosition();
+    Array3<double> sdfAtW{ w.size() };
+    input.ParallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtW(i, j, k) = sdf.Sample(wPos(i, j, k));
+    });
+
+    Extrapolate(w, sdfAtW.ConstAccessor(), gridSpacing, maxDistance,
+                output->GetWAccessor());
+}
+
+void FSMLevelSetSolver3::Extrapolate(const ConstArrayAccessor3<double>& input,
+                                     const ConstArrayAccessor3<double>& sdf,
+                                     const Vector3D& gridSpacing,
+                                     double maxDistance,
+                                     ArrayAccessor3<double> output)
+{
+    const Size3 size = input.size();
+    const Vector3D invGridSpacing = 1.0 / gridSpacing;
+
+    Array3<char> markers{ size, UNKNOWN };
+    markers.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (IsInsideSDF(sdf(i, j, k)))
+        {
+            markers(i, j, k) = KNOWN;
+        }
+        output(i, j, k) = input(i, j, k);
+    });
+
+    auto update = [&](size_t i, size_t j, size_t k) {
+        if (markers(i, j, k) == KNOWN || sdf(i, j, k) > maxDistance)
+        {
+            return;
+        }
+
+        const Vector3D grad =
+            Gradient3(sdf, gridSpacing, i, j, k).Normalized();
+
+        double sum = 0.0;
+        double count = 0.0;
+
+        // Average the neighbors that already carry a value, weighted by the
+        // upwind component of the SDF gradient. The marker gate ensures
+        // information only flows outward from the interface.
+        auto accumulate = [&](size_t ni, size_t nj, size_t nk,
+                              double directionalWeight) {
+            if (markers(ni, nj, nk) == UNKNOWN ||
+                sdf(ni, nj, nk) > sdf(i, j, k))
+            {
+                return;
+            }
+
+            double weight = directionalWeight;
+
+            // If gradient is zero, then just assign 1 to weight
+            if (weight < std::numeric_limits<double>::epsilon())
+            {
+                weight = 1.0;
+            }
+
+            sum += weight * output(ni, nj, nk);
+            count += weight;
+        };
+
+        if (i > 0)
+        {
+            accumulate(i - 1, j, k, std::max(grad.x, 0.0) * invGridSpacing.x);
+        }
+        if (i + 1 < size.x)
+        {
+            accumulate(i + 1, j, k, -std::min(grad.x, 0.0) * invGridSpacing.x);
+        }
+        if (j > 0)
+        {
+            accumulate(i, j - 1, k, std::max(grad.y, 0.0) * invGridSpacing.y);
+        }
+        if (j + 1 < size.y)
+        {
+            accumulate(i, j + 1, k, -std::min(grad.y, 0.0) * invGridSpacing.y);
+        }
+        if (k > 0)
+        {
+            accumulate(i, j, k - 1, std::max(grad.z, 0.0) * invGridSpacing.z);
+        }
+        if (k + 1 < size.z)
+        {
+            accumulate(i, j, k + 1, -std::min(grad.z, 0.0) * invGridSpacing.z);
+        }
+
+        if (count > 0.0)
+        {
+            output(i, j, k) = sum / count;
+            markers(i, j, k) = VALID;
+        }
+    };
+
+    // Unlike the eikonal sweeps, the upwind ordering here follows the SDF
+    // rather than the sweep diagonals, so one sweep set is not exact. Repeat
+    // it a few times as a Gauss-Seidel iteration of the upwind average; the
+    // first-order values settle quickly.
+    const int numPasses = 3;
+
+    for (int pass = 0; pass < numPasses; ++pass)
+    {
+        for (const auto& dir : SWEEP_DIRS)
+        {
+            SweepPlanes(size, dir, update);
+        }
+    }
+}
+}  // namespace CubbyFlow
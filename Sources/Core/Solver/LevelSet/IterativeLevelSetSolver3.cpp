@@ -10,6 +10,7 @@
 
 #include <Core/Array/ArrayUtils.hpp>
 #include <Core/FDM/FDMUtils.hpp>
+#include <Core/Grid/GridActiveRegion3.hpp>
 #include <Core/Solver/LevelSet/IterativeLevelSetSolver3.hpp>
 #include <Core/Utils/Logging.hpp>
 
@@ -42,13 +43,42 @@ void IterativeLevelSetSolver3::Reinitialize(const ScalarGrid3& inputSDF,
     Array3<double> temp{ size };
     ArrayAccessor3<double> tempAcc = temp.Accessor();
 
+    // In narrow band mode, only the cells near the interface are iterated;
+    // everything else keeps its input value.
+    const bool useNarrowBand = m_narrowBandWidth > 0.0;
+    GridActiveRegion3 band;
+
+    if (useNarrowBand)
+    {
+        // Cells beyond the reinitialization distance never converge within
+        // the iteration budget anyway, so the band never needs to be wider
+        // than maxDistance plus a small margin for the boundary stencils.
+        const double maxSpacing =
+            std::max({ gridSpacing.x, gridSpacing.y, gridSpacing.z });
+        const double bandWidth =
+            std::min(m_narrowBandWidth, maxDistance + 2.0 * maxSpacing);
+
+        band.BuildNarrowBand(inputSDF.GetConstDataAccessor(), bandWidth);
+        band.AddHalo();
+
+        // Out-of-band cells are never touched again, so both buffers need
+        // their input values up front.
+        CopyRange3(inputSDF.GetConstDataAccessor(), size.x, size.y, size.z,
+                   &tempAcc);
+
+        CUBBYFLOW_INFO << "Narrow band reinitialization: "
+                       << band.GetNumberOfActiveTiles() << " of "
+                       << band.GetTileCount().x * band.GetTileCount().y *
+                              band.GetTileCount().z
+                       << " tiles active";
+    }
+
     CUBBYFLOW_INFO << "Reinitializing with pseudoTimeStep: " << dtau
                    << " numberOfIterations: " << numberOfIterations;
 
     for (unsigned int n = 0; n < numberOfIterations; ++n)
     {
-        inputSDF.ParallelForEachDataPointIndex([&](size_t i, size_t j,
-                                                   size_t k) {
+        auto updateCell = [&](size_t i, size_t j, size_t k) {
             const double s = Sign(outputAcc, gridSpacing, i, j, k);
 
             std::array<double, 2> dx{}, dy{}, dz{};
@@ -74,7 +104,48 @@ void IterativeLevelSetSolver3::Reinitialize(const ScalarGrid3& inputSDF,
                                               Square(std::max(dz[1], 0.0))) -
                                     1.0);
             tempAcc(i, j, k) = val;
-        });
+        };
+
+        if (useNarrowBand)
+        {
+            band.ParallelForEachCellInActiveTiles(updateCell);
+        }
+        else
+        {
+            inputSDF.ParallelForEachDataPointIndex(updateCell);
+        }
+
+        if (m_convergenceTolerance > 0.0)
+        {
+            // Untouched out-of-band cells are identical in both buffers, so
+            // the flat reduction is exact in narrow band mode as well.
+            const double* newVal = tempAcc.data();
+            const double* oldVal = outputAcc.data();
+            const size_t numCells = size.x * size.y * size.z;
+
+            const double maxDelta = ParallelReduce(
+                ZERO_SIZE, numCells, 0.0,
+                [&](size_t begin, size_t end, double init) {
+                    double localMax = init;
+                    for (size_t l = begin; l < end; ++l)
+                    {
+                        localMax = std::max(localMax,
+                                            std::fabs(newVal[l] - oldVal[l]));
+                    }
+                    return localMax;
+                },
+                [](double a, double b) { return std::max(a, b); });
+
+            if (maxDelta <= m_convergenceTolerance * dtau)
+            {
+                std::swap(tempAcc, outputAcc);
+
+                CUBBYFLOW_INFO << "Reinitialization converged after "
+                               << n + 1 << " of " << numberOfIterations
+                               << " iterations";
+                break;
+            }
+        }
 
         std::swap(tempAcc, outputAcc);
     }
@@ -142,10 +213,11 @@ void IterativeLevelSetSolver3::Extrapolate(const CollocatedVectorGrid3& input,
     Extrapolate(v, sdfGrid.ConstAccessor(), gridSpacing, maxDistance, v0);
     Extrapolate(w, sdfGrid.ConstAccessor(), gridSpacing, maxDistance, w0);
 
+    auto outputAcc = output->GetDataAccessor();
     output->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-        (*output)(i, j, k).x = u(i, j, k);
-        (*output)(i, j, k).y = v(i, j, k);
-        (*output)(i, j, k).z = w(i, j, k);
+        outputAcc(i, j, k).x = u(i, j, k);
+        outputAcc(i, j, k).y = v(i, j, k);
+        outputAcc(i, j, k).z = w(i, j, k);
     });
 }
 
@@ -252,6 +324,26 @@ void IterativeLevelSetSolver3::SetMaxCFL(double newMaxCFL)
     m_maxCFL = std::max(newMaxCFL, 0.0);
 }
 
+double IterativeLevelSetSolver3::GetNarrowBandWidth() const
+{
+    return m_narrowBandWidth;
+}
+
+void IterativeLevelSetSolver3::SetNarrowBandWidth(double newWidth)
+{
+    m_narrowBandWidth = std::max(newWidth, 0.0);
+}
+
+double IterativeLevelSetSolver3::GetConvergenceTolerance() const
+{
+    return m_convergenceTolerance;
+}
+
+void IterativeLevelSetSolver3::SetConvergenceTolerance(double newTolerance)
+{
+    m_convergenceTolerance = std::max(newTolerance, 0.0);
+}
+
 unsigned int IterativeLevelSetSolver3::DistanceToNumberOfIterations(
     double distance, double dtau)
 {
@@ -274,20 +366,27 @@ double IterativeLevelSetSolver3::PseudoTimeStep(
 
     const double h = std::max({ gridSpacing.x, gridSpacing.y, gridSpacing.z });
 
-    double maxS = -std::numeric_limits<double>::max();
     double dtau = m_maxCFL * h;
 
-    for (size_t k = 0; k < size.z; ++k)
-    {
-        for (size_t j = 0; j < size.y; ++j)
-        {
-            for (size_t i = 0; i < size.x; ++i)
+    // The smoothed sign only depends on the cell value, so the scan can run
+    // flat over the data array with the smoothing epsilon hoisted out of the
+    // loop instead of re-deriving it from the grid spacing per cell.
+    const double e = std::min({ gridSpacing.x, gridSpacing.y, gridSpacing.z });
+    const double* data = sdf.data();
+    const size_t numCells = size.x * size.y * size.z;
+
+    const double maxS = ParallelReduce(
+        ZERO_SIZE, numCells, -std::numeric_limits<double>::max(),
+        [&](size_t begin, size_t end, double init) {
+            double localMax = init;
+            for (size_t l = begin; l < end; ++l)
             {
-                double s = Sign(sdf, gridSpacing, i, j, k);
-                maxS = std::max(s, maxS);
+                const double d = data[l];
+                localMax = std::max(localMax, d / std::sqrt(d * d + e * e));
             }
-        }
-    }
+            return localMax;
+        },
+        [](double a, double b) { return std::max(a, b); });
 
     while (dtau * maxS / h > m_maxCFL)
     {
@@ -8,16 +8,33 @@
 // personal capacity and are not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <Core/FDM/FDMMGLinearSystem3.hpp>
+#include <Core/Geometry/MarchingCubes.hpp>
 #include <Core/Grid/CellCenteredScalarGrid3.hpp>
 #include <Core/Solver/LevelSet/ENOLevelSetSolver3.hpp>
 #include <Core/Solver/LevelSet/FMMLevelSetSolver3.hpp>
+#include <Core/Solver/LevelSet/IterativeLevelSetSolver3.hpp>
 #include <Core/Solver/LevelSet/LevelSetLiquidSolver3.hpp>
 #include <Core/Utils/LevelSetUtils.hpp>
 #include <Core/Utils/Logging.hpp>
 #include <Core/Utils/Timer.hpp>
 
+#include <algorithm>
+#include <random>
+
 namespace CubbyFlow
 {
+namespace
+{
+//! Particle level set tuning constants. Band width and radii are measured in
+//! grid cells.
+constexpr size_t LSP_PARTICLES_PER_CELL = 16;
+constexpr double LSP_BAND_WIDTH_FACTOR = 3.0;
+constexpr double LSP_MIN_RADIUS_FACTOR = 0.1;
+constexpr double LSP_MAX_RADIUS_FACTOR = 0.5;
+constexpr unsigned int LSP_RESEED_INTERVAL = 20;
+}  // namespace
+
 LevelSetLiquidSolver3::LevelSetLiquidSolver3()
     : LevelSetLiquidSolver3{ { 1, 1, 1 }, { 1, 1, 1 }, { 0, 0, 0 } }
 {
@@ -36,6 +53,14 @@ LevelSetLiquidSolver3::LevelSetLiquidSolver3(const Size3& resolution,
     m_levelSetSolver = std::make_shared<ENOLevelSetSolver3>();
 }
 
+LevelSetLiquidSolver3::~LevelSetLiquidSolver3()
+{
+    if (m_previewThread.joinable())
+    {
+        m_previewThread.join();
+    }
+}
+
 ScalarGrid3Ptr LevelSetLiquidSolver3::GetSignedDistanceField() const
 {
     return GetGridSystemData()->GetAdvectableScalarDataAt(
@@ -63,6 +88,32 @@ void LevelSetLiquidSolver3::SetIsGlobalCompensationEnabled(bool isEnabled)
     m_isGlobalCompensationEnabled = isEnabled;
 }
 
+void LevelSetLiquidSolver3::SetIsNarrowBandEnabled(bool isEnabled)
+{
+    m_isNarrowBandEnabled = isEnabled;
+}
+
+void LevelSetLiquidSolver3::SetIsParticleLevelSetEnabled(bool isEnabled)
+{
+    m_isParticleLevelSetEnabled = isEnabled;
+}
+
+ParticleSystemData3Ptr LevelSetLiquidSolver3::GetLevelSetParticles() const
+{
+    return m_levelSetParticles;
+}
+
+void LevelSetLiquidSolver3::SetIsSurfacePreviewEnabled(bool isEnabled)
+{
+    m_isSurfacePreviewEnabled = isEnabled;
+}
+
+TriangleMesh3Ptr LevelSetLiquidSolver3::GetSurfacePreview() const
+{
+    std::lock_guard<std::mutex> lock{ m_previewMutex };
+    return m_previewMesh;
+}
+
 double LevelSetLiquidSolver3::ComputeVolume() const
 {
     ScalarGrid3Ptr sdf = GetSignedDistanceField();
@@ -93,11 +144,34 @@ void LevelSetLiquidSolver3::OnEndAdvanceTimeStep(double timeIntervalInSeconds)
 {
     const double currentCFL = GetCFL(timeIntervalInSeconds);
 
+    // The particle correction runs on both sides of the reinitialization:
+    // once to restore features the grid advection lost before they get
+    // smoothed further, and once to undo any interface movement the
+    // reinitialization itself introduced near restored features.
+    if (m_isParticleLevelSetEnabled && m_levelSetParticles != nullptr)
+    {
+        CorrectSDFWithParticles();
+    }
+
     const Timer timer;
     Reinitialize(currentCFL);
     CUBBYFLOW_INFO << "reinitializing level set field took "
                    << timer.DurationInSeconds() << " seconds";
 
+    if (m_isParticleLevelSetEnabled && m_levelSetParticles != nullptr)
+    {
+        CorrectSDFWithParticles();
+
+        if (++m_stepsSinceReseed >= LSP_RESEED_INTERVAL)
+        {
+            ReseedLevelSetParticles();
+        }
+        else
+        {
+            AdjustLevelSetParticleRadii();
+        }
+    }
+
     // Measure current volume
     double currentVol = ComputeVolume();
     const double volDiff = currentVol - m_lastKnownVolume;
@@ -112,6 +186,11 @@ void LevelSetLiquidSolver3::OnEndAdvanceTimeStep(double timeIntervalInSeconds)
         currentVol = ComputeVolume();
         CUBBYFLOW_INFO << "Volume after global compensation: " << currentVol;
     }
+
+    if (m_isSurfacePreviewEnabled)
+    {
+        ExtractSurfacePreview();
+    }
 }
 
 void LevelSetLiquidSolver3::ComputeAdvection(double timeIntervalInSeconds)
@@ -123,6 +202,18 @@ void LevelSetLiquidSolver3::ComputeAdvection(double timeIntervalInSeconds)
     CUBBYFLOW_INFO << "velocity extrapolation took "
                    << timer.DurationInSeconds() << " seconds";
 
+    // The marker particles ride the same (extrapolated) velocity field the
+    // grid is about to be advected through.
+    if (m_isParticleLevelSetEnabled)
+    {
+        if (m_levelSetParticles == nullptr)
+        {
+            ReseedLevelSetParticles();
+        }
+
+        AdvectLevelSetParticles(timeIntervalInSeconds);
+    }
+
     GridFluidSolver3::ComputeAdvection(timeIntervalInSeconds);
 }
 
@@ -145,6 +236,16 @@ void LevelSetLiquidSolver3::Reinitialize(double currentCfl)
 
         CUBBYFLOW_INFO << "Max reinitialize distance: " << maxReinitDist;
 
+        if (const auto iterativeSolver =
+                std::dynamic_pointer_cast<IterativeLevelSetSolver3>(
+                    m_levelSetSolver))
+        {
+            // Pad the band by two cells so the derivative stencils at the
+            // edge of the reinitialized region see reinitialized values.
+            iterativeSolver->SetNarrowBandWidth(
+                m_isNarrowBandEnabled ? maxReinitDist + 2.0 * h : 0.0);
+        }
+
         m_levelSetSolver->Reinitialize(*sdf0, maxReinitDist, sdf.get());
         ExtrapolateIntoCollider(sdf.get());
     }
@@ -243,6 +344,295 @@ void LevelSetLiquidSolver3::AddVolume(double volDiff)
     }
 }
 
+void LevelSetLiquidSolver3::ReseedLevelSetParticles()
+{
+    const ScalarGrid3Ptr sdf = GetSignedDistanceField();
+    const Vector3D gridSpacing = sdf->GridSpacing();
+    const double h = gridSpacing.Max();
+    const double bandWidth = LSP_BAND_WIDTH_FACTOR * h;
+    const double minRadius = LSP_MIN_RADIUS_FACTOR * h;
+    const double maxRadius = LSP_MAX_RADIUS_FACTOR * h;
+
+    const auto dataPos = sdf->GetDataPosition();
+
+    std::mt19937 rng{ 0 };
+    std::uniform_real_distribution<double> jitter{ -0.5, 0.5 };
+
+    std::vector<Vector3D> positions;
+    std::vector<double> signs;
+    std::vector<double> radii;
+
+    sdf->ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (std::abs((*sdf)(i, j, k)) > bandWidth)
+        {
+            return;
+        }
+
+        const Vector3D cellCenter = dataPos(i, j, k);
+
+        for (size_t p = 0; p < LSP_PARTICLES_PER_CELL; ++p)
+        {
+            const Vector3D pt =
+                cellCenter + Vector3D{ jitter(rng) * gridSpacing.x,
+                                       jitter(rng) * gridSpacing.y,
+                                       jitter(rng) * gridSpacing.z };
+
+            const double phi = sdf->Sample(pt);
+            if (std::abs(phi) > bandWidth)
+            {
+                continue;
+            }
+
+            positions.push_back(pt);
+            signs.push_back(IsInsideSDF(phi) ? -1.0 : 1.0);
+            radii.push_back(std::clamp(std::abs(phi), minRadius, maxRadius));
+        }
+    });
+
+    m_levelSetParticles = std::make_shared<ParticleSystemData3>();
+    m_particleSignDataId = m_levelSetParticles->AddScalarData();
+    m_particleRadiusDataId = m_levelSetParticles->AddScalarData();
+    m_levelSetParticles->AddParticles(
+        ConstArrayAccessor1<Vector3D>{ positions.size(), positions.data() });
+
+    ArrayAccessor1<double> signData =
+        m_levelSetParticles->ScalarDataAt(m_particleSignDataId);
+    ArrayAccessor1<double> radiusData =
+        m_levelSetParticles->ScalarDataAt(m_particleRadiusDataId);
+    ParallelFor(ZERO_SIZE, positions.size(), [&](size_t i) {
+        signData[i] = signs[i];
+        radiusData[i] = radii[i];
+    });
+
+    m_stepsSinceReseed = 0;
+
+    CUBBYFLOW_INFO << "Reseeded " << positions.size()
+                   << " level set particles";
+}
+
+void LevelSetLiquidSolver3::AdvectLevelSetParticles(
+    double timeIntervalInSeconds)
+{
+    const FaceCenteredGrid3Ptr vel = GetGridSystemData()->GetVelocity();
+    const BoundingBox3D boundingBox = GetGridSystemData()->GetBoundingBox();
+
+    ArrayAccessor1<Vector3D> positions = m_levelSetParticles->GetPositions();
+
+    ParallelFor(
+        ZERO_SIZE, m_levelSetParticles->GetNumberOfParticles(),
+        [&](size_t i) {
+            // Mid-point rule
+            const Vector3D pt0 = positions[i];
+            const Vector3D midPt =
+                pt0 + 0.5 * timeIntervalInSeconds * vel->Sample(pt0);
+            const Vector3D pt1 =
+                pt0 + timeIntervalInSeconds * vel->Sample(midPt);
+
+            positions[i] = boundingBox.Clamp(pt1);
+        });
+}
+
+void LevelSetLiquidSolver3::CorrectSDFWithParticles()
+{
+    const ScalarGrid3Ptr sdf = GetSignedDistanceField();
+    const Size3 size = sdf->GetDataSize();
+    const Vector3D gridSpacing = sdf->GridSpacing();
+    const Vector3D dataOrigin = sdf->GetDataOrigin();
+    const auto dataPos = sdf->GetDataPosition();
+
+    const ConstArrayAccessor1<Vector3D> positions =
+        m_levelSetParticles->GetPositions();
+    const ConstArrayAccessor1<double> signData =
+        std::as_const(*m_levelSetParticles)
+            .ScalarDataAt(m_particleSignDataId);
+    const ConstArrayAccessor1<double> radiusData =
+        std::as_const(*m_levelSetParticles)
+            .ScalarDataAt(m_particleRadiusDataId);
+
+    // An escaped particle sits on the wrong side of the interface, deeper
+    // than its own radius — the grid has locally lost the front it was
+    // tracking.
+    std::vector<size_t> escaped;
+    for (size_t i = 0; i < m_levelSetParticles->GetNumberOfParticles(); ++i)
+    {
+        const double phi = sdf->Sample(positions[i]);
+        if (signData[i] * phi < 0.0 && std::abs(phi) > radiusData[i])
+        {
+            escaped.push_back(i);
+        }
+    }
+
+    if (escaped.empty())
+    {
+        return;
+    }
+
+    // Rebuild per-sign candidates from the escaped particles' spheres, then
+    // keep whichever candidate lies closer to the interface (Enright et al.)
+    Array3<double> phiPlus{ size };
+    Array3<double> phiMinus{ size };
+    sdf->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        phiPlus(i, j, k) = (*sdf)(i, j, k);
+        phiMinus(i, j, k) = (*sdf)(i, j, k);
+    });
+
+    for (const size_t p : escaped)
+    {
+        const Vector3D pt = positions[p];
+        const double sp = signData[p];
+        const double rp = radiusData[p];
+
+        const Vector3D normalized = (pt - dataOrigin) / gridSpacing;
+        const auto iBegin = static_cast<size_t>(
+            std::max(std::floor(normalized.x - rp / gridSpacing.x), 0.0));
+        const auto jBegin = static_cast<size_t>(
+            std::max(std::floor(normalized.y - rp / gridSpacing.y), 0.0));
+        const auto kBegin = static_cast<size_t>(
+            std::max(std::floor(normalized.z - rp / gridSpacing.z), 0.0));
+        const size_t iEnd = std::min(
+            static_cast<size_t>(std::ceil(normalized.x + rp / gridSpacing.x)),
+            size.x - 1);
+        const size_t jEnd = std::min(
+            static_cast<size_t>(std::ceil(normalized.y + rp / gridSpacing.y)),
+            size.y - 1);
+        const size_t kEnd = std::min(
+            static_cast<size_t>(std::ceil(normalized.z + rp / gridSpacing.z)),
+            size.z - 1);
+
+        for (size_t k = kBegin; k <= kEnd; ++k)
+        {
+            for (size_t j = jBegin; j <= jEnd; ++j)
+            {
+                for (size_t i = iBegin; i <= iEnd; ++i)
+                {
+                    const double dist = (dataPos(i, j, k) - pt).Length();
+                    const double phiP = sp * (rp - dist);
+
+                    if (sp > 0.0)
+                    {
+                        phiPlus(i, j, k) = std::max(phiPlus(i, j, k), phiP);
+                    }
+                    else
+                    {
+                        phiMinus(i, j, k) = std::min(phiMinus(i, j, k), phiP);
+                    }
+                }
+            }
+        }
+    }
+
+    sdf->ParallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        (*sdf)(i, j, k) =
+            (std::abs(phiPlus(i, j, k)) <= std::abs(phiMinus(i, j, k)))
+                ? phiPlus(i, j, k)
+                : phiMinus(i, j, k);
+    });
+
+    CUBBYFLOW_INFO << "Corrected level set with " << escaped.size()
+                   << " escaped particles";
+}
+
+void LevelSetLiquidSolver3::AdjustLevelSetParticleRadii()
+{
+    const ScalarGrid3Ptr sdf = GetSignedDistanceField();
+    const double h = sdf->GridSpacing().Max();
+    const double minRadius = LSP_MIN_RADIUS_FACTOR * h;
+    const double maxRadius = LSP_MAX_RADIUS_FACTOR * h;
+
+    const ConstArrayAccessor1<Vector3D> positions =
+        std::as_const(*m_levelSetParticles).GetPositions();
+    const ConstArrayAccessor1<double> signData =
+        std::as_const(*m_levelSetParticles)
+            .ScalarDataAt(m_particleSignDataId);
+    ArrayAccessor1<double> radiusData =
+        m_levelSetParticles->ScalarDataAt(m_particleRadiusDataId);
+
+    ParallelFor(
+        ZERO_SIZE, m_levelSetParticles->GetNumberOfParticles(),
+        [&](size_t i) {
+            const double phi = sdf->Sample(positions[i]);
+
+            // Escaped particles keep their radius; their sphere is the only
+            // record of the lost front.
+            if (signData[i] * phi < 0.0)
+            {
+                return;
+            }
+
+            radiusData[i] = std::clamp(std::abs(phi), minRadius, maxRadius);
+        });
+}
+
+void LevelSetLiquidSolver3::ExtractSurfacePreview()
+{
+    // Never block the solver: while the previous extraction is still
+    // running, skip this frame and let the preview trail by a step.
+    if (m_previewInFlight)
+    {
+        return;
+    }
+
+    if (m_previewThread.joinable())
+    {
+        m_previewThread.join();
+    }
+
+    const ScalarGrid3Ptr sdf = GetSignedDistanceField();
+    const Size3 size = sdf->GetDataSize();
+
+    // Snapshot the field so the worker never races the next time-step.
+    Array3<double> snapshot{ size };
+    const ConstArrayAccessor3<double> src = sdf->GetConstDataAccessor();
+    std::copy(src.data(), src.data() + size.x * size.y * size.z,
+              snapshot.data());
+
+    m_previewInFlight = true;
+    m_previewThread = std::thread([this, snapshot = std::move(snapshot), size,
+                                   gridSpacing = sdf->GridSpacing(),
+                                   origin = sdf->Origin()]() mutable {
+        Array3<double> fine = std::move(snapshot);
+        Size3 previewSize = size;
+        Vector3D previewSpacing = gridSpacing;
+
+        // Each restriction halves the resolution. Stop early when a
+        // dimension no longer divides evenly (or gets too small) so the
+        // preview stays well defined on any grid size.
+        for (int level = 0; level < 2; ++level)
+        {
+            if (previewSize.x % 2 != 0 || previewSize.y % 2 != 0 ||
+                previewSize.z % 2 != 0 || previewSize.x < 4 ||
+                previewSize.y < 4 || previewSize.z < 4)
+            {
+                break;
+            }
+
+            Array3<double> coarse{ Size3{ previewSize.x / 2,
+                                          previewSize.y / 2,
+                                          previewSize.z / 2 } };
+            FDMMGUtils3::Restrict(fine, &coarse);
+            fine.Swap(coarse);
+            previewSize = fine.size();
+            previewSpacing *= 2.0;
+        }
+
+        // The cell-centered restriction keeps sample (i, j, k) centered at
+        // origin + (i + 0.5) * spacing, so the coarse data origin follows
+        // the same formula with the doubled spacing.
+        const Vector3D previewOrigin = origin + 0.5 * previewSpacing;
+
+        auto mesh = std::make_shared<TriangleMesh3>();
+        MarchingCubes(fine.ConstAccessor(), previewSpacing, previewOrigin,
+                      mesh.get(), 0.0);
+
+        {
+            std::lock_guard<std::mutex> lock{ m_previewMutex };
+            m_previewMesh = mesh;
+        }
+
+        m_previewInFlight = false;
+    });
+}
+
 LevelSetLiquidSolver3::Builder LevelSetLiquidSolver3::GetBuilder()
 {
     return Builder{};
@@ -50,6 +50,16 @@ void PCISPHSolver3::SetMaxNumberOfIterations(unsigned int n)
     m_maxNumberOfIterations = n;
 }
 
+unsigned int PCISPHSolver3::GetLastNumberOfIterations() const
+{
+    return m_lastNumberOfIterations;
+}
+
+double PCISPHSolver3::GetLastMaxDensityErrorRatio() const
+{
+    return m_lastMaxDensityErrorRatio;
+}
+
 void PCISPHSolver3::AccumulatePressureForce(double timeIntervalInSeconds)
 {
     SPHSystemData3Ptr particles = GetSPHSystemData();
@@ -64,10 +74,12 @@ void PCISPHSolver3::AccumulatePressureForce(double timeIntervalInSeconds)
     ArrayAccessor1<Vector3D> v = particles->GetVelocities();
     ArrayAccessor1<Vector3D> f = particles->GetForces();
 
-    // Predicted density ds
-    Array1<double> ds(numberOfParticles, 0.0);
+    // Predicted density; persistent scratch pre-sized in
+    // OnBeginAdvanceTimeStep
+    ArrayAccessor1<double> ds = m_predictedDensities.Accessor();
 
     SPHStdKernel3 kernel{ particles->GetKernelRadius() };
+    const auto& neighborLists = particles->GetCompactNeighborLists();
 
     // Initialize buffers
     ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
@@ -97,14 +109,12 @@ void PCISPHSolver3::AccumulatePressureForce(double timeIntervalInSeconds)
         // Compute pressure from density error
         ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
             double weightSum = 0.0;
-            const auto& neighbors = particles->GetNeighborLists()[i];
 
-            for (size_t j : neighbors)
-            {
+            neighborLists.ForEachNeighbor(i, [&](size_t j) {
                 const double dist =
                     m_tempPositions[j].DistanceTo(m_tempPositions[i]);
                 weightSum += kernel(dist);
-            }
+            });
             weightSum += kernel(0);
 
             const double density = mass * weightSum;
@@ -124,25 +134,40 @@ void PCISPHSolver3::AccumulatePressureForce(double timeIntervalInSeconds)
 
         // Compute pressure gradient force
         m_pressureForces.Set(Vector3D{});
-        SPHSolver3::AccumulatePressureForce(x, ds.ConstAccessor(), p,
-                                            m_pressureForces.Accessor());
+        SPHSolver3::AccumulatePressureForce(
+            x, m_predictedDensities.ConstAccessor(), p,
+            m_pressureForces.Accessor());
 
         // Compute max density error
-        maxDensityError = 0.0;
-        for (size_t i = 0; i < numberOfParticles; ++i)
-        {
-            maxDensityError = AbsMax(maxDensityError, m_densityErrors[i]);
-        }
+        maxDensityError = ParallelReduce(
+            ZERO_SIZE, numberOfParticles, 0.0,
+            [&](size_t begin, size_t end, double init) {
+                double localMax = init;
+
+                for (size_t i = begin; i < end; ++i)
+                {
+                    localMax = AbsMax(localMax, m_densityErrors[i]);
+                }
+
+                return localMax;
+            },
+            [](double a, double b) { return AbsMax(a, b); });
 
         densityErrorRatio = maxDensityError / targetDensity;
         maxNumIter = k + 1;
 
+        CUBBYFLOW_INFO << "PCI iteration " << maxNumIter
+                       << " density error ratio: " << densityErrorRatio;
+
         if (std::fabs(densityErrorRatio) < m_maxDensityErrorRatio)
         {
             break;
         }
     }
 
+    m_lastNumberOfIterations = maxNumIter;
+    m_lastMaxDensityErrorRatio = densityErrorRatio;
+
     CUBBYFLOW_INFO << "Number of PCI iterations: " << maxNumIter;
     CUBBYFLOW_INFO << "Max density error after PCI iteration: "
                    << maxDensityError;
@@ -171,6 +196,7 @@ void PCISPHSolver3::OnBeginAdvanceTimeStep(double timeStepInSeconds)
     m_tempVelocities.Resize(numberOfParticles);
     m_pressureForces.Resize(numberOfParticles);
     m_densityErrors.Resize(numberOfParticles);
+    m_predictedDensities.Resize(numberOfParticles);
 }
 
 double PCISPHSolver3::ComputeDelta(double timeStepInSeconds) const
@@ -101,6 +101,17 @@ void ParticleSystemSolver3::SetWind(const VectorField3Ptr& newWind)
     m_wind = newWind;
 }
 
+unsigned int ParticleSystemSolver3::GetNumberOfTimeIntegrationTiers() const
+{
+    return m_numberOfTimeIntegrationTiers;
+}
+
+void ParticleSystemSolver3::SetNumberOfTimeIntegrationTiers(
+    unsigned int newNumberOfTiers)
+{
+    m_numberOfTimeIntegrationTiers = std::clamp(newNumberOfTiers, 1U, 4U);
+}
+
 void ParticleSystemSolver3::OnInitialize()
 {
     // When initializing the solver, update the collider and emitter state as
@@ -116,6 +127,33 @@ void ParticleSystemSolver3::OnInitialize()
                    << " seconds";
 }
 
+void ParticleSystemSolver3::OnSaveCheckpoint(Checkpoint* checkpoint) const
+{
+    PhysicsAnimation::OnSaveCheckpoint(checkpoint);
+
+    std::vector<uint8_t> buffer;
+    m_particleSystemData->Serialize(&buffer);
+    checkpoint->Set("particleSystemData", std::move(buffer));
+}
+
+bool ParticleSystemSolver3::OnLoadCheckpoint(const Checkpoint& checkpoint)
+{
+    if (!PhysicsAnimation::OnLoadCheckpoint(checkpoint))
+    {
+        return false;
+    }
+
+    const std::vector<uint8_t>* buffer = checkpoint.Get("particleSystemData");
+    if (buffer == nullptr)
+    {
+        return false;
+    }
+
+    m_particleSystemData->Deserialize(*buffer);
+
+    return true;
+}
+
 void ParticleSystemSolver3::OnAdvanceTimeStep(double timeStepInSeconds)
 {
     BeginAdvanceTimeStep(timeStepInSeconds);
@@ -126,7 +164,14 @@ void ParticleSystemSolver3::OnAdvanceTimeStep(double timeStepInSeconds)
                    << " seconds";
 
     timer.Reset();
-    TimeIntegration(timeStepInSeconds);
+    if (m_numberOfTimeIntegrationTiers > 1)
+    {
+        TieredTimeIntegration(timeStepInSeconds);
+    }
+    else
+    {
+        TimeIntegration(timeStepInSeconds);
+    }
     CUBBYFLOW_INFO << "Time integration took " << timer.DurationInSeconds()
                    << " seconds";
 
@@ -212,10 +257,44 @@ void ParticleSystemSolver3::ResolveCollision(
             m_particleSystemData->GetNumberOfParticles();
         const double radius = m_particleSystemData->GetRadius();
 
-        ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
-            m_collider->ResolveCollision(radius, m_restitutionCoefficient,
-                                         &newPositions[i], &newVelocities[i]);
-        });
+        const Surface3Ptr& surface = m_collider->GetSurface();
+        if (surface->IsValidGeometry() && surface->IsBounded())
+        {
+            // A particle can only penetrate the collider if it sits within
+            // the collider bounds expanded by its radius, so gather that
+            // subset first and run the expensive surface queries on it alone.
+            BoundingBox3D bounds = surface->BoundingBox();
+            bounds.Expand(radius);
+
+            std::vector<char> nearCollider(numberOfParticles);
+            ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+                nearCollider[i] = bounds.Contains(newPositions[i]) ? 1 : 0;
+            });
+
+            std::vector<size_t> candidates;
+            for (size_t i = 0; i < numberOfParticles; ++i)
+            {
+                if (nearCollider[i] != 0)
+                {
+                    candidates.push_back(i);
+                }
+            }
+
+            ParallelFor(ZERO_SIZE, candidates.size(), [&](size_t i) {
+                const size_t particleIndex = candidates[i];
+                m_collider->ResolveCollision(radius, m_restitutionCoefficient,
+                                             &newPositions[particleIndex],
+                                             &newVelocities[particleIndex]);
+            });
+        }
+        else
+        {
+            ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+                m_collider->ResolveCollision(radius, m_restitutionCoefficient,
+                                             &newPositions[i],
+                                             &newVelocities[i]);
+            });
+        }
     }
 }
 
@@ -267,6 +346,64 @@ void ParticleSystemSolver3::TimeIntegration(double timeStepInSeconds)
     });
 }
 
+void ParticleSystemSolver3::TieredTimeIntegration(double timeStepInSeconds)
+{
+    const size_t n = m_particleSystemData->GetNumberOfParticles();
+    ArrayAccessor<Vector3D, 1> forces = m_particleSystemData->GetForces();
+    ArrayAccessor<Vector3D, 1> velocities =
+        m_particleSystemData->GetVelocities();
+    ArrayAccessor<Vector3D, 1> positions = m_particleSystemData->GetPositions();
+    const double mass = m_particleSystemData->GetMass();
+    const double radius = m_particleSystemData->GetRadius();
+
+    // Particles in tier k take 2^k sub-steps of the accumulated force, so
+    // the fastest particles subdivide their position update and collision
+    // response without shrinking the global time-step for everyone else.
+    // The tier is picked from the local CFL number: how far the particle
+    // travels within the step, including the velocity the pending force
+    // will add, measured in particle radii.
+    const size_t maxSubSteps = static_cast<size_t>(1)
+                               << (m_numberOfTimeIntegrationTiers - 1);
+
+    ParallelFor(ZERO_SIZE, n, [&](size_t i) {
+        const Vector3D acceleration = forces[i] / mass;
+        const double endSpeed =
+            (velocities[i] + timeStepInSeconds * acceleration).Length();
+        const double travelInRadii = timeStepInSeconds * endSpeed / radius;
+
+        size_t numberOfSubSteps = 1;
+        while (numberOfSubSteps < maxSubSteps &&
+               travelInRadii > static_cast<double>(numberOfSubSteps))
+        {
+            numberOfSubSteps *= 2;
+        }
+
+        const double subTimeStep =
+            timeStepInSeconds / static_cast<double>(numberOfSubSteps);
+
+        Vector3D newVelocity = velocities[i];
+        Vector3D newPosition = positions[i];
+
+        for (size_t step = 0; step < numberOfSubSteps; ++step)
+        {
+            newVelocity += subTimeStep * acceleration;
+            newPosition += subTimeStep * newVelocity;
+
+            // Resolve collisions mid-flight so fast particles cannot tunnel
+            // through the collider within a single global step. The final
+            // sub-step is covered by the common ResolveCollision pass.
+            if (m_collider != nullptr && step + 1 < numberOfSubSteps)
+            {
+                m_collider->ResolveCollision(radius, m_restitutionCoefficient,
+                                             &newPosition, &newVelocity);
+            }
+        }
+
+        m_newVelocities[i] = newVelocity;
+        m_newPositions[i] = newPosition;
+    });
+}
+
 void ParticleSystemSolver3::UpdateCollider(double timeStepInSeconds) const
 {
     if (m_collider != nullptr)
@@ -8,17 +8,144 @@
 // personal capacity and are not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <Core/Math/CG.hpp>
 #include <Core/Particle/SPH/SPHStdKernel3.hpp>
 #include <Core/Solver/Particle/SPH/SPHSolver3.hpp>
 #include <Core/Utils/Logging.hpp>
 #include <Core/Utils/PhysicsHelpers.hpp>
+#include <Core/Utils/Profiler.hpp>
 #include <Core/Utils/Timer.hpp>
 
+#include <array>
+#include <vector>
+
 namespace CubbyFlow
 {
 static double TIME_STEP_LIMIT_BY_SPEED_FACTOR = 0.4;
 static double TIME_STEP_LIMIT_BY_FORCE_FACTOR = 0.25;
 
+static unsigned int IMPLICIT_VISCOSITY_MAX_NUMBER_OF_ITERATIONS = 100;
+static double IMPLICIT_VISCOSITY_RELATIVE_TOLERANCE = 1e-6;
+
+namespace
+{
+//!
+//! \brief Matrix-free representation of (I - dt * nu * L) over the particles.
+//!
+//! The Laplacian coefficient between particles i and j uses the symmetrized
+//! density weight 2 / (d_i + d_j) instead of the explicit path's 1 / d_j so
+//! that the operator is symmetric positive definite, which conjugate gradient
+//! requires. The two forms agree for nearly uniform density.
+//!
+struct ImplicitViscosityMatrix
+{
+    const ParticleSystemData3::CompactNeighborLists* neighborLists = nullptr;
+    ConstArrayAccessor1<Vector3D> positions;
+    ConstArrayAccessor1<double> densities;
+    SPHSpikyKernel3 kernel;
+
+    //! dt * nu * mass.
+    double scale = 0.0;
+};
+
+//! BLAS-like wrapper over per-particle vector channels so the generic CG
+//! solver can run directly on the particle system's data.
+struct ImplicitViscosityBLAS
+{
+    using ScalarType = double;
+    using VectorType = std::vector<Vector3D>;
+    using MatrixType = ImplicitViscosityMatrix;
+
+    static void Set(double s, VectorType* result)
+    {
+        std::fill(result->begin(), result->end(), Vector3D{ s, s, s });
+    }
+
+    static void Set(const VectorType& v, VectorType* result)
+    {
+        *result = v;
+    }
+
+    static double Dot(const VectorType& a, const VectorType& b)
+    {
+        return ParallelReduce(
+            ZERO_SIZE, a.size(), 0.0,
+            [&](size_t begin, size_t end, double init) {
+                double sum = init;
+
+                for (size_t i = begin; i < end; ++i)
+                {
+                    sum += a[i].Dot(b[i]);
+                }
+
+                return sum;
+            },
+            std::plus<double>());
+    }
+
+    static void AXPlusY(double a, const VectorType& x, const VectorType& y,
+                        VectorType* result)
+    {
+        ParallelFor(ZERO_SIZE, x.size(),
+                    [&](size_t i) { (*result)[i] = a * x[i] + y[i]; });
+    }
+
+    static void MVM(const MatrixType& m, const VectorType& v,
+                    VectorType* result)
+    {
+        const auto& neighborLists = *m.neighborLists;
+
+        ParallelFor(ZERO_SIZE, v.size(), [&](size_t i) {
+            std::array<double, SPHSpikyKernel3::BATCH_SIZE> dists{};
+            std::array<double, SPHSpikyKernel3::BATCH_SIZE> laplacians{};
+            std::array<size_t, SPHSpikyKernel3::BATCH_SIZE> neighbors{};
+            size_t count = 0;
+
+            Vector3D sum = v[i];
+
+            const auto flush = [&]() {
+                m.kernel.SecondDerivative(dists.data(), count,
+                                          laplacians.data());
+
+                for (size_t n = 0; n < count; ++n)
+                {
+                    const size_t j = neighbors[n];
+                    const double coefficient =
+                        m.scale * laplacians[n] * 2.0 /
+                        (m.densities[i] + m.densities[j]);
+                    sum -= coefficient * (v[j] - v[i]);
+                }
+
+                count = 0;
+            };
+
+            neighborLists.ForEachNeighbor(i, [&](size_t j) {
+                dists[count] = m.positions[i].DistanceTo(m.positions[j]);
+                neighbors[count] = j;
+
+                if (++count == SPHSpikyKernel3::BATCH_SIZE)
+                {
+                    flush();
+                }
+            });
+
+            flush();
+
+            (*result)[i] = sum;
+        });
+    }
+
+    static void Residual(const MatrixType& m, const VectorType& x,
+                         const VectorType& b, VectorType* result)
+    {
+        MVM(m, x, result);
+
+        ParallelFor(ZERO_SIZE, x.size(),
+                    [&](size_t i) { (*result)[i] = b[i] - (*result)[i]; });
+    }
+};
+}  // namespace
+
 SPHSolver3::SPHSolver3()
 {
     SetParticleSystemData(std::make_shared<SPHSystemData3>());
@@ -66,6 +193,26 @@ void SPHSolver3::SetViscosityCoefficient(double newViscosityCoefficient)
     m_viscosityCoefficient = std::max(newViscosityCoefficient, 0.0);
 }
 
+bool SPHSolver3::GetUseImplicitViscosity() const
+{
+    return m_useImplicitViscosity;
+}
+
+void SPHSolver3::SetUseImplicitViscosity(bool isOn)
+{
+    m_useImplicitViscosity = isOn;
+}
+
+unsigned int SPHSolver3::GetReorderInterval() const
+{
+    return m_reorderInterval;
+}
+
+void SPHSolver3::SetReorderInterval(unsigned int newReorderInterval)
+{
+    m_reorderInterval = newReorderInterval;
+}
+
 double SPHSolver3::GetPseudoViscosityCoefficient() const
 {
     return m_pseudoViscosityCoefficient;
@@ -142,14 +289,28 @@ void SPHSolver3::AccumulateForces(double timeStepInSeconds)
 
 void SPHSolver3::OnBeginAdvanceTimeStep(double timeStepInSeconds)
 {
+    CUBBYFLOW_PROFILE_ZONE("SPHSolver3::OnBeginAdvanceTimeStep");
+
     UNUSED_VARIABLE(timeStepInSeconds);
 
     SPHSystemData3Ptr particles = GetSPHSystemData();
 
     const Timer timer;
-    particles->BuildNeighborSearcher();
+
+    // Periodically permute the attribute arrays into the searcher's sorted
+    // order so that neighbor gathers read near-contiguous memory. The pass
+    // uses the ordering of the previous sub-time-step's searcher, which is
+    // still close to cell order for CFL-limited displacements.
+    if (m_reorderInterval > 0 && m_subTimeStepCount > 0 &&
+        m_subTimeStepCount % m_reorderInterval == 0)
+    {
+        particles->ReorderParticles();
+    }
+    ++m_subTimeStepCount;
+
+    particles->UpdateNeighborSearcher();
     particles->BuildNeighborLists();
-    particles->UpdateDensities();
+    UpdateDensitiesAndPressures();
 
     CUBBYFLOW_INFO << "Building neighbor lists and updating densities took "
                    << timer.DurationInSeconds() << " seconds";
@@ -176,12 +337,24 @@ void SPHSolver3::OnEndAdvanceTimeStep(double timeStepInSeconds)
 
 void SPHSolver3::AccumulateNonPressureForces(double timeStepInSeconds)
 {
+    CUBBYFLOW_PROFILE_ZONE("SPHSolver3::AccumulateNonPressureForces");
+
     ParticleSystemSolver3::AccumulateForces(timeStepInSeconds);
-    AccumulateViscosityForce();
+
+    if (m_useImplicitViscosity)
+    {
+        AccumulateImplicitViscosityForce(timeStepInSeconds);
+    }
+    else
+    {
+        AccumulateViscosityForce();
+    }
 }
 
 void SPHSolver3::AccumulatePressureForce(double timeStepInSeconds)
 {
+    CUBBYFLOW_PROFILE_ZONE("SPHSolver3::AccumulatePressureForce");
+
     UNUSED_VARIABLE(timeStepInSeconds);
 
     SPHSystemData3Ptr particles = GetSPHSystemData();
@@ -190,7 +363,8 @@ void SPHSolver3::AccumulatePressureForce(double timeStepInSeconds)
     const ArrayAccessor1<double> p = particles->GetPressures();
     const ArrayAccessor1<Vector3D> f = particles->GetForces();
 
-    ComputePressure();
+    // Pressures are already up to date: the equation of state ran fused
+    // with the density pass at the beginning of the sub-time-step.
     AccumulatePressureForce(x, d, p, f);
 }
 
@@ -213,6 +387,46 @@ void SPHSolver3::ComputePressure()
     });
 }
 
+void SPHSolver3::UpdateDensitiesAndPressures()
+{
+    SPHSystemData3Ptr particles = GetSPHSystemData();
+    const size_t numberOfParticles = particles->GetNumberOfParticles();
+    ArrayAccessor1<Vector3D> x = particles->GetPositions();
+    ArrayAccessor1<double> d = particles->GetDensities();
+    ArrayAccessor1<double> p = particles->GetPressures();
+    const double mass = particles->GetMass();
+
+    const double targetDensity = particles->GetTargetDensity();
+    const double eosScale = targetDensity * Square(m_speedOfSound);
+    const double eosExponent = GetEosExponent();
+    const double negativePressureScale = GetNegativePressureScale();
+
+    const auto& neighborLists = particles->GetCompactNeighborLists();
+
+    if (neighborLists.offsets.size() == numberOfParticles + 1)
+    {
+        const SPHStdKernel3 kernel{ particles->GetKernelRadius() };
+
+        ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+            const Vector3D origin = x[i];
+            double sum = kernel(0.0);
+
+            neighborLists.ForEachNeighbor(i, [&](size_t j) {
+                sum += kernel(origin.DistanceTo(x[j]));
+            });
+
+            d[i] = mass * sum;
+            p[i] = ComputePressureFromEos(d[i], targetDensity, eosScale,
+                                          eosExponent, negativePressureScale);
+        });
+    }
+    else
+    {
+        particles->UpdateDensities();
+        ComputePressure();
+    }
+}
+
 void SPHSolver3::AccumulatePressureForce(
     const ConstArrayAccessor1<Vector3D>& positions,
     const ConstArrayAccessor1<double>& densities,
@@ -224,22 +438,47 @@ void SPHSolver3::AccumulatePressureForce(
 
     const double massSquared = Square(particles->GetMass());
     const SPHSpikyKernel3 kernel{ particles->GetKernelRadius() };
+    const auto& neighborLists = particles->GetCompactNeighborLists();
 
     ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
-        const auto& neighbors = particles->GetNeighborLists()[i];
-        for (size_t j : neighbors)
-        {
-            const double dist = positions[i].DistanceTo(positions[j]);
-            if (dist > 0.0)
+        std::array<double, SPHSpikyKernel3::BATCH_SIZE> dists{};
+        std::array<double, SPHSpikyKernel3::BATCH_SIZE> gradients{};
+        std::array<size_t, SPHSpikyKernel3::BATCH_SIZE> neighbors{};
+        size_t count = 0;
+
+        const auto flush = [&]() {
+            kernel.FirstDerivative(dists.data(), count, gradients.data());
+
+            for (size_t n = 0; n < count; ++n)
             {
-                Vector3D dir = (positions[j] - positions[i]) / dist;
-                pressureForces[i] -=
+                const size_t j = neighbors[n];
+                const Vector3D dir =
+                    (positions[j] - positions[i]) / dists[n];
+                pressureForces[i] +=
                     massSquared *
                     (pressures[i] / (densities[i] * densities[i]) +
                      pressures[j] / (densities[j] * densities[j])) *
-                    kernel.Gradient(dist, dir);
+                    gradients[n] * dir;
             }
-        }
+
+            count = 0;
+        };
+
+        neighborLists.ForEachNeighbor(i, [&](size_t j) {
+            const double dist = positions[i].DistanceTo(positions[j]);
+            if (dist > 0.0)
+            {
+                dists[count] = dist;
+                neighbors[count] = j;
+
+                if (++count == SPHSpikyKernel3::BATCH_SIZE)
+                {
+                    flush();
+                }
+            }
+        });
+
+        flush();
     });
 }
 
@@ -254,21 +493,104 @@ void SPHSolver3::AccumulateViscosityForce()
 
     const double massSquared = Square(particles->GetMass());
     const SPHSpikyKernel3 kernel{ particles->GetKernelRadius() };
+    const auto& neighborLists = particles->GetCompactNeighborLists();
 
     ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
-        const auto& neighbors = particles->GetNeighborLists()[i];
-        for (size_t j : neighbors)
-        {
-            const double dist = x[i].DistanceTo(x[j]);
+        std::array<double, SPHSpikyKernel3::BATCH_SIZE> dists{};
+        std::array<double, SPHSpikyKernel3::BATCH_SIZE> laplacians{};
+        std::array<size_t, SPHSpikyKernel3::BATCH_SIZE> neighbors{};
+        size_t count = 0;
 
-            f[i] += GetViscosityCoefficient() * massSquared * (v[j] - v[i]) /
-                    d[j] * kernel.SecondDerivative(dist);
-        }
+        const auto flush = [&]() {
+            kernel.SecondDerivative(dists.data(), count, laplacians.data());
+
+            for (size_t n = 0; n < count; ++n)
+            {
+                const size_t j = neighbors[n];
+                f[i] += GetViscosityCoefficient() * massSquared *
+                        (v[j] - v[i]) / d[j] * laplacians[n];
+            }
+
+            count = 0;
+        };
+
+        neighborLists.ForEachNeighbor(i, [&](size_t j) {
+            dists[count] = x[i].DistanceTo(x[j]);
+            neighbors[count] = j;
+
+            if (++count == SPHSpikyKernel3::BATCH_SIZE)
+            {
+                flush();
+            }
+        });
+
+        flush();
+    });
+}
+
+void SPHSolver3::AccumulateImplicitViscosityForce(double timeStepInSeconds)
+{
+    CUBBYFLOW_PROFILE_ZONE("SPHSolver3::AccumulateImplicitViscosityForce");
+
+    SPHSystemData3Ptr particles = GetSPHSystemData();
+    const size_t numberOfParticles = particles->GetNumberOfParticles();
+    const auto& neighborLists = particles->GetCompactNeighborLists();
+
+    if (numberOfParticles == 0 || timeStepInSeconds <= 0.0 ||
+        neighborLists.offsets.size() != numberOfParticles + 1)
+    {
+        AccumulateViscosityForce();
+        return;
+    }
+
+    ArrayAccessor1<Vector3D> v = particles->GetVelocities();
+    ArrayAccessor1<Vector3D> f = particles->GetForces();
+    const double mass = particles->GetMass();
+
+    ImplicitViscosityMatrix system;
+    system.neighborLists = &neighborLists;
+    system.positions = particles->GetPositions();
+    system.densities = particles->GetDensities();
+    system.kernel = SPHSpikyKernel3{ particles->GetKernelRadius() };
+    system.scale = timeStepInSeconds * m_viscosityCoefficient * mass;
+
+    std::vector<Vector3D> b{ v.begin(), v.end() };
+    std::vector<Vector3D> solution = b;
+    std::vector<Vector3D> r(numberOfParticles);
+    std::vector<Vector3D> d(numberOfParticles);
+    std::vector<Vector3D> q(numberOfParticles);
+    std::vector<Vector3D> s(numberOfParticles);
+
+    // The CG tolerance is an absolute residual norm, so scale the relative
+    // target by the right-hand side to make convergence independent of the
+    // overall velocity magnitude.
+    const double tolerance = IMPLICIT_VISCOSITY_RELATIVE_TOLERANCE *
+                             std::sqrt(ImplicitViscosityBLAS::Dot(b, b));
+
+    unsigned int lastNumberOfIterations = 0;
+    double lastResidualNorm = 0.0;
+
+    CG<ImplicitViscosityBLAS>(system, b,
+                              IMPLICIT_VISCOSITY_MAX_NUMBER_OF_ITERATIONS,
+                              tolerance, &solution, &r, &d, &q, &s,
+                              &lastNumberOfIterations, &lastResidualNorm);
+
+    CUBBYFLOW_INFO << "Implicit viscosity solve took "
+                   << lastNumberOfIterations
+                   << " CG iterations with residual norm "
+                   << lastResidualNorm;
+
+    // Apply the solved velocity change as an equivalent force so the result
+    // flows through the common time integration step.
+    ParallelFor(ZERO_SIZE, numberOfParticles, [&](size_t i) {
+        f[i] += mass * (solution[i] - v[i]) / timeStepInSeconds;
     });
 }
 
 void SPHSolver3::ComputePseudoViscosity(double timeStepInSeconds)
 {
+    CUBBYFLOW_PROFILE_ZONE("SPHSolver3::ComputePseudoViscosity");
+
     SPHSystemData3Ptr particles = GetSPHSystemData();
     const size_t numberOfParticles = particles->GetNumberOfParticles();
     ArrayAccessor1<Vector3D> x = particles->GetPositions();
@@ -277,6 +599,7 @@ void SPHSolver3::ComputePseudoViscosity(double timeStepInSeconds)
 
     const double mass = particles->GetMass();
     const SPHSpikyKernel3 kernel{ particles->GetKernelRadius() };
+    const auto& neighborLists = particles->GetCompactNeighborLists();
 
     Array1<Vector3D> smoothedVelocities{ numberOfParticles };
 
@@ -284,14 +607,12 @@ void SPHSolver3::ComputePseudoViscosity(double timeStepInSeconds)
         double weightSum = 0.0;
         Vector3D smoothedVelocity;
 
-        const auto& neighbors = particles->GetNeighborLists()[i];
-        for (size_t j : neighbors)
-        {
+        neighborLists.ForEachNeighbor(i, [&](size_t j) {
             const double dist = x[i].DistanceTo(x[j]);
             const double wj = mass / d[j] * kernel(dist);
             weightSum += wj;
             smoothedVelocity += wj * v[j];
-        }
+        });
 
         const double wi = mass / d[i];
         weightSum += wi;
@@ -26,87 +26,95 @@
 #include <Core/Searcher/PointParallelHashGridSearcher3.hpp>
 #include <Core/Searcher/PointSimpleListSearcher2.hpp>
 #include <Core/Searcher/PointSimpleListSearcher3.hpp>
+#include <Core/Searcher/PointTiledHashGridSearcher3.hpp>
 #include <Core/Utils/Factory.hpp>
 
-#include <memory>
-#include <unordered_map>
+#include <cstdint>
+#include <cstring>
 
 namespace CubbyFlow
 {
-std::unordered_map<std::string, ScalarGridBuilder2Ptr> sScalarGrid2Builders;
-std::unordered_map<std::string, ScalarGridBuilder3Ptr> sScalarGrid3Builders;
-
-std::unordered_map<std::string, VectorGridBuilder2Ptr> sVectorGrid2Builders;
-std::unordered_map<std::string, VectorGridBuilder3Ptr> sVectorGrid3Builders;
-
-std::unordered_map<std::string, PointNeighborSearcherBuilder2Ptr>
-    sPointNeighborSearcher2Builders;
-std::unordered_map<std::string, PointNeighborSearcherBuilder3Ptr>
-    sPointNeighborSearcher3Builders;
-
-#define REGISTER_BUILDER(map, ClassName) \
-    map.emplace(#ClassName, std::make_shared<ClassName::Builder>());
-
-#define REGISTER_SCALAR_GRID2_BUILDER(ClassName) \
-    REGISTER_BUILDER(sScalarGrid2Builders, ClassName)
-#define REGISTER_SCALAR_GRID3_BUILDER(ClassName) \
-    REGISTER_BUILDER(sScalarGrid3Builders, ClassName)
-
-#define REGISTER_VECTOR_GRID2_BUILDER(ClassName) \
-    REGISTER_BUILDER(sVectorGrid2Builders, ClassName)
-#define REGISTER_VECTOR_GRID3_BUILDER(ClassName) \
-    REGISTER_BUILDER(sVectorGrid3Builders, ClassName)
+namespace
+{
+//! Compile-time FNV-1a hash of a type name. Evaluated at compile time for the
+//! case labels below and once at runtime for the queried name, so dispatching
+//! allocates nothing. A collision between two registered names would show up
+//! as a duplicate-case compile error.
+constexpr uint64_t TypeNameHash(const char* name)
+{
+    uint64_t hash = 14695981039346656037ULL;
 
-#define REGISTER_POINT_NEIGHBOR_SEARCHER2_BUILDER(ClassName) \
-    REGISTER_BUILDER(sPointNeighborSearcher2Builders, ClassName)
-#define REGISTER_POINT_NEIGHBOR_SEARCHER3_BUILDER(ClassName) \
-    REGISTER_BUILDER(sPointNeighborSearcher3Builders, ClassName)
+    while (*name != '\0')
+    {
+        hash ^= static_cast<uint64_t>(
+            static_cast<unsigned char>(*name));
+        hash *= 1099511628211ULL;
+        ++name;
+    }
 
-class Registry
+    return hash;
+}
+}  // namespace
+
+//! One dispatch case: the hash pre-filters, the strcmp confirms the match so
+//! an unknown name that happens to collide still falls through to nullptr.
+#define FACTORY_TYPE_CASE(ClassName, expr)       \
+    case TypeNameHash(#ClassName):               \
+        if (std::strcmp(name, #ClassName) == 0)  \
+        {                                        \
+            return expr;                         \
+        }                                        \
+        break;
+
+#define FACTORY_VECTOR_GRID2_CASE(ClassName)                 \
+    FACTORY_TYPE_CASE(ClassName, ClassName::Builder{}.Build( \
+                                     { 0, 0 }, { 1, 1 }, { 0, 0 }, { 0, 0 }))
+
+#define FACTORY_SCALAR_GRID2_CASE(ClassName)                             \
+    FACTORY_TYPE_CASE(ClassName, ClassName::Builder{}.Build(             \
+                                     { 0, 0 }, { 1, 1 }, { 0, 0 }, 0.0))
+
+#define FACTORY_VECTOR_GRID3_CASE(ClassName)                   \
+    FACTORY_TYPE_CASE(ClassName, ClassName::Builder{}.Build(   \
+                                     { 0, 0, 0 }, { 1, 1, 1 }, \
+                                     { 0, 0, 0 }, { 0, 0, 0 }))
+
+#define FACTORY_SCALAR_GRID3_CASE(ClassName)                 \
+    FACTORY_TYPE_CASE(ClassName, ClassName::Builder{}.Build( \
+                                     { 0, 0, 0 }, { 1, 1, 1 }, \
+                                     { 0, 0, 0 }, 0.0))
+
+#define FACTORY_SEARCHER_CASE(ClassName) \
+    FACTORY_TYPE_CASE(ClassName, ClassName::Builder{}.BuildPointNeighborSearcher())
+
+ScalarGrid2Ptr Factory::BuildScalarGrid2(const char* name)
 {
- public:
-    Registry()
+    switch (TypeNameHash(name))
     {
-        REGISTER_SCALAR_GRID2_BUILDER(CellCenteredScalarGrid2)
-        REGISTER_SCALAR_GRID3_BUILDER(CellCenteredScalarGrid3)
-
-        REGISTER_VECTOR_GRID2_BUILDER(CellCenteredVectorGrid2)
-        REGISTER_VECTOR_GRID3_BUILDER(CellCenteredVectorGrid3)
+        FACTORY_SCALAR_GRID2_CASE(CellCenteredScalarGrid2)
+        FACTORY_SCALAR_GRID2_CASE(VertexCenteredScalarGrid2)
 
-        REGISTER_VECTOR_GRID2_BUILDER(FaceCenteredGrid2)
-        REGISTER_VECTOR_GRID3_BUILDER(FaceCenteredGrid3)
-
-        REGISTER_SCALAR_GRID2_BUILDER(VertexCenteredScalarGrid2)
-        REGISTER_SCALAR_GRID3_BUILDER(VertexCenteredScalarGrid3)
-
-        REGISTER_VECTOR_GRID2_BUILDER(VertexCenteredVectorGrid2)
-        REGISTER_VECTOR_GRID3_BUILDER(VertexCenteredVectorGrid3)
-
-        REGISTER_POINT_NEIGHBOR_SEARCHER2_BUILDER(PointHashGridSearcher2)
-        REGISTER_POINT_NEIGHBOR_SEARCHER3_BUILDER(PointHashGridSearcher3)
-
-        REGISTER_POINT_NEIGHBOR_SEARCHER2_BUILDER(
-            PointParallelHashGridSearcher2)
-        REGISTER_POINT_NEIGHBOR_SEARCHER3_BUILDER(
-            PointParallelHashGridSearcher3)
-
-        REGISTER_POINT_NEIGHBOR_SEARCHER2_BUILDER(PointSimpleListSearcher2)
-        REGISTER_POINT_NEIGHBOR_SEARCHER3_BUILDER(PointSimpleListSearcher3)
-
-        REGISTER_POINT_NEIGHBOR_SEARCHER2_BUILDER(PointKdTreeSearcher2)
-        REGISTER_POINT_NEIGHBOR_SEARCHER3_BUILDER(PointKdTreeSearcher3)
+        default:
+            break;
     }
-};
 
-static Registry sRegistry;
+    return nullptr;
+}
 
 ScalarGrid2Ptr Factory::BuildScalarGrid2(const std::string& name)
 {
-    const auto result = sScalarGrid2Builders.find(name);
-    if (result != sScalarGrid2Builders.end())
+    return BuildScalarGrid2(name.c_str());
+}
+
+ScalarGrid3Ptr Factory::BuildScalarGrid3(const char* name)
+{
+    switch (TypeNameHash(name))
     {
-        const auto builder = result->second;
-        return builder->Build({ 0, 0 }, { 1, 1 }, { 0, 0 }, 0.0);
+        FACTORY_SCALAR_GRID3_CASE(CellCenteredScalarGrid3)
+        FACTORY_SCALAR_GRID3_CASE(VertexCenteredScalarGrid3)
+
+        default:
+            break;
     }
 
     return nullptr;
@@ -114,11 +122,19 @@ ScalarGrid2Ptr Factory::BuildScalarGrid2(const std::string& name)
 
 ScalarGrid3Ptr Factory::BuildScalarGrid3(const std::string& name)
 {
-    const auto result = sScalarGrid3Builders.find(name);
-    if (result != sScalarGrid3Builders.end())
+    return BuildScalarGrid3(name.c_str());
+}
+
+VectorGrid2Ptr Factory::BuildVectorGrid2(const char* name)
+{
+    switch (TypeNameHash(name))
     {
-        const auto builder = result->second;
-        return builder->Build({ 0, 0, 0 }, { 1, 1, 1 }, { 0, 0, 0 }, 0.0);
+        FACTORY_VECTOR_GRID2_CASE(CellCenteredVectorGrid2)
+        FACTORY_VECTOR_GRID2_CASE(FaceCenteredGrid2)
+        FACTORY_VECTOR_GRID2_CASE(VertexCenteredVectorGrid2)
+
+        default:
+            break;
     }
 
     return nullptr;
@@ -126,11 +142,19 @@ ScalarGrid3Ptr Factory::BuildScalarGrid3(const std::string& name)
 
 VectorGrid2Ptr Factory::BuildVectorGrid2(const std::string& name)
 {
-    const auto result = sVectorGrid2Builders.find(name);
-    if (result != sVectorGrid2Builders.end())
+    return BuildVectorGrid2(name.c_str());
+}
+
+VectorGrid3Ptr Factory::BuildVectorGrid3(const char* name)
+{
+    switch (TypeNameHash(name))
     {
-        const auto builder = result->second;
-        return builder->Build({ 0, 0 }, { 1, 1 }, { 0, 0 }, { 0, 0 });
+        FACTORY_VECTOR_GRID3_CASE(CellCenteredVectorGrid3)
+        FACTORY_VECTOR_GRID3_CASE(FaceCenteredGrid3)
+        FACTORY_VECTOR_GRID3_CASE(VertexCenteredVectorGrid3)
+
+        default:
+            break;
     }
 
     return nullptr;
@@ -138,12 +162,21 @@ VectorGrid2Ptr Factory::BuildVectorGrid2(const std::string& name)
 
 VectorGrid3Ptr Factory::BuildVectorGrid3(const std::string& name)
 {
-    const auto result = sVectorGrid3Builders.find(name);
-    if (result != sVectorGrid3Builders.end())
+    return BuildVectorGrid3(name.c_str());
+}
+
+PointNeighborSearcher2Ptr Factory::BuildPointNeighborSearcher2(
+    const char* name)
+{
+    switch (TypeNameHash(name))
     {
-        const auto builder = result->second;
-        return builder->Build({ 0, 0, 0 }, { 1, 1, 1 }, { 0, 0, 0 },
-                              { 0, 0, 0 });
+        FACTORY_SEARCHER_CASE(PointHashGridSearcher2)
+        FACTORY_SEARCHER_CASE(PointParallelHashGridSearcher2)
+        FACTORY_SEARCHER_CASE(PointSimpleListSearcher2)
+        FACTORY_SEARCHER_CASE(PointKdTreeSearcher2)
+
+        default:
+            break;
     }
 
     return nullptr;
@@ -152,11 +185,22 @@ VectorGrid3Ptr Factory::BuildVectorGrid3(const std::string& name)
 PointNeighborSearcher2Ptr Factory::BuildPointNeighborSearcher2(
     const std::string& name)
 {
-    const auto result = sPointNeighborSearcher2Builders.find(name);
-    if (result != sPointNeighborSearcher2Builders.end())
+    return BuildPointNeighborSearcher2(name.c_str());
+}
+
+PointNeighborSearcher3Ptr Factory::BuildPointNeighborSearcher3(
+    const char* name)
+{
+    switch (TypeNameHash(name))
     {
-        const auto builder = result->second;
-        return builder->BuildPointNeighborSearcher();
+        FACTORY_SEARCHER_CASE(PointHashGridSearcher3)
+        FACTORY_SEARCHER_CASE(PointParallelHashGridSearcher3)
+        FACTORY_SEARCHER_CASE(PointSimpleListSearcher3)
+        FACTORY_SEARCHER_CASE(PointKdTreeSearcher3)
+        FACTORY_SEARCHER_CASE(PointTiledHashGridSearcher3)
+
+        default:
+            break;
     }
 
     return nullptr;
@@ -165,13 +209,6 @@ PointNeighborSearcher2Ptr Factory::BuildPointNeighborSearcher2(
 PointNeighborSearcher3Ptr Factory::BuildPointNeighborSearcher3(
     const std::string& name)
 {
-    const auto result = sPointNeighborSearcher3Builders.find(name);
-    if (result != sPointNeighborSearcher3Builders.end())
-    {
-        const auto builder = result->second;
-        return builder->BuildPointNeighborSearcher();
-    }
-
-    return nullptr;
+    return BuildPointNeighborSearcher3(name.c_str());
 }
-}  // namespace CubbyFlow
\ No newline at end of file
+}  // namespace CubbyFlow
@@ -0,0 +1,255 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/GridDataCodec.hpp>
+#include <Core/Utils/HalfFloat.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace CubbyFlow
+{
+namespace
+{
+// Buffer layout:
+//   [uint64 valueCount][uint8 quantization][uint32 chunkCount]
+//   [uint64 payloadBytes x chunkCount][payloads back to back]
+// Each chunk covers CHUNK_VALUE_COUNT values (the last one possibly fewer)
+// and is encoded independently, which is what allows the parallel codec.
+//
+// A chunk payload is a sequence of uint32 tokens. A token with the high bit
+// set is followed by one value that repeats (token & 0x7FFFFFFF) times; a
+// token with the high bit clear is followed by that many raw values. The
+// value width is 8 bytes (double) or 2 bytes (half), depending on the
+// quantization mode.
+constexpr size_t CHUNK_VALUE_COUNT = static_cast<size_t>(64) * 64 * 64;
+constexpr uint32_t RUN_TOKEN_BIT = 0x80000000U;
+
+// Runs shorter than this are cheaper to leave in the literal block than to
+// pay for two extra tokens.
+constexpr size_t MIN_RUN_LENGTH = 4;
+
+template <typename T>
+void AppendPOD(std::vector<uint8_t>* buffer, const T& value)
+{
+    const size_t offset = buffer->size();
+    buffer->resize(offset + sizeof(T));
+    std::memcpy(buffer->data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T ReadPOD(const uint8_t* data, size_t* offset)
+{
+    T value;
+    std::memcpy(&value, data + *offset, sizeof(T));
+    *offset += sizeof(T);
+    return value;
+}
+
+template <typename ValueType>
+void EncodeChunk(const ValueType* values, size_t count,
+                 std::vector<uint8_t>* payload)
+{
+    size_t literalBegin = 0;
+    size_t i = 0;
+
+    const auto flushLiterals = [&](size_t literalEnd) {
+        size_t remaining = literalEnd - literalBegin;
+        size_t offset = literalBegin;
+
+        while (remaining > 0)
+        {
+            const size_t blockSize =
+                std::min(remaining, static_cast<size_t>(0x7FFFFFFF));
+            AppendPOD(payload, static_cast<uint32_t>(blockSize));
+
+            const size_t byteCount = blockSize * sizeof(ValueType);
+            const size_t payloadOffset = payload->size();
+            payload->resize(payloadOffset + byteCount);
+            std::memcpy(payload->data() + payloadOffset, values + offset,
+                        byteCount);
+
+            offset += blockSize;
+            remaining -= blockSize;
+        }
+    };
+
+    while (i < count)
+    {
+        size_t runEnd = i + 1;
+        while (runEnd < count && values[runEnd] == values[i])
+        {
+            ++runEnd;
+        }
+
+        const size_t runLength = runEnd - i;
+        if (runLength >= MIN_RUN_LENGTH)
+        {
+            flushLiterals(i);
+
+            size_t remaining = runLength;
+            while (remaining > 0)
+            {
+                const size_t blockSize =
+                    std::min(remaining, static_cast<size_t>(0x7FFFFFFF));
+                AppendPOD(payload,
+                          static_cast<uint32_t>(blockSize) | RUN_TOKEN_BIT);
+                AppendPOD(payload, values[i]);
+                remaining -= blockSize;
+            }
+
+            literalBegin = runEnd;
+        }
+
+        i = runEnd;
+    }
+
+    flushLiterals(count);
+}
+
+template <typename ValueType>
+void DecodeChunk(const uint8_t* payload, size_t payloadSize, ValueType* values,
+                 size_t count)
+{
+    size_t offset = 0;
+    size_t produced = 0;
+
+    while (offset < payloadSize && produced < count)
+    {
+        const auto token = ReadPOD<uint32_t>(payload, &offset);
+        const size_t blockSize = token & ~RUN_TOKEN_BIT;
+
+        assert(produced + blockSize <= count);
+
+        if ((token & RUN_TOKEN_BIT) != 0)
+        {
+            const auto value = ReadPOD<ValueType>(payload, &offset);
+            std::fill(values + produced, values + produced + blockSize,
+                      value);
+        }
+        else
+        {
+            std::memcpy(values + produced, payload + offset,
+                        blockSize * sizeof(ValueType));
+            offset += blockSize * sizeof(ValueType);
+        }
+
+        produced += blockSize;
+    }
+
+    assert(produced == count);
+}
+}  // namespace
+
+void CompressGridData(const std::vector<double>& values,
+                      GridDataQuantization quantization,
+                      std::vector<uint8_t>* buffer)
+{
+    const size_t valueCount = values.size();
+    const size_t chunkCount =
+        (valueCount + CHUNK_VALUE_COUNT - 1) / CHUNK_VALUE_COUNT;
+
+    std::vector<std::vector<uint8_t>> payloads(chunkCount);
+
+    ParallelFor(ZERO_SIZE, chunkCount, [&](size_t chunkIdx) {
+        const size_t begin = chunkIdx * CHUNK_VALUE_COUNT;
+        const size_t count =
+            std::min(CHUNK_VALUE_COUNT, valueCount - begin);
+
+        if (quantization == GridDataQuantization::Float16)
+        {
+            std::vector<uint16_t> halves(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                halves[i] = DoubleToHalf(values[begin + i]);
+            }
+
+            EncodeChunk(halves.data(), count, &payloads[chunkIdx]);
+        }
+        else
+        {
+            EncodeChunk(values.data() + begin, count, &payloads[chunkIdx]);
+        }
+    });
+
+    buffer->clear();
+    AppendPOD(buffer, static_cast<uint64_t>(valueCount));
+    AppendPOD(buffer, static_cast<uint8_t>(quantization));
+    AppendPOD(buffer, static_cast<uint32_t>(chunkCount));
+
+    for (const std::vector<uint8_t>& payload : payloads)
+    {
+        AppendPOD(buffer, static_cast<uint64_t>(payload.size()));
+    }
+
+    for (const std::vector<uint8_t>& payload : payloads)
+    {
+        buffer->insert(buffer->end(), payload.begin(), payload.end());
+    }
+}
+
+void DecompressGridData(const uint8_t* data, size_t size,
+                        std::vector<double>* values)
+{
+    size_t offset = 0;
+    const auto valueCount =
+        static_cast<size_t>(ReadPOD<uint64_t>(data, &offset));
+    const auto quantization =
+        static_cast<GridDataQuantization>(ReadPOD<uint8_t>(data, &offset));
+    const auto chunkCount =
+        static_cast<size_t>(ReadPOD<uint32_t>(data, &offset));
+
+    std::vector<size_t> payloadSizes(chunkCount);
+    std::vector<size_t> payloadOffsets(chunkCount);
+
+    size_t payloadOffset =
+        offset + chunkCount * sizeof(uint64_t);
+    for (size_t i = 0; i < chunkCount; ++i)
+    {
+        payloadSizes[i] =
+            static_cast<size_t>(ReadPOD<uint64_t>(data, &offset));
+        payloadOffsets[i] = payloadOffset;
+        payloadOffset += payloadSizes[i];
+    }
+
+    assert(payloadOffset <= size);
+    (void)size;
+
+    values->resize(valueCount);
+
+    ParallelFor(ZERO_SIZE, chunkCount, [&](size_t chunkIdx) {
+        const size_t begin = chunkIdx * CHUNK_VALUE_COUNT;
+        const size_t count =
+            std::min(CHUNK_VALUE_COUNT, valueCount - begin);
+
+        if (quantization == GridDataQuantization::Float16)
+        {
+            std::vector<uint16_t> halves(count);
+            DecodeChunk(data + payloadOffsets[chunkIdx],
+                        payloadSizes[chunkIdx], halves.data(), count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                (*values)[begin + i] = HalfToDouble(halves[i]);
+            }
+        }
+        else
+        {
+            DecodeChunk(data + payloadOffsets[chunkIdx],
+                        payloadSizes[chunkIdx], values->data() + begin,
+                        count);
+        }
+    });
+}
+}  // namespace CubbyFlow
@@ -11,8 +11,12 @@
 #include <Core/Utils/Logging.hpp>
 #include <Core/Utils/Macros.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 namespace CubbyFlow
 {
@@ -22,7 +26,7 @@ static std::ostream* infoOutStream = &std::cout;
 static std::ostream* warnOutStream = &std::cout;
 static std::ostream* errorOutStream = &std::cerr;
 static std::ostream* debugOutStream = &std::cout;
-static LogLevel logLevel = LogLevel::All;
+static std::atomic<LogLevel> logLevel{ LogLevel::All };
 
 inline std::ostream* LevelToStream(LogLevel level)
 {
@@ -70,21 +74,223 @@ inline bool IsLeq(LogLevel a, LogLevel b)
     return static_cast<uint8_t>(a) <= static_cast<uint8_t>(b);
 }
 
-Logger::Logger(LogLevel level) : m_level{ level }
+namespace
+{
+//! One preformatted record handed from a producer to the drain thread.
+struct LogRecord
+{
+    LogLevel level = LogLevel::Off;
+    std::string message;
+};
+
+//!
+//! \brief Bounded lock-free multi-producer ring buffer of log records.
+//!
+//! Each slot carries a sequence number (Vyukov-style); producers claim a
+//! slot with a single compare-and-swap on the head counter and publish by
+//! bumping the slot sequence, so pushes never take a lock. The drain thread
+//! is the only consumer.
+//!
+class LogRecordQueue
+{
+ public:
+    explicit LogRecordQueue(size_t capacity) : m_slots(capacity)
+    {
+        // Capacity must be a power of two for the mask to work
+        m_mask = capacity - 1;
+
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool TryPush(LogRecord&& record)
+    {
+        size_t pos = m_head.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Slot& slot = m_slots[pos & m_mask];
+            const size_t sequence =
+                slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) -
+                              static_cast<intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (m_head.compare_exchange_weak(pos, pos + 1,
+                                                 std::memory_order_relaxed))
+                {
+                    slot.record = std::move(record);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // Full; the consumer has not freed this slot yet
+                return false;
+            }
+            else
+            {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool TryPop(LogRecord* record)
+    {
+        const size_t pos = m_tail.load(std::memory_order_relaxed);
+        Slot& slot = m_slots[pos & m_mask];
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<intptr_t>(sequence) -
+                          static_cast<intptr_t>(pos + 1);
+
+        if (diff != 0)
+        {
+            return false;
+        }
+
+        *record = std::move(slot.record);
+        slot.sequence.store(pos + m_mask + 1, std::memory_order_release);
+        m_tail.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    [[nodiscard]] bool IsEmpty() const
+    {
+        return m_tail.load(std::memory_order_acquire) ==
+               m_head.load(std::memory_order_acquire);
+    }
+
+ private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence{ 0 };
+        LogRecord record;
+    };
+
+    std::vector<Slot> m_slots;
+    std::atomic<size_t> m_head{ 0 };
+    std::atomic<size_t> m_tail{ 0 };
+    size_t m_mask = 0;
+};
+
+const size_t ASYNC_LOG_QUEUE_CAPACITY = 1024;
+
+//! Owns the ring buffer and the drain thread; constructed lazily on first
+//! enable and torn down (flushing) at program exit.
+class AsyncLogWriter
+{
+ public:
+    AsyncLogWriter() : m_queue(ASYNC_LOG_QUEUE_CAPACITY)
+    {
+        m_thread = std::thread([this] { Run(); });
+    }
+
+    ~AsyncLogWriter()
+    {
+        m_isRunning.store(false);
+        m_thread.join();
+    }
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter(AsyncLogWriter&&) noexcept = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(AsyncLogWriter&&) noexcept = delete;
+
+    void Enqueue(LogLevel level, std::string&& message)
+    {
+        LogRecord record{ level, std::move(message) };
+
+        m_numPending.fetch_add(1, std::memory_order_relaxed);
+
+        // Retry when full rather than dropping; the consumer keeps draining
+        while (!m_queue.TryPush(std::move(record)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void Flush()
+    {
+        while (m_numPending.load(std::memory_order_acquire) > 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+ private:
+    void Run()
+    {
+        LogRecord record;
+
+        while (m_isRunning.load() || !m_queue.IsEmpty())
+        {
+            if (m_queue.TryPop(&record))
+            {
+                WriteRecord(record);
+                m_numPending.fetch_sub(1, std::memory_order_release);
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    static void WriteRecord(const LogRecord& record)
+    {
+        std::lock_guard<std::mutex> lock(critical);
+
+        if (std::ostream* stream = LevelToStream(record.level))
+        {
+            *stream << record.message << std::endl;
+            stream->flush();
+        }
+    }
+
+    LogRecordQueue m_queue;
+    std::thread m_thread;
+    std::atomic<bool> m_isRunning{ true };
+    std::atomic<size_t> m_numPending{ 0 };
+};
+
+std::atomic<bool> asyncModeEnabled{ false };
+
+AsyncLogWriter* GetAsyncLogWriter()
+{
+    static AsyncLogWriter writer;
+    return &writer;
+}
+}  // namespace
+
+Logger::Logger(LogLevel level)
+    : m_level{ level },
+      m_isEnabled{ IsLeq(logLevel.load(std::memory_order_relaxed), level) }
 {
     // Do nothing
 }
 
 Logger::~Logger()
 {
-    std::lock_guard<std::mutex> lock(critical);
+    if (!m_isEnabled)
+    {
+        return;
+    }
 
-    if (IsLeq(logLevel, m_level))
+    if (asyncModeEnabled.load(std::memory_order_relaxed))
     {
-        std::ostream* stream = LevelToStream(m_level);
-        *stream << m_buffer.str() << std::endl;
-        stream->flush();
+        GetAsyncLogWriter()->Enqueue(m_level, m_buffer.str());
+        return;
     }
+
+    std::lock_guard<std::mutex> lock(critical);
+
+    std::ostream* stream = LevelToStream(m_level);
+    *stream << m_buffer.str() << std::endl;
+    stream->flush();
 }
 
 void Logging::SetInfoStream(std::ostream* stream)
@@ -121,6 +327,13 @@ void Logging::SetAllStream(std::ostream* stream)
 
 std::string Logging::GetHeader(LogLevel level)
 {
+    // Skip the timestamp formatting when the severity is filtered out; the
+    // disabled logger discards the header anyway.
+    if (!IsLeq(logLevel.load(std::memory_order_relaxed), level))
+    {
+        return "";
+    }
+
     auto now =
         std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
     char timeStr[20];
@@ -147,8 +360,43 @@ std::string Logging::GetHeader(LogLevel level)
 
 void Logging::SetLevel(LogLevel level)
 {
-    std::lock_guard<std::mutex> lock(critical);
-    logLevel = level;
+    logLevel.store(level, std::memory_order_relaxed);
+}
+
+LogLevel Logging::GetLevel()
+{
+    return logLevel.load(std::memory_order_relaxed);
+}
+
+void Logging::SetAsyncMode(bool enabled)
+{
+    if (enabled)
+    {
+        // Construct the writer before publishing the flag
+        GetAsyncLogWriter();
+        asyncModeEnabled.store(true);
+    }
+    else
+    {
+        const bool wasEnabled = asyncModeEnabled.exchange(false);
+        if (wasEnabled)
+        {
+            GetAsyncLogWriter()->Flush();
+        }
+    }
+}
+
+bool Logging::GetAsyncMode()
+{
+    return asyncModeEnabled.load();
+}
+
+void Logging::Flush()
+{
+    if (asyncModeEnabled.load())
+    {
+        GetAsyncLogWriter()->Flush();
+    }
 }
 
 void Logging::Mute()
@@ -0,0 +1,98 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Utils/MemoryStats.hpp>
+
+#include <mutex>
+#include <unordered_set>
+
+namespace CubbyFlow
+{
+namespace
+{
+std::mutex registryMutex;
+
+std::unordered_set<const MemoryStats*>& GetRegistry()
+{
+    static std::unordered_set<const MemoryStats*> registry;
+    return registry;
+}
+}  // namespace
+
+MemoryStats::MemoryStats()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    GetRegistry().insert(this);
+}
+
+MemoryStats::MemoryStats(const MemoryStats&) : MemoryStats{}
+{
+    // Do nothing
+}
+
+MemoryStats::MemoryStats(MemoryStats&&) noexcept
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    GetRegistry().insert(this);
+}
+
+MemoryStats::~MemoryStats()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    GetRegistry().erase(this);
+}
+
+size_t MemoryStats::GetMemoryUsage() const
+{
+    std::vector<MemoryUsageRecord> records;
+    ReportMemoryUsage(&records);
+
+    size_t total = 0;
+    for (const MemoryUsageRecord& record : records)
+    {
+        total += record.bytes;
+    }
+
+    return total;
+}
+
+void MemoryStats::EnumerateMemoryUsage(std::vector<MemoryUsageRecord>* records)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    std::vector<MemoryUsageRecord> instanceRecords;
+    for (const MemoryStats* instance : GetRegistry())
+    {
+        instanceRecords.clear();
+        instance->ReportMemoryUsage(&instanceRecords);
+
+        for (MemoryUsageRecord& record : instanceRecords)
+        {
+            records->push_back(
+                MemoryUsageRecord{ std::string{ instance->GetMemoryStatsName() } +
+                                       "." + record.component,
+                                   record.bytes });
+        }
+    }
+}
+
+size_t MemoryStats::GetTotalMemoryUsage()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    size_t total = 0;
+    for (const MemoryStats* instance : GetRegistry())
+    {
+        total += instance->GetMemoryUsage();
+    }
+
+    return total;
+}
+}  // namespace CubbyFlow
@@ -17,13 +17,222 @@
 #include <omp.h>
 #endif
 
+#if defined(CUBBYFLOW_TASKING_CPP11THREAD)
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+#endif
+
 #include <memory>
 #include <thread>
 
 static unsigned int MAX_NUMBER_OF_THREADS = std::thread::hardware_concurrency();
+static thread_local unsigned int CURRENT_THREAD_BUDGET = 0;
+static bool DETERMINISTIC_EXECUTION = false;
+static size_t PARALLEL_FOR_GRAIN_SIZE = 0;
 
 namespace CubbyFlow
 {
+#if defined(CUBBYFLOW_TASKING_CPP11THREAD)
+namespace
+{
+//! Pool-worker index of the calling thread, or INVALID_WORKER_INDEX for
+//! threads outside the pool. Lets a worker drain its own pinned queue while
+//! it waits, so pinned tasks cannot deadlock a worker against itself.
+constexpr size_t INVALID_WORKER_INDEX = static_cast<size_t>(-1);
+thread_local size_t THREAD_WORKER_INDEX = INVALID_WORKER_INDEX;
+
+//!
+//! \brief Persistent worker pool shared by all Parallel* primitives.
+//!
+//! Workers are spawned lazily on the first scheduled task and park on a
+//! condition variable between calls, so a ParallelFor invocation costs a
+//! queue push and a wakeup instead of thread creation. The pool grows up to
+//! GetMaxNumberOfThreads() workers but never shrinks; it drains and joins at
+//! static destruction time.
+//!
+//! Tasks come in two flavors: shared tasks are claimed by whichever thread
+//! gets there first, while pinned tasks target one specific worker and are
+//! never stolen. Pinning gives ExecutionPolicy::ParallelStatic its
+//! deterministic chunk-to-thread mapping.
+//!
+class WorkerPool
+{
+ public:
+    using TaskQueue = std::deque<std::function<void()>>;
+
+    static WorkerPool& GetInstance()
+    {
+        static WorkerPool instance;
+        return instance;
+    }
+
+    void Schedule(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+
+            EnsureWorkers();
+            m_tasks.push_back(std::move(task));
+        }
+
+        m_wakeUp.notify_one();
+    }
+
+    void ScheduleOnWorker(size_t workerIndex, std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+
+            EnsureWorkers();
+            m_pinnedTasks[workerIndex % m_workers.size()].push_back(
+                std::move(task));
+        }
+
+        // The target worker may not be the one notify_one would pick
+        m_wakeUp.notify_all();
+    }
+
+    void HelpWhileWaiting(const std::function<bool()>& isDone)
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+
+        while (!isDone())
+        {
+            TaskQueue* queue = ClaimableQueue();
+            if (queue == nullptr)
+            {
+                // Re-check isDone shortly even if no completion notification
+                // arrives; a task may finish on a thread outside the pool.
+                m_taskDone.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            else
+            {
+                RunOneTask(lock, *queue);
+            }
+        }
+    }
+
+ private:
+    WorkerPool() = default;
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            m_shutdown = true;
+        }
+
+        m_wakeUp.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    //! Grows the pool to the current thread-count hint. (m_mutex held)
+    void EnsureWorkers()
+    {
+        const unsigned int numThreadsHint = GetMaxNumberOfThreads();
+        const size_t numThreads = (numThreadsHint == 0u) ? 8u : numThreadsHint;
+
+        while (m_workers.size() < numThreads)
+        {
+            const size_t workerIndex = m_workers.size();
+
+            m_pinnedTasks.emplace_back();
+            m_workers.emplace_back(
+                [this, workerIndex]() { WorkerLoop(workerIndex); });
+        }
+    }
+
+    //! Returns the queue the calling thread may take a task from, preferring
+    //! its own pinned queue, or null if nothing is claimable. (m_mutex held)
+    TaskQueue* ClaimableQueue()
+    {
+        if (THREAD_WORKER_INDEX < m_pinnedTasks.size() &&
+            !m_pinnedTasks[THREAD_WORKER_INDEX].empty())
+        {
+            return &m_pinnedTasks[THREAD_WORKER_INDEX];
+        }
+
+        if (!m_tasks.empty())
+        {
+            return &m_tasks;
+        }
+
+        return nullptr;
+    }
+
+    void WorkerLoop(size_t workerIndex)
+    {
+        THREAD_WORKER_INDEX = workerIndex;
+
+        std::unique_lock<std::mutex> lock{ m_mutex };
+
+        while (true)
+        {
+            m_wakeUp.wait(lock, [this]() {
+                return m_shutdown || ClaimableQueue() != nullptr;
+            });
+
+            TaskQueue* queue = ClaimableQueue();
+            if (queue == nullptr)
+            {
+                return;
+            }
+
+            RunOneTask(lock, *queue);
+        }
+    }
+
+    //! Pops and runs the front task of \p queue with \p lock released during
+    //! the call.
+    void RunOneTask(std::unique_lock<std::mutex>& lock, TaskQueue& queue)
+    {
+        std::function<void()> task = std::move(queue.front());
+        queue.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        m_taskDone.notify_all();
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_taskDone;
+    TaskQueue m_tasks;
+    std::vector<TaskQueue> m_pinnedTasks;
+    std::vector<std::thread> m_workers;
+    bool m_shutdown = false;
+};
+}  // namespace
+
+namespace Internal
+{
+void ScheduleTask(std::function<void()> task)
+{
+    WorkerPool::GetInstance().Schedule(std::move(task));
+}
+
+void ScheduleTaskOnWorker(size_t workerIndex, std::function<void()> task)
+{
+    WorkerPool::GetInstance().ScheduleOnWorker(workerIndex, std::move(task));
+}
+
+void HelpWhileWaiting(const std::function<bool()>& isDone)
+{
+    WorkerPool::GetInstance().HelpWhileWaiting(isDone);
+}
+}  // namespace Internal
+#endif
+
 void SetMaxNumberOfThreads(unsigned int numThreads)
 {
 #if defined(CUBBYFLOW_TASKING_TBB)
@@ -46,6 +255,59 @@ void SetMaxNumberOfThreads(unsigned int numThreads)
 
 unsigned int GetMaxNumberOfThreads()
 {
+    if (CURRENT_THREAD_BUDGET > 0)
+    {
+        return std::min(MAX_NUMBER_OF_THREADS, CURRENT_THREAD_BUDGET);
+    }
+
     return MAX_NUMBER_OF_THREADS;
 }
+
+ScopedThreadBudget::ScopedThreadBudget(unsigned int numThreads)
+    : m_previousBudget{ CURRENT_THREAD_BUDGET }
+{
+    if (numThreads > 0)
+    {
+        CURRENT_THREAD_BUDGET = (m_previousBudget > 0)
+                                    ? std::min(m_previousBudget, numThreads)
+                                    : numThreads;
+    }
+}
+
+ScopedThreadBudget::~ScopedThreadBudget()
+{
+    CURRENT_THREAD_BUDGET = m_previousBudget;
+}
+
+unsigned int GetCurrentThreadBudget()
+{
+    return CURRENT_THREAD_BUDGET;
+}
+
+size_t GetMaxNumberOfWorkerSlots()
+{
+    // Mirrors the "hint == 0 means 8" convention of the loop launchers.
+    const unsigned int numThreads = GetMaxNumberOfThreads();
+    return (numThreads == 0u) ? 8u : numThreads;
+}
+
+void SetDeterministicExecution(bool enabled)
+{
+    DETERMINISTIC_EXECUTION = enabled;
+}
+
+bool GetDeterministicExecution()
+{
+    return DETERMINISTIC_EXECUTION;
+}
+
+void SetParallelForGrainSize(size_t grainSize)
+{
+    PARALLEL_FOR_GRAIN_SIZE = grainSize;
+}
+
+size_t GetParallelForGrainSize()
+{
+    return PARALLEL_FOR_GRAIN_SIZE;
+}
 }  // namespace CubbyFlow
\ No newline at end of file
@@ -0,0 +1,247 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Utils/Profiler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace CubbyFlow
+{
+namespace
+{
+std::atomic<bool> profilerEnabled{ false };
+
+//! A closed zone on some thread.
+struct ProfileEvent
+{
+    const char* name = nullptr;
+    double beginUs = 0.0;
+    double endUs = 0.0;
+    unsigned int threadID = 0;
+    double bytesRead = 0.0;
+    double bytesWritten = 0.0;
+    double flops = 0.0;
+};
+
+//! An open zone on the owning thread.
+struct OpenZone
+{
+    const char* name = nullptr;
+    double beginUs = 0.0;
+    double bytesRead = 0.0;
+    double bytesWritten = 0.0;
+    double flops = 0.0;
+};
+
+double NowInMicroseconds()
+{
+    static const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+std::mutex registryMutex;
+std::vector<ProfileEvent> retiredEvents;
+unsigned int nextThreadID = 0;
+
+struct ThreadEventBuffer;
+std::vector<ThreadEventBuffer*> liveBuffers;
+
+//! Per-thread zone stack and closed-event list. Registered globally on
+//! first use; closed events move to the retired list when the thread exits.
+struct ThreadEventBuffer
+{
+    ThreadEventBuffer()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        threadID = nextThreadID++;
+        liveBuffers.push_back(this);
+    }
+
+    ~ThreadEventBuffer()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        retiredEvents.insert(retiredEvents.end(), events.begin(),
+                             events.end());
+        liveBuffers.erase(
+            std::find(liveBuffers.begin(), liveBuffers.end(), this));
+    }
+
+    ThreadEventBuffer(const ThreadEventBuffer&) = delete;
+    ThreadEventBuffer(ThreadEventBuffer&&) noexcept = delete;
+    ThreadEventBuffer& operator=(const ThreadEventBuffer&) = delete;
+    ThreadEventBuffer& operator=(ThreadEventBuffer&&) noexcept = delete;
+
+    //! Guards events against a concurrent dump; zone begin/end only touch
+    //! it for the push, so contention is negligible.
+    std::mutex eventsMutex;
+    std::vector<ProfileEvent> events;
+    std::vector<OpenZone> zoneStack;
+    unsigned int threadID = 0;
+};
+
+ThreadEventBuffer* GetThreadEventBuffer()
+{
+    thread_local ThreadEventBuffer buffer;
+    return &buffer;
+}
+
+void WriteEventJSON(std::ostream* stream, const ProfileEvent& event,
+                    bool isFirst)
+{
+    if (!isFirst)
+    {
+        *stream << ",";
+    }
+
+    *stream << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"ts\":"
+            << event.beginUs << ",\"dur\":" << event.endUs - event.beginUs
+            << ",\"pid\":0,\"tid\":" << event.threadID;
+
+    if (event.bytesRead > 0.0 || event.bytesWritten > 0.0 ||
+        event.flops > 0.0)
+    {
+        *stream << ",\"args\":{\"bytesRead\":" << event.bytesRead
+                << ",\"bytesWritten\":" << event.bytesWritten
+                << ",\"flops\":" << event.flops;
+
+        const double seconds = (event.endUs - event.beginUs) * 1e-6;
+        if (seconds > 0.0)
+        {
+            *stream << ",\"GBps\":"
+                    << (event.bytesRead + event.bytesWritten) * 1e-9 /
+                           seconds
+                    << ",\"GFLOPS\":" << event.flops * 1e-9 / seconds;
+        }
+
+        *stream << "}";
+    }
+
+    *stream << "}";
+}
+}  // namespace
+
+void Profiler::SetEnabled(bool enabled)
+{
+    profilerEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::GetEnabled()
+{
+    return profilerEnabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::BeginZone(const char* name)
+{
+    ThreadEventBuffer* buffer = GetThreadEventBuffer();
+    buffer->zoneStack.push_back(OpenZone{ name, NowInMicroseconds() });
+}
+
+void Profiler::EndZone()
+{
+    ThreadEventBuffer* buffer = GetThreadEventBuffer();
+    if (buffer->zoneStack.empty())
+    {
+        return;
+    }
+
+    const OpenZone zone = buffer->zoneStack.back();
+    buffer->zoneStack.pop_back();
+
+    std::lock_guard<std::mutex> lock(buffer->eventsMutex);
+    buffer->events.push_back(ProfileEvent{ zone.name, zone.beginUs,
+                                           NowInMicroseconds(),
+                                           buffer->threadID, zone.bytesRead,
+                                           zone.bytesWritten, zone.flops });
+}
+
+void Profiler::ReportZoneCounters(double bytesRead, double bytesWritten,
+                                  double flops)
+{
+    if (!GetEnabled())
+    {
+        return;
+    }
+
+    ThreadEventBuffer* buffer = GetThreadEventBuffer();
+    if (buffer->zoneStack.empty())
+    {
+        return;
+    }
+
+    OpenZone& zone = buffer->zoneStack.back();
+    zone.bytesRead += bytesRead;
+    zone.bytesWritten += bytesWritten;
+    zone.flops += flops;
+}
+
+void Profiler::DumpChromeTrace(std::ostream* stream)
+{
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+
+    *stream << "{\"traceEvents\":[";
+
+    bool isFirst = true;
+    for (const ProfileEvent& event : retiredEvents)
+    {
+        WriteEventJSON(stream, event, isFirst);
+        isFirst = false;
+    }
+
+    for (ThreadEventBuffer* buffer : liveBuffers)
+    {
+        std::lock_guard<std::mutex> eventsLock(buffer->eventsMutex);
+        for (const ProfileEvent& event : buffer->events)
+        {
+            WriteEventJSON(stream, event, isFirst);
+            isFirst = false;
+        }
+    }
+
+    *stream << "]}";
+}
+
+void Profiler::Clear()
+{
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+
+    retiredEvents.clear();
+
+    for (ThreadEventBuffer* buffer : liveBuffers)
+    {
+        std::lock_guard<std::mutex> eventsLock(buffer->eventsMutex);
+        buffer->events.clear();
+    }
+}
+
+ProfileZone::ProfileZone(const char* name)
+    : m_isActive{ Profiler::GetEnabled() }
+{
+    if (m_isActive)
+    {
+        Profiler::BeginZone(name);
+    }
+}
+
+ProfileZone::~ProfileZone()
+{
+    if (m_isActive)
+    {
+        Profiler::EndZone();
+    }
+}
+}  // namespace CubbyFlow
@@ -0,0 +1,104 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/TaskGraph.hpp>
+
+#include <algorithm>
+
+namespace CubbyFlow
+{
+namespace
+{
+bool Overlaps(const std::vector<const void*>& a,
+              const std::vector<const void*>& b)
+{
+    for (const void* resource : a)
+    {
+        if (std::find(b.begin(), b.end(), resource) != b.end())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+}  // namespace
+
+TaskGraph::TaskID TaskGraph::AddTask(std::function<void()> work,
+                                     std::vector<const void*> reads,
+                                     std::vector<const void*> writes)
+{
+    m_tasks.push_back(
+        Task{ std::move(work), std::move(reads), std::move(writes) });
+    return m_tasks.size() - 1;
+}
+
+size_t TaskGraph::GetNumberOfTasks() const
+{
+    return m_tasks.size();
+}
+
+void TaskGraph::Run(ExecutionPolicy policy) const
+{
+    const size_t numTasks = m_tasks.size();
+
+    // A task depends on every earlier task whose writes overlap its reads or
+    // writes (read-after-write, write-after-write), or whose reads overlap
+    // its writes (write-after-read). The level of a task is one more than
+    // the deepest task it depends on.
+    std::vector<size_t> levels(numTasks, 0);
+    size_t numLevels = 0;
+
+    for (size_t t = 0; t < numTasks; ++t)
+    {
+        const Task& task = m_tasks[t];
+        size_t level = 0;
+
+        for (size_t s = 0; s < t; ++s)
+        {
+            const Task& earlier = m_tasks[s];
+
+            if (Overlaps(earlier.writes, task.reads) ||
+                Overlaps(earlier.writes, task.writes) ||
+                Overlaps(earlier.reads, task.writes))
+            {
+                level = std::max(level, levels[s] + 1);
+            }
+        }
+
+        levels[t] = level;
+        numLevels = std::max(numLevels, level + 1);
+    }
+
+    // Execute level by level; tasks within a level are independent.
+    std::vector<size_t> wave;
+    for (size_t level = 0; level < numLevels; ++level)
+    {
+        wave.clear();
+        for (size_t t = 0; t < numTasks; ++t)
+        {
+            if (levels[t] == level)
+            {
+                wave.push_back(t);
+            }
+        }
+
+        ParallelFor(
+            ZERO_SIZE, wave.size(),
+            [&](size_t i) { m_tasks[wave[i]].work(); }, policy);
+    }
+}
+
+void TaskGraph::Clear()
+{
+    m_tasks.clear();
+}
+}  // namespace CubbyFlow
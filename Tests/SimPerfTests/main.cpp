@@ -0,0 +1,454 @@
+// This code is based on Jet framework.
+// Copyright (c) 2018 Doyub Kim
+// CubbyFlow is voxel-based fluid simulation engine for computer games.
+// Copyright (c) 2020 CubbyFlow Team
+// Core Part: Chris Ohk, Junwoo Hwang, Jihong Sin, Seungwoo Yoo
+// AI Part: Dongheon Cho, Minseo Kim
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+//
+// End-to-end simulation benchmark suite.
+//
+// Runs one standardized, deterministic scene per solver family (grid smoke,
+// SPH, and hybrid FLIP liquid) for a fixed number of frames at the requested
+// resolutions, records the per-frame wall time, and optionally dumps the
+// per-stage profiler zones as a chrome-trace file per scene.
+//
+// Results are written as JSON and, unless --update-baseline is given,
+// compared against a checked-in baseline with a tolerance gate so solver
+// performance regressions fail the run. Baselines are host-specific:
+// regenerate with --update-baseline on the reference machine whenever the
+// hardware or the expected performance changes.
+//
+
+#include <Core/Animation/Frame.hpp>
+#include <Core/Emitter/ParticleEmitterSet3.hpp>
+#include <Core/Emitter/VolumeGridEmitter3.hpp>
+#include <Core/Emitter/VolumeParticleEmitter3.hpp>
+#include <Core/Geometry/Box3.hpp>
+#include <Core/Geometry/Plane3.hpp>
+#include <Core/Geometry/RigidBodyCollider3.hpp>
+#include <Core/Geometry/Sphere3.hpp>
+#include <Core/PointGenerator/GridPointGenerator3.hpp>
+#include <Core/Solver/Grid/GridSmokeSolver3.hpp>
+#include <Core/Solver/Hybrid/FLIP/FLIPSolver3.hpp>
+#include <Core/Solver/Particle/SPH/SPHSolver3.hpp>
+#include <Core/Utils/Logging.hpp>
+#include <Core/Utils/Profiler.hpp>
+#include <Core/Utils/Timer.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace CubbyFlow;
+
+namespace
+{
+struct SceneResult
+{
+    std::string name;
+    size_t scale = 0;
+    int frames = 0;
+    double totalSeconds = 0.0;
+    double avgFrameSeconds = 0.0;
+};
+
+//! Runs \p solver for \p numberOfFrames frames and returns the average
+//! frame time, excluding the first frame which pays the one-time
+//! initialization cost.
+template <typename SolverPtr>
+SceneResult RunScene(const std::string& name, size_t scale,
+                     const SolverPtr& solver, int numberOfFrames,
+                     bool dumpTrace)
+{
+    SceneResult result;
+    result.name = name;
+    result.scale = scale;
+    result.frames = numberOfFrames;
+
+    if (dumpTrace)
+    {
+        Profiler::SetEnabled(true);
+        Profiler::Clear();
+    }
+
+    double measuredSeconds = 0.0;
+    int measuredFrames = 0;
+
+    for (Frame frame{ 0, 1.0 / 60.0 }; frame.index < numberOfFrames; ++frame)
+    {
+        const Timer timer;
+        solver->Update(frame);
+        const double seconds = timer.DurationInSeconds();
+
+        result.totalSeconds += seconds;
+        if (frame.index > 0)
+        {
+            measuredSeconds += seconds;
+            ++measuredFrames;
+        }
+    }
+
+    result.avgFrameSeconds =
+        (measuredFrames > 0) ? measuredSeconds / measuredFrames
+                             : result.totalSeconds;
+
+    if (dumpTrace)
+    {
+        std::ofstream traceFile{ name + "_trace.json" };
+        if (traceFile)
+        {
+            Profiler::DumpChromeTrace(&traceFile);
+        }
+        Profiler::Clear();
+        Profiler::SetEnabled(false);
+    }
+
+    std::printf("%-24s scale=%-4zu frames=%-3d total=%8.3fs avg=%8.4fs\n",
+                name.c_str(), scale, numberOfFrames, result.totalSeconds,
+                result.avgFrameSeconds);
+
+    return result;
+}
+
+//! Rising smoke plume past a sphere collider (grid solver family).
+SceneResult RunSmokeScene(size_t scale, int numberOfFrames, bool dumpTrace)
+{
+    auto solver = GridSmokeSolver3::Builder()
+                      .WithResolution({ scale, 2 * scale, scale })
+                      .WithDomainSizeX(1.0)
+                      .MakeShared();
+
+    const BoundingBox3D domain = solver->GetGridSystemData()->GetBoundingBox();
+
+    const auto box = Box3::Builder()
+                         .WithLowerCorner({ 0.45, -1, 0.45 })
+                         .WithUpperCorner({ 0.55, 0.05, 0.55 })
+                         .MakeShared();
+
+    auto emitter = VolumeGridEmitter3::Builder()
+                       .WithSourceRegion(box)
+                       .WithIsOneShot(false)
+                       .MakeShared();
+
+    solver->SetEmitter(emitter);
+    emitter->AddStepFunctionTarget(solver->GetSmokeDensity(), 0, 1);
+    emitter->AddStepFunctionTarget(solver->GetTemperature(), 0, 1);
+
+    const auto sphere = Sphere3::Builder()
+                            .WithCenter({ 0.5, 0.3, 0.5 })
+                            .WithRadius(0.075 * domain.GetWidth())
+                            .MakeShared();
+    solver->SetCollider(
+        RigidBodyCollider3::Builder().WithSurface(sphere).MakeShared());
+
+    return RunScene("SmokeSim", scale, solver, numberOfFrames, dumpTrace);
+}
+
+//! Dam-break block over a floor plane (SPH solver family). The block is
+//! seeded on a regular lattice, so the scene is fully deterministic.
+SceneResult RunSPHScene(size_t scale, int numberOfFrames, bool dumpTrace)
+{
+    const double targetSpacing = 1.0 / static_cast<double>(scale);
+
+    auto solver = SPHSolver3::Builder()
+                      .WithTargetDensity(1000.0)
+                      .WithTargetSpacing(targetSpacing)
+                      .MakeShared();
+
+    Array1<Vector3D> points;
+    for (double x = 0.5 * targetSpacing; x < 0.25; x += targetSpacing)
+    {
+        for (double y = 0.5 * targetSpacing; y < 0.5; y += targetSpacing)
+        {
+            for (double z = 0.5 * targetSpacing; z < 0.5; z += targetSpacing)
+            {
+                points.Append(Vector3D{ x, y, z });
+            }
+        }
+    }
+    solver->GetSPHSystemData()->AddParticles(points.ConstAccessor());
+
+    const auto plane = Plane3::Builder()
+                           .WithNormal({ 0, 1, 0 })
+                           .WithPoint({ 0, 0, 0 })
+                           .MakeShared();
+    solver->SetCollider(
+        RigidBodyCollider3::Builder().WithSurface(plane).MakeShared());
+
+    return RunScene("SPHSim", scale, solver, numberOfFrames, dumpTrace);
+}
+
+//! Water drop into a pool (hybrid FLIP solver family). Particles come from
+//! a grid point generator, so seeding is deterministic.
+SceneResult RunHybridLiquidScene(size_t scale, int numberOfFrames,
+                                 bool dumpTrace)
+{
+    auto solver = FLIPSolver3::Builder()
+                      .WithResolution({ scale, 2 * scale, scale })
+                      .WithDomainSizeX(1.0)
+                      .MakeShared();
+
+    const BoundingBox3D domain = solver->GetGridSystemData()->GetBoundingBox();
+    const double dx = solver->GetGridSystemData()->GetGridSpacing().x;
+
+    const auto plane = Plane3::Builder()
+                           .WithNormal({ 0, 1, 0 })
+                           .WithPoint({ 0, 0.25 * domain.GetHeight(), 0 })
+                           .MakeShared();
+
+    const auto sphere = Sphere3::Builder()
+                            .WithCenter(domain.MidPoint())
+                            .WithRadius(0.15 * domain.GetWidth())
+                            .MakeShared();
+
+    auto emitter1 = VolumeParticleEmitter3::Builder()
+                        .WithSurface(plane)
+                        .WithSpacing(0.5 * dx)
+                        .WithMaxRegion(domain)
+                        .WithIsOneShot(true)
+                        .MakeShared();
+    emitter1->SetPointGenerator(std::make_shared<GridPointGenerator3>());
+
+    auto emitter2 = VolumeParticleEmitter3::Builder()
+                        .WithSurface(sphere)
+                        .WithSpacing(0.5 * dx)
+                        .WithMaxRegion(domain)
+                        .WithIsOneShot(true)
+                        .MakeShared();
+    emitter2->SetPointGenerator(std::make_shared<GridPointGenerator3>());
+
+    const auto emitterSet = ParticleEmitterSet3::Builder()
+                                .WithEmitters({ emitter1, emitter2 })
+                                .MakeShared();
+    solver->SetParticleEmitter(emitterSet);
+
+    return RunScene("HybridLiquidSim", scale, solver, numberOfFrames,
+                    dumpTrace);
+}
+
+std::string MakeKey(const std::string& name, size_t scale)
+{
+    return name + "/" + std::to_string(scale);
+}
+
+void WriteResults(const std::string& path,
+                  const std::vector<SceneResult>& results)
+{
+    std::ofstream file{ path };
+    if (!file)
+    {
+        std::fprintf(stderr, "Cannot write %s\n", path.c_str());
+        return;
+    }
+
+    file << "{\n  \"scenes\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const SceneResult& r = results[i];
+        file << "    { \"name\": \"" << MakeKey(r.name, r.scale)
+             << "\", \"frames\": " << r.frames
+             << ", \"totalSeconds\": " << r.totalSeconds
+             << ", \"avgFrameSeconds\": " << r.avgFrameSeconds << " }"
+             << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    file << "  ]\n}\n";
+}
+
+//! Reads scene name to average frame seconds pairs from a results or
+//! baseline file. Only understands the format written by WriteResults.
+std::map<std::string, double> ReadBaseline(const std::string& path)
+{
+    std::map<std::string, double> baseline;
+
+    std::ifstream file{ path };
+    if (!file)
+    {
+        return baseline;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    size_t pos = 0;
+    while ((pos = text.find("\"name\":", pos)) != std::string::npos)
+    {
+        const size_t nameBegin = text.find('"', pos + 7);
+        const size_t nameEnd = text.find('"', nameBegin + 1);
+        const size_t valuePos = text.find("\"avgFrameSeconds\":", nameEnd);
+        if (nameBegin == std::string::npos || nameEnd == std::string::npos ||
+            valuePos == std::string::npos)
+        {
+            break;
+        }
+
+        const std::string name =
+            text.substr(nameBegin + 1, nameEnd - nameBegin - 1);
+        baseline[name] = std::strtod(text.c_str() + valuePos + 18, nullptr);
+
+        pos = valuePos;
+    }
+
+    return baseline;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    int numberOfFrames = 8;
+    std::vector<size_t> scales{ 64 };
+    std::string baselinePath = std::string{ SIM_PERF_TESTS_DIR } +
+                               "/baseline.json";
+    std::string outputPath = "sim_perf_results.json";
+    std::string sceneFilter;
+    double tolerance = 1.5;
+    bool updateBaseline = false;
+    bool dumpTrace = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const auto next = [&]() -> const char* {
+            return (i + 1 < argc) ? argv[++i] : "";
+        };
+
+        if (arg == "--frames")
+        {
+            numberOfFrames = std::atoi(next());
+        }
+        else if (arg == "--scales")
+        {
+            scales.clear();
+            std::stringstream list{ next() };
+            std::string item;
+            while (std::getline(list, item, ','))
+            {
+                scales.push_back(
+                    static_cast<size_t>(std::strtoul(item.c_str(), nullptr,
+                                                     10)));
+            }
+        }
+        else if (arg == "--baseline")
+        {
+            baselinePath = next();
+        }
+        else if (arg == "--output")
+        {
+            outputPath = next();
+        }
+        else if (arg == "--scene")
+        {
+            sceneFilter = next();
+        }
+        else if (arg == "--tolerance")
+        {
+            tolerance = std::atof(next());
+        }
+        else if (arg == "--update-baseline")
+        {
+            updateBaseline = true;
+        }
+        else if (arg == "--trace")
+        {
+            dumpTrace = true;
+        }
+        else
+        {
+            std::printf(
+                "Usage: SimPerfTests [--frames n] [--scales 64,128,...]\n"
+                "                    [--scene filter] [--baseline file]\n"
+                "                    [--output file] [--tolerance factor]\n"
+                "                    [--update-baseline] [--trace]\n");
+            return (arg == "--help") ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    std::ofstream logFile{ "sim_perf_tests.log" };
+    if (logFile)
+    {
+        Logging::SetAllStream(&logFile);
+    }
+
+    using SceneFunc = std::function<SceneResult(size_t, int, bool)>;
+    const std::vector<std::pair<std::string, SceneFunc>> scenes{
+        { "SmokeSim", RunSmokeScene },
+        { "SPHSim", RunSPHScene },
+        { "HybridLiquidSim", RunHybridLiquidScene }
+    };
+
+    std::vector<SceneResult> results;
+    for (const size_t scale : scales)
+    {
+        for (const auto& scene : scenes)
+        {
+            if (!sceneFilter.empty() &&
+                scene.first.find(sceneFilter) == std::string::npos)
+            {
+                continue;
+            }
+
+            results.push_back(scene.second(scale, numberOfFrames, dumpTrace));
+        }
+    }
+
+    WriteResults(outputPath, results);
+
+    if (updateBaseline)
+    {
+        WriteResults(baselinePath, results);
+        std::printf("Baseline updated: %s\n", baselinePath.c_str());
+        return EXIT_SUCCESS;
+    }
+
+    const std::map<std::string, double> baseline = ReadBaseline(baselinePath);
+    if (baseline.empty())
+    {
+        std::printf(
+            "No baseline at %s; skipping the regression gate. Run with "
+            "--update-baseline to record one.\n",
+            baselinePath.c_str());
+        return EXIT_SUCCESS;
+    }
+
+    int regressions = 0;
+    for (const SceneResult& r : results)
+    {
+        const auto found = baseline.find(MakeKey(r.name, r.scale));
+        if (found == baseline.end())
+        {
+            std::printf("%-24s scale=%-4zu not in baseline; skipped\n",
+                        r.name.c_str(), r.scale);
+            continue;
+        }
+
+        const double limit = tolerance * found->second;
+        if (r.avgFrameSeconds > limit)
+        {
+            std::printf(
+                "REGRESSION %-13s scale=%-4zu avg=%8.4fs exceeds %8.4fs "
+                "(baseline %8.4fs x %.2f)\n",
+                r.name.c_str(), r.scale, r.avgFrameSeconds, limit,
+                found->second, tolerance);
+            ++regressions;
+        }
+    }
+
+    if (regressions > 0)
+    {
+        std::printf("%d scene(s) regressed\n", regressions);
+        return EXIT_FAILURE;
+    }
+
+    std::printf("All scenes within tolerance\n");
+    return EXIT_SUCCESS;
+}
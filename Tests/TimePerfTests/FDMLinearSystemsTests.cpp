@@ -186,10 +186,79 @@ BENCHMARK_DEFINE_F(FDMBLAS3, MVM)(benchmark::State& state)
     {
         CubbyFlow::FDMBLAS3::MVM(m, a, &b);
     }
+
+    const auto n =
+        static_cast<int64_t>(m.size().x * m.size().y * m.size().z);
+
+    state.SetItemsProcessed(state.iterations() * n);
+
+    // One matrix row, one vector read, and one store per cell; the six
+    // stencil neighbor reads mostly hit cache and are not counted.
+    state.SetBytesProcessed(
+        state.iterations() * n *
+        static_cast<int64_t>(sizeof(CubbyFlow::FDMMatrixRow3) +
+                             2 * sizeof(double)));
 }
 
 BENCHMARK_REGISTER_F(FDMBLAS3, MVM)->Arg(1 << 4)->Arg(1 << 6)->Arg(1 << 8);
 
+BENCHMARK_DEFINE_F(FDMBLAS3, Dot)(benchmark::State& state)
+{
+    double sum = 0.0;
+
+    while (state.KeepRunning())
+    {
+        sum += CubbyFlow::FDMBLAS3::Dot(a, a);
+    }
+
+    benchmark::DoNotOptimize(sum);
+
+    const auto n =
+        static_cast<int64_t>(a.size().x * a.size().y * a.size().z);
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * 2 *
+                            static_cast<int64_t>(sizeof(double)));
+}
+
+BENCHMARK_REGISTER_F(FDMBLAS3, Dot)->Arg(1 << 4)->Arg(1 << 6)->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FDMBLAS3, AXPlusY)(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        CubbyFlow::FDMBLAS3::AXPlusY(0.5, a, a, &b);
+    }
+
+    const auto n =
+        static_cast<int64_t>(a.size().x * a.size().y * a.size().z);
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * 3 *
+                            static_cast<int64_t>(sizeof(double)));
+}
+
+BENCHMARK_REGISTER_F(FDMBLAS3, AXPlusY)->Arg(1 << 4)->Arg(1 << 6)->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FDMBLAS3, Residual)(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        CubbyFlow::FDMBLAS3::Residual(m, a, a, &b);
+    }
+
+    const auto n =
+        static_cast<int64_t>(m.size().x * m.size().y * m.size().z);
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(
+        state.iterations() * n *
+        static_cast<int64_t>(sizeof(CubbyFlow::FDMMatrixRow3) +
+                             3 * sizeof(double)));
+}
+
+BENCHMARK_REGISTER_F(FDMBLAS3, Residual)->Arg(1 << 4)->Arg(1 << 6)->Arg(1 << 8);
+
 BENCHMARK_DEFINE_F(FDMCompressedBLAS3, MVM)(benchmark::State& state)
 {
     while (state.KeepRunning())
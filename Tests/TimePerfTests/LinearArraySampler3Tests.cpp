@@ -0,0 +1,97 @@
+#include "benchmark/benchmark.h"
+
+#include <Core/Array/Array1.hpp>
+#include <Core/Array/Array3.hpp>
+#include <Core/Array/ArraySamplers3.hpp>
+#include <Core/Vector/Vector3.hpp>
+
+#include <random>
+
+using CubbyFlow::Array1;
+using CubbyFlow::Array3;
+using CubbyFlow::Vector3D;
+
+class LinearArraySampler3 : public ::benchmark::Fixture
+{
+ protected:
+    Array3<double> data;
+    Array1<Vector3D> points;
+    Array1<double> results;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        const auto dim = static_cast<size_t>(state.range(0));
+        const auto numSamples = static_cast<size_t>(state.range(1));
+
+        data.Resize(dim, dim, dim);
+
+        std::mt19937 rng{ 0 };
+        std::uniform_real_distribution<> d(0.0, 1.0);
+
+        data.ForEachIndex(
+            [&](size_t i, size_t j, size_t k) { data(i, j, k) = d(rng); });
+
+        std::uniform_real_distribution<> p(0.0,
+                                           static_cast<double>(dim - 1));
+
+        points.Resize(numSamples);
+        results.Resize(numSamples);
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            points[i] = Vector3D(p(rng), p(rng), p(rng));
+        }
+    }
+
+    void SetCounters(benchmark::State& state) const
+    {
+        const auto numSamples = static_cast<int64_t>(points.size());
+
+        state.SetItemsProcessed(state.iterations() * numSamples);
+
+        // Eight cell-corner fetches and one store per sample
+        state.SetBytesProcessed(state.iterations() * numSamples * 9 *
+                                static_cast<int64_t>(sizeof(double)));
+    }
+};
+
+BENCHMARK_DEFINE_F(LinearArraySampler3, Functor)(benchmark::State& state)
+{
+    const CubbyFlow::LinearArraySampler3<double, double> sampler(
+        data.ConstAccessor(), Vector3D(1, 1, 1), Vector3D());
+
+    while (state.KeepRunning())
+    {
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            results[i] = sampler(points[i]);
+        }
+
+        benchmark::DoNotOptimize(results[0]);
+    }
+
+    SetCounters(state);
+}
+
+BENCHMARK_REGISTER_F(LinearArraySampler3, Functor)
+    ->Args({ 1 << 5, 1 << 16 })
+    ->Args({ 1 << 7, 1 << 16 });
+
+BENCHMARK_DEFINE_F(LinearArraySampler3, Sample)(benchmark::State& state)
+{
+    const CubbyFlow::LinearArraySampler3<double, double> sampler(
+        data.ConstAccessor(), Vector3D(1, 1, 1), Vector3D());
+
+    while (state.KeepRunning())
+    {
+        sampler.Sample(points.ConstAccessor(), results.Accessor());
+
+        benchmark::DoNotOptimize(results[0]);
+    }
+
+    SetCounters(state);
+}
+
+BENCHMARK_REGISTER_F(LinearArraySampler3, Sample)
+    ->Args({ 1 << 5, 1 << 16 })
+    ->Args({ 1 << 7, 1 << 16 });
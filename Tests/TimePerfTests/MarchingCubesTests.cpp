@@ -0,0 +1,59 @@
+#include "benchmark/benchmark.h"
+
+#include <Core/Array/Array3.hpp>
+#include <Core/Geometry/MarchingCubes.hpp>
+#include <Core/Geometry/TriangleMesh3.hpp>
+#include <Core/Vector/Vector3.hpp>
+
+using CubbyFlow::Vector3D;
+
+class MarchingCubes : public ::benchmark::Fixture
+{
+ protected:
+    CubbyFlow::Array3<double> grid;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        const auto dim = static_cast<size_t>(state.range(0));
+
+        grid.Resize(dim, dim, dim);
+
+        // Sphere SDF centered in the grid
+        const Vector3D center = 0.5 * static_cast<double>(dim - 1) *
+                                Vector3D(1, 1, 1);
+        const double radius = 0.25 * static_cast<double>(dim);
+
+        grid.ForEachIndex([&](size_t i, size_t j, size_t k) {
+            const Vector3D pt(static_cast<double>(i), static_cast<double>(j),
+                              static_cast<double>(k));
+            grid(i, j, k) = pt.DistanceTo(center) - radius;
+        });
+    }
+};
+
+BENCHMARK_DEFINE_F(MarchingCubes, Call)(benchmark::State& state)
+{
+    size_t numTriangles = 0;
+
+    while (state.KeepRunning())
+    {
+        CubbyFlow::TriangleMesh3 mesh;
+        CubbyFlow::MarchingCubes(grid.ConstAccessor(), Vector3D(1, 1, 1),
+                                 Vector3D(), &mesh, 0.0);
+        numTriangles += mesh.NumberOfTriangles();
+    }
+
+    benchmark::DoNotOptimize(numTriangles);
+
+    const auto numCells = static_cast<int64_t>(
+        (grid.size().x - 1) * (grid.size().y - 1) * (grid.size().z - 1));
+
+    state.SetItemsProcessed(state.iterations() * numCells);
+    state.SetBytesProcessed(state.iterations() * numCells * 8 *
+                            static_cast<int64_t>(sizeof(double)));
+}
+
+BENCHMARK_REGISTER_F(MarchingCubes, Call)
+    ->Arg(1 << 5)
+    ->Arg(1 << 6)
+    ->Arg(1 << 7);
@@ -1,5 +1,7 @@
 #include "pch.hpp"
 
+#include <Core/Emitter/VolumeParticleEmitter3.hpp>
+#include <Core/Geometry/Sphere3.hpp>
 #include <Core/Solver/Hybrid/APIC/APICSolver3.hpp>
 
 using namespace CubbyFlow;
@@ -12,4 +14,51 @@ TEST(APICSolver3, UpdateEmpty)
     {
         solver.Update(frame);
     }
+}
+
+TEST(APICSolver3, FusedTransferAndAdvect)
+{
+    auto solver = APICSolver3::GetBuilder()
+                      .WithResolution({ 16, 16, 16 })
+                      .WithGridSpacing({ 1.0 / 16, 1.0 / 16, 1.0 / 16 })
+                      .MakeShared();
+
+    const auto sphere = Sphere3::GetBuilder()
+                            .WithCenter({ 0.5, 0.7, 0.5 })
+                            .WithRadius(0.2)
+                            .MakeShared();
+    solver->SetParticleEmitter(VolumeParticleEmitter3::GetBuilder()
+                                   .WithSurface(sphere)
+                                   .WithSpacing(1.0 / 32.0)
+                                   .MakeShared());
+
+    Frame frame{ 0, 0.01 };
+    for (; frame.index < 3; ++frame)
+    {
+        solver->Update(frame);
+    }
+
+    // The fused grid-to-particle/advection pass must keep every particle
+    // inside the closed domain while gravity pulls the droplet down.
+    const auto particles = solver->GetParticleSystemData();
+    const size_t n = particles->GetNumberOfParticles();
+    ASSERT_GT(n, 0u);
+
+    auto positions = particles->GetPositions();
+    auto velocities = particles->GetVelocities();
+    double meanY = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        EXPECT_TRUE(std::isfinite(velocities[i].Length()));
+        EXPECT_GE(positions[i].x, 0.0);
+        EXPECT_LE(positions[i].x, 1.0);
+        EXPECT_GE(positions[i].y, 0.0);
+        EXPECT_LE(positions[i].y, 1.0);
+        EXPECT_GE(positions[i].z, 0.0);
+        EXPECT_LE(positions[i].z, 1.0);
+        meanY += positions[i].y;
+    }
+    meanY /= static_cast<double>(n);
+
+    EXPECT_LT(meanY, 0.7);
 }
\ No newline at end of file
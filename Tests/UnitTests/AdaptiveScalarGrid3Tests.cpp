@@ -0,0 +1,129 @@
+#include "pch.hpp"
+
+#include <Core/Field/CustomScalarField3.hpp>
+#include <Core/Field/CustomVectorField3.hpp>
+#include <Core/Grid/AdaptiveScalarGrid3.hpp>
+#include <Core/Grid/AdaptiveVectorGrid3.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace CubbyFlow;
+
+namespace
+{
+double Blob(const Vector3D& x)
+{
+    const Vector3D d = x - Vector3D{ 0.3, 0.3, 0.3 };
+    return std::exp(-60.0 * d.LengthSquared());
+}
+}  // namespace
+
+TEST(AdaptiveScalarGrid3, RefinesTowardDetail)
+{
+    const CustomScalarField3 src(Blob);
+    const BoundingBox3D domain(Vector3D{ 0, 0, 0 }, Vector3D{ 1, 1, 1 });
+
+    const AdaptiveScalarGrid3 grid(src, domain, 5, 1e-3);
+
+    // Far fewer cells than the equivalent 32^3 uniform grid
+    const size_t uniform = 32 * 32 * 32;
+    EXPECT_LT(grid.GetTree().GetNumberOfLeaves(), uniform / 2);
+
+    // Accurate where the tree is refined
+    double maxErr = 0.0;
+    for (double z = 0.15; z <= 0.45; z += 0.02)
+    {
+        for (double y = 0.15; y <= 0.45; y += 0.02)
+        {
+            for (double x = 0.15; x <= 0.45; x += 0.02)
+            {
+                const Vector3D p{ x, y, z };
+                maxErr = std::max(maxErr,
+                                  std::fabs(grid.Sample(p) - Blob(p)));
+            }
+        }
+    }
+    EXPECT_LT(maxErr, 0.05);
+
+    // Gradient points downhill away from the blob center
+    EXPECT_LT(grid.Gradient(Vector3D{ 0.4, 0.3, 0.3 }).x, 0.0);
+}
+
+TEST(AdaptiveScalarGrid3, TwoToOneBalance)
+{
+    const CustomScalarField3 src(Blob);
+    const BoundingBox3D domain(Vector3D{ 0, 0, 0 }, Vector3D{ 1, 1, 1 });
+
+    const AdaptiveScalarGrid3 grid(src, domain, 5, 1e-3);
+
+    struct Leaf
+    {
+        BoundingBox3D bound;
+        size_t depth;
+    };
+    std::vector<Leaf> leaves;
+    grid.GetTree().ForEachLeaf(
+        [&](const BoundingBox3D& bound, size_t depth, const double&) {
+            leaves.push_back({ bound, depth });
+        });
+
+    // Face-adjacent leaves never differ by more than one level
+    for (const Leaf& leaf : leaves)
+    {
+        const Vector3D center = leaf.bound.MidPoint();
+        const Vector3D size = leaf.bound.upperCorner - leaf.bound.lowerCorner;
+
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            for (int dir = -1; dir <= 1; dir += 2)
+            {
+                Vector3D probe = center;
+                probe[axis] += dir * size[axis];
+                if (!domain.Contains(probe))
+                {
+                    continue;
+                }
+
+                for (const Leaf& other : leaves)
+                {
+                    if (other.bound.Contains(probe))
+                    {
+                        const auto diff =
+                            static_cast<int>(other.depth) -
+                            static_cast<int>(leaf.depth);
+                        EXPECT_LE(std::abs(diff), 1);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(AdaptiveVectorGrid3, SamplesSource)
+{
+    const CustomVectorField3 src([](const Vector3D& x) {
+        return Vector3D{ Blob(x), 0.5 * Blob(x), -Blob(x) };
+    });
+    const BoundingBox3D domain(Vector3D{ 0, 0, 0 }, Vector3D{ 1, 1, 1 });
+
+    const AdaptiveVectorGrid3 grid(src, domain, 5, 1e-3);
+
+    const Vector3D p{ 0.3, 0.32, 0.28 };
+    EXPECT_LT((grid.Sample(p) - src.Sample(p)).Length(), 0.05);
+}
+
+TEST(AdaptiveScalarGrid3, Builder)
+{
+    const BoundingBox3D domain(Vector3D{ 0, 0, 0 }, Vector3D{ 1, 1, 1 });
+    const auto grid =
+        AdaptiveScalarGrid3::GetBuilder()
+            .WithSourceField(std::make_shared<CustomScalarField3>(Blob))
+            .WithBoundingBox(domain)
+            .WithMaxDepth(5)
+            .WithRefinementThreshold(1e-3)
+            .MakeShared();
+
+    EXPECT_NEAR(1.0, grid->Sample(Vector3D{ 0.3, 0.3, 0.3 }), 0.05);
+}
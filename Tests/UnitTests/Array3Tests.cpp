@@ -1,6 +1,8 @@
 #include "pch.hpp"
 
 #include <Core/Array/Array3.hpp>
+#include <Core/Array/ArrayExpression3.hpp>
+#include <Core/Array/HugePageAllocator.hpp>
 #include <Core/Utils/Serialization.hpp>
 
 using namespace CubbyFlow;
@@ -248,4 +250,120 @@ TEST(Array3, ParallelForEachIndex)
         size_t idx = i + (4 * (j + 3 * k)) + 1;
         EXPECT_FLOAT_EQ(static_cast<float>(idx), arr1(i, j, k));
     });
-}
\ No newline at end of file
+}
+TEST(Array3, TiledForEachIndex)
+{
+    Array3<double> arr1(17, 9, 11);
+    arr1.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        arr1(i, j, k) = static_cast<double>(i + (4 * (j + 3 * k)));
+    });
+
+    // Tiled and Morton traversals visit the exact same index set
+    Array3<double> arr2(17, 9, 11, -1.0);
+    arr1.TiledForEachIndex(
+        [&](size_t i, size_t j, size_t k) { arr2(i, j, k) = arr1(i, j, k); },
+        4);
+
+    Array3<double> arr3(17, 9, 11, -1.0);
+    arr1.MortonForEachIndex(
+        [&](size_t i, size_t j, size_t k) { arr3(i, j, k) = arr1(i, j, k); });
+
+    Array3<double> arr4(17, 9, 11, -1.0);
+    arr1.ParallelTiledForEachIndex(
+        [&](size_t i, size_t j, size_t k) { arr4(i, j, k) = arr1(i, j, k); });
+
+    arr1.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(arr1(i, j, k), arr2(i, j, k));
+        EXPECT_DOUBLE_EQ(arr1(i, j, k), arr3(i, j, k));
+        EXPECT_DOUBLE_EQ(arr1(i, j, k), arr4(i, j, k));
+    });
+}
+
+TEST(Array3, CustomAllocator)
+{
+    // The allocator parameter defaults to the cache-aligned allocator, so
+    // both spellings name the same type
+    static_assert(
+        std::is_same_v<Array3<double>,
+                       Array3<double, CacheAlignedAllocator<double>>>);
+
+    Array3<double, HugePageAllocator<double>> arr(4, 5, 6, 7.0);
+    EXPECT_EQ(4u, arr.Width());
+    EXPECT_EQ(5u, arr.Height());
+    EXPECT_EQ(6u, arr.Depth());
+    arr.ForEach([](double value) { EXPECT_DOUBLE_EQ(7.0, value); });
+
+    // Large enough to take the huge-page mapping path on Linux
+    Array3<double, HugePageAllocator<double>> big(128, 64, 64, 1.0);
+    big(127, 63, 63) = 2.0;
+    EXPECT_DOUBLE_EQ(2.0, big(127, 63, 63));
+    EXPECT_DOUBLE_EQ(1.0, big(0, 0, 0));
+
+    // Accessors are allocator-agnostic
+    ConstArrayAccessor3<double> acc = big.ConstAccessor();
+    EXPECT_DOUBLE_EQ(1.0, acc(1, 2, 3));
+}
+
+TEST(Array3, Expression)
+{
+    Array3<double> a({ 5, 4, 3 }, 2.0);
+    Array3<double> b({ 5, 4, 3 }, 3.0);
+    Array3<double> v({ 5, 4, 3 }, 1.0);
+
+    // v = v + dt * a fuses into a single pass.
+    ParallelEvaluate(ArrayInput3<double>(v.ConstAccessor()) +
+                         0.5 * ArrayInput3<double>(a.ConstAccessor()),
+                     v.Accessor());
+    v.ForEach([](double val) { EXPECT_DOUBLE_EQ(2.0, val); });
+
+    Array3<double> out(Size3(5, 4, 3));
+    ParallelEvaluate((ArrayInput3<double>(a.ConstAccessor()) *
+                          ArrayInput3<double>(b.ConstAccessor()) -
+                      1.0) /
+                             ArrayConstant3<double>({ 5, 4, 3 }, 2.0) +
+                         4.0,
+                     out.Accessor());
+    out.ForEach([](double val) { EXPECT_DOUBLE_EQ(6.5, val); });
+}
+
+TEST(Array3, CopyOnWrite)
+{
+    Array3<double> arr(Size3(9, 5, 7), 1.0);
+    arr(3, 2, 4) = 2.0;
+
+    // A copy shares the buffer until one side is written to.
+    Array3<double> copy = arr;
+    EXPECT_EQ(arr.ConstAccessor().data(), copy.ConstAccessor().data());
+    EXPECT_DOUBLE_EQ(2.0, copy(3, 2, 4));
+
+    // Writing to the copy detaches it and leaves the original alone.
+    copy(3, 2, 4) = 5.0;
+    EXPECT_NE(arr.ConstAccessor().data(), copy.ConstAccessor().data());
+    EXPECT_DOUBLE_EQ(2.0, arr(3, 2, 4));
+    EXPECT_DOUBLE_EQ(5.0, copy(3, 2, 4));
+
+    // Writing to the original after a copy preserves the copy.
+    Array3<double> snapshot = arr;
+    arr.Accessor()(0, 0, 0) = 9.0;
+    EXPECT_DOUBLE_EQ(1.0, snapshot(0, 0, 0));
+    EXPECT_DOUBLE_EQ(9.0, arr(0, 0, 0));
+
+    // Assignment shares again.
+    snapshot = copy;
+    EXPECT_EQ(copy.ConstAccessor().data(), snapshot.ConstAccessor().data());
+    EXPECT_DOUBLE_EQ(5.0, snapshot(3, 2, 4));
+}
+
+TEST(Array3, CacheAlignedStorage)
+{
+    // The default allocator aligns the buffer base to a 64-byte cache line,
+    // including after a detach re-allocates the storage.
+    Array3<double> arr(Size3(9, 5, 7), 1.0);
+    EXPECT_EQ(0u,
+              reinterpret_cast<uintptr_t>(arr.ConstAccessor().data()) % 64);
+
+    Array3<double> copy = arr;
+    copy(0, 0, 0) = 2.0;
+    EXPECT_EQ(0u,
+              reinterpret_cast<uintptr_t>(copy.ConstAccessor().data()) % 64);
+}
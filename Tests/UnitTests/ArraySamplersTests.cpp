@@ -6,6 +6,9 @@
 #include <Core/Array/ArraySamplers1.hpp>
 #include <Core/Array/ArraySamplers2.hpp>
 #include <Core/Array/ArraySamplers3.hpp>
+#include <Core/Math/MathUtils.hpp>
+
+#include <cmath>
 
 using namespace CubbyFlow;
 
@@ -199,4 +202,78 @@ TEST(CubicArraySampler3, Sample)
     double s0 = sampler(Vector3D(1.5, 1.8, 1.2));
     EXPECT_LT(3.0, s0);
     EXPECT_GT(6.0, s0);
-}
\ No newline at end of file
+}
+TEST(FastCubicArraySampler3, Sample)
+{
+    Array3<double> grid(8, 8, 8);
+    for (size_t k = 0; k < 8; ++k)
+    {
+        for (size_t j = 0; j < 8; ++j)
+        {
+            for (size_t i = 0; i < 8; ++i)
+            {
+                grid(i, j, k) = static_cast<double>(i + j + k);
+            }
+        }
+    }
+
+    Vector3D gridSpacing(1.0, 1.0, 1.0), gridOrigin;
+    FastCubicArraySampler3<double, double> sampler(grid.ConstAccessor(),
+                                                   gridSpacing, gridOrigin);
+
+    // Catmull-Rom reproduces linear data exactly in the interior; near the
+    // boundary the clamped stencil only stays within the data range.
+    EXPECT_DOUBLE_EQ(4.5, sampler(Vector3D(1.5, 1.8, 1.2)));
+
+    const double s0 = sampler(Vector3D(0.2, 0.3, 0.5));
+    EXPECT_LT(0.0, s0);
+    EXPECT_GT(3.0, s0);
+
+    const double s1 = sampler(Vector3D(6.8, 6.8, 6.8));
+    EXPECT_LT(18.0, s1);
+    EXPECT_GT(21.0, s1);
+}
+
+TEST(FastCubicArraySampler3, MatchesTensorProductWeights)
+{
+    Array3<double> grid(6, 6, 6);
+    for (size_t k = 0; k < 6; ++k)
+    {
+        for (size_t j = 0; j < 6; ++j)
+        {
+            for (size_t i = 0; i < 6; ++i)
+            {
+                grid(i, j, k) =
+                    std::sin(0.9 * static_cast<double>(i)) +
+                    std::cos(0.7 * static_cast<double>(j)) *
+                        static_cast<double>(k);
+            }
+        }
+    }
+
+    Vector3D gridSpacing(1.0, 1.0, 1.0), gridOrigin;
+    FastCubicArraySampler3<double, double> sampler(grid.ConstAccessor(),
+                                                   gridSpacing, gridOrigin);
+
+    // Reference: nested one-dimensional (non-monotonic) Catmull-Rom.
+    const Vector3D pt(2.3, 2.7, 2.1);
+    double kValues[4];
+    for (int kk = 0; kk < 4; ++kk)
+    {
+        double jValues[4];
+        for (int jj = 0; jj < 4; ++jj)
+        {
+            jValues[jj] =
+                CatmullRom(grid(1, jj + 1, kk + 1), grid(2, jj + 1, kk + 1),
+                           grid(3, jj + 1, kk + 1), grid(4, jj + 1, kk + 1),
+                           0.3);
+        }
+
+        kValues[kk] =
+            CatmullRom(jValues[0], jValues[1], jValues[2], jValues[3], 0.7);
+    }
+    const double expected =
+        CatmullRom(kValues[0], kValues[1], kValues[2], kValues[3], 0.1);
+
+    EXPECT_NEAR(expected, sampler(pt), 1e-12);
+}
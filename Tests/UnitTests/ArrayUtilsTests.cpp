@@ -46,6 +46,39 @@ TEST(ArrayUtils, CopyRange1)
     }
 }
 
+TEST(ArrayUtils, BulkRange1)
+{
+    // Large enough to take the streamed bulk path, with unaligned bounds.
+    const size_t n = 300000;
+
+    Array1<double> array0(n, -1.0);
+    SetRange1(3, n - 5, 7.25, &array0);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double expected = (i >= 3 && i < n - 5) ? 7.25 : -1.0;
+        EXPECT_EQ(expected, array0[i]);
+    }
+
+    Array1<double> array1(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        array1[i] = static_cast<double>(i % 97);
+    }
+
+    Array1<double> array2(n, 0.0);
+    CopyRange1(array1, 1, n - 2, &array2);
+
+    EXPECT_EQ(0.0, array2[0]);
+    EXPECT_EQ(0.0, array2[n - 2]);
+    EXPECT_EQ(0.0, array2[n - 1]);
+
+    for (size_t i = 1; i < n - 2; ++i)
+    {
+        EXPECT_EQ(array1[i], array2[i]);
+    }
+}
+
 TEST(ArrayUtils, CopyRange2)
 {
     Array2<double> array0({ { 1.0, 2.0 }, { 3.0, 4.0 }, { 5.0, 6.0 } });
@@ -178,6 +211,36 @@ TEST(ArrayUtils, ExtrapolateToRegion3)
     }
 }
 
+TEST(ArrayUtils, ExtrapolateToRegionFrontier3)
+{
+    // The frontier variant must reproduce the iterative version exactly,
+    // including cells beyond the propagation distance that keep their
+    // input values.
+    Array3<double> data(16, 12, 14);
+    Array3<char> valid(16, 12, 14, 0);
+
+    data.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        data(i, j, k) = static_cast<double>((7 * i + 3 * j + 5 * k) % 11);
+        valid(i, j, k) = ((i * 5 + j * 3 + k) % 23 == 0) ? 1 : 0;
+    });
+
+    for (unsigned int depth : { 0u, 1u, 3u, 100u })
+    {
+        Array3<double> expected(16, 12, 14), actual(16, 12, 14);
+
+        ExtrapolateToRegion(data.ConstAccessor(), valid.ConstAccessor(),
+                            depth, expected.Accessor());
+        ExtrapolateToRegionFrontier(data.ConstAccessor(),
+                                    valid.ConstAccessor(), depth,
+                                    actual.Accessor());
+
+        expected.ForEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_DOUBLE_EQ(expected(i, j, k), actual(i, j, k))
+                << i << ", " << j << ", " << k << " at depth " << depth;
+        });
+    }
+}
+
 TEST(ArrayUtils, ConvertToCSV)
 {
     Array2<double> array = { { 1.0, 2.0, 3.0 }, { 4.0, 5.0, 6.0 } };
@@ -0,0 +1,77 @@
+#include "pch.hpp"
+
+#include <Core/Array/Array3.hpp>
+#include <Core/Array/ArrayView3.hpp>
+
+using namespace CubbyFlow;
+
+TEST(ArrayView3, DenseView)
+{
+    Array3<double> arr(10, 8, 6);
+    arr.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        arr(i, j, k) = static_cast<double>(i + 100 * j + 10000 * k);
+    });
+
+    ArrayView3<double> view(arr.Accessor(), Point3UI(2, 1, 3), Size3(4, 3, 2));
+
+    EXPECT_EQ(4u, view.Width());
+    EXPECT_EQ(3u, view.Height());
+    EXPECT_EQ(2u, view.Depth());
+
+    view.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(arr(i + 2, j + 1, k + 3), view(i, j, k));
+    });
+}
+
+TEST(ArrayView3, StridedView)
+{
+    Array3<double> arr(10, 8, 6);
+    arr.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        arr(i, j, k) = static_cast<double>(i + 100 * j + 10000 * k);
+    });
+
+    // Every other cell along x.
+    ArrayView3<double> view(arr.Accessor(), Point3UI(0, 0, 0), Size3(5, 8, 6),
+                            Size3(2, 1, 1));
+
+    view.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(arr(2 * i, j, k), view(i, j, k));
+    });
+}
+
+TEST(ArrayView3, WriteThrough)
+{
+    Array3<double> arr(10, 8, 6, 0.0);
+
+    ArrayView3<double> view(arr.Accessor(), Point3UI(2, 1, 3), Size3(4, 3, 2));
+    view.ParallelForEachIndex(
+        [&](size_t i, size_t j, size_t k) { view(i, j, k) = 1.0; });
+
+    size_t touched = 0;
+    arr.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (arr(i, j, k) == 1.0)
+        {
+            ++touched;
+            EXPECT_TRUE(i >= 2 && i < 6);
+            EXPECT_TRUE(j >= 1 && j < 4);
+            EXPECT_TRUE(k >= 3 && k < 5);
+        }
+    });
+
+    EXPECT_EQ(4u * 3u * 2u, touched);
+}
+
+TEST(ArrayView3, SubViewComposesStrides)
+{
+    Array3<double> arr(10, 8, 6);
+
+    ArrayView3<double> view(arr.Accessor(), Point3UI(2, 1, 3), Size3(4, 3, 2));
+    ConstArrayView3<double> cview(view);
+
+    const ConstArrayView3<double> sub =
+        cview.View(Point3UI(1, 0, 0), Size3(2, 3, 1), Size3(2, 1, 1));
+
+    EXPECT_EQ(&arr(3, 1, 3), &sub(0, 0, 0));
+    EXPECT_EQ(&arr(5, 1, 3), &sub(1, 0, 0));
+    EXPECT_EQ(&arr(3, 2, 3), &sub(0, 1, 0));
+}
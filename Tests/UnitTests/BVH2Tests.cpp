@@ -288,4 +288,40 @@ TEST(BVH2, ForEachOverlappingItems)
     });
 
     EXPECT_EQ(numOverlaps, measured);
-}
\ No newline at end of file
+}
+TEST(BVH2, BuildSAH)
+{
+    BVH2<Vector2D> midpoint;
+    BVH2<Vector2D> sah;
+
+    auto distanceFunc = [](const Vector2D& a, const Vector2D& b) {
+        return a.DistanceTo(b);
+    };
+
+    size_t numSamples = GetNumberOfSamplePoints2();
+    std::vector<Vector2D> points(GetSamplePoints2(),
+                                 GetSamplePoints2() + numSamples);
+
+    std::vector<BoundingBox2D> bounds(points.size());
+    size_t i = 0;
+
+    std::generate(bounds.begin(), bounds.end(), [&]() {
+        auto c = points[i++];
+        BoundingBox2D box(c, c);
+
+        box.Expand(0.1);
+
+        return box;
+    });
+
+    midpoint.Build(points, bounds);
+    sah.BuildSAH(points, bounds);
+
+    EXPECT_EQ(midpoint.GetNumberOfItems(), sah.GetNumberOfItems());
+    EXPECT_EQ(midpoint.GetNumberOfNodes(), sah.GetNumberOfNodes());
+
+    Vector2D testPt(0.5, 0.5);
+    auto expected = midpoint.GetNearestNeighbor(testPt, distanceFunc);
+    auto actual = sah.GetNearestNeighbor(testPt, distanceFunc);
+    EXPECT_DOUBLE_EQ(expected.distance, actual.distance);
+}
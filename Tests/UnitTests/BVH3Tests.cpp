@@ -1,8 +1,12 @@
 #include "UnitTestsUtils.hpp"
 #include "pch.hpp"
 
+#include <Core/Array/Array1.hpp>
 #include <Core/Geometry/BVH3.hpp>
 
+#include <random>
+#include <vector>
+
 using namespace CubbyFlow;
 
 TEST(BVH3, Constructors)
@@ -93,6 +97,122 @@ TEST(BVH3, Nearest)
     EXPECT_EQ(answerIdx, nearest.item - &bvh.GetItem(0));
 }
 
+TEST(BVH3, NearestBatch)
+{
+    BVH3<Vector3D> bvh;
+
+    auto distanceFunc = [](const Vector3D& a, const Vector3D& b) {
+        return a.DistanceTo(b);
+    };
+
+    size_t numSamples = GetNumberOfSamplePoints3();
+    std::vector<Vector3D> points(GetSamplePoints3(),
+                                 GetSamplePoints3() + numSamples);
+
+    std::vector<BoundingBox3D> bounds(points.size());
+    size_t i = 0;
+
+    std::generate(bounds.begin(), bounds.end(), [&]() {
+        auto c = points[i++];
+        BoundingBox3D box(c, c);
+
+        box.Expand(0.1);
+
+        return box;
+    });
+
+    bvh.Build(points, bounds);
+
+    size_t numQueries = GetNumberOfSampleDirs3();
+    Array1<Vector3D> queries(numQueries);
+    for (i = 0; i < numQueries; ++i)
+    {
+        queries[i] = GetSampleDirs3()[i];
+    }
+
+    Array1<NearestNeighborQueryResult3<Vector3D>> results(numQueries);
+
+    bvh.GetNearestNeighbors(queries.ConstAccessor(), distanceFunc,
+                            results.Accessor());
+
+    for (i = 0; i < numQueries; ++i)
+    {
+        auto nearest = bvh.GetNearestNeighbor(queries[i], distanceFunc);
+        EXPECT_EQ(nearest.item, results[i].item);
+        EXPECT_DOUBLE_EQ(nearest.distance, results[i].distance);
+    }
+}
+
+TEST(BVH3, BuildParallelAndRefit)
+{
+    BVH3<Vector3D> serial;
+    BVH3<Vector3D> parallel;
+
+    auto distanceFunc = [](const Vector3D& a, const Vector3D& b) {
+        return a.DistanceTo(b);
+    };
+
+    size_t numSamples = GetNumberOfSamplePoints3();
+    std::vector<Vector3D> points(GetSamplePoints3(),
+                                 GetSamplePoints3() + numSamples);
+
+    std::vector<BoundingBox3D> bounds(points.size());
+    size_t i = 0;
+
+    std::generate(bounds.begin(), bounds.end(), [&]() {
+        auto c = points[i++];
+        BoundingBox3D box(c, c);
+
+        box.Expand(0.1);
+
+        return box;
+    });
+
+    serial.Build(points, bounds);
+    parallel.BuildParallel(points, bounds);
+
+    EXPECT_EQ(serial.GetNumberOfItems(), parallel.GetNumberOfItems());
+    EXPECT_EQ(serial.GetNumberOfNodes(), parallel.GetNumberOfNodes());
+
+    size_t numQueries = GetNumberOfSampleDirs3();
+    for (i = 0; i < numQueries; ++i)
+    {
+        auto expected = serial.GetNearestNeighbor(GetSampleDirs3()[i],
+                                                  distanceFunc);
+        auto actual = parallel.GetNearestNeighbor(GetSampleDirs3()[i],
+                                                  distanceFunc);
+        EXPECT_DOUBLE_EQ(expected.distance, actual.distance);
+    }
+
+    // Translate every bound and refit; queries should match a fresh build.
+    const Vector3D offset(0.5, -0.25, 0.75);
+    std::vector<BoundingBox3D> movedBounds(bounds.size());
+    for (i = 0; i < bounds.size(); ++i)
+    {
+        movedBounds[i] = BoundingBox3D(bounds[i].lowerCorner + offset,
+                                       bounds[i].upperCorner + offset);
+    }
+
+    parallel.Refit(movedBounds);
+    serial.Build(points, movedBounds);
+
+    auto movedDistanceFunc = [&offset](const Vector3D& a, const Vector3D& b) {
+        return (a + offset).DistanceTo(b);
+    };
+
+    EXPECT_BOUNDING_BOX3_EQ(serial.GetBoundingBox(),
+                            parallel.GetBoundingBox());
+
+    for (i = 0; i < numQueries; ++i)
+    {
+        auto expected = serial.GetNearestNeighbor(GetSampleDirs3()[i],
+                                                  movedDistanceFunc);
+        auto actual = parallel.GetNearestNeighbor(GetSampleDirs3()[i],
+                                                  movedDistanceFunc);
+        EXPECT_DOUBLE_EQ(expected.distance, actual.distance);
+    }
+}
+
 TEST(BVH3, BBoxIntersects)
 {
     BVH3<Vector3D> bvh;
@@ -288,4 +408,165 @@ TEST(BVH3, ForEachOverlappingItems)
     });
 
     EXPECT_EQ(numOverlaps, measured);
-}
\ No newline at end of file
+}
+TEST(BVH3, GetClosestIntersections)
+{
+    std::mt19937 rng{ 11 };
+    std::uniform_real_distribution<double> dist{ 0.0, 1.0 };
+    std::vector<BoundingBox3D> items;
+    std::vector<BoundingBox3D> bounds;
+
+    for (int i = 0; i < 200; ++i)
+    {
+        const Vector3D c{ dist(rng), dist(rng), dist(rng) };
+        const Vector3D h{ 0.02 + 0.03 * dist(rng), 0.02 + 0.03 * dist(rng),
+                          0.02 + 0.03 * dist(rng) };
+        items.emplace_back(c - h, c + h);
+        bounds.emplace_back(c - h, c + h);
+    }
+
+    BVH3<BoundingBox3D> bvh;
+    bvh.Build(items, bounds);
+
+    const GetRayIntersectionFunc3<BoundingBox3D> testFunc =
+        [](const BoundingBox3D& b, const Ray3D& r) {
+            const auto hit = b.ClosestIntersection(r);
+            return hit.isIntersecting ? hit.near
+                                      : std::numeric_limits<double>::max();
+        };
+
+    // Coherent fan of rays, as a preview render would cast them.
+    std::vector<Ray3D> rays;
+    for (int py = 0; py < 10; ++py)
+    {
+        for (int px = 0; px < 10; ++px)
+        {
+            const Vector3D origin{ -1.0, 0.5, 0.5 };
+            const Vector3D target{ 1.0, px / 9.0, py / 9.0 };
+            rays.emplace_back(origin, (target - origin).Normalized());
+        }
+    }
+
+    std::vector<ClosestIntersectionQueryResult3<BoundingBox3D>> batched(
+        rays.size());
+    bvh.GetClosestIntersections(
+        ConstArrayAccessor1<Ray3D>(rays.size(), rays.data()), testFunc,
+        ArrayAccessor1<ClosestIntersectionQueryResult3<BoundingBox3D>>(
+            batched.size(), batched.data()));
+
+    for (size_t i = 0; i < rays.size(); ++i)
+    {
+        const auto single = bvh.GetClosestIntersection(rays[i], testFunc);
+        EXPECT_EQ(single.item, batched[i].item);
+        EXPECT_DOUBLE_EQ(single.distance, batched[i].distance);
+    }
+}
+
+TEST(BVH3, RefitDegradationRebuild)
+{
+    BVH3<size_t> bvh;
+
+    std::mt19937 rng(88);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+
+    const size_t n = 300;
+    std::vector<size_t> ids(n);
+    std::vector<BoundingBox3D> bounds(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ids[i] = i;
+        const Vector3D c{ u(rng), u(rng), u(rng) };
+        bounds[i] = BoundingBox3D(c - Vector3D(0.01, 0.01, 0.01),
+                                  c + Vector3D(0.01, 0.01, 0.01));
+    }
+
+    bvh.Build(ids, bounds);
+
+    // Scatter every item to an unrelated position. The refit degrades the
+    // tree far past the rebuild threshold, and either way every query must
+    // stay exact.
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Vector3D c{ u(rng), u(rng), u(rng) };
+        bounds[i] = BoundingBox3D(c - Vector3D(0.01, 0.01, 0.01),
+                                  c + Vector3D(0.01, 0.01, 0.01));
+    }
+
+    bvh.Refit(bounds);
+
+    const auto distanceFunc = [&](const size_t& item, const Vector3D& pt) {
+        return bounds[item].MidPoint().DistanceTo(pt);
+    };
+
+    for (int q = 0; q < 50; ++q)
+    {
+        const Vector3D pt{ u(rng), u(rng), u(rng) };
+        const auto result = bvh.GetNearestNeighbor(pt, distanceFunc);
+
+        double expected = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < n; ++i)
+        {
+            expected =
+                std::min(expected, bounds[i].MidPoint().DistanceTo(pt));
+        }
+
+        ASSERT_NE(result.item, nullptr);
+        EXPECT_DOUBLE_EQ(expected, result.distance);
+    }
+}
+
+TEST(BVH3, BuildSAH)
+{
+    BVH3<Vector3D> midpoint;
+    BVH3<Vector3D> sah;
+
+    auto distanceFunc = [](const Vector3D& a, const Vector3D& b) {
+        return a.DistanceTo(b);
+    };
+
+    size_t numSamples = GetNumberOfSamplePoints3();
+    std::vector<Vector3D> points(GetSamplePoints3(),
+                                 GetSamplePoints3() + numSamples);
+
+    std::vector<BoundingBox3D> bounds(points.size());
+    size_t i = 0;
+
+    std::generate(bounds.begin(), bounds.end(), [&]() {
+        auto c = points[i++];
+        BoundingBox3D box(c, c);
+
+        box.Expand(0.1);
+
+        return box;
+    });
+
+    midpoint.Build(points, bounds);
+    sah.BuildSAH(points, bounds);
+
+    EXPECT_EQ(midpoint.GetNumberOfItems(), sah.GetNumberOfItems());
+    EXPECT_EQ(midpoint.GetNumberOfNodes(), sah.GetNumberOfNodes());
+
+    // Every item must appear in exactly one leaf.
+    std::vector<size_t> leafCounts(numSamples, 0);
+    for (i = 0; i < sah.GetNumberOfNodes(); ++i)
+    {
+        if (sah.IsLeaf(i))
+        {
+            ++leafCounts[sah.GetItemOfNode(i) - sah.begin()];
+        }
+    }
+    for (i = 0; i < numSamples; ++i)
+    {
+        EXPECT_EQ(1u, leafCounts[i]);
+    }
+
+    size_t numQueries = GetNumberOfSampleDirs3();
+    for (i = 0; i < numQueries; ++i)
+    {
+        auto expected =
+            midpoint.GetNearestNeighbor(GetSampleDirs3()[i], distanceFunc);
+        auto actual = sah.GetNearestNeighbor(GetSampleDirs3()[i],
+                                             distanceFunc);
+        EXPECT_DOUBLE_EQ(expected.distance, actual.distance);
+    }
+}
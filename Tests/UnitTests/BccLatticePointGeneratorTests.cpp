@@ -0,0 +1,42 @@
+#include "pch.hpp"
+
+#include <Core/PointGenerator/BccLatticePointGenerator.hpp>
+
+using namespace CubbyFlow;
+
+TEST(BccLatticePointGenerator, GenerateMatchesForEachPoint)
+{
+    const BccLatticePointGenerator generator;
+    const BoundingBox3D box(Vector3D{ -0.4, 0.1, -1.3 },
+                            Vector3D{ 0.7, 0.9, -0.2 });
+    const double spacing = 0.13;
+
+    Array1<Vector3D> reference;
+    generator.ForEachPoint(box, spacing, [&](const Vector3D& point) {
+        reference.Append(point);
+        return true;
+    });
+
+    Array1<Vector3D> generated;
+    generator.Generate(box, spacing, &generated);
+
+    ASSERT_EQ(reference.size(), generated.size());
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        EXPECT_EQ(reference[i], generated[i]);
+    }
+}
+
+TEST(BccLatticePointGenerator, GenerateAppends)
+{
+    const BccLatticePointGenerator generator;
+    const BoundingBox3D box(Vector3D{ 0, 0, 0 }, Vector3D{ 1, 1, 1 });
+
+    Array1<Vector3D> points;
+    points.Append(Vector3D{ 9, 9, 9 });
+
+    generator.Generate(box, 0.25, &points);
+
+    ASSERT_GT(points.size(), 1u);
+    EXPECT_EQ(Vector3D(9, 9, 9), points[0]);
+}
@@ -0,0 +1,96 @@
+#include "pch.hpp"
+
+#include <Core/Array/BlockedArray3.hpp>
+
+using namespace CubbyFlow;
+
+TEST(BlockedArray3, Constructors)
+{
+    BlockedArray3<float> arr1;
+    EXPECT_EQ(0u, arr1.Width());
+    EXPECT_EQ(0u, arr1.Height());
+    EXPECT_EQ(0u, arr1.Depth());
+
+    BlockedArray3<float> arr2(Size3(3, 7, 4));
+    EXPECT_EQ(3u, arr2.Width());
+    EXPECT_EQ(7u, arr2.Height());
+    EXPECT_EQ(4u, arr2.Depth());
+    EXPECT_EQ(1u, arr2.BlockCount().x);
+    EXPECT_EQ(1u, arr2.BlockCount().y);
+    EXPECT_EQ(1u, arr2.BlockCount().z);
+
+    BlockedArray3<float> arr3(Size3(9, 17, 8), 1.5f);
+    EXPECT_EQ(2u, arr3.BlockCount().x);
+    EXPECT_EQ(3u, arr3.BlockCount().y);
+    EXPECT_EQ(1u, arr3.BlockCount().z);
+    arr3.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_FLOAT_EQ(1.5f, arr3(i, j, k));
+    });
+}
+
+TEST(BlockedArray3, RoundTrip)
+{
+    Array3<double> flat(11, 9, 13);
+    flat.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        flat(i, j, k) = 4.0 * i + 7.0 * j + 3.0 * k + 1.5;
+    });
+
+    BlockedArray3<double> blocked(flat.ConstAccessor());
+    EXPECT_EQ(flat.size(), blocked.size());
+    flat.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(flat(i, j, k), blocked(i, j, k));
+    });
+
+    Array3<double> flattened = blocked.Flatten();
+    flat.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(flat(i, j, k), flattened(i, j, k));
+    });
+}
+
+TEST(BlockedArray3, Resize)
+{
+    BlockedArray3<int> arr(Size3(5, 6, 7));
+    arr.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        arr(i, j, k) = static_cast<int>(i + 10 * j + 100 * k);
+    });
+
+    arr.Resize(Size3(12, 4, 9), -1);
+    EXPECT_EQ(12u, arr.Width());
+    EXPECT_EQ(4u, arr.Height());
+    EXPECT_EQ(9u, arr.Depth());
+    arr.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (i < 5 && j < 4 && k < 7)
+        {
+            EXPECT_EQ(static_cast<int>(i + 10 * j + 100 * k), arr(i, j, k));
+        }
+        else
+        {
+            EXPECT_EQ(-1, arr(i, j, k));
+        }
+    });
+}
+
+TEST(BlockedArray3, MortonIndexIsUnique)
+{
+    BlockedArray3<size_t> arr(Size3(8, 8, 8));
+    std::vector<bool> seen(8 * 8 * 8, false);
+
+    arr.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        const size_t idx = arr.Index(i, j, k);
+        ASSERT_LT(idx, seen.size());
+        EXPECT_FALSE(seen[idx]);
+        seen[idx] = true;
+    });
+}
+
+TEST(BlockedArray3, ParallelForEachIndex)
+{
+    BlockedArray3<double> arr(Size3(10, 10, 10), 5.0);
+
+    std::atomic<size_t> count{ 0 };
+    arr.ParallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(5.0, arr(i, j, k));
+        ++count;
+    });
+    EXPECT_EQ(1000u, count.load());
+}
@@ -349,6 +349,35 @@ TEST(CellCenteredScalarGrid3, LaplacianAtAtDataPoint)
     }
 }
 
+TEST(CellCenteredScalarGrid3, BatchGradientAndLaplacian)
+{
+    CellCenteredScalarGrid3 grid(5, 8, 6, 2.0, 3.0, 1.5);
+
+    grid.Fill([](const Vector3D& x) {
+        return std::sin(x.x) + 2.0 * std::cos(x.y) - 3.0 * x.z * x.z;
+    });
+
+    // The batch kernels must agree bitwise with the per-point operators,
+    // boundary shell included.
+    Array3<Vector3D> gradient;
+    grid.GradientGrid(&gradient);
+    ASSERT_EQ(grid.GetDataSize(), gradient.size());
+
+    Array3<double> laplacian;
+    grid.LaplacianGrid(&laplacian);
+    ASSERT_EQ(grid.GetDataSize(), laplacian.size());
+
+    grid.ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D grad = grid.GradientAtDataPoint(i, j, k);
+        EXPECT_DOUBLE_EQ(grad.x, gradient(i, j, k).x);
+        EXPECT_DOUBLE_EQ(grad.y, gradient(i, j, k).y);
+        EXPECT_DOUBLE_EQ(grad.z, gradient(i, j, k).z);
+
+        EXPECT_DOUBLE_EQ(grid.LaplacianAtDataPoint(i, j, k),
+                         laplacian(i, j, k));
+    });
+}
+
 TEST(CellCenteredScalarGrid3, Serialization)
 {
     CellCenteredScalarGrid3 grid1(5, 4, 3, 1.0, 2.0, 3.0, -5.0, 3.0, 1.0);
@@ -381,6 +410,14 @@ TEST(CellCenteredScalarGrid3, Serialization)
         EXPECT_DOUBLE_EQ(grid1(i, j, k), grid2(i, j, k));
     });
 
+    // Deserializing the same shape again must reuse the data array.
+    const double* dataPtr = grid2.GetConstDataAccessor().data();
+    grid2.Deserialize(buffer1);
+    EXPECT_EQ(dataPtr, grid2.GetConstDataAccessor().data());
+    grid1.ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(grid1(i, j, k), grid2(i, j, k));
+    });
+
     // Serialize zero-sized array
     CellCenteredScalarGrid3 grid3;
     std::vector<uint8_t> buffer2;
@@ -397,4 +434,24 @@ TEST(CellCenteredScalarGrid3, Serialization)
     EXPECT_DOUBLE_EQ(1.0, grid2.GridSpacing().x);
     EXPECT_DOUBLE_EQ(1.0, grid2.GridSpacing().y);
     EXPECT_DOUBLE_EQ(1.0, grid2.GridSpacing().z);
-}
\ No newline at end of file
+}
+TEST(CellCenteredScalarGrid3, CloneCopyOnWrite)
+{
+    CellCenteredScalarGrid3 grid(5, 4, 3, 1.0, 1.0, 1.0);
+    grid.Fill([](const Vector3D& x) { return x.x + 2.0 * x.y - x.z; });
+
+    // Cloning shares the data buffer until one side is written to.
+    const std::shared_ptr<ScalarGrid3> clone = grid.Clone();
+    EXPECT_EQ(grid.GetConstDataAccessor().data(),
+              clone->GetConstDataAccessor().data());
+
+    // Writing to the original detaches it; the clone keeps the snapshot and
+    // the original's sampler follows the new buffer.
+    const double before = grid(2, 1, 1);
+    grid.GetDataAccessor()(2, 1, 1) = 42.0;
+
+    EXPECT_DOUBLE_EQ(before, (*clone)(2, 1, 1));
+    EXPECT_DOUBLE_EQ(42.0, grid(2, 1, 1));
+    EXPECT_DOUBLE_EQ(42.0, grid.Sample(grid.GetDataPosition()(2, 1, 1)));
+    EXPECT_DOUBLE_EQ(before, clone->Sample(clone->GetDataPosition()(2, 1, 1)));
+}
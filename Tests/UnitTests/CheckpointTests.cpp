@@ -0,0 +1,158 @@
+#include "pch.hpp"
+
+#include <Core/Animation/Checkpoint.hpp>
+#include <Core/Animation/PhysicsAnimation.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace CubbyFlow;
+
+namespace
+{
+class SimpleAnimation final : public PhysicsAnimation
+{
+ public:
+    double value = 0.0;
+
+ protected:
+    void OnAdvanceTimeStep(double timeIntervalInSeconds) override
+    {
+        value += timeIntervalInSeconds;
+    }
+
+    void OnSaveCheckpoint(Checkpoint* checkpoint) const override
+    {
+        PhysicsAnimation::OnSaveCheckpoint(checkpoint);
+
+        std::vector<uint8_t> buffer(sizeof(double));
+        std::memcpy(buffer.data(), &value, sizeof(double));
+        checkpoint->Set("simpleAnimation", std::move(buffer));
+    }
+
+    bool OnLoadCheckpoint(const Checkpoint& checkpoint) override
+    {
+        if (!PhysicsAnimation::OnLoadCheckpoint(checkpoint))
+        {
+            return false;
+        }
+
+        const std::vector<uint8_t>* buffer =
+            checkpoint.Get("simpleAnimation");
+        if (buffer == nullptr || buffer->size() != sizeof(double))
+        {
+            return false;
+        }
+
+        std::memcpy(&value, buffer->data(), sizeof(double));
+        return true;
+    }
+};
+
+void RemoveCheckpointFiles(const Checkpoint& checkpoint,
+                           const std::vector<std::string>& names)
+{
+    std::remove("checkpoint.manifest");
+
+    for (const std::string& name : names)
+    {
+        const std::vector<uint8_t>* buffer = checkpoint.Get(name);
+        if (buffer != nullptr)
+        {
+            char hashHex[17];
+            std::snprintf(hashHex, sizeof(hashHex), "%016llx",
+                          static_cast<unsigned long long>(
+                              Checkpoint::HashBuffer(buffer->data(),
+                                                     buffer->size())));
+            std::remove((name + "." + hashHex + ".bin").c_str());
+        }
+    }
+}
+}  // namespace
+
+TEST(Checkpoint, SaveAndLoad)
+{
+    Checkpoint saved;
+    saved.Set("alpha", { 1, 2, 3, 4 });
+    saved.Set("beta", { 5, 6 });
+    ASSERT_TRUE(saved.SaveToDirectory("."));
+
+    Checkpoint loaded;
+    ASSERT_TRUE(loaded.LoadFromDirectory("."));
+
+    const std::vector<uint8_t>* alpha = loaded.Get("alpha");
+    ASSERT_NE(nullptr, alpha);
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 2, 3, 4 }), *alpha);
+
+    const std::vector<uint8_t>* beta = loaded.Get("beta");
+    ASSERT_NE(nullptr, beta);
+    EXPECT_EQ((std::vector<uint8_t>{ 5, 6 }), *beta);
+
+    EXPECT_EQ(nullptr, loaded.Get("gamma"));
+
+    RemoveCheckpointFiles(saved, { "alpha", "beta" });
+}
+
+TEST(Checkpoint, CorruptComponentRejected)
+{
+    Checkpoint saved;
+    saved.Set("alpha", { 1, 2, 3, 4 });
+    ASSERT_TRUE(saved.SaveToDirectory("."));
+
+    // Flip a byte in the component file
+    char hashHex[17];
+    const std::vector<uint8_t>* buffer = saved.Get("alpha");
+    std::snprintf(hashHex, sizeof(hashHex), "%016llx",
+                  static_cast<unsigned long long>(Checkpoint::HashBuffer(
+                      buffer->data(), buffer->size())));
+    const std::string path = std::string{ "alpha." } + hashHex + ".bin";
+    {
+        std::ofstream file{ path, std::ios::binary };
+        file.put(static_cast<char>(0xFF));
+    }
+
+    Checkpoint loaded;
+    EXPECT_FALSE(loaded.LoadFromDirectory("."));
+
+    RemoveCheckpointFiles(saved, { "alpha" });
+}
+
+TEST(Checkpoint, MissingManifestRejected)
+{
+    Checkpoint loaded;
+    EXPECT_FALSE(loaded.LoadFromDirectory("no_such_directory"));
+}
+
+TEST(Checkpoint, AnimationRestart)
+{
+    SimpleAnimation animation;
+    for (int i = 0; i < 10; ++i)
+    {
+        animation.AdvanceSingleFrame();
+    }
+
+    ASSERT_TRUE(animation.SaveCheckpoint("."));
+
+    SimpleAnimation restored;
+    ASSERT_TRUE(restored.LoadCheckpoint("."));
+    EXPECT_EQ(animation.GetCurrentFrame().index,
+              restored.GetCurrentFrame().index);
+    EXPECT_DOUBLE_EQ(animation.value, restored.value);
+
+    // Both must follow the same trajectory after the restart
+    for (int i = 0; i < 5; ++i)
+    {
+        animation.AdvanceSingleFrame();
+        restored.AdvanceSingleFrame();
+    }
+
+    EXPECT_EQ(animation.GetCurrentFrame().index,
+              restored.GetCurrentFrame().index);
+    EXPECT_DOUBLE_EQ(animation.value, restored.value);
+
+    Checkpoint checkpoint;
+    ASSERT_TRUE(checkpoint.LoadFromDirectory("."));
+    RemoveCheckpointFiles(checkpoint,
+                          { "physicsAnimation", "simpleAnimation" });
+}
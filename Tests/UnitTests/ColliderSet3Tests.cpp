@@ -1,9 +1,13 @@
 #include "pch.hpp"
 
+#include "UnitTestsUtils.hpp"
+
 #include <Core/Geometry/Box3.hpp>
 #include <Core/Geometry/ColliderSet3.hpp>
 #include <Core/Geometry/RigidBodyCollider3.hpp>
 
+#include <random>
+
 using namespace CubbyFlow;
 
 TEST(ColliderSet3, Constructors)
@@ -58,4 +62,51 @@ TEST(ColliderSet3, Builder)
 
     auto colSet3 = ColliderSet3::GetBuilder().Build();
     EXPECT_EQ(0u, colSet3.NumberOfColliders());
+}
+
+TEST(ColliderSet3, VelocityAtWithBroadphase)
+{
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uni(0.0, 10.0);
+
+    auto colSet = ColliderSet3::GetBuilder().MakeShared();
+    std::vector<Collider3Ptr> colliders;
+
+    for (size_t i = 0; i < 50; ++i)
+    {
+        const Vector3D lower{ uni(rng), uni(rng), uni(rng) };
+        auto box = Box3::GetBuilder()
+                       .WithLowerCorner(lower)
+                       .WithUpperCorner(lower + Vector3D{ 0.3, 0.2, 0.25 })
+                       .MakeShared();
+        auto col = RigidBodyCollider3::GetBuilder()
+                       .WithSurface(box)
+                       .WithLinearVelocity(
+                           { static_cast<double>(i), 0.0, 0.0 })
+                       .MakeShared();
+        colliders.push_back(col);
+        colSet->AddCollider(col);
+    }
+
+    colSet->Update(0.0, 1.0 / 60.0);
+
+    for (size_t q = 0; q < 100; ++q)
+    {
+        const Vector3D pt{ uni(rng), uni(rng), uni(rng) };
+
+        double closestDist = std::numeric_limits<double>::max();
+        Collider3Ptr closestCollider;
+        for (const auto& col : colliders)
+        {
+            const double dist = col->GetSurface()->ClosestDistance(pt);
+            if (dist < closestDist)
+            {
+                closestDist = dist;
+                closestCollider = col;
+            }
+        }
+
+        EXPECT_VECTOR3_EQ(closestCollider->VelocityAt(pt),
+                          colSet->VelocityAt(pt));
+    }
 }
\ No newline at end of file
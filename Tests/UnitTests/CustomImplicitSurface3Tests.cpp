@@ -111,4 +111,34 @@ TEST(CustomImplicitSurface3, ClosestIntersection)
         EXPECT_VECTOR3_NEAR(refAns.point, actAns.point, 1e-5);
         EXPECT_VECTOR3_NEAR(refAns.normal, actAns.normal, 1e-5);
     }
-}
\ No newline at end of file
+}
+TEST(CustomImplicitSurface3, EvaluationCache)
+{
+    int evalCount = 0;
+    auto sphereSdf = [&evalCount](const Vector3D& pt) {
+        ++evalCount;
+        return (pt - Vector3D{ 0.5, 0.5, 0.5 }).Length() - 0.25;
+    };
+
+    auto cached = CustomImplicitSurface3::GetBuilder()
+                      .WithSignedDistanceFunction(sphereSdf)
+                      .WithDomain(BoundingBox3D{ { 0, 0, 0 }, { 1, 1, 1 } })
+                      .WithEvaluationCache(0.02, 0.05)
+                      .MakeShared();
+
+    // Inside the refinement band the query must stay exact.
+    const Vector3D nearSurface{ 0.5, 0.5, 0.76 };
+    EXPECT_DOUBLE_EQ(sphereSdf(nearSurface),
+                     cached->SignedDistance(nearSurface));
+
+    // Away from the surface the interpolated value must be close, and a
+    // repeated query must be served from the cache without re-evaluating
+    // the function.
+    const Vector3D farPoint{ 0.1, 0.1, 0.1 };
+    const double exact = sphereSdf(farPoint);
+    EXPECT_NEAR(exact, cached->SignedDistance(farPoint), 0.01);
+
+    const int warmCount = evalCount;
+    EXPECT_NEAR(exact, cached->SignedDistance(farPoint), 0.01);
+    EXPECT_EQ(warmCount, evalCount);
+}
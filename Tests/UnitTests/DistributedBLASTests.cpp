@@ -0,0 +1,78 @@
+#include "pch.hpp"
+
+#include <FDMLinearSystemSolverTestHelper3.hpp>
+
+#include <Core/Math/CG.hpp>
+#include <Core/Math/DistributedBLAS.hpp>
+
+using namespace CubbyFlow;
+
+namespace
+{
+// Single-rank stand-in for an allreduce: the identity, with call counting
+struct CountingReducePolicy
+{
+    static double Sum(double localValue)
+    {
+        ++numSumCalls;
+        return localValue;
+    }
+
+    static double Max(double localValue)
+    {
+        ++numMaxCalls;
+        return localValue;
+    }
+
+    static size_t numSumCalls;
+    static size_t numMaxCalls;
+};
+
+size_t CountingReducePolicy::numSumCalls = 0;
+size_t CountingReducePolicy::numMaxCalls = 0;
+}  // namespace
+
+TEST(DistributedBLAS, CGMatchesLocalBLAS)
+{
+    using TestBLAS = DistributedBLAS<FDMBLAS3, CountingReducePolicy>;
+
+    FDMLinearSystem3 system;
+    FDMLinearSystemSolverTestHelper3::BuildTestLinearSystem(&system,
+                                                            { 3, 3, 3 });
+
+    FDMLinearSystem3 reference;
+    FDMLinearSystemSolverTestHelper3::BuildTestLinearSystem(&reference,
+                                                            { 3, 3, 3 });
+
+    FDMVector3 r(system.x.size()), d(system.x.size()), q(system.x.size()),
+        s(system.x.size());
+    unsigned int lastNumIter;
+    double lastResidual;
+
+    CountingReducePolicy::numSumCalls = 0;
+    CG<TestBLAS>(system.A, system.b, 100, 1e-9, &system.x, &r, &d, &q, &s,
+                 &lastNumIter, &lastResidual);
+
+    // Every dot product went through the reduce policy
+    EXPECT_GT(CountingReducePolicy::numSumCalls, 0u);
+    EXPECT_GT(1e-9, lastResidual);
+
+    // With an identity reduction the result matches the local BLAS exactly
+    CG<FDMBLAS3>(reference.A, reference.b, 100, 1e-9, &reference.x, &r, &d,
+                 &q, &s, &lastNumIter, &lastResidual);
+    system.x.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(reference.x(i, j, k), system.x(i, j, k));
+    });
+}
+
+TEST(DistributedBLAS, Norms)
+{
+    using TestBLAS = DistributedBLAS<FDMBLAS3, CountingReducePolicy>;
+
+    FDMVector3 v(2, 2, 2, -3.0);
+
+    CountingReducePolicy::numMaxCalls = 0;
+    EXPECT_DOUBLE_EQ(FDMBLAS3::L2Norm(v), TestBLAS::L2Norm(v));
+    EXPECT_DOUBLE_EQ(FDMBLAS3::LInfNorm(v), TestBLAS::LInfNorm(v));
+    EXPECT_EQ(1u, CountingReducePolicy::numMaxCalls);
+}
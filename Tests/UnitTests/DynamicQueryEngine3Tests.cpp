@@ -0,0 +1,228 @@
+#include "UnitTestsUtils.hpp"
+#include "pch.hpp"
+
+#include <Core/QueryEngine/DynamicQueryEngine3.hpp>
+
+using namespace CubbyFlow;
+
+namespace
+{
+DynamicQueryEngine3<Vector3D> MakePointEngine()
+{
+    return DynamicQueryEngine3<Vector3D>{ [](const Vector3D& pt) {
+        return BoundingBox3D{ pt, pt };
+    } };
+}
+}  // namespace
+
+TEST(DynamicQueryEngine3, BoxIntersection)
+{
+    const size_t numSamples = GetNumberOfSamplePoints3();
+    const std::vector<Vector3D> points(GetSamplePoints3(),
+                                       GetSamplePoints3() + numSamples);
+
+    DynamicQueryEngine3<Vector3D> engine = MakePointEngine();
+    engine.Add(points);
+
+    const auto testFunc = [](const Vector3D& pt, const BoundingBox3D& bbox) {
+        return bbox.Contains(pt);
+    };
+
+    const BoundingBox3D testBox({ 0.25, 0.15, 0.3 }, { 0.5, 0.6, 0.4 });
+    size_t numIntersections = 0;
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        numIntersections += testFunc(points[i], testBox);
+    }
+    bool hasIntersection = numIntersections > 0;
+
+    EXPECT_EQ(hasIntersection, engine.IsIntersects(testBox, testFunc));
+
+    const BoundingBox3D testBox2({ 0.3, 0.2, 0.1 }, { 0.6, 0.5, 0.4 });
+    numIntersections = 0;
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        numIntersections += testFunc(points[i], testBox2);
+    }
+    hasIntersection = numIntersections > 0;
+
+    EXPECT_EQ(hasIntersection, engine.IsIntersects(testBox2, testFunc));
+
+    size_t measured = 0;
+    engine.ForEachIntersectingItem(testBox2, testFunc, [&](const Vector3D& pt) {
+        EXPECT_TRUE(testFunc(pt, testBox2));
+        ++measured;
+    });
+
+    EXPECT_EQ(numIntersections, measured);
+}
+
+TEST(DynamicQueryEngine3, DynamicChurn)
+{
+    const size_t numSamples = GetNumberOfSamplePoints3();
+    const std::vector<Vector3D> points(GetSamplePoints3(),
+                                       GetSamplePoints3() + numSamples);
+
+    DynamicQueryEngine3<Vector3D> engine = MakePointEngine();
+
+    const auto testFunc = [](const Vector3D& pt, const BoundingBox3D& bbox) {
+        return bbox.Contains(pt);
+    };
+    const auto distanceFunc = [](const Vector3D& a, const Vector3D& b) {
+        return a.DistanceTo(b);
+    };
+    const BoundingBox3D testBox({ 0.2, 0.2, 0.2 }, { 0.8, 0.8, 0.8 });
+    const Vector3D testPt(0.5, 0.5, 0.5);
+
+    // Mirror the engine contents with a plain list, mutating both the same
+    // way and comparing query answers after every batch of changes.
+    std::vector<Vector3D> reference;
+
+    const auto verify = [&]() {
+        EXPECT_EQ(reference.size(), engine.GetNumberOfItems());
+
+        size_t expectedHits = 0;
+        for (const auto& pt : reference)
+        {
+            expectedHits += testFunc(pt, testBox);
+        }
+
+        size_t measuredHits = 0;
+        engine.ForEachIntersectingItem(testBox, testFunc,
+                                       [&](const Vector3D& pt) {
+                                           EXPECT_TRUE(testFunc(pt, testBox));
+                                           ++measuredHits;
+                                       });
+        EXPECT_EQ(expectedHits, measuredHits);
+
+        const auto nearest = engine.GetNearestNeighbor(testPt, distanceFunc);
+        if (reference.empty())
+        {
+            EXPECT_EQ(nullptr, nearest.item);
+            return;
+        }
+
+        double bestDist = std::numeric_limits<double>::max();
+        for (const auto& pt : reference)
+        {
+            bestDist = std::min(bestDist, distanceFunc(pt, testPt));
+        }
+
+        ASSERT_NE(nullptr, nearest.item);
+        EXPECT_DOUBLE_EQ(bestDist, nearest.distance);
+    };
+
+    // Initial population
+    for (size_t i = 0; i < numSamples / 2; ++i)
+    {
+        engine.Add(points[i]);
+        reference.push_back(points[i]);
+    }
+    verify();
+
+    // Remove every third item, then add the second half in small batches,
+    // interleaving queries so that the refit and overflow paths both run.
+    for (size_t i = 0; i < numSamples / 2; i += 3)
+    {
+        EXPECT_TRUE(engine.Remove(points[i]));
+        reference.erase(
+            std::find(reference.begin(), reference.end(), points[i]));
+
+        if (i % 9 == 0)
+        {
+            verify();
+        }
+    }
+    verify();
+
+    for (size_t i = numSamples / 2; i < numSamples; ++i)
+    {
+        engine.Add(points[i]);
+        reference.push_back(points[i]);
+
+        if (i % 7 == 0)
+        {
+            verify();
+        }
+    }
+    verify();
+
+    // Removing an item that is not stored fails.
+    EXPECT_FALSE(engine.Remove(Vector3D{ 42.0, 42.0, 42.0 }));
+
+    engine.Clear();
+    reference.clear();
+    verify();
+}
+
+TEST(DynamicQueryEngine3, ClosestIntersection)
+{
+    const size_t numSamples = GetNumberOfSamplePoints3();
+
+    DynamicQueryEngine3<BoundingBox3D> engine{ [](const BoundingBox3D& box) {
+        return box;
+    } };
+
+    const auto intersectsFunc = [](const BoundingBox3D& a, const Ray3D& ray) {
+        return a.ClosestIntersection(ray).near;
+    };
+
+    std::vector<BoundingBox3D> items(numSamples / 2);
+    size_t i = 0;
+
+    std::generate(items.begin(), items.end(), [&]() {
+        auto c = GetSamplePoints3()[i++];
+        BoundingBox3D box(c, c);
+
+        box.Expand(0.1);
+
+        return box;
+    });
+
+    // Split the population so that the first query builds the tree over the
+    // first half and the second half stays in the linear overflow section.
+    engine.Add(
+        std::vector<BoundingBox3D>{ items.begin(),
+                                    items.begin() + items.size() / 2 });
+    (void)engine.GetClosestIntersection(
+        Ray3D{ GetSamplePoints3()[0], GetSampleDirs3()[0] }, intersectsFunc);
+    engine.Add(
+        std::vector<BoundingBox3D>{ items.begin() + items.size() / 2,
+                                    items.end() });
+
+    for (i = 0; i < numSamples / 2; ++i)
+    {
+        Ray3D ray(GetSamplePoints3()[i + numSamples / 2],
+                  GetSampleDirs3()[i + numSamples / 2]);
+
+        // ad-hoc search
+        ClosestIntersectionQueryResult3<BoundingBox3D> ansInts;
+        for (size_t j = 0; j < items.size(); ++j)
+        {
+            double dist = intersectsFunc(items[j], ray);
+            if (dist < ansInts.distance)
+            {
+                ansInts.distance = dist;
+                ansInts.item = &items[j];
+            }
+        }
+
+        // engine search
+        auto engInts = engine.GetClosestIntersection(ray, intersectsFunc);
+
+        if (ansInts.item != nullptr && engInts.item != nullptr)
+        {
+            EXPECT_VECTOR3_EQ(ansInts.item->lowerCorner,
+                              engInts.item->lowerCorner);
+            EXPECT_VECTOR3_EQ(ansInts.item->upperCorner,
+                              engInts.item->upperCorner);
+        }
+        else
+        {
+            EXPECT_EQ(nullptr, ansInts.item);
+            EXPECT_EQ(nullptr, engInts.item);
+        }
+
+        EXPECT_DOUBLE_EQ(ansInts.distance, engInts.distance);
+    }
+}
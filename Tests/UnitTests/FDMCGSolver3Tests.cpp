@@ -18,6 +18,23 @@ TEST(FDMCGSolver3, Solve)
     EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
 }
 
+TEST(FDMCGSolver3, SolveMatrixFree)
+{
+    FDMLinearSystem3 system;
+    FDMLinearSystemSolverTestHelper3::BuildTestLinearSystem(&system,
+                                                            { 3, 3, 3 });
+
+    const FDMMatrixFreeOperator3 op = [&system](const FDMVector3& v,
+                                                FDMVector3* result) {
+        FDMBLAS3::MVM(system.A, v, result);
+    };
+
+    FDMCGSolver3 solver(100, 1e-9);
+    solver.SolveMatrixFree(op, system.b, &system.x);
+
+    EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
+}
+
 TEST(FDMCGSolver3, SolveCompressed)
 {
     FDMCompressedLinearSystem3 system;
@@ -28,4 +45,62 @@ TEST(FDMCGSolver3, SolveCompressed)
     solver.SolveCompressed(&system);
 
     EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
-}
\ No newline at end of file
+}
+TEST(FDMCGSolver3, SolveSinglePrecision)
+{
+    FDMLinearSystem3 system;
+    FDMLinearSystemSolverTestHelper3::BuildTestLinearSystem(&system,
+                                                            { 3, 3, 3 });
+
+    FDMLinearSystem3 reference;
+    FDMLinearSystemSolverTestHelper3::BuildTestLinearSystem(&reference,
+                                                            { 3, 3, 3 });
+
+    FDMCGSolver3 referenceSolver(100, 1e-9);
+    referenceSolver.Solve(&reference);
+
+    FDMCGSolver3 solver(100, 1e-6);
+    solver.SetUseSinglePrecision(true);
+    EXPECT_TRUE(solver.GetUseSinglePrecision());
+
+    EXPECT_TRUE(solver.Solve(&system));
+
+    system.x.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(reference.x(i, j, k), system.x(i, j, k), 1e-4);
+    });
+}
+
+TEST(FDMCGSolver3, Metrics)
+{
+    FDMLinearSystem3 system;
+    FDMLinearSystemSolverTestHelper3::BuildTestLinearSystem(&system,
+                                                            { 3, 3, 3 });
+
+    FDMCGSolver3 solver(100, 1e-9);
+
+    size_t numInvocations = 0;
+    solver.SetMetricsCallback([&numInvocations](const FDMSolverMetrics3& m) {
+        ++numInvocations;
+
+        EXPECT_GT(m.residualHistory.size(), 0u);
+        EXPECT_GE(m.spmvTimeInSeconds, 0.0);
+        EXPECT_GE(m.blas1TimeInSeconds, 0.0);
+        EXPECT_GE(m.totalTimeInSeconds, 0.0);
+    });
+
+    solver.Solve(&system);
+
+    EXPECT_EQ(1u, numInvocations);
+
+    const FDMSolverMetrics3& metrics = solver.GetLastMetrics();
+    EXPECT_EQ(static_cast<size_t>(solver.GetLastNumberOfIterations()),
+              metrics.residualHistory.size());
+    EXPECT_NEAR(solver.GetLastResidual(),
+                metrics.residualHistory[metrics.residualHistory.size() - 1],
+                1e-12);
+
+    // Unregistering the callback disables collection
+    solver.SetMetricsCallback(nullptr);
+    solver.Solve(&system);
+    EXPECT_EQ(1u, numInvocations);
+}
@@ -0,0 +1,52 @@
+#include "pch.hpp"
+
+#include <FDMLinearSystemSolverTestHelper3.hpp>
+
+#include <Core/Solver/FDM/FDMCallbackSolver3.hpp>
+#include <Core/Solver/FDM/FDMCGSolver3.hpp>
+
+using namespace CubbyFlow;
+
+TEST(FDMCallbackSolver3, Solve)
+{
+    FDMLinearSystem3 system;
+    FDMLinearSystemSolverTestHelper3::BuildTestLinearSystem(&system,
+                                                            { 3, 3, 3 });
+
+    // Stand-in for an external backend: delegates to a CG solve
+    size_t numInvocations = 0;
+    FDMCallbackSolver3 solver(
+        [&numInvocations](FDMLinearSystem3* sys) {
+            ++numInvocations;
+
+            FDMCGSolver3 backend(100, 1e-9);
+            return backend.Solve(sys);
+        });
+
+    EXPECT_TRUE(solver.Solve(&system));
+    EXPECT_EQ(1u, numInvocations);
+
+    FDMVector3 residual(system.x.size());
+    FDMBLAS3::Residual(system.A, system.x, system.b, &residual);
+    EXPECT_GT(1e-8, FDMBLAS3::L2Norm(residual));
+}
+
+TEST(FDMCallbackSolver3, SolveCompressed)
+{
+    FDMCompressedLinearSystem3 system;
+    FDMLinearSystemSolverTestHelper3::BuildTestCompressedLinearSystem(
+        &system, { 3, 3, 3 });
+
+    // No compressed function registered
+    FDMCallbackSolver3 unregistered([](FDMLinearSystem3*) { return true; });
+    EXPECT_FALSE(unregistered.SolveCompressed(&system));
+
+    FDMCallbackSolver3 solver(
+        nullptr, [](FDMCompressedLinearSystem3* sys) {
+            FDMCGSolver3 backend(100, 1e-9);
+            return backend.SolveCompressed(sys);
+        });
+
+    EXPECT_TRUE(solver.SolveCompressed(&system));
+    EXPECT_FALSE(solver.Solve(nullptr));
+}
@@ -40,4 +40,39 @@ TEST(FDMICCGSolver3, SolveCompressed)
     solver.SolveCompressed(&system);
 
     EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
-}
\ No newline at end of file
+}
+TEST(FDMICCGSolver3, SolveWithInitialGuess)
+{
+    FDMLinearSystem3 system;
+    FDMLinearSystemSolverTestHelper3::BuildTestLinearSystem(&system,
+                                                            { 32, 32, 32 });
+
+    FDMICCGSolver3 solver(100, 1e-9);
+    solver.Solve(&system);
+    const unsigned int coldIterations = solver.GetLastNumberOfIterations();
+
+    // Re-solving from the converged solution should be nearly free.
+    solver.SetUseInitialGuess(true);
+    EXPECT_TRUE(solver.Solve(&system));
+    EXPECT_LT(solver.GetLastNumberOfIterations(), coldIterations);
+    EXPECT_GT(solver.GetTolerance(), solver.GetLastResidual());
+}
+
+TEST(FDMICCGSolver3, RelativeTolerance)
+{
+    FDMLinearSystem3 system;
+    FDMLinearSystemSolverTestHelper3::BuildTestLinearSystem(&system,
+                                                            { 32, 32, 32 });
+
+    FDMICCGSolver3 tightSolver(100, 1e-9);
+    tightSolver.Solve(&system);
+    const unsigned int tightIterations =
+        tightSolver.GetLastNumberOfIterations();
+
+    FDMICCGSolver3 looseSolver(100, 1e-9);
+    looseSolver.SetRelativeTolerance(1e-2);
+    EXPECT_DOUBLE_EQ(1e-2, looseSolver.GetRelativeTolerance());
+
+    looseSolver.Solve(&system);
+    EXPECT_LT(looseSolver.GetLastNumberOfIterations(), tightIterations);
+}
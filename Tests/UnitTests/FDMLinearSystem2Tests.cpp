@@ -0,0 +1,73 @@
+#include "pch.hpp"
+
+#include <Core/FDM/FDMLinearSystem2.hpp>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+TEST(FDMBLAS2, StencilKernelMatchesCheckedStencil)
+{
+    const Size2 size{ 9, 6 };
+    FDMMatrix2 A{ size };
+    FDMVector2 v{ size };
+    FDMVector2 b{ size };
+    FDMVector2 expected{ size };
+    FDMVector2 actual{ size };
+
+    std::mt19937 rng{ 42 };
+    std::uniform_real_distribution<double> dist{ -1.0, 1.0 };
+    A.ForEachIndex([&](size_t i, size_t j) {
+        A(i, j).center = 4.0 + dist(rng);
+        A(i, j).right = dist(rng);
+        A(i, j).up = dist(rng);
+    });
+    v.ForEachIndex([&](size_t i, size_t j) { v(i, j) = dist(rng); });
+    b.ForEachIndex([&](size_t i, size_t j) { b(i, j) = dist(rng); });
+
+    // Checked per-point reference of A·v.
+    A.ForEachIndex([&](size_t i, size_t j) {
+        expected(i, j) =
+            A(i, j).center * v(i, j) +
+            ((i > 0) ? A(i - 1, j).right * v(i - 1, j) : 0.0) +
+            ((i + 1 < size.x) ? A(i, j).right * v(i + 1, j) : 0.0) +
+            ((j > 0) ? A(i, j - 1).up * v(i, j - 1) : 0.0) +
+            ((j + 1 < size.y) ? A(i, j).up * v(i, j + 1) : 0.0);
+    });
+
+    // The unchecked interior path must agree bitwise with the checked one.
+    FDMBLAS2::MVM(A, v, &actual);
+    expected.ForEachIndex(
+        [&](size_t i, size_t j) { EXPECT_EQ(expected(i, j), actual(i, j)); });
+
+    const double sum = FDMBLAS2::MVMAndDot(A, v, &actual);
+    double expectedSum = 0.0;
+    expected.ForEachIndex([&](size_t i, size_t j) {
+        EXPECT_EQ(expected(i, j), actual(i, j));
+        expectedSum += v(i, j) * expected(i, j);
+    });
+    EXPECT_NEAR(expectedSum, sum, 1e-12);
+
+    // Checked per-point reference of b - A·v.
+    A.ForEachIndex([&](size_t i, size_t j) {
+        expected(i, j) =
+            b(i, j) - A(i, j).center * v(i, j) -
+            ((i > 0) ? A(i - 1, j).right * v(i - 1, j) : 0.0) -
+            ((i + 1 < size.x) ? A(i, j).right * v(i + 1, j) : 0.0) -
+            ((j > 0) ? A(i, j - 1).up * v(i, j - 1) : 0.0) -
+            ((j + 1 < size.y) ? A(i, j).up * v(i, j + 1) : 0.0);
+    });
+
+    FDMBLAS2::Residual(A, v, b, &actual);
+    expected.ForEachIndex(
+        [&](size_t i, size_t j) { EXPECT_EQ(expected(i, j), actual(i, j)); });
+
+    double residualSum = 0.0;
+    expected.ForEachIndex([&](size_t i, size_t j) {
+        residualSum += expected(i, j) * expected(i, j);
+    });
+    EXPECT_NEAR(residualSum, FDMBLAS2::ResidualAndSelfDot(A, v, b, &actual),
+                1e-12);
+    expected.ForEachIndex(
+        [&](size_t i, size_t j) { EXPECT_EQ(expected(i, j), actual(i, j)); });
+}
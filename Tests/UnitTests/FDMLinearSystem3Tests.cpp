@@ -0,0 +1,147 @@
+#include "pch.hpp"
+
+#include <Core/FDM/FDMLinearSystem3.hpp>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+TEST(FDMMatrixSoA3, MatchesRowLayout)
+{
+    const Size3 size{ 13, 7, 9 };
+    FDMMatrix3 A{ size };
+    FDMVector3 v{ size };
+    FDMVector3 b{ size };
+    FDMVector3 expected{ size };
+    FDMVector3 actual{ size };
+
+    std::mt19937 rng{ 123 };
+    std::uniform_real_distribution<double> dist{ -1.0, 1.0 };
+    A.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        A(i, j, k).center = 6.0 + dist(rng);
+        A(i, j, k).right = dist(rng);
+        A(i, j, k).up = dist(rng);
+        A(i, j, k).front = dist(rng);
+    });
+    v.ForEachIndex(
+        [&](size_t i, size_t j, size_t k) { v(i, j, k) = dist(rng); });
+    b.ForEachIndex(
+        [&](size_t i, size_t j, size_t k) { b(i, j, k) = dist(rng); });
+
+    FDMMatrixSoA3 soa;
+    soa.Set(A);
+    EXPECT_EQ(size, soa.size());
+
+    FDMBLAS3::MVM(A, v, &expected);
+    FDMSoABLAS3::MVM(soa, v, &actual);
+    expected.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected(i, j, k), actual(i, j, k), 1e-12);
+    });
+
+    FDMBLAS3::Residual(A, v, b, &expected);
+    FDMSoABLAS3::Residual(soa, v, b, &actual);
+    expected.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected(i, j, k), actual(i, j, k), 1e-12);
+    });
+
+    EXPECT_NEAR(FDMBLAS3::MVMAndDot(A, v, &expected),
+                FDMSoABLAS3::MVMAndDot(soa, v, &actual), 1e-9);
+    EXPECT_NEAR(FDMBLAS3::ResidualAndSelfDot(A, v, b, &expected),
+                FDMSoABLAS3::ResidualAndSelfDot(soa, v, b, &actual), 1e-9);
+}
+
+TEST(FDMMatrixSoA3, DegenerateSizes)
+{
+    // Single-cell-wide axes exercise the boundary hoisting in the row sweep.
+    const Size3 size{ 1, 4, 1 };
+    FDMMatrix3 A{ size };
+    FDMVector3 v{ size };
+    FDMVector3 expected{ size };
+    FDMVector3 actual{ size };
+
+    std::mt19937 rng{ 7 };
+    std::uniform_real_distribution<double> dist{ -1.0, 1.0 };
+    A.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        A(i, j, k).center = 6.0 + dist(rng);
+        A(i, j, k).right = dist(rng);
+        A(i, j, k).up = dist(rng);
+        A(i, j, k).front = dist(rng);
+    });
+    v.ForEachIndex(
+        [&](size_t i, size_t j, size_t k) { v(i, j, k) = dist(rng); });
+
+    FDMMatrixSoA3 soa;
+    soa.Set(A);
+
+    FDMBLAS3::MVM(A, v, &expected);
+    FDMSoABLAS3::MVM(soa, v, &actual);
+    expected.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected(i, j, k), actual(i, j, k), 1e-12);
+    });
+}
+
+TEST(FDMBLAS3, StencilKernelMatchesCheckedStencil)
+{
+    const Size3 size{ 9, 6, 5 };
+    FDMMatrix3 A{ size };
+    FDMVector3 v{ size };
+    FDMVector3 b{ size };
+    FDMVector3 expected{ size };
+    FDMVector3 actual{ size };
+
+    std::mt19937 rng{ 42 };
+    std::uniform_real_distribution<double> dist{ -1.0, 1.0 };
+    A.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        A(i, j, k).center = 6.0 + dist(rng);
+        A(i, j, k).right = dist(rng);
+        A(i, j, k).up = dist(rng);
+        A(i, j, k).front = dist(rng);
+    });
+    v.ForEachIndex(
+        [&](size_t i, size_t j, size_t k) { v(i, j, k) = dist(rng); });
+    b.ForEachIndex(
+        [&](size_t i, size_t j, size_t k) { b(i, j, k) = dist(rng); });
+
+    // Checked per-point reference of A·v.
+    A.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        expected(i, j, k) =
+            A(i, j, k).center * v(i, j, k) +
+            ((i > 0) ? A(i - 1, j, k).right * v(i - 1, j, k) : 0.0) +
+            ((i + 1 < size.x) ? A(i, j, k).right * v(i + 1, j, k) : 0.0) +
+            ((j > 0) ? A(i, j - 1, k).up * v(i, j - 1, k) : 0.0) +
+            ((j + 1 < size.y) ? A(i, j, k).up * v(i, j + 1, k) : 0.0) +
+            ((k > 0) ? A(i, j, k - 1).front * v(i, j, k - 1) : 0.0) +
+            ((k + 1 < size.z) ? A(i, j, k).front * v(i, j, k + 1) : 0.0);
+    });
+
+    // The unchecked interior path must agree bitwise with the checked one.
+    FDMBLAS3::MVM(A, v, &actual);
+    expected.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(expected(i, j, k), actual(i, j, k));
+    });
+
+    const double sum = FDMBLAS3::MVMAndDot(A, v, &actual);
+    double expectedSum = 0.0;
+    expected.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(expected(i, j, k), actual(i, j, k));
+        expectedSum += v(i, j, k) * expected(i, j, k);
+    });
+    EXPECT_NEAR(expectedSum, sum, 1e-12);
+
+    // Checked per-point reference of b - A·v.
+    A.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        expected(i, j, k) =
+            b(i, j, k) - A(i, j, k).center * v(i, j, k) -
+            ((i > 0) ? A(i - 1, j, k).right * v(i - 1, j, k) : 0.0) -
+            ((i + 1 < size.x) ? A(i, j, k).right * v(i + 1, j, k) : 0.0) -
+            ((j > 0) ? A(i, j - 1, k).up * v(i, j - 1, k) : 0.0) -
+            ((j + 1 < size.y) ? A(i, j, k).up * v(i, j + 1, k) : 0.0) -
+            ((k > 0) ? A(i, j, k - 1).front * v(i, j, k - 1) : 0.0) -
+            ((k + 1 < size.z) ? A(i, j, k).front * v(i, j, k + 1) : 0.0);
+    });
+
+    FDMBLAS3::Residual(A, v, b, &actual);
+    expected.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(expected(i, j, k), actual(i, j, k));
+    });
+}
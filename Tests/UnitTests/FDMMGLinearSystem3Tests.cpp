@@ -0,0 +1,43 @@
+#include "pch.hpp"
+
+#include <Core/FDM/FDMMGLinearSystem3.hpp>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+TEST(FDMMGUtils3, RestrictResidual)
+{
+    const Size3 size{ 16, 16, 16 };
+
+    FDMMatrix3 A{ size };
+    FDMVector3 x{ size };
+    FDMVector3 b{ size };
+
+    std::mt19937 rng{ 0 };
+    std::uniform_real_distribution<double> dist{ 0.0, 1.0 };
+
+    A.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        A(i, j, k).center = 6.0 + dist(rng);
+        A(i, j, k).right = -dist(rng);
+        A(i, j, k).up = -dist(rng);
+        A(i, j, k).front = -dist(rng);
+
+        x(i, j, k) = dist(rng);
+        b(i, j, k) = dist(rng);
+    });
+
+    // Reference: separate residual pass followed by restriction
+    FDMVector3 residual{ size };
+    FDMBLAS3::Residual(A, x, b, &residual);
+
+    FDMVector3 expected{ size.x / 2, size.y / 2, size.z / 2 };
+    FDMMGUtils3::Restrict(residual, &expected);
+
+    FDMVector3 actual{ size.x / 2, size.y / 2, size.z / 2 };
+    FDMMGUtils3::RestrictResidual(A, x, b, &actual);
+
+    expected.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected(i, j, k), actual(i, j, k), 1e-12);
+    });
+}
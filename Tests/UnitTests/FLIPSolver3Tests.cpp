@@ -26,4 +26,20 @@ TEST(FLIPSolver3, PICBlendingFactor)
 
     solver.SetPICBlendingFactor(-0.9);
     EXPECT_EQ(0.0, solver.GetPICBlendingFactor());
+}
+
+TEST(FLIPSolver3, VorticityAdaptiveBlending)
+{
+    FLIPSolver3 solver;
+
+    EXPECT_FALSE(solver.GetUseVorticityAdaptiveBlending());
+
+    solver.SetUseVorticityAdaptiveBlending(true);
+    EXPECT_TRUE(solver.GetUseVorticityAdaptiveBlending());
+
+    solver.SetPICBlendingFactor(0.3);
+    for (Frame frame; frame.index < 2; ++frame)
+    {
+        solver.Update(frame);
+    }
 }
\ No newline at end of file
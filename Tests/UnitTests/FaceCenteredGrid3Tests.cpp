@@ -403,4 +403,55 @@ TEST(FaceCenteredGrid3, Serialization)
     EXPECT_DOUBLE_EQ(1.0, grid2.GridSpacing().x);
     EXPECT_DOUBLE_EQ(1.0, grid2.GridSpacing().y);
     EXPECT_DOUBLE_EQ(1.0, grid2.GridSpacing().z);
-}
\ No newline at end of file
+}
+TEST(FaceCenteredGrid3, DivergenceAndCurlGrid)
+{
+    FaceCenteredGrid3 grid(5, 8, 6, 2.0, 3.0, 1.5);
+
+    grid.Fill([](const Vector3D& x) {
+        return Vector3D(x.y * x.z, x.z * x.x, x.x * x.y);
+    });
+
+    Array3<double> div(grid.Resolution());
+    grid.DivergenceGrid(div.Accessor());
+
+    Array3<Vector3D> curl(grid.Resolution());
+    grid.CurlGrid(curl.Accessor());
+
+    // The fused whole-grid kernels must match the per-cell getters exactly.
+    div.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(grid.DivergenceAtCellCenter(i, j, k), div(i, j, k));
+
+        const Vector3D expected = grid.CurlAtCellCenter(i, j, k);
+        EXPECT_DOUBLE_EQ(expected.x, curl(i, j, k).x);
+        EXPECT_DOUBLE_EQ(expected.y, curl(i, j, k).y);
+        EXPECT_DOUBLE_EQ(expected.z, curl(i, j, k).z);
+    });
+}
+
+TEST(FaceCenteredGrid3, DataVersion)
+{
+    FaceCenteredGrid3 grid(3, 3, 3, 1.0, 1.0, 1.0);
+    const size_t v0 = grid.GetDataVersion();
+
+    // Const reads leave the version untouched.
+    (void)grid.ValueAtCellCenter(1, 1, 1);
+    (void)grid.GetUConstAccessor();
+    EXPECT_EQ(v0, grid.GetDataVersion());
+
+    // Every mutable entry point bumps it.
+    grid.Fill(Vector3D(1.0, 2.0, 3.0));
+    const size_t v1 = grid.GetDataVersion();
+    EXPECT_GT(v1, v0);
+
+    grid.GetU(0, 0, 0) = 4.0;
+    const size_t v2 = grid.GetDataVersion();
+    EXPECT_GT(v2, v1);
+
+    (void)grid.GetUAccessor();
+    const size_t v3 = grid.GetDataVersion();
+    EXPECT_GT(v3, v2);
+
+    grid.Resize(Size3(4, 4, 4), Vector3D(1.0, 1.0, 1.0), Vector3D());
+    EXPECT_GT(grid.GetDataVersion(), v3);
+}
@@ -0,0 +1,95 @@
+#include "pch.hpp"
+
+#include <Core/Grid/GridActiveRegion3.hpp>
+
+using namespace CubbyFlow;
+
+TEST(GridActiveRegion3, Build)
+{
+    GridActiveRegion3 region;
+
+    region.Build(Size3{ 32, 32, 32 }, [](size_t i, size_t j, size_t k) {
+        return i == 5 && j == 5 && k == 5;
+    });
+
+    EXPECT_EQ(Size3(4, 4, 4), region.GetTileCount());
+    EXPECT_EQ(1u, region.GetNumberOfActiveTiles());
+    EXPECT_TRUE(region.IsTileActive(0, 0, 0));
+    EXPECT_TRUE(region.IsCellActive(5, 5, 5));
+    EXPECT_TRUE(region.IsCellActive(0, 7, 3));
+    EXPECT_FALSE(region.IsCellActive(8, 5, 5));
+    EXPECT_FALSE(region.IsCellActive(20, 20, 20));
+}
+
+TEST(GridActiveRegion3, AddHalo)
+{
+    GridActiveRegion3 region;
+
+    region.Build(Size3{ 32, 32, 32 }, [](size_t i, size_t j, size_t k) {
+        return i == 5 && j == 5 && k == 5;
+    });
+    region.AddHalo();
+
+    // The corner tile plus its three face, three edge, and one corner
+    // neighbors should now be active.
+    EXPECT_EQ(8u, region.GetNumberOfActiveTiles());
+    EXPECT_TRUE(region.IsCellActive(10, 10, 10));
+    EXPECT_FALSE(region.IsCellActive(20, 20, 20));
+}
+
+TEST(GridActiveRegion3, NonTileAlignedResolution)
+{
+    GridActiveRegion3 region;
+
+    region.Build(Size3{ 20, 12, 9 }, [](size_t i, size_t j, size_t k) {
+        return i == 19 && j == 11 && k == 8;
+    });
+
+    EXPECT_EQ(Size3(3, 2, 2), region.GetTileCount());
+    EXPECT_EQ(1u, region.GetNumberOfActiveTiles());
+    EXPECT_TRUE(region.IsCellActive(19, 11, 8));
+    EXPECT_FALSE(region.IsCellActive(0, 0, 0));
+}
+
+TEST(GridActiveRegion3, BuildNarrowBand)
+{
+    Array3<double> sdf(Size3{ 32, 32, 32 });
+    sdf.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        const double dx = i + 0.5 - 16.0;
+        const double dy = j + 0.5 - 16.0;
+        const double dz = k + 0.5 - 16.0;
+        sdf(i, j, k) = std::sqrt(dx * dx + dy * dy + dz * dz) - 8.0;
+    });
+
+    GridActiveRegion3 region;
+    region.BuildNarrowBand(sdf.ConstAccessor(), 2.0);
+
+    EXPECT_TRUE(region.IsCellActive(16, 16, 8));
+
+    // Activity is tile-granular, so only tiles that are entirely outside
+    // the band are guaranteed inactive; the center tile still touches the
+    // band through its outer cells.
+    EXPECT_FALSE(region.IsCellActive(0, 0, 0));
+}
+
+TEST(GridActiveRegion3, ParallelForEachCellInActiveTiles)
+{
+    GridActiveRegion3 region;
+
+    region.Build(Size3{ 20, 12, 9 }, [](size_t i, size_t j, size_t k) {
+        return i == 5 && j == 5 && k == 5;
+    });
+
+    Array3<int> visited(Size3{ 20, 12, 9 }, 0);
+    region.ParallelForEachCellInActiveTiles(
+        [&](size_t i, size_t j, size_t k) { ++visited(i, j, k); });
+
+    size_t count = 0;
+    visited.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        count += visited(i, j, k);
+        EXPECT_EQ(region.IsCellActive(i, j, k) ? 1 : 0, visited(i, j, k));
+    });
+
+    // One full 8^3 tile, clamped by nothing in this corner.
+    EXPECT_EQ(512u, count);
+}
@@ -1,5 +1,7 @@
 #include "pch.hpp"
 
+#include <Core/Geometry/RigidBodyCollider3.hpp>
+#include <Core/Geometry/Sphere3.hpp>
 #include <Core/Solver/Grid/GridBlockedBoundaryConditionSolver3.hpp>
 
 using namespace CubbyFlow;
@@ -101,4 +103,41 @@ TEST(GridBlockedBoundaryConditionSolver3, OpenDomain)
             EXPECT_DOUBLE_EQ(1.0, velocity.GetW(i, j, k));
         }
     });
-}
\ No newline at end of file
+}
+TEST(GridBlockedBoundaryConditionSolver3, RepeatedConstrainIsDeterministic)
+{
+    auto sphere = Sphere3::Builder{}
+                      .WithCenter({ 0.0, 0.0, 0.0 })
+                      .WithRadius(2.0)
+                      .MakeShared();
+    auto collider =
+        RigidBodyCollider3::Builder{}.WithSurface(sphere).MakeShared();
+
+    GridBlockedBoundaryConditionSolver3 bndSolver;
+    Size3 gridSize(10, 10, 10);
+    Vector3D gridSpacing(1.0, 1.0, 1.0);
+    Vector3D gridOrigin(-5.0, -5.0, -5.0);
+
+    bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+    FaceCenteredGrid3 velocity(gridSize, gridSpacing, gridOrigin);
+    velocity.Fill(Vector3D(1.0, 1.0, 1.0));
+    bndSolver.ConstrainVelocity(&velocity);
+
+    // A second pass with an unchanged collider reuses the solver workspace
+    // and the cached marker, and must produce the exact same result.
+    FaceCenteredGrid3 velocity2(gridSize, gridSpacing, gridOrigin);
+    velocity2.Fill(Vector3D(1.0, 1.0, 1.0));
+    bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+    bndSolver.ConstrainVelocity(&velocity2);
+
+    velocity.ForEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(velocity.GetU(i, j, k), velocity2.GetU(i, j, k));
+    });
+    velocity.ForEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(velocity.GetV(i, j, k), velocity2.GetV(i, j, k));
+    });
+    velocity.ForEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(velocity.GetW(i, j, k), velocity2.GetW(i, j, k));
+    });
+}
@@ -0,0 +1,67 @@
+#include "pch.hpp"
+
+#include <Core/Solver/Grid/GridCascadeSolver3.hpp>
+
+using namespace CubbyFlow;
+
+TEST(GridCascadeSolver3, Constructor)
+{
+    auto coarse = GridFluidSolver3::GetBuilder()
+                      .WithResolution({ 8, 8, 8 })
+                      .WithDomainSizeX(1.0)
+                      .MakeShared();
+    auto fine = GridFluidSolver3::GetBuilder()
+                    .WithResolution({ 8, 8, 8 })
+                    .WithGridSpacing(1.0 / 16.0)
+                    .WithOrigin(Vector3D(0.25, 0.25, 0.25))
+                    .MakeShared();
+
+    const auto cascade = GridCascadeSolver3::GetBuilder()
+                             .WithCoarseSolver(coarse)
+                             .WithFineSolver(fine)
+                             .MakeShared();
+
+    EXPECT_EQ(coarse, cascade->GetCoarseSolver());
+    EXPECT_EQ(fine, cascade->GetFineSolver());
+    EXPECT_FALSE(cascade->GetIsTwoWayCouplingEnabled());
+
+    cascade->SetIsTwoWayCouplingEnabled(true);
+    EXPECT_TRUE(cascade->GetIsTwoWayCouplingEnabled());
+}
+
+TEST(GridCascadeSolver3, Update)
+{
+    auto coarse = GridFluidSolver3::GetBuilder()
+                      .WithResolution({ 8, 8, 8 })
+                      .WithDomainSizeX(1.0)
+                      .MakeShared();
+    auto fine = GridFluidSolver3::GetBuilder()
+                    .WithResolution({ 8, 8, 8 })
+                    .WithGridSpacing(1.0 / 16.0)
+                    .WithOrigin(Vector3D(0.25, 0.25, 0.25))
+                    .MakeShared();
+
+    const auto cascade = GridCascadeSolver3::GetBuilder()
+                             .WithCoarseSolver(coarse)
+                             .WithFineSolver(fine)
+                             .WithTwoWayCoupling(true)
+                             .MakeShared();
+
+    Frame frame(0, 1.0 / 60.0);
+    for (; frame.index < 2; frame.Advance())
+    {
+        cascade->Update(frame);
+    }
+
+    // The coarse velocity must have been wired into the fine solver as its
+    // background field.
+    ASSERT_NE(nullptr, fine->GetBackgroundVelocityField());
+
+    const Vector3D pt(0.4, 0.5, 0.5);
+    const Vector3D background = fine->GetBackgroundVelocityField()->Sample(pt);
+    const Vector3D coarseVel = coarse->GetVelocity()->Sample(pt);
+
+    EXPECT_DOUBLE_EQ(coarseVel.x, background.x);
+    EXPECT_DOUBLE_EQ(coarseVel.y, background.y);
+    EXPECT_DOUBLE_EQ(coarseVel.z, background.z);
+}
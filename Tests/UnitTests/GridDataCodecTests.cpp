@@ -0,0 +1,76 @@
+#include "pch.hpp"
+
+#include <Core/Grid/CellCenteredScalarGrid3.hpp>
+#include <Core/Utils/GridDataCodec.hpp>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+TEST(GridDataCodec, LosslessRoundTrip)
+{
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+
+    // Mostly-zero data spanning more than one chunk
+    std::vector<double> values(2 * 64 * 64 * 64 + 137, 0.0);
+    for (double& v : values)
+    {
+        if (rng() % 10 == 0)
+        {
+            v = dist(rng);
+        }
+    }
+
+    std::vector<uint8_t> buffer;
+    CompressGridData(values, GridDataQuantization::Lossless, &buffer);
+    EXPECT_LT(buffer.size(), values.size() * sizeof(double) / 2);
+
+    std::vector<double> decoded;
+    DecompressGridData(buffer.data(), buffer.size(), &decoded);
+
+    ASSERT_EQ(values.size(), decoded.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_EQ(values[i], decoded[i]);
+    }
+}
+
+TEST(GridDataCodec, Float16Quantization)
+{
+    const std::vector<double> values = { 0.0, 1.0, -2.5, 0.125, 1e9 };
+
+    std::vector<uint8_t> buffer;
+    CompressGridData(values, GridDataQuantization::Float16, &buffer);
+
+    std::vector<double> decoded;
+    DecompressGridData(buffer.data(), buffer.size(), &decoded);
+
+    ASSERT_EQ(values.size(), decoded.size());
+    EXPECT_EQ(0.0, decoded[0]);
+    EXPECT_EQ(1.0, decoded[1]);
+    EXPECT_EQ(-2.5, decoded[2]);
+    EXPECT_EQ(0.125, decoded[3]);
+    // Out-of-range values saturate to the half-precision maximum
+    EXPECT_EQ(65504.0, decoded[4]);
+}
+
+TEST(GridDataCodec, GridSerializeCompressed)
+{
+    CellCenteredScalarGrid3 grid{ 16, 12, 8, 0.5, 0.5, 0.5, 1.0, 2.0, 3.0 };
+    grid.Fill([](const Vector3D& x) { return (x.x > 5.0) ? x.y * x.z : 0.0; });
+
+    std::vector<uint8_t> buffer;
+    grid.SerializeCompressed(&buffer);
+
+    CellCenteredScalarGrid3 grid2;
+    grid2.DeserializeCompressed(buffer);
+
+    EXPECT_EQ(grid.Resolution(), grid2.Resolution());
+    EXPECT_EQ(grid.GridSpacing(), grid2.GridSpacing());
+    EXPECT_EQ(grid.Origin(), grid2.Origin());
+
+    grid.ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(grid(i, j, k), grid2(i, j, k));
+    });
+}
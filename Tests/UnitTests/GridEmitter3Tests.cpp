@@ -1,5 +1,6 @@
 #include "pch.hpp"
 
+#include <Core/Emitter/GridEmitterSet3.hpp>
 #include <Core/Emitter/VolumeGridEmitter3.hpp>
 #include <Core/Geometry/Sphere3.hpp>
 #include <Core/Grid/CellCenteredScalarGrid3.hpp>
@@ -115,4 +116,154 @@ TEST(VolumeGridEmitter3, StepFunction)
 
         EXPECT_NEAR(answer, acttual, 1e-6);
     });
-}
\ No newline at end of file
+}
+TEST(VolumeGridEmitter3, BoundedEmissionWithSDFCache)
+{
+    auto sphere = Sphere3::Builder()
+                      .WithCenter({ 0.5, 0.75, 0.5 })
+                      .WithRadius(0.15)
+                      .MakeShared();
+
+    auto buildEmitter = [&]() {
+        return VolumeGridEmitter3::Builder()
+            .WithSourceRegion(sphere)
+            .WithIsOneShot(false)
+            .MakeShared();
+    };
+
+    auto buildGrid = []() {
+        return CellCenteredScalarGrid3::Builder()
+            .WithResolution({ 16, 16, 16 })
+            .WithGridSpacing({ 1.0 / 16.0, 1.0 / 16.0, 1.0 / 16.0 })
+            .WithOrigin({ 0, 0, 0 })
+            .MakeShared();
+    };
+
+    auto refEmitter = buildEmitter();
+    auto refGrid = buildGrid();
+    refEmitter->AddStepFunctionTarget(refGrid, 0.0, 1.0);
+
+    auto emitter = buildEmitter();
+    auto grid = buildGrid();
+    emitter->AddStepFunctionTarget(grid, 0.0, 1.0);
+    emitter->SetUseBoundedEmission(true);
+    emitter->SetUseSourceSDFCache(true);
+    EXPECT_TRUE(emitter->GetUseBoundedEmission());
+    EXPECT_TRUE(emitter->GetUseSourceSDFCache());
+
+    // The cached second emission must match the unbounded reference
+    refEmitter->Update(0.0, 0.01);
+    emitter->Update(0.0, 0.01);
+    emitter->Update(0.01, 0.01);
+
+    grid->ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR((*refGrid)(i, j, k), (*grid)(i, j, k), 1e-12);
+    });
+
+    // Moving the source must invalidate the cache
+    sphere->transform.SetTranslation({ 0.0, -0.25, 0.0 });
+
+    refEmitter->Update(0.02, 0.01);
+    emitter->Update(0.02, 0.01);
+
+    grid->ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR((*refGrid)(i, j, k), (*grid)(i, j, k), 1e-12);
+    });
+}
+
+TEST(VolumeGridEmitter3, SDFPyramidEmission)
+{
+    auto sphere = Sphere3::Builder()
+                      .WithCenter({ 0.5, 0.75, 0.5 })
+                      .WithRadius(0.15)
+                      .MakeShared();
+
+    auto buildEmitter = [&]() {
+        return VolumeGridEmitter3::Builder()
+            .WithSourceRegion(sphere)
+            .WithIsOneShot(false)
+            .MakeShared();
+    };
+
+    auto buildGrid = []() {
+        return CellCenteredScalarGrid3::Builder()
+            .WithResolution({ 32, 32, 32 })
+            .WithGridSpacing({ 1.0 / 32.0, 1.0 / 32.0, 1.0 / 32.0 })
+            .WithOrigin({ 0, 0, 0 })
+            .MakeShared();
+    };
+
+    auto refEmitter = buildEmitter();
+    auto refGrid = buildGrid();
+    refEmitter->AddStepFunctionTarget(refGrid, 0.0, 1.0);
+
+    auto emitter = buildEmitter();
+    auto grid = buildGrid();
+    emitter->AddStepFunctionTarget(grid, 0.0, 1.0);
+    emitter->SetUseSDFPyramid(true);
+    EXPECT_TRUE(emitter->GetUseSDFPyramid());
+
+    refEmitter->Update(0.0, 0.01);
+    emitter->Update(0.0, 0.01);
+
+    // Step-function targets saturate outside the smearing margin, so the
+    // pyramid-culled emission must match the full evaluation exactly.
+    grid->ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR((*refGrid)(i, j, k), (*grid)(i, j, k), 1e-12);
+    });
+}
+
+TEST(GridEmitterSet3, ActiveRegionCullingAndExpiry)
+{
+    auto buildEmitter = [](const Vector3D& center) {
+        auto sphere =
+            Sphere3::Builder().WithCenter(center).WithRadius(0.15).MakeShared();
+        auto emitter = VolumeGridEmitter3::Builder()
+                           .WithSourceRegion(sphere)
+                           .WithIsOneShot(false)
+                           .MakeShared();
+        return emitter;
+    };
+
+    auto grid = CellCenteredScalarGrid3::Builder()
+                    .WithResolution({ 16, 16, 16 })
+                    .WithGridSpacing({ 1.0 / 16.0, 1.0 / 16.0, 1.0 / 16.0 })
+                    .WithOrigin({ 0, 0, 0 })
+                    .MakeShared();
+
+    auto nearEmitter = buildEmitter({ 0.5, 0.5, 0.5 });
+    auto farEmitter = buildEmitter({ 10.0, 10.0, 10.0 });
+    nearEmitter->AddStepFunctionTarget(grid, 0.0, 1.0);
+    farEmitter->AddStepFunctionTarget(grid, 0.0, 1.0);
+
+    GridEmitterSet3 set({ nearEmitter, farEmitter });
+    set.SetActiveRegion(BoundingBox3D({ 0, 0, 0 }, { 1, 1, 1 }));
+    set.Update(0.0, 0.01);
+
+    // Only the overlapping emitter ran; the other one sleeps.
+    EXPECT_EQ(EmitterState::Active, nearEmitter->GetState());
+    EXPECT_EQ(EmitterState::Sleeping, farEmitter->GetState());
+
+    // Growing the region wakes the sleeping emitter again.
+    set.SetActiveRegion(BoundingBox3D({ 0, 0, 0 }, { 20, 20, 20 }));
+    set.Update(0.01, 0.01);
+    EXPECT_EQ(EmitterState::Active, farEmitter->GetState());
+
+    // A one-shot emitter expires after its first emission and stays
+    // skipped even when it overlaps the region.
+    auto oneShotSphere = Sphere3::Builder()
+                             .WithCenter({ 0.5, 0.5, 0.5 })
+                             .WithRadius(0.15)
+                             .MakeShared();
+    auto oneShot = VolumeGridEmitter3::Builder()
+                       .WithSourceRegion(oneShotSphere)
+                       .WithIsOneShot(true)
+                       .MakeShared();
+    oneShot->AddStepFunctionTarget(grid, 0.0, 1.0);
+    set.AddEmitter(oneShot);
+
+    set.Update(0.02, 0.01);
+    EXPECT_EQ(EmitterState::Expired, oneShot->GetState());
+    set.Update(0.03, 0.01);
+    EXPECT_EQ(EmitterState::Expired, oneShot->GetState());
+}
@@ -1,5 +1,9 @@
 #include "pch.hpp"
 
+#include <Core/Emitter/VolumeGridEmitter3.hpp>
+#include <Core/Field/ConstantVectorField3.hpp>
+#include <Core/Geometry/Box3.hpp>
+#include <Core/Solver/Grid/GridSmokeSolver3.hpp>
 #include <Core/Solver/Grid/GridFluidSolver3.hpp>
 
 using namespace CubbyFlow;
@@ -93,4 +97,176 @@ TEST(GridFluidSolver3, GravityOnly)
     solver.GetVelocity()->ForEachWIndex([&](size_t i, size_t j, size_t k) {
         EXPECT_NEAR(0.0, solver.GetVelocity()->GetW(i, j, k), 1e-8);
     });
-}
\ No newline at end of file
+}
+
+TEST(GridFluidSolver3, SecondaryParticlesDefaults)
+{
+    GridFluidSolver3 solver;
+
+    // Disabled by default; subsystem only runs when switched on.
+    EXPECT_FALSE(solver.GetIsSecondaryParticlesEnabled());
+    EXPECT_EQ(nullptr, solver.GetSecondaryParticles());
+
+    solver.SetIsSecondaryParticlesEnabled(true);
+    EXPECT_TRUE(solver.GetIsSecondaryParticlesEnabled());
+
+    solver.SetMaxNumberOfSecondaryParticles(1234);
+    EXPECT_EQ(1234u, solver.GetMaxNumberOfSecondaryParticles());
+
+    // The base solver has no fluid SDF, so even with the subsystem enabled
+    // a step emits nothing.
+    solver.ResizeGrid(Size3(4, 4, 4), Vector3D(0.25, 0.25, 0.25), Vector3D());
+    solver.GetVelocity()->Fill(Vector3D(10.0, 0.0, 0.0));
+
+    Frame frame(0, 0.01);
+    solver.Update(frame);
+
+    ASSERT_NE(nullptr, solver.GetSecondaryParticles());
+    EXPECT_EQ(0u, solver.GetSecondaryParticles()->GetNumberOfParticles());
+}
+
+TEST(GridFluidSolver3, NumberOfSubTimeSteps)
+{
+    // Expose the protected sub-time-step query for testing.
+    struct TestSolver : GridFluidSolver3
+    {
+        using GridFluidSolver3::GetNumberOfSubTimeSteps;
+    };
+
+    TestSolver solver;
+    solver.SetMaxCFL(1.0);
+
+    solver.ResizeGrid(Size3(3, 3, 3), Vector3D(0.1, 0.1, 0.1), Vector3D());
+    solver.GetVelocity()->Fill(Vector3D(1.0, 0.0, 0.0));
+
+    // CFL = |u| * dt / dx = 1 with dt = 0.1
+    EXPECT_EQ(1u, solver.GetNumberOfSubTimeSteps(0.1));
+
+    // Ten times the interval needs ten sub-steps
+    EXPECT_EQ(10u, solver.GetNumberOfSubTimeSteps(1.0));
+
+    // Slow-down: expansion is rate limited (at most 50% growth per step)
+    EXPECT_EQ(10u, solver.GetNumberOfSubTimeSteps(1.0));
+    solver.GetVelocity()->Fill(Vector3D());
+    const unsigned int afterSlowDown = solver.GetNumberOfSubTimeSteps(1.0);
+    EXPECT_EQ(7u, afterSlowDown);
+
+    // ... but the step keeps expanding on subsequent calls
+    EXPECT_GT(afterSlowDown, solver.GetNumberOfSubTimeSteps(1.0));
+}
+
+TEST(GridFluidSolver3, AsyncEmitterUpdate)
+{
+    // The asynchronous emitter update must produce the same fields as the
+    // synchronous path for emitters that do not target velocity.
+    const auto runSim = [](bool useAsync) {
+        auto solver = GridSmokeSolver3::Builder()
+                          .WithResolution({ 8, 16, 8 })
+                          .WithDomainSizeX(1.0)
+                          .MakeShared();
+        solver->SetUseAsyncEmitterUpdate(useAsync);
+
+        const auto box = Box3::Builder()
+                             .WithLowerCorner({ 0.45, -1, 0.45 })
+                             .WithUpperCorner({ 0.55, 0.05, 0.55 })
+                             .MakeShared();
+        auto emitter = VolumeGridEmitter3::Builder()
+                           .WithSourceRegion(box)
+                           .WithIsOneShot(false)
+                           .MakeShared();
+        solver->SetEmitter(emitter);
+        emitter->AddStepFunctionTarget(solver->GetSmokeDensity(), 0, 1);
+
+        for (Frame frame(0, 1.0 / 60.0); frame.index < 3; ++frame)
+        {
+            solver->Update(frame);
+        }
+
+        double sum = 0.0;
+        solver->GetSmokeDensity()->ForEachDataPointIndex(
+            [&](size_t i, size_t j, size_t k) {
+                sum += (*solver->GetSmokeDensity())(i, j, k);
+            });
+        return sum;
+    };
+
+    GridFluidSolver3 solver;
+    EXPECT_FALSE(solver.GetUseAsyncEmitterUpdate());
+    solver.SetUseAsyncEmitterUpdate(true);
+    EXPECT_TRUE(solver.GetUseAsyncEmitterUpdate());
+
+    const double syncSum = runSim(false);
+    EXPECT_GT(syncSum, 0.0);
+    EXPECT_DOUBLE_EQ(syncSum, runSim(true));
+}
+
+TEST(GridSmokeSolver3, VorticityConfinement)
+{
+    const auto runSim = [](double strength) {
+        auto solver = GridSmokeSolver3::Builder()
+                          .WithResolution({ 12, 24, 12 })
+                          .WithDomainSizeX(1.0)
+                          .MakeShared();
+        solver->SetVorticityConfinementStrength(strength);
+
+        const auto box = Box3::Builder()
+                             .WithLowerCorner({ 0.45, -1, 0.45 })
+                             .WithUpperCorner({ 0.55, 0.05, 0.55 })
+                             .MakeShared();
+        auto emitter = VolumeGridEmitter3::Builder()
+                           .WithSourceRegion(box)
+                           .WithIsOneShot(false)
+                           .MakeShared();
+        solver->SetEmitter(emitter);
+        emitter->AddStepFunctionTarget(solver->GetSmokeDensity(), 0, 1);
+        emitter->AddStepFunctionTarget(solver->GetTemperature(), 0, 1);
+
+        for (Frame frame(0, 1.0 / 60.0); frame.index < 5; ++frame)
+        {
+            solver->Update(frame);
+        }
+
+        const auto vel = solver->GetGridSystemData()->GetVelocity();
+        double enstrophy = 0.0;
+        vel->ForEachCellIndex([&](size_t i, size_t j, size_t k) {
+            enstrophy += vel->CurlAtCellCenter(i, j, k).LengthSquared();
+        });
+        EXPECT_TRUE(std::isfinite(enstrophy));
+        return enstrophy;
+    };
+
+    GridSmokeSolver3 solver;
+    EXPECT_DOUBLE_EQ(0.0, solver.GetVorticityConfinementStrength());
+    solver.SetVorticityConfinementStrength(0.5);
+    EXPECT_DOUBLE_EQ(0.5, solver.GetVorticityConfinementStrength());
+    solver.SetVorticityConfinementStrength(-1.0);
+    EXPECT_DOUBLE_EQ(0.0, solver.GetVorticityConfinementStrength());
+
+    // Confinement should add small-scale rotational energy to the plume.
+    EXPECT_GT(runSim(0.25), runSim(0.0));
+}
+
+TEST(GridFluidSolver3, BackgroundVelocityBlend)
+{
+    auto solver = GridFluidSolver3::GetBuilder()
+                      .WithResolution({ 16, 16, 16 })
+                      .WithDomainSizeX(1.0)
+                      .MakeShared();
+    solver->SetGravity(Vector3D());
+
+    EXPECT_EQ(nullptr, solver->GetBackgroundVelocityField());
+
+    solver->SetBackgroundVelocityField(
+        std::make_shared<ConstantVectorField3>(Vector3D(1.0, 0.0, 0.0)));
+    solver->SetBackgroundBlendWidth(2);
+    EXPECT_EQ(2u, solver->GetBackgroundBlendWidth());
+
+    Frame frame(0, 1.0 / 60.0);
+    solver->Update(frame);
+
+    // Faces on the domain boundary carry the background flow; the blend
+    // weight decays to zero at the inner edge of the band.
+    const Vector3D nearBoundary =
+        solver->GetVelocity()->Sample(Vector3D(0.01, 0.5, 0.5));
+    EXPECT_GT(nearBoundary.x, 0.5);
+}
@@ -1,5 +1,7 @@
 #include "pch.hpp"
 
+#include <Core/Geometry/RigidBodyCollider3.hpp>
+#include <Core/Geometry/Sphere3.hpp>
 #include <Core/Solver/Grid/GridFractionalBoundaryConditionSolver3.hpp>
 
 using namespace CubbyFlow;
@@ -101,4 +103,111 @@ TEST(GridFractionalBoundaryConditionSolver3, OpenDomain)
             EXPECT_DOUBLE_EQ(1.0, velocity.GetW(i, j, k));
         }
     });
-}
\ No newline at end of file
+}
+TEST(GridFractionalBoundaryConditionSolver3, ColliderSDFCache)
+{
+    GridFractionalBoundaryConditionSolver3 bndSolver;
+    Size3 gridSize(16, 16, 16);
+    Vector3D gridSpacing(0.5, 0.5, 0.5);
+    Vector3D gridOrigin(-4.0, -4.0, -4.0);
+
+    auto sphere =
+        Sphere3::Builder{}.WithCenter({ 0, 0, 0 }).WithRadius(1.5).MakeShared();
+    auto collider =
+        RigidBodyCollider3::Builder{}.WithSurface(sphere).MakeShared();
+
+    bndSolver.SetUseColliderSDFCache(true);
+    EXPECT_TRUE(bndSolver.GetUseColliderSDFCache());
+
+    bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+    const size_t version0 = bndSolver.GetColliderSDFVersion();
+
+    // A static collider should not be re-rasterized
+    bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+    EXPECT_EQ(version0, bndSolver.GetColliderSDFVersion());
+
+    // Moving the surface triggers re-rasterization
+    sphere->transform.SetTranslation({ 0.5, 0.0, 0.0 });
+    bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+    EXPECT_LT(version0, bndSolver.GetColliderSDFVersion());
+
+    // Near the surface, the cached SDF should match a fresh rasterization
+    GridFractionalBoundaryConditionSolver3 refSolver;
+    refSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+    auto sdf = bndSolver.GetColliderSDF();
+    auto refSDF = refSolver.GetColliderSDF();
+
+    for (size_t k = 0; k < gridSize.z; ++k)
+    {
+        for (size_t j = 0; j < gridSize.y; ++j)
+        {
+            for (size_t i = 0; i < gridSize.x; ++i)
+            {
+                const Vector3D pt =
+                    gridOrigin +
+                    Vector3D{ (i + 0.5) * gridSpacing.x,
+                              (j + 0.5) * gridSpacing.y,
+                              (k + 0.5) * gridSpacing.z };
+                const double ref = refSDF->Sample(pt);
+
+                if (std::fabs(ref) < 1.0)
+                {
+                    EXPECT_NEAR(ref, sdf->Sample(pt), 1e-10);
+                }
+            }
+        }
+    }
+}
+
+TEST(GridFractionalBoundaryConditionSolver3, FaceClassificationReuse)
+{
+    Size3 gridSize(16, 16, 16);
+    Vector3D gridSpacing(0.5, 0.5, 0.5);
+    Vector3D gridOrigin(-4.0, -4.0, -4.0);
+
+    auto sphere =
+        Sphere3::Builder{}.WithCenter({ 0, 0, 0 }).WithRadius(1.5).MakeShared();
+    auto collider =
+        RigidBodyCollider3::Builder{}.WithSurface(sphere).MakeShared();
+
+    const auto fillVelocity = [&](FaceCenteredGrid3* velocity) {
+        velocity->Fill(Vector3D(1.0, 0.5, -0.25));
+    };
+
+    // Constrain twice with a static collider; the second call runs off the
+    // cached face classification and must reproduce the first result.
+    GridFractionalBoundaryConditionSolver3 bndSolver;
+    bndSolver.SetUseColliderSDFCache(true);
+    bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+    FaceCenteredGrid3 velocity0(gridSize, gridSpacing, gridOrigin);
+    fillVelocity(&velocity0);
+    bndSolver.ConstrainVelocity(&velocity0);
+
+    FaceCenteredGrid3 velocity1(gridSize, gridSpacing, gridOrigin);
+    fillVelocity(&velocity1);
+    bndSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+    bndSolver.ConstrainVelocity(&velocity1);
+
+    // A fresh solver classifying from scratch is the reference.
+    GridFractionalBoundaryConditionSolver3 refSolver;
+    refSolver.UpdateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+    FaceCenteredGrid3 refVelocity(gridSize, gridSpacing, gridOrigin);
+    fillVelocity(&refVelocity);
+    refSolver.ConstrainVelocity(&refVelocity);
+
+    velocity0.ForEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(refVelocity.GetU(i, j, k), velocity0.GetU(i, j, k));
+        EXPECT_EQ(refVelocity.GetU(i, j, k), velocity1.GetU(i, j, k));
+    });
+    velocity0.ForEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(refVelocity.GetV(i, j, k), velocity0.GetV(i, j, k));
+        EXPECT_EQ(refVelocity.GetV(i, j, k), velocity1.GetV(i, j, k));
+    });
+    velocity0.ForEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(refVelocity.GetW(i, j, k), velocity0.GetW(i, j, k));
+        EXPECT_EQ(refVelocity.GetW(i, j, k), velocity1.GetW(i, j, k));
+    });
+}
@@ -0,0 +1,42 @@
+#include "pch.hpp"
+
+#include <Core/PointGenerator/GridPointGenerator3.hpp>
+
+using namespace CubbyFlow;
+
+TEST(GridPointGenerator3, GenerateMatchesForEachPoint)
+{
+    const GridPointGenerator3 generator;
+    const BoundingBox3D box(Vector3D{ -0.5, 0.2, -1.1 },
+                            Vector3D{ 0.6, 1.0, -0.1 });
+    const double spacing = 0.17;
+
+    Array1<Vector3D> reference;
+    generator.ForEachPoint(box, spacing, [&](const Vector3D& point) {
+        reference.Append(point);
+        return true;
+    });
+
+    Array1<Vector3D> generated;
+    generator.Generate(box, spacing, &generated);
+
+    ASSERT_EQ(reference.size(), generated.size());
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        EXPECT_EQ(reference[i], generated[i]);
+    }
+}
+
+TEST(GridPointGenerator3, GenerateAppends)
+{
+    const GridPointGenerator3 generator;
+    const BoundingBox3D box(Vector3D{ 0, 0, 0 }, Vector3D{ 1, 1, 1 });
+
+    Array1<Vector3D> points;
+    points.Append(Vector3D{ 7, 7, 7 });
+
+    generator.Generate(box, 0.25, &points);
+
+    ASSERT_GT(points.size(), 1u);
+    EXPECT_EQ(Vector3D(7, 7, 7), points[0]);
+}
@@ -1,6 +1,7 @@
 #include "pch.hpp"
 
 #include <Core/Grid/CellCenteredScalarGrid3.hpp>
+#include <Core/Solver/FDM/FDMICCGSolver3.hpp>
 #include <Core/Solver/Grid/GridSinglePhasePressureSolver3.hpp>
 
 using namespace CubbyFlow;
@@ -408,4 +409,104 @@ TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceWithBoundary)
             }
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(GridSinglePhasePressureSolver3, SolveWithWarmStart)
+{
+    FaceCenteredGrid3 vel(8, 8, 8);
+
+    vel.Fill(Vector3D());
+
+    for (size_t k = 0; k < 8; ++k)
+    {
+        for (size_t j = 0; j < 9; ++j)
+        {
+            for (size_t i = 0; i < 8; ++i)
+            {
+                if (j == 0 || j == 8)
+                {
+                    vel.GetV(i, j, k) = 0.0;
+                }
+                else
+                {
+                    vel.GetV(i, j, k) = 1.0;
+                }
+            }
+        }
+    }
+
+    const auto systemSolver = std::make_shared<FDMICCGSolver3>(100, 1e-9);
+
+    GridSinglePhasePressureSolver3 solver;
+    solver.SetLinearSystemSolver(systemSolver);
+    solver.SetUseWarmStart(true);
+    EXPECT_TRUE(solver.GetUseWarmStart());
+
+    FaceCenteredGrid3 output(8, 8, 8);
+    solver.Solve(vel, 1.0, &output);
+    const unsigned int coldIterations =
+        systemSolver->GetLastNumberOfIterations();
+    const FDMVector3 coldPressure = solver.GetPressure();
+
+    // Solving the same system again starts from the previous pressure and
+    // should converge in fewer iterations to the same solution.
+    solver.Solve(vel, 1.0, &output);
+    EXPECT_LT(systemSolver->GetLastNumberOfIterations(), coldIterations);
+
+    const auto& warmPressure = solver.GetPressure();
+    coldPressure.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(coldPressure(i, j, k), warmPressure(i, j, k), 1e-6);
+    });
+}
+
+TEST(GridSinglePhasePressureSolver3, SolveWithDivergenceTarget)
+{
+    FaceCenteredGrid3 vel(8, 8, 8);
+
+    vel.Fill(Vector3D());
+
+    for (size_t k = 0; k < 8; ++k)
+    {
+        for (size_t j = 0; j < 9; ++j)
+        {
+            for (size_t i = 0; i < 8; ++i)
+            {
+                if (j == 0 || j == 8)
+                {
+                    vel.GetV(i, j, k) = 0.0;
+                }
+                else
+                {
+                    vel.GetV(i, j, k) = 1.0;
+                }
+            }
+        }
+    }
+
+    const auto systemSolver = std::make_shared<FDMICCGSolver3>(100, 1e-9);
+
+    GridSinglePhasePressureSolver3 solver;
+    solver.SetLinearSystemSolver(systemSolver);
+    solver.SetDivergenceTrackingEnabled(true);
+    EXPECT_TRUE(solver.GetDivergenceTrackingEnabled());
+
+    FaceCenteredGrid3 output(8, 8, 8);
+    solver.Solve(vel, 1.0, &output);
+
+    // A tight solve leaves the projected field essentially divergence-free.
+    EXPECT_LT(solver.GetLastMaxDivergence(), 1e-6);
+    EXPECT_LE(solver.GetLastMeanDivergence(), solver.GetLastMaxDivergence());
+
+    // With a loose target the controller relaxes the solver tolerance above
+    // the configured 1e-9 while the measured divergence stays on target.
+    solver.SetTargetDivergence(1e-3);
+    EXPECT_DOUBLE_EQ(1e-3, solver.GetTargetDivergence());
+
+    for (int iter = 0; iter < 10; ++iter)
+    {
+        solver.Solve(vel, 1.0, &output);
+    }
+
+    EXPECT_GT(systemSolver->GetTolerance(), 1e-9);
+    EXPECT_LE(solver.GetLastMaxDivergence(), 1e-3);
+}
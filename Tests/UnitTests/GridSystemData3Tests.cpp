@@ -172,4 +172,187 @@ TEST(GridSystemData3, Serialize)
     velocity->ForEachWIndex([&](size_t i, size_t j, size_t k) {
         EXPECT_EQ(velocity->GetW(i, j, k), velocity2->GetW(i, j, k));
     });
-}
\ No newline at end of file
+}
+TEST(GridSystemData3, ShadowBuffers)
+{
+    GridSystemData3 grids({ 16, 16, 16 }, { 1.0, 1.0, 1.0 }, { 0.0, 0.0, 0.0 });
+
+    size_t scalarIdx = grids.AddAdvectableScalarData(
+        std::make_shared<CellCenteredScalarGrid3::Builder>(), 5.0);
+
+    // Shadows match the grid type/layout and are reused across calls.
+    auto scalarShadow = grids.GetAdvectableScalarShadowAt(scalarIdx);
+    EXPECT_EQ(grids.GetAdvectableScalarDataAt(scalarIdx)->Resolution(),
+              scalarShadow->Resolution());
+    EXPECT_EQ(scalarShadow, grids.GetAdvectableScalarShadowAt(scalarIdx));
+
+    auto velShadow = std::dynamic_pointer_cast<FaceCenteredGrid3>(
+        grids.GetAdvectableVectorShadowAt(grids.GetVelocityIndex()));
+    ASSERT_TRUE(velShadow != nullptr);
+
+    // Swapping flips contents without touching pointer identity.
+    grids.GetVelocity()->Fill(Vector3D(1.0, 2.0, 3.0));
+    velShadow->Fill(Vector3D(0.0, 0.0, 0.0));
+    auto velocity = grids.GetVelocity();
+    velocity->Swap(velShadow.get());
+    EXPECT_EQ(velocity, grids.GetVelocity());
+    EXPECT_EQ(1.0, velShadow->GetU(0, 0, 0));
+    EXPECT_EQ(0.0, velocity->GetU(0, 0, 0));
+
+    // Resizing the system invalidates the shadows.
+    grids.Resize({ 8, 8, 8 }, { 1.0, 1.0, 1.0 }, { 0.0, 0.0, 0.0 });
+    auto rebuilt = grids.GetAdvectableScalarShadowAt(scalarIdx);
+    EXPECT_EQ(Size3(8, 8, 8), rebuilt->Resolution());
+}
+
+TEST(GridSystemData3, TileChangeListener)
+{
+    GridSystemData3 grids({ 40, 24, 24 }, { 1.0, 1.0, 1.0 }, { 0.0, 0.0, 0.0 });
+
+    const size_t scalarIdx = grids.AddAdvectableScalarData(
+        std::make_shared<CellCenteredScalarGrid3::Builder>(), 0.0);
+
+    std::vector<Point3UI> velTiles;
+    std::vector<Point3UI> scalarTiles;
+    size_t numCalls = 0;
+
+    grids.SetTileChangeListener([&](const std::vector<Point3UI>& velocityTiles,
+                                    const std::vector<Point3UI>& sTiles) {
+        velTiles = velocityTiles;
+        scalarTiles = sTiles;
+        ++numCalls;
+    });
+    EXPECT_TRUE(grids.HasTileChangeListener());
+
+    // Nothing changed between capture and emit -> empty lists, one call.
+    grids.CaptureTileSnapshot();
+    grids.EmitTileChangeEvents();
+    EXPECT_EQ(1u, numCalls);
+    EXPECT_TRUE(velTiles.empty());
+    EXPECT_TRUE(scalarTiles.empty());
+
+    // Emitting again without a fresh snapshot is a no-op.
+    grids.EmitTileChangeEvents();
+    EXPECT_EQ(1u, numCalls);
+
+    // Touch one velocity sample and one scalar sample in distinct tiles.
+    grids.CaptureTileSnapshot();
+    grids.GetVelocity()->GetU(20, 4, 4) += 1.0;
+    (*std::dynamic_pointer_cast<CellCenteredScalarGrid3>(
+        grids.GetAdvectableScalarDataAt(scalarIdx)))(36, 20, 20) = 2.0;
+    grids.EmitTileChangeEvents();
+
+    EXPECT_EQ(2u, numCalls);
+    ASSERT_EQ(1u, velTiles.size());
+    EXPECT_EQ(Point3UI(1, 0, 0), velTiles[0]);
+    ASSERT_EQ(1u, scalarTiles.size());
+    EXPECT_EQ(Point3UI(2, 1, 1), scalarTiles[0]);
+
+    // A change below the tracking epsilon stays invisible.
+    grids.SetTileTrackingEpsilon(1.0e-6);
+    grids.CaptureTileSnapshot();
+    grids.GetVelocity()->GetU(0, 0, 0) += 1.0e-9;
+    grids.EmitTileChangeEvents();
+    EXPECT_EQ(3u, numCalls);
+    EXPECT_TRUE(velTiles.empty());
+
+    // Resizing between capture and emit conservatively dirties everything.
+    grids.SetTileTrackingEpsilon(0.0);
+    grids.CaptureTileSnapshot();
+    grids.Resize({ 16, 16, 16 }, { 1.0, 1.0, 1.0 }, { 0.0, 0.0, 0.0 });
+    grids.EmitTileChangeEvents();
+    EXPECT_EQ(4u, numCalls);
+    EXPECT_EQ(1u, velTiles.size());
+    EXPECT_EQ(1u, scalarTiles.size());
+
+    // Clearing the listener disables tracking entirely.
+    grids.SetTileChangeListener(nullptr);
+    EXPECT_FALSE(grids.HasTileChangeListener());
+    grids.CaptureTileSnapshot();
+    grids.EmitTileChangeEvents();
+    EXPECT_EQ(4u, numCalls);
+}
+
+TEST(GridSystemData3, DerivedFields)
+{
+    GridSystemData3 grids{ { 8, 8, 8 }, { 1.0, 1.0, 1.0 },
+                           { 0.0, 0.0, 0.0 } };
+    grids.AddStandardDerivedFields();
+
+    const auto names = grids.GetDerivedFieldNames();
+    ASSERT_EQ(3u, names.size());
+    EXPECT_EQ("speed", names[0]);
+    EXPECT_EQ("vorticity", names[1]);
+    EXPECT_EQ("qCriterion", names[2]);
+
+    // Unknown names and kind mismatches return null.
+    EXPECT_EQ(nullptr, grids.ComputeDerivedScalarField("divergence"));
+    EXPECT_EQ(nullptr, grids.ComputeDerivedScalarField("vorticity"));
+    EXPECT_EQ(nullptr, grids.ComputeDerivedVectorField("speed"));
+
+    // Uniform flow: known speed, zero curl, zero Q.
+    grids.GetVelocity()->Fill(Vector3D{ 2.0, -1.0, 0.5 });
+
+    const auto speed = grids.ComputeDerivedScalarField("speed");
+    ASSERT_NE(nullptr, speed);
+    speed->ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(std::sqrt(5.25), (*speed)(i, j, k), 1e-12);
+    });
+
+    const auto uniformQ = grids.ComputeDerivedScalarField("qCriterion");
+    ASSERT_NE(nullptr, uniformQ);
+    uniformQ->ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(0.0, (*uniformQ)(i, j, k), 1e-12);
+    });
+
+    // Rigid rotation about z: vorticity matches the cell-center curl and
+    // Q is positive (pure rotation, no strain).
+    grids.GetVelocity()->Fill(Vector3D{});
+    grids.GetVelocity()->ForEachUIndex([&](size_t i, size_t j, size_t k) {
+        grids.GetVelocity()->GetU(i, j, k) = -(static_cast<double>(j) + 0.5);
+    });
+    grids.GetVelocity()->ForEachVIndex([&](size_t i, size_t j, size_t k) {
+        grids.GetVelocity()->GetV(i, j, k) = static_cast<double>(i) + 0.5;
+    });
+
+    const auto vorticity = grids.ComputeDerivedVectorField("vorticity");
+    ASSERT_NE(nullptr, vorticity);
+    vorticity->ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D expected =
+            grids.GetVelocity()->CurlAtCellCenter(i, j, k);
+        EXPECT_EQ(expected.x, (*vorticity)(i, j, k).x);
+        EXPECT_EQ(expected.y, (*vorticity)(i, j, k).y);
+        EXPECT_EQ(expected.z, (*vorticity)(i, j, k).z);
+    });
+
+    const auto q = grids.ComputeDerivedScalarField("qCriterion");
+    ASSERT_NE(nullptr, q);
+    q->ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(1.0, (*q)(i, j, k), 1e-12);
+    });
+
+    // The registry survives copies.
+    const GridSystemData3 copied{ grids };
+    EXPECT_EQ(3u, copied.GetDerivedFieldNames().size());
+
+    // Serialized derived fields round-trip as regular data layers in
+    // registration order.
+    grids.GetVelocity()->Fill(Vector3D{ 2.0, -1.0, 0.5 });
+
+    std::vector<uint8_t> buffer;
+    grids.SerializeDerivedFields(&buffer);
+
+    GridSystemData3 loaded;
+    loaded.Deserialize(buffer);
+
+    EXPECT_EQ(Size3(8, 8, 8), loaded.GetResolution());
+    ASSERT_EQ(2u, loaded.GetNumberOfScalarData());
+    ASSERT_EQ(1u, loaded.GetNumberOfVectorData());
+
+    const auto& loadedSpeed = loaded.GetScalarDataAt(0);
+    const auto& loadedQ = loaded.GetScalarDataAt(1);
+    loadedSpeed->ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(std::sqrt(5.25), (*loadedSpeed)(i, j, k), 1e-12);
+        EXPECT_NEAR(0.0, (*loadedQ)(i, j, k), 1e-12);
+    });
+}
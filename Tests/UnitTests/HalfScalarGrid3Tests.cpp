@@ -0,0 +1,89 @@
+#include "pch.hpp"
+
+#include <Core/Grid/CellCenteredScalarGrid3.hpp>
+#include <Core/Grid/HalfScalarGrid3.hpp>
+
+using namespace CubbyFlow;
+
+TEST(HalfScalarGrid3, Constructors)
+{
+    HalfScalarGrid3 grid1;
+    EXPECT_EQ(0u, grid1.Resolution().x);
+    EXPECT_EQ(0u, grid1.Resolution().y);
+    EXPECT_EQ(0u, grid1.Resolution().z);
+
+    HalfScalarGrid3 grid2{ Size3(4, 3, 2), Vector3D(1.0, 2.0, 3.0),
+                           Vector3D(5.0, 4.0, 3.0), 0.5 };
+    EXPECT_EQ(Size3(4, 3, 2), grid2.Resolution());
+    EXPECT_EQ(Vector3D(1.0, 2.0, 3.0), grid2.GridSpacing());
+    EXPECT_EQ(Vector3D(5.0, 4.0, 3.0), grid2.Origin());
+    EXPECT_EQ(Vector3D(5.5, 5.0, 4.5), grid2.GetDataOrigin());
+    EXPECT_DOUBLE_EQ(0.5, grid2(2, 1, 1));
+}
+
+TEST(HalfScalarGrid3, QuantizationRoundTrip)
+{
+    HalfScalarGrid3 grid{ Size3(2, 2, 2) };
+
+    // Half precision has a 10-bit mantissa, so values near 1 survive with
+    // roughly three decimal digits.
+    const double values[] = { 0.0, 1.0, -1.0, 0.123, 3.14159, -275.0 };
+    for (double value : values)
+    {
+        grid.SetValue(0, 0, 0, value);
+        EXPECT_NEAR(value, grid(0, 0, 0), std::fabs(value) * 1e-3 + 1e-6);
+    }
+}
+
+TEST(HalfScalarGrid3, FillFromScalarGrid)
+{
+    CellCenteredScalarGrid3 src{ Size3(5, 4, 6), Vector3D(1.0, 2.0, 3.0),
+                                 Vector3D(5.0, 4.0, 3.0) };
+    src.Fill([](const Vector3D& x) { return x.x + 2.0 * x.y - x.z; });
+
+    HalfScalarGrid3 half{ src };
+    EXPECT_EQ(src.GetDataSize(), half.Resolution());
+    EXPECT_EQ(src.GridSpacing(), half.GridSpacing());
+    EXPECT_EQ(src.GetDataOrigin(), half.GetDataOrigin());
+
+    auto srcData = src.GetConstDataAccessor();
+    srcData.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(srcData(i, j, k), half(i, j, k),
+                    std::fabs(srcData(i, j, k)) * 1e-3 + 1e-6);
+    });
+
+    // Storage is two bytes per data point.
+    EXPECT_EQ(src.GetDataSize(), half.GetRawDataAccessor().size());
+}
+
+TEST(HalfScalarGrid3, Sample)
+{
+    CellCenteredScalarGrid3 src{ Size3(8, 8, 8), Vector3D(0.5, 0.5, 0.5) };
+    src.Fill([](const Vector3D& x) { return 0.25 * x.x - 0.5 * x.y + x.z; });
+
+    const HalfScalarGrid3 half{ src };
+
+    const Vector3D samples[] = { Vector3D(1.0, 1.0, 1.0),
+                                 Vector3D(0.1, 3.3, 2.7),
+                                 Vector3D(3.9, 0.4, 1.6) };
+    for (const Vector3D& pt : samples)
+    {
+        EXPECT_NEAR(src.Sample(pt), half.Sample(pt),
+                    std::fabs(src.Sample(pt)) * 1e-3 + 1e-6);
+    }
+}
+
+TEST(HalfScalarGrid3, Builder)
+{
+    HalfScalarGrid3Ptr grid = HalfScalarGrid3::GetBuilder()
+                                  .WithResolution(Size3(3, 2, 4))
+                                  .WithGridSpacing(Vector3D(2.0, 2.0, 2.0))
+                                  .WithOrigin(Vector3D(1.0, 2.0, 3.0))
+                                  .WithInitialValue(4.0)
+                                  .MakeShared();
+
+    EXPECT_EQ(Size3(3, 2, 4), grid->Resolution());
+    EXPECT_EQ(Vector3D(2.0, 2.0, 2.0), grid->GridSpacing());
+    EXPECT_EQ(Vector3D(1.0, 2.0, 3.0), grid->Origin());
+    EXPECT_DOUBLE_EQ(4.0, (*grid)(1, 1, 2));
+}
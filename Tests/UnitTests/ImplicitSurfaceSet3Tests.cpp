@@ -3,9 +3,11 @@
 
 #include <Core/Geometry/Box3.hpp>
 #include <Core/Geometry/ImplicitSurfaceSet3.hpp>
+#include <Core/Geometry/ImplicitSurfaceSetToSDF.hpp>
 #include <Core/Geometry/Plane3.hpp>
 #include <Core/Geometry/Sphere3.hpp>
 #include <Core/Geometry/SurfaceToImplicit3.hpp>
+#include <Core/Grid/CellCenteredScalarGrid3.hpp>
 
 using namespace CubbyFlow;
 
@@ -323,4 +325,41 @@ TEST(ImplicitSurfaceSet3, UpdateQueryEngine)
     auto bbox4 = surfaceSet->BoundingBox();
     EXPECT_BOUNDING_BOX2_EQ(
         BoundingBox3D({ -4.5, 5.5, 10.5 }, { -3.5, 6.5, 11.5 }), bbox4);
-}
\ No newline at end of file
+}
+TEST(ImplicitSurfaceSet3, ToSDF)
+{
+    auto surfaceSet = ImplicitSurfaceSet3::Builder{}
+                          .WithExplicitSurfaces(
+                              { Sphere3::Builder{}
+                                    .WithCenter({ 0.25, 0.5, 0.5 })
+                                    .WithRadius(0.15)
+                                    .MakeShared(),
+                                Box3::Builder{}
+                                    .WithLowerCorner({ 0.6, 0.3, 0.3 })
+                                    .WithUpperCorner({ 0.9, 0.7, 0.7 })
+                                    .MakeShared() })
+                          .MakeShared();
+
+    const size_t res = 32;
+    const double h = 1.0 / static_cast<double>(res);
+    CellCenteredScalarGrid3 sdf{ res, res, res, h, h, h };
+
+    ImplicitSurfaceSetToSDF(*surfaceSet, &sdf);
+
+    const double bandwidth = 3.0 * h;
+    const auto pos = sdf.GetDataPosition();
+
+    sdf.ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const double truth = surfaceSet->SignedDistance(pos(i, j, k));
+        const double approx = sdf(i, j, k);
+
+        // Exact inside the band; correct sign and a conservative magnitude
+        // everywhere else
+        if (std::fabs(truth) <= bandwidth)
+        {
+            EXPECT_NEAR(truth, approx, 1e-10);
+        }
+        EXPECT_EQ(truth < 0.0, approx < 0.0);
+        EXPECT_LE(std::fabs(approx), std::fabs(truth) + 1e-9);
+    });
+}
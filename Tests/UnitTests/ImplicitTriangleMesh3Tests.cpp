@@ -5,6 +5,7 @@
 #include <Core/Geometry/ImplicitTriangleMesh3.hpp>
 #include <Core/Geometry/SurfaceToImplicit3.hpp>
 
+#include <filesystem>
 #include <fstream>
 
 using namespace CubbyFlow;
@@ -34,4 +35,53 @@ TEST(ImplicitTriangleMesh3, SignedDistance)
 
         EXPECT_NEAR(refAns, actAns, 1.0 / 20);
     }
-}
\ No newline at end of file
+}
+TEST(ImplicitTriangleMesh3, BakeCache)
+{
+    namespace fs = std::filesystem;
+
+    std::ifstream objFile(RESOURCES_DIR "/cube.obj");
+    auto mesh = TriangleMesh3::Builder().MakeShared();
+    [[maybe_unused]] bool isLoaded = mesh->ReadObj(&objFile);
+
+    const std::string cacheDir = "implicit_triangle_mesh3_bake_cache_test";
+    fs::create_directory(cacheDir);
+
+    auto uncached = ImplicitTriangleMesh3::Builder()
+                        .WithTriangleMesh(mesh)
+                        .WithResolutionX(10)
+                        .MakeShared();
+
+    auto baked = ImplicitTriangleMesh3::Builder()
+                     .WithTriangleMesh(mesh)
+                     .WithResolutionX(10)
+                     .WithBakeCacheDirectory(cacheDir)
+                     .MakeShared();
+
+    // One cache entry should have been written
+    size_t numCacheFiles = 0;
+    for ([[maybe_unused]] const auto& entry : fs::directory_iterator(cacheDir))
+    {
+        ++numCacheFiles;
+    }
+    EXPECT_EQ(1u, numCacheFiles);
+
+    // Second construction loads the cached grid
+    auto cached = ImplicitTriangleMesh3::Builder()
+                      .WithTriangleMesh(mesh)
+                      .WithResolutionX(10)
+                      .WithBakeCacheDirectory(cacheDir)
+                      .MakeShared();
+
+    EXPECT_EQ(uncached->GetGrid()->Resolution(),
+              cached->GetGrid()->Resolution());
+    uncached->GetGrid()->ForEachDataPointIndex(
+        [&](size_t i, size_t j, size_t k) {
+            EXPECT_DOUBLE_EQ((*uncached->GetGrid())(i, j, k),
+                             (*baked->GetGrid())(i, j, k));
+            EXPECT_DOUBLE_EQ((*uncached->GetGrid())(i, j, k),
+                             (*cached->GetGrid())(i, j, k));
+        });
+
+    fs::remove_all(cacheDir);
+}
@@ -11,6 +11,9 @@
 #include <Core/Solver/LevelSet/LevelSetLiquidSolver2.hpp>
 #include <Core/Solver/LevelSet/LevelSetLiquidSolver3.hpp>
 
+#include <chrono>
+#include <thread>
+
 using namespace CubbyFlow;
 
 TEST(LevelSetLiquidSolver2, ComputeVolume)
@@ -39,6 +42,138 @@ TEST(LevelSetLiquidSolver2, ComputeVolume)
     EXPECT_NEAR(ans, volume, 0.001);
 }
 
+TEST(LevelSetLiquidSolver3, ParticleLevelSet)
+{
+    LevelSetLiquidSolver3 solver;
+    solver.SetIsParticleLevelSetEnabled(true);
+    solver.SetGravity(Vector3D{});
+
+    auto data = solver.GetGridSystemData();
+    const double dx = 1.0 / 16.0;
+    data->Resize(Size3(16, 16, 16), Vector3D(dx, dx, dx), Vector3D());
+
+    const double radius = 0.2;
+    BoundingBox3D domain = data->GetBoundingBox();
+    ImplicitSurfaceSet3 surfaceSet;
+    surfaceSet.AddExplicitSurface(
+        std::make_shared<Sphere3>(domain.MidPoint(), radius));
+
+    auto sdf = solver.GetSignedDistanceField();
+    sdf->Fill([&](const Vector3D& x) { return surfaceSet.SignedDistance(x); });
+
+    const double volumeBefore = solver.ComputeVolume();
+
+    Frame frame{ 0, 0.01 };
+    for (; frame.index < 2; ++frame)
+    {
+        solver.Update(frame);
+    }
+
+    // Particles must be seeded in the interface band, each with a sign and
+    // a bounded radius.
+    auto particles = solver.GetLevelSetParticles();
+    ASSERT_NE(nullptr, particles);
+    ASSERT_GT(particles->GetNumberOfParticles(), 0u);
+
+    auto positions = particles->GetPositions();
+    for (size_t i = 0; i < particles->GetNumberOfParticles(); ++i)
+    {
+        EXPECT_TRUE(domain.Contains(positions[i]));
+    }
+
+    // A resting droplet with no gravity must keep its volume.
+    EXPECT_NEAR(volumeBefore, solver.ComputeVolume(), 0.05 * volumeBefore);
+}
+
+TEST(LevelSetLiquidSolver3, SecondaryParticles)
+{
+    LevelSetLiquidSolver3 solver;
+    solver.SetIsSecondaryParticlesEnabled(true);
+
+    auto data = solver.GetGridSystemData();
+    const double dx = 1.0 / 16.0;
+    data->Resize(Size3(16, 16, 16), Vector3D(dx, dx, dx), Vector3D());
+
+    // A falling droplet: the interface moves fast enough to pass the
+    // emission thresholds within a few frames.
+    BoundingBox3D domain = data->GetBoundingBox();
+    ImplicitSurfaceSet3 surfaceSet;
+    surfaceSet.AddExplicitSurface(std::make_shared<Sphere3>(
+        domain.MidPoint() + Vector3D(0.0, 0.2, 0.0), 0.15));
+
+    auto sdf = solver.GetSignedDistanceField();
+    sdf->Fill([&](const Vector3D& x) { return surfaceSet.SignedDistance(x); });
+
+    Frame frame{ 0, 0.05 };
+    for (; frame.index < 5; ++frame)
+    {
+        solver.Update(frame);
+    }
+
+    auto particles = solver.GetSecondaryParticles();
+    ASSERT_NE(nullptr, particles);
+    EXPECT_GT(particles->GetNumberOfParticles(), 0u);
+
+    auto positions = particles->GetPositions();
+    auto lifetimes = particles->ScalarDataAt(0);
+    for (size_t i = 0; i < particles->GetNumberOfParticles(); ++i)
+    {
+        EXPECT_TRUE(domain.Contains(positions[i]));
+        EXPECT_GT(lifetimes[i], 0.0);
+    }
+}
+
+TEST(LevelSetLiquidSolver3, SurfacePreview)
+{
+    LevelSetLiquidSolver3 solver;
+    solver.SetIsSurfacePreviewEnabled(true);
+    solver.SetGravity(Vector3D{});
+
+    auto data = solver.GetGridSystemData();
+    const double dx = 1.0 / 16.0;
+    data->Resize(Size3(16, 16, 16), Vector3D(dx, dx, dx), Vector3D());
+
+    // The droplet must stay resolvable on the quarter resolution (4 cells
+    // across) preview grid, so use a generous radius.
+    const double radius = 0.3;
+    BoundingBox3D domain = data->GetBoundingBox();
+    ImplicitSurfaceSet3 surfaceSet;
+    surfaceSet.AddExplicitSurface(
+        std::make_shared<Sphere3>(domain.MidPoint(), radius));
+
+    auto sdf = solver.GetSignedDistanceField();
+    sdf->Fill([&](const Vector3D& x) { return surfaceSet.SignedDistance(x); });
+
+    EXPECT_EQ(nullptr, solver.GetSurfacePreview());
+
+    Frame frame{ 0, 0.01 };
+    for (; frame.index < 2; ++frame)
+    {
+        solver.Update(frame);
+    }
+
+    // The extraction is asynchronous; wait for the worker by polling.
+    TriangleMesh3Ptr mesh;
+    for (int i = 0; i < 100 && mesh == nullptr; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        mesh = solver.GetSurfacePreview();
+    }
+
+    ASSERT_NE(nullptr, mesh);
+    ASSERT_GT(mesh->NumberOfTriangles(), 0u);
+
+    // Every preview vertex must lie near the droplet surface; the quarter
+    // resolution grid (4 cells across) bounds the discretization error by
+    // roughly one coarse cell.
+    const double coarseCell = 4.0 * dx;
+    for (size_t i = 0; i < mesh->NumberOfPoints(); ++i)
+    {
+        const double dist = (mesh->Point(i) - domain.MidPoint()).Length();
+        EXPECT_NEAR(radius, dist, coarseCell);
+    }
+}
+
 TEST(LevelSetLiquidSolver3, ComputeVolume)
 {
     LevelSetLiquidSolver3 solver;
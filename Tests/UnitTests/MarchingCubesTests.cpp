@@ -3,6 +3,7 @@
 
 #include <Core/Array/Array3.hpp>
 #include <Core/Geometry/MarchingCubes.hpp>
+#include <Core/Utils/Parallel.hpp>
 
 using namespace CubbyFlow;
 
@@ -58,4 +59,48 @@ TEST(MarchingCubes, Connectivity)
     MarchingCubes(grid, Vector3D(1, 1, 1), Vector3D(), &triMesh, 0,
                   DIRECTION_ALL, DIRECTION_ALL);
     EXPECT_EQ(8u, triMesh.NumberOfPoints());
-}
\ No newline at end of file
+}
+TEST(MarchingCubes, ParallelMatchesSerial)
+{
+    const size_t n = 16;
+    Array3<double> grid{ n, n, n };
+    const Vector3D center(7.5, 7.5, 7.5);
+
+    grid.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D pt(static_cast<double>(i), static_cast<double>(j),
+                          static_cast<double>(k));
+        grid(i, j, k) = pt.DistanceTo(center) - 4.0;
+    });
+
+    TriangleMesh3 serialMesh;
+    TriangleMesh3 parallelMesh;
+
+    const unsigned int numThreads = GetMaxNumberOfThreads();
+
+    SetMaxNumberOfThreads(1);
+    MarchingCubes(grid, Vector3D(1, 1, 1), Vector3D(), &serialMesh, 0,
+                  DIRECTION_ALL, DIRECTION_NONE);
+
+    SetMaxNumberOfThreads(numThreads > 1 ? numThreads : 4);
+    MarchingCubes(grid, Vector3D(1, 1, 1), Vector3D(), &parallelMesh, 0,
+                  DIRECTION_ALL, DIRECTION_NONE);
+
+    SetMaxNumberOfThreads(numThreads);
+
+    ASSERT_EQ(serialMesh.NumberOfPoints(), parallelMesh.NumberOfPoints());
+    ASSERT_EQ(serialMesh.NumberOfTriangles(),
+              parallelMesh.NumberOfTriangles());
+
+    for (size_t i = 0; i < serialMesh.NumberOfPoints(); ++i)
+    {
+        EXPECT_VECTOR3_EQ(serialMesh.Point(i), parallelMesh.Point(i));
+        EXPECT_VECTOR3_EQ(serialMesh.Normal(i), parallelMesh.Normal(i));
+    }
+
+    for (size_t t = 0; t < serialMesh.NumberOfTriangles(); ++t)
+    {
+        EXPECT_EQ(serialMesh.PointIndex(t), parallelMesh.PointIndex(t));
+        EXPECT_EQ(serialMesh.NormalIndex(t), parallelMesh.NormalIndex(t));
+        EXPECT_EQ(serialMesh.UVIndex(t), parallelMesh.UVIndex(t));
+    }
+}
@@ -0,0 +1,67 @@
+#include "pch.hpp"
+
+#include <Core/Array/Array3.hpp>
+#include <Core/Grid/MarkerBitset3.hpp>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+TEST(MarkerBitset3, BuildAndQuery)
+{
+    Array3<char> markers{ { 7, 5, 9 } };
+    std::mt19937 rng{ 42 };
+    std::uniform_int_distribution<int> dist{ 0, 2 };
+    markers.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        markers(i, j, k) = static_cast<char>(dist(rng));
+    });
+
+    MarkerBitset3 bits;
+    bits.Build(markers.ConstAccessor());
+
+    EXPECT_EQ(markers.size(), bits.size());
+
+    size_t numberOfFluidCells = 0;
+    markers.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(markers(i, j, k), bits(i, j, k));
+
+        if (markers(i, j, k) == 0)
+        {
+            ++numberOfFluidCells;
+        }
+    });
+
+    EXPECT_EQ(numberOfFluidCells, bits.CountFluidCells());
+}
+
+TEST(MarkerBitset3, AllAirWords)
+{
+    Array3<char> markers{ { 8, 8, 8 } };
+    markers.Set(1);
+
+    MarkerBitset3 bits;
+    bits.Build(markers.ConstAccessor());
+
+    for (size_t wordIdx = 0; wordIdx < bits.GetNumberOfWords(); ++wordIdx)
+    {
+        EXPECT_TRUE(bits.IsAllAirWord(wordIdx));
+    }
+    EXPECT_EQ(0u, bits.CountFluidCells());
+
+    // A single fluid cell must break exactly one word.
+    markers(3, 4, 5) = 0;
+    bits.Build(markers.ConstAccessor());
+
+    size_t numberOfMixedWords = 0;
+    for (size_t wordIdx = 0; wordIdx < bits.GetNumberOfWords(); ++wordIdx)
+    {
+        if (!bits.IsAllAirWord(wordIdx))
+        {
+            ++numberOfMixedWords;
+        }
+    }
+
+    EXPECT_EQ(1u, numberOfMixedWords);
+    EXPECT_EQ(1u, bits.CountFluidCells());
+    EXPECT_EQ(0, bits(3, 4, 5));
+}
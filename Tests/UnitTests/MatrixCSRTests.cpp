@@ -318,6 +318,27 @@ TEST(MatrixCSR, BinaryOperatorMethods)
     }
 }
 
+TEST(MatrixCSR, ParallelMul)
+{
+    // Rows with deliberately uneven non-zero counts
+    const MatrixCSRD matA = { { 1.0, 2.0, 3.0, 4.0 },
+                              { 0.0, 5.0, 0.0, 0.0 },
+                              { 0.0, 0.0, 0.0, 0.0 },
+                              { -1.0, 2.0, -3.0, 4.0 } };
+    const VectorND vecA = { 3.0, -1.0, 2.0, 5.0 };
+
+    VectorND result;
+    matA.ParallelMul(vecA, &result);
+
+    const VectorND expected = matA * vecA;
+
+    EXPECT_EQ(4u, result.size());
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(expected[i], result[i]);
+    }
+}
+
 TEST(MatrixCSR, AugmentedMethods)
 {
     const MatrixCSRD matA = { { 1.0, 2.0, 3.0 }, { 4.0, 5.0, 6.0 } };
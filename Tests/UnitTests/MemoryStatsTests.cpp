@@ -0,0 +1,68 @@
+#include "pch.hpp"
+
+#include <Core/FDM/FDMLinearSystem3.hpp>
+#include <Core/Particle/ParticleSystemData3.hpp>
+#include <Core/Searcher/PointParallelHashGridSearcher3.hpp>
+#include <Core/Utils/MemoryStats.hpp>
+
+using namespace CubbyFlow;
+
+TEST(MemoryStats, LinearSystemUsage)
+{
+    FDMLinearSystem3 sys;
+    sys.Resize(Size3{ 16, 16, 16 });
+
+    const size_t n = 16 * 16 * 16;
+    EXPECT_EQ(n * (sizeof(FDMMatrixRow3) + 2 * sizeof(double)),
+              sys.GetMemoryUsage());
+
+    std::vector<MemoryUsageRecord> records;
+    sys.ReportMemoryUsage(&records);
+    ASSERT_EQ(3u, records.size());
+    EXPECT_EQ("A", records[0].component);
+    EXPECT_EQ(n * sizeof(FDMMatrixRow3), records[0].bytes);
+}
+
+TEST(MemoryStats, ParticleSystemUsage)
+{
+    ParticleSystemData3 particles{ 1000 };
+
+    // Positions and velocities at minimum
+    EXPECT_GE(particles.GetMemoryUsage(), 2 * 1000 * sizeof(Vector3D));
+
+    particles.AddScalarData();
+    EXPECT_GE(particles.GetMemoryUsage(),
+              2 * 1000 * sizeof(Vector3D) + 1000 * sizeof(double));
+}
+
+TEST(MemoryStats, Registry)
+{
+    const size_t before = MemoryStats::GetTotalMemoryUsage();
+
+    {
+        FDMLinearSystem3 sys;
+        sys.Resize(Size3{ 8, 8, 8 });
+
+        EXPECT_EQ(before + sys.GetMemoryUsage(),
+                  MemoryStats::GetTotalMemoryUsage());
+
+        std::vector<MemoryUsageRecord> records;
+        MemoryStats::EnumerateMemoryUsage(&records);
+
+        size_t total = 0;
+        bool found = false;
+        for (const MemoryUsageRecord& record : records)
+        {
+            total += record.bytes;
+            if (record.component == "FDMLinearSystem3.A")
+            {
+                found = true;
+            }
+        }
+        EXPECT_TRUE(found);
+        EXPECT_EQ(MemoryStats::GetTotalMemoryUsage(), total);
+    }
+
+    // Destroyed instances must be unregistered
+    EXPECT_EQ(before, MemoryStats::GetTotalMemoryUsage());
+}
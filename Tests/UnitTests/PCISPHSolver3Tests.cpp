@@ -25,4 +25,7 @@ TEST(PCISPHSolver3, Parameters)
 
     solver.SetMaxNumberOfIterations(10);
     EXPECT_DOUBLE_EQ(10, solver.GetMaxNumberOfIterations());
+
+    EXPECT_EQ(0u, solver.GetLastNumberOfIterations());
+    EXPECT_DOUBLE_EQ(0.0, solver.GetLastMaxDensityErrorRatio());
 }
\ No newline at end of file
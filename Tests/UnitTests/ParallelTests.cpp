@@ -4,6 +4,9 @@
 #include <Core/Array/Array3.hpp>
 #include <Core/Utils/Parallel.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <numeric>
 #include <random>
 
@@ -59,6 +62,78 @@ TEST(Parallel, RangeFor)
     });
 }
 
+TEST(Parallel, RangeForWeighted)
+{
+    const size_t n = 256;
+
+    // Heavily skewed cost: nearly all work sits in the first quarter.
+    const auto cost = [](size_t i) { return (i < n / 4) ? 100.0 : 1.0; };
+
+    std::vector<std::atomic<int>> visited(n);
+    for (auto& v : visited)
+    {
+        v.store(0);
+    }
+
+    std::atomic<int> numChunks{ 0 };
+    std::atomic<size_t> maxExpensivePerChunk{ 0 };
+
+    ParallelRangeForWeighted(
+        ZERO_SIZE, n, cost, [&](size_t iBegin, size_t iEnd) {
+            ++numChunks;
+
+            size_t expensive = 0;
+            for (size_t i = iBegin; i < iEnd; ++i)
+            {
+                ++visited[i];
+
+                if (i < n / 4)
+                {
+                    ++expensive;
+                }
+            }
+
+            size_t prev = maxExpensivePerChunk.load();
+            while (prev < expensive &&
+                   !maxExpensivePerChunk.compare_exchange_weak(prev,
+                                                               expensive))
+            {
+                // Retry
+            }
+        });
+
+    // Every index is visited exactly once
+    for (size_t i = 0; i < n; ++i)
+    {
+        EXPECT_EQ(1, visited[i].load());
+    }
+
+    // With more than one worker, the expensive quarter must be split across
+    // chunks instead of landing in a single equal-width slice.
+    if (NUM_CORES > 1)
+    {
+        EXPECT_GT(numChunks.load(), 1);
+        EXPECT_LT(maxExpensivePerChunk.load(), n / 4);
+    }
+
+    // All-zero costs fall back to the even split and still cover the range
+    std::vector<int> covered(n, 0);
+    ParallelRangeForWeighted(
+        ZERO_SIZE, n, [](size_t) { return 0.0; },
+        [&](size_t iBegin, size_t iEnd) {
+            for (size_t i = iBegin; i < iEnd; ++i)
+            {
+                ++covered[i];
+            }
+        },
+        ExecutionPolicy::Serial);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        EXPECT_EQ(1, covered[i]);
+    }
+}
+
 TEST(Parallel, For2D)
 {
     size_t nX = std::max(20u, (3 * NUM_CORES) / 2);
@@ -171,6 +246,100 @@ TEST(Parallel, RangeFor3D)
         });
 }
 
+TEST(Parallel, TiledFor3D)
+{
+    // Sizes that do not divide the tile size, so partial tiles are covered
+    const size_t nX = 13;
+    const size_t nY = 21;
+    const size_t nZ = 10;
+    std::vector<std::atomic<int>> visits(nX * nY * nZ);
+
+    ParallelTiledFor(ZERO_SIZE, nX, ZERO_SIZE, nY, ZERO_SIZE, nZ,
+                     [&](size_t i, size_t j, size_t k) {
+                         visits[i + (j + k * nY) * nX].fetch_add(1);
+                     });
+
+    for (const auto& visit : visits)
+    {
+        EXPECT_EQ(1, visit.load());
+    }
+}
+
+TEST(Parallel, MortonFor3D)
+{
+    // Non-cubic, non-power-of-two sizes
+    const size_t nX = 33;
+    const size_t nY = 5;
+    const size_t nZ = 9;
+    std::vector<std::atomic<int>> visits(nX * nY * nZ);
+
+    ParallelMortonFor(ZERO_SIZE, nX, ZERO_SIZE, nY, ZERO_SIZE, nZ,
+                      [&](size_t i, size_t j, size_t k) {
+                          visits[i + (j + k * nY) * nX].fetch_add(1);
+                      });
+
+    for (const auto& visit : visits)
+    {
+        EXPECT_EQ(1, visit.load());
+    }
+}
+
+TEST(Parallel, StaticFor)
+{
+    size_t N = std::max(1000u, 100 * NUM_CORES);
+    std::vector<int> counts(N, 0);
+
+    ParallelFor(
+        ZERO_SIZE, N, [&counts](size_t i) { counts[i]++; },
+        ExecutionPolicy::ParallelStatic);
+
+    for (int count : counts)
+    {
+        EXPECT_EQ(1, count);
+    }
+
+    std::vector<double> a(N);
+    ParallelFill(a.begin(), a.end(), 3.0, ExecutionPolicy::ParallelStatic);
+
+    for (double val : a)
+    {
+        EXPECT_EQ(3.0, val);
+    }
+
+#if defined(CUBBYFLOW_TASKING_CPP11THREAD)
+    // The chunk-to-thread mapping is deterministic: repeating a loop over
+    // the same range must land every index on the same thread, both for the
+    // per-index and the range variants.
+    std::vector<std::thread::id> firstPass(N), secondPass(N), rangePass(N);
+
+    ParallelFor(
+        ZERO_SIZE, N,
+        [&firstPass](size_t i) { firstPass[i] = std::this_thread::get_id(); },
+        ExecutionPolicy::ParallelStatic);
+    ParallelFor(
+        ZERO_SIZE, N,
+        [&secondPass](size_t i) {
+            secondPass[i] = std::this_thread::get_id();
+        },
+        ExecutionPolicy::ParallelStatic);
+    ParallelRangeFor(
+        ZERO_SIZE, N,
+        [&rangePass](size_t iBegin, size_t iEnd) {
+            for (size_t i = iBegin; i < iEnd; ++i)
+            {
+                rangePass[i] = std::this_thread::get_id();
+            }
+        },
+        ExecutionPolicy::ParallelStatic);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        EXPECT_EQ(firstPass[i], secondPass[i]) << i;
+        EXPECT_EQ(firstPass[i], rangePass[i]) << i;
+    }
+#endif
+}
+
 TEST(Parallel, Sort)
 {
     size_t N = std::max(20u, (3 * NUM_CORES) / 2);
@@ -250,4 +419,331 @@ TEST(Parallel, Reduce)
 
     int expected = std::accumulate(a.begin(), a.end(), 0);
     EXPECT_EQ(expected, sum);
-}
\ No newline at end of file
+}
+TEST(Parallel, RadixSort)
+{
+    const size_t N = 4096;
+    std::vector<uint64_t> keys(N);
+    std::vector<size_t> values(N);
+
+    std::mt19937 rng{ 17 };
+    std::uniform_int_distribution<uint64_t> d(0, 1023);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        keys[i] = d(rng);
+        values[i] = i;
+    }
+
+    std::vector<uint64_t> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    ParallelRadixSort(keys.begin(), keys.end(), values.begin());
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        EXPECT_EQ(expected[i], keys[i]);
+
+        if (i > 0 && keys[i - 1] == keys[i])
+        {
+            // Stable: equal keys preserve the original value order
+            EXPECT_LT(values[i - 1], values[i]);
+        }
+    }
+}
+
+TEST(Parallel, DeterministicReduce)
+{
+    const size_t N = 100000;
+    std::vector<double> a(N);
+
+    std::mt19937 rng{ 7 };
+    std::uniform_real_distribution<double> d(-1.0, 1.0);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        a[i] = d(rng);
+    }
+
+    const auto sumRange = [&](size_t start, size_t end, double init) {
+        double result = init;
+
+        for (size_t i = start; i < end; ++i)
+        {
+            result += a[i];
+        }
+
+        return result;
+    };
+
+    const double first =
+        ParallelReduce(ZERO_SIZE, a.size(), 0.0, sumRange, std::plus<double>(),
+                       ExecutionPolicy::ParallelDeterministic);
+
+    // Bit-stable: repeated runs must return the exact same value
+    for (int run = 0; run < 8; ++run)
+    {
+        const double again = ParallelReduce(
+            ZERO_SIZE, a.size(), 0.0, sumRange, std::plus<double>(),
+            ExecutionPolicy::ParallelDeterministic);
+        EXPECT_EQ(first, again);
+    }
+
+    // ... and agree with the serial sum up to rounding
+    const double serial = std::accumulate(a.begin(), a.end(), 0.0);
+    EXPECT_NEAR(serial, first, 1e-9);
+}
+
+TEST(Parallel, ForWithWorkerIndex)
+{
+    size_t N = std::max(1000u, 100 * NUM_CORES);
+    std::vector<int> counts(N, 0);
+
+    PerWorkerScratch<size_t> scratch(0);
+    EXPECT_EQ(GetMaxNumberOfWorkerSlots(), scratch.size());
+
+    ParallelForWithWorkerIndex(ZERO_SIZE, N, [&](size_t worker, size_t i) {
+        ASSERT_LT(worker, scratch.size());
+        ++scratch.At(worker);
+        counts[i]++;
+    });
+
+    for (int count : counts)
+    {
+        EXPECT_EQ(1, count);
+    }
+
+    size_t total = 0;
+    scratch.ForEach([&total](size_t& value) { total += value; });
+    EXPECT_EQ(N, total);
+
+    // Dynamic grain-size chunking keeps one slot per task across every chunk
+    // it claims.
+    scratch.Reset(0);
+    std::fill(counts.begin(), counts.end(), 0);
+    SetParallelForGrainSize(64);
+
+    ParallelForWithWorkerIndex(ZERO_SIZE, N, [&](size_t worker, size_t i) {
+        ASSERT_LT(worker, scratch.size());
+        ++scratch.At(worker);
+        counts[i]++;
+    });
+
+    SetParallelForGrainSize(0);
+
+    for (int count : counts)
+    {
+        EXPECT_EQ(1, count);
+    }
+
+    total = 0;
+    scratch.ForEach([&total](size_t& value) { total += value; });
+    EXPECT_EQ(N, total);
+
+    // The serial policy reports slot 0 for every index.
+    ParallelForWithWorkerIndex(
+        ZERO_SIZE, N, [](size_t worker, size_t) { EXPECT_EQ(0u, worker); },
+        ExecutionPolicy::Serial);
+}
+
+TEST(Parallel, SortByKey)
+{
+    struct HeavyElement
+    {
+        uint32_t key = 0;
+        size_t originalIndex = 0;
+        std::array<double, 16> payload{};
+    };
+
+    size_t N = size_t(1) << 14;
+    std::mt19937 rng(49);
+    std::uniform_int_distribution<uint32_t> d(0, 255);
+
+    std::vector<HeavyElement> a(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        a[i].key = d(rng);
+        a[i].originalIndex = i;
+        a[i].payload.fill(static_cast<double>(i));
+    }
+
+    std::vector<HeavyElement> expected = a;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const HeavyElement& x, const HeavyElement& y) {
+                         return x.key < y.key;
+                     });
+
+    ParallelSortByKey(a.begin(), a.end(),
+                      [](const HeavyElement& e) { return e.key; });
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        // Stability: equal keys keep their original order, and the payload
+        // travels with its element.
+        ASSERT_EQ(expected[i].key, a[i].key);
+        ASSERT_EQ(expected[i].originalIndex, a[i].originalIndex);
+        ASSERT_EQ(static_cast<double>(a[i].originalIndex), a[i].payload[7]);
+    }
+}
+
+TEST(Parallel, DeterministicExecutionSwitch)
+{
+    EXPECT_FALSE(GetDeterministicExecution());
+    SetDeterministicExecution(true);
+
+    // Reductions follow the fixed-tree path, so the sum is bit-identical
+    // across reruns even with the default Parallel policy.
+    size_t N = 1 << 16;
+    std::mt19937 rng(24);
+    std::uniform_real_distribution<double> d(0.0, 1.0);
+
+    std::vector<double> values(N);
+    for (double& v : values)
+    {
+        v = d(rng);
+    }
+
+    auto sum = [&](unsigned int numThreads) {
+        const unsigned int oldNumThreads = GetMaxNumberOfThreads();
+        SetMaxNumberOfThreads(numThreads);
+        const double result = ParallelReduce(
+            ZERO_SIZE, N, 0.0,
+            [&values](size_t start, size_t end, double init) {
+                for (size_t i = start; i < end; ++i)
+                {
+                    init += values[i];
+                }
+                return init;
+            },
+            std::plus<double>());
+        SetMaxNumberOfThreads(oldNumThreads);
+        return result;
+    };
+
+    EXPECT_EQ(sum(1), sum(4));
+
+    // Sorts are stable, so equal keys keep their original order no matter
+    // how the range was split across threads.
+    struct Tagged
+    {
+        int key;
+        size_t tag;
+    };
+
+    std::vector<Tagged> items(N);
+    std::uniform_int_distribution<int> keys(0, 15);
+    for (size_t i = 0; i < N; ++i)
+    {
+        items[i] = Tagged{ keys(rng), i };
+    }
+
+    std::vector<Tagged> expected = items;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const Tagged& x, const Tagged& y) {
+                         return x.key < y.key;
+                     });
+
+    ParallelSort(items.begin(), items.end(),
+                 [](const Tagged& x, const Tagged& y) {
+                     return x.key < y.key;
+                 });
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        ASSERT_EQ(expected[i].key, items[i].key);
+        ASSERT_EQ(expected[i].tag, items[i].tag);
+    }
+
+    SetDeterministicExecution(false);
+}
+
+TEST(Parallel, RangeFor3DBlockSplitting)
+{
+    // Thin-slab domain: the z extent alone cannot feed the workers, so the
+    // 3D range loop must also split y while keeping the full x extent.
+    const size_t nX = 32;
+    const size_t nY = 32;
+    const size_t nZ = 2;
+
+    Array3<int> visited(nX, nY, nZ, 0);
+    std::atomic<int> numBlocks{ 0 };
+
+    ParallelRangeFor(
+        ZERO_SIZE, nX, ZERO_SIZE, nY, ZERO_SIZE, nZ,
+        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
+            size_t kBegin, size_t kEnd) {
+            EXPECT_EQ(ZERO_SIZE, iBegin);
+            EXPECT_EQ(nX, iEnd);
+
+            ++numBlocks;
+
+            for (size_t k = kBegin; k < kEnd; ++k)
+            {
+                for (size_t j = jBegin; j < jEnd; ++j)
+                {
+                    for (size_t i = iBegin; i < iEnd; ++i)
+                    {
+                        ++visited(i, j, k);
+                    }
+                }
+            }
+        });
+
+    EXPECT_GT(numBlocks, static_cast<int>(nZ));
+
+    visited.ForEachIndex(
+        [&](size_t i, size_t j, size_t k) { EXPECT_EQ(1, visited(i, j, k)); });
+
+    // The per-index 3D loop rides on the same decomposition and must still
+    // visit every index exactly once.
+    Array3<int> counts(nX, nY, nZ, 0);
+
+    ParallelFor(ZERO_SIZE, nX, ZERO_SIZE, nY, ZERO_SIZE, nZ,
+                [&](size_t i, size_t j, size_t k) { ++counts(i, j, k); });
+
+    counts.ForEachIndex(
+        [&](size_t i, size_t j, size_t k) { EXPECT_EQ(1, counts(i, j, k)); });
+}
+
+TEST(Parallel, ScopedThreadBudget)
+{
+    const unsigned int globalMax = GetMaxNumberOfThreads();
+    EXPECT_EQ(0u, GetCurrentThreadBudget());
+
+    {
+        const ScopedThreadBudget budget{ 2 };
+        EXPECT_EQ(2u, GetCurrentThreadBudget());
+        EXPECT_EQ(std::min(globalMax, 2u), GetMaxNumberOfThreads());
+
+        // Nested scopes tighten but never widen the budget.
+        {
+            const ScopedThreadBudget inner{ 4 };
+            EXPECT_EQ(2u, GetCurrentThreadBudget());
+        }
+        {
+            const ScopedThreadBudget inner{ 1 };
+            EXPECT_EQ(1u, GetCurrentThreadBudget());
+            EXPECT_EQ(1u, GetMaxNumberOfThreads());
+        }
+        EXPECT_EQ(2u, GetCurrentThreadBudget());
+
+        // Zero adds no cap.
+        {
+            const ScopedThreadBudget inner{ 0 };
+            EXPECT_EQ(2u, GetCurrentThreadBudget());
+        }
+
+        // The budget caps loops launched from this thread, not the workers
+        // they run on.
+        std::vector<int> result(100, 0);
+        ParallelFor(ZERO_SIZE, result.size(),
+                    [&result](size_t i) { result[i] = 1; });
+        for (const int value : result)
+        {
+            EXPECT_EQ(1, value);
+        }
+    }
+
+    EXPECT_EQ(0u, GetCurrentThreadBudget());
+    EXPECT_EQ(globalMax, GetMaxNumberOfThreads());
+}
@@ -0,0 +1,75 @@
+#include "UnitTestsUtils.hpp"
+#include "pch.hpp"
+
+#include <Core/Particle/ParticleCache3.hpp>
+
+#include <cstdio>
+
+using namespace CubbyFlow;
+
+TEST(ParticleCache3, WriteAndRead)
+{
+    const size_t n = 5000;
+    const std::string fileName = "particle_cache3_test.pcache";
+
+    ParticleSystemData3 data{ n };
+    const size_t tempIdx = data.AddScalarData();
+
+    auto pos = data.GetPositions();
+    auto temp = data.ScalarDataAt(tempIdx);
+    for (size_t i = 0; i < n; ++i)
+    {
+        pos[i] = Vector3D(i * 0.001, i * 0.002, i * 0.003);
+        temp[i] = 300.0 + 0.01 * static_cast<double>(i);
+    }
+
+    // Use a small chunk size so each layer spans several chunks.
+    ASSERT_TRUE(ParticleCache3::Write(fileName, data, 1024));
+
+    ParticleCache3::Reader reader;
+    ASSERT_TRUE(reader.Open(fileName));
+
+    EXPECT_EQ(n, reader.GetNumberOfParticles());
+    EXPECT_EQ(data.GetNumberOfScalarDataLayers(),
+              reader.GetNumberOfScalarLayers());
+    EXPECT_EQ(data.GetNumberOfVectorDataLayers(),
+              reader.GetNumberOfVectorLayers());
+    EXPECT_EQ(data.GetPositionIndex(), reader.GetPositionLayerIndex());
+
+    Array1<Vector3D> positions;
+    ASSERT_TRUE(
+        reader.ReadVectorLayer(reader.GetPositionLayerIndex(), &positions));
+
+    Array1<double> temps;
+    ASSERT_TRUE(reader.ReadScalarLayer(tempIdx, &temps));
+
+    ASSERT_EQ(n, positions.size());
+    ASSERT_EQ(n, temps.size());
+    for (size_t i = 0; i < n; ++i)
+    {
+        EXPECT_VECTOR3_EQ(pos[i], positions[i]);
+        EXPECT_DOUBLE_EQ(temp[i], temps[i]);
+    }
+
+    // Requesting a layer past the end must fail without touching the output.
+    Array1<double> dummy;
+    EXPECT_FALSE(
+        reader.ReadScalarLayer(reader.GetNumberOfScalarLayers(), &dummy));
+
+    std::remove(fileName.c_str());
+}
+
+TEST(ParticleCache3, RejectsInvalidFile)
+{
+    const std::string fileName = "particle_cache3_invalid.pcache";
+
+    {
+        std::ofstream bad{ fileName.c_str(), std::ofstream::binary };
+        bad << "not a particle cache";
+    }
+
+    ParticleCache3::Reader reader;
+    EXPECT_FALSE(reader.Open(fileName));
+
+    std::remove(fileName.c_str());
+}
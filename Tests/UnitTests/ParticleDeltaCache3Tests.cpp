@@ -0,0 +1,102 @@
+#include "UnitTestsUtils.hpp"
+#include "pch.hpp"
+
+#include <Core/Particle/ParticleDeltaCache3.hpp>
+
+#include <random>
+
+using namespace CubbyFlow;
+
+TEST(ParticleDeltaCache3, RoundTrip)
+{
+    const size_t n = 1000;
+    const double dt = 1.0 / 60.0;
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    ParticleSystemData3 data{ n };
+    const size_t densityIdx = data.AddScalarData();
+
+    auto pos = data.GetPositions();
+    auto vel = data.GetVelocities();
+    auto den = data.ScalarDataAt(densityIdx);
+    for (size_t i = 0; i < n; ++i)
+    {
+        pos[i] = Vector3D{ dist(rng), dist(rng), dist(rng) };
+        vel[i] = 0.1 * Vector3D{ dist(rng), dist(rng), dist(rng) };
+        den[i] = 1000.0 + dist(rng);
+    }
+
+    ParticleDeltaCache3::Encoder encoder{ 4 };
+    ParticleDeltaCache3::Decoder decoder;
+
+    std::vector<uint8_t> buffer;
+    for (size_t frame = 0; frame < 10; ++frame)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            pos[i] += vel[i] * dt;
+            vel[i] += 1e-4 * Vector3D{ dist(rng), dist(rng), dist(rng) };
+        }
+
+        encoder.EncodeFrame(data, dt, &buffer);
+
+        ParticleSystemData3 restored;
+        ASSERT_TRUE(decoder.DecodeFrame(buffer, &restored));
+
+        ASSERT_EQ(n, restored.GetNumberOfParticles());
+        auto rpos = restored.GetPositions();
+        auto rvel = restored.GetVelocities();
+        auto rden = restored.ScalarDataAt(densityIdx);
+        for (size_t i = 0; i < n; ++i)
+        {
+            EXPECT_VECTOR3_EQ(pos[i], rpos[i]);
+            EXPECT_VECTOR3_EQ(vel[i], rvel[i]);
+            EXPECT_DOUBLE_EQ(den[i], rden[i]);
+        }
+    }
+}
+
+TEST(ParticleDeltaCache3, LayoutChangeForcesKeyframe)
+{
+    ParticleSystemData3 data{ 100 };
+
+    ParticleDeltaCache3::Encoder encoder{ 100 };
+    ParticleDeltaCache3::Decoder decoder;
+
+    std::vector<uint8_t> buffer;
+    ParticleSystemData3 restored;
+
+    encoder.EncodeFrame(data, 0.01, &buffer);
+    EXPECT_EQ(0, buffer[0]);
+    ASSERT_TRUE(decoder.DecodeFrame(buffer, &restored));
+
+    encoder.EncodeFrame(data, 0.01, &buffer);
+    EXPECT_EQ(1, buffer[0]);
+    ASSERT_TRUE(decoder.DecodeFrame(buffer, &restored));
+
+    // Adding a layer must interrupt the delta chain
+    data.AddVectorData();
+    encoder.EncodeFrame(data, 0.01, &buffer);
+    EXPECT_EQ(0, buffer[0]);
+    ASSERT_TRUE(decoder.DecodeFrame(buffer, &restored));
+    EXPECT_EQ(data.GetNumberOfVectorDataLayers(),
+              restored.GetNumberOfVectorDataLayers());
+}
+
+TEST(ParticleDeltaCache3, DeltaWithoutKeyframeFails)
+{
+    ParticleSystemData3 data{ 10 };
+
+    ParticleDeltaCache3::Encoder encoder{ 100 };
+
+    std::vector<uint8_t> buffer;
+    encoder.EncodeFrame(data, 0.01, &buffer);
+    encoder.EncodeFrame(data, 0.01, &buffer);
+    ASSERT_EQ(1, buffer[0]);
+
+    ParticleDeltaCache3::Decoder decoder;
+    ParticleSystemData3 restored;
+    EXPECT_FALSE(decoder.DecodeFrame(buffer, &restored));
+}
@@ -0,0 +1,52 @@
+#include "pch.hpp"
+
+#include <Core/Animation/Frame.hpp>
+#include <Core/Emitter/ParticleEmitterSet3.hpp>
+#include <Core/Emitter/PointParticleEmitter3.hpp>
+
+using namespace CubbyFlow;
+
+TEST(ParticleEmitterSet3, ActiveRegionCullingAndExpiry)
+{
+    auto particles = std::make_shared<ParticleSystemData3>();
+
+    // One emitter inside the initial active region and one far outside it.
+    // Rate of two particles per second, four particles total each.
+    auto nearEmitter = std::make_shared<PointParticleEmitter3>(
+        Vector3D(0.5, 0.5, 0.5), Vector3D(0.0, 1.0, 0.0), 1.0, 0.0, 2, 4);
+    auto farEmitter = std::make_shared<PointParticleEmitter3>(
+        Vector3D(100.0, 100.0, 100.0), Vector3D(0.0, 1.0, 0.0), 1.0, 0.0, 2,
+        4);
+
+    ParticleEmitterSet3 set({ nearEmitter, farEmitter });
+    set.SetTarget(particles);
+    set.SetActiveRegion(BoundingBox3D({ 0, 0, 0 }, { 1, 1, 1 }));
+
+    Frame frame(0, 1.0);
+    set.Update(frame.TimeInSeconds(), frame.timeIntervalInSeconds);
+
+    // Only the overlapping emitter emitted; the other one sleeps.
+    EXPECT_EQ(EmitterState::Active, nearEmitter->GetState());
+    EXPECT_EQ(EmitterState::Sleeping, farEmitter->GetState());
+    EXPECT_EQ(2u, particles->GetNumberOfParticles());
+
+    // Growing the region wakes the far emitter; the near one drains the
+    // rest of its budget and expires.
+    set.SetActiveRegion(BoundingBox3D({ 0, 0, 0 }, { 200, 200, 200 }));
+    frame.Advance();
+    set.Update(frame.TimeInSeconds(), frame.timeIntervalInSeconds);
+
+    EXPECT_EQ(EmitterState::Expired, nearEmitter->GetState());
+    EXPECT_EQ(EmitterState::Active, farEmitter->GetState());
+    EXPECT_EQ(6u, particles->GetNumberOfParticles());
+
+    frame.Advance();
+    set.Update(frame.TimeInSeconds(), frame.timeIntervalInSeconds);
+    EXPECT_EQ(EmitterState::Expired, farEmitter->GetState());
+    EXPECT_EQ(8u, particles->GetNumberOfParticles());
+
+    // With every member expired, further updates are no-ops.
+    frame.Advance();
+    set.Update(frame.TimeInSeconds(), frame.timeIntervalInSeconds);
+    EXPECT_EQ(8u, particles->GetNumberOfParticles());
+}
@@ -1,6 +1,8 @@
 #include "pch.hpp"
 
 #include <Core/Particle/ParticleSystemData3.hpp>
+#include <Core/Utils/Constants.hpp>
+#include <Core/Utils/Parallel.hpp>
 
 using namespace CubbyFlow;
 
@@ -97,6 +99,40 @@ TEST(ParticleSystemData3, AddVectorData)
     }
 }
 
+TEST(ParticleSystemData3, AddSoAVectorData)
+{
+    ParticleSystemData3 particleSystem;
+    particleSystem.Resize(12);
+
+    size_t a0 = particleSystem.AddSoAVectorData(Vector3D(2.0, 4.0, -1.0));
+
+    EXPECT_EQ(12u, particleSystem.GetNumberOfParticles());
+    EXPECT_EQ(0u, a0);
+
+    auto as0 = particleSystem.SoAVectorDataAt(a0);
+    for (size_t i = 0; i < 12; ++i)
+    {
+        EXPECT_EQ(Vector3D(2.0, 4.0, -1.0), as0.At(i));
+        EXPECT_DOUBLE_EQ(2.0, as0.x[i]);
+        EXPECT_DOUBLE_EQ(4.0, as0.y[i]);
+        EXPECT_DOUBLE_EQ(-1.0, as0.z[i]);
+    }
+
+    as0.Set(3, Vector3D(7.0, 8.0, 9.0));
+    EXPECT_EQ(Vector3D(7.0, 8.0, 9.0), as0.At(3));
+
+    size_t v0 = particleSystem.AddVectorData(Vector3D(9.0, -2.0, 5.0));
+    particleSystem.CopyVectorDataToSoA(v0, a0);
+    for (size_t i = 0; i < 12; ++i)
+    {
+        EXPECT_EQ(Vector3D(9.0, -2.0, 5.0), as0.At(i));
+    }
+
+    as0.Set(5, Vector3D(1.0, 2.0, 3.0));
+    particleSystem.CopyVectorDataFromSoA(v0, a0);
+    EXPECT_EQ(Vector3D(1.0, 2.0, 3.0), particleSystem.VectorDataAt(v0)[5]);
+}
+
 TEST(ParticleSystemData3, AddParticles)
 {
     ParticleSystemData3 particleSystem;
@@ -147,6 +183,40 @@ TEST(ParticleSystemData3, AddParticlesException)
     EXPECT_EQ(12u, particleSystem.GetNumberOfParticles());
 }
 
+TEST(ParticleSystemData3, ConcurrentAppend)
+{
+    ParticleSystemData3 particleSystem;
+    particleSystem.Resize(4);
+
+    particleSystem.BeginConcurrentAppend();
+    EXPECT_TRUE(particleSystem.IsConcurrentAppendActive());
+
+    ParallelFor(ZERO_SIZE, static_cast<size_t>(16), [&](size_t i) {
+        const auto v = static_cast<double>(i);
+        particleSystem.AddParticle(Vector3D(v, v, v), Vector3D(1.0, 0.0, 0.0));
+    });
+
+    // Staged appends must not resize the layers until the merge.
+    EXPECT_EQ(4u, particleSystem.GetNumberOfParticles());
+
+    particleSystem.EndConcurrentAppend();
+    EXPECT_FALSE(particleSystem.IsConcurrentAppendActive());
+    EXPECT_EQ(20u, particleSystem.GetNumberOfParticles());
+
+    // Every staged particle must land exactly once, in some order.
+    auto p = particleSystem.GetPositions();
+    auto v = particleSystem.GetVelocities();
+    std::vector<bool> found(16, false);
+    for (size_t i = 4; i < 20; ++i)
+    {
+        const auto idx = static_cast<size_t>(p[i].x);
+        ASSERT_LT(idx, found.size());
+        EXPECT_FALSE(found[idx]);
+        found[idx] = true;
+        EXPECT_EQ(Vector3D(1.0, 0.0, 0.0), v[i]);
+    }
+}
+
 TEST(ParticleSystemData3, BuildNeighborSearcher)
 {
     ParticleSystemData3 particleSystem;
@@ -181,6 +251,37 @@ TEST(ParticleSystemData3, BuildNeighborSearcher)
     }
 }
 
+TEST(ParticleSystemData3, BuildNeighborSearcherReusesInstance)
+{
+    ParticleSystemData3 particleSystem;
+    ParticleSystemData3::VectorData positions = {
+        { 0.1, 0.0, 0.4 }, { 0.6, 0.2, 0.6 }, { 1.0, 0.3, 0.4 },
+        { 0.9, 0.2, 0.2 }, { 0.8, 0.4, 0.9 }, { 0.1, 0.6, 0.2 }
+    };
+    particleSystem.AddParticles(positions);
+
+    particleSystem.BuildNeighborSearcher(0.4);
+    const auto searcher = particleSystem.GetNeighborSearcher();
+
+    // Rebuilding, even at a different search radius, must pool the searcher
+    // instance instead of allocating a new one.
+    particleSystem.BuildNeighborSearcher(0.2);
+    EXPECT_EQ(searcher, particleSystem.GetNeighborSearcher());
+
+    const double radius = 0.2;
+    const Vector3D searchOrigin = { 0.1, 0.2, 0.3 };
+    std::vector<size_t> found;
+    particleSystem.GetNeighborSearcher()->ForEachNearbyPoint(
+        searchOrigin, radius,
+        [&](size_t i, const Vector3D&) { found.push_back(i); });
+
+    for (size_t ii = 0; ii < positions.size(); ++ii)
+    {
+        EXPECT_EQ(searchOrigin.DistanceTo(positions[ii]) <= radius,
+                  found.end() != std::find(found.begin(), found.end(), ii));
+    }
+}
+
 TEST(ParticleSystemData3, BuildNeighborLists)
 {
     ParticleSystemData3 particleSystem;
@@ -217,6 +318,82 @@ TEST(ParticleSystemData3, BuildNeighborLists)
     }
 }
 
+TEST(ParticleSystemData3, BuildCompactNeighborLists)
+{
+    ParticleSystemData3 particleSystem;
+    ParticleSystemData3::VectorData positions = {
+        { 0.7, 0.2, 0.2 }, { 0.7, 0.8, 1.0 }, { 0.9, 0.4, 0.0 },
+        { 0.5, 0.1, 0.6 }, { 0.6, 0.3, 0.8 }, { 0.1, 0.6, 0.0 },
+        { 0.5, 1.0, 0.2 }, { 0.6, 0.7, 0.8 }, { 0.2, 0.4, 0.7 },
+        { 0.8, 0.5, 0.8 }, { 0.0, 0.8, 0.4 }, { 0.3, 0.0, 0.6 },
+        { 0.7, 0.8, 0.3 }, { 0.0, 0.7, 0.1 }, { 0.6, 0.3, 0.8 },
+        { 0.3, 0.2, 1.0 }, { 0.3, 0.5, 0.6 }, { 0.3, 0.9, 0.6 },
+        { 0.9, 1.0, 1.0 }, { 0.0, 0.1, 0.6 }
+    };
+    particleSystem.AddParticles(positions);
+
+    const double radius = 0.4;
+    particleSystem.BuildNeighborSearcher(radius);
+    particleSystem.BuildNeighborLists(radius);
+
+    const auto& compactLists = particleSystem.GetCompactNeighborLists();
+    const auto& neighborLists = particleSystem.GetNeighborLists();
+
+    ASSERT_EQ(positions.size() + 1, compactLists.offsets.size());
+
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        const auto& neighbors = neighborLists[i];
+        EXPECT_EQ(neighbors.size(), compactLists.NumberOfNeighbors(i));
+
+        size_t jj = 0;
+        compactLists.ForEachNeighbor(i, [&](size_t j) {
+            ASSERT_LT(jj, neighbors.size());
+            EXPECT_EQ(neighbors[jj], j);
+            ++jj;
+        });
+        EXPECT_EQ(neighbors.size(), jj);
+    }
+}
+
+TEST(ParticleSystemData3, ReorderParticles)
+{
+    ParticleSystemData3 particleSystem;
+    ParticleSystemData3::VectorData positions = {
+        { 0.7, 0.2, 0.2 }, { 0.7, 0.8, 1.0 }, { 0.9, 0.4, 0.0 },
+        { 0.5, 0.1, 0.6 }, { 0.6, 0.3, 0.8 }, { 0.1, 0.6, 0.0 },
+        { 0.5, 1.0, 0.2 }, { 0.6, 0.7, 0.8 }, { 0.2, 0.4, 0.7 },
+        { 0.8, 0.5, 0.8 }, { 0.0, 0.8, 0.4 }, { 0.3, 0.0, 0.6 }
+    };
+    ParticleSystemData3::VectorData velocities;
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        velocities.Append({ static_cast<double>(i), 0.0, 0.0 });
+    }
+    particleSystem.AddParticles(positions.ConstAccessor(),
+                                velocities.ConstAccessor());
+
+    const double radius = 0.4;
+    particleSystem.BuildNeighborSearcher(radius);
+    particleSystem.ReorderParticles();
+
+    const auto& oldToNew = particleSystem.GetParticleReorderMap();
+    ASSERT_EQ(positions.size(), oldToNew.size());
+
+    std::vector<bool> seen(positions.size(), false);
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        const size_t newIdx = oldToNew[i];
+        ASSERT_LT(newIdx, positions.size());
+        EXPECT_FALSE(seen[newIdx]);
+        seen[newIdx] = true;
+
+        // Attribute channels must move together
+        EXPECT_EQ(positions[i], particleSystem.GetPositions()[newIdx]);
+        EXPECT_EQ(velocities[i], particleSystem.GetVelocities()[newIdx]);
+    }
+}
+
 TEST(ParticleSystemData3, Serialization)
 {
     ParticleSystemData3 particleSystem;
@@ -281,4 +458,228 @@ TEST(ParticleSystemData3, Serialization)
             EXPECT_EQ(neighbors[j], neighbors2[j]);
         }
     }
-}
\ No newline at end of file
+
+    // Deserializing the same layout again must reuse the existing attribute
+    // storage rather than reallocating.
+    const auto* positionsPtr = particleSystem2.GetPositions().data();
+    particleSystem2.Deserialize(buffer);
+    EXPECT_EQ(positionsPtr, particleSystem2.GetPositions().data());
+    EXPECT_EQ(positions.size(), particleSystem2.GetNumberOfParticles());
+}
+TEST(ParticleSystemData3, AddTypedData)
+{
+    ParticleSystemData3 particleSystem{ 4 };
+
+    const size_t age =
+        particleSystem.AddTypedData(ParticleSystemData3::TypedDataType::Float32);
+    const size_t flags =
+        particleSystem.AddTypedData(ParticleSystemData3::TypedDataType::UInt16);
+    const size_t normals = particleSystem.AddTypedData(
+        ParticleSystemData3::TypedDataType::PackedNormal);
+
+    EXPECT_EQ(3u, particleSystem.GetNumberOfTypedDataLayers());
+    EXPECT_EQ(ParticleSystemData3::TypedDataType::Float32,
+              particleSystem.GetTypedDataTypeAt(age));
+    EXPECT_EQ(ParticleSystemData3::TypedDataType::UInt16,
+              particleSystem.GetTypedDataTypeAt(flags));
+    EXPECT_EQ(ParticleSystemData3::TypedDataType::PackedNormal,
+              particleSystem.GetTypedDataTypeAt(normals));
+    EXPECT_EQ(4u, ParticleSystemData3::GetTypedDataElementSize(
+                      ParticleSystemData3::TypedDataType::Float32));
+    EXPECT_EQ(2u, ParticleSystemData3::GetTypedDataElementSize(
+                      ParticleSystemData3::TypedDataType::UInt16));
+    EXPECT_EQ(4u, ParticleSystemData3::GetTypedDataElementSize(
+                      ParticleSystemData3::TypedDataType::PackedNormal));
+
+    auto ages = particleSystem.TypedDataAt<float>(age);
+    auto flagValues = particleSystem.TypedDataAt<uint16_t>(flags);
+    EXPECT_EQ(4u, ages.size());
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(0.0f, ages[i]);
+        EXPECT_EQ(0u, flagValues[i]);
+
+        ages[i] = 0.5f * static_cast<float>(i);
+        flagValues[i] = static_cast<uint16_t>(10 * i);
+    }
+
+    // New particles get zero-initialized typed elements.
+    particleSystem.AddParticle(Vector3D{ 1.0, 2.0, 3.0 });
+    ages = particleSystem.TypedDataAt<float>(age);
+    flagValues = particleSystem.TypedDataAt<uint16_t>(flags);
+
+    EXPECT_EQ(5u, ages.size());
+    EXPECT_EQ(0.0f, ages[4]);
+    EXPECT_EQ(0u, flagValues[4]);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(0.5f * static_cast<float>(i), ages[i]);
+        EXPECT_EQ(static_cast<uint16_t>(10 * i), flagValues[i]);
+    }
+
+    // Typed channels survive copies.
+    const ParticleSystemData3 copied{ particleSystem };
+    EXPECT_EQ(3u, copied.GetNumberOfTypedDataLayers());
+    EXPECT_EQ(1.5f, copied.TypedDataAt<float>(age)[3]);
+}
+
+TEST(ParticleSystemData3, PackedNormals)
+{
+    const Vector3D samples[] = { { 0.0, 0.0, 1.0 },
+                                 { 0.0, 0.0, -1.0 },
+                                 { 1.0, 0.0, 0.0 },
+                                 Vector3D{ 1.0, 2.0, 3.0 }.Normalized(),
+                                 Vector3D{ -0.3, 0.7, -0.5 }.Normalized() };
+
+    for (const Vector3D& normal : samples)
+    {
+        const uint32_t packed = ParticleSystemData3::PackNormal(normal);
+        const Vector3D unpacked = ParticleSystemData3::UnpackNormal(packed);
+
+        EXPECT_NEAR(1.0, unpacked.Length(), 1e-12);
+        EXPECT_NEAR(1.0, normal.Dot(unpacked), 1e-4);
+    }
+
+    // A zero vector packs as +z instead of producing NaNs.
+    const Vector3D fallback = ParticleSystemData3::UnpackNormal(
+        ParticleSystemData3::PackNormal(Vector3D{}));
+    EXPECT_NEAR(1.0, fallback.z, 1e-4);
+}
+
+TEST(ParticleSystemData3, TypedDataSerialization)
+{
+    ParticleSystemData3 particleSystem{ 3 };
+    const size_t scalarIdx = particleSystem.AddScalarData(7.0);
+    const size_t age =
+        particleSystem.AddTypedData(ParticleSystemData3::TypedDataType::Float32);
+
+    auto ages = particleSystem.TypedDataAt<float>(age);
+    ages[0] = 0.25f;
+    ages[1] = 0.5f;
+    ages[2] = 0.75f;
+
+    std::vector<uint8_t> buffer;
+    particleSystem.Serialize(&buffer);
+
+    ParticleSystemData3 loaded;
+    loaded.Deserialize(buffer);
+
+    // Typed channels widen to f64 scalar layers trailing the regular ones;
+    // the typed registry itself is not serialized.
+    EXPECT_EQ(3u, loaded.GetNumberOfParticles());
+    EXPECT_EQ(0u, loaded.GetNumberOfTypedDataLayers());
+    ASSERT_EQ(particleSystem.GetNumberOfScalarDataLayers() + 1,
+              loaded.GetNumberOfScalarDataLayers());
+
+    const auto widened =
+        loaded.ScalarDataAt(loaded.GetNumberOfScalarDataLayers() - 1);
+    EXPECT_DOUBLE_EQ(0.25, widened[0]);
+    EXPECT_DOUBLE_EQ(0.5, widened[1]);
+    EXPECT_DOUBLE_EQ(0.75, widened[2]);
+    EXPECT_DOUBLE_EQ(7.0, loaded.ScalarDataAt(scalarIdx)[0]);
+}
+
+TEST(ParticleSystemData3, ComputeParticleCountHistogram)
+{
+    ParticleSystemData3 particleSystem;
+
+    // Three particles in cell (0, 0, 0), one in cell (3, 2, 1), and one
+    // outside the domain that must clamp into the border cell.
+    particleSystem.AddParticle({ 0.1, 0.1, 0.1 });
+    particleSystem.AddParticle({ 0.4, 0.2, 0.3 });
+    particleSystem.AddParticle({ 0.9, 0.9, 0.9 });
+    particleSystem.AddParticle({ 3.5, 2.5, 1.5 });
+    particleSystem.AddParticle({ -1.0, 10.0, 0.5 });
+
+    Array3<size_t> histogram;
+    particleSystem.ComputeParticleCountHistogram(
+        Size3{ 4, 3, 2 }, Vector3D{}, Vector3D{ 1.0, 1.0, 1.0 }, &histogram);
+
+    EXPECT_EQ(Size3(4, 3, 2), histogram.size());
+    EXPECT_EQ(3u, histogram(0, 0, 0));
+    EXPECT_EQ(1u, histogram(3, 2, 1));
+    EXPECT_EQ(1u, histogram(0, 2, 0));
+
+    size_t total = 0;
+    histogram.ForEachIndex(
+        [&](size_t i, size_t j, size_t k) { total += histogram(i, j, k); });
+    EXPECT_EQ(particleSystem.GetNumberOfParticles(), total);
+}
+
+TEST(ParticleSystemData3, UpdateActivityStates)
+{
+    ParticleSystemData3 particleSystem;
+
+    // Two resting particles in neighboring cells of a fast one, plus one
+    // resting particle far away from any motion.
+    particleSystem.AddParticle({ 1.5, 1.5, 1.5 }, { 0.0, 0.0, 0.0 });
+    particleSystem.AddParticle({ 2.5, 1.5, 1.5 }, { 0.0, 0.0, 0.0 });
+    particleSystem.AddParticle({ 6.5, 1.5, 1.5 }, { 0.0, 0.0, 0.0 });
+    particleSystem.AddParticle({ 1.5, 2.5, 1.5 }, { 1.0, 0.0, 0.0 });
+
+    const Size3 resolution{ 8, 4, 4 };
+    const Vector3D origin;
+    const Vector3D gridSpacing{ 1.0, 1.0, 1.0 };
+
+    EXPECT_EQ(0u, particleSystem.GetActivityStates().size());
+
+    // Resting particles need the full hysteresis before falling asleep.
+    particleSystem.UpdateActivityStates(0.01, 3, resolution, origin,
+                                        gridSpacing);
+    ConstArrayAccessor1<char> states = particleSystem.GetActivityStates();
+    ASSERT_EQ(4u, states.size());
+    EXPECT_EQ(0, states[0]);
+    EXPECT_EQ(0, states[1]);
+    EXPECT_EQ(0, states[2]);
+
+    particleSystem.UpdateActivityStates(0.01, 3, resolution, origin,
+                                        gridSpacing);
+    particleSystem.UpdateActivityStates(0.01, 3, resolution, origin,
+                                        gridSpacing);
+    states = particleSystem.GetActivityStates();
+
+    // The far resting particle sleeps; the two next to the fast particle are
+    // kept awake by the cell-neighborhood wake propagation, and the fast
+    // particle itself never sleeps.
+    EXPECT_EQ(0, states[0]);
+    EXPECT_EQ(0, states[1]);
+    EXPECT_EQ(1, states[2]);
+    EXPECT_EQ(0, states[3]);
+}
+
+TEST(ParticleSystemData3, RemoveParticles)
+{
+    ParticleSystemData3 particleSystem;
+    particleSystem.AddParticle(Vector3D{ 0.0, 0.0, 0.0 },
+                               Vector3D{ 1.0, 0.0, 0.0 });
+    particleSystem.AddParticle(Vector3D{ 1.0, 0.0, 0.0 },
+                               Vector3D{ 2.0, 0.0, 0.0 });
+    particleSystem.AddParticle(Vector3D{ 2.0, 0.0, 0.0 },
+                               Vector3D{ 3.0, 0.0, 0.0 });
+
+    const size_t scalarIdx = particleSystem.AddScalarData();
+    auto scalars = particleSystem.ScalarDataAt(scalarIdx);
+    scalars[0] = 10.0;
+    scalars[1] = 20.0;
+    scalars[2] = 30.0;
+
+    Array1<char> shouldRemove(3, 0);
+    shouldRemove[1] = 1;
+    particleSystem.RemoveParticles(shouldRemove.ConstAccessor());
+
+    EXPECT_EQ(2u, particleSystem.GetNumberOfParticles());
+
+    // The survivors keep their relative order across every channel.
+    EXPECT_DOUBLE_EQ(0.0, particleSystem.GetPositions()[0].x);
+    EXPECT_DOUBLE_EQ(2.0, particleSystem.GetPositions()[1].x);
+    EXPECT_DOUBLE_EQ(1.0, particleSystem.GetVelocities()[0].x);
+    EXPECT_DOUBLE_EQ(3.0, particleSystem.GetVelocities()[1].x);
+    EXPECT_DOUBLE_EQ(10.0, particleSystem.ScalarDataAt(scalarIdx)[0]);
+    EXPECT_DOUBLE_EQ(30.0, particleSystem.ScalarDataAt(scalarIdx)[1]);
+
+    // Removing nothing leaves the system untouched.
+    Array1<char> keepAll(2, 0);
+    particleSystem.RemoveParticles(keepAll.ConstAccessor());
+    EXPECT_EQ(2u, particleSystem.GetNumberOfParticles());
+}
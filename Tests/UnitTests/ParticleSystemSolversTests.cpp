@@ -99,6 +99,51 @@ TEST(ParticleSystemSolver3, BasicParams)
 
     solver.SetGravity(Vector3D(3, -10, 7));
     EXPECT_EQ(Vector3D(3, -10, 7), solver.GetGravity());
+
+    EXPECT_EQ(1u, solver.GetNumberOfTimeIntegrationTiers());
+
+    solver.SetNumberOfTimeIntegrationTiers(3);
+    EXPECT_EQ(3u, solver.GetNumberOfTimeIntegrationTiers());
+
+    solver.SetNumberOfTimeIntegrationTiers(0);
+    EXPECT_EQ(1u, solver.GetNumberOfTimeIntegrationTiers());
+
+    solver.SetNumberOfTimeIntegrationTiers(9);
+    EXPECT_EQ(4u, solver.GetNumberOfTimeIntegrationTiers());
+}
+
+TEST(ParticleSystemSolver3, TieredUpdate)
+{
+    // Without a collider, the tiered integration of a constant force should
+    // stay close to the single-step result for slow particles and remain
+    // finite for fast ones.
+    ParticleSystemSolver3 solver;
+    solver.SetGravity(Vector3D(0, -10, 0));
+    solver.SetDragCoefficient(0.0);
+    solver.SetNumberOfTimeIntegrationTiers(4);
+
+    ParticleSystemData3Ptr data = solver.GetParticleSystemData();
+    data->SetRadius(0.1);
+    ParticleSystemData3::VectorData positions(2);
+    data->AddParticles(positions.Accessor());
+
+    data->GetVelocities()[1] = Vector3D(0, -50.0, 0);
+
+    Frame frame(0, 1.0 / 60.0);
+    solver.Update(frame);
+
+    const double dt = 1.0 / 60.0;
+
+    // The slow particle travels less than one radius per step, so it must
+    // take the unmodified single-step path.
+    EXPECT_DOUBLE_EQ(-10.0 * dt, data->GetVelocities()[0].y);
+    EXPECT_DOUBLE_EQ(-10.0 * dt * dt, data->GetPositions()[0].y);
+
+    // The fast particle's velocity update is exact regardless of tier, and
+    // its position lands between the single-step and exact ballistic answer.
+    EXPECT_DOUBLE_EQ(-50.0 - 10.0 * dt, data->GetVelocities()[1].y);
+    EXPECT_LT(data->GetPositions()[1].y, -50.0 * dt);
+    EXPECT_GT(data->GetPositions()[1].y, (-50.0 - 10.0 * dt) * dt);
 }
 
 TEST(ParticleSystemSolver3, Update)
@@ -0,0 +1,136 @@
+#include "pch.hpp"
+
+#include <Core/Animation/PhysicsAnimation.hpp>
+#include <Core/Utils/Macros.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace CubbyFlow;
+
+namespace
+{
+struct CounterSnapshot final : public Serializable
+{
+    double value = 0.0;
+
+    void Serialize(std::vector<uint8_t>* buffer) const override
+    {
+        buffer->resize(sizeof(double));
+        std::memcpy(buffer->data(), &value, sizeof(double));
+    }
+
+    void Deserialize(const std::vector<uint8_t>& buffer) override
+    {
+        std::memcpy(&value, buffer.data(), sizeof(double));
+    }
+};
+
+class CounterAnimation final : public PhysicsAnimation
+{
+ public:
+    double state = 0.0;
+
+ protected:
+    void OnAdvanceTimeStep(double timeIntervalInSeconds) override
+    {
+        state += timeIntervalInSeconds;
+    }
+};
+}  // namespace
+
+TEST(PhysicsAnimation, AsyncFrameOutput)
+{
+    CounterAnimation anim;
+
+    std::mutex mutex;
+    std::vector<int> frames;
+    std::vector<double> values;
+
+    anim.SetFrameOutput(
+        [&anim] {
+            auto snapshot = std::make_shared<CounterSnapshot>();
+            snapshot->value = anim.state;
+            return snapshot;
+        },
+        [&](const Frame& frame, const std::vector<uint8_t>& buffer) {
+            CounterSnapshot decoded;
+            decoded.Deserialize(buffer);
+
+            std::lock_guard<std::mutex> lock{ mutex };
+            frames.push_back(frame.index);
+            values.push_back(decoded.value);
+        });
+
+    for (int i = 0; i < 5; ++i)
+    {
+        anim.AdvanceSingleFrame();
+    }
+
+    anim.FlushFrameOutput();
+
+    ASSERT_EQ(5u, frames.size());
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        EXPECT_EQ(static_cast<int>(i), frames[i]);
+        EXPECT_DOUBLE_EQ((i + 1) * (1.0 / 60.0), values[i]);
+    }
+
+    // A multi-frame jump should emit output for every intermediate frame.
+    Frame jump{ 8, 1.0 / 60.0 };
+    anim.Update(jump);
+    anim.FlushFrameOutput();
+
+    ASSERT_EQ(9u, frames.size());
+    EXPECT_EQ(6, frames[6]);
+    EXPECT_EQ(8, frames.back());
+}
+
+TEST(PhysicsAnimation, FlushWithoutFrameOutput)
+{
+    CounterAnimation anim;
+
+    anim.AdvanceSingleFrame();
+
+    // Flushing is a no-op when no output stage is configured.
+    anim.FlushFrameOutput();
+
+    EXPECT_EQ(0, anim.GetCurrentFrame().index);
+}
+
+namespace
+{
+class BudgetProbeAnimation final : public PhysicsAnimation
+{
+ public:
+    unsigned int observedBudget = 0;
+
+ protected:
+    void OnAdvanceTimeStep(double timeIntervalInSeconds) override
+    {
+        UNUSED_VARIABLE(timeIntervalInSeconds);
+
+        observedBudget = GetCurrentThreadBudget();
+    }
+};
+}  // namespace
+
+TEST(PhysicsAnimation, ThreadBudget)
+{
+    BudgetProbeAnimation anim;
+    EXPECT_EQ(0u, anim.GetThreadBudget());
+
+    anim.AdvanceSingleFrame();
+    EXPECT_EQ(0u, anim.observedBudget);
+
+    anim.SetThreadBudget(2);
+    EXPECT_EQ(2u, anim.GetThreadBudget());
+
+    anim.AdvanceSingleFrame();
+    EXPECT_EQ(2u, anim.observedBudget);
+
+    // The scope ends with the update.
+    EXPECT_EQ(0u, GetCurrentThreadBudget());
+}
@@ -2,6 +2,9 @@
 
 #include <Core/Searcher/PointHashGridSearcher3.hpp>
 
+#include <algorithm>
+#include <vector>
+
 using namespace CubbyFlow;
 
 TEST(PointHashGridSearcher3, ForEachNearByPoint)
@@ -59,4 +62,65 @@ TEST(PointHashGridSearcher3, Build)
     EXPECT_EQ(21, searcher.GetHashKeyFromBucketIndex(Point3I(1, 1, 37)));
     EXPECT_EQ(5, searcher.GetHashKeyFromBucketIndex(Point3I(37, 1, 0)));
     EXPECT_EQ(8, searcher.GetHashKeyFromBucketIndex(Point3I(-104, 374, 0)));
-}
\ No newline at end of file
+}
+TEST(PointHashGridSearcher3, HashKeyWrapping)
+{
+    // Power-of-two and non-power-of-two resolutions must wrap identically,
+    // including negative bucket indices.
+    const PointHashGridSearcher3 pow2{ Size3(8, 4, 16), 1.0 };
+    const PointHashGridSearcher3 odd{ Size3(7, 5, 9), 1.0 };
+
+    const auto reference = [](const Point3I& index, const Point3I& res) {
+        const auto wrap = [](ssize_t c, ssize_t r) {
+            ssize_t w = c % r;
+            return (w < 0) ? w + r : w;
+        };
+        return static_cast<size_t>(
+            (wrap(index.z, res.z) * res.y + wrap(index.y, res.y)) * res.x +
+            wrap(index.x, res.x));
+    };
+
+    const Point3I samples[] = { Point3I(0, 0, 0),    Point3I(7, 3, 15),
+                                Point3I(8, 4, 16),   Point3I(-1, -1, -1),
+                                Point3I(-9, 13, -17), Point3I(123, -456, 789) };
+
+    for (const Point3I& index : samples)
+    {
+        EXPECT_EQ(reference(index, Point3I(8, 4, 16)),
+                  pow2.GetHashKeyFromBucketIndex(index));
+        EXPECT_EQ(reference(index, Point3I(7, 5, 9)),
+                  odd.GetHashKeyFromBucketIndex(index));
+    }
+}
+
+TEST(PointHashGridSearcher3, PowerOfTwoResolutionSearch)
+{
+    // Both wrap modes must find the same neighbors.
+    Array1<Vector3D> points = { Vector3D(1, 1, 4), Vector3D(3, 4, 5),
+                                Vector3D(-1, 2, 4), Vector3D(9, -3, 2) };
+
+    PointHashGridSearcher3 pow2{ Size3(8, 8, 8), std::sqrt(10) };
+    PointHashGridSearcher3 odd{ Size3(5, 7, 9), std::sqrt(10) };
+    pow2.Build(points.Accessor());
+    odd.Build(points.Accessor());
+
+    const Vector3D origins[] = { Vector3D(0, 0, 0), Vector3D(2, 2, 4),
+                                 Vector3D(-2, 1, 3) };
+
+    for (const Vector3D& origin : origins)
+    {
+        std::vector<size_t> foundPow2;
+        std::vector<size_t> foundOdd;
+
+        pow2.ForEachNearbyPoint(
+            origin, 3.0,
+            [&](size_t i, const Vector3D&) { foundPow2.push_back(i); });
+        odd.ForEachNearbyPoint(
+            origin, 3.0,
+            [&](size_t i, const Vector3D&) { foundOdd.push_back(i); });
+
+        std::sort(foundPow2.begin(), foundPow2.end());
+        std::sort(foundOdd.begin(), foundOdd.end());
+        EXPECT_EQ(foundOdd, foundPow2);
+    }
+}
@@ -2,6 +2,9 @@
 
 #include <Core/Searcher/PointParallelHashGridSearcher3.hpp>
 
+#include <algorithm>
+#include <random>
+
 using namespace CubbyFlow;
 
 TEST(PointParallelHashGridSearcher3, ForEachNearByPoint)
@@ -75,6 +78,89 @@ TEST(PointParallelHashGridSearcher3, Build)
     EXPECT_EQ(3, searcher.EndIndexTable()[39]);
 }
 
+TEST(PointParallelHashGridSearcher3, Update)
+{
+    Array1<Vector3D> points;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    for (size_t i = 0; i < 256; ++i)
+    {
+        points.Append(Vector3D(dist(rng), dist(rng), dist(rng)));
+    }
+
+    PointParallelHashGridSearcher3 searcher(Size3(8, 8, 8), 0.1);
+    searcher.Build(points.ConstAccessor());
+
+    // Displace every point by a fraction of the grid spacing
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        points[i] += Vector3D(0.01 * dist(rng), 0.01 * dist(rng),
+                              0.01 * dist(rng));
+    }
+
+    searcher.Update(points.ConstAccessor());
+
+    PointParallelHashGridSearcher3 searcher2(Size3(8, 8, 8), 0.1);
+    searcher2.Build(points.ConstAccessor());
+
+    for (int q = 0; q < 100; ++q)
+    {
+        const Vector3D origin(dist(rng), dist(rng), dist(rng));
+
+        std::vector<size_t> found, found2;
+        searcher.ForEachNearbyPoint(
+            origin, 0.05,
+            [&](size_t i, const Vector3D&) { found.push_back(i); });
+        searcher2.ForEachNearbyPoint(
+            origin, 0.05,
+            [&](size_t i, const Vector3D&) { found2.push_back(i); });
+
+        std::sort(found.begin(), found.end());
+        std::sort(found2.begin(), found2.end());
+        EXPECT_EQ(found2, found);
+    }
+}
+
+TEST(PointParallelHashGridSearcher3, Rebuild)
+{
+    Array1<Vector3D> points;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    for (size_t i = 0; i < 256; ++i)
+    {
+        points.Append(Vector3D(dist(rng), dist(rng), dist(rng)));
+    }
+
+    // Rebuilding with a new spacing must match a freshly built searcher.
+    PointParallelHashGridSearcher3 searcher(Size3(8, 8, 8), 0.1);
+    searcher.Build(points.ConstAccessor());
+    searcher.Rebuild(points.ConstAccessor(), 0.2);
+
+    EXPECT_DOUBLE_EQ(0.2, searcher.GridSpacing());
+
+    PointParallelHashGridSearcher3 searcher2(Size3(8, 8, 8), 0.2);
+    searcher2.Build(points.ConstAccessor());
+
+    for (int q = 0; q < 100; ++q)
+    {
+        const Vector3D origin(dist(rng), dist(rng), dist(rng));
+
+        std::vector<size_t> found, found2;
+        searcher.ForEachNearbyPoint(
+            origin, 0.09,
+            [&](size_t i, const Vector3D&) { found.push_back(i); });
+        searcher2.ForEachNearbyPoint(
+            origin, 0.09,
+            [&](size_t i, const Vector3D&) { found2.push_back(i); });
+
+        std::sort(found.begin(), found.end());
+        std::sort(found2.begin(), found2.end());
+        EXPECT_EQ(found2, found);
+    }
+}
+
 TEST(PointParallelHashGridSearcher3, Serialization)
 {
     Array1<Vector3D> points = { Vector3D(0, 1, 3), Vector3D(2, 5, 4),
@@ -0,0 +1,104 @@
+#include "pch.hpp"
+
+#include <Core/Searcher/PointTiledHashGridSearcher3.hpp>
+
+using namespace CubbyFlow;
+
+TEST(PointTiledHashGridSearcher3, ForEachNearByPoint)
+{
+    Array1<Vector3D> points = { Vector3D(0.5, 0.5, 0.5),
+                                Vector3D(1.0, 1.2, 0.4),
+                                Vector3D(10.0, 10.0, 10.0) };
+
+    PointTiledHashGridSearcher3 searcher(3.0);
+    searcher.Build(points.Accessor());
+
+    size_t numFound = 0;
+    searcher.ForEachNearbyPoint(Vector3D(0.4, 0.6, 0.5), 1.5,
+                                [&](size_t i, const Vector3D& pt) {
+                                    EXPECT_TRUE(i == 0 || i == 1);
+                                    EXPECT_EQ(points[i].x, pt.x);
+                                    EXPECT_EQ(points[i].y, pt.y);
+                                    EXPECT_EQ(points[i].z, pt.z);
+                                    ++numFound;
+                                });
+    EXPECT_EQ(2u, numFound);
+}
+
+TEST(PointTiledHashGridSearcher3, HasNearbyPoint)
+{
+    Array1<Vector3D> points = { Vector3D(1, 1, 1), Vector3D(3, 444, 1),
+                                Vector3D(4, 15, 111) };
+
+    PointTiledHashGridSearcher3 searcher(std::sqrt(10));
+    searcher.Build(points.Accessor());
+
+    EXPECT_TRUE(searcher.HasNearbyPoint(Vector3D(), std::sqrt(15.0)));
+    EXPECT_FALSE(searcher.HasNearbyPoint(Vector3D(500, 500, 500), 1.0));
+}
+
+TEST(PointTiledHashGridSearcher3, BuildSparseDomain)
+{
+    // Two far-apart clusters must produce exactly two occupied tiles rather
+    // than a resolution-sized bucket table.
+    Array1<Vector3D> points = { Vector3D(0.1, 0.1, 0.1),
+                                Vector3D(0.2, 0.3, 0.1),
+                                Vector3D(900.0, 900.0, 900.0) };
+
+    PointTiledHashGridSearcher3 searcher(1.0);
+    searcher.Build(points.Accessor());
+
+    EXPECT_EQ(2u, searcher.GetNumberOfTiles());
+
+    size_t numFound = 0;
+    searcher.ForEachNearbyPoint(
+        Vector3D(0.15, 0.2, 0.1), 0.5,
+        [&](size_t, const Vector3D&) { ++numFound; });
+    EXPECT_EQ(2u, numFound);
+
+    numFound = 0;
+    searcher.ForEachNearbyPoint(
+        Vector3D(900.1, 900.0, 900.0), 0.5,
+        [&](size_t, const Vector3D&) { ++numFound; });
+    EXPECT_EQ(1u, numFound);
+}
+
+TEST(PointTiledHashGridSearcher3, TileKeys)
+{
+    // Cells in the same 4^3 tile share a key; the next tile over does not.
+    EXPECT_EQ(PointTiledHashGridSearcher3::GetTileKeyFromCellIndex(
+                  Point3I(0, 0, 0)),
+              PointTiledHashGridSearcher3::GetTileKeyFromCellIndex(
+                  Point3I(3, 3, 3)));
+    EXPECT_NE(PointTiledHashGridSearcher3::GetTileKeyFromCellIndex(
+                  Point3I(0, 0, 0)),
+              PointTiledHashGridSearcher3::GetTileKeyFromCellIndex(
+                  Point3I(4, 0, 0)));
+    EXPECT_EQ(PointTiledHashGridSearcher3::GetTileKeyFromCellIndex(
+                  Point3I(-1, -1, -1)),
+              PointTiledHashGridSearcher3::GetTileKeyFromCellIndex(
+                  Point3I(-4, -4, -4)));
+}
+
+TEST(PointTiledHashGridSearcher3, Serialization)
+{
+    Array1<Vector3D> points = { Vector3D(0.5, 0.5, 0.5),
+                                Vector3D(1.0, 1.2, 0.4),
+                                Vector3D(10.0, 10.0, 10.0) };
+
+    PointTiledHashGridSearcher3 searcher(3.0);
+    searcher.Build(points.Accessor());
+
+    std::vector<uint8_t> buffer;
+    searcher.Serialize(&buffer);
+
+    PointTiledHashGridSearcher3 searcher2(3.0);
+    searcher2.Deserialize(buffer);
+
+    size_t numFound = 0;
+    searcher2.ForEachNearbyPoint(
+        Vector3D(0.4, 0.6, 0.5), 1.5,
+        [&](size_t i, const Vector3D&) { EXPECT_TRUE(i == 0 || i == 1);
+                                         ++numFound; });
+    EXPECT_EQ(2u, numFound);
+}
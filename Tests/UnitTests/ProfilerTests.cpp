@@ -0,0 +1,80 @@
+#include "pch.hpp"
+
+#include <Core/Utils/Profiler.hpp>
+
+#include <sstream>
+
+using namespace CubbyFlow;
+
+TEST(Profiler, Basics)
+{
+    Profiler::Clear();
+
+    // Disabled zones record nothing
+    {
+        CUBBYFLOW_PROFILE_ZONE("DisabledZone");
+    }
+
+    std::stringstream stream;
+    Profiler::DumpChromeTrace(&stream);
+    EXPECT_EQ("{\"traceEvents\":[]}", stream.str());
+
+    Profiler::SetEnabled(true);
+
+    {
+        CUBBYFLOW_PROFILE_ZONE("OuterZone");
+        {
+            CUBBYFLOW_PROFILE_ZONE("InnerZone");
+        }
+    }
+
+    Profiler::SetEnabled(false);
+
+    std::stringstream stream2;
+    Profiler::DumpChromeTrace(&stream2);
+    const std::string trace = stream2.str();
+
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"OuterZone\""));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"InnerZone\""));
+
+    Profiler::Clear();
+
+    std::stringstream stream3;
+    Profiler::DumpChromeTrace(&stream3);
+    EXPECT_EQ("{\"traceEvents\":[]}", stream3.str());
+}
+
+TEST(Profiler, ZoneCounters)
+{
+    Profiler::Clear();
+    Profiler::SetEnabled(true);
+
+    {
+        CUBBYFLOW_PROFILE_ZONE("CountedZone");
+        CUBBYFLOW_PROFILE_COUNTERS(1024.0, 512.0, 2048.0);
+        CUBBYFLOW_PROFILE_COUNTERS(1024.0, 0.0, 0.0);
+    }
+
+    {
+        CUBBYFLOW_PROFILE_ZONE("PlainZone");
+    }
+
+    Profiler::SetEnabled(false);
+
+    std::stringstream stream;
+    Profiler::DumpChromeTrace(&stream);
+    const std::string trace = stream.str();
+
+    // Repeated reports accumulate into the innermost zone
+    EXPECT_NE(std::string::npos, trace.find("\"bytesRead\":2048"));
+    EXPECT_NE(std::string::npos, trace.find("\"bytesWritten\":512"));
+    EXPECT_NE(std::string::npos, trace.find("\"flops\":2048"));
+    EXPECT_NE(std::string::npos, trace.find("\"GBps\":"));
+
+    // Zones without counters stay free of args
+    const size_t plainPos = trace.find("\"name\":\"PlainZone\"");
+    ASSERT_NE(std::string::npos, plainPos);
+    EXPECT_EQ(std::string::npos, trace.find("\"args\"", plainPos));
+
+    Profiler::Clear();
+}
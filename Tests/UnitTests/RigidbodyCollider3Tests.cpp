@@ -148,4 +148,34 @@ TEST(RigidBodyCollider3, Empty)
     EXPECT_DOUBLE_EQ(1.0, newVelocity.x);
     EXPECT_DOUBLE_EQ(0.0, newVelocity.y);
     EXPECT_DOUBLE_EQ(0.0, newVelocity.z);
-}
\ No newline at end of file
+}
+TEST(RigidBodyCollider3, SweptTransform)
+{
+    RigidBodyCollider3 collider(
+        std::make_shared<Plane3>(Vector3D(0, 1, 0), Vector3D(0, 0, 0)));
+    collider.isVelocityDerivedFromMotion = true;
+
+    // Scripted motion: translate along +x at 2 units/s, spin about +y at
+    // 3 rad/s.
+    collider.SetOnBeginUpdateCallback([](Collider3* col, double t, double) {
+        col->GetSurface()->transform.SetTranslation({ 2.0 * t, 0, 0 });
+        col->GetSurface()->transform.SetOrientation(
+            QuaternionD({ 0, 1, 0 }, 3.0 * t));
+    });
+
+    const double dt = 0.01;
+    collider.Update(0.0, dt);
+    collider.Update(dt, dt);
+
+    EXPECT_NEAR(2.0, collider.linearVelocity.x, 1e-9);
+    EXPECT_NEAR(0.0, collider.linearVelocity.y, 1e-9);
+    EXPECT_NEAR(3.0, collider.angularVelocity.y, 1e-9);
+
+    const Transform3 mid = collider.GetTransformAt(0.5);
+    EXPECT_NEAR(dt, mid.GetTranslation().x, 1e-9);
+    EXPECT_NEAR(1.5 * dt, mid.GetOrientation().Angle(), 1e-9);
+
+    EXPECT_NEAR(0.0, collider.GetTransformAt(0.0).GetTranslation().x, 1e-12);
+    EXPECT_NEAR(2.0 * dt, collider.GetTransformAt(1.0).GetTranslation().x,
+                1e-12);
+}
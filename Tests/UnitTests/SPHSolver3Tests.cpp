@@ -56,5 +56,62 @@ TEST(SPHSolver3, Parameters)
     solver.SetTimeStepLimitScale(-1.0);
     EXPECT_DOUBLE_EQ(0.0, solver.GetTimeStepLimitScale());
 
+    EXPECT_FALSE(solver.GetUseImplicitViscosity());
+
+    solver.SetUseImplicitViscosity(true);
+    EXPECT_TRUE(solver.GetUseImplicitViscosity());
+
     EXPECT_TRUE(solver.GetSPHSystemData() != nullptr);
+}
+
+TEST(SPHSolver3, ImplicitViscosityStability)
+{
+    // A sheared velocity field with high viscosity and a fixed time step that
+    // is far beyond the explicit diffusion limit. The implicit solve must
+    // dissipate the shear instead of amplifying it.
+    SPHSolver3 solver;
+    solver.GetSPHSystemData()->SetTargetDensity(1000.0);
+    solver.GetSPHSystemData()->SetTargetSpacing(0.05);
+    solver.SetViscosityCoefficient(50.0);
+    solver.SetUseImplicitViscosity(true);
+    solver.SetPseudoViscosityCoefficient(0.0);
+    solver.SetIsUsingFixedSubTimeSteps(true);
+    solver.SetNumberOfFixedSubTimeSteps(1);
+
+    Array1<Vector3D> points;
+    for (int i = 0; i < 6; ++i)
+    {
+        for (int j = 0; j < 6; ++j)
+        {
+            for (int k = 0; k < 6; ++k)
+            {
+                points.Append(Vector3D{ 0.05 * i + 0.025, 0.05 * j + 0.025,
+                                        0.05 * k + 0.025 });
+            }
+        }
+    }
+    solver.GetSPHSystemData()->AddParticles(points.ConstAccessor());
+
+    ArrayAccessor1<Vector3D> v = solver.GetSPHSystemData()->GetVelocities();
+    const ArrayAccessor1<Vector3D> x = solver.GetSPHSystemData()->GetPositions();
+    double initialMaxSpeed = 0.0;
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = Vector3D{ std::sin(12.0 * x[i].y), 0.0, 0.0 };
+        initialMaxSpeed = std::max(initialMaxSpeed, v[i].Length());
+    }
+
+    Frame frame{ 0, 1.0 / 60.0 };
+    for (; frame.index < 3; frame.Advance())
+    {
+        solver.Update(frame);
+    }
+
+    const ArrayAccessor1<Vector3D> result =
+        solver.GetSPHSystemData()->GetVelocities();
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        EXPECT_TRUE(std::isfinite(result[i].Length()));
+        EXPECT_LT(result[i].Length(), 2.0 * initialMaxSpeed);
+    }
 }
\ No newline at end of file
@@ -152,4 +152,54 @@ TEST(SPHSpikyKernel3, SecondDerivative)
     const double fdm =
         (kernel(5.0 + e) - 2.0 * kernel(5.0) + kernel(5.0 - e)) / (e * e);
     EXPECT_NEAR(fdm, value1, 1e-10);
-}
\ No newline at end of file
+}
+TEST(SPHStdKernel3, BatchedEvaluation)
+{
+    const SPHStdKernel3 kernel{ 10.0 };
+
+    std::array<double, SPHStdKernel3::BATCH_SIZE> distances{};
+    for (size_t n = 0; n < SPHStdKernel3::BATCH_SIZE; ++n)
+    {
+        // Includes distances outside the kernel support.
+        distances[n] = 1.5 * static_cast<double>(n);
+    }
+
+    std::array<double, SPHStdKernel3::BATCH_SIZE> weights{};
+    std::array<double, SPHStdKernel3::BATCH_SIZE> first{};
+    std::array<double, SPHStdKernel3::BATCH_SIZE> second{};
+    kernel.Evaluate(distances.data(), distances.size(), weights.data());
+    kernel.FirstDerivative(distances.data(), distances.size(), first.data());
+    kernel.SecondDerivative(distances.data(), distances.size(), second.data());
+
+    for (size_t n = 0; n < SPHStdKernel3::BATCH_SIZE; ++n)
+    {
+        EXPECT_NEAR(kernel(distances[n]), weights[n], 1e-15);
+        EXPECT_NEAR(kernel.FirstDerivative(distances[n]), first[n], 1e-15);
+        EXPECT_NEAR(kernel.SecondDerivative(distances[n]), second[n], 1e-15);
+    }
+}
+
+TEST(SPHSpikyKernel3, BatchedEvaluation)
+{
+    const SPHSpikyKernel3 kernel{ 10.0 };
+
+    std::array<double, SPHSpikyKernel3::BATCH_SIZE> distances{};
+    for (size_t n = 0; n < SPHSpikyKernel3::BATCH_SIZE; ++n)
+    {
+        distances[n] = 1.5 * static_cast<double>(n);
+    }
+
+    std::array<double, SPHSpikyKernel3::BATCH_SIZE> weights{};
+    std::array<double, SPHSpikyKernel3::BATCH_SIZE> first{};
+    std::array<double, SPHSpikyKernel3::BATCH_SIZE> second{};
+    kernel.Evaluate(distances.data(), distances.size(), weights.data());
+    kernel.FirstDerivative(distances.data(), distances.size(), first.data());
+    kernel.SecondDerivative(distances.data(), distances.size(), second.data());
+
+    for (size_t n = 0; n < SPHSpikyKernel3::BATCH_SIZE; ++n)
+    {
+        EXPECT_NEAR(kernel(distances[n]), weights[n], 1e-15);
+        EXPECT_NEAR(kernel.FirstDerivative(distances[n]), first[n], 1e-15);
+        EXPECT_NEAR(kernel.SecondDerivative(distances[n]), second[n], 1e-15);
+    }
+}
@@ -127,4 +127,97 @@ TEST(SPHSystemData3, Serialization)
             EXPECT_EQ(neighbors[j], neighbors2[j]);
         }
     }
-}
\ No newline at end of file
+}
+TEST(SPHSystemData3, LazyMassRecompute)
+{
+    SPHSystemData3 data;
+
+    // Setting properties in arbitrary order defers the mass calibration;
+    // the first GetMass() call computes it once from the final state.
+    data.SetRelativeKernelRadius(2.0);
+    data.SetTargetSpacing(0.2);
+    data.SetTargetDensity(500.0);
+
+    const double lazyMass = data.GetMass();
+
+    SPHSystemData3 reference;
+    reference.SetRelativeKernelRadius(2.0);
+    reference.SetTargetSpacing(0.2);
+    reference.SetTargetDensity(500.0);
+    EXPECT_DOUBLE_EQ(reference.GetMass(), lazyMass);
+
+    // Mass scales linearly with the target density.
+    data.SetTargetDensity(1000.0);
+    EXPECT_DOUBLE_EQ(2.0 * lazyMass, data.GetMass());
+
+    // An explicit mass assignment sticks and rescales the target density.
+    data.SetMass(3.0 * data.GetMass());
+    EXPECT_DOUBLE_EQ(3000.0, data.GetTargetDensity());
+
+    // Copies inherit the calibrated state without recomputing.
+    const SPHSystemData3 copied(data);
+    EXPECT_DOUBLE_EQ(data.GetMass(), copied.GetMass());
+}
+
+TEST(SPHSystemData3, SplitAndMergeParticles)
+{
+    SPHSystemData3 data;
+    data.SetTargetSpacing(0.1);
+
+    data.AddParticle(Vector3D{ 0.0, 0.0, 0.0 }, Vector3D{ 1.0, 0.0, 0.0 });
+    data.AddParticle(Vector3D{ 1.0, 0.0, 0.0 });
+
+    data.EnableAdaptiveSpacing();
+    EXPECT_TRUE(data.HasAdaptiveSpacing());
+    EXPECT_DOUBLE_EQ(0.1, data.GetParticleSpacings()[0]);
+    EXPECT_DOUBLE_EQ(data.GetMass(), data.GetParticleMasses()[0]);
+
+    const double totalMass =
+        data.GetParticleMasses()[0] + data.GetParticleMasses()[1];
+
+    // Split the first particle only.
+    Array1<char> shouldSplit(2, 0);
+    shouldSplit[0] = 1;
+    const size_t numSplits =
+        data.SplitParticles(shouldSplit.ConstAccessor(), 0.01);
+    EXPECT_EQ(1u, numSplits);
+    EXPECT_EQ(3u, data.GetNumberOfParticles());
+
+    const double childSpacing = 0.1 / std::cbrt(2.0);
+    EXPECT_DOUBLE_EQ(childSpacing, data.GetParticleSpacings()[0]);
+    EXPECT_DOUBLE_EQ(childSpacing, data.GetParticleSpacings()[2]);
+    EXPECT_DOUBLE_EQ(0.1, data.GetParticleSpacings()[1]);
+
+    double massAfterSplit = 0.0;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        massAfterSplit += data.GetParticleMasses()[i];
+    }
+    EXPECT_DOUBLE_EQ(totalMass, massAfterSplit);
+
+    // The children straddle the parent position along its velocity.
+    EXPECT_DOUBLE_EQ(-0.25 * childSpacing, data.GetPositions()[0].x);
+    EXPECT_DOUBLE_EQ(0.25 * childSpacing, data.GetPositions()[2].x);
+
+    // A split below the minimum spacing is refused.
+    Array1<char> shouldSplitAll(3, 1);
+    EXPECT_EQ(0u, data.SplitParticles(shouldSplitAll.ConstAccessor(), 0.1));
+
+    // Merging the children restores the original particle.
+    data.BuildNeighborSearcher();
+    data.BuildNeighborLists();
+
+    Array1<char> canMerge(3, 1);
+    const size_t numMerges = data.MergeParticles(canMerge.ConstAccessor(), 0.2);
+    EXPECT_EQ(1u, numMerges);
+    EXPECT_EQ(2u, data.GetNumberOfParticles());
+
+    double massAfterMerge = 0.0;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        massAfterMerge += data.GetParticleMasses()[i];
+    }
+    EXPECT_DOUBLE_EQ(totalMass, massAfterMerge);
+    EXPECT_NEAR(0.1, data.GetParticleSpacings()[0], 1e-12);
+    EXPECT_NEAR(0.0, data.GetPositions()[0].x, 1e-12);
+}
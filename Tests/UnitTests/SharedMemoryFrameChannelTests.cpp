@@ -0,0 +1,87 @@
+#include "pch.hpp"
+
+#include <Core/Animation/SharedMemoryFrameChannel.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace CubbyFlow;
+
+TEST(SharedMemoryFrameChannel, PublishAndReadLatest)
+{
+    auto writer =
+        SharedMemoryFrameChannel::Create("cubbyflow_test_channel", 3, 1024);
+    ASSERT_NE(nullptr, writer);
+    EXPECT_EQ(3u, writer->GetNumberOfSlots());
+    EXPECT_EQ(1024u, writer->GetSlotCapacity());
+
+    auto reader = SharedMemoryFrameChannel::Open("cubbyflow_test_channel");
+    ASSERT_NE(nullptr, reader);
+
+    uint64_t frameIndex;
+    std::vector<uint8_t> data;
+
+    // Nothing published yet
+    EXPECT_FALSE(reader->ReadLatest(&frameIndex, &data));
+
+    std::vector<uint8_t> payload(500);
+    for (size_t i = 0; i < payload.size(); ++i)
+    {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+
+    EXPECT_TRUE(writer->Publish(7, payload.data(), payload.size()));
+    ASSERT_TRUE(reader->ReadLatest(&frameIndex, &data));
+    EXPECT_EQ(7u, frameIndex);
+    EXPECT_EQ(payload, data);
+}
+
+TEST(SharedMemoryFrameChannel, RingKeepsLatestFrame)
+{
+    auto writer =
+        SharedMemoryFrameChannel::Create("cubbyflow_test_channel", 2, 64);
+    ASSERT_NE(nullptr, writer);
+
+    for (uint64_t frame = 0; frame < 10; ++frame)
+    {
+        const auto byte = static_cast<uint8_t>(frame);
+        EXPECT_TRUE(writer->Publish(frame, &byte, 1));
+    }
+
+    auto reader = SharedMemoryFrameChannel::Open("cubbyflow_test_channel");
+    ASSERT_NE(nullptr, reader);
+
+    uint64_t frameIndex;
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(reader->ReadLatest(&frameIndex, &data));
+    EXPECT_EQ(9u, frameIndex);
+    ASSERT_EQ(1u, data.size());
+    EXPECT_EQ(9u, data[0]);
+}
+
+TEST(SharedMemoryFrameChannel, OversizedFrameIsSkipped)
+{
+    auto writer =
+        SharedMemoryFrameChannel::Create("cubbyflow_test_channel", 2, 16);
+    ASSERT_NE(nullptr, writer);
+
+    const uint8_t small = 42;
+    EXPECT_TRUE(writer->Publish(1, &small, 1));
+
+    const std::vector<uint8_t> big(32, 1);
+    EXPECT_FALSE(writer->Publish(2, big.data(), big.size()));
+
+    // The oversized frame must not clobber the previous one
+    uint64_t frameIndex;
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(writer->ReadLatest(&frameIndex, &data));
+    EXPECT_EQ(1u, frameIndex);
+    ASSERT_EQ(1u, data.size());
+    EXPECT_EQ(42u, data[0]);
+}
+
+TEST(SharedMemoryFrameChannel, OpenMissingChannelFails)
+{
+    EXPECT_EQ(nullptr,
+              SharedMemoryFrameChannel::Open("cubbyflow_no_such_channel"));
+}
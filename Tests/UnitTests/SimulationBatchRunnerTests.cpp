@@ -0,0 +1,97 @@
+#include "pch.hpp"
+
+#include <Core/Animation/SimulationBatchRunner.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace CubbyFlow;
+
+namespace
+{
+class StepCountAnimation final : public PhysicsAnimation
+{
+ public:
+    size_t numberOfSteps = 0;
+    double accumulatedTime = 0.0;
+
+ protected:
+    void OnAdvanceTimeStep(double timeIntervalInSeconds) override
+    {
+        ++numberOfSteps;
+        accumulatedTime += timeIntervalInSeconds;
+    }
+};
+}  // namespace
+
+TEST(SimulationBatchRunner, AdvancesEverySimulation)
+{
+    SimulationBatchRunner runner;
+    std::vector<std::shared_ptr<StepCountAnimation>> sims;
+
+    for (size_t i = 0; i < 5; ++i)
+    {
+        auto sim = std::make_shared<StepCountAnimation>();
+        sims.push_back(sim);
+        EXPECT_EQ(i, runner.AddSimulation(sim, i % 3));
+    }
+
+    EXPECT_EQ(5u, runner.GetNumberOfSimulations());
+
+    runner.AdvanceFrames(4);
+
+    auto solo = std::make_shared<StepCountAnimation>();
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        solo->AdvanceSingleFrame();
+    }
+
+    for (size_t i = 0; i < sims.size(); ++i)
+    {
+        EXPECT_EQ(sims[i], runner.GetSimulationAt(i));
+        EXPECT_EQ(solo->numberOfSteps, sims[i]->numberOfSteps);
+        EXPECT_EQ(solo->GetCurrentFrame().index,
+                  sims[i]->GetCurrentFrame().index);
+        EXPECT_DOUBLE_EQ(solo->accumulatedTime, sims[i]->accumulatedTime);
+    }
+}
+
+TEST(SimulationBatchRunner, SharedResourceCache)
+{
+    SimulationBatchRunner runner;
+
+    const auto resource = std::make_shared<int>(42);
+    runner.SetSharedResource("bakedSDF", resource);
+
+    const auto fetched = runner.GetSharedResource<int>("bakedSDF");
+    EXPECT_EQ(resource, fetched);
+    EXPECT_EQ(42, *fetched);
+
+    EXPECT_EQ(nullptr, runner.GetSharedResource<int>("missing"));
+
+    // Re-registering a key replaces the stored resource.
+    const auto replacement = std::make_shared<int>(7);
+    runner.SetSharedResource("bakedSDF", replacement);
+    EXPECT_EQ(7, *runner.GetSharedResource<int>("bakedSDF"));
+}
+
+TEST(SimulationBatchRunner, LargeBudgetsStillRun)
+{
+    SimulationBatchRunner runner;
+    std::vector<std::shared_ptr<StepCountAnimation>> sims;
+
+    // Budgets exceeding the pool size degenerate to one simulation per wave.
+    for (size_t i = 0; i < 3; ++i)
+    {
+        auto sim = std::make_shared<StepCountAnimation>();
+        sims.push_back(sim);
+        runner.AddSimulation(sim, 1024);
+    }
+
+    runner.AdvanceSingleFrame();
+
+    for (const auto& sim : sims)
+    {
+        EXPECT_EQ(1u, sim->numberOfSteps);
+    }
+}
@@ -0,0 +1,85 @@
+#include "pch.hpp"
+
+#include <Core/Utils/SmallVector.hpp>
+
+#include <string>
+#include <utility>
+
+using namespace CubbyFlow;
+
+TEST(SmallVector, BasicOperations)
+{
+    SmallVector<int, 8> vec;
+
+    EXPECT_TRUE(vec.IsEmpty());
+    EXPECT_EQ(0u, vec.Size());
+    EXPECT_EQ(8u, vec.Capacity());
+
+    for (int i = 0; i < 5; ++i)
+    {
+        vec.Append(i);
+    }
+
+    EXPECT_EQ(5u, vec.Size());
+    EXPECT_EQ(4, vec.Back());
+    EXPECT_EQ(2, vec[2]);
+
+    vec.PopBack();
+    EXPECT_EQ(4u, vec.Size());
+    EXPECT_EQ(3, vec.Back());
+
+    vec.Clear();
+    EXPECT_TRUE(vec.IsEmpty());
+}
+
+TEST(SmallVector, GrowsPastInlineCapacity)
+{
+    SmallVector<std::string, 4> vec;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        vec.Append("item" + std::to_string(i));
+    }
+
+    EXPECT_EQ(100u, vec.Size());
+    EXPECT_GE(vec.Capacity(), 100u);
+    EXPECT_EQ("item0", vec[0]);
+    EXPECT_EQ("item57", vec[57]);
+    EXPECT_EQ("item99", vec.Back());
+}
+
+TEST(SmallVector, CopyAndMove)
+{
+    SmallVector<std::string, 4> source;
+    for (int i = 0; i < 10; ++i)
+    {
+        source.Append(std::to_string(i));
+    }
+
+    SmallVector<std::string, 4> copied{ source };
+    EXPECT_EQ(10u, copied.Size());
+    EXPECT_EQ("9", copied.Back());
+    EXPECT_EQ(10u, source.Size());
+
+    SmallVector<std::string, 4> moved{ std::move(copied) };
+    EXPECT_EQ(10u, moved.Size());
+    EXPECT_EQ("3", moved[3]);
+
+    SmallVector<std::string, 4> assigned;
+    assigned.Append("stale");
+    assigned = source;
+    EXPECT_EQ(10u, assigned.Size());
+    EXPECT_EQ("0", assigned[0]);
+
+    SmallVector<std::string, 4> moveAssigned;
+    moveAssigned = std::move(moved);
+    EXPECT_EQ(10u, moveAssigned.Size());
+    EXPECT_EQ("9", moveAssigned.Back());
+
+    // Inline-only copies must not alias each other's storage.
+    SmallVector<int, 8> small;
+    small.Append(1);
+    SmallVector<int, 8> smallCopy{ small };
+    smallCopy[0] = 2;
+    EXPECT_EQ(1, small[0]);
+}
@@ -0,0 +1,60 @@
+#include "pch.hpp"
+
+#include <Core/Array/StagedArray3.hpp>
+
+using namespace CubbyFlow;
+
+TEST(StagedArray3, StageAll)
+{
+    Array3<double> data(4, 5, 6);
+    data.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        data(i, j, k) = static_cast<double>(i + 2 * j + 3 * k);
+    });
+
+    StagedArray3<double> stager;
+    EXPECT_TRUE(stager.IsDirty());
+
+    stager.StageAsync(data.ConstAccessor());
+    stager.Synchronize();
+    EXPECT_FALSE(stager.IsDirty());
+    EXPECT_FALSE(stager.IsStaging());
+
+    EXPECT_EQ(data.size(), stager.Buffer().size());
+    data.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(data(i, j, k), stager.Buffer()(i, j, k));
+    });
+}
+
+TEST(StagedArray3, DirtySlabTracking)
+{
+    Array3<double> data(4, 4, 4, 1.0);
+
+    StagedArray3<double> stager;
+    stager.StageAsync(data.ConstAccessor());
+    stager.Synchronize();
+
+    // Mutate two slabs, but only mark one dirty
+    data.ForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (k == 1 || k == 2)
+        {
+            data(i, j, k) = 7.0;
+        }
+    });
+    stager.MarkDirty(1, 2);
+    EXPECT_TRUE(stager.IsDirty());
+
+    stager.StageAsync(data.ConstAccessor());
+    stager.Synchronize();
+
+    // Only the marked slab was refreshed
+    EXPECT_DOUBLE_EQ(7.0, stager.Buffer()(0, 0, 1));
+    EXPECT_DOUBLE_EQ(1.0, stager.Buffer()(0, 0, 2));
+    EXPECT_DOUBLE_EQ(1.0, stager.Buffer()(0, 0, 3));
+
+    // Resize forces a full copy
+    data.Resize(4, 4, 5, 3.0);
+    stager.StageAsync(data.ConstAccessor());
+    stager.Synchronize();
+    EXPECT_DOUBLE_EQ(7.0, stager.Buffer()(0, 0, 2));
+    EXPECT_DOUBLE_EQ(3.0, stager.Buffer()(0, 0, 4));
+}
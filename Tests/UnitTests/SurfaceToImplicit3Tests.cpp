@@ -1,7 +1,10 @@
 #include "pch.hpp"
 
+#include <Core/Array/Array1.hpp>
 #include <Core/Geometry/Box3.hpp>
+#include <Core/Geometry/Cylinder3.hpp>
 #include <Core/Geometry/Plane3.hpp>
+#include <Core/Geometry/Sphere3.hpp>
 #include <Core/Geometry/SurfaceSet3.hpp>
 #include <Core/Geometry/SurfaceToImplicit3.hpp>
 
@@ -199,4 +202,169 @@ TEST(SurfaceToImplicit3, IsInside)
         SurfaceToImplicit3::Builder{}.WithSurface(plane).MakeShared();
     EXPECT_FALSE(s2i->IsInside({ 0, -0.5, 0 }));
     EXPECT_TRUE(s2i->IsInside({ 0, -1.5, 0 }));
-}
\ No newline at end of file
+}
+TEST(SurfaceToImplicit3, BatchSignedDistance)
+{
+    const Sphere3Ptr sphere = Sphere3::Builder{}
+                                  .WithCenter({ 0.5, 0.25, -0.25 })
+                                  .WithRadius(0.75)
+                                  .WithTranslation({ 1, 2, 3 })
+                                  .MakeShared();
+    const Box3Ptr box = Box3::Builder{}
+                            .WithLowerCorner({ -1, -0.5, 0 })
+                            .WithUpperCorner({ 1, 0.5, 2 })
+                            .WithIsNormalFlipped(true)
+                            .MakeShared();
+    const Plane3Ptr plane = Plane3::Builder{}
+                                .WithPoint({ 0, 0, 0 })
+                                .WithNormal({ 0, 1, 0 })
+                                .WithOrientation(QuaternionD{ { 0, 0, 1 }, 0.5 })
+                                .MakeShared();
+    // Wrapped in a set so the fallback path is exercised with finite
+    // distances; an empty set has infinite signed distance everywhere.
+    const SurfaceSet3Ptr sset =
+        SurfaceSet3::Builder{}.WithSurfaces({ sphere }).MakeShared();
+
+    Array1<Vector3D> points;
+    for (int i = -2; i <= 2; ++i)
+    {
+        for (int j = -2; j <= 2; ++j)
+        {
+            for (int k = -2; k <= 2; ++k)
+            {
+                points.Append(Vector3D(0.8 * i, 0.8 * j, 0.8 * k));
+            }
+        }
+    }
+
+    Array1<double> results(points.size());
+
+    for (const Surface3Ptr& surface :
+         std::vector<Surface3Ptr>{ sphere, box, plane, sset })
+    {
+        const SurfaceToImplicit3Ptr s2i = SurfaceToImplicit3::Builder{}
+                                              .WithSurface(surface)
+                                              .WithTranslation({ 0.5, 0, 0 })
+                                              .MakeShared();
+
+        s2i->SignedDistance(points.ConstAccessor(), results.Accessor());
+
+        for (size_t idx = 0; idx < points.size(); ++idx)
+        {
+            EXPECT_NEAR(s2i->SignedDistance(points[idx]), results[idx], 1e-12);
+        }
+    }
+}
+
+TEST(SurfaceToImplicit3, Gradient)
+{
+    const Sphere3Ptr sphere = Sphere3::Builder{}
+                                  .WithCenter({ 0.5, 0.25, -0.25 })
+                                  .WithRadius(0.75)
+                                  .WithTranslation({ 1, 2, 3 })
+                                  .MakeShared();
+    const Box3Ptr box = Box3::Builder{}
+                            .WithLowerCorner({ -1, -0.5, 0 })
+                            .WithUpperCorner({ 1, 0.5, 2 })
+                            .WithIsNormalFlipped(true)
+                            .MakeShared();
+    const Plane3Ptr plane = Plane3::Builder{}
+                                .WithPoint({ 0, 0, 0 })
+                                .WithNormal({ 0, 1, 0 })
+                                .WithOrientation(QuaternionD{ { 0, 0, 1 }, 0.5 })
+                                .MakeShared();
+    const Cylinder3Ptr cylinder = Cylinder3::Builder{}
+                                      .WithCenter({ 0.2, -0.3, 0.1 })
+                                      .WithRadius(0.6)
+                                      .WithHeight(1.2)
+                                      .MakeShared();
+    // Wrapped in a set so the fallback path is exercised with finite
+    // distances; an empty set has infinite signed distance everywhere.
+    const SurfaceSet3Ptr sset =
+        SurfaceSet3::Builder{}.WithSurfaces({ sphere }).MakeShared();
+
+    const auto numericalGradient = [](const SurfaceToImplicit3Ptr& s,
+                                      const Vector3D& x) {
+        const double e = 1e-6;
+        return Vector3D{ (s->SignedDistance(x + Vector3D{ e, 0, 0 }) -
+                          s->SignedDistance(x - Vector3D{ e, 0, 0 })) /
+                             (2.0 * e),
+                         (s->SignedDistance(x + Vector3D{ 0, e, 0 }) -
+                          s->SignedDistance(x - Vector3D{ 0, e, 0 })) /
+                             (2.0 * e),
+                         (s->SignedDistance(x + Vector3D{ 0, 0, e }) -
+                          s->SignedDistance(x - Vector3D{ 0, 0, e })) /
+                             (2.0 * e) };
+    };
+
+    // Probe points chosen away from gradient discontinuities (equidistant
+    // ridges, primitive centers) so the finite-difference reference is
+    // well defined.
+    const struct
+    {
+        Surface3Ptr surface;
+        std::vector<Vector3D> probes;
+    } cases[] = {
+        { sphere, { { 2.0, 2.5, 2.0 }, { 1.6, 2.3, 2.7 }, { 0.5, 1.0, 4.0 } } },
+        { box, { { 1.5, 0.9, 2.5 }, { 0.3, 0.1, 0.7 }, { -2.0, 0.2, 1.0 } } },
+        { plane, { { 0.4, 1.2, -0.3 }, { -1.0, -2.0, 0.5 } } },
+        { cylinder,
+          { { 1.2, -0.2, 0.1 },
+            { 0.3, 0.8, 0.2 },
+            { 1.0, 0.7, 0.1 },
+            { 0.4, -0.2, 0.2 } } },
+    };
+
+    for (const auto& testCase : cases)
+    {
+        const SurfaceToImplicit3Ptr s2i = SurfaceToImplicit3::Builder{}
+                                              .WithSurface(testCase.surface)
+                                              .MakeShared();
+
+        for (const Vector3D& x : testCase.probes)
+        {
+            const Vector3D analytic = s2i->Gradient(x);
+            const Vector3D numerical = numericalGradient(s2i, x);
+
+            EXPECT_NEAR(numerical.x, analytic.x, 1e-5);
+            EXPECT_NEAR(numerical.y, analytic.y, 1e-5);
+            EXPECT_NEAR(numerical.z, analytic.z, 1e-5);
+            EXPECT_NEAR(1.0, analytic.Length(), 1e-10);
+        }
+    }
+
+    // The batch overload matches the scalar query for analytic primitives
+    // and for the finite-difference fallback alike.
+    Array1<Vector3D> points;
+    for (int i = -2; i <= 2; ++i)
+    {
+        for (int j = -2; j <= 2; ++j)
+        {
+            for (int k = -2; k <= 2; ++k)
+            {
+                points.Append(Vector3D(0.8 * i, 0.8 * j, 0.8 * k));
+            }
+        }
+    }
+
+    Array1<Vector3D> results(points.size());
+
+    for (const Surface3Ptr& surface :
+         std::vector<Surface3Ptr>{ sphere, box, plane, cylinder, sset })
+    {
+        const SurfaceToImplicit3Ptr s2i = SurfaceToImplicit3::Builder{}
+                                              .WithSurface(surface)
+                                              .WithTranslation({ 0.5, 0, 0 })
+                                              .MakeShared();
+
+        s2i->Gradient(points.ConstAccessor(), results.Accessor());
+
+        for (size_t idx = 0; idx < points.size(); ++idx)
+        {
+            const Vector3D expected = s2i->Gradient(points[idx]);
+            EXPECT_NEAR(expected.x, results[idx].x, 1e-12);
+            EXPECT_NEAR(expected.y, results[idx].y, 1e-12);
+            EXPECT_NEAR(expected.z, results[idx].z, 1e-12);
+        }
+    }
+}
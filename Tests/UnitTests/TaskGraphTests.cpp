@@ -0,0 +1,89 @@
+#include "pch.hpp"
+
+#include <Core/Utils/TaskGraph.hpp>
+
+#include <atomic>
+
+using namespace CubbyFlow;
+
+TEST(TaskGraph, DependencyOrdering)
+{
+    TaskGraph graph;
+    int a = 0;
+    int b = 0;
+    std::atomic<int> counter{ 0 };
+    int producerAOrder = -1;
+    int producerBOrder = -1;
+    int consumerOrder = -1;
+
+    graph.AddTask(
+        [&]() {
+            a = 1;
+            producerAOrder = counter++;
+        },
+        {}, { &a });
+    graph.AddTask(
+        [&]() {
+            b = 2;
+            producerBOrder = counter++;
+        },
+        {}, { &b });
+    graph.AddTask(
+        [&]() {
+            EXPECT_EQ(1, a);
+            EXPECT_EQ(2, b);
+            consumerOrder = counter++;
+        },
+        { &a, &b }, {});
+
+    EXPECT_EQ(3u, graph.GetNumberOfTasks());
+
+    graph.Run();
+
+    // The consumer reads both writes, so it must run after both producers.
+    EXPECT_GT(consumerOrder, producerAOrder);
+    EXPECT_GT(consumerOrder, producerBOrder);
+}
+
+TEST(TaskGraph, WriteAfterRead)
+{
+    TaskGraph graph;
+    int shared = 7;
+    int observed = -1;
+
+    // The reader declares a read on the resource and the writer a write, so
+    // the reader must see the original value even though the writer was added
+    // later.
+    graph.AddTask([&]() { observed = shared; }, { &shared }, {});
+    graph.AddTask([&]() { shared = 42; }, {}, { &shared });
+
+    graph.Run();
+
+    EXPECT_EQ(7, observed);
+    EXPECT_EQ(42, shared);
+}
+
+TEST(TaskGraph, IndependentTasksAllRun)
+{
+    TaskGraph graph;
+    std::atomic<int> numExecuted{ 0 };
+    int resources[16];
+
+    for (auto& resource : resources)
+    {
+        graph.AddTask([&]() { ++numExecuted; }, {}, { &resource });
+    }
+
+    graph.Run();
+    EXPECT_EQ(16, numExecuted.load());
+
+    // Re-running executes everything again; Clear drops the tasks.
+    graph.Run(ExecutionPolicy::Serial);
+    EXPECT_EQ(32, numExecuted.load());
+
+    graph.Clear();
+    EXPECT_EQ(0u, graph.GetNumberOfTasks());
+
+    graph.Run();
+    EXPECT_EQ(32, numExecuted.load());
+}
@@ -139,4 +139,30 @@ TEST(Triangle3, Builder)
             EXPECT_DOUBLE_EQ(uvs[i][j], tri.uvs[i][j]);
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(Triangle3, ClosestPointVertexRegion)
+{
+    // The query point projects outside two edges at once; the closest
+    // boundary feature is on edge bc, not on the first edge whose
+    // half-plane test fails.
+    Triangle3 tri;
+    tri.points = { { Vector3D(0.601856, 0.039106, 0.756149),
+                     Vector3D(0.293712, 1.080473, -0.427807),
+                     Vector3D(1.834360, 1.912207, -1.172475) } };
+
+    const Vector3D queryPoint{ -0.191990, 2.321308, -2.976509 };
+
+    EXPECT_NEAR(2.6375325089946378, tri.ClosestDistance(queryPoint), 1e-12);
+
+    const Vector3D closest = tri.ClosestPoint(queryPoint);
+    EXPECT_VECTOR3_NEAR(
+        Vector3D(1.2222465173581507, 1.5817515063560035, -0.87661162115425406),
+        closest, 1e-12);
+
+    // A true vertex-region query must return the vertex itself
+    tri.points = { { Vector3D(0, 0, -1), Vector3D(1, 0, -1),
+                     Vector3D(0, 1, -1) } };
+    EXPECT_VECTOR3_EQ(Vector3D(0, 0, -1),
+                      tri.ClosestPoint(Vector3D(-3.0, -3.0, 0.0)));
+}
@@ -1,7 +1,16 @@
 #include "UnitTestsUtils.hpp"
 #include "pch.hpp"
 
+#include <Core/Geometry/ObjToSDFPipeline.hpp>
 #include <Core/Geometry/TriangleMesh3.hpp>
+#include <Core/Geometry/TriangleMeshDecimation.hpp>
+#include <Core/Geometry/TriangleMeshToSDF.hpp>
+#include <Core/Grid/VertexCenteredScalarGrid3.hpp>
+#include <Core/Utils/Parallel.hpp>
+
+#include <atomic>
+#include <map>
+#include <sstream>
 
 using namespace CubbyFlow;
 
@@ -296,4 +305,259 @@ TEST(TriangleMesh3, Builder)
         EXPECT_EQ(normalIndices[i], mesh.NormalIndex(i));
         EXPECT_EQ(uvIndices[i], mesh.UVIndex(i));
     }
-}
\ No newline at end of file
+}
+TEST(TriangleMesh3, WriteReadPly)
+{
+    TriangleMesh3 mesh;
+
+    for (size_t i = 0; i < 6; ++i)
+    {
+        const auto x = static_cast<double>(i);
+        mesh.AddPoint({ x, 2.0 * x, 0.5 * x });
+        mesh.AddNormal({ 0.0, 1.0, 0.0 });
+        mesh.AddUV({ 0.25 * x, 0.5 * x });
+    }
+
+    mesh.AddPointTriangle({ 0, 1, 2 });
+    mesh.AddPointTriangle({ 3, 4, 5 });
+    mesh.AddNormalTriangle({ 0, 1, 2 });
+    mesh.AddNormalTriangle({ 3, 4, 5 });
+    mesh.AddUVTriangle({ 0, 1, 2 });
+    mesh.AddUVTriangle({ 3, 4, 5 });
+
+    std::stringstream stream{ std::ios::in | std::ios::out |
+                              std::ios::binary };
+    mesh.WritePly(&stream);
+
+    TriangleMesh3 readMesh;
+    ASSERT_TRUE(readMesh.ReadPly(&stream));
+
+    ASSERT_EQ(mesh.NumberOfPoints(), readMesh.NumberOfPoints());
+    ASSERT_EQ(mesh.NumberOfNormals(), readMesh.NumberOfNormals());
+    ASSERT_EQ(mesh.NumberOfUVs(), readMesh.NumberOfUVs());
+    ASSERT_EQ(mesh.NumberOfTriangles(), readMesh.NumberOfTriangles());
+
+    for (size_t i = 0; i < mesh.NumberOfPoints(); ++i)
+    {
+        EXPECT_NEAR(mesh.Point(i).x, readMesh.Point(i).x, 1e-4);
+        EXPECT_NEAR(mesh.Point(i).y, readMesh.Point(i).y, 1e-4);
+        EXPECT_NEAR(mesh.Point(i).z, readMesh.Point(i).z, 1e-4);
+    }
+
+    for (size_t i = 0; i < mesh.NumberOfTriangles(); ++i)
+    {
+        EXPECT_EQ(mesh.PointIndex(i), readMesh.PointIndex(i));
+        EXPECT_EQ(mesh.NormalIndex(i), readMesh.NormalIndex(i));
+        EXPECT_EQ(mesh.UVIndex(i), readMesh.UVIndex(i));
+    }
+
+    // Not a PLY stream
+    std::stringstream badStream{ "not a ply file" };
+    TriangleMesh3 badMesh;
+    EXPECT_FALSE(badMesh.ReadPly(&badStream));
+}
+
+TEST(TriangleMesh3, WriteObjDeterministic)
+{
+    TriangleMesh3 mesh;
+
+    for (size_t i = 0; i < 300; ++i)
+    {
+        const auto x = static_cast<double>(i);
+        mesh.AddPoint({ x, x + 1.0, x + 2.0 });
+    }
+
+    for (size_t i = 0; i + 2 < 300; i += 3)
+    {
+        mesh.AddPointTriangle({ i, i + 1, i + 2 });
+    }
+
+    const unsigned int numThreads = GetMaxNumberOfThreads();
+
+    std::ostringstream singleThreaded;
+    SetMaxNumberOfThreads(1);
+    mesh.WriteObj(&singleThreaded);
+
+    std::ostringstream multiThreaded;
+    SetMaxNumberOfThreads(numThreads > 1 ? numThreads : 4);
+    mesh.WriteObj(&multiThreaded);
+
+    SetMaxNumberOfThreads(numThreads);
+
+    EXPECT_EQ(singleThreaded.str(), multiThreaded.str());
+    EXPECT_EQ("v 0 1 2\n", singleThreaded.str().substr(0, 8));
+}
+
+TEST(TriangleMesh3, CompactQueryData)
+{
+    std::string objStr = GetCubeTriMesh3x3x3Obj();
+    std::istringstream objStream(objStr);
+
+    TriangleMesh3 mesh;
+    [[maybe_unused]] bool isLoaded = mesh.ReadObj(&objStream);
+
+    TriangleMesh3 compactMesh(mesh);
+    compactMesh.SetUseCompactQueryData(true);
+    EXPECT_TRUE(compactMesh.GetUseCompactQueryData());
+
+    size_t numSamples = GetNumberOfSamplePoints3();
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const Vector3D& pt = GetSamplePoints3()[i];
+
+        EXPECT_VECTOR3_NEAR(mesh.ClosestPoint(pt), compactMesh.ClosestPoint(pt),
+                            1e-6);
+        EXPECT_NEAR(mesh.ClosestDistance(pt), compactMesh.ClosestDistance(pt),
+                    1e-6);
+        EXPECT_VECTOR3_NEAR(mesh.ClosestNormal(pt),
+                            compactMesh.ClosestNormal(pt), 1e-6);
+    }
+
+    // Toggling the mode off restores the default query path
+    compactMesh.SetUseCompactQueryData(false);
+    EXPECT_FALSE(compactMesh.GetUseCompactQueryData());
+    EXPECT_VECTOR3_EQ(mesh.ClosestPoint(GetSamplePoints3()[0]),
+                      compactMesh.ClosestPoint(GetSamplePoints3()[0]));
+}
+
+TEST(TriangleMesh3, ReadObjStreaming)
+{
+    std::string objStr = GetCubeTriMesh3x3x3Obj();
+
+    std::istringstream objStream(objStr);
+    TriangleMesh3 mesh;
+    [[maybe_unused]] bool isLoaded = mesh.ReadObj(&objStream);
+
+    // A tiny chunk size forces records to be split across many fetches.
+    std::istringstream streamedObjStream(objStr);
+    TriangleMesh3 streamedMesh;
+    EXPECT_TRUE(ReadObjStreaming(&streamedObjStream, &streamedMesh, 64));
+
+    EXPECT_EQ(mesh.NumberOfPoints(), streamedMesh.NumberOfPoints());
+    EXPECT_EQ(mesh.NumberOfNormals(), streamedMesh.NumberOfNormals());
+    EXPECT_EQ(mesh.NumberOfUVs(), streamedMesh.NumberOfUVs());
+    EXPECT_EQ(mesh.NumberOfTriangles(), streamedMesh.NumberOfTriangles());
+
+    for (size_t i = 0; i < mesh.NumberOfPoints(); ++i)
+    {
+        EXPECT_VECTOR3_EQ(mesh.Point(i), streamedMesh.Point(i));
+    }
+
+    for (size_t i = 0; i < mesh.NumberOfTriangles(); ++i)
+    {
+        EXPECT_EQ(mesh.PointIndex(i), streamedMesh.PointIndex(i));
+    }
+}
+
+TEST(TriangleMesh3, ObjToSDFPipeline)
+{
+    std::string objStr = GetCubeTriMesh3x3x3Obj();
+
+    // Reference: whole-mesh read plus the non-streamed SDF bake.
+    std::istringstream objStream(objStr);
+    TriangleMesh3 mesh;
+    [[maybe_unused]] bool isLoaded = mesh.ReadObj(&objStream);
+
+    BoundingBox3D box = mesh.BoundingBox();
+    const Vector3D scale{ box.GetWidth(), box.GetHeight(), box.GetDepth() };
+    box.lowerCorner -= 0.2 * scale;
+    box.upperCorner += 0.2 * scale;
+
+    const double dx = box.GetWidth() / 10.0;
+    VertexCenteredScalarGrid3 expected(10, 10, 10, dx, dx, dx,
+                                       box.lowerCorner.x, box.lowerCorner.y,
+                                       box.lowerCorner.z);
+    TriangleMeshToSDF(mesh, &expected);
+
+    std::istringstream pipelineStream(objStr);
+    VertexCenteredScalarGrid3 actual;
+
+    ObjToSDFPipelineSettings settings;
+    settings.resolutionX = 10;
+    settings.marginScale = 0.2;
+    settings.readChunkSize = 128;
+
+    std::atomic<size_t> writtenSlabs{ 0 };
+    EXPECT_TRUE(ObjToSDF(&pipelineStream, &actual, settings,
+                         [&writtenSlabs](size_t kBegin, size_t kEnd) {
+                             writtenSlabs += kEnd - kBegin;
+                         }));
+
+    EXPECT_EQ(expected.GetDataSize(), actual.GetDataSize());
+    EXPECT_EQ(actual.GetDataSize().z, writtenSlabs.load());
+    expected.ForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(expected(i, j, k), actual(i, j, k));
+    });
+}
+
+TEST(TriangleMesh3, Decimation)
+{
+    // Flat 20x20 grid: heavily over-tessellated for its shape.
+    TriangleMesh3 grid;
+    const size_t n = 20;
+    for (size_t j = 0; j <= n; ++j)
+    {
+        for (size_t i = 0; i <= n; ++i)
+        {
+            grid.AddPoint({ static_cast<double>(i), 0.0,
+                            static_cast<double>(j) });
+        }
+    }
+
+    const auto vid = [n](size_t i, size_t j) { return j * (n + 1) + i; };
+    for (size_t j = 0; j < n; ++j)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            grid.AddPointTriangle(
+                { vid(i, j), vid(i + 1, j), vid(i + 1, j + 1) });
+            grid.AddPointTriangle(
+                { vid(i, j), vid(i + 1, j + 1), vid(i, j + 1) });
+        }
+    }
+
+    EXPECT_EQ(800u, grid.NumberOfTriangles());
+
+    DecimateTriangleMesh3(&grid, 300);
+
+    EXPECT_LE(grid.NumberOfTriangles(), 300u);
+    EXPECT_GT(grid.NumberOfTriangles(), 0u);
+    EXPECT_EQ(grid.NumberOfPoints(), grid.NumberOfNormals());
+
+    // Decimation must keep the vertices on the plane and the indices valid.
+    for (size_t i = 0; i < grid.NumberOfPoints(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(0.0, grid.Point(i).y);
+    }
+    for (size_t t = 0; t < grid.NumberOfTriangles(); ++t)
+    {
+        const Point3UI tri = grid.PointIndex(t);
+        EXPECT_LT(tri.x, grid.NumberOfPoints());
+        EXPECT_LT(tri.y, grid.NumberOfPoints());
+        EXPECT_LT(tri.z, grid.NumberOfPoints());
+    }
+
+    // Closed meshes stay closed: every edge keeps exactly two triangles.
+    std::istringstream cubeStream(GetCubeTriMesh3x3x3Obj());
+    TriangleMesh3 cube;
+    EXPECT_TRUE(ReadObjStreaming(&cubeStream, &cube));
+    DecimateTriangleMesh3(&cube, 40);
+
+    EXPECT_LE(cube.NumberOfTriangles(), 40u);
+    std::map<std::pair<size_t, size_t>, int> edgeCounts;
+    for (size_t t = 0; t < cube.NumberOfTriangles(); ++t)
+    {
+        const Point3UI tri = cube.PointIndex(t);
+        const size_t v[3] = { tri.x, tri.y, tri.z };
+        for (int e = 0; e < 3; ++e)
+        {
+            const size_t lo = std::min(v[e], v[(e + 1) % 3]);
+            const size_t hi = std::max(v[e], v[(e + 1) % 3]);
+            edgeCounts[{ lo, hi }]++;
+        }
+    }
+    for (const auto& edgeCount : edgeCounts)
+    {
+        EXPECT_EQ(2, edgeCount.second);
+    }
+}
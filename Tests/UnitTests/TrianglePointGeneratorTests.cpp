@@ -0,0 +1,41 @@
+#include "pch.hpp"
+
+#include <Core/PointGenerator/TrianglePointGenerator.hpp>
+
+using namespace CubbyFlow;
+
+TEST(TrianglePointGenerator, GenerateMatchesForEachPoint)
+{
+    const TrianglePointGenerator generator;
+    const BoundingBox2D box(Vector2D{ -0.3, 0.4 }, Vector2D{ 0.8, 1.5 });
+    const double spacing = 0.11;
+
+    Array1<Vector2D> reference;
+    generator.ForEachPoint(box, spacing, [&](const Vector2D& point) {
+        reference.Append(point);
+        return true;
+    });
+
+    Array1<Vector2D> generated;
+    generator.Generate(box, spacing, &generated);
+
+    ASSERT_EQ(reference.size(), generated.size());
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        EXPECT_EQ(reference[i], generated[i]);
+    }
+}
+
+TEST(TrianglePointGenerator, GenerateAppends)
+{
+    const TrianglePointGenerator generator;
+    const BoundingBox2D box(Vector2D{ 0, 0 }, Vector2D{ 1, 1 });
+
+    Array1<Vector2D> points;
+    points.Append(Vector2D{ 5, 5 });
+
+    generator.Generate(box, 0.2, &points);
+
+    ASSERT_GT(points.size(), 1u);
+    EXPECT_EQ(Vector2D(5, 5), points[0]);
+}
@@ -417,4 +417,35 @@ TEST(Vector3, BinaryOperators)
     auto tangential = normal.Tangential();
     EXPECT_NEAR(std::get<0>(tangential).Dot(normal), 0.0, 1e-9);
     EXPECT_NEAR(std::get<1>(tangential).Dot(normal), 0.0, 1e-9);
-}
\ No newline at end of file
+}
+TEST(Vector3, ConstexprOperations)
+{
+    // Construction and the value-returning arithmetic are evaluable at
+    // compile time; the static_asserts are the test.
+    constexpr Vector3D a{ 1.0, 2.0, 3.0 };
+    constexpr Vector3D b{ 4.0, 5.0, 6.0 };
+
+    constexpr Vector3D sum = a.Add(b);
+    static_assert(sum.x == 5.0 && sum.y == 7.0 && sum.z == 9.0,
+                  "constexpr Add");
+
+    constexpr double dot = a.Dot(b);
+    static_assert(dot == 32.0, "constexpr Dot");
+
+    constexpr Vector3D cross = a.Cross(b);
+    static_assert(cross.x == -3.0 && cross.y == 6.0 && cross.z == -3.0,
+                  "constexpr Cross");
+
+    constexpr Vector3D expr = a + b * 2.0 - 1.0;
+    static_assert(expr.x == 8.0 && expr.y == 11.0 && expr.z == 14.0,
+                  "constexpr operator chain");
+
+    EXPECT_DOUBLE_EQ(32.0, dot);
+
+#ifdef CUBBYFLOW_ALIGNED_VECTOR_TYPES
+    static_assert(sizeof(Vector3D) == 4 * sizeof(double), "padded size");
+    static_assert(alignof(Vector3D) == 4 * sizeof(double), "padded align");
+#else
+    static_assert(sizeof(Vector3D) == 3 * sizeof(double), "default layout");
+#endif
+}
@@ -88,6 +88,39 @@ TEST(VolumeParticleEmitter3, Emit)
     EXPECT_LT(79u, particles->GetNumberOfParticles());
 }
 
+TEST(VolumeParticleEmitter3, EmitOneShotParallel)
+{
+    auto sphere = std::make_shared<SurfaceToImplicit3>(
+        std::make_shared<Sphere3>(Vector3D(1.0, 2.0, 4.0), 3.0));
+
+    BoundingBox3D box({ 0.0, 0.0, 0.0 }, { 3.0, 3.0, 3.0 });
+
+    VolumeParticleEmitter3 emitter(sphere, box, 0.5, { 0.0, 0.0, 0.0 },
+                                   { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, 100,
+                                   0.1, true, false);
+
+    auto particles = std::make_shared<ParticleSystemData3>();
+    emitter.SetTarget(particles);
+
+    Frame frame(0, 1.0);
+    emitter.Update(frame.TimeInSeconds(), frame.timeIntervalInSeconds);
+
+    // One-shot emission takes the parallel lattice path and must respect
+    // both the particle cap and the emission region.
+    EXPECT_EQ(100u, particles->GetNumberOfParticles());
+
+    auto pos = particles->GetPositions();
+    for (size_t i = 0; i < particles->GetNumberOfParticles(); ++i)
+    {
+        EXPECT_GE(3.0 + 0.5 * 0.1 * 0.5,
+                  (pos[i] - Vector3D(1.0, 2.0, 4.0)).Length());
+    }
+
+    ++frame;
+    emitter.Update(frame.TimeInSeconds(), frame.timeIntervalInSeconds);
+    EXPECT_EQ(100u, particles->GetNumberOfParticles());
+}
+
 TEST(VolumeParticleEmitter3, Builder)
 {
     auto sphere = std::make_shared<Sphere3>(Vector3D(1.0, 2.0, 4.0), 3.0);